@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/decoded_cache.h"
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "common/hash-str.h"
+#include "common/memstream.h"
+#include "common/memtag.h"
+#include "common/util.h"
+
+namespace Audio {
+
+namespace {
+
+/** Amount of samples decoded at once when adding a sound. */
+const int kDecodeChunk = 4096;
+
+} // End of anonymous namespace
+
+uint DecodedCache::KeyHash::operator()(const Key &key) const {
+	return Common::hashit_lower(key.name) ^ (key.offset * 2654435761U);
+}
+
+DecodedCache::DecodedCache(uint32 maxBytes, uint32 maxSoundBytes)
+	: _maxBytes(maxBytes), _maxSoundBytes(MIN(maxSoundBytes, maxBytes)), _bytes(0), _useCounter(0) {
+}
+
+DecodedCache::~DecodedCache() {
+	clear();
+}
+
+SeekableAudioStream *DecodedCache::get(const Common::String &name, uint32 offset) {
+	Common::StackLock lock(_mutex);
+
+	Key key;
+	key.name = name;
+	key.offset = offset;
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return nullptr;
+
+	i->_value.lastUse = ++_useCounter;
+	return makeStream(i->_value);
+}
+
+SeekableAudioStream *DecodedCache::add(const Common::String &name, uint32 offset, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	// Check the length first, so long sounds aren't decoded at all
+	const int channels = stream->isStereo() ? 2 : 1;
+	const Timestamp length = stream->getLength();
+	if ((uint64)length.totalNumberOfFrames() * channels * sizeof(int16) > _maxSoundBytes)
+		return stream;
+
+	const uint32 maxSamples = _maxSoundBytes / sizeof(int16);
+	uint32 capacity = MAX<uint32>(length.totalNumberOfFrames() * channels, kDecodeChunk);
+	int16 *samples = (int16 *)malloc(capacity * sizeof(int16));
+	uint32 count = 0;
+	while (samples && !stream->endOfData()) {
+		// The length is missing or only estimated for some formats
+		if (count + kDecodeChunk > capacity) {
+			if (count > maxSamples)
+				break;
+			capacity = MAX<uint32>(capacity * 2, count + kDecodeChunk);
+			int16 *grown = (int16 *)realloc(samples, capacity * sizeof(int16));
+			if (!grown) {
+				free(samples);
+				samples = nullptr;
+				break;
+			}
+			samples = grown;
+		}
+
+		const int read = stream->readBuffer(samples + count, kDecodeChunk);
+		if (read <= 0)
+			break;
+		count += read;
+	}
+
+	if (!samples || count > maxSamples) {
+		free(samples);
+		stream->rewind();
+		return stream;
+	}
+
+	Entry entry;
+	entry.data = Common::SharedPtr<byte>((byte *)samples, free);
+	entry.size = count * sizeof(int16);
+	entry.rate = stream->getRate();
+	entry.flags = FLAG_16BITS;
+	if (channels == 2)
+		entry.flags |= FLAG_STEREO;
+#ifdef SCUMM_LITTLE_ENDIAN
+	entry.flags |= FLAG_LITTLE_ENDIAN;
+#endif
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+
+	Key key;
+	key.name = name;
+	key.offset = offset;
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		_bytes -= i->_value.size;
+		Common::memTagFreed(Common::kMemTagAudio, i->_value.size);
+		_entries.erase(i);
+	}
+
+	evict(entry.size);
+	entry.lastUse = ++_useCounter;
+	_bytes += entry.size;
+	Common::memTagAllocated(Common::kMemTagAudio, entry.size);
+	_entries[key] = entry;
+	return makeStream(_entries[key]);
+}
+
+void DecodedCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		Common::memTagFreed(Common::kMemTagAudio, i->_value.size);
+	_entries.clear();
+	_bytes = 0;
+}
+
+SeekableAudioStream *DecodedCache::makeStream(Entry &entry) {
+	// The stream shares the samples, so they stay valid if evicted
+	Common::SeekableReadStream *data = new Common::MemoryReadStream(entry.data, entry.size);
+	return makeRawStream(data, entry.rate, entry.flags, DisposeAfterUse::YES);
+}
+
+void DecodedCache::evict(uint32 size) {
+	while (_bytes + size > _maxBytes && !_entries.empty()) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+		_bytes -= oldest->_value.size;
+		Common::memTagFreed(Common::kMemTagAudio, oldest->_value.size);
+		_entries.erase(oldest);
+	}
+}
+
+} // End of namespace Audio
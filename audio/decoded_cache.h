@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_DECODED_CACHE_H
+#define AUDIO_DECODED_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+namespace Audio {
+
+class SeekableAudioStream;
+
+/**
+ * @defgroup audio_decoded_cache Decoded sound cache
+ * @ingroup audio
+ *
+ * @brief Cache for the decoded PCM data of short compressed sounds.
+ * @{
+ */
+
+/**
+ * Keeps the decoded samples of short sounds in memory, so that sounds
+ * which are played over and over again, like clicks, footsteps or looped
+ * ambience, are only decoded once. Cached sounds are played from memory
+ * with a raw stream, which also makes looping them cheap.
+ *
+ * Sounds are identified by the name of the file they are stored in, which
+ * is compared ignoring case, and their offset in it. When the cache is full, the sounds which were not
+ * played for the longest time are removed from it. Streams playing a
+ * sound that has been removed keep working.
+ */
+class DecodedCache {
+public:
+	/**
+	 * @param maxBytes      Memory budget for the decoded samples.
+	 * @param maxSoundBytes Size above which decoded sounds are not cached.
+	 */
+	DecodedCache(uint32 maxBytes, uint32 maxSoundBytes);
+	~DecodedCache();
+
+	/**
+	 * Create a stream playing the sound cached for @p name and @p offset.
+	 *
+	 * @return The new stream, or nullptr if the sound isn't cached.
+	 */
+	SeekableAudioStream *get(const Common::String &name, uint32 offset = 0);
+
+	/**
+	 * Decode @p stream and add the result to the cache for @p name and
+	 * @p offset. The returned stream must be used instead of @p stream.
+	 *
+	 * If the sound is too long to be cached, @p stream is rewound and
+	 * returned.
+	 *
+	 * @return A stream playing the sound, or nullptr if @p stream is
+	 *         nullptr.
+	 */
+	SeekableAudioStream *add(const Common::String &name, uint32 offset, SeekableAudioStream *stream);
+
+	/** Remove all the cached sounds. */
+	void clear();
+
+	/** Return the memory used by the decoded samples. */
+	uint32 getSize() const { return _bytes; }
+
+private:
+	struct Key {
+		Common::String name;
+		uint32 offset;
+
+		bool operator==(const Key &other) const {
+			return offset == other.offset && name.equalsIgnoreCase(other.name);
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Common::SharedPtr<byte> data;
+		uint32 size;
+		int rate;
+		byte flags;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	SeekableAudioStream *makeStream(Entry &entry);
+	void evict(uint32 size);
+
+	Common::Mutex _mutex;
+	EntryMap _entries;
+	uint32 _maxBytes;
+	uint32 _maxSoundBytes;
+	uint32 _bytes;
+	uint32 _useCounter;
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -23,6 +23,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -107,6 +108,19 @@ protected:
 	Timestamp _length;
 
 private:
+	enum {
+		/** Amount of frames between two entries of the seek index. */
+		SEEK_INDEX_INTERVAL = 8
+	};
+
+	struct SeekPoint {
+		mad_timer_t time;
+		int64 offset;
+	};
+
+	/** Position of every SEEK_INDEX_INTERVAL-th frame, collected when calculating the length. */
+	Common::Array<SeekPoint> _seekIndex;
+
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
 };
 
@@ -336,9 +350,18 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream. This reads all the frame headers,
+	// so the seek index is built at the same time.
+	for (uint frame = 0; _state != MP3_STATE_EOS; ++frame) {
+		const mad_timer_t frameTime = _curTime;
 		readHeader(*_inStream);
+		if (_state == MP3_STATE_READY && !(frame % SEEK_INDEX_INTERVAL)) {
+			SeekPoint point;
+			point.time = frameTime;
+			point.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+			_seekIndex.push_back(point);
+		}
+	}
 
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
@@ -376,7 +399,26 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
+	// Find the last indexed frame starting before the destination
+	uint first = 0, last = _seekIndex.size();
+	while (first < last) {
+		const uint middle = (first + last) / 2;
+		if (mad_timer_compare(_seekIndex[middle].time, destination) <= 0)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// Jump there, unless the stream is already between it and the destination
+	if (first > 0) {
+		const SeekPoint &point = _seekIndex[first - 1];
+		if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 ||
+		    mad_timer_compare(point.time, _curTime) > 0) {
+			_inStream->seek(point.offset);
+			initStream(*_inStream);
+			_curTime = point.time;
+		}
+	} else if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
 		_inStream->seek(0);
 		initStream(*_inStream);
 	}
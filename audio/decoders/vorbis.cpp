@@ -28,6 +28,7 @@
 
 #ifdef USE_VORBIS
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -102,6 +103,17 @@ protected:
 	const int16 *_bufferEnd;
 	const int16 *_pos;
 
+	struct SeekPoint {
+		ogg_int64_t pcm;
+		ogg_int64_t offset;
+	};
+
+	/**
+	 * Raw positions collected while decoding, so seeking back to a part
+	 * that has been played doesn't have to bisect the file to find it.
+	 */
+	Common::Array<SeekPoint> _seekIndex;
+
 public:
 	// startTime / duration are in milliseconds
 	VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose);
@@ -117,6 +129,8 @@ public:
 	Timestamp getLength() const override { return _length; }
 protected:
 	bool refill();
+	void addSeekPoint();
+	bool seekIndexed(ogg_int64_t target);
 };
 
 VorbisStream::VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -159,6 +173,7 @@ int VorbisStream::readBuffer(int16 *buffer, const int numSamples) {
 		_pos += len;
 		samples += len;
 		if (_pos >= _bufferEnd) {
+			addSeekPoint();
 			if (!refill())
 				break;
 		}
@@ -166,10 +181,68 @@ int VorbisStream::readBuffer(int16 *buffer, const int numSamples) {
 	return samples;
 }
 
+void VorbisStream::addSeekPoint() {
+	// Keep a point every quarter of a second, which is short enough to
+	// decode from it faster than a bisection search would take
+	const ogg_int64_t pcm = ov_pcm_tell(&_ovFile);
+	if (pcm < 0 || (!_seekIndex.empty() && pcm < _seekIndex.back().pcm + _rate / 4))
+		return;
+
+	SeekPoint point;
+	point.pcm = pcm;
+	point.offset = ov_raw_tell(&_ovFile);
+	if (point.offset >= 0)
+		_seekIndex.push_back(point);
+}
+
+bool VorbisStream::seekIndexed(ogg_int64_t target) {
+	uint first = 0, last = _seekIndex.size();
+	while (first < last) {
+		const uint middle = (first + last) / 2;
+		if (_seekIndex[middle].pcm <= target)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// Seeking forward leaves gaps in the index, where bisecting is faster
+	if (!first || target - _seekIndex[first - 1].pcm > _rate)
+		return false;
+
+	// The data at a raw offset may start slightly after the position it
+	// was recorded at, so fall back to the point before if needed
+	const int channels = ov_info(&_ovFile, -1)->channels;
+	for (uint tries = 0; tries < 2 && tries < first; ++tries) {
+		if (ov_raw_seek(&_ovFile, _seekIndex[first - 1 - tries].offset))
+			return false;
+		const ogg_int64_t pcm = ov_pcm_tell(&_ovFile);
+		if (pcm < 0 || pcm > target)
+			continue;
+
+		// Decode from there up to the target
+		ogg_int64_t skip = (target - pcm) * channels;
+		while (true) {
+			if (!refill())
+				return false;
+			const ogg_int64_t available = _bufferEnd - _buffer;
+			if (skip < available || !available) {
+				_pos = _buffer + MIN(skip, available);
+				return true;
+			}
+			skip -= available;
+		}
+	}
+	return false;
+}
+
 bool VorbisStream::seek(const Timestamp &where) {
 	// Vorbisfile uses the sample pair number, thus we always use "false" for the isStereo parameter
 	// of the convertTimeToStreamPos helper.
-	int res = ov_pcm_seek(&_ovFile, convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames());
+	const ogg_int64_t target = convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames();
+	if (seekIndexed(target))
+		return true;
+
+	int res = ov_pcm_seek(&_ovFile, target);
 	if (res) {
 		warning("Error seeking in Vorbis stream (%d)", res);
 		_pos = _bufferEnd;
@@ -21,6 +21,9 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
+#include "common/profiler.h"
+#include "common/system.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -48,13 +51,14 @@ public:
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data buffer where to mix the data, saturated with
+	 *             clampSamples() once all channels are mixed
 	 * @param len  number of sample *pairs*. So a value of
 	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             32 bits, for a total of 80 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -134,6 +138,11 @@ public:
 	*/
 	void resetRate();
 
+	/**
+	 * Set the interpolation used to resample the channel.
+	 */
+	void setRateConverterQuality(RateConverterQuality quality);
+
 	/**
 	 * Notifies the channel that the global sound type
 	 * volume settings changed.
@@ -141,9 +150,10 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Queries the values MixerImpl::getElapsedTime() computes how long
+	 * the channel has been playing from.
 	 */
-	Timestamp getElapsedTime();
+	void getTiming(uint32 &samplesConsumed, uint32 &mixerTimeStamp, uint32 &pauseStartTime, uint32 &pauseTime) const;
 
 	/**
 	 * Replaces the channel's stream with a version that loops indefinitely.
@@ -180,6 +190,16 @@ private:
 	void updateChannelVolumes();
 	st_volume_t _volL, _volR;
 
+	/**
+	 * Volume changes are spread over a few blocks of samples to avoid
+	 * clicks. These are the volumes the last block was mixed with.
+	 */
+	enum {
+		kVolumeRampBlockSize = 32,
+		kVolumeRampStep = Mixer::kMaxMixerVolume / 8
+	};
+	st_volume_t _mixVolL, _mixVolR;
+
 	Mixer *_mixer;
 
 	uint32 _samplesConsumed;
@@ -197,22 +217,39 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _rateConverterQuality(kRateConverterLinear), _commandHead(0), _commandTail(0) {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	// Linear interpolation is the default, for the ports with little CPU
+	// time to spare
+	if (ConfMan.hasKey("resampling_quality")) {
+		const Common::String quality = ConfMan.get("resampling_quality");
+		if (quality == "sinc_low")
+			_rateConverterQuality = kRateConverterSincLow;
+		else if (quality == "sinc_high")
+			_rateConverterQuality = kRateConverterSincHigh;
+		else if (quality != "linear")
+			warning("Unknown resampling quality '%s'", quality.c_str());
+	}
+
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = nullptr;
+		_channelHandles[i] = SoundHandle()._val;
+		_channelTimings[i].sequence = 0;
+	}
+
+	resetOutputStats();
 }
 
 MixerImpl::~MixerImpl() {
+	applyCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
 }
 
 void MixerImpl::setReady(bool ready) {
-	Common::StackLock lock(_mutex);
-
 	_mixerReady = ready;
 }
 
@@ -228,10 +265,177 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
-void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
+bool MixerImpl::getOutputStats(OutputStats &stats) const {
+	stats.bufferSize = _outputBufferSize;
+	stats.callbacks = _outputCallbacks;
+	stats.underruns = _outputUnderruns;
+	stats.lastCallbackTime = _outputLastTime;
+	stats.maxCallbackTime = _outputMaxTime;
+	stats.totalCallbackTime = _outputTotalTime;
+	return true;
+}
+
+void MixerImpl::resetOutputStats() {
+	_outputBufferSize = 0;
+	_outputCallbacks = 0;
+	_outputUnderruns = 0;
+	_outputLastTime = 0;
+	_outputMaxTime = 0;
+	_outputTotalTime = 0;
+	_lastCallbackStart = 0;
+}
+
+void MixerImpl::updateOutputStats(uint64 start, uint samples) {
+	const uint64 end = g_system->getMicros();
+	const uint32 duration = (uint32)MIN<uint64>(end - start, 0xFFFFFFFF);
+
+	// The output runs dry when the callback comes later than the previous
+	// buffer takes to play, allowing for some jitter of the audio thread
+	const uint64 lastStart = _lastCallbackStart.exchange(start);
+	const uint64 period = (uint64)samples * 1000000 / _sampleRate;
+	if (lastStart && start - lastStart > period + period / 2) {
+		++_outputUnderruns;
+#ifdef USE_PROFILER
+		Common::Profiler &profiler = Common::Profiler::instance();
+		if (profiler.isEnabled())
+			profiler.record("Audio underrun", lastStart, start, Common::Profiler::kLaneAudio);
+#endif
+	}
+
+	_outputBufferSize = samples;
+	++_outputCallbacks;
+	_outputLastTime = duration;
+	if (duration > _outputMaxTime)
+		_outputMaxTime = duration;
+	_outputTotalTime += duration;
+}
+
+int MixerImpl::findSlot(SoundHandle handle) const {
+	const int index = handle._val % NUM_CHANNELS;
+	if (handle._val == SoundHandle()._val || _channelHandles[index].load(std::memory_order_acquire) != handle._val)
+		return -1;
+	return index;
+}
+
+void MixerImpl::queueCommand(CommandType type, uint32 handle, int value, Channel *channel) {
+	if (_commandHead - _commandTail.load(std::memory_order_acquire) == kCommandQueueSize) {
+		// The mixer does not keep up, apply the commands here instead.
+		// Keep the locking order by releasing _queueMutex first.
+		_queueMutex.unlock();
+		{
+			Common::StackLock lock(_mutex);
+			_queueMutex.lock();
+			applyCommands();
+		}
+	}
+
+	const uint32 head = _commandHead.load(std::memory_order_relaxed);
+	Command &command = _commands[head % kCommandQueueSize];
+	command.type = type;
+	command.handle = handle;
+	command.channel = channel;
+	command.value = value;
+	_commandHead.store(head + 1, std::memory_order_release);
+}
+
+void MixerImpl::applyCommands() {
+	const uint32 head = _commandHead.load(std::memory_order_acquire);
+	uint32 tail = _commandTail.load(std::memory_order_relaxed);
+
+	for (; tail != head; ++tail) {
+		const Command &command = _commands[tail % kCommandQueueSize];
+		const int index = command.handle % NUM_CHANNELS;
+		Channel *chan = _channels[index];
+
+		switch (command.type) {
+		case kCommandPlay:
+			assert(!chan);
+			_channels[index] = command.channel;
+			continue;
+		case kCommandPauseAll:
+		case kCommandQualityAll:
+			for (int i = 0; i != NUM_CHANNELS; i++) {
+				if (!_channels[i])
+					continue;
+				if (command.type == kCommandPauseAll) {
+					_channels[i]->pause(command.value != 0);
+					publishTiming(i);
+				} else {
+					_channels[i]->setRateConverterQuality((RateConverterQuality)command.value);
+				}
+			}
+			continue;
+		case kCommandUpdateVolumes:
+			for (int i = 0; i != NUM_CHANNELS; i++) {
+				if (_channels[i] && _channels[i]->getType() == command.value)
+					_channels[i]->notifyGlobalVolChange();
+			}
+			continue;
+		default:
+			break;
+		}
+
+		// Simply ignore requests for sounds that already terminated
+		if (!chan || chan->getHandle()._val != command.handle)
+			continue;
+
+		switch (command.type) {
+		case kCommandPause:
+			chan->pause(command.value != 0);
+			publishTiming(index);
+			break;
+		case kCommandVolume:
+			chan->setVolume(command.value);
+			break;
+		case kCommandBalance:
+			chan->setBalance(command.value);
+			break;
+		case kCommandRate:
+			chan->setRate(command.value);
+			break;
+		case kCommandResetRate:
+			chan->resetRate();
+			break;
+		case kCommandLoop:
+			chan->loop();
+			break;
+		case kCommandQuality:
+			chan->setRateConverterQuality((RateConverterQuality)command.value);
+			break;
+		default:
+			break;
+		}
+	}
+
+	_commandTail.store(tail, std::memory_order_release);
+}
+
+void MixerImpl::removeChannel(int index) {
+	delete _channels[index];
+	_channels[index] = nullptr;
+	_channelHandles[index].store(SoundHandle()._val, std::memory_order_release);
+}
+
+void MixerImpl::publishTiming(int index) {
+	ChannelTiming &timing = _channelTimings[index];
+	uint32 samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime;
+	_channels[index]->getTiming(samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime);
+
+	const uint32 sequence = timing.sequence.load(std::memory_order_relaxed);
+	timing.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	timing.samplesConsumed.store(samplesConsumed, std::memory_order_relaxed);
+	timing.mixerTimeStamp.store(mixerTimeStamp, std::memory_order_relaxed);
+	timing.pauseStartTime.store(pauseStartTime, std::memory_order_relaxed);
+	timing.pauseTime.store(pauseTime, std::memory_order_relaxed);
+	timing.paused.store(_channels[index]->isPaused(), std::memory_order_relaxed);
+	timing.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan, uint32 streamRate) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == nullptr) {
+		if (_channelHandles[i].load(std::memory_order_acquire) == SoundHandle()._val) {
 			index = i;
 			break;
 		}
@@ -242,8 +446,6 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		return;
 	}
 
-	_channels[index] = chan;
-
 	SoundHandle chanHandle;
 	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
 
@@ -251,6 +453,25 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	ChannelInfo &info = _channelInfo[index];
+	info.id = chan->getId();
+	info.type = chan->getType();
+	info.permanent = chan->isPermanent();
+	info.volume = chan->getVolume();
+	info.balance = chan->getBalance();
+	info.rate = info.streamRate = streamRate;
+
+	// The slot is free, so the mixer does not write its timing
+	ChannelTiming &timing = _channelTimings[index];
+	timing.samplesConsumed = 0;
+	timing.mixerTimeStamp = 0;
+	timing.pauseStartTime = 0;
+	timing.pauseTime = 0;
+	timing.paused = false;
+
+	_channelHandles[index].store(chanHandle._val, std::memory_order_release);
+	queueCommand(kCommandPlay, chanHandle._val, 0, chan);
 }
 
 void MixerImpl::playStream(
@@ -261,7 +482,7 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
 	if (stream == nullptr) {
 		warning("stream is 0");
@@ -274,7 +495,7 @@ void MixerImpl::playStream(
 	// Prevent duplicate sounds
 	if (id != -1) {
 		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != nullptr && _channels[i]->getId() == id) {
+			if (_channelHandles[i] != SoundHandle()._val && _channelInfo[i].id == id) {
 				// Delete the stream if were asked to auto-dispose it.
 				// Note: This could cause trouble if the client code does not
 				// yet expect the stream to be gone. The primary example to
@@ -291,16 +512,21 @@ void MixerImpl::playStream(
 	reverseStereo = !reverseStereo;
 #endif
 
-	// Create the channel
+	// Create the channel. It is only used by the mixer once queued.
+	const uint32 streamRate = stream->getRate();
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
-	insertChannel(handle, chan);
+	chan->setRateConverterQuality(_rateConverterQuality);
+	insertChannel(handle, chan, streamRate);
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_ZONE_LANE("MixerImpl::mixCallback", Common::Profiler::kLaneAudio);
+	const uint64 start = g_system->getMicros();
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -308,8 +534,7 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, len);
+	applyCommands();
 
 	// we store 16-bit samples
 	if (_stereo) {
@@ -320,64 +545,81 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
+	// The channels are mixed with 32 bits per sample and saturated once
+	// at the end, instead of after every channel
+	const uint numSamples = _stereo ? len * 2 : len;
+	if (_mixBuffer.size() < numSamples)
+		_mixBuffer.resize(numSamples);
+	int32 *mixBuf = _mixBuffer.data();
+	memset(mixBuf, 0, numSamples * sizeof(int32));
+
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
+				removeChannel(i);
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				tmp = _channels[i]->mix(mixBuf, len);
+				publishTiming(i);
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	clampSamples(buf, mixBuf, numSamples);
+
+	updateOutputStats(start, len);
+
 	return res;
 }
 
+// Stopping is not queued: once it returns, the streams are not read anymore,
+// so they can be freed.
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	Common::StackLock queueLock(_queueMutex);
+	applyCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && !_channels[i]->isPermanent())
+			removeChannel(i);
 	}
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	Common::StackLock queueLock(_queueMutex);
+	applyCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && _channels[i]->getId() == id)
+			removeChannel(i);
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
+	// Simply ignore stop requests for handles of sounds that already terminated
+	if (findSlot(handle) < 0)
+		return;
+
 	Common::StackLock lock(_mutex);
+	Common::StackLock queueLock(_queueMutex);
+	applyCommands();
 
-	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	removeChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Common::StackLock lock(_queueMutex);
+	_soundTypeSettings[type].mute = mute;
+	queueCommand(kCommandUpdateVolumes, 0, type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
@@ -386,67 +628,98 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index < 0)
 		return;
 
-	_channels[index]->setVolume(volume);
+	_channelInfo[index].volume = volume;
+	queueCommand(kCommandVolume, handle._val, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_queueMutex);
+
+	const int index = findSlot(handle);
+	if (index < 0)
 		return 0;
 
-	return _channels[index]->getVolume();
+	return _channelInfo[index].volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index < 0)
 		return;
 
-	_channels[index]->setBalance(balance);
+	_channelInfo[index].balance = balance;
+	queueCommand(kCommandBalance, handle._val, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_queueMutex);
+
+	const int index = findSlot(handle);
+	if (index < 0)
 		return 0;
 
-	return _channels[index]->getBalance();
+	return _channelInfo[index].balance;
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index < 0)
 		return;
 
-	_channels[index]->setRate(rate);
+	_channelInfo[index].rate = rate;
+	queueCommand(kCommandRate, handle._val, rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_queueMutex);
+
+	const int index = findSlot(handle);
+	if (index < 0)
 		return 0;
-	
-	return _channels[index]->getRate();
+
+	return _channelInfo[index].rate;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index < 0)
 		return;
-	
-	_channels[index]->resetRate();
+
+	_channelInfo[index].rate = _channelInfo[index].streamRate;
+	queueCommand(kCommandResetRate, handle._val);
+}
+
+void MixerImpl::setRateConverterQuality(RateConverterQuality quality) {
+	Common::StackLock lock(_queueMutex);
+
+	_rateConverterQuality = quality;
+	queueCommand(kCommandQualityAll, 0, quality);
+}
+
+RateConverterQuality MixerImpl::getRateConverterQuality() const {
+	Common::StackLock lock(_queueMutex);
+	return _rateConverterQuality;
+}
+
+void MixerImpl::setChannelRateConverterQuality(SoundHandle handle, RateConverterQuality quality) {
+	Common::StackLock lock(_queueMutex);
+
+	if (findSlot(handle) < 0)
+		return;
+
+	queueCommand(kCommandQuality, handle._val, quality);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -454,91 +727,116 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Audio::Timestamp ts(0, _sampleRate);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	const int index = findSlot(handle);
+	if (index < 0)
+		return ts;
+
+	// Read a consistent copy of the timing published by the mixer
+	const ChannelTiming &timing = _channelTimings[index];
+	uint32 sequence, samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime;
+	bool paused;
+	do {
+		sequence = timing.sequence.load(std::memory_order_acquire);
+		samplesConsumed = timing.samplesConsumed.load(std::memory_order_relaxed);
+		mixerTimeStamp = timing.mixerTimeStamp.load(std::memory_order_relaxed);
+		pauseStartTime = timing.pauseStartTime.load(std::memory_order_relaxed);
+		pauseTime = timing.pauseTime.load(std::memory_order_relaxed);
+		paused = timing.paused.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while ((sequence & 1) || timing.sequence.load(std::memory_order_relaxed) != sequence);
+
+	if (mixerTimeStamp == 0)
+		return ts;
+
+	uint32 delta;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
+
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
 
-	return _channels[index]->getElapsedTime();
+	return ts;
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (findSlot(handle) < 0)
 		return;
 
-	_channels[index]->loop();
+	queueCommand(kCommandLoop, handle._val);
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr) {
-			_channels[i]->pause(paused);
-		}
-	}
+	Common::StackLock lock(_queueMutex);
+	queueCommand(kCommandPauseAll, 0, paused);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
+		const uint32 handle = _channelHandles[i].load(std::memory_order_acquire);
+		if (handle != SoundHandle()._val && _channelInfo[i].id == id) {
+			queueCommand(kCommandPause, handle, paused);
 			return;
 		}
 	}
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (findSlot(handle) < 0)
 		return;
 
-	_channels[index]->pause(paused);
+	queueCommand(kCommandPause, handle._val, paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
+	Common::StackLock lock(_queueMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channelHandles[i] != SoundHandle()._val && _channelInfo[i].id == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	Common::StackLock lock(_queueMutex);
+	const int index = findSlot(handle);
+	if (index >= 0)
+		return _channelInfo[index].id;
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return findSlot(handle) >= 0;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channelHandles[i] != SoundHandle()._val && _channelInfo[i].type == type)
 			return true;
 	return false;
 }
@@ -552,13 +850,9 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_queueMutex);
 	_soundTypeSettings[type].volume = volume;
-
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	queueCommand(kCommandUpdateVolumes, 0, type);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
@@ -625,6 +919,11 @@ void Channel::resetRate() {
 	}
 }
 
+void Channel::setRateConverterQuality(RateConverterQuality quality) {
+	if (_converter)
+		_converter->setQuality(quality);
+}
+
 void Channel::updateChannelVolumes() {
 	// From the channel balance/volume and the global volume, we compute
 	// the effective volume for the left and right channel. Note the
@@ -670,32 +969,11 @@ void Channel::pause(bool paused) {
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
-
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
-
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
-
-	return ts;
+void Channel::getTiming(uint32 &samplesConsumed, uint32 &mixerTimeStamp, uint32 &pauseStartTime, uint32 &pauseTime) const {
+	samplesConsumed = _samplesConsumed;
+	mixerTimeStamp = _mixerTimeStamp;
+	pauseStartTime = _pauseStartTime;
+	pauseTime = _pauseTime;
 }
 
 void Channel::loop() {
@@ -707,7 +985,13 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+static st_volume_t rampVolume(st_volume_t volume, st_volume_t target, int step) {
+	if (volume < target)
+		return MIN<int>(volume + step, target);
+	return MAX<int>(volume - step, target);
+}
+
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 
 	int res = 0;
@@ -718,7 +1002,29 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->convert(*_stream, data, len, _volL, _volR);
+
+		// Start at the right volume instead of fading in
+		if (_samplesDecoded == 0) {
+			_mixVolL = _volL;
+			_mixVolR = _volR;
+		}
+
+		const uint channels = _mixer->getOutputStereo() ? 2 : 1;
+		while ((_mixVolL != _volL || _mixVolR != _volR) && (uint)res < len) {
+			_mixVolL = rampVolume(_mixVolL, _volL, kVolumeRampStep);
+			_mixVolR = rampVolume(_mixVolR, _volR, kVolumeRampStep);
+
+			const int block = MIN<uint>(kVolumeRampBlockSize, len - res);
+			const int mixed = _converter->mix(*_stream, data + res * channels, block, _mixVolL, _mixVolR);
+			res += mixed;
+			if (mixed < block) {
+				_samplesDecoded += res;
+				return res;
+			}
+		}
+
+		if ((uint)res < len)
+			res += _converter->mix(*_stream, data + res * channels, len - res, _volL, _volR);
 		_samplesDecoded += res;
 	}
 
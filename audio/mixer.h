@@ -26,6 +26,8 @@
 #include "common/types.h"
 #include "common/noncopyable.h"
 
+#include "audio/rate.h"
+
 namespace Audio {
 
 class AudioStream;
@@ -279,6 +281,28 @@ public:
 	*/
 	virtual void resetChannelRate(SoundHandle handle) = 0;
 
+	/**
+	 * Set the interpolation used to resample the sounds which play at
+	 * another rate than the output, for all sounds including the ones
+	 * started later. Better interpolation costs more CPU time.
+	 *
+	 * @param quality	The new interpolation.
+	 */
+	virtual void setRateConverterQuality(RateConverterQuality quality) = 0;
+
+	/**
+	 * Get the interpolation used for the sounds started from now on.
+	 */
+	virtual RateConverterQuality getRateConverterQuality() const = 0;
+
+	/**
+	 * Set the interpolation used to resample the given sound.
+	 *
+	 * @param handle 	The sound to affect.
+	 * @param quality	The new interpolation.
+	 */
+	virtual void setChannelRateConverterQuality(SoundHandle handle, RateConverterQuality quality) = 0;
+
 	/**
 	 * Get an approximation of for how long the channel has been playing.
 	 */
@@ -343,6 +367,26 @@ public:
 	 * @return The number of samples processed at each audio callback.
 	 */
 	virtual uint getOutputBufSize() const = 0;
+
+	/**
+	 * Timing of the audio output, as measured around the mixer callback.
+	 * All times are in microseconds.
+	 */
+	struct OutputStats {
+		uint bufferSize;          ///< Number of samples mixed by the last callback.
+		uint32 callbacks;         ///< Number of callbacks.
+		uint32 underruns;         ///< Number of callbacks which came too late to keep the output fed.
+		uint32 lastCallbackTime;  ///< Time taken by the last callback.
+		uint32 maxCallbackTime;   ///< Longest time taken by a callback.
+		uint64 totalCallbackTime; ///< Time taken by all callbacks.
+	};
+
+	/**
+	 * Return the timing of the audio output.
+	 *
+	 * @return false if the output is not measured.
+	 */
+	virtual bool getOutputStats(OutputStats &stats) const { return false; }
 };
 
 /** @} */
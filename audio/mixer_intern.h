@@ -23,9 +23,12 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
+#include <atomic>
+
 namespace Audio {
 
 /**
@@ -58,34 +61,147 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		kCommandQueueSize = 256
 	};
 
+	/**
+	 * Held while mixing. Engines lock it through mutex() to keep the mixer
+	 * from reading their streams.
+	 */
 	Common::Mutex _mutex;
 
+	/**
+	 * Serializes the threads which call the Mixer API. It is never held by
+	 * mixCallback(), so they do not wait for the mixing to finish. When
+	 * both are needed, _mutex is locked first.
+	 */
+	Common::Mutex _queueMutex;
+
 	const uint _sampleRate;
 	const bool _stereo;
 	const uint _outBufSize;
-	bool _mixerReady;
+	std::atomic<bool> _mixerReady;
 	uint32 _handleSeed;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		std::atomic<bool> mute;
+		std::atomic<int> volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
+	RateConverterQuality _rateConverterQuality;
+
+	/** The channels, only used while holding _mutex. */
 	Channel *_channels[NUM_CHANNELS];
 
+	/** Buffer the channels are mixed in before saturating the samples */
+	Common::Array<int32> _mixBuffer;
+
+	/**
+	 * Changes to the channels, applied by the mixer at the start of the
+	 * next callback. They are queued while holding _queueMutex and applied
+	 * while holding _mutex, so there is only one producer and one consumer.
+	 */
+	enum CommandType {
+		kCommandPlay,
+		kCommandPause,
+		kCommandPauseAll,
+		kCommandVolume,
+		kCommandBalance,
+		kCommandRate,
+		kCommandResetRate,
+		kCommandLoop,
+		kCommandQuality,
+		kCommandQualityAll,
+		kCommandUpdateVolumes
+	};
+
+	struct Command {
+		CommandType type;
+		uint32 handle;
+		Channel *channel;
+		int value;
+	};
+
+	Command _commands[kCommandQueueSize];
+	std::atomic<uint32> _commandHead;
+	std::atomic<uint32> _commandTail;
+
+	/**
+	 * The handle of the channel in each slot, SoundHandle()._val if the slot
+	 * is free. It is set when a sound is queued to play and reset when the
+	 * mixer removes it, so it can be read at any time.
+	 */
+	std::atomic<uint32> _channelHandles[NUM_CHANNELS];
+
+	/** The settings of the channel in each slot, only used while holding _queueMutex. */
+	struct ChannelInfo {
+		int id;
+		SoundType type;
+		bool permanent;
+		byte volume;
+		int8 balance;
+		uint32 rate;
+		uint32 streamRate;
+	};
+
+	ChannelInfo _channelInfo[NUM_CHANNELS];
+
+	/**
+	 * The play position of the channel in each slot, published by the mixer
+	 * after each callback. The values are consistent when sequence is even
+	 * and has not changed while reading them.
+	 */
+	struct ChannelTiming {
+		std::atomic<uint32> sequence;
+		std::atomic<uint32> samplesConsumed;
+		std::atomic<uint32> mixerTimeStamp;
+		std::atomic<uint32> pauseStartTime;
+		std::atomic<uint32> pauseTime;
+		std::atomic<bool> paused;
+	};
+
+	ChannelTiming _channelTimings[NUM_CHANNELS];
+
+	/** Return the slot of @p handle if it is playing, -1 otherwise. */
+	int findSlot(SoundHandle handle) const;
+
+	/** Queue a command, the caller holds _queueMutex. */
+	void queueCommand(CommandType type, uint32 handle, int value = 0, Channel *channel = nullptr);
+
+	/** Apply the queued commands, the caller holds _mutex. */
+	void applyCommands();
+
+	/** Remove the channel in @p index, the caller holds _mutex. */
+	void removeChannel(int index);
+
+	/** Publish the play position of the channel in @p index. */
+	void publishTiming(int index);
+
+	/**
+	 * Timing of the output, published by mixCallback(). The start of the
+	 * last callback is 0 when the interval to the next one is not measured.
+	 */
+	std::atomic<uint32> _outputBufferSize;
+	std::atomic<uint32> _outputCallbacks;
+	std::atomic<uint32> _outputUnderruns;
+	std::atomic<uint32> _outputLastTime;
+	std::atomic<uint32> _outputMaxTime;
+	std::atomic<uint64> _outputTotalTime;
+	std::atomic<uint64> _lastCallbackStart;
+
+	/** Account for a callback which started at @p start and mixed @p samples samples. */
+	void updateOutputStats(uint64 start, uint samples);
 
 public:
 
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
 
-	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
+	virtual bool isReady() const { return _mixerReady; }
 
 	virtual Common::Mutex &mutex() { return _mutex; }
 
@@ -121,6 +237,9 @@ public:
 	virtual void setChannelRate(SoundHandle handle, uint32 rate);
 	virtual uint32 getChannelRate(SoundHandle handle);
 	virtual void resetChannelRate(SoundHandle handle);
+	virtual void setRateConverterQuality(RateConverterQuality quality);
+	virtual RateConverterQuality getRateConverterQuality() const;
+	virtual void setChannelRateConverterQuality(SoundHandle handle, RateConverterQuality quality);
 
 	virtual uint32 getSoundElapsedTime(SoundHandle handle);
 	virtual Timestamp getElapsedTime(SoundHandle handle);
@@ -135,9 +254,10 @@ public:
 	virtual uint getOutputRate() const;
 	virtual bool getOutputStereo() const;
 	virtual uint getOutputBufSize() const;
+	virtual bool getOutputStats(OutputStats &stats) const;
 
 protected:
-	void insertChannel(SoundHandle *handle, Channel *chan);
+	void insertChannel(SoundHandle *handle, Channel *chan, uint32 streamRate);
 
 public:
 	/**
@@ -151,6 +271,15 @@ public:
 	 */
 	int mixCallback(byte *samples, uint len);
 
+	/** Reset the statistics returned by getOutputStats(). */
+	void resetOutputStats();
+
+	/**
+	 * Do not count the time until the next callback as an underrun.
+	 * Backends call this after they stopped or reopened the output.
+	 */
+	void restartOutputTiming() { _lastCallbackStart = 0; }
+
 	/**
 	 * Set the internal 'is ready' flag of the mixer.
 	 * Backends should invoke Mixer::setReady(true) once initialisation of
@@ -1194,14 +1194,22 @@ void ModXmS3mStream::resample(const Channel &channel, int *mixBuf, int offset, i
 						break;
 					}
 				}
-				c = sampleData[samIdx];
-				m = sampleData[samIdx + 1] - c;
-				y = ((m * samFra) >> FP_SHIFT) + c;
-				mixBuf[outIdx++] += (y * lGain) >> FP_SHIFT;
-				mixBuf[outIdx++] += (y * rGain) >> FP_SHIFT;
-				samFra += step;
-				samIdx += samFra >> FP_SHIFT;
-				samFra &= FP_MASK;
+				// Mix the whole run up to the loop end without checking it for every sample
+				int frames = (outEnd - outIdx) >> 1;
+				if (step > 0) {
+					const int64 distance = ((int64)(loopEnd - samIdx) << FP_SHIFT) - samFra;
+					frames = (int)MIN<int64>(frames, (distance + step - 1) / step);
+				}
+				for (; frames > 0; --frames) {
+					c = sampleData[samIdx];
+					m = sampleData[samIdx + 1] - c;
+					y = ((m * samFra) >> FP_SHIFT) + c;
+					mixBuf[outIdx++] += (y * lGain) >> FP_SHIFT;
+					mixBuf[outIdx++] += (y * rGain) >> FP_SHIFT;
+					samFra += step;
+					samIdx += samFra >> FP_SHIFT;
+					samFra &= FP_MASK;
+				}
 			}
 		} else {
 			while (outIdx < outEnd) {
@@ -0,0 +1,51 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MODS_PAULA_SIMD_H
+#define AUDIO_MODS_PAULA_SIMD_H
+
+#include "audio/mods/paula.h"
+
+namespace Audio {
+
+/**
+ * Run the first @p counts[voice] samples of each voice in @p samples
+ * through the filters of that voice, in place, and update @p state.
+ * The filter mode must not be kFilterModeNone.
+ */
+typedef void (*FilterVoicesProc)(Paula::FilterState &state, int32 *const samples[Paula::NUM_VOICES], const uint counts[Paula::NUM_VOICES]);
+
+/** Filter the voices one sample at a time, used when no vectorized kernel is available. */
+void filterVoices(Paula::FilterState &state, int32 *const samples[Paula::NUM_VOICES], const uint counts[Paula::NUM_VOICES]);
+
+#ifdef SCUMMVM_SSE2
+void filterVoicesSSE2(Paula::FilterState &state, int32 *const samples[Paula::NUM_VOICES], const uint counts[Paula::NUM_VOICES]);
+#endif
+
+/**
+ * Return the fastest available filter kernel, which runs the filters of
+ * the four voices side by side, or nullptr if there is none.
+ */
+FilterVoicesProc getFilterVoicesProc();
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,126 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mods/paula-simd.h"
+#include "common/util.h"
+
+#include <emmintrin.h>
+
+namespace Audio {
+
+namespace {
+
+/** Compute a * x + b * y, one filter stage of all four voices. */
+inline __m128 stage(__m128 a, __m128 x, __m128 b, __m128 y) {
+	return _mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y));
+}
+
+/**
+ * Add the denormal offset the way the scalar filter does, which adds it
+ * in double precision and rounds the sum back to float.
+ */
+inline __m128 addDenormalOffset(__m128 x) {
+	const __m128d offset = _mm_set1_pd(1E-10);
+	const __m128 lo = _mm_cvtpd_ps(_mm_add_pd(_mm_cvtps_pd(x), offset));
+	const __m128 hi = _mm_cvtpd_ps(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), offset));
+	return _mm_movelh_ps(lo, hi);
+}
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 loadState(const Paula::FilterState &state, int stage) {
+	return _mm_set_ps(state.rc[3][stage], state.rc[2][stage], state.rc[1][stage], state.rc[0][stage]);
+}
+
+inline void storeState(Paula::FilterState &state, int stage, __m128 rc) {
+	float values[4];
+	_mm_storeu_ps(values, rc);
+	for (int voice = 0; voice < Paula::NUM_VOICES; ++voice)
+		state.rc[voice][stage] = values[voice];
+}
+
+} // End of anonymous namespace
+
+void filterVoicesSSE2(Paula::FilterState &state, int32 *const samples[Paula::NUM_VOICES], const uint counts[Paula::NUM_VOICES]) {
+	uint maxCount = 0;
+	for (int voice = 0; voice < Paula::NUM_VOICES; ++voice)
+		maxCount = MAX(maxCount, counts[voice]);
+	if (!maxCount)
+		return;
+
+	const bool a500 = state.mode == Paula::kFilterModeA500;
+	const __m128 a0 = _mm_set1_ps(state.a0[0]), b0 = _mm_set1_ps(1 - state.a0[0]);
+	const __m128 a1 = _mm_set1_ps(state.a0[1]), b1 = _mm_set1_ps(1 - state.a0[1]);
+	const __m128 a2 = _mm_set1_ps(state.a0[2]), b2 = _mm_set1_ps(1 - state.a0[2]);
+	const __m128 led = _mm_castsi128_ps(_mm_set1_epi32(state.ledFilter ? -1 : 0));
+	const __m128i countsVec = _mm_set_epi32(counts[3], counts[2], counts[1], counts[0]);
+	__m128 rc[5];
+	for (int i = 0; i < 5; ++i)
+		rc[i] = loadState(state, i);
+
+	for (uint i = 0; i < maxCount; ++i) {
+		// Voices with fewer samples keep their state once they are done
+		const __m128 active = _mm_castsi128_ps(_mm_cmpgt_epi32(countsVec, _mm_set1_epi32(i)));
+		int32 in[4];
+		for (int voice = 0; voice < Paula::NUM_VOICES; ++voice)
+			in[voice] = i < counts[voice] ? samples[voice][i] : 0;
+		const __m128 input = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)in));
+
+		__m128 output;
+		if (a500) {
+			const __m128 rc0 = addDenormalOffset(stage(a0, input, b0, rc[0]));
+			const __m128 rc1 = stage(a1, rc0, b1, rc[1]);
+			const __m128 rc2 = stage(a2, rc1, b2, rc[2]);
+			const __m128 rc3 = stage(a2, rc2, b2, rc[3]);
+			const __m128 rc4 = stage(a2, rc3, b2, rc[4]);
+			output = select(led, rc4, rc1);
+			rc[0] = select(active, rc0, rc[0]);
+			rc[1] = select(active, rc1, rc[1]);
+			rc[2] = select(active, rc2, rc[2]);
+			rc[3] = select(active, rc3, rc[3]);
+			rc[4] = select(active, rc4, rc[4]);
+		} else {
+			const __m128 rc1 = addDenormalOffset(stage(a2, input, b2, rc[1]));
+			const __m128 rc2 = stage(a2, rc1, b2, rc[2]);
+			const __m128 rc3 = stage(a2, rc2, b2, rc[3]);
+			output = select(led, rc3, input);
+			rc[1] = select(active, rc1, rc[1]);
+			rc[2] = select(active, rc2, rc[2]);
+			rc[3] = select(active, rc3, rc[3]);
+		}
+
+		// Truncate and saturate to 16 bits, then widen back
+		const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(output), _mm_setzero_si128());
+		int32 out[4];
+		_mm_storeu_si128((__m128i *)out, _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+		for (int voice = 0; voice < Paula::NUM_VOICES; ++voice) {
+			if (i < counts[voice])
+				samples[voice][i] = out[voice];
+		}
+	}
+
+	for (int i = 0; i < 5; ++i)
+		storeState(state, i, rc[i]);
+}
+
+} // End of namespace Audio
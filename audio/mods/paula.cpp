@@ -37,6 +37,7 @@
 
 #include "audio/mixer.h"
 #include "audio/mods/paula.h"
+#include "audio/mods/paula-simd.h"
 #include "audio/null.h"
 
 namespace Audio {
@@ -98,85 +99,36 @@ int Paula::readBuffer(int16 *buffer, const int numSamples) {
 		return readBufferIntern<false>(buffer, numSamples);
 }
 
-/* Denormals are very small floating point numbers that force FPUs into slow
- * mode. All lowpass filters using floats are suspectible to denormals unless
- * a small offset is added to avoid very small floating point numbers.
+/**
+ * Store the unfiltered samples of a voice to @p out and return how many
+ * were stored. It stops at the end of the sample data.
  */
-#define DENORMAL_OFFSET (1E-10)
-
-/* Based on UAE.
- * Original comment in UAE:
- *
- * Amiga has two separate filtering circuits per channel, a static RC filter
- * on A500 and the LED filter. This code emulates both.
- *
- * The Amiga filtering circuitry depends on Amiga model. Older Amigas seem
- * to have a 6 dB/oct RC filter with cutoff frequency such that the -6 dB
- * point for filter is reached at 6 kHz, while newer Amigas have no filtering.
- *
- * The LED filter is complicated, and we are modelling it with a pair of
- * RC filters, the other providing a highboost. The LED starts to cut
- * into signal somewhere around 5-6 kHz, and there's some kind of highboost
- * in effect above 12 kHz. Better measurements are required.
- *
- * The current filtering should be accurate to 2 dB with the filter on,
- * and to 1 dB with the filter off.
- */
-inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
-	float normalOutput, ledOutput;
-
-	switch (state.mode) {
-	case Paula::kFilterModeA500:
-		state.rc[voice][0] = state.a0[0] * input + (1 - state.a0[0]) * state.rc[voice][0] + DENORMAL_OFFSET;
-		state.rc[voice][1] = state.a0[1] * state.rc[voice][0] + (1-state.a0[1]) * state.rc[voice][1];
-		normalOutput = state.rc[voice][1];
-
-		state.rc[voice][2] = state.a0[2] * normalOutput        + (1 - state.a0[2]) * state.rc[voice][2];
-		state.rc[voice][3] = state.a0[2] * state.rc[voice][2]  + (1 - state.a0[2]) * state.rc[voice][3];
-		state.rc[voice][4] = state.a0[2] * state.rc[voice][3]  + (1 - state.a0[2]) * state.rc[voice][4];
-
-		ledOutput = state.rc[voice][4];
-		break;
-
-	case Paula::kFilterModeA1200:
-		normalOutput = input;
-
-		state.rc[voice][1] = state.a0[2] * normalOutput        + (1 - state.a0[2]) * state.rc[voice][1] + DENORMAL_OFFSET;
-		state.rc[voice][2] = state.a0[2] * state.rc[voice][1]  + (1 - state.a0[2]) * state.rc[voice][2];
-		state.rc[voice][3] = state.a0[2] * state.rc[voice][2]  + (1 - state.a0[2]) * state.rc[voice][3];
-
-		ledOutput = state.rc[voice][3];
-		break;
-
-	case Paula::kFilterModeNone:
-	default:
-		return input;
+inline uint fetchSamples(int32 *out, const int8 *data, Paula::Offset &offset, frac_t rate, uint neededSamples, uint bufSize, byte volume) {
+	uint samples;
+	for (samples = 0; samples < neededSamples && offset.int_off < bufSize; ++samples) {
+		out[samples] = ((int32) data[offset.int_off]) * volume;
 
+		// Step to next source sample
+		offset.rem_off += rate;
+		if (offset.rem_off >= (frac_t)FRAC_ONE) {
+			offset.int_off += fracToInt(offset.rem_off);
+			offset.rem_off &= FRAC_LO_MASK;
+		}
 	}
 
-	return CLIP<int32>(state.ledFilter ? ledOutput : normalOutput, -32768, 32767);
+	return samples;
 }
 
 template<bool stereo>
-inline int mixBuffer(int16 *&buf, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume, byte panning, Paula::FilterState &filterState, int voice) {
-	int samples;
-	for (samples = 0; samples < neededSamples && offset.int_off < bufSize; ++samples) {
-		const int32 tmp = filter(((int32) data[offset.int_off]) * volume, filterState, voice);
+inline void mixSamples(int16 *buf, const int32 *samples, uint count, byte panning) {
+	for (uint i = 0; i < count; ++i) {
+		const int32 tmp = samples[i];
 		if (stereo) {
 			*buf++ += (tmp * (255 - panning)) >> 7;
 			*buf++ += (tmp * (panning)) >> 7;
 		} else
 			*buf++ += tmp;
-
-		// Step to next source sample
-		offset.rem_off += rate;
-		if (offset.rem_off >= (frac_t)FRAC_ONE) {
-			offset.int_off += fracToInt(offset.rem_off);
-			offset.rem_off &= FRAC_LO_MASK;
-		}
 	}
-
-	return samples;
 }
 
 template<bool stereo>
@@ -195,8 +147,21 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 		// of course, but we may stop earlier when an 'interrupt' is expected.
 		const uint nSamples = MIN((uint)samples, _curInt);
 
+		// The voices are rendered in three passes over the whole block: the
+		// samples of each voice are fetched first, then the filters of all
+		// voices run side by side and finally the voices are mixed.
+		int32 *voiceSamples[NUM_VOICES];
+		uint counts[NUM_VOICES];
+		// Samples mixed before the channel interrupt and panning on both sides of it
+		uint splits[NUM_VOICES];
+		byte pannings[NUM_VOICES][2];
+
 		// Loop over the four channels of the emulated Paula chip
 		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			voiceSamples[voice] = nullptr;
+			counts[voice] = 0;
+			splits[voice] = 0;
+
 			// No data, or paused -> skip channel
 			if (!_voice[voice].data || (_voice[voice].period <= 0))
 				continue;
@@ -213,19 +178,26 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 
 
 			Channel &ch = _voice[voice];
-			int16 *p = buffer;
-			int neededSamples = nSamples;
+			if (_voiceSamples[voice].size() < nSamples)
+				_voiceSamples[voice].resize(nSamples);
+			int32 *p = voiceSamples[voice] = _voiceSamples[voice].begin();
+			uint neededSamples = nSamples;
+			uint count;
 
 			// NOTE: A Protracker (or other module format) player might actually
 			// push the offset past the sample length in its interrupt(), in which
-			// case the first mixBuffer() call should not mix anything, and the loop
+			// case the first fetchSamples() call should not fetch anything, and the loop
 			// should be triggered.
 			// Thus, doing an assert(ch.offset.int_off < ch.length) here is wrong.
 			// An example where this happens is a certain Protracker module played
 			// by the OS/2 version of Hopkins FBI.
 
-			// Mix the generated samples into the output buffer
-			neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+			// Fetch the samples to generate
+			count = fetchSamples(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume);
+			neededSamples -= count;
+			p += count;
+			splits[voice] = count;
+			pannings[voice][0] = ch.panning;
 
 			// Wrap around if necessary
 			if (ch.offset.int_off >= ch.length) {
@@ -250,13 +222,16 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 				if (ch.interrupt)
 					interruptChannel(voice);
 			}
+			pannings[voice][1] = ch.panning;
 
 			// If we have not yet generated enough samples, and looping is active: loop!
 			if (neededSamples > 0 && ch.length > 2) {
 				// Repeat as long as necessary.
 				while (neededSamples > 0) {
-					// Mix the generated samples into the output buffer
-					neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+					// Fetch the samples to generate
+					count = fetchSamples(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume);
+					neededSamples -= count;
+					p += count;
 
 					if (ch.offset.int_off >= ch.length) {
 						// Wrap around. See also the note above.
@@ -266,7 +241,24 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 				}
 			}
 
+			counts[voice] = nSamples - neededSamples;
+		}
+
+		if (_filterState.mode != kFilterModeNone) {
+			const FilterVoicesProc filterProc = getFilterVoicesProc();
+			(filterProc ? filterProc : filterVoices)(_filterState, voiceSamples, counts);
+		}
+
+		// Mix the generated samples into the output buffer
+		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			if (!counts[voice])
+				continue;
+
+			const uint split = splits[voice];
+			mixSamples<stereo>(buffer, voiceSamples[voice], split, pannings[voice][0]);
+			mixSamples<stereo>(buffer + (stereo ? split * 2 : split), voiceSamples[voice] + split, counts[voice] - split, pannings[voice][1]);
 		}
+
 		buffer += stereo ? nSamples * 2 : nSamples;
 		_curInt -= nSamples;
 		samples -= nSamples;
@@ -23,6 +23,7 @@
 #define AUDIO_MODS_PAULA_H
 
 #include "audio/audiostream.h"
+#include "common/array.h"
 #include "common/frac.h"
 #include "common/mutex.h"
 
@@ -221,6 +222,8 @@ protected:
 
 private:
 	Channel _voice[NUM_VOICES];
+	/** Samples of the voices being rendered, before they are mixed */
+	Common::Array<int32> _voiceSamples[NUM_VOICES];
 
 	const bool _stereo;
 	const int _rate;
@@ -6,6 +6,7 @@ MODULE_OBJS := \
 	audiostream.o \
 	casio.o \
 	cms.o \
+	decoded_cache.o \
 	fmopl.o \
 	mididrv.o \
 	mididrv_ms.o \
@@ -51,10 +52,12 @@ MODULE_OBJS := \
 	mods/module_mod_xm_s3m.o \
 	mods/protracker.o \
 	mods/paula.o \
+	mods/paula-filter.o \
 	mods/rjp1.o \
 	mods/soundfx.o \
 	mods/tfmx.o \
 	softsynth/cms.o \
+	softsynth/emumidi.o \
 	softsynth/opl/dbopl.o \
 	softsynth/opl/dosbox.o \
 	softsynth/opl/mame.o \
@@ -109,5 +112,24 @@ MODULE_OBJS += \
 	rwopl3.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	mods/paula-sse2.o \
+	rate-sse2.o
+$(MODULE)/mods/paula-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/rate-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	rate-avx2.o
+$(MODULE)/rate-avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	rate-neon.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
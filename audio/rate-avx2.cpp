@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/rate-simd.h"
+#include "common/util.h"
+
+#include <immintrin.h>
+
+namespace Audio {
+
+namespace {
+
+/** Multiply by the volumes and divide by Mixer::kMaxMixerVolume, rounding towards zero. */
+inline void scaleAdd(int32 *out, __m128i in, __m256i vol) {
+	__m256i p = _mm256_mullo_epi32(_mm256_cvtepi16_epi32(in), vol);
+	p = _mm256_srai_epi32(_mm256_add_epi32(p, _mm256_srli_epi32(_mm256_srai_epi32(p, 31), 24)), 8);
+	_mm256_storeu_si256((__m256i *)out, _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)out), p));
+}
+
+inline void mixFrame(int32 *out, st_sample_t inL, st_sample_t inR, int volL, int volR) {
+	out[0] += (inL * volL) / 256;
+	out[1] += (inR * volR) / 256;
+}
+
+void mixStereoAVX2(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set_epi32(volR, volL, volR, volL, volR, volL, volR, volL);
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		scaleAdd(out + i * 2, _mm_loadu_si128((const __m128i *)(in + i * 2)), vol);
+		scaleAdd(out + i * 2 + 8, _mm_loadu_si128((const __m128i *)(in + i * 2 + 8)), vol);
+	}
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i * 2], in[i * 2 + 1], volL, volR);
+}
+
+void mixMonoAVX2(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set_epi32(volR, volL, volR, volL, volR, volL, volR, volL);
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(in + i));
+		scaleAdd(out + i * 2, _mm_unpacklo_epi16(s, s), vol);
+		scaleAdd(out + i * 2 + 8, _mm_unpackhi_epi16(s, s), vol);
+	}
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i], in[i], volL, volR);
+}
+
+void clampSamplesAVX2(st_sample_t *out, const int32 *in, uint count) {
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i a = _mm256_loadu_si256((const __m256i *)(in + i));
+		const __m256i b = _mm256_loadu_si256((const __m256i *)(in + i + 8));
+		// The packing works on each half, put the samples back in order
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+		_mm256_storeu_si256((__m256i *)(out + i), packed);
+	}
+	for (; i < count; ++i)
+		out[i] = (st_sample_t)CLIP<int32>(in[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+int32 dotProductAVX2(const st_sample_t *in, const int16 *coefs, uint count) {
+	__m256i sum = _mm256_setzero_si256();
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i a = _mm256_loadu_si256((const __m256i *)(in + i));
+		const __m256i b = _mm256_loadu_si256((const __m256i *)(coefs + i));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, b));
+	}
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	if (i < count) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(in + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(coefs + i));
+		half = _mm_add_epi32(half, _mm_madd_epi16(a, b));
+	}
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(half);
+}
+
+} // End of anonymous namespace
+
+const MixProcs mixProcsAVX2 = {
+	mixStereoAVX2,
+	mixMonoAVX2,
+	clampSamplesAVX2,
+	dotProductAVX2
+};
+
+} // End of namespace Audio
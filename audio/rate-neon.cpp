@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/rate-simd.h"
+#include "common/util.h"
+
+#include <arm_neon.h>
+
+namespace Audio {
+
+namespace {
+
+/** Divide by Mixer::kMaxMixerVolume, rounding towards zero. */
+inline int32x4_t divideVolume(int32x4_t p) {
+	const uint32x4_t bias = vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 24);
+	return vshrq_n_s32(vaddq_s32(p, vreinterpretq_s32_u32(bias)), 8);
+}
+
+inline void scaleAdd(int32 *out, int16x8_t in, int16x8_t vol) {
+	const int32x4_t p0 = divideVolume(vmull_s16(vget_low_s16(in), vget_low_s16(vol)));
+	const int32x4_t p1 = divideVolume(vmull_s16(vget_high_s16(in), vget_high_s16(vol)));
+	vst1q_s32(out, vaddq_s32(vld1q_s32(out), p0));
+	vst1q_s32(out + 4, vaddq_s32(vld1q_s32(out + 4), p1));
+}
+
+inline int16x8_t stereoVolume(st_volume_t volL, st_volume_t volR) {
+	const int16x4_t pair = vreinterpret_s16_s32(vdup_n_s32((int32)(uint32)(volL | (volR << 16))));
+	return vcombine_s16(pair, pair);
+}
+
+inline void mixFrame(int32 *out, st_sample_t inL, st_sample_t inR, int volL, int volR) {
+	out[0] += (inL * volL) / 256;
+	out[1] += (inR * volR) / 256;
+}
+
+void mixStereoNEON(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const int16x8_t vol = stereoVolume(volL, volR);
+	uint i = 0;
+	for (; i + 4 <= frames; i += 4)
+		scaleAdd(out + i * 2, vld1q_s16(in + i * 2), vol);
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i * 2], in[i * 2 + 1], volL, volR);
+}
+
+void mixMonoNEON(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const int16x8_t vol = stereoVolume(volL, volR);
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const int16x8_t s = vld1q_s16(in + i);
+		const int16x8x2_t pairs = vzipq_s16(s, s);
+		scaleAdd(out + i * 2, pairs.val[0], vol);
+		scaleAdd(out + i * 2 + 8, pairs.val[1], vol);
+	}
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i], in[i], volL, volR);
+}
+
+void clampSamplesNEON(st_sample_t *out, const int32 *in, uint count) {
+	uint i = 0;
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vld1q_s32(in + i)), vqmovn_s32(vld1q_s32(in + i + 4))));
+	for (; i < count; ++i)
+		out[i] = (st_sample_t)CLIP<int32>(in[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+int32 dotProductNEON(const st_sample_t *in, const int16 *coefs, uint count) {
+	int32x4_t sum = vdupq_n_s32(0);
+	for (uint i = 0; i < count; i += 8) {
+		const int16x8_t a = vld1q_s16(in + i);
+		const int16x8_t b = vld1q_s16(coefs + i);
+		sum = vmlal_s16(sum, vget_low_s16(a), vget_low_s16(b));
+		sum = vmlal_s16(sum, vget_high_s16(a), vget_high_s16(b));
+	}
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+} // End of anonymous namespace
+
+const MixProcs mixProcsNEON = {
+	mixStereoNEON,
+	mixMonoNEON,
+	clampSamplesNEON,
+	dotProductNEON
+};
+
+} // End of namespace Audio
@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_SIMD_H
+#define AUDIO_RATE_SIMD_H
+
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * Add @p frames frames of @p in with the volume applied to the stereo
+ * buffer @p out, as done by the rate converters without resampling:
+ *
+ *   out[2 * i]     += inL * volL / Mixer::kMaxMixerVolume
+ *   out[2 * i + 1] += inR * volR / Mixer::kMaxMixerVolume
+ *
+ * where inL and inR are the same sample for a mono input. The division
+ * rounds towards zero and the volumes are at most Mixer::kMaxMixerVolume.
+ */
+typedef void (*MixFramesProc)(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+
+/**
+ * Store @p count mixed samples of @p in to @p out, saturated to 16 bits.
+ */
+typedef void (*ClampSamplesProc)(st_sample_t *out, const int32 *in, uint count);
+
+/**
+ * Return the sum of the products of @p count samples of @p in and
+ * @p coefs. @p count is a multiple of 8.
+ */
+typedef int32 (*DotProductProc)(const st_sample_t *in, const int16 *coefs, uint count);
+
+struct MixProcs {
+	MixFramesProc mixStereo;
+	MixFramesProc mixMono;
+	ClampSamplesProc clamp;
+	DotProductProc dotProduct;
+};
+
+#ifdef SCUMMVM_SSE2
+extern const MixProcs mixProcsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+extern const MixProcs mixProcsAVX2;
+#endif
+#ifdef SCUMMVM_NEON
+extern const MixProcs mixProcsNEON;
+#endif
+
+/**
+ * Return the fastest available mixing kernels, or nullptr if there are no
+ * vectorized ones.
+ */
+const MixProcs *getMixProcs();
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/rate-simd.h"
+#include "common/util.h"
+
+#include <emmintrin.h>
+
+namespace Audio {
+
+namespace {
+
+/** Multiply by the volumes and divide by Mixer::kMaxMixerVolume, rounding towards zero. */
+inline void scaleAdd(int32 *out, __m128i in, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(in, vol);
+	const __m128i hi = _mm_mulhi_epi16(in, vol);
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 24)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 24)), 8);
+	_mm_storeu_si128((__m128i *)out, _mm_add_epi32(_mm_loadu_si128((const __m128i *)out), p0));
+	_mm_storeu_si128((__m128i *)(out + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(out + 4)), p1));
+}
+
+inline void mixFrame(int32 *out, st_sample_t inL, st_sample_t inR, int volL, int volR) {
+	out[0] += (inL * volL) / 256;
+	out[1] += (inR * volR) / 256;
+}
+
+void mixStereoSSE2(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+	uint i = 0;
+	for (; i + 4 <= frames; i += 4)
+		scaleAdd(out + i * 2, _mm_loadu_si128((const __m128i *)(in + i * 2)), vol);
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i * 2], in[i * 2 + 1], volL, volR);
+}
+
+void mixMonoSSE2(int32 *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(in + i));
+		scaleAdd(out + i * 2, _mm_unpacklo_epi16(s, s), vol);
+		scaleAdd(out + i * 2 + 8, _mm_unpackhi_epi16(s, s), vol);
+	}
+	for (; i < frames; ++i)
+		mixFrame(out + i * 2, in[i], in[i], volL, volR);
+}
+
+void clampSamplesSSE2(st_sample_t *out, const int32 *in, uint count) {
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(in + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(in + i + 4));
+		_mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(a, b));
+	}
+	for (; i < count; ++i)
+		out[i] = (st_sample_t)CLIP<int32>(in[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+int32 dotProductSSE2(const st_sample_t *in, const int16 *coefs, uint count) {
+	__m128i sum = _mm_setzero_si128();
+	for (uint i = 0; i < count; i += 8) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(in + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(coefs + i));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+	}
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+} // End of anonymous namespace
+
+const MixProcs mixProcsSSE2 = {
+	mixStereoSSE2,
+	mixMonoSSE2,
+	clampSamplesSSE2,
+	dotProductSSE2
+};
+
+} // End of namespace Audio
@@ -29,7 +29,10 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate-simd.h"
 #include "audio/mixer.h"
+#include "common/array.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -45,6 +48,162 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+namespace {
+
+inline bool hasCpuFeature(OSystem::Feature f) {
+	return g_system && g_system->hasFeature(f);
+}
+
+/** Adds a sample to a 16-bit output buffer, saturating it. */
+inline void mixSample(st_sample_t &a, int b) {
+	clampedAdd(a, b);
+}
+
+/** Adds a sample to a 32-bit mixing buffer, it is saturated later. */
+inline void mixSample(int32 &a, int b) {
+	a += b;
+}
+
+/** There are no kernels for 16-bit output buffers. */
+inline bool mixFrames(const MixProcs *, st_sample_t *, const st_sample_t *, uint, bool, st_volume_t, st_volume_t) {
+	return false;
+}
+
+inline bool mixFrames(const MixProcs *procs, int32 *out, const st_sample_t *in, uint frames, bool inStereo, st_volume_t volL, st_volume_t volR) {
+	if (!procs)
+		return false;
+	(inStereo ? procs->mixStereo : procs->mixMono)(out, in, frames, volL, volR);
+	return true;
+}
+
+inline int32 dotProduct(const MixProcs *procs, const st_sample_t *in, const int16 *coefs, uint count) {
+	if (procs)
+		return procs->dotProduct(in, coefs, count);
+
+	int32 sum = 0;
+	for (uint i = 0; i < count; ++i)
+		sum += in[i] * coefs[i];
+	return sum;
+}
+
+/**
+ * Coefficients of a windowed sinc low-pass filter, for each of kPhases
+ * positions between two input samples.
+ */
+class SincFilter {
+public:
+	enum {
+		kMaxTaps = 32,
+		kPhases = 256,
+		kCoefBits = 14
+	};
+
+	SincFilter() : _taps(0), _inRate(0), _outRate(0) {}
+
+	/** Compute the coefficients, unless they already are for these rates. */
+	void setup(uint taps, st_rate_t inRate, st_rate_t outRate);
+
+	uint getTaps() const { return _taps; }
+
+	/** Return the coefficients for an output sample at @p frac after the middle input sample. */
+	const int16 *getCoefs(frac_t frac) const {
+		return &_coefs[((frac * kPhases) >> FRAC_BITS_LOW) * _taps];
+	}
+
+	/** Filter the last getTaps() input samples in @p history. */
+	st_sample_t filter(const MixProcs *procs, const st_sample_t *history, const int16 *coefs) const {
+		const int32 sum = dotProduct(procs, history, coefs, _taps);
+		return (st_sample_t)CLIP<int32>((sum + (1 << (kCoefBits - 1))) >> kCoefBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+private:
+	Common::Array<int16> _coefs;
+	uint _taps;
+	st_rate_t _inRate, _outRate;
+};
+
+void SincFilter::setup(uint taps, st_rate_t inRate, st_rate_t outRate) {
+	if (taps == _taps && inRate == _inRate && outRate == _outRate)
+		return;
+
+	_taps = taps;
+	_inRate = inRate;
+	_outRate = outRate;
+	_coefs.resize(kPhases * taps);
+
+	// Keep the frequencies below the lower of both Nyquist frequencies,
+	// with some room for the transition band
+	const double cutoff = 0.9 * MIN<double>(1.0, (double)outRate / inRate);
+
+	for (uint phase = 0; phase < kPhases; ++phase) {
+		const double frac = (double)phase / kPhases;
+		double values[kMaxTaps];
+		double sum = 0.0;
+
+		for (uint i = 0; i < taps; ++i) {
+			// The output sample is between the two middle taps
+			const double x = (double)i - (taps / 2 - 1) - frac;
+			const double t = M_PI * cutoff * x;
+			const double w = 2.0 * M_PI * x / taps;
+			// Blackman window
+			values[i] = (t == 0.0 ? 1.0 : sin(t) / t) * (0.42 + 0.5 * cos(w) + 0.08 * cos(2.0 * w));
+			sum += values[i];
+		}
+
+		// Normalize each phase, so a constant signal keeps its level
+		int16 *coefs = &_coefs[phase * taps];
+		int total = 0;
+		for (uint i = 0; i < taps; ++i) {
+			coefs[i] = (int16)floor(values[i] / sum * (1 << kCoefBits) + 0.5);
+			total += coefs[i];
+		}
+		coefs[taps / 2 - 1 + (phase >= kPhases / 2 ? 1 : 0)] += (1 << kCoefBits) - total;
+	}
+}
+
+} // End of anonymous namespace
+
+const MixProcs *getMixProcs() {
+#ifdef SCUMMVM_AVX2
+	if (hasCpuFeature(OSystem::kCpuFeatureAVX2))
+		return &mixProcsAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return &mixProcsSSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return &mixProcsSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return &mixProcsNEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return &mixProcsNEON;
+#endif
+#endif
+	return nullptr;
+}
+
+void clampSamples(st_sample_t *outBuffer, const int32 *mixBuffer, st_size_t numSamples) {
+	const MixProcs *procs = getMixProcs();
+	if (procs) {
+		procs->clamp(outBuffer, mixBuffer, numSamples);
+	} else {
+		for (st_size_t i = 0; i < numSamples; ++i)
+			outBuffer[i] = (st_sample_t)CLIP<int32>(mixBuffer[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	for (st_size_t i = 0; i < numSamples; ++i)
+		outBuffer[i] ^= 0x8000;
+#endif
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -76,26 +235,54 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
-    int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-    int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-    int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	/** Vectorized kernels for mixing without resampling, nullptr if there are none */
+	const MixProcs *_mixProcs;
+
+	/** Interpolation used when the rates differ */
+	RateConverterQuality _quality;
+
+	SincFilter _sincFilter;
+
+	/**
+	 * The last input samples of each channel for the sinc filter. Every
+	 * sample is stored twice, so the last samples are always in order
+	 * from _sincPos on.
+	 */
+	st_sample_t _sincHistory[2][2 * SincFilter::kMaxTaps];
+	uint _sincPos;
+
+	template<typename SampleType>
+	int convertAny(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename SampleType>
+	int copyConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename SampleType>
+	int simpleConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename SampleType>
+	int interpolateConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename SampleType>
+	int sincConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 
 public:
     RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
     virtual ~RateConverter_Impl() {}
 
     int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+	int mix(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
 
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
 
 	st_rate_t getInputRate() const override { return _inRate; }
 	st_rate_t getOutputRate() const override { return _outRate; }
+
+	void setQuality(RateConverterQuality quality) override { _quality = quality; }
+	RateConverterQuality getQuality() const override { return _quality; }
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
-	st_sample_t *outStart, *outEnd;
+template<typename SampleType>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	SampleType *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -110,6 +297,17 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
+		// Mix as much of the buffer as possible at once with the kernels
+		if (outStereo && !reverseStereo) {
+			const uint frames = MIN<uint>((outEnd - outBuffer) / 2, _bufferSize / (inStereo ? 2 : 1));
+			if (frames > 0 && mixFrames(_mixProcs, outBuffer, _bufferPos, frames, inStereo, volL, volR)) {
+				_bufferPos += frames * (inStereo ? 2 : 1);
+				_bufferSize -= frames * (inStereo ? 2 : 1);
+				outBuffer += frames * 2;
+				continue;
+			}
+		}
+
 		// Mix the data into the output buffer
 		st_sample_t inL, inR;
 		inL = *_bufferPos++;
@@ -122,15 +320,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 
 		if (outStereo) {
 			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			mixSample(outBuffer[reverseStereo    ], outL);
 
 			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			mixSample(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -140,11 +338,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename SampleType>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	SampleType *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -182,15 +381,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 
 		if (outStereo) {
 			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			mixSample(outBuffer[reverseStereo    ], outL);
 
 			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			mixSample(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -199,11 +398,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename SampleType>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	SampleType *outStart, *outEnd;
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
@@ -247,15 +447,89 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 
 			if (outStereo) {
 				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
+				mixSample(outBuffer[reverseStereo    ], outL);
+
+				// Output right channel
+				mixSample(outBuffer[reverseStereo ^ 1], outR);
+
+				outBuffer += 2;
+			} else {
+				// Output mono channel
+				mixSample(outBuffer[0], (outL + outR) / 2);
+
+				outBuffer += 1;
+			}
+
+			// Increment output position
+			_outPosFrac += outPos_inc;
+		}
+	}
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+template<typename SampleType>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::sincConvert(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	const uint taps = _quality == kRateConverterSincHigh ? 32 : 16;
+	if (taps != _sincFilter.getTaps()) {
+		memset(_sincHistory, 0, sizeof(_sincHistory));
+		_sincPos = 0;
+	}
+	_sincFilter.setup(taps, _inRate, _outRate);
+
+	// How much to increment _outPosFrac by
+	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	SampleType *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		// Read enough input samples so that _outPosFrac < 0
+		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+			// Check if we have to refill the buffer
+			if (_bufferSize == 0) {
+				_bufferPos = _buffer;
+				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+				if (_bufferSize <= 0)
+					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+			}
+
+			_bufferSize -= (inStereo ? 2 : 1);
+			_sincHistory[0][_sincPos] = _sincHistory[0][_sincPos + taps] = *_bufferPos++;
+
+			if (inStereo)
+				_sincHistory[1][_sincPos] = _sincHistory[1][_sincPos + taps] = *_bufferPos++;
+
+			_sincPos = (_sincPos + 1) % taps;
+			_outPosFrac -= FRAC_ONE_LOW;
+		}
+
+		// Loop as long as the _outPos trails behind, and as long as there is
+		// still space in the output buffer.
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
+			// Filter
+			const int16 *coefs = _sincFilter.getCoefs(_outPosFrac);
+			st_sample_t inL, inR;
+			inL = _sincFilter.filter(_mixProcs, _sincHistory[0] + _sincPos, coefs);
+			inR = (inStereo ? _sincFilter.filter(_mixProcs, _sincHistory[1] + _sincPos, coefs) : inL);
+
+			st_sample_t outL, outR;
+			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+			if (outStereo) {
+				// Output left channel
+				mixSample(outBuffer[reverseStereo    ], outL);
 
 				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+				mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 				outBuffer += 2;
 			} else {
 				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
+				mixSample(outBuffer[0], (outL + outR) / 2);
 
 				outBuffer += 1;
 			}
@@ -278,14 +552,32 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_inCurL(0),
 	_inCurR(0),
 	_bufferSize(0),
-	_bufferPos(nullptr) {}
+	_bufferPos(nullptr),
+	_mixProcs(getMixProcs()),
+	_quality(kRateConverterLinear),
+	_sincPos(0) {
+	memset(_sincHistory, 0, sizeof(_sincHistory));
+}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
 int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	return convertAny(input, outBuffer, numSamples, volL, volR);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::mix(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	return convertAny(input, outBuffer, numSamples, volL, volR);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+template<typename SampleType>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convertAny(AudioStream &input, SampleType *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
 		return copyConvert(input, outBuffer, numSamples, volL, volR);
+	} else if (_quality != kRateConverterLinear) {
+		return sincConvert(input, outBuffer, numSamples, volL, volR);
 	} else {
 		if ((_inRate % _outRate) == 0 && (_inRate < 65536)) {
 			return simpleConvert(input, outBuffer, numSamples, volL, volR);
@@ -295,20 +587,28 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateConverter *makeRateConverterImpl(st_rate_t inRate, st_rate_t outRate, RateConverterQuality quality) {
+	RateConverter *converter = new RateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+	converter->setQuality(quality);
+	return converter;
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo,
+                                 RateConverterQuality quality) {
     if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return makeRateConverterImpl<true, true, true>(inRate, outRate, quality);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return makeRateConverterImpl<true, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return makeRateConverterImpl<true, false, false>(inRate, outRate, quality);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return makeRateConverterImpl<false, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return makeRateConverterImpl<false, false, false>(inRate, outRate, quality);
 	}
 }
 
@@ -66,6 +66,16 @@ static inline void clampedAdd(int16& a, int b) {
 #endif
 }
 
+/**
+ * The interpolation used when the input and output rates differ. Better
+ * interpolation reduces aliasing at a higher CPU cost.
+ */
+enum RateConverterQuality {
+	kRateConverterLinear,	/**< Linear interpolation, the cheapest. */
+	kRateConverterSincLow,	/**< Windowed sinc interpolation with 16 taps. */
+	kRateConverterSincHigh	/**< Windowed sinc interpolation with 32 taps. */
+};
+
 /**
  * Helper class that handles resampling an AudioStream between an input and output
  * sample rate. Its regular use case is upsampling from the native stream rate
@@ -90,14 +100,47 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream like convert() and add it to a 32-bit
+	 * mixing buffer, which is not saturated. This allows mixing several
+	 * streams and saturating the result only once with clampSamples().
+	 *
+	 * @param input			The AudioStream to read data from.
+	 * @param outBuffer		The buffer that the resampled audio will be added to. Must have size of at least @p numSamples.
+	 * @param numSamples	The desired number of samples to be added to the buffer.
+	 * @param vol_l			Volume for left channel.
+	 * @param vol_r			Volume for right channel.
+	 *
+	 * @return Number of sample pairs added to the buffer.
+	 */
+	virtual int mix(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
 	virtual st_rate_t getInputRate() const = 0;
 	virtual st_rate_t getOutputRate() const = 0;
+
+	/**
+	 * Set the interpolation used when the input and output rates differ.
+	 * This can be changed while converting a stream.
+	 */
+	virtual void setQuality(RateConverterQuality quality) = 0;
+	virtual RateConverterQuality getQuality() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo,
+                                 RateConverterQuality quality = kRateConverterLinear);
+
+/**
+ * Store the samples of a mixing buffer filled with RateConverter::mix()
+ * as output samples, saturating the values which are out of range.
+ *
+ * @param outBuffer		The buffer to write the samples to.
+ * @param mixBuffer		The mixing buffer.
+ * @param numSamples	The number of samples (not sample pairs) to store.
+ */
+void clampSamples(st_sample_t *outBuffer, const int32 *mixBuffer, st_size_t numSamples);
 
 /** @} */
 } // End of namespace Audio
@@ -0,0 +1,234 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+#include "common/algorithm.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace {
+
+/** Maximum amount of frames the render thread generates in one go. */
+const uint32 kRenderAheadChunk = 256;
+
+} // End of anonymous namespace
+
+void MidiDriver_Emulated::renderSamples(int16 *data, int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int len = numSamples / stereoFactor;
+	int step;
+
+	do {
+		step = len;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		if (_renderAhead) {
+			// Stop at the next queued event, so it is played on time
+			const uint32 position = _renderPosition.load(std::memory_order_relaxed);
+			uint32 nextTime;
+			if (dispatchRenderAheadEvents(position, nextTime)) {
+				const int until = (int)(nextTime - position) / stereoFactor;
+				if (step > until)
+					step = until;
+			}
+			_renderPosition.store(position + step * stereoFactor, std::memory_order_relaxed);
+		}
+
+		generateSamples(data, step);
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			_renderInTimer.store(true, std::memory_order_relaxed);
+			if (_timerProc)
+				(*_timerProc)(_timerParam);
+
+			onTimer();
+			_renderInTimer.store(false, std::memory_order_relaxed);
+
+			_nextTick += _samplesPerTick;
+		}
+
+		data += step * stereoFactor;
+		len -= step;
+	} while (len);
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	if (!_renderAhead) {
+		renderSamples(data, numSamples);
+		return numSamples;
+	}
+
+	const uint32 tail = _renderTail.load(std::memory_order_relaxed);
+	const uint32 head = _renderHead.load(std::memory_order_acquire);
+	const uint32 count = MIN<uint32>(head - tail, numSamples);
+	const uint32 offset = tail & (_renderRingSize - 1);
+	const uint32 first = MIN<uint32>(count, _renderRingSize - offset);
+
+	memcpy(data, _renderRing + offset, first * sizeof(int16));
+	memcpy(data + first, _renderRing, (count - first) * sizeof(int16));
+	// The render thread fell behind, which can't be helped any more
+	if (count < (uint32)numSamples)
+		memset(data + count, 0, (numSamples - count) * sizeof(int16));
+
+	_renderTail.store(tail + count, std::memory_order_release);
+	_renderSemaphore->post();
+	return numSamples;
+}
+
+bool MidiDriver_Emulated::startRenderAhead(uint latency) {
+	if (_renderAhead || !latency)
+		return false;
+
+	_renderSemaphore = g_system->createSemaphore(0);
+	if (!_renderSemaphore)
+		return false;
+
+	const uint32 stereoFactor = isStereo() ? 2 : 1;
+	const uint32 frames = MAX<uint32>(getRate() * latency / 1000, kRenderAheadChunk);
+	_renderLatency = frames * stereoFactor;
+	_renderRingSize = Common::nextHigher2(_renderLatency);
+	_renderRing = new int16[_renderRingSize];
+	_renderHead.store(0);
+	_renderTail.store(0);
+	_renderPosition.store(0);
+	_renderQuit.store(false);
+
+	_renderAhead = true;
+	_renderThread = g_system->createThread(renderThreadProc, this, "MidiRenderAhead");
+	if (!_renderThread) {
+		warning("MidiDriver_Emulated: Could not create the render thread");
+		_renderAhead = false;
+		delete _renderSemaphore;
+		_renderSemaphore = nullptr;
+		delete[] _renderRing;
+		_renderRing = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void MidiDriver_Emulated::stopRenderAhead() {
+	if (!_renderAhead)
+		return;
+
+	_renderQuit.store(true);
+	_renderSemaphore->post();
+	_renderThread->join();
+	delete _renderThread;
+	_renderThread = nullptr;
+	delete _renderSemaphore;
+	_renderSemaphore = nullptr;
+	_renderAhead = false;
+
+	delete[] _renderRing;
+	_renderRing = nullptr;
+	for (Common::List<RenderAheadEvent>::iterator i = _renderEvents.begin(); i != _renderEvents.end(); ++i)
+		delete[] i->sysEx;
+	_renderEvents.clear();
+}
+
+void MidiDriver_Emulated::renderThreadProc(void *param) {
+	((MidiDriver_Emulated *)param)->renderAhead();
+}
+
+void MidiDriver_Emulated::renderAhead() {
+	const uint32 chunk = kRenderAheadChunk * (isStereo() ? 2 : 1);
+
+	while (!_renderQuit.load(std::memory_order_acquire)) {
+		const uint32 head = _renderHead.load(std::memory_order_relaxed);
+		const uint32 tail = _renderTail.load(std::memory_order_acquire);
+		const uint32 filled = head - tail;
+		if (filled >= _renderLatency) {
+			_renderSemaphore->wait();
+			continue;
+		}
+
+		// Don't wrap around the end of the ring within one chunk
+		const uint32 offset = head & (_renderRingSize - 1);
+		uint32 count = MIN<uint32>(_renderLatency - filled, chunk);
+		count = MIN<uint32>(count, _renderRingSize - offset);
+
+		renderSamples(_renderRing + offset, count);
+		_renderHead.store(head + count, std::memory_order_release);
+	}
+}
+
+bool MidiDriver_Emulated::dispatchRenderAheadEvents(uint32 position, uint32 &nextTime) {
+	while (true) {
+		RenderAheadEvent event;
+		{
+			Common::StackLock lock(_renderEventMutex);
+			if (_renderEvents.empty())
+				return false;
+			if ((int32)(_renderEvents.front().time - position) > 0) {
+				nextTime = _renderEvents.front().time;
+				return true;
+			}
+			event = _renderEvents.front();
+			_renderEvents.pop_front();
+		}
+
+		// The lock is released, so the synth can queue more events
+		if (event.sysEx) {
+			playRenderAheadSysEx(event.sysEx, event.length);
+			delete[] event.sysEx;
+		} else {
+			playRenderAheadEvent(event.b);
+		}
+	}
+}
+
+bool MidiDriver_Emulated::queueRenderAheadEvent(uint32 b, const byte *sysEx, uint16 length) {
+	if (!_renderAhead)
+		return false;
+
+	RenderAheadEvent event;
+	// Events sent by the timer callback are part of the rendered output
+	// already, others are delayed by the latency so their timing is kept
+	if (_renderInTimer.load(std::memory_order_relaxed))
+		event.time = _renderPosition.load(std::memory_order_relaxed);
+	else
+		event.time = _renderTail.load(std::memory_order_acquire) + _renderLatency;
+	event.b = b;
+	event.sysEx = nullptr;
+	event.length = length;
+	if (sysEx) {
+		event.sysEx = new byte[length ? length : 1];
+		memcpy(event.sysEx, sysEx, length);
+	}
+
+	// Keep the events sorted by time, events with the same time stay in
+	// the order they were sent
+	Common::StackLock lock(_renderEventMutex);
+	Common::List<RenderAheadEvent>::iterator i = _renderEvents.end();
+	while (i != _renderEvents.begin()) {
+		--i;
+		if ((int32)(i->time - event.time) <= 0) {
+			++i;
+			break;
+		}
+	}
+	_renderEvents.insert(i, event);
+	return true;
+}
@@ -25,6 +25,11 @@
 #include "audio/audiostream.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "common/mutex.h"
+#include "common/list.h"
+#include "common/thread.h"
+
+#include <atomic>
 
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
@@ -43,12 +48,82 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	struct RenderAheadEvent {
+		uint32 time;
+		uint32 b;
+		byte *sysEx;
+		uint16 length;
+	};
+
+	bool _renderAhead;
+	Common::ThreadInternal *_renderThread;
+	Common::SemaphoreInternal *_renderSemaphore;
+	std::atomic<bool> _renderQuit;
+	std::atomic<bool> _renderInTimer;
+	int16 *_renderRing;
+	uint32 _renderRingSize;
+	uint32 _renderLatency;
+	// Positions in samples, the ring is filled from _renderTail to _renderHead
+	std::atomic<uint32> _renderHead;
+	std::atomic<uint32> _renderTail;
+	std::atomic<uint32> _renderPosition;
+	Common::Mutex _renderEventMutex;
+	Common::List<RenderAheadEvent> _renderEvents;
+
+	void renderSamples(int16 *data, int numSamples);
+	void renderAhead();
+	bool dispatchRenderAheadEvents(uint32 position, uint32 &nextTime);
+	bool queueRenderAheadEvent(uint32 b, const byte *sysEx, uint16 length);
+	static void renderThreadProc(void *param);
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Render the output on a worker thread, up to @p latency milliseconds
+	 * ahead of the mixer. This keeps expensive synths from causing
+	 * underruns when a single mixer callback takes too long to render.
+	 *
+	 * While this is active, the timer callback and generateSamples() are
+	 * called from the worker thread. MIDI events sent from other threads
+	 * must be passed to queueRenderAheadEvent() by the subclass, and are
+	 * then replayed through playRenderAheadEvent() at the position the
+	 * mixer will reach after the latency has elapsed.
+	 *
+	 * This must be called after open() and before the stream is played.
+	 *
+	 * @return False if the backend can't create threads, in which case
+	 *         the output is rendered in the mixer callback as usual.
+	 */
+	bool startRenderAhead(uint latency);
+
+	/**
+	 * Stop the worker thread started by startRenderAhead(). Subclasses
+	 * must call this after the stream has been stopped and before the
+	 * synth is destroyed.
+	 */
+	void stopRenderAhead();
+
+	bool isRenderingAhead() const { return _renderAhead; }
+
+	/**
+	 * Queue a MIDI event to be played from the render thread.
+	 *
+	 * @return False if the output isn't rendered ahead, in which case the
+	 *         event has to be played right away.
+	 */
+	bool queueRenderAheadEvent(uint32 b) { return queueRenderAheadEvent(b, nullptr, 0); }
+	bool queueRenderAheadSysEx(const byte *msg, uint16 length) { return queueRenderAheadEvent(0, msg, length); }
+
+	/** Play a MIDI event queued with queueRenderAheadEvent(). */
+	virtual void playRenderAheadEvent(uint32 b) {}
+
+	/** Play a SysEx message queued with queueRenderAheadSysEx(). */
+	virtual void playRenderAheadSysEx(const byte *msg, uint16 length) {}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,9 +132,24 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAhead(false),
+		_renderThread(nullptr),
+		_renderSemaphore(nullptr),
+		_renderQuit(false),
+		_renderInTimer(false),
+		_renderRing(nullptr),
+		_renderRingSize(0),
+		_renderLatency(0),
+		_renderHead(0),
+		_renderTail(0),
+		_renderPosition(0),
 		_baseFreq(250) {
 	}
 
+	~MidiDriver_Emulated() override {
+		stopRenderAhead();
+	}
+
 	// MidiDriver API
 	virtual int open() {
 		_isOpen = true;
@@ -87,34 +177,7 @@ public:
 	}
 
 	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	int readBuffer(int16 *data, const int numSamples) override;
 
 	virtual bool endOfData() const {
 		return false;
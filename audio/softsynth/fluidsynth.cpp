@@ -110,6 +110,7 @@ protected:
 	void setStr(const char *name, const char *str);
 
 	void generateSamples(int16 *buf, int len) override;
+	void playRenderAheadEvent(uint32 b) override;
 
 public:
 	MidiDriver_FluidSynth(Audio::Mixer *mixer);
@@ -458,6 +459,7 @@ int MidiDriver_FluidSynth::open() {
 	}
 
 	MidiDriver_Emulated::open();
+	startRenderAhead(ConfMan.getInt("midi_render_ahead"));
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
@@ -470,6 +472,7 @@ void MidiDriver_FluidSynth::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
 
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
@@ -482,6 +485,11 @@ void MidiDriver_FluidSynth::send(uint32 b) {
 	if (!_isOpen)
 		return;
 
+	if (!queueRenderAheadEvent(b))
+		playRenderAheadEvent(b);
+}
+
+void MidiDriver_FluidSynth::playRenderAheadEvent(uint32 b) {
 	midiDriverCommonSend(b);
 
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
@@ -83,6 +83,8 @@ namespace DBOPL {
 #define ENV_MAX		( 511 << ENV_EXTRA )
 #define ENV_LIMIT	( ( 12 * 256) >> ( 3 - ENV_EXTRA ) )
 #define ENV_SILENT( _X_ ) ( (_X_) >= ENV_LIMIT )
+//Amount of samples the envelopes are run ahead of the waves
+#define ENV_BLOCK	64
 
 //Attack/decay/release rate counter shift
 #define RATE_SH		24
@@ -442,6 +444,21 @@ INLINE Bitu Operator::ForwardVolume() {
 }
 
 
+//Run the envelope for a whole block, so it isn't interleaved with the waves
+void Operator::ForwardVolumeBlock( Bit32u* vol, Bitu samples ) {
+	//Off and sustaining envelopes don't change during a block
+	if ( state == OFF || ( state == SUSTAIN && ( reg20 & MASK_SUSTAIN ) ) ) {
+		Bit32u level = (Bit32u)ForwardVolume();
+		for ( Bitu i = 0; i < samples; i++ ) {
+			vol[ i ] = level;
+		}
+		return;
+	}
+	for ( Bitu i = 0; i < samples; i++ ) {
+		vol[ i ] = (Bit32u)ForwardVolume();
+	}
+}
+
 INLINE Bitu Operator::ForwardWave() {
 	waveIndex += waveCurrent;
 	return waveIndex >> WAVE_SH;
@@ -586,7 +603,10 @@ INLINE Bits Operator::GetWave( Bitu index, Bitu vol ) {
 }
 
 INLINE Bits Operator::GetSample( Bits modulation ) {
-	Bitu vol = ForwardVolume();
+	return GetSample( modulation, ForwardVolume() );
+}
+
+INLINE Bits Operator::GetSample( Bits modulation, Bitu vol ) {
 	if ( ENV_SILENT( vol ) ) {
 		//Simply forward the wave
 		waveIndex += waveCurrent;
@@ -918,81 +938,95 @@ Channel* Channel::BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output ) {
 		Op( 4 )->Prepare( chip );
 		Op( 5 )->Prepare( chip );
 	}
-	for ( Bitu i = 0; i < samples; i++ ) {
-		//Early out for percussion handlers
-		if ( mode == sm2Percussion ) {
+	//Early out for percussion handlers
+	if ( mode == sm2Percussion ) {
+		for ( Bitu i = 0; i < samples; i++ ) {
 			GeneratePercussion<false>( chip, output + i );
-			continue;	//Prevent some unitialized value bitching
-		} else if ( mode == sm3Percussion ) {
+		}
+		return ( this + 3 );
+	} else if ( mode == sm3Percussion ) {
+		for ( Bitu i = 0; i < samples; i++ ) {
 			GeneratePercussion<true>( chip, output + i * 2 );
-			continue;	//Prevent some unitialized value bitching
 		}
-
-		//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
-		Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
-		old[0] = old[1];
-		old[1] = Op(0)->GetSample( mod );
-		Bit32s sample;
-		Bit32s out0 = old[0];
-		if ( mode == sm2AM || mode == sm3AM ) {
-			sample = out0 + Op(1)->GetSample( 0 );
-		} else if ( mode == sm2FM || mode == sm3FM ) {
-			sample = Op(1)->GetSample( out0 );
-		} else if ( mode == sm3FMFM ) {
-			Bits next = Op(1)->GetSample( out0 );
-			next = Op(2)->GetSample( next );
-			sample = Op(3)->GetSample( next );
-		} else if ( mode == sm3AMFM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 );
-			next = Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3FMAM ) {
-			sample = Op(1)->GetSample( out0 );
-			Bits next = Op(2)->GetSample( 0 );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3AMAM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 );
-			sample += Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( 0 );
+		return ( this + 3 );
+	}
+	//The envelopes don't depend on the waves, so they are run ahead for a
+	//chunk of samples and the wave loop only has to look up the tables
+	const Bitu opCount = mode > sm4Start ? 4 : 2;
+	Bit32u vol[ 4 ][ ENV_BLOCK ];
+	for ( Bitu start = 0; start < samples; start += ENV_BLOCK ) {
+		const Bitu todo = ( samples - start < ENV_BLOCK ) ? samples - start : ENV_BLOCK;
+		for ( Bitu o = 0; o < opCount; o++ ) {
+			Op( o )->ForwardVolumeBlock( vol[ o ], todo );
 		}
-		switch( mode ) {
-		case sm2AM:
-		case sm2FM:
-			output[ i ] += sample;
-			break;
-		case sm3AM:
-		case sm3FM:
-		case sm3FMFM:
-		case sm3AMFM:
-		case sm3FMAM:
-		case sm3AMAM:
-			output[ i * 2 + 0 ] += sample & maskLeft;
-			output[ i * 2 + 1 ] += sample & maskRight;
-			break;
-		case sm2Percussion:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm3Percussion:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm4Start:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		case sm6Start:
-			// This case was not handled in the DOSBox code either
-			// thus we leave this blank.
-			// TODO: Consider checking this.
-			break;
-		default:
-			break;
+		for ( Bitu j = 0; j < todo; j++ ) {
+			const Bitu i = start + j;
+			//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
+			Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
+			old[0] = old[1];
+			old[1] = Op(0)->GetSample( mod, vol[ 0 ][ j ] );
+			Bit32s sample;
+			Bit32s out0 = old[0];
+			if ( mode == sm2AM || mode == sm3AM ) {
+				sample = out0 + Op(1)->GetSample( 0, vol[ 1 ][ j ] );
+			} else if ( mode == sm2FM || mode == sm3FM ) {
+				sample = Op(1)->GetSample( out0, vol[ 1 ][ j ] );
+			} else if ( mode == sm3FMFM ) {
+				Bits next = Op(1)->GetSample( out0, vol[ 1 ][ j ] );
+				next = Op(2)->GetSample( next, vol[ 2 ][ j ] );
+				sample = Op(3)->GetSample( next, vol[ 3 ][ j ] );
+			} else if ( mode == sm3AMFM ) {
+				sample = out0;
+				Bits next = Op(1)->GetSample( 0, vol[ 1 ][ j ] );
+				next = Op(2)->GetSample( next, vol[ 2 ][ j ] );
+				sample += Op(3)->GetSample( next, vol[ 3 ][ j ] );
+			} else if ( mode == sm3FMAM ) {
+				sample = Op(1)->GetSample( out0, vol[ 1 ][ j ] );
+				Bits next = Op(2)->GetSample( 0, vol[ 2 ][ j ] );
+				sample += Op(3)->GetSample( next, vol[ 3 ][ j ] );
+			} else if ( mode == sm3AMAM ) {
+				sample = out0;
+				Bits next = Op(1)->GetSample( 0, vol[ 1 ][ j ] );
+				sample += Op(2)->GetSample( next, vol[ 2 ][ j ] );
+				sample += Op(3)->GetSample( 0, vol[ 3 ][ j ] );
+			}
+			switch( mode ) {
+			case sm2AM:
+			case sm2FM:
+				output[ i ] += sample;
+				break;
+			case sm3AM:
+			case sm3FM:
+			case sm3FMFM:
+			case sm3AMFM:
+			case sm3FMAM:
+			case sm3AMAM:
+				output[ i * 2 + 0 ] += sample & maskLeft;
+				output[ i * 2 + 1 ] += sample & maskRight;
+				break;
+			case sm2Percussion:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm3Percussion:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm4Start:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			case sm6Start:
+				// This case was not handled in the DOSBox code either
+				// thus we leave this blank.
+				// TODO: Consider checking this.
+				break;
+			default:
+				break;
+			}
 		}
 	}
 	switch( mode ) {
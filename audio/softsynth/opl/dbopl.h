@@ -175,8 +175,10 @@ public:
 	Bit32s RateForward( Bit32u add );
 	Bitu ForwardWave();
 	Bitu ForwardVolume();
+	void ForwardVolumeBlock( Bit32u* vol, Bitu samples );
 
 	Bits GetSample( Bits modulation );
+	Bits GetSample( Bits modulation, Bitu vol );
 	Bits GetWave( Bitu index, Bitu vol );
 public:
 	Operator();
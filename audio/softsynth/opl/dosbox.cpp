@@ -32,6 +32,7 @@
 #include "dbopl.h"
 
 #include "audio/mixer.h"
+#include "audio/rate.h"
 #include "common/system.h"
 #include "common/scummsys.h"
 #include "common/util.h"
@@ -326,6 +327,8 @@ void OPL::generateSamples(int16 *buffer, int length) {
 	if (_type != Config::kOpl2)
 		length >>= 1;
 
+	// The chip renders whole blocks into a 32-bit buffer, which is then
+	// saturated to 16 bits with the mixer's vector kernels.
 	const uint bufferLength = 512;
 	int32 tempBuffer[bufferLength * 2];
 
@@ -334,9 +337,7 @@ void OPL::generateSamples(int16 *buffer, int length) {
 			const uint readSamples = MIN<uint>(length, bufferLength);
 
 			_emulator->GenerateBlock3(readSamples, tempBuffer);
-
-			for (uint i = 0; i < (readSamples << 1); ++i)
-				buffer[i] = tempBuffer[i];
+			Audio::clampSamples(buffer, tempBuffer, readSamples << 1);
 
 			buffer += (readSamples << 1);
 			length -= readSamples;
@@ -346,9 +347,7 @@ void OPL::generateSamples(int16 *buffer, int length) {
 			const uint readSamples = MIN<uint>(length, bufferLength << 1);
 
 			_emulator->GenerateBlock2(readSamples, tempBuffer);
-
-			for (uint i = 0; i < readSamples; ++i)
-				buffer[i] = tempBuffer[i];
+			Audio::clampSamples(buffer, tempBuffer, readSamples);
 
 			buffer += readSamples;
 			length -= readSamples;
@@ -23,21 +23,38 @@
 #include "backends/cloud/cloudmanager.h"
 #include "backends/cloud/downloadrequest.h"
 #include "backends/cloud/id/iddownloadrequest.h"
+#include "backends/networking/curl/connectionmanager.h"
 #include "backends/networking/curl/curljsonrequest.h"
 #include "backends/saves/default/default-saves.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/formats/json.h"
+#include "common/md5.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "gui/saveload-dialog.h"
 
 namespace Cloud {
 
+/**
+ * Callback that tells SavesSyncRequest which of its parallel
+ * transfers the response belongs to.
+ */
+template<typename S> class TransferCallback: public Common::BaseCallback<S> {
+	typedef void(SavesSyncRequest::*TMethod)(uint32, S);
+	SavesSyncRequest *_object;
+	TMethod _method;
+	uint32 _id;
+public:
+	TransferCallback(SavesSyncRequest *object, TMethod method, uint32 id): _object(object), _method(method), _id(id) {}
+	void operator()(S data) { (_object->*_method)(_id, data); }
+};
+
 SavesSyncRequest::SavesSyncRequest(Storage *storage, Storage::BoolCallback callback, Networking::ErrorCallback ecb):
 	Request(nullptr, ecb), _storage(storage), _boolCallback(callback),
-	_workingRequest(nullptr), _ignoreCallback(false), _bytesToDownload(0), _bytesDownloaded(0) {
+	_workingRequest(nullptr), _ignoreCallback(false), _totalFilesToHandle(0), _totalFilesToDownload(0),
+	_nextTransferId(0), _bytesToDownload(0), _bytesDownloaded(0) {
 	start();
 }
 
@@ -45,6 +62,7 @@ SavesSyncRequest::~SavesSyncRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	cancelTransfers();
 	delete _boolCallback;
 }
 
@@ -53,16 +71,17 @@ void SavesSyncRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentDownloadingFile = StorageFile();
-	_currentUploadingFile = "";
+	cancelTransfers();
 	_filesToDownload.clear();
 	_filesToUpload.clear();
 	_localFilesTimestamps.clear();
 	_totalFilesToHandle = 0;
+	_totalFilesToDownload = 0;
 	_ignoreCallback = false;
 
-	//load timestamps
+	//load timestamps and the hashes of what was synced last time
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
+	_syncedFiles = DefaultSaveFileManager::loadSyncedFiles();
 
 	//list saves directory
 	Common::String dir = _storage->savesDirectoryPath();
@@ -91,6 +110,7 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 	//determine which files to download and which files to upload
 	Common::Array<StorageFile> &remoteFiles = response.value;
 	uint64 totalSize = 0;
+	bool timestampsChanged = false;
 	debug(9, "SavesSyncRequest decisions:");
 	for (uint32 i = 0; i < remoteFiles.size(); ++i) {
 		StorageFile &file = remoteFiles[i];
@@ -110,6 +130,14 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 			if (_localFilesTimestamps[name] == file.timestamp())
 				continue;
 
+			//a save written again with the same contents doesn't need a transfer
+			if (_localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP && isUnchangedSinceSync(file)) {
+				debug(9, "- skipping file %s, because its contents haven't changed since the last sync", name.c_str());
+				_localFilesTimestamps[name] = file.timestamp();
+				timestampsChanged = true;
+				continue;
+			}
+
 			//we actually can have some files not only with timestamp < remote
 			//but also with timestamp > remote (when we have been using ANOTHER CLOUD and then switched back)
 			if (_localFilesTimestamps[name] > file.timestamp() || _localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP)
@@ -127,6 +155,8 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 	}
 
 	CloudMan.setStorageUsedSpace(CloudMan.getStorageIndex(), totalSize);
+	if (timestampsChanged)
+		DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
 
 	//upload files which are unavailable in cloud
 	for (Common::HashMap<Common::String, bool>::iterator i = localFileNotAvailableInCloud.begin(); i != localFileNotAvailableInCloud.end(); ++i) {
@@ -160,14 +190,11 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 	} else {
 		debug(9, "nothing to upload");
 	}
+	_totalFilesToDownload = _filesToDownload.size();
 	_totalFilesToHandle = _filesToDownload.size() + _filesToUpload.size();
 
-	//start downloading files
-	if (!_filesToDownload.empty()) {
-		downloadNextFile();
-	} else {
-		uploadNextFile();
-	}
+	//start transferring files
+	startTransfers();
 }
 
 void SavesSyncRequest::directoryListedErrorCallback(Networking::ErrorResponse error) {
@@ -271,108 +298,198 @@ void SavesSyncRequest::directoryCreatedErrorCallback(Networking::ErrorResponse e
 	finishError(error);
 }
 
-void SavesSyncRequest::downloadNextFile() {
-	if (_filesToDownload.empty()) {
-		_currentDownloadingFile = StorageFile("", 0, 0, false); //so getFilesToDownload() would return an empty array
-		uploadNextFile();
-		return;
+void SavesSyncRequest::startTransfers() {
+	//downloads go first, then uploads fill the free slots
+	while (_state != Networking::FINISHED && _transfers.size() < Networking::ConnectionManager::getMaxConcurrentTransfers()) {
+		if (!_filesToDownload.empty())
+			startDownload();
+		else if (!_filesToUpload.empty())
+			startUpload();
+		else
+			break;
 	}
 
-	_currentDownloadingFile = _filesToDownload.back();
-	_filesToDownload.pop_back();
+	if (_state != Networking::FINISHED && _transfers.empty())
+		finishSync(true);
+}
 
-	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", _currentDownloadingFile.name().c_str(), (int)(getProgress() * 100));
-	_workingRequest = _storage->downloadById(
-		_currentDownloadingFile.id(),
-		DefaultSaveFileManager::concatWithSavesPath(_currentDownloadingFile.name()),
-		new Common::Callback<SavesSyncRequest, Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback),
-		new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileDownloadedErrorCallback)
-	);
-	if (!_workingRequest)
-		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFile: Storage couldn't create Request to download a file"));
+void SavesSyncRequest::cancelTransfers() {
+	bool ignoreCallback = _ignoreCallback;
+	_ignoreCallback = true;
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		if (_transfers[i].request)
+			_transfers[i].request->finish();
+		//delete the incomplete file
+		if (!_transfers[i].upload)
+			g_system->getSavefileManager()->removeSavefile(_transfers[i].name);
+	}
+	_transfers.clear();
+	_ignoreCallback = ignoreCallback;
 }
 
-void SavesSyncRequest::fileDownloadedCallback(Storage::BoolResponse response) {
-	_workingRequest = nullptr;
-	if (_ignoreCallback)
+void SavesSyncRequest::startDownload() {
+	Transfer transfer;
+	transfer.id = ++_nextTransferId;
+	transfer.file = _filesToDownload.back();
+	transfer.name = transfer.file.name();
+	_filesToDownload.pop_back();
+	_transfers.push_back(transfer);
+
+	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", transfer.name.c_str(), (int)(getProgress() * 100));
+	Request *request = _storage->downloadById(
+		transfer.file.id(),
+		DefaultSaveFileManager::concatWithSavesPath(transfer.name),
+		new TransferCallback<Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback, transfer.id),
+		new TransferCallback<Networking::ErrorResponse>(this, &SavesSyncRequest::transferErrorCallback, transfer.id)
+	);
+
+	//the error callback might have been called already
+	int index = findTransfer(transfer.id);
+	if (index < 0)
+		return;
+	if (!request) {
+		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::startDownload: Storage couldn't create Request to download a file"));
 		return;
+	}
+	_transfers[index].request = request;
+}
 
-	//stop syncing if download failed
-	if (!response.value) {
-		//delete the incomplete file
-		g_system->getSavefileManager()->removeSavefile(_currentDownloadingFile.name());
-		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloadedCallback: failed to download a file", -1));
+void SavesSyncRequest::startUpload() {
+	Transfer transfer;
+	transfer.id = ++_nextTransferId;
+	transfer.name = _filesToUpload.back();
+	transfer.upload = true;
+	_filesToUpload.pop_back();
+	_transfers.push_back(transfer);
+
+	debug(9, "\nSavesSyncRequest: uploading %s (%d %%)", transfer.name.c_str(), (int)(getProgress() * 100));
+	Request *request;
+	if (_storage->uploadStreamSupported()) {
+		request = _storage->upload(
+			_storage->savesDirectoryPath() + transfer.name,
+			g_system->getSavefileManager()->openRawFile(transfer.name),
+			new TransferCallback<Storage::UploadResponse>(this, &SavesSyncRequest::fileUploadedCallback, transfer.id),
+			new TransferCallback<Networking::ErrorResponse>(this, &SavesSyncRequest::transferErrorCallback, transfer.id)
+		);
+	} else {
+		request = _storage->upload(
+			_storage->savesDirectoryPath() + transfer.name,
+			DefaultSaveFileManager::concatWithSavesPath(transfer.name),
+			new TransferCallback<Storage::UploadResponse>(this, &SavesSyncRequest::fileUploadedCallback, transfer.id),
+			new TransferCallback<Networking::ErrorResponse>(this, &SavesSyncRequest::transferErrorCallback, transfer.id)
+		);
+	}
+
+	//the error callback might have been called already
+	int index = findTransfer(transfer.id);
+	if (index < 0)
+		return;
+	if (!request) {
+		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::startUpload: Storage couldn't create Request to upload a file"));
 		return;
 	}
+	_transfers[index].request = request;
+}
 
-	//update local timestamp for downloaded file
-	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
-	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
-	_bytesDownloaded += _currentDownloadingFile.size();
+int SavesSyncRequest::findTransfer(uint32 id) const {
+	for (uint32 i = 0; i < _transfers.size(); ++i)
+		if (_transfers[i].id == id)
+			return i;
+	return -1;
+}
 
-	//continue downloading files
-	downloadNextFile();
+uint32 SavesSyncRequest::countDownloads() const {
+	uint32 count = 0;
+	for (uint32 i = 0; i < _transfers.size(); ++i)
+		if (!_transfers[i].upload)
+			++count;
+	return count;
 }
 
-void SavesSyncRequest::fileDownloadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
+void SavesSyncRequest::fileDownloadedCallback(uint32 id, Storage::BoolResponse response) {
 	if (_ignoreCallback)
 		return;
+	int index = findTransfer(id);
+	if (index < 0)
+		return;
+	Transfer transfer = _transfers[index];
+	_transfers.remove_at(index);
 
 	//stop syncing if download failed
-	finishError(error);
-}
-
-void SavesSyncRequest::uploadNextFile() {
-	if (_filesToUpload.empty()) {
-		finishSync(true);
+	if (!response.value) {
+		//delete the incomplete file
+		g_system->getSavefileManager()->removeSavefile(transfer.name);
+		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloadedCallback: failed to download a file", -1));
 		return;
 	}
 
-	_currentUploadingFile = _filesToUpload.back();
-	_filesToUpload.pop_back();
+	//update local timestamp for downloaded file
+	fileSynced(transfer.name, transfer.file.timestamp());
+	_bytesDownloaded += transfer.file.size();
 
-	debug(9, "\nSavesSyncRequest: uploading %s (%d %%)", _currentUploadingFile.c_str(), (int)(getProgress() * 100));
-	if (_storage->uploadStreamSupported()) {
-		_workingRequest = _storage->upload(
-			_storage->savesDirectoryPath() + _currentUploadingFile,
-			g_system->getSavefileManager()->openRawFile(_currentUploadingFile),
-			new Common::Callback<SavesSyncRequest, Storage::UploadResponse>(this, &SavesSyncRequest::fileUploadedCallback),
-			new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileUploadedErrorCallback)
-		);
-	} else {
-		_workingRequest = _storage->upload(
-			_storage->savesDirectoryPath() + _currentUploadingFile,
-			DefaultSaveFileManager::concatWithSavesPath(_currentUploadingFile),
-			new Common::Callback<SavesSyncRequest, Storage::UploadResponse>(this, &SavesSyncRequest::fileUploadedCallback),
-			new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileUploadedErrorCallback)
-		);
-	}
-	if (!_workingRequest) finishError(Networking::ErrorResponse(this, "SavesSyncRequest::uploadNextFile: Storage couldn't create Request to upload a file"));
+	//continue transferring files
+	startTransfers();
 }
 
-void SavesSyncRequest::fileUploadedCallback(Storage::UploadResponse response) {
-	_workingRequest = nullptr;
+void SavesSyncRequest::fileUploadedCallback(uint32 id, Storage::UploadResponse response) {
 	if (_ignoreCallback)
 		return;
+	int index = findTransfer(id);
+	if (index < 0)
+		return;
+	Transfer transfer = _transfers[index];
+	_transfers.remove_at(index);
 
 	//update local timestamp for the uploaded file
-	_localFilesTimestamps[_currentUploadingFile] = response.value.timestamp();
-	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	fileSynced(transfer.name, response.value.timestamp());
 
-	//continue uploading files
-	uploadNextFile();
+	//continue transferring files
+	startTransfers();
 }
 
-void SavesSyncRequest::fileUploadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
+void SavesSyncRequest::transferErrorCallback(uint32 id, Networking::ErrorResponse error) {
 	if (_ignoreCallback)
 		return;
+	int index = findTransfer(id);
+	if (index < 0)
+		return;
+	Transfer transfer = _transfers[index];
+	_transfers.remove_at(index);
 
-	//stop syncing if upload failed
+	//delete the incomplete file
+	if (!transfer.upload)
+		g_system->getSavefileManager()->removeSavefile(transfer.name);
+
+	//stop syncing if a transfer failed
 	finishError(error);
 }
 
+bool SavesSyncRequest::isUnchangedSinceSync(const StorageFile &file) {
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedFile>::const_iterator i = _syncedFiles.find(file.name());
+	if (i == _syncedFiles.end() || i->_value.timestamp != file.timestamp())
+		return false; //remote file has changed since then
+
+	Common::InSaveFile *f = g_system->getSavefileManager()->openRawFile(file.name());
+	if (!f)
+		return false;
+	bool unchanged = (Common::computeStreamMD5AsString(*f) == i->_value.md5);
+	delete f;
+	return unchanged;
+}
+
+void SavesSyncRequest::fileSynced(const Common::String &name, uint32 timestamp) {
+	//timestamps are saved after every file, so an interrupted sync resumes where it stopped
+	_localFilesTimestamps[name] = timestamp;
+	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+
+	Common::InSaveFile *f = g_system->getSavefileManager()->openRawFile(name);
+	if (f) {
+		_syncedFiles[name] = DefaultSaveFileManager::SyncedFile(timestamp, Common::computeStreamMD5AsString(*f));
+		delete f;
+		DefaultSaveFileManager::saveSyncedFiles(_syncedFiles);
+	}
+}
+
 void SavesSyncRequest::handle() {}
 
 void SavesSyncRequest::restart() { start(); }
@@ -384,7 +501,7 @@ double SavesSyncRequest::getDownloadingProgress() const {
 		return 0; //directory not listed yet
 	}
 
-	if (_totalFilesToHandle == _filesToUpload.size())
+	if (_totalFilesToDownload == 0)
 		return 1; //nothing to download => download complete
 
 	if (_bytesToDownload > 0) {
@@ -392,8 +509,8 @@ double SavesSyncRequest::getDownloadingProgress() const {
 		return (double)(getDownloadedBytes()) / (double)(_bytesToDownload);
 	}
 
-	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 totalFilesToDownload = _totalFilesToDownload;
+	uint32 filesLeftToDownload = _filesToDownload.size() + countDownloads();
 	if (filesLeftToDownload > totalFilesToDownload)
 		filesLeftToDownload = totalFilesToDownload;
 	return (double)(totalFilesToDownload - filesLeftToDownload) / (double)(totalFilesToDownload);
@@ -403,8 +520,8 @@ void SavesSyncRequest::getDownloadingInfo(Storage::SyncDownloadingInfo &info) co
 	info.bytesDownloaded = getDownloadedBytes();
 	info.bytesToDownload = getBytesToDownload();
 
-	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 totalFilesToDownload = _totalFilesToDownload;
+	uint32 filesLeftToDownload = _filesToDownload.size() + countDownloads();
 	if (filesLeftToDownload > totalFilesToDownload)
 		filesLeftToDownload = totalFilesToDownload;
 	info.filesDownloaded = totalFilesToDownload - filesLeftToDownload;
@@ -420,26 +537,34 @@ double SavesSyncRequest::getProgress() const {
 		return 0; //directory not listed yet
 	}
 
-	return (double)(_totalFilesToHandle - _filesToDownload.size() - _filesToUpload.size()) / (double)(_totalFilesToHandle);
+	return (double)(_totalFilesToHandle - _filesToDownload.size() - _filesToUpload.size() - _transfers.size()) / (double)(_totalFilesToHandle);
 }
 
 Common::Array<Common::String> SavesSyncRequest::getFilesToDownload() {
 	Common::Array<Common::String> result;
 	for (uint32 i = 0; i < _filesToDownload.size(); ++i)
 		result.push_back(_filesToDownload[i].name());
-	if (_currentDownloadingFile.name() != "")
-		result.push_back(_currentDownloadingFile.name());
+	for (uint32 i = 0; i < _transfers.size(); ++i)
+		if (!_transfers[i].upload)
+			result.push_back(_transfers[i].name);
 	return result;
 }
 
 uint32 SavesSyncRequest::getDownloadedBytes() const {
-	double currentFileProgress = 0;
-	if (const DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(_workingRequest))
-		currentFileProgress = downloadRequest->getProgress();
-	else if (const Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(_workingRequest))
-		currentFileProgress = idDownloadRequest->getProgress();
+	double bytes = _bytesDownloaded;
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		const Transfer &transfer = _transfers[i];
+		if (transfer.upload)
+			continue;
 
-	return _bytesDownloaded + currentFileProgress * _currentDownloadingFile.size();
+		double fileProgress = 0;
+		if (const DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(transfer.request))
+			fileProgress = downloadRequest->getProgress();
+		else if (const Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(transfer.request))
+			fileProgress = idDownloadRequest->getProgress();
+		bytes += fileProgress * transfer.file.size();
+	}
+	return bytes;
 }
 
 uint32 SavesSyncRequest::getBytesToDownload() const {
@@ -448,21 +573,17 @@ uint32 SavesSyncRequest::getBytesToDownload() const {
 
 void SavesSyncRequest::finishError(Networking::ErrorResponse error, Networking::RequestState state) {
 	debug(9, "SavesSync::finishError");
-	//if we were downloading a file - remember the name
-	//and make the Request close() it, so we can delete it
-	Common::String name = _currentDownloadingFile.name();
 	if (_workingRequest) {
 		_ignoreCallback = true;
 		_workingRequest->finish();
 		_workingRequest = nullptr;
 		_ignoreCallback = false;
 	}
-	//unlock all the files by making getFilesToDownload() return empty array
-	_currentDownloadingFile = StorageFile();
+	//stop the other transfers and delete their incomplete files,
+	//this also unlocks them by making getFilesToDownload() return empty array
+	cancelTransfers();
 	_filesToDownload.clear();
-	//delete the incomplete file
-	if (name != "")
-		g_system->getSavefileManager()->removeSavefile(name);
+	_filesToUpload.clear();
 	Request::finishError(error);
 }
 
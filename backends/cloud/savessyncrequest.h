@@ -24,22 +24,35 @@
 
 #include "backends/networking/curl/request.h"
 #include "backends/cloud/storage.h"
+#include "backends/saves/default/default-saves.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 
 namespace Cloud {
 
 class SavesSyncRequest: public Networking::Request {
+	/** A download or an upload, running in parallel with the others. */
+	struct Transfer {
+		uint32 id;
+		Request *request;
+		StorageFile file; //remote file for downloads
+		Common::String name;
+		bool upload;
+
+		Transfer(): id(0), request(nullptr), upload(false) {}
+	};
+
 	Storage *_storage;
 	Storage::BoolCallback _boolCallback;
 	Common::HashMap<Common::String, uint32> _localFilesTimestamps;
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedFile> _syncedFiles;
 	Common::Array<StorageFile> _filesToDownload;
 	Common::Array<Common::String> _filesToUpload;
-	StorageFile _currentDownloadingFile;
-	Common::String _currentUploadingFile;
+	Common::Array<Transfer> _transfers;
 	Request *_workingRequest;
 	bool _ignoreCallback;
-	uint32 _totalFilesToHandle;
+	uint32 _totalFilesToHandle, _totalFilesToDownload;
+	uint32 _nextTransferId;
 	Common::String _date;
 	uint32 _bytesToDownload, _bytesDownloaded;
 
@@ -48,12 +61,17 @@ class SavesSyncRequest: public Networking::Request {
 	void directoryListedErrorCallback(Networking::ErrorResponse error);
 	void directoryCreatedCallback(Storage::BoolResponse response);
 	void directoryCreatedErrorCallback(Networking::ErrorResponse error);
-	void fileDownloadedCallback(Storage::BoolResponse response);
-	void fileDownloadedErrorCallback(Networking::ErrorResponse error);
-	void fileUploadedCallback(Storage::UploadResponse response);
-	void fileUploadedErrorCallback(Networking::ErrorResponse error);
-	void downloadNextFile();
-	void uploadNextFile();
+	void fileDownloadedCallback(uint32 id, Storage::BoolResponse response);
+	void fileUploadedCallback(uint32 id, Storage::UploadResponse response);
+	void transferErrorCallback(uint32 id, Networking::ErrorResponse error);
+	void startTransfers();
+	void cancelTransfers();
+	void startDownload();
+	void startUpload();
+	int findTransfer(uint32 id) const;
+	uint32 countDownloads() const;
+	bool isUnchangedSinceSync(const StorageFile &file);
+	void fileSynced(const Common::String &name, uint32 timestamp);
 	virtual void finishError(Networking::ErrorResponse error, Networking::RequestState state = Networking::FINISHED);
 	void finishSync(bool success);
 
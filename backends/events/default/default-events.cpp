@@ -25,6 +25,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -41,7 +42,8 @@ DefaultEventManager::DefaultEventManager(Common::EventSource *boss) :
 	_modifierState(0),
 	_shouldQuit(false),
 	_shouldReturnToLauncher(false),
-	_confirmExitDialogActive(false) {
+	_confirmExitDialogActive(false),
+	_coalesceMouseMotion(false) {
 
 	assert(boss);
 
@@ -68,6 +70,8 @@ DefaultEventManager::~DefaultEventManager() {
 }
 
 void DefaultEventManager::init() {
+	_coalesceMouseMotion = ConfMan.hasKey("coalesce_mouse_motion") && ConfMan.getBool("coalesce_mouse_motion");
+
 #ifdef ENABLE_VKEYBD
 	_vk = new Common::VirtualKeyboard();
 
@@ -80,6 +84,8 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	PROFILE_ZONE("EventManager::pollEvent");
+
 	_dispatcher.dispatch();
 
 	if (g_engine)
@@ -93,6 +99,16 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 	event = _eventQueue.pop();
 	bool forwardEvent = true;
 
+	// Only the latest position of a run of motion events is passed on. The
+	// run ends at any other event, so that clicks keep their position.
+	if (_coalesceMouseMotion && event.type == Common::EVENT_MOUSEMOVE) {
+		while (!_eventQueue.empty() && _eventQueue.front().type == Common::EVENT_MOUSEMOVE) {
+			const Common::Point relMouse = event.relMouse;
+			event = _eventQueue.pop();
+			event.relMouse += relMouse;
+		}
+	}
+
 	// If the backend has the kFeatureNoQuit or the "Return to Launcher at Exit" option is enabled,
 	// replace "Quit" event with "Return to Launcher". This is also handled in scummvm_main, but
 	// doing it here allows getting the correct confirmation dialog if the "confirm_exit" setting
@@ -57,6 +57,7 @@ class DefaultEventManager : public Common::EventManager, Common::EventObserver {
 	bool _shouldQuit;
 	bool _shouldReturnToLauncher;
 	bool _confirmExitDialogActive;
+	bool _coalesceMouseMotion;
 
 public:
 	DefaultEventManager(Common::EventSource *boss);
@@ -67,6 +68,7 @@ public:
 	void pushEvent(const Common::Event &event) override;
 	void purgeMouseEvents() override;
 	void purgeKeyboardEvents() override;
+	void setMouseMotionCoalescing(bool enable) override { _coalesceMouseMotion = enable; }
 
 	Common::Point getMousePos() const override { return _mousePos; }
 	int getButtonState() const override { return _buttonState; }
@@ -182,6 +182,26 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a MemoryReadStream instance backed by a read-only memory
+	 * mapping of the file referred by this node. The default implementation
+	 * returns 0, in which case FSNode falls back to reading the file into
+	 * memory.
+	 *
+	 * @return pointer to the stream object, 0 if mapping is not supported or failed
+	 */
+	virtual Common::MemoryReadStream *createMappedReadStream() { return nullptr; }
+
+	/**
+	 * Gets the size of the file referred by this node and the time it was
+	 * last modified, in seconds since an epoch of the backend's choice.
+	 * The default implementation returns false, for backends which cannot
+	 * tell without opening the file.
+	 *
+	 * @return true if the node is a file and its stats could be retrieved
+	 */
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const { return false; }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -34,6 +34,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/memstream.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -49,6 +50,9 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#endif
 
 #ifdef __OS2__
 #define INCL_DOS
@@ -269,6 +273,66 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+/**
+ * MemoryReadStream over a read-only mapping of a whole file.
+ */
+class PosixMappedReadStream final : public Common::MemoryReadStream {
+public:
+	PosixMappedReadStream(void *mapping, uint32 size) :
+		Common::MemoryReadStream((const byte *)mapping, size), _mapping(mapping), _mappingSize(size) {}
+
+	~PosixMappedReadStream() override {
+		if (_mapping)
+			munmap(_mapping, _mappingSize);
+	}
+
+private:
+	void *_mapping;
+	size_t _mappingSize;
+};
+
+Common::MemoryReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	int fd = open(_path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (uint64)st.st_size > 0xFFFFFFFF) {
+		close(fd);
+		return nullptr;
+	}
+
+	// mmap() refuses empty mappings
+	if (st.st_size == 0) {
+		close(fd);
+		return new PosixMappedReadStream(nullptr, 0);
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after closing the descriptor
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMappedReadStream(mapping, st.st_size);
+}
+#else
+Common::MemoryReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	return nullptr;
+}
+#endif
+
+bool POSIXFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
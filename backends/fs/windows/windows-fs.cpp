@@ -26,6 +26,7 @@
 
 #include "backends/fs/windows/windows-fs.h"
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 bool WindowsFilesystemNode::exists() const {
 	// Check whether the file actually exists
@@ -223,6 +224,65 @@ Common::SeekableReadStream *WindowsFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+/**
+ * MemoryReadStream over a read-only view of a whole file.
+ */
+class WindowsMappedReadStream final : public Common::MemoryReadStream {
+public:
+	WindowsMappedReadStream(void *view, uint32 size) :
+		Common::MemoryReadStream((const byte *)view, size), _view(view) {}
+
+	~WindowsMappedReadStream() override {
+		if (_view)
+			UnmapViewOfFile(_view);
+	}
+
+private:
+	void *_view;
+};
+
+Common::MemoryReadStream *WindowsFilesystemNode::createMappedReadStream() {
+	HANDLE file = CreateFile(charToTchar(_path.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart > 0xFFFFFFFF) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// CreateFileMapping() refuses empty files
+	if (size.QuadPart == 0) {
+		CloseHandle(file);
+		return new WindowsMappedReadStream(nullptr, 0);
+	}
+
+	HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+
+	// The view keeps the mapping object alive after closing its handle
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view)
+		return nullptr;
+
+	return new WindowsMappedReadStream(view, (uint32)size.QuadPart);
+}
+
+bool WindowsFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		return false;
+
+	size = ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	// The time is in 100 nanosecond intervals since 1601
+	modificationTime = (((int64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime) / 10000000;
+	return true;
+}
+
 Common::SeekableWriteStream *WindowsFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
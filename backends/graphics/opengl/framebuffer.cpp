@@ -109,23 +109,23 @@ void Framebuffer::applyClearColor() {
 void Framebuffer::applyBlendState() {
 	switch (_blendState) {
 		case kBlendModeDisabled:
-			GL_CALL(glDisable(GL_BLEND));
+			OpenGLContext.setCapability(GL_BLEND, false);
 			break;
 		case kBlendModeTraditionalTransparency:
-			GL_CALL(glEnable(GL_BLEND));
-			GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+			OpenGLContext.setCapability(GL_BLEND, true);
+			OpenGLContext.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			break;
 		case kBlendModePremultipliedTransparency:
-			GL_CALL(glEnable(GL_BLEND));
-			GL_CALL(glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+			OpenGLContext.setCapability(GL_BLEND, true);
+			OpenGLContext.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 			break;
 		case kBlendModeAdditive:
-			GL_CALL(glEnable(GL_BLEND));
-			GL_CALL(glBlendFunc(GL_ONE, GL_ONE));
+			OpenGLContext.setCapability(GL_BLEND, true);
+			OpenGLContext.blendFunc(GL_ONE, GL_ONE);
 			break;
 		case kBlendModeMaskAlphaAndInvertByColor:
-			GL_CALL(glEnable(GL_BLEND));
-			GL_CALL(glBlendFunc(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA));
+			OpenGLContext.setCapability(GL_BLEND, true);
+			OpenGLContext.blendFunc(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
 			break;
 		default:
 			break;
@@ -133,11 +133,7 @@ void Framebuffer::applyBlendState() {
 }
 
 void Framebuffer::applyScissorTestState() {
-	if (_scissorTestState) {
-		GL_CALL(glEnable(GL_SCISSOR_TEST));
-	} else {
-		GL_CALL(glDisable(GL_SCISSOR_TEST));
-	}
+	OpenGLContext.setCapability(GL_SCISSOR_TEST, _scissorTestState);
 }
 
 void Framebuffer::applyScissorBox() {
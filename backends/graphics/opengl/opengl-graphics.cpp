@@ -82,7 +82,7 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
 #endif
 #ifdef USE_OSD
 	  , _osdMessageChangeRequest(false), _osdMessageAlpha(0), _osdMessageFadeStartTime(0), _osdMessageSurface(nullptr),
-	  _osdIconSurface(nullptr)
+	  _osdIconSurface(nullptr), _performanceHudSurface(nullptr)
 #endif
 #ifdef USE_SCALERS
 	  , _scalerPlugins(ScalerMan.getPlugins())
@@ -100,6 +100,7 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 #ifdef USE_OSD
 	delete _osdMessageSurface;
 	delete _osdIconSurface;
+	delete _performanceHudSurface;
 #endif
 #if !USE_FORCED_GLES
 	ShaderManager::destroy();
@@ -633,7 +634,20 @@ void OpenGLGraphicsManager::updateScreen() {
 		return;
 	}
 
+	// Do not trust the shadowed GL state across frames, in case anything
+	// else touched the context in between.
+	OpenGLContext.invalidateState();
+
 #ifdef USE_OSD
+	if (_performanceHud.isVisible()) {
+		_performanceHud.beginFrame();
+
+		const Surface *active = _overlayInGUI ? _overlay : _gameScreen;
+		const Common::Rect dirtyArea = active->isDirty() ? active->getDirtyArea() : Common::Rect();
+		_performanceHud.addDirtyArea(dirtyArea.width() * dirtyArea.height(), active->getWidth() * active->getHeight());
+	}
+	updatePerformanceHud();
+
 	if (_osdMessageChangeRequest) {
 		osdMessageUpdateSurface();
 	}
@@ -658,12 +672,22 @@ void OpenGLGraphicsManager::updateScreen() {
 	    && !(_overlayVisible && _overlay->isDirty())
 	    && !(_cursorVisible && ((_cursor && _cursor->isDirty()) || (_cursorMask && _cursorMask->isDirty())))
 #ifdef USE_OSD
-	    && !_osdMessageSurface && !_osdIconSurface
+	    && !_osdMessageSurface && !_osdIconSurface && !_performanceHudSurface
 #endif
 	    ) {
 		return;
 	}
 
+#if !USE_FORCED_GLES
+	// The scaler passes only need to run again when the game screen or the cursor
+	// content changed. Overlay changes are drawn unscaled on top of them.
+	if (_libretroPipeline
+	    && (_gameScreen->isDirty()
+	        || (_cursorVisible && ((_cursor && _cursor->isDirty()) || (_cursorMask && _cursorMask->isDirty()))))) {
+		_libretroPipeline->invalidateScaling();
+	}
+#endif
+
 	// Update changes to textures.
 	_gameScreen->updateGLTexture();
 	if (_cursorVisible && _cursor) {
@@ -738,7 +762,7 @@ void OpenGLGraphicsManager::updateScreen() {
 
 #ifdef USE_OSD
 	// Fourth step: Draw the OSD.
-	if (_osdMessageSurface || _osdIconSurface) {
+	if (_osdMessageSurface || _osdIconSurface || _performanceHudSurface) {
 		_backBuffer.enableBlend(Framebuffer::kBlendModeTraditionalTransparency);
 	}
 
@@ -786,10 +810,26 @@ void OpenGLGraphicsManager::updateScreen() {
 		_pipeline->drawTexture(_osdIconSurface->getGLTexture(),
 		                       dstX, dstY, _osdIconSurface->getWidth(), _osdIconSurface->getHeight());
 	}
+
+	if (_performanceHudSurface) {
+		_pipeline->setColor(1.0f, 1.0f, 1.0f, kPerformanceHudAlpha / 100.0f);
+		_pipeline->drawTexture(_performanceHudSurface->getGLTexture(),
+		                       kPerformanceHudMargin, kPerformanceHudMargin,
+		                       _performanceHudSurface->getWidth(), _performanceHudSurface->getHeight());
+		_pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+	}
 #endif
 
 	_cursorNeedsRedraw = false;
 	_forceRedraw = false;
+	OpenGLContext.endFrame();
+#ifdef USE_OSD
+	if (_performanceHud.isVisible()) {
+		const OpenGL::Context::StateStats &stats = OpenGLContext.getFrameStats();
+		_performanceHud.addUploadBytes(stats.uploadBytes);
+		_performanceHud.setBackendInfo(Common::String::format("GL state calls %u  skipped %u", stats.calls, stats.skipped));
+	}
+#endif
 	refreshScreen();
 }
 
@@ -1210,6 +1250,30 @@ void OpenGLGraphicsManager::osdMessageUpdateSurface() {
 	_osdMessageNextData.clear();
 	_osdMessageChangeRequest = false;
 }
+
+void OpenGLGraphicsManager::updatePerformanceHud() {
+	if (!_performanceHud.isVisible()) {
+		delete _performanceHudSurface;
+		_performanceHudSurface = nullptr;
+		return;
+	}
+
+	if (!_performanceHud.render(*getFontOSD(), _defaultFormatAlpha)) {
+		return;
+	}
+
+	const Graphics::Surface &hud = _performanceHud.getSurface();
+	if (!_performanceHudSurface || _performanceHudSurface->getWidth() != (uint)hud.w || _performanceHudSurface->getHeight() != (uint)hud.h) {
+		delete _performanceHudSurface;
+		_performanceHudSurface = createSurface(_defaultFormatAlpha);
+		assert(_performanceHudSurface);
+		_performanceHudSurface->allocate(hud.w, hud.h);
+	}
+
+	_performanceHudSurface->getSurface()->copyFrom(hud);
+	_performanceHudSurface->flagDirty();
+	_performanceHudSurface->updateGLTexture();
+}
 #endif
 
 void OpenGLGraphicsManager::displayActivityIconOnOSD(const Graphics::Surface *icon) {
@@ -1407,6 +1471,10 @@ void OpenGLGraphicsManager::notifyContextCreate(ContextType type,
 	if (_osdIconSurface) {
 		_osdIconSurface->recreate();
 	}
+
+	if (_performanceHudSurface) {
+		_performanceHudSurface->recreate();
+	}
 #endif
 }
 
@@ -1435,6 +1503,10 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 	if (_osdIconSurface) {
 		_osdIconSurface->destroy();
 	}
+
+	if (_performanceHudSurface) {
+		_performanceHudSurface->destroy();
+	}
 #endif
 
 #if !USE_FORCED_GLES
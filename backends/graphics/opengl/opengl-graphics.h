@@ -125,6 +125,10 @@ public:
 	void displayMessageOnOSD(const Common::U32String &msg) override;
 	void displayActivityIconOnOSD(const Graphics::Surface *icon) override;
 
+#ifdef USE_OSD
+	bool canShowPerformanceHud() const override { return true; }
+#endif
+
 	// PaletteManager interface
 	void setPalette(const byte *colors, uint start, uint num) override;
 	void grabPalette(byte *colors, uint start, uint num) const override;
@@ -510,6 +514,21 @@ private:
 		kOSDIconTopMargin = 10,
 		kOSDIconRightMargin = 10
 	};
+
+	/**
+	 * Update the performance overlay texture if it is out of date.
+	 */
+	void updatePerformanceHud();
+
+	/**
+	 * The rendered performance overlay.
+	 */
+	Surface *_performanceHudSurface;
+
+	enum {
+		kPerformanceHudMargin = 10,
+		kPerformanceHudAlpha = 85
+	};
 #endif
 };
 
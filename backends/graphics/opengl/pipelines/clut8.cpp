@@ -35,12 +35,12 @@ void CLUT8LookUpPipeline::drawTextureInternal(const GLTexture &texture, const GL
 	assert(isActive());
 
 	// Set the palette texture.
-	GL_CALL(glActiveTexture(GL_TEXTURE1));
+	OpenGLContext.activeTexture(GL_TEXTURE1);
 	if (_paletteTexture) {
 		_paletteTexture->bind();
 	}
 
-	GL_CALL(glActiveTexture(GL_TEXTURE0));
+	OpenGLContext.activeTexture(GL_TEXTURE0);
 	ShaderPipeline::drawTextureInternal(texture, coordinates, texcoords);
 }
 #endif // !USE_FORCED_GLES
@@ -38,10 +38,10 @@ void FixedPipeline::activateInternal() {
 
 #if !USE_FORCED_GLES
 	if (OpenGLContext.multitextureSupported) {
-		GL_CALL(glActiveTexture(GL_TEXTURE0));
+		OpenGLContext.activeTexture(GL_TEXTURE0);
 	}
 #endif
-	GL_CALL(glEnable(GL_TEXTURE_2D));
+	OpenGLContext.setCapability(GL_TEXTURE_2D, true);
 	GL_CALL(glColor4f(_r, _g, _b, _a));
 }
 
@@ -195,11 +195,22 @@ LibRetroPipeline::LibRetroPipeline()
 	  _outputPipeline(ShaderMan.query(ShaderManager::kDefault)),
 	  _needsScaling(false), _shaderPreset(nullptr), _linearFiltering(false),
 	  _currentTarget(uint(-1)), _inputWidth(0), _inputHeight(0),
-	  _isAnimated(false), _frameCount(0) {
+	  _isAnimated(false), _frameCount(0), _passesValid(false) {
 }
 
 LibRetroPipeline::~LibRetroPipeline() {
 	close();
+
+	for (uint i = 0; i < _targetPool.size(); ++i) {
+		delete _targetPool[i];
+	}
+	_targetPool.clear();
+}
+
+bool LibRetroPipeline::InputDraw::operator==(const InputDraw &other) const {
+	return texture == other.texture
+		&& !memcmp(coordinates, other.coordinates, sizeof(coordinates))
+		&& !memcmp(texCoords, other.texCoords, sizeof(texCoords));
 }
 
 /** Small helper to overcome that texture passed to drawTexture is const
@@ -213,7 +224,7 @@ static void setLinearFiltering(GLuint glTexture, bool enable) {
 		glFilter = GL_NEAREST;
 	}
 
-	GL_CALL(glBindTexture(GL_TEXTURE_2D, glTexture));
+	OpenGLContext.bindTexture(GL_TEXTURE_2D, glTexture);
 
 	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glFilter));
 	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glFilter));
@@ -231,9 +242,16 @@ void LibRetroPipeline::drawTextureInternal(const GLTexture &texture, const GLflo
 	/* OpenGLGraphicsManager only knows about _activeFramebuffer and modify framebuffer here
 	 * So let's synchronize our _inputTargets with it.
 	 * Don't synchronize the scissor test as coordinates are wrong and we should not need it*/
-	_inputTargets[_currentTarget].copyRenderStateFrom(*_activeFramebuffer,
+	_inputTargets[_currentTarget]->copyRenderStateFrom(*_activeFramebuffer,
 			Framebuffer::kCopyMaskClearColor | Framebuffer::kCopyMaskBlendState);
 
+	// Remember what got drawn to find out if the passes need to run again
+	InputDraw draw;
+	draw.texture = texture.getGLTexture();
+	memcpy(draw.coordinates, coordinates, sizeof(draw.coordinates));
+	memcpy(draw.texCoords, texcoords, sizeof(draw.texCoords));
+	_inputDraws.push_back(draw);
+
 	/* The backend sends us the coordinates in screen coordinates system
 	 * So, when we are before libretro scaling, we need to scale back coordinates
 	 * to our own coordinates system */
@@ -248,7 +266,8 @@ void LibRetroPipeline::drawTextureInternal(const GLTexture &texture, const GLflo
 void LibRetroPipeline::beginScaling() {
 	if (_shaderPreset != nullptr) {
 		_needsScaling = true;
-		_inputTargets[_currentTarget].getTexture()->enableLinearFiltering(_linearFiltering);
+		_inputTargets[_currentTarget]->getTexture()->enableLinearFiltering(_linearFiltering);
+		_inputDraws.clear();
 	}
 }
 
@@ -257,27 +276,37 @@ void LibRetroPipeline::finishScaling() {
 		return;
 	}
 
-	/* As we have now finished to render everything in the input pipeline
-	 * we can do the render through all libretro passes */
+	/* When the preset neither depends on time nor on previous frames and the same
+	 * content got drawn in the input target, the last pass still holds the result:
+	 * this is the case for overlay only changes or static game screens. */
+	const bool reuseOutput = !_isAnimated && _passesValid && _inputDraws == _lastInputDraws;
 
-	// Now we can actually draw the texture with the setup passes.
-	for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
-		renderPass(*i);
-	}
+	if (!reuseOutput) {
+		/* As we have now finished to render everything in the input pipeline
+		 * we can do the render through all libretro passes */
+
+		// Now we can actually draw the texture with the setup passes.
+		for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
+			renderPass(*i);
+		}
 
-	// Prepare for the next frame
-	_frameCount++;
+		// Prepare for the next frame
+		_frameCount++;
 
-	_currentTarget++;
-	if (_currentTarget >= _inputTargets.size()) {
-		_currentTarget = 0;
+		_currentTarget++;
+		if (_currentTarget >= _inputTargets.size()) {
+			_currentTarget = 0;
+		}
+		_passes[0].inputTexture = _inputTargets[_currentTarget]->getTexture();
+
+		SWAP(_inputDraws, _lastInputDraws);
+		_passesValid = true;
 	}
-	_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
 
 	// Clear the output buffer.
 	_activeFramebuffer->activate(this);
 	// Disable scissor test for clearing, it will get enabled back when activating the output pipeline
-	GL_CALL(glDisable(GL_SCISSOR_TEST));
+	OpenGLContext.setCapability(GL_SCISSOR_TEST, false);
 	GL_CALL(glClear(GL_COLOR_BUFFER_BIT));
 
 	// Finally, we need to render the result to the output pipeline
@@ -305,7 +334,19 @@ void LibRetroPipeline::finishScaling() {
 	_needsScaling = false;
 }
 
+void LibRetroPipeline::enableLinearFiltering(bool enabled) {
+	if (_linearFiltering != enabled) {
+		_linearFiltering = enabled;
+		_passesValid = false;
+	}
+}
+
 void LibRetroPipeline::setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect) {
+	// Nothing to recompute when the sizes are the ones already set up
+	if (inputWidth == _inputWidth && inputHeight == _inputHeight && outputRect == _outputRect) {
+		return;
+	}
+
 	_inputWidth = inputWidth;
 	_inputHeight = inputHeight;
 	_outputRect = outputRect;
@@ -324,7 +365,7 @@ void LibRetroPipeline::setProjectionMatrix(const Math::Matrix4 &projectionMatrix
 void LibRetroPipeline::activateInternal() {
 	// Don't call Pipeline::activateInternal as our framebuffer is passed to _outputPipeline
 	if (_needsScaling) {
-		_inputPipeline.setFramebuffer(&_inputTargets[_currentTarget]);
+		_inputPipeline.setFramebuffer(_inputTargets[_currentTarget]);
 		_inputPipeline.activate();
 	} else {
 		_outputPipeline.setFramebuffer(_activeFramebuffer);
@@ -370,7 +411,7 @@ void LibRetroPipeline::close() {
 
 	for (PassArray::size_type i = 0; i < _passes.size(); ++i) {
 		delete _passes[i].shader;
-		delete _passes[i].target;
+		releaseTarget(_passes[i].target);
 	}
 	_passes.clear();
 
@@ -380,8 +421,39 @@ void LibRetroPipeline::close() {
 	_isAnimated = false;
 	_needsScaling = false;
 
-	_inputTargets.resize(0);
+	for (uint i = 0; i < _inputTargets.size(); ++i) {
+		releaseTarget(_inputTargets[i]);
+	}
+	_inputTargets.clear();
 	_currentTarget = uint(-1);
+
+	_inputDraws.clear();
+	_lastInputDraws.clear();
+	_passesValid = false;
+}
+
+LibRetroTextureTarget *LibRetroPipeline::acquireTarget() {
+	if (_targetPool.empty()) {
+		return new LibRetroTextureTarget();
+	}
+
+	LibRetroTextureTarget *target = _targetPool.back();
+	_targetPool.pop_back();
+
+	// Restore the defaults of a new target as presets set filtering and wrapping per pass
+	GLTexture *texture = target->getTexture();
+	texture->enableLinearFiltering(false);
+	texture->setWrapMode(kWrapModeEdge);
+	return target;
+}
+
+void LibRetroPipeline::releaseTarget(LibRetroTextureTarget *target) {
+	if (!target) {
+		return;
+	}
+
+	// Keep the texture and FBO storage: the next preset most likely uses the same sizes
+	_targetPool.push_back(target);
 }
 
 bool LibRetroPipeline::loadTextures(Common::SearchSet &archSet) {
@@ -543,17 +615,16 @@ bool LibRetroPipeline::loadPasses(Common::SearchSet &archSet) {
 		// Input texture is always bound at sampler 0.
 		shader->setUniform("Texture", 0);
 
-		TextureTarget *target = nullptr;
 		// TODO: float and sRGB FBO handling.
-		target = new TextureTarget();
+		LibRetroTextureTarget *target = acquireTarget();
 
 		_passes.push_back(Pass(i, shader, target));
 		Pass &pass = _passes[_passes.size() - 1];
 		const uint passId = _passes.size() - 1;
 
-		pass.hasFrameCount = shader->getUniformLocation("FrameCount") != -1;
+		pass.frameCountLocation = shader->getUniformLocation("FrameCount");
 		// If pass has FrameCount uniform, preset is animated and must be redrawn on a regular basis
-		_isAnimated |= pass.hasFrameCount;
+		_isAnimated |= pass.frameCountLocation != -1;
 
 		pass.buildTexCoords(passId, aliases);
 		pass.buildTexSamplers(passId, _textures, aliases);
@@ -587,9 +658,12 @@ bool LibRetroPipeline::loadPasses(Common::SearchSet &archSet) {
 	_isAnimated |= (maxPrevCount > 0);
 
 	_inputTargets.resize(maxPrevCount + 1);
+	for (uint i = 0; i < _inputTargets.size(); ++i) {
+		_inputTargets[i] = acquireTarget();
+	}
 
 	_currentTarget = 0;
-	_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
+	_passes[0].inputTexture = _inputTargets[_currentTarget]->getTexture();
 
 	// Now try to setup FBOs with some dummy size to make sure it could work
 	uint bakInputWidth = _inputWidth;
@@ -613,6 +687,9 @@ bool LibRetroPipeline::loadPasses(Common::SearchSet &archSet) {
 }
 
 void LibRetroPipeline::setPipelineState() {
+	// Passes output doesn't match the new sizes anymore
+	_passesValid = false;
+
 	// Setup FBO sizes, we require this to be able to set all uniform values.
 	setupFBOs();
 
@@ -625,8 +702,8 @@ void LibRetroPipeline::setPipelineState() {
 
 bool LibRetroPipeline::setupFBOs() {
 	// Setup the input targets sizes
-	for (Common::Array<LibRetroTextureTarget>::iterator it = _inputTargets.begin(); it != _inputTargets.end(); it++) {
-		if (!it->setScaledSize(_inputWidth, _inputHeight, _outputRect)) {
+	for (Common::Array<LibRetroTextureTarget *>::iterator it = _inputTargets.begin(); it != _inputTargets.end(); it++) {
+		if (!(*it)->setScaledSize(_inputWidth, _inputHeight, _outputRect)) {
 			return false;
 		}
 	}
@@ -855,12 +932,13 @@ void LibRetroPipeline::renderPass(const Pass &pass) {
 	// We don't need to set the projection matrix here so let's use a fake pipeline
 	pass.target->activate(&fakePipeline);
 
-	if (pass.hasFrameCount) {
+	if (pass.frameCountLocation != -1) {
 		uint frameCount = _frameCount;
 		if (pass.shaderPass->frameCountMod) {
 			frameCount %= pass.shaderPass->frameCountMod;
 		}
-		pass.shader->setUniform("FrameCount", frameCount);
+		// The shader is in use: set the uniform directly through its cached location
+		GL_CALL(glUniform1i(pass.frameCountLocation, frameCount));
 	}
 
 	// Activate attribute arrays and setup matching attributes.
@@ -909,7 +987,7 @@ void LibRetroPipeline::renderPassSetupCoordinates(const Pass &pass) {
 }
 
 void LibRetroPipeline::renderPassSetupTextures(const Pass &pass) {
-	GL_CALL(glActiveTexture(GL_TEXTURE0));
+	OpenGLContext.activeTexture(GL_TEXTURE0);
 	pass.inputTexture->bind();
 
 	// In case the pass requests mipmaps for the input texture we generate
@@ -934,7 +1012,7 @@ void LibRetroPipeline::renderPassSetupTextures(const Pass &pass) {
 		case Pass::TextureSampler::kTypePrev: {
 			assert(i->index < _inputTargets.size() - 1);
 			texture = _inputTargets[(_currentTarget - i->index - 1
-					+ _inputTargets.size()) % _inputTargets.size()].getTexture();
+					+ _inputTargets.size()) % _inputTargets.size()]->getTexture();
 			break;
 		}
 		}
@@ -943,7 +1021,7 @@ void LibRetroPipeline::renderPassSetupTextures(const Pass &pass) {
 			continue;
 		}
 
-		GL_CALL(glActiveTexture(GL_TEXTURE0 + i->unit));
+		OpenGLContext.activeTexture(GL_TEXTURE0 + i->unit);
 		texture->bind();
 	}
 }
@@ -41,7 +41,6 @@ struct ShaderPreset;
 struct ShaderPass;
 } // End of namespace LibRetro
 
-class TextureTarget;
 class LibRetroTextureTarget;
 
 /**
@@ -59,7 +58,7 @@ public:
 	void close();
 
 	/* Called by OpenGLGraphicsManager */
-	void enableLinearFiltering(bool enabled) { _linearFiltering = enabled; }
+	void enableLinearFiltering(bool enabled);
 	/* Called by OpenGLGraphicsManager to setup the internal objects sizes */
 	void setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect);
 	/* Called by OpenGLGraphicsManager to indicate that next draws need to be scaled. */
@@ -67,6 +66,9 @@ public:
 	/* Called by OpenGLGraphicsManager to indicate that next draws don't need to be scaled.
 	 * This must be called to execute scaling. */
 	void finishScaling();
+	/* Called by OpenGLGraphicsManager when the content of a texture drawn through the scaler changed.
+	 * Unless this is called, static presets reuse the output of the previous frame. */
+	void invalidateScaling() { _passesValid = false; }
 	bool isAnimated() const { return _isAnimated; }
 
 	static bool isSupportedByContext() {
@@ -87,6 +89,9 @@ private:
 	void setupPassUniforms(const uint id);
 	void setShaderTexUniforms(const Common::String &prefix, Shader *shader, const GLTexture &texture);
 
+	LibRetroTextureTarget *acquireTarget();
+	void releaseTarget(LibRetroTextureTarget *target);
+
 	/* Pipelines used to draw all layers
 	 * First before the scaler then after it to draw on screen
 	 */
@@ -106,9 +111,26 @@ private:
 	bool _isAnimated;
 	uint _frameCount;
 
-	Common::Array<LibRetroTextureTarget> _inputTargets;
+	Common::Array<LibRetroTextureTarget *> _inputTargets;
 	uint _currentTarget;
 
+	/* Framebuffers released by close(), kept to be reused by the next preset */
+	Common::Array<LibRetroTextureTarget *> _targetPool;
+
+	/* Draws done in the input target during the current and the last scaled frame.
+	 * When they match and nothing got invalidated, the passes output is still valid */
+	struct InputDraw {
+		GLuint texture;
+		GLfloat coordinates[4*2];
+		GLfloat texCoords[4*2];
+
+		bool operator==(const InputDraw &other) const;
+		bool operator!=(const InputDraw &other) const { return !(*this == other); }
+	};
+	Common::Array<InputDraw> _inputDraws;
+	Common::Array<InputDraw> _lastInputDraws;
+	bool _passesValid;
+
 	struct Texture {
 		Texture() : textureData(nullptr), glTexture(nullptr) {}
 		Texture(Graphics::Surface *tD, GLTexture *glTex) : textureData(tD), glTexture(glTex) {}
@@ -125,14 +147,14 @@ private:
 	struct Pass {
 		Pass()
 			: shaderPass(nullptr), shader(nullptr), target(nullptr), texCoords(), texSamplers(),
-			inputTexture(nullptr), vertexCoord(), hasFrameCount(false), prevCount(0) {}
-		Pass(const LibRetro::ShaderPass *sP, Shader *s, TextureTarget *t)
+			inputTexture(nullptr), vertexCoord(), frameCountLocation(-1), prevCount(0) {}
+		Pass(const LibRetro::ShaderPass *sP, Shader *s, LibRetroTextureTarget *t)
 			: shaderPass(sP), shader(s), target(t), texCoords(), texSamplers(),
-			inputTexture(nullptr), vertexCoord(), hasFrameCount(false), prevCount(0) {}
+			inputTexture(nullptr), vertexCoord(), frameCountLocation(-1), prevCount(0) {}
 
 		const LibRetro::ShaderPass *shaderPass;
 		Shader *shader;
-		TextureTarget *target;
+		LibRetroTextureTarget *target;
 
 		/**
 		 * Description of texture coordinates bound to attribute.
@@ -250,10 +272,10 @@ private:
 		GLfloat vertexCoord[2*4];
 
 		/**
-		 * Whether the shader has a FrameCount uniform or not
+		 * Location of the FrameCount uniform or -1 if the shader has none
 		 * Allows to speed up if it is not here
 		 */
-		bool hasFrameCount;
+		GLint frameCountLocation;
 
 		/**
 		 * The number of previous frames this pass needs
@@ -53,7 +53,7 @@ void ShaderPipeline::activateInternal() {
 	Pipeline::activateInternal();
 
 	if (OpenGLContext.multitextureSupported) {
-		GL_CALL(glActiveTexture(GL_TEXTURE0));
+		OpenGLContext.activeTexture(GL_TEXTURE0);
 	}
 
 	_activeShader->use();
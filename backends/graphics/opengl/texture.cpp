@@ -44,11 +44,24 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
 	  _glTexture(0) {
+#ifdef USE_GLAD
+	for (uint i = 0; i < kNumUploadBuffers; ++i) {
+		_uploadBuffers[i] = 0;
+		_uploadBufferSizes[i] = 0;
+		_uploadFences[i] = nullptr;
+	}
+	_nextUploadBuffer = 0;
+#endif
 	create();
 }
 
 GLTexture::~GLTexture() {
+	OpenGLContext.textureDeleted(_glTexture);
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#ifdef USE_GLAD
+	if (OpenGLContext.type != kContextNone)
+		destroyUploadBuffers();
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -111,8 +124,12 @@ void GLTexture::setWrapMode(WrapMode wrapMode) {
 }
 
 void GLTexture::destroy() {
+	OpenGLContext.textureDeleted(_glTexture);
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+#ifdef USE_GLAD
+	destroyUploadBuffers();
+#endif
 }
 
 void GLTexture::create() {
@@ -146,7 +163,7 @@ void GLTexture::create() {
 }
 
 void GLTexture::bind() const {
-	GL_CALL(glBindTexture(GL_TEXTURE_2D, _glTexture));
+	OpenGLContext.bindTexture(GL_TEXTURE_2D, _glTexture);
 }
 
 bool GLTexture::setSize(uint width, uint height) {
@@ -199,6 +216,17 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	// Set the texture on the active texture unit.
 	bind();
 
+	// Whole lines are uploaded, see below.
+	OpenGLContext.countUpload(src.pitch * area.height());
+
+#ifdef USE_GLAD
+	// Go through a pixel buffer object where possible, so that the upload
+	// does not stall until the driver is done with the texture.
+	if (OpenGLContext.pixelBufferObjectSupported && updateAreaBuffered(area, src)) {
+		return;
+	}
+#endif
+
 	// Update the actual texture.
 	// Although we have the area of the texture buffer we want to update we
 	// cannot take advantage of the left/right boundaries here because it is
@@ -221,6 +249,93 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
 }
 
+#ifdef USE_GLAD
+bool GLTexture::updateAreaBuffered(const Common::Rect &area, const Graphics::Surface &src) {
+	// As in updateArea, whole lines are uploaded.
+	const GLsizeiptr size = src.pitch * area.height();
+	const uint index = _nextUploadBuffer;
+
+	if (!_uploadBuffers[index]) {
+		GL_CALL(glGenBuffers(1, &_uploadBuffers[index]));
+	}
+
+	// The buffer was last used kNumUploadBuffers uploads ago, so this
+	// normally returns right away.
+	bool synchronized = false;
+	if (_uploadFences[index]) {
+		GLenum result;
+		GL_ASSIGN(result, glClientWaitSync(_uploadFences[index], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull));
+		GL_CALL(glDeleteSync(_uploadFences[index]));
+		_uploadFences[index] = nullptr;
+		synchronized = (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+	}
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _uploadBuffers[index]));
+
+	void *dst = nullptr;
+	if (OpenGLContext.mapBufferRangeSupported) {
+		if (size > _uploadBufferSizes[index]) {
+			GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+			_uploadBufferSizes[index] = size;
+		}
+
+		GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+		if (synchronized) {
+			access |= GL_MAP_UNSYNCHRONIZED_BIT;
+		}
+		GL_ASSIGN(dst, glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, access));
+	} else {
+		// Orphan the old storage, so that mapping does not wait for the
+		// previous upload from this buffer.
+		GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+		_uploadBufferSizes[index] = size;
+		GL_ASSIGN(dst, glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+	}
+
+	if (!dst) {
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+		return false;
+	}
+
+	memcpy(dst, src.getBasePtr(0, area.top), size);
+
+	GLboolean unmapped;
+	GL_ASSIGN(unmapped, glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+	if (!unmapped) {
+		// The buffer contents got lost, upload directly instead
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+		return false;
+	}
+
+	// With a pixel unpack buffer bound the data pointer is an offset into it.
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
+	                       _glFormat, _glType, nullptr));
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+	if (OpenGLContext.syncSupported) {
+		GL_ASSIGN(_uploadFences[index], glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	}
+
+	_nextUploadBuffer = (index + 1) % kNumUploadBuffers;
+	return true;
+}
+
+void GLTexture::destroyUploadBuffers() {
+	for (uint i = 0; i < kNumUploadBuffers; ++i) {
+		if (_uploadFences[i]) {
+			GL_CALL(glDeleteSync(_uploadFences[i]));
+			_uploadFences[i] = nullptr;
+		}
+		if (_uploadBuffers[i]) {
+			GL_CALL(glDeleteBuffers(1, &_uploadBuffers[i]));
+			_uploadBuffers[i] = 0;
+		}
+		_uploadBufferSizes[i] = 0;
+	}
+	_nextUploadBuffer = 0;
+}
+#endif
+
 //
 // Surface
 //
@@ -158,6 +158,30 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+#ifdef USE_GLAD
+	/**
+	 * Upload the lines of area through the next pixel buffer object of the
+	 * ring. The copy into the buffer returns right away and the transfer to
+	 * the texture happens while the driver is busy with earlier frames.
+	 *
+	 * @return false if the buffer could not be used, so that the caller
+	 *         has to upload directly.
+	 */
+	bool updateAreaBuffered(const Common::Rect &area, const Graphics::Surface &src);
+
+	/** Release the pixel buffer objects and pending fences. */
+	void destroyUploadBuffers();
+
+	enum {
+		kNumUploadBuffers = 3
+	};
+
+	GLuint _uploadBuffers[kNumUploadBuffers];
+	GLsizeiptr _uploadBufferSizes[kNumUploadBuffers];
+	GLsync _uploadFences[kNumUploadBuffers];
+	uint _nextUploadBuffer;
+#endif
 };
 
 /**
@@ -225,6 +249,11 @@ public:
 	void flagDirty() { _allDirty = true; }
 	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
 
+	/**
+	 * @return The area which changed since the last updateGLTexture() call.
+	 */
+	Common::Rect getDirtyArea() const;
+
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
 
@@ -264,8 +293,6 @@ public:
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
 	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
-
-	Common::Rect getDirtyArea() const;
 private:
 	bool _allDirty;
 	Common::Rect _dirtyArea;
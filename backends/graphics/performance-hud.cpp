@@ -0,0 +1,183 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/graphics/performance-hud.h"
+
+#include "audio/mixer.h"
+#include "common/algorithm.h"
+#include "common/system.h"
+#include "graphics/font.h"
+
+std::atomic<uint32> PerformanceHud::_sleepTime(0);
+
+PerformanceHud::PerformanceHud() :
+	_visible(false), _frameStart(0), _lastRender(0), _nextFrame(0), _frameCount(0),
+	_dirtyPixels(0), _totalPixels(0), _uploadBytes(0), _intervalFrames(0), _underrunBase(0) {
+}
+
+PerformanceHud::~PerformanceHud() {
+	_surface.free();
+}
+
+void PerformanceHud::setVisible(bool visible) {
+	if (_visible == visible)
+		return;
+
+	_visible = visible;
+	_frameStart = 0;
+	_nextFrame = _frameCount = 0;
+	_dirtyPixels = _totalPixels = _uploadBytes = 0;
+	_intervalFrames = 0;
+	_sleepTime = 0;
+	_surface.free();
+
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::Mixer::OutputStats stats;
+	_underrunBase = (mixer && mixer->getOutputStats(stats)) ? stats.underruns : 0;
+}
+
+void PerformanceHud::beginFrame() {
+	if (!_visible)
+		return;
+
+	const uint64 now = g_system->getMicros();
+	const uint32 sleep = _sleepTime.exchange(0);
+	if (_frameStart) {
+		Frame &frame = _frames[_nextFrame];
+		frame.duration = (uint32)MIN<uint64>(now - _frameStart, 0xFFFFFFFF);
+		frame.sleep = MIN(sleep, frame.duration);
+		_nextFrame = (_nextFrame + 1) % kFrameHistory;
+		_frameCount = MIN<uint>(_frameCount + 1, kFrameHistory);
+		_intervalFrames++;
+	}
+	_frameStart = now;
+}
+
+void PerformanceHud::addDirtyArea(uint32 dirtyPixels, uint32 totalPixels) {
+	_dirtyPixels += MIN(dirtyPixels, totalPixels);
+	_totalPixels += totalPixels;
+}
+
+void PerformanceHud::addUploadBytes(uint32 bytes) {
+	_uploadBytes += bytes;
+}
+
+bool PerformanceHud::render(const Graphics::Font &font, const Graphics::PixelFormat &format) {
+	if (!_visible)
+		return false;
+
+	const uint32 now = g_system->getMillis(true);
+	if (_surface.getPixels() && _surface.format == format && now - _lastRender < kRenderInterval)
+		return false;
+	_lastRender = now;
+
+	// Frame times, as averages and percentiles over the history
+	uint32 durations[kFrameHistory];
+	uint64 totalDuration = 0, totalSleep = 0;
+	for (uint i = 0; i < _frameCount; ++i) {
+		durations[i] = _frames[i].duration;
+		totalDuration += _frames[i].duration;
+		totalSleep += _frames[i].sleep;
+	}
+	Common::sort(durations, durations + _frameCount);
+
+	Common::String lines[5];
+	uint lineCount = 0;
+	if (_frameCount) {
+		const uint32 average = totalDuration / _frameCount;
+		const uint32 sleep = totalSleep / _frameCount;
+		lines[lineCount++] = Common::String::format("Frame %.1f ms (%u fps)  p50 %.1f  p99 %.1f",
+			average / 1000.0f, average ? (uint)(1000000 / average) : 0,
+			durations[(_frameCount - 1) * 50 / 100] / 1000.0f, durations[(_frameCount - 1) * 99 / 100] / 1000.0f);
+		lines[lineCount++] = Common::String::format("Engine %.1f ms  sleep %.1f ms",
+			(average - sleep) / 1000.0f, sleep / 1000.0f);
+	} else {
+		lines[lineCount++] = "Frame -";
+		lines[lineCount++] = "Engine -";
+	}
+
+	Common::String dirty = _totalPixels ? Common::String::format("%u%%", (uint)(_dirtyPixels * 100 / _totalPixels)) : "-";
+	lines[lineCount++] = Common::String::format("Dirty %s  upload %u KiB/frame", dirty.c_str(),
+		_intervalFrames ? (uint)(_uploadBytes / _intervalFrames / 1024) : 0);
+	_dirtyPixels = _totalPixels = _uploadBytes = 0;
+	_intervalFrames = 0;
+
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::Mixer::OutputStats stats;
+	if (mixer && mixer->getOutputStats(stats)) {
+		// The counter starts over when the output is reset
+		if (stats.underruns < _underrunBase)
+			_underrunBase = 0;
+		lines[lineCount++] = Common::String::format("Audio underruns %u", stats.underruns - _underrunBase);
+	}
+
+	if (!_backendInfo.empty())
+		lines[lineCount++] = _backendInfo;
+
+	// Lay out the text above the frame time graph
+	const int lineHeight = font.getFontHeight() + 1;
+	int width = kFrameHistory;
+	for (uint i = 0; i < lineCount; ++i)
+		width = MAX(width, font.getStringWidth(lines[i]));
+	// Round up, so that the size does not change with every update
+	width = (width + 2 * kMargin + 31) & ~31;
+	const int height = lineCount * lineHeight + kGraphHeight + 3 * kMargin;
+
+	if (_surface.w != width || _surface.h != height || _surface.format != format) {
+		_surface.free();
+		_surface.create(width, height, format);
+	}
+
+	const uint32 background = format.ARGBToColor(255, 40, 40, 40);
+	const uint32 white = format.ARGBToColor(255, 255, 255, 255);
+	_surface.fillRect(Common::Rect(width, height), background);
+
+	for (uint i = 0; i < lineCount; ++i)
+		font.drawString(&_surface, lines[i], kMargin, kMargin + i * lineHeight, width - 2 * kMargin, white);
+
+	drawGraph(kMargin, 2 * kMargin + lineCount * lineHeight);
+	return true;
+}
+
+void PerformanceHud::drawGraph(int x, int y) {
+	const Graphics::PixelFormat &format = _surface.format;
+	const uint32 grid = format.ARGBToColor(255, 90, 90, 90);
+	const uint32 good = format.ARGBToColor(255, 80, 200, 80);
+	const uint32 slow = format.ARGBToColor(255, 230, 200, 60);
+	const uint32 bad = format.ARGBToColor(255, 230, 70, 60);
+
+	_surface.fillRect(Common::Rect(x, y, x + kFrameHistory, y + kGraphHeight), format.ARGBToColor(255, 20, 20, 20));
+
+	// Lines at 60 and 30 frames per second
+	const int bottom = y + kGraphHeight;
+	_surface.hLine(x, bottom - 16667 * kGraphHeight / kGraphMaxMicros, x + kFrameHistory - 1, grid);
+	_surface.hLine(x, bottom - 33333 * kGraphHeight / kGraphMaxMicros, x + kFrameHistory - 1, grid);
+
+	// One bar per frame, the newest one on the right
+	const uint first = (_nextFrame + kFrameHistory - _frameCount) % kFrameHistory;
+	for (uint i = 0; i < _frameCount; ++i) {
+		const uint32 duration = _frames[(first + i) % kFrameHistory].duration;
+		const int barHeight = MAX<int>(1, MIN<uint32>(duration, kGraphMaxMicros) * kGraphHeight / kGraphMaxMicros);
+		const uint32 color = duration <= 17000 ? good : (duration <= 34000 ? slow : bad);
+		const int barX = x + kFrameHistory - _frameCount + i;
+		_surface.vLine(barX, bottom - barHeight, bottom - 1, color);
+	}
+}
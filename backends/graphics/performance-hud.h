@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_PERFORMANCE_HUD_H
+#define BACKENDS_GRAPHICS_PERFORMANCE_HUD_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "graphics/surface.h"
+
+#include <atomic>
+
+namespace Graphics {
+class Font;
+}
+
+/**
+ * Collects the timing of the frames shown by a graphics manager and renders
+ * it into a small overlay, so that performance problems can be looked at on
+ * the machine where they happen.
+ *
+ * The graphics manager reports what it knows about each frame, the backend
+ * reports the time spent in OSystem::delayMillis() and the audio underruns
+ * are taken from the mixer. The overlay itself is only rendered a few times
+ * per second, so that it does not disturb the measurements too much.
+ */
+class PerformanceHud {
+public:
+	PerformanceHud();
+	~PerformanceHud();
+
+	bool isVisible() const { return _visible; }
+	void setVisible(bool visible);
+
+	/**
+	 * Mark the start of a new frame. This is to be called by updateScreen(),
+	 * even when the screen does not need to be redrawn.
+	 */
+	void beginFrame();
+
+	/** Report the part of the screen which changed in the current frame. */
+	void addDirtyArea(uint32 dirtyPixels, uint32 totalPixels);
+
+	/** Report pixel data sent to the GPU or the display in the current frame. */
+	void addUploadBytes(uint32 bytes);
+
+	/** Set a line of backend specific information, shown below the others. */
+	void setBackendInfo(const Common::String &info) { _backendInfo = info; }
+
+	/** Report time the application slept, from any thread. */
+	static void addSleepTime(uint32 micros) { _sleepTime += micros; }
+
+	/**
+	 * Render the overlay again if its contents are out of date.
+	 *
+	 * @return true if the contents of getSurface() changed.
+	 */
+	bool render(const Graphics::Font &font, const Graphics::PixelFormat &format);
+
+	/** Return the overlay, as last rendered. */
+	const Graphics::Surface &getSurface() const { return _surface; }
+
+private:
+	enum {
+		kFrameHistory = 128,
+		kRenderInterval = 250,
+		kGraphHeight = 40,
+		kGraphMaxMicros = 50000,
+		kMargin = 4
+	};
+
+	struct Frame {
+		uint32 duration;
+		uint32 sleep;
+	};
+
+	void drawGraph(int x, int y);
+
+	bool _visible;
+	uint64 _frameStart;
+	uint32 _lastRender;
+	Frame _frames[kFrameHistory];
+	uint _nextFrame;
+	uint _frameCount;
+
+	// Totals since the overlay was last rendered
+	uint64 _dirtyPixels;
+	uint64 _totalPixels;
+	uint64 _uploadBytes;
+	uint _intervalFrames;
+
+	uint32 _underrunBase;
+	Common::String _backendInfo;
+	Graphics::Surface _surface;
+
+	static std::atomic<uint32> _sleepTime;
+};
+
+#endif
@@ -183,6 +183,20 @@ void SdlGraphicsManager::initSizeHint(const Graphics::ModeList &modes) {
 #endif
 }
 
+uint SdlGraphicsManager::getDisplayRefreshRate() const {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	SDL_Window *window = _window ? _window->getSDLWindow() : nullptr;
+	if (window) {
+		const int displayIndex = SDL_GetWindowDisplayIndex(window);
+		SDL_DisplayMode mode;
+		if (displayIndex >= 0 && SDL_GetCurrentDisplayMode(displayIndex, &mode) == 0 && mode.refresh_rate > 0) {
+			return mode.refresh_rate;
+		}
+	}
+#endif
+	return 0;
+}
+
 bool SdlGraphicsManager::showMouse(bool visible) {
 	if (visible == _cursorVisible) {
 		return visible;
@@ -391,6 +405,10 @@ bool SdlGraphicsManager::notifyEvent(const Common::Event &event) {
 		saveScreenshot();
 		return true;
 
+	case kActionTogglePerformanceHud:
+		setPerformanceHudVisible(!isPerformanceHudVisible());
+		return true;
+
 	default:
 		return false;
 	}
@@ -488,5 +506,12 @@ Common::Keymap *SdlGraphicsManager::getKeymap() {
 		keymap->addAction(act);
 	}
 
+	if (canShowPerformanceHud()) {
+		act = new Action("PHUD", _("Toggle performance statistics"));
+		act->addDefaultInputMapping("C+A+p");
+		act->setCustomBackendActionEvent(kActionTogglePerformanceHud);
+		keymap->addAction(act);
+	}
+
 	return keymap;
 }
@@ -133,6 +133,8 @@ public:
 
 	void initSizeHint(const Graphics::ModeList &modes) override;
 
+	uint getDisplayRefreshRate() const override;
+
 	Common::Keymap *getKeymap();
 
 protected:
@@ -146,7 +148,8 @@ protected:
 		kActionIncreaseScaleFactor,
 		kActionDecreaseScaleFactor,
 		kActionNextScaleFilter,
-		kActionPreviousScaleFilter
+		kActionPreviousScaleFilter,
+		kActionTogglePerformanceHud
 	};
 
 	/** Obtain the user configured fullscreen resolution, or default to the desktop resolution */
@@ -25,6 +25,7 @@
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -40,6 +41,7 @@
 #include "graphics/scaler.h"
 #include "graphics/scaler/aspect.h"
 #include "graphics/surface.h"
+#include "graphics/tile-diff.h"
 #include "gui/debugger.h"
 #include "gui/EventRecorder.h"
 #ifdef USE_PNG
@@ -111,7 +113,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	SdlGraphicsManager(sdlEventSource, window),
 #ifdef USE_OSD
 	_osdMessageSurface(nullptr), _osdMessageAlpha(SDL_ALPHA_TRANSPARENT), _osdMessageFadeStartTime(0),
-	_osdIconSurface(nullptr),
+	_osdIconSurface(nullptr), _performanceHudSurface(nullptr),
 #endif
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	_renderer(nullptr), _screenTexture(nullptr),
@@ -137,6 +139,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_transactionMode(kTransactionNone),
 	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
+	_tileDiffEnabled(false), _tileDiffChangedArea(0), _tileDiffUpdatedArea(0), _tileDiffFrames(0), _dirtyAreaPercentage(-1),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0) {
 
@@ -163,6 +166,9 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 		_enableFocusRectDebugCode = ConfMan.getBool("use_sdl_debug_focusrect");
 #endif
 
+	if (ConfMan.hasKey("use_sdl_tile_diff"))
+		_tileDiffEnabled = ConfMan.getBool("use_sdl_tile_diff");
+
 	_videoMode.isHwPalette = false;
 
 #if defined(USE_ASPECT)
@@ -1068,6 +1074,11 @@ void SurfaceSdlGraphicsManager::unloadGFXMode() {
 		SDL_FreeSurface(_osdIconSurface);
 		_osdIconSurface = nullptr;
 	}
+
+	if (_performanceHudSurface) {
+		SDL_FreeSurface(_performanceHudSurface);
+		_performanceHudSurface = nullptr;
+	}
 #endif
 
 #if defined(WIN32) && !SDL_VERSION_ATLEAST(2, 0, 0)
@@ -1268,6 +1279,19 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		undrawMouse();
 
 #ifdef USE_OSD
+	if (_performanceHud.isVisible()) {
+		_performanceHud.beginFrame();
+
+		// Measured before the OSD forces a full redraw
+		uint32 dirtyPixels = width * height;
+		if (!_forceRedraw) {
+			dirtyPixels = 0;
+			for (int i = 0; i < _numDirtyRects; ++i)
+				dirtyPixels += _dirtyRectList[i].w * _dirtyRectList[i].h;
+		}
+		_performanceHud.addDirtyArea(dirtyPixels, width * height);
+	}
+
 	updateOSD();
 #endif
 
@@ -1483,6 +1507,14 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 
 		// Finally, blit all our changes to the screen
 		if (!_displayDisabled) {
+#ifdef USE_OSD
+			if (_performanceHud.isVisible()) {
+				uint32 uploadBytes = 0;
+				for (int i = 0; i < actualDirtyRects; ++i)
+					uploadBytes += _dirtyRectList[i].w * _dirtyRectList[i].h * _hwScreen->format->BytesPerPixel;
+				_performanceHud.addUploadBytes(uploadBytes);
+			}
+#endif
 			updateScreen(_dirtyRectList, actualDirtyRects);
 		}
 	}
@@ -1490,6 +1522,16 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	// Set up the old scale factor
 	_scaler->setFactor(oldScaleFactor);
 
+	if (_tileDiffEnabled && ++_tileDiffFrames == TILE_DIFF_REPORT_FRAMES) {
+		if (_tileDiffUpdatedArea) {
+			_dirtyAreaPercentage = _tileDiffChangedArea * 100 / _tileDiffUpdatedArea;
+			debug(3, "SurfaceSdlGraphicsManager: %d%% of the updated screen area changed in the last %d frames",
+				_dirtyAreaPercentage, TILE_DIFF_REPORT_FRAMES);
+		}
+		_tileDiffChangedArea = _tileDiffUpdatedArea = 0;
+		_tileDiffFrames = 0;
+	}
+
 	_numDirtyRects = 0;
 	_forceRedraw = false;
 	_cursorNeedsRedraw = false;
@@ -1620,12 +1662,27 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 	assert(h > 0 && y + h <= _videoMode.screenHeight);
 	assert(w > 0 && x + w <= _videoMode.screenWidth);
 
-	addDirtyRect(x, y, w, h, false);
-
 	// Try to lock the screen surface
 	if (SDL_LockSurface(_screen) == -1)
 		error("SDL_LockSurface failed: %s", SDL_GetError());
 
+	if (_tileDiffEnabled && !_forceRedraw) {
+		// Many engines update much more than what changed, often the
+		// whole screen. The screen surface still holds the previous
+		// frame, so only pass the tiles which differ on to the scaler.
+		_tileDiffRects.clear();
+		_tileDiffChangedArea += Graphics::diffTiles((const byte *)_screen->pixels, _screen->pitch, (const byte *)buf, pitch,
+			Common::Rect(x, y, x + w, y + h), _screenFormat.bytesPerPixel, _tileDiffRects);
+		_tileDiffUpdatedArea += w * h;
+
+		for (uint i = 0; i < _tileDiffRects.size(); ++i) {
+			const Common::Rect &r = _tileDiffRects[i];
+			addDirtyRect(r.left, r.top, r.width(), r.height(), false);
+		}
+	} else {
+		addDirtyRect(x, y, w, h, false);
+	}
+
 	byte *dst = (byte *)_screen->pixels + y * _screen->pitch + x * _screenFormat.bytesPerPixel;
 	if (_videoMode.screenWidth == w && pitch == _screen->pitch) {
 		memcpy(dst, buf, h*pitch);
@@ -2581,12 +2638,57 @@ void SurfaceSdlGraphicsManager::updateOSD() {
 		}
 	}
 
-	if (_osdIconSurface || _osdMessageSurface) {
+	updatePerformanceHud();
+
+	if (_osdIconSurface || _osdMessageSurface || _performanceHudSurface) {
 		// Redraw the area below the icon and message for the transparent blit to give correct results.
 		_forceRedraw = true;
 	}
 }
 
+void SurfaceSdlGraphicsManager::updatePerformanceHud() {
+	// The overlay is not drawn in paletted modes
+	if (!_performanceHud.isVisible() || _hwScreen->format->BytesPerPixel < 2) {
+		if (_performanceHudSurface) {
+			SDL_FreeSurface(_performanceHudSurface);
+			_performanceHudSurface = nullptr;
+		}
+		return;
+	}
+
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kLocalizedFont);
+	if (!_performanceHud.render(*font, convertSDLPixelFormat(_hwScreen->format)))
+		return;
+
+	const Graphics::Surface &hud = _performanceHud.getSurface();
+	if (!_performanceHudSurface || _performanceHudSurface->w != hud.w || _performanceHudSurface->h != hud.h) {
+		if (_performanceHudSurface)
+			SDL_FreeSurface(_performanceHudSurface);
+
+		_performanceHudSurface = SDL_CreateRGBSurface(
+			SDL_SWSURFACE,
+			hud.w, hud.h, _hwScreen->format->BitsPerPixel, _hwScreen->format->Rmask, _hwScreen->format->Gmask, _hwScreen->format->Bmask, _hwScreen->format->Amask
+		);
+		if (!_performanceHudSurface)
+			error("updatePerformanceHud: SDL_CreateRGBSurface failed: %s", SDL_GetError());
+
+		SDL_SetAlpha(_performanceHudSurface, SDL_RLEACCEL | SDL_SRCALPHA, SDL_ALPHA_OPAQUE * 85 / 100);
+	}
+
+	if (SDL_LockSurface(_performanceHudSurface))
+		error("updatePerformanceHud: SDL_LockSurface failed: %s", SDL_GetError());
+
+	const byte *src = (const byte *)hud.getPixels();
+	byte *dst = (byte *)_performanceHudSurface->pixels;
+	for (int y = 0; y < hud.h; ++y) {
+		memcpy(dst, src, hud.w * hud.format.bytesPerPixel);
+		src += hud.pitch;
+		dst += _performanceHudSurface->pitch;
+	}
+
+	SDL_UnlockSurface(_performanceHudSurface);
+}
+
 void SurfaceSdlGraphicsManager::drawOSD() {
 	if (_osdMessageSurface) {
 		SDL_Rect dstRect = getOSDMessageRect();
@@ -2597,6 +2699,15 @@ void SurfaceSdlGraphicsManager::drawOSD() {
 		SDL_Rect dstRect = getOSDIconRect();
 		SDL_BlitSurface(_osdIconSurface, nullptr, _hwScreen, &dstRect);
 	}
+
+	if (_performanceHudSurface) {
+		SDL_Rect dstRect;
+		dstRect.x = 10;
+		dstRect.y = 10;
+		dstRect.w = _performanceHudSurface->w;
+		dstRect.h = _performanceHudSurface->h;
+		SDL_BlitSurface(_performanceHudSurface, nullptr, _hwScreen, &dstRect);
+	}
 }
 
 #endif
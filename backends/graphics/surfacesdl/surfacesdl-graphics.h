@@ -27,6 +27,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
+#include "common/array.h"
 #include "common/events.h"
 #include "common/mutex.h"
 
@@ -77,6 +78,13 @@ public:
 	bool setScaler(uint mode, int factor) override;
 	uint getScaler() const override;
 	uint getScaleFactor() const override;
+
+	/**
+	 * Return how much of the screen area engines passed to copyRectToScreen()
+	 * actually changed over the last frames, in percent, or -1 if tile
+	 * diffing is disabled or no data is available yet.
+	 */
+	int getDirtyAreaPercentage() const { return _dirtyAreaPercentage; }
 #ifdef USE_RGB_COLOR
 	Graphics::PixelFormat getScreenFormat() const override { return _screenFormat; }
 	Common::List<Graphics::PixelFormat> getSupportedFormats() const override;
@@ -130,6 +138,8 @@ public:
 #ifdef USE_OSD
 	void displayMessageOnOSD(const Common::U32String &msg) override;
 	void displayActivityIconOnOSD(const Graphics::Surface *icon) override;
+
+	bool canShowPerformanceHud() const override { return true; }
 #endif
 
 	// Override from Common::EventObserver
@@ -161,6 +171,10 @@ protected:
 	SDL_Surface *_osdIconSurface;
 	/** Screen rectangle where the OSD background activity icon is drawn */
 	SDL_Rect getOSDIconRect() const;
+	/** Surface containing the rendered performance overlay */
+	SDL_Surface *_performanceHudSurface;
+	/** Update the performance overlay surface if it is out of date */
+	void updatePerformanceHud();
 
 	void updateOSD();
 	void drawOSD();
@@ -352,6 +366,19 @@ protected:
 	SDL_Rect _prevDirtyRectList[NUM_DIRTY_RECT];
 	int _numPrevDirtyRects;
 
+	// Tile diffing of the game screen, see copyRectToScreen().
+	// Enabled with the use_sdl_tile_diff config key.
+	enum {
+		TILE_DIFF_REPORT_FRAMES = 100
+	};
+
+	bool _tileDiffEnabled;
+	Common::Array<Common::Rect> _tileDiffRects;
+	uint64 _tileDiffChangedArea;
+	uint64 _tileDiffUpdatedArea;
+	uint _tileDiffFrames;
+	int _dirtyAreaPercentage;
+
 	struct MousePos {
 		// The size and hotspot of the original cursor image.
 		int16 w, h;
@@ -23,6 +23,7 @@
 #define BACKENDS_GRAPHICS_WINDOWED_H
 
 #include "backends/graphics/graphics.h"
+#include "backends/graphics/performance-hud.h"
 #include "common/frac.h"
 #include "common/rect.h"
 #include "common/config-manager.h"
@@ -103,6 +104,25 @@ public:
 	int getWindowWidth() const { return _windowWidth; }
 	int getWindowHeight() const { return _windowHeight; }
 
+	/**
+	 * @returns whether the graphics manager draws the performance overlay.
+	 */
+	virtual bool canShowPerformanceHud() const { return false; }
+
+	bool isPerformanceHudVisible() const { return _performanceHud.isVisible(); }
+
+	/**
+	 * Show or hide the overlay with frame timing and other statistics on top
+	 * of everything else.
+	 */
+	void setPerformanceHudVisible(bool visible) {
+		if (!canShowPerformanceHud())
+			return;
+
+		_performanceHud.setVisible(visible);
+		_forceRedraw = true;
+	}
+
 protected:
 	/**
 	 * @returns whether or not the game screen must have aspect ratio correction
@@ -387,6 +407,12 @@ protected:
 	 */
 	int _cursorX, _cursorY;
 
+	/**
+	 * Statistics for the performance overlay, which are to be fed and drawn
+	 * by the subclasses returning true from canShowPerformanceHud().
+	 */
+	PerformanceHud _performanceHud;
+
 private:
 	void populateDisplayAreaDrawRect(const frac_t displayAspect, int originalWidth, int originalHeight, Common::Rect &drawRect) const {
 		int mode = getStretchMode();
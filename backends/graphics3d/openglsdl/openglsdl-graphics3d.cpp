@@ -58,11 +58,21 @@ OpenGLSdlGraphics3dManager::OpenGLSdlGraphics3dManager(SdlEventSource *eventSour
 	_lockAspectRatio(true),
 	_stretchMode(STRETCH_FIT),
 	_frameBuffer(nullptr),
+	_renderScale(100),
+	_dynamicRenderScale(false),
+	_currentRenderScale(100),
+	_renderScaled(false),
+	_lastFrameTime(0),
+	_frameTimeTotal(0),
+	_frameTimeCount(0),
+	_renderScaleGoodWindows(0),
 	_surfaceRenderer(nullptr),
 	_engineRequestedWidth(0),
 	_engineRequestedHeight(0),
 	_transactionMode(kTransactionNone) {
 	ConfMan.registerDefault("antialiasing", 0);
+	ConfMan.registerDefault("render_scale", 100);
+	ConfMan.registerDefault("render_scale_dynamic", false);
 	ConfMan.registerDefault("aspect_ratio", true);
 
 	// Don't start at zero so that the value is never the same as the surface graphics manager
@@ -297,6 +307,13 @@ void OpenGLSdlGraphics3dManager::setupScreen() {
 	closeOverlay();
 
 	_antialiasing = ConfMan.getInt("antialiasing");
+	_renderScale = CLIP<int>(ConfMan.getInt("render_scale"), kMinRenderScale, kMaxRenderScale);
+	_dynamicRenderScale = ConfMan.getBool("render_scale_dynamic");
+	_currentRenderScale = _renderScale;
+	_lastFrameTime = 0;
+	_frameTimeTotal = 0;
+	_frameTimeCount = 0;
+	_renderScaleGoodWindows = 0;
 
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	bool needsWindowReset = false;
@@ -434,6 +451,12 @@ void OpenGLSdlGraphics3dManager::handleResizeImpl(const int width, const int hei
 	delete _overlayBackground;
 	_overlayBackground = nullptr;
 
+	// Games which adapt to any resolution follow the window size at the render scale
+	if (_renderScaled || (!_frameBuffer && shouldScaleRendering())) {
+		createScaledFramebuffer(width, height);
+		_frameBuffer->attach();
+	}
+
 	// Re-setup the scaling for the screen
 	recalculateDisplayAreas();
 
@@ -441,6 +464,19 @@ void OpenGLSdlGraphics3dManager::handleResizeImpl(const int width, const int hei
 	_screenChangeCount++;
 }
 
+void OpenGLSdlGraphics3dManager::recalculateDisplayAreas() {
+	SdlGraphicsManager::recalculateDisplayAreas();
+
+	// The offscreen rendering at the render scale always covers the whole window
+	if (_renderScaled && _windowHeight) {
+		_gameDrawRect = Common::Rect(_windowWidth, _windowHeight);
+		if (!_overlayInGUI) {
+			_activeArea.drawRect = _gameDrawRect;
+			notifyActiveAreaChanged();
+		}
+	}
+}
+
 bool OpenGLSdlGraphics3dManager::gameNeedsAspectRatioCorrection() const {
 	if (_lockAspectRatio) {
 		const uint width = getWidth();
@@ -603,6 +639,64 @@ bool OpenGLSdlGraphics3dManager::shouldRenderToFramebuffer() const {
 	return !engineSupportsArbitraryResolutions && _supportsFrameBuffer;
 }
 
+bool OpenGLSdlGraphics3dManager::shouldScaleRendering() const {
+	bool engineSupportsArbitraryResolutions = g_engine && g_engine->hasFeature(Engine::kSupportsArbitraryResolutions);
+	return engineSupportsArbitraryResolutions && _supportsFrameBuffer && (_renderScale != 100 || _dynamicRenderScale);
+}
+
+void OpenGLSdlGraphics3dManager::createScaledFramebuffer(int windowWidth, int windowHeight) {
+	delete _frameBuffer;
+	_frameBuffer = createFramebuffer(MAX(1, windowWidth * _currentRenderScale / 100),
+	                                 MAX(1, windowHeight * _currentRenderScale / 100));
+	_renderScaled = true;
+}
+
+void OpenGLSdlGraphics3dManager::updateDynamicRenderScale() {
+	const uint64 now = g_system->getMicros();
+	const uint64 frameTime = _lastFrameTime ? now - _lastFrameTime : 0;
+	_lastFrameTime = now;
+
+	// Long stalls, e.g. while loading, say nothing about the rendering
+	if (!frameTime || frameTime > 1000000)
+		return;
+
+	_frameTimeTotal += frameTime;
+	if (++_frameTimeCount < kRenderScaleFrameWindow)
+		return;
+
+	const uint64 average = _frameTimeTotal / _frameTimeCount;
+	_frameTimeTotal = 0;
+	_frameTimeCount = 0;
+
+	const uint refreshRate = getDisplayRefreshRate();
+	const uint64 budget = 1000000 / (refreshRate ? refreshRate : 60);
+
+	// With vsync the frame time does not go below the budget, so a higher
+	// scale is only tried after a while without missing it
+	int scale = _currentRenderScale;
+	if (average > budget * 115 / 100) {
+		scale = MAX<int>(MIN<int>(_renderScale, kMinDynamicRenderScale), scale - kRenderScaleStep);
+		_renderScaleGoodWindows = 0;
+	} else if (average <= budget * 105 / 100 && scale < _renderScale) {
+		if (++_renderScaleGoodWindows >= kRenderScaleProbeWindows) {
+			scale = MIN<int>(_renderScale, scale + kRenderScaleStep);
+			_renderScaleGoodWindows = 0;
+		}
+	}
+
+	if (scale == _currentRenderScale)
+		return;
+
+	debug(2, "OpenGLSdlGraphics3dManager: Average frame time %u us, changing the render scale to %d%%",
+	      (uint)average, scale);
+	_currentRenderScale = scale;
+	createScaledFramebuffer(_windowWidth, _windowHeight);
+	recalculateDisplayAreas();
+
+	// Let the engine adapt to the new size, as after a window resize
+	_screenChangeCount++;
+}
+
 void OpenGLSdlGraphics3dManager::drawOverlay() {
 	_surfaceRenderer->prepareState();
 
@@ -659,6 +753,11 @@ void OpenGLSdlGraphics3dManager::updateScreen() {
 #else
 	SDL_GL_SwapBuffers();
 #endif
+	OpenGLContext.endFrame();
+
+	if (_renderScaled && _dynamicRenderScale) {
+		updateDynamicRenderScale();
+	}
 
 	if (_frameBuffer) {
 		_frameBuffer->attach();
@@ -747,6 +846,7 @@ void OpenGLSdlGraphics3dManager::closeOverlay() {
 
 	delete _frameBuffer;
 	_frameBuffer = nullptr;
+	_renderScaled = false;
 
 	OpenGLContext.reset();
 }
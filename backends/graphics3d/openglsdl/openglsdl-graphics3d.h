@@ -149,6 +149,7 @@ protected:
 	void setupScreen();
 
 	void handleResizeImpl(const int width, const int height) override;
+	void recalculateDisplayAreas() override;
 
 	bool saveScreenshot(const Common::String &filename) const override;
 
@@ -175,6 +176,40 @@ protected:
 	OpenGL::FrameBuffer *createFramebuffer(uint width, uint height);
 	bool shouldRenderToFramebuffer() const;
 
+	enum {
+		kMinRenderScale = 25,
+		kMaxRenderScale = 200,
+		kMinDynamicRenderScale = 50,
+		kRenderScaleStep = 10,
+		kRenderScaleFrameWindow = 30,  ///< Frames whose average time is compared to the budget
+		kRenderScaleProbeWindows = 10  ///< Windows within budget before trying a higher scale
+	};
+
+	/**
+	 * Size at which games adapting to any resolution are rendered, in percent
+	 * of the window size. They are rendered offscreen and scaled to the window
+	 * unless this is 100.
+	 */
+	int _renderScale;
+
+	/** Whether the render scale is lowered while frames take too long. */
+	bool _dynamicRenderScale;
+
+	/** The render scale in effect, which is lower than _renderScale when reduced dynamically. */
+	int _currentRenderScale;
+
+	/** Whether _frameBuffer is the offscreen rendering at the render scale. */
+	bool _renderScaled;
+
+	uint64 _lastFrameTime;
+	uint64 _frameTimeTotal;
+	uint _frameTimeCount;
+	uint _renderScaleGoodWindows;
+
+	bool shouldScaleRendering() const;
+	void createScaledFramebuffer(int windowWidth, int windowHeight);
+	void updateDynamicRenderScale();
+
 protected:
 
 	enum TransactionMode {
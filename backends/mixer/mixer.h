@@ -55,6 +55,12 @@ public:
 	 */
 	virtual int resumeAudio() = 0;
 
+	/**
+	 * Called regularly from the main thread, to let the mixer manager
+	 * adjust the audio output
+	 */
+	virtual void update() {}
+
 protected:
 	/** The mixer implementation */
 	Audio::MixerImpl *_mixer;
@@ -39,6 +39,21 @@
 #define SAMPLES_PER_SEC 44100
 #endif
 
+enum {
+	// How often update() checks for underruns, in milliseconds
+	kAdaptInterval = 1000,
+	// Checks without underruns before the buffer is shrunk
+	kStableChecksToShrink = 10,
+	kMaxStableChecksToShrink = 160,
+	// Buffer size update() does not grow beyond, about 185 ms at 44.1 kHz
+	kMaxAdaptiveBufferSize = 8192
+};
+
+SdlMixerManager::SdlMixerManager() : _adaptiveBuffer(false), _minBufferSize(0), _lastAdaptTime(0), _lastStats(),
+	_stableChecks(0), _stableChecksToShrink(kStableChecksToShrink), _lastAdaptShrank(false) {
+	memset(&_obtained, 0, sizeof(_obtained));
+}
+
 SdlMixerManager::~SdlMixerManager() {
 	_mixer->setReady(false);
 
@@ -113,6 +128,11 @@ void SdlMixerManager::init() {
 	assert(_mixer);
 	_mixer->setReady(true);
 
+	if (ConfMan.hasKey("audio_buffer_adaptive", Common::ConfigManager::kApplicationDomain))
+		_adaptiveBuffer = ConfMan.getBool("audio_buffer_adaptive", Common::ConfigManager::kApplicationDomain);
+	_minBufferSize = _obtained.samples;
+	_lastAdaptTime = SDL_GetTicks();
+
 	startAudio();
 }
 
@@ -200,6 +220,82 @@ void SdlMixerManager::sdlCallback(void *this_, byte *samples, int len) {
 	manager->callbackHandler(samples, len);
 }
 
+void SdlMixerManager::update() {
+	if (!_adaptiveBuffer || _audioSuspended || !_mixer || !_mixer->isReady())
+		return;
+
+	const uint32 now = SDL_GetTicks();
+	if (now - _lastAdaptTime < kAdaptInterval)
+		return;
+	_lastAdaptTime = now;
+
+	Audio::Mixer::OutputStats stats;
+	if (!_mixer->getOutputStats(stats))
+		return;
+	const uint32 underruns = stats.underruns - _lastStats.underruns;
+	const uint32 callbacks = stats.callbacks - _lastStats.callbacks;
+	const uint64 callbackTime = stats.totalCallbackTime - _lastStats.totalCallbackTime;
+	_lastStats = stats;
+	if (!callbacks)
+		return;
+
+	const uint16 samples = _obtained.samples;
+	if (underruns) {
+		_stableChecks = 0;
+		if (samples >= kMaxAdaptiveBufferSize)
+			return;
+
+		// Wait longer before shrinking again when the smaller buffer did not hold
+		if (_lastAdaptShrank)
+			_stableChecksToShrink = MIN<uint>(_stableChecksToShrink * 2, kMaxStableChecksToShrink);
+
+		debug(1, "SDL mixer had %u underruns in %u callbacks, growing the buffer to %d samples", underruns, callbacks, samples * 2);
+		if (reopenAudio(samples * 2))
+			_lastAdaptShrank = false;
+	} else if (samples > _minBufferSize && ++_stableChecks >= _stableChecksToShrink) {
+		_stableChecks = 0;
+
+		// The mixing should take no more than half of the time a buffer half
+		// the size plays, which is a quarter of the current one
+		const uint64 period = (uint64)samples * 1000000 / _obtained.freq;
+		if (callbackTime / callbacks >= period / 4)
+			return;
+
+		debug(1, "SDL mixer had no underruns, shrinking the buffer to %d samples", samples / 2);
+		if (reopenAudio(samples / 2))
+			_lastAdaptShrank = true;
+	}
+}
+
+bool SdlMixerManager::reopenAudio(uint16 samples) {
+	SDL_CloseAudio();
+
+	// The gap while the device is closed is not an underrun
+	_mixer->restartOutputTiming();
+
+	SDL_AudioSpec spec = _obtained;
+	spec.samples = samples;
+	spec.callback = sdlCallback;
+	spec.userdata = this;
+
+	bool result = true;
+	if (SDL_OpenAudio(&spec, nullptr) != 0) {
+		warning("Could not reopen audio device with %d samples: %s", samples, SDL_GetError());
+
+		spec.samples = _obtained.samples;
+		if (SDL_OpenAudio(&spec, nullptr) != 0) {
+			warning("Could not reopen audio device: %s", SDL_GetError());
+			_mixer->setReady(false);
+			return false;
+		}
+		result = false;
+	}
+
+	_obtained = spec;
+	startAudio();
+	return result;
+}
+
 void SdlMixerManager::suspendAudio() {
 	SDL_CloseAudio();
 	_audioSuspended = true;
@@ -211,6 +307,7 @@ int SdlMixerManager::resumeAudio() {
 	if (SDL_OpenAudio(&_obtained, nullptr) < 0) {
 		return -1;
 	}
+	_mixer->restartOutputTiming();
 	SDL_PauseAudio(0);
 	_audioSuspended = false;
 	return 0;
@@ -33,6 +33,7 @@
  */
 class SdlMixerManager : public MixerManager {
 public:
+	SdlMixerManager();
 	virtual ~SdlMixerManager();
 
 	/**
@@ -52,6 +53,12 @@ public:
 	 */
 	virtual int resumeAudio();
 
+	/**
+	 * Adjusts the buffer size to the underruns, if enabled with the
+	 * audio_buffer_adaptive option
+	 */
+	virtual void update();
+
 protected:
 	/**
 	 * The obtained audio specification after opening the
@@ -59,6 +66,31 @@ protected:
 	 */
 	SDL_AudioSpec _obtained;
 
+	/** Whether update() adjusts the buffer size */
+	bool _adaptiveBuffer;
+
+	/** The buffer size the audio was opened with, which is never undercut */
+	uint16 _minBufferSize;
+
+	/** Time of the last check of the output statistics, in milliseconds */
+	uint32 _lastAdaptTime;
+
+	/** Output statistics at the last check */
+	Audio::Mixer::OutputStats _lastStats;
+
+	/** Number of checks without underruns in a row, and how many allow shrinking the buffer */
+	uint _stableChecks;
+	uint _stableChecksToShrink;
+
+	/** Whether the last change of the buffer size shrank it */
+	bool _lastAdaptShrank;
+
+	/**
+	 * Reopens the audio device with @p samples samples per buffer,
+	 * keeping the current buffer size if that fails
+	 */
+	bool reopenAudio(uint16 samples);
+
 	/**
 	 * Returns the desired audio specification
 	 */
@@ -0,0 +1,322 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <curl/curl.h>
+#include "backends/networking/curl/chunkeddownloadrequest.h"
+#include "backends/networking/curl/connectionmanager.h"
+#include "backends/networking/curl/networkreadstream.h"
+#include "common/debug.h"
+#include "common/file.h"
+
+namespace Networking {
+
+ChunkedDownloadRequest::ChunkedDownloadRequest(Common::String url, Common::String localFile, DataCallback cb, ErrorCallback ecb, uint32 chunkSize):
+	Request(cb, ecb), _url(url), _localFilePath(localFile), _localFile(nullptr), _chunkSize(chunkSize),
+	_buffer(new byte[CURL_SESSION_REQUEST_BUFFER_SIZE]), _nextChunkStart(0), _totalSize(0), _downloadedSize(0),
+	_rangesSupported(false), _probed(false) {
+	openLocalFile();
+}
+
+ChunkedDownloadRequest::~ChunkedDownloadRequest() {
+	cleanup();
+	delete _localFile;
+	delete[] _buffer;
+}
+
+bool ChunkedDownloadRequest::openLocalFile() {
+	delete _localFile;
+	_localFile = new Common::DumpFile();
+	if (!_localFile->open(_localFilePath, true)) {
+		warning("ChunkedDownloadRequest: unable to open file to download into");
+		return false;
+	}
+
+	debug(5, "ChunkedDownloadRequest: opened localfile %s", _localFilePath.c_str());
+	return true;
+}
+
+void ChunkedDownloadRequest::startChunk(Chunk *chunk) {
+	// Resume after what was already received for this chunk
+	uint32 from = chunk->start + chunk->written + chunk->data.size();
+
+	Common::String range;
+	if (chunk->size)
+		range = Common::String::format("Range: bytes=%u-%u", from, chunk->start + chunk->size - 1);
+	else
+		range = Common::String::format("Range: bytes=%u-%u", from, chunk->start + _chunkSize - 1);
+
+	chunk->headersList = curl_slist_append(nullptr, range.c_str());
+	chunk->stream = new NetworkReadStream(_url.c_str(), chunk->headersList, Common::String());
+}
+
+void ChunkedDownloadRequest::stopChunk(Chunk *chunk) {
+	delete chunk->stream;
+	chunk->stream = nullptr;
+	curl_slist_free_all(chunk->headersList);
+	chunk->headersList = nullptr;
+}
+
+void ChunkedDownloadRequest::cleanup() {
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		stopChunk(_chunks[i]);
+		delete _chunks[i];
+	}
+	_chunks.clear();
+}
+
+bool ChunkedDownloadRequest::probe() {
+	Chunk *chunk = _chunks[0];
+	long code = chunk->stream->httpResponseCode();
+	if (code == 0) {
+		if (chunk->stream->eos()) {
+			finishError(ErrorResponse(this, false, true, Common::String::format("ChunkedDownloadRequest: request failed: %s", chunk->stream->getError()), chunk->stream->getErrorCode()));
+		}
+		return false;
+	}
+
+	Common::HashMap<Common::String, Common::String> headers = chunk->stream->responseHeadersMap();
+
+	if (code == 206) {
+		// Content-Range: bytes 0-1048575/12345678
+		Common::String contentRange = headers.getValOrDefault("content-range");
+		size_t slash = contentRange.findLastOf('/');
+		if (slash == Common::String::npos || contentRange.substr(slash + 1) == "*") {
+			finishError(ErrorResponse(this, false, true, "ChunkedDownloadRequest: unknown file size in Content-Range", code));
+			return false;
+		}
+
+		_totalSize = atol(contentRange.c_str() + slash + 1);
+		_rangesSupported = true;
+		chunk->size = MIN(_chunkSize, _totalSize);
+		_nextChunkStart = chunk->size;
+		debug(5, "ChunkedDownloadRequest: %s is %u bytes, downloading in chunks", _url.c_str(), _totalSize);
+	} else if (code == 200) {
+		// The server ignored the Range header: the whole file comes through this transfer
+		if (headers.contains("content-length"))
+			_totalSize = atol(headers["content-length"].c_str());
+		_rangesSupported = false;
+		debug(5, "ChunkedDownloadRequest: %s doesn't support ranges", _url.c_str());
+	} else if (code == 416) {
+		// Not even the first byte can be served: the file is empty
+		cleanup();
+		_totalSize = 0;
+		_rangesSupported = true;
+		_nextChunkStart = 0;
+	} else {
+		warning("ChunkedDownloadRequest: HTTP response code is not 200 OK or 206 Partial Content (it's %ld)", code);
+		finishError(ErrorResponse(this, false, true, "HTTP response code is not 200 OK or 206 Partial Content", code));
+		return false;
+	}
+
+	_probed = true;
+	return true;
+}
+
+void ChunkedDownloadRequest::scheduleChunks() {
+	if (!_rangesSupported)
+		return;
+
+	const uint32 maxTransfers = ConnMan.getMaxConcurrentTransfers();
+
+	uint32 transfers = 0;
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		if (_chunks[i]->stream)
+			++transfers;
+	}
+
+	// Completed chunks wait in memory until the ones before them are written,
+	// so bound how far ahead of the file position the transfers may go
+	while (transfers < maxTransfers && _chunks.size() < 2 * maxTransfers && _nextChunkStart < _totalSize) {
+		Chunk *chunk = new Chunk(_nextChunkStart, MIN(_chunkSize, _totalSize - _nextChunkStart));
+		chunk->data.reserve(chunk->size);
+		_chunks.push_back(chunk);
+		startChunk(chunk);
+
+		_nextChunkStart += chunk->size;
+		++transfers;
+	}
+}
+
+bool ChunkedDownloadRequest::receive(Chunk *chunk) {
+	if (!chunk->stream)
+		return true;
+
+	NetworkReadStream *stream = chunk->stream;
+	const long expectedCode = _rangesSupported ? 206 : 200;
+	long code = stream->httpResponseCode();
+	if (code != 0 && code != expectedCode) {
+		warning("ChunkedDownloadRequest: unexpected HTTP response code %ld for bytes from %u", code, chunk->start);
+		finishError(ErrorResponse(this, false, true, "ChunkedDownloadRequest: unexpected HTTP response code", code));
+		return false;
+	}
+
+	uint32 readBytes;
+	while ((readBytes = stream->read(_buffer, CURL_SESSION_REQUEST_BUFFER_SIZE)) != 0) {
+		uint32 oldSize = chunk->data.size();
+		chunk->data.resize(oldSize + readBytes);
+		memcpy(chunk->data.data() + oldSize, _buffer, readBytes);
+		_downloadedSize += readBytes;
+	}
+
+	if (!stream->eos())
+		return true;
+
+	const uint32 received = chunk->written + chunk->data.size();
+	if (!stream->hasError() && code == expectedCode && (!chunk->size || received == chunk->size)) {
+		chunk->complete = true;
+		stopChunk(chunk);
+		return true;
+	}
+
+	// Only range requests can be resumed
+	if (_rangesSupported && chunk->retries < CHUNKED_DOWNLOAD_MAX_RETRIES) {
+		++chunk->retries;
+		debug(5, "ChunkedDownloadRequest: resuming bytes from %u (attempt %u)", chunk->start + received, chunk->retries);
+		stopChunk(chunk);
+		startChunk(chunk);
+		return true;
+	}
+
+	Common::String message = stream->hasError() ? Common::String(stream->getError()) : "ChunkedDownloadRequest: transfer ended early";
+	finishError(ErrorResponse(this, false, true, message, code));
+	return false;
+}
+
+bool ChunkedDownloadRequest::flush() {
+	while (!_chunks.empty()) {
+		// Only the first chunk is at the file's current position
+		Chunk *chunk = _chunks[0];
+
+		if (!chunk->data.empty()) {
+			// Take the data out first, the callback might abort the request
+			Common::Array<byte> data;
+			data.swap(chunk->data);
+			chunk->written += data.size();
+
+			if (_localFile->write(data.data(), data.size()) != data.size()) {
+				warning("ChunkedDownloadRequest: unable to write all received bytes into output file");
+				finishError(ErrorResponse(this, false, true, "ChunkedDownloadRequest::flush: failed to write all bytes into a file", -1));
+				return false;
+			}
+
+			if (_callback) {
+				_response.buffer = data.data();
+				_response.len = data.size();
+				_response.eos = false;
+				(*_callback)(DataResponse(this, &_response));
+
+				if (_state != PROCESSING)
+					return false;
+			}
+		}
+
+		if (!chunk->complete)
+			break;
+
+		delete chunk;
+		_chunks.remove_at(0);
+	}
+
+	return true;
+}
+
+void ChunkedDownloadRequest::handle() {
+	if (!_localFile || !_localFile->isOpen()) {
+		finishError(ErrorResponse(this, false, true, "ChunkedDownloadRequest::handle: failed to open file to write", -1));
+		return;
+	}
+
+	if (!_probed) {
+		if (_chunks.empty()) {
+			_chunks.push_back(new Chunk(0, 0));
+			startChunk(_chunks[0]);
+		}
+
+		if (!probe())
+			return;
+	}
+
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		if (!receive(_chunks[i]))
+			return;
+	}
+
+	if (!flush())
+		return;
+
+	scheduleChunks();
+
+	if (_chunks.empty() && (!_rangesSupported || _nextChunkStart >= _totalSize))
+		finishSuccess();
+}
+
+void ChunkedDownloadRequest::restart() {
+	cleanup();
+	_nextChunkStart = _totalSize = _downloadedSize = 0;
+	_rangesSupported = _probed = false;
+
+	// Written chunks are lost: start over with an empty file
+	openLocalFile();
+	_state = PROCESSING;
+}
+
+void ChunkedDownloadRequest::finishError(ErrorResponse error, RequestState state) {
+	cleanup();
+	if (_localFile)
+		_localFile->close();
+	Request::finishError(error, state);
+}
+
+void ChunkedDownloadRequest::finishSuccess() {
+	Request::finishSuccess();
+
+	if (_localFile) {
+		_localFile->close();
+		delete _localFile;
+		_localFile = nullptr;
+	}
+
+	if (_callback) {
+		_response.buffer = _buffer;
+		_response.len = 0;
+		_response.eos = true;
+		(*_callback)(DataResponse(this, &_response));
+	}
+}
+
+void ChunkedDownloadRequest::abortRequest() {
+	cleanup();
+	if (_localFile)
+		_localFile->close();
+
+	// TODO we need to remove file, but there is no API
+	_state = FINISHED;
+}
+
+double ChunkedDownloadRequest::getProgress() const {
+	if (!_totalSize)
+		return 0;
+	return (double)_downloadedSize / (double)_totalSize;
+}
+
+} // End of namespace Networking
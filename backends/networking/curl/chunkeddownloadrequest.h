@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_NETWORKING_CURL_CHUNKEDDOWNLOADREQUEST_H
+#define BACKENDS_NETWORKING_CURL_CHUNKEDDOWNLOADREQUEST_H
+
+#include "backends/networking/curl/request.h"
+#include "backends/networking/curl/sessionrequest.h"
+#include "common/array.h"
+
+namespace Common {
+class DumpFile;
+}
+
+struct curl_slist;
+
+namespace Networking {
+
+class NetworkReadStream;
+
+#define CHUNKED_DOWNLOAD_CHUNK_SIZE 1 * 1024 * 1024
+#define CHUNKED_DOWNLOAD_MAX_RETRIES 3
+
+/**
+ * @brief Downloads a big file into a local file using parallel range requests
+ *
+ * The first chunk is requested with a Range header. If the server answers
+ * with 206 Partial Content, the remaining chunks are requested in parallel,
+ * up to ConnectionManager::getMaxConcurrentTransfers() at once. Otherwise,
+ * the whole file is received through that first transfer.
+ *
+ * Chunks are written to the file in order. An interrupted chunk resumes
+ * from the last received byte, up to CHUNKED_DOWNLOAD_MAX_RETRIES times.
+ *
+ * The callback gets a SessionFileResponse each time data is written
+ * to the file, with eos set for the last one.
+ */
+class ChunkedDownloadRequest: public Request {
+	struct Chunk {
+		uint32 start;
+		uint32 size; ///< 0 when the size is not known, i.e. the server doesn't support ranges
+		Common::Array<byte> data;
+		uint32 written;
+		NetworkReadStream *stream;
+		curl_slist *headersList;
+		uint retries;
+		bool complete;
+
+		Chunk(uint32 s, uint32 sz): start(s), size(sz), written(0), stream(nullptr), headersList(nullptr), retries(0), complete(false) {}
+	};
+
+	Common::String _url;
+	Common::String _localFilePath;
+	Common::DumpFile *_localFile;
+	uint32 _chunkSize;
+	byte *_buffer;
+
+	/** Chunks not written yet, ordered by their start. */
+	Common::Array<Chunk *> _chunks;
+	uint32 _nextChunkStart;
+	uint32 _totalSize;
+	uint32 _downloadedSize;
+	bool _rangesSupported;
+	bool _probed;
+	SessionFileResponse _response;
+
+	void startChunk(Chunk *chunk);
+	void stopChunk(Chunk *chunk);
+	bool openLocalFile();
+	bool probe();
+	void scheduleChunks();
+	bool receive(Chunk *chunk);
+	bool flush();
+	void cleanup();
+
+	virtual void finishError(ErrorResponse error, RequestState state = FINISHED);
+	virtual void finishSuccess();
+
+public:
+	ChunkedDownloadRequest(Common::String url, Common::String localFile, DataCallback cb = nullptr, ErrorCallback ecb = nullptr, uint32 chunkSize = CHUNKED_DOWNLOAD_CHUNK_SIZE);
+	virtual ~ChunkedDownloadRequest();
+
+	virtual void handle();
+	virtual void restart();
+
+	/**
+	 * @brief Stops the download without calling any callback
+	 *
+	 * Like SessionRequest::abortRequest(), the partial file is left behind.
+	 */
+	void abortRequest();
+
+	/** Returns the file size or 0 if it is not known yet. */
+	uint32 getTotalSize() const { return _totalSize; }
+
+	/** Returns a number in range [0, 1], where 1 is "complete". */
+	double getProgress() const;
+};
+
+} // End of namespace Networking
+
+#endif
@@ -37,9 +37,32 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(nullptr), _timerStarted(false), _frame(0) {
+ConnectionManager::ConnectionManager(): _multi(nullptr), _share(nullptr), _timerStarted(false), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+
+	//share DNS lookups, TLS sessions and connections between all easy handles
+	_share = curl_share_init();
+	if (_share) {
+		curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+		curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+		curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+		// Added in libcurl 7.57.0
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+	}
+
+	//bound the transfers running at once and reuse their connections
+#if LIBCURL_VERSION_NUM >= 0x071E00
+	curl_multi_setopt(_multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long)MAX_CONCURRENT_TRANSFERS);
+	curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)MAX_CONCURRENT_TRANSFERS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, (long)CURLPIPE_MULTIPLEX);
+#endif
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -60,12 +83,25 @@ ConnectionManager::~ConnectionManager() {
 
 	//cleanup
 	curl_multi_cleanup(_multi);
+	if (_share)
+		curl_share_cleanup(_share);
 	curl_global_cleanup();
 	_multi = nullptr;
+	_share = nullptr;
 	_handleMutex.unlock();
 }
 
 void ConnectionManager::registerEasyHandle(CURL *easy) const {
+	if (_share)
+		curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	// Added in libcurl 7.47.0, falls back to HTTP/1.1 when the server doesn't support HTTP/2
+	curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0, wait for a connection to multiplex on instead of opening a new one
+	curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+#endif
 	curl_multi_add_handle(_multi, easy);
 }
 
@@ -98,6 +134,10 @@ uint32 ConnectionManager::getCloudRequestsPeriodInMicroseconds() {
 	return TIMER_INTERVAL * CLOUD_PERIOD;
 }
 
+uint32 ConnectionManager::getMaxConcurrentTransfers() {
+	return MAX_CONCURRENT_TRANSFERS;
+}
+
 const char *ConnectionManager::getCaCertPath() {
 #if defined(__ANDROID__)
 	Common::ArchiveMemberPtr member = SearchMan.getMember("cacert.pem");
@@ -131,6 +171,18 @@ const char *ConnectionManager::getCaCertPath() {
 
 //private goes here:
 
+void ConnectionManager::lockShare(CURL *handle, int data, int access, void *userPtr) {
+	ConnectionManager *manager = (ConnectionManager *)userPtr;
+	if (data >= 0 && (uint32)data < SHARE_LOCKS)
+		manager->_shareMutexes[data].lock();
+}
+
+void ConnectionManager::unlockShare(CURL *handle, int data, void *userPtr) {
+	ConnectionManager *manager = (ConnectionManager *)userPtr;
+	if (data >= 0 && (uint32)data < SHARE_LOCKS)
+		manager->_shareMutexes[data].unlock();
+}
+
 void connectionsThread(void *ignored) {
 	ConnMan.handle();
 }
@@ -30,6 +30,7 @@
 
 typedef void CURL;
 typedef void CURLM;
+typedef void CURLSH;
 struct curl_slist;
 
 namespace Networking {
@@ -42,6 +43,7 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	static const uint32 CLOUD_PERIOD = 1; //every frame
 	static const uint32 CURL_PERIOD = 1; //every frame
 	static const uint32 DEBUG_PRINT_PERIOD = FRAMES_PER_SECOND; // once per second
+	static const uint32 MAX_CONCURRENT_TRANSFERS = 4;
 
 	friend void connectionsThread(void *); //calls handle()
 
@@ -74,7 +76,16 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 		RequestWithCallback(Request *rq = nullptr, RequestCallback cb = nullptr): request(rq), onDeleteCallback(cb) {}
 	};
 
+	/**
+	 * libcurl share locks are given a curl_lock_data value.
+	 * Only DNS, TLS session and connection caches are shared,
+	 * but keep room for all the values libcurl defines.
+	 */
+	static const uint32 SHARE_LOCKS = 8;
+
 	CURLM *_multi;
+	CURLSH *_share;
+	Common::Mutex _shareMutexes[SHARE_LOCKS];
 	bool _timerStarted;
 	Common::Array<RequestWithCallback> _requests, _addedRequests;
 	Common::Mutex _handleMutex, _addedRequestsMutex;
@@ -87,6 +98,9 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	void processTransfers();
 	bool hasAddedRequests();
 
+	static void lockShare(CURL *handle, int data, int access, void *userPtr);
+	static void unlockShare(CURL *handle, int data, void *userPtr);
+
 public:
 	ConnectionManager();
 	virtual ~ConnectionManager();
@@ -95,6 +109,10 @@ public:
 	 * All libcurl transfers are going through this ConnectionManager.
 	 * So, if you want to start any libcurl transfer, you must create
 	 * an easy handle and register it using this method.
+	 *
+	 * The handle is attached to the manager's shared DNS, TLS
+	 * session and connection caches, and asks for HTTP/2 over
+	 * TLS so transfers to the same host share one connection.
 	 */
 	void registerEasyHandle(CURL *easy) const;
 
@@ -118,6 +136,14 @@ public:
 
 	static uint32 getCloudRequestsPeriodInMicroseconds();
 
+	/**
+	 * Return how many transfers libcurl runs at the same time. Easy
+	 * handles registered beyond that wait in libcurl's queue until a
+	 * connection is free, so there is no point in starting more
+	 * transfers than this in parallel.
+	 */
+	static uint32 getMaxConcurrentTransfers();
+
 	/** Return the path to the CA certificates bundle. */
 	static const char *getCaCertPath();
 };
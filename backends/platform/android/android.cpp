@@ -65,6 +65,7 @@
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 
@@ -762,6 +763,18 @@ Common::MutexInternal *OSystem_Android::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Android::createThread(Common::ThreadProc proc, void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_Android::createSemaphore(uint initialCount) {
+	return createPthreadSemaphoreInternal(initialCount);
+}
+
+uint OSystem_Android::getCPUCount() {
+	return getPthreadCPUCount();
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
@@ -197,6 +197,9 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param, const char *name) override;
+	Common::SemaphoreInternal *createSemaphore(uint initialCount) override;
+	uint getCPUCount() override;
 
 	void quit() override;
 
@@ -42,8 +42,10 @@
 
 #include "backends/events/default/default-events.h"
 #include "backends/events/sdl/legacy-sdl-events.h"
+#include "backends/graphics/performance-hud.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -187,6 +189,13 @@ bool OSystem_SDL::hasFeature(Feature f) {
 	 * we are at one initGraphics3d call of supporting OpenGL */
 	if (f == kFeatureOpenGLForGame) return true;
 	if (f == kFeatureShadersForGame) return _supportsShaders;
+#endif
+	if (f == kCpuFeatureSSE2) return SDL_HasSSE2();
+#if SDL_VERSION_ATLEAST(2, 0, 2)
+	if (f == kCpuFeatureAVX2) return SDL_HasAVX2();
+#endif
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+	if (f == kCpuFeatureNEON) return SDL_HasNEON();
 #endif
 	return ModularGraphicsBackend::hasFeature(f);
 }
@@ -694,6 +703,18 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(Common::ThreadProc proc, void *param, const char *name) {
+	return createSdlThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore(uint initialCount) {
+	return createSdlSemaphoreInternal(initialCount);
+}
+
+uint OSystem_SDL::getCPUCount() {
+	return getSdlCPUCount();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
@@ -704,11 +725,28 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
+	if (_mixerManager)
+		_mixerManager->update();
+
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
 #endif
+	{
+		const uint64 start = getMicros();
 		SDL_Delay(msecs);
+		PerformanceHud::addSleepTime((uint32)(getMicros() - start));
+	}
 }
 
 void OSystem_SDL::getTimeAndDate(TimeDate &td, bool skipRecord) const {
@@ -36,19 +36,121 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/threadpool.h"
 #include "common/compression/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
+const char *DefaultSaveFileManager::SYNC_HASHES_FILENAME = ".synchashes";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * Collects a save in memory, so that compressing and writing it can happen
+ * on a worker thread once it is finalized.
+ */
+class DefaultSaveFileManager::BackgroundSaveStream : public Common::SeekableWriteStream {
+public:
+	BackgroundSaveStream(DefaultSaveFileManager &manager, const Common::String &filename, Common::WriteStream *target) :
+		_manager(manager), _filename(filename), _target(target), _buffer(DisposeAfterUse::NO) {}
+
+	~BackgroundSaveStream() override {
+		finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (!_target)
+			return 0;
+		return _buffer.write(dataPtr, dataSize);
+	}
+
+	void finalize() override {
+		if (!_target)
+			return;
+
+		// The job owns the data from now on
+		_manager.queueSave(_filename, _target, _buffer.getData(), _buffer.size());
+		_target = nullptr;
+	}
+
+	int64 pos() const override { return _buffer.pos(); }
+	int64 size() const override { return _buffer.size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _buffer.seek(offset, whence); }
+
+private:
+	DefaultSaveFileManager &_manager;
+	Common::String _filename;
+	Common::WriteStream *_target;
+	Common::MemoryWriteStreamDynamic _buffer;
+};
+
+class DefaultSaveFileManager::SaveJob : public Common::Job {
+public:
+	SaveJob(const Common::String &name, Common::WriteStream *target, byte *data, uint32 size) :
+		filename(name), failed(false), _target(target), _data(data), _size(size) {}
+
+	void run() override {
+		failed = _target->write(_data, _size) != _size;
+		_target->finalize();
+		failed |= _target->err();
+		delete _target;
+		_target = nullptr;
+		free(_data);
+		_data = nullptr;
+	}
+
+	Common::String filename;
+	bool failed;
+
+private:
+	Common::WriteStream *_target;
+	byte *_data;
+	uint32 _size;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _pendingSaves(nullptr), _changeCounter(0) {
+	ConfMan.registerDefault("background_saves", false);
+	ConfMan.registerDefault("fast_save_compression", false);
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _pendingSaves(nullptr), _changeCounter(0) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
+	ConfMan.registerDefault("background_saves", false);
+	ConfMan.registerDefault("fast_save_compression", false);
+}
+
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	waitForPendingSaves();
+	delete _pendingSaves;
+}
+
+void DefaultSaveFileManager::queueSave(const Common::String &filename, Common::WriteStream *target, byte *data, uint32 size) {
+	if (!_pendingSaves)
+		_pendingSaves = new Common::TaskGroup(g_system->getThreadPool());
+
+	SaveJob *job = new SaveJob(filename, target, data, size);
+	_saveJobs.push_back(job);
+	_pendingSaves->run(job);
+}
+
+bool DefaultSaveFileManager::waitForPendingSaves() {
+	if (!_pendingSaves)
+		return true;
+
+	_pendingSaves->wait();
+
+	bool success = true;
+	for (uint i = 0; i < _saveJobs.size(); ++i) {
+		if (_saveJobs[i]->failed) {
+			warning("Failed to write savefile '%s'", _saveJobs[i]->filename.c_str());
+			success = false;
+		}
+		delete _saveJobs[i];
+	}
+	_saveJobs.clear();
+	return success;
 }
 
 
@@ -165,10 +267,22 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+
+	// Trade some compression for speed if requested; the format stays the same
+	Common::WriteStream *stream = sf;
+	if (compress)
+		stream = Common::wrapCompressedWriteStream(sf, ConfMan.getBool("fast_save_compression") ? 1 : -1);
+
+	// With background saves, the engine only writes to memory and the
+	// compression and file I/O happen on a worker thread on finalize()
+	if (ConfMan.getBool("background_saves") && g_system->getThreadPool().getWorkerCount() > 0)
+		stream = new BackgroundSaveStream(*this, filename, stream);
+
+	Common::OutSaveFile *const result = new Common::OutSaveFile(stream);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	++_changeCounter;
 
 	return result;
 }
@@ -198,6 +312,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
+		++_changeCounter;
 
 		Common::ErrorCode result = removeFile(fileNode.getPath());
 		if (result == Common::kNoError)
@@ -232,6 +347,13 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getChangeCounter(uint32 &counter) {
+	// Catch up with changes to the save path and files synced in the meantime
+	assureCached(getSavePath());
+	counter = _changeCounter;
+	return true;
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -251,6 +373,9 @@ Common::String DefaultSaveFileManager::getSavePath() const {
 }
 
 void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
+	// Saves written in the background must be visible to whatever follows
+	waitForPendingSaves();
+
 	// Check that path exists and is usable.
 	checkPath(Common::FSNode(savePathName));
 
@@ -293,6 +418,7 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	// Only now store that we cached 'savePathName' to indicate we successfully
 	// cached the directory.
 	_cachedDirectory = savePathName;
+	++_changeCounter;
 }
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
@@ -381,6 +507,55 @@ void DefaultSaveFileManager::saveTimestamps(Common::HashMap<Common::String, uint
 	f.close();
 }
 
+Common::HashMap<Common::String, DefaultSaveFileManager::SyncedFile> DefaultSaveFileManager::loadSyncedFiles() {
+	Common::HashMap<Common::String, SyncedFile> files;
+
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(SYNC_HASHES_FILENAME);
+	if (!file)
+		return files;
+
+	//each line is "<md5> <timestamp> <filename>", as filenames may contain spaces
+	while (!file->eos() && !file->err()) {
+		Common::String line = file->readLine();
+		if (line.size() < 35 || line[32] != ' ')
+			continue;
+
+		const char *timestamp = line.c_str() + 33;
+		const char *name = strchr(timestamp, ' ');
+		if (!name || name[1] == '\0')
+			continue;
+
+		files[name + 1] = SyncedFile(Common::String(timestamp, name).asUint64(), Common::String(line.c_str(), 32));
+	}
+
+	delete file;
+	return files;
+}
+
+void DefaultSaveFileManager::saveSyncedFiles(Common::HashMap<Common::String, SyncedFile> &files) {
+	Common::DumpFile f;
+	Common::String filename = concatWithSavesPath(SYNC_HASHES_FILENAME);
+	if (!f.open(filename, true)) {
+		warning("DefaultSaveFileManager: failed to open '%s' file to save sync hashes", filename.c_str());
+		return;
+	}
+
+	for (Common::HashMap<Common::String, SyncedFile>::iterator i = files.begin(); i != files.end(); ++i) {
+		if (i->_value.md5.size() != 32)
+			continue;
+
+		Common::String data = Common::String::format("%s %u %s\n", i->_value.md5.c_str(), i->_value.timestamp, i->_key.c_str());
+		if (f.write(data.c_str(), data.size()) != data.size()) {
+			warning("DefaultSaveFileManager: failed to write sync hashes into '%s'", filename.c_str());
+			return;
+		}
+	}
+
+	f.flush();
+	f.finalize();
+	f.close();
+}
+
 #endif // ifdef USE_LIBCURL
 
 Common::String DefaultSaveFileManager::concatWithSavesPath(Common::String name) {
@@ -28,6 +28,10 @@
 #include "common/fs.h"
 #include "common/hash-str.h"
 
+namespace Common {
+class TaskGroup;
+}
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -35,6 +39,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -43,6 +48,7 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getChangeCounter(uint32 &counter) override;
 
 #ifdef USE_LIBCURL
 
@@ -51,10 +57,30 @@ public:
 
 	static Common::HashMap<Common::String, uint32> loadTimestamps();
 	static void saveTimestamps(Common::HashMap<Common::String, uint32> &timestamps);
+
+	static const char *SYNC_HASHES_FILENAME;
+
+	/** Remote timestamp and content MD5 of a save as of its last sync. */
+	struct SyncedFile {
+		uint32 timestamp;
+		Common::String md5;
+
+		SyncedFile(): timestamp(INVALID_TIMESTAMP) {}
+		SyncedFile(uint32 ts, const Common::String &hash): timestamp(ts), md5(hash) {}
+	};
+
+	static Common::HashMap<Common::String, SyncedFile> loadSyncedFiles();
+	static void saveSyncedFiles(Common::HashMap<Common::String, SyncedFile> &files);
 #endif
 
 	static Common::String concatWithSavesPath(Common::String name);
 
+	/**
+	 * Wait until all saves that are written in the background have reached
+	 * the disk. Returns false if any of them failed.
+	 */
+	bool waitForPendingSaves();
+
 protected:
 	/**
 	 * Get the path to the savegame directory.
@@ -100,10 +126,29 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	class BackgroundSaveStream;
+	class SaveJob;
+
+	/** Compress and write @p data to @p target on a worker thread. */
+	void queueSave(const Common::String &filename, Common::WriteStream *target, byte *data, uint32 size);
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/**
+	 * Incremented whenever a save is written or removed, or the cached
+	 * directory is read again.
+	 */
+	uint32 _changeCounter;
+
+	/**
+	 * Saves being written in the background when "background_saves" is
+	 * enabled. They are waited for before touching the save directory.
+	 */
+	Common::TaskGroup *_pendingSaves;
+	Common::Array<SaveJob *> _saveJobs;
 };
 
 #endif
@@ -0,0 +1,114 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/textconsole.h"
+
+/**
+ * SDL thread implementation
+ */
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *param) : _thread(nullptr), _proc(proc), _param(param) {}
+	~SdlThreadInternal() override { join(); }
+
+	bool start(const char *name) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_thread = SDL_CreateThread(&threadEntry, name, this);
+#else
+		_thread = SDL_CreateThread(&threadEntry, this);
+#endif
+		if (!_thread)
+			warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		return _thread != nullptr;
+	}
+
+	bool join() override {
+		if (_thread) {
+			SDL_WaitThread(_thread, nullptr);
+			_thread = nullptr;
+		}
+		return true;
+	}
+
+private:
+	static int SDLCALL threadEntry(void *data) {
+		SdlThreadInternal *self = (SdlThreadInternal *)data;
+		self->_proc(self->_param);
+		return 0;
+	}
+
+	SDL_Thread *_thread;
+	Common::ThreadProc _proc;
+	void *_param;
+};
+
+/**
+ * SDL semaphore implementation
+ */
+class SdlSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	SdlSemaphoreInternal(uint initialCount) { _sem = SDL_CreateSemaphore(initialCount); }
+	~SdlSemaphoreInternal() override { SDL_DestroySemaphore(_sem); }
+
+	bool isValid() const { return _sem != nullptr; }
+
+	bool wait() override { return (SDL_SemWait(_sem) == 0); }
+	bool post() override { return (SDL_SemPost(_sem) == 0); }
+
+private:
+	SDL_sem *_sem;
+};
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *param, const char *name) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, param);
+	if (!thread->start(name)) {
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createSdlSemaphoreInternal(uint initialCount) {
+	SdlSemaphoreInternal *sem = new SdlSemaphoreInternal(initialCount);
+	if (!sem->isValid()) {
+		delete sem;
+		return nullptr;
+	}
+	return sem;
+}
+
+uint getSdlCPUCount() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	int count = SDL_GetCPUCount();
+	return count > 0 ? count : 1;
+#else
+	return 1;
+#endif
+}
+
+#endif
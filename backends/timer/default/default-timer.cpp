@@ -30,53 +30,95 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
+	uint32 baseTime;	// in milliseconds
+	uint64 fireCount;	// number of intervals since baseTime
 	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
-	TimerSlot *next;
+	uint heapIndex;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
-};
-
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+	uint32 calls;
+	uint32 overruns;
+	uint32 maxLateness;	// in milliseconds
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), baseTime(0), fireCount(0), nextFireTime(0),
+		heapIndex(0), calls(0), overruns(0), maxLateness(0) {}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+	void scheduleNext() {
+		// Computing the fire time from the start instead of adding up the
+		// interval does not accumulate rounding errors
+		++fireCount;
+		nextFireTime = baseTime + (uint32)(fireCount * interval / 1000);
 	}
+};
+
+static inline bool firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	// The difference keeps the order correct when getMillis() wraps around
+	return (int32)(a->nextFireTime - b->nextFireTime) < 0;
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_timerCallbackNext(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _queue.size(); ++i)
+		delete _queue[i];
+	_queue.clear();
+	_slots.clear();
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _queue[index];
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!firesBefore(slot, _queue[parent]))
+			break;
+		_queue[index] = _queue[parent];
+		_queue[index]->heapIndex = index;
+		index = parent;
+	}
+	_queue[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _queue[index];
+	const uint size = _queue.size();
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && firesBefore(_queue[child + 1], _queue[child]))
+			++child;
+		if (!firesBefore(_queue[child], slot))
+			break;
+		_queue[index] = _queue[child];
+		_queue[index]->heapIndex = index;
+		index = child;
 	}
-	_head = nullptr;
+	_queue[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::removeFromQueue(TimerSlot *slot) {
+	const uint index = slot->heapIndex;
+	assert(index < _queue.size() && _queue[index] == slot);
+
+	TimerSlot *last = _queue.back();
+	_queue.pop_back();
+	if (last == slot)
+		return;
+
+	// Move the last timer into the hole and restore the heap order
+	_queue[index] = last;
+	last->heapIndex = index;
+	if (index > 0 && firesBefore(last, _queue[(index - 1) / 2]))
+		siftUp(index);
+	else
+		siftDown(index);
 }
 
 void DefaultTimerManager::handler() {
@@ -84,33 +126,25 @@ void DefaultTimerManager::handler() {
 
 	uint32 curTime = g_system->getMillis(true);
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
-
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	while (!_queue.empty() && (int32)(_queue[0]->nextFireTime - curTime) < 0) {
+		TimerSlot *slot = _queue[0];
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		const uint32 lateness = curTime - slot->nextFireTime;
+		++slot->calls;
+		if ((uint64)lateness * 1000 >= slot->interval)
+			++slot->overruns;
+		slot->maxLateness = MAX(slot->maxLateness, lateness);
+
+		// Update the fire time and move the TimerSlot to its new place in
+		// the priority queue.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
+		slot->scheduleNext();
+		siftDown(0);
 
-		// Invoke the timer callback
+		// Invoke the timer callback, which may remove the timer
 		assert(slot->callback);
 		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
 	}
 }
 
@@ -133,12 +167,10 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 			error("Different callbacks are referred by same name (%s)", id.c_str());
 		}
 	}
-	TimerSlotMap::const_iterator i;
 
-	for (i = _callbacks.begin(); i != _callbacks.end(); ++i) {
-		if (i->_value == callback) {
-			error("Same callback added twice (old name: %s, new name: %s)", i->_key.c_str(), id.c_str());
-		}
+	TimerProcMap::const_iterator installed = _slots.find(callback);
+	if (installed != _slots.end()) {
+		error("Same callback added twice (old name: %s, new name: %s)", installed->_value->id.c_str(), id.c_str());
 	}
 	_callbacks[id] = callback;
 
@@ -147,11 +179,12 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->baseTime = g_system->getMillis();
+	slot->scheduleNext();
 
-	insertPrioQueue(_head, slot);
+	_slots[callback] = slot;
+	_queue.push_back(slot);
+	siftUp(_queue.size() - 1);
 
 	return true;
 }
@@ -159,16 +192,11 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	TimerProcMap::iterator installed = _slots.find(callback);
+	if (installed != _slots.end()) {
+		removeFromQueue(installed->_value);
+		delete installed->_value;
+		_slots.erase(installed);
 	}
 
 	// We need to remove all names referencing the timer proc here.
@@ -188,3 +216,21 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+bool DefaultTimerManager::getTimerStats(Common::Array<TimerStats> &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats.clear();
+	stats.reserve(_queue.size());
+	for (uint i = 0; i < _queue.size(); ++i) {
+		const TimerSlot *slot = _queue[i];
+		TimerStats entry;
+		entry.id = slot->id;
+		entry.interval = slot->interval;
+		entry.calls = slot->calls;
+		entry.overruns = slot->overruns;
+		entry.maxLateness = slot->maxLateness;
+		stats.push_back(entry);
+	}
+	return true;
+}
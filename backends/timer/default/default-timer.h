@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -33,17 +34,29 @@ class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
+	struct TimerProc_Hash {
+		uint operator()(TimerProc proc) const { return (uint)(reinterpret_cast<uintptr>(proc) >> 2); }
+	};
+	typedef Common::HashMap<TimerProc, TimerSlot *, TimerProc_Hash> TimerProcMap;
+
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	/** Binary min-heap of the installed timers, ordered by their next fire time. */
+	Common::Array<TimerSlot *> _queue;
 	TimerSlotMap _callbacks;
+	TimerProcMap _slots;
 
 	uint32 _timerCallbackNext;
 
+	void siftUp(uint index);
+	void siftDown(uint index);
+	void removeFromQueue(TimerSlot *slot);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual bool getTimerStats(Common::Array<TimerStats> &stats);
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
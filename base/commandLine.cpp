@@ -153,6 +153,10 @@ static const char HELP_STRING4[] =
 	"  --debug-channels-only    Show only the specified debug channels\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
+#ifdef USE_PROFILER
+	"  --profile=FILE           Record profiling zones and write them to FILE as\n"
+	"                           Chrome trace JSON when quitting\n"
+#endif
 	"\n"
 	"  --cdrom=DRIVE            CD drive to play CD audio from; can either be a\n"
 	"                           drive, path, or numeric index (default: 0 = best\n"
@@ -188,6 +192,8 @@ static const char HELP_STRING4[] =
 	"  --aspect-ratio           Enable aspect ratio correction\n"
 	"  --[no-]dirtyrects        Enable dirty rectangles optimisation in software renderer\n"
 	"                           (default: enabled)\n"
+	"  --[no-]tinygltiles       Rasterize software renderer frames in tiles on all\n"
+	"                           CPU cores (default: disabled)\n"
 	"  --render-mode=MODE       Enable additional render modes (hercGreen, hercAmber,\n"
 	"                           cga, ega, vga, amiga, fmtowns, pc9821, pc9801, 2gs,\n"
 	"                           atari, macintosh, macintoshbw)\n"
@@ -199,6 +205,13 @@ static const char HELP_STRING4[] =
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
 	"                           (default: 60000)\n"
+	"  --[no-]screenshot-hash-only\n"
+	"                           When recording, only store checksums of the screenshots\n"
+	"                           (default: disabled)\n"
+	"  --[no-]fast-playback     Play back recordings as fast as possible\n"
+	"                           (default: disabled)\n"
+	"  --benchmark              Play back the record file headless and as fast as\n"
+	"                           possible, then report frame times and peak memory use\n"
 	"  --list-records           Display a list of recordings for the target specified\n"
 #endif
 	"\n"
@@ -300,6 +313,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("shader", "default");
 	ConfMan.registerDefault("show_fps", false);
 	ConfMan.registerDefault("dirtyrects", true);
+	ConfMan.registerDefault("tinygltiles", false);
 	ConfMan.registerDefault("vsync", true);
 
 	// Sound & Music
@@ -317,6 +331,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("midi_render_ahead", 0);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -367,6 +382,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("screenshot_hash_only", false);
+	ConfMan.registerDefault("fast_playback", false);
+	ConfMan.registerDefault("benchmark", false);
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -682,6 +700,11 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("debugflags")
 			END_OPTION
 
+#ifdef USE_PROFILER
+			DO_LONG_OPTION("profile")
+			END_OPTION
+#endif
+
 			DO_LONG_OPTION_BOOL("debug-channels-only")
 			END_OPTION
 
@@ -737,6 +760,20 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION_INT("screenshot-period")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("screenshot-hash-only")
+			END_OPTION
+
+			DO_LONG_OPTION_BOOL("fast-playback")
+			END_OPTION
+
+			DO_LONG_OPTION_BOOL("benchmark")
+				if (boolValue) {
+					settings["record-mode"] = "playback";
+					settings["disable-display"] = "true";
+					settings["fast-playback"] = "true";
+				}
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -842,6 +879,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("dirtyrects")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("tinygltiles")
+			END_OPTION
+
 			DO_LONG_OPTION("gamma")
 			END_OPTION
 
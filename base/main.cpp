@@ -43,6 +43,8 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/file.h"
+#include "common/profiler.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -56,6 +58,7 @@
 #include "gui/gui-manager.h"
 #include "gui/error.h"
 #include "gui/message.h"
+#include "gui/saveload-dialog.h"
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
@@ -315,7 +318,11 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	system.getEventManager()->purgeMouseEvents();
 
 	// Run the engine
-	Common::Error result = engine->run();
+	Common::Error result;
+	{
+		PROFILE_ZONE("Engine::run");
+		result = engine->run();
+	}
 
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
@@ -539,6 +546,14 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		ConfMan.registerDefault("dump_midi", true);
 	}
 
+#ifdef USE_PROFILER
+	Common::String profileFile;
+	if (settings.contains("profile")) {
+		profileFile = settings["profile"];
+		Common::Profiler::instance().setEnabled(true);
+	}
+#endif
+
 #ifdef USE_OPENGL
 	if (settings.contains("last_window_width")) {
 		ConfMan.setInt("last_window_width", atoi(settings["last_window_width"].c_str()));
@@ -847,10 +862,23 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	//I think it's important to destroy it after ConnectionManager
 	Cloud::CloudManager::destroy();
 #endif
+#endif
+#ifdef USE_PROFILER
+	// The profiler is not destroyed, as the mixer thread may still be
+	// inside a zone.
+	if (Common::Profiler::hasInstance()) {
+		Common::Profiler::instance().setEnabled(false);
+		Common::DumpFile out;
+		if (!profileFile.empty() && out.open(profileFile))
+			Common::Profiler::instance().writeChromeTrace(out);
+	}
 #endif
 	PluginManager::instance().unloadDetectionPlugin();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
+#ifndef DISABLE_SAVELOADCHOOSER_GRID
+	GUI::SaveMetaInfoCache::destroy();
+#endif
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
@@ -25,6 +25,8 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
+#include "common/endian.h"
+#include "common/stream.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -394,6 +396,19 @@ void PluginManagerUncached::init() {
  * engine ID under the domain 'engine_plugin_files'.
  **/
 bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineId) {
+	if (!_pluginIndexLoaded)
+		loadPluginIndex();
+
+	Common::String indexedFilename = findPluginFileInIndex(engineId);
+	if (indexedFilename.empty()) {
+		// Index the new and changed plugins once instead of loading all of
+		// them for every engine we are asked about
+		updatePluginIndex();
+		indexedFilename = findPluginFileInIndex(engineId);
+	}
+	if (loadPluginByFileName(indexedFilename))
+		return true;
+
 	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
 
 	if (domain) {
@@ -422,6 +437,125 @@ bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineI
 	return false;
 }
 
+#define PLUGIN_INDEX_MAGIC MKTAG('P', 'I', 'D', 'X')
+#define PLUGIN_INDEX_VERSION 1
+
+Common::FSNode PluginManagerUncached::getPluginIndexFile() const {
+	Common::FSNode dir = ConfMan.getConfigDirectory();
+	if (!dir.isDirectory())
+		return Common::FSNode();
+
+	return dir.getChild("plugins.idx");
+}
+
+void PluginManagerUncached::loadPluginIndex() {
+	_pluginIndexLoaded = true;
+	_pluginIndex.clear();
+
+	Common::FSNode file = getPluginIndexFile();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() == PLUGIN_INDEX_MAGIC && stream->readUint32LE() == PLUGIN_INDEX_VERSION) {
+		uint32 count = stream->readUint32LE();
+		for (uint32 i = 0; i < count && !stream->eos() && !stream->err(); i++) {
+			Common::String filename = stream->readString(0, stream->readUint16LE());
+			PluginIndexEntry entry;
+			entry.engineId = stream->readString(0, stream->readByte());
+			entry.size = stream->readSint64LE();
+			entry.modificationTime = stream->readSint64LE();
+			if (stream->eos() || stream->err())
+				break;
+			_pluginIndex[filename] = entry;
+		}
+	}
+
+	delete stream;
+	debug(9, "Loaded %u entries from the plugin index", _pluginIndex.size());
+}
+
+void PluginManagerUncached::savePluginIndex() {
+	Common::FSNode file = getPluginIndexFile();
+	Common::SeekableWriteStream *stream = file.getPath().empty() ? nullptr : file.createWriteStream();
+	if (!stream)
+		return;
+
+	stream->writeUint32BE(PLUGIN_INDEX_MAGIC);
+	stream->writeUint32LE(PLUGIN_INDEX_VERSION);
+	stream->writeUint32LE(_pluginIndex.size());
+	for (PluginIndex::const_iterator it = _pluginIndex.begin(); it != _pluginIndex.end(); ++it) {
+		stream->writeUint16LE(it->_key.size());
+		stream->writeString(it->_key);
+		stream->writeByte(it->_value.engineId.size());
+		stream->writeString(it->_value.engineId);
+		stream->writeSint64LE(it->_value.size);
+		stream->writeSint64LE(it->_value.modificationTime);
+	}
+	stream->finalize();
+	delete stream;
+}
+
+void PluginManagerUncached::updatePluginIndex() {
+	bool changed = false;
+
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false);
+
+	PluginIndex index;
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		if (!(*p)->getFileName())
+			continue;
+
+		Common::String filename = (*p)->getFileName();
+		PluginIndexEntry entry;
+		if (filename.size() > 0xFFFF || !Common::FSNode(filename).getFileStats(entry.size, entry.modificationTime))
+			continue;
+
+		PluginIndex::const_iterator old = _pluginIndex.find(filename);
+		if (old != _pluginIndex.end() && old->_value.size == entry.size && old->_value.modificationTime == entry.modificationTime) {
+			index[filename] = old->_value;
+			continue;
+		}
+
+		// Plugins that fail to load are indexed without an engine, so that
+		// they are only tried again once they change
+		changed = true;
+		if ((*p)->loadPlugin()) {
+			if ((*p)->getType() == PLUGIN_TYPE_ENGINE)
+				entry.engineId = (*p)->getName();
+			(*p)->unloadPlugin();
+		}
+		if (entry.engineId.size() > 0xFF)
+			entry.engineId.clear();
+		index[filename] = entry;
+	}
+
+	// Plugins that were removed are dropped as well
+	if (changed || index.size() != _pluginIndex.size()) {
+		_pluginIndex = index;
+		savePluginIndex();
+	}
+}
+
+Common::String PluginManagerUncached::findPluginFileInIndex(const Common::String &engineId) const {
+	if (engineId.empty())
+		return Common::String();
+
+	for (PluginIndex::const_iterator it = _pluginIndex.begin(); it != _pluginIndex.end(); ++it) {
+		if (!it->_value.engineId.equalsIgnoreCase(engineId))
+			continue;
+
+		int64 size, modificationTime;
+		if (Common::FSNode(it->_key).getFileStats(size, modificationTime) &&
+		    size == it->_value.size && modificationTime == it->_value.modificationTime)
+			return it->_key;
+	}
+	return Common::String();
+}
+
 /**
  * Load a plugin with a filename taken from ConfigManager.
  **/
@@ -741,6 +875,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 		}
 	}
 
+	// Keep the computed MD5s for the next launch
+	PersistentMD5Man.flush();
+
 	return DetectionResults(candidates);
 }
 
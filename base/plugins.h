@@ -24,6 +24,8 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -361,9 +363,32 @@ protected:
 
 	bool _isDetectionLoaded;
 
-	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
+	/**
+	 * On-disk index mapping plugin files to the engine they contain, so
+	 * that finding an engine does not need to load every plugin. Entries
+	 * are keyed by file name and only trusted while the size and
+	 * modification time of the file still match.
+	 */
+	struct PluginIndexEntry {
+		Common::String engineId;
+		int64 size;
+		int64 modificationTime;
+	};
+	typedef Common::HashMap<Common::String, PluginIndexEntry> PluginIndex;
+	PluginIndex _pluginIndex;
+	bool _pluginIndexLoaded;
+
+	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr), _pluginIndexLoaded(false) {}
 	bool loadPluginByFileName(const Common::String &filename);
 
+	Common::FSNode getPluginIndexFile() const;
+	void loadPluginIndex();
+	void savePluginIndex();
+	/** Index the plugins that are new or changed since the index was written. */
+	void updatePluginIndex();
+	/** Return the file of the plugin containing @p engineId, if it is indexed. */
+	Common::String findPluginFileInIndex(const Common::String &engineId) const;
+
 public:
 	void init() override;
 	void loadFirstPlugin() override;
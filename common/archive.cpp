@@ -144,15 +144,57 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMember(
 	// Now we have a valid contents reference. Make stream for it.
 	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->getContents(), entry->getSize());
 
-	// If the entry was just created and it's too big for strong caching,
-	// mark the copy in cache as weak
-	if (isNew && entry->getSize() > _maxStronglyCachedSize) {
-		entry->makeWeak();
+	// If the entry is too big for strong caching, mark the copy in cache as
+	// weak. When recently used members are kept, that list decides how long
+	// it stays around, otherwise only entries just created are marked.
+	if (entry->getSize() > _maxStronglyCachedSize) {
+		if (_maxRecentlyUsedSize) {
+			keepRecentlyUsed(translated, *entry);
+			entry->makeWeak();
+		} else if (isNew) {
+			entry->makeWeak();
+		}
 	}
 
 	return memStream;
 }
 
+void MemcachingCaseInsensitiveArchive::keepRecentlyUsed(const String &translatedPath, const SharedArchiveContents &contents) const {
+	const uint32 size = contents.getSize();
+	if (size > _maxRecentlyUsedSize)
+		return;
+
+	if (_recentlyUsed.contains(translatedPath)) {
+		_recentlyUsedSize -= _recentlyUsed[translatedPath]._size;
+		_recentlyUsed.erase(translatedPath);
+	}
+
+	// The weak reference in _cache stays valid as long as this one exists
+	while (_recentlyUsedSize + size > _maxRecentlyUsedSize) {
+		typedef HashMap<String, RecentlyUsed, IgnoreCase_Hash, IgnoreCase_EqualTo>::iterator RecentlyUsedIterator;
+		RecentlyUsedIterator oldest = _recentlyUsed.begin();
+		for (RecentlyUsedIterator i = _recentlyUsed.begin(); i != _recentlyUsed.end(); ++i) {
+			if (i->_value._lastUse < oldest->_value._lastUse)
+				oldest = i;
+		}
+
+		_recentlyUsedSize -= oldest->_value._size;
+		_recentlyUsed.erase(oldest);
+	}
+
+	RecentlyUsed &entry = _recentlyUsed[translatedPath];
+	entry._contents = contents.getContents();
+	entry._size = size;
+	entry._lastUse = ++_useCounter;
+	_recentlyUsedSize += size;
+}
+
+void MemcachingCaseInsensitiveArchive::clearContentsCache() {
+	_cache.clear();
+	_recentlyUsed.clear();
+	_recentlyUsedSize = 0;
+}
+
 
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
@@ -184,6 +226,7 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	_lookupCache.clear();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -265,6 +308,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		_lookupCache.clear();
 	}
 }
 
@@ -288,6 +332,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_lookupCache.clear(true);
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -306,10 +351,37 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
+void SearchSet::setCacheLookups(bool cacheLookups) {
+	_cacheLookups = cacheLookups;
+	if (!cacheLookups)
+		_lookupCache.clear(true);
+}
+
+Archive *SearchSet::lookupArchive(const Path &path) const {
+	LookupCache::const_iterator cached = _lookupCache.find(path);
+	if (cached != _lookupCache.end())
+		return cached->_value;
+
+	Archive *found = nullptr;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		if (it->_arc->hasFile(path)) {
+			found = it->_arc;
+			break;
+		}
+	}
+
+	_lookupCache[path] = found;
+	return found;
+}
+
 bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	if (_cacheLookups)
+		return lookupArchive(path) != nullptr;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(path))
@@ -343,6 +415,11 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	if (_cacheLookups) {
+		Archive *arc = lookupArchive(path);
+		return arc ? arc->getMember(path) : ArchiveMemberPtr();
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(path))
@@ -356,6 +433,19 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (_cacheLookups) {
+		Archive *arc = lookupArchive(path);
+		if (!arc)
+			return nullptr;
+
+		SeekableReadStream *stream = arc->createReadStreamForMember(path);
+		if (stream)
+			return stream;
+
+		// The archive claims to have the file but cannot open it, so
+		// fall back to asking every archive like the uncached path does.
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
@@ -151,6 +151,13 @@ public:
 		return createReadStreamForMember(path);
 	}
 
+	/**
+	 * Hint that the given members of this archive are about to be opened.
+	 * Archives that have to decompress their members may use this to do so
+	 * ahead of time, possibly in parallel. The default does nothing.
+	 */
+	virtual void prefetchMembers(const ArchiveMemberList &members) const {}
+
 	/**
 	 * Dump all files from the archive to the given directory
 	 */
@@ -214,10 +221,16 @@ private:
 
 /**
  * An archive that caches the resulting contents.
+ *
+ * Members up to maxStronglyCachedSize bytes stay in memory for the lifetime
+ * of the archive. Bigger ones are kept while streams on them are alive and,
+ * if maxRecentlyUsedSize is not 0, for as long as the most recently opened
+ * ones fit in that many bytes.
  */
 class MemcachingCaseInsensitiveArchive : public Archive {
 public:
-	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512) : _maxStronglyCachedSize(maxStronglyCachedSize) {}
+	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512, uint32 maxRecentlyUsedSize = 0)
+		: _maxStronglyCachedSize(maxStronglyCachedSize), _maxRecentlyUsedSize(maxRecentlyUsedSize), _recentlyUsedSize(0), _useCounter(0) {}
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 
 	virtual String translatePath(const Path &path) const {
@@ -228,9 +241,26 @@ public:
 
 	virtual SharedArchiveContents readContentsForPath(const String& translatedPath) const = 0;
 
+protected:
+	/** Drop all the cached contents, e.g. when the underlying file changes. */
+	void clearContentsCache();
+
 private:
+	struct RecentlyUsed {
+		SharedPtr<byte> _contents;
+		uint32 _size;
+		uint32 _lastUse;
+	};
+
+	void keepRecentlyUsed(const String &translatedPath, const SharedArchiveContents &contents) const;
+
 	mutable HashMap<String, SharedArchiveContents, IgnoreCase_Hash, IgnoreCase_EqualTo> _cache;
 	uint32 _maxStronglyCachedSize;
+
+	mutable HashMap<String, RecentlyUsed, IgnoreCase_Hash, IgnoreCase_EqualTo> _recentlyUsed;
+	uint32 _maxRecentlyUsedSize;
+	mutable uint32 _recentlyUsedSize;
+	mutable uint32 _useCounter;
 };
 
 /**
@@ -261,8 +291,18 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/**
+	 * Maps a path to the first archive, in priority order, that has it, or to
+	 * nullptr if none does. Filled on demand when _cacheLookups is set.
+	 */
+	typedef HashMap<Path, Archive *, Path::Hash> LookupCache;
+	mutable LookupCache _lookupCache;
+	bool _cacheLookups;
+
+	Archive *lookupArchive(const Path &path) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _cacheLookups(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -371,6 +411,24 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	/**
+	 * Remember which archive holds each path that is looked up, so that
+	 * further lookups of the same path through hasFile(), getMember() and
+	 * createReadStreamForMember() only cost one hash probe instead of
+	 * one query per archive. Misses are remembered as well.
+	 *
+	 * The cache is dropped whenever archives are added, removed or
+	 * reordered. It must only be enabled when the contents of the
+	 * archives in the set do not change, otherwise call
+	 * invalidateLookupCache() after changing them.
+	 */
+	void setCacheLookups(bool cacheLookups);
+
+	/**
+	 * Forget all cached lookups. See setCacheLookups().
+	 */
+	void invalidateLookupCache() { _lookupCache.clear(); }
 };
 
 
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize) : _current(nullptr), _blockSize(blockSize), _tag(MemTag::current(kMemTagArenas)) {
+}
+
+Arena::~Arena() {
+	freeBlocks(nullptr);
+}
+
+void Arena::addBlock(size_t minSize) {
+	size_t size = _current ? _current->size * 2 : _blockSize;
+	while (size < minSize)
+		size *= 2;
+
+	Block *block = (Block *)malloc(sizeof(Block) + size);
+	if (!block)
+		error("Arena: Couldn't allocate a block of %u bytes", (uint)size);
+
+	memTagAllocated(_tag, sizeof(Block) + size);
+
+	block->prev = _current;
+	block->size = size;
+	block->used = 0;
+	_current = block;
+}
+
+void Arena::freeBlocks(Block *until) {
+	while (_current != until) {
+		Block *prev = _current->prev;
+		memTagFreed(_tag, sizeof(Block) + _current->size);
+		free(_current);
+		_current = prev;
+	}
+}
+
+void *Arena::allocate(size_t size, size_t align) {
+	assert((align & (align - 1)) == 0);
+
+	// The block header is a multiple of the pointer size, but blocks are
+	// only guaranteed to be aligned to what malloc() returns.
+	if (_current) {
+		const size_t base = (size_t)_current->data();
+		const size_t offset = ((base + _current->used + align - 1) & ~(align - 1)) - base;
+		if (offset + size <= _current->size) {
+			_current->used = offset + size;
+			return _current->data() + offset;
+		}
+	}
+
+	addBlock(size + align);
+	const size_t base = (size_t)_current->data();
+	const size_t offset = ((base + align - 1) & ~(align - 1)) - base;
+	_current->used = offset + size;
+	return _current->data() + offset;
+}
+
+Arena::Marker Arena::getMarker() const {
+	Marker marker;
+	marker.block = _current;
+	marker.used = _current ? _current->used : 0;
+	return marker;
+}
+
+void Arena::rewind(const Marker &marker) {
+	freeBlocks(marker.block);
+	if (_current)
+		_current->used = marker.used;
+}
+
+void Arena::reset() {
+	if (!_current)
+		return;
+
+	if (_current->prev) {
+		// Merge the chain into one block for the next round
+		size_t total = 0;
+		for (Block *block = _current; block; block = block->prev)
+			total += block->size;
+
+		freeBlocks(nullptr);
+		if (total > _blockSize)
+			_blockSize = total;
+		addBlock(_blockSize);
+	}
+
+	_current->used = 0;
+}
+
+size_t Arena::getUsedSize() const {
+	size_t used = 0;
+	for (Block *block = _current; block; block = block->prev)
+		used += block->used;
+	return used;
+}
+
+#pragma mark -
+
+FrameArena::FrameArena(size_t blockSize) : _first(blockSize), _second(blockSize), _current(&_first) {
+}
+
+void FrameArena::nextFrame() {
+	_current = (_current == &_first) ? &_second : &_first;
+	_current->reset();
+}
+
+void FrameArena::reset() {
+	_first.reset();
+	_second.reset();
+}
+
+void FrameArena::setBlockSize(size_t blockSize) {
+	_first.setBlockSize(blockSize);
+	_second.setBlockSize(blockSize);
+}
+
+} // End of namespace Common
@@ -0,0 +1,192 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/memtag.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arena allocator
+ * @ingroup common_memory
+ *
+ * @brief Bump allocator for short-lived allocations.
+ * @{
+ */
+
+/**
+ * An arena serves allocations of arbitrary size by bumping a pointer in
+ * large blocks obtained from malloc(). Individual allocations cannot be
+ * freed; instead, everything allocated after a marker is released at once
+ * with rewind(), or everything with reset(). Both are O(1) apart from
+ * releasing surplus blocks.
+ *
+ * When the current block is exhausted, a new block at least twice as big
+ * is chained. reset() then merges the chain into one block big enough for
+ * everything that was allocated, so that an arena used once per frame
+ * settles on a single block after the first frames.
+ *
+ * Destructors of objects created in an arena are not called; only use it
+ * for trivially destructible data, or call the destructors by hand.
+ */
+class Arena : NonCopyable {
+	struct Block {
+		Block *prev;
+		size_t size;
+		size_t used;
+
+		byte *data() { return (byte *)(this + 1); }
+	};
+
+	Block *_current;
+	size_t _blockSize;
+	MemTagId _tag;
+
+	void addBlock(size_t minSize);
+	void freeBlocks(Block *until);
+
+public:
+	/** Position in an arena, see getMarker() and rewind(). */
+	struct Marker {
+		Block *block;
+		size_t used;
+	};
+
+	/**
+	 * Create an arena. No memory is allocated until the first allocation.
+	 * The blocks are accounted to the current MemTag scope, or kMemTagArenas.
+	 *
+	 * @param blockSize  Size of the first block.
+	 */
+	explicit Arena(size_t blockSize = 64 * 1024);
+	~Arena();
+
+	/**
+	 * Allocate @p size bytes aligned to @p align bytes, which must be a power of two.
+	 * The memory is not initialized.
+	 */
+	void *allocate(size_t size, size_t align = sizeof(void *) > 8 ? sizeof(void *) : 8);
+
+	/** Allocate uninitialized storage for @p count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(sizeof(T) * count, alignof(T));
+	}
+
+	/** Allocate and default-construct an object of type T. */
+	template<class T>
+	T *create() {
+		return new (allocate(sizeof(T), alignof(T))) T();
+	}
+
+	/** Return a marker for the current position in the arena. */
+	Marker getMarker() const;
+
+	/** Release everything allocated after @p marker was taken. */
+	void rewind(const Marker &marker);
+
+	/** Release everything, keeping one block big enough for all of it. */
+	void reset();
+
+	/** Return the number of bytes currently allocated from the arena, including padding. */
+	size_t getUsedSize() const;
+
+	/** Set the minimum size of blocks allocated from now on. */
+	void setBlockSize(size_t blockSize) { _blockSize = blockSize; }
+};
+
+/**
+ * Double-buffered arena for per-frame temporaries.
+ *
+ * Data allocated during a frame stays valid during the following frame,
+ * which allows e.g. comparing the draw list of the current frame with the
+ * previous one. nextFrame() releases the data of the previous frame.
+ */
+class FrameArena : NonCopyable {
+	Arena _first, _second;
+	Arena *_current;
+
+public:
+	explicit FrameArena(size_t blockSize = 64 * 1024);
+
+	void *allocate(size_t size) { return _current->allocate(size); }
+
+	template<class T>
+	T *allocateArray(size_t count) { return _current->allocateArray<T>(count); }
+
+	/** Return the arena for the current frame. */
+	Arena &current() { return *_current; }
+
+	/**
+	 * Start a new frame. Data allocated during the frame before the
+	 * current one is released.
+	 */
+	void nextFrame();
+
+	/** Release the data of both frames. */
+	void reset();
+
+	/** Set the minimum size of blocks allocated from now on. */
+	void setBlockSize(size_t blockSize);
+};
+
+/**
+ * Allocator adapter with the interface known from the C++ standard
+ * library, to place containers in an Arena. deallocate() does nothing;
+ * the memory is reclaimed when the arena is rewound or reset.
+ */
+template<class T>
+class ArenaAllocator {
+	template<class U> friend class ArenaAllocator;
+
+	Arena *_arena;
+
+public:
+	typedef T value_type;
+	typedef size_t size_type;
+
+	template<class U>
+	struct rebind {
+		typedef ArenaAllocator<U> other;
+	};
+
+	explicit ArenaAllocator(Arena &arena) : _arena(&arena) {}
+	template<class U>
+	ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other._arena) {}
+
+	T *allocate(size_type n) { return _arena->allocateArray<T>(n); }
+	void deallocate(T *, size_type) {}
+
+	template<class U>
+	bool operator==(const ArenaAllocator<U> &other) const { return _arena == other._arena; }
+	template<class U>
+	bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other._arena; }
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
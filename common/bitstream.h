@@ -41,6 +41,161 @@ namespace Common {
  * @{
  */
 
+/**
+ * A cut-down version of MemoryReadStream specifically for use with BitStream.
+ * It removes the virtual call overhead for reading bytes from a memory buffer,
+ * and allows directly inlining this access.
+ *
+ * The code duplication with MemoryReadStream is not ideal.
+ * It might be possible to avoid this by making this a final subclass of
+ * MemoryReadStream, but that is a C++11 feature.
+ */
+class BitStreamMemoryStream {
+private:
+	const byte * const _ptrOrig;
+	const byte *_ptr;
+	const uint32 _size;
+	uint32 _pos;
+	DisposeAfterUse::Flag _disposeMemory;
+	bool _eos;
+/** @overload */
+public:
+	BitStreamMemoryStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
+		_ptrOrig(dataPtr),
+		_ptr(dataPtr),
+		_size(dataSize),
+		_pos(0),
+		_disposeMemory(disposeMemory),
+		_eos(false) {}
+
+	~BitStreamMemoryStream() {
+		if (_disposeMemory)
+			free(const_cast<byte *>(_ptrOrig));
+	}
+
+	bool eos() const {
+		return _eos;
+	}
+
+	bool err() const {
+		return false;
+	}
+
+	uint32 pos() const {
+		return _pos;
+	}
+
+	uint32 size() const {
+		return _size;
+	}
+
+	bool seek(uint32 offset) {
+		assert(offset <= _size);
+
+		_eos = false;
+		_pos = offset;
+		_ptr = _ptrOrig + _pos;
+		return true;
+	}
+
+	byte readByte() {
+		if (_pos >= _size) {
+			_eos = true;
+			return 0;
+		}
+
+		_pos++;
+		return *_ptr++;
+	}
+
+	uint16 readUint16LE() {
+		if (_pos + 2 > _size) {
+			_eos = true;
+			if (_pos < _size) {
+				_pos++;
+				return *_ptr++;
+			} else {
+				return 0;
+			}
+		}
+
+		uint16 val = READ_LE_UINT16(_ptr);
+
+		_pos += 2;
+		_ptr += 2;
+
+		return val;
+	}
+
+	uint16 readUint16BE() {
+		if (_pos + 2 > _size) {
+			_eos = true;
+			if (_pos < _size) {
+				_pos++;
+				return (*_ptr++) << 8;
+			} else {
+				return 0;
+			}
+		}
+
+		uint16 val = READ_BE_UINT16(_ptr);
+
+		_pos += 2;
+		_ptr += 2;
+
+		return val;
+	}
+
+	uint32 readUint32LE() {
+		if (_pos + 4 > _size) {
+			uint32 val = readByte();
+			val |= (uint32)readByte() << 8;
+			val |= (uint32)readByte() << 16;
+			val |= (uint32)readByte() << 24;
+
+			return val;
+		}
+
+		uint32 val = READ_LE_UINT32(_ptr);
+
+		_pos += 4;
+		_ptr += 4;
+
+		return val;
+	}
+
+	uint32 readUint32BE() {
+		if (_pos + 4 > _size) {
+			uint32 val = (uint32)readByte() << 24;
+			val |= (uint32)readByte() << 16;
+			val |= (uint32)readByte() << 8;
+			val |= (uint32)readByte();
+
+			return val;
+		}
+
+		uint32 val = READ_BE_UINT32(_ptr);
+
+		_pos += 4;
+		_ptr += 4;
+
+		return val;
+	}
+
+	/** Return a pointer to the data at the current position. */
+	const byte *getPtr() const {
+		return _ptr;
+	}
+
+	/** Skip @p count bytes, which have to be within the buffer. */
+	void skip(uint32 count) {
+		assert(_pos + count <= _size);
+
+		_pos += count;
+		_ptr += count;
+	}
+};
+
 /**
  * A template implementing a bit stream for different data memory layouts.
  *
@@ -86,6 +241,13 @@ private:
 
 	/** Fill the container with at least @p min bits. */
 	FORCEINLINE void fillContainer(size_t min) {
+		if (_bitsLeft < min)
+			refill(_stream, min);
+	}
+
+	/** Read data values into the container, one at a time, until it holds at least @p min bits. */
+	template<class S>
+	FORCEINLINE void refill(S *, size_t min) {
 		while (_bitsLeft < min) {
 
 			CONTAINER data;
@@ -108,7 +270,52 @@ private:
 
 			_bitsLeft += valueBits;
 		}
-}
+	}
+
+	/**
+	 * Fill the container straight from a memory buffer, with as many data
+	 * values as fit, using a single unaligned 64-bit load.
+	 */
+	FORCEINLINE void refill(BitStreamMemoryStream *stream, size_t min) {
+		const uint32 count = ((64 - _bitsLeft) / valueBits) * valueBits;
+
+		if ((sizeof(_bitContainer) != 8) || (stream->pos() + 8 > stream->size()) || (_pos + _bitsLeft + count > _size)) {
+			// Near the end of the data, read the remaining values one by one
+			refill<BitStreamMemoryStream>(stream, min);
+			return;
+		}
+
+		const byte *ptr = stream->getPtr();
+
+		// Load the data in the order the bits are handed out, i.e. the first
+		// bit at the top for MSB2LSB and at the bottom for LSB2MSB. Values
+		// wider than a byte stored in the other byte order are put in order
+		// by reversing the order of the values in the loaded word.
+		uint64 data;
+		if (MSB2LSB) {
+			data = (isLE && valueBits > 8) ? reverseValues(READ_LE_UINT64(ptr)) : READ_BE_UINT64(ptr);
+			if (count < 64)
+				data >>= 64 - count;
+			_bitContainer |= (CONTAINER)data << (64 - count - _bitsLeft);
+		} else {
+			data = (!isLE && valueBits > 8) ? reverseValues(READ_BE_UINT64(ptr)) : READ_LE_UINT64(ptr);
+			if (count < 64)
+				data &= ((uint64)1 << count) - 1;
+			_bitContainer |= (CONTAINER)data << _bitsLeft;
+		}
+
+		stream->skip(count / 8);
+		_bitsLeft += count;
+	}
+
+	/** Reverse the order of the valueBits-wide values in @p x. */
+	FORCEINLINE static uint64 reverseValues(uint64 x) {
+		x = (x >> 32) | (x << 32);
+		if (valueBits == 16)
+			x = ((x & 0xFFFF0000FFFF0000ULL) >> 16) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+
+		return x;
+	}
 
 	/** Get @p n bits from the bit container. */
 	FORCEINLINE static uint32 getNBits(CONTAINER value, size_t n) {
@@ -325,149 +532,6 @@ public:
 
 
 
-/**
- * A cut-down version of MemoryReadStream specifically for use with BitStream.
- * It removes the virtual call overhead for reading bytes from a memory buffer,
- * and allows directly inlining this access.
- *
- * The code duplication with MemoryReadStream is not ideal.
- * It might be possible to avoid this by making this a final subclass of
- * MemoryReadStream, but that is a C++11 feature.
- */
-class BitStreamMemoryStream {
-private:
-	const byte * const _ptrOrig;
-	const byte *_ptr;
-	const uint32 _size;
-	uint32 _pos;
-	DisposeAfterUse::Flag _disposeMemory;
-	bool _eos;
-/** @overload */
-public:
-	BitStreamMemoryStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
-		_ptrOrig(dataPtr),
-		_ptr(dataPtr),
-		_size(dataSize),
-		_pos(0),
-		_disposeMemory(disposeMemory),
-		_eos(false) {}
-
-	~BitStreamMemoryStream() {
-		if (_disposeMemory)
-			free(const_cast<byte *>(_ptrOrig));
-	}
-
-	bool eos() const {
-		return _eos;
-	}
-
-	bool err() const {
-		return false;
-	}
-
-	uint32 pos() const {
-		return _pos;
-	}
-
-	uint32 size() const {
-		return _size;
-	}
-
-	bool seek(uint32 offset) {
-		assert(offset <= _size);
-
-		_eos = false;
-		_pos = offset;
-		_ptr = _ptrOrig + _pos;
-		return true;
-	}
-
-	byte readByte() {
-		if (_pos >= _size) {
-			_eos = true;
-			return 0;
-		}
-
-		_pos++;
-		return *_ptr++;
-	}
-
-	uint16 readUint16LE() {
-		if (_pos + 2 > _size) {
-			_eos = true;
-			if (_pos < _size) {
-				_pos++;
-				return *_ptr++;
-			} else {
-				return 0;
-			}
-		}
-
-		uint16 val = READ_LE_UINT16(_ptr);
-
-		_pos += 2;
-		_ptr += 2;
-
-		return val;
-	}
-
-	uint16 readUint16BE() {
-		if (_pos + 2 > _size) {
-			_eos = true;
-			if (_pos < _size) {
-				_pos++;
-				return (*_ptr++) << 8;
-			} else {
-				return 0;
-			}
-		}
-
-		uint16 val = READ_LE_UINT16(_ptr);
-
-		_pos += 2;
-		_ptr += 2;
-
-		return val;
-	}
-
-	uint32 readUint32LE() {
-		if (_pos + 4 > _size) {
-			uint32 val = readByte();
-			val |= (uint32)readByte() << 8;
-			val |= (uint32)readByte() << 16;
-			val |= (uint32)readByte() << 24;
-
-			return val;
-		}
-
-		uint32 val = READ_LE_UINT32(_ptr);
-
-		_pos += 4;
-		_ptr += 4;
-
-		return val;
-	}
-
-	uint32 readUint32BE() {
-		if (_pos + 4 > _size) {
-			uint32 val = (uint32)readByte() << 24;
-			val |= (uint32)readByte() << 16;
-			val |= (uint32)readByte() << 8;
-			val |= (uint32)readByte();
-
-			return val;
-		}
-
-		uint32 val = READ_BE_UINT32(_ptr);
-
-		_pos += 4;
-		_ptr += 4;
-
-		return val;
-	}
-
-};
-
 /**
  * @name Typedefs for various memory layouts
  * @{
@@ -27,6 +27,8 @@
 
 namespace Common {
 
+class Mutex;
+
 /**
  * @defgroup common_buffstream Buffered stream
  * @ingroup common
@@ -66,6 +68,84 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+class PrefetchingSeekableReadStream;
+
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream that
+ * reads ahead of the current position on the shared thread pool.
+ *
+ * The stream is split into blocks of @p blockSize bytes. Whenever a block
+ * is consumed, the following @p numBlocks - 1 blocks are requested, so that
+ * slow media (network shares, SD cards) can keep up with sequential readers
+ * such as video decoders. Without thread support the blocks are read
+ * synchronously, which behaves like a plain buffered stream.
+ *
+ * The parent stream must not be used directly while it is wrapped.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap in a custom stream.
+ * @param blockSize           Size of each block.
+ * @param numBlocks           Number of blocks kept in memory; at least 2.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+PrefetchingSeekableReadStream *wrapPrefetchingSeekableReadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream);
+
+/**
+ * Stream returned by wrapPrefetchingSeekableReadStream().
+ */
+class PrefetchingSeekableReadStream : public SeekableReadStream {
+public:
+	PrefetchingSeekableReadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream);
+	~PrefetchingSeekableReadStream() override;
+
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = _err = false; }
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+
+	/**
+	 * Hint that the reader is about to seek to @p offset, so that reading
+	 * ahead from there can start right away.
+	 */
+	void hintSeek(int64 offset);
+
+	/** Number of block accesses that found the data already loaded. */
+	uint32 getHits() const { return _hits; }
+
+	/** Number of block accesses that had to wait for the data. */
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Block;
+
+	SeekableReadStream *_parentStream;
+	DisposeAfterUse::Flag _disposeParentStream;
+	Mutex *_parentMutex;
+
+	Block **_blocks;
+	uint32 _blockSize;
+	uint32 _numBlocks;
+
+	int64 _pos;
+	int64 _size;
+	bool _eos;
+	bool _err;
+
+	uint32 _hits;
+	uint32 _misses;
+
+	Block *request(int64 blockOffset);
+	void fillBlock(Block *block);
+};
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream that
  * transparently provides buffering.
@@ -102,10 +102,13 @@ private:
 			   uint32 crcXor, uint32 block3Offset, uint32 block3Size, Common::SeekableReadStream *stream,
 			   Common::Archive *reference,
 			   DisposeAfterUse::Flag dispose)
-		: _files(files), _tags(tags), _crcXor(crcXor), _block3Offset(block3Offset), /*_block3Size(block3Size), */_stream(stream, dispose),
+		: MemcachingCaseInsensitiveArchive(512, kMaxRecentlyUsedSize), _files(files), _tags(tags), _crcXor(crcXor), _block3Offset(block3Offset), /*_block3Size(block3Size), */_stream(stream, dispose),
 		  _reference(reference) {
 	}
 
+	// Keep up to this many bytes of recently extracted members in memory
+	static const uint32 kMaxRecentlyUsedSize = 8 * 1024 * 1024;
+
 	static int findPatchIdx(const ClickteamFileDescriptor &desc, Common::SeekableReadStream *refStream, const Common::String &fileName,
 				uint32 crcXor, bool doWarn);
 	Common::HashMap<Common::String, ClickteamFileDescriptor, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _files;
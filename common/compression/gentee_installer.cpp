@@ -24,6 +24,7 @@
 #include "common/stream.h"
 #include "common/bufferedstream.h"
 #include "common/substream.h"
+#include "common/ptr.h"
 
 #include "common/compression/gentee_installer.h"
 
@@ -60,6 +61,7 @@ public:
 
 protected:
 	void initTree(HuffmanTreeNode *nodes, uint16 numLeafs);
+	void copyTree(const HuffmanTree &other);
 
 private:
 	void buildTree();
@@ -176,6 +178,28 @@ void HuffmanTree::rebalanceTree(HuffmanTreeNode *entry, HuffmanTreeNode *entryPa
 	}
 }
 
+void HuffmanTree::copyTree(const HuffmanTree &other) {
+	// The nodes link to each other, so the links must be rebased on our nodes
+	const HuffmanTreeNode *otherNodes = other._nodes;
+	HuffmanTreeNode *nodes = _nodes;
+
+	for (uint32 i = 0; i < other._numNodes; i++) {
+		const HuffmanTreeNode &src = otherNodes[i];
+		HuffmanTreeNode &dest = nodes[i];
+
+		dest._parent = src._parent ? nodes + (src._parent - otherNodes) : nullptr;
+		for (uint j = 0; j < 2; j++)
+			dest._children[j] = src._children[j] ? nodes + (src._children[j] - otherNodes) : nullptr;
+		dest._freq = src._freq;
+		dest._symbol = src._symbol;
+	}
+
+	_treeRoot = nodes + (other._treeRoot - otherNodes);
+	_numNodes = other._numNodes;
+	_maxFreq = other._maxFreq;
+	_numLeafs = other._numLeafs;
+}
+
 void HuffmanTree::initTree(HuffmanTreeNode *nodes, uint16 numLeafs) {
 
 	_numLeafs = numLeafs;
@@ -196,6 +220,7 @@ public:
 	HuffmanTreePresized();
 
 	void reset();
+	void copyFrom(const HuffmanTreePresized &other);
 
 private:
 	HuffmanTreeNode _preallocNodes[TNumLeafs * 2];
@@ -211,6 +236,11 @@ void HuffmanTreePresized<TNumLeafs>::reset() {
 	initTree(_preallocNodes, TNumLeafs);
 }
 
+template<uint TNumLeafs>
+void HuffmanTreePresized<TNumLeafs>::copyFrom(const HuffmanTreePresized &other) {
+	copyTree(other);
+}
+
 class DecompressorState
 {
 public:
@@ -219,6 +249,12 @@ public:
 	void resetEverything();
 	void resetBitstream();
 
+	/**
+	 * Copy the decoding state of another decompressor, which reads the
+	 * same data. The input stream is left untouched.
+	 */
+	void copyStateFrom(const DecompressorState &other);
+
 	uint decompressBytes(void *dest, uint size);
 
 private:
@@ -284,6 +320,23 @@ void DecompressorState::resetEverything() {
 	_failed = false;
 }
 
+void DecompressorState::copyStateFrom(const DecompressorState &other) {
+	_codeTree.copyFrom(other._codeTree);
+	_offsetTree.copyFrom(other._offsetTree);
+	_lengthTree.copyFrom(other._lengthTree);
+
+	memcpy(_matchOffsetHistory, other._matchOffsetHistory, sizeof(_matchOffsetHistory));
+	_windowOffset = other._windowOffset;
+	memcpy(_window, other._window, sizeof(_window));
+	memcpy(_matchVLCOffsets, other._matchVLCOffsets, sizeof(_matchVLCOffsets));
+
+	_matchReadPos = other._matchReadPos;
+	_matchRemaining = other._matchRemaining;
+	_bitstreamByte = other._bitstreamByte;
+	_bitstreamBitsRemaining = other._bitstreamBitsRemaining;
+	_failed = other._failed;
+}
+
 void DecompressorState::resetBitstream() {
 	_bitstreamBitsRemaining = 0;
 	_bitstreamByte = 0;
@@ -448,9 +501,25 @@ public:
 	void clearErr() override;
 
 private:
+	/**
+	 * Snapshot of the decompressor taken while reading forward, so that
+	 * seeking backwards does not have to decompress from the start again.
+	 */
+	struct Checkpoint {
+		uint32 pos;
+		int64 basePos;
+		SharedPtr<DecompressorState> state;
+	};
+
+	// Decompressed bytes between two checkpoints. Each one costs about 70KB.
+	static const uint32 kCheckpointInterval = 1024 * 1024;
+
 	bool rewind();
+	void addCheckpoint();
+	bool restoreCheckpoint(uint32 offset);
 
 	DecompressorState _decomp;
+	Array<Checkpoint> _checkpoints;
 
 	Common::SeekableReadStream *_baseStream;
 
@@ -498,7 +567,7 @@ bool DecompressingStream::seek(int64 offset, int whence) {
 			return true;
 		}
 
-		if (offset < static_cast<int64>(_pos)) {
+		if (!restoreCheckpoint(static_cast<uint32>(offset)) && offset < static_cast<int64>(_pos)) {
 			if (!rewind())
 				return false;
 		}
@@ -556,9 +625,44 @@ uint32 DecompressingStream::read(void *dataPtr, uint32 dataSize) {
 
 	_pos += numBytesDecompressed;
 
+	const uint32 lastCheckpointPos = _checkpoints.empty() ? 0 : _checkpoints.back().pos;
+	if (!_errFlag && _pos < _decompressedSize && _pos >= lastCheckpointPos + kCheckpointInterval)
+		addCheckpoint();
+
 	return numBytesDecompressed;
 }
 
+void DecompressingStream::addCheckpoint() {
+	Checkpoint checkpoint;
+	checkpoint.pos = _pos;
+	checkpoint.basePos = _baseStream->pos();
+	checkpoint.state.reset(new DecompressorState(nullptr));
+	checkpoint.state->copyStateFrom(_decomp);
+
+	_checkpoints.push_back(checkpoint);
+}
+
+bool DecompressingStream::restoreCheckpoint(uint32 offset) {
+	// Checkpoints are recorded in order, find the last one before offset
+	const Checkpoint *best = nullptr;
+	for (const Checkpoint &checkpoint : _checkpoints) {
+		if (checkpoint.pos > offset)
+			break;
+		best = &checkpoint;
+	}
+
+	// Only worth it when going backwards or skipping past the checkpoint
+	if (!best || (offset >= _pos && best->pos <= _pos))
+		return false;
+
+	if (!_baseStream->seek(best->basePos))
+		return false;
+
+	_decomp.copyStateFrom(*best->state);
+	_pos = best->pos;
+	return true;
+}
+
 bool DecompressingStream::err() const {
 	return _errFlag;
 }
@@ -930,6 +930,13 @@ GzioReadStream::inflate_window ()
   /* initialize window */
   _wp = 0;
 
+  fill_window ();
+}
+
+
+void
+GzioReadStream::fill_window ()
+{
   /*
    *  Main decompression loop.
    */
@@ -941,6 +948,9 @@ GzioReadStream::inflate_window ()
 	  if (_lastBlock)
 	    break;
 
+	  if (_seekPointInterval && (uint64)(_savedOffset + _wp) >= (_seekPoints.empty () ? 0 : _seekPoints.back ().outOffset) + _seekPointInterval)
+	    add_seek_point ();
+
 	  get_new_block ();
 	}
 
@@ -989,6 +999,61 @@ GzioReadStream::inflate_window ()
 }
 
 
+/*
+ *  Block boundaries only depend on the bit position in the input and on
+ *  the last 32K of output, which makes them good places to resume from.
+ */
+
+void
+GzioReadStream::add_seek_point ()
+{
+  SeekPoint point;
+
+  point.outOffset = _savedOffset + _wp;
+  point.inOffset = _input->pos () - (_inbufSize - _inbufD);
+  point.bb = _bb;
+  point.bk = _bk;
+  point.slide = Common::SharedPtr<uint8> (new uint8[WSIZE], Common::ArrayDeleter<uint8> ());
+  memcpy (point.slide.get (), _slide, WSIZE);
+
+  _seekPoints.push_back (point);
+}
+
+
+bool
+GzioReadStream::restore_seek_point (int64 offset, int64 after)
+{
+  const SeekPoint *point = NULL;
+
+  for (uint i = 0; i < _seekPoints.size () && (int64) _seekPoints[i].outOffset <= offset; i++)
+    point = &_seekPoints[i];
+
+  if (!point || (int64) point->outOffset <= after)
+    return false;
+
+  parentSeek (point->inOffset);
+  _bb = point->bb;
+  _bk = point->bk;
+  memcpy (_slide, point->slide.get (), WSIZE);
+
+  /* We are at the start of a block.  */
+  _lastBlock = 0;
+  _blockLen = 0;
+  _codeState = 0;
+  huft_free (_tl);
+  huft_free (_td);
+  _tl = NULL;
+  _td = NULL;
+
+  /* Resume filling the window the point is in.  */
+  _wp = point->outOffset & (WSIZE - 1);
+  _savedOffset = point->outOffset - _wp;
+  fill_window ();
+
+  return true;
+}
+
+
 void
 GzioReadStream::initialize_tables()
 {
@@ -1062,9 +1127,18 @@ GzioReadStream::readAtOffset (int64 offset, byte *buf, uint32 len)
 {
   int32 ret = 0;
 
-  /* Do we reset decompression to the beginning of the file?  */
+  /* Do we reset decompression to the beginning of the file, or to the
+     closest seek point?  */
   if (_savedOffset > offset + WSIZE)
-    initialize_tables ();
+    {
+      if (!restore_seek_point (offset, -1))
+	initialize_tables ();
+    }
+  else if (_seekPointInterval && offset >= _savedOffset + _seekPointInterval)
+    {
+      /* Skip ahead if a point was recorded there before.  */
+      restore_seek_point (offset, _savedOffset);
+    }
 
   /*
    *  This loop operates upon uncompressed data only.  The only
@@ -1191,6 +1265,7 @@ GzioReadStream::clickteamDecompress (byte *outbuf, uint32 outsize, byte *inbuf,
   Common::ScopedPtr<GzioReadStream> gzio(GzioReadStream::openClickteam(new Common::MemoryReadStream(inbuf, insize, DisposeAfterUse::NO), outsize + off, DisposeAfterUse::YES));
   if (!gzio)
     return -1;
+  gzio->_seekPointInterval = 0;
   return gzio->readAtOffset(off, outbuf, outsize);
 }
 
@@ -1200,6 +1275,7 @@ GzioReadStream::deflateDecompress (byte *outbuf, uint32 outsize, byte *inbuf, ui
   Common::ScopedPtr<GzioReadStream> gzio(GzioReadStream::openDeflate(new Common::MemoryReadStream(inbuf, insize, DisposeAfterUse::NO), outsize + off, DisposeAfterUse::YES));
   if (!gzio)
     return -1;
+  gzio->_seekPointInterval = 0;
   return gzio->readAtOffset(off, outbuf, outsize);
 }
 
@@ -1209,6 +1285,7 @@ GzioReadStream::zlibDecompress (byte *outbuf, uint32 outsize, byte *inbuf, uint3
   Common::ScopedPtr<GzioReadStream> gzio(GzioReadStream::openZlib(new Common::MemoryReadStream(inbuf, insize, DisposeAfterUse::NO), outsize + off, DisposeAfterUse::YES));
   if (!gzio)
     return -1;
+  gzio->_seekPointInterval = 0;
   return gzio->readAtOffset(off, outbuf, outsize);
 }
 
@@ -36,6 +36,7 @@
 
 #include "common/scummsys.h"
 #include "common/stream.h"
+#include "common/array.h"
 #include "common/ptr.h"
 
 namespace Common {
@@ -73,6 +74,25 @@ private:
 	static const int WSIZE = 0x8000;
 	static const int INBUFSIZ = 0x2000;
 
+  /*
+   *  Distance in uncompressed data between two seek points.  Each one
+   *  holds a copy of the window, i.e. costs about 32K.
+   */
+
+	static const uint32 SEEK_POINT_INTERVAL = 0x100000;
+
+	/* A block boundary decompression can be resumed from.  */
+	struct SeekPoint {
+		/* The offset in uncompressed data.  */
+		uint64 outOffset;
+		/* The offset in the underlying stream, and the bit buffer.  */
+		int64 inOffset;
+		unsigned long bb;
+		unsigned bk;
+		/* The sliding window at that point.  */
+		Common::SharedPtr<uint8> slide;
+	};
+
 	/* If input is in memory following fields are used instead of file.  */
 	Common::DisposablePtr<Common::SeekableReadStream> _input;
 	/* The offset at which the data starts in the underlying file.  */
@@ -118,6 +138,11 @@ private:
 	uint64 _streamPos;
 	bool _eos;
 
+	/* The seek points, by increasing offset, and the distance between them
+	   or 0 to not record any.  */
+	Common::Array<SeekPoint> _seekPoints;
+	uint32 _seekPointInterval;
+
 	enum class Mode { ZLIB, CLICKTEAM } _mode;
 
         GzioReadStream(Common::SeekableReadStream *parent, DisposeAfterUse::Flag disposeParent, uint64 uncompressedSize, Mode mode) :
@@ -126,9 +151,13 @@ private:
 	  _inflateD(0), _bb(0), _bk(0), _wp(0), _tl(nullptr),
 	  _td(nullptr), _bl(0),
 	  _bd(0), _savedOffset(0), _err(false), _mode(mode), _input(parent, disposeParent),
-	  _inbufD(0), _inbufSize(0), _uncompressedSize(uncompressedSize), _streamPos(0), _eos(false) {}
+	  _inbufD(0), _inbufSize(0), _uncompressedSize(uncompressedSize), _streamPos(0), _eos(false),
+	  _seekPointInterval(uncompressedSize > 2 * SEEK_POINT_INTERVAL ? SEEK_POINT_INTERVAL : 0) {}
 
 	void inflate_window();
+	void fill_window();
+	void add_seek_point();
+	bool restore_seek_point(int64 offset, int64 after);
 	void initialize_tables();
 	bool test_zlib_header();
 	void get_new_block();
@@ -55,7 +55,10 @@ namespace Common {
 
 namespace {
 
-class InstallShieldCabinet : public Archive {
+// Keep up to this many bytes of recently extracted members in memory
+static const uint32 kMaxRecentlyUsedSize = 8 * 1024 * 1024;
+
+class InstallShieldCabinet : public MemcachingCaseInsensitiveArchive {
 public:
 	InstallShieldCabinet();
 
@@ -66,7 +69,8 @@ public:
 	bool hasFile(const Path &path) const override;
 	int listMembers(ArchiveMemberList &list) const override;
 	const ArchiveMemberPtr getMember(const Path &path) const override;
-	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
+	String translatePath(const Path &path) const override;
+	SharedArchiveContents readContentsForPath(const String &name) const override;
 
 private:
 	enum Flags { kSplit = 1, kObfuscated = 2, kCompressed = 4, kInvalid = 8 };
@@ -106,7 +110,7 @@ private:
 	String getVolumeName(uint volume) const;
 };
 
-InstallShieldCabinet::InstallShieldCabinet() : _version(0) {
+InstallShieldCabinet::InstallShieldCabinet() : MemcachingCaseInsensitiveArchive(512, kMaxRecentlyUsedSize), _version(0) {
 }
 
 bool InstallShieldCabinet::open(const String &baseName) {
@@ -259,6 +263,7 @@ bool InstallShieldCabinet::open(const String &baseName) {
 }
 
 void InstallShieldCabinet::close() {
+	clearContentsCache();
 	_baseName.clear();
 	_map.clear();
     _volumeHeaders.clear();
@@ -282,28 +287,31 @@ const ArchiveMemberPtr InstallShieldCabinet::getMember(const Path &path) const {
 	return ArchiveMemberPtr(new GenericArchiveMember(name, this));
 }
 
-SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &path) const {
-	String name = path.toString();
+String InstallShieldCabinet::translatePath(const Path &path) const {
+	return path.toString();
+}
+
+SharedArchiveContents InstallShieldCabinet::readContentsForPath(const String &name) const {
 	if (!_map.contains(name))
-		return nullptr;
+		return SharedArchiveContents();
 
 	const FileEntry &entry = _map[name];
 
     if (entry.flags & kObfuscated) {
         warning("Cannot extract obfuscated file %s", name.c_str());
-        return nullptr;
+        return SharedArchiveContents();
     }
 
 	ScopedPtr<SeekableReadStream> stream(SearchMan.createReadStreamForMember(getVolumeName((entry.volume))));
 	if (!stream) {
 		warning("Failed to open volume for file '%s'", name.c_str());
-		return nullptr;
+		return SharedArchiveContents();
 	}
 
 	byte *src = nullptr;
 	if (entry.flags & kSplit) {
 		// File is split across volumes
-		src = (byte *)malloc(entry.compressedSize);
+		src = new byte[entry.compressedSize];
 		uint bytesRead = 0;
 		uint volume = entry.volume;
 
@@ -317,8 +325,8 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 			stream.reset(SearchMan.createReadStreamForMember(getVolumeName((++volume))));
 			if (!stream.get()) {
 				warning("Failed to read split file %s", name.c_str());
-				free(src);
-				return nullptr;
+				delete[] src;
+				return SharedArchiveContents();
 			}
 			stream->seek(_volumeHeaders[volume - 1].firstFileOffset);
 			stream->read(src + bytesRead, _volumeHeaders[volume - 1].firstFileSizeCompressed);
@@ -330,36 +338,36 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 	if (!(entry.flags & kCompressed)) {
 		if (src == nullptr) {
 			// File not split, return a substream
-			return new SeekableSubReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES);
+			return SharedArchiveContents::bypass(new SeekableSubReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES));
 		} else {
 			// File split, return the assembled data
-			return new MemoryReadStream(src, entry.uncompressedSize, DisposeAfterUse::YES);
+			return SharedArchiveContents(src, entry.uncompressedSize);
 		}		
 	}
 
 #ifdef USE_ZLIB
-	byte *dst = (byte *)malloc(entry.uncompressedSize);
+	byte *dst = new byte[entry.uncompressedSize];
 
 	if (!src) {
-		src = (byte *)malloc(entry.compressedSize);
+		src = new byte[entry.compressedSize];
 		stream->seek(entry.offset);
 		stream->read(src, entry.compressedSize);
 	}
 
 	bool result = inflateZlibInstallShield(dst, entry.uncompressedSize, src, entry.compressedSize);
-	free(src);
+	delete[] src;
 
 	if (!result) {
 		warning("failed to inflate CAB file '%s'", name.c_str());
-		free(dst);
-		return nullptr;
+		delete[] dst;
+		return SharedArchiveContents();
 	}
 
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	return SharedArchiveContents(dst, entry.uncompressedSize);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
-	free(src);
-	return 0;
+	delete[] src;
+	return SharedArchiveContents();
 #endif
 }
 
@@ -26,7 +26,10 @@
 
 namespace Common {
 
-InstallShieldV3::InstallShieldV3() : Common::Archive() {
+// Keep up to this many bytes of recently extracted members in memory
+static const uint32 kMaxRecentlyUsedSize = 8 * 1024 * 1024;
+
+InstallShieldV3::InstallShieldV3() : Common::MemcachingCaseInsensitiveArchive(512, kMaxRecentlyUsedSize) {
 	_stream = nullptr;
 }
 
@@ -116,6 +119,7 @@ bool InstallShieldV3::open(const Common::String &filename) {
 }
 
 void InstallShieldV3::close() {
+	clearContentsCache();
 	delete _stream; _stream = nullptr;
 	_map.clear();
 }
@@ -137,20 +141,31 @@ const Common::ArchiveMemberPtr InstallShieldV3::getMember(const Common::Path &pa
 	return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
 }
 
-Common::SeekableReadStream *InstallShieldV3::createReadStreamForMember(const Common::Path &path) const {
+Common::String InstallShieldV3::translatePath(const Common::Path &path) const {
 	Common::String name = path.toString();
 	// Make sure "/" is converted to "\"
 	while (name.contains("/"))
 		Common::replace(name, "/", "\\");
 
+	return name;
+}
+
+Common::SharedArchiveContents InstallShieldV3::readContentsForPath(const Common::String &name) const {
 	if (!_stream || !_map.contains(name))
-		return nullptr;
+		return Common::SharedArchiveContents();
 
 	const FileEntry &entry = _map[name];
 
 	// Seek to our offset and then send it off to the decompressor
 	_stream->seek(entry.offset);
-	return Common::decompressDCL(_stream, entry.compressedSize, entry.uncompressedSize);
+
+	byte *data = new byte[entry.uncompressedSize];
+	if (!Common::decompressDCL(_stream, data, entry.compressedSize, entry.uncompressedSize)) {
+		delete[] data;
+		return Common::SharedArchiveContents();
+	}
+
+	return Common::SharedArchiveContents(data, entry.uncompressedSize);
 }
 
 char InstallShieldV3::getPathSeparator() const {
@@ -32,7 +32,7 @@
 
 namespace Common {
 
-class InstallShieldV3 : public Common::Archive {
+class InstallShieldV3 : public Common::MemcachingCaseInsensitiveArchive {
 public:
 	InstallShieldV3();
 	~InstallShieldV3() override;
@@ -45,7 +45,8 @@ public:
 	bool hasFile(const Common::Path &path) const override;
 	int listMembers(Common::ArchiveMemberList &list) const override;
 	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override;
-	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override;
+	Common::String translatePath(const Common::Path &path) const override;
+	Common::SharedArchiveContents readContentsForPath(const Common::String &name) const override;
 	char getPathSeparator() const override;
 
 private:
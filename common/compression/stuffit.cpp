@@ -84,7 +84,10 @@ private:
 	void readTree14(Common::BitStream8LSB *bits, SIT14Data *dat, uint16 codesize, uint16 *result) const;
 };
 
-StuffItArchive::StuffItArchive() : Common::MemcachingCaseInsensitiveArchive(), _flattenTree(false) {
+// Keep up to this many bytes of recently extracted members in memory
+static const uint32 kMaxRecentlyUsedSize = 8 * 1024 * 1024;
+
+StuffItArchive::StuffItArchive() : Common::MemcachingCaseInsensitiveArchive(512, kMaxRecentlyUsedSize), _flattenTree(false) {
 	_stream = nullptr;
 }
 
@@ -261,6 +264,7 @@ bool StuffItArchive::open(Common::SeekableReadStream *stream, bool flattenTree)
 }
 
 void StuffItArchive::close() {
+	clearContentsCache();
 	delete _stream;
 	_stream = nullptr;
 	_map.clear();
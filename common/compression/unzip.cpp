@@ -87,6 +87,9 @@ typedef Byte Bytef;
 #include "common/compression/gzio.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/memtag.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -906,62 +909,108 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 }
 
 /*
-  Open for reading data the current file in the zipfile.
-  If there is no error and the file is opened, the return value is UNZ_OK.
+  Compressed data of a file, as read from the zipfile, together with what is
+  needed to decompress and check it. Decompression does not touch the zipfile,
+  so it can run on another thread.
 */
-Common::SharedArchiveContents unzOpenCurrentFile (unzFile file, const Common::CRC32 &crc) {
+struct unz_pending_file {
+	byte *compressedBuffer;
+	uLong compressed_size;
+	uLong uncompressed_size;
+	uLong compression_method;
+	uLong crc;
+};
+
+/*
+  Read the compressed data of the current file in the zipfile.
+  If there is no error, the return value is UNZ_OK and pending->compressedBuffer
+  has to be released by unzlocal_DecompressFile.
+*/
+static int unzlocal_ReadCurrentFile(unzFile file, unz_pending_file *pending) {
 	uInt iSizeVar;
 	unz_s *s;
 	uLong offset_local_extrafield;  /* offset of the local extra field */
 	uInt  size_local_extrafield;    /* size of the local extra field */
 
 	if (file == nullptr)
-		return Common::SharedArchiveContents();
+		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 	if (!s->current_file_ok)
-		return Common::SharedArchiveContents();
+		return UNZ_PARAMERROR;
 
 	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar,
 				&offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
-		return Common::SharedArchiveContents();
+		return UNZ_BADZIPFILE;
 
 	if (s->cur_file_info.compression_method != 0 && s->cur_file_info.compression_method != Z_DEFLATED) {
 		warning("Unknown compression algoritthm %d", (int)s->cur_file_info.compression_method);
-		return Common::SharedArchiveContents();
+		return UNZ_BADZIPFILE;
 	}
 
-	uint32 crc32_wait = s->cur_file_info.crc;
+	pending->compressed_size = s->cur_file_info.compressed_size;
+	pending->uncompressed_size = s->cur_file_info.uncompressed_size;
+	pending->compression_method = s->cur_file_info.compression_method;
+	pending->crc = s->cur_file_info.crc;
 
-	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
+	pending->compressedBuffer = new byte[pending->compressed_size];
 	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
-	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
+	s->_stream->read(pending->compressedBuffer, pending->compressed_size);
+
+	return UNZ_OK;
+}
+
+/*
+  Decompress and check data read by unzlocal_ReadCurrentFile, releasing the
+  compressed buffer. Returns the uncompressed data, allocated with new[], or
+  nullptr on failure.
+*/
+static byte *unzlocal_DecompressFile(unz_pending_file *pending, const Common::CRC32 &crc) {
+	byte *compressedBuffer = pending->compressedBuffer;
 	byte *uncompressedBuffer = nullptr;
+	pending->compressedBuffer = nullptr;
 
-	switch (s->cur_file_info.compression_method) {
+	switch (pending->compression_method) {
 	case 0: // Store
 		uncompressedBuffer = compressedBuffer;
 		break;
 	case Z_DEFLATED:
-		uncompressedBuffer = new byte[s->cur_file_info.uncompressed_size];
-		assert(s->cur_file_info.uncompressed_size == 0 || uncompressedBuffer != nullptr);
-		Common::GzioReadStream::deflateDecompress(uncompressedBuffer, s->cur_file_info.uncompressed_size, compressedBuffer, s->cur_file_info.compressed_size);
+		uncompressedBuffer = new byte[pending->uncompressed_size];
+		assert(pending->uncompressed_size == 0 || uncompressedBuffer != nullptr);
+		Common::GzioReadStream::deflateDecompress(uncompressedBuffer, pending->uncompressed_size, compressedBuffer, pending->compressed_size);
 		delete[] compressedBuffer;
 		compressedBuffer = nullptr;
 		break;
 	default:
-		warning("Unknown compression algoritthm %d", (int)s->cur_file_info.compression_method);
+		warning("Unknown compression algoritthm %d", (int)pending->compression_method);
 		delete[] compressedBuffer;
-		return Common::SharedArchiveContents();
+		return nullptr;
 	}
 
-	uint32 crc32_data = crc.crcFast(uncompressedBuffer, s->cur_file_info.uncompressed_size);
-	if (crc32_data != crc32_wait) {
+	uint32 crc32_data = crc.crcFast(uncompressedBuffer, pending->uncompressed_size);
+	if (crc32_data != pending->crc) {
 		delete[] uncompressedBuffer;
-		warning("CRC32 mismatch: %08x, %08x", crc32_data, crc32_wait);
-		return Common::SharedArchiveContents();
+		warning("CRC32 mismatch: %08x, %08x", crc32_data, (uint32)pending->crc);
+		return nullptr;
 	}
 
-	return Common::SharedArchiveContents(uncompressedBuffer, s->cur_file_info.uncompressed_size);
+	return uncompressedBuffer;
+}
+
+/*
+  Open for reading data the current file in the zipfile.
+  If there is no error and the file is opened, the return value is UNZ_OK.
+*/
+Common::SharedArchiveContents unzOpenCurrentFile (unzFile file, const Common::CRC32 &crc) {
+	unz_pending_file pending;
+
+	if (unzlocal_ReadCurrentFile(file, &pending) != UNZ_OK)
+		return Common::SharedArchiveContents();
+
+	byte *contents = unzlocal_DecompressFile(&pending, crc);
+	if (!contents)
+		return Common::SharedArchiveContents();
+
+	return Common::SharedArchiveContents(contents, pending.uncompressed_size);
 }
 
 
@@ -969,10 +1018,37 @@ namespace Common {
 
 
 class ZipArchive : public MemcachingCaseInsensitiveArchive {
+	/**
+	 * Decompressed members are kept in memory until their total size exceeds
+	 * kMaxCachedContentsSize, at which point the least recently used ones are
+	 * dropped. This spares inflating files again which are opened repeatedly.
+	 */
+	static const uint32 kMaxCachedContentsSize = 2 * 1024 * 1024;
+
+	struct CachedContents {
+		SharedArchiveContents _contents;
+		uint32 _size;
+		uint32 _lastUse;
+	};
+
+	typedef HashMap<String, CachedContents, IgnoreCase_Hash, IgnoreCase_EqualTo> ContentsCache;
+
+	struct PendingMember {
+		String _name;
+		unz_pending_file _file;
+		byte *_contents;
+	};
+
 	unzFile _zipFile;
 	Common::CRC32 _crc;
 	bool _flattenTree;
 
+	mutable ContentsCache _contentsCache;
+	mutable uint32 _cachedSize;
+	mutable uint32 _useCounter;
+
+	void cacheContents(const String &name, const SharedArchiveContents &contents, uint32 size) const;
+
 public:
 	ZipArchive(unzFile zipFile, bool flattenTree);
 
@@ -982,6 +1058,7 @@ public:
 	bool hasFile(const Path &path) const override;
 	int listMembers(ArchiveMemberList &list) const override;
 	const ArchiveMemberPtr getMember(const Path &path) const override;
+	void prefetchMembers(const ArchiveMemberList &members) const override;
 	Common::SharedArchiveContents readContentsForPath(const Common::String& translated) const override;
 	Common::String translatePath(const Common::Path &path) const override {
 		return _flattenTree ? path.getLastComponent().toString() : path.toString();
@@ -1006,11 +1083,14 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile, bool flattenTree) : _zipFile(zipFile), _crc(), _flattenTree(flattenTree) {
+ZipArchive::ZipArchive(unzFile zipFile, bool flattenTree) : _zipFile(zipFile), _crc(), _flattenTree(flattenTree),
+	_cachedSize(0), _useCounter(0) {
 	assert(_zipFile);
 }
 
 ZipArchive::~ZipArchive() {
+	for (ContentsCache::iterator i = _contentsCache.begin(); i != _contentsCache.end(); ++i)
+		memTagFreed(kMemTagResources, i->_value._size);
 	unzClose(_zipFile);
 }
 
@@ -1040,11 +1120,91 @@ const ArchiveMemberPtr ZipArchive::getMember(const Path &path) const {
 	return ArchiveMemberPtr(new GenericArchiveMember(name, this));
 }
 
+void ZipArchive::prefetchMembers(const ArchiveMemberList &members) const {
+	Array<PendingMember> pending;
+	uint32 pendingSize = 0;
+
+	// Reading the compressed data has to go through the single archive
+	// stream, so do that here and only spread the decompression over
+	// the thread pool. Stop once the cache would be full anyway.
+	for (ArchiveMemberList::const_iterator i = members.begin(); i != members.end(); ++i) {
+		String name = translatePath((*i)->getName());
+		if (_contentsCache.contains(name) || unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
+			continue;
+
+		uint32 size = ((const unz_s *)_zipFile)->cur_file_info.uncompressed_size;
+		if (pendingSize + size > kMaxCachedContentsSize)
+			break;
+
+		PendingMember member;
+		member._name = name;
+		member._contents = nullptr;
+		if (unzlocal_ReadCurrentFile(_zipFile, &member._file) != UNZ_OK)
+			continue;
+
+		pending.push_back(member);
+		pendingSize += size;
+	}
+
+	g_system->getThreadPool().parallelFor(0, pending.size(), 1, [&](uint first, uint last) {
+		for (uint j = first; j < last; ++j)
+			pending[j]._contents = unzlocal_DecompressFile(&pending[j]._file, _crc);
+	});
+
+	for (uint j = 0; j < pending.size(); ++j) {
+		if (!pending[j]._contents)
+			continue;
+
+		uint32 size = pending[j]._file.uncompressed_size;
+		cacheContents(pending[j]._name, SharedArchiveContents(pending[j]._contents, size), size);
+	}
+}
+
+void ZipArchive::cacheContents(const String &name, const SharedArchiveContents &contents, uint32 size) const {
+	if (size > kMaxCachedContentsSize)
+		return;
+
+	while (_cachedSize + size > kMaxCachedContentsSize) {
+		ContentsCache::iterator oldest = _contentsCache.begin();
+		for (ContentsCache::iterator i = _contentsCache.begin(); i != _contentsCache.end(); ++i) {
+			if (i->_value._lastUse < oldest->_value._lastUse)
+				oldest = i;
+		}
+
+		_cachedSize -= oldest->_value._size;
+		memTagFreed(kMemTagResources, oldest->_value._size);
+		_contentsCache.erase(oldest);
+	}
+
+	CachedContents &entry = _contentsCache[name];
+	entry._contents = contents;
+	entry._size = size;
+	entry._lastUse = ++_useCounter;
+	_cachedSize += size;
+	memTagAllocated(kMemTagResources, size);
+}
+
 Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::String& name) const {
+	ContentsCache::iterator cached = _contentsCache.find(name);
+	if (cached != _contentsCache.end()) {
+		cached->_value._lastUse = ++_useCounter;
+		return cached->_value._contents;
+	}
+
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return Common::SharedArchiveContents();
 
-	return unzOpenCurrentFile(_zipFile, _crc);
+	unz_pending_file pending;
+	if (unzlocal_ReadCurrentFile(_zipFile, &pending) != UNZ_OK)
+		return Common::SharedArchiveContents();
+
+	byte *data = unzlocal_DecompressFile(&pending, _crc);
+	if (!data)
+		return Common::SharedArchiveContents();
+
+	Common::SharedArchiveContents contents(data, pending.uncompressed_size);
+	cacheContents(name, contents, pending.uncompressed_size);
+	return contents;
 }
 
 Archive *makeZipArchive(const String &name, bool flattenTree) {
@@ -150,8 +150,13 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
  *
  * It is safe to call this with a NULL parameter (in this case, NULL is
  * returned).
+ *
+ * @param toBeWrapped	the stream receiving the compressed data
+ * @param level			the zlib compression level, from 1 (fastest) to 9
+ *						(smallest), or -1 for the default. Every level
+ *						produces data wrapCompressedReadStream() can read.
  */
-WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped);
+WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped, int level = -1);
 
 /** @} */
 
@@ -0,0 +1,253 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/concurrent-memorypool.h"
+#include "common/mutex.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * Chunks handed out by the pool are preceded by a pointer sized header.
+ * While the chunk is in use the header holds the id of the allocating
+ * thread, while it is free it links the chunk into a free list.
+ */
+enum {
+	kHeaderSize = sizeof(void *),
+	kCacheSlots = 8
+};
+
+struct ConcurrentMemoryPool::Cache {
+	uint32 poolId;
+	std::atomic<int> refs;      ///< One reference held by the pool, one by the thread
+	std::atomic<bool> orphaned; ///< Set once the thread has let go of the cache
+	void *free;
+	uint count;
+	Cache *next;                ///< Next cache of the same pool, guarded by the pool lock
+
+	explicit Cache(uint32 id) : poolId(id), refs(2), orphaned(false), free(nullptr), count(0), next(nullptr) {}
+
+	void release() {
+		if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+};
+
+namespace {
+
+std::atomic<uint32> s_nextPoolId(1);
+std::atomic<uint32> s_nextThreadId(1);
+
+/**
+ * The caches of the calling thread. A slot is matched by pool id only,
+ * so a slot still referring to a destroyed pool is never used again,
+ * and is recycled when the thread needs a slot for another pool.
+ */
+struct ThreadCaches {
+	struct Slot {
+		uint32 poolId;
+		ConcurrentMemoryPool::Cache *cache;
+	};
+
+	uint32 threadId;
+	uint nextVictim;
+	Slot slots[kCacheSlots];
+
+	ThreadCaches() : threadId(s_nextThreadId.fetch_add(1, std::memory_order_relaxed)), nextVictim(0) {
+		for (uint i = 0; i < kCacheSlots; ++i) {
+			slots[i].poolId = 0;
+			slots[i].cache = nullptr;
+		}
+	}
+
+	~ThreadCaches() {
+		for (uint i = 0; i < kCacheSlots; ++i) {
+			if (slots[i].cache)
+				orphan(slots[i].cache);
+		}
+	}
+
+	static void orphan(ConcurrentMemoryPool::Cache *cache) {
+		// The cached chunks stay where they are; the pool picks them up
+		// on its next refill, or frees them along with its pages
+		cache->orphaned.store(true, std::memory_order_release);
+		cache->release();
+	}
+};
+
+thread_local ThreadCaches t_caches;
+
+} // End of anonymous namespace
+
+ConcurrentMemoryPool::ConcurrentMemoryPool(size_t chunkSize, uint batchSize)
+	: _chunkSize(MAX<size_t>((chunkSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1), sizeof(void *))),
+	  _batchSize(MAX<uint>(batchSize, 1)), _id(s_nextPoolId.fetch_add(1, std::memory_order_relaxed)),
+	  _pool(kHeaderSize + _chunkSize), _mutex(nullptr), _caches(nullptr),
+	  _refills(0), _returns(0), _crossThreadFrees(0) {
+}
+
+ConcurrentMemoryPool::~ConcurrentMemoryPool() {
+	// Any chunks still cached are freed along with the pages of _pool
+	Cache *cache = _caches;
+	while (cache) {
+		Cache *next = cache->next;
+		cache->release();
+		cache = next;
+	}
+
+	delete _mutex;
+}
+
+void ConcurrentMemoryPool::lock() {
+	if (!_mutex) {
+		// The Mutex class can only be used once the backend is initialized,
+		// but until then there is only a single thread, see String.
+		if (!g_system || !g_system->backendInitialized())
+			return;
+		_mutex = new Mutex();
+	}
+	_mutex->lock();
+}
+
+void ConcurrentMemoryPool::unlock() {
+	if (_mutex)
+		_mutex->unlock();
+}
+
+void ConcurrentMemoryPool::releaseMutex() {
+	delete _mutex;
+	_mutex = nullptr;
+}
+
+ConcurrentMemoryPool::Cache *ConcurrentMemoryPool::getCache() {
+	ThreadCaches &tc = t_caches;
+	for (uint i = 0; i < kCacheSlots; ++i) {
+		if (tc.slots[i].poolId == _id)
+			return tc.slots[i].cache;
+	}
+
+	// Take a free slot, or else hand back the cache in the next slot
+	ThreadCaches::Slot *slot = nullptr;
+	for (uint i = 0; i < kCacheSlots && !slot; ++i) {
+		if (!tc.slots[i].cache)
+			slot = &tc.slots[i];
+	}
+	if (!slot) {
+		slot = &tc.slots[tc.nextVictim];
+		tc.nextVictim = (tc.nextVictim + 1) % kCacheSlots;
+		ThreadCaches::orphan(slot->cache);
+	}
+
+	Cache *cache = new Cache(_id);
+	lock();
+	cache->next = _caches;
+	_caches = cache;
+	unlock();
+
+	slot->poolId = _id;
+	slot->cache = cache;
+	return cache;
+}
+
+void ConcurrentMemoryPool::adoptOrphans() {
+	Cache **link = &_caches;
+	while (*link) {
+		Cache *cache = *link;
+		if (!cache->orphaned.load(std::memory_order_acquire)) {
+			link = &cache->next;
+			continue;
+		}
+
+		void *chunk = cache->free;
+		while (chunk) {
+			void *next = *(void **)chunk;
+			_pool.freeChunk(chunk);
+			chunk = next;
+		}
+
+		*link = cache->next;
+		cache->release();
+	}
+}
+
+void ConcurrentMemoryPool::refill(Cache *cache) {
+	lock();
+	adoptOrphans();
+	for (uint i = 0; i < _batchSize; ++i) {
+		void *chunk = _pool.allocChunk();
+		*(void **)chunk = cache->free;
+		cache->free = chunk;
+	}
+	unlock();
+
+	cache->count += _batchSize;
+	_refills.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConcurrentMemoryPool::giveBack(Cache *cache, uint count) {
+	lock();
+	for (uint i = 0; i < count; ++i) {
+		void *chunk = cache->free;
+		cache->free = *(void **)chunk;
+		_pool.freeChunk(chunk);
+	}
+	unlock();
+
+	cache->count -= count;
+	_returns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void *ConcurrentMemoryPool::allocChunk() {
+	Cache *cache = getCache();
+	if (!cache->free)
+		refill(cache);
+
+	byte *chunk = (byte *)cache->free;
+	cache->free = *(void **)chunk;
+	cache->count--;
+
+	*(uint32 *)chunk = t_caches.threadId;
+	return chunk + kHeaderSize;
+}
+
+void ConcurrentMemoryPool::freeChunk(void *ptr) {
+	byte *chunk = (byte *)ptr - kHeaderSize;
+	if (*(uint32 *)chunk != t_caches.threadId)
+		_crossThreadFrees.fetch_add(1, std::memory_order_relaxed);
+
+	Cache *cache = getCache();
+	*(void **)chunk = cache->free;
+	cache->free = chunk;
+	cache->count++;
+
+	if (cache->count >= 2 * _batchSize)
+		giveBack(cache, _batchSize);
+}
+
+ConcurrentMemoryPool::Stats ConcurrentMemoryPool::getStats() const {
+	Stats stats;
+	stats.refills = _refills.load(std::memory_order_relaxed);
+	stats.returns = _returns.load(std::memory_order_relaxed);
+	stats.crossThreadFrees = _crossThreadFrees.load(std::memory_order_relaxed);
+	return stats;
+}
+
+} // End of namespace Common
@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_CONCURRENT_MEMORYPOOL_H
+#define COMMON_CONCURRENT_MEMORYPOOL_H
+
+#include "common/memorypool.h"
+#include "common/noncopyable.h"
+
+#include <atomic>
+
+namespace Common {
+
+class Mutex;
+
+/**
+ * @addtogroup common_memory_pool
+ * @{
+ */
+
+/**
+ * A MemoryPool that can be shared between threads.
+ *
+ * Each thread keeps a small cache of free chunks for every pool it uses,
+ * so that allocChunk() and freeChunk() normally run without taking any
+ * lock. Only when a cache runs empty, or grows beyond twice the batch
+ * size, are chunks moved from or to the shared pool, a whole batch at a
+ * time.
+ *
+ * Chunks may be freed on a different thread than the one that allocated
+ * them; they then go to the cache of the freeing thread. Such frees are
+ * counted in the statistics, since a workload dominated by them keeps
+ * shifting chunks between the caches.
+ *
+ * The pool must not be destroyed while other threads still use it. The
+ * chunks cached by a thread that exits, or that has more pools in use
+ * than it has cache slots for, are taken back by the pool on its next
+ * refill.
+ */
+class ConcurrentMemoryPool : NonCopyable {
+public:
+	struct Stats {
+		uint32 refills;          ///< Number of batches moved from the shared pool to a thread cache
+		uint32 returns;          ///< Number of batches moved from a thread cache back to the shared pool
+		uint32 crossThreadFrees; ///< Number of chunks freed by another thread than the allocating one
+	};
+
+	/**
+	 * Constructor for a pool with the given chunk size.
+	 * @param chunkSize		the chunk size of this memory pool
+	 * @param batchSize		the number of chunks moved at once between
+	 *						the shared pool and a thread cache
+	 */
+	explicit ConcurrentMemoryPool(size_t chunkSize, uint batchSize = 32);
+	~ConcurrentMemoryPool();
+
+	/**
+	 * Allocate a new chunk from the memory pool.
+	 */
+	void *allocChunk();
+
+	/**
+	 * Return a chunk to the memory pool. The given pointer must have
+	 * been obtained from calling the allocChunk() method of the very
+	 * same pool, but possibly on another thread.
+	 */
+	void freeChunk(void *ptr);
+
+	/**
+	 * Return the chunk size used by this memory pool.
+	 */
+	size_t getChunkSize() const { return _chunkSize; }
+
+	/**
+	 * Return the number of batch transfers and cross-thread frees so far.
+	 */
+	Stats getStats() const;
+
+	/**
+	 * Release the mutex guarding the shared pool. This must be called
+	 * before the backend is destroyed, if the pool outlives it.
+	 */
+	void releaseMutex();
+
+	struct Cache;
+
+private:
+	const size_t _chunkSize;
+	const uint _batchSize;
+	const uint32 _id;       ///< Unique serial number, never reused by another pool
+	MemoryPool _pool;
+	Mutex *_mutex;
+	Cache *_caches;         ///< All thread caches created by this pool
+	std::atomic<uint32> _refills;
+	std::atomic<uint32> _returns;
+	std::atomic<uint32> _crossThreadFrees;
+
+	void lock();
+	void unlock();
+
+	Cache *getCache();
+	void refill(Cache *cache);
+	void giveBack(Cache *cache, uint count);
+	void adoptOrphans();
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -23,6 +23,8 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -50,7 +52,21 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _hasFlushedDigest(false), _flushedSize(0) {
+}
+
+FSNode ConfigManager::getConfigDirectory() {
+	String configFile = _filename;
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return FSNode();
+
+	FSNode dir = FSNode(configFile).getParent();
+	if (!dir.isDirectory())
+		return FSNode();
+
+	return dir;
 }
 
 void ConfigManager::defragment() {
@@ -75,6 +91,9 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_hasFlushedDigest = source._hasFlushedDigest;
+	_flushedSize = source._flushedSize;
+	memcpy(_flushedDigest, source._flushedDigest, sizeof(_flushedDigest));
 }
 
 
@@ -171,11 +190,32 @@ void ConfigManager::addDomain(const String &domainName, const ConfigManager::Dom
 
 
 bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
+	// The file is parsed in place after reading it in one go, instead of
+	// copying every line into a string first
+	const int64 size = stream.size() - stream.pos();
+	if (size < 0 || size > 0x7FFFFFFF || stream.err())
+		return false;
+
+	char *buffer = (char *)malloc(size + 1);
+	if (!buffer)
+		return false;
+
+	const uint32 len = stream.read(buffer, size);
+	buffer[len] = '\0';
+	const bool result = !stream.err() && loadFromBuffer(buffer, len);
+	free(buffer);
+	return result;
+}
+
+bool ConfigManager::loadFromBuffer(const char *buffer, uint32 size) {
 	String domainName;
 	String comment;
 	Domain domain;
 	int lineno = 0;
 
+	// Whatever was flushed before belongs to another file
+	_hasFlushedDigest = false;
+
 	_appDomain.clear();
 	_gameDomains.clear();
 	_miscDomains.clear();
@@ -191,33 +231,43 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
-	while (!stream.eos() && !stream.err()) {
+	const char *const bufferEnd = buffer + size;
+	const char *next = buffer;
+	while (next < bufferEnd) {
 		lineno++;
 
-		// Read a line
-		String line = stream.readLine();
-
-		if (line.size() == 0) {
+		// Find the end of the line. CR, LF and CR/LF all end a line.
+		const char *line = next;
+		const char *lineEnd = line;
+		while (lineEnd < bufferEnd && *lineEnd != '\n' && *lineEnd != '\r')
+			lineEnd++;
+		next = lineEnd;
+		if (next < bufferEnd && *next == '\r')
+			next++;
+		if (next < bufferEnd && *next == '\n')
+			next++;
+
+		if (line == lineEnd) {
 			// Do nothing
 		} else if (line[0] == '#') {
 			// Accumulate comments here. Once we encounter either the start
 			// of a new domain, or a key-value-pair, we associate the value
 			// of the 'comment' variable with that entity.
-			comment += line;
+			comment += String(line, lineEnd);
 			comment += "\n";
 		} else if (line[0] == '[') {
 			// It's a new domain which begins here.
 			// Determine where the previously accumulated domain goes, if we accumulated anything.
 			addDomain(domainName, domain);
 			domain.clear();
-			const char *p = line.c_str() + 1;
+			const char *p = line + 1;
 			// Get the domain name, and check whether it's valid (that
 			// is, verify that it only consists of alphanumerics,
 			// dashes and underscores).
-			while (*p && (isAlnum(*p) || *p == '-' || *p == '_'))
+			while (p < lineEnd && (isAlnum(*p) || *p == '-' || *p == '_'))
 				p++;
 
-			if (*p == '\0') {
+			if (p == lineEnd) {
 				warning("Config file buggy: missing ] in line %d", lineno);
 				return false;
 			} else if (*p != ']') {
@@ -225,7 +275,7 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 				return false;
 			}
 
-			domainName = String(line.c_str() + 1, p);
+			domainName = String(line + 1, p);
 
 			domain.setDomainComment(comment);
 			comment.clear();
@@ -234,12 +284,12 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			// This line should be a line with a 'key=value' pair, or an empty one.
 
 			// Skip leading whitespaces
-			const char *t = line.c_str();
-			while (isSpace(*t))
+			const char *t = line;
+			while (t < lineEnd && isSpace(*t))
 				t++;
 
 			// Skip empty lines / lines with only whitespace
-			if (*t == 0)
+			if (t == lineEnd)
 				continue;
 
 			// If no domain has been set, this config file is invalid!
@@ -249,22 +299,28 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			}
 
 			// Split string at '=' into 'key' and 'value'. First, find the "=" delimeter.
-			const char *p = strchr(t, '=');
+			const char *p = (const char *)memchr(t, '=', lineEnd - t);
 			if (!p) {
-				warning("Config file buggy: Junk found in line %d: '%s'", lineno, t);
+				warning("Config file buggy: Junk found in line %d: '%s'", lineno, String(t, lineEnd).c_str());
 				return false;
 			}
 
-			// Extract the key/value pair
-			String key(t, p);
-			String value(p + 1);
-
 			// Trim of spaces
-			key.trim();
-			value.trim();
+			const char *keyEnd = p;
+			while (keyEnd > t && isSpace(keyEnd[-1]))
+				keyEnd--;
+			const char *value = p + 1;
+			const char *valueEnd = lineEnd;
+			while (value < valueEnd && isSpace(*value))
+				value++;
+			while (valueEnd > value && isSpace(valueEnd[-1]))
+				valueEnd--;
+
+			// Extract the key/value pair
+			String key(t, keyEnd);
 
 			// Finally, store the key/value pair in the active domain
-			domain.setVal(key, value);
+			domain.setVal(key, String(value, valueEnd));
 
 			// Store comment
 			domain.setKVComment(key, comment);
@@ -279,42 +335,25 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	// Build the whole file in memory first, so that it can be compared with
+	// what was written last and is written in a single call
+	MemoryWriteStreamDynamic buffer(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(buffer, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(buffer, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(buffer, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(buffer, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -323,18 +362,51 @@ void ConfigManager::flushToDisk() {
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(buffer, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
 		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+			writeDomain(buffer, d->_key, d->_value);
+	}
+
+	// Nothing changed since the last flush
+	uint8 digest[16];
+	MemoryReadStream contents(buffer.getData(), buffer.size());
+	computeStreamMD5(contents, digest);
+	if (_hasFlushedDigest && _flushedSize == buffer.size() && !memcmp(digest, _flushedDigest, sizeof(digest)))
+		return;
+
+	WriteStream *stream;
+
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return;
+	} else {
+		DumpFile *dump = new DumpFile();
+		assert(dump);
+
+		if (!dump->open(_filename)) {
+			warning("Unable to write configuration file: %s", _filename.c_str());
+			delete dump;
+			return;
+		}
+
+		stream = dump;
 	}
 
+	const bool written = stream->write(buffer.getData(), buffer.size()) == buffer.size() && stream->flush();
 	delete stream;
 
+	_hasFlushedDigest = written;
+	_flushedSize = buffer.size();
+	memcpy(_flushedDigest, digest, sizeof(digest));
+
 #endif // !__DC__
 }
 
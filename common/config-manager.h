@@ -40,6 +40,7 @@ namespace Common {
  * @{
  */
 
+class FSNode;
 class WriteStream;
 class SeekableReadStream;
 
@@ -214,6 +215,7 @@ public:
 	DomainMap::iterator      endGameDomains() { return _gameDomains.end(); } /*!< Return the ending position of game domains. */
 
 	const String             &getCustomConfigFileName() { return _filename; } /*!< Return the custom config file being used, or an empty string when using the default config file */
+	FSNode                   getConfigDirectory(); /*!< Return the directory holding the config file, or an invalid node if it is not known. Caches can be kept there. */
 
 	static void              defragment(); /*!< Move the configuration in memory to reduce fragmentation. */
 	void                     copyFrom(ConfigManager &source); /*!< Copy from a ConfigManager instance. */
@@ -224,6 +226,7 @@ private:
 
 	bool            loadFallbackConfigFile(const String &filename);
 	bool			loadFromStream(SeekableReadStream &stream);
+	bool			loadFromBuffer(const char *buffer, uint32 size);
 	void			addDomain(const String &domainName, const Domain &domain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
@@ -248,6 +251,14 @@ private:
 	Domain *		_activeDomain;
 
 	String			_filename;
+
+	/**
+	 * Digest of the contents written by the last flushToDisk(), so flushes
+	 * that would write the same contents again can be skipped.
+	 */
+	bool			_hasFlushedDigest;
+	uint32			_flushedSize;
+	uint8			_flushedDigest[16];
 };
 
 /** @} */
@@ -148,6 +148,10 @@ public:
 
 	/**
 	 * Test whether the given debug channel is enabled.
+	 *
+	 * The enabled channels are kept in gDebugChannelsEnabled, so that
+	 * debugChannelActive() can test them without going through the
+	 * singleton.
 	 */
 	bool isDebugChannelEnabled(uint32 channel, bool enforce = false);
 
@@ -155,7 +159,6 @@ private:
 	typedef HashMap<String, DebugChannel, IgnoreCase_Hash, IgnoreCase_EqualTo> DebugChannelMap;
 
 	DebugChannelMap _debugChannels;
-	uint32 _debugChannelsEnabled;
 	uint32 _globalChannelsMask;
 
 	friend class Singleton<SingletonBaseType>;
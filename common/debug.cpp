@@ -30,6 +30,7 @@
 // TODO: Move gDebugLevel into namespace Common.
 int gDebugLevel = -1;
 bool gDebugChannelsOnly = false;
+uint32 gDebugChannelsEnabled = 0;
 
 const DebugChannelDef gDebugChannels[] = {
 	{ kDebugLevelEventRec,   "eventrec",  "Event recorder debug level" },
@@ -50,8 +51,8 @@ struct DebugLevelComperator {
 
 } // end of anonymous namespace
 
-DebugManager::DebugManager() :
-	_debugChannelsEnabled(0) {
+DebugManager::DebugManager() {
+	gDebugChannelsEnabled = 0;
 	addDebugChannels(gDebugChannels);
 
 	// Create global debug channels mask
@@ -88,19 +89,19 @@ void DebugManager::addAllDebugChannels(const DebugChannelDef *channels) {
 }
 
 void DebugManager::removeAllDebugChannels() {
-	uint32 globalChannels = _debugChannelsEnabled & _globalChannelsMask;
-	_debugChannelsEnabled = 0;
+	uint32 globalChannels = gDebugChannelsEnabled & _globalChannelsMask;
+	gDebugChannelsEnabled = 0;
 	_debugChannels.clear();
 	addDebugChannels(gDebugChannels);
 
-	_debugChannelsEnabled |= globalChannels;
+	gDebugChannelsEnabled |= globalChannels;
 }
 
 bool DebugManager::enableDebugChannel(const String &name) {
 	DebugChannelMap::iterator i = _debugChannels.find(name);
 
 	if (i != _debugChannels.end()) {
-		_debugChannelsEnabled |= i->_value.channel;
+		gDebugChannelsEnabled |= i->_value.channel;
 		i->_value.enabled = true;
 
 		return true;
@@ -110,7 +111,7 @@ bool DebugManager::enableDebugChannel(const String &name) {
 }
 
 bool DebugManager::enableDebugChannel(uint32 channel) {
-	_debugChannelsEnabled |= channel;
+	gDebugChannelsEnabled |= channel;
 	return true;
 }
 
@@ -118,7 +119,7 @@ bool DebugManager::disableDebugChannel(const String &name) {
 	DebugChannelMap::iterator i = _debugChannels.find(name);
 
 	if (i != _debugChannels.end()) {
-		_debugChannelsEnabled &= ~i->_value.channel;
+		gDebugChannelsEnabled &= ~i->_value.channel;
 		i->_value.enabled = false;
 
 		return true;
@@ -128,7 +129,7 @@ bool DebugManager::disableDebugChannel(const String &name) {
 }
 
 bool DebugManager::disableDebugChannel(uint32 channel) {
-	_debugChannelsEnabled &= ~channel;
+	gDebugChannelsEnabled &= ~channel;
 	return true;
 }
 
@@ -156,7 +157,7 @@ bool DebugManager::isDebugChannelEnabled(uint32 channel, bool enforce) {
 	if (gDebugLevel == 11 && enforce == false)
 		return true;
 	else
-		return (_debugChannelsEnabled & channel) != 0;
+		return (gDebugChannelsEnabled & channel) != 0;
 }
 
 void DebugManager::addDebugChannels(const DebugChannelDef *channels) {
@@ -171,14 +172,6 @@ bool debugLevelSet(int level) {
 	return level <= gDebugLevel;
 }
 
-bool debugChannelSet(int level, uint32 debugChannels) {
-	if (gDebugLevel != 11 || level == -1)
-		if ((level != -1 && level > gDebugLevel) || !(DebugMan.isDebugChannelEnabled(debugChannels, level == -1)))
-			return false;
-
-	return true;
-}
-
 
 #ifndef DISABLE_TEXT_CONSOLE
 
@@ -242,10 +235,8 @@ void debugN(int level, const char *s, ...) {
 void debugC(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelActive(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -255,10 +246,8 @@ void debugC(int level, uint32 debugChannels, const char *s, ...) {
 void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelActive(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
@@ -268,10 +257,8 @@ void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 void debugC(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelActive(debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -281,10 +268,8 @@ void debugC(uint32 debugChannels, const char *s, ...) {
 void debugCN(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugChannelActive(debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
@@ -133,14 +133,6 @@ void debugCN(uint32 debugChannels, MSVC_PRINTF const char *s, ...) GCC_PRINTF(2,
  */
 bool debugLevelSet(int level);
 
-/**
- * Check whether the debug level and channel are active.
- *
- * @param level         Debug level to check against. If set to -1, only channel check is active.
- * @param debugChannels Bitfield of channels to check against.
- * @see enableDebugChannel
- */
-bool debugChannelSet(int level, uint32 debugChannels);
 
 /**
  * The debug level. Initially set to -1, indicating that no debug output
@@ -159,6 +151,91 @@ extern int gDebugLevel;
  */
 extern bool gDebugChannelsOnly;
 
+/**
+ * Bitfield of the enabled debug channels, kept up to date by the
+ * DebugManager.
+ */
+extern uint32 gDebugChannelsEnabled;
+
+/**
+ * Check whether a debugC() call with the same arguments would print.
+ * This only reads gDebugLevel and gDebugChannelsEnabled and is cheap
+ * enough to be used in hot loops.
+ *
+ * @param level         Debug level that must be active.
+ * @param debugChannels Bitfield of channels to check against.
+ */
+inline bool debugChannelActive(int level, uint32 debugChannels) {
+	// Debug level 11 turns on all special debug level messages
+	return gDebugLevel == 11 || (level <= gDebugLevel && (gDebugChannelsEnabled & debugChannels) != 0);
+}
+
+/**
+ * Check whether a debugC() call without level would print.
+ *
+ * @param debugChannels Bitfield of channels to check against.
+ */
+inline bool debugChannelActive(uint32 debugChannels) {
+	return gDebugLevel == 11 || (gDebugChannelsEnabled & debugChannels) != 0;
+}
+
+/**
+ * Check whether the debug level and channel are active.
+ *
+ * @param level         Debug level to check against. If set to -1, only channel check is active.
+ * @param debugChannels Bitfield of channels to check against.
+ * @see enableDebugChannel
+ */
+inline bool debugChannelSet(int level, uint32 debugChannels) {
+	if (level == -1)
+		return (gDebugChannelsEnabled & debugChannels) != 0;
+
+	return debugChannelActive(level, debugChannels);
+}
+
+/**
+ * Debug messages with a level above this are removed at compile time
+ * by DEBUG_C() and DEBUG_CN(). Set with the --with-debug-max-level
+ * configure option; by default no level is removed.
+ */
+#ifdef SCUMMVM_DEBUG_MAX_LEVEL
+#define DEBUG_LEVEL_COMPILED(level) ((level) <= SCUMMVM_DEBUG_MAX_LEVEL)
+#else
+#define DEBUG_LEVEL_COMPILED(level) true
+#endif
+
+#ifdef DISABLE_TEXT_CONSOLE
+
+#define DEBUG_C(level, debugChannels, ...) do {} while (0)
+#define DEBUG_CN(level, debugChannels, ...) do {} while (0)
+
+#else
+
+/**
+ * Like debugC(level, debugChannels, ...), but the message arguments are
+ * only evaluated if the message is printed. Use this when formatting
+ * the arguments is expensive, or in hot loops. With a constant level
+ * above SCUMMVM_DEBUG_MAX_LEVEL the whole call is compiled out.
+ */
+#define DEBUG_C(level, debugChannels, ...) \
+	do { \
+		if (DEBUG_LEVEL_COMPILED(level) && debugChannelActive(level, debugChannels)) \
+			debugC(level, debugChannels, __VA_ARGS__); \
+	} while (0)
+
+/**
+ * Like debugCN(level, debugChannels, ...), but the message arguments are
+ * only evaluated if the message is printed.
+ * @see DEBUG_C
+ */
+#define DEBUG_CN(level, debugChannels, ...) \
+	do { \
+		if (DEBUG_LEVEL_COMPILED(level) && debugChannelActive(level, debugChannels)) \
+			debugCN(level, debugChannels, __VA_ARGS__); \
+	} while (0)
+
+#endif
+
 /** Global constant for EventRecorder debug channel. */
 enum GlobalDebugLevels {
 	kDebugGlobalDetection = 1 << 29,
@@ -506,6 +506,18 @@ public:
 	 */
 	virtual void purgeKeyboardEvents() = 0;
 
+	/**
+	 * Merge consecutive mouse motion events when they are polled, into a
+	 * single event with the latest position and the summed relative motion.
+	 * Events of other types, such as button presses, are never merged or
+	 * reordered.
+	 *
+	 * This is meant for engines which do not need every intermediate position
+	 * of the mouse, so that they are not flooded by high rate mice and touch
+	 * panels. It is also enabled by the "coalesce_mouse_motion" setting.
+	 */
+	virtual void setMouseMotionCoalescing(bool enable) {}
+
 	/** Return the current mouse position. */
 	virtual Point getMousePos() const = 0;
 
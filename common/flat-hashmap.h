@@ -0,0 +1,557 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The probing scheme and control byte layout of the flat hash map in this
+// file follow the "Swiss table" design used by Abseil and others.
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/hashmap.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flat_hashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on an open-addressing hash table with inline storage.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in replacement for HashMap<Key,Val> for
+ * lookup-heavy maps.
+ *
+ * Instead of an array of pointers to individually allocated nodes, the
+ * nodes are stored inline in a single power-of-two sized table. A separate
+ * array of control bytes holds, for each slot, either a marker for an empty
+ * or erased slot, or 7 bits of the hash of the key stored there. Lookups
+ * compare the control bytes of 8 slots at a time and only touch the nodes
+ * whose control bytes match, so most lookups read one cache line of control
+ * bytes and one node.
+ *
+ * The differences with HashMap are:
+ * - Nodes move when the table grows, so pointers and references to
+ *   values are invalidated by any insertion. Iterators are invalidated by
+ *   insertions too, but erasing an element does not invalidate iterators
+ *   to other elements.
+ * - Key and Val must be copy-constructible, as nodes are copied on rehash.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_GROUP_WIDTH = 8,
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// Grow when used and erased slots exceed 7/8 of the capacity.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	enum {
+		kCtrlEmpty = 0x80,
+		kCtrlDeleted = 0xFE
+		// Full slots hold the 7 high bits of the hash, so bit 7 is clear.
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	/**
+	 * Control bytes. There are _mask + 1 + FLATHASHMAP_GROUP_WIDTH of them;
+	 * the last group mirrors the first one so that a group can always be
+	 * loaded without wrapping around.
+	 */
+	byte *_ctrl;
+	Node *_slots;		///< Uninitialized storage for _mask + 1 nodes.
+	size_type _mask;	///< Capacity minus one; the capacity is a power of two.
+	size_type _size;
+	size_type _deleted;	///< Number of erased slots (tombstones).
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	static uint32 mixHash(size_type hash) {
+		// Some hash functions (e.g. for integers) are the identity, so
+		// spread the bits over the whole word before splitting the hash.
+		return (uint32)hash * 0x9E3779B1U;
+	}
+
+	static byte hashTag(uint32 hash) {
+		return hash >> 25;
+	}
+
+	static uint64 loadGroup(const byte *ctrl) {
+		uint64 group;
+		memcpy(&group, ctrl, sizeof(group));
+		return group;
+	}
+
+	/** Return true if any byte of @p group is equal to @p value. */
+	static bool groupHasByte(uint64 group, byte value) {
+		const uint64 lsbs = 0x0101010101010101ULL;
+		const uint64 x = group ^ (lsbs * value);
+		return ((x - lsbs) & ~x & (lsbs << 7)) != 0;
+	}
+
+	void setCtrl(size_type idx, byte value) {
+		_ctrl[idx] = value;
+		if (idx < FLATHASHMAP_GROUP_WIDTH)
+			_ctrl[_mask + 1 + idx] = value;
+	}
+
+	bool isFull(size_type idx) const {
+		return (_ctrl[idx] & 0x80) == 0;
+	}
+
+	void allocStorage(size_type capacity) {
+		_mask = capacity - 1;
+		_ctrl = new byte[capacity + FLATHASHMAP_GROUP_WIDTH];
+		memset(_ctrl, kCtrlEmpty, capacity + FLATHASHMAP_GROUP_WIDTH);
+		_slots = (Node *)malloc(capacity * sizeof(Node));
+		assert(_slots != nullptr);
+		_size = 0;
+		_deleted = 0;
+	}
+
+	void freeStorage() {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				_slots[ctr].~Node();
+		}
+		delete[] _ctrl;
+		free(_slots);
+	}
+
+	/** Find a free slot for a key with the given hash, which must not be present. */
+	size_type findFreeSlot(uint32 hash) const {
+		size_type pos = hash & _mask;
+		for (size_type step = FLATHASHMAP_GROUP_WIDTH; ; step += FLATHASHMAP_GROUP_WIDTH) {
+			for (size_type i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+				const size_type idx = (pos + i) & _mask;
+				if (!isFull(idx))
+					return idx;
+			}
+			pos = (pos + step) & _mask;
+		}
+	}
+
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isFull(_idx));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextFull(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	size_type nextFull(size_type idx) const {
+		for (; idx <= _mask; ++idx) {
+			if (isFull(idx))
+				return idx;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		freeStorage();
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	/** Make room for @p count elements without further rehashing. */
+	void reserve(size_type count);
+
+	size_type size() const { return _size; }
+
+	iterator begin() { return iterator(nextFull(0), this); }
+	iterator end() { return iterator((size_type)-1, this); }
+	const_iterator begin() const { return const_iterator(nextFull(0), this); }
+	const_iterator end() const { return const_iterator((size_type)-1, this); }
+
+	iterator find(const Key &key) {
+		size_type ctr = lookup(key);
+		return iterator(ctr, this);
+	}
+
+	const_iterator find(const Key &key) const {
+		size_type ctr = lookup(key);
+		return const_iterator(ctr, this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Same capacity and same hash function, so the layout can be cloned as is.
+	memcpy(_ctrl, map._ctrl, _mask + 1 + FLATHASHMAP_GROUP_WIDTH);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			new (&_slots[ctr]) Node(map._slots[ctr]);
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+		return;
+	}
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			_slots[ctr].~Node();
+	}
+	memset(_ctrl, kCtrlEmpty, _mask + 1 + FLATHASHMAP_GROUP_WIDTH);
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity >= FLATHASHMAP_MIN_CAPACITY && (newCapacity & (newCapacity - 1)) == 0);
+
+	const size_type oldMask = _mask;
+	const size_type oldSize = _size;
+	byte *oldCtrl = _ctrl;
+	Node *oldSlots = _slots;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (oldCtrl[ctr] & 0x80)
+			continue;
+
+		// No key exists twice in the old table, so there is no need to
+		// compare keys while inserting.
+		const uint32 hash = mixHash(_hash(oldSlots[ctr]._key));
+		const size_type idx = findFreeSlot(hash);
+		new (&_slots[idx]) Node(oldSlots[ctr]);
+		setCtrl(idx, hashTag(hash));
+		oldSlots[ctr].~Node();
+		_size++;
+	}
+
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == oldSize);
+	(void)oldSize;
+
+	delete[] oldCtrl;
+	free(oldSlots);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::reserve(size_type count) {
+	size_type capacity = _mask + 1;
+	while (count * FLATHASHMAP_LOADFACTOR_DENOMINATOR >= capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		capacity *= 2;
+	if (capacity != _mask + 1)
+		rehash(capacity);
+}
+
+/**
+ * Return the slot holding @p key, or (size_type)-1 if it is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint32 hash = mixHash(_hash(key));
+	const byte tag = hashTag(hash);
+	size_type pos = hash & _mask;
+
+	for (size_type step = FLATHASHMAP_GROUP_WIDTH; ; step += FLATHASHMAP_GROUP_WIDTH) {
+		const uint64 group = loadGroup(_ctrl + pos);
+
+		if (groupHasByte(group, tag)) {
+			for (size_type i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+				const size_type idx = (pos + i) & _mask;
+				if (_ctrl[idx] == tag && _equal(_slots[idx]._key, key))
+					return idx;
+			}
+		}
+
+		// A group with an empty slot ends the probe sequence.
+		if (groupHasByte(group, kCtrlEmpty))
+			return (size_type)-1;
+
+		pos = (pos + step) & _mask;
+
+		// Triangular probing visits every group once after this many steps.
+		if (step > _mask + 1)
+			return (size_type)-1;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep the load factor below a certain threshold. Erased slots are
+	// also counted, since they lengthen the probe sequences; rehashing at
+	// the same capacity is enough to get rid of them.
+	const size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if (_deleted > _size)
+			rehash(capacity);
+		else
+			rehash(capacity < 512 ? capacity * 4 : capacity * 2);
+	}
+
+	const uint32 hash = mixHash(_hash(key));
+	ctr = findFreeSlot(hash);
+	if (_ctrl[ctr] == kCtrlDeleted)
+		_deleted--;
+	new (&_slots[ctr]) Node(key);
+	setCtrl(ctr, hashTag(hash));
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// May rehash, so _slots must only be read afterwards.
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isFull(ctr));
+
+	_slots[ctr].~Node();
+	setCtrl(ctr, kCtrlDeleted);
+	_size--;
+	_deleted++;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr == (size_type)-1)
+		return;
+
+	_slots[ctr].~Node();
+	setCtrl(ctr, kCtrlDeleted);
+	_size--;
+	_deleted++;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
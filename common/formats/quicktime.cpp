@@ -133,6 +133,9 @@ void QuickTimeParser::init() {
 				_tracks[i]->editList[0].mediaTime = 0;
 				_tracks[i]->editList[0].mediaRate = 1;
 			}
+
+			if (_tracks[i]->codecType == CODEC_TYPE_VIDEO)
+				_tracks[i]->buildSampleIndex();
 		}
 	}
 }
@@ -880,4 +883,77 @@ QuickTimeParser::Track::~Track() {
 		delete sampleDescs[i];
 }
 
+void QuickTimeParser::Track::buildSampleIndex() {
+	sampleOffsets.clear();
+	sampleDescIds.clear();
+	sampleTimes.clear();
+
+	// Samples are stored in chunks, the sample to chunk table holds runs
+	// of chunks with the same number of samples
+	const uint32 maxSamples = sampleSize ? 0xFFFFFFFF : sampleCount;
+	if (sampleCount)
+		sampleOffsets.reserve(sampleCount);
+	uint32 sampleToChunkIndex = 0;
+
+	for (uint32 i = 0; i < chunkCount && sampleOffsets.size() < maxSamples; i++) {
+		if (sampleToChunkIndex < sampleToChunkCount && i >= sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		const SampleToChunkEntry &entry = sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = chunkOffsets[i];
+
+		for (uint32 j = 0; j < entry.count && sampleOffsets.size() < maxSamples; j++) {
+			const uint32 sample = sampleOffsets.size();
+			sampleOffsets.push_back(offset);
+			sampleDescIds.push_back(entry.id);
+			offset += sampleSize ? sampleSize : sampleSizes[sample];
+		}
+	}
+
+	sampleTimes.reserve(frameCount + 1);
+	uint32 time = 0;
+
+	for (int i = 0; i < timeToSampleCount; i++) {
+		for (int j = 0; j < timeToSample[i].count; j++) {
+			sampleTimes.push_back(time);
+			time += timeToSample[i].duration;
+		}
+	}
+
+	sampleTimes.push_back(time);
+}
+
+uint32 QuickTimeParser::Track::findSampleTime(uint32 mediaTime) const {
+	uint32 first = 0, last = sampleTimes.size();
+
+	while (first < last) {
+		const uint32 middle = first + (last - first) / 2;
+		if (sampleTimes[middle] < mediaTime)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	return first;
+}
+
+uint32 QuickTimeParser::Track::findKeyframe(uint32 sample) const {
+	// The keyframes are sorted, find the first one after the sample
+	uint32 first = 0, last = keyframeCount;
+
+	while (first < last) {
+		const uint32 middle = first + (last - first) / 2;
+		if (keyframes[middle] <= sample)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// If none found, we'll assume the requested sample is a keyframe
+	return first ? keyframes[first - 1] : sample;
+}
+
 } // End of namespace Video
@@ -174,6 +174,24 @@ protected:
 		uint32 mediaDuration; // media time
 		Rational scaleFactorX;
 		Rational scaleFactorY;
+
+		// The sample tables flattened to one entry per sample, so that
+		// looking up a sample does not scan the tables. Only built for
+		// video tracks, as audio tracks may have a sample per audio frame.
+		Array<uint32> sampleOffsets; // file offset, from stco/stsc/stsz
+		Array<uint32> sampleDescIds; // from stsc
+		Array<uint32> sampleTimes;   // media time, from stts, followed by the end of the last sample
+
+		void buildSampleIndex();
+
+		/**
+		 * Return the index of the first entry of sampleTimes which is not
+		 * before @p mediaTime, or the size of sampleTimes if there is none.
+		 */
+		uint32 findSampleTime(uint32 mediaTime) const;
+
+		/** Return the last keyframe at or before @p sample. */
+		uint32 findKeyframe(uint32 sample) const;
 	};
 
 	virtual SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) = 0;
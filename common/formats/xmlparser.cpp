@@ -79,6 +79,13 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (!_stream) {
+		// Replaying recorded keys, so there is no text to point to
+		Common::String errorMessage = Common::String::format("\n  File <%s>:\n\nParser error: %s\n\n", _fileName.c_str(), errStr.c_str());
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -352,6 +359,13 @@ bool XMLParser::parse() {
 						parserError("Unexpected end of file.");
 						break;
 					}
+					if (_recording) {
+						ParseEvent event;
+						event.type = ParseEvent::kText;
+						event.name = text;
+						event.header = event.closed = false;
+						_recording->push_back(event);
+					}
 					if (!textCallback(text)) {
 						parserError("Failed to process text segment.");
 						break;
@@ -412,6 +426,13 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_recording) {
+					ParseEvent event;
+					event.type = ParseEvent::kCloseKey;
+					event.header = event.closed = false;
+					_recording->push_back(event);
+				}
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -438,7 +459,20 @@ bool XMLParser::parse() {
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
-				} else if (parseActiveKey(selfClosure)) {
+					break;
+				}
+
+				if (_recording) {
+					ParseEvent event;
+					event.type = ParseEvent::kOpenKey;
+					event.name = _activeKey.top()->name;
+					event.values = _activeKey.top()->values;
+					event.header = _activeKey.top()->header;
+					event.closed = selfClosure;
+					_recording->push_back(event);
+				}
+
+				if (parseActiveKey(selfClosure)) {
 					_char = _stream->readByte();
 					_state = kParserNeedKey;
 				}
@@ -487,6 +521,63 @@ bool XMLParser::parse() {
 	return true;
 }
 
+bool XMLParser::replay(const ParseEventList &events, const String &fileName) {
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_fileName = fileName;
+	_state = kParserNeedKey;
+
+	for (ParseEventList::const_iterator i = events.begin(); i != events.end() && _state != kParserError; ++i) {
+		switch (i->type) {
+		case ParseEvent::kOpenKey: {
+			ParserNode *node = allocNode();
+			node->name = i->name;
+			node->values = i->values;
+			node->ignore = false;
+			node->header = i->header;
+			node->depth = _activeKey.size();
+			node->layout = nullptr;
+			_activeKey.push(node);
+
+			parseActiveKey(i->closed);
+			break;
+		}
+
+		case ParseEvent::kCloseKey:
+			if (_activeKey.empty()) {
+				parserError("Unexpected closure.");
+			} else {
+				const String name = _activeKey.top()->name;
+				if (!closeKey())
+					parserError("Missing data when closing key '" + name + "'.");
+			}
+			break;
+
+		case ParseEvent::kText:
+			if (!textCallback(i->name))
+				parserError("Failed to process text segment.");
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	if (_state == kParserError)
+		return false;
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of file.");
+
+	return true;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
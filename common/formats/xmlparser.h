@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/types.h"
 
+#include "common/array.h"
 #include "common/fs.h"
 #include "common/list.h"
 #include "common/hashmap.h"
@@ -100,7 +101,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0), _recording(nullptr) {}
 
 	virtual ~XMLParser();
 
@@ -195,6 +196,43 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * A key or text segment met while parsing, in the order the callbacks
+	 * were called for them.
+	 */
+	struct ParseEvent {
+		enum Type {
+			kOpenKey,  ///< A key with its properties, which is closed right away if closed is set
+			kCloseKey, ///< The closure of the innermost open key
+			kText      ///< A text node, stored in name
+		};
+
+		Type type;
+		String name;
+		StringMap values;
+		bool header;
+		bool closed;
+	};
+
+	typedef Array<ParseEvent> ParseEventList;
+
+	/**
+	 * Record the keys of the following parse() calls into @p events, so
+	 * they can be passed to replay() later on. Pass nullptr to stop.
+	 */
+	void setRecording(ParseEventList *events) {
+		_recording = events;
+	}
+
+	/**
+	 * Parse the keys recorded in an earlier parse() call again, calling the
+	 * same callbacks without having to load and tokenize the file.
+	 *
+	 * @param events   Keys recorded from a successful parse() call.
+	 * @param fileName Name of the originally parsed file, for error messages.
+	 */
+	bool replay(const ParseEventList &events, const String &fileName);
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -384,6 +422,8 @@ private:
 	String _error; /** Current error message */
 	String _token; /** Current text token */
 
+	ParseEventList *_recording; /** Where parsed keys are recorded, if anywhere */
+
 	Stack<ParserNode *> _activeKey; /** Node stack of the parsed keys */
 };
 
@@ -20,6 +20,7 @@
  */
 
 #include "common/system.h"
+#include "common/memstream.h"
 #include "common/punycode.h"
 #include "common/textconsole.h"
 #include "backends/fs/abstract-fs.h"
@@ -146,6 +147,53 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+MemoryReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	MemoryReadStream *mapped = _realNode->createMappedReadStream();
+	if (mapped)
+		return mapped;
+
+	// No mapping support, read the whole file instead
+	SeekableReadStream *file = _realNode->createReadStream();
+	if (!file)
+		return nullptr;
+
+	const int64 size = file->size();
+	if (size < 0 || size > 0xFFFFFFFF) {
+		warning("FSNode::createMappedReadStream: '%s' is too large", getName().c_str());
+		delete file;
+		return nullptr;
+	}
+
+	byte *data = (byte *)malloc(size ? size : 1);
+	if (!data || file->read(data, size) != size) {
+		warning("FSNode::createMappedReadStream: Failed to read '%s'", getName().c_str());
+		free(data);
+		delete file;
+		return nullptr;
+	}
+	delete file;
+
+	return new MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+bool FSNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	if (_realNode == nullptr)
+		return false;
+
+	return _realNode->getFileStats(size, modificationTime);
+}
+
 SeekableWriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
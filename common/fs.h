@@ -45,6 +45,7 @@ namespace Common {
 
 class FSNode;
 class FSDirectory;
+class MemoryReadStream;
 class SeekableReadStream;
 class WriteStream;
 class SeekableWriteStream;
@@ -235,6 +236,29 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Create a MemoryReadStream giving direct access to the contents of
+	 * the file referred by this node, through MemoryReadStream::getData().
+	 *
+	 * Where the backend supports it, the stream is backed by a read-only
+	 * memory mapping of the file, so no data is copied and pages are only
+	 * loaded when accessed. Otherwise the whole file is read into memory.
+	 * Either way the data stays valid until the stream is deleted.
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	MemoryReadStream *createMappedReadStream() const;
+
+	/**
+	 * Get the size of the file referred by this node and the time it was
+	 * last modified, without opening it. The modification time is only
+	 * meant to be compared with an earlier one of the same file.
+	 *
+	 * @return True if the node is a file and the backend could tell,
+	 *         false otherwise.
+	 */
+	bool getFileStats(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -25,7 +25,6 @@
 #define COMMON_HUFFMAN_H
 
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -72,31 +71,90 @@ public:
 	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
-	struct Symbol {
-		uint32 code;
+	/**
+	 * Entry in one of the lookup tables.
+	 *
+	 * If subBits is non-zero, the entry does not describe a code but points to
+	 * a second-level table of 1 << subBits entries starting at _subTables[symbol],
+	 * indexed by the bits following the first-level prefix.
+	 */
+	struct PrefixEntry {
 		uint32 symbol;
+		uint8  length;
+		uint8  subBits;
 
-		Symbol(uint32 c, uint32 s) : code(c), symbol(s) {}
+		PrefixEntry() : symbol(0), length(0xFF), subBits(0) {}
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
+	/** Maximal width of the first-level lookup table. */
+	static const uint8 kMaxPrefixTableBits = 12;
+	/** Minimal width of the first-level lookup table for trees with long codes. */
+	static const uint8 kMinPrefixTableBits = 8;
 
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	static uint8 choosePrefixTableBits(uint8 maxLength, uint32 codeCount, const uint8 *lengths);
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
-	struct PrefixEntry {
-		uint32 symbol;
-		uint8  length;
+	/** Index of the bit stream value @p code, @p length bits long, in a table of 1 << @p bits entries. */
+	static uint32 tableIndex(uint32 code, uint8 length, uint8 bits) {
+		return BITSTREAM::isMSB2LSB() ? code << (bits - length) : code;
+	}
 
-		PrefixEntry() : length(0xFF) {}
-	};
+	/** Step between the table entries sharing a code of the given length. */
+	static uint32 tableStep(uint8 length) {
+		return BITSTREAM::isMSB2LSB() ? 1 : (1 << length);
+	}
 
-	static const uint8 _prefixTableBits = 8;
-	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	static void fillTable(PrefixEntry *table, uint8 bits, uint32 code, uint8 codeLength, uint8 length, uint32 symbol);
+
+	/** Width of the first-level lookup table, chosen per tree from the code lengths. */
+	uint8 _prefixTableBits;
+
+	/** First-level lookup table, indexed by the next _prefixTableBits bits. */
+	Array<PrefixEntry> _prefixTable;
+	/** Second-level lookup tables for the codes longer than _prefixTableBits. */
+	Array<PrefixEntry> _subTables;
 };
 
+template <class BITSTREAM>
+uint8 Huffman<BITSTREAM>::choosePrefixTableBits(uint8 maxLength, uint32 codeCount, const uint8 *lengths) {
+	if (maxLength <= kMinPrefixTableBits)
+		return MAX<uint8>(maxLength, 1);
+
+	// Use the narrowest table (to keep it in the cache) that still resolves all but
+	// 1/64 of the code space, i.e. of the expected symbols, in one lookup.
+	const uint8 maxBits = MIN<uint8>(maxLength, kMaxPrefixTableBits);
+
+	uint64 histogram[33];
+	for (uint i = 0; i <= 32; i++)
+		histogram[i] = 0;
+	for (uint32 i = 0; i < codeCount; i++)
+		histogram[lengths[i]] += (uint64)1 << (32 - lengths[i]);
+
+	for (uint8 bits = kMinPrefixTableBits; bits < maxBits; bits++) {
+		uint64 longMass = 0;
+		for (uint8 length = bits + 1; length <= maxLength; length++)
+			longMass += histogram[length];
+
+		if (longMass <= ((uint64)1 << 26))
+			return bits;
+	}
+
+	return maxBits;
+}
+
+template <class BITSTREAM>
+void Huffman<BITSTREAM>::fillTable(PrefixEntry *table, uint8 bits, uint32 code, uint8 codeLength, uint8 length, uint32 symbol) {
+	// Set all the entries in the table with an index starting with the code to the symbol value
+	const uint32 start = tableIndex(code, codeLength, bits);
+	const uint32 step  = tableStep(codeLength);
+	const uint32 count = 1 << (bits - codeLength);
+
+	for (uint32 j = 0; j < count; j++) {
+		PrefixEntry &entry = table[start + j * step];
+		entry.symbol = symbol;
+		entry.length = length;
+	}
+}
+
 template <class BITSTREAM>
 Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
 	assert(codeCount > 0);
@@ -110,62 +168,81 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that do not fit in the prefix table are stored in the _codes array.
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
+	_prefixTableBits = choosePrefixTableBits(maxLength, codeCount, lengths);
+	_prefixTable.resize(1 << _prefixTableBits);
+
+	const uint32 prefixMask = (1 << _prefixTableBits) - 1;
+
+	// Codes that do not fit in the first-level table are split into a prefix, selecting
+	// a second-level table, and the remaining bits. First find how many bits each
+	// second-level table needs to hold the longest code sharing its prefix.
+	for (uint32 i = 0; i < codeCount; i++) {
+		const uint8 length = lengths[i];
+		if (length <= _prefixTableBits)
+			continue;
+
+		const uint32 prefix = BITSTREAM::isMSB2LSB() ? (codes[i] >> (length - _prefixTableBits)) : (codes[i] & prefixMask);
+
+		PrefixEntry &entry = _prefixTable[tableIndex(prefix, _prefixTableBits, _prefixTableBits)];
+		entry.subBits = MAX<uint8>(entry.subBits, length - _prefixTableBits);
+	}
+
+	uint32 subTablesSize = 0;
+	for (uint32 i = 0; i < _prefixTable.size(); i++) {
+		PrefixEntry &entry = _prefixTable[i];
+		if (entry.subBits) {
+			entry.symbol = subTablesSize;
+			subTablesSize += 1 << entry.subBits;
+		}
+	}
 
-	for (uint i = 0; i < codeCount; i++) {
-		uint8 length = lengths[i];
+	_subTables.resize(subTablesSize);
+
+	for (uint32 i = 0; i < codeCount; i++) {
+		const uint8 length = lengths[i];
 
 		// The symbol. If none was specified, assume it is identical to the code index.
-		uint32 symbol = symbols ? symbols[i] : i;
+		const uint32 symbol = symbols ? symbols[i] : i;
 
 		if (length <= _prefixTableBits) {
-			// Short codes go in the prefix lookup table. Set all the entries in the table
-			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
-
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
-
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
-			}
+			fillTable(_prefixTable.data(), _prefixTableBits, codes[i], length, length, symbol);
+			continue;
+		}
+
+		const uint8 restLength = length - _prefixTableBits;
+
+		uint32 prefix, rest;
+		if (BITSTREAM::isMSB2LSB()) {
+			prefix = codes[i] >> restLength;
+			rest   = codes[i] & ((1 << restLength) - 1);
 		} else {
-			// Put the code and symbol into the correct list for the length.
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
+			prefix = codes[i] & prefixMask;
+			rest   = codes[i] >> _prefixTableBits;
 		}
+
+		// The second-level entries hold the length of the whole code
+		const PrefixEntry &entry = _prefixTable[tableIndex(prefix, _prefixTableBits, _prefixTableBits)];
+		fillTable(&_subTables[entry.symbol], entry.subBits, rest, restLength, length, symbol);
 	}
 }
 
 template <class BITSTREAM>
 uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
-	uint32 code = bits.peekBits(_prefixTableBits);
+	const PrefixEntry *entry = &_prefixTable[bits.peekBits(_prefixTableBits)];
 
-	uint8 length = _prefixTable[code].length;
+	if (entry->subBits) {
+		const uint8 subBits = entry->subBits;
+		const uint32 code = bits.peekBits(_prefixTableBits + subBits);
+		const uint32 index = BITSTREAM::isMSB2LSB() ? (code & ((1 << subBits) - 1)) : (code >> _prefixTableBits);
 
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
-	} else {
-		bits.skip(_prefixTableBits);
-
-		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
-
-			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
-		}
+		entry = &_subTables[entry->symbol + index];
 	}
 
-	error("Unknown Huffman code");
-	return 0;
+	if (entry->length == 0xFF)
+		error("Unknown Huffman code");
+
+	bits.skip(entry->length);
+	return entry->symbol;
 }
 
 /** @} */
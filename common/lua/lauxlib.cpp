@@ -22,6 +22,7 @@
 #include "lua.h"
 
 #include "lauxlib.h"
+#include "lua_heap.h"
 #include "scummvm_file.h"
 #include "common/textconsole.h"
 
@@ -630,18 +631,6 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s) {
 /* }====================================================== */
 
 
-static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
-  (void)ud;
-  (void)osize;
-  if (nsize == 0) {
-    free(ptr);
-    return NULL;
-  }
-  else
-    return realloc(ptr, nsize);
-}
-
-
 static int panic (lua_State *L) {
   (void)L;  /* to avoid warnings */
   warning("PANIC: unprotected error in call to Lua API (%s)\n",
@@ -651,7 +640,7 @@ static int panic (lua_State *L) {
 
 
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  lua_State *L = Lua::LuaHeap::newState();
   if (L) lua_atpanic(L, &panic);
   return L;
 }
@@ -19,6 +19,9 @@
 #include "lstring.h"
 #include "ltable.h"
 #include "ltm.h"
+#include "lua_heap.h"
+
+#include "common/profiler.h"
 
 
 #define GCSTEPSIZE	1024u
@@ -606,6 +609,8 @@ static l_mem singlestep (lua_State *L) {
 
 
 void luaC_step (lua_State *L) {
+  PROFILE_ZONE("Lua GC step");
+  Lua::LuaCollectionTimer timer(L, false);
   global_State *g = G(L);
   l_mem lim = (GCSTEPSIZE/100) * g->gcstepmul;
   if (lim == 0)
@@ -632,6 +637,8 @@ void luaC_step (lua_State *L) {
 
 
 void luaC_fullgc (lua_State *L) {
+  PROFILE_ZONE("Lua full GC");
+  Lua::LuaCollectionTimer timer(L, true);
   global_State *g = G(L);
   if (g->gcstate <= GCSpropagate) {
     /* reset sweep marks to sweep all elements (returning them to white) */
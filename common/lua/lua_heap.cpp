@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "lua_heap.h"
+
+#include "lua.h"
+#include "lgc.h"
+#include "lstate.h"
+
+#include "common/memorypool.h"
+#include "common/memtag.h"
+#include "common/system.h"
+
+namespace Lua {
+
+LuaHeap::LuaHeap() {
+	memset(&_stats, 0, sizeof(_stats));
+
+	Common::MemTag tag(Common::kMemTagScripts);
+	for (uint i = 0; i < kPoolCount; ++i) {
+		_pools[i] = new Common::MemoryPool((i + 1) * kGranularity);
+	}
+}
+
+LuaHeap::~LuaHeap() {
+	for (uint i = 0; i < kPoolCount; ++i) {
+		delete _pools[i];
+	}
+}
+
+lua_State *LuaHeap::newState() {
+	LuaHeap *heap = new LuaHeap();
+	lua_State *L = lua_newstate(&alloc, heap);
+	if (!L) {
+		delete heap;
+	}
+	return L;
+}
+
+LuaHeap *LuaHeap::fromState(lua_State *L) {
+	void *ud;
+	if (lua_getallocf(L, &ud) != &alloc) {
+		return nullptr;
+	}
+	return (LuaHeap *)ud;
+}
+
+void *LuaHeap::allocBlock(size_t size) {
+	if (size > kMaxPooledSize) {
+		void *ptr = malloc(size);
+		if (ptr) {
+			Common::memTagAllocated(Common::kMemTagScripts, size);
+		}
+		return ptr;
+	}
+	return _pools[getPoolIndex(size)]->allocChunk();
+}
+
+void LuaHeap::freeBlock(void *ptr, size_t size) {
+	if (size > kMaxPooledSize) {
+		Common::memTagFreed(Common::kMemTagScripts, size);
+		free(ptr);
+	} else {
+		_pools[getPoolIndex(size)]->freeChunk(ptr);
+	}
+}
+
+void *LuaHeap::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	LuaHeap *heap = (LuaHeap *)ud;
+
+	// Lua passes the size a block was allocated with whenever it frees or
+	// resizes it, which tells the pool it came from. It also frees empty
+	// arrays, which were never allocated.
+	if (!ptr) {
+		osize = 0;
+		if (nsize == 0) {
+			return nullptr;
+		}
+	}
+
+	void *result = nullptr;
+	if (nsize == 0) {
+		heap->freeBlock(ptr, osize);
+	} else if (osize == 0) {
+		result = heap->allocBlock(nsize);
+	} else if (osize > kMaxPooledSize && nsize > kMaxPooledSize) {
+		result = realloc(ptr, nsize);
+		if (result) {
+			Common::memTagFreed(Common::kMemTagScripts, osize);
+			Common::memTagAllocated(Common::kMemTagScripts, nsize);
+		}
+	} else if (osize <= kMaxPooledSize && nsize <= kMaxPooledSize && getPoolIndex(osize) == getPoolIndex(nsize)) {
+		result = ptr;
+	} else {
+		result = heap->allocBlock(nsize);
+		if (result) {
+			memcpy(result, ptr, MIN(osize, nsize));
+			heap->freeBlock(ptr, osize);
+		}
+	}
+
+	// On failure the old block stays valid, and Lua raises a memory error
+	if (nsize != 0 && !result) {
+		return nullptr;
+	}
+
+	heap->_stats.bytesInUse = heap->_stats.bytesInUse - osize + nsize;
+	heap->_stats.peakBytes = MAX(heap->_stats.peakBytes, heap->_stats.bytesInUse);
+
+	// The state itself is the first block Lua allocates and the last one
+	// lua_close() frees, which makes that the end of the heap as well
+	if (heap->_stats.bytesInUse == 0) {
+		delete heap;
+	}
+
+	return result;
+}
+
+bool LuaHeap::collectWithTimeBudget(lua_State *L, uint32 budgetMicros) {
+	// Don't start cycles early, only help to finish them
+	const global_State *g = G(L);
+	if (g->gcstate == GCSpause) {
+		return false;
+	}
+
+	const uint64 start = g_system->getMicros();
+	do {
+		if (lua_gc(L, LUA_GCSTEP, 0)) {
+			return true;
+		}
+	} while (g_system->getMicros() - start < budgetMicros);
+	return false;
+}
+
+bool LuaHeap::collectWithWorkBudget(lua_State *L, int kilobytes) {
+	return lua_gc(L, LUA_GCSTEP, kilobytes) != 0;
+}
+
+void LuaHeap::recordCollection(bool full, uint32 micros) {
+	if (full) {
+		++_stats.fullCollections;
+	} else {
+		++_stats.gcSteps;
+	}
+	_stats.gcMicros += micros;
+	_stats.maxPauseMicros = MAX(_stats.maxPauseMicros, micros);
+}
+
+LuaCollectionTimer::LuaCollectionTimer(lua_State *L, bool full) :
+	_heap(LuaHeap::fromState(L)),
+	_full(full),
+	_start(0) {
+	if (_heap) {
+		_start = g_system->getMicros();
+	}
+}
+
+LuaCollectionTimer::~LuaCollectionTimer() {
+	if (!_heap) {
+		return;
+	}
+
+	_heap->recordCollection(_full, (uint32)(g_system->getMicros() - _start));
+}
+
+} // End of namespace Lua
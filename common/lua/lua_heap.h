@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LUA_HEAP_H
+#define LUA_HEAP_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+class MemoryPool;
+}
+
+struct lua_State;
+
+namespace Lua {
+
+/**
+ * The allocator of the Lua states created by luaL_newstate(). Blocks of up
+ * to kMaxPooledSize bytes, which are most tables, strings and closures, are
+ * served from memory pools of a few size classes instead of the C heap.
+ * The whole heap is accounted to Common::kMemTagScripts.
+ *
+ * Every state has its own heap, which also counts the time the collector
+ * spends in the state. Engines can give the collector a budget per frame
+ * with collectWithTimeBudget() or collectWithWorkBudget(), so that it keeps
+ * up with the scripts in small steps rather than long pauses.
+ */
+class LuaHeap {
+public:
+	struct Stats {
+		uint64 bytesInUse;      ///< Bytes currently allocated by the state
+		uint64 peakBytes;       ///< Highest bytesInUse so far
+		uint32 gcSteps;         ///< Incremental collection steps, automatic or budgeted
+		uint32 fullCollections; ///< Full collections, e.g. through lua_gc(LUA_GCCOLLECT)
+		uint64 gcMicros;        ///< Time spent in all collections
+		uint32 maxPauseMicros;  ///< Longest single step or full collection
+	};
+
+	/** Create a Lua state using a new heap. Returns nullptr on failure. */
+	static lua_State *newState();
+
+	/** Return the heap of @p L, or nullptr if it uses another allocator. */
+	static LuaHeap *fromState(lua_State *L);
+
+	/** The lua_Alloc function of the heap passed as @p ud. */
+	static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+	/**
+	 * Run incremental collection steps until @p budgetMicros have passed or
+	 * the current cycle is finished. Does nothing while the collector waits
+	 * for the heap to grow enough to start the next cycle. Returns true if
+	 * a cycle was finished.
+	 */
+	static bool collectWithTimeBudget(lua_State *L, uint32 budgetMicros);
+
+	/**
+	 * Run incremental collection steps worth @p kilobytes of allocations,
+	 * like lua_gc(LUA_GCSTEP). Returns true if a cycle was finished.
+	 */
+	static bool collectWithWorkBudget(lua_State *L, int kilobytes);
+
+	/** Called by the collector after a step or full collection. */
+	void recordCollection(bool full, uint32 micros);
+
+	const Stats &getStats() const { return _stats; }
+
+private:
+	enum {
+		kGranularity = 16,
+		kMaxPooledSize = 256,
+		kPoolCount = kMaxPooledSize / kGranularity
+	};
+
+	LuaHeap();
+	~LuaHeap();
+
+	static uint getPoolIndex(size_t size) { return (size - 1) / kGranularity; }
+
+	void *allocBlock(size_t size);
+	void freeBlock(void *ptr, size_t size);
+
+	Common::MemoryPool *_pools[kPoolCount];
+	Stats _stats;
+};
+
+/**
+ * Measures a collection and adds it to the statistics of the LuaHeap of the
+ * state, if it has one.
+ */
+class LuaCollectionTimer {
+public:
+	LuaCollectionTimer(lua_State *L, bool full);
+	~LuaCollectionTimer();
+
+private:
+	LuaHeap *_heap;
+	bool _full;
+	uint64 _start;
+};
+
+} // End of namespace Lua
+
+#endif
@@ -28,6 +28,7 @@ MODULE_OBJS := \
 	ltable.o \
 	ltablib.o \
 	ltm.o \
+	lua_heap.o \
 	lua_persist.o \
 	lua_persistence_util.o \
 	lua_unpersist.o \
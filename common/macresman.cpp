@@ -27,6 +27,7 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 #include "common/textconsole.h"
 #include "common/archive.h"
@@ -121,18 +122,49 @@ void MacResManager::close() {
 	_resForkOffset = -1;
 	_mode = kResForkNone;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		for (int j = 0; j < _resTypes[i].items; j++)
-			if (_resLists[i][j].nameOffset != -1)
-				delete[] _resLists[i][j].name;
+	_map.reset();
+	_resLists = nullptr;
+	_resTypes = nullptr;
+	delete _stream; _stream = nullptr;
+	_resMap.numTypes = 0;
+}
+
+MacResManager::ResourceMap::~ResourceMap() {
+	for (int i = 0; i < header.numTypes; i++) {
+		for (int j = 0; j < types[i].items; j++)
+			if (lists[i][j].nameOffset != -1)
+				delete[] lists[i][j].name;
 
-		delete[] _resLists[i];
+		delete[] lists[i];
 	}
 
-	delete[] _resLists; _resLists = nullptr;
-	delete[] _resTypes; _resTypes = nullptr;
-	delete _stream; _stream = nullptr;
-	_resMap.numTypes = 0;
+	delete[] lists;
+	delete[] types;
+}
+
+namespace {
+
+enum {
+	kMaxCachedResourceMaps = 64
+};
+
+} // End of anonymous namespace
+
+MacResManager::MapCache *MacResManager::_mapCache = nullptr;
+
+void MacResManager::clearMapCache() {
+	if (!_mapCache)
+		return;
+
+	for (MapCache::iterator i = _mapCache->begin(); i != _mapCache->end(); ++i) {
+		if (i->_value.unique())
+			_mapCache->erase(i);
+	}
+
+	if (_mapCache->empty()) {
+		delete _mapCache;
+		_mapCache = nullptr;
+	}
 }
 
 bool MacResManager::hasResFork() const {
@@ -903,68 +935,120 @@ SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &file
 }
 
 void MacResManager::readMap() {
-	_stream->seek(_mapOffset + 22);
+	// Read the whole map block in one go, it spans from the map offset to
+	// the end of the fork. This avoids lots of small seeks on the fork.
+	int64 mapEnd = MIN<int64>((int64)_resForkOffset + _resForkSize, _stream->size());
+	if (mapEnd < (int64)_mapOffset + 30)
+		mapEnd = _stream->size();
+
+	Array<byte> raw;
+	raw.resize(mapEnd - _mapOffset);
+	_stream->seek(_mapOffset);
+	_stream->read(raw.data(), raw.size());
+
+	const uint32 crc = CRC32().crcFast(raw.data(), raw.size());
+
+	if (_mapCache) {
+		MapCache::const_iterator cached = _mapCache->find(crc);
+		if (cached != _mapCache->end() && cached->_value->raw == raw)
+			_map = cached->_value;
+	}
+
+	if (!_map) {
+		_map = parseMap(raw.data(), raw.size(), _stream->size());
+
+		if (_mapCache && _mapCache->size() >= kMaxCachedResourceMaps)
+			clearMapCache();
+		if (!_mapCache)
+			_mapCache = new MapCache();
+
+		// A colliding map simply is not cached
+		if (_mapCache->size() < kMaxCachedResourceMaps && !_mapCache->contains(crc)) {
+			_map->raw.swap(raw);
+			(*_mapCache)[crc] = _map;
+		}
+	}
+
+	_resMap = _map->header;
+	_resTypes = _map->types;
+	_resLists = _map->lists;
+}
 
-	_resMap.resAttr = _stream->readUint16BE();
-	_resMap.typeOffset = _stream->readUint16BE();
-	_resMap.nameOffset = _stream->readUint16BE();
-	_resMap.numTypes = _stream->readUint16BE();
-	_resMap.numTypes++;
+SharedPtr<MacResManager::ResourceMap> MacResManager::parseMap(const byte *data, uint32 size, int64 streamSize) {
+	MemoryReadStream stream(data, size);
+	SharedPtr<ResourceMap> map(new ResourceMap());
+	ResMap &resMap = map->header;
 
-	_stream->seek(_mapOffset + _resMap.typeOffset + 2);
-	_resTypes = new ResType[_resMap.numTypes];
+	stream.seek(22);
 
-	debug(8, "numResTypes: %d total size: %u", _resMap.numTypes, unsigned(_stream->size()));
+	resMap.resAttr = stream.readUint16BE();
+	resMap.typeOffset = stream.readUint16BE();
+	resMap.nameOffset = stream.readUint16BE();
+	uint16 numTypes = stream.readUint16BE() + 1;
 
-	if (_stream->pos() + _resMap.numTypes * 8 > _stream->size())
-		error("MacResManager::readMap(): incorrect resource map, too big, %d types", _resMap.numTypes);
+	stream.seek(resMap.typeOffset + 2);
 
+	debug(8, "numResTypes: %d total size: %u", numTypes, unsigned(streamSize));
+
+	if (stream.pos() + numTypes * 8 > stream.size())
+		error("MacResManager::readMap(): incorrect resource map, too big, %d types", numTypes);
+
+	map->types = new ResType[numTypes];
 	int totalItems = 0;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resTypes[i].id = _stream->readUint32BE();
-		_resTypes[i].items = _stream->readUint16BE();
-		_resTypes[i].offset = _stream->readUint16BE();
-		_resTypes[i].items++;
+	for (int i = 0; i < numTypes; i++) {
+		ResType &type = map->types[i];
+		type.id = stream.readUint32BE();
+		type.items = stream.readUint16BE();
+		type.offset = stream.readUint16BE();
+		type.items++;
 
-		totalItems += _resTypes[i].items;
+		totalItems += type.items;
 
-		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(_resTypes[i].id), _resTypes[i].items,  _resTypes[i].offset, _resTypes[i].offset);
+		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(type.id), type.items, type.offset, type.offset);
 	}
 
-	if (totalItems * 4 > _stream->size())
+	if (totalItems * 4 > streamSize) {
+		delete[] map->types;
+		map->types = nullptr;
 		error("MacResManager::readMap(): incorrect resource map, too big, %d total items", totalItems);
+	}
 
-	_resLists = new ResPtr[_resMap.numTypes];
+	// Only set the number of types once the lists exist, for the destructor
+	map->lists = new ResPtr[numTypes];
+	resMap.numTypes = numTypes;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resLists[i] = new Resource[_resTypes[i].items];
-		_stream->seek(_resTypes[i].offset + _mapOffset + _resMap.typeOffset);
+	for (int i = 0; i < numTypes; i++) {
+		const ResType &type = map->types[i];
+		ResPtr list = map->lists[i] = new Resource[type.items];
+		stream.seek(type.offset + resMap.typeOffset);
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			ResPtr resPtr = _resLists[i] + j;
+		for (int j = 0; j < type.items; j++) {
+			ResPtr resPtr = list + j;
 
-			resPtr->id = _stream->readUint16BE();
-			resPtr->nameOffset = _stream->readUint16BE();
-			resPtr->dataOffset = _stream->readUint32BE();
-			_stream->readUint32BE();
+			resPtr->id = stream.readUint16BE();
+			resPtr->nameOffset = stream.readUint16BE();
+			resPtr->dataOffset = stream.readUint32BE();
+			stream.readUint32BE();
 			resPtr->name = nullptr;
 
 			resPtr->attr = resPtr->dataOffset >> 24;
 			resPtr->dataOffset &= 0xFFFFFF;
 		}
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1) {
-				_stream->seek(_resLists[i][j].nameOffset + _mapOffset + _resMap.nameOffset);
+		for (int j = 0; j < type.items; j++) {
+			if (list[j].nameOffset != -1) {
+				stream.seek(list[j].nameOffset + resMap.nameOffset);
 
-				byte len = _stream->readByte();
-				_resLists[i][j].name = new char[len + 1];
-				_resLists[i][j].name[len] = 0;
-				_stream->read(_resLists[i][j].name, len);
+				byte len = stream.readByte();
+				list[j].name = new char[len + 1];
+				list[j].name[len] = 0;
+				stream.read(list[j].name, len);
 			}
 		}
 	}
+
+	return map;
 }
 
 Path MacResManager::constructAppleDoubleName(Path name) {
@@ -26,6 +26,8 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 #include "common/str.h"
 #include "common/str-array.h"
@@ -200,6 +202,15 @@ public:
 	 */
 	void close();
 
+	/**
+	 * Drop the resource maps shared between MacResManager instances that
+	 * are not in use anymore.
+	 *
+	 * Parsed resource maps are cached for the whole session, keyed by
+	 * their contents, so reopening the same fork only reads its map block.
+	 */
+	static void clearMapCache();
+
 	/**
 	 * Query whether or not we have a data fork present.
 	 * @return True if the resource fork is present
@@ -374,6 +385,31 @@ private:
 
 	typedef Resource *ResPtr;
 
+	/**
+	 * A parsed resource map, shared by all the instances which opened a
+	 * fork with an identical map block.
+	 */
+	struct ResourceMap {
+		Array<byte> raw;
+		ResMap header;
+		ResType *types;
+		ResPtr *lists;
+
+		ResourceMap() : types(nullptr), lists(nullptr) {}
+		~ResourceMap();
+	};
+
+	static SharedPtr<ResourceMap> parseMap(const byte *data, uint32 size, int64 streamSize);
+
+	/**
+	 * Maps the CRC-32 of a map block to its parsed form. Hits are checked
+	 * against the raw map block.
+	 */
+	typedef HashMap<uint32, SharedPtr<ResourceMap> > MapCache;
+	static MapCache *_mapCache;
+
+	SharedPtr<ResourceMap> _map;
+
 	int32 _resForkOffset;
 	uint32 _resForkSize;
 
@@ -382,8 +418,8 @@ private:
 	uint32 _mapOffset;
 	uint32 _mapLength;
 	ResMap _resMap;
-	ResType *_resTypes;
-	ResPtr  *_resLists;
+	ResType *_resTypes; ///< Owned by _map
+	ResPtr  *_resLists; ///< Owned by _map
 };
 
 /** @} */
@@ -40,7 +40,7 @@ static size_t adjustChunkSize(size_t chunkSize) {
 
 
 MemoryPool::MemoryPool(size_t chunkSize)
-	: _chunkSize(adjustChunkSize(chunkSize)) {
+	: _chunkSize(adjustChunkSize(chunkSize)), _tag(MemTag::current(kMemTagPools)) {
 
 	_next = nullptr;
 
@@ -54,8 +54,10 @@ MemoryPool::~MemoryPool() {
 		warning("Memory leak found in pool");
 #endif
 
-	for (size_t i = 0; i < _pages.size(); ++i)
+	for (size_t i = 0; i < _pages.size(); ++i) {
+		memTagFreed(_tag, _pages[i].numChunks * _chunkSize);
 		::free(_pages[i].start);
+	}
 }
 
 void MemoryPool::allocPage() {
@@ -68,6 +70,7 @@ void MemoryPool::allocPage() {
 	page.start = ::malloc(page.numChunks * _chunkSize);
 	assert(page.start);
 	_pages.push_back(page);
+	memTagAllocated(_tag, page.numChunks * _chunkSize);
 
 
 	// Next time, we'll allocate a page twice as big as this one.
@@ -150,6 +153,7 @@ void MemoryPool::freeUnusedPages() {
 					iter2 = *(void ***)iter2;
 			}
 
+			memTagFreed(_tag, _pages[i].numChunks * _chunkSize);
 			::free(_pages[i].start);
 			_pages[i].start = nullptr;
 		}
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/memtag.h"
 
 
 namespace Common {
@@ -60,6 +61,7 @@ protected:
 	Array<Page>		_pages;
 	void			*_next;
 	size_t			_chunksPerPage;
+	MemTagId		_tag; ///< The tag the pages are accounted to
 
 	void	allocPage();
 	void	addPageToPool(const Page &page);
@@ -67,7 +69,8 @@ protected:
 
 public:
 	/**
-	 * Constructor for a memory pool with the given chunk size.
+	 * Constructor for a memory pool with the given chunk size. The pages
+	 * are accounted to the current MemTag scope, or kMemTagPools.
 	 * @param chunkSize		the chunk size of this memory pool
 	 */
 	explicit MemoryPool(size_t chunkSize);
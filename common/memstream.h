@@ -93,6 +93,12 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return a pointer to the whole memory block wrapped by this stream,
+	 * independently of the current position.
+	 */
+	const byte *getData() const { return _ptr; }
 };
 
 
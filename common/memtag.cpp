@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/memtag.h"
+#include "common/textconsole.h"
+
+#include <atomic>
+
+namespace Common {
+
+namespace {
+
+struct MemTagCounters {
+	std::atomic<uint64> currentBytes;
+	std::atomic<uint64> peakBytes;
+	std::atomic<uint32> currentAllocations;
+	std::atomic<uint32> totalAllocations;
+};
+
+MemTagCounters g_memTagCounters[kMemTagCount];
+
+MemTagId g_currentMemTag = kMemTagGeneral;
+bool g_hasMemTag = false;
+
+} // End of anonymous namespace
+
+const char *getMemTagName(MemTagId tag) {
+	static const char *const names[kMemTagCount] = {
+		"general",
+		"pools",
+		"arenas",
+		"resources",
+		"video",
+		"audio",
+		"fonts",
+		"scripts",
+		"engine"
+	};
+
+	assert(tag < kMemTagCount);
+	return names[tag];
+}
+
+void memTagAllocated(MemTagId tag, size_t size) {
+	assert(tag < kMemTagCount);
+	MemTagCounters &counters = g_memTagCounters[tag];
+
+	const uint64 current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	uint64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+	while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+		;
+
+	counters.currentAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void memTagFreed(MemTagId tag, size_t size) {
+	assert(tag < kMemTagCount);
+	MemTagCounters &counters = g_memTagCounters[tag];
+
+	counters.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+	counters.currentAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemTagStats getMemTagStats(MemTagId tag) {
+	assert(tag < kMemTagCount);
+	const MemTagCounters &counters = g_memTagCounters[tag];
+
+	MemTagStats stats;
+	stats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	stats.currentAllocations = counters.currentAllocations.load(std::memory_order_relaxed);
+	stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void resetMemTagPeaks() {
+	for (int i = 0; i < kMemTagCount; ++i) {
+		MemTagCounters &counters = g_memTagCounters[i];
+		counters.peakBytes.store(counters.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
+
+MemTag::MemTag(MemTagId tag) : _previous(g_currentMemTag), _hadPrevious(g_hasMemTag) {
+	assert(tag < kMemTagCount);
+	g_currentMemTag = tag;
+	g_hasMemTag = true;
+}
+
+MemTag::~MemTag() {
+	g_currentMemTag = _previous;
+	g_hasMemTag = _hadPrevious;
+}
+
+MemTagId MemTag::current(MemTagId fallback) {
+	return g_hasMemTag ? g_currentMemTag : fallback;
+}
+
+} // End of namespace Common
@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_MEMTAG_H
+#define COMMON_MEMTAG_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_memtag Memory accounting
+ * @ingroup common_memory
+ *
+ * @brief Counters of the memory held by each subsystem.
+ *
+ * Allocators and caches report the memory they obtain and release under a
+ * tag, so that it can be attributed, for example with the "mem" debugger
+ * command. Only memory which is explicitly reported is counted; plain
+ * new and malloc() calls are not.
+ * @{
+ */
+
+/** The subsystems memory is accounted to. */
+enum MemTagId {
+	kMemTagGeneral,   ///< Memory without a more specific tag
+	kMemTagPools,     ///< Pages of MemoryPool instances
+	kMemTagArenas,    ///< Blocks of Arena instances
+	kMemTagResources, ///< Resource and archive caches
+	kMemTagVideo,     ///< Video frames
+	kMemTagAudio,     ///< Decoded audio
+	kMemTagFonts,     ///< Glyph caches
+	kMemTagScripts,   ///< Script interpreter heaps
+	kMemTagEngine,    ///< Engine caches
+
+	kMemTagCount
+};
+
+/** Counters of one tag. */
+struct MemTagStats {
+	uint64 currentBytes;       ///< Bytes currently held
+	uint64 peakBytes;          ///< Highest currentBytes since the start or resetMemTagPeaks()
+	uint32 currentAllocations; ///< Allocations currently held
+	uint32 totalAllocations;   ///< Allocations made since the start
+};
+
+/** Return the name of @p tag, as shown by the debugger. */
+const char *getMemTagName(MemTagId tag);
+
+/** Account an allocation of @p size bytes to @p tag. This is thread-safe. */
+void memTagAllocated(MemTagId tag, size_t size);
+
+/** Account the release of an allocation of @p size bytes to @p tag. This is thread-safe. */
+void memTagFreed(MemTagId tag, size_t size);
+
+/** Return the counters of @p tag. */
+MemTagStats getMemTagStats(MemTagId tag);
+
+/** Set the peak counters of all tags to their current values. */
+void resetMemTagPeaks();
+
+/**
+ * Scope which tags the allocators created in it. A MemoryPool or Arena
+ * constructed while a scope is active accounts all its memory to the tag of
+ * the innermost scope; without a scope, it uses its own tag. Scopes are meant
+ * to be used on the main thread.
+ */
+class MemTag : NonCopyable {
+public:
+	explicit MemTag(MemTagId tag);
+	~MemTag();
+
+	/** Return the tag of the innermost active scope, or @p fallback if there is none. */
+	static MemTagId current(MemTagId fallback);
+
+private:
+	MemTagId _previous;
+	bool _hadPrevious;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
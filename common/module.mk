@@ -2,7 +2,9 @@ MODULE := common
 
 MODULE_OBJS := \
 	archive.o \
+	arena.o \
 	concatstream.o \
+	concurrent-memorypool.o \
 	config-manager.o \
 	coroutines.o \
 	dbcs-str.o \
@@ -17,11 +19,13 @@ MODULE_OBJS := \
 	localization.o \
 	macresman.o \
 	memorypool.o \
+	memtag.o \
 	md5.o \
 	mutex.o \
 	osd_message_queue.o \
 	path.o \
 	platform.o \
+	profiler.o \
 	punycode.o \
 	random.o \
 	rational.o \
@@ -35,6 +39,7 @@ MODULE_OBJS := \
 	system.o \
 	textconsole.o \
 	text-to-speech.o \
+	threadpool.o \
 	tokenizer.o \
 	translation.o \
 	unicode-bidi.o \
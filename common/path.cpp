@@ -31,15 +31,16 @@ const char *SLASH_ESCAPED = "/+";
 
 namespace Common {
 
-Path::Path(const Path &path) {
-	_str = path._str;
+Path::Path(const Path &path) : _str(path._str), _hash(path._hash), _foldedHash(path._foldedHash), _cached(path._cached) {
+	if (_cached & kFoldedCached)
+		_folded = path._folded;
 }
 
-Path::Path(const char *str, char separator) {
+Path::Path(const char *str, char separator) : _hash(0), _foldedHash(0), _cached(0) {
 	set(str, separator);
 }
 
-Path::Path(const String &str, char separator) {
+Path::Path(const String &str, char separator) : _hash(0), _foldedHash(0), _cached(0) {
 	set(str.c_str(), separator);
 }
 
@@ -129,11 +130,13 @@ Path Path::appendComponent(const String &x) const {
 }
 
 bool Path::operator==(const Path &x) const {
+	if ((_cached & x._cached & kHashCached) && _hash != x._hash)
+		return false;
 	return _str == x._str;
 }
 
 bool Path::operator!=(const Path &x) const {
-	return _str != x._str;
+	return !(*this == x);
 }
 
 bool Path::empty() const {
@@ -141,7 +144,15 @@ bool Path::empty() const {
 }
 
 Path &Path::operator=(const Path &path) {
+	if (this == &path)
+		return *this;
+
 	_str = path._str;
+	_hash = path._hash;
+	_foldedHash = path._foldedHash;
+	_cached = path._cached;
+	if (_cached & kFoldedCached)
+		_folded = path._folded;
 	return *this;
 }
 
@@ -157,11 +168,13 @@ Path &Path::operator=(const String &str) {
 
 void Path::set(const char *str, char separator) {
 	_str.clear();
+	invalidateCache();
 	appendInPlace(str, separator);
 }
 
 Path &Path::appendInPlace(const Path &x) {
 	_str += x._str;
+	invalidateCache();
 	return *this;
 }
 
@@ -171,6 +184,7 @@ Path &Path::appendInPlace(const String &str, char separator) {
 }
 
 Path &Path::appendInPlace(const char *str, char separator) {
+	invalidateCache();
 	for (; *str; str++) {
 		if (*str == separator)
 			_str += DIR_SEPARATOR;
@@ -207,6 +221,7 @@ Path &Path::joinInPlace(const Path &x) {
 		_str += DIR_SEPARATOR;
 
 	_str += x._str;
+	invalidateCache();
 
 	return *this;
 }
@@ -363,12 +378,65 @@ bool Path::matchPattern(const Path& pattern) const {
 	return true;
 }
 
+// Plain ASCII paths without escaped slashes or punycoded components are
+// their own identifier string, which is by far the most common case.
+static bool isOwnIdentifier(const String &str) {
+	const char *p = str.c_str();
+	bool componentStart = true;
+	for (; *p; p++) {
+		if (*p & 0x80)
+			return false;
+		if (*p == ESCAPER) {
+			if (p[1] == ESCAPE_SLASH)
+				return false;
+			p++;
+			componentStart = true;
+			continue;
+		}
+		if (componentStart && *p == 'x' && strncmp(p, "xn--", 4) == 0)
+			return false;
+		componentStart = false;
+	}
+	return true;
+}
+
+const String &Path::getFoldedIdentifier() const {
+	if (!(_cached & kFoldedCached)) {
+		_folded = isOwnIdentifier(_str) ? _str : getIdentifierString();
+		_folded.toLowercase();
+		_foldedHash = hashit(_folded.c_str());
+		_cached |= kFoldedCached;
+	}
+	return _folded;
+}
+
+uint Path::getFoldedHash() const {
+	getFoldedIdentifier();
+	return _foldedHash;
+}
+
+uint Path::getHash() const {
+	if (!(_cached & kHashCached)) {
+		_hash = hashit(_str.c_str());
+		_cached |= kHashCached;
+	}
+	return _hash;
+}
+
 bool Path::IgnoreCaseAndMac_EqualsTo::operator()(const Path& x, const Path& y) const {
-	return x.getIdentifierString().equalsIgnoreCase(y.getIdentifierString());
+	if (&x == &y)
+		return true;
+	if (x.getFoldedHash() != y.getFoldedHash())
+		return false;
+	return x.getFoldedIdentifier() == y.getFoldedIdentifier();
 }
 
 uint Path::IgnoreCaseAndMac_Hash::operator()(const Path& x) const {
-	return hashit_lower(x.getIdentifierString().c_str());
+	return x.getFoldedHash();
+}
+
+uint Path::Hash::operator()(const Path &x) const {
+	return x.getHash();
 }
 
 } // End of namespace Common
@@ -48,7 +48,27 @@ class Path {
 private:
 	String _str;
 
+	/**
+	 * Lazily computed lookup keys. Archive and SearchSet lookups hash and
+	 * compare the same Path objects (and the HashMap keys copied from them)
+	 * over and over, so the case-folded identifier string and both hashes
+	 * are kept until the path is modified.
+	 */
+	enum {
+		kHashCached = 1 << 0,
+		kFoldedCached = 1 << 1
+	};
+
+	mutable String _folded;
+	mutable uint _hash;
+	mutable uint _foldedHash;
+	mutable byte _cached;
+
 	String getIdentifierString() const;
+	const String &getFoldedIdentifier() const;
+	uint getHash() const;
+	uint getFoldedHash() const;
+	void invalidateCache() { _cached = 0; }
 	size_t findLastSeparator(size_t last = String::npos) const;
 
 public:
@@ -69,8 +89,15 @@ public:
 		uint operator()(const Path& x) const;
 	};
 
+	/**
+	 * Case-sensitive hash, consistent with operator==.
+	 */
+	struct Hash {
+		uint operator()(const Path &x) const;
+	};
+
 	/** Construct a new empty path. */
-	Path() {}
+	Path() : _hash(0), _foldedHash(0), _cached(0) {}
 
 	/** Construct a copy of the given path. */
 	Path(const Path &path);
@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/algorithm.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+enum {
+	kDefaultCapacity = 64 * 1024
+};
+
+Profiler::Profiler() : _next(0), _count(0), _enabled(false) {
+	_events.resize(kDefaultCapacity);
+}
+
+void Profiler::setCapacity(uint capacity) {
+	StackLock lock(_mutex);
+	_events.clear();
+	_events.resize(MAX<uint>(capacity, 1));
+	_next = 0;
+	_count = 0;
+}
+
+void Profiler::record(const char *name, uint64 start, uint64 end, uint16 lane) {
+	StackLock lock(_mutex);
+	Event &event = _events[_next];
+	event.name = name;
+	event.start = start;
+	event.duration = (uint32)MIN<uint64>(end - start, 0xFFFFFFFF);
+	event.lane = lane;
+
+	_next = (_next + 1) % _events.size();
+	if (_count < _events.size())
+		++_count;
+}
+
+void Profiler::clear() {
+	StackLock lock(_mutex);
+	_next = 0;
+	_count = 0;
+}
+
+uint Profiler::getEventCount() const {
+	StackLock lock(_mutex);
+	return _count;
+}
+
+Profiler::Event Profiler::getEvent(uint index) const {
+	StackLock lock(_mutex);
+	assert(index < _count);
+	return _events[(_next + _events.size() - _count + index) % _events.size()];
+}
+
+namespace {
+
+struct ZoneStatsGreater {
+	bool operator()(const Profiler::ZoneStats &a, const Profiler::ZoneStats &b) const {
+		return a.total > b.total;
+	}
+};
+
+} // End of anonymous namespace
+
+void Profiler::getStatistics(Array<ZoneStats> &stats) const {
+	typedef HashMap<String, uint> IndexMap;
+	IndexMap indices;
+
+	stats.clear();
+
+	const uint count = getEventCount();
+	for (uint i = 0; i < count; ++i) {
+		const Event event = getEvent(i);
+
+		IndexMap::iterator index = indices.find(event.name);
+		if (index == indices.end()) {
+			ZoneStats zone;
+			zone.name = event.name;
+			zone.count = 0;
+			zone.total = 0;
+			zone.max = 0;
+			indices[event.name] = stats.size();
+			stats.push_back(zone);
+			index = indices.find(event.name);
+		}
+
+		ZoneStats &zone = stats[index->_value];
+		zone.count++;
+		zone.total += event.duration;
+		zone.max = MAX(zone.max, event.duration);
+	}
+
+	sort(stats.begin(), stats.end(), ZoneStatsGreater());
+}
+
+bool Profiler::writeChromeTrace(WriteStream &stream) const {
+	stream.writeString("{\"traceEvents\":[\n");
+
+	const uint count = getEventCount();
+	for (uint i = 0; i < count; ++i) {
+		const Event event = getEvent(i);
+
+		// Zone names are identifiers, only escape what would break the JSON.
+		String name;
+		for (const char *c = event.name; *c; ++c) {
+			if (*c == '"' || *c == '\\')
+				name += '\\';
+			name += *c;
+		}
+
+		stream.writeString(String::format("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}%s\n",
+			name.c_str(), (uint)event.lane, (unsigned long long)event.start, (uint)event.duration,
+			i + 1 < count ? "," : ""));
+	}
+
+	stream.writeString("]}\n");
+	return !stream.err();
+}
+
+ProfileZone::ProfileZone(const char *name, uint16 lane) : _name(name), _start(0), _lane(lane), _active(false) {
+	if (Profiler::hasInstance() && Profiler::instance().isEnabled()) {
+		_active = true;
+		_start = g_system->getMicros();
+	}
+}
+
+ProfileZone::~ProfileZone() {
+	if (_active)
+		Profiler::instance().record(_name, _start, g_system->getMicros(), _lane);
+}
+
+} // End of namespace Common
@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Lightweight instrumentation of hot code paths.
+ *
+ * Code is instrumented with the PROFILE_ZONE() macros, which measure the
+ * time until the end of the enclosing scope. The macros compile to nothing
+ * unless ScummVM is configured with --enable-profiler, and only record while
+ * the profiler is enabled, e.g. through the --profile command line option or
+ * the "profile" debugger command.
+ *
+ * The most recent events are kept in a ring buffer. They can be summarized
+ * or exported in the Chrome trace event format, which can be loaded into
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * @{
+ */
+
+class WriteStream;
+
+class Profiler : public Singleton<Profiler> {
+public:
+	/**
+	 * Timeline an event is shown on. Zones on threads other than the main
+	 * one should use their own lane, so that their events do not interleave.
+	 */
+	enum Lane {
+		kLaneMain = 0,
+		kLaneAudio = 1,
+		kLaneWorker = 2
+	};
+
+	/** A measured zone, with times in microseconds. */
+	struct Event {
+		const char *name;
+		uint64 start;
+		uint32 duration;
+		uint16 lane;
+	};
+
+	/** Accumulated times of all events of a zone, in microseconds. */
+	struct ZoneStats {
+		const char *name;
+		uint count;
+		uint64 total;
+		uint32 max;
+	};
+
+	/** Start or stop recording events. */
+	void setEnabled(bool enabled) { _enabled = enabled; }
+	bool isEnabled() const { return _enabled; }
+
+	/** Resize the ring buffer to hold @p capacity events. This clears it. */
+	void setCapacity(uint capacity);
+	uint getCapacity() const { return _events.size(); }
+
+	/**
+	 * Record an event. Zone names are not copied and must stay valid,
+	 * normally they are string literals.
+	 */
+	void record(const char *name, uint64 start, uint64 end, uint16 lane = kLaneMain);
+
+	/** Drop all recorded events. */
+	void clear();
+
+	/** Return the number of events in the ring buffer. */
+	uint getEventCount() const;
+
+	/** Return an event, where index 0 is the oldest one. */
+	Event getEvent(uint index) const;
+
+	/** Compute statistics per zone, sorted by descending total time. */
+	void getStatistics(Array<ZoneStats> &stats) const;
+
+	/** Write the recorded events as Chrome trace JSON. */
+	bool writeChromeTrace(WriteStream &stream) const;
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	Profiler();
+
+	mutable Mutex _mutex;
+	Array<Event> _events;
+	uint _next;
+	uint _count;
+	bool _enabled;
+};
+
+/**
+ * Measures the lifetime of the object and records it as an event with
+ * Profiler, if the profiler is enabled. Use through PROFILE_ZONE().
+ */
+class ProfileZone : NonCopyable {
+	const char *_name;
+	uint64 _start;
+	uint16 _lane;
+	bool _active;
+
+public:
+	explicit ProfileZone(const char *name, uint16 lane = Profiler::kLaneMain);
+	~ProfileZone();
+};
+
+#ifdef USE_PROFILER
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+
+/** Measure the time until the end of the enclosing scope. */
+#define PROFILE_ZONE(name) Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+
+/** Same as PROFILE_ZONE(), but place the events on the given Profiler::Lane. */
+#define PROFILE_ZONE_LANE(name, lane) Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name, lane)
+#else
+#define PROFILE_ZONE(name) do {} while (false)
+#define PROFILE_ZONE_LANE(name, lane) do {} while (false)
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -25,14 +25,76 @@
 #include "common/recorderfile.h"
 #include "common/savefile.h"
 #include "common/bufferedstream.h"
+#include "common/threadpool.h"
+#include "common/compression/zlib.h"
 #include "graphics/thumbnail.h"
 #include "graphics/surface.h"
 #include "graphics/scaler.h"
 
-#define RECORD_VERSION 1
+#define RECORD_VERSION 2
 
 namespace Common {
 
+/**
+ * Compresses a block of events and writes it, optionally followed by a
+ * screenshot, to the record file off the engine thread.
+ */
+class PlaybackFile::WriteJob : public Job {
+	WriteStream *_target;
+	byte *_events;
+	uint32 _eventsSize;
+	Graphics::Surface _screenShot;
+	bool _hashOnly;
+
+public:
+	WriteJob(WriteStream *target, const byte *events, uint32 eventsSize, Graphics::Surface *screenShot, bool hashOnly) :
+		_target(target), _events(nullptr), _eventsSize(eventsSize), _hashOnly(hashOnly) {
+		if (eventsSize) {
+			_events = (byte *)malloc(eventsSize);
+			memcpy(_events, events, eventsSize);
+		}
+		if (screenShot) {
+			// Take over the pixels, the caller does not free them
+			_screenShot = *screenShot;
+			screenShot->setPixels(nullptr);
+		}
+	}
+
+	~WriteJob() override {
+		free(_events);
+		_screenShot.free();
+	}
+
+	void run() override {
+		if (_eventsSize) {
+			MemoryWriteStreamDynamic *block = new MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+			WriteStream *compressed = wrapCompressedWriteStream(block, 1);
+			compressed->write(_events, _eventsSize);
+			compressed->finalize();
+			byte *data = block->getData();
+			const uint32 size = block->size();
+			delete compressed;
+
+			_target->writeUint32BE(kEventTag);
+			_target->writeUint32BE(size);
+			_target->write(data, size);
+			free(data);
+		}
+
+		if (_screenShot.getPixels()) {
+			uint8 md5[16];
+			MemoryReadStream bitmapStream((const byte *)_screenShot.getPixels(), _screenShot.w * _screenShot.h * _screenShot.format.bytesPerPixel);
+			computeStreamMD5(bitmapStream, md5);
+
+			_target->writeUint32BE(kMD5Tag);
+			_target->writeUint32BE(16);
+			_target->write(md5, 16);
+			if (!_hashOnly)
+				Graphics::saveThumbnail(*_target, _screenShot);
+		}
+	}
+};
+
 PlaybackFile::PlaybackFile()
 	: _tmpBuffer(kRecordBuffSize)
 	, _tmpRecordFile(_tmpBuffer.data(), kRecordBuffSize)
@@ -47,6 +109,9 @@ PlaybackFile::PlaybackFile()
 	_recordCount = 0;
 	_eventsSize = 0;
 	_version = RECORD_VERSION;
+	_pendingWrites = nullptr;
+	_writeJob = nullptr;
+	resetDeltaState();
 	memset(_tmpBuffer.data(), 1, kRecordBuffSize);
 
 	_playbackParseState = kFileStateCheckFormat;
@@ -54,6 +119,7 @@ PlaybackFile::PlaybackFile()
 
 PlaybackFile::~PlaybackFile() {
 	close();
+	delete _pendingWrites;
 }
 
 bool PlaybackFile::openWrite(const String &fileName) {
@@ -62,6 +128,8 @@ bool PlaybackFile::openWrite(const String &fileName) {
 	_writeStream = wrapBufferedWriteStream(g_system->getSavefileManager()->openForSaving(fileName), 128 * 1024);
 	_headerDumped = false;
 	_recordCount = 0;
+	_version = RECORD_VERSION;
+	resetDeltaState();
 	if (_writeStream == NULL) {
 		return false;
 	}
@@ -94,6 +162,7 @@ void PlaybackFile::close() {
 	_readStream = NULL;
 	if (_writeStream != NULL) {
 		dumpRecordsToFile();
+		waitForPendingWrite();
 		_writeStream->finalize();
 		delete _writeStream;
 		_writeStream = NULL;
@@ -133,6 +202,7 @@ bool PlaybackFile::checkPlaybackFileVersion() {
 	_version = _readStream->readUint32BE();
 	switch (_version) {
 	case 1:
+	case 2:
 		break;
 	default:
 		warning("Unknown playback file version %d. Maximum supported version is %d.", _version, RECORD_VERSION);
@@ -372,7 +442,133 @@ bool PlaybackFile::isEventsBufferEmpty() {
 	return (uint32)_tmpPlaybackFile.pos() == _eventsSize;
 }
 
+void PlaybackFile::resetDeltaState() {
+	_lastEventTime = 0;
+	_lastMouseX = 0;
+	_lastMouseY = 0;
+}
+
+void PlaybackFile::writeVarUint(uint32 value) {
+	while (value >= 0x80) {
+		_tmpRecordFile.writeByte((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	_tmpRecordFile.writeByte(value);
+}
+
+void PlaybackFile::writeVarInt(int32 value) {
+	// Zigzag encoding keeps small negative values short
+	writeVarUint(((uint32)value << 1) ^ (uint32)(value >> 31));
+}
+
+void PlaybackFile::writeEventTime(uint32 time) {
+	writeVarUint(time - _lastEventTime);
+	_lastEventTime = time;
+}
+
+uint32 PlaybackFile::readVarUint() {
+	uint32 value = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		const byte b = _tmpPlaybackFile.readByte();
+		value |= (uint32)(b & 0x7F) << shift;
+		if (!(b & 0x80))
+			break;
+	}
+	return value;
+}
+
+int32 PlaybackFile::readVarInt() {
+	const uint32 value = readVarUint();
+	return (int32)(value >> 1) ^ -(int32)(value & 1);
+}
+
+uint32 PlaybackFile::readEventTime() {
+	_lastEventTime += readVarUint();
+	return _lastEventTime;
+}
+
 void PlaybackFile::readEvent(RecorderEvent& event) {
+	if (_version == 1) {
+		readLegacyEvent(event);
+		return;
+	}
+
+	event.recordedtype = (RecorderEventType)_tmpPlaybackFile.readByte();
+	switch (event.recordedtype) {
+	case kRecorderEventTypeTimer:
+		event.time = readEventTime();
+		break;
+	case kRecorderEventTypeTimeDate:
+		event.timeDate.tm_sec = readVarInt();
+		event.timeDate.tm_min = readVarInt();
+		event.timeDate.tm_hour = readVarInt();
+		event.timeDate.tm_mday = readVarInt();
+		event.timeDate.tm_mon = readVarInt();
+		event.timeDate.tm_year = readVarInt();
+		event.timeDate.tm_wday = readVarInt();
+		break;
+	case kRecorderEventTypeScreenUpdate:
+		event.time = readEventTime();
+		break;
+	default:
+		// fallthrough intended
+	case kRecorderEventTypeNormal:
+		event.type = (EventType)readVarUint();
+		switch (event.type) {
+		case EVENT_KEYDOWN:
+			event.kbdRepeat = _tmpPlaybackFile.readByte();
+			// fallthrough
+		case EVENT_KEYUP:
+			event.time = readEventTime();
+			event.kbd.keycode = (KeyCode)readVarInt();
+			event.kbd.ascii = readVarUint();
+			event.kbd.flags = _tmpPlaybackFile.readByte();
+			break;
+		case EVENT_MOUSEMOVE:
+		case EVENT_LBUTTONDOWN:
+		case EVENT_LBUTTONUP:
+		case EVENT_RBUTTONDOWN:
+		case EVENT_RBUTTONUP:
+		case EVENT_WHEELUP:
+		case EVENT_WHEELDOWN:
+		case EVENT_MBUTTONDOWN:
+		case EVENT_MBUTTONUP:
+		case EVENT_X1BUTTONDOWN:
+		case EVENT_X1BUTTONUP:
+		case EVENT_X2BUTTONDOWN:
+		case EVENT_X2BUTTONUP:
+			event.time = readEventTime();
+			_lastMouseX += readVarInt();
+			_lastMouseY += readVarInt();
+			event.mouse.x = _lastMouseX;
+			event.mouse.y = _lastMouseY;
+			break;
+		case EVENT_CUSTOM_BACKEND_ACTION_START:
+		case EVENT_CUSTOM_BACKEND_ACTION_END:
+		case EVENT_CUSTOM_ENGINE_ACTION_START:
+		case EVENT_CUSTOM_ENGINE_ACTION_END:
+			event.time = readEventTime();
+			event.customType = readVarUint();
+			break;
+		case EVENT_JOYAXIS_MOTION:
+		case EVENT_JOYBUTTON_UP:
+		case EVENT_JOYBUTTON_DOWN:
+			event.time = readEventTime();
+			event.joystick.axis = _tmpPlaybackFile.readByte();
+			event.joystick.button = _tmpPlaybackFile.readByte();
+			event.joystick.position = readVarInt();
+			break;
+		default:
+			event.time = readEventTime();
+			break;
+		}
+		break;
+	}
+	debug(3, "read event of recordedtype: %i, type: %i (time: %u, systemmillis: %u)",
+			event.recordedtype, event.type, event.time, g_system->getMillis(true));
+}
+
+void PlaybackFile::readLegacyEvent(RecorderEvent& event) {
 	event.recordedtype = (RecorderEventType)_tmpPlaybackFile.readByte();
 	switch (event.recordedtype) {
 	case kRecorderEventTypeTimer:
@@ -447,32 +643,54 @@ void PlaybackFile::readEvent(RecorderEvent& event) {
 }
 
 void PlaybackFile::readEventsToBuffer(uint32 size) {
-	_readStream->read(_tmpBuffer.data(), size);
+	if (_version == 1) {
+		_readStream->read(_tmpBuffer.data(), size);
+		_eventsSize = size;
+	} else {
+		// Since version 2 every block of events is compressed
+		byte *block = (byte *)malloc(size);
+		const uint32 blockSize = _readStream->read(block, size);
+		SeekableReadStream *events = wrapCompressedReadStream(new MemoryReadStream(block, blockSize, DisposeAfterUse::YES));
+		_eventsSize = events->read(_tmpBuffer.data(), kRecordBuffSize);
+		delete events;
+	}
 	_tmpPlaybackFile.seek(0);
-	_eventsSize = size;
+	resetDeltaState();
 }
 
-void PlaybackFile::saveScreenShot(Graphics::Surface &screen, byte md5[16]) {
-	dumpRecordsToFile();
-	_writeStream->writeUint32BE(kMD5Tag);
-	_writeStream->writeUint32BE(16);
-	_writeStream->write(md5, 16);
-	Graphics::saveThumbnail(*_writeStream, screen);
+void PlaybackFile::saveScreenShot(Graphics::Surface &screen, bool hashOnly) {
+	dumpRecordsToFile(&screen, hashOnly);
 }
 
-void PlaybackFile::dumpRecordsToFile() {
+void PlaybackFile::dumpRecordsToFile(Graphics::Surface *screenShot, bool hashOnly) {
 	if (!_headerDumped) {
 		dumpHeaderToFile();
 		_headerDumped = true;
 	}
-	if (_recordCount == 0) {
+	if (_recordCount == 0 && !screenShot) {
 		return;
 	}
-	_writeStream->writeUint32BE(kEventTag);
-	_writeStream->writeUint32BE(_tmpRecordFile.pos());
-	_writeStream->write(_tmpBuffer.data(), _tmpRecordFile.pos());
+
+	// Only a single block is in flight, it is usually written long
+	// before the next one is full
+	waitForPendingWrite();
+	if (!_pendingWrites)
+		_pendingWrites = new TaskGroup(g_system->getThreadPool());
+	_writeJob = new WriteJob(_writeStream, _tmpBuffer.data(), _tmpRecordFile.pos(), screenShot, hashOnly);
+	_pendingWrites->run(_writeJob);
+
 	_tmpRecordFile.seek(0);
 	_recordCount = 0;
+	resetDeltaState();
+}
+
+void PlaybackFile::waitForPendingWrite() {
+	if (!_writeJob)
+		return;
+
+	_pendingWrites->wait();
+	delete _writeJob;
+	_writeJob = nullptr;
 }
 
 void PlaybackFile::dumpHeaderToFile() {
@@ -565,32 +783,32 @@ void PlaybackFile::writeEvent(const RecorderEvent &event) {
 	_tmpRecordFile.writeByte(event.recordedtype);
 	switch (event.recordedtype) {
 	case kRecorderEventTypeTimer:
-		_tmpRecordFile.writeUint32BE(event.time);
+		writeEventTime(event.time);
 		break;
 	case kRecorderEventTypeTimeDate:
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_sec);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_min);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_hour);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_mday);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_mon);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_year);
-		_tmpRecordFile.writeSint32BE(event.timeDate.tm_wday);
+		writeVarInt(event.timeDate.tm_sec);
+		writeVarInt(event.timeDate.tm_min);
+		writeVarInt(event.timeDate.tm_hour);
+		writeVarInt(event.timeDate.tm_mday);
+		writeVarInt(event.timeDate.tm_mon);
+		writeVarInt(event.timeDate.tm_year);
+		writeVarInt(event.timeDate.tm_wday);
 		break;
 	case kRecorderEventTypeScreenUpdate:
-		_tmpRecordFile.writeUint32BE(event.time);
+		writeEventTime(event.time);
 		break;
 	default:
 		// fallthrough intended
 	case kRecorderEventTypeNormal:
-		_tmpRecordFile.writeUint32BE((uint32)event.type);
+		writeVarUint((uint32)event.type);
 		switch(event.type) {
 		case EVENT_KEYDOWN:
 			_tmpRecordFile.writeByte(event.kbdRepeat);
 			// fallthrough
 		case EVENT_KEYUP:
-			_tmpRecordFile.writeUint32BE(event.time);
-			_tmpRecordFile.writeSint32BE(event.kbd.keycode);
-			_tmpRecordFile.writeUint16BE(event.kbd.ascii);
+			writeEventTime(event.time);
+			writeVarInt(event.kbd.keycode);
+			writeVarUint(event.kbd.ascii);
 			_tmpRecordFile.writeByte(event.kbd.flags);
 			break;
 		case EVENT_MOUSEMOVE:
@@ -606,27 +824,29 @@ void PlaybackFile::writeEvent(const RecorderEvent &event) {
 		case EVENT_X1BUTTONUP:
 		case EVENT_X2BUTTONDOWN:
 		case EVENT_X2BUTTONUP:
-			_tmpRecordFile.writeUint32BE(event.time);
-			_tmpRecordFile.writeSint16BE(event.mouse.x);
-			_tmpRecordFile.writeSint16BE(event.mouse.y);
+			writeEventTime(event.time);
+			writeVarInt(event.mouse.x - _lastMouseX);
+			writeVarInt(event.mouse.y - _lastMouseY);
+			_lastMouseX = event.mouse.x;
+			_lastMouseY = event.mouse.y;
 			break;
 		case EVENT_CUSTOM_BACKEND_ACTION_START:
 		case EVENT_CUSTOM_BACKEND_ACTION_END:
 		case EVENT_CUSTOM_ENGINE_ACTION_START:
 		case EVENT_CUSTOM_ENGINE_ACTION_END:
-			_tmpRecordFile.writeUint32BE(event.time);
-			_tmpRecordFile.writeUint32BE(event.customType);
+			writeEventTime(event.time);
+			writeVarUint(event.customType);
 			break;
 		case EVENT_JOYAXIS_MOTION:
 		case EVENT_JOYBUTTON_UP:
 		case EVENT_JOYBUTTON_DOWN:
-			_tmpRecordFile.writeUint32BE(event.time);
+			writeEventTime(event.time);
 			_tmpRecordFile.writeByte(event.joystick.axis);
 			_tmpRecordFile.writeByte(event.joystick.button);
-			_tmpRecordFile.writeSint16BE(event.joystick.position);
+			writeVarInt(event.joystick.position);
 			break;
 		default:
-			_tmpRecordFile.writeUint32BE(event.time);
+			writeEventTime(event.time);
 			break;
 		}
 		break;
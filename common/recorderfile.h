@@ -35,6 +35,8 @@
 
 namespace Common {
 
+class TaskGroup;
+
 enum RecorderEventType {
 	kRecorderEventTypeNormal = 0,
 	kRecorderEventTypeTimer = 1,
@@ -77,6 +79,8 @@ struct RecorderEvent : Event {
 
 
 class PlaybackFile {
+	class WriteJob;
+
 	typedef HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo> RandomSeedsDictionary;
 	enum fileMode {
 		kRead = 0,
@@ -149,7 +153,15 @@ public:
 	RecorderEvent getNextEvent();
 	void writeEvent(const RecorderEvent &event);
 
-	void saveScreenShot(Graphics::Surface &screen, byte md5[16]);
+	/**
+	 * Queue a screenshot to be written after the events recorded so far.
+	 * The checksum is computed and the screenshot written in the
+	 * background. The recording takes ownership of the surface pixels.
+	 *
+	 * @param screen     the screen contents grabbed by the caller
+	 * @param hashOnly   store only the checksum of the screen contents
+	 */
+	void saveScreenShot(Graphics::Surface &screen, bool hashOnly);
 	Graphics::Surface *getScreenShot(int number);
 	int getScreensCount();
 
@@ -176,6 +188,14 @@ private:
 	PlaybackFileState _playbackParseState;
 	uint32 _version;
 
+	// Events are delta encoded against the previous event of the same block
+	uint32 _lastEventTime;
+	int16 _lastMouseX;
+	int16 _lastMouseY;
+
+	TaskGroup *_pendingWrites;
+	WriteJob *_writeJob;
+
 	void skipHeader();
 	bool parseHeader();
 	bool processChunk(ChunkHeader &nextChunk);
@@ -196,13 +216,22 @@ private:
 	void writeGameHash();
 	void writeRandomRecords();
 
-	void dumpRecordsToFile();
+	void dumpRecordsToFile(Graphics::Surface *screenShot = nullptr, bool hashOnly = false);
+	void waitForPendingWrite();
+	void resetDeltaState();
 
 	String readString(int len);
 	void readHashMap(ChunkHeader chunk);
 
 	bool skipToNextScreenshot();
 	void readEvent(RecorderEvent& event);
+	void readLegacyEvent(RecorderEvent& event);
+	void writeVarUint(uint32 value);
+	void writeVarInt(int32 value);
+	void writeEventTime(uint32 time);
+	uint32 readVarUint();
+	int32 readVarInt();
+	uint32 readEventTime();
 	void readEventsToBuffer(uint32 size);
 	bool grabScreenAndComputeMD5(Graphics::Surface &screen, uint8 md5[16]);
 };
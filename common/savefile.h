@@ -268,6 +268,17 @@ public:
 	 */
 	virtual void updateSavefilesList(StringArray &lockedFiles) = 0;
 
+	/**
+	 * Get a counter that changes whenever save files might have been written,
+	 * removed or otherwise changed, e.g. to find out whether information read
+	 * from them earlier is still valid.
+	 *
+	 * @param counter  Set to the current value of the counter.
+	 *
+	 * @return False if the save file manager does not keep track of changes.
+	 */
+	virtual bool getChangeCounter(uint32 &counter) { return false; }
+
 	/**
 	 * Checks if the savefile exists.
 	 *
@@ -22,6 +22,7 @@
 #ifndef COMMON_SERIALIZER_H
 #define COMMON_SERIALIZER_H
 
+#include "common/endian.h"
 #include "common/stream.h"
 #include "common/str.h"
 
@@ -52,6 +53,30 @@ namespace Common {
 		_bytesSynced += SIZE; \
 	}
 
+#define SYNC_ARRAY_AS(SUFFIX,TYPE,SIZE,READ,WRITE) \
+	template<typename T> \
+	void syncArrayAs ## SUFFIX(T *arr, size_t entries, Version minVersion = 0, Version maxVersion = kLastVersion) { \
+		if (_version < minVersion || _version > maxVersion) \
+			return; \
+		byte buf[kBulkBufferSize]; \
+		while (entries) { \
+			const size_t count = entries < kBulkBufferSize / SIZE ? entries : kBulkBufferSize / SIZE; \
+			if (_loadStream) { \
+				const uint32 read = _loadStream->read(buf, count * SIZE); \
+				memset(buf + read, 0, count * SIZE - read); \
+				for (size_t i = 0; i < count; ++i) \
+					arr[i] = static_cast<T>(static_cast<TYPE>(READ(buf + i * SIZE))); \
+			} else { \
+				for (size_t i = 0; i < count; ++i) \
+					WRITE(buf + i * SIZE, static_cast<TYPE>(arr[i])); \
+				_saveStream->write(buf, count * SIZE); \
+			} \
+			_bytesSynced += count * SIZE; \
+			arr += count; \
+			entries -= count; \
+		} \
+	}
+
 #define SYNC_PRIMITIVE(suffix) \
 	template <typename T> \
 	static inline void suffix(Serializer &s, T &value) { \
@@ -81,6 +106,9 @@ public:
 	typedef uint32 Version;
 	static const Version kLastVersion = 0xFFFFFFFF;
 
+	/** Size of the staging buffer used by the syncArrayAs*() methods. */
+	static const uint32 kBulkBufferSize = 1024;
+
 	SYNC_PRIMITIVE(Uint32LE)
 	SYNC_PRIMITIVE(Uint32BE)
 	SYNC_PRIMITIVE(Sint32LE)
@@ -132,6 +160,22 @@ public:
 	SYNC_AS(DoubleLE, double, 8)
 	SYNC_AS(DoubleBE, double, 8)
 
+	/**
+	 * Sync an array of integers with a fixed number of entries.
+	 * This produces the same data as syncing every entry with the matching
+	 * syncAs*() method, but reads and writes the stream in large blocks
+	 * instead of one call per entry.
+	 */
+	SYNC_ARRAY_AS(Uint16LE, uint16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Uint16BE, uint16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+	SYNC_ARRAY_AS(Sint16LE, int16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Sint16BE, int16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+
+	SYNC_ARRAY_AS(Uint32LE, uint32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Uint32BE, uint32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+	SYNC_ARRAY_AS(Sint32LE, int32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Sint32BE, int32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+
 	/**
 	 * Returns true if an I/O failure occurred.
 	 * This flag is never cleared automatically. In order to clear it,
@@ -300,6 +344,7 @@ public:
 };
 
 #undef SYNC_PRIMITIVE
+#undef SYNC_ARRAY_AS
 #undef SYNC_AS
 
 
@@ -23,43 +23,29 @@
 #include "common/hash-str.h"
 #include "common/list.h"
 #include "common/memorypool.h"
+#ifndef SCUMMVM_UTIL
+#include "common/concurrent-memorypool.h"
+#endif
 #include "common/textconsole.h"
 #include "common/util.h"
-#include "common/mutex.h"
 
 namespace Common {
 
 #define TEMPLATE template<class T>
 #define BASESTRING BaseString<T>
 
-MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
 #ifndef SCUMMVM_UTIL
-Mutex *g_refCountPoolMutex = nullptr;
-
-void lockMemoryPoolMutex() {
-	// The Mutex class can only be used once g_system is set and initialized,
-	// but we may use the String class earlier than that (it is for example
-	// used in the OSystem_POSIX constructor). However in those early stages
-	// we can hope we don't have multiple threads either.
-	if (!g_system || !g_system->backendInitialized())
-		return;
-	if (!g_refCountPoolMutex)
-		g_refCountPoolMutex = new Mutex();
-	g_refCountPoolMutex->lock();
-}
-
-void unlockMemoryPoolMutex() {
-	if (g_refCountPoolMutex)
-		g_refCountPoolMutex->unlock();
-}
+// Strings are created and destroyed on worker threads as well, so the
+// ref counts come from a pool with per-thread caches. The pool itself is
+// created on first use, which happens long before any thread is started.
+ConcurrentMemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
 
 TEMPLATE void BASESTRING::releaseMemoryPoolMutex() {
-	if (g_refCountPoolMutex){
-		delete g_refCountPoolMutex;
-		g_refCountPoolMutex = nullptr;
-	}
+	if (g_refCountPool)
+		g_refCountPool->releaseMutex();
 }
-
+#else
+MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
 #endif
 
 static uint32 computeCapacity(uint32 len) {
@@ -199,18 +185,16 @@ TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
 	if (_extern._refCount == nullptr) {
-#ifndef SCUMMVM_UTIL
-		lockMemoryPoolMutex();
-#endif
 		if (g_refCountPool == nullptr) {
+#ifndef SCUMMVM_UTIL
+			g_refCountPool = new ConcurrentMemoryPool(sizeof(int));
+#else
 			g_refCountPool = new MemoryPool(sizeof(int));
+#endif
 			assert(g_refCountPool);
 		}
 
 		_extern._refCount = (int *)g_refCountPool->allocChunk();
-#ifndef SCUMMVM_UTIL
-		unlockMemoryPoolMutex();
-#endif
 		*_extern._refCount = 2;
 	} else {
 		++(*_extern._refCount);
@@ -229,14 +213,8 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 		// The ref count reached zero, so we free the string storage
 		// and the ref count storage.
 		if (oldRefCount) {
-#ifndef SCUMMVM_UTIL
-			lockMemoryPoolMutex();
-#endif
 			assert(g_refCountPool);
 			g_refCountPool->freeChunk(oldRefCount);
-#ifndef SCUMMVM_UTIL
-			unlockMemoryPoolMutex();
-#endif
 		}
 		// Coverity thinks that we always free memory, as it assumes
 		// (correctly) that there are cases when oldRefCount == 0
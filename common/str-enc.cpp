@@ -30,6 +30,40 @@
 
 namespace Common {
 
+/**
+ * Return the length of the run of ASCII characters at the start of
+ * @p src. Whole 16 byte blocks are tested with two 64-bit words.
+ */
+static uint32 asciiRunLength(const byte *src, uint32 len) {
+	const uint64 highBits = 0x8080808080808080ULL;
+	uint32 i = 0;
+
+	for (; len - i >= 16; i += 16) {
+		uint64 a, b;
+		memcpy(&a, src + i, 8);
+		memcpy(&b, src + i + 8, 8);
+		if ((a | b) & highBits)
+			break;
+	}
+
+	while (i < len && !(src[i] & 0x80))
+		i++;
+	return i;
+}
+
+static uint32 asciiRunLength(const U32String::value_type *src, uint32 len) {
+	uint32 i = 0;
+
+	for (; len - i >= 4; i += 4) {
+		if ((src[i] | src[i + 1] | src[i + 2] | src[i + 3]) & ~0x7FU)
+			break;
+	}
+
+	while (i < len && src[i] <= 0x7F)
+		i++;
+	return i;
+}
+
 // //TODO: This is a quick and dirty converter. Refactoring needed:
 // 1. Original version has an option for performing strict / nonstrict
 //    conversion for the 0xD800...0xDFFF interval
@@ -38,6 +72,8 @@ namespace Common {
 //
 // More comprehensive one lives in wintermute/utils/convert_utf.cpp
 void U32String::decodeUTF8(const char *src, uint32 len) {
+	// Every character takes at least one byte, so this is enough room
+	// for the whole string.
 	ensureCapacity(len, false);
 
 	// The String class, and therefore the Font class as well, assume one
@@ -45,48 +81,61 @@ void U32String::decodeUTF8(const char *src, uint32 len) {
 	// string with up to 4 bytes per character. To work around this,
 	// convert it to an U32String before drawing it, because our Font class
 	// can handle that.
+	const byte *bytes = (const byte *)src;
+	value_type *dst = _str + _size;
+
 	for (uint i = 0; i < len;) {
+		const uint32 run = asciiRunLength(bytes + i, len - i);
+		for (uint32 j = 0; j < run; j++)
+			dst[j] = bytes[i + j];
+		dst += run;
+		i += run;
+		if (i == len)
+			break;
+
 		uint32 chr = 0;
 		uint num = 1;
 
-		if ((src[i] & 0xF8) == 0xF0) {
+		if ((bytes[i] & 0xF8) == 0xF0) {
 			num = 4;
-		} else if ((src[i] & 0xF0) == 0xE0) {
+		} else if ((bytes[i] & 0xF0) == 0xE0) {
 			num = 3;
-		} else if ((src[i] & 0xE0) == 0xC0) {
+		} else if ((bytes[i] & 0xE0) == 0xC0) {
 			num = 2;
 		}
 
-		if (len - i >= num) {
-			switch (num) {
-			case 4:
-				chr |= (src[i++] & 0x07) << 18;
-				chr |= (src[i++] & 0x3F) << 12;
-				chr |= (src[i++] & 0x3F) << 6;
-				chr |= (src[i++] & 0x3F);
-				break;
-
-			case 3:
-				chr |= (src[i++] & 0x0F) << 12;
-				chr |= (src[i++] & 0x3F) << 6;
-				chr |= (src[i++] & 0x3F);
-				break;
-
-			case 2:
-				chr |= (src[i++] & 0x1F) << 6;
-				chr |= (src[i++] & 0x3F);
-				break;
-
-			default:
-				chr = (src[i++] & 0x7F);
-				break;
-			}
-		} else {
+		if (len - i < num)
+			break;
+
+		switch (num) {
+		case 4:
+			chr |= (bytes[i++] & 0x07) << 18;
+			chr |= (bytes[i++] & 0x3F) << 12;
+			chr |= (bytes[i++] & 0x3F) << 6;
+			chr |= (bytes[i++] & 0x3F);
+			break;
+
+		case 3:
+			chr |= (bytes[i++] & 0x0F) << 12;
+			chr |= (bytes[i++] & 0x3F) << 6;
+			chr |= (bytes[i++] & 0x3F);
+			break;
+
+		case 2:
+			chr |= (bytes[i++] & 0x1F) << 6;
+			chr |= (bytes[i++] & 0x3F);
+			break;
+
+		default:
+			chr = (bytes[i++] & 0x7F);
 			break;
 		}
 
-		operator+=(chr);
+		*dst++ = chr;
 	}
+
+	_size = dst - _str;
+	_str[_size] = 0;
 }
 
 const uint16 invalidCode = 0xFFFD;
@@ -834,20 +883,43 @@ StringEncodingResult String::encodeJohab(const U32String &src, char errorChar) {
 //
 // More comprehensive one lives in wintermute/utils/convert_utf.cpp
 StringEncodingResult String::encodeUTF8(const U32String &src, char errorChar) {
-	ensureCapacity(src.size(), false);
+	const U32String::value_type *chars = src.c_str();
+	const uint32 len = src.size();
+
+	// Size the output exactly, so that it is allocated once.
+	uint32 outLen = 0;
+	for (uint32 i = 0; i < len; i++) {
+		const uint32 ch = chars[i];
+		if (ch < 0x80)
+			outLen += 1;
+		else if (ch < 0x800)
+			outLen += 2;
+		else if (ch < 0x10000 || ch > 0x0010FFFF)
+			outLen += 3;
+		else
+			outLen += 4;
+	}
+	ensureCapacity(_size + outLen, true);
+
 	static const uint8 firstByteMark[5] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0 };
-	char writingBytes[5] = {0x00, 0x00, 0x00, 0x00, 0x00};
+	char *dst = _str + _size;
 
 	uint i = 0;
-	while (i < src.size()) {
+	while (i < len) {
+		const uint32 run = asciiRunLength(chars + i, len - i);
+		for (uint32 j = 0; j < run; j++)
+			dst[j] = (char)chars[i + j];
+		dst += run;
+		i += run;
+		if (i == len)
+			break;
+
 		unsigned short bytesToWrite = 0;
 		const uint32 byteMask = 0xBF;
 		const uint32 byteMark = 0x80;
 
-		uint32 ch = src[i++];
-		if (ch < (uint32)0x80) {
-			bytesToWrite = 1;
-		} else if (ch < (uint32)0x800) {
+		uint32 ch = chars[i++];
+		if (ch < (uint32)0x800) {
 			bytesToWrite = 2;
 		} else if (ch < (uint32)0x10000) {
 			bytesToWrite = 3;
@@ -858,31 +930,30 @@ StringEncodingResult String::encodeUTF8(const U32String &src, char errorChar) {
 			ch = invalidCode;
 		}
 
-		char *pBytes = writingBytes + (4 - bytesToWrite);
-
 		switch (bytesToWrite) {
 		case 4:
-			pBytes[3] = (char)((ch | byteMark) & byteMask);
+			dst[3] = (char)((ch | byteMark) & byteMask);
 			ch >>= 6;
 			// fallthrough
 		case 3:
-			pBytes[2] = (char)((ch | byteMark) & byteMask);
+			dst[2] = (char)((ch | byteMark) & byteMask);
 			ch >>= 6;
 			// fallthrough
 		case 2:
-			pBytes[1] = (char)((ch | byteMark) & byteMask);
+			dst[1] = (char)((ch | byteMark) & byteMask);
 			ch >>= 6;
-			// fallthrough
-		case 1:
-			pBytes[0] = (char)(ch | firstByteMark[bytesToWrite]);
+			dst[0] = (char)(ch | firstByteMark[bytesToWrite]);
 			break;
 		default:
 			break;
 		}
 
-		operator+=(pBytes);
+		dst += bytesToWrite;
 	}
 
+	_size = dst - _str;
+	_str[_size] = 0;
+
 	return kStringEncodingResultSucceeded;
 }
 
@@ -1048,15 +1119,24 @@ void U32String::decodeOneByte(const char *src, uint32 len, CodePage page) {
 
 	ensureCapacity(len, false);
 
-	for (uint i = 0; i < len; ++i) {
-		if ((src[i] & 0x80) == 0) {
-			operator+=(src[i]);
-			continue;
-		}
+	const byte *bytes = (const byte *)src;
+	value_type *dst = _str + _size;
 
-		uint16 val = conversionTable[src[i] & 0x7f];
-		operator+=(val ? val : invalidCode);
+	for (uint i = 0; i < len;) {
+		const uint32 run = asciiRunLength(bytes + i, len - i);
+		for (uint32 j = 0; j < run; j++)
+			dst[j] = bytes[i + j];
+		dst += run;
+		i += run;
+		if (i == len)
+			break;
+
+		uint16 val = conversionTable[bytes[i++] & 0x7f];
+		*dst++ = val ? val : invalidCode;
 	}
+
+	_size = dst - _str;
+	_str[_size] = 0;
 }
 
 StringEncodingResult String::encodeOneByte(const U32String &src, CodePage page, bool transliterate, char errorChar) {
@@ -1065,44 +1145,37 @@ StringEncodingResult String::encodeOneByte(const U32String &src, CodePage page,
 	const ReverseTablePrefixTreeLevel1 *conversionTable =
 		getReverseConversionTable(page);
 
-	ensureCapacity(src.size(), false);
+	const U32String::value_type *chars = src.c_str();
+	const uint32 len = src.size();
 
-	if (conversionTable == nullptr) {
-		for (uint i = 0; i < src.size(); ++i) {
-			uint32 c = src[i];
-			if (c <= 0x7F) {
-				operator+=((char)c);
-				continue;
-			}
+	// Transliteration writes one character at most, so this is enough
+	// room for the whole string. Characters are stored directly, and
+	// only transliteration goes through operator+=.
+	ensureCapacity(_size + len, true);
 
-			if (transliterate) {
-				StringEncodingResult translitResult = translitChar(c, errorChar);
-				if (translitResult != kStringEncodingResultSucceeded)
-					encodingResult = translitResult;
-			} else {
-				operator+=(errorChar);
-				encodingResult = kStringEncodingResultHasErrors;
-			}
-		}
-		return encodingResult;
-	}
+	for (uint i = 0; i < len;) {
+		const uint32 run = asciiRunLength(chars + i, len - i);
+		for (uint32 j = 0; j < run; j++)
+			_str[_size + j] = (char)chars[i + j];
+		_size += run;
+		i += run;
+		if (i == len)
+			break;
 
-	for (uint i = 0; i < src.size(); ++i) {
-		uint32 c = src[i];
-		if (c <= 0x7F) {
-			operator+=((char)c);
-			continue;
-		}
+		uint32 c = chars[i++];
 
-		if (c >= kMaxCharSingleByte)
-			continue;
-		ReverseTablePrefixTreeLevel2 *l2 = conversionTable->next[c>>8];
-		unsigned char uc = l2 ? l2->end[c&0xff] : 0;
-		if (uc != 0) {
-			operator+=((char)uc);
-			continue;
+		if (conversionTable != nullptr) {
+			if (c >= kMaxCharSingleByte)
+				continue;
+			ReverseTablePrefixTreeLevel2 *l2 = conversionTable->next[c>>8];
+			unsigned char uc = l2 ? l2->end[c&0xff] : 0;
+			if (uc != 0) {
+				_str[_size++] = (char)uc;
+				continue;
+			}
 		}
 
+		_str[_size] = 0;
 		if (transliterate) {
 			StringEncodingResult translitResult = translitChar(c, errorChar);
 			if (translitResult != kStringEncodingResultSucceeded)
@@ -1113,6 +1186,8 @@ StringEncodingResult String::encodeOneByte(const U32String &src, CodePage page,
 		}
 	}
 
+	_str[_size] = 0;
+
 	return encodingResult;
 }
 
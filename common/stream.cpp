@@ -24,6 +24,10 @@
 #include "common/memstream.h"
 #include "common/substream.h"
 #include "common/str.h"
+#include "common/bufferedstream.h"
+#include "common/mutex.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace Common {
 
@@ -480,6 +484,176 @@ SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStr
 
 #pragma mark -
 
+struct PrefetchingSeekableReadStream::Block : public Job {
+	PrefetchingSeekableReadStream *owner;
+	TaskGroup group;
+	byte *data;
+	int64 offset;	///< Offset of the block in the stream, or -1 if unused
+	uint32 length;	///< Number of valid bytes, once ready
+	bool ready;		///< Protected by the parent mutex
+
+	Block(PrefetchingSeekableReadStream *o, uint32 blockSize) :
+		owner(o), group(g_system->getThreadPool()), offset(-1), length(0), ready(false) {
+		data = (byte *)malloc(blockSize);
+	}
+
+	~Block() override {
+		group.wait();
+		free(data);
+	}
+
+	void run() override {
+		owner->fillBlock(this);
+	}
+};
+
+PrefetchingSeekableReadStream::PrefetchingSeekableReadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream), _disposeParentStream(disposeParentStream),
+	  _blockSize(blockSize), _numBlocks(MAX<uint32>(numBlocks, 2)),
+	  _pos(0), _eos(false), _err(false), _hits(0), _misses(0) {
+	assert(parentStream);
+	assert(blockSize > 0);
+
+	_parentMutex = new Mutex();
+
+	// The parent is only accessed by the blocks from now on, under the mutex
+	_pos = _parentStream->pos();
+	_size = _parentStream->size();
+
+	_blocks = new Block *[_numBlocks];
+	for (uint32 i = 0; i < _numBlocks; ++i)
+		_blocks[i] = new Block(this, _blockSize);
+}
+
+PrefetchingSeekableReadStream::~PrefetchingSeekableReadStream() {
+	for (uint32 i = 0; i < _numBlocks; ++i)
+		delete _blocks[i];
+	delete[] _blocks;
+	delete _parentMutex;
+
+	if (_disposeParentStream)
+		delete _parentStream;
+}
+
+void PrefetchingSeekableReadStream::fillBlock(Block *block) {
+	StackLock lock(*_parentMutex);
+
+	uint32 length = 0;
+	if (_parentStream->seek(block->offset, SEEK_SET))
+		length = _parentStream->read(block->data, _blockSize);
+
+	if (_parentStream->err()) {
+		_parentStream->clearErr();
+		_err = true;
+	}
+
+	block->length = length;
+	block->ready = true;
+}
+
+PrefetchingSeekableReadStream::Block *PrefetchingSeekableReadStream::request(int64 blockOffset) {
+	// Blocks are direct-mapped, so consecutive blocks never evict each other.
+	Block *block = _blocks[(blockOffset / _blockSize) % _numBlocks];
+	if (block->offset == blockOffset)
+		return block;
+
+	// Recycle the slot; a read into it may still be in flight.
+	block->group.wait();
+	block->offset = blockOffset;
+	block->ready = false;
+	block->group.run(block);
+	return block;
+}
+
+uint32 PrefetchingSeekableReadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+
+	while (dataSize > 0 && _pos < _size) {
+		const int64 blockOffset = _pos - _pos % _blockSize;
+		Block *block = request(blockOffset);
+
+		// Keep the following blocks in flight
+		for (uint32 i = 1; i < _numBlocks; ++i) {
+			const int64 ahead = blockOffset + (int64)i * _blockSize;
+			if (ahead >= _size)
+				break;
+			request(ahead);
+		}
+
+		bool ready;
+		{
+			StackLock lock(*_parentMutex);
+			ready = block->ready;
+		}
+		if (ready)
+			_hits++;
+		else
+			_misses++;
+		block->group.wait();
+
+		const uint32 skip = _pos - blockOffset;
+		if (block->length <= skip)
+			break;
+
+		const uint32 n = MIN(block->length - skip, dataSize);
+		memcpy(dst, block->data + skip, n);
+		dst += n;
+		total += n;
+		dataSize -= n;
+		_pos += n;
+
+		// A short block means the parent hit its end or an error
+		if (block->length < _blockSize)
+			break;
+	}
+
+	if (dataSize > 0)
+		_eos = true;
+
+	return total;
+}
+
+bool PrefetchingSeekableReadStream::seek(int64 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset = _size + offset;
+		// fall through
+	case SEEK_SET:
+	default:
+		_pos = offset;
+		break;
+	case SEEK_CUR:
+		_pos += offset;
+		break;
+	}
+
+	_pos = CLIP<int64>(_pos, 0, _size);
+	_eos = false;
+	return true;
+}
+
+void PrefetchingSeekableReadStream::hintSeek(int64 offset) {
+	if (offset < 0 || offset >= _size)
+		return;
+
+	const int64 blockOffset = offset - offset % _blockSize;
+	for (uint32 i = 0; i < _numBlocks; ++i) {
+		const int64 ahead = blockOffset + (int64)i * _blockSize;
+		if (ahead >= _size)
+			break;
+		request(ahead);
+	}
+}
+
+PrefetchingSeekableReadStream *wrapPrefetchingSeekableReadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new PrefetchingSeekableReadStream(parentStream, blockSize, numBlocks, disposeParentStream);
+	return nullptr;
+}
+
+#pragma mark -
+
 namespace {
 
 /**
@@ -33,6 +33,7 @@
 #include "common/str-enc.h"
 #include "common/textconsole.h"
 #include "common/text-to-speech.h"
+#include "common/threadpool.h"
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/fs/fs-factory.h"
@@ -56,6 +57,7 @@ OSystem::OSystem() {
 	_dialogManager = nullptr;
 #endif
 	_fsFactory = nullptr;
+	_threadPool = nullptr;
 	_backendInitialized = false;
 }
 
@@ -115,12 +117,28 @@ void OSystem::initBackend() {
 }
 
 void OSystem::destroy() {
+	// Saves may still be written in the background on the thread pool
+	delete _savefileManager;
+	_savefileManager = nullptr;
+
+	// The workers must be joined while the backend thread support is still alive
+	delete _threadPool;
+	_threadPool = nullptr;
+
 	_backendInitialized = false;
 	Common::String::releaseMemoryPoolMutex();
 	Common::releaseCJKTables();
 	delete this;
 }
 
+Common::ThreadPool &OSystem::getThreadPool() {
+	if (!_threadPool) {
+		const uint cpus = getCPUCount();
+		_threadPool = new Common::ThreadPool(cpus > 1 ? cpus - 1 : 0);
+	}
+	return *_threadPool;
+}
+
 void OSystem::updateStartSettings(const Common::String &executable, Common::String &command, Common::StringMap &settings, Common::StringArray& additionalArgs) {
 	// If a command was explicitly passed on the command line, do not override it
 	if (!command.empty())
@@ -29,6 +29,7 @@
 #include "common/ustr.h"
 #include "common/str-array.h" // For OSystem::updateStartSettings()
 #include "common/hash-str.h" // For OSystem::updateStartSettings()
+#include "common/thread.h" // For OSystem::createThread()
 #include "graphics/pixelformat.h"
 #include "graphics/mode.h"
 #include "graphics/opengl/context.h"
@@ -49,6 +50,9 @@ class OptionsContainerWidget;
 namespace Common {
 class EventManager;
 class MutexInternal;
+class SemaphoreInternal;
+class ThreadInternal;
+class ThreadPool;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
@@ -269,6 +273,11 @@ protected:
 	 */
 	Common::U32String _clipboard;
 
+	/**
+	 * Lazily created by getThreadPool() and deleted by destroy().
+	 */
+	Common::ThreadPool *_threadPool;
+
 	/** Workaround for a bug in the osx_intel toolchain introduced by
 	 * 014bef9eab9fb409cfb3ec66830e033e4aaa29a9. Adding this variable fixes it.
 	 */
@@ -548,7 +557,22 @@ public:
 		/**
 		* For platforms that should not have a Quit button.
 		*/
-		kFeatureNoQuit
+		kFeatureNoQuit,
+
+		/**
+		* The CPU supports the SSE2 instruction set extension.
+		*/
+		kCpuFeatureSSE2,
+
+		/**
+		* The CPU supports the AVX2 instruction set extension.
+		*/
+		kCpuFeatureAVX2,
+
+		/**
+		* The CPU supports the NEON instruction set extension.
+		*/
+		kCpuFeatureNEON
 	};
 
 	/**
@@ -1082,6 +1106,16 @@ public:
 	 */
 	virtual int16 getWidth() = 0;
 
+	/**
+	 * Return the refresh rate of the display the screen is shown on.
+	 *
+	 * This allows to pace frames to the vertical sync when
+	 * kFeatureVSync is enabled.
+	 *
+	 * @return Refresh rate in Hz, or 0 if it is not known.
+	 */
+	virtual uint getDisplayRefreshRate() { return 0; }
+
 	/**
 	 * Return the palette manager singleton.
 	 *
@@ -1415,6 +1449,16 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since an arbitrary point in time, at
+	 * the best resolution the system offers. This is meant for measuring
+	 * short intervals, as done by Common::Profiler, and is never recorded
+	 * by the event recorder.
+	 *
+	 * The default implementation is based on getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1503,6 +1547,59 @@ public:
 	/** @} */
 
 
+	/**
+	 * @defgroup common_system_threads Thread handling
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Optional support for native threads, used by Common::ThreadPool to
+	 * spread CPU heavy work such as scaling or video decoding over several
+	 * cores. Backends that do not implement these methods keep the default
+	 * implementations, in which case all jobs run on the calling thread.
+	 *
+	 * Code outside of common/ should use getThreadPool() rather than
+	 * creating threads itself.
+	 */
+
+	/**
+	 * Create and start a new thread.
+	 *
+	 * @param proc   Entry point of the thread.
+	 * @param param  Parameter passed to @p proc.
+	 * @param name   Name of the thread, for debugging purposes.
+	 *
+	 * @return The newly created thread, or nullptr if threads are not supported
+	 *         or an error occurred.
+	 */
+	virtual Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param, const char *name) { return nullptr; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @param initialCount  Initial value of the semaphore.
+	 *
+	 * @return The newly created semaphore, or nullptr if threads are not supported
+	 *         or an error occurred.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount) { return nullptr; }
+
+	/**
+	 * Return the number of logical CPU cores available to ScummVM.
+	 */
+	virtual uint getCPUCount() { return 1; }
+
+	/**
+	 * Return the shared thread pool, creating it on first use.
+	 *
+	 * The pool has one worker less than getCPUCount() since the thread
+	 * waiting for the jobs helps running them. It is destroyed in destroy(),
+	 * before the backend is torn down.
+	 */
+	Common::ThreadPool &getThreadPool();
+
+	/** @} */
+
+
 
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
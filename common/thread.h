@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_thread Threads
+ * @ingroup common
+ *
+ * @brief Low-level thread primitives supplied by the backend.
+ *
+ * Engines and common code should not use these directly; use
+ * Common::ThreadPool instead, which degrades gracefully to running
+ * work on the calling thread when the backend has no thread support.
+ *
+ * @{
+ */
+
+/** Entry point of a thread created through OSystem::createThread(). */
+typedef void (*ThreadProc)(void *param);
+
+/**
+ * A native thread, as returned by OSystem::createThread().
+ *
+ * Deleting the object without calling join() first is only allowed
+ * once the thread has already returned from its entry point.
+ */
+class ThreadInternal {
+public:
+	virtual ~ThreadInternal() {}
+
+	/** Wait until the thread has returned from its entry point. */
+	virtual bool join() = 0;
+};
+
+/**
+ * A counting semaphore, as returned by OSystem::createSemaphore().
+ */
+class SemaphoreInternal {
+public:
+	virtual ~SemaphoreInternal() {}
+
+	/** Block until the count is non-zero, then decrement it. */
+	virtual bool wait() = 0;
+
+	/** Increment the count, waking up one waiting thread if any. */
+	virtual bool post() = 0;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,322 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+/**
+ * Growable ring buffer of jobs. The owning worker pushes and pops at
+ * the back, thieves take from the front.
+ */
+class ThreadPool::JobDeque {
+	Array<Job *> _ring;
+	uint _head;
+	uint _count;
+
+	void grow() {
+		Array<Job *> ring;
+		ring.resize(_ring.empty() ? 16 : _ring.size() * 2);
+		for (uint i = 0; i < _count; ++i)
+			ring[i] = _ring[(_head + i) % _ring.size()];
+		_ring.swap(ring);
+		_head = 0;
+	}
+
+public:
+	JobDeque() : _head(0), _count(0) {}
+
+	bool empty() const { return _count == 0; }
+
+	void pushBack(Job *job) {
+		if (_count == _ring.size())
+			grow();
+		_ring[(_head + _count) % _ring.size()] = job;
+		++_count;
+	}
+
+	Job *popBack() {
+		if (_count == 0)
+			return nullptr;
+		--_count;
+		return _ring[(_head + _count) % _ring.size()];
+	}
+
+	Job *popFront() {
+		if (_count == 0)
+			return nullptr;
+		Job *job = _ring[_head];
+		_head = (_head + 1) % _ring.size();
+		--_count;
+		return job;
+	}
+};
+
+struct ThreadPool::Worker {
+	ThreadPool *pool;
+	uint index;
+	ThreadInternal *thread;
+	Mutex mutex;
+	JobDeque jobs;
+};
+
+ThreadPool::ThreadPool(uint numWorkers) : _jobsAvailable(nullptr), _nextWorker(0), _quit(false) {
+	if (numWorkers == 0)
+		return;
+
+	_jobsAvailable = g_system->createSemaphore(0);
+	if (!_jobsAvailable)
+		return;
+
+	for (uint i = 0; i < numWorkers; ++i) {
+		Worker *worker = new Worker();
+		worker->pool = this;
+		worker->index = i;
+
+		// Workers only look at _workers after being woken up by a job,
+		// and no job can be pushed before the constructor returns.
+		_workers.push_back(worker);
+		worker->thread = g_system->createThread(&workerProc, worker, "ScummVM worker");
+		if (!worker->thread) {
+			_workers.pop_back();
+			delete worker;
+			break;
+		}
+	}
+
+	if (_workers.empty()) {
+		delete _jobsAvailable;
+		_jobsAvailable = nullptr;
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	if (_workers.empty())
+		return;
+
+	_quit = true;
+	for (uint i = 0; i < _workers.size(); ++i)
+		_jobsAvailable->post();
+
+	for (uint i = 0; i < _workers.size(); ++i) {
+		_workers[i]->thread->join();
+		delete _workers[i]->thread;
+	}
+
+	for (uint i = 0; i < _workers.size(); ++i) {
+		if (!_workers[i]->jobs.empty())
+			warning("ThreadPool: destroyed with jobs still queued");
+		delete _workers[i];
+	}
+
+	delete _jobsAvailable;
+}
+
+void ThreadPool::workerProc(void *param) {
+	Worker *self = (Worker *)param;
+	ThreadPool *pool = self->pool;
+
+	for (;;) {
+		pool->_jobsAvailable->wait();
+		if (pool->_quit)
+			break;
+
+		// The semaphore count only approximates the number of queued jobs,
+		// since waiting threads also take jobs. An empty take is harmless.
+		Job *job = pool->take(self->index);
+		if (job)
+			pool->execute(job);
+	}
+}
+
+void ThreadPool::push(Job *job) {
+	Worker *worker;
+	{
+		StackLock lock(_groupMutex);
+		worker = _workers[_nextWorker];
+		_nextWorker = (_nextWorker + 1) % _workers.size();
+	}
+
+	{
+		StackLock lock(worker->mutex);
+		worker->jobs.pushBack(job);
+	}
+
+	_jobsAvailable->post();
+}
+
+Job *ThreadPool::take(uint self) {
+	const uint count = _workers.size();
+
+	if (self < count) {
+		Worker *worker = _workers[self];
+		StackLock lock(worker->mutex);
+		Job *job = worker->jobs.popBack();
+		if (job)
+			return job;
+	}
+
+	// Steal from the other workers, starting with our neighbour so that
+	// thieves spread out over the victims.
+	const uint start = (self < count) ? self + 1 : 0;
+	for (uint i = 0; i < count; ++i) {
+		Worker *victim = _workers[(start + i) % count];
+		if (victim->index == self)
+			continue;
+
+		StackLock lock(victim->mutex);
+		Job *job = victim->jobs.popFront();
+		if (job)
+			return job;
+	}
+
+	return nullptr;
+}
+
+void ThreadPool::execute(Job *job) {
+	TaskGroup *group = job->_group;
+
+	job->run();
+
+	StackLock lock(_groupMutex);
+	assert(group->_pending > 0);
+	if (--group->_pending == 0 && group->_waiting)
+		group->_done->post();
+}
+
+namespace {
+
+struct RangeJob : public Job {
+	ParallelForProc proc;
+	void *param;
+	uint first, last;
+
+	void run() override {
+		proc(param, first, last);
+	}
+};
+
+} // End of anonymous namespace
+
+void ThreadPool::parallelFor(uint begin, uint end, uint grain, ParallelForProc proc, void *param) {
+	if (begin >= end)
+		return;
+
+	const uint total = end - begin;
+	if (grain == 0)
+		grain = 1;
+
+	// A few chunks per thread keep the load balanced without making the
+	// per-job overhead dominate.
+	uint chunks = (total + grain - 1) / grain;
+	chunks = MIN<uint>(chunks, getConcurrency() * 4);
+
+	if (chunks <= 1 || _workers.empty()) {
+		proc(param, begin, end);
+		return;
+	}
+
+	Array<RangeJob> jobs;
+	jobs.resize(chunks);
+
+	const uint chunkSize = total / chunks;
+	const uint remainder = total % chunks;
+	uint first = begin;
+	for (uint i = 0; i < chunks; ++i) {
+		const uint size = chunkSize + (i < remainder ? 1 : 0);
+		jobs[i].proc = proc;
+		jobs[i].param = param;
+		jobs[i].first = first;
+		jobs[i].last = first + size;
+		first += size;
+	}
+
+	TaskGroup group(*this);
+	// The calling thread takes the first chunk itself.
+	for (uint i = 1; i < chunks; ++i)
+		group.run(&jobs[i]);
+	jobs[0].run();
+	group.wait();
+}
+
+
+#pragma mark -
+
+
+TaskGroup::TaskGroup(ThreadPool &pool) : _pool(pool), _pending(0), _waiting(false), _done(nullptr) {
+	if (_pool.getWorkerCount() > 0)
+		_done = g_system->createSemaphore(0);
+}
+
+TaskGroup::~TaskGroup() {
+	wait();
+	delete _done;
+}
+
+void TaskGroup::run(Job *job) {
+	if (!_done) {
+		job->run();
+		return;
+	}
+
+	job->_group = this;
+	{
+		StackLock lock(_pool._groupMutex);
+		++_pending;
+	}
+	_pool.push(job);
+}
+
+void TaskGroup::wait() {
+	if (!_done)
+		return;
+
+	for (;;) {
+		{
+			StackLock lock(_pool._groupMutex);
+			if (_pending == 0)
+				return;
+		}
+
+		// Help out instead of blocking while there is queued work. This may
+		// run jobs of other groups, which is fine as they make progress too.
+		Job *job = _pool.take((uint)-1);
+		if (!job)
+			break;
+		_pool.execute(job);
+	}
+
+	{
+		StackLock lock(_pool._groupMutex);
+		if (_pending == 0)
+			return;
+		_waiting = true;
+	}
+
+	_done->wait();
+
+	StackLock lock(_pool._groupMutex);
+	_waiting = false;
+}
+
+} // End of namespace Common
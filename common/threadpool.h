@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief Portable worker-thread pool with task groups and parallelFor.
+ *
+ * The pool is built on top of the thread primitives provided by
+ * OSystem::createThread() and OSystem::createSemaphore(). On backends
+ * without thread support the pool has no workers and all work runs
+ * synchronously on the calling thread, so callers never need a separate
+ * single-threaded code path.
+ *
+ * Each worker owns a deque of jobs. Workers take jobs from the back of
+ * their own deque and steal from the front of the other workers' deques
+ * when they run out. Threads waiting on a TaskGroup help by running
+ * queued jobs until the group has completed.
+ *
+ * @{
+ */
+
+class TaskGroup;
+class ThreadPool;
+
+/**
+ * A unit of work that can be scheduled on a ThreadPool.
+ *
+ * The job object is owned by the caller and must stay alive until
+ * the TaskGroup it was submitted to has been waited on.
+ */
+class Job {
+	friend class TaskGroup;
+	friend class ThreadPool;
+
+	TaskGroup *_group;
+
+public:
+	Job() : _group(nullptr) {}
+	virtual ~Job() {}
+
+	virtual void run() = 0;
+};
+
+/**
+ * A set of jobs that can be waited on as a whole.
+ *
+ * The destructor waits for all outstanding jobs.
+ */
+class TaskGroup : NonCopyable {
+	friend class ThreadPool;
+
+	ThreadPool &_pool;
+	uint _pending;
+	bool _waiting;
+	SemaphoreInternal *_done;
+
+public:
+	explicit TaskGroup(ThreadPool &pool);
+	~TaskGroup();
+
+	/**
+	 * Schedule a job. If the pool has no workers, the job runs
+	 * immediately on the calling thread.
+	 */
+	void run(Job *job);
+
+	/**
+	 * Wait until all jobs scheduled in this group have completed.
+	 * The calling thread executes queued jobs while it waits.
+	 */
+	void wait();
+};
+
+/**
+ * Callback type used by the non-template ThreadPool::parallelFor().
+ * It is called with the half-open range [first, last).
+ */
+typedef void (*ParallelForProc)(void *param, uint first, uint last);
+
+class ThreadPool : NonCopyable {
+	friend class TaskGroup;
+
+	class JobDeque;
+	struct Worker;
+
+	Array<Worker *> _workers;
+	SemaphoreInternal *_jobsAvailable;
+	Mutex _groupMutex;
+	uint _nextWorker;
+	bool _quit;
+
+	static void workerProc(void *param);
+
+	void push(Job *job);
+	Job *take(uint self);
+	void execute(Job *job);
+
+	template<class F>
+	static void parallelForTrampoline(void *param, uint first, uint last) {
+		(*(const F *)param)(first, last);
+	}
+
+public:
+	/**
+	 * Create a pool with up to @p numWorkers worker threads.
+	 *
+	 * Fewer workers are created if the backend fails to supply
+	 * threads, possibly none at all.
+	 */
+	explicit ThreadPool(uint numWorkers);
+	~ThreadPool();
+
+	/** Return the number of worker threads actually running. */
+	uint getWorkerCount() const { return _workers.size(); }
+
+	/**
+	 * Return the number of threads that can execute jobs simultaneously,
+	 * which is the worker count plus the thread that waits for them.
+	 */
+	uint getConcurrency() const { return _workers.size() + 1; }
+
+	/**
+	 * Split [begin, end) into chunks of at least @p grain elements,
+	 * run @p proc on every chunk and wait for all chunks to complete.
+	 */
+	void parallelFor(uint begin, uint end, uint grain, ParallelForProc proc, void *param);
+
+	/**
+	 * Convenience overload taking any callable with the signature
+	 * <tt>void (uint first, uint last)</tt>, such as a lambda.
+	 */
+	template<class F>
+	void parallelFor(uint begin, uint end, uint grain, const F &body) {
+		parallelFor(begin, end, grain, &parallelForTrampoline<F>, const_cast<F *>(&body));
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -23,6 +23,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -69,6 +70,24 @@ public:
 	 * of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Scheduling statistics of an installed timer.
+	 */
+	struct TimerStats {
+		String id;            ///< ID the timer was installed with.
+		int32 interval;       ///< Interval of the timer (in microseconds).
+		uint32 calls;         ///< Number of times the callback was invoked.
+		uint32 overruns;      ///< Number of calls which were late by a whole interval or more.
+		uint32 maxLateness;   ///< Longest delay of a call after its due time (in milliseconds).
+	};
+
+	/**
+	 * Return the scheduling statistics of all installed timers.
+	 *
+	 * @return false if the timer manager does not keep statistics.
+	 */
+	virtual bool getTimerStats(Array<TimerStats> &stats) { return false; }
 };
 
 /** @} */
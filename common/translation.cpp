@@ -28,6 +28,7 @@
 
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/endian.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/system.h"
@@ -124,7 +125,7 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 		const int midIndex = (leftIndex + rightIndex) / 2;
 		const PoMessageEntry *const m = &_currentTranslationMessages[midIndex];
 
-		int compareResult = strcmp(message, _messageIds[m->msgid].c_str());
+		int compareResult = strcmp(message, &_messageIdData[_messageIdOffsets[m->msgid]]);
 
 		if (compareResult == 0) {
 			// Get the range of messages with the same ID (but different context)
@@ -143,17 +144,17 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 			}
 			// Find the context we want
 			if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
-				return _currentTranslationMessages[leftIndex].msgstr;
+				return getMessageString(_currentTranslationMessages[leftIndex]);
 			// We could use again binary search, but there should be only a small number of contexts.
 			while (rightIndex > leftIndex) {
-				compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt.c_str());
+				compareResult = strcmp(context, &_currentTranslationData[_currentTranslationMessages[rightIndex].msgctxt]);
 				if (compareResult == 0)
-					return _currentTranslationMessages[rightIndex].msgstr;
+					return getMessageString(_currentTranslationMessages[rightIndex]);
 				else if (compareResult > 0)
 					break;
 				--rightIndex;
 			}
-			return _currentTranslationMessages[leftIndex].msgstr;
+			return getMessageString(_currentTranslationMessages[leftIndex]);
 		} else if (compareResult < 0)
 			rightIndex = midIndex - 1;
 		else
@@ -163,6 +164,17 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 	return U32String(message);
 }
 
+U32String TranslationManager::getMessageString(const PoMessageEntry &entry) const {
+	const uint index = &entry - &_currentTranslationMessages[0];
+
+	if (!_isDecoded[index]) {
+		_decodedMessages[index] = String(&_currentTranslationData[entry.msgstr], entry.msgstrLength).decode();
+		_isDecoded[index] = true;
+	}
+
+	return _decodedMessages[index];
+}
+
 String TranslationManager::getCurrentLanguage() const {
 	if (_currentLang == -1)
 		return "en";
@@ -289,10 +301,14 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 	// Get number of translations
 	int nbTranslations = in.readUint16BE();
 
-	// Skip translation description & size for the original language (english) block
+	// Skip translation description size, and remember the size of the
+	// original language (english) block holding the message IDs.
 	// Also skip size of each translation block. Each block is written in Uint32BE.
+	uint32 messageIdsSize = 0;
 	for (int i = 0; i < nbTranslations + 2; i++) {
-		in.readUint32BE();
+		const uint32 blockSize = in.readUint32BE();
+		if (i == 1)
+			messageIdsSize = blockSize;
 	}
 
 	// Read list of languages
@@ -307,23 +323,44 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 		_langNames[i] = String(buf, len - 1).decode();
 	}
 
-	// Read messages
-	int numMessages = in.readUint16BE();
-	_messageIds.resize(numMessages);
+	// Read messages. The block is kept as is and only the offsets of the
+	// (null terminated) strings in it are stored.
+	_messageIdData.resize(messageIdsSize + 1);
+	if (messageIdsSize < 2 || in.read(&_messageIdData[0], messageIdsSize) != messageIdsSize) {
+		warning("Corrupted '%s' file. GUI translation will not be available", name.c_str());
+		_messageIdData.clear();
+		_langs.clear();
+		_langNames.clear();
+		return;
+	}
+	_messageIdData[messageIdsSize] = '\0';
+
+	const byte *data = (const byte *)&_messageIdData[0];
+	int numMessages = READ_BE_UINT16(data);
+	uint32 pos = 2;
+	_messageIdOffsets.resize(numMessages);
 	for (int i = 0; i < numMessages; ++i) {
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_messageIds[i] = msg;
+		if (pos + 2 > messageIdsSize)
+			break;
+		len = READ_BE_UINT16(data + pos);
+		_messageIdOffsets[i] = pos + 2;
+		pos += 2 + len;
+	}
+
+	if (pos > messageIdsSize) {
+		warning("Corrupted '%s' file. GUI translation will not be available", name.c_str());
+		_messageIdData.clear();
+		_messageIdOffsets.clear();
+		_langs.clear();
+		_langNames.clear();
 	}
 }
 
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
+	_currentTranslationData.clear();
+	_decodedMessages.clear();
+	_isDecoded.clear();
 	_currentCharset.clear();
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
@@ -336,9 +373,6 @@ void TranslationManager::loadLanguageDat(int index) {
 	if (!openTranslationsFile(in))
 		return;
 
-	char buf[1024];
-	int len;
-
 	// Get number of translations
 	int nbTranslations = in.readUint16BE();
 	if (nbTranslations != (int)_langs.size()) {
@@ -354,35 +388,69 @@ void TranslationManager::loadLanguageDat(int index) {
 	for (int i = 0; i < index + 2; ++i)
 		skipSize += in.readUint32BE();
 
+	// Then comes the size of the block we want
+	const uint32 blockSize = in.readUint32BE();
+
 	// We also need to skip the remaining block sizes
-	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
+	skipSize += 4 * (nbTranslations - index - 1);	// 4 because block sizes are written in Uint32BE in the .dat file.
 
 	// Seek to start of block we want to read
 	in.seek(skipSize, SEEK_CUR);
 
+	// Read the whole block at once. Only the offsets of the strings in it
+	// are stored here, the messages are decoded when they are first used.
+	// An extra null byte is added for contexts which have been left out.
+	_currentTranslationData.resize(blockSize + 1);
+	if (blockSize < 2 || in.read(&_currentTranslationData[0], blockSize) != blockSize) {
+		warning("Corrupted '%s' file. GUI translation will not be available", _translationsFileName.c_str());
+		_currentTranslationData.clear();
+		return;
+	}
+	_currentTranslationData[blockSize] = '\0';
+
+	const byte *data = (const byte *)&_currentTranslationData[0];
+
 	// Read number of translated messages
-	int nbMessages = in.readUint16BE();
+	int nbMessages = READ_BE_UINT16(data);
+	uint32 pos = 2;
 	_currentTranslationMessages.resize(nbMessages);
 
-	_currentCharset = "UTF-32";
-
 	// Read messages
 	for (int i = 0; i < nbMessages; ++i) {
-		_currentTranslationMessages[i].msgid = in.readUint16BE();
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_currentTranslationMessages[i].msgstr = msg.decode();
-		len = in.readUint16BE();
-		if (len > 0) {
-			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
-		}
+		if (pos + 4 > blockSize)
+			break;
+
+		PoMessageEntry &entry = _currentTranslationMessages[i];
+		entry.msgid = READ_BE_UINT16(data + pos);
+		uint len = READ_BE_UINT16(data + pos + 2);
+		entry.msgstr = pos + 4;
+		entry.msgstrLength = len > 0 ? len - 1 : 0;
+		pos += 4 + len;
+
+		if (pos + 2 > blockSize)
+			break;
+
+		len = READ_BE_UINT16(data + pos);
+		entry.msgctxt = len > 0 ? pos + 2 : blockSize;
+		pos += 2 + len;
+
+		if (entry.msgid >= (int)_messageIdOffsets.size())
+			pos = blockSize + 1;
 	}
+
+	if (pos > blockSize) {
+		warning("Corrupted '%s' file. GUI translation will not be available", _translationsFileName.c_str());
+		_currentTranslationMessages.clear();
+		_currentTranslationData.clear();
+		return;
+	}
+
+	_decodedMessages.resize(nbMessages);
+	_isDecoded.resize(nbMessages);
+	for (int i = 0; i < nbMessages; ++i)
+		_isDecoded[i] = false;
+
+	_currentCharset = "UTF-32";
 }
 
 bool TranslationManager::checkHeader(File &in) {
@@ -72,13 +72,15 @@ bool operator<(const TLanguage &l, const TLanguage &r);
 typedef Array<TLanguage> TLangArray;
 
 /**
- * Structure describing a translated message.
+ * Structure describing a translated message. The strings are kept in the
+ * language block as read from the translations file.
  */
 struct PoMessageEntry {
-	int msgid;         /*!< ID of the message. */
-	String msgctxt;    /*!< Context of the message. It can be empty.
+	int msgid;            /*!< ID of the message. */
+	uint32 msgctxt;       /*!< Offset of the context of the message. It can be empty.
 							Can be used to solve ambiguities. */
-	U32String msgstr;  /*!< Message string. */
+	uint32 msgstr;        /*!< Offset of the message string. */
+	uint32 msgstrLength;  /*!< Length of the message string in bytes. */
 };
 
 /**
@@ -242,8 +244,18 @@ private:
 	StringArray _langs;
 	U32StringArray _langNames;
 
-	StringArray _messageIds;
+	/**
+	 * Return the message string of @p entry, decoding it on first use.
+	 */
+	U32String getMessageString(const PoMessageEntry &entry) const;
+
+	Array<char> _messageIdData;       ///< English message block, holding the message IDs
+	Array<uint32> _messageIdOffsets;  ///< Offsets of the message IDs in _messageIdData
+
+	Array<char> _currentTranslationData;  ///< Language block of the current language
 	Array<PoMessageEntry> _currentTranslationMessages;
+	mutable Array<U32String> _decodedMessages;  ///< Decoded message strings, by message index
+	mutable Array<bool> _isDecoded;
 	String _currentCharset;
 	int _currentLang;
 	Common::String _translationsFileName;
@@ -512,6 +512,162 @@ void AdvancedMetaEngineDetection::composeFileHashMap(FileMap &allFiles, const Co
 
 namespace Common {
 	DECLARE_SINGLETON(MD5CacheManager);
+	DECLARE_SINGLETON(PersistentMD5Cache);
+}
+
+/* Persistent cache of detection MD5s */
+
+#define MD5CACHE_MAGIC MKTAG('M', 'D', '5', 'C')
+#define MD5CACHE_VERSION 1
+
+PersistentMD5Cache::PersistentMD5Cache() : _loaded(false), _dirty(false), _useCounter(0), _lastFlush(0) {
+}
+
+PersistentMD5Cache::~PersistentMD5Cache() {
+	flush(true);
+}
+
+Common::String PersistentMD5Cache::makeKey(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop) {
+	return Common::String::format("%s:%u:%d", node.getPath().c_str(), md5Bytes, (int)md5prop);
+}
+
+Common::FSNode PersistentMD5Cache::getCacheFile() const {
+	Common::FSNode dir = ConfMan.getConfigDirectory();
+	if (!dir.isDirectory())
+		return Common::FSNode();
+
+	return dir.getChild("detection-md5.cache");
+}
+
+void PersistentMD5Cache::load() {
+	_loaded = true;
+
+	Common::FSNode file = getCacheFile();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() == MD5CACHE_MAGIC && stream->readUint32LE() == MD5CACHE_VERSION) {
+		uint32 count = stream->readUint32LE();
+		for (uint32 i = 0; i < count && !stream->eos() && !stream->err(); i++) {
+			Common::String key = stream->readString(0, stream->readUint16LE());
+			Entry entry;
+			entry.md5 = stream->readString(0, stream->readByte());
+			entry.size = stream->readSint64LE();
+			entry.modificationTime = stream->readSint64LE();
+			entry.lastUse = stream->readUint32LE();
+			if (stream->eos() || stream->err())
+				break;
+			_entries[key] = entry;
+			_useCounter = MAX(_useCounter, entry.lastUse);
+		}
+	}
+
+	delete stream;
+	debugC(2, kDebugGlobalDetection, "Loaded %u cached detection MD5s", _entries.size());
+}
+
+bool PersistentMD5Cache::lookup(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop, FileProperties &fileProps) {
+	int64 size, modificationTime;
+	if (!node.getFileStats(size, modificationTime))
+		return false;
+
+	if (!_loaded)
+		load();
+
+	const Common::String key = makeKey(node, md5Bytes, md5prop);
+	if (key.size() > 0xFFFF)
+		return false;
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end())
+		return false;
+
+	// The file changed since it was hashed
+	if (it->_value.size != size || it->_value.modificationTime != modificationTime) {
+		_entries.erase(it);
+		_dirty = true;
+		return false;
+	}
+
+	it->_value.lastUse = ++_useCounter;
+	_dirty = true;
+
+	fileProps.md5 = it->_value.md5;
+	fileProps.size = size;
+	fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+	return true;
+}
+
+void PersistentMD5Cache::store(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop, const FileProperties &fileProps) {
+	Entry entry;
+	if (!node.getFileStats(entry.size, entry.modificationTime) || entry.size != fileProps.size)
+		return;
+
+	if (!_loaded)
+		load();
+
+	const Common::String key = makeKey(node, md5Bytes, md5prop);
+	if (key.size() > 0xFFFF)
+		return;
+
+	entry.md5 = fileProps.md5;
+	entry.lastUse = ++_useCounter;
+	_entries[key] = entry;
+	_dirty = true;
+
+	if (_entries.size() > kMaxEntries)
+		prune();
+}
+
+void PersistentMD5Cache::prune() {
+	// Drop the least recently used quarter of the entries
+	Common::Array<uint32> uses;
+	uses.reserve(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		uses.push_back(it->_value.lastUse);
+	Common::sort(uses.begin(), uses.end());
+	const uint32 threshold = uses[uses.size() / 4];
+
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_value.lastUse < threshold)
+			_entries.erase(it);
+	}
+}
+
+void PersistentMD5Cache::flush(bool force) {
+	if (!_dirty)
+		return;
+
+	const uint32 now = g_system ? g_system->getMillis() : 0;
+	if (!force && _lastFlush && now - _lastFlush < kFlushInterval)
+		return;
+
+	Common::FSNode file = getCacheFile();
+	Common::SeekableWriteStream *stream = file.getPath().empty() ? nullptr : file.createWriteStream();
+	if (!stream)
+		return;
+
+	stream->writeUint32BE(MD5CACHE_MAGIC);
+	stream->writeUint32LE(MD5CACHE_VERSION);
+	stream->writeUint32LE(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		stream->writeUint16LE(it->_key.size());
+		stream->writeString(it->_key);
+		stream->writeByte(it->_value.md5.size());
+		stream->writeString(it->_value.md5);
+		stream->writeSint64LE(it->_value.size);
+		stream->writeSint64LE(it->_value.modificationTime);
+		stream->writeUint32LE(it->_value.lastUse);
+	}
+	stream->finalize();
+	delete stream;
+
+	_dirty = false;
+	_lastFlush = now ? now : 1;
 }
 
 
@@ -610,9 +766,13 @@ static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngine::Fil
 	if (!allFiles.contains(fname))
 		return false;
 
+	const Common::FSNode &node = allFiles[fname];
+	if (PersistentMD5Man.lookup(node, md5Bytes, (MD5Properties)(md5prop & kMD5Tail), fileProps))
+		return true;
+
 	Common::File testFile;
 
-	if (!testFile.open(allFiles[fname]))
+	if (!testFile.open(node))
 		return false;
 
 	if (md5prop & kMD5Tail) {
@@ -623,6 +783,7 @@ static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngine::Fil
 	fileProps.size = testFile.size();
 	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
 	fileProps.md5prop = (MD5Properties) (md5prop & kMD5Tail);
+	PersistentMD5Man.store(node, md5Bytes, fileProps.md5prop, fileProps);
 	return true;
 }
 
@@ -613,5 +613,67 @@ private:
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
 #define MD5Man MD5CacheManager::instance()
+
+/**
+ * Singleton on-disk cache of detection MD5s.
+ *
+ * Entries are keyed by the file path, the number of hashed bytes and the
+ * MD5 type and are only returned while the size and modification time of
+ * the file still match, so changed files are hashed again. The cache is
+ * shared by all engines, kept next to the configuration file and bounded
+ * to kMaxEntries; the least recently used entries are dropped first.
+ */
+class PersistentMD5Cache : public Common::Singleton<PersistentMD5Cache> {
+public:
+	/**
+	 * Look up the MD5 of @p node. Returns true and fills @p fileProps
+	 * if a valid entry exists.
+	 */
+	bool lookup(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop, FileProperties &fileProps);
+
+	/** Remember the MD5 computed for @p node. */
+	void store(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop, const FileProperties &fileProps);
+
+	/**
+	 * Write the cache to disk if it changed. Unless @p force is set, writes
+	 * are rate limited so that repeated detections do not rewrite the file
+	 * every time.
+	 */
+	void flush(bool force = false);
+
+private:
+	friend class Common::Singleton<PersistentMD5Cache>;
+
+	PersistentMD5Cache();
+	~PersistentMD5Cache();
+
+	enum {
+		kMaxEntries = 65536,
+		kFlushInterval = 10000
+	};
+
+	struct Entry {
+		Common::String md5;
+		int64 size;
+		int64 modificationTime;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	static Common::String makeKey(const Common::FSNode &node, uint md5Bytes, MD5Properties md5prop);
+	Common::FSNode getCacheFile() const;
+	void load();
+	void prune();
+
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+	uint32 _useCounter;
+	uint32 _lastFlush;
+};
+
+/** Convenience shortcut for accessing the PersistentMD5Cache. */
+#define PersistentMD5Man PersistentMD5Cache::instance()
 /** @} */
 #endif
@@ -23,8 +23,12 @@
 #include "ags/ags.h"
 #include "ags/globals.h"
 #include "ags/shared/ac/sprite_cache.h"
+#include "ags/engine/ac/dynobj/cc_dynamic_array.h"
+#include "ags/engine/ac/dynobj/managed_object_pool.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_common.h"
+#include "ags/engine/script/cc_instance.h"
+#include "common/algorithm.h"
 #include "image/png.h"
 
 namespace AGS {
@@ -33,7 +37,10 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_script_profile", WRAP_METHOD(AGSConsole, Cmd_scriptProfile));
+	registerCmd("ags_managed_objects", WRAP_METHOD(AGSConsole, Cmd_managedObjectStats));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
+	registerCmd("ags_sprite_cache",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
 
 	_logOutputTarget = new LogOutputTarget();
@@ -184,6 +191,64 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_scriptProfile(int argc, const char **argv) {
+	if (argc == 2) {
+		if (strcmp(argv[1], "on") == 0) {
+			_G(scriptOpcodeProfiling) = true;
+		} else if (strcmp(argv[1], "off") == 0) {
+			_G(scriptOpcodeProfiling) = false;
+		} else if (strcmp(argv[1], "reset") == 0) {
+			Common::fill(_G(scriptOpcodeCounts), _G(scriptOpcodeCounts) + CC_NUM_SCCMDS, 0);
+		} else {
+			debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		}
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		return true;
+	}
+
+	// Print the executed instructions, most frequent first
+	int order[CC_NUM_SCCMDS];
+	uint64 total = 0;
+	for (int i = 0; i < CC_NUM_SCCMDS; ++i) {
+		order[i] = i;
+		total += _G(scriptOpcodeCounts)[i];
+	}
+	Common::sort(order, order + CC_NUM_SCCMDS, [](int a, int b) {
+		return _G(scriptOpcodeCounts)[a] > _G(scriptOpcodeCounts)[b];
+	});
+
+	debugPrintf("Instruction profiling is %s, %llu instructions counted\n",
+		_G(scriptOpcodeProfiling) ? "on" : "off", (unsigned long long)total);
+	for (int i = 0; i < CC_NUM_SCCMDS && _G(scriptOpcodeCounts)[order[i]] > 0; ++i) {
+		uint32 count = _G(scriptOpcodeCounts)[order[i]];
+		debugPrintf("%-18s %10u %5.1f%%\n", AGS3::script_command_name(order[i]), count, 100.0 * count / total);
+	}
+	return true;
+}
+
+bool AGSConsole::Cmd_managedObjectStats(int argc, const char **argv) {
+	if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+		_GP(pool).ResetStats();
+		_GP(globalDynamicArray).ResetStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const AGS3::ManagedObjectPool::Stats &stats = _GP(pool).GetStats();
+	debugPrintf("Objects: %u alive in %u slots, peak %u\n", _GP(pool).GetObjectCount(),
+		(uint)_GP(pool).GetSlotCount(), stats.Peak);
+	debugPrintf("Created: %u, disposed: %u, stale handles: %u\n", stats.Created, stats.Disposed, stats.StaleHandles);
+	debugPrintf("References added: %u, released: %u\n", stats.AddRefs, stats.SubRefs);
+	debugPrintf("Garbage collections: %u, objects collected: %u\n", stats.GCRuns, stats.GCDisposed);
+	const AGS3::CCDynamicArray::Stats &arrStats = _GP(globalDynamicArray).GetStats();
+	debugPrintf("Arrays allocated: %u pooled, %u on the heap\n", arrStats.PoolAllocs, arrStats.HeapAllocs);
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
@@ -207,6 +272,24 @@ bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+		_GP(spriteset).ResetStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const AGS3::AGS::Shared::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	debugPrintf("Size: %u KB of %u KB, %u KB locked\n", (uint)(_GP(spriteset).GetCacheSize() / 1024),
+		(uint)(_GP(spriteset).GetMaxCacheSize() / 1024), (uint)(_GP(spriteset).GetLockedSize() / 1024));
+	debugPrintf("Hits: %u, misses: %u, evictions: %u\n", stats.Hits, stats.Misses, stats.Evictions);
+	debugPrintf("Preloads: %u queued, %u used on first request, %u waited for\n",
+		stats.Preloads, stats.PreloadHits, stats.PreloadWaits);
+	return true;
+}
+
 bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
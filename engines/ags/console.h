@@ -47,8 +47,11 @@ private:
 	bool Cmd_setDebugGroupLevel(int argc, const char **argv);
 
 	bool Cmd_SetScriptDump(int argc, const char **argv);
+	bool Cmd_scriptProfile(int argc, const char **argv);
+	bool Cmd_managedObjectStats(int argc, const char **argv);
 
 	bool Cmd_getSpriteInfo(int argc, const char **argv);
+	bool Cmd_spriteCacheStats(int argc, const char **argv);
 	bool Cmd_dumpSprite(int argc, const char **argv);
 
 	const char *getVerbosityLevel(AGS3::uint32_t groupID) const;
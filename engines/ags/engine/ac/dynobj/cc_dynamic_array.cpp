@@ -24,6 +24,45 @@
 
 namespace AGS3 {
 
+CCDynamicArray::CCDynamicArray() {
+	for (int i = 0; i < NUM_POOLS; i++)
+		_pools[i] = new Common::MemoryPool(1 << (MIN_POOL_SHIFT + i));
+}
+
+CCDynamicArray::~CCDynamicArray() {
+	for (int i = 0; i < NUM_POOLS; i++)
+		delete _pools[i];
+}
+
+int CCDynamicArray::GetPoolIndex(size_t size) {
+	for (int i = 0; i < NUM_POOLS; i++) {
+		if (size <= ((size_t)1 << (MIN_POOL_SHIFT + i)))
+			return i;
+	}
+	return -1;
+}
+
+char *CCDynamicArray::Allocate(size_t size) {
+	// Arrays are returned zeroed, like new char[]() does
+	const int pool = GetPoolIndex(size);
+	if (pool < 0) {
+		_stats.HeapAllocs++;
+		return new char[size]();
+	}
+	_stats.PoolAllocs++;
+	char *buf = (char *)_pools[pool]->allocChunk();
+	memset(buf, 0, size);
+	return buf;
+}
+
+void CCDynamicArray::Free(char *buf, size_t size) {
+	const int pool = GetPoolIndex(size);
+	if (pool < 0)
+		delete[] buf;
+	else
+		_pools[pool]->freeChunk(buf);
+}
+
 // return the type name of the object
 const char *CCDynamicArray::GetType() {
 	return CC_DYNAMIC_ARRAY_TYPE_NAME;
@@ -35,8 +74,9 @@ int CCDynamicArray::Dispose(const char *address, bool force) {
 	// If it's an array of managed objects, release their ref counts;
 	// except if this array is forcefully removed from the managed pool,
 	// in which case just ignore these.
+	int *elementCount = (int *)const_cast<char *>(address);
+	const size_t blockSize = elementCount[1] + 8;
 	if (!force) {
-		int *elementCount = (int *)const_cast<char *>(address);
 		if (elementCount[0] & ARRAY_MANAGED_TYPE_FLAG) {
 			elementCount[0] &= ~ARRAY_MANAGED_TYPE_FLAG;
 			for (int i = 0; i < elementCount[0]; i++) {
@@ -47,7 +87,7 @@ int CCDynamicArray::Dispose(const char *address, bool force) {
 		}
 	}
 
-	delete[] address;
+	Free(const_cast<char *>(address), blockSize);
 	return 1;
 }
 
@@ -65,13 +105,16 @@ int CCDynamicArray::Serialize(const char *address, char *buffer, int bufsize) {
 }
 
 void CCDynamicArray::Unserialize(int index, const char *serializedData, int dataSize) {
-	char *newArray = new char[dataSize];
-	memcpy(newArray, serializedData, dataSize);
+	// The block size must follow the header, as that is what Dispose frees
+	const size_t blockSize = (dataSize >= 8) ? ((const int *)serializedData)[1] + 8 : 8;
+	char *newArray = Allocate(blockSize);
+	memcpy(newArray, serializedData, MIN<size_t>(dataSize, blockSize));
 	ccRegisterUnserializedObject(index, &newArray[8], this);
 }
 
 DynObjectRef CCDynamicArray::Create(int numElements, int elementSize, bool isManagedType) {
-	char *newArray = new char[numElements * elementSize + 8]();
+	const size_t blockSize = numElements * elementSize + 8;
+	char *newArray = Allocate(blockSize);
 	int *sizePtr = (int *)newArray;
 	sizePtr[0] = numElements;
 	sizePtr[1] = numElements * elementSize;
@@ -80,7 +123,7 @@ DynObjectRef CCDynamicArray::Create(int numElements, int elementSize, bool isMan
 	void *obj_ptr = &newArray[8];
 	int32_t handle = ccRegisterManagedObject(obj_ptr, this);
 	if (handle == 0) {
-		delete[] newArray;
+		Free(newArray, blockSize);
 		return DynObjectRef(0, nullptr);
 	}
 	return DynObjectRef(handle, obj_ptr);
@@ -22,6 +22,7 @@
 #ifndef AGS_ENGINE_AC_DYNOBJ_CC_DYNAMICARRAY_H
 #define AGS_ENGINE_AC_DYNOBJ_CC_DYNAMICARRAY_H
 
+#include "common/memorypool.h"
 #include "ags/lib/std/vector.h"
 #include "ags/engine/ac/dynobj/cc_dynamic_object.h"   // ICCDynamicObject
 
@@ -31,6 +32,15 @@ namespace AGS3 {
 #define ARRAY_MANAGED_TYPE_FLAG    0x80000000
 
 struct CCDynamicArray final : ICCDynamicObject {
+	// Allocation counters, reported by the console
+	struct Stats {
+		uint32_t PoolAllocs = 0; // arrays allocated from the size class pools
+		uint32_t HeapAllocs = 0; // arrays too large for the pools
+	};
+
+	CCDynamicArray();
+	~CCDynamicArray() override;
+
 	// return the type name of the object
 	const char *GetType() override;
 	int Dispose(const char *address, bool force) override;
@@ -53,6 +63,28 @@ struct CCDynamicArray final : ICCDynamicObject {
 	void    WriteInt16(const char *address, intptr_t offset, int16_t val) override;
 	void    WriteInt32(const char *address, intptr_t offset, int32_t val) override;
 	void    WriteFloat(const char *address, intptr_t offset, float val) override;
+
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	void ResetStats() {
+		_stats = Stats();
+	}
+
+private:
+	// Arrays of up to 2^(MIN_POOL_SHIFT + NUM_POOLS - 1) bytes, header included,
+	// are allocated from pools of fixed size chunks instead of the heap,
+	// as scripts often create and drop lots of small arrays
+	static const int MIN_POOL_SHIFT = 4;
+	static const int NUM_POOLS = 6;
+
+	Common::MemoryPool *_pools[NUM_POOLS];
+	Stats _stats;
+
+	// Returns the index of the pool for blocks of the given size, or -1
+	static int GetPoolIndex(size_t size);
+	char *Allocate(size_t size);
+	void Free(char *buf, size_t size);
 };
 
 // Helper functions for setting up dynamic arrays.
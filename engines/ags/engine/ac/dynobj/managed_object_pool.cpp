@@ -38,6 +38,30 @@ const auto SERIALIZE_BUFFER_SIZE = 10240;
 const auto GARBAGE_COLLECTION_INTERVAL = 1024;
 const auto RESERVED_SIZE = 2048;
 
+ManagedObjectPool::ManagedObject *ManagedObjectPool::Lookup(int32_t handle) {
+	if (handle < 0) {
+		return nullptr;
+	}
+	const int32_t index = HandleToIndex(handle);
+	if ((size_t)index >= objects.size()) {
+		return nullptr;
+	}
+	auto &o = objects[index];
+	if (!o.isUsed() || o.handle != handle) {
+		if (handle != 0)
+			stats.StaleHandles++;
+		return nullptr;
+	}
+	return &o;
+}
+
+void ManagedObjectPool::EnsureSlot(int32_t index) {
+	if ((size_t)index >= objects.size()) {
+		objects.resize(index + 1024, ManagedObject());
+		generations.resize(objects.size(), 0);
+	}
+}
+
 int ManagedObjectPool::Remove(ManagedObject &o, bool force) {
 	if (!o.isUsed()) {
 		return 1;
@@ -48,35 +72,42 @@ int ManagedObjectPool::Remove(ManagedObject &o, bool force) {
 		return 0;
 	}
 
-	available_ids.push(o.handle);
+	const int32_t index = HandleToIndex(o.handle);
+	available_ids.push(index);
+	// Invalidate any handles to the object which may still be around
+	generations[index] = (generations[index] + 1) & HANDLE_GENERATION_MASK;
 	handleByAddress.erase(o.addr);
 	ManagedObjectLog("Line %d Disposed managed object handle=%d", currentline, o.handle);
 	o = ManagedObject();
+	numAlive--;
+	stats.Disposed++;
 	return 1;
 }
 
+void ManagedObjectPool::ResetStats() {
+	stats = Stats();
+	stats.Peak = numAlive;
+}
+
 int32_t ManagedObjectPool::AddRef(int32_t handle) {
-	if (handle < 0 || (size_t)handle >= objects.size()) {
-		return 0;
-	}
-	auto &o = objects[handle];
-	if (!o.isUsed()) {
+	ManagedObject *obj = Lookup(handle);
+	if (!obj) {
 		return 0;
 	}
+	auto &o = *obj;
 
 	o.refCount += 1;
+	stats.AddRefs++;
 	ManagedObjectLog("Line %d AddRef: handle=%d new refcount=%d", _G(currentline), o.handle, o.refCount);
 	return o.refCount;
 }
 
 int ManagedObjectPool::CheckDispose(int32_t handle) {
-	if (handle < 0 || (size_t)handle >= objects.size()) {
-		return 1;
-	}
-	auto &o = objects[handle];
-	if (!o.isUsed()) {
+	ManagedObject *obj = Lookup(handle);
+	if (!obj) {
 		return 1;
 	}
+	auto &o = *obj;
 	if (o.refCount >= 1) {
 		return 0;
 	}
@@ -84,15 +115,14 @@ int ManagedObjectPool::CheckDispose(int32_t handle) {
 }
 
 int32_t ManagedObjectPool::SubRef(int32_t handle) {
-	if (handle < 0 || (size_t)handle >= objects.size()) {
-		return 0;
-	}
-	auto &o = objects[handle];
-	if (!o.isUsed()) {
+	ManagedObject *obj = Lookup(handle);
+	if (!obj) {
 		return 0;
 	}
+	auto &o = *obj;
 
 	o.refCount--;
+	stats.SubRefs++;
 	auto newRefCount = o.refCount;
 	auto canBeDisposed = (o.addr != disableDisposeForObject);
 	if (canBeDisposed) {
@@ -116,25 +146,20 @@ int32_t ManagedObjectPool::AddressToHandle(const char *addr) {
 
 // this function is called often (whenever a pointer is used)
 const char *ManagedObjectPool::HandleToAddress(int32_t handle) {
-	if (handle < 0 || (size_t)handle >= objects.size()) {
+	ManagedObject *obj = Lookup(handle);
+	if (!obj) {
 		return nullptr;
 	}
-	auto &o = objects[handle];
-	if (!o.isUsed()) {
-		return nullptr;
-	}
-	return o.addr;
+	return obj->addr;
 }
 
 // this function is called often (whenever a pointer is used)
 ScriptValueType ManagedObjectPool::HandleToAddressAndManager(int32_t handle, void *&object, ICCDynamicObject *&manager) {
-	if (handle < 0 || (size_t)handle >= objects.size()) {
-		return kScValUndefined;
-	}
-	auto &o = objects[handle];
-	if (!o.isUsed()) {
+	ManagedObject *obj = Lookup(handle);
+	if (!obj) {
 		return kScValUndefined;
 	}
+	auto &o = *obj;
 
 	object = const_cast<char *>(o.addr);  // WARNING: This strips the const from the char* pointer.
 	manager = o.callback;
@@ -150,7 +175,7 @@ int ManagedObjectPool::RemoveObject(const char *address) {
 		return 0;
 	}
 
-	auto &o = objects[it->_value];
+	auto &o = objects[HandleToIndex(it->_value)];
 	return Remove(o, true);
 }
 
@@ -163,6 +188,7 @@ void ManagedObjectPool::RunGarbageCollectionIfAppropriate() {
 }
 
 void ManagedObjectPool::RunGarbageCollection() {
+	const uint32_t disposed = stats.Disposed;
 	for (int i = 1; i < nextHandle; i++) {
 		auto &o = objects[i];
 		if (!o.isUsed()) {
@@ -172,32 +198,39 @@ void ManagedObjectPool::RunGarbageCollection() {
 			Remove(o);
 		}
 	}
+	stats.GCRuns++;
+	stats.GCDisposed += stats.Disposed - disposed;
 	ManagedObjectLog("Ran garbage collection");
 }
 
 int ManagedObjectPool::AddObject(const char *address, ICCDynamicObject *callback, bool plugin_object) {
-	int32_t handle;
+	int32_t index;
 
 	if (!available_ids.empty()) {
-		handle = available_ids.front();
+		index = available_ids.front();
 		available_ids.pop();
 	} else {
-		handle = nextHandle++;
-		if ((size_t)handle >= objects.size()) {
-			objects.resize(handle + 1024, ManagedObject());
+		if (nextHandle > HANDLE_INDEX_MASK) {
+			cc_error("too many managed objects");
+			return 0;
 		}
+		index = nextHandle++;
+		EnsureSlot(index);
 	}
 
-	auto &o = objects[handle];
+	auto &o = objects[index];
 	if (o.isUsed()) {
-		cc_error("used: %d", handle);
+		cc_error("used: %d", index);
 		return 0;
 	}
 
+	const int32_t handle = (generations[index] << HANDLE_INDEX_BITS) | index;
 	o = ManagedObject(plugin_object ? kScValPluginObject : kScValDynamicObject, handle, address, callback);
 
 	handleByAddress.insert({ address, o.handle });
 	objectCreationCounter++;
+	stats.Created++;
+	stats.Peak = MAX(stats.Peak, ++numAlive);
 	ManagedObjectLog("Allocated managed object handle=%d, type=%s", handle, callback->GetType());
 	return o.handle;
 }
@@ -208,19 +241,21 @@ int ManagedObjectPool::AddUnserializedObject(const char *address, ICCDynamicObje
 		cc_error("Attempt to assign invalid handle: %d", handle);
 		return 0;
 	}
-	if ((size_t)handle >= objects.size()) {
-		objects.resize(handle + 1024, ManagedObject());
-	}
+	const int32_t index = HandleToIndex(handle);
+	EnsureSlot(index);
 
-	auto &o = objects[handle];
+	auto &o = objects[index];
 	if (o.isUsed()) {
 		cc_error("bad save. used: %d", o.handle);
 		return 0;
 	}
 
 	o = ManagedObject(plugin_object ? kScValPluginObject : kScValDynamicObject, handle, address, callback);
+	generations[index] = (handle >> HANDLE_INDEX_BITS) & HANDLE_GENERATION_MASK;
 
 	handleByAddress.insert({ address, o.handle });
+	stats.Created++;
+	stats.Peak = MAX(stats.Peak, ++numAlive);
 	ManagedObjectLog("Allocated unserialized managed object handle=%d, type=%s", o.handle, callback->GetType());
 	return o.handle;
 }
@@ -300,8 +335,11 @@ int ManagedObjectPool::ReadFromDisk(Stream *in, ICCObjectReader *reader) {
 				} else {
 					reader->Unserialize(i, typeNameBuffer, &serializeBuffer.front(), numBytes);
 				}
-				objects[i].refCount = in->ReadInt32();
-				ManagedObjectLog("Read handle = %d", objects[i].handle);
+				ManagedObject *o = Lookup(i);
+				int refCount = in->ReadInt32();
+				if (o)
+					o->refCount = refCount;
+				ManagedObjectLog("Read handle = %d", i);
 			}
 		}
 	}
@@ -324,8 +362,11 @@ int ManagedObjectPool::ReadFromDisk(Stream *in, ICCObjectReader *reader) {
 			} else {
 				reader->Unserialize(handle, typeNameBuffer, &serializeBuffer.front(), numBytes);
 			}
-			objects[handle].refCount = in->ReadInt32();
-			ManagedObjectLog("Read handle = %d", objects[i].handle);
+			ManagedObject *o = Lookup(handle);
+			int refCount = in->ReadInt32();
+			if (o)
+				o->refCount = refCount;
+			ManagedObjectLog("Read handle = %d", handle);
 		}
 	}
 	break;
@@ -342,7 +383,7 @@ int ManagedObjectPool::ReadFromDisk(Stream *in, ICCObjectReader *reader) {
 
 	for (const auto &o : objects) {
 		if (o.isUsed()) {
-			nextHandle = o.handle + 1;
+			nextHandle = HandleToIndex(o.handle) + 1;
 		}
 	}
 	for (int i = 1; i < nextHandle; i++) {
@@ -369,7 +410,8 @@ void ManagedObjectPool::reset() {
 	nextHandle = 1;
 }
 
-ManagedObjectPool::ManagedObjectPool() : objectCreationCounter(0), nextHandle(1), available_ids(), objects(RESERVED_SIZE, ManagedObject()), handleByAddress() {
+ManagedObjectPool::ManagedObjectPool() : objectCreationCounter(0), nextHandle(1), available_ids(), objects(RESERVED_SIZE, ManagedObject()),
+	generations(RESERVED_SIZE, 0), handleByAddress() {
 	handleByAddress.reserve(RESERVED_SIZE);
 }
 
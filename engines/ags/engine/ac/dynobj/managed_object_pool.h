@@ -48,6 +48,26 @@ struct Pointer_Hash {
 
 
 struct ManagedObjectPool final {
+	// Handles consist of the index of the object's slot in the lower bits
+	// and the slot's generation in the upper ones, which changes whenever
+	// the slot is reused; so a stale handle never resolves to a newer
+	// object. Generation 0 gives the plain slot index used by old saves.
+	static const int HANDLE_INDEX_BITS = 24;
+	static const int32_t HANDLE_INDEX_MASK = (1 << HANDLE_INDEX_BITS) - 1;
+	static const int32_t HANDLE_GENERATION_MASK = 0x7f;
+
+	// Counters reported by the console
+	struct Stats {
+		uint32_t Created = 0;      // objects added to the pool
+		uint32_t Disposed = 0;     // objects removed from the pool
+		uint32_t Peak = 0;         // highest number of objects alive at once
+		uint32_t AddRefs = 0;
+		uint32_t SubRefs = 0;
+		uint32_t StaleHandles = 0; // lookups of handles of disposed objects
+		uint32_t GCRuns = 0;
+		uint32_t GCDisposed = 0;   // objects disposed by garbage collection
+	};
+
 private:
 	// TODO: find out if we can make handle size_t
 	struct ManagedObject {
@@ -75,10 +95,21 @@ private:
 
 	int objectCreationCounter;  // used to do garbage collection every so often
 
-	int32_t nextHandle{}; // TODO: manage nextHandle's going over INT32_MAX !
-	std::queue<int32_t> available_ids;
+	int32_t nextHandle{}; // next slot index which was never used
+	std::queue<int32_t> available_ids; // free slot indexes
 	std::vector<ManagedObject> objects;
+	std::vector<uint8_t> generations; // current generation of each slot
 	std::unordered_map<const char *, int32_t, Pointer_Hash> handleByAddress;
+	uint32_t numAlive = 0;
+	Stats stats;
+
+	static int32_t HandleToIndex(int32_t handle) {
+		return handle & HANDLE_INDEX_MASK;
+	}
+	// Returns the object the handle refers to, or nullptr
+	ManagedObject *Lookup(int32_t handle);
+	// Makes sure the slot arrays are large enough for the given index
+	void EnsureSlot(int32_t index);
 
 	void Init(int32_t theHandle, const char *theAddress, ICCDynamicObject *theCallback, ScriptValueType objType);
 	int Remove(ManagedObject &o, bool force = false);
@@ -102,6 +133,17 @@ public:
 	void reset();
 	ManagedObjectPool();
 
+	uint32_t GetObjectCount() const {
+		return numAlive;
+	}
+	size_t GetSlotCount() const {
+		return nextHandle;
+	}
+	const Stats &GetStats() const {
+		return stats;
+	}
+	void ResetStats();
+
 	const char *disableDisposeForObject{ nullptr };
 };
 
@@ -47,6 +47,7 @@
 #include "ags/engine/ac/screen.h"
 #include "ags/engine/ac/string.h"
 #include "ags/engine/ac/system.h"
+#include "ags/engine/ac/view_frame.h"
 #include "ags/engine/ac/walkable_area.h"
 #include "ags/engine/ac/walk_behind.h"
 #include "ags/engine/ac/dynobj/script_object.h"
@@ -661,6 +662,21 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 			StopMoving(cc);
 	}
 
+	// Decompress the sprites of the room's objects and characters in the
+	// background, rather than when each of them is first drawn
+	for (size_t cc = 0; cc < _G(croom)->numobj; cc++) {
+		const RoomObject &obj = _G(croom)->obj[cc];
+		if (!obj.on)
+			continue;
+		_GP(spriteset).Preload(obj.num);
+		if (obj.view != RoomObject::NoView)
+			preload_view(obj.view);
+	}
+	for (int cc = 0; cc < _GP(game).numcharacters; cc++) {
+		if (_GP(game).chars[cc].room == newnum && _GP(game).chars[cc].on)
+			preload_view(_GP(game).chars[cc].view);
+	}
+
 	_G(roominst) = nullptr;
 	if (_G(debug_flags) & DBG_NOSCRIPT) ;
 	else if (_GP(thisroom).CompiledScript != nullptr) {
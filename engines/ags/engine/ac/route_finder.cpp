@@ -42,6 +42,9 @@ public:
 	void set_wallscreen(Bitmap *wallscreen) override {
 		AGS::Engine::RouteFinder::set_wallscreen(wallscreen);
 	}
+	void set_walkablearea_mask(Bitmap *mask) override {
+		AGS::Engine::RouteFinder::set_walkablearea_mask(mask);
+	}
 	int can_see_from(int x1, int y1, int x2, int y2) override {
 		return AGS::Engine::RouteFinder::can_see_from(x1, y1, x2, y2);
 	}
@@ -72,6 +75,9 @@ public:
 	void set_wallscreen(Bitmap *wallscreen) override {
 		AGS::Engine::RouteFinderLegacy::set_wallscreen(wallscreen);
 	}
+	void set_walkablearea_mask(Bitmap *mask) override {
+		// the legacy pathfinder does not precompute anything
+	}
 	int can_see_from(int x1, int y1, int x2, int y2) override {
 		return AGS::Engine::RouteFinderLegacy::can_see_from(x1, y1, x2, y2);
 	}
@@ -110,6 +116,11 @@ void set_wallscreen(Bitmap *wallscreen) {
 	_GP(route_finder_impl)->set_wallscreen(wallscreen);
 }
 
+void set_walkablearea_mask(Bitmap *mask) {
+	if (_GP(route_finder_impl))
+		_GP(route_finder_impl)->set_walkablearea_mask(mask);
+}
+
 int can_see_from(int x1, int y1, int x2, int y2) {
 	return _GP(route_finder_impl)->can_see_from(x1, y1, x2, y2);
 }
@@ -43,6 +43,7 @@ public:
 	virtual void init_pathfinder() = 0;
 	virtual void shutdown_pathfinder() = 0;
 	virtual void set_wallscreen(AGS::Shared::Bitmap *wallscreen) = 0;
+	virtual void set_walkablearea_mask(AGS::Shared::Bitmap *mask) = 0;
 	virtual int can_see_from(int x1, int y1, int x2, int y2) = 0;
 	virtual void get_lastcpos(int &lastcx, int &lastcy) = 0;
 	virtual void set_route_move_speed(int speed_x, int speed_y) = 0;
@@ -54,6 +55,9 @@ void init_pathfinder(GameDataVersion game_file_version);
 void shutdown_pathfinder();
 
 void set_wallscreen(AGS::Shared::Bitmap *wallscreen);
+// Lets the pathfinder precompute data for the room's walkable areas;
+// must be called whenever the walkable area mask changes
+void set_walkablearea_mask(AGS::Shared::Bitmap *mask);
 
 int can_see_from(int x1, int y1, int x2, int y2);
 void get_lastcpos(int &lastcx, int &lastcy);
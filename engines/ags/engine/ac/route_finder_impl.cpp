@@ -45,11 +45,16 @@ namespace RouteFinder {
 #define MAKE_INTCOORD(x,y) (((unsigned short)x << 16) | ((unsigned short)y))
 
 static const int MAXNAVPOINTS = MAXNEEDSTAGES;
+// Largest walkable area mask to precompute jump distances for;
+// costs 9 bytes per mask pixel (4.5 MB at this size)
+static const int MAX_JUMP_TABLE_CELLS = 512 * 1024;
 
 void init_pathfinder() {
 }
 
 void shutdown_pathfinder() {
+	_GP(nav).ClearJumpTable();
+	_G(nav_grid_data) = nullptr;
 }
 
 void set_wallscreen(Bitmap *wallscreen_) {
@@ -57,11 +62,44 @@ void set_wallscreen(Bitmap *wallscreen_) {
 }
 
 static void sync_nav_wallscreen() {
-	// FIXME: this is dumb, but...
-	_GP(nav).Resize(_G(wallscreen)->GetWidth(), _G(wallscreen)->GetHeight());
+	const int width = _G(wallscreen)->GetWidth();
+	const int height = _G(wallscreen)->GetHeight();
+	const uint8_t *data = _G(wallscreen)->GetScanLine(0);
+	const int pitch = _G(wallscreen)->GetLineLength();
+
+	// the grid only references the bitmap rows, so it has to be rebuilt
+	// only when pointed at a different bitmap
+	if (data != _G(nav_grid_data) || width != _G(nav_grid_width) ||
+	        height != _G(nav_grid_height) || pitch != _G(nav_grid_pitch)) {
+		_GP(nav).Resize(width, height);
+
+		for (int y = 0; y < height; y++)
+			_GP(nav).SetMapRow(y, _G(wallscreen)->GetScanLine(y));
+
+		_G(nav_grid_data) = data;
+		_G(nav_grid_width) = width;
+		_G(nav_grid_height) = height;
+		_G(nav_grid_pitch) = pitch;
+	}
+
+	// the contents may change between calls though (e.g. blocking characters)
+	_GP(nav).SyncJumpTable();
+}
+
+void set_walkablearea_mask(Bitmap *mask) {
+	_GP(nav).ClearJumpTable();
+	if (!mask)
+		return;
+
+	_GP(nav).Resize(mask->GetWidth(), mask->GetHeight());
+	for (int y = 0; y < mask->GetHeight(); y++)
+		_GP(nav).SetMapRow(y, mask->GetScanLine(y));
+	// the grid now points to the mask, resync with the wallscreen on next use
+	_G(nav_grid_data) = nullptr;
 
-	for (int y = 0; y < _G(wallscreen)->GetHeight(); y++)
-		_GP(nav).SetMapRow(y, _G(wallscreen)->GetScanLine(y));
+	if (!_GP(nav).BuildJumpTable(MAX_JUMP_TABLE_CELLS))
+		AGS::Shared::Debug::Printf(AGS::Shared::MessageType::kDbgMsg_Info, "Walkable area mask %dx%d is too large for jump distance precomputation",
+		                           mask->GetWidth(), mask->GetHeight());
 }
 
 int can_see_from(int x1, int y1, int x2, int y2) {
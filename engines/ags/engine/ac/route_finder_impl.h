@@ -43,6 +43,8 @@ void init_pathfinder();
 void shutdown_pathfinder();
 
 void set_wallscreen(AGS::Shared::Bitmap *wallscreen);
+// Precomputes jump distances for the room's walkable area mask
+void set_walkablearea_mask(AGS::Shared::Bitmap *mask);
 
 int can_see_from(int x1, int y1, int x2, int y2);
 void get_lastcpos(int &lastcx, int &lastcy);
@@ -68,6 +68,13 @@ public:
 		map[y] = row;
 	}
 
+	// precompute orthogonal jump distances (JPS+) for the current map;
+	// fails if the map has more than maxCells cells
+	bool BuildJumpTable(int maxCells);
+	void ClearJumpTable();
+	// find map rows which no longer match the ones the jump table was built from
+	void SyncJumpTable();
+
 	inline static int PackSquare(int x, int y);
 	inline static void UnpackSquare(int sq, int &x, int &y);
 
@@ -132,6 +139,15 @@ private:
 	int cnode;
 	int closest;
 
+	// precomputed jump distances, 4 per cell (+x, -x, +y, -y);
+	// n > 0 means a jump point n cells away, n <= 0 means -n passable cells
+	// followed by a blocked one
+	std::vector<short> jumpDist;
+	// copy of the map the jump table was built from
+	std::vector<unsigned char> jumpMap;
+	// running count of map rows which differ from jumpMap, mapHeight + 1 entries
+	std::vector<int> jumpRowsChanged;
+
 	// orthogonal only (this should correspond to what AGS is doing)
 	bool nodiag;
 
@@ -150,6 +166,9 @@ private:
 	bool HasForcedNeighbor(int x, int y, int dx, int dy) const;
 	int FindJump(int x, int y, int dx, int dy, int ex, int ey);
 	int FindOrthoJump(int x, int y, int dx, int dy, int ex, int ey);
+	bool FindTableJump(int x, int y, int dx, int dy, int ex, int ey, int &jump);
+	bool JumpRowsIntact(int y0, int y1) const;
+	static int JumpDir(int dx, int dy);
 
 	// neighbor reachable (nodiag only)
 	bool Reachable(int x0, int y0, int x1, int y1) const;
@@ -201,6 +220,119 @@ void Navigation::Resize(int width, int height) {
 	mapNodes.resize(size);
 }
 
+bool Navigation::BuildJumpTable(int maxCells) {
+	ClearJumpTable();
+
+	// distances are stored as shorts
+	if (mapWidth <= 0 || mapHeight <= 0 || mapWidth > 32767 || mapHeight > 32767 ||
+	        mapWidth * mapHeight > maxCells)
+		return false;
+
+	jumpDist.resize(mapWidth * mapHeight * 4);
+	jumpMap.resize(mapWidth * mapHeight);
+	jumpRowsChanged.resize(mapHeight + 1, 0);
+
+	for (int y = 0; y < mapHeight; y++)
+		memcpy(&jumpMap[y * mapWidth], map[y], mapWidth);
+
+	// each direction is swept from the far end, so that every cell can reuse
+	// the distance of its neighbor
+	for (int y = 0; y < mapHeight; y++) {
+		int dist = 0;
+
+		for (int x = mapWidth - 1; x >= 0; x--) {
+			jumpDist[(y * mapWidth + x) * 4 + 0] = (short)dist;
+
+			if (!Walkable(x, y))
+				dist = 0;
+			else if (HasForcedNeighbor(x, y, 1, 0))
+				dist = 1;
+			else
+				dist = dist > 0 ? dist + 1 : dist - 1;
+		}
+
+		dist = 0;
+
+		for (int x = 0; x < mapWidth; x++) {
+			jumpDist[(y * mapWidth + x) * 4 + 1] = (short)dist;
+
+			if (!Walkable(x, y))
+				dist = 0;
+			else if (HasForcedNeighbor(x, y, -1, 0))
+				dist = 1;
+			else
+				dist = dist > 0 ? dist + 1 : dist - 1;
+		}
+	}
+
+	for (int x = 0; x < mapWidth; x++) {
+		int dist = 0;
+
+		for (int y = mapHeight - 1; y >= 0; y--) {
+			jumpDist[(y * mapWidth + x) * 4 + 2] = (short)dist;
+
+			if (!Walkable(x, y))
+				dist = 0;
+			else if (HasForcedNeighbor(x, y, 0, 1))
+				dist = 1;
+			else
+				dist = dist > 0 ? dist + 1 : dist - 1;
+		}
+
+		dist = 0;
+
+		for (int y = 0; y < mapHeight; y++) {
+			jumpDist[(y * mapWidth + x) * 4 + 3] = (short)dist;
+
+			if (!Walkable(x, y))
+				dist = 0;
+			else if (HasForcedNeighbor(x, y, 0, -1))
+				dist = 1;
+			else
+				dist = dist > 0 ? dist + 1 : dist - 1;
+		}
+	}
+
+	return true;
+}
+
+void Navigation::ClearJumpTable() {
+	jumpDist.clear();
+	jumpMap.clear();
+	jumpRowsChanged.clear();
+}
+
+void Navigation::SyncJumpTable() {
+	if (jumpDist.empty())
+		return;
+
+	// the map was resized: nothing can be trusted anymore
+	if ((int)jumpMap.size() != mapWidth * mapHeight ||
+	        (int)jumpRowsChanged.size() != mapHeight + 1) {
+		ClearJumpTable();
+		return;
+	}
+
+	for (int y = 0; y < mapHeight; y++) {
+		bool changed = memcmp(map[y], &jumpMap[y * mapWidth], mapWidth) != 0;
+		jumpRowsChanged[y + 1] = jumpRowsChanged[y] + (changed ? 1 : 0);
+	}
+}
+
+bool Navigation::JumpRowsIntact(int y0, int y1) const {
+	y0 = MAX(y0, 0);
+	y1 = MIN(y1, mapHeight - 1);
+
+	return y0 > y1 || jumpRowsChanged[y1 + 1] == jumpRowsChanged[y0];
+}
+
+int Navigation::JumpDir(int dx, int dy) {
+	if (dy)
+		return dy > 0 ? 2 : 3;
+
+	return dx > 0 ? 0 : 1;
+}
+
 void Navigation::IncFrameId() {
 	if (++frameId == 0) {
 		for (int i = 0; i < (int)mapNodes.size(); i++)
@@ -267,9 +399,70 @@ bool Navigation::HasForcedNeighbor(int x, int y, int dx, int dy) const {
 	    (!Passable(x, y - dy) && Passable(x + dx, y - dy));
 }
 
+// same result as the scan in FindOrthoJump, using the precomputed distances;
+// fails if the rows the distance depends on have changed since
+bool Navigation::FindTableJump(int x, int y, int dx, int dy, int ex, int ey, int &jump) {
+	if (jumpDist.empty() || Outside(x, y))
+		return false;
+
+	int dist = jumpDist[(y * mapWidth + x) * 4 + JumpDir(dx, dy)];
+	int count = dist > 0 ? dist : -dist;
+
+	// forced neighbor tests look one row/column beyond the scanned cells
+	bool intact;
+	if (!dy)
+		intact = JumpRowsIntact(y - 1, y + 1);
+	else if (dy > 0)
+		intact = JumpRowsIntact(y + 1, y + count + 1);
+	else
+		intact = JumpRowsIntact(y - count - 1, y - 1);
+
+	if (!intact)
+		return false;
+
+	jump = -1;
+
+	if (!count)
+		return true;
+
+	// the scan stops at the target if it lies on the way
+	int t = dx ? (ex - x) * dx : (ey - y) * dy;
+
+	if ((dx ? ey == y : ex == x) && t >= 1 && t <= count) {
+		if (closest > 0) {
+			closest = 0;
+			cnode = PackSquare(ex, ey);
+		}
+
+		jump = PackSquare(ex, ey);
+		return true;
+	}
+
+	// otherwise the closest scanned cell to the target is simply the
+	// projection of the target on the scanned segment
+	int i = iclamp(t, 1, count);
+	int cx = x + dx * i;
+	int cy = y + dy * i;
+	int edist = ClosestDist(cx - ex, cy - ey);
+
+	if (edist < closest) {
+		closest = edist;
+		cnode = PackSquare(cx, cy);
+	}
+
+	if (dist > 0)
+		jump = PackSquare(x + dx * count, y + dy * count);
+
+	return true;
+}
+
 int Navigation::FindOrthoJump(int x, int y, int dx, int dy, int ex, int ey) {
 	assert((!dx || !dy) && (dx || dy));
 
+	int jump;
+	if (FindTableJump(x, y, dx, dy, ex, ey, jump))
+		return jump;
+
 	for (;;) {
 		x += dx;
 		y += dy;
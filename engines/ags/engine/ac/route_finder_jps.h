@@ -66,6 +66,13 @@ public:
 		map[y] = row;
 	}
 
+	// precompute orthogonal jump distances (JPS+) for the current map;
+	// fails if the map has more than maxCells cells
+	bool BuildJumpTable(int maxCells);
+	void ClearJumpTable();
+	// find map rows which no longer match the ones the jump table was built from
+	void SyncJumpTable();
+
 	static int PackSquare(int x, int y);
 	static void UnpackSquare(int sq, int &x, int &y);
 
@@ -130,6 +137,15 @@ private:
 	int cnode;
 	int closest;
 
+	// precomputed jump distances, 4 per cell (+x, -x, +y, -y);
+	// n > 0 means a jump point n cells away, n <= 0 means -n passable cells
+	// followed by a blocked one
+	std::vector<short> jumpDist;
+	// copy of the map the jump table was built from
+	std::vector<unsigned char> jumpMap;
+	// running count of map rows which differ from jumpMap, mapHeight + 1 entries
+	std::vector<int> jumpRowsChanged;
+
 	// orthogonal only (this should correspond to what AGS is doing)
 	bool nodiag;
 
@@ -148,6 +164,9 @@ private:
 	bool HasForcedNeighbor(int x, int y, int dx, int dy) const;
 	int FindJump(int x, int y, int dx, int dy, int ex, int ey);
 	int FindOrthoJump(int x, int y, int dx, int dy, int ex, int ey);
+	bool FindTableJump(int x, int y, int dx, int dy, int ex, int ey, int &jump);
+	bool JumpRowsIntact(int y0, int y1) const;
+	static int JumpDir(int dx, int dy);
 
 	// neighbor reachable (nodiag only)
 	bool Reachable(int x0, int y0, int x1, int y1) const;
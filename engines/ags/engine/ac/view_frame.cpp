@@ -117,6 +117,16 @@ void precache_view(int view) {
 	}
 }
 
+void preload_view(int view) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+
+	for (int i = 0; i < _GP(views)[view].numLoops; i++) {
+		for (int j = 0; j < _GP(views)[view].loops[i].numFrames; j++)
+			_GP(spriteset).Preload(_GP(views)[view].loops[i].frames[j].pic);
+	}
+}
+
 // Handle the new animation frame (play linked sounds, etc)
 void CheckViewFrame(int view, int loop, int frame, int sound_volume) {
 	ScriptAudioChannel *channel = nullptr;
@@ -479,6 +479,9 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 
 		if (bitmap->_alpha == 0) {
 		} // fully transparent, do nothing
+		else if (!AreRectsIntersecting(surface->GetClip(),
+				RectWH(drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight()))) {
+		} // entirely outside of the surface's clipping area, do nothing
 		else if ((bitmap->_opaque) && (bitmap->_bmp == surface) && (bitmap->_alpha == 255)) {
 		} else if (bitmap->_opaque) {
 			surface->Blit(bitmap->_bmp, 0, 0, drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight());
@@ -533,6 +536,38 @@ void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bo
 		_screen->addDirtyRect(Common::Rect(x1, y1, x2 + 1, y2 + 1));
 }
 
+void ScummVMRendererGraphicsDriver::copyChangedRect(const Graphics::Surface &src) {
+	assert(src.w == _screen->w && src.h == _screen->h && src.format == _screen->format);
+	const int lineSize = src.w * src.format.bytesPerPixel;
+	int x1 = lineSize, y1 = -1, x2 = -1, y2 = -1;
+
+	for (int y = 0; y < src.h; ++y) {
+		const byte *srcP = (const byte *)src.getBasePtr(0, y);
+		byte *destP = (byte *)_screen->getBasePtr(0, y);
+		if (memcmp(srcP, destP, lineSize) == 0)
+			continue;
+
+		// Find the first and last changed bytes of the line
+		int left = 0, right = lineSize - 1;
+		while (srcP[left] == destP[left])
+			++left;
+		while (srcP[right] == destP[right])
+			--right;
+		memcpy(destP + left, srcP + left, right - left + 1);
+
+		x1 = MIN(x1, left);
+		x2 = MAX(x2, right);
+		if (y1 == -1)
+			y1 = y;
+		y2 = y;
+	}
+
+	if (y1 != -1) {
+		const int bpp = src.format.bytesPerPixel;
+		_screen->addDirtyRect(Common::Rect(x1 / bpp, y1, x2 / bpp + 1, y2 + 1));
+	}
+}
+
 void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicFlip flip) {
 	Graphics::Surface *srcTransformed = nullptr;
 	if (xoff != 0 || yoff != 0 || flip != Shared::kFlip_None) {
@@ -583,8 +618,17 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		renderMode = kRenderOther;
 	}
 
-	if (renderMode != kRenderDirect && !_screen)
+	// Keep the last presented frame, so that only what changed since then
+	// is passed on to the backend
+	if (_screen && (_screen->w != g_system->getWidth() || _screen->h != g_system->getHeight() ||
+			_screen->format != screenFormat)) {
+		delete _screen;
+		_screen = nullptr;
+	}
+	if (!_screen) {
 		_screen = new Graphics::Screen();
+		_screen->markAllDirty();
+	}
 
 	switch (renderMode) {
 	case kRenderToABGR:
@@ -608,6 +652,12 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 	}
 
 	case kRenderDirect:
+		if (src.w == _screen->w && src.h == _screen->h) {
+			// Copy the changed area of the virtual surface to the screen
+			copyChangedRect(src);
+			break;
+		}
+
 		// Blit the virtual surface directly to the screen
 		g_system->copyRectToScreen(src.getPixels(), src.pitch,
 			0, 0, src.w, src.h);
@@ -243,6 +243,7 @@ protected:
 	}
 
 private:
+	// Copy of the last frame passed to the backend
 	Graphics::Screen *_screen = nullptr;
 	PSDLRenderFilter _filter;
 
@@ -295,6 +296,9 @@ private:
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	// Copy raw screen bitmap pixels to the screen
 	void copySurface(const Graphics::Surface &src, bool mode);
+	// Copy the pixels of a surface in the screen format which differ from
+	// the last frame to the screen, and mark them dirty
+	void copyChangedRect(const Graphics::Surface &src);
 	// Render bitmap on screen
 	void Present(int xoff = 0, int yoff = 0, Shared::GraphicFlip flip = Shared::kFlip_None);
 };
@@ -169,6 +169,12 @@ void script_commands_free() {
 	delete g_commands;
 }
 
+const char *script_command_name(int32_t code) {
+	if (code < 0 || code >= CC_NUM_SCCMDS)
+		return "?";
+	return (*g_commands)[code].CmdName;
+}
+
 const char *regnames[] = { "null", "sp", "mar", "ax", "bx", "cx", "op", "dx" };
 
 const char *fixupnames[] = { "null", "fix_gldata", "fix_func", "fix_string", "fix_import", "fix_datadata", "fix_stack" };
@@ -255,6 +261,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_ops            = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -426,6 +433,18 @@ int ccInstance::CallScriptFunction(const char *funcname, int32_t numargs, const
 	_G(currentline) = line_number
 
 #define MAXNEST 50  // number of recursive function calls allowed
+
+// Use computed gotos to dispatch the instructions where the compiler
+// supports them
+#if defined(__GNUC__) && !defined(AGS_DISABLE_THREADED_DISPATCH)
+#define AGS_THREADED_DISPATCH
+#define SCMD_CASE(op) case op: label_##op
+#define SCMD_DEFAULT default: label_default
+#else
+#define SCMD_CASE(op) case op
+#define SCMD_DEFAULT default
+#endif
+
 int ccInstance::Run(int32_t curpc) {
 	pc = curpc;
 	returnValue = -1;
@@ -444,7 +463,93 @@ int ccInstance::Run(int32_t curpc) {
 	int loopIterationCheckDisabled = 0;
 	thisbase[0] = 0;
 	funcstart[0] = pc;
+#ifdef AGS_THREADED_DISPATCH
+	// Jump straight to the instruction's handler, without the switch's checks
+	static const void *dispatch_table[CC_NUM_SCCMDS];
+	if (!dispatch_table[0]) {
+		for (int i = 0; i < CC_NUM_SCCMDS; ++i)
+			dispatch_table[i] = __extension__ &&label_default;
+#define SCMD_DISPATCH(op) dispatch_table[op] = __extension__ &&label_##op
+		SCMD_DISPATCH(SCMD_LINENUM);
+		SCMD_DISPATCH(SCMD_ADD);
+		SCMD_DISPATCH(SCMD_SUB);
+		SCMD_DISPATCH(SCMD_REGTOREG);
+		SCMD_DISPATCH(SCMD_WRITELIT);
+		SCMD_DISPATCH(SCMD_RET);
+		SCMD_DISPATCH(SCMD_LITTOREG);
+		SCMD_DISPATCH(SCMD_MEMREAD);
+		SCMD_DISPATCH(SCMD_MEMWRITE);
+		SCMD_DISPATCH(SCMD_LOADSPOFFS);
+		SCMD_DISPATCH(SCMD_MULREG);
+		SCMD_DISPATCH(SCMD_DIVREG);
+		SCMD_DISPATCH(SCMD_ADDREG);
+		SCMD_DISPATCH(SCMD_SUBREG);
+		SCMD_DISPATCH(SCMD_BITAND);
+		SCMD_DISPATCH(SCMD_BITOR);
+		SCMD_DISPATCH(SCMD_ISEQUAL);
+		SCMD_DISPATCH(SCMD_NOTEQUAL);
+		SCMD_DISPATCH(SCMD_GREATER);
+		SCMD_DISPATCH(SCMD_LESSTHAN);
+		SCMD_DISPATCH(SCMD_GTE);
+		SCMD_DISPATCH(SCMD_LTE);
+		SCMD_DISPATCH(SCMD_AND);
+		SCMD_DISPATCH(SCMD_OR);
+		SCMD_DISPATCH(SCMD_XORREG);
+		SCMD_DISPATCH(SCMD_MODREG);
+		SCMD_DISPATCH(SCMD_NOTREG);
+		SCMD_DISPATCH(SCMD_CALL);
+		SCMD_DISPATCH(SCMD_MEMREADB);
+		SCMD_DISPATCH(SCMD_MEMREADW);
+		SCMD_DISPATCH(SCMD_MEMWRITEB);
+		SCMD_DISPATCH(SCMD_MEMWRITEW);
+		SCMD_DISPATCH(SCMD_JZ);
+		SCMD_DISPATCH(SCMD_JNZ);
+		SCMD_DISPATCH(SCMD_PUSHREG);
+		SCMD_DISPATCH(SCMD_POPREG);
+		SCMD_DISPATCH(SCMD_JMP);
+		SCMD_DISPATCH(SCMD_MUL);
+		SCMD_DISPATCH(SCMD_CHECKBOUNDS);
+		SCMD_DISPATCH(SCMD_DYNAMICBOUNDS);
+		SCMD_DISPATCH(SCMD_MEMREADPTR);
+		SCMD_DISPATCH(SCMD_MEMWRITEPTR);
+		SCMD_DISPATCH(SCMD_MEMINITPTR);
+		SCMD_DISPATCH(SCMD_MEMZEROPTR);
+		SCMD_DISPATCH(SCMD_MEMZEROPTRND);
+		SCMD_DISPATCH(SCMD_CHECKNULL);
+		SCMD_DISPATCH(SCMD_CHECKNULLREG);
+		SCMD_DISPATCH(SCMD_NUMFUNCARGS);
+		SCMD_DISPATCH(SCMD_CALLAS);
+		SCMD_DISPATCH(SCMD_CALLEXT);
+		SCMD_DISPATCH(SCMD_PUSHREAL);
+		SCMD_DISPATCH(SCMD_SUBREALSTACK);
+		SCMD_DISPATCH(SCMD_CALLOBJ);
+		SCMD_DISPATCH(SCMD_SHIFTLEFT);
+		SCMD_DISPATCH(SCMD_SHIFTRIGHT);
+		SCMD_DISPATCH(SCMD_THISBASE);
+		SCMD_DISPATCH(SCMD_NEWARRAY);
+		SCMD_DISPATCH(SCMD_NEWUSEROBJECT);
+		SCMD_DISPATCH(SCMD_FADD);
+		SCMD_DISPATCH(SCMD_FSUB);
+		SCMD_DISPATCH(SCMD_FMULREG);
+		SCMD_DISPATCH(SCMD_FDIVREG);
+		SCMD_DISPATCH(SCMD_FADDREG);
+		SCMD_DISPATCH(SCMD_FSUBREG);
+		SCMD_DISPATCH(SCMD_FGREATER);
+		SCMD_DISPATCH(SCMD_FLESSTHAN);
+		SCMD_DISPATCH(SCMD_FGTE);
+		SCMD_DISPATCH(SCMD_FLTE);
+		SCMD_DISPATCH(SCMD_ZEROMEMORY);
+		SCMD_DISPATCH(SCMD_CREATESTRING);
+		SCMD_DISPATCH(SCMD_STRINGSEQUAL);
+		SCMD_DISPATCH(SCMD_STRINGSNOTEQ);
+		SCMD_DISPATCH(SCMD_LOOPCHECKOFF);
+#undef SCMD_DISPATCH
+	}
+#endif
+
 	ccInstance *codeInst = runningInst;
+	const ScriptCodeOp *codeOps = codeInst->code_ops;
+	const bool opcode_profiling = _G(scriptOpcodeProfiling);
 	bool write_debug_dump = ccGetOption(SCOPT_DEBUGRUN) ||
 		(gDebugLevel > 0 && DebugMan.isDebugChannelEnabled(::AGS::kDebugScript));
 	ScriptOperation codeOp;
@@ -467,24 +572,37 @@ int ccInstance::Run(int32_t curpc) {
 		*/
 		/* ReadOperation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+		bool has_fixups = true;
+		const ScriptCodeOp *decoded = codeOps ? &codeOps[pc] : nullptr;
+		if (decoded && (decoded->Flags & kScCodeOpValid)) {
+			// Validated when the code was loaded
+			codeOp.Instruction.Code         = decoded->Code;
+			codeOp.Instruction.InstanceId   = decoded->InstanceId;
+			codeOp.ArgCount                 = decoded->ArgCount;
+			has_fixups = (decoded->Flags & kScCodeOpHasFixups) != 0;
+		} else {
+			codeOp.Instruction.Code         = codeInst->code[pc];
+			codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+			codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
 
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
-			return -1;
-		}
+			if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+				return -1;
+			}
 
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			if (pc + codeOp.ArgCount >= codeInst->codesize) {
+				cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+				return -1;
+			}
 		}
 
+		if (opcode_profiling)
+			_G(scriptOpcodeCounts)[codeOp.Instruction.Code]++;
+
 		int pc_at = pc + 1;
 		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
+			char fixup = has_fixups ? codeInst->code_fixups[pc_at] : 0;
 			if (fixup > 0) {
 				// could be relative pointer or import address
 				/*
@@ -553,14 +671,20 @@ int ccInstance::Run(int32_t curpc) {
 			DumpInstruction(codeOp);
 		}
 
+#ifdef AGS_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+		goto *dispatch_table[codeOp.Instruction.Code];
+#pragma GCC diagnostic pop
+#endif
 		switch (codeOp.Instruction.Code) {
-		case SCMD_LINENUM:
+		SCMD_CASE(SCMD_LINENUM):
 			line_number = arg1.IValue;
 			_G(currentline) = arg1.IValue;
 			if (_G(new_line_hook))
 				_G(new_line_hook)(this, _G(currentline));
 			break;
-		case SCMD_ADD:
+		SCMD_CASE(SCMD_ADD):
 			// If the register is SREG_SP, we are allocating new variable on the stack
 			if (arg1.IValue == SREG_SP) {
 				// Only allocate new data if current stack entry is invalid;
@@ -579,7 +703,7 @@ int ccInstance::Run(int32_t curpc) {
 				reg1.IValue += arg2.IValue;
 			}
 			break;
-		case SCMD_SUB:
+		SCMD_CASE(SCMD_SUB):
 			if (reg1.Type == kScValStackPtr) {
 				// If this is SREG_SP, this is stack pop, which frees local variables;
 				// Other than SREG_SP this may be AGS 2.x method to offset stack in SREG_MAR;
@@ -599,10 +723,10 @@ int ccInstance::Run(int32_t curpc) {
 				reg1.IValue -= arg2.IValue;
 			}
 			break;
-		case SCMD_REGTOREG:
+		SCMD_CASE(SCMD_REGTOREG):
 			reg2 = reg1;
 			break;
-		case SCMD_WRITELIT:
+		SCMD_CASE(SCMD_WRITELIT):
 			// Take the data address from reg[MAR] and copy there arg1 bytes from arg2 address
 			//
 			// NOTE: since it reads directly from arg2 (which originally was
@@ -625,7 +749,7 @@ int ccInstance::Run(int32_t curpc) {
 				break;
 			}
 			break;
-		case SCMD_RET: {
+		SCMD_CASE(SCMD_RET): {
 			if (loopIterationCheckDisabled > 0)
 				loopIterationCheckDisabled--;
 
@@ -640,18 +764,18 @@ int ccInstance::Run(int32_t curpc) {
 			POP_CALL_STACK;
 			continue; // continue so that the PC doesn't get overwritten
 		}
-		case SCMD_LITTOREG:
+		SCMD_CASE(SCMD_LITTOREG):
 			reg1 = arg2;
 			break;
-		case SCMD_MEMREAD:
+		SCMD_CASE(SCMD_MEMREAD):
 			// Take the data address from reg[MAR] and copy int32_t to reg[arg1]
 			reg1 = registers[SREG_MAR].ReadValue();
 			break;
-		case SCMD_MEMWRITE:
+		SCMD_CASE(SCMD_MEMWRITE):
 			// Take the data address from reg[MAR] and copy there int32_t from reg[arg1]
 			registers[SREG_MAR].WriteValue(reg1);
 			break;
-		case SCMD_LOADSPOFFS:
+		SCMD_CASE(SCMD_LOADSPOFFS):
 			registers[SREG_MAR] = GetStackPtrOffsetRw(arg1.IValue);
 			if (cc_has_error()) {
 				return -1;
@@ -659,68 +783,68 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 
 		// 64 bit: Force 32 bit math
-		case SCMD_MULREG:
+		SCMD_CASE(SCMD_MULREG):
 			reg1.SetInt32(reg1.IValue * reg2.IValue);
 			break;
-		case SCMD_DIVREG:
+		SCMD_CASE(SCMD_DIVREG):
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
 			}
 			reg1.SetInt32(reg1.IValue / reg2.IValue);
 			break;
-		case SCMD_ADDREG:
+		SCMD_CASE(SCMD_ADDREG):
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue += reg2.IValue;
 			break;
-		case SCMD_SUBREG:
+		SCMD_CASE(SCMD_SUBREG):
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue -= reg2.IValue;
 			break;
-		case SCMD_BITAND:
+		SCMD_CASE(SCMD_BITAND):
 			reg1.SetInt32(reg1.IValue & reg2.IValue);
 			break;
-		case SCMD_BITOR:
+		SCMD_CASE(SCMD_BITOR):
 			reg1.SetInt32(reg1.IValue | reg2.IValue);
 			break;
-		case SCMD_ISEQUAL:
+		SCMD_CASE(SCMD_ISEQUAL):
 			reg1.SetInt32AsBool(reg1 == reg2);
 			break;
-		case SCMD_NOTEQUAL:
+		SCMD_CASE(SCMD_NOTEQUAL):
 			reg1.SetInt32AsBool(reg1 != reg2);
 			break;
-		case SCMD_GREATER:
+		SCMD_CASE(SCMD_GREATER):
 			reg1.SetInt32AsBool(reg1.IValue > reg2.IValue);
 			break;
-		case SCMD_LESSTHAN:
+		SCMD_CASE(SCMD_LESSTHAN):
 			reg1.SetInt32AsBool(reg1.IValue < reg2.IValue);
 			break;
-		case SCMD_GTE:
+		SCMD_CASE(SCMD_GTE):
 			reg1.SetInt32AsBool(reg1.IValue >= reg2.IValue);
 			break;
-		case SCMD_LTE:
+		SCMD_CASE(SCMD_LTE):
 			reg1.SetInt32AsBool(reg1.IValue <= reg2.IValue);
 			break;
-		case SCMD_AND:
+		SCMD_CASE(SCMD_AND):
 			reg1.SetInt32AsBool(reg1.IValue && reg2.IValue);
 			break;
-		case SCMD_OR:
+		SCMD_CASE(SCMD_OR):
 			reg1.SetInt32AsBool(reg1.IValue || reg2.IValue);
 			break;
-		case SCMD_XORREG:
+		SCMD_CASE(SCMD_XORREG):
 			reg1.SetInt32(reg1.IValue ^ reg2.IValue);
 			break;
-		case SCMD_MODREG:
+		SCMD_CASE(SCMD_MODREG):
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
 			}
 			reg1.SetInt32(reg1.IValue % reg2.IValue);
 			break;
-		case SCMD_NOTREG:
+		SCMD_CASE(SCMD_NOTREG):
 			reg1 = !(reg1);
 			break;
-		case SCMD_CALL:
+		SCMD_CASE(SCMD_CALL):
 			// Call another function within same script, just save PC
 			// and continue from there
 			if (curnest >= MAXNEST - 1) {
@@ -749,40 +873,40 @@ int ccInstance::Run(int32_t curpc) {
 			thisbase[curnest] = 0;
 			funcstart[curnest] = pc;
 			continue; // continue so that the PC doesn't get overwritten
-		case SCMD_MEMREADB:
+		SCMD_CASE(SCMD_MEMREADB):
 			// Take the data address from reg[MAR] and copy byte to reg[arg1]
 			reg1.SetUInt8(registers[SREG_MAR].ReadByte());
 			break;
-		case SCMD_MEMREADW:
+		SCMD_CASE(SCMD_MEMREADW):
 			// Take the data address from reg[MAR] and copy int16_t to reg[arg1]
 			reg1.SetInt16(registers[SREG_MAR].ReadInt16());
 			break;
-		case SCMD_MEMWRITEB:
+		SCMD_CASE(SCMD_MEMWRITEB):
 			// Take the data address from reg[MAR] and copy there byte from reg[arg1]
 			registers[SREG_MAR].WriteByte(reg1.IValue);
 			break;
-		case SCMD_MEMWRITEW:
+		SCMD_CASE(SCMD_MEMWRITEW):
 			// Take the data address from reg[MAR] and copy there int16_t from reg[arg1]
 			registers[SREG_MAR].WriteInt16(reg1.IValue);
 			break;
-		case SCMD_JZ:
+		SCMD_CASE(SCMD_JZ):
 			if (registers[SREG_AX].IsNull())
 				pc += arg1.IValue;
 			break;
-		case SCMD_JNZ:
+		SCMD_CASE(SCMD_JNZ):
 			if (!registers[SREG_AX].IsNull())
 				pc += arg1.IValue;
 			break;
-		case SCMD_PUSHREG:
+		SCMD_CASE(SCMD_PUSHREG):
 			// Push reg[arg1] value to the stack
 			ASSERT_STACK_SPACE_AVAILABLE(1);
 			PushValueToStack(reg1);
 			break;
-		case SCMD_POPREG:
+		SCMD_CASE(SCMD_POPREG):
 			ASSERT_STACK_SIZE(1);
 			reg1 = PopValueFromStack();
 			break;
-		case SCMD_JMP:
+		SCMD_CASE(SCMD_JMP):
 			pc += arg1.IValue;
 
 			// Make sure it's not stuck in a While loop
@@ -804,17 +928,17 @@ int ccInstance::Run(int32_t curpc) {
 				}
 			}
 			break;
-		case SCMD_MUL:
+		SCMD_CASE(SCMD_MUL):
 			reg1.IValue *= arg2.IValue;
 			break;
-		case SCMD_CHECKBOUNDS:
+		SCMD_CASE(SCMD_CHECKBOUNDS):
 			if ((reg1.IValue < 0) ||
 			        (reg1.IValue >= arg2.IValue)) {
 				cc_error("!Array index out of bounds (index: %d, bounds: 0..%d)", reg1.IValue, arg2.IValue - 1);
 				return -1;
 			}
 			break;
-		case SCMD_DYNAMICBOUNDS: {
+		SCMD_CASE(SCMD_DYNAMICBOUNDS): {
 			// TODO: test reg[MAR] type here;
 			// That might be dynamic object, but also a non-managed dynamic array, "allocated"
 			// on global or local memspace (buffer)
@@ -835,7 +959,7 @@ int ccInstance::Run(int32_t curpc) {
 
 		// 64 bit: Handles are always 32 bit values. They are not C pointer.
 
-		case SCMD_MEMREADPTR: {
+		SCMD_CASE(SCMD_MEMREADPTR): {
 			cc_clear_error();
 
 			int32_t handle = registers[SREG_MAR].ReadInt32();
@@ -853,7 +977,7 @@ int ccInstance::Run(int32_t curpc) {
 				return -1;
 			break;
 		}
-		case SCMD_MEMWRITEPTR: {
+		SCMD_CASE(SCMD_MEMWRITEPTR): {
 
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			const char *address = nullptr;
@@ -884,7 +1008,7 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			break;
 		}
-		case SCMD_MEMINITPTR: {
+		SCMD_CASE(SCMD_MEMINITPTR): {
 			const char *address = nullptr;
 
 			if (reg1.Type == kScValStaticArray && reg1.StcArr->GetDynamicManager()) {
@@ -910,13 +1034,13 @@ int ccInstance::Run(int32_t curpc) {
 			registers[SREG_MAR].WriteInt32(newHandle);
 			break;
 		}
-		case SCMD_MEMZEROPTR: {
+		SCMD_CASE(SCMD_MEMZEROPTR): {
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			ccReleaseObjectReference(handle);
 			registers[SREG_MAR].WriteInt32(0);
 			break;
 		}
-		case SCMD_MEMZEROPTRND: {
+		SCMD_CASE(SCMD_MEMZEROPTRND): {
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 
 			// don't do the Dispose check for the object being returned -- this is
@@ -930,22 +1054,22 @@ int ccInstance::Run(int32_t curpc) {
 			registers[SREG_MAR].WriteInt32(0);
 			break;
 		}
-		case SCMD_CHECKNULL:
+		SCMD_CASE(SCMD_CHECKNULL):
 			if (registers[SREG_MAR].IsNull()) {
 				cc_error("!Null pointer referenced");
 				return -1;
 			}
 			break;
-		case SCMD_CHECKNULLREG:
+		SCMD_CASE(SCMD_CHECKNULLREG):
 			if (reg1.IsNull()) {
 				cc_error("!Null string referenced");
 				return -1;
 			}
 			break;
-		case SCMD_NUMFUNCARGS:
+		SCMD_CASE(SCMD_NUMFUNCARGS):
 			num_args_to_func = arg1.IValue;
 			break;
-		case SCMD_CALLAS: {
+		SCMD_CASE(SCMD_CALLAS): {
 			PUSH_CALL_STACK;
 
 			// Call to a function in another script
@@ -1003,7 +1127,7 @@ int ccInstance::Run(int32_t curpc) {
 			POP_CALL_STACK;
 			break;
 		}
-		case SCMD_CALLEXT: {
+		SCMD_CASE(SCMD_CALLEXT): {
 			// Call to a real 'C' code function
 			was_just_callas = -1;
 			if (num_args_to_func < 0) {
@@ -1069,10 +1193,10 @@ int ccInstance::Run(int32_t curpc) {
 			num_args_to_func = -1;
 			break;
 		}
-		case SCMD_PUSHREAL:
+		SCMD_CASE(SCMD_PUSHREAL):
 			PushToFuncCallStack(func_callstack, reg1);
 			break;
-		case SCMD_SUBREALSTACK:
+		SCMD_CASE(SCMD_SUBREALSTACK):
 			PopFromFuncCallStack(func_callstack, arg1.IValue);
 			if (was_just_callas >= 0) {
 				ASSERT_STACK_SIZE(arg1.IValue);
@@ -1080,7 +1204,7 @@ int ccInstance::Run(int32_t curpc) {
 				was_just_callas = -1;
 			}
 			break;
-		case SCMD_CALLOBJ:
+		SCMD_CASE(SCMD_CALLOBJ):
 			// set the OP register
 			if (reg1.IsNull()) {
 				cc_error("!Null pointer referenced");
@@ -1113,16 +1237,16 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			next_call_needs_object = 1;
 			break;
-		case SCMD_SHIFTLEFT:
+		SCMD_CASE(SCMD_SHIFTLEFT):
 			reg1.SetInt32(reg1.IValue << reg2.IValue);
 			break;
-		case SCMD_SHIFTRIGHT:
+		SCMD_CASE(SCMD_SHIFTRIGHT):
 			reg1.SetInt32(reg1.IValue >> reg2.IValue);
 			break;
-		case SCMD_THISBASE:
+		SCMD_CASE(SCMD_THISBASE):
 			thisbase[curnest] = arg1.IValue;
 			break;
-		case SCMD_NEWARRAY: {
+		SCMD_CASE(SCMD_NEWARRAY): {
 			int numElements = reg1.IValue;
 			if (numElements < 1) {
 				cc_error("invalid size for dynamic array; requested: %d, range: 1..%d", numElements, INT32_MAX);
@@ -1132,7 +1256,7 @@ int ccInstance::Run(int32_t curpc) {
 			reg1.SetDynamicObject(ref.second, &_GP(globalDynamicArray));
 			break;
 		}
-		case SCMD_NEWUSEROBJECT: {
+		SCMD_CASE(SCMD_NEWUSEROBJECT): {
 			const int32_t size = arg2.IValue;
 			if (size < 0) {
 				cc_error("Invalid size for user object; requested: %d (or %d), range: 0..%d", (uint32_t)size, size, INT_MAX);
@@ -1142,41 +1266,41 @@ int ccInstance::Run(int32_t curpc) {
 			reg1.SetDynamicObject(suo, suo);
 			break;
 		}
-		case SCMD_FADD:
+		SCMD_CASE(SCMD_FADD):
 			reg1.SetFloat(reg1.FValue + arg2.IValue); // arg2 was used as int here originally
 			break;
-		case SCMD_FSUB:
+		SCMD_CASE(SCMD_FSUB):
 			reg1.SetFloat(reg1.FValue - arg2.IValue); // arg2 was used as int here originally
 			break;
-		case SCMD_FMULREG:
+		SCMD_CASE(SCMD_FMULREG):
 			reg1.SetFloat(reg1.FValue * reg2.FValue);
 			break;
-		case SCMD_FDIVREG:
+		SCMD_CASE(SCMD_FDIVREG):
 			if (reg2.FValue == 0.0) {
 				cc_error("!Floating point divide by zero");
 				return -1;
 			}
 			reg1.SetFloat(reg1.FValue / reg2.FValue);
 			break;
-		case SCMD_FADDREG:
+		SCMD_CASE(SCMD_FADDREG):
 			reg1.SetFloat(reg1.FValue + reg2.FValue);
 			break;
-		case SCMD_FSUBREG:
+		SCMD_CASE(SCMD_FSUBREG):
 			reg1.SetFloat(reg1.FValue - reg2.FValue);
 			break;
-		case SCMD_FGREATER:
+		SCMD_CASE(SCMD_FGREATER):
 			reg1.SetFloatAsBool(reg1.FValue > reg2.FValue);
 			break;
-		case SCMD_FLESSTHAN:
+		SCMD_CASE(SCMD_FLESSTHAN):
 			reg1.SetFloatAsBool(reg1.FValue < reg2.FValue);
 			break;
-		case SCMD_FGTE:
+		SCMD_CASE(SCMD_FGTE):
 			reg1.SetFloatAsBool(reg1.FValue >= reg2.FValue);
 			break;
-		case SCMD_FLTE:
+		SCMD_CASE(SCMD_FLTE):
 			reg1.SetFloatAsBool(reg1.FValue <= reg2.FValue);
 			break;
-		case SCMD_ZEROMEMORY:
+		SCMD_CASE(SCMD_ZEROMEMORY):
 			// Check if we are zeroing at stack tail
 			if (registers[SREG_MAR] == registers[SREG_SP]) {
 				// creating a local variable -- check the stack to ensure no mem overrun
@@ -1198,7 +1322,7 @@ int ccInstance::Run(int32_t curpc) {
 				return -1;
 			}
 			break;
-		case SCMD_CREATESTRING:
+		SCMD_CASE(SCMD_CREATESTRING):
 			if (_G(stringClassImpl) == nullptr) {
 				cc_error("No string class implementation set, but opcode was used");
 				return -1;
@@ -1208,7 +1332,7 @@ int ccInstance::Run(int32_t curpc) {
 			    _G(stringClassImpl)->CreateString(direct_ptr1).second,
 			    &_GP(myScriptStringImpl));
 			break;
-		case SCMD_STRINGSEQUAL:
+		SCMD_CASE(SCMD_STRINGSEQUAL):
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1218,7 +1342,7 @@ int ccInstance::Run(int32_t curpc) {
 			reg1.SetInt32AsBool(strcmp(direct_ptr1, direct_ptr2) == 0);
 
 			break;
-		case SCMD_STRINGSNOTEQ:
+		SCMD_CASE(SCMD_STRINGSNOTEQ):
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1227,11 +1351,11 @@ int ccInstance::Run(int32_t curpc) {
 			direct_ptr2 = (const char *)reg2.GetDirectPtr();
 			reg1.SetInt32AsBool(strcmp(direct_ptr1, direct_ptr2) != 0);
 			break;
-		case SCMD_LOOPCHECKOFF:
+		SCMD_CASE(SCMD_LOOPCHECKOFF):
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
-		default:
+		SCMD_DEFAULT:
 			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
 			return -1;
 		}
@@ -1425,6 +1549,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_ops = joined->code_ops;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1507,9 +1632,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] code_ops;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_ops = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1715,9 +1842,44 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+
+	// The code won't change anymore, so the instructions may be decoded now
+	DecodeCodeOps();
 	return true;
 }
 
+void ccInstance::DecodeCodeOps() {
+	if ((flags & INSTF_SHAREDATA) != 0 || codesize <= 0)
+		return;
+
+	delete[] code_ops;
+	// Positions where no valid instruction starts stay zeroed, and are
+	// decoded (and reported) by Run() as they are reached
+	code_ops = new ScriptCodeOp[codesize]();
+
+	for (int32_t at_pc = 0; at_pc < codesize;) {
+		int32_t instr = (int32_t)(code[at_pc] & INSTANCE_ID_REMOVEMASK);
+		if (instr < 0 || instr >= CC_NUM_SCCMDS)
+			break;
+
+		int arg_count = (*g_commands)[instr].ArgCount;
+		if (at_pc + arg_count >= codesize)
+			break;
+
+		ScriptCodeOp &op = code_ops[at_pc];
+		op.Code = (uint8_t)instr;
+		op.InstanceId = (uint8_t)((code[at_pc] >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK);
+		op.ArgCount = (uint8_t)arg_count;
+		op.Flags = kScCodeOpValid;
+		for (int i = 1; i <= arg_count; ++i) {
+			if (code_fixups[at_pc + i] > 0)
+				op.Flags |= kScCodeOpHasFixups;
+		}
+
+		at_pc += arg_count + 1;
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -69,6 +69,20 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction decoded in advance, once all the fixups of the code are
+// resolved; stored at the code position where the instruction starts
+struct ScriptCodeOp {
+	uint8_t Code;       // pure instruction code
+	uint8_t InstanceId;
+	uint8_t ArgCount;
+	uint8_t Flags;      // ScriptCodeOpFlags
+};
+
+enum ScriptCodeOpFlags {
+	kScCodeOpValid      = 0x01, // an instruction starts here and fits in the code
+	kScCodeOpHasFixups  = 0x02  // at least one argument needs fixing up
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -139,6 +153,9 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// Pre-decoded instructions, one per code position; null until the
+	// import fixups are resolved
+	ScriptCodeOp *code_ops;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -189,6 +206,8 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decode the final code into code_ops
+	void    DecodeCodeOps();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Begin executing script starting from the given bytecode index
@@ -224,6 +243,8 @@ private:
 
 extern void script_commands_init();
 extern void script_commands_free();
+// Get the mnemonic of the given instruction code
+extern const char *script_command_name(int32_t code);
 
 } // namespace AGS3
 
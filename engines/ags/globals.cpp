@@ -362,6 +362,7 @@ Globals::Globals() {
 	// script_runtime.cpp globals
 	Common::fill(_loadedInstances, _loadedInstances + MAX_LOADED_INSTANCES,
 	             (ccInstance *)nullptr);
+	Common::fill(_scriptOpcodeCounts, _scriptOpcodeCounts + CC_NUM_SCCMDS, 0);
 
 	// system_imports.cpp globals
 	_simp = new SystemImports();
@@ -1221,6 +1221,9 @@ public:
 	int _num_navpoints = 0;
 	fixed _move_speed_x = 0, _move_speed_y = 0;
 	AGS::Shared::Bitmap *_wallscreen = nullptr;
+	// wallscreen layout the navigation grid rows currently point into
+	const uint8_t *_nav_grid_data = nullptr;
+	int _nav_grid_width = 0, _nav_grid_height = 0, _nav_grid_pitch = 0;
 	int _lastcx = 0, _lastcy = 0;
 	std::unique_ptr<IRouteFinder> *_route_finder_impl;
 
@@ -1297,6 +1300,9 @@ public:
 	// after which the interpreter will abort
 	unsigned _maxWhileLoops = 0u;
 	ccInstance *_loadedInstances[MAX_LOADED_INSTANCES];
+	// Whether to count the executed instructions by code, and the counts
+	bool _scriptOpcodeProfiling = false;
+	uint32_t _scriptOpcodeCounts[CC_NUM_SCCMDS];
 
 	/**@}*/
 
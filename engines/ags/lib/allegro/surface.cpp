@@ -22,6 +22,7 @@
 #include "ags/lib/allegro/gfx.h"
 #include "ags/lib/allegro/color.h"
 #include "ags/lib/allegro/flood.h"
+#include "ags/lib/allegro/surface_simd.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
 #include "common/textconsole.h"
@@ -107,6 +108,170 @@ void BITMAP::floodfill(int x, int y, int color) {
 const int SCALE_THRESHOLD = 0x100;
 #define VGA_COLOR_TRANS(x) ((x) * 255 / 63)
 
+namespace {
+
+BlendRowProc getBlendRowProc() {
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return blendRowSSE2;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureSSE2))
+		return blendRowSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return blendRowNEON;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureNEON))
+		return blendRowNEON;
+#endif
+#endif
+	return nullptr;
+}
+
+} // End of anonymous namespace
+
+void BITMAP::initDrawRowParams(DrawRowParams &params, const Graphics::PixelFormat &srcFormat,
+                               PALETTE palette, bool skipTrans, int srcAlpha, int tintRed,
+                               int tintGreen, int tintBlue) const {
+	params.srcFormat = &srcFormat;
+	params.palette = palette;
+	params.skipTrans = skipTrans;
+	params.srcAlpha = srcAlpha;
+	params.useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
+	params.tintRed = tintRed;
+	params.tintGreen = tintGreen;
+	params.tintBlue = tintBlue;
+	params.sameFormat = (srcFormat == format);
+
+	if (srcFormat.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
+		for (int i = 0; i < PAL_SIZE; ++i) {
+			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
+			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
+			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
+		}
+	}
+
+	params.transColor = 0;
+	params.alphaMask = 0xff;
+	if (skipTrans && srcFormat.bytesPerPixel != 1) {
+		params.transColor = srcFormat.ARGBToColor(0, 255, 0, 255);
+		params.alphaMask = srcFormat.ARGBToColor(255, 0, 0, 0);
+		params.alphaMask = ~params.alphaMask;
+	}
+
+	// The vectorized blenders only handle the engine's 32-bit format
+	static const BlendRowProc blendRowProc = getBlendRowProc();
+	const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	params.blendRow = nullptr;
+	if (blendRowProc && params.sameFormat && format == argb8888 && !params.useTint &&
+	        (srcAlpha == -1 || (srcAlpha >= 0 && srcAlpha <= 255 && isBlendRowMode(_G(_blender_mode)))))
+		params.blendRow = blendRowProc;
+}
+
+BITMAP::DrawRowProc BITMAP::getDrawRowProc(int destBpp, int srcBpp) {
+	switch (destBpp) {
+	case 1:
+		return &BITMAP::drawRow<1, 1>;
+	case 2:
+		if (srcBpp == 1)
+			return &BITMAP::drawRow<2, 1>;
+		else if (srcBpp == 2)
+			return &BITMAP::drawRow<2, 2>;
+		return &BITMAP::drawRow<2, 4>;
+	default:
+		if (srcBpp == 1)
+			return &BITMAP::drawRow<4, 1>;
+		else if (srcBpp == 2)
+			return &BITMAP::drawRow<4, 2>;
+		return &BITMAP::drawRow<4, 4>;
+	}
+}
+
+template<int DestBytesPerPixel, int SrcBytesPerPixel>
+void BITMAP::drawRow(byte *destP, const byte *srcP, int xStart, int width, int destWidth,
+                     int srcStep, const DrawRowParams &params) const {
+	// Only draw the pixels which are inside the destination area
+	int xCtr = MAX(0, -xStart);
+	const int xEnd = MIN(width, destWidth - xStart);
+	if (xCtr >= xEnd)
+		return;
+
+	if (DestBytesPerPixel == 4 && SrcBytesPerPixel == 4 && params.blendRow && srcStep == SCALE_THRESHOLD) {
+		xCtr += params.blendRow((uint32 *)destP + xStart + xCtr, (const uint32 *)srcP + xCtr,
+		                        xEnd - xCtr, _G(_blender_mode), params.srcAlpha, params.skipTrans);
+	}
+
+	byte rSrc, gSrc, bSrc, aSrc;
+	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
+
+	// Loop through the pixels of the row
+	for (; xCtr < xEnd; ++xCtr) {
+		const byte *srcVal = srcP + (xCtr * srcStep / SCALE_THRESHOLD) * SrcBytesPerPixel;
+		uint32 srcCol = getColor(srcVal, SrcBytesPerPixel);
+
+		// Check if this is a transparent color we should skip
+		if (params.skipTrans && ((srcCol & params.alphaMask) == params.transColor))
+			continue;
+
+		byte *destVal = (byte *)&destP[(xStart + xCtr) * DestBytesPerPixel];
+
+		// When blitting to the same format we can just copy the color
+		if (DestBytesPerPixel == 1) {
+			*destVal = srcCol;
+			continue;
+		} else if (params.sameFormat && params.srcAlpha == -1) {
+			if (DestBytesPerPixel == 4)
+				*(uint32 *)destVal = srcCol;
+			else
+				*(uint16 *)destVal = srcCol;
+			continue;
+		}
+
+		// We need the rgb values to do blending and/or convert between formats
+		if (SrcBytesPerPixel == 1) {
+			const RGB &rgb = params.palette[srcCol];
+			aSrc = 0xff;
+			rSrc = rgb.r;
+			gSrc = rgb.g;
+			bSrc = rgb.b;
+		} else
+			params.srcFormat->colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
+
+		if (params.srcAlpha == -1) {
+			// This means we don't use blending.
+			aDest = aSrc;
+			rDest = rSrc;
+			gDest = gSrc;
+			bDest = bSrc;
+		} else {
+			if (params.useTint) {
+				rDest = rSrc;
+				gDest = gSrc;
+				bDest = bSrc;
+				aDest = aSrc;
+				rSrc = params.tintRed;
+				gSrc = params.tintGreen;
+				bSrc = params.tintBlue;
+				aSrc = params.srcAlpha;
+			} else {
+				// TODO: move this to blendPixel to only do it when needed?
+				format.colorToARGB(getColor(destVal, DestBytesPerPixel), aDest, rDest, gDest, bDest);
+			}
+			blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, params.srcAlpha);
+		}
+
+		uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
+		if (DestBytesPerPixel == 4)
+			*(uint32 *)destVal = pixel;
+		else
+			*(uint16 *)destVal = pixel;
+	}
+}
+
 void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
                   int dstX, int dstY, bool horizFlip, bool vertFlip,
                   bool skipTrans, int srcAlpha, int tintRed, int tintGreen,
@@ -140,28 +305,12 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	Graphics::Surface destArea = dest.getSubArea(destRect);
 
 	// Define scaling and other stuff used by the drawing loops
-	const int xDir = horizFlip ? -1 : 1;
-	bool useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
-	bool sameFormat = (src.format == format);
-
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
+	const int srcStep = horizFlip ? -SCALE_THRESHOLD : SCALE_THRESHOLD;
 
 	PALETTE palette;
-	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
-		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
-		}
-	}
-
-	uint32 transColor = 0, alphaMask = 0xff;
-	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
-	}
+	DrawRowParams params;
+	initDrawRowParams(params, src.format, palette, skipTrans, srcAlpha, tintRed, tintGreen, tintBlue);
+	const DrawRowProc drawRowProc = getDrawRowProc(format.bytesPerPixel, src.format.bytesPerPixel);
 
 	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
 	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
@@ -175,71 +324,7 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		                       vertFlip ? srcArea.bottom - 1 - yCtr :
 		                       srcArea.top + yCtr);
 
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
-			const byte *srcVal = srcP + xDir * xCtrBpp;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
-
-			// Check if this is a transparent color we should skip
-			if (skipTrans && ((srcCol & alphaMask) == transColor))
-				continue;
-
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
-
-			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
-				*destVal = srcCol;
-				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
-				continue;
-			}
-
-			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
-				aSrc = 0xff;
-				rSrc = rgb.r;
-				gSrc = rgb.g;
-				bSrc = rgb.b;
-			} else
-				src.format.colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
-
-			if (srcAlpha == -1) {
-				// This means we don't use blending.
-				aDest = aSrc;
-				rDest = rSrc;
-				gDest = gSrc;
-				bDest = bSrc;
-			} else {
-				if (useTint) {
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-					aDest = aSrc;
-					rSrc = tintRed;
-					gSrc = tintGreen;
-					bSrc = tintBlue;
-					aSrc = srcAlpha;
-				} else {
-					// TODO: move this to blendPixel to only do it when needed?
-					format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				}
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
-			}
-
-			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
-				*(uint32 *)destVal = pixel;
-			else
-				*(uint16 *)destVal = pixel;
-		}
+		(this->*drawRowProc)(destP, srcP, xStart, dstRect.width(), destArea.w, srcStep, params);
 	}
 }
 
@@ -269,26 +354,11 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	// Define scaling and other stuff used by the drawing loops
 	const int scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
 	const int scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
-	bool sameFormat = (src.format == format);
-
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
 
 	PALETTE palette;
-	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
-		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
-		}
-	}
-
-	uint32 transColor = 0, alphaMask = 0xff;
-	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
-	}
+	DrawRowParams params;
+	initDrawRowParams(params, src.format, palette, skipTrans, srcAlpha, -1, -1, -1);
+	const DrawRowProc drawRowProc = getDrawRowProc(format.bytesPerPixel, src.format.bytesPerPixel);
 
 	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
 	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
@@ -301,61 +371,7 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		const byte *srcP = (const byte *)src.getBasePtr(
 		                       srcRect.left, srcRect.top + scaleYCtr / SCALE_THRESHOLD);
 
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, scaleXCtr = 0; xCtr < dstRect.width();
-		        ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
-			const byte *srcVal = srcP + scaleXCtr / SCALE_THRESHOLD * src.format.bytesPerPixel;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
-
-			// Check if this is a transparent color we should skip
-			if (skipTrans && ((srcCol & alphaMask) == transColor))
-				continue;
-
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
-
-			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
-				*destVal = srcCol;
-				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
-				continue;
-			}
-
-			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
-				aSrc = 0xff;
-				rSrc = rgb.r;
-				gSrc = rgb.g;
-				bSrc = rgb.b;
-			} else
-				src.format.colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
-
-			if (srcAlpha == -1) {
-				// This means we don't use blending.
-				aDest = aSrc;
-				rDest = rSrc;
-				gDest = gSrc;
-				bDest = bSrc;
-			} else {
-				// TODO: move this to blendPixel to only do it when needed?
-				format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
-			}
-
-			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
-				*(uint32 *)destVal = pixel;
-			else
-				*(uint16 *)destVal = pixel;
-		}
+		(this->*drawRowProc)(destP, srcP, xStart, dstRect.width(), destArea.w, scaleX, params);
 	}
 }
 
@@ -24,6 +24,7 @@
 
 #include "graphics/managed_surface.h"
 #include "ags/lib/allegro/base.h"
+#include "ags/lib/allegro/surface_simd.h"
 #include "common/array.h"
 
 namespace AGS3 {
@@ -130,6 +131,34 @@ public:
 	// unsigned int blender_func(unsigned long x, unsigned long y, unsigned long n)
 	// when x is the sprite color, y the destination color, and n an alpha value
 
+	// Everything draw and stretchDraw need to draw a row of pixels
+	struct DrawRowParams {
+		const Graphics::PixelFormat *srcFormat;
+		const RGB *palette;
+		BlendRowProc blendRow; // Vectorized blender usable for these rows, if any
+		uint32 transColor;
+		uint32 alphaMask;
+		int srcAlpha;
+		int tintRed, tintGreen, tintBlue;
+		bool skipTrans;
+		bool useTint;
+		bool sameFormat;
+	};
+
+	typedef void (BITMAP::*DrawRowProc)(byte *destP, const byte *srcP, int xStart, int width,
+	                                    int destWidth, int srcStep, const DrawRowParams &params) const;
+
+	void initDrawRowParams(DrawRowParams &params, const Graphics::PixelFormat &srcFormat,
+	                       PALETTE palette, bool skipTrans, int srcAlpha, int tintRed,
+	                       int tintGreen, int tintBlue) const;
+	static DrawRowProc getDrawRowProc(int destBpp, int srcBpp);
+
+	// Draw the pixels 0 to width - 1 of a row at xStart in the destination,
+	// stepping through the source by srcStep / SCALE_THRESHOLD pixels
+	template<int DestBytesPerPixel, int SrcBytesPerPixel>
+	void drawRow(byte *destP, const byte *srcP, int xStart, int width, int destWidth,
+	             int srcStep, const DrawRowParams &params) const;
+
 	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
 
 
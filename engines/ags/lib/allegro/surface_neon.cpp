@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "ags/lib/allegro/surface_simd.h"
+
+#include <arm_neon.h>
+
+namespace AGS3 {
+
+namespace {
+
+// The factor BITMAP::rgbBlend uses for the alpha values in t
+inline uint32x4_t blendFactor(uint32x4_t t) {
+	// t ? t + 1 : 0
+	return vaddq_u32(t, vaddq_u32(vdupq_n_u32(1), vceqq_u32(t, vdupq_n_u32(0))));
+}
+
+// BITMAP::rgbBlend, with the same wrapping 32-bit arithmetic. The alpha of
+// the result is 0.
+inline uint32x4_t rgbBlend(uint32x4_t x, uint32x4_t y, uint32x4_t f) {
+	const uint32x4_t rbMask = vdupq_n_u32(0xFF00FF);
+	const uint32x4_t gMask = vdupq_n_u32(0xFF00);
+
+	uint32x4_t yRgb = vandq_u32(y, vdupq_n_u32(0xFFFFFF));
+	uint32x4_t rb = vsubq_u32(vandq_u32(x, rbMask), vandq_u32(y, rbMask));
+	rb = vaddq_u32(vshrq_n_u32(vmulq_u32(rb, f), 8), yRgb);
+
+	uint32x4_t yG = vandq_u32(y, gMask);
+	uint32x4_t g = vsubq_u32(vandq_u32(x, gMask), yG);
+	g = vaddq_u32(vshrq_n_u32(vmulq_u32(g, f), 8), yG);
+
+	return vorrq_u32(vandq_u32(rb, rbMask), vandq_u32(g, gMask));
+}
+
+template<int Mode>
+int blendRow(uint32 *dst, const uint32 *src, int width, uint32 alpha, bool skipTrans) {
+	const uint32x4_t rgbMask = vdupq_n_u32(0xFFFFFF);
+	const uint32x4_t alphaMask = vdupq_n_u32(0xFF000000);
+	const uint32x4_t transColor = vdupq_n_u32(0xFF00FF);
+	const uint32x4_t constFactor = blendFactor(vdupq_n_u32(alpha));
+	const uint32x4_t alphaScale = vdupq_n_u32((alpha & 0xff) + 1);
+
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		uint32x4_t s = vld1q_u32(src + x);
+		uint32x4_t d = vld1q_u32(dst + x);
+		uint32x4_t out;
+
+		switch (Mode) {
+		case kSourceAlphaBlender:
+			out = rgbBlend(s, d, blendFactor(vshrq_n_u32(s, 24)));
+			break;
+		case kArgbToRgbBlender: {
+			uint32x4_t t = vshrq_n_u32(s, 24);
+			if (alpha != 0)
+				t = vshrq_n_u32(vmulq_u32(t, alphaScale), 8);
+			out = rgbBlend(s, d, blendFactor(t));
+			break;
+		}
+		case kRgbToRgbBlender:
+			out = rgbBlend(s, d, constFactor);
+			break;
+		case kAlphaPreservedBlenderMode:
+			out = vorrq_u32(rgbBlend(s, d, constFactor), vandq_u32(d, alphaMask));
+			break;
+		case kOpaqueBlenderMode:
+			out = vorrq_u32(s, alphaMask);
+			break;
+		case kAdditiveBlenderMode: {
+			uint32x4_t a = vreinterpretq_u32_u8(vqaddq_u8(vreinterpretq_u8_u32(s), vreinterpretq_u8_u32(d)));
+			out = vorrq_u32(vandq_u32(s, rgbMask), vandq_u32(a, alphaMask));
+			break;
+		}
+		default:
+			// Plain copy
+			out = s;
+			break;
+		}
+
+		if (skipTrans) {
+			uint32x4_t trans = vceqq_u32(vandq_u32(s, rgbMask), transColor);
+			out = vbslq_u32(trans, d, out);
+		}
+
+		vst1q_u32(dst + x, out);
+	}
+
+	return x;
+}
+
+} // End of anonymous namespace
+
+int blendRowNEON(uint32 *dst, const uint32 *src, int width, BlenderMode mode, int srcAlpha, bool skipTrans) {
+	if (srcAlpha == -1)
+		return blendRow<-1>(dst, src, width, 0, skipTrans);
+
+	switch (mode) {
+	case kSourceAlphaBlender:
+		return blendRow<kSourceAlphaBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kArgbToRgbBlender:
+		return blendRow<kArgbToRgbBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kRgbToRgbBlender:
+		return blendRow<kRgbToRgbBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kAlphaPreservedBlenderMode:
+		return blendRow<kAlphaPreservedBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	case kOpaqueBlenderMode:
+		return blendRow<kOpaqueBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	case kAdditiveBlenderMode:
+		return blendRow<kAdditiveBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	default:
+		return 0;
+	}
+}
+
+} // namespace AGS3
@@ -0,0 +1,63 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef AGS_LIB_ALLEGRO_SURFACE_SIMD_H
+#define AGS_LIB_ALLEGRO_SURFACE_SIMD_H
+
+#include "ags/lib/allegro/color.h"
+
+namespace AGS3 {
+
+/**
+ * Vectorized row blenders for ARGB8888 sources and destinations, giving the
+ * same results as BITMAP::draw. A srcAlpha of -1 copies the pixels. They
+ * return how many leading pixels of the row they handled, the remaining
+ * ones are left to the generic code.
+ */
+typedef int (*BlendRowProc)(uint32 *dst, const uint32 *src, int width, BlenderMode mode, int srcAlpha, bool skipTrans);
+
+#ifdef SCUMMVM_SSE2
+int blendRowSSE2(uint32 *dst, const uint32 *src, int width, BlenderMode mode, int srcAlpha, bool skipTrans);
+#endif
+#ifdef SCUMMVM_NEON
+int blendRowNEON(uint32 *dst, const uint32 *src, int width, BlenderMode mode, int srcAlpha, bool skipTrans);
+#endif
+
+/** Whether the vectorized blenders implement the given blender mode. */
+inline bool isBlendRowMode(BlenderMode mode) {
+	switch (mode) {
+	case kSourceAlphaBlender:
+	case kArgbToRgbBlender:
+	case kRgbToRgbBlender:
+	case kAlphaPreservedBlenderMode:
+	case kOpaqueBlenderMode:
+	case kAdditiveBlenderMode:
+		return true;
+	default:
+		// The ARGB blenders use floating point and the tint ones HSV
+		return false;
+	}
+}
+
+} // namespace AGS3
+
+#endif
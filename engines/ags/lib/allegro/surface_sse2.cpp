@@ -0,0 +1,142 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "ags/lib/allegro/surface_simd.h"
+
+#include <emmintrin.h>
+
+namespace AGS3 {
+
+namespace {
+
+// Low 32 bits of the products of each lane of v with the factor in the same
+// lane of f. The factors must fit in 16 bits and be repeated in both halves
+// of their lane.
+inline __m128i mul32(__m128i v, __m128i f) {
+	__m128i lo = _mm_mullo_epi16(v, f);
+	__m128i hi = _mm_slli_epi32(_mm_mulhi_epu16(v, f), 16);
+	return _mm_add_epi32(lo, hi);
+}
+
+// The factor BITMAP::rgbBlend uses for the alpha values in t
+inline __m128i blendFactor(__m128i t) {
+	// t ? t + 1 : 0
+	__m128i f = _mm_add_epi32(t, _mm_add_epi32(_mm_set1_epi32(1), _mm_cmpeq_epi32(t, _mm_setzero_si128())));
+	return _mm_or_si128(f, _mm_slli_epi32(f, 16));
+}
+
+// BITMAP::rgbBlend, with the same wrapping 32-bit arithmetic. The alpha of
+// the result is 0.
+inline __m128i rgbBlend(__m128i x, __m128i y, __m128i f) {
+	const __m128i rbMask = _mm_set1_epi32(0xFF00FF);
+	const __m128i gMask = _mm_set1_epi32(0xFF00);
+
+	__m128i yRgb = _mm_and_si128(y, _mm_set1_epi32(0xFFFFFF));
+	__m128i rb = _mm_sub_epi32(_mm_and_si128(x, rbMask), _mm_and_si128(y, rbMask));
+	rb = _mm_add_epi32(_mm_srli_epi32(mul32(rb, f), 8), yRgb);
+
+	__m128i yG = _mm_and_si128(y, gMask);
+	__m128i g = _mm_sub_epi32(_mm_and_si128(x, gMask), yG);
+	g = _mm_add_epi32(_mm_srli_epi32(mul32(g, f), 8), yG);
+
+	return _mm_or_si128(_mm_and_si128(rb, rbMask), _mm_and_si128(g, gMask));
+}
+
+template<int Mode>
+int blendRow(uint32 *dst, const uint32 *src, int width, uint32 alpha, bool skipTrans) {
+	const __m128i rgbMask = _mm_set1_epi32(0xFFFFFF);
+	const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+	const __m128i transColor = _mm_set1_epi32(0xFF00FF);
+	const __m128i constFactor = blendFactor(_mm_set1_epi32(alpha));
+	const __m128i alphaScale = _mm_set1_epi32((alpha & 0xff) + 1);
+
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+		__m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+		__m128i out;
+
+		switch (Mode) {
+		case kSourceAlphaBlender:
+			out = rgbBlend(s, d, blendFactor(_mm_srli_epi32(s, 24)));
+			break;
+		case kArgbToRgbBlender: {
+			__m128i t = _mm_srli_epi32(s, 24);
+			if (alpha != 0)
+				t = _mm_srli_epi32(_mm_mullo_epi16(t, alphaScale), 8);
+			out = rgbBlend(s, d, blendFactor(t));
+			break;
+		}
+		case kRgbToRgbBlender:
+			out = rgbBlend(s, d, constFactor);
+			break;
+		case kAlphaPreservedBlenderMode:
+			out = _mm_or_si128(rgbBlend(s, d, constFactor), _mm_and_si128(d, alphaMask));
+			break;
+		case kOpaqueBlenderMode:
+			out = _mm_or_si128(s, alphaMask);
+			break;
+		case kAdditiveBlenderMode:
+			out = _mm_or_si128(_mm_and_si128(s, rgbMask), _mm_and_si128(_mm_adds_epu8(s, d), alphaMask));
+			break;
+		default:
+			// Plain copy
+			out = s;
+			break;
+		}
+
+		if (skipTrans) {
+			__m128i trans = _mm_cmpeq_epi32(_mm_and_si128(s, rgbMask), transColor);
+			out = _mm_or_si128(_mm_and_si128(trans, d), _mm_andnot_si128(trans, out));
+		}
+
+		_mm_storeu_si128((__m128i *)(dst + x), out);
+	}
+
+	return x;
+}
+
+} // End of anonymous namespace
+
+int blendRowSSE2(uint32 *dst, const uint32 *src, int width, BlenderMode mode, int srcAlpha, bool skipTrans) {
+	if (srcAlpha == -1)
+		return blendRow<-1>(dst, src, width, 0, skipTrans);
+
+	switch (mode) {
+	case kSourceAlphaBlender:
+		return blendRow<kSourceAlphaBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kArgbToRgbBlender:
+		return blendRow<kArgbToRgbBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kRgbToRgbBlender:
+		return blendRow<kRgbToRgbBlender>(dst, src, width, srcAlpha, skipTrans);
+	case kAlphaPreservedBlenderMode:
+		return blendRow<kAlphaPreservedBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	case kOpaqueBlenderMode:
+		return blendRow<kOpaqueBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	case kAdditiveBlenderMode:
+		return blendRow<kAdditiveBlenderMode>(dst, src, width, srcAlpha, skipTrans);
+	default:
+		return 0;
+	}
+}
+
+} // namespace AGS3
@@ -375,6 +375,17 @@ MODULE_OBJS += \
 	tests/test_version.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	lib/allegro/surface_sse2.o
+$(MODULE)/lib/allegro/surface_sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	lib/allegro/surface_neon.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_AGS), DYNAMIC_PLUGIN)
 PLUGIN := 1
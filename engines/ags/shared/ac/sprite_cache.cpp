@@ -62,13 +62,18 @@ namespace Shared {
 
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos)
 	: _sprInfos(sprInfos), _maxCacheSize(DEFAULTCACHESIZE_KB * 1024u),
-	_cacheSize(0u), _lockedSize(0u) {
+	_cacheSize(0u), _lockedSize(0u), _preloadGroup(g_system->getThreadPool()),
+	_preloadsPending(0u), _preloadSize(0u) {
 }
 
 SpriteCache::~SpriteCache() {
 	Reset();
 }
 
+void SpriteCache::ResetStats() {
+	_stats = Stats();
+}
+
 size_t SpriteCache::GetCacheSize() const {
 	return _cacheSize;
 }
@@ -91,6 +96,7 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 }
 
 void SpriteCache::Reset() {
+	DiscardPreloads();
 	_file.Close();
 	// TODO: find out if it's safe to simply always delete _spriteData.Image with array element
 	for (size_t i = 0; i < _spriteData.size(); ++i) {
@@ -210,12 +216,22 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 	if (_spriteData[index].IsExternalSprite() || _spriteData[index].IsLocked())
 		return _spriteData[index].Image;
 
+	if (!_preloads.empty())
+		UpdatePreloads();
+
 	if (_spriteData[index].Image) {
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
+		_stats.Hits++;
 	} else {
-		// Sprite exists in file but is not in mem, load it
-		LoadSprite(index);
+		// Sprite exists in file but is not in mem, take it from the
+		// preloads or load it
+		if (_spriteData[index].Preload && TakePreload(index)) {
+			_stats.PreloadHits++;
+		} else {
+			LoadSprite(index);
+			_stats.Misses++;
+		}
 		_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
 	}
 	return _spriteData[index].Image;
@@ -253,6 +269,7 @@ void SpriteCache::DisposeOldest() {
 		_cacheSize -= _spriteData[sprnum].Size;
 		delete _spriteData[*it].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_stats.Evictions++;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
@@ -320,7 +337,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 		RemapSpriteToSprite0(index);
 		return 0;
 	}
+	return InitLoadedSprite(index, image);
+}
 
+size_t SpriteCache::InitLoadedSprite(sprkey_t index, Bitmap *image) {
 	// update the stored width/height
 	_sprInfos[index].Width = image->GetWidth();
 	_sprInfos[index].Height = image->GetHeight();
@@ -401,9 +421,158 @@ HError SpriteCache::InitFile(const String &filename, const String &sprindex_file
 }
 
 void SpriteCache::DetachFile() {
+	DiscardPreloads();
 	_file.Close();
 }
 
+void SpriteCache::PreloadJob::run() {
+	{
+		Common::StackLock lock(Owner->_preloadMutex);
+		// The engine may have taken the job over already
+		if (JobState != kQueued)
+			return;
+		JobState = kRunning;
+	}
+	Decode();
+}
+
+void SpriteCache::PreloadJob::Decode() {
+	Shared::Bitmap *image = nullptr;
+	Owner->_file.DecodeSprite(Index, Header, Data, image);
+	Data.clear();
+
+	Common::StackLock lock(Owner->_preloadMutex);
+	Image = image;
+	JobState = kDone;
+	Owner->_preloadsPending--;
+}
+
+void SpriteCache::Preload(sprkey_t index) {
+	if (index <= 0 || (size_t)index >= _spriteData.size())
+		return;
+	SpriteData &spr = _spriteData[index];
+	if (!spr.IsAssetSprite() || spr.Image || spr.Preload || (spr.Flags & SPRCACHEFLAG_REMAPPED))
+		return; // already available, or nothing to decode
+	// Without worker threads the sprite would be decoded right here, which
+	// is no better than decoding it when it is first drawn
+	if (g_system->getThreadPool().getWorkerCount() == 0)
+		return;
+
+	// Preloads never evict anything, they only use the free cache space;
+	// the final color depth is not known yet, so assume the largest one
+	const size_t size = _sprInfos[index].Width * _sprInfos[index].Height * 4;
+	if (_cacheSize + _preloadSize + size > _maxCacheSize)
+		return;
+
+	PreloadJob *job = new PreloadJob();
+	job->Owner = this;
+	job->Index = index;
+	job->Size = size;
+	// Reading is done here, as the sprite stream is not thread-safe
+	HError err = _file.LoadRawData(index, job->Header, job->Data);
+	if (!err || job->Data.empty()) {
+		delete job;
+		return;
+	}
+
+	{
+		Common::StackLock lock(_preloadMutex);
+		_preloadsPending++;
+	}
+	_preloadSize += size;
+	spr.Preload = job;
+	_preloads.push_back(job);
+	_stats.Preloads++;
+	SprCacheLog("Preload: queued %d", index);
+	_preloadGroup.run(job);
+}
+
+bool SpriteCache::InstallPreload(PreloadJob *job) {
+	_preloadSize -= job->Size;
+	Bitmap *image = job->Image;
+	job->Image = nullptr;
+	job->Size = 0;
+
+	// The slot may have been reassigned while the sprite was being decoded
+	if ((size_t)job->Index >= _spriteData.size() || _spriteData[job->Index].Preload != job) {
+		delete image;
+		return false;
+	}
+	SpriteData &spr = _spriteData[job->Index];
+	spr.Preload = nullptr;
+	if (!image || spr.Image || !spr.IsAssetSprite() || (spr.Flags & SPRCACHEFLAG_REMAPPED)) {
+		delete image;
+		return false;
+	}
+	InitLoadedSprite(job->Index, image);
+	return true;
+}
+
+bool SpriteCache::TakePreload(sprkey_t index) {
+	PreloadJob *job = _spriteData[index].Preload;
+	PreloadJob::State state;
+	{
+		Common::StackLock lock(_preloadMutex);
+		state = job->JobState;
+		if (state == PreloadJob::kQueued)
+			job->JobState = PreloadJob::kRunning;
+	}
+
+	if (state == PreloadJob::kQueued) {
+		// No worker got to it yet, decode it on this thread
+		job->Decode();
+	} else if (state == PreloadJob::kRunning) {
+		// The calling thread helps with the remaining preloads while waiting
+		_stats.PreloadWaits++;
+		_preloadGroup.wait();
+	}
+	return InstallPreload(job);
+}
+
+void SpriteCache::UpdatePreloads() {
+	{
+		Common::StackLock lock(_preloadMutex);
+		if (_preloadsPending > 0)
+			return;
+	}
+	FinishPreloads();
+}
+
+void SpriteCache::FinishPreloads() {
+	_preloadGroup.wait();
+	// Installing a sprite may query the cache, so detach the list first
+	std::vector<PreloadJob *> jobs;
+	jobs.swap(_preloads);
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		const sprkey_t index = jobs[i]->Index;
+		if (jobs[i]->Size > 0 && InstallPreload(jobs[i]))
+			_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
+		delete jobs[i];
+	}
+}
+
+void SpriteCache::DiscardPreloads() {
+	{
+		Common::StackLock lock(_preloadMutex);
+		for (size_t i = 0; i < _preloads.size(); ++i) {
+			if (_preloads[i]->JobState == PreloadJob::kQueued) {
+				_preloads[i]->JobState = PreloadJob::kDone;
+				_preloadsPending--;
+			}
+		}
+	}
+	_preloadGroup.wait();
+	for (size_t i = 0; i < _preloads.size(); ++i) {
+		PreloadJob *job = _preloads[i];
+		if ((size_t)job->Index < _spriteData.size() && _spriteData[job->Index].Preload == job)
+			_spriteData[job->Index].Preload = nullptr;
+		delete job->Image;
+		delete job;
+	}
+	_preloads.clear();
+	_preloadSize = 0;
+}
+
 } // namespace Shared
 } // namespace AGS
 } // namespace AGS3
@@ -24,7 +24,9 @@
 //
 // SpriteFile handles sprite serialization and streaming.
 // SpriteCache provides bitmaps by demand; it uses SpriteFile to load sprites
-// and does MRU (most-recent-use) caching.
+// and does MRU (most-recent-use) caching. Sprites that are going to be needed
+// soon may be queued for preloading, in which case their raw data is read
+// right away and decompressed on the worker threads of the thread pool.
 //
 // TODO: store sprite data in a specialized container type that is optimized
 // for having most keys allocated in large continious sequences by default.
@@ -41,6 +43,8 @@
 #ifndef AGS_SHARED_AC_SPRITE_CACHE_H
 #define AGS_SHARED_AC_SPRITE_CACHE_H
 
+#include "common/mutex.h"
+#include "common/threadpool.h"
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/lib/std/list.h"
@@ -89,6 +93,16 @@ public:
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
 
+	// Counters reported by GetStats
+	struct Stats {
+		uint32_t Hits = 0;        // requested sprites found in memory
+		uint32_t Misses = 0;      // requested sprites loaded synchronously
+		uint32_t Evictions = 0;   // sprites disposed to make room
+		uint32_t Preloads = 0;    // sprites queued for preloading
+		uint32_t PreloadHits = 0; // preloaded sprites requested before anything else
+		uint32_t PreloadWaits = 0; // requests which had to wait for a worker
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
 
@@ -124,6 +138,15 @@ public:
 	size_t      GetSpriteSlotCount() const;
 	// Loads sprite and and locks in memory (so it cannot get removed implicitly)
 	void        Precache(sprkey_t index);
+	// Queues a sprite for decompression in the background, if it is not in
+	// memory yet and fits into the free cache space; it is added to the
+	// cache as a regular (not locked) sprite
+	void        Preload(sprkey_t index);
+	// Returns the cache usage counters
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	void        ResetStats();
 	// Remap the given index to the sprite 0
 	void        RemapSpriteToSprite0(sprkey_t index);
 	// Unregisters sprite from the bank and optionally deletes bitmap
@@ -157,6 +180,20 @@ private:
 	void        DisposeOldest();
 	// Keep disposing oldest elements until cache has at least the given free space
 	void        FreeMem(size_t space);
+	// Registers a bitmap loaded for the given sprite and updates cache size
+	size_t      InitLoadedSprite(sprkey_t index, Bitmap *image);
+
+	class PreloadJob;
+	// Moves a finished preload into the cache; returns if it was used
+	bool        InstallPreload(PreloadJob *job);
+	// Makes sure the sprite's queued preload is finished and installs it
+	bool        TakePreload(sprkey_t index);
+	// Installs all preloads if there are no more of them running
+	void        UpdatePreloads();
+	// Waits for all queued preloads and adds them to the cache
+	void        FinishPreloads();
+	// Cancels all queued preloads and frees the decoded ones
+	void        DiscardPreloads();
 
 	// Information required for the sprite streaming
 	struct SpriteData {
@@ -167,6 +204,8 @@ private:
 		Shared::Bitmap *Image = nullptr; // actual bitmap
 		// MRU list reference
 		std::list<sprkey_t>::iterator MruIt;
+		// Preload queued for this sprite, if any
+		PreloadJob *Preload = nullptr;
 
 		// Tells if there actually is a registered sprite in this slot
 		bool DoesSpriteExist() const;
@@ -194,6 +233,37 @@ private:
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
 
+	// Sprite decoded on a worker thread
+	class PreloadJob : public Common::Job {
+	public:
+		enum State {
+			kQueued,  // waiting for a thread
+			kRunning, // being decoded
+			kDone     // Image is ready, or nullptr if decoding failed
+		};
+
+		SpriteCache *Owner = nullptr;
+		sprkey_t Index = 0;
+		State JobState = kQueued;
+		size_t Size = 0; // expected size of the bitmap, in bytes
+		SpriteDatHeader Header;
+		std::vector<uint8_t> Data;
+		Shared::Bitmap *Image = nullptr;
+
+		void run() override;
+		void Decode();
+	};
+
+	// Preloads which have not been waited for yet
+	std::vector<PreloadJob *> _preloads;
+	Common::TaskGroup _preloadGroup;
+	// Guards JobState and _preloadsPending
+	Common::Mutex _preloadMutex;
+	size_t _preloadsPending; // preloads not decoded yet
+	size_t _preloadSize;     // expected size of the queued preloads, in bytes
+
+	Stats _stats;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
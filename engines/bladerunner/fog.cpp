@@ -42,6 +42,8 @@ Fog::Fog() {
 	_m32ptr             = nullptr;
 	_m33ptr             = nullptr;
 	_m34ptr             = nullptr;
+	_setupOffset        = -1;
+	_viewPositionValid  = false;
 	_next               = nullptr;
 }
 
@@ -89,6 +91,7 @@ void Fog::readAnimationData(Common::ReadStream *stream, int size) {
 	_m33ptr = _m32ptr + ((_animatedParameters & 0x200) ? _frameCount : 1);
 	_m34ptr = _m33ptr + ((_animatedParameters & 0x400) ? _frameCount : 1);
 
+	_setupOffset = -1;
 	setupFrame(0);
 }
 
@@ -96,7 +99,15 @@ void Fog::reset() {
 }
 
 void Fog::setupFrame(int frame) {
-	int offset = frame % _frameCount;
+	// Static fogs, and animated ones within the same frame, keep their
+	// matrices, so there is no need to invert them again for every actor
+	int offset = (_animatedParameters & 0xFFF) ? frame % _frameCount : 0;
+	if (offset == _setupOffset) {
+		return;
+	}
+	_setupOffset = offset;
+	_viewPositionValid = false;
+
 	_matrix._m[0][0] = ((_animatedParameters &   0x1) ? _m11ptr[offset] : *_m11ptr);
 	_matrix._m[0][1] = ((_animatedParameters &   0x2) ? _m12ptr[offset] : *_m12ptr);
 	_matrix._m[0][2] = ((_animatedParameters &   0x4) ? _m13ptr[offset] : *_m13ptr);
@@ -112,6 +123,19 @@ void Fog::setupFrame(int frame) {
 	_inverted = invertMatrix(_matrix);
 }
 
+Vector3 Fog::transformViewPosition(Vector3 viewPosition) {
+	if (!_viewPositionValid
+	 || viewPosition.x != _viewPosition.x
+	 || viewPosition.y != _viewPosition.y
+	 || viewPosition.z != _viewPosition.z
+	) {
+		_viewPosition = viewPosition;
+		_viewPositionT = _matrix * viewPosition;
+		_viewPositionValid = true;
+	}
+	return _viewPositionT;
+}
+
 void FogSphere::read(Common::ReadStream *stream, int frameCount) {
 	_frameCount = frameCount;
 	int size = readCommon(stream);
@@ -132,7 +156,7 @@ void FogSphere::calculateCoeficient(Vector3 position, Vector3 viewPosition, floa
 	// Explained in book Andrew S. Glassner (1995), Graphics Gems I (p. 388-389)
 
 	Vector3 rayOrigin = _matrix * position;
-	Vector3 rayDestination = _matrix * viewPosition;
+	Vector3 rayDestination = transformViewPosition(viewPosition);
 	Vector3 rayDirection = (rayDestination - rayOrigin).normalize();
 
 	float b = Vector3::dot(rayDirection, rayOrigin);
@@ -184,7 +208,7 @@ void FogCone::calculateCoeficient(Vector3 position, Vector3 viewPosition, float
 	// The algorithm looks like from book Alan W. Paeth (1995), Graphics Gems V (p. 228-230)
 
 	Vector3 positionT = _matrix * position;
-	Vector3 viewPositionT = _matrix * viewPosition;
+	Vector3 viewPositionT = transformViewPosition(viewPosition);
 
 	Vector3 v(0.0f, 0.0f, -1.0f);
 
@@ -260,7 +284,7 @@ void FogBox::calculateCoeficient(Vector3 position, Vector3 viewPosition, float *
 	// line - box intersection, where everything is rotated to box orientation by the fog matrix
 
 	Vector3 point1 = _matrix * position;
-	Vector3 point2 = _matrix * viewPosition;
+	Vector3 point2 = transformViewPosition(viewPosition);
 
 	Vector3 intersection1 = point1;
 	Vector3 intersection2 = point2;
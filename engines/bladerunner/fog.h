@@ -60,6 +60,15 @@ protected:
 	float     *_m33ptr;
 	float     *_m34ptr;
 
+	// Animation frame the matrices were last set up for
+	int        _setupOffset;
+
+	// The view position is the same for every call within a frame, so keep
+	// the last one transformed into the fog's space
+	bool       _viewPositionValid;
+	Vector3    _viewPosition;
+	Vector3    _viewPositionT;
+
 	Fog       *_next;
 
 public:
@@ -76,6 +85,8 @@ protected:
 	int readCommon(Common::ReadStream *stream);
 	void readAnimationData(Common::ReadStream *stream, int count);
 
+	Vector3 transformViewPosition(Vector3 viewPosition);
+
 };
 
 class FogSphere : public Fog {
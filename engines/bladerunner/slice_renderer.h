@@ -27,6 +27,7 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -43,6 +44,22 @@ class Lights;
 class SetEffects;
 
 class SliceRenderer {
+	/**
+	 * The parameters of one screen line of a slice model, worked out in order
+	 * on the engine thread so that the lines themselves can be drawn in any
+	 * order.
+	 */
+	struct SliceLine {
+		int   slice;
+		int   y;
+		int   m13;
+		int   m23;
+		Color lightsColor;
+		Color setEffectColor;
+	};
+
+	static const uint kMinParallelLines = 32;
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -75,19 +92,16 @@ class SliceRenderer {
 
 	int _m11lookup[256];
 	int _m12lookup[256];
-	int _m13;
 	int _m21lookup[256];
 	int _m22lookup[256];
-	int _m23;
+
+	Common::Array<SliceLine> _sliceLines;
 
 	bool _animationsShadowEnabled[997];
 
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
-
 	Graphics::PixelFormat _pixelFormat;
 
 public:
@@ -113,7 +127,8 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawSliceLines(Graphics::Surface &surface, uint16 *zbuffer);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine);
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
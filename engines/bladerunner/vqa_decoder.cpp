@@ -150,6 +150,8 @@ VQADecoder::VQADecoder() {
 VQADecoder::~VQADecoder() {
 	for (uint i = _codebooks.size(); i != 0; --i) {
 		delete[] _codebooks[i - 1].data;
+		delete[] _codebooks[i - 1].pixels;
+		delete[] _codebooks[i - 1].alpha;
 	}
 	delete _audioTrack;
 	delete _videoTrack;
@@ -687,6 +689,8 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_maxZBUFChunkSize = vqaDecoder->_maxZBUFChunkSize;
 
 	_codebook = nullptr;
+	_codebookPixels = nullptr;
+	_codebookAlpha = nullptr;
 	_cbfz     = nullptr;
 
 	_vpointerSize = 0;
@@ -1062,16 +1066,40 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
+void VQADecoder::VQAVideoTrack::convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format) {
+	const uint32 count = _maxBlocks * _blockW * _blockH;
+
+	if (!codebookInfo.pixels) {
+		// This is released in VQADecoder::~VQADecoder()
+		codebookInfo.pixels = new uint32[count];
+		codebookInfo.alpha = new uint8[count];
+	}
+
+	const uint8 *src_p = codebookInfo.data;
+	uint8 a, r, g, b;
+
+	for (uint32 i = 0; i < count; ++i) {
+		getGameDataColor(READ_LE_UINT16(src_p), a, r, g, b);
+		src_p += 2;
+
+		// Ignore the alpha in the output as it is inversed in the input
+		codebookInfo.pixels[i] = format.RGBToColor(r, g, b);
+		codebookInfo.alpha[i] = a;
+	}
+
+	codebookInfo.pixelsFormat = format;
+}
+
 void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
-	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+	const uint32 *const block_src = &_codebookPixels[srcBlock * _blockW * _blockH];
+	const uint8 *const block_alpha = &_codebookAlpha[srcBlock * _blockW * _blockH];
+	const uint8 bytesPerPixel = surface->format.bytesPerPixel;
 
 	uint16 blocks_per_line = _width / _blockW;
 
 	uint32 intermDiv = 0;
 	uint32 dst_x = 0;
 	uint32 dst_y = 0;
-	uint16 vqaColor = 0;
-	uint8 a, r, g, b;
 
 	for (uint i = count; i != 0; --i) {
 		// aux variable to avoid duplicate division and a modulo operation
@@ -1079,22 +1107,19 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 		dst_x = ((dstBlock + count - i) - intermDiv * blocks_per_line) * _blockW + _offsetX;
 		dst_y = intermDiv * _blockH + _offsetY;
 
-		const uint8 *src_p = block_src;
+		const uint32 *src_p = block_src;
+		const uint8 *alpha_p = block_alpha;
 
-		for (uint y = _blockH; y != 0; --y) {
+		for (uint y = 0; y < _blockH; ++y) {
+			// CLIP() is too slow and it is not needed.
+			uint8 *dstPtr = (uint8 *)surface->getBasePtr(dst_x, dst_y + y);
 			for (uint x = _blockW; x != 0; --x) {
-				vqaColor = READ_LE_UINT16(src_p);
-				src_p += 2;
-
-				getGameDataColor(vqaColor, a, r, g, b);
-
-				if (!(alpha && a)) {
-					// CLIP() is too slow and it is not needed.
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + _blockW - x, dst_y + _blockH - y);
-					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+				if (!(alpha && *alpha_p)) {
+					drawPixel(*surface, dstPtr, *src_p);
 				}
+				++src_p;
+				++alpha_p;
+				dstPtr += bytesPerPixel;
 			}
 		}
 	}
@@ -1111,6 +1136,14 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	if (!_vqaDecoder->_oldV2VQA) {
+		if (!codebookInfo.pixels || codebookInfo.pixelsFormat != surface->format) {
+			convertCodebook(codebookInfo, surface->format);
+		}
+		_codebookPixels = codebookInfo.pixels;
+		_codebookAlpha = codebookInfo.alpha;
+	}
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
@@ -141,6 +141,14 @@ public:
 		uint16  frame;
 		uint32  size;
 		uint8  *data;
+
+		// The codebook converted to the format of the surface it is drawn on,
+		// so that blocks don't have to be converted pixel by pixel each frame
+		uint32                *pixels;
+		uint8                 *alpha;
+		Graphics::PixelFormat  pixelsFormat;
+
+		CodebookInfo() : frame(0), size(0), data(nullptr), pixels(nullptr), alpha(nullptr) {}
 	};
 
 	class VQAVideoTrack;
@@ -239,6 +247,8 @@ public:
 		uint32  _maxZBUFChunkSize;
 
 		uint8   *_codebook;
+		uint32  *_codebookPixels;
+		uint8   *_codebookAlpha;
 		uint8   *_cbfz;
 		uint32   _zbufChunkSize;
 		uint8   *_zbufChunk;
@@ -267,6 +277,7 @@ public:
 
 		CodebookInfo  *_codebookInfoNext; // Used to store the decompressed codebook data and swap with the active codebook
 
+		void convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format);
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
 	};
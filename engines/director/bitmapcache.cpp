@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "director/director.h"
+#include "director/bitmapcache.h"
+
+namespace Director {
+
+BitmapCache::BitmapCache(const char *name, uint32 maxBytes)
+	: _name(name), _maxBytes(maxBytes), _usedBytes(0), _useCounter(0),
+	  _hits(0), _misses(0), _evictions(0), _evictedBytes(0) {
+}
+
+BitmapCache::SurfacePtr BitmapCache::get(const BitmapCacheKey &key) {
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		_misses++;
+		return SurfacePtr();
+	}
+
+	_hits++;
+	it->_value.lastUse = ++_useCounter;
+	return it->_value.surface;
+}
+
+void BitmapCache::add(const BitmapCacheKey &key, const SurfacePtr &surface) {
+	if (!surface)
+		return;
+
+	uint32 size = surface->pitch * surface->h;
+	if (size > _maxBytes / 4)
+		return;
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		_usedBytes -= it->_value.size;
+		_entries.erase(it);
+	}
+
+	evict(size);
+
+	Entry &entry = _entries[key];
+	entry.surface = surface;
+	entry.size = size;
+	entry.lastUse = ++_useCounter;
+	_usedBytes += size;
+
+	debugC(7, kDebugImages, "BitmapCache(%s): Added %dx%d surface, %d of %d bytes used", _name, surface->w, surface->h, _usedBytes, _maxBytes);
+}
+
+void BitmapCache::evict(uint32 needed) {
+	while (!_entries.empty() && _usedBytes + needed > _maxBytes) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		_usedBytes -= oldest->_value.size;
+		_evictedBytes += oldest->_value.size;
+		_evictions++;
+		_entries.erase(oldest);
+	}
+}
+
+void BitmapCache::purge(const CastMember *member) {
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_key.member == member) {
+			_usedBytes -= it->_value.size;
+			_entries.erase(it);
+		}
+	}
+}
+
+void BitmapCache::clear() {
+	_entries.clear();
+	_usedBytes = 0;
+}
+
+Common::String BitmapCache::formatStats() const {
+	return Common::String::format("%s: %d entries, %d of %d bytes used, %d hits, %d misses, %d evictions (%d bytes)",
+		_name, _entries.size(), _usedBytes, _maxBytes, _hits, _misses, _evictions, _evictedBytes);
+}
+
+} // End of namespace Director
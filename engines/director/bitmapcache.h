@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DIRECTOR_BITMAPCACHE_H
+#define DIRECTOR_BITMAPCACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
+#include "common/ptr.h"
+#include "graphics/surface.h"
+
+#include "director/types.h"
+
+namespace Director {
+
+class CastMember;
+
+struct BitmapCacheKey {
+	const CastMember *member;
+	CastMemberID palette;	// Palette the bitmap was converted to, null if none
+	uint16 width;			// Size the bitmap was scaled to, 0 if unscaled
+	uint16 height;
+	byte bpp;
+
+	BitmapCacheKey(const CastMember *m, const CastMemberID &pal, byte b, uint16 w = 0, uint16 h = 0)
+		: member(m), palette(pal), width(w), height(h), bpp(b) {}
+
+	bool operator==(const BitmapCacheKey &k) const {
+		return member == k.member && palette == k.palette && width == k.width && height == k.height && bpp == k.bpp;
+	}
+};
+
+struct BitmapCacheKeyHash {
+	uint operator()(const BitmapCacheKey &k) const {
+		return Common::Hash<const CastMember *>()(k.member) ^ (k.palette.hash() * 31) ^ (k.width << 16) ^ k.height ^ (k.bpp << 8);
+	}
+};
+
+/**
+ * Least recently used cache of surfaces derived from bitmap cast members,
+ * e.g. their palette conversions or scaled copies. Surfaces are shared, so
+ * evicting an entry never invalidates a surface still held by a cast member.
+ */
+class BitmapCache {
+public:
+	typedef Common::SharedPtr<Graphics::Surface> SurfacePtr;
+
+	BitmapCache(const char *name, uint32 maxBytes);
+
+	SurfacePtr get(const BitmapCacheKey &key);
+	void add(const BitmapCacheKey &key, const SurfacePtr &surface);
+
+	/** Drop all entries derived from @p member, e.g. when its picture changed. */
+	void purge(const CastMember *member);
+	void clear();
+
+	Common::String formatStats() const;
+
+private:
+	struct Entry {
+		SurfacePtr surface;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	void evict(uint32 needed);
+
+	typedef Common::HashMap<BitmapCacheKey, Entry, BitmapCacheKeyHash> EntryMap;
+	EntryMap _entries;
+
+	const char *_name;
+	uint32 _maxBytes;
+	uint32 _usedBytes;
+	uint32 _useCounter;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+	uint32 _evictedBytes;
+};
+
+} // End of namespace Director
+
+#endif
@@ -28,6 +28,7 @@
 #include "image/pict.h"
 
 #include "director/director.h"
+#include "director/bitmapcache.h"
 #include "director/cast.h"
 #include "director/images.h"
 #include "director/movie.h"
@@ -44,7 +45,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 		: CastMember(cast, castId, stream) {
 	_type = kCastBitmap;
 	_picture = nullptr;
-	_ditheredImg = nullptr;
 	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
@@ -165,7 +165,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecode
 	if (img != nullptr) {
 		_picture = new Picture(*img);
 	}
-	_ditheredImg = nullptr;
 	_clut = CastMemberID(0, 0);
 	_ditheredTargetClut = CastMemberID(0, 0);
 	_initialRect = Common::Rect(0, 0, img->getSurface()->w, img->getSurface()->h);
@@ -182,10 +181,7 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecode
 BitmapCastMember::~BitmapCastMember() {
 	delete _picture;
 
-	if (_ditheredImg) {
-		_ditheredImg->free();
-		delete _ditheredImg;
-	}
+	purgeCachedImages();
 
 	if (_matte)
 		delete _matte;
@@ -207,12 +203,12 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 
 	const byte *pal = _picture->_palette;
 	bool previouslyDithered = _ditheredImg != nullptr;
-	if (_ditheredImg) {
-		_ditheredImg->free();
-		delete _ditheredImg;
-		_ditheredImg = nullptr;
-		_ditheredTargetClut = CastMemberID(0, 0);
-	}
+	_ditheredImg.reset();
+	_ditheredTargetClut = CastMemberID(0, 0);
+
+	// Conversions to the live window manager palette can't be cached, as it
+	// changes during palette fades without the score palette changing
+	bool cacheable = true;
 
 	if (dstBpp == 1) {
 		if (srcBpp > 1
@@ -224,9 +220,10 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 #endif
 			) {
 
-			_ditheredImg = _picture->_surface.convertTo(g_director->_wm->_pixelformat, _picture->_palette, _picture->_paletteColors, g_director->_wm->getPalette(), g_director->_wm->getPaletteSize());
+			_ditheredImg = Common::SharedPtr<Graphics::Surface>(_picture->_surface.convertTo(g_director->_wm->_pixelformat, _picture->_palette, _picture->_paletteColors, g_director->_wm->getPalette(), g_director->_wm->getPaletteSize()), Graphics::SurfaceDeleter());
 
 			pal = g_director->_wm->getPalette();
+			cacheable = false;
 		} else {
 			// Convert indexed image to indexed palette
 			Movie *movie = g_director->getCurrentMovie();
@@ -259,7 +256,7 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 			case 2:
 				{
 					const PaletteV4 &srcPal = g_director->getLoaded4Palette();
-					_ditheredImg = _picture->_surface.convertTo(g_director->_wm->_pixelformat, srcPal.palette, srcPal.length, currentPalette->palette, currentPalette->length, Graphics::kDitherNaive);
+					_ditheredImg = ditherImage(currentPaletteId, srcPal.palette, srcPal.length, currentPalette->palette, currentPalette->length);
 				}
 				break;
 			// 4bpp - if using a builtin palette, use one of the corresponding 4-bit ones.
@@ -270,7 +267,7 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 					// I guess default to the mac palette?
 					CastMemberID palIndex = pals.contains(castPaletteId) ? castPaletteId : CastMemberID(kClutSystemMac, -1);
 					const PaletteV4 &srcPal = pals.getVal(palIndex);
-					_ditheredImg = _picture->_surface.convertTo(g_director->_wm->_pixelformat, srcPal.palette, srcPal.length, currentPalette->palette, currentPalette->length, Graphics::kDitherNaive);
+					_ditheredImg = ditherImage(currentPaletteId, srcPal.palette, srcPal.length, currentPalette->palette, currentPalette->length);
 				}
 				break;
 			// 8bpp - if using a different palette, and we're not doing a color cycling operation, convert using nearest colour matching
@@ -288,7 +285,7 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 					// but in the wrong palette order.
 					const byte *palPtr = _external ? pal : srcPal.palette;
 					int palLength = _external ? _picture->getPaletteSize() : srcPal.length;
-					_ditheredImg = _picture->_surface.convertTo(g_director->_wm->_pixelformat, palPtr, palLength, currentPalette->palette, currentPalette->length, Graphics::kDitherNaive);
+					_ditheredImg = ditherImage(currentPaletteId, palPtr, palLength, currentPalette->palette, currentPalette->length);
 				}
 				break;
 			default:
@@ -299,20 +296,6 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 				debugC(4, kDebugImages, "BitmapCastMember::createWidget(): Dithering image from source palette %s to target palette %s", _clut.asString().c_str(), score->getCurrentPalette().asString().c_str());
 				// Save the palette ID so we can check if a redraw is required
 				_ditheredTargetClut = currentPaletteId;
-
-				if (!_external) {
-					// Finally, the first and last colours in the palette are special. No matter what the palette remap
-					// does, we need to scrub those to be the same.
-					const Graphics::Surface *src = &_picture->_surface;
-					for (int y = 0; y < src->h; y++) {
-						for (int x = 0; x < src->w; x++) {
-							const int test = *(const byte *)src->getBasePtr(x, y);
-							if (test == 0 || test == (1 << _bitsPerPixel) - 1) {
-								*(byte *)_ditheredImg->getBasePtr(x, y) = test == 0 ? 0x00 : 0xff;
-							}
-						}
-					}
-				}
 			} else if (previouslyDithered) {
 				debugC(4, kDebugImages, "BitmapCastMember::createWidget(): Removed dithered image, score palette %s matches cast member", score->getCurrentPalette().asString().c_str());
 			}
@@ -321,18 +304,68 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 	}
 
 	Graphics::MacWidget *widget = new Graphics::MacWidget(g_director->getCurrentWindow(), bbox.left, bbox.top, bbox.width(), bbox.height(), g_director->_wm, false);
+	Graphics::Surface *dst = widget->getSurface()->surfacePtr();
 
 	// scale for drawing a different size sprite
-	copyStretchImg(widget->getSurface()->surfacePtr(), bbox, pal);
+	if (cacheable && (bbox.width() != _initialRect.width() || bbox.height() != _initialRect.height())) {
+		BitmapCacheKey key(this, _ditheredTargetClut, dstBpp, bbox.width(), bbox.height());
+		BitmapCache::SurfacePtr scaled = g_director->_scaledBitmapCache->get(key);
+
+		if (!scaled) {
+			scaled = BitmapCache::SurfacePtr(new Graphics::Surface(), Graphics::SurfaceDeleter());
+			scaled->create(bbox.width(), bbox.height(), dst->format);
+			copyStretchImg(scaled.get(), bbox, pal);
+			g_director->_scaledBitmapCache->add(key, scaled);
+		}
+
+		dst->copyFrom(*scaled);
+	} else {
+		copyStretchImg(dst, bbox, pal);
+	}
 
 	return widget;
 }
 
+Common::SharedPtr<Graphics::Surface> BitmapCastMember::ditherImage(const CastMemberID &targetPaletteId, const byte *srcPal, int srcPalLength, const byte *dstPal, int dstPalLength) {
+	BitmapCacheKey key(this, targetPaletteId, g_director->_wm->_pixelformat.bytesPerPixel);
+	BitmapCache::SurfacePtr dithered = g_director->_bitmapCache->get(key);
+	if (dithered)
+		return dithered;
+
+	dithered = BitmapCache::SurfacePtr(_picture->_surface.convertTo(g_director->_wm->_pixelformat, srcPal, srcPalLength, dstPal, dstPalLength, Graphics::kDitherNaive), Graphics::SurfaceDeleter());
+
+	if (!_external) {
+		// Finally, the first and last colours in the palette are special. No matter what the palette remap
+		// does, we need to scrub those to be the same.
+		const Graphics::Surface *src = &_picture->_surface;
+		for (int y = 0; y < src->h; y++) {
+			for (int x = 0; x < src->w; x++) {
+				const int test = *(const byte *)src->getBasePtr(x, y);
+				if (test == 0 || test == (1 << _bitsPerPixel) - 1) {
+					*(byte *)dithered->getBasePtr(x, y) = test == 0 ? 0x00 : 0xff;
+				}
+			}
+		}
+	}
+
+	g_director->_bitmapCache->add(key, dithered);
+	return dithered;
+}
+
+void BitmapCastMember::purgeCachedImages() {
+	_ditheredImg.reset();
+
+	if (g_director->_bitmapCache)
+		g_director->_bitmapCache->purge(this);
+	if (g_director->_scaledBitmapCache)
+		g_director->_scaledBitmapCache->purge(this);
+}
+
 void BitmapCastMember::copyStretchImg(Graphics::Surface *surface, const Common::Rect &bbox, const byte *pal) {
 	const Graphics::Surface *srcSurf;
 
 	if (_ditheredImg)
-		srcSurf = _ditheredImg;
+		srcSurf = _ditheredImg.get();
 	else
 		srcSurf = &_picture->_surface;
 
@@ -634,8 +667,7 @@ void BitmapCastMember::unload() {
 	delete _picture;
 	_picture = nullptr;
 
-	delete _ditheredImg;
-	_ditheredImg = nullptr;
+	purgeCachedImages();
 
 	_loaded = false;
 }
@@ -656,8 +688,7 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 	_picture = new Picture(*picture._picture);
 
 	// Force redither
-	delete _ditheredImg;
-	_ditheredImg = nullptr;
+	purgeCachedImages();
 
 	// Make sure we get redrawn
 	setModified(true);
@@ -667,6 +698,7 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 void BitmapCastMember::setPicture(Image::ImageDecoder &image, bool adjustSize) {
 	delete _picture;
 	_picture = new Picture(image);
+	purgeCachedImages();
 	if (adjustSize) {
 		auto surf = image.getSurface();
 		_size = surf->pitch * surf->h + _picture->getPaletteSize();
@@ -22,6 +22,8 @@
 #ifndef DIRECTOR_CASTMEMBER_BITMAP_H
 #define DIRECTOR_CASTMEMBER_BITMAP_H
 
+#include "common/ptr.h"
+
 #include "director/castmember/castmember.h"
 
 namespace Image {
@@ -59,7 +61,7 @@ public:
 	Common::Point getRegistrationOffset(int16 width, int16 height) override;
 
 	Picture *_picture = nullptr;
-	Graphics::Surface *_ditheredImg;
+	Common::SharedPtr<Graphics::Surface> _ditheredImg;
 	Graphics::FloodFill *_matte;
 
 	uint16 _pitch;
@@ -75,6 +77,10 @@ public:
 	uint32 _tag;
 	bool _noMatte;
 	bool _external;
+
+private:
+	Common::SharedPtr<Graphics::Surface> ditherImage(const CastMemberID &targetPaletteId, const byte *srcPal, int srcPalLength, const byte *dstPal, int dstPalLength);
+	void purgeCachedImages();
 };
 
 } // End of namespace Director
@@ -678,6 +678,27 @@ bool Channel::isTrail() {
 	return _sprite->_trails;
 }
 
+bool Channel::isOpaqueOver(const Common::Rect &r) {
+	// Only sprites which replace every pixel they cover hide the channels
+	// below them
+	if (!_visible || _sprite->_ink != kInkTypeCopy || _sprite->_blendAmount || hasSubChannels())
+		return false;
+
+	if (isActiveVideo() && isVideoDirectToStage())
+		return false;
+
+	Common::Rect bbox = getBbox();
+	if (!bbox.contains(r))
+		return false;
+
+	Graphics::ManagedSurface *surface = getSurface();
+	if (!surface || surface->w < bbox.width() || surface->h < bbox.height() || getMask())
+		return false;
+
+	DirectorPlotData pd = getPlotData();
+	return !pd.applyColor || pd.sprite == kTextSprite;
+}
+
 int Channel::getMouseChar(int x, int y) {
 	if (_sprite->_spriteType != kTextSprite)
 		return -1;
@@ -70,6 +70,7 @@ public:
 	void updateTextCast();
 
 	bool isTrail();
+	bool isOpaqueOver(const Common::Rect &r);
 
 	void updateGlobalAttr();
 
@@ -22,6 +22,7 @@
 #include "common/language.h"
 #include "common/platform.h"
 #include "director/director.h"
+#include "director/bitmapcache.h"
 #include "director/debugger.h"
 #include "director/archive.h"
 #include "director/cast.h"
@@ -59,6 +60,8 @@ Debugger::Debugger(): GUI::Debugger() {
 	registerCmd("nf", WRAP_METHOD(Debugger, cmdNextFrame));
 	registerCmd("nextmovie", WRAP_METHOD(Debugger, cmdNextMovie));
 	registerCmd("nm", WRAP_METHOD(Debugger, cmdNextMovie));
+	registerCmd("datumstats", WRAP_METHOD(Debugger, cmdDatumStats));
+	registerCmd("bitmapcache", WRAP_METHOD(Debugger, cmdBitmapCache));
 
 	registerCmd("print", WRAP_METHOD(Debugger, cmdPrint));
 	registerCmd("p", WRAP_METHOD(Debugger, cmdPrint));
@@ -152,6 +155,8 @@ bool Debugger::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" cast [castNum] - Shows the cast list or castNum for the current movie\n");
 	debugPrintf(" nextframe / nf [n] - Steps forward one or more score frames\n");
 	debugPrintf(" nextmovie / nm - Steps forward until the next change of movie\n");
+	debugPrintf(" datumstats - Shows how many Lingo values were allocated per score frame\n");
+	debugPrintf(" bitmapcache [clear] - Shows or clears the caches of converted and scaled bitmaps\n");
 	debugPrintf("\n");
 	debugPrintf("Lingo execution:\n");
 	debugPrintf(" print / p [statement] - Evaluates a single Lingo statement\n");
@@ -196,6 +201,28 @@ bool Debugger::cmdHelp(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdDatumStats(int argc, const char **argv) {
+	Lingo *lingo = g_director->getLingo();
+	debugPrintf("Datum allocations in the last frame: %d\n", lingo->_datumAllocsLastFrame);
+	debugPrintf("Most Datum allocations in a frame: %d\n", lingo->_datumAllocsMaxFrame);
+	debugPrintf("Datum allocations since the last frame: %d\n", Datum::numAllocations - lingo->_datumAllocsFrameStart);
+	debugPrintf("Frames profiled: %d\n", lingo->_datumStatsFrames);
+	debugPrintf("Total Datum allocations: %d\n", Datum::numAllocations);
+	debugPrintf("\n");
+	return true;
+}
+
+bool Debugger::cmdBitmapCache(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "clear")) {
+		g_director->_bitmapCache->clear();
+		g_director->_scaledBitmapCache->clear();
+	}
+	debugPrintf("%s\n", g_director->_bitmapCache->formatStats().c_str());
+	debugPrintf("%s\n", g_director->_scaledBitmapCache->formatStats().c_str());
+	debugPrintf("\n");
+	return true;
+}
+
 bool Debugger::cmdVersion(int argc, const char **argv) {
 	debugPrintf("Director version: %d\n", g_director->getVersion());
 	debugPrintf("Director platform: %s\n", Common::getPlatformCode(g_director->getPlatform()));
@@ -281,7 +308,7 @@ bool Debugger::cmdChannels(int argc, const char **argv) {
 
 	if (frameId >= 1 && frameId <= maxSize) {
 		debugPrintf("Channel info for frame %d of %d\n", frameId, maxSize);
-		debugPrintf("%s\n", score->_frames[frameId-1]->formatChannelInfo().c_str());
+		debugPrintf("%s\n", score->getFrame(frameId-1)->formatChannelInfo().c_str());
 	} else {
 		debugPrintf("Must specify a frame number between 1 and %d.\n", maxSize);
 	}
@@ -125,6 +125,8 @@ private:
 	bool cmdHelp(int argc, const char **argv);
 
 	bool cmdVersion(int argc, const char **argv);
+	bool cmdDatumStats(int argc, const char **argv);
+	bool cmdBitmapCache(int argc, const char **argv);
 	bool cmdInfo(int argc, const char **argv);
 	bool cmdMovie(int argc, const char **argv);
 	bool cmdFrame(int argc, const char **argv);
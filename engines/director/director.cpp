@@ -31,6 +31,7 @@
 #include "director/director.h"
 #include "director/debugger.h"
 #include "director/archive.h"
+#include "director/bitmapcache.h"
 #include "director/cast.h"
 #include "director/movie.h"
 #include "director/picture.h"
@@ -142,6 +143,9 @@ DirectorEngine::DirectorEngine(OSystem *syst, const DirectorGameDescription *gam
 
 	_surface = nullptr;
 	_tickBaseline = 0;
+
+	_bitmapCache = new BitmapCache("converted", 16 * 1024 * 1024);
+	_scaledBitmapCache = new BitmapCache("scaled", 16 * 1024 * 1024);
 }
 
 DirectorEngine::~DirectorEngine() {
@@ -158,6 +162,11 @@ DirectorEngine::~DirectorEngine() {
 		delete _winCursor[i];
 
 	clearPalettes();
+
+	// Cast members purge their entries when deleted, so go last
+	delete _bitmapCache;
+	delete _scaledBitmapCache;
+	_bitmapCache = _scaledBitmapCache = nullptr;
 }
 
 Archive *DirectorEngine::getMainArchive() const { return _currentWindow->getMainArchive(); }
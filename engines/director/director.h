@@ -56,6 +56,7 @@ class ManagedSurface;
 namespace Director {
 
 class Archive;
+class BitmapCache;
 class MacArchive;
 class Cast;
 class DirectorSound;
@@ -259,6 +260,10 @@ public:
 
 	Common::Array<Graphics::WinCursorGroup *> _winCursor;
 
+	// Palette conversions and scaled copies of bitmap cast members
+	BitmapCache *_bitmapCache;
+	BitmapCache *_scaledBitmapCache;
+
 
 protected:
 	Common::Error run() override;
@@ -620,6 +620,70 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+// Row blitters for the inks which just copy some of the source pixels
+// unchanged. inkDrawPixel() handles every other case.
+template <typename T, InkType INK>
+static void inkBlitRow(T *dst, const T *src, const T *msk, int width, uint32 backColor) {
+	for (int i = 0; i < width; i++) {
+		if (msk && msk[i])
+			continue;
+		if (INK == kInkTypeBackgndTrans && src[i] == (T)backColor)
+			continue;
+		dst[i] = src[i];
+	}
+}
+
+template <typename T>
+static void inkBlitRowCopy(T *dst, const T *src, const T *msk, int width, uint32 backColor) {
+	if (msk)
+		inkBlitRow<T, kInkTypeCopy>(dst, src, msk, width, backColor);
+	else
+		memcpy(dst, src, width * sizeof(T));
+}
+
+template <typename T>
+static bool inkBlitSurfaceFast(DirectorPlotData &p, Common::Rect &srcRect, const Graphics::Surface *mask, bool &failedBoundsCheck) {
+	void (*blitRow)(T *, const T *, const T *, int, uint32);
+
+	switch (p.ink) {
+	case kInkTypeMask:
+		// Text sprites are recoloured for the mask ink
+		if (p.sprite == kTextSprite)
+			return false;
+		// fall through
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeBlend:
+		blitRow = &inkBlitRowCopy<T>;
+		break;
+	case kInkTypeBackgndTrans:
+		if (p.oneBitImage)
+			return false;
+		blitRow = &inkBlitRow<T, kInkTypeBackgndTrans>;
+		break;
+	default:
+		return false;
+	}
+
+	int srcX = abs(srcRect.left - p.destRect.left);
+	int srcY = abs(srcRect.top - p.destRect.top);
+	int width = MIN<int>(p.destRect.width(), p.srf->w - srcX);
+	if (width < p.destRect.width())
+		failedBoundsCheck = true;
+
+	for (int i = 0; i < p.destRect.height(); i++, srcY++) {
+		if (srcY >= p.srf->h || width <= 0) {
+			failedBoundsCheck = true;
+			continue;
+		}
+
+		const T *msk = mask ? (const T *)mask->getBasePtr(srcX, srcY) : nullptr;
+		blitRow((T *)p.dst->getBasePtr(p.destRect.left, p.destRect.top + i), (const T *)p.srf->getBasePtr(srcX, srcY), msk, width, p.backColor);
+	}
+
+	return true;
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -631,8 +695,17 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	Common::Rect srfClip = srf->getBounds();
 	bool failedBoundsCheck = false;
 
+	// Copy the pixels row by row where the ink leaves them unchanged
+	bool blitted = false;
+	if (!alpha && !applyColor) {
+		if (d->_wm->_pixelformat.bytesPerPixel == 1)
+			blitted = inkBlitSurfaceFast<byte>(*this, srcRect, mask, failedBoundsCheck);
+		else
+			blitted = inkBlitSurfaceFast<uint32>(*this, srcRect, mask, failedBoundsCheck);
+	}
+
 	srcPoint.y = abs(srcRect.top - destRect.top);
-	for (int i = 0; i < destRect.height(); i++, srcPoint.y++) {
+	for (int i = 0; i < destRect.height() && !blitted; i++, srcPoint.y++) {
 		if (d->_wm->_pixelformat.bytesPerPixel == 1) {
 			srcPoint.x = abs(srcRect.left - destRect.left);
 			const byte *msk = mask ? (const byte *)mask->getBasePtr(srcPoint.x, srcPoint.y) : nullptr;
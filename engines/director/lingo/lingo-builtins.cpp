@@ -2288,7 +2288,7 @@ void LB::b_move(int nargs) {
 	b_erase(1);
 	Score *score = movie->getScore();
 	uint16 frame = score->getCurrentFrame();
-	Frame *currentFrame = score->_frames[frame];
+	Frame *currentFrame = score->getFrame(frame);
 	auto channels = score->_channels;
 
 	score->renderFrame(frame, kRenderForceUpdate);
@@ -2317,7 +2317,7 @@ void LB::b_move(int nargs) {
 void LB::b_moveableSprite(int nargs) {
 	Movie *movie = g_director->getCurrentMovie();
 	Score *score = movie->getScore();
-	Frame *frame = score->_frames[score->getCurrentFrame()];
+	Frame *frame = score->getFrame(score->getCurrentFrame());
 
 	if (g_lingo->_currentChannelId == -1) {
 		warning("b_moveableSprite: channel Id is missing");
@@ -2348,7 +2348,7 @@ void LB::b_pasteClipBoardInto(int nargs) {
 
 	Score *score = movie->getScore();
 	uint16 frame = score->getCurrentFrame();
-	Frame *currentFrame = score->_frames[frame];
+	Frame *currentFrame = score->getFrame(frame);
 	auto channels = score->_channels;
 
 	castMember->setModified(true);
@@ -2522,7 +2522,7 @@ void LB::b_immediateSprite(int nargs) {
 				// same as puppetSprite
 				Channel *channel = sc->getChannelById(sprite.asInt());
 
-				channel->replaceSprite(sc->_frames[sc->getNextFrame()]->_sprites[sprite.asInt()]);
+				channel->replaceSprite(sc->getFrame(sc->getNextFrame())->_sprites[sprite.asInt()]);
 				channel->_dirty = true;
 			}
 
@@ -2563,7 +2563,7 @@ void LB::b_puppetSprite(int nargs) {
 				// sprite in new frame before setting puppet (Majestic).
 				Channel *channel = sc->getChannelById(sprite.asInt());
 
-				channel->replaceSprite(sc->_frames[sc->getNextFrame()]->_sprites[sprite.asInt()]);
+				channel->replaceSprite(sc->getFrame(sc->getNextFrame())->_sprites[sprite.asInt()]);
 				channel->_dirty = true;
 			}
 
@@ -2721,14 +2721,14 @@ void LB::b_zoomBox(int nargs) {
 	Common::Rect endRect = score->_channels[endSpriteId]->getBbox();
 	if (endRect.isEmpty()) {
 		if ((uint)curFrame + 1 < score->_frames.size()) {
-			Channel endChannel(nullptr, score->_frames[curFrame + 1]->_sprites[endSpriteId]);
+			Channel endChannel(nullptr, score->getFrame(curFrame + 1)->_sprites[endSpriteId]);
 			endRect = endChannel.getBbox();
 		}
 	}
 
 	if (endRect.isEmpty()) {
 		if ((uint)curFrame - 1 > 0) {
-			Channel endChannel(nullptr, score->_frames[curFrame - 1]->_sprites[endSpriteId]);
+			Channel endChannel(nullptr, score->getFrame(curFrame - 1)->_sprites[endSpriteId]);
 			endRect = endChannel.getBbox();
 		}
 	}
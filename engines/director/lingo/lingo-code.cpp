@@ -102,6 +102,12 @@ static struct FuncDescr {
 	{ LC::c_itemToOfRef,	"c_itemToOfRef",	"" },	// D3
 	{ LC::c_jump,			"c_jump",			"o" },
 	{ LC::c_jumpifz,		"c_jumpifz",		"o" },
+	{ LC::c_eqjumpifz,		"c_eqjumpifz",		"" },	// fused c_eq, c_jumpifz
+	{ LC::c_neqjumpifz,		"c_neqjumpifz",		"" },	// fused c_neq, c_jumpifz
+	{ LC::c_gtjumpifz,		"c_gtjumpifz",		"" },	// fused c_gt, c_jumpifz
+	{ LC::c_ltjumpifz,		"c_ltjumpifz",		"" },	// fused c_lt, c_jumpifz
+	{ LC::c_gejumpifz,		"c_gejumpifz",		"" },	// fused c_ge, c_jumpifz
+	{ LC::c_lejumpifz,		"c_lejumpifz",		"" },	// fused c_le, c_jumpifz
 	{ LC::c_le,				"c_le",				"" },
 	{ LC::c_lineToOf,		"c_lineToOf",		"" },	// D3
 	{ LC::c_lineToOfRef,	"c_lineToOfRef",	"" },	// D3
@@ -187,6 +193,53 @@ void Lingo::cleanupFuncs() {
 		delete it->_value;
 }
 
+static const struct FusedJump {
+	const inst compare;
+	const inst fused;
+} fusedJumps[] = {
+	{ LC::c_eq,		LC::c_eqjumpifz },
+	{ LC::c_neq,	LC::c_neqjumpifz },
+	{ LC::c_gt,		LC::c_gtjumpifz },
+	{ LC::c_lt,		LC::c_ltjumpifz },
+	{ LC::c_ge,		LC::c_gejumpifz },
+	{ LC::c_le,		LC::c_lejumpifz },
+	{ nullptr, nullptr }
+};
+
+void Lingo::fuseInstructions(ScriptData *sd) {
+	// Replace comparisons which are directly followed by a c_jumpifz with
+	// a single instruction doing both. Only the opcode of the comparison is
+	// replaced, the c_jumpifz stays in place and is skipped by the fused
+	// instruction, so the layout of the script and all jump targets remain
+	// valid, including jumps to the c_jumpifz itself.
+	uint pc = 0;
+	while (pc < sd->size()) {
+		const uint start = pc;
+		void *opcodeFunc = (void *)(*sd)[pc++];
+		if (!_functions.contains(opcodeFunc))
+			break;
+
+		for (const char *pars = _functions[opcodeFunc]->proto; *pars; pars++) {
+			if (*pars == 's')
+				pc += calcStringAlignment((char *)&(*sd)[pc]);
+			else if (*pars == 'f')
+				pc += calcCodeAlignment(sizeof(double));
+			else
+				pc++;
+		}
+
+		if (pc + 1 >= sd->size() || (*sd)[pc] != LC::c_jumpifz)
+			continue;
+
+		for (const FusedJump *fj = fusedJumps; fj->compare; fj++) {
+			if ((*sd)[start] == fj->compare) {
+				(*sd)[start] = fj->fused;
+				break;
+			}
+		}
+	}
+}
+
 void Lingo::push(Datum d) {
 	_stack.push_back(d);
 }
@@ -509,27 +562,29 @@ void LC::c_proprefpush() {
 	g_lingo->push(d);
 }
 
+// The variable pushes build the reference in place instead of pushing and
+// popping it again, as they run more often than any other instruction
 void LC::c_varpush() {
-	LC::c_varrefpush();
-	Datum d = g_lingo->pop();
+	Datum d(g_lingo->readString());
+	d.type = VARREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
+	Datum d(g_lingo->readString());
+	d.type = GLOBALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_localpush() {
-	LC::c_localrefpush();
-	Datum d = g_lingo->pop();
+	Datum d(g_lingo->readString());
+	d.type = LOCALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
+	Datum d(g_lingo->readString());
+	d.type = PROPREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
@@ -1405,6 +1460,30 @@ void LC::c_jumpifz() {
 	}
 }
 
+// Comparisons fused with the c_jumpifz following them by
+// Lingo::fuseInstructions(). They skip over the c_jumpifz opcode and
+// then behave exactly like it.
+#define COMPARE_JUMPIFZ(name, compareFunc) \
+	void LC::name() { \
+		Datum d2 = g_lingo->pop(); \
+		Datum d1 = g_lingo->pop(); \
+		int test = compareFunc(d1, d2).asInt(); \
+		g_lingo->_state->pc++; \
+		int jump = g_lingo->readInt(); \
+		if (test == 0) { \
+			g_lingo->_state->pc = g_lingo->_state->pc + jump - 2; \
+		} \
+	}
+
+COMPARE_JUMPIFZ(c_eqjumpifz, LC::eqData)
+COMPARE_JUMPIFZ(c_neqjumpifz, LC::neqData)
+COMPARE_JUMPIFZ(c_gtjumpifz, LC::gtData)
+COMPARE_JUMPIFZ(c_ltjumpifz, LC::ltData)
+COMPARE_JUMPIFZ(c_gejumpifz, LC::geData)
+COMPARE_JUMPIFZ(c_lejumpifz, LC::leData)
+
+#undef COMPARE_JUMPIFZ
+
 void LC::c_whencode() {
 	Common::String eventname(g_lingo->readString());
 	Datum code = g_lingo->pop();
@@ -1487,7 +1566,7 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 			objName.type = VARREF;
 			Datum obj = g_lingo->varFetch(objName, true);
 			if (obj.type == OBJECT && (obj.u.obj->getObjType() & (kFactoryObj | kXObj))) {
-				debugC(3, kDebugLingoExec, "Factory/XObject method called on object: <%s>", obj.asString(true).c_str());
+				DEBUG_C(3, kDebugLingoExec, "Factory/XObject method called on object: <%s>", obj.asString(true).c_str());
 				AbstractObject *target = obj.u.obj;
 				if (firstArg.u.s->equalsIgnoreCase("mNew")) {
 					target = target->clone();
@@ -1506,7 +1585,7 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 
 		// Script/Xtra method call
 		if (firstArg.type == OBJECT && !(firstArg.u.obj->getObjType() & (kFactoryObj | kXObj))) {
-			debugC(3, kDebugLingoExec, "Script/Xtra method called on object: <%s>", firstArg.asString(true).c_str());
+			DEBUG_C(3, kDebugLingoExec, "Script/Xtra method called on object: <%s>", firstArg.asString(true).c_str());
 			AbstractObject *target = firstArg.u.obj;
 			if (name.equalsIgnoreCase("birth") || name.equalsIgnoreCase("new")) {
 				target = target->clone();
@@ -119,6 +119,12 @@ Datum leData(Datum d1, Datum d2);
 void c_le();
 void c_jump();
 void c_jumpifz();
+void c_eqjumpifz();
+void c_neqjumpifz();
+void c_gtjumpifz();
+void c_ltjumpifz();
+void c_gejumpifz();
+void c_lejumpifz();
 void c_callcmd();
 void c_callfunc();
 
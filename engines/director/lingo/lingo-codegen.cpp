@@ -177,6 +177,8 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 			debugC(2, kDebugCompile, "<end code>");
 		}
 
+		g_lingo->fuseInstructions(_currentAssembly);
+
 		Symbol currentFunc;
 
 		currentFunc.type = HANDLER;
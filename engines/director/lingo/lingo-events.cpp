@@ -119,7 +119,7 @@ void Movie::queueSpriteEvent(Common::Queue<LingoEvent> &queue, LEvent event, int
 	 * When more than one movie script [...]
 	 * [D4 docs] */
 
-	Frame *currentFrame = _score->_frames[_score->getCurrentFrame()];
+	Frame *currentFrame = _score->getFrame(_score->getCurrentFrame());
 	assert(currentFrame != nullptr);
 	Sprite *sprite = _score->getSpriteById(spriteId);
 
@@ -160,8 +160,8 @@ void Movie::queueFrameEvent(Common::Queue<LingoEvent> &queue, LEvent event, int
 	// 	entity = score->getCurrentFrame();
 	// } else {
 
-	assert(_score->_frames[_score->getCurrentFrame()] != nullptr);
-	CastMemberID scriptId = _score->_frames[_score->getCurrentFrame()]->_actionId;
+	assert(_score->getFrame(_score->getCurrentFrame()) != nullptr);
+	CastMemberID scriptId = _score->getFrame(_score->getCurrentFrame())->_actionId;
 	if (!scriptId.member)
 		return;
 
@@ -350,6 +350,8 @@ Common::String ScriptContext::asString() {
 }
 
 Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames) {
+	g_lingo->fuseInstructions(code);
+
 	Symbol sym;
 	sym.name = new Common::String(name);
 	sym.type = HANDLER;
@@ -462,7 +462,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		d.u.s = score->getFrameLabel(score->getCurrentFrame());
 		break;
 	case kTheFrameScript:
-		d = score->_frames[score->getCurrentFrame()]->_actionId.member;
+		d = score->getFrame(score->getCurrentFrame())->_actionId.member;
 		break;
 	case kTheFramePalette:
 		d = score->getCurrentPalette();
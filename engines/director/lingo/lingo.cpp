@@ -21,6 +21,7 @@
 
 #include "common/file.h"
 #include "common/config-manager.h"
+#include "common/memorypool.h"
 
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -203,6 +204,11 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	_passEvent = false;
 	_perFrameHook = Datum();
 
+	_datumAllocsFrameStart = Datum::numAllocations;
+	_datumAllocsLastFrame = 0;
+	_datumAllocsMaxFrame = 0;
+	_datumStatsFrames = 0;
+
 	_windowList.type = ARRAY;
 	_windowList.u.farr = new FArray;
 
@@ -791,29 +797,38 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool numsOnly) {
 	return opType;
 }
 
+// Reference counts of Datums are small and short-lived, so they come from a pool
+static Common::ObjectPool<int, 512> s_datumRefCounts;
+
+static int *newDatumRefCount() {
+	Datum::numAllocations++;
+	return new (s_datumRefCounts) int(1);
+}
+
+uint32 Datum::numAllocations = 0;
+
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Datum &d) {
 	type = d.type;
 	u = d.u;
-	refCount = d.refCount;
-	*refCount += 1;
+	refCount = d.shareRefCount();
 	ignoreGlobal = false;
 }
 
 Datum& Datum::operator=(const Datum &d) {
-	if (this != &d && refCount != d.refCount) {
+	if (this != &d && (!refCount || refCount != d.refCount)) {
+		// Share first, d may be owned by the payload released here
+		int *newRefCount = d.shareRefCount();
 		reset();
 		type = d.type;
 		u = d.u;
-		refCount = d.refCount;
-		*refCount += 1;
+		refCount = newRefCount;
 	}
 	ignoreGlobal = false;
 	return *this;
@@ -822,24 +837,22 @@ Datum& Datum::operator=(const Datum &d) {
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Common::String &val) {
 	u.s = new Common::String(val);
+	numAllocations++;
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
@@ -851,94 +864,116 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const CastMemberID &val) {
 	u.cast = new CastMemberID(val);
+	numAllocations++;
 	type = CASTREF;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Common::Rect &rect) {
 	type = RECT;
 	u.farr = new FArray;
+	numAllocations++;
 	u.farr->arr.push_back(Datum(rect.left));
 	u.farr->arr.push_back(Datum(rect.top));
 	u.farr->arr.push_back(Datum(rect.right));
 	u.farr->arr.push_back(Datum(rect.bottom));
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
+bool Datum::hasPayload() const {
+	switch (type) {
+	case VOID:
+	case INT:
+	case FLOAT:
+	case ARGC:
+	case ARGCNORET:
+		return false;
+	default:
+		return true;
+	}
+}
+
+int *Datum::shareRefCount() const {
+	if (!refCount) {
+		if (!hasPayload())
+			return nullptr;
+		refCount = newDatumRefCount();
+	}
+	*refCount += 1;
+	return refCount;
+}
+
 void Datum::reset() {
-	if (!refCount)
-		return;
+	if (refCount) {
+		*refCount -= 1;
+		if (*refCount > 0)
+			return;
+	}
 
-	*refCount -= 1;
 	// Coverity thinks that we always free memory, as it assumes
 	// (correctly) that there are cases when refCount == 0
 	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
-	if (*refCount <= 0) {
-		switch (type) {
-		case VOID:
-		case INT:
-		case FLOAT:
-		case ARGC:
-		case ARGCNORET:
-			break;
-		case VARREF:
-		case GLOBALREF:
-		case LOCALREF:
-		case PROPREF:
-		case STRING:
-		case SYMBOL:
-			delete u.s;
-			break;
-		case ARRAY:
-		case POINT:
-		case RECT:
-			delete u.farr;
-			break;
-		case PARRAY:
-			delete u.parr;
-			break;
-		case OBJECT:
-			if (u.obj->getObjType() == kWindowObj) {
-				Window *window = static_cast<Window *>(u.obj);
-				g_director->_wm->removeWindow(window);
-				g_director->_wm->removeMarked();
-			} else {
-				delete u.obj;
-			}
-			break;
-		case CHUNKREF:
-			delete u.cref;
-			break;
-		case CASTREF:
-		case FIELDREF:
-			delete u.cast;
-			break;
-		case MENUREF:
-			delete u.menu;
-			break;
-		case PICTUREREF:
-			delete u.picture;
-			break;
-		default:
-			warning("Datum::reset(): Unprocessed REF type %d", type);
-			break;
+	switch (type) {
+	case VOID:
+	case INT:
+	case FLOAT:
+	case ARGC:
+	case ARGCNORET:
+		break;
+	case VARREF:
+	case GLOBALREF:
+	case LOCALREF:
+	case PROPREF:
+	case STRING:
+	case SYMBOL:
+		delete u.s;
+		break;
+	case ARRAY:
+	case POINT:
+	case RECT:
+		delete u.farr;
+		break;
+	case PARRAY:
+		delete u.parr;
+		break;
+	case OBJECT:
+		if (u.obj->getObjType() == kWindowObj) {
+			Window *window = static_cast<Window *>(u.obj);
+			g_director->_wm->removeWindow(window);
+			g_director->_wm->removeMarked();
+		} else {
+			delete u.obj;
 		}
-		if (type != OBJECT) // object owns refCount
-			delete refCount;
+		break;
+	case CHUNKREF:
+		delete u.cref;
+		break;
+	case CASTREF:
+	case FIELDREF:
+		delete u.cast;
+		break;
+	case MENUREF:
+		delete u.menu;
+		break;
+	case PICTUREREF:
+		delete u.picture;
+		break;
+	default:
+		warning("Datum::reset(): Unprocessed REF type %d", type);
+		break;
 	}
+	if (refCount && type != OBJECT) // object owns refCount
+		s_datumRefCounts.deleteChunk(refCount);
 #endif
 }
 
@@ -1404,6 +1439,14 @@ void Lingo::executeImmediateScripts(Frame *frame) {
 	}
 }
 
+void Lingo::updateDatumStats() {
+	_datumAllocsLastFrame = Datum::numAllocations - _datumAllocsFrameStart;
+	_datumAllocsMaxFrame = MAX(_datumAllocsMaxFrame, _datumAllocsLastFrame);
+	_datumAllocsFrameStart = Datum::numAllocations;
+	_datumStatsFrames++;
+	debugC(5, kDebugLingoExec, "Lingo::updateDatumStats(): %d Datum allocations in the last frame", _datumAllocsLastFrame);
+}
+
 void Lingo::executePerFrameHook(int frame, int subframe) {
 	// Execute perFrameHook and actorList stepFrame, if any is available
 	// Starting D4, stepFrame of each objects in actorList is executed
@@ -148,10 +148,17 @@ struct Datum {	/* interpreter stack type */
 		PictureReference *picture; /* PICTUREREF */
 	} u;
 
-	int *refCount;
+	// Shared by all copies of a Datum with a heap payload. Plain values
+	// (VOID, INT, FLOAT, ARGC) never get one, and a Datum which is the only
+	// owner of its payload only gets one once it is copied.
+	mutable int *refCount;
 
 	bool ignoreGlobal; // True if this Datum should be ignored by showGlobals and clearGlobals
 
+	// Number of heap allocations made by Datum constructors and copies,
+	// reported per frame by the "datumstats" debugger command
+	static uint32 numAllocations;
+
 	Datum();
 	Datum(const Datum &d);
 	Datum& operator=(const Datum &d);
@@ -162,6 +169,8 @@ struct Datum {	/* interpreter stack type */
 	Datum(const CastMemberID &val);
 	Datum(const Common::Rect &rect);
 	void reset();
+	int *shareRefCount() const;
+	bool hasPayload() const;
 
 	~Datum() {
 		reset();
@@ -355,6 +364,7 @@ public:
 	void cleanupBuiltIns(BuiltinProto protos[]);
 	void initFuncs();
 	void cleanupFuncs();
+	void fuseInstructions(ScriptData *sd);
 	void initBytecode();
 	void initMethods();
 	void cleanupMethods();
@@ -533,6 +543,13 @@ public:
 	void executeImmediateScripts(Frame *frame);
 	void executePerFrameHook(int frame, int subframe);
 
+	// Datum allocation profiling
+	void updateDatumStats();
+	uint32 _datumAllocsFrameStart;
+	uint32 _datumAllocsLastFrame;
+	uint32 _datumAllocsMaxFrame;
+	uint32 _datumStatsFrames;
+
 	// lingo-utils.cpp
 private:
 	Common::HashMap<uint32, Common::U32String> _charNormalizations;
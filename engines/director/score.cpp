@@ -87,6 +87,10 @@ Score::Score(Movie *movie) {
 
 	_numChannelsDisplayed = 0;
 	_skipTransition = false;
+
+	_framesVersion = 0;
+	_framesBigEndian = false;
+	_spriteCastsSet = false;
 }
 
 Score::~Score() {
@@ -277,8 +281,8 @@ void Score::startPlay() {
 
 	// All frames in the same movie have the same number of channels
 	if (_playState != kPlayStopped)
-		for (uint i = 0; i < _frames[1]->_sprites.size(); i++)
-			_channels.push_back(new Channel(this, _frames[1]->_sprites[i], i));
+		for (uint i = 0; i < getFrame(1)->_sprites.size(); i++)
+			_channels.push_back(new Channel(this, getFrame(1)->_sprites[i], i));
 
 	if (_vm->getVersion() >= 300)
 		_movie->processEvent(kEventStartMovie);
@@ -372,13 +376,15 @@ void Score::update() {
 
 		// If there is a transition, the perFrameHook is called
 		// after each transition subframe instead.
-		if (_frames[_currentFrame]->_transType == 0 && _frames[_currentFrame]->_trans.isNull()) {
+		if (getFrame(_currentFrame)->_transType == 0 && getFrame(_currentFrame)->_trans.isNull()) {
 			_lingo->executePerFrameHook(_currentFrame, 0);
 		}
 	}
 
 	_vm->_skipFrameAdvance = false;
 
+	_lingo->updateDatumStats();
+
 	// the exitFrame event handler may have stopped this movie
 	if (_playState == kPlayStopped) {
 		processFrozenScripts();
@@ -428,9 +434,9 @@ void Score::update() {
 		}
 	}
 
-	byte tempo = _frames[_currentFrame]->_scoreCachedTempo;
+	byte tempo = getFrame(_currentFrame)->_scoreCachedTempo;
 	// puppetTempo is overridden by changes in score tempo
-	if (_frames[_currentFrame]->_tempo || tempo != _lastTempo) {
+	if (getFrame(_currentFrame)->_tempo || tempo != _lastTempo) {
 		_puppetTempo = 0;
 	} else if (_puppetTempo) {
 		tempo = _puppetTempo;
@@ -491,7 +497,7 @@ void Score::update() {
 	debugC(1, kDebugLoading, "******************************  Current frame: %d, time: %d", _currentFrame, g_system->getMillis(false));
 	g_debugger->frameHook();
 
-	_lingo->executeImmediateScripts(_frames[_currentFrame]);
+	_lingo->executeImmediateScripts(getFrame(_currentFrame));
 
 	if (_vm->getVersion() >= 600) {
 		// _movie->processEvent(kEventBeginSprite);
@@ -581,7 +587,7 @@ void Score::renderFrame(uint16 frameId, RenderMode mode) {
 }
 
 bool Score::renderTransition(uint16 frameId) {
-	Frame *currentFrame = _frames[frameId];
+	Frame *currentFrame = getFrame(frameId);
 	TransParams *tp = _window->_puppetTransition;
 
 	if (tp) {
@@ -615,7 +621,7 @@ void Score::renderSprites(uint16 frameId, RenderMode mode) {
 	for (uint16 i = 0; i < _channels.size(); i++) {
 		Channel *channel = _channels[i];
 		Sprite *currentSprite = channel->_sprite;
-		Sprite *nextSprite = _frames[frameId]->_sprites[i];
+		Sprite *nextSprite = getFrame(frameId)->_sprites[i];
 
 		// widget content has changed and needs a redraw.
 		// this doesn't include changes in dimension or position!
@@ -669,14 +675,14 @@ bool Score::renderPrePaletteCycle(uint16 frameId, RenderMode mode) {
 		return false;
 
 	// Skip this if we don't have a palette instruction
-	CastMemberID currentPalette = _frames[frameId]->_palette.paletteId;
+	CastMemberID currentPalette = getFrame(frameId)->_palette.paletteId;
 	if (currentPalette.isNull())
 		return false;
 
-	if (!_frames[frameId]->_palette.colorCycling &&
-		!_frames[frameId]->_palette.overTime) {
+	if (!getFrame(frameId)->_palette.colorCycling &&
+		!getFrame(frameId)->_palette.overTime) {
 
-		int frameRate = CLIP<int>(_frames[frameId]->_palette.speed, 1, 30);
+		int frameRate = CLIP<int>(getFrame(frameId)->_palette.speed, 1, 30);
 
 		if (debugChannelSet(-1, kDebugFast))
 			frameRate = 30;
@@ -696,10 +702,10 @@ bool Score::renderPrePaletteCycle(uint16 frameId, RenderMode mode) {
 			return false;
 		}
 
-		if (_frames[frameId]->_palette.normal) {
+		if (getFrame(frameId)->_palette.normal) {
 			// If the target palette ID is the same as the previous palette ID,
 			// a normal fade is a no-op.
-			if (_frames[frameId]->_palette.paletteId == g_director->_lastPalette) {
+			if (getFrame(frameId)->_palette.paletteId == g_director->_lastPalette) {
 				return false;
 			}
 
@@ -737,11 +743,11 @@ bool Score::renderPrePaletteCycle(uint16 frameId, RenderMode mode) {
 			// the first half happens with the previous frame's layout.
 
 			byte *fadePal = nullptr;
-			if (_frames[frameId]->_palette.fadeToBlack) {
+			if (getFrame(frameId)->_palette.fadeToBlack) {
 				// Fade everything except color index 0 to black
 				debugC(2, kDebugImages, "Score::renderPrePaletteCycle(): fading palette to black over %d frames", fadeFrames);
 				fadePal = kBlackPalette;
-			} else if (_frames[frameId]->_palette.fadeToWhite) {
+			} else if (getFrame(frameId)->_palette.fadeToWhite) {
 				// Fade everything except color index 255 to white
 				debugC(2, kDebugImages, "Score::renderPrePaletteCycle(): fading palette to white over %d frames", fadeFrames);
 				fadePal = kWhitePalette;
@@ -785,12 +791,12 @@ void Score::setLastPalette(uint16 frameId) {
 		return;
 
 	bool isCachedPalette = false;
-	CastMemberID currentPalette = _frames[frameId]->_palette.paletteId;
+	CastMemberID currentPalette = getFrame(frameId)->_palette.paletteId;
 	// Palette not specified in the frame
 	if (currentPalette.isNull()) {
 		// Use the score cached palette ID
 		isCachedPalette = true;
-		currentPalette = _frames[frameId]->_scoreCachedPaletteId;
+		currentPalette = getFrame(frameId)->_scoreCachedPaletteId;
 		// The cached ID is created before the cast gets loaded; if it's zero,
 		// this corresponds to the movie default palette.
 		if (currentPalette.isNull())
@@ -811,14 +817,14 @@ void Score::setLastPalette(uint16 frameId) {
 		// Switch to a new palette immediately if:
 		// - this is color cycling mode, or
 		// - the cached palette ID is different (i.e. we jumped in the score)
-		if (_frames[frameId]->_palette.colorCycling || isCachedPalette)
+		if (getFrame(frameId)->_palette.colorCycling || isCachedPalette)
 			g_director->setPalette(g_director->_lastPalette);
 	}
 
 }
 
 bool Score::isPaletteColorCycling() {
-	return _frames[_currentFrame]->_palette.colorCycling;
+	return getFrame(_currentFrame)->_palette.colorCycling;
 }
 
 void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
@@ -827,7 +833,7 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 
 	// If the palette is defined in the frame and doesn't match
 	// the current one, set it
-	CastMemberID currentPalette = _frames[frameId]->_palette.paletteId;
+	CastMemberID currentPalette = getFrame(frameId)->_palette.paletteId;
 	if (currentPalette.isNull())
 		return;
 
@@ -840,7 +846,7 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 	// offset will remain.
 
 	// Cycle speed in FPS
-	int speed = _frames[frameId]->_palette.speed;
+	int speed = getFrame(frameId)->_palette.speed;
 	if (speed == 0)
 		return;
 
@@ -849,14 +855,14 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 
 	// 30 (the maximum) is actually unbounded
 	int delay = speed == 30 ? 10 : 1000 / speed;
-	if (_frames[frameId]->_palette.colorCycling) {
+	if (getFrame(frameId)->_palette.colorCycling) {
 		// Cycle the colors of a chosen palette
-		int firstColor = _frames[frameId]->_palette.firstColor;
-		int lastColor = _frames[frameId]->_palette.lastColor;
+		int firstColor = getFrame(frameId)->_palette.firstColor;
+		int lastColor = getFrame(frameId)->_palette.lastColor;
 
-		if (_frames[frameId]->_palette.overTime) {
+		if (getFrame(frameId)->_palette.overTime) {
 			// Do a single color step in one frame transition
-			debugC(2, kDebugImages, "Score::renderPaletteCycle(): color cycle palette %s, from colors %d to %d, by 1 frame", currentPalette.asString().c_str(), firstColor, lastColor);
+			DEBUG_C(2, kDebugImages, "Score::renderPaletteCycle(): color cycle palette %s, from colors %d to %d, by 1 frame", currentPalette.asString().c_str(), firstColor, lastColor);
 			g_director->shiftPalette(firstColor, lastColor, false);
 			g_director->draw();
 		} else {
@@ -868,8 +874,8 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 
 			// Do a full color cycle in one frame transition
 			int steps = lastColor - firstColor + 1;
-			debugC(2, kDebugImages, "Score::renderPaletteCycle(): color cycle palette %s, from colors %d to %d, over %d steps %d times", currentPalette.asString().c_str(), firstColor, lastColor, steps, _frames[frameId]->_palette.cycleCount);
-			for (int i = 0; i < _frames[frameId]->_palette.cycleCount; i++) {
+			DEBUG_C(2, kDebugImages, "Score::renderPaletteCycle(): color cycle palette %s, from colors %d to %d, over %d steps %d times", currentPalette.asString().c_str(), firstColor, lastColor, steps, getFrame(frameId)->_palette.cycleCount);
+			for (int i = 0; i < getFrame(frameId)->_palette.cycleCount; i++) {
 				for (int j = 0; j < steps; j++) {
 					uint32 startTime = g_system->getMillis();
 					g_director->shiftPalette(firstColor, lastColor, false);
@@ -887,7 +893,7 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 					int diff = (int)delay - (int)(endTime - startTime);
 					g_director->delayMillis(MAX(0, diff));
 				}
-				if (_frames[frameId]->_palette.autoReverse) {
+				if (getFrame(frameId)->_palette.autoReverse) {
 					for (int j = 0; j < steps; j++) {
 						uint32 startTime = g_system->getMillis();
 						g_director->shiftPalette(firstColor, lastColor, true);
@@ -915,10 +921,10 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 			warning("Score::renderPaletteCycle(): no match for palette id %s", currentPalette.asString().c_str());
 			return;
 		}
-		int frameCount = _frames[frameId]->_palette.frameCount;
+		int frameCount = getFrame(frameId)->_palette.frameCount;
 		byte calcPal[768];
 
-		if (_frames[frameId]->_palette.overTime) {
+		if (getFrame(frameId)->_palette.overTime) {
 			// Transition over a series of frames
 			if (_paletteTransitionIndex == 0) {
 				// Copy the current palette into the snapshot buffer
@@ -927,7 +933,7 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 				debugC(2, kDebugImages, "Score::renderPaletteCycle(): fading palette to %s over %d frames", currentPalette.asString().c_str(), frameCount);
 			}
 
-			if (_frames[frameId]->_palette.normal) {
+			if (getFrame(frameId)->_palette.normal) {
 				// Fade the palette directly to the new palette
 				lerpPalette(
 					calcPal,
@@ -942,10 +948,10 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 				int halfway = frameCount / 2;
 
 				byte *fadePal = nullptr;
-				if (_frames[frameId]->_palette.fadeToBlack) {
+				if (getFrame(frameId)->_palette.fadeToBlack) {
 					// Fade everything except color index 0 to black
 					fadePal = kBlackPalette;
-				} else if (_frames[frameId]->_palette.fadeToWhite) {
+				} else if (getFrame(frameId)->_palette.fadeToWhite) {
 					// Fade everything except color index 255 to white
 					fadePal = kWhitePalette;
 				} else {
@@ -984,19 +990,19 @@ void Score::renderPaletteCycle(uint16 frameId, RenderMode mode) {
 
 			// Do a full cycle in one frame transition
 			// For normal mode, we've already faded the palette in renderPrePaletteCycle
-			if (!_frames[frameId]->_palette.normal) {
+			if (!getFrame(frameId)->_palette.normal) {
 				byte *fadePal = nullptr;
-				if (_frames[frameId]->_palette.fadeToBlack) {
+				if (getFrame(frameId)->_palette.fadeToBlack) {
 					// Fade everything except color index 0 to black
 					fadePal = kBlackPalette;
-				} else if (_frames[frameId]->_palette.fadeToWhite) {
+				} else if (getFrame(frameId)->_palette.fadeToWhite) {
 					// Fade everything except color index 255 to white
 					fadePal = kWhitePalette;
 				} else {
 					// Shouldn't reach here
 					return;
 				}
-				int frameRate = CLIP<int>(_frames[frameId]->_palette.speed, 1, 30);
+				int frameRate = CLIP<int>(getFrame(frameId)->_palette.speed, 1, 30);
 
 				if (debugChannelSet(-1, kDebugFast))
 					frameRate = 30;
@@ -1287,7 +1293,7 @@ Sprite *Score::getSpriteById(uint16 id) {
 }
 
 Sprite *Score::getOriginalSpriteById(uint16 id) {
-	Frame *frame = _frames[_currentFrame];
+	Frame *frame = getFrame(_currentFrame);
 	if (id < frame->_sprites.size())
 		return frame->_sprites[id];
 	warning("Score::getOriginalSpriteById(%d): out of bounds, >= %d", id, frame->_sprites.size());
@@ -1304,9 +1310,9 @@ Channel *Score::getChannelById(uint16 id) {
 }
 
 void Score::playSoundChannel(uint16 frameId, bool puppetOnly) {
-	Frame *frame = _frames[frameId];
+	Frame *frame = getFrame(frameId);
 
-	debugC(5, kDebugSound, "playSoundChannel(): Sound1 %s Sound2 %s", frame->_sound1.asString().c_str(), frame->_sound2.asString().c_str());
+	DEBUG_C(5, kDebugSound, "playSoundChannel(): Sound1 %s Sound2 %s", frame->_sound1.asString().c_str(), frame->_sound2.asString().c_str());
 	DirectorSound *sound = _window->getSoundManager();
 
 	if (sound->isChannelPuppet(1)) {
@@ -1379,14 +1385,21 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version)
 		// Unknown, some bytes - constant (refer to contuinity).
 	}
 
-	uint16 channelSize;
-	uint16 channelOffset;
-
 	Frame *initial = new Frame(this, _numChannelsDisplayed);
 	// Push a frame at frame#0 position.
 	// This makes all indexing simpler
 	_frames.push_back(initial);
 
+	// Frames are only decoded when they are first used. Keep the frame
+	// deltas, and scan them once to find where each frame starts and to
+	// precache the values which carry forward from frame to frame.
+	uint32 dataSize = MIN<uint32>(size, stream.size() - stream.pos());
+	_framesData.resize(dataSize);
+	if (dataSize)
+		stream.read(_framesData.data(), dataSize);
+	_framesVersion = version;
+	_framesBigEndian = stream.isBE();
+
 	// This is a representation of the channelData. It gets overridden
 	// partically by channels, hence we keep it and read the score from left to right
 	//
@@ -1394,66 +1407,134 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version)
 	byte channelData[kChannelDataSize];
 	memset(channelData, 0, kChannelDataSize);
 
+	// A scratch frame to read the channels of every frame into
+	Frame scan(this, _numChannelsDisplayed);
+
 	uint8 currentTempo = 0;
 	CastMemberID currentPaletteId = CastMemberID(0, 0);
 
-	while (size != 0 && !stream.eos()) {
-		uint16 frameSize = stream.readUint16();
-		debugC(3, kDebugLoading, "++++++++++ score frame %d (frameSize %d) size %d", _frames.size(), frameSize, size);
+	uint32 offset = 0;
+	while (offset + 2 <= _framesData.size()) {
+		uint16 frameSize = _framesBigEndian ? READ_BE_UINT16(&_framesData[offset]) : READ_LE_UINT16(&_framesData[offset]);
+		debugC(3, kDebugLoading, "++++++++++ score frame %d (frameSize %d) offset %d", _frames.size(), frameSize, offset);
+
+		if (frameSize == 0) {
+			warning("zero sized frame!? exiting loop until we know what to do with the tags that follow.");
+			break;
+		}
+
+		if (offset + frameSize > _framesData.size()) {
+			warning("Score::loadFrames(): Frame %d is truncated", _frames.size());
+			break;
+		}
+
 		if (debugChannelSet(8, kDebugLoading)) {
-			stream.hexdump(frameSize);
+			Common::hexdump(&_framesData[offset], frameSize);
 		}
 
-		if (frameSize > 0) {
-			Frame *frame = new Frame(this, _numChannelsDisplayed);
-			size -= frameSize;
-			frameSize -= 2;
+		FramePosition position;
+		position.offset = offset;
+		applyFrameDelta(offset, channelData);
+		offset += frameSize;
+
+		// Keep a full snapshot every kFrameSnapshotInterval frames, so
+		// decoding any frame applies at most that many deltas
+		if ((_frames.size() - 1) % kFrameSnapshotInterval == 0) {
+			uint32 start = _frameSnapshots.size();
+			_frameSnapshots.resize(start + kChannelDataSize);
+			memcpy(&_frameSnapshots[start], channelData, kChannelDataSize);
+		}
 
-			while (frameSize != 0) {
+		Common::MemoryReadStreamEndian *str = new Common::MemoryReadStreamEndian(channelData, ARRAYSIZE(channelData), _framesBigEndian);
+		// str->hexdump(str->size(), 32);
+		scan.readChannels(str, version);
+		delete str;
+		// Precache the current FPS tempo, as this carries forward to frames to the right
+		// of the instruction.
+		// Delay type tempos (e.g. wait commands, delays) apply to only a single frame, and are ignored here.
+		if (scan._tempo && scan._tempo <= 120)
+			currentTempo = scan._tempo;
+		position.cachedTempo = scan._tempo ? scan._tempo : currentTempo;
+		// Precache the current palette ID, as this carries forward to frames to the right
+		// of the instruction.
+		if (!scan._palette.paletteId.isNull())
+			currentPaletteId = scan._palette.paletteId;
+		position.cachedPaletteId = currentPaletteId;
+
+		debugC(8, kDebugLoading, "Score::loadFrames(): Frame %d actionId: %s", _frames.size(), scan._actionId.asString().c_str());
+
+		_framePositions.push_back(position);
+		_frames.push_back(nullptr);
+	}
+}
 
-				if (_vm->getVersion() < 400) {
-					channelSize = stream.readByte() * 2;
-					channelOffset = stream.readByte() * 2;
-					frameSize -= channelSize + 2;
-				} else {
-					channelSize = stream.readUint16();
-					channelOffset = stream.readUint16();
-					frameSize -= channelSize + 4;
-				}
+void Score::applyFrameDelta(uint32 offset, byte *channelData) {
+	Common::MemoryReadStreamEndian stream(&_framesData[offset], _framesData.size() - offset, _framesBigEndian);
 
-				assert(channelOffset + channelSize < kChannelDataSize);
-				stream.read(&channelData[channelOffset], channelSize);
-			}
+	uint16 frameSize = stream.readUint16();
+	frameSize -= 2;
 
-			Common::MemoryReadStreamEndian *str = new Common::MemoryReadStreamEndian(channelData, ARRAYSIZE(channelData), stream.isBE());
-			// str->hexdump(str->size(), 32);
-			frame->readChannels(str, version);
-			delete str;
-			// Precache the current FPS tempo, as this carries forward to frames to the right
-			// of the instruction.
-			// Delay type tempos (e.g. wait commands, delays) apply to only a single frame, and are ignored here.
-			if (frame->_tempo && frame->_tempo <= 120)
-				currentTempo = frame->_tempo;
-			frame->_scoreCachedTempo = frame->_tempo ? frame->_tempo : currentTempo;
-			// Precache the current palette ID, as this carries forward to frames to the right
-			// of the instruction.
-			if (!frame->_palette.paletteId.isNull())
-				currentPaletteId = frame->_palette.paletteId;
-			frame->_scoreCachedPaletteId = currentPaletteId;
-
-			debugC(8, kDebugLoading, "Score::loadFrames(): Frame %d actionId: %s", _frames.size(), frame->_actionId.asString().c_str());
-
-			_frames.push_back(frame);
+	uint16 channelSize;
+	uint16 channelOffset;
+
+	while (frameSize != 0 && !stream.eos()) {
+		if (_vm->getVersion() < 400) {
+			channelSize = stream.readByte() * 2;
+			channelOffset = stream.readByte() * 2;
+			frameSize -= channelSize + 2;
 		} else {
-			warning("zero sized frame!? exiting loop until we know what to do with the tags that follow.");
-			size = 0;
+			channelSize = stream.readUint16();
+			channelOffset = stream.readUint16();
+			frameSize -= channelSize + 4;
 		}
+
+		assert(channelOffset + channelSize < kChannelDataSize);
+		stream.read(&channelData[channelOffset], channelSize);
+	}
+}
+
+Frame *Score::getFrame(uint16 frameId) {
+	Frame *&frame = _frames[frameId];
+	if (!frame)
+		frame = decodeFrame(frameId);
+	return frame;
+}
+
+Frame *Score::decodeFrame(uint16 frameId) {
+	// Start from the closest snapshot at or before the frame, and apply
+	// the deltas of the frames from there on
+	uint snapshot = (frameId - 1) / kFrameSnapshotInterval;
+	uint16 firstFrame = snapshot * kFrameSnapshotInterval + 1;
+
+	byte channelData[kChannelDataSize];
+	memcpy(channelData, &_frameSnapshots[snapshot * kChannelDataSize], kChannelDataSize);
+	for (uint16 i = firstFrame + 1; i <= frameId; i++)
+		applyFrameDelta(_framePositions[i - 1].offset, channelData);
+
+	debugC(3, kDebugLoading, "Score::decodeFrame(): Decoding frame %d from the snapshot of frame %d", frameId, firstFrame);
+
+	Frame *frame = new Frame(this, _numChannelsDisplayed);
+	Common::MemoryReadStreamEndian str(channelData, ARRAYSIZE(channelData), _framesBigEndian);
+	frame->readChannels(&str, _framesVersion);
+	frame->_scoreCachedTempo = _framePositions[frameId - 1].cachedTempo;
+	frame->_scoreCachedPaletteId = _framePositions[frameId - 1].cachedPaletteId;
+
+	if (_spriteCastsSet) {
+		for (uint16 j = 0; j < frame->_sprites.size(); j++)
+			frame->_sprites[j]->setCast(frame->_sprites[j]->_castId);
 	}
+
+	return frame;
 }
 
 void Score::setSpriteCasts() {
-	// Update sprite cache of cast pointers/info
+	// Update sprite cache of cast pointers/info. Frames which have not been
+	// decoded yet are updated when they are decoded.
+	_spriteCastsSet = true;
 	for (uint16 i = 0; i < _frames.size(); i++) {
+		if (!_frames[i])
+			continue;
+
 		for (uint16 j = 0; j < _frames[i]->_sprites.size(); j++) {
 			_frames[i]->_sprites[j]->setCast(_frames[i]->_sprites[j]->_castId);
 
@@ -1564,12 +1645,12 @@ void Score::loadActions(Common::SeekableReadStreamEndian &stream) {
 
 	// Now let's scan which scripts are actually referenced
 	for (uint i = 0; i < _frames.size(); i++) {
-		if ((uint)_frames[i]->_actionId.member <= _actions.size())
-			scriptRefs[_frames[i]->_actionId.member] = true;
+		if ((uint)getFrame(i)->_actionId.member <= _actions.size())
+			scriptRefs[getFrame(i)->_actionId.member] = true;
 
-		for (uint16 j = 0; j <= _frames[i]->_numChannels; j++) {
-			if ((uint)_frames[i]->_sprites[j]->_scriptId.member <= _actions.size())
-				scriptRefs[_frames[i]->_sprites[j]->_scriptId.member] = true;
+		for (uint16 j = 0; j <= getFrame(i)->_numChannels; j++) {
+			if ((uint)getFrame(i)->_sprites[j]->_scriptId.member <= _actions.size())
+				scriptRefs[getFrame(i)->_sprites[j]->_scriptId.member] = true;
 		}
 	}
 
@@ -1608,7 +1689,7 @@ void Score::loadActions(Common::SeekableReadStreamEndian &stream) {
 }
 
 Common::String Score::formatChannelInfo() {
-	Frame &frame = *_frames[_currentFrame];
+	Frame &frame = *getFrame(_currentFrame);
 	Common::String result;
 	CastMemberID defaultPalette = g_director->getCurrentMovie()->getCast()->_defaultPalette;
 	result += Common::String::format("TMPO:   tempo: %d, skipFrameFlag: %d, blend: %d, currentFPS: %d\n",
@@ -73,6 +73,12 @@ public:
 
 	Movie *getMovie() const { return _movie; }
 
+	/**
+	 * Get a frame of the score, decoding it on first use. Frames stay
+	 * decoded once they have been used, since scripts modify them in place.
+	 */
+	Frame *getFrame(uint16 frameId);
+
 	void loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version);
 	void loadLabels(Common::SeekableReadStreamEndian &stream);
 	void loadActions(Common::SeekableReadStreamEndian &stream);
@@ -133,6 +139,9 @@ private:
 	void update();
 	void playQueuedSound();
 
+	void applyFrameDelta(uint32 offset, byte *channelData);
+	Frame *decodeFrame(uint16 frameId);
+
 	void screenShot();
 
 	bool processImmediateFrameScript(Common::String s, int id);
@@ -140,7 +149,7 @@ private:
 
 public:
 	Common::Array<Channel *> _channels;
-	Common::Array<Frame *> _frames;
+	Common::Array<Frame *> _frames; // nullptr for frames which have not been decoded yet
 	Common::SortedArray<Label *> *_labels;
 	Common::HashMap<uint16, Common::String> _actions;
 	Common::HashMap<uint16, bool> _immediateActions;
@@ -179,6 +188,24 @@ private:
 	DirectorSound *_soundManager;
 
 	int _previousBuildBotBuild = -1;
+
+	enum {
+		/** Number of frames between two snapshots of the channel data. */
+		kFrameSnapshotInterval = 32
+	};
+
+	struct FramePosition {
+		uint32 offset; // of the frame delta in _framesData
+		uint8 cachedTempo;
+		CastMemberID cachedPaletteId;
+	};
+
+	Common::Array<byte> _framesData;
+	Common::Array<FramePosition> _framePositions; // for frames 1 and up
+	Common::Array<byte> _frameSnapshots; // channel data of frames 1, 1 + kFrameSnapshotInterval, ...
+	uint16 _framesVersion;
+	bool _framesBigEndian;
+	bool _spriteCastsSet;
 };
 
 } // End of namespace Director
@@ -135,8 +135,16 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		const Common::Rect &r = *i;
 		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
 
-		bool shouldClear = true;
+		// Neither the stage nor the channels below the topmost sprite which
+		// covers the whole rect with opaque pixels are visible
+		Channel *occluder = nullptr;
 		for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
+			if ((*j)->isOpaqueOver(r))
+				occluder = *j;
+		}
+
+		bool shouldClear = !occluder;
+		for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end() && shouldClear; j++) {
 			if ((*j)->_visible && r == (*j)->getBbox() && (*j)->isTrail()) {
 				shouldClear = false;
 				break;
@@ -147,6 +155,7 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 			blitTo->fillRect(r, _stageColor);
 
 		for (int pass = 0; pass < 2; pass++) {
+			bool occluded = occluder != nullptr;
 			for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
 				if ((*j)->isActiveVideo() && (*j)->isVideoDirectToStage()) {
 					if (pass == 0)
@@ -154,6 +163,12 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 				} else {
 					if (pass == 1)
 						continue;
+
+					if (occluded) {
+						if (*j != occluder)
+							continue;
+						occluded = false;
+					}
 				}
 
 				if ((*j)->_visible) {
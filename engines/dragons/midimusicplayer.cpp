@@ -18,9 +18,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/md5.h"
 #include "common/memstream.h"
+#include "common/savefile.h"
 #include "common/stream.h"
+#include "common/system.h"
 #include "audio/midiparser.h"
 #include "audio/soundfont/rawfile.h"
 #include "audio/soundfont/vab/vab.h"
@@ -30,7 +34,7 @@
 
 namespace Dragons {
 
-MidiMusicPlayer::MidiMusicPlayer(BigfileArchive *bigFileArchive): _midiDataSize(0) {
+MidiMusicPlayer::MidiMusicPlayer(BigfileArchive *bigFileArchive): _midiDataSize(0), _soundFontSize(0) {
 	_midiData = nullptr;
 	MidiPlayer::createDriver(MDT_PREFER_FLUID | MDT_MIDI);
 
@@ -154,6 +158,10 @@ void MidiMusicPlayer::sendToChannel(byte channel, uint32 b) {
 }
 
 Common::SeekableReadStream *MidiMusicPlayer::loadSoundFont(BigfileArchive *bigFileArchive) {
+	// The conversion is done once, later drivers get a new stream over the same data
+	if (_soundFontData)
+		return new Common::MemoryReadStream(_soundFontData, _soundFontSize);
+
 	uint32 headSize, bodySize;
 	byte *headData = bigFileArchive->load("musx.vh", headSize);
 	byte *bodyData = bigFileArchive->load("musx.vb", bodySize);
@@ -166,20 +174,71 @@ Common::SeekableReadStream *MidiMusicPlayer::loadSoundFont(BigfileArchive *bigFi
 	free(headData);
 	free(bodyData);
 
+	// Converting the VAB takes a while, so the result may be kept in the saves
+	// folder, keyed by the VAB contents
+	Common::String cacheName;
+	if (ConfMan.hasKey("dragons_soundfont_cache") && ConfMan.getBool("dragons_soundfont_cache")) {
+		Common::MemoryReadStream vabStream(vabData, headSize + bodySize);
+		cacheName = Common::String::format("dragons-musx-%s.sf2", Common::computeStreamMD5AsString(vabStream).c_str());
+
+		if (loadCachedSoundFont(cacheName)) {
+			free(vabData);
+			return new Common::MemoryReadStream(_soundFontData, _soundFontSize);
+		}
+	}
+
 	MemFile *memFile = new MemFile(vabData, headSize + bodySize);
 	debug("Loading soundfont2 from musx vab file.");
 	Vab *vab = new Vab(memFile, 0);
 	vab->LoadVGMFile();
 	VGMColl vabCollection;
 	SF2File *file = vabCollection.CreateSF2File(vab);
-	const byte *bytes = (const byte *)file->SaveToMem();
-	uint32 size = file->GetSize();
+	_soundFontData = Common::SharedPtr<byte>((byte *)const_cast<void *>(file->SaveToMem()), Common::ArrayDeleter<byte>());
+	_soundFontSize = file->GetSize();
 
 	delete file;
 	delete vab;
 	delete memFile;
 
-	return new Common::MemoryReadStream(bytes, size, DisposeAfterUse::YES);
+	if (!cacheName.empty())
+		saveCachedSoundFont(cacheName);
+
+	return new Common::MemoryReadStream(_soundFontData, _soundFontSize);
+}
+
+bool MidiMusicPlayer::loadCachedSoundFont(const Common::String &cacheName) {
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(cacheName);
+	if (!in)
+		return false;
+
+	uint32 size = in->size();
+	byte *data = new byte[size];
+	bool valid = size > 12 && in->read(data, size) == size
+		&& READ_BE_UINT32(data) == MKTAG('R', 'I', 'F', 'F') && READ_BE_UINT32(data + 8) == MKTAG('s', 'f', 'b', 'k');
+	delete in;
+
+	if (!valid) {
+		warning("Ignoring invalid cached soundfont '%s'", cacheName.c_str());
+		delete[] data;
+		return false;
+	}
+
+	debug("Loading soundfont2 from cache file '%s'.", cacheName.c_str());
+	_soundFontData = Common::SharedPtr<byte>(data, Common::ArrayDeleter<byte>());
+	_soundFontSize = size;
+	return true;
+}
+
+void MidiMusicPlayer::saveCachedSoundFont(const Common::String &cacheName) {
+	Common::OutSaveFile *out = g_system->getSavefileManager()->openForSaving(cacheName, false);
+	if (!out)
+		return;
+
+	out->write(_soundFontData.get(), _soundFontSize);
+	out->finalize();
+	if (out->err())
+		warning("Failed to write soundfont cache '%s'", cacheName.c_str());
+	delete out;
 }
 
 } // End of namespace Dragons
@@ -22,6 +22,7 @@
 #define DRAGONS_MIDIMUSICPLAYER_H
 
 #include "audio/midiplayer.h"
+#include "common/ptr.h"
 #include "vabsound.h"
 #include "bigfile.h"
 
@@ -30,6 +31,10 @@ namespace Dragons {
 class MidiMusicPlayer : public Audio::MidiPlayer {
 private:
 	uint32 _midiDataSize;
+
+	// SF2 data converted from the music VAB, shared with the streams given to the driver
+	Common::SharedPtr<byte> _soundFontData;
+	uint32 _soundFontSize;
 public:
 	MidiMusicPlayer(BigfileArchive *bigFileArchive);
 	~MidiMusicPlayer();
@@ -46,6 +51,8 @@ public:
 private:
 	byte *resizeMidiBuffer(uint32 desiredSize);
 	Common::SeekableReadStream *loadSoundFont(BigfileArchive *bigFileArchive);
+	bool loadCachedSoundFont(const Common::String &cacheName);
+	void saveCachedSoundFont(const Common::String &cacheName);
 };
 
 } // End of namespace Dragons
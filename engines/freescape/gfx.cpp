@@ -46,6 +46,7 @@ Renderer::Renderer(int screenW, int screenH, Common::RenderMode renderMode) {
 	_palette = nullptr;
 	_colorMap = nullptr;
 	_colorRemaps = nullptr;
+	_recordedGeometry = nullptr;
 	_renderMode = renderMode;
 	_isAccelerated = false;
 
@@ -574,356 +575,272 @@ void Renderer::renderPyramid(const Math::Vector3d &origin, const Math::Vector3d
 	}
 
 	Common::Array<Math::Vector3d> face;
-	byte *stipple = nullptr;
-	uint8 r1, g1, b1, r2, g2, b2;
-	if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[4]);
-		face.push_back(vertices[5]);
-		face.push_back(vertices[1]);
-		face.push_back(vertices[0]);
-
-		renderFace(face);
+	face.push_back(vertices[4]);
+	face.push_back(vertices[5]);
+	face.push_back(vertices[1]);
+	face.push_back(vertices[0]);
+	renderColouredFace(colours, 0, face);
+
+	face.clear();
+	face.push_back(vertices[5]);
+	face.push_back(vertices[6]);
+	face.push_back(vertices[2]);
+	face.push_back(vertices[1]);
+	renderColouredFace(colours, 1, face);
+
+	face.clear();
+	face.push_back(vertices[6]);
+	face.push_back(vertices[7]);
+	face.push_back(vertices[3]);
+	face.push_back(vertices[2]);
+	renderColouredFace(colours, 2, face);
+
+	face.clear();
+	face.push_back(vertices[7]);
+	face.push_back(vertices[4]);
+	face.push_back(vertices[0]);
+	face.push_back(vertices[3]);
+	renderColouredFace(colours, 3, face);
+
+	face.clear();
+	face.push_back(vertices[0]);
+	face.push_back(vertices[1]);
+	face.push_back(vertices[2]);
+	face.push_back(vertices[3]);
+	renderColouredFace(colours, 4, face);
+
+	face.clear();
+	face.push_back(vertices[7]);
+	face.push_back(vertices[6]);
+	face.push_back(vertices[5]);
+	face.push_back(vertices[4]);
+	renderColouredFace(colours, 5, face);
+}
 
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+void Renderer::renderCube(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
+	Common::Array<Math::Vector3d> face;
 
-		face.clear();
-	}
+	face.push_back(origin);
+	face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+	renderColouredFace(colours, 0, face);
+
+	face.clear();
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+	renderColouredFace(colours, 1, face);
+
+	face.clear();
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
+	renderColouredFace(colours, 2, face);
+
+	face.clear();
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	renderColouredFace(colours, 3, face);
+
+	face.clear();
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+	face.push_back(origin);
+	renderColouredFace(colours, 4, face);
+
+	face.clear();
+	face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
+	renderColouredFace(colours, 5, face);
+}
 
-	if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
+void Renderer::renderRectangle(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
 
-		face.push_back(vertices[5]);
-		face.push_back(vertices[6]);
-		face.push_back(vertices[2]);
-		face.push_back(vertices[1]);
+	assert(size.x() == 0 || size.y() == 0 || size.z() == 0);
+	useObjectPolygonOffset(true);
 
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+	float dx, dy, dz;
+	Common::Array<Math::Vector3d> vertices;
+	vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
 
-		face.clear();
+	dx = dy = dz = 0.0;
+	if (size.x() == 0) {
+		dy = size.y();
+	} else if (size.y() == 0) {
+		dx = size.x();
+	} else if (size.z() == 0) {
+		dx = size.x();
 	}
 
-	if (getRGBAt((*colours)[2], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
+	vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
+	vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
 
-		face.push_back(vertices[6]);
-		face.push_back(vertices[7]);
-		face.push_back(vertices[3]);
-		face.push_back(vertices[2]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
+	dx = dy = dz = 0.0;
+	if (size.x() == 0) {
+		dz = size.z();
+	} else if (size.y() == 0) {
+		dz = size.z();
+	} else if (size.z() == 0) {
+		dy = size.y();
 	}
 
-	if (getRGBAt((*colours)[3], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
+	vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
+	vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
 
-		face.push_back(vertices[7]);
-		face.push_back(vertices[4]);
-		face.push_back(vertices[0]);
-		face.push_back(vertices[3]);
+	for (int i = 0; i < 2; i++)
+		renderColouredFace(colours, i, vertices);
 
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
+	useObjectPolygonOffset(false);
+}
 
-	if (getRGBAt((*colours)[4], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
+void Renderer::renderPolygon(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours) {
+	if (ordinates->size() % 3 > 0 && ordinates->size() > 0)
+		error("Invalid polygon with size %f %f %f and ordinates %d", size.x(), size.y(), size.z(), ordinates->size());
 
-		face.push_back(vertices[0]);
-		face.push_back(vertices[1]);
-		face.push_back(vertices[2]);
-		face.push_back(vertices[3]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+	Common::Array<Math::Vector3d> vertices;
+	useObjectPolygonOffset(true);
 
-		face.clear();
-	}
+	for (uint i = 0; i < ordinates->size(); i = i + 3)
+		vertices.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
+	renderColouredFace(colours, 0, vertices);
 
-	if (getRGBAt((*colours)[5], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
+	vertices.clear();
+	for (int i = ordinates->size(); i > 0; i = i - 3)
+		vertices.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
+	renderColouredFace(colours, 1, vertices);
 
-		face.push_back(vertices[7]);
-		face.push_back(vertices[6]);
-		face.push_back(vertices[5]);
-		face.push_back(vertices[4]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
+	useObjectPolygonOffset(false);
 }
 
-void Renderer::renderCube(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
-	byte *stipple = nullptr;
-	uint8 r1, g1, b1, r2, g2, b2;
-	Common::Array<Math::Vector3d> face;
-
-	if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.push_back(origin);
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+void Renderer::renderColouredFace(Common::Array<uint8> *colours, uint slot, const Common::Array<Math::Vector3d> &face) {
+	if (_recordedGeometry) {
+		recordFace(slot, face);
+		return;
 	}
 
-	if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[2], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[3], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	uint8 r1, g1, b1, r2, g2, b2;
+	byte *stipple = nullptr;
+	if (!getRGBAt((*colours)[slot], r1, g1, b1, r2, g2, b2, stipple))
+		return;
+
+	setStippleData(stipple);
+	useColor(r1, g1, b1);
+	renderFace(face);
+	if (r1 != r2 || g1 != g2 || b1 != b2) {
+		useStipple(true);
+		useColor(r2, g2, b2);
 		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+		useStipple(false);
 	}
+}
 
-	if (getRGBAt((*colours)[4], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		face.push_back(origin);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
+void Renderer::useObjectPolygonOffset(bool enabled) {
+	if (!_recordedGeometry)
+		polygonOffset(enabled);
+	else if (enabled)
+		_recordedGeometry->_polygonOffset = true;
+}
 
-	if (getRGBAt((*colours)[5], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
+void Renderer::beginGeometry(ObjectGeometry *geometry) {
+	assert(!_recordedGeometry);
+	geometry->_faces.clear();
+	geometry->_vertices.clear();
+	geometry->_polygonOffset = false;
+	_recordedGeometry = geometry;
 }
 
-void Renderer::renderRectangle(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
+void Renderer::endGeometry() {
+	assert(_recordedGeometry);
+	_recordedGeometry = nullptr;
+}
 
-	assert(size.x() == 0 || size.y() == 0 || size.z() == 0);
-	polygonOffset(true);
+void Renderer::recordFace(uint slot, const Common::Array<Math::Vector3d> &face) {
+	assert(face.size() >= 2);
+	const Math::Vector3d &v0 = face[0];
 
-	float dx, dy, dz;
-	uint8 r1, g1, b1, r2, g2, b2;
-	byte *stipple = nullptr;
+	// Split the face exactly like renderFace does
 	Common::Array<Math::Vector3d> vertices;
-	for (int i = 0; i < 2; i++) {
-
-		// debug("rec color: %d", (*colours)[i]);
-		if (getRGBAt((*colours)[i], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			vertices.clear();
-			vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-
-			dx = dy = dz = 0.0;
-			if (size.x() == 0) {
-				dy = size.y();
-			} else if (size.y() == 0) {
-				dx = size.x();
-			} else if (size.z() == 0) {
-				dx = size.x();
-			}
+	if (face.size() == 2) {
+		if (v0 == face[1])
+			return;
+		vertices = face;
+	} else {
+		for (uint i = 1; i < face.size() - 1; i++) {
+			vertices.push_back(v0);
+			vertices.push_back(face[i]);
+			vertices.push_back(face[i + 1]);
+		}
+	}
 
-			vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
-			vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-			vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-
-			dx = dy = dz = 0.0;
-			if (size.x() == 0) {
-				dz = size.z();
-			} else if (size.y() == 0) {
-				dz = size.z();
-			} else if (size.z() == 0) {
-				dy = size.y();
-			}
+	ObjectGeometry::Face recorded;
+	recorded.colourSlot = slot;
+	recorded.lines = face.size() == 2;
+	recorded.first = _recordedGeometry->_vertices.size() / 3;
+	recorded.count = vertices.size();
+	_recordedGeometry->_faces.push_back(recorded);
 
-			vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
-			vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
-		}
+	for (uint i = 0; i < vertices.size(); i++) {
+		_recordedGeometry->_vertices.push_back(vertices[i].x());
+		_recordedGeometry->_vertices.push_back(vertices[i].y());
+		_recordedGeometry->_vertices.push_back(vertices[i].z());
 	}
-	polygonOffset(false);
 }
 
-void Renderer::renderPolygon(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours) {
+void Renderer::renderGeometry(ObjectGeometry *geometry, Common::Array<uint8> *colours) {
+	if (geometry->_polygonOffset)
+		polygonOffset(true);
+
 	uint8 r1, g1, b1, r2, g2, b2;
 	byte *stipple = nullptr;
-	if (ordinates->size() % 3 > 0 && ordinates->size() > 0)
-		error("Invalid polygon with size %f %f %f and ordinates %d", size.x(), size.y(), size.z(), ordinates->size());
+	for (uint i = 0; i < geometry->_faces.size(); i++) {
+		const ObjectGeometry::Face &face = geometry->_faces[i];
+		if (!getRGBAt((*colours)[face.colourSlot], r1, g1, b1, r2, g2, b2, stipple))
+			continue;
 
-	Common::Array<Math::Vector3d> vertices;
-	polygonOffset(true);
-
-	if (ordinates->size() == 6) {                 // Line
-		assert(getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)); // It will never return false?
 		setStippleData(stipple);
 		useColor(r1, g1, b1);
-		for (uint i = 0; i < ordinates->size(); i = i + 3)
-			vertices.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
-		renderFace(vertices);
+		renderGeometryFace(geometry, face);
 		if (r1 != r2 || g1 != g2 || b1 != b2) {
 			useStipple(true);
 			useColor(r2, g2, b2);
-			renderFace(vertices);
+			renderGeometryFace(geometry, face);
 			useStipple(false);
 		}
+	}
 
-		vertices.clear();
-		assert(getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)); // It will never return false?
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		for (int i = ordinates->size(); i > 0; i = i - 3)
-			vertices.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
-		renderFace(vertices);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(vertices);
-			useStipple(false);
-		}
+	if (geometry->_polygonOffset)
+		polygonOffset(false);
+}
 
-	} else {
-		if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			for (uint i = 0; i < ordinates->size(); i = i + 3) {
-				vertices.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
-			}
-			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
-		}
-		vertices.clear();
-		if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			for (int i = ordinates->size(); i > 0; i = i - 3) {
-				vertices.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
-			}
+void Renderer::renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face) {
+	Common::Array<Math::Vector3d> vertices;
+	const float *v = &geometry->_vertices[3 * face.first];
+	for (uint i = 0; i < face.count; i++, v += 3) {
+		vertices.push_back(Math::Vector3d(v[0], v[1], v[2]));
+		// Triangles are already split, so they are drawn one at a time
+		if (!face.lines && vertices.size() == 3) {
 			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
+			vertices.clear();
 		}
 	}
 
-	polygonOffset(false);
+	if (face.lines)
+		renderFace(vertices);
+}
+
+ObjectGeometry::ObjectGeometry(Renderer *renderer) : _polygonOffset(false), _buffer(0), _renderer(renderer) {}
+
+ObjectGeometry::~ObjectGeometry() {
+	_renderer->freeGeometry(this);
 }
 
 void Renderer::drawBackground(uint8 color) {
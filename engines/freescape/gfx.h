@@ -56,6 +56,32 @@ public:
 	static const Graphics::PixelFormat getRGBAPixelFormat();
 };
 
+/**
+ * The faces of an object, triangulated once and kept until the object moves.
+ * Only the geometry is retained: colours are resolved every time the object
+ * is drawn, since colour remaps and palettes change while an area is shown.
+ */
+class ObjectGeometry {
+public:
+	struct Face {
+		uint8 colourSlot; // index into the colours of the object
+		bool lines;
+		uint first;
+		uint count;
+	};
+
+	ObjectGeometry(Renderer *renderer);
+	~ObjectGeometry();
+
+	Common::Array<Face> _faces;
+	Common::Array<float> _vertices; // 3 floats per vertex
+	bool _polygonOffset;
+	uint _buffer; // renderer specific copy of _vertices, 0 if none
+
+private:
+	Renderer *_renderer;
+};
+
 class Renderer {
 public:
 	Renderer(int screenW, int screenH, Common::RenderMode renderMode);
@@ -90,6 +116,15 @@ public:
 	virtual void renderPyramid(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours, int type);
 	virtual void renderFace(const Common::Array<Math::Vector3d> &vertices) = 0;
 
+	/**
+	 * Record the faces emitted by the render* functions above into
+	 * geometry instead of drawing them.
+	 */
+	void beginGeometry(ObjectGeometry *geometry);
+	void endGeometry();
+	void renderGeometry(ObjectGeometry *geometry, Common::Array<uint8> *colours);
+	virtual void freeGeometry(ObjectGeometry *geometry) {}
+
 	void setColorRemaps(ColorReMap *colorRemaps);
 	virtual void clear(uint8 r, uint8 g, uint8 b) = 0;
 	virtual void drawFloor(uint8 color) = 0;
@@ -160,6 +195,19 @@ protected:
 	Math::Frustum _frustum;
 
 	Math::Matrix4 makeProjectionMatrix(float fov, float nearClipPlane, float farClipPlane) const;
+
+	/**
+	 * Draw a single recorded face. Renderers can override this to draw
+	 * straight from the retained vertices.
+	 */
+	virtual void renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face);
+
+private:
+	void renderColouredFace(Common::Array<uint8> *colours, uint slot, const Common::Array<Math::Vector3d> &face);
+	void recordFace(uint slot, const Common::Array<Math::Vector3d> &face);
+	void useObjectPolygonOffset(bool enabled);
+
+	ObjectGeometry *_recordedGeometry;
 };
 
 Graphics::RendererType determinateRenderType();
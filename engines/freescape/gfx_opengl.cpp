@@ -271,6 +271,18 @@ void OpenGLRenderer::renderFace(const Common::Array<Math::Vector3d> &vertices) {
 	glDisableClientState(GL_VERTEX_ARRAY);
 }
 
+void OpenGLRenderer::renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face) {
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, geometry->_vertices.data());
+	if (face.lines) {
+		glLineWidth(MAX(1, g_system->getWidth() / 192));
+		glDrawArrays(GL_LINES, face.first, face.count);
+		glLineWidth(1);
+	} else
+		glDrawArrays(GL_TRIANGLES, face.first, face.count);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
 void OpenGLRenderer::polygonOffset(bool enabled) {
 	if (enabled) {
 		glEnable(GL_POLYGON_OFFSET_FILL);
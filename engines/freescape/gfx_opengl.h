@@ -101,6 +101,7 @@ public:
 	virtual void renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d player, const Common::Rect viewPort) override;
 	virtual void renderPlayerShoot(byte color, const Common::Point position, const Common::Rect viewPort) override;
 	virtual void renderFace(const Common::Array<Math::Vector3d> &vertices) override;
+	virtual void renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face) override;
 
 	virtual void flipBuffer() override;
 	virtual void drawFloor(uint8 color) override;
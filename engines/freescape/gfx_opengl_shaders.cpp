@@ -277,6 +277,31 @@ void OpenGLShaderRenderer::renderFace(const Common::Array<Math::Vector3d> &verti
 	glDrawArrays(GL_TRIANGLES, 0, vi + 3);
 }
 
+void OpenGLShaderRenderer::renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face) {
+	// The vertices only change when the object moves, and then the whole
+	// geometry is recorded again, so they are uploaded once
+	if (!geometry->_buffer)
+		geometry->_buffer = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, geometry->_vertices.size() * sizeof(float), geometry->_vertices.data(), GL_STATIC_DRAW);
+
+	_triangleShader->use();
+	_triangleShader->setUniform("mvpMatrix", _mvpMatrix);
+
+	glBindBuffer(GL_ARRAY_BUFFER, geometry->_buffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+	if (face.lines) {
+		glLineWidth(MAX(1, g_system->getWidth() / 192));
+		glDrawArrays(GL_LINES, face.first, face.count);
+		glLineWidth(1);
+	} else
+		glDrawArrays(GL_TRIANGLES, face.first, face.count);
+}
+
+void OpenGLShaderRenderer::freeGeometry(ObjectGeometry *geometry) {
+	if (geometry->_buffer)
+		OpenGL::Shader::freeBuffer(geometry->_buffer);
+	geometry->_buffer = 0;
+}
+
 void OpenGLShaderRenderer::polygonOffset(bool enabled) {
 	if (enabled) {
 		glEnable(GL_POLYGON_OFFSET_FILL);
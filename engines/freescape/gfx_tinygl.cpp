@@ -63,6 +63,7 @@ void TinyGLRenderer::init() {
 	computeScreenViewport();
 
 	TinyGL::createContext(_screenW, _screenH, g_system->getScreenFormat(), 512, true, ConfMan.getBool("dirtyrects"));
+	TinyGL::enableTiledRendering(ConfMan.getBool("tinygltiles"));
 
 	tglMatrixMode(TGL_PROJECTION);
 	tglLoadIdentity();
@@ -199,6 +200,13 @@ void TinyGLRenderer::renderFace(const Common::Array<Math::Vector3d> &vertices) {
 	tglDisableClientState(TGL_VERTEX_ARRAY);
 }
 
+void TinyGLRenderer::renderGeometryFace(ObjectGeometry *geometry, const ObjectGeometry::Face &face) {
+	tglEnableClientState(TGL_VERTEX_ARRAY);
+	tglVertexPointer(3, TGL_FLOAT, 0, geometry->_vertices.data());
+	tglDrawArrays(face.lines ? TGL_LINES : TGL_TRIANGLES, face.first, face.count);
+	tglDisableClientState(TGL_VERTEX_ARRAY);
+}
+
 void TinyGLRenderer::polygonOffset(bool enabled) {
 	if (enabled) {
 		tglEnable(TGL_POLYGON_OFFSET_FILL);
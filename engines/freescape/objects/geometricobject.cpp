@@ -146,6 +146,7 @@ GeometricObject::GeometricObject(
 
 	if (ordinates_)
 		_ordinates = ordinates_;
+	_geometry = nullptr;
 	_condition = conditionInstructions_;
 	_conditionSource = conditionSource_;
 
@@ -171,6 +172,9 @@ GeometricObject::GeometricObject(
 }
 
 void GeometricObject::setOrigin(Math::Vector3d origin_) {
+	if (origin_ != _origin)
+		invalidateGeometry();
+
 	if (isPolygon(_type)) {
 		Math::Vector3d offset = origin_ - _origin;
 		offset = 32 * offset;
@@ -186,6 +190,7 @@ void GeometricObject::setOrigin(Math::Vector3d origin_) {
 }
 
 void GeometricObject::scale(int factor) {
+	invalidateGeometry();
 	_origin = _origin / factor;
 	_size = _size / factor;
 	if (_ordinates) {
@@ -363,6 +368,7 @@ void GeometricObject::computeBoundingBox() {
 }
 
 GeometricObject::~GeometricObject() {
+	delete _geometry;
 	delete _colours;
 	delete _ordinates;
 }
@@ -380,7 +386,23 @@ bool GeometricObject::collides(const Math::AABB &boundingBox_) {
 	return _boundingBox.collides(boundingBox_);
 }
 
+void GeometricObject::invalidateGeometry() {
+	delete _geometry;
+	_geometry = nullptr;
+}
+
 void GeometricObject::draw(Freescape::Renderer *gfx) {
+	if (!_geometry) {
+		_geometry = new ObjectGeometry(gfx);
+		gfx->beginGeometry(_geometry);
+		renderFaces(gfx);
+		gfx->endGeometry();
+	}
+
+	gfx->renderGeometry(_geometry, _colours);
+}
+
+void GeometricObject::renderFaces(Freescape::Renderer *gfx) {
 	if (this->getType() == kCubeType) {
 		gfx->renderCube(_origin, _size, _colours);
 	} else if (this->getType() == kRectangleType) {
@@ -62,8 +62,12 @@ public:
 	FCLInstructionVector _condition;
 
 private:
+	void renderFaces(Freescape::Renderer *gfx);
+	void invalidateGeometry();
+
 	Common::Array<uint8> *_colours;
 	Common::Array<uint16> *_ordinates;
+	ObjectGeometry *_geometry; // faces retained between frames, rebuilt when the object moves
 };
 
 } // End of namespace Freescape
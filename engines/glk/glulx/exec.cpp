@@ -38,7 +38,11 @@ void Glulx::execute_loop() {
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
 
-	while (!done_executing && !g_vm->shouldQuit()) {
+	/* Checking for the engine quitting goes through the event manager, which
+	   is too costly to do for every opcode. */
+	uint quit_poll = 0;
+
+	while (!done_executing && (++quit_poll % QUIT_POLL_INTERVAL != 0 || !g_vm->shouldQuit())) {
 
 		profile_tick();
 		debugger_tick();
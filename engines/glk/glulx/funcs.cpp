@@ -44,6 +44,30 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 
 	profile_in(addr, stackptr, false);
 
+	/* Bump the frameptr to the top. */
+	frameptr = stackptr;
+
+	Common::HashMap<uint, funcheader_t>::const_iterator cached = funcheader_cache.end();
+	if (addr < ramstart)
+		cached = funcheader_cache.find(addr);
+	if (cached != funcheader_cache.end()) {
+		/* We've called this function before, so just copy its locals-format
+		   list to the call frame. */
+		const funcheader_t &header = cached->_value;
+		functype = header.functype;
+		locallen = header.locallen;
+		addr++;
+
+		for (jx = 0; jx < header.formatlen; jx++)
+			StkW1(frameptr + 8 + jx, Mem1(addr + jx));
+		for (; jx < header.framelen; jx++)
+			StkW1(frameptr + 8 + jx, 0);
+
+		ix = header.framelen / 2;
+		addr += header.formatlen;
+		goto FrameBuilt;
+	}
+
 	/* Check the Glulx type identifier byte. */
 	functype = Mem1(addr);
 	if (functype != 0xC0 && functype != 0xC1) {
@@ -54,9 +78,6 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 	}
 	addr++;
 
-	/* Bump the frameptr to the top. */
-	frameptr = stackptr;
-
 	/* Go through the function's locals-format list, copying it to the
 	   call frame. At the same time, we work out how much space the locals
 	   will actually take up. (Including padding.) */
@@ -109,6 +130,15 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 	while (locallen & 3)
 		locallen++;
 
+	if (funcaddr < ramstart) {
+		funcheader_t &header = funcheader_cache[funcaddr];
+		header.functype = functype;
+		header.formatlen = addr - (funcaddr + 1);
+		header.framelen = 2 * ix;
+		header.locallen = locallen;
+	}
+
+FrameBuilt:
 	/* We now know how long the locals-frame and locals segments are. */
 	localsbase = frameptr + 8 + 2 * ix;
 	valstackbase = localsbase + locallen;
@@ -25,6 +25,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -106,6 +107,19 @@ private:
 
 	/**@}*/
 
+	/**
+	 * \defgroup funcs fields
+	 * @{
+	 */
+
+	/**
+	 * Decoded headers of the functions called so far. Only functions in ROM are
+	 * cached, since those can't change while the game runs.
+	 */
+	Common::HashMap<uint, funcheader_t> funcheader_cache;
+
+	/**@}*/
+
 	/**
 	 * \defgroup heap fields
 	 * @{
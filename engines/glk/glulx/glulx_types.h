@@ -363,6 +363,23 @@ typedef accelentry_struct accelentry_t;
 
 #define ACCEL_HASH_SIZE (511)
 
+/**
+ * The decoded header of a function in ROM, so that calls to it don't have
+ * to walk the locals-format list again.
+ */
+struct funcheader_struct {
+	int functype;
+	uint formatlen;     ///< bytes of locals-format list in the game file
+	uint framelen;      ///< bytes of locals-format list in the call frame, padded
+	int locallen;       ///< bytes of locals, padded
+};
+typedef funcheader_struct funcheader_t;
+
+/**
+ * Number of opcodes executed between checks for the engine quitting
+ */
+#define QUIT_POLL_INTERVAL (0x400)
+
 struct heapblock_struct {
 	uint addr;
 	uint len;
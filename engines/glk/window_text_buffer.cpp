@@ -819,6 +819,7 @@ void TextBufferWindow::redraw() {
 	int selrow, selchar, sx0, sx1, selleft, selright;
 	bool selBuf;
 	int tx, tsc, tsw, lsc, rsc;
+	TextBufferRow selLine;
 	Screen &screen = *g_vm->_screen;
 
 	gli_tts_flush();
@@ -856,7 +857,11 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
+		// only a selected line needs a copy, to reverse its selected characters in
+		const bool selCopy = selrow && !Windows::_claimSelect;
+		if (selCopy)
+			selLine = _lines[i];
+		TextBufferRow &ln = selCopy ? selLine : _lines[i];
 
 		// skip if we can
 		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
@@ -1087,7 +1092,7 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1549,11 +1554,11 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	_lines.rotate();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1565,6 +1570,7 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 		_ladjw = 0;
 
 	touch(0);
+	_lines[0]._repaint = false;
 	_lines[0]._len = 0;
 	_lines[0]._newLine = 0;
 	_lines[0]._lm = _ladjw;
@@ -52,7 +52,51 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window and its scrollback, most recent first. Scrolling
+	 * rotates the oldest row round to the front, rather than copying every
+	 * row of the scrollback down by one.
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		/**
+		 * Set the number of rows. Should only be used when the rows are empty
+		 */
+		void resize(uint count) {
+			assert(_first == 0);
+			_rows.resize(count);
+		}
+
+		/**
+		 * Remove all the rows
+		 */
+		void clear() {
+			_rows.clear();
+			_first = 0;
+		}
+
+		/**
+		 * Moves the oldest row to the front, shifting all the others back by one
+		 */
+		void rotate() {
+			_first = (_first == 0 ? _rows.size() : _first) - 1;
+		}
+
+		TextBufferRow &operator[](uint idx) {
+			idx += _first;
+			return _rows[idx < _rows.size() ? idx : idx - _rows.size()];
+		}
+		const TextBufferRow &operator[](uint idx) const {
+			idx += _first;
+			return _rows[idx < _rows.size() ? idx : idx - _rows.size()];
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -42,6 +42,15 @@
 
 namespace Grim {
 
+// Grim meshes are static in model space, so their faces are unrolled once
+// into an interleaved array and drawn with tglDrawArrays instead of
+// passing every vertex through the immediate mode API each frame.
+struct TinyGLMeshVertex {
+	float _position[3];
+	float _texcoord[2];
+	float _normal[3];
+};
+
 GfxBase *CreateGfxTinyGL() {
 	return new GfxTinyGL();
 }
@@ -86,6 +95,7 @@ void GfxTinyGL::setupScreen(int screenW, int screenH) {
 	_pixelFormat = g_system->getScreenFormat();
 	debug(2, "INFO: TinyGL front buffer pixel format: %s", _pixelFormat.toString().c_str());
 	TinyGL::createContext(screenW, screenH, _pixelFormat, 256, true, ConfMan.getBool("dirtyrects"));
+	TinyGL::enableTiledRendering(ConfMan.getBool("tinygltiles"));
 
 	_storedDisplay = new Graphics::Surface;
 	_storedDisplay->create(_gameWidth, _gameHeight, _pixelFormat);
@@ -695,6 +705,25 @@ void GfxTinyGL::drawModelFace(const Mesh *mesh, const MeshFace *face) {
 	tglAlphaFunc(TGL_GREATER, 0.5);
 	tglEnable(TGL_ALPHA_TEST);
 	tglNormal3fv(const_cast<float *>(face->getNormal().getData()));
+
+	const TinyGLMeshVertex *meshInfo = (const TinyGLMeshVertex *)mesh->_userData;
+	if (meshInfo && face->_userData) {
+		tglEnableClientState(TGL_VERTEX_ARRAY);
+		tglEnableClientState(TGL_NORMAL_ARRAY);
+		tglVertexPointer(3, TGL_FLOAT, sizeof(TinyGLMeshVertex), meshInfo->_position);
+		tglNormalPointer(TGL_FLOAT, sizeof(TinyGLMeshVertex), meshInfo->_normal);
+		if (face->hasTexture()) {
+			tglEnableClientState(TGL_TEXTURE_COORD_ARRAY);
+			tglTexCoordPointer(2, TGL_FLOAT, sizeof(TinyGLMeshVertex), meshInfo->_texcoord);
+		}
+		tglDrawArrays(TGL_POLYGON, *(uint32 *)face->_userData, face->getNumVertices());
+		tglDisableClientState(TGL_VERTEX_ARRAY);
+		tglDisableClientState(TGL_NORMAL_ARRAY);
+		tglDisableClientState(TGL_TEXTURE_COORD_ARRAY);
+		tglDisable(TGL_ALPHA_TEST);
+		return;
+	}
+
 	tglBegin(TGL_POLYGON);
 	for (int i = 0; i < face->getNumVertices(); i++) {
 		tglNormal3fv(vertNormals + 3 * face->getVertex(i));
@@ -1141,6 +1170,47 @@ void GfxTinyGL::createTexture(Texture *texture, const uint8 *data, const CMap *c
 	delete[] texdata;
 }
 
+void GfxTinyGL::createMesh(Mesh *mesh) {
+	int numVertices = 0;
+	for (int i = 0; i < mesh->_numFaces; ++i)
+		numVertices += mesh->_faces[i].getNumVertices();
+
+	if (numVertices == 0) {
+		mesh->_userData = nullptr;
+		return;
+	}
+
+	TinyGLMeshVertex *meshInfo = new TinyGLMeshVertex[numVertices];
+	uint32 pos = 0;
+	for (int i = 0; i < mesh->_numFaces; ++i) {
+		MeshFace *face = &mesh->_faces[i];
+		face->_userData = new uint32;
+		*(uint32 *)face->_userData = pos;
+
+		for (int j = 0; j < face->getNumVertices(); ++j, ++pos) {
+			TinyGLMeshVertex &v = meshInfo[pos];
+			memcpy(v._position, mesh->_vertices + 3 * face->getVertex(j), 3 * sizeof(float));
+			memcpy(v._normal, mesh->_vertNormals + 3 * face->getVertex(j), 3 * sizeof(float));
+			if (face->hasTexture())
+				memcpy(v._texcoord, mesh->_textureVerts + 2 * face->getTextureVertex(j), 2 * sizeof(float));
+			else
+				v._texcoord[0] = v._texcoord[1] = 0.f;
+		}
+	}
+
+	mesh->_userData = meshInfo;
+}
+
+void GfxTinyGL::destroyMesh(const Mesh *mesh) {
+	for (int i = 0; i < mesh->_numFaces; ++i) {
+		MeshFace *face = &mesh->_faces[i];
+		delete static_cast<uint32 *>(face->_userData);
+		face->_userData = nullptr;
+	}
+
+	delete[] static_cast<TinyGLMeshVertex *>(mesh->_userData);
+}
+
 void GfxTinyGL::selectTexture(const Texture *texture) {
 	TGLuint *textures = (TGLuint *)texture->_texture;
 	tglBindTexture(TGL_TEXTURE_2D, textures[0]);
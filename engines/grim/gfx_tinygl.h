@@ -84,6 +84,9 @@ public:
 	void drawModelFace(const Mesh *mesh, const MeshFace *face) override;
 	void drawSprite(const Sprite *sprite) override;
 
+	void createMesh(Mesh *mesh) override;
+	void destroyMesh(const Mesh *mesh) override;
+
 	void enableLights() override;
 	void disableLights() override;
 	void setupLight(Light *light, int lightId) override;
@@ -39,6 +39,7 @@ Common::SeekableReadStream *LabEntry::createReadStream() const {
 
 Lab::Lab() {
 	_stream = nullptr;
+	_streamInMemory = false;
 }
 
 Lab::~Lab() {
@@ -66,6 +67,10 @@ bool Lab::open(const Common::String &filename, bool keepStream) {
 		byte *data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
 		file->read(data, file->size());
 		_stream = new Common::MemoryReadStream(data, file->size(), DisposeAfterUse::YES);
+		_streamInMemory = true;
+	} else if (result) {
+		_stream = file;
+		return result;
 	}
 	delete file;
 
@@ -146,9 +151,7 @@ void Lab::parseMonkey4FileTable(Common::File *file) {
 }
 
 bool Lab::hasFile(const Common::Path &filename) const {
-	Common::String fname(filename.toString());
-	fname.toLowercase();
-	return _entries.contains(fname);
+	return _entries.contains(filename.toString());
 }
 
 int Lab::listMembers(Common::ArchiveMemberList &list) const {
@@ -163,25 +166,22 @@ int Lab::listMembers(Common::ArchiveMemberList &list) const {
 }
 
 const Common::ArchiveMemberPtr Lab::getMember(const Common::Path &path) const {
-	Common::String name = path.toString();
-	if (!hasFile(name))
+	LabMap::const_iterator i = _entries.find(path.toString());
+	if (i == _entries.end())
 		return Common::ArchiveMemberPtr();
 
-	Common::String fname(name);
-	fname.toLowercase();
-	return _entries[fname];
+	return i->_value;
 }
 
 Common::SeekableReadStream *Lab::createReadStreamForMember(const Common::Path &path) const {
-	Common::String filename = path.toString();
-	if (!hasFile(filename))
+	LabMap::const_iterator it = _entries.find(path.toString());
+	if (it == _entries.end())
 		return nullptr;
 
-	Common::String fname(filename);
-	fname.toLowercase();
-	LabEntryPtr i = _entries[fname];
+	const LabEntryPtr &i = it->_value;
 
-	if (!_stream) {
+	if (!_stream || (!_streamInMemory && i->_len > kMaxBufferedMemberSize)) {
+		// Big members, like music and videos, are streamed through their own handle
 		Common::File *file = new Common::File();
 		file->open(_labFileName);
 		return new Common::SeekableSubReadStream(file, i->_offset, i->_offset + i->_len, DisposeAfterUse::YES);
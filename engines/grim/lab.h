@@ -55,6 +55,12 @@ public:
 	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override;
 
 private:
+	/**
+	 * Members up to this size are read in one go through the lab's own
+	 * file handle, instead of opening the lab again for each of them.
+	 */
+	static const uint32 kMaxBufferedMemberSize = 256 * 1024;
+
 	void parseGrimFileTable(Common::File *_f);
 	void parseMonkey4FileTable(Common::File *_f);
 
@@ -62,7 +68,9 @@ private:
 	typedef Common::SharedPtr<LabEntry> LabEntryPtr;
 	typedef Common::HashMap<Common::String, LabEntryPtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> LabMap;
 	LabMap _entries;
+	// Either the whole lab in memory (keepStream) or its open file handle
 	Common::SeekableReadStream *_stream;
+	bool _streamInMemory;
 };
 
 } // end of namespace Grim
@@ -72,8 +72,8 @@ public:
 };
 
 ResourceLoader::ResourceLoader() {
-	_cacheDirty = false;
 	_cacheMemorySize = 0;
+	_cacheClock = 0;
 
 	Lab *l;
 	Common::ArchiveMemberList files, updFiles;
@@ -218,6 +218,10 @@ ResourceLoader::ResourceLoader() {
 	}
 
 	files.clear();
+
+	// The set of archives is fixed from now on, so remember where each
+	// looked up file lives instead of querying every lab again.
+	SearchMan.setCacheLookups(true);
 }
 
 template<typename T>
@@ -230,11 +234,9 @@ void clearList(Common::List<T> &list) {
 }
 
 ResourceLoader::~ResourceLoader() {
-	for (Common::Array<ResourceCache>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
-		ResourceCache &r = *i;
-		delete[] r.fname;
-		delete[] r.resPtr;
-	}
+	SearchMan.setCacheLookups(false);
+	printCacheStats();
+	_cache.clear();
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
@@ -242,38 +244,18 @@ ResourceLoader::~ResourceLoader() {
 	MD5Check::clear();
 }
 
-static int sortCallback(const void *entry1, const void *entry2) {
-	return scumm_stricmp(((const ResourceLoader::ResourceCache *)entry1)->fname, ((const ResourceLoader::ResourceCache *)entry2)->fname);
-}
-
 Common::SeekableReadStream *ResourceLoader::getFileFromCache(const Common::String &filename) const {
-	ResourceLoader::ResourceCache *entry = getEntryFromCache(filename);
-	if (!entry)
-		return nullptr;
-
-	return new Common::MemoryReadStream(entry->resPtr, entry->len);
-}
-
-ResourceLoader::ResourceCache *ResourceLoader::getEntryFromCache(const Common::String &filename) const {
-	if (_cache.empty())
+	ResourceCacheMap::iterator entry = _cache.find(filename);
+	if (entry == _cache.end())
 		return nullptr;
 
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	ResourceCache key;
-	key.fname = const_cast<char *>(filename.c_str());
-
-	return (ResourceLoader::ResourceCache *)bsearch(&key, _cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
+	entry->_value.lastUse = ++_cacheClock;
+	return new Common::MemoryReadStream(entry->_value.resPtr, entry->_value.len);
 }
 
 Common::SeekableReadStream *ResourceLoader::loadFile(const Common::String &filename) const {
-	Common::SeekableReadStream *rs = nullptr;
-	if (SearchMan.hasFile(filename))
-		rs = SearchMan.createReadStreamForMember(filename);
-	else
+	Common::SeekableReadStream *rs = SearchMan.createReadStreamForMember(filename);
+	if (!rs)
 		return nullptr;
 
 	rs = wrapPatchedFile(rs, filename);
@@ -286,14 +268,17 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 
 	if (cache) {
 		s = getFileFromCache(fname);
-		if (!s) {
+		if (s) {
+			getCacheStats(fname).hits++;
+		} else {
 			s = loadFile(fname);
 			if (!s)
 				return nullptr;
 
+			getCacheStats(fname).misses++;
 			uint32 size = s->size();
-			byte *buf = new byte[size];
-			s->read(buf, size);
+			Common::SharedPtr<byte> buf(new byte[size], Common::ArrayDeleter<byte>());
+			s->read(buf.get(), size);
 			putIntoCache(fname, buf, size);
 			delete s;
 			s = new Common::MemoryReadStream(buf, size);
@@ -305,15 +290,45 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 	return Common::wrapCompressedReadStream(s);
 }
 
-void ResourceLoader::putIntoCache(const Common::String &fname, byte *res, uint32 len) const {
-	ResourceCache entry;
+void ResourceLoader::putIntoCache(const Common::String &fname, const Common::SharedPtr<byte> &res, uint32 len) const {
+	// Files bigger than the whole budget are handed out uncached
+	if (len > kCacheMemoryBudget)
+		return;
+
+	evictFromCache(len);
+
+	ResourceCache &entry = _cache[fname];
 	entry.resPtr = res;
 	entry.len = len;
-	entry.fname = new char[fname.size() + 1];
-	Common::strcpy_s(entry.fname, fname.size() + 1, fname.c_str());
+	entry.lastUse = ++_cacheClock;
 	_cacheMemorySize += len;
-	_cache.push_back(entry);
-	_cacheDirty = true;
+}
+
+void ResourceLoader::evictFromCache(uint32 len) const {
+	while (!_cache.empty() && _cacheMemorySize + len > kCacheMemoryBudget) {
+		ResourceCacheMap::iterator oldest = _cache.begin();
+		for (ResourceCacheMap::iterator i = _cache.begin(); i != _cache.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		getCacheStats(oldest->_key).evictions++;
+		_cacheMemorySize -= oldest->_value.len;
+		_cache.erase(oldest);
+	}
+}
+
+ResourceLoader::ResourceCacheStats &ResourceLoader::getCacheStats(const Common::String &fname) const {
+	const char *ext = strrchr(fname.c_str(), '.');
+	return _cacheStats[ext ? ext + 1 : ""];
+}
+
+void ResourceLoader::printCacheStats() const {
+	Debug::debug(Debug::Engine, "File cache: %d files, %d bytes", _cache.size(), _cacheMemorySize);
+	for (ResourceCacheStatsMap::const_iterator i = _cacheStats.begin(); i != _cacheStats.end(); ++i) {
+		const ResourceCacheStats &stats = i->_value;
+		Debug::debug(Debug::Engine, "  %-5s hits: %d misses: %d evictions: %d", i->_key.c_str(), stats.hits, stats.misses, stats.evictions);
+	}
 }
 
 CMap *ResourceLoader::loadColormap(const Common::String &filename) {
@@ -575,19 +590,10 @@ void ResourceLoader::uncache(const char *filename) const {
 	Common::String fname = filename;
 	fname.toLowercase();
 
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	for (unsigned int i = 0; i < _cache.size(); i++) {
-		if (fname.compareTo(_cache[i].fname) == 0) {
-			delete[] _cache[i].fname;
-			_cacheMemorySize -= _cache[i].len;
-			delete[] _cache[i].resPtr;
-			_cache.remove_at(i);
-			_cacheDirty = true;
-		}
+	ResourceCacheMap::iterator i = _cache.find(fname);
+	if (i != _cache.end()) {
+		_cacheMemorySize -= i->_value.len;
+		_cache.erase(i);
 	}
 }
 
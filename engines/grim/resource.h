@@ -24,6 +24,8 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
 
 #include "engines/grim/object.h"
 
@@ -86,23 +88,40 @@ public:
 	void uncacheAnimationEmi(AnimationEmi *a);
 
 	struct ResourceCache {
-		char *fname;
-		byte *resPtr;
+		// Shared with the streams handed out, so evicting an entry never
+		// pulls the data from under a reader
+		Common::SharedPtr<byte> resPtr;
 		uint32 len;
+		uint32 lastUse;
+	};
+
+	struct ResourceCacheStats {
+		uint32 hits, misses, evictions;
+		ResourceCacheStats() : hits(0), misses(0), evictions(0) {}
 	};
 
 	static Common::String fixFilename(const Common::String &filename, bool append = true);
 
+	/** Print the hit statistics of the file cache, per file extension. */
+	void printCacheStats() const;
+
 private:
+	/** Least recently used files are dropped once the cache grows past this. */
+	static const uint32 kCacheMemoryBudget = 32 * 1024 * 1024;
+
 	Common::SeekableReadStream *loadFile(const Common::String &filename) const;
 	Common::SeekableReadStream *getFileFromCache(const Common::String &filename) const;
-	ResourceLoader::ResourceCache *getEntryFromCache(const Common::String &filename) const;
-	void putIntoCache(const Common::String &fname, byte *res, uint32 len) const;
+	void putIntoCache(const Common::String &fname, const Common::SharedPtr<byte> &res, uint32 len) const;
+	void evictFromCache(uint32 len) const;
 	void uncache(const char *fname) const;
-
-	mutable Common::Array<ResourceCache> _cache;
-	mutable bool _cacheDirty;
-	mutable int32 _cacheMemorySize;
+	ResourceCacheStats &getCacheStats(const Common::String &fname) const;
+
+	typedef Common::HashMap<Common::String, ResourceCache> ResourceCacheMap;
+	typedef Common::HashMap<Common::String, ResourceCacheStats> ResourceCacheStatsMap;
+	mutable ResourceCacheMap _cache;
+	mutable ResourceCacheStatsMap _cacheStats;
+	mutable uint32 _cacheMemorySize;
+	mutable uint32 _cacheClock;
 
 	Common::List<EMIModel *> _emiModels;
 	Common::List<Model *> _models;
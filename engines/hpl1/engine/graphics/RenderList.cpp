@@ -41,26 +41,14 @@ namespace hpl {
 int cRenderList::mlGlobalRenderCount = 0;
 
 //////////////////////////////////////////////////////////////////////////
-// MOTION BLUR OBJECT COMPARE
+// SORT KEYS
 //////////////////////////////////////////////////////////////////////////
 
-bool cMotionBlurObject_Compare::operator()(iRenderable *pObjectA,
-										   iRenderable *pObjectB) const {
-	// TODO: perhaps Z here...
-
-	return pObjectA->GetVertexBuffer() < pObjectB->GetVertexBuffer();
-}
-
-//////////////////////////////////////////////////////////////////////////
-// TRANSPERANT OBJECT COMPARE
-//////////////////////////////////////////////////////////////////////////
-
-bool cTransperantObject_Compare::operator()(iRenderable *pObjectA, iRenderable *pObjectB) const {
-	if (pObjectA->GetMaterial()->GetDepthTest() != pObjectA->GetMaterial()->GetDepthTest()) {
-		return pObjectA->GetMaterial()->GetDepthTest() < pObjectA->GetMaterial()->GetDepthTest();
-	}
-
-	return pObjectA->GetZ() < pObjectB->GetZ();
+// Maps a float onto an unsigned int with the same ordering.
+static inline uint32 floatSortKey(float afValue) {
+	uint32 lBits;
+	memcpy(&lBits, &afValue, sizeof(lBits));
+	return (lBits & 0x80000000) ? ~lBits : (lBits | 0x80000000);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -172,8 +160,8 @@ void cRenderList::Clear() {
 	m_setLights.clear();
 	m_setObjects.clear();
 	m_setQueries.clear();
-	m_setMotionBlurObjects.clear();
-	m_setTransperantObjects.clear();
+	mvMotionBlurObjects.clear();
+	mvTransperantObjects.clear();
 
 	mRootNodeDepth.DeleteChildren();
 	mRootNodeDiffuse.DeleteChildren();
@@ -202,13 +190,13 @@ cOcclusionQueryObjectIterator cRenderList::GetQueryIterator() {
 //-----------------------------------------------------------------------
 
 cMotionBlurObjectIterator cRenderList::GetMotionBlurIterator() {
-	return cMotionBlurObjectIterator(&m_setMotionBlurObjects);
+	return cMotionBlurObjectIterator(&mvMotionBlurObjects);
 }
 
 //-----------------------------------------------------------------------
 
 cTransperantObjectIterator cRenderList::GetTransperantIterator() {
-	return cTransperantObjectIterator(&m_setTransperantObjects);
+	return cTransperantObjectIterator(&mvTransperantObjects);
 }
 
 //-----------------------------------------------------------------------
@@ -271,8 +259,8 @@ void cRenderList::Compile() {
 
 		// If the object is transparent add tot eh trans tree
 		if (pMat->IsTransperant()) {
-			// Use the set cotainer instead for now:
-			m_setTransperantObjects.insert(pObject);
+			// Use the sorted array instead for now:
+			mvTransperantObjects.push_back(pObject);
 			/*for(int lPass=0; lPass< pMat->GetNumOfPasses(eMaterialRenderType_Diffuse, NULL);lPass++)
 			{
 				AddToTree(pObject,eRenderListDrawType_Trans,
@@ -323,6 +311,11 @@ void cRenderList::Compile() {
 			}
 		}
 	}
+
+	// Transparent objects are drawn back to front, motion blur objects are
+	// grouped by vertex buffer.
+	SortObjects(mvTransperantObjects, true);
+	SortObjects(mvMotionBlurObjects, false);
 }
 
 //-----------------------------------------------------------------------
@@ -368,7 +361,7 @@ bool cRenderList::Add(iRenderable *apObject) {
 
 			// MotionBlur
 			if (mpGraphics->GetRendererPostEffects()->GetMotionBlurActive() || mpGraphics->GetRenderer3D()->GetRenderSettings()->mbFogActive || mpGraphics->GetRendererPostEffects()->GetDepthOfFieldActive()) {
-				m_setMotionBlurObjects.insert(apObject);
+				mvMotionBlurObjects.push_back(apObject);
 
 				if (apObject->GetPrevRenderCount() != GetLastRenderCount()) {
 					cMatrixf *pMtx = apObject->GetModelMatrix(mpCamera);
@@ -452,6 +445,55 @@ cRenderNode *cRenderList::InsertNode(cRenderNode *apListNode, cRenderNode *apTem
 
 //-----------------------------------------------------------------------
 
+void cRenderList::SortObjects(tSortedRenderableVec &avObjects, bool abByZ) {
+	const uint lCount = avObjects.size();
+	if (lCount < 2)
+		return;
+
+	mvSortEntries.resize(lCount);
+	mvSortTemp.resize(lCount);
+
+	uint64 lDiffBits = 0;
+	for (uint i = 0; i < lCount; ++i) {
+		iRenderable *pObject = avObjects[i];
+		uint64 lKey = abByZ ? floatSortKey(pObject->GetZ()) : (uint64)(uintptr)pObject->GetVertexBuffer();
+
+		mvSortEntries[i].mlKey = lKey;
+		mvSortEntries[i].mpObject = pObject;
+		lDiffBits |= lKey ^ mvSortEntries[0].mlKey;
+	}
+
+	// Stable LSD radix sort, one byte per pass. Bytes that are the same
+	// for every key are skipped, so Z keys take at most four passes.
+	cRenderListSortEntry *pSrc = mvSortEntries.data();
+	cRenderListSortEntry *pDst = mvSortTemp.data();
+	for (int lShift = 0; lShift < 64; lShift += 8) {
+		if (((lDiffBits >> lShift) & 0xFF) == 0)
+			continue;
+
+		uint lOffsets[256] = {0};
+		for (uint i = 0; i < lCount; ++i)
+			++lOffsets[(pSrc[i].mlKey >> lShift) & 0xFF];
+
+		uint lTotal = 0;
+		for (int i = 0; i < 256; ++i) {
+			uint lNum = lOffsets[i];
+			lOffsets[i] = lTotal;
+			lTotal += lNum;
+		}
+
+		for (uint i = 0; i < lCount; ++i)
+			pDst[lOffsets[(pSrc[i].mlKey >> lShift) & 0xFF]++] = pSrc[i];
+
+		SWAP(pSrc, pDst);
+	}
+
+	for (uint i = 0; i < lCount; ++i)
+		avObjects[i] = pSrc[i].mpObject;
+}
+
+//-----------------------------------------------------------------------
+
 void cRenderList::AddToTree(iRenderable *apObject, eRenderListDrawType aObjectType,
 							eMaterialRenderType aPassType, int alLightNum, iLight3D *apLight,
 							bool abUseDepth, int alPass) {
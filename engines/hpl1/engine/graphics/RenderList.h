@@ -81,29 +81,24 @@ public:
 
 //-------------------------------------------------------------
 
-class cMotionBlurObject_Compare {
-public:
-	bool operator()(iRenderable *pObjectA, iRenderable *pObjectB) const;
-};
-
-typedef Hpl1::Std::multiset<iRenderable *, cMotionBlurObject_Compare> tMotionBlurObjectSet;
-typedef tMotionBlurObjectSet::iterator tMotionBlurObjectSetIt;
+// Motion blur and transparent objects are kept in plain arrays that are
+// radix sorted on a numeric key in Compile().
+typedef Common::Array<iRenderable *> tSortedRenderableVec;
+typedef tSortedRenderableVec::iterator tSortedRenderableVecIt;
 
-typedef cSTLIterator<iRenderable *, tMotionBlurObjectSet,
-					 tMotionBlurObjectSetIt>
+typedef cSTLIterator<iRenderable *, tSortedRenderableVec,
+					 tSortedRenderableVecIt>
 	cMotionBlurObjectIterator;
 
-//-------------------------------------------------------------
+typedef cSTLIterator<iRenderable *, tSortedRenderableVec, tSortedRenderableVecIt> cTransperantObjectIterator;
 
-class cTransperantObject_Compare {
+class cRenderListSortEntry {
 public:
-	bool operator()(iRenderable *pObjectA, iRenderable *pObjectB) const;
+	uint64 mlKey;
+	iRenderable *mpObject;
 };
 
-typedef Hpl1::Std::multiset<iRenderable *, cTransperantObject_Compare> tTransperantObjectSet;
-typedef tTransperantObjectSet::iterator tTransperantObjectSetIt;
-
-typedef cSTLIterator<iRenderable *, tTransperantObjectSet, tTransperantObjectSetIt> cTransperantObjectIterator;
+typedef Common::Array<cRenderListSortEntry> tRenderListSortEntryVec;
 
 //-------------------------------------------------------------
 
@@ -196,8 +191,12 @@ private:
 
 	tOcclusionQueryObjectSet m_setQueries;
 
-	tMotionBlurObjectSet m_setMotionBlurObjects;
-	tTransperantObjectSet m_setTransperantObjects;
+	tSortedRenderableVec mvMotionBlurObjects;
+	tSortedRenderableVec mvTransperantObjects;
+
+	void SortObjects(tSortedRenderableVec &avObjects, bool abByZ);
+	tRenderListSortEntryVec mvSortEntries;
+	tRenderListSortEntryVec mvSortTemp;
 
 	cRenderNode mRootNodeDepth;
 	cRenderNode mRootNodeDiffuse;
@@ -312,6 +312,7 @@ LowLevelGraphicsTGL::LowLevelGraphicsTGL() {
 	mvVirtualSize.y = 600;
 	mfGammaCorrection = 1.0;
 	mpRenderTarget = nullptr;
+	mpActiveQuery = nullptr;
 #ifdef SCUMM_BIG_ENDIAN
 	mpPixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
 #else
@@ -824,7 +825,7 @@ void LowLevelGraphicsTGL::DrawQuadMultiTex(const tVertexVec &avVtx, const tVecto
 //-----------------------------------------------------------------------
 
 iOcclusionQuery *LowLevelGraphicsTGL::CreateOcclusionQuery() {
-	return hplNew(OcclusionQueryTGL, ());
+	return hplNew(OcclusionQueryTGL, (this));
 }
 
 //-----------------------------------------------------------------------
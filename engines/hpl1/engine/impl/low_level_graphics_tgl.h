@@ -33,6 +33,8 @@
 
 namespace hpl {
 
+class OcclusionQueryTGL;
+
 TGLenum ColorFormatToTGL(eColorDataFormat format);
 
 TGLenum TextureTargetToTGL(eTextureTarget target);
@@ -102,6 +104,8 @@ public:
 	// OCCLUSION
 	iOcclusionQuery *CreateOcclusionQuery();
 	void DestroyOcclusionQuery(iOcclusionQuery *apQuery);
+	void SetActiveOcclusionQuery(OcclusionQueryTGL *apQuery) { mpActiveQuery = apQuery; }
+	OcclusionQueryTGL *GetActiveOcclusionQuery() { return mpActiveQuery; }
 
 	// CLEARING THE FRAMEBUFFER
 	void ClearScreen();
@@ -259,6 +263,9 @@ private:
 	// Texture
 	iTexture *mpCurrentTexture[MAX_TEXTUREUNITS];
 
+	// Occlusion query that vertex buffers report to instead of drawing.
+	OcclusionQueryTGL *mpActiveQuery;
+
 	// CG Compiler Variables
 	// CGcontext mCG_Context;
 
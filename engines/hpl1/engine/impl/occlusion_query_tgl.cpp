@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hpl1/engine/impl/occlusion_query_tgl.h"
+#include "hpl1/engine/impl/low_level_graphics_tgl.h"
+
+#include "graphics/tinygl/tinygl.h"
+
+#ifdef USE_TINYGL
+
+namespace hpl {
+
+//////////////////////////////////////////////////////////////////////////
+// CONSTRUCTORS
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+OcclusionQueryTGL::OcclusionQueryTGL(LowLevelGraphicsTGL *apLowLevelGraphics) {
+	mpLowLevelGraphics = apLowLevelGraphics;
+	mlSampleCount = 0;
+}
+
+//-----------------------------------------------------------------------
+
+OcclusionQueryTGL::~OcclusionQueryTGL() {
+	if (mpLowLevelGraphics->GetActiveOcclusionQuery() == this)
+		mpLowLevelGraphics->SetActiveOcclusionQuery(nullptr);
+}
+
+//-----------------------------------------------------------------------
+
+//////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::Begin() {
+	mlSampleCount = 0;
+	mpLowLevelGraphics->SetActiveOcclusionQuery(this);
+}
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::End() {
+	if (mpLowLevelGraphics->GetActiveOcclusionQuery() == this)
+		mpLowLevelGraphics->SetActiveOcclusionQuery(nullptr);
+}
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::AddBounds(const cVector3f &avMin, const cVector3f &avMax) {
+	// Matrices are column major.
+	float vModelView[16], vProjection[16], vMtx[16];
+	tglGetFloatv(TGL_MODELVIEW_MATRIX, vModelView);
+	tglGetFloatv(TGL_PROJECTION_MATRIX, vProjection);
+	for (int c = 0; c < 4; ++c) {
+		for (int r = 0; r < 4; ++r) {
+			vMtx[c * 4 + r] = vProjection[r] * vModelView[c * 4] + vProjection[4 + r] * vModelView[c * 4 + 1] +
+							  vProjection[8 + r] * vModelView[c * 4 + 2] + vProjection[12 + r] * vModelView[c * 4 + 3];
+		}
+	}
+
+	TGLint vViewport[4];
+	tglGetIntegerv(TGL_VIEWPORT, vViewport);
+
+	///////////////////////////////
+	// Project the corners to normalized device coordinates
+	float fMinX = 1, fMinY = 1, fMaxX = -1, fMaxY = -1;
+	bool bInFront = false;
+	for (int i = 0; i < 8; ++i) {
+		const float fX = (i & 1) ? avMax.x : avMin.x;
+		const float fY = (i & 2) ? avMax.y : avMin.y;
+		const float fZ = (i & 4) ? avMax.z : avMin.z;
+
+		const float fClipX = vMtx[0] * fX + vMtx[4] * fY + vMtx[8] * fZ + vMtx[12];
+		const float fClipY = vMtx[1] * fX + vMtx[5] * fY + vMtx[9] * fZ + vMtx[13];
+		const float fClipZ = vMtx[2] * fX + vMtx[6] * fY + vMtx[10] * fZ + vMtx[14];
+		const float fClipW = vMtx[3] * fX + vMtx[7] * fY + vMtx[11] * fZ + vMtx[15];
+
+		// A corner behind the eye makes the projection unbounded, so assume the
+		// whole viewport is covered.
+		if (fClipW <= 0) {
+			fMinX = fMinY = -1;
+			fMaxX = fMaxY = 1;
+			bInFront = true;
+			break;
+		}
+
+		if (fClipZ <= fClipW)
+			bInFront = true;
+
+		fMinX = MIN(fMinX, fClipX / fClipW);
+		fMaxX = MAX(fMaxX, fClipX / fClipW);
+		fMinY = MIN(fMinY, fClipY / fClipW);
+		fMaxY = MAX(fMaxY, fClipY / fClipW);
+	}
+
+	if (bInFront == false)
+		return;
+
+	fMinX = MAX(fMinX, -1.0f);
+	fMinY = MAX(fMinY, -1.0f);
+	fMaxX = MIN(fMaxX, 1.0f);
+	fMaxY = MIN(fMaxY, 1.0f);
+	if (fMinX >= fMaxX || fMinY >= fMaxY)
+		return;
+
+	const float fWidth = (fMaxX - fMinX) * 0.5f * vViewport[2];
+	const float fHeight = (fMaxY - fMinY) * 0.5f * vViewport[3];
+	mlSampleCount += (unsigned int)(fWidth * fHeight + 0.5f);
+}
+
+//-----------------------------------------------------------------------
+
+} // namespace hpl
+
+#endif // USE_TINYGL
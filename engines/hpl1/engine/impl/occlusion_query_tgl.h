@@ -24,20 +24,38 @@
 
 #include "common/scummsys.h"
 #include "hpl1/engine/graphics/OcclusionQuery.h"
+#include "hpl1/engine/math/MathTypes.h"
 
 #ifdef USE_TINYGL
 
 namespace hpl {
 
+class LowLevelGraphicsTGL;
+
+/**
+ * TinyGL has no hardware occlusion queries. While a query is active, vertex
+ * buffers are not drawn but report their bounds instead, and the sample count
+ * is the screen area the bounds cover. Nothing is ever treated as occluded.
+ */
 class OcclusionQueryTGL : public iOcclusionQuery {
 public:
-	OcclusionQueryTGL() {}
-	~OcclusionQueryTGL() {}
+	OcclusionQueryTGL(LowLevelGraphicsTGL *apLowLevelGraphics);
+	~OcclusionQueryTGL();
 
-	void Begin() override {}
-	void End() override {}
+	void Begin() override;
+	void End() override;
 	bool FetchResults() override { return true; }
-	unsigned int GetSampleCount() override { return 0; }
+	unsigned int GetSampleCount() override { return mlSampleCount; }
+
+	/**
+	 * Adds the pixels covered by a box given in model space, using the current
+	 * modelview and projection matrices.
+	 */
+	void AddBounds(const cVector3f &avMin, const cVector3f &avMax);
+
+private:
+	LowLevelGraphicsTGL *mpLowLevelGraphics;
+	unsigned int mlSampleCount;
 };
 
 } // namespace hpl
@@ -20,6 +20,8 @@
  */
 
 #include "hpl1/engine/impl/vertex_buffer_tgl.h"
+#include "hpl1/engine/impl/low_level_graphics_tgl.h"
+#include "hpl1/engine/impl/occlusion_query_tgl.h"
 #include "hpl1/engine/math/Math.h"
 #include "hpl1/engine/system/low_level_system.h"
 
@@ -213,6 +215,9 @@ void VertexBufferTGL::Transform(const cMatrixf &a_mtxTransform) {
 //-----------------------------------------------------------------------
 
 void VertexBufferTGL::Draw(eVertexBufferDrawType aDrawType) {
+	if (AddToOcclusionQuery())
+		return;
+
 	eVertexBufferDrawType drawType = aDrawType == eVertexBufferDrawType_LastEnum ? mDrawType : aDrawType;
 
 	///////////////////////////////
@@ -232,6 +237,9 @@ void VertexBufferTGL::Draw(eVertexBufferDrawType aDrawType) {
 
 void VertexBufferTGL::DrawIndices(unsigned int *apIndices, int alCount,
 								  eVertexBufferDrawType aDrawType) {
+	if (AddToOcclusionQuery())
+		return;
+
 	eVertexBufferDrawType drawType = aDrawType == eVertexBufferDrawType_LastEnum ? mDrawType : aDrawType;
 
 	///////////////////////////////
@@ -483,4 +491,32 @@ void VertexBufferTGL::SetVertexStates(tVertexFlag aFlags) {
 
 //-----------------------------------------------------------------------
 
+bool VertexBufferTGL::AddToOcclusionQuery() {
+	OcclusionQueryTGL *pQuery = static_cast<LowLevelGraphicsTGL *>(mpLowLevelGraphics)->GetActiveOcclusionQuery();
+	if (pQuery == nullptr)
+		return false;
+
+	const int lIdx = cMath::Log2ToInt(eVertexFlag_Position);
+	const int lStride = kvVertexElements[lIdx];
+	const tFloatVec &vPositions = mvVertexArray[lIdx];
+	if (vPositions.size() < (size_t)lStride)
+		return true;
+
+	cVector3f vMin(vPositions[0], vPositions[1], vPositions[2]);
+	cVector3f vMax = vMin;
+	for (size_t i = lStride; i + 2 < vPositions.size(); i += lStride) {
+		vMin.x = MIN(vMin.x, vPositions[i]);
+		vMin.y = MIN(vMin.y, vPositions[i + 1]);
+		vMin.z = MIN(vMin.z, vPositions[i + 2]);
+		vMax.x = MAX(vMax.x, vPositions[i]);
+		vMax.y = MAX(vMax.y, vPositions[i + 1]);
+		vMax.z = MAX(vMax.z, vPositions[i + 2]);
+	}
+
+	pQuery->AddBounds(vMin, vMax);
+	return true;
+}
+
+//-----------------------------------------------------------------------
+
 } // namespace hpl
\ No newline at end of file
@@ -74,6 +74,7 @@ public:
 
 private:
 	void SetVertexStates(tVertexFlag aFlags);
+	bool AddToOcclusionQuery();
 
 	tFloatVec mvVertexArray[klNumOfVertexFlags];
 	tUIntVec mvIndexArray;
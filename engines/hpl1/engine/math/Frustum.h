@@ -89,6 +89,7 @@ public:
 
 	const cVector3f &GetOrigin();
 	cBoundingVolume *GetOriginBV();
+	const cMatrixf &GetViewProjMatrix() const { return m_mtxViewProj; }
 
 	cVector3f GetForward();
 
@@ -212,6 +212,15 @@ void cPortal::AddPoint(const cVector3f &avPoint) {
 }
 void cPortal::SetTransform(const cMatrixf &a_mtxTrans) {
 	mBV.SetTransform(a_mtxTrans);
+	mpContainer->InvalidateVisibility();
+}
+
+void cPortal::SetActive(bool abX) {
+	if (mbActive == abX)
+		return;
+
+	mbActive = abX;
+	mpContainer->InvalidateVisibility();
 }
 //-----------------------------------------------------------------------
 
@@ -638,6 +647,8 @@ cPortalContainer::cPortalContainer() {
 	mlSectorVisitCount = 0;
 
 	mlEntityIterateCount = 0;
+
+	mpVisibilityCache = NULL;
 }
 
 //-----------------------------------------------------------------------
@@ -646,6 +657,8 @@ cPortalContainer::~cPortalContainer() {
 	hplDelete(mpEntityCallback);
 	hplDelete(mpNormalEntityCallback);
 
+	InvalidateVisibility();
+
 	STLMapDeleteAll(m_mapSectors);
 }
 
@@ -952,8 +965,19 @@ void cPortalContainer::GetVisible(cFrustum *apFrustum, cRenderList *apRenderList
 	mlstVisibleSectors.clear();
 
 	////////////////////////////////////////////////
-	// Get a container with all the visible sectors
-	cSectorVisibilityContainer *pVisSectorCont = CreateVisibiltyFromFrustum(apFrustum);
+	// Get a container with all the visible sectors.
+	// The search only depends on the frustum and the portals, so the result is
+	// kept as long as the camera does not move.
+	if (mpVisibilityCache == NULL ||
+		m_mtxVisibilityViewProj != apFrustum->GetViewProjMatrix() ||
+		mvVisibilityOrigin != apFrustum->GetOrigin()) {
+		InvalidateVisibility();
+
+		mpVisibilityCache = CreateVisibiltyFromFrustum(apFrustum);
+		m_mtxVisibilityViewProj = apFrustum->GetViewProjMatrix();
+		mvVisibilityOrigin = apFrustum->GetOrigin();
+	}
+	cSectorVisibilityContainer *pVisSectorCont = mpVisibilityCache;
 
 	// Iterate visible sectors, check for intersection with object and add the valid ones.
 	tSectorVisibilityIterator SectorIt = pVisSectorCont->GetSectorIterator();
@@ -1015,9 +1039,6 @@ void cPortalContainer::GetVisible(cFrustum *apFrustum, cRenderList *apRenderList
 		}
 	}
 
-	// Delete visible sectors.
-	hplDelete(pVisSectorCont);
-
 	gbCallbackActive = true;
 }
 
@@ -1026,6 +1047,8 @@ void cPortalContainer::GetVisible(cFrustum *apFrustum, cRenderList *apRenderList
 void cPortalContainer::Compile() {
 	/*When octrees are used, they should be compiled here */
 
+	InvalidateVisibility();
+
 	////////////////////////////////////////////////////////
 	// Go through all normal entities and update them
 	//(this since sectors might have been created  after their creation).
@@ -1064,6 +1087,8 @@ void cPortalContainer::AddSector(tString asId) {
 	cSector *pSector = hplNew(cSector, (asId, this));
 
 	m_mapSectors.insert(tSectorMap::value_type(asId, pSector));
+
+	InvalidateVisibility();
 }
 
 //-----------------------------------------------------------------------
@@ -1107,6 +1132,7 @@ bool cPortalContainer::AddToSector(iRenderable *apRenderable, tString asSector)
 		vMin.z = vObjectMin.z;
 
 	pSector->mBV.SetLocalMinMax(vMin, vMax);
+	InvalidateVisibility();
 	// Quick fix for thin stuff. (not working it seems)
 	// pSector->mBV.SetLocalMinMax(vMin - cVector3f(0.1f), vMax+cVector3f(0.1f));
 
@@ -1126,6 +1152,8 @@ bool cPortalContainer::AddPortal(cPortal *apPortal, tString asSector) {
 
 	pSector->AddPortal(apPortal);
 
+	InvalidateVisibility();
+
 	return true;
 }
 
@@ -1169,6 +1197,15 @@ cSectorVisibilityContainer *cPortalContainer::CreateVisibiltyFromFrustum(cFrustu
 
 //-----------------------------------------------------------------------
 
+void cPortalContainer::InvalidateVisibility() {
+	if (mpVisibilityCache) {
+		hplDelete(mpVisibilityCache);
+		mpVisibilityCache = NULL;
+	}
+}
+
+//-----------------------------------------------------------------------
+
 //////////////////////////////////////////////////////////////////////////
 // PRIVATE METHODS
 //////////////////////////////////////////////////////////////////////////
@@ -152,7 +152,7 @@ public:
 	cPlanef &GetPlane() { return mPlane; }
 
 	bool GetActive() { return mbActive; }
-	void SetActive(bool abX) { mbActive = abX; }
+	void SetActive(bool abX);
 
 private:
 	cPortalContainer *mpContainer;
@@ -276,6 +276,12 @@ public:
 	cSectorVisibilityContainer *CreateVisibiltyFromBV(cBoundingVolume *apBV);
 	cSectorVisibilityContainer *CreateVisibiltyFromFrustum(cFrustum *apFrustum);
 
+	/**
+	 * Drops the sector visibility kept from the last GetVisible call. Needs to be
+	 * called when sectors or portals change.
+	 */
+	void InvalidateVisibility();
+
 	// Debug stuff
 	tSectorMap *GetSectorMap() { return &m_mapSectors; }
 	tStringList *GetVisibleSectorsList() { return &mlstVisibleSectors; }
@@ -304,6 +310,11 @@ private:
 	tStringList mlstVisibleSectors;
 
 	int mlEntityIterateCount;
+
+	// Sectors visible from the frustum GetVisible was last called with.
+	cSectorVisibilityContainer *mpVisibilityCache;
+	cMatrixf m_mtxVisibilityViewProj;
+	cVector3f mvVisibilityOrigin;
 };
 
 } // namespace hpl
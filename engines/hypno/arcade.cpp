@@ -30,6 +30,9 @@ namespace Hypno {
 
 extern int parse_arc(const char *);
 
+// Number of frames of enemy videos decoded ahead of playback
+static const uint kShootDecodeAhead = 4;
+
 void HypnoEngine::splitArcadeFile(const Common::String &filename, Common::String &arc, Common::String &list) {
 	debugC(1, kHypnoDebugParser, "Splitting %s", filename.c_str());
 	Common::File file;
@@ -463,6 +466,8 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 							}
 							s.lastFrame = s.bodyFrames[s.bodyFrames.size() - 1].lastFrame();
 							loadPalette(s.video->decoder->getPalette() + 3*s.paletteOffset, s.paletteOffset, s.paletteSize);
+							// Enemy overlays are decoded on a worker while the background plays
+							s.video->decoder->setDecodeAhead(kShootDecodeAhead);
 							_shoots.push_back(s);
 						}
 						if (!s.noEnemySound) {
@@ -599,6 +604,7 @@ int HypnoEngine::detectTarget(const Common::Point &mousePos) {
 	if (target.x < 0 || target.y < 0)
 		return -1;
 
+	const uint32 c = _compositeSurface->getPixel(target.x, target.y);
 	for (Shoots::iterator it = _shoots.begin(); it != _shoots.end(); ++it) {
 		i++;
 		if (it->destroyed)
@@ -607,7 +613,6 @@ int HypnoEngine::detectTarget(const Common::Point &mousePos) {
 		if (it->animation != "NONE" && !it->video->decoder)
 			continue;
 
-		uint32 c =  _compositeSurface->getPixel(target.x, target.y);
 		if (c >= it->paletteOffset && c < it->paletteOffset + it->paletteSize) {
 			return i;
 		}
@@ -574,21 +574,18 @@ int32 DrawFlatUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	// Draw the spans
 	pspan = spans;
 
+	// The render device is always 32-bit BGRA with a 16-bit z buffer
+	const uint32 pixel = ((uint32)a0 << 24) | (r0 << 16) | (g0 << 8) | b0;
+
 	for (i = itopy; i < ibottomy; i++) {
 		count = pspan->x1 - pspan->x0;
 		if (count > 0) {
 			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * pspan->x0;
 			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				*(left + 0) = b0;
-				*(left + 1) = g0;
-				*(left + 2) = r0;
-				*(left + 3) = a0;
-				left += myRenDev.RGBBytesPerPixel;
-				*(uint16 *)(zleft + 0) = z;
-				zleft += myRenDev.ZBytesPerPixel;
-				count--;
-			} while (count > 0);
+			for (j = 0; j < count; j++)
+				WRITE_LE_UINT32(left + j * 4, pixel);
+			for (j = 0; j < count; j++)
+				*(uint16 *)(zleft + j * 2) = z;
 		}
 		pspan++;
 	}
@@ -764,20 +761,16 @@ int32 DrawGouraudUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z
 			ibslope = ((pspan->b1 << 8) - b) / count;
 			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * x;
 			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				*(left + 0) = (char)(b >> 8);
-				*(left + 1) = (char)(g >> 8);
-				*(left + 2) = (char)(r >> 8);
-				*(left + 3) = (char)(a >> 8);
-				*(uint16 *)(zleft + 0) = z;
-				zleft += myRenDev.ZBytesPerPixel;
-				left += myRenDev.RGBBytesPerPixel;
-				x++;
+			// Alpha is constant along the span
+			const uint32 alpha = (uint32)((a >> 8) & 0xFF) << 24;
+			for (j = 0; j < count; j++) {
+				WRITE_LE_UINT32(left + j * 4, alpha | (((r >> 8) & 0xFF) << 16) | (((g >> 8) & 0xFF) << 8) | ((b >> 8) & 0xFF));
 				r += irslope;
 				g += igslope;
 				b += ibslope;
-				count--;
-			} while (count > 0);
+			}
+			for (j = 0; j < count; j++)
+				*(uint16 *)(zleft + j * 2) = z;
 		}
 		pspan++;
 	}
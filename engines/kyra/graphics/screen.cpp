@@ -1053,21 +1053,38 @@ void Screen::copyRegion(int x1, int y1, int x2, int y2, int w, int h, int srcPag
 			src += SCREEN_W * _bytesPerPixel;
 			dst += SCREEN_W * _bytesPerPixel;
 		}
-	} else {
+	} else if (_bytesPerPixel == 2) {
 		while (h--) {
 			for (int i = 0; i < w; ++i) {
-				if (_bytesPerPixel == 2) {
-					uint px = *(const uint16*)&src[i << 1];
-					if (px)
-						*(uint16*)&dst[i << 1] = px;
-				} else {
-					if (src[i])
-						dst[i] = src[i];
-				}
+				uint px = *(const uint16*)&src[i << 1];
+				if (px)
+					*(uint16*)&dst[i << 1] = px;
 			}
 			src += SCREEN_W * _bytesPerPixel;
 			dst += SCREEN_W * _bytesPerPixel;
 		}
+	} else {
+		while (h--) {
+			int i = 0;
+			// Copy runs of four opaque pixels at once
+			for (; i + 4 <= w; i += 4) {
+				uint32 px = READ_UINT32(src + i);
+				if ((px & 0xFF000000) && (px & 0x00FF0000) && (px & 0x0000FF00) && (px & 0x000000FF)) {
+					WRITE_UINT32(dst + i, px);
+				} else {
+					for (int j = i; j < i + 4; ++j) {
+						if (src[j])
+							dst[j] = src[j];
+					}
+				}
+			}
+			for (; i < w; ++i) {
+				if (src[i])
+					dst[i] = src[i];
+			}
+			src += SCREEN_W;
+			dst += SCREEN_W;
+		}
 	}
 }
 
@@ -1769,6 +1786,11 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		return;
 	}
 
+	// Most shapes are drawn unscaled with a plain or color table plot. Process
+	// those lines without going through the plot callback for every pixel.
+	if (!(drawFunc & 4) && dsPlot2 == dsPlot3 && (dsPlot2 == &Screen::drawShapePlotType0 || dsPlot2 == &Screen::drawShapePlotType4))
+		dsProcessLine = (drawFunc & 1) ? &Screen::drawShapeProcessLineCopyDownwind : &Screen::drawShapeProcessLineCopyUpwind;
+
 	int curY = y;
 	const uint8 *src = shapeData;
 	uint8 *dst = _dsDstPage = getPagePtr(pageNum);
@@ -2162,6 +2184,38 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, c
 	cnt = -1;
 }
 
+void Screen::drawShapeProcessLineCopyUpwind(uint8 *&dst, const uint8 *&src, const DsPlotFunc plot, int &cnt, int16) {
+	const uint8 *colorTable = (plot == &Screen::drawShapePlotType4) ? _dsColorTable : nullptr;
+
+	do {
+		uint8 c = *src++;
+		if (c) {
+			*dst++ = colorTable ? colorTable[c] : c;
+			cnt--;
+		} else {
+			c = *src++;
+			dst += c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
+void Screen::drawShapeProcessLineCopyDownwind(uint8 *&dst, const uint8 *&src, const DsPlotFunc plot, int &cnt, int16) {
+	const uint8 *colorTable = (plot == &Screen::drawShapePlotType4) ? _dsColorTable : nullptr;
+
+	do {
+		uint8 c = *src++;
+		if (c) {
+			*dst-- = colorTable ? colorTable[c] : c;
+			cnt--;
+		} else {
+			c = *src++;
+			dst -= c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
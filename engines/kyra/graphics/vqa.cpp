@@ -604,6 +604,9 @@ bool VQAMovie::open(const char *filename) {
 }
 
 void VQAMovie::close() {
+	// The decoder may still be reading frames ahead from the file
+	_decoder->close();
+
 	if (_file.isOpen()) {
 		_file.close();
 	}
@@ -619,6 +622,10 @@ void VQAMovie::play() {
 
 		_decoder->start();
 
+		// Decode a few frames ahead, so that slow frames don't fall
+		// behind the sound
+		_decoder->setDecodeAhead(4);
+
 		// Note that decoding starts at frame -1. That's because there
 		// is usually sound data before the first frame, probably to
 		// avoid sound underflow.
@@ -45,6 +45,9 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream) override;
 	void readNextPacket() override;
 
+protected:
+	bool supportsDecodeAhead() const override { return true; }
+
 private:
 	Common::SeekableReadStream *_fileStream;
 
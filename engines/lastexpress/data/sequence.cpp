@@ -26,6 +26,8 @@
 #include "lastexpress/debug.h"
 
 #include "common/stream.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace LastExpress {
 
@@ -75,7 +77,7 @@ void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 
 // AnimFrame
 
-AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _palette(nullptr) {
+AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _palette(nullptr), _drawStart(0), _drawEnd(0) {
 	_palSize = 1;
 	// TODO: use just the needed rectangle
 	_image.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
@@ -129,7 +131,10 @@ AnimFrame::~AnimFrame() {
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
 	byte *inp = (byte *)_image.getPixels();
 	uint16 *outp = (uint16 *)s->getPixels();
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
+	uint32 end = MIN<uint32>(_drawEnd, 640 * 480);
+	inp += _drawStart;
+	outp += _drawStart;
+	for (uint32 i = _drawStart; i < end; i++, inp++, outp++) {
 		if (*inp)
 			*outp = _palette[*inp];
 	}
@@ -166,7 +171,8 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 
 		if (opcode & 0x80) {
@@ -191,11 +197,13 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 				_palSize = value + 1;
 			if (!opcode)
 				opcode = in->readByte();
-			for (int i = 0; i < opcode; i++, out++) {
-				p[out] = value;
-			}
+			memset(p + out, value, opcode);
+			out += opcode;
 		}
 	}
+
+	_drawStart = skip;
+	_drawEnd = out;
 }
 
 void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
@@ -209,7 +217,8 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 	//assert (f.yPos2 == size / 640);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 		if (!(opcode & 0x1f)) {
 			opcode = (uint16)((opcode << 3) + in->readByte());
@@ -226,11 +235,13 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 				_palSize = value + 1;
 			if (!opcode)
 				opcode = in->readByte();
-			for (int i = 0; i < opcode; i++, out++) {
-				p[out] = value;
-			}
+			memset(p + out, value, opcode);
+			out += opcode;
 		}
 	}
+
+	_drawStart = skip;
+	_drawEnd = out;
 }
 
 void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
@@ -246,7 +257,8 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 		if (opcode & 0x80) {
 			if (opcode & 0x40) {
@@ -272,9 +284,8 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 				byte value = in->readByte();
 				if (_palSize <= value)
 					_palSize = value + 1;
-				for (int i = 0; i < opcode; i++, out++) {
-					p[out] = value;
-				}
+				memset(p + out, value, opcode);
+				out += opcode;
 			}
 		} else {
 			if (_palSize <= opcode)
@@ -284,6 +295,9 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 			out++;
 		}
 	}
+
+	_drawStart = skip;
+	_drawEnd = out;
 }
 
 void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
@@ -293,7 +307,8 @@ void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
 	uint32 size = f.decompressedEndOffset / 2;
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 
 		if (opcode < 0x80) {
@@ -316,15 +331,17 @@ void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
 					byte value = in->readByte();
 					if (_palSize <= value)
 						_palSize = value + 1;
-					for (int i = 0; i < opcode; i++, out++) {
-						p[out] = value;
-					}
+					memset(p + out, value, opcode);
+					out += opcode;
 				}
 			} else {
 				out += ((opcode & 0xf) << 8) + in->readByte();
 			}
 		}
 	}
+
+	_drawStart = skip;
+	_drawEnd = out;
 }
 
 
@@ -332,16 +349,78 @@ void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
 //  SEQUENCE
 //////////////////////////////////////////////////////////////////////////
 
+class Sequence::PrefetchJob : public Common::Job {
+public:
+	PrefetchJob(Common::SeekableReadStream *stream, const FrameInfo &info, uint16 index) : _stream(stream), _info(info), index(index), frame(nullptr) {}
+
+	void run() override {
+		frame = new AnimFrame(_stream, _info);
+	}
+
+private:
+	Common::SeekableReadStream *_stream;
+	FrameInfo _info;
+
+public:
+	uint16 index;
+	AnimFrame *frame;
+};
+
 Sequence::~Sequence() {
 	reset();
+	delete _prefetchGroup;
 }
 
 void Sequence::reset() {
+	clearCache();
 	_frames.clear();
 	delete _stream;
 	_stream = nullptr;
 }
 
+void Sequence::clearCache() {
+	waitForPrefetch();
+
+	for (uint i = 0; i < _cache.size(); i++)
+		delete _cache[i].frame;
+
+	_cache.clear();
+}
+
+void Sequence::waitForPrefetch() {
+	if (!_prefetchJob)
+		return;
+
+	_prefetchGroup->wait();
+
+	PrefetchJob *job = _prefetchJob;
+	_prefetchJob = nullptr;
+	addToCache(job->index, job->frame);
+	delete job;
+}
+
+void Sequence::addToCache(uint16 index, AnimFrame *frame) {
+	CachedFrame entry;
+	entry.index = index;
+	entry.frame = frame;
+	entry.lastUse = ++_cacheClock;
+
+	if (_cache.size() < _frameCacheSize) {
+		_cache.push_back(entry);
+		return;
+	}
+
+	// Replace the least recently used frame
+	uint oldest = 0;
+	for (uint i = 1; i < _cache.size(); i++) {
+		if (_cache[i].lastUse < _cache[oldest].lastUse)
+			oldest = i;
+	}
+
+	delete _cache[oldest].frame;
+	_cache[oldest] = entry;
+}
+
 Sequence *Sequence::load(Common::String name, Common::SeekableReadStream *stream, byte field30) {
 	Sequence *sequence = new Sequence(name);
 
@@ -416,9 +495,59 @@ AnimFrame *Sequence::getFrame(uint16 index) {
 
 	debugC(9, kLastExpressDebugGraphics, "Decoding sequence %s: frame %d / %d", _name.c_str(), index, _frames.size() - 1);
 
+	waitForPrefetch();
+
 	return new AnimFrame(_stream, *frame);
 }
 
+AnimFrame *Sequence::getCachedFrame(uint16 index) {
+	waitForPrefetch();
+
+	for (uint i = 0; i < _cache.size(); i++) {
+		if (_cache[i].index == index) {
+			_cache[i].lastUse = ++_cacheClock;
+			return _cache[i].frame;
+		}
+	}
+
+	AnimFrame *frame = getFrame(index);
+	if (!frame)
+		return nullptr;
+
+	addToCache(index, frame);
+
+	return frame;
+}
+
+void Sequence::prefetchFrame(uint16 index) {
+	if (_prefetchJob || index >= _frames.size())
+		return;
+
+	// Only prefetch frames we know how to decode, the decoder errors out otherwise
+	const FrameInfo &info = _frames[index];
+	switch (info.compressionType) {
+	case 3:
+	case 4:
+	case 5:
+	case 7:
+	case 255:
+		break;
+	default:
+		return;
+	}
+
+	for (uint i = 0; i < _cache.size(); i++) {
+		if (_cache[i].index == index)
+			return;
+	}
+
+	if (!_prefetchGroup)
+		_prefetchGroup = new Common::TaskGroup(g_system->getThreadPool());
+
+	_prefetchJob = new PrefetchJob(_stream, info, index);
+	_prefetchGroup->run(_prefetchJob);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // SequenceFrame
 SequenceFrame::~SequenceFrame() {
@@ -433,13 +562,15 @@ Common::Rect SequenceFrame::draw(Graphics::Surface *surface) {
 	if (!_sequence || _frame >= _sequence->count())
 		return Common::Rect();
 
-	AnimFrame *f = _sequence->getFrame(_frame);
+	AnimFrame *f = _sequence->getCachedFrame(_frame);
 	if (!f)
 		return Common::Rect();
 
 	Common::Rect rect = f->draw(surface);
 
-	delete f;
+	// Most sequences are played forward, start decoding the next frame now
+	if (_frame + 1 < _sequence->count())
+		_sequence->prefetchFrame(_frame + 1);
 
 	return rect;
 }
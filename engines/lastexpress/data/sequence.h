@@ -79,6 +79,7 @@
 
 namespace Common {
 class SeekableReadStream;
+class TaskGroup;
 }
 
 namespace LastExpress {
@@ -146,11 +147,15 @@ private:
 	uint16 _palSize;
 	uint16 *_palette;
 	Common::Rect _rect;
+
+	// Pixels outside [_drawStart, _drawEnd) are never written by the decoders
+	uint32 _drawStart;
+	uint32 _drawEnd;
 };
 
 class Sequence {
 public:
-	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15) {}
+	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15), _cacheClock(0), _prefetchJob(nullptr), _prefetchGroup(nullptr) {}
 	~Sequence();
 
 	static Sequence *load(Common::String name, Common::SeekableReadStream *stream = NULL, byte field30 = 15);
@@ -161,6 +166,15 @@ public:
 	AnimFrame *getFrame(uint16 index = 0);
 	FrameInfo *getFrameInfo(uint16 index = 0);
 
+	/**
+	 * Get a decoded frame from the sequence frame cache, decoding it if needed.
+	 * The frame is owned by the sequence and stays valid until the next call.
+	 */
+	AnimFrame *getCachedFrame(uint16 index);
+
+	/** Start decoding a frame in the background so a later getCachedFrame() finds it ready. */
+	void prefetchFrame(uint16 index);
+
 	Common::String getName() { return _name; }
 	byte getField30() { return _field30; }
 
@@ -169,8 +183,20 @@ public:
 private:
 	static const uint32 _sequenceHeaderSize = 8;
 	static const uint32 _sequenceFrameSize = 68;
+	static const uint32 _frameCacheSize = 4;
+
+	class PrefetchJob;
+
+	struct CachedFrame {
+		uint16 index;
+		AnimFrame *frame;
+		uint32 lastUse;
+	};
 
 	void reset();
+	void clearCache();
+	void waitForPrefetch();
+	void addToCache(uint16 index, AnimFrame *frame);
 
 	Common::Array<FrameInfo> _frames;
 	Common::SeekableReadStream *_stream;
@@ -178,6 +204,15 @@ private:
 
 	Common::String _name;
 	byte _field30; // used when copying sequences
+
+	// Decoded frames, so redrawing or stepping back does not decode again
+	Common::Array<CachedFrame> _cache;
+	uint32 _cacheClock;
+
+	// Background decoding of the next frame. It uses _stream, so it has to be
+	// waited for before anything else reads from it.
+	PrefetchJob *_prefetchJob;
+	Common::TaskGroup *_prefetchGroup;
 };
 
 class SequenceFrame : public Drawable {
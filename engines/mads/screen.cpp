@@ -169,14 +169,16 @@ void DirtyAreas::merge(int startIndex, int count) {
 		return;
 
 	for (int outerCtr = startIndex - 1, idx = 0; idx < count; ++outerCtr, ++idx) {
-		if (!(*this)[outerCtr]._active)
+		// Only text areas are ever merged, and merging never changes the
+		// text flag of the outer area, so skip the inner scan for the rest
+		if (!(*this)[outerCtr]._active || !(*this)[outerCtr]._textActive)
 			continue;
 
 		for (int innerCtr = outerCtr + 1; innerCtr < count; ++innerCtr) {
-			if (!(*this)[innerCtr]._active || !intersects(outerCtr, innerCtr))
+			if (!(*this)[innerCtr]._active || !(*this)[innerCtr]._textActive)
 				continue;
 
-			if ((*this)[outerCtr]._textActive && (*this)[innerCtr]._textActive)
+			if (intersects(outerCtr, innerCtr))
 				mergeAreas(innerCtr, outerCtr);
 		}
 	}
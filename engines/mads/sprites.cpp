@@ -49,7 +49,10 @@ bool sortHelper(const DepthEntry &entry1, const DepthEntry &entry2) {
 	return entry1.depth < entry2.depth;
 }
 
-typedef Common::List<DepthEntry> DepthList;
+// An array rather than a list, so that sorting picks its pivots in constant
+// time. The sort visits the entries in the same order either way, so sprites
+// of equal depth keep being drawn in the same order.
+typedef Common::Array<DepthEntry> DepthList;
 
 /*------------------------------------------------------------------------*/
 
@@ -292,6 +295,8 @@ void SpriteSlots::drawSprites(MSurface *s) {
 	DepthList depthList;
 	Scene &scene = _vm->_game->_scene;
 
+	depthList.reserve(size());
+
 	// Get a list of sprite object depths for active objects
 	for (uint i = 0; i < size(); ++i) {
 		SpriteSlot &spriteSlot = (*this)[i];
@@ -39,14 +39,17 @@ namespace Xeen {
 #define SCENE_CLIP_RIGHT 223
 
 int SpriteResource::_clippedBottom;
+uint32 SpriteResource::_nextSerial = 1;
 
 SpriteResource::SpriteResource() {
 	_filesize = 0;
 	_data = nullptr;
+	_serial = 0;
 }
 
 SpriteResource::SpriteResource(const Common::String &filename) {
 	_data = nullptr;
+	_serial = 0;
 	load(filename);
 }
 
@@ -61,6 +64,7 @@ SpriteResource::~SpriteResource() {
 void SpriteResource::copy(const SpriteResource &src) {
 	_filesize = src._filesize;
 	_data = new byte[_filesize];
+	_serial = _nextSerial++;
 	Common::copy(src._data, src._data + _filesize, _data);
 
 	_index.resize(src._index.size());
@@ -93,6 +97,7 @@ void SpriteResource::load(Common::SeekableReadStream &f) {
 	_filesize = f.size();
 	delete[] _data;
 	_data = new byte[_filesize];
+	_serial = _nextSerial++;
 	f.read(_data, _filesize);
 
 	// Read in the index
@@ -110,6 +115,7 @@ void SpriteResource::clear() {
 	delete[] _data;
 	_data = nullptr;
 	_filesize = 0;
+	_serial = 0;
 	_index.clear();
 }
 
@@ -58,7 +58,9 @@ protected:
 	size_t _filesize;
 	byte *_data;
 	Common::String _filename;
+	uint32 _serial;
 	static int _clippedBottom;
+	static uint32 _nextSerial;
 
 	/**
 	 * Load a sprite resource from a stream
@@ -140,6 +142,14 @@ public:
 		return _index.size() == 0;
 	}
 
+	/**
+	 * Returns a number that changes whenever different sprite data is loaded
+	 * into the resource, so callers can tell whether earlier output is stale
+	 */
+	uint32 getSerial() const {
+		return _serial;
+	}
+
 	/**
 	 * Set the bottom Y position where sprites are clipped if SPRFLAG_BOTTOM_CLIPPED
 	 * is applied
@@ -32,6 +32,117 @@ static const int INDOOR_POW_INDEXES[3] = { 157, 151, 154 };
 static const int OUTDOOR_POW_INDEXES[3] = { 119, 113, 116 };
 static const int COMBAT_OFFSET_X[4] = { 8, 6, 4, 2 };
 
+// Area scene clipped sprites can draw to, including the extra pixel enlarged sprites write
+static const Common::Rect SCENE_DRAW_AREA(8, 8, 224, 142);
+
+bool SceneDrawCache::isCacheable(const DrawStruct &item) {
+	// Only the plain drawer simply overwrites pixels; the others depend on
+	// what's underneath or on random state, and bottom clipping on a global
+	return (item._flags & SPRFLAG_SCENE_CLIPPED) &&
+		!(item._flags & (SPRFLAG_MODE_MASK | SPRFLAG_BOTTOM_CLIPPED | SPRFLAG_RESIZE));
+}
+
+void SceneDrawCache::draw(Window &win, DrawStruct *items, int count) {
+	// Find how many leading entries are unchanged since the last frame
+	uint same = 0;
+	if (_lastItems.size() == (uint)count) {
+		for (; same < (uint)count; ++same) {
+			const DrawStruct &item = items[same];
+			const Entry &entry = _lastItems[same];
+			uint32 serial = item._sprites ? item._sprites->getSerial() : 0;
+
+			if (!isCacheable(item) || item._sprites != entry._item._sprites ||
+					serial != entry._serial || item._frame != entry._item._frame ||
+					item._x != entry._item._x || item._y != entry._item._y ||
+					item._scale != entry._item._scale || item._flags != entry._item._flags)
+				break;
+		}
+	}
+
+	uint start = 0;
+	if (_cachedCount && same >= _cachedCount) {
+		restore(win);
+		start = _cachedCount;
+	} else if (same && same == _lastSame) {
+		// Only save the output once it has stayed the same for two frames,
+		// so that rendering while moving around isn't slowed down
+		build(win, items, same);
+		start = same;
+	} else {
+		_cachedCount = 0;
+	}
+
+	win.drawList(items + start, count - start);
+
+	_lastSame = same;
+	_lastItems.resize(count);
+	for (int idx = 0; idx < count; ++idx) {
+		_lastItems[idx]._item = items[idx];
+		_lastItems[idx]._serial = items[idx]._sprites ? items[idx]._sprites->getSerial() : 0;
+	}
+}
+
+void SceneDrawCache::build(Window &win, DrawStruct *items, uint count) {
+	const Common::Rect &r = SCENE_DRAW_AREA;
+	const int w = r.width();
+	_pixels.resize(w * r.height());
+	_covered.resize(w * r.height());
+	_rowCovered.resize(r.height());
+	_background.resize(w * r.height());
+
+	for (int y = 0; y < r.height(); ++y)
+		memcpy(&_background[y * w], win.getBasePtr(r.left, r.top + y), w);
+
+	// Draw the entries over two different fills. Pixels that come out the
+	// same in both were written by a sprite, the rest show what's underneath
+	win.fillRect(r, 0);
+	win.drawList(items, count);
+	for (int y = 0; y < r.height(); ++y)
+		memcpy(&_pixels[y * w], win.getBasePtr(r.left, r.top + y), w);
+
+	win.fillRect(r, 0xff);
+	win.drawList(items, count);
+	for (int y = 0; y < r.height(); ++y) {
+		const byte *srcP = (const byte *)win.getBasePtr(r.left, r.top + y);
+		const byte *pixelsP = &_pixels[y * w];
+		byte *coveredP = &_covered[y * w];
+		byte rowCovered = 1;
+
+		for (int x = 0; x < w; ++x) {
+			coveredP[x] = srcP[x] == pixelsP[x];
+			rowCovered &= coveredP[x];
+		}
+		_rowCovered[y] = rowCovered;
+
+		memcpy(win.getBasePtr(r.left, r.top + y), &_background[y * w], w);
+	}
+
+	_cachedCount = count;
+	restore(win);
+}
+
+void SceneDrawCache::restore(Window &win) {
+	const Common::Rect &r = SCENE_DRAW_AREA;
+	const int w = r.width();
+
+	for (int y = 0; y < r.height(); ++y) {
+		byte *destP = (byte *)win.getBasePtr(r.left, r.top + y);
+		const byte *pixelsP = &_pixels[y * w];
+
+		if (_rowCovered[y]) {
+			memcpy(destP, pixelsP, w);
+		} else {
+			const byte *coveredP = &_covered[y * w];
+			for (int x = 0; x < w; ++x) {
+				if (coveredP[x])
+					destP[x] = pixelsP[x];
+			}
+		}
+	}
+
+	win.addDirtyRect(r);
+}
+
 OutdoorDrawList::OutdoorDrawList() : _sky1(_data[0]), _sky2(_data[1]),
 	_groundSprite(_data[2]), _attackImgs1(&_data[124]), _attackImgs2(&_data[95]),
 	_attackImgs3(&_data[76]), _attackImgs4(&_data[53]), _groundTiles(&_data[3]) {
@@ -178,7 +289,7 @@ void OutdoorDrawList::draw() {
 		_data[idx]._flags |= SPRFLAG_SCENE_CLIPPED;
 
 	// Draw the list
-	(*g_vm->_windows)[3].drawList(_data, size());
+	_cache.draw((*g_vm->_windows)[3], _data, size());
 }
 
 /*------------------------------------------------------------------------*/
@@ -386,7 +497,7 @@ void IndoorDrawList::draw() {
 		_data[idx]._flags |= SPRFLAG_SCENE_CLIPPED;
 
 	// Draw the list
-	(*g_vm->_windows)[3].drawList(_data, size());
+	_cache.draw((*g_vm->_windows)[3], _data, size());
 }
 
 /*------------------------------------------------------------------------*/
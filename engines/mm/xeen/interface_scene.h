@@ -31,6 +31,50 @@ namespace Xeen {
 
 class XeenEngine;
 
+/**
+ * Remembers the scene area as drawn by the leading entries of a draw list.
+ * While those entries stay the same from frame to frame, the saved pixels are
+ * put back instead of decoding the sprites again, and only the entries after
+ * them (such as animated monsters and the walls in front of them) are drawn
+ */
+class SceneDrawCache {
+	struct Entry {
+		DrawStruct _item;
+		uint32 _serial;
+	};
+private:
+	Common::Array<Entry> _lastItems;
+	uint _lastSame;
+	uint _cachedCount;
+	Common::Array<byte> _pixels;
+	Common::Array<byte> _covered;
+	Common::Array<byte> _rowCovered;
+	Common::Array<byte> _background;
+private:
+	/**
+	 * Returns true if an entry's output only depends on its own fields
+	 */
+	static bool isCacheable(const DrawStruct &item);
+
+	/**
+	 * Draws the first count entries and saves the result along with
+	 * which of the scene pixels they cover
+	 */
+	void build(Window &win, DrawStruct *items, uint count);
+
+	/**
+	 * Puts the saved pixels back, leaving the uncovered ones untouched
+	 */
+	void restore(Window &win);
+public:
+	SceneDrawCache() : _lastSame(0), _cachedCount(0) {}
+
+	/**
+	 * Draws a list to the scene, reusing the saved output where possible
+	 */
+	void draw(Window &win, DrawStruct *items, int count);
+};
+
 class OutdoorDrawList {
 public:
 	DrawStruct _data[132];
@@ -66,6 +110,8 @@ public:
 	 * Draw the list to the scene
 	 */
 	void draw();
+private:
+	SceneDrawCache _cache;
 };
 
 class IndoorDrawList {
@@ -115,6 +161,8 @@ public:
 	 * Draw the list to the scene
 	 */
 	void draw();
+private:
+	SceneDrawCache _cache;
 };
 
 class InterfaceScene {
@@ -45,6 +45,7 @@
 #ifdef ENABLE_RIVEN
 #include "mohawk/riven.h"
 #include "mohawk/riven_card.h"
+#include "mohawk/riven_graphics.h"
 #include "mohawk/riven_sound.h"
 #include "mohawk/riven_stack.h"
 #include "mohawk/riven_stacks/domespit.h"
@@ -391,6 +392,7 @@ RivenConsole::RivenConsole(MohawkEngine_Riven *vm) : GUI::Debugger(), _vm(vm) {
 	registerCmd("getRMAP",        WRAP_METHOD(RivenConsole, Cmd_GetRMAP));
 	registerCmd("combos",         WRAP_METHOD(RivenConsole, Cmd_Combos));
 	registerCmd("sliderState",    WRAP_METHOD(RivenConsole, Cmd_SliderState));
+	registerCmd("imageCache",     WRAP_METHOD(RivenConsole, Cmd_ImageCache));
 	registerCmd("quickTest",      WRAP_METHOD(RivenConsole, Cmd_QuickTest));
 	registerVar("show_hotspots",  &_vm->_showHotspots);
 }
@@ -688,6 +690,16 @@ bool RivenConsole::Cmd_SliderState(int argc, const char **argv) {
 	return true;
 }
 
+bool RivenConsole::Cmd_ImageCache(int argc, const char **argv) {
+	GraphicsManager::CacheStats stats = _vm->_gfx->getCacheStats();
+
+	debugPrintf("Images:    %d (%d KB of %d KB)\n", stats.images, stats.bytes / 1024, stats.budget / 1024);
+	debugPrintf("Hits:      %d\n", stats.hits);
+	debugPrintf("Misses:    %d\n", stats.misses);
+	debugPrintf("Evictions: %d\n", stats.evictions);
+	return true;
+}
+
 bool RivenConsole::Cmd_QuickTest(int argc, const char **argv) {
 	_debugPauseToken.clear();
 
@@ -23,6 +23,7 @@
 #include "mohawk/resource.h"
 #include "mohawk/graphics.h"
 
+#include "common/memtag.h"
 #include "common/system.h"
 #include "engines/util.h"
 #include "graphics/palette.h"
@@ -67,7 +68,13 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() :
+		_cacheBytes(0),
+		_cacheBudget(0),
+		_cacheTick(0),
+		_cacheHits(0),
+		_cacheMisses(0),
+		_cacheEvictions(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -75,8 +82,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		freeCachedImage(it->_value);
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -85,18 +92,54 @@ void GraphicsManager::clearCache() {
 
 	_cache.clear();
 	_subImageCache.clear();
+	_cacheBytes = 0;
 }
 
-MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+void GraphicsManager::freeCachedImage(CachedImage &image) {
+	delete image.surface;
+	image.surface = nullptr;
+	_cacheBytes -= image.size;
+	Common::memTagFreed(Common::kMemTagEngine, image.size);
+}
+
+void GraphicsManager::trimCache() {
+	if (_cacheBudget == 0)
+		return;
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	while (_cacheBytes > _cacheBudget && !_cache.empty()) {
+		Common::HashMap<uint16, CachedImage>::iterator oldest = _cache.begin();
+		for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+
+		freeCachedImage(oldest->_value);
+		_cache.erase(oldest);
+		_cacheEvictions++;
+	}
+}
 
-	return _cache[id];
+GraphicsManager::CacheStats GraphicsManager::getCacheStats() const {
+	CacheStats stats;
+	stats.hits = _cacheHits;
+	stats.misses = _cacheMisses;
+	stats.evictions = _cacheEvictions;
+	stats.images = _cache.size();
+	stats.bytes = _cacheBytes;
+	stats.budget = _cacheBudget;
+	return stats;
+}
+
+MohawkSurface *GraphicsManager::findImage(uint16 id) {
+	Common::HashMap<uint16, CachedImage>::iterator it = _cache.find(id);
+	if (it != _cache.end()) {
+		_cacheHits++;
+		it->_value.lastUse = ++_cacheTick;
+		return it->_value.surface;
+	}
+
+	_cacheMisses++;
+	addImageToCache(id, decodeImage(id));
+	return _cache[id].surface;
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -226,7 +269,14 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	CachedImage &image = _cache[id];
+	image.surface = surface;
+	image.lastUse = ++_cacheTick;
+
+	Graphics::Surface *s = surface->getSurface();
+	image.size = s ? s->pitch * s->h : 0;
+	_cacheBytes += image.size;
+	Common::memTagAllocated(Common::kMemTagEngine, image.size);
 }
 
 } // End of namespace Mohawk
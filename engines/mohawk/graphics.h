@@ -73,6 +73,26 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Limit the number of bytes kept by the image cache. A budget of 0
+	// (the default) keeps everything until clearCache() is called.
+	void setCacheBudget(uint32 bytes) { _cacheBudget = bytes; }
+
+	// Evict the least recently used images until the cache fits its budget.
+	// Never called implicitly, so surfaces returned by findImage() stay
+	// valid until the owner decides it is safe to trim.
+	void trimCache();
+
+	struct CacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		uint32 images;
+		uint32 bytes;
+		uint32 budget;
+	};
+
+	CacheStats getCacheStats() const;
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
@@ -96,8 +116,24 @@ protected:
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	struct CachedImage {
+		MohawkSurface *surface;
+		uint32 size;
+		uint32 lastUse;
+
+		CachedImage() : surface(nullptr), size(0), lastUse(0) {}
+	};
+
+	void freeCachedImage(CachedImage &image);
+
+	// An image cache that stores images until clearCache() or trimCache()
+	Common::HashMap<uint16, CachedImage> _cache;
+	uint32 _cacheBytes;
+	uint32 _cacheBudget;
+	uint32 _cacheTick;
+	uint32 _cacheHits;
+	uint32 _cacheMisses;
+	uint32 _cacheEvictions;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
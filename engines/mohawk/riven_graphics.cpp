@@ -325,6 +325,7 @@ RivenGraphics::RivenGraphics(MohawkEngine_Riven* vm) :
 		_transitionFrames(0),
 		_transitionDuration(0) {
 	_bitmapDecoder = new MohawkBitmap();
+	setCacheBudget(kRivenImageCacheBudget);
 
 	// Restrict ourselves to a single pixel format to simplify the effects implementation
 	_pixelFormat = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
@@ -58,6 +58,11 @@ enum RivenCreditsImageNumber {
 	kRivenCreditsLastImage   = 320
 };
 
+enum {
+	// Decoded card images kept around across card changes within a stack
+	kRivenImageCacheBudget = 32 * 1024 * 1024
+};
+
 class RivenGraphics : public GraphicsManager {
 public:
 	explicit RivenGraphics(MohawkEngine_Riven *vm);
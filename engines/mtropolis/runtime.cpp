@@ -4008,28 +4008,36 @@ Scheduler::~Scheduler() {
 
 Common::SharedPtr<ScheduledEvent> Scheduler::getFirstEvent() const {
 	if (_events.size() > 0)
-		return _events[0];
+		return _events.back();
 	return nullptr;
 }
 
 void Scheduler::descheduleFirstEvent() {
-	_events.remove_at(0);
+	_events.pop_back();
 }
 
-void Scheduler::insertEvent(const Common::SharedPtr<ScheduledEvent> &evt) {
-	uint32 t = evt->getScheduledTime();
-	size_t insertionIndex = 0;
-	while (insertionIndex < _events.size()) {
-		if (_events[insertionIndex]->getScheduledTime() > t)
-			break;
-		insertionIndex++;
+size_t Scheduler::findFirstNotLater(uint64 scheduledTime) const {
+	size_t lo = 0;
+	size_t hi = _events.size();
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (_events[mid]->getScheduledTime() > scheduledTime)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
 
-	_events.insert_at(insertionIndex, evt);
+	return lo;
+}
+
+void Scheduler::insertEvent(const Common::SharedPtr<ScheduledEvent> &evt) {
+	// Insert in front of the events with the same time, so that it fires after them
+	_events.insert_at(findFirstNotLater(evt->getScheduledTime()), evt);
 }
 
 void Scheduler::removeEvent(const ScheduledEvent *evt) {
-	for (size_t i = 0; i < _events.size(); i++) {
+	uint64 t = evt->getScheduledTime();
+	for (size_t i = findFirstNotLater(t); i < _events.size() && _events[i]->getScheduledTime() == t; i++) {
 		if (_events[i].get() == evt) {
 			_events[i].get()->_scheduler = nullptr;
 			_events.remove_at(i);
@@ -1486,6 +1486,11 @@ private:
 	void insertEvent(const Common::SharedPtr<ScheduledEvent> &evt);
 	void removeEvent(const ScheduledEvent *evt);
 
+	// Returns the index of the first event scheduled at or before scheduledTime
+	size_t findFirstNotLater(uint64 scheduledTime) const;
+
+	// Sorted by descending time, so the next event to fire is at the back.
+	// Events scheduled for the same time fire in the order they were added.
 	Common::Array<Common::SharedPtr<ScheduledEvent>> _events;
 };
 
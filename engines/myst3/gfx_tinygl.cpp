@@ -61,6 +61,7 @@ void TinyGLRenderer::init() {
 	computeScreenViewport();
 
 	TinyGL::createContext(kOriginalWidth, kOriginalHeight, g_system->getScreenFormat(), 512, false, ConfMan.getBool("dirtyrects"));
+	TinyGL::enableTiledRendering(ConfMan.getBool("tinygltiles"));
 
 	tglMatrixMode(TGL_PROJECTION);
 	tglLoadIdentity();
@@ -18,6 +18,7 @@ MODULE_OBJS := \
 	movie.o \
 	myst3.o \
 	node.o \
+	nodecache.o \
 	nodecube.o \
 	nodeframe.o \
 	puzzles.o \
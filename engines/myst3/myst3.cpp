@@ -38,6 +38,7 @@
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
 #include "engines/myst3/myst3.h"
+#include "engines/myst3/nodecache.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
 #include "engines/myst3/scene.h"
@@ -64,7 +65,7 @@ namespace Myst3 {
 Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		Engine(syst), _system(syst), _gameDescription(version),
 		_db(nullptr), _scriptEngine(nullptr),
-		_state(nullptr), _node(nullptr), _scene(nullptr), _archiveNode(nullptr),
+		_state(nullptr), _node(nullptr), _nodeFaceCache(nullptr), _scene(nullptr), _archiveNode(nullptr),
 		_cursor(nullptr), _inventory(nullptr), _gfx(nullptr), _menu(nullptr),
 		_rnd(nullptr), _sound(nullptr), _ambient(nullptr),
 		_inputSpacePressed(false), _inputEnterPressed(false),
@@ -112,6 +113,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _inventory;
 	delete _cursor;
 	delete _scene;
+	delete _nodeFaceCache;
 	delete _archiveNode;
 	delete _db;
 	delete _scriptEngine;
@@ -171,6 +173,7 @@ Common::Error Myst3Engine::run() {
 		_menu = new PagingMenu(this);
 	}
 	_archiveNode = new Archive();
+	_nodeFaceCache = new NodeFaceCache(this);
 
 	_system->showMouse(false);
 
@@ -850,6 +853,7 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	_db->cacheRoom(roomID, ageID);
 
 	Common::String newRoomName = _db->getRoomName(roomID, ageID);
+	_nodeFaceCache->setRoom(newRoomName);
 	if ((!_archiveNode || _archiveNode->getRoomName() != newRoomName) && !_db->isCommonRoom(roomID, ageID)) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
@@ -870,6 +874,11 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	_shakeEffect = ShakeEffect::create(this);
 	_rotationEffect = RotationEffect::create(this);
 
+	// Get the places the player can go from here ready in the background
+	NodePtr nodeData = _db->getNodeData(_state->getLocationNode(), _state->getLocationRoom(), _state->getLocationAge());
+	if (nodeData)
+		_nodeFaceCache->prefetchNeighbours(*nodeData, _state->getLocationNode());
+
 	// WORKAROUND: In Narayan, the scripts in node NACH 9 test on var 39
 	// without first reinitializing it leading to Saavedro not always giving
 	// Releeshan to the player when he is trapped between both shields.
@@ -1393,13 +1402,18 @@ Graphics::Surface *Myst3Engine::loadTexture(uint16 id) {
 
 Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc) {
 	Common::SeekableReadStream *jpegStream = jpegDesc->getData();
+	Graphics::Surface *surface = decodeJpeg(*jpegStream);
+	delete jpegStream;
 
+	return surface;
+}
+
+Graphics::Surface *Myst3Engine::decodeJpeg(Common::SeekableReadStream &jpegStream) {
 	Image::JPEGDecoder jpeg;
 	jpeg.setOutputPixelFormat(Texture::getRGBAPixelFormat());
 
-	if (!jpeg.loadStream(*jpegStream))
+	if (!jpeg.loadStream(jpegStream))
 		error("Could not decode Myst III JPEG");
-	delete jpegStream;
 
 	const Graphics::Surface *bitmap = jpeg.getSurface();
 	assert(bitmap->format == Texture::getRGBAPixelFormat());
@@ -73,6 +73,7 @@ class SunSpot;
 class Renderer;
 class Menu;
 class Node;
+class NodeFaceCache;
 class Sound;
 class Ambient;
 class ScriptedMovie;
@@ -102,6 +103,7 @@ public:
 	Database *_db;
 	Sound *_sound;
 	Ambient *_ambient;
+	NodeFaceCache *_nodeFaceCache;
 
 	Common::RandomSource *_rnd;
 
@@ -132,6 +134,7 @@ public:
 
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
+	static Graphics::Surface *decodeJpeg(Common::SeekableReadStream &jpegStream);
 
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
@@ -33,7 +33,11 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
+	setTextureFromBitmap(Myst3Engine::decodeJpeg(jpegDesc));
+}
+
+void Face::setTextureFromBitmap(Graphics::Surface *bitmap) {
+	_bitmap = bitmap;
 	if (_is3D) {
 		_texture = _vm->_gfx->createTexture3D(_bitmap);
 	} else {
@@ -0,0 +1,265 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/myst3/nodecache.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+NodeFaceCache::DecodeJob::~DecodeJob() {
+	delete data;
+
+	if (bitmap) {
+		bitmap->free();
+		delete bitmap;
+	}
+}
+
+void NodeFaceCache::DecodeJob::run() {
+	{
+		Common::StackLock lock(owner->_mutex);
+		if (state != kQueued)
+			return; // Already claimed by the main thread
+		state = kRunning;
+	}
+
+	decode();
+
+	Common::StackLock lock(owner->_mutex);
+	state = kDone;
+}
+
+void NodeFaceCache::DecodeJob::decode() {
+	bitmap = Myst3Engine::decodeJpeg(*data);
+	delete data;
+	data = nullptr;
+}
+
+NodeFaceCache::NodeFaceCache(Myst3Engine *vm) :
+		_vm(vm),
+		_memoryUsed(0),
+		_useCounter(0),
+		_group(g_system->getThreadPool()) {
+}
+
+NodeFaceCache::~NodeFaceCache() {
+	clear();
+}
+
+void NodeFaceCache::clear() {
+	_group.wait();
+
+	for (JobMap::iterator it = _jobs.begin(); it != _jobs.end(); ++it) {
+		delete it->_value;
+	}
+
+	_jobs.clear();
+	_memoryUsed = 0;
+}
+
+void NodeFaceCache::setRoom(const Common::String &room) {
+	if (room != _room) {
+		clear();
+		_room = room;
+	}
+}
+
+uint32 NodeFaceCache::makeKey(uint16 nodeId, const ResourceDescription &jpegDesc) {
+	return (jpegDesc.getType() << 24) | (jpegDesc.getFace() << 16) | nodeId;
+}
+
+uint32 NodeFaceCache::bitmapSize(const ResourceDescription &jpegDesc) {
+	// Cube faces are 640x640, frames are 640x480
+	if (jpegDesc.getType() == Archive::kCubeFace)
+		return 640 * 640 * 4;
+	return 640 * 480 * 4;
+}
+
+void NodeFaceCache::prefetchNeighbours(const NodeData &node, uint16 currentNodeId) {
+	// Without worker threads the faces would be decoded right here,
+	// which is no better than decoding them when the node is entered
+	if (g_system->getThreadPool().getWorkerCount() == 0)
+		return;
+
+	for (uint i = 0; i < node.hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = node.hotspots[i].script;
+
+		for (uint j = 0; j < script.size(); j++) {
+			const Opcode &cmd = script[j];
+			switch (cmd.op) {
+			case 136: // goToNodeTransition
+			case 137: // goToNodeTrans2
+			case 138: // goToNodeTrans1
+			case 164: { // changeNode
+				uint16 nodeId = _vm->_state->valueOrVarValue(cmd.args[0]);
+				if (nodeId != currentNodeId)
+					prefetchNode(nodeId);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+}
+
+void NodeFaceCache::prefetchNode(uint16 nodeId) {
+	ResourceDescription jpegDesc = _vm->getFileDescription(_room, nodeId, 1, Archive::kCubeFace);
+	if (jpegDesc.isValid()) {
+		for (uint i = 0; i < 6; i++) {
+			jpegDesc = _vm->getFileDescription(_room, nodeId, i + 1, Archive::kCubeFace);
+			if (jpegDesc.isValid())
+				prefetchFace(nodeId, jpegDesc);
+		}
+		return;
+	}
+
+	// Same lookup order as NodeFrame
+	jpegDesc = _vm->getFileDescription(_room, nodeId, 1, Archive::kLocalizedFrame);
+	if (!jpegDesc.isValid())
+		jpegDesc = _vm->getFileDescription(_room, nodeId, 0, Archive::kFrame);
+	if (!jpegDesc.isValid())
+		jpegDesc = _vm->getFileDescription(_room, nodeId, 1, Archive::kFrame);
+	if (jpegDesc.isValid())
+		prefetchFace(nodeId, jpegDesc);
+}
+
+void NodeFaceCache::prefetchFace(uint16 nodeId, const ResourceDescription &jpegDesc) {
+	uint32 key = makeKey(nodeId, jpegDesc);
+
+	JobMap::iterator it = _jobs.find(key);
+	if (it != _jobs.end()) {
+		it->_value->lastUse = ++_useCounter;
+		return;
+	}
+
+	if (!makeRoom(bitmapSize(jpegDesc)))
+		return;
+
+	DecodeJob *job = new DecodeJob();
+	job->owner = this;
+	job->size = bitmapSize(jpegDesc);
+	job->lastUse = ++_useCounter;
+	// Reading is done here, as the archive streams are not thread-safe
+	job->data = jpegDesc.getData();
+
+	_jobs[key] = job;
+	_memoryUsed += job->size;
+	debugC(kDebugNode, "Prefetching node %d face %d", nodeId, jpegDesc.getFace());
+	_group.run(job);
+}
+
+bool NodeFaceCache::makeRoom(uint32 size) {
+	while (_memoryUsed + size > kMemoryBudget) {
+		// Evict the least recently used face that is not being decoded
+		JobMap::iterator oldest = _jobs.end();
+		{
+			Common::StackLock lock(_mutex);
+			for (JobMap::iterator it = _jobs.begin(); it != _jobs.end(); ++it) {
+				if (it->_value->state != DecodeJob::kDone)
+					continue;
+				if (oldest == _jobs.end() || it->_value->lastUse < oldest->_value->lastUse)
+					oldest = it;
+			}
+		}
+
+		if (oldest == _jobs.end())
+			return false;
+
+		_memoryUsed -= oldest->_value->size;
+		delete oldest->_value;
+		_jobs.erase(oldest);
+	}
+
+	return true;
+}
+
+void NodeFaceCache::finish(DecodeJob *job) {
+	bool claimed = false;
+	{
+		Common::StackLock lock(_mutex);
+		if (job->state == DecodeJob::kQueued) {
+			job->state = DecodeJob::kRunning;
+			claimed = true;
+		}
+	}
+
+	if (claimed) {
+		// No worker picked the face up yet, decode it here
+		job->decode();
+
+		Common::StackLock lock(_mutex);
+		job->state = DecodeJob::kDone;
+		return;
+	}
+
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			if (job->state == DecodeJob::kDone)
+				return;
+		}
+
+		// A worker is decoding the face
+		_group.wait();
+	}
+}
+
+Graphics::Surface *NodeFaceCache::getBitmap(uint16 nodeId, const ResourceDescription &jpegDesc) {
+	uint32 key = makeKey(nodeId, jpegDesc);
+
+	DecodeJob *job;
+	JobMap::iterator it = _jobs.find(key);
+	if (it != _jobs.end()) {
+		job = it->_value;
+		finish(job);
+		debugC(kDebugNode, "Node %d face %d found in the cache", nodeId, jpegDesc.getFace());
+	} else {
+		Graphics::Surface *bitmap = Myst3Engine::decodeJpeg(&jpegDesc);
+		if (!makeRoom(bitmapSize(jpegDesc)))
+			return bitmap;
+
+		job = new DecodeJob();
+		job->owner = this;
+		job->bitmap = bitmap;
+		job->state = DecodeJob::kDone;
+		job->size = bitmapSize(jpegDesc);
+
+		_jobs[key] = job;
+		_memoryUsed += job->size;
+	}
+
+	job->lastUse = ++_useCounter;
+
+	// The node draws its spot items on its own copy of the bitmap
+	Graphics::Surface *copy = new Graphics::Surface();
+	copy->copyFrom(*job->bitmap);
+	return copy;
+}
+
+} // End of namespace Myst3
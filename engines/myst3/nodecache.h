@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MYST3_NODECACHE_H
+#define MYST3_NODECACHE_H
+
+#include "engines/myst3/archive.h"
+
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/threadpool.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Myst3 {
+
+class Myst3Engine;
+struct NodeData;
+
+/**
+ * Keeps the decoded background faces of recently used nodes, and decodes
+ * the faces of the nodes reachable from the current one on the thread pool
+ * so that moving to them does not stall on JPEG decoding.
+ */
+class NodeFaceCache {
+public:
+	explicit NodeFaceCache(Myst3Engine *vm);
+	~NodeFaceCache();
+
+	/**
+	 * Drop everything when the current room changes, as node and
+	 * face ids are only unique within a room.
+	 */
+	void setRoom(const Common::String &room);
+
+	/** Queue the faces of the nodes the hotspots of @p node lead to. */
+	void prefetchNeighbours(const NodeData &node, uint16 currentNodeId);
+
+	/**
+	 * Return a decoded copy of a node face, owned by the caller.
+	 * Faces that were not prefetched are decoded immediately, and kept
+	 * for later visits.
+	 */
+	Graphics::Surface *getBitmap(uint16 nodeId, const ResourceDescription &jpegDesc);
+
+	void clear();
+
+private:
+	/** Decoded bitmaps of all the nodes are kept until they use this much memory. */
+	static const uint32 kMemoryBudget = 64 * 1024 * 1024;
+
+	struct DecodeJob : public Common::Job {
+		enum State {
+			kQueued,
+			kRunning,
+			kDone
+		};
+
+		NodeFaceCache *owner;
+		Common::SeekableReadStream *data;
+		Graphics::Surface *bitmap;
+		State state;
+		uint32 size;
+		uint32 lastUse;
+
+		DecodeJob() : owner(nullptr), data(nullptr), bitmap(nullptr), state(kQueued), size(0), lastUse(0) {}
+		~DecodeJob() override;
+
+		void run() override;
+		void decode();
+	};
+
+	typedef Common::HashMap<uint32, DecodeJob *> JobMap;
+
+	static uint32 makeKey(uint16 nodeId, const ResourceDescription &jpegDesc);
+	static uint32 bitmapSize(const ResourceDescription &jpegDesc);
+
+	void prefetchNode(uint16 nodeId);
+	void prefetchFace(uint16 nodeId, const ResourceDescription &jpegDesc);
+	bool makeRoom(uint32 size);
+	void finish(DecodeJob *job);
+
+	Myst3Engine *_vm;
+	Common::String _room;
+
+	JobMap _jobs;
+	uint32 _memoryUsed;
+	uint32 _useCounter;
+
+	Common::Mutex _mutex;
+	Common::TaskGroup _group;
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_NODECACHE_H
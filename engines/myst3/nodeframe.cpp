@@ -21,6 +21,7 @@
 
 #include "engines/myst3/archive.h"
 #include "engines/myst3/myst3.h"
+#include "engines/myst3/nodecache.h"
 #include "engines/myst3/nodeframe.h"
 #include "engines/myst3/scene.h"
 #include "engines/myst3/state.h"
@@ -41,7 +42,7 @@ NodeFrame::NodeFrame(Myst3Engine *vm, uint16 id) :
 		error("Frame %d does not exist", id);
 
 	_faces[0] = new Face(_vm);
-	_faces[0]->setTextureFromJPEG(&jpegDesc);
+	_faces[0]->setTextureFromBitmap(_vm->_nodeFaceCache->getBitmap(id, jpegDesc));
 }
 
 NodeFrame::~NodeFrame() {
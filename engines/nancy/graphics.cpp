@@ -48,6 +48,53 @@ void GraphicsManager::init() {
 	g_nancy->_resource->loadImage(g_nancy->_imageChunks["OB0"].imageName, _object0);
 }
 
+// Adds the part of rect not yet covered by dirtyRects, split into
+// non-overlapping pieces, so that no screen pixel gets redrawn twice
+static void addDirtyRect(Common::Array<Common::Rect> &dirtyRects, const Common::Rect &rect) {
+	if (rect.isEmpty()) {
+		return;
+	}
+
+	Common::Array<Common::Rect> pieces;
+	pieces.push_back(rect);
+
+	for (uint i = 0; i < dirtyRects.size() && !pieces.empty(); ++i) {
+		const Common::Rect &existing = dirtyRects[i];
+		Common::Array<Common::Rect> remaining;
+
+		for (const Common::Rect &piece : pieces) {
+			if (!piece.intersects(existing)) {
+				remaining.push_back(piece);
+				continue;
+			}
+
+			// Keep the parts of piece above, below, left and right of existing
+			int16 top = piece.top;
+			int16 bottom = piece.bottom;
+			if (existing.top > top) {
+				remaining.push_back(Common::Rect(piece.left, top, piece.right, existing.top));
+				top = existing.top;
+			}
+			if (existing.bottom < bottom) {
+				remaining.push_back(Common::Rect(piece.left, existing.bottom, piece.right, bottom));
+				bottom = existing.bottom;
+			}
+			if (existing.left > piece.left) {
+				remaining.push_back(Common::Rect(piece.left, top, existing.left, bottom));
+			}
+			if (existing.right < piece.right) {
+				remaining.push_back(Common::Rect(existing.right, top, piece.right, bottom));
+			}
+		}
+
+		pieces = remaining;
+	}
+
+	for (const Common::Rect &piece : pieces) {
+		dirtyRects.push_back(piece);
+	}
+}
+
 void GraphicsManager::draw(bool updateScreen) {
 	if (_isSuppressed) {
 		_isSuppressed = false;
@@ -55,7 +102,7 @@ void GraphicsManager::draw(bool updateScreen) {
 	}
 
 	g_nancy->_cursorManager->applyCursor();
-	Common::List<Common::Rect> dirtyRects;
+	Common::Array<Common::Rect> dirtyRects;
 
 	// Update graphics for all RenderObjects and determine
 	// the areas of the screen that need to be redrawn
@@ -68,14 +115,14 @@ void GraphicsManager::draw(bool updateScreen) {
 			if (current._isVisible) {
 				if (current.hasMoved() && !current.getPreviousScreenPosition().isEmpty()) {
 					// Object moved to a new location on screen, update the previous one
-					dirtyRects.push_back(current.getPreviousScreenPosition());
+					addDirtyRect(dirtyRects, current.getPreviousScreenPosition());
 				}
 
 				// Redraw the current location
-				dirtyRects.push_back(current.getScreenPosition());
+				addDirtyRect(dirtyRects, current.getScreenPosition());
 			} else if (!current.getPreviousScreenPosition().isEmpty()) {
 				// Object just turned invisible, redraw the last location
-				dirtyRects.push_back(current.getPreviousScreenPosition());
+				addDirtyRect(dirtyRects, current.getPreviousScreenPosition());
 			}
 		}
 
@@ -83,16 +130,6 @@ void GraphicsManager::draw(bool updateScreen) {
 		current._previousScreenPosition = current._screenPosition;
 	}
 
-	// Filter out dirty rects that are completely inside others to reduce overdraw
-	for (auto outer = dirtyRects.begin(); outer != dirtyRects.end(); ++outer) {
-		for (auto inner = dirtyRects.begin(); inner != dirtyRects.end(); ++inner) {
-			if (inner != outer && (*outer).contains(*inner)) {
-				dirtyRects.erase(inner);
-				break;
-			}
-		}
-	}
-
 	// Redraw all dirty rects
 	for (auto it : _objects) {
 		RenderObject &current = *it;
@@ -101,7 +138,7 @@ void GraphicsManager::draw(bool updateScreen) {
 			continue;
 		}
 
-		for (Common::Rect rect : dirtyRects) {
+		for (const Common::Rect &rect : dirtyRects) {
 			if (rect.intersects(current.getScreenPosition())) {
 				blitToScreen(current, rect.findIntersectingRect(current.getScreenPosition()));
 			}
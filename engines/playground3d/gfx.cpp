@@ -70,7 +70,7 @@ const float Renderer::cubeVertices[] = {
 };
 
 Renderer::Renderer(OSystem *system)
-		: _system(system), _texture(nullptr) {
+		: _system(system), _texture(nullptr), _quadGridColumns(0) {
 }
 
 Renderer::~Renderer() {
@@ -111,10 +111,40 @@ void Renderer::setupCameraPerspective(float pitch, float heading, float fov) {
 	_mvpMatrix.transpose();
 }
 
-Renderer *createRenderer(OSystem *system) {
+const Common::Array<float> &Renderer::getQuadGrid(uint columns) {
+	if (columns == _quadGridColumns)
+		return _quadGrid;
+
+	_quadGrid.clear();
+	_quadGrid.reserve(columns * columns * 12);
+	const float step = 2.0f / columns;
+	for (uint y = 0; y < columns; y++) {
+		const float top = 1.0f - y * step;
+		const float bottom = top - step;
+		for (uint x = 0; x < columns; x++) {
+			const float left = -1.0f + x * step;
+			const float right = left + step;
+			const float quad[] = {
+				left, top,  right, top,  left, bottom,
+				right, top,  right, bottom,  left, bottom
+			};
+			for (uint i = 0; i < ARRAYSIZE(quad); i++)
+				_quadGrid.push_back(quad[i]);
+		}
+	}
+	_quadGridColumns = columns;
+	return _quadGrid;
+}
+
+float Renderer::quadLayerDepth(uint layer, uint layers) {
+	// Each layer is closer than the previous one, so it passes the depth test
+	return 0.9f - 1.8f * (layer + 1) / (layers + 1);
+}
+
+Graphics::RendererType determinateRenderType() {
 	Common::String rendererConfig = ConfMan.get("renderer");
 	Graphics::RendererType desiredRendererType = Graphics::Renderer::parseTypeCode(rendererConfig);
-	Graphics::RendererType matchingRendererType = Graphics::Renderer::getBestMatchingAvailableType(desiredRendererType,
+	return Graphics::Renderer::getBestMatchingAvailableType(desiredRendererType,
 #if defined(USE_OPENGL_GAME)
 			Graphics::kRendererTypeOpenGL |
 #endif
@@ -125,6 +155,10 @@ Renderer *createRenderer(OSystem *system) {
 			Graphics::kRendererTypeTinyGL |
 #endif
 			0);
+}
+
+Renderer *createRenderer(OSystem *system) {
+	Graphics::RendererType matchingRendererType = determinateRenderType();
 
 	bool isAccelerated = matchingRendererType != Graphics::kRendererTypeTinyGL;
 
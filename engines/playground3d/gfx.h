@@ -22,6 +22,7 @@
 #ifndef PLAYGROUND3D_GFX_H
 #define PLAYGROUND3D_GFX_H
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "common/system.h"
 
@@ -29,6 +30,7 @@
 #include "math/matrix4.h"
 #include "math/vector3d.h"
 
+#include "graphics/renderer.h"
 #include "graphics/surface.h"
 #include "graphics/pixelformat.h"
 
@@ -70,6 +72,19 @@ public:
 	virtual void drawRgbaTexture() = 0;
 
 	virtual void enableFog(const Math::Vector4d &fogColor) = 0;
+	virtual void disableFog() = 0;
+
+	/**
+	 * Draw layers of columns x columns flat quads covering the viewport.
+	 * With depthOnly set only the depth buffer is written.
+	 */
+	virtual void drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) = 0;
+
+	/**
+	 * Draw the RGBA texture count times, as 2D blits where the renderer
+	 * supports them
+	 */
+	virtual void drawBlits(uint count) = 0;
 
 protected:
 	OSystem *_system;
@@ -84,11 +99,24 @@ protected:
 	Graphics::Surface *_texture;
 
 	Math::Matrix4 makeProjectionMatrix(float fov, float nearClip, float farClip) const;
+
+	/**
+	 * Two triangles per quad, X Y per vertex, in normalized device coordinates.
+	 * The grid is kept until a different number of columns is asked for.
+	 */
+	const Common::Array<float> &getQuadGrid(uint columns);
+
+	static float quadLayerDepth(uint layer, uint layers);
+
+private:
+	Common::Array<float> _quadGrid;
+	uint _quadGridColumns;
 };
 
 Renderer *CreateGfxOpenGL(OSystem *system);
 Renderer *CreateGfxOpenGLShader(OSystem *system);
 Renderer *CreateGfxTinyGL(OSystem *system);
+Graphics::RendererType determinateRenderType();
 Renderer *createRenderer(OSystem *system);
 
 } // End of namespace Playground3d
@@ -159,6 +159,10 @@ void OpenGLRenderer::enableFog(const Math::Vector4d &fogColor) {
 	glEnable(GL_FOG);
 }
 
+void OpenGLRenderer::disableFog() {
+	glDisable(GL_FOG);
+}
+
 void OpenGLRenderer::drawFace(uint face) {
 	glBegin(GL_TRIANGLE_STRIP);
 	for (uint i = 0; i < 4; i++) {
@@ -359,6 +363,92 @@ void OpenGLRenderer::drawRgbaTexture() {
 	glPopMatrix();
 }
 
+void OpenGLRenderer::drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) {
+	const Common::Array<float> &grid = getQuadGrid(columns);
+
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+
+	glDisable(GL_TEXTURE_2D);
+	if (blend) {
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	} else {
+		glDisable(GL_BLEND);
+	}
+	if (depthOnly) {
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+	} else {
+		glDisable(GL_DEPTH_TEST);
+		glDepthMask(GL_FALSE);
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 2 * sizeof(GLfloat), grid.data());
+	for (uint i = 0; i < layers; i++) {
+		glLoadIdentity();
+		glTranslatef(0, 0, quadLayerDepth(i, layers));
+		glColor4f((i & 1) ? 1.0f : 0.0f, (i & 2) ? 1.0f : 0.0f, (i & 4) ? 1.0f : 0.5f, 0.5f);
+		glDrawArrays(GL_TRIANGLES, 0, grid.size() / 2);
+	}
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDisable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+}
+
+void OpenGLRenderer::drawBlits(uint count) {
+	// There are no 2D blits in OpenGL, textured quads are the equivalent
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_TEXTURE_2D);
+	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 2 * sizeof(GLfloat), bitmapVertices);
+	glTexCoordPointer(2, GL_FLOAT, 2 * sizeof(GLfloat), textCords);
+	glBindTexture(GL_TEXTURE_2D, _textureRgbaId[0]);
+	for (uint i = 0; i < count; i++) {
+		glLoadIdentity();
+		glTranslatef(-0.8f + (i % 8) * 0.2f, 0.8f - ((i / 8) % 8) * 0.2f, 0);
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	}
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+	glDisable(GL_TEXTURE_2D);
+
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+}
+
 } // End of namespace Playground3d
 
 #endif
@@ -56,6 +56,10 @@ public:
 	void drawRgbaTexture() override;
 
 	void enableFog(const Math::Vector4d &fogColor) override;
+	void disableFog() override;
+
+	void drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) override;
+	void drawBlits(uint count) override;
 
 private:
 	Math::Vector3d _pos;
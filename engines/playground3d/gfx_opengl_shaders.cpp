@@ -64,19 +64,24 @@ ShaderRenderer::ShaderRenderer(OSystem *system) :
 		_cubeShader(nullptr),
 		_fadeShader(nullptr),
 		_bitmapShader(nullptr),
+		_quadShader(nullptr),
 		_cubeVBO(0),
 		_fadeVBO(0),
-		_bitmapVBO(0) {
+		_bitmapVBO(0),
+		_quadVBO(0),
+		_quadVBOColumns(0) {
 }
 
 ShaderRenderer::~ShaderRenderer() {
 	OpenGL::Shader::freeBuffer(_cubeVBO);
 	OpenGL::Shader::freeBuffer(_fadeVBO);
 	OpenGL::Shader::freeBuffer(_bitmapVBO);
+	OpenGL::Shader::freeBuffer(_quadVBO);
 
 	delete _cubeShader;
 	delete _fadeShader;
 	delete _bitmapShader;
+	delete _quadShader;
 }
 
 void ShaderRenderer::init() {
@@ -105,6 +110,9 @@ void ShaderRenderer::init() {
 	_bitmapShader->enableVertexAttribute("position", _bitmapVBO, 2, GL_FLOAT, GL_TRUE, 4 * sizeof(float), 0);
 	_bitmapShader->enableVertexAttribute("texcoord", _bitmapVBO, 2, GL_FLOAT, GL_TRUE, 4 * sizeof(float), 8);
 
+	static const char *quadAttributes[] = { "position", nullptr };
+	_quadShader = OpenGL::Shader::fromFiles("playground3d_quad", quadAttributes);
+
 	glGenTextures(5, _textureRgbaId);
 	glGenTextures(5, _textureRgbId);
 	glGenTextures(2, _textureRgb565Id);
@@ -171,6 +179,9 @@ void ShaderRenderer::setupViewport(int x, int y, int width, int height) {
 void ShaderRenderer::enableFog(const Math::Vector4d &fogColor) {
 }
 
+void ShaderRenderer::disableFog() {
+}
+
 void ShaderRenderer::drawCube(const Math::Vector3d &pos, const Math::Vector3d &roll) {
 	auto rotateMatrix = (Math::Quaternion::fromEuler(roll.x(), roll.y(), roll.z(), Math::EO_XYZ)).inverse().toMatrix();
 	_cubeShader->use();
@@ -249,6 +260,60 @@ void ShaderRenderer::drawRgbaTexture() {
 	_bitmapShader->unbind();
 }
 
+void ShaderRenderer::drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) {
+	if (columns != _quadVBOColumns) {
+		const Common::Array<float> &grid = getQuadGrid(columns);
+		OpenGL::Shader::freeBuffer(_quadVBO);
+		_quadVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, grid.size() * sizeof(float), grid.data());
+		_quadShader->enableVertexAttribute("position", _quadVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
+		_quadVBOColumns = columns;
+	}
+
+	if (blend) {
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	} else {
+		glDisable(GL_BLEND);
+	}
+	if (depthOnly) {
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+	} else {
+		glDisable(GL_DEPTH_TEST);
+		glDepthMask(GL_FALSE);
+	}
+
+	_quadShader->use();
+	for (uint i = 0; i < layers; i++) {
+		_quadShader->setUniform1f("depth", quadLayerDepth(i, layers));
+		_quadShader->setUniform("color", Math::Vector4d((i & 1) ? 1.0f : 0.0f, (i & 2) ? 1.0f : 0.0f, (i & 4) ? 1.0f : 0.5f, 0.5f));
+		glDrawArrays(GL_TRIANGLES, 0, columns * columns * 6);
+	}
+	_quadShader->unbind();
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDisable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+}
+
+void ShaderRenderer::drawBlits(uint count) {
+	// There are no 2D blits in OpenGL, textured quads are the equivalent
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+
+	_bitmapShader->use();
+	glBindTexture(GL_TEXTURE_2D, _textureRgbaId[0]);
+	for (uint i = 0; i < count; i++) {
+		_bitmapShader->setUniform("offsetXY", Math::Vector2d(-0.8f + (i % 8) * 0.2f, 0.8f - ((i / 8) % 8) * 0.2f));
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	}
+	_bitmapShader->unbind();
+}
+
 } // End of namespace Playground3d
 
 #endif
@@ -56,15 +56,22 @@ public:
 	void drawRgbaTexture() override;
 
 	void enableFog(const Math::Vector4d &fogColor) override;
+	void disableFog() override;
+
+	void drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) override;
+	void drawBlits(uint count) override;
 
 private:
 	OpenGL::Shader *_cubeShader;
 	OpenGL::Shader *_fadeShader;
 	OpenGL::Shader *_bitmapShader;
+	OpenGL::Shader *_quadShader;
 
 	GLuint _cubeVBO;
 	GLuint _fadeVBO;
 	GLuint _bitmapVBO;
+	GLuint _quadVBO;
+	uint _quadVBOColumns;
 
 	Common::Rect _currentViewport;
 	GLuint _textureRgbaId[5];
@@ -189,6 +189,10 @@ void TinyGLRenderer::enableFog(const Math::Vector4d &fogColor) {
 	tglEnable(TGL_FOG);
 }
 
+void TinyGLRenderer::disableFog() {
+	tglDisable(TGL_FOG);
+}
+
 void TinyGLRenderer::drawFace(uint face) {
 	tglBegin(TGL_TRIANGLE_STRIP);
 	for (uint i = 0; i < 4; i++) {
@@ -430,4 +434,63 @@ void TinyGLRenderer::drawRgbaTexture() {
 	tglPopMatrix();
 }
 
+void TinyGLRenderer::drawQuadGrid(uint columns, uint layers, bool blend, bool depthOnly) {
+	const Common::Array<float> &grid = getQuadGrid(columns);
+
+	tglMatrixMode(TGL_PROJECTION);
+	tglPushMatrix();
+	tglLoadIdentity();
+
+	tglMatrixMode(TGL_MODELVIEW);
+	tglPushMatrix();
+
+	tglDisable(TGL_TEXTURE_2D);
+	if (blend) {
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+	} else {
+		tglDisable(TGL_BLEND);
+	}
+	if (depthOnly) {
+		tglColorMask(TGL_FALSE, TGL_FALSE, TGL_FALSE, TGL_FALSE);
+		tglEnable(TGL_DEPTH_TEST);
+		tglDepthMask(TGL_TRUE);
+	} else {
+		tglDisable(TGL_DEPTH_TEST);
+		tglDepthMask(TGL_FALSE);
+	}
+
+	tglEnableClientState(TGL_VERTEX_ARRAY);
+	tglVertexPointer(2, TGL_FLOAT, 2 * sizeof(TGLfloat), grid.data());
+	for (uint i = 0; i < layers; i++) {
+		tglLoadIdentity();
+		tglTranslatef(0, 0, quadLayerDepth(i, layers));
+		tglColor4f((i & 1) ? 1.0f : 0.0f, (i & 2) ? 1.0f : 0.0f, (i & 4) ? 1.0f : 0.5f, 0.5f);
+		tglDrawArrays(TGL_TRIANGLES, 0, grid.size() / 2);
+	}
+	tglDisableClientState(TGL_VERTEX_ARRAY);
+
+	tglColorMask(TGL_TRUE, TGL_TRUE, TGL_TRUE, TGL_TRUE);
+	tglDisable(TGL_BLEND);
+	tglEnable(TGL_DEPTH_TEST);
+	tglDepthMask(TGL_TRUE);
+
+	tglMatrixMode(TGL_MODELVIEW);
+	tglPopMatrix();
+
+	tglMatrixMode(TGL_PROJECTION);
+	tglPopMatrix();
+}
+
+void TinyGLRenderer::drawBlits(uint count) {
+	int blitTextureWidth, blitTextureHeight;
+	tglGetBlitImageSize(_blitImageRgba, blitTextureWidth, blitTextureHeight);
+
+	for (uint i = 0; i < count; i++) {
+		TinyGL::BlitTransform transform((i % 8) * 64, ((i / 8) % 6) * 64);
+		transform.sourceRectangle(0, 0, blitTextureWidth, blitTextureHeight);
+		tglBlit(_blitImageRgba, transform);
+	}
+}
+
 } // End of namespace Playground3d
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 #include "common/config-manager.h"
 #include "common/events.h"
+#include "common/savefile.h"
 
 #include "graphics/renderer.h"
 
@@ -33,20 +34,7 @@ namespace Playground3d {
 
 bool Playground3dEngine::hasFeature(EngineFeature f) const {
 	// The TinyGL renderer does not support arbitrary resolutions for now
-	Common::String rendererConfig = ConfMan.get("renderer");
-	Graphics::RendererType desiredRendererType = Graphics::Renderer::parseTypeCode(rendererConfig);
-	Graphics::RendererType matchingRendererType = Graphics::Renderer::getBestMatchingAvailableType(desiredRendererType,
-#if defined(USE_OPENGL_GAME)
-			Graphics::kRendererTypeOpenGL |
-#endif
-#if defined(USE_OPENGL_SHADERS)
-			Graphics::kRendererTypeOpenGLShaders |
-#endif
-#if defined(USE_TINYGL)
-			Graphics::kRendererTypeTinyGL |
-#endif
-			0);
-	bool softRenderer = matchingRendererType == Graphics::kRendererTypeTinyGL;
+	bool softRenderer = determinateRenderType() == Graphics::kRendererTypeTinyGL;
 
 	return
 		(f == kSupportsReturnToLauncher) ||
@@ -59,7 +47,9 @@ Playground3dEngine::Playground3dEngine(OSystem *syst)
 		_clearColor(0.0f, 0.0f, 0.0f, 1.0f), _fogColor(0.0f, 0.0f, 0.0f, 1.0f),
         _fade(1.0f), _fadeIn(false),
 		_rgbaTexture(nullptr), _rgbTexture(nullptr), _rgb565Texture(nullptr),
-		_rgba5551Texture(nullptr), _rgba4444Texture(nullptr) {
+		_rgba5551Texture(nullptr), _rgba4444Texture(nullptr),
+		_quadColumns(1), _quadLayers(1), _quadBlend(false), _quadDepthOnly(false), _blitCount(1),
+		_renderTime(0), _presentTime(0) {
 }
 
 Playground3dEngine::~Playground3dEngine() {
@@ -67,22 +57,74 @@ Playground3dEngine::~Playground3dEngine() {
 	delete _gfx;
 }
 
+struct BenchmarkPass {
+	const char *name;
+	int testId;
+	uint columns;
+	uint count; // quad layers or blits
+	bool blend;
+	bool depthOnly;
+	bool fog;
+};
+
+// The texture tests leave blending on and the depth test off, so they come last
+static const BenchmarkPass benchmarkPasses[] = {
+	// name              test columns count blend depthOnly fog
+	{ "cube",              1,   0,   0, false, false, false },
+	{ "fog",               1,   0,   0, false, false, true  },
+	{ "fillrate",          6,   1,  16, false, false, false },
+	{ "triangles_large",   6,   8,   1, false, false, false },
+	{ "triangles_medium",  6,  32,   1, false, false, false },
+	{ "triangles_small",   6, 128,   1, false, false, false },
+	{ "blending",          6,   1,  16, true,  false, false },
+	{ "depth_only",        6,   1,  16, false, true,  false },
+	{ "texture_upload",    5,   0,   0, false, false, false },
+	{ "blits",             7,   0,  64, false, false, false }
+};
+
 Common::Error Playground3dEngine::run() {
 	_gfx = createRenderer(_system);
 	_gfx->init();
 
-	_frameLimiter = new Graphics::FrameLimiter(_system, ConfMan.getInt("engine_speed"));
+	// The benchmark measures how fast frames can be drawn, so they are not limited
+	bool benchmark = ConfMan.hasKey("benchmark") && ConfMan.getBool("benchmark");
+	_frameLimiter = new Graphics::FrameLimiter(_system, benchmark ? 0 : ConfMan.getInt("engine_speed"));
 
 	_system->showMouse(true);
 
-	// 1 - rotated colorfull cube
-	// 2 - rotated two triangles with depth offset
-	// 3 - fade in/out
-	// 4 - moving filled rectangle in viewport
-	// 5 - drawing RGBA pattern texture to check endian correctness
-	int testId = 1;
-	_fogEnable = false;
+	Common::Error result = Common::kNoError;
+	if (benchmark) {
+		result = runBenchmark();
+	} else {
+		// 1 - rotated colorfull cube
+		// 2 - rotated two triangles with depth offset
+		// 3 - fade in/out
+		// 4 - moving filled rectangle in viewport
+		// 5 - drawing RGBA pattern texture to check endian correctness
+		// 6 - layers of flat quads covering the viewport
+		// 7 - blitting the RGBA pattern texture
+		int testId = 1;
+		_fogEnable = false;
+		setupTest(testId);
+
+		while (!shouldQuit()) {
+			processInput();
+			drawFrame(testId);
+		}
+	}
 
+	delete _rgbaTexture;
+	delete _rgbTexture;
+	delete _rgb565Texture;
+	delete _rgba5551Texture;
+	delete _rgba4444Texture;
+	_gfx->deinit();
+	_system->showMouse(false);
+
+	return result;
+}
+
+void Playground3dEngine::setupTest(int testId) {
 	if (_fogEnable) {
 		_fogColor = Math::Vector4d(1.0f, 1.0f, 1.0f, 1.0f);
 	}
@@ -101,43 +143,79 @@ Common::Error Playground3dEngine::run() {
 		case 4:
 			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
 			break;
-		case 5: {
+		case 5:
 			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
-#if defined(SCUMM_LITTLE_ENDIAN)
-			Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 0, 8, 16, 24);
-			Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 0, 8, 16, 0);
-#else
-			Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 24, 16, 8, 0);
-			Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 16, 8, 0, 0);
-#endif
-			Graphics::PixelFormat pixelFormatRGB565(2, 5, 6, 5, 0, 11, 5, 0, 0);
-			Graphics::PixelFormat pixelFormatRGB5551(2, 5, 5, 5, 1, 11, 6, 1, 0);
-			Graphics::PixelFormat pixelFormatRGB4444(2, 4, 4, 4, 4, 12, 8, 4, 0);
-			_rgbaTexture = generateRgbaTexture(120, 120, pixelFormatRGBA);
-			_rgbTexture = _rgbaTexture->convertTo(pixelFormatRGB);
-			_rgb565Texture = generateRgbaTexture(120, 120, pixelFormatRGB565);
-			_rgba5551Texture = generateRgbaTexture(120, 120, pixelFormatRGB5551);
-			_rgba4444Texture = generateRgbaTexture(120, 120, pixelFormatRGB4444);
+			generateTextures();
+			break;
+		case 6:
+			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
+			break;
+		case 7:
+			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
+			generateTextures();
+			_gfx->loadTextureRGBA(_rgbaTexture);
 			break;
-		}
 		default:
 			assert(false);
 	}
+}
+
+Common::Error Playground3dEngine::runBenchmark() {
+	uint32 duration = ConfMan.hasKey("benchmark_duration") ? ConfMan.getInt("benchmark_duration") : 5000;
+
+	Graphics::RendererType rendererType = determinateRenderType();
+	Common::String rendererName = Graphics::Renderer::getTypeCode(rendererType);
+	if (rendererType == Graphics::kRendererTypeTinyGL && ConfMan.getBool("dirtyrects"))
+		rendererName += "-dirtyrects";
+
+	Common::String csv = "renderer,pass,frames,milliseconds,fps,render_ms_per_frame,present_ms_per_frame\n";
+	for (uint i = 0; i < ARRAYSIZE(benchmarkPasses) && !shouldQuit(); i++) {
+		const BenchmarkPass &pass = benchmarkPasses[i];
+		_quadColumns = pass.columns;
+		_quadLayers = pass.count;
+		_quadBlend = pass.blend;
+		_quadDepthOnly = pass.depthOnly;
+		_blitCount = pass.count;
+		_fogEnable = pass.fog;
+		setupTest(pass.testId);
+
+		_renderTime = 0;
+		_presentTime = 0;
+		uint frames = 0;
+		uint64 start = _system->getMicros();
+		while (!shouldQuit() && _system->getMicros() - start < duration * 1000ULL) {
+			processInput();
+			drawFrame(pass.testId);
+			frames++;
+		}
+		float milliseconds = (_system->getMicros() - start) / 1000.0f;
 
-	while (!shouldQuit()) {
-		processInput();
-		drawFrame(testId);
+		if (_fogEnable) {
+			_gfx->disableFog();
+			_fogEnable = false;
+		}
+
+		float fps = milliseconds > 0 ? frames * 1000.0f / milliseconds : 0.0f;
+		float renderMs = frames ? _renderTime / 1000.0f / frames : 0.0f;
+		float presentMs = frames ? _presentTime / 1000.0f / frames : 0.0f;
+		debug("Benchmark %s %s: %u frames in %.0f ms, %.2f fps (render %.3f ms, present %.3f ms)",
+		      rendererName.c_str(), pass.name, frames, milliseconds, fps, renderMs, presentMs);
+		csv += Common::String::format("%s,%s,%u,%.1f,%.2f,%.3f,%.3f\n",
+		                              rendererName.c_str(), pass.name, frames, milliseconds, fps, renderMs, presentMs);
 	}
 
-	delete _rgbaTexture;
-	delete _rgbTexture;
-	delete _rgb565Texture;
-	delete _rgba5551Texture;
-	delete _rgba4444Texture;
-	_gfx->deinit();
-	_system->showMouse(false);
+	Common::String filename = "playground3d-benchmark-" + rendererName + ".csv";
+	Common::OutSaveFile *out = _saveFileMan->openForSaving(filename, false);
+	if (!out) {
+		warning("Unable to write the benchmark results to '%s'", filename.c_str());
+		return Common::kWritingFailed;
+	}
+	out->writeString(csv);
+	out->finalize();
+	bool failed = out->err();
+	delete out;
 
-	return Common::kNoError;
+	return failed ? Common::kWritingFailed : Common::kNoError;
 }
 
 void Playground3dEngine::processInput() {
@@ -172,6 +250,27 @@ Graphics::Surface *Playground3dEngine::generateRgbaTexture(int width, int height
 	return surface;
 }
 
+void Playground3dEngine::generateTextures() {
+	if (_rgbaTexture)
+		return;
+
+#if defined(SCUMM_LITTLE_ENDIAN)
+	Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 0, 8, 16, 24);
+	Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 0, 8, 16, 0);
+#else
+	Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 16, 8, 0, 0);
+#endif
+	Graphics::PixelFormat pixelFormatRGB565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	Graphics::PixelFormat pixelFormatRGB5551(2, 5, 5, 5, 1, 11, 6, 1, 0);
+	Graphics::PixelFormat pixelFormatRGB4444(2, 4, 4, 4, 4, 12, 8, 4, 0);
+	_rgbaTexture = generateRgbaTexture(120, 120, pixelFormatRGBA);
+	_rgbTexture = _rgbaTexture->convertTo(pixelFormatRGB);
+	_rgb565Texture = generateRgbaTexture(120, 120, pixelFormatRGB565);
+	_rgba5551Texture = generateRgbaTexture(120, 120, pixelFormatRGB5551);
+	_rgba4444Texture = generateRgbaTexture(120, 120, pixelFormatRGB4444);
+}
+
 void Playground3dEngine::drawAndRotateCube() {
 	Math::Vector3d pos = Math::Vector3d(0.0f, 0.0f, 6.0f);
 	_gfx->drawCube(pos, Math::Vector3d(_rotateAngleX, _rotateAngleY, _rotateAngleZ));
@@ -218,6 +317,8 @@ void Playground3dEngine::drawRgbaTexture() {
 }
 
 void Playground3dEngine::drawFrame(int testId) {
+	uint64 frameStart = _system->getMicros();
+
 	_gfx->clear(_clearColor);
 
 	float pitch = 0.0f;
@@ -253,15 +354,26 @@ void Playground3dEngine::drawFrame(int testId) {
 			_gfx->loadTextureRGBA4444(_rgba4444Texture);
 			drawRgbaTexture();
 			break;
+		case 6:
+			_gfx->drawQuadGrid(_quadColumns, _quadLayers, _quadBlend, _quadDepthOnly);
+			break;
+		case 7:
+			_gfx->drawBlits(_blitCount);
+			break;
 		default:
 			assert(false);
 	}
 
+	uint64 renderEnd = _system->getMicros();
+	_renderTime += renderEnd - frameStart;
+
 	_gfx->flipBuffer();
 
 	_frameLimiter->delayBeforeSwap();
 	_system->updateScreen();
 	_frameLimiter->startFrame();
+
+	_presentTime += _system->getMicros() - renderEnd;
 }
 
 } // End of namespace Playground3d
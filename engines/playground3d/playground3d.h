@@ -62,7 +62,22 @@ private:
 
 	float _rotateAngleX, _rotateAngleY, _rotateAngleZ;
 
+	// Parameters of the quad grid and blit tests
+	uint _quadColumns;
+	uint _quadLayers;
+	bool _quadBlend;
+	bool _quadDepthOnly;
+	uint _blitCount;
+
+	// Microseconds spent drawing and presenting frames, for the benchmark
+	uint64 _renderTime;
+	uint64 _presentTime;
+
+	void setupTest(int testId);
+	Common::Error runBenchmark();
+
 	Graphics::Surface *generateRgbaTexture(int width, int height, Graphics::PixelFormat format);
+	void generateTextures();
 	void drawAndRotateCube();
 	void drawPolyOffsetTest();
 	void dimRegionInOut();
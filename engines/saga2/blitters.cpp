@@ -32,28 +32,43 @@
 
 namespace Saga2 {
 
+//  Copy a row of pixels, leaving the destination alone where the
+//  source is color 0. Four pixels are looked at at once, since sprites
+//  are mostly made of long opaque or transparent runs.
+static inline void transparentRow(const byte *src, byte *dst, int32 width) {
+	for (; width >= 4; width -= 4, src += 4, dst += 4) {
+		uint32 quad = READ_UINT32(src);
+
+		if (quad == 0)
+			continue;
+
+		if (((quad - 0x01010101) & ~quad & 0x80808080) == 0) {
+			//  No transparent pixel among the four
+			WRITE_UINT32(dst, quad);
+			continue;
+		}
+
+		for (int i = 0; i < 4; i++) {
+			if (src[i])
+				dst[i] = src[i];
+		}
+	}
+
+	for (; width > 0; width--, src++, dst++) {
+		if (*src)
+			*dst = *src;
+	}
+}
+
 void _BltPixels(uint8 *srcPtr, uint32 srcMod, uint8 *dstPtr, uint32 dstMod, uint32 width, uint32 height) {
 	for (uint y = 0; y < height; y++) {
-		uint8 *src = srcPtr + srcMod * y;
-		uint8 *dst = dstPtr + dstMod * y;
-		for (uint x = 0; x < width; x++) {
-			*dst++ = *src++;
-		}
+		memcpy(dstPtr + dstMod * y, srcPtr + srcMod * y, width);
 	}
 }
 
 void _BltPixelsT(uint8 *srcPtr, uint32 srcMod, uint8 *dstPtr, uint32 dstMod, uint32 width, uint32 height) {
 	for (uint y = 0; y < height; y++) {
-		uint8 *src = srcPtr + srcMod * y;
-		uint8 *dst = dstPtr + dstMod * y;
-		for (uint x = 0; x < width; x++) {
-			byte c = *src++;
-
-			if (c == 0)
-				dst++;
-			else
-				*dst++ = c;
-		}
+		transparentRow(srcPtr + srcMod * y, dstPtr + dstMod * y, width);
 	}
 }
 
@@ -331,16 +346,10 @@ void TBlit(gPixelMap *dstMap, gPixelMap *srcMap, int32 xpos, int32 ypos) {
 	byte *dstPtr = dstMap->_data + xpos + ypos * dstMap->_size.x;
 
 	for (int16 y = 0; y < h; y++) {
-		for (int16 x = 0; x < w; x++) {
-			byte c = *srcPtr++;
+		transparentRow(srcPtr, dstPtr, w);
 
-			if (c == 0)
-				dstPtr++;
-			else
-				*dstPtr++ = c;
-		}
-		dstPtr += dstMod;
-		srcPtr += srcMod;
+		dstPtr += w + dstMod;
+		srcPtr += w + srcMod;
 	}
 }
 
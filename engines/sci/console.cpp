@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -102,6 +103,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("selectors",			WRAP_METHOD(Console, cmdSelectors));
 	registerCmd("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	registerCmd("class_table",		WRAP_METHOD(Console, cmdClassTable));
+	registerCmd("selector_cache",		WRAP_METHOD(Console, cmdSelectorCache));
 	// Parser
 	registerCmd("suffixes",			WRAP_METHOD(Console, cmdSuffixes));
 	registerCmd("parse_grammar",		WRAP_METHOD(Console, cmdParseGrammar));
@@ -152,6 +154,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -165,6 +168,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -341,6 +345,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" selector - Attempts to find the requested selector by name\n");
 	debugPrintf(" functions - Lists the kernel functions\n");
 	debugPrintf(" class_table - Shows the available classes\n");
+	debugPrintf(" selector_cache - Shows the hit rate of the selector lookup cache\n");
 	debugPrintf("\n");
 	debugPrintf("Parser:\n");
 	debugPrintf(" suffixes - Lists the vocabulary suffixes\n");
@@ -389,6 +394,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows the hit rates of the cel and scaler caches (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -401,6 +407,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows the pause durations of the garbage collector\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -1706,6 +1713,28 @@ bool Console::cmdClassTable(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		cache.resetStats();
+		debugPrintf("Selector lookup cache statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows the hit rate of the selector lookup cache.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const SelectorLookupCache::Stats &stats = cache.getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	debugPrintf("Lookups: %u, hits: %u (%u%%), misses: %u\n", lookups, stats.hits,
+				lookups ? (uint)((uint64)stats.hits * 100 / lookups) : 0, stats.misses);
+	debugPrintf("Invalidations: %u\n", stats.invalidations);
+
+	return true;
+}
+
 bool Console::cmdSentenceFragments(int argc, const char **argv) {
 	debugPrintf("Sentence fragments (used to build Parse trees)\n");
 
@@ -2218,6 +2247,45 @@ bool Console::cmdSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!CelObj::_cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		CelObj::_cache->resetStats();
+		CelObj::_scaler->resetStats();
+		debugPrintf("Cel cache statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows the hit rates of the cel and scaler caches.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const CelCache::Stats &cels = CelObj::_cache->getStats();
+	uint32 lookups = cels.hits + cels.misses;
+	debugPrintf("Cels: %u of %u cached, %u lookups, %u hits (%u%%), %u evictions\n",
+				CelObj::_cache->size(), CelObj::_cache->getMaxSize(), lookups, cels.hits,
+				lookups ? (uint)((uint64)cels.hits * 100 / lookups) : 0, cels.evictions);
+
+	lookups = cels.scaledHits + cels.scaledMisses;
+	debugPrintf("LarryScale cels: %u cached in %u KB, %u lookups, %u hits (%u%%)\n",
+				CelObj::_cache->scaledSize(), CelObj::_cache->getScaledBytes() / 1024, lookups, cels.scaledHits,
+				lookups ? (uint)((uint64)cels.scaledHits * 100 / lookups) : 0);
+
+	const CelScaler::Stats &scaler = CelObj::_scaler->getStats();
+	lookups = scaler.hits + scaler.misses;
+	debugPrintf("Scale tables: %u lookups, %u hits (%u%%)\n", lookups, scaler.hits,
+				lookups ? (uint)((uint64)scaler.hits * 100 / lookups) : 0);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Display saved bits.\n");
@@ -2759,6 +2827,29 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	GCStats &stats = _engine->_gamestate->_gcStats;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		stats.reset();
+		debugPrintf("Garbage collector statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows the pause durations of the garbage collector.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Collections: %u, deferred: %u, interval: %d kernel calls\n", stats.runs, stats.deferred,
+				_engine->_gamestate->scriptGCInterval * stats.intervalScale);
+	debugPrintf("Pause: last %u us, max %u us, average %u us\n", stats.lastMicros, stats.maxMicros,
+				stats.runs ? (uint)(stats.totalMicros / stats.runs) : 0);
+	debugPrintf("Freed: last %u objects (%u reachable), total %u objects\n", stats.lastFreed,
+				stats.lastReachable, stats.totalFreed);
+
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -21,6 +21,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -178,8 +179,16 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
+// Collections taking longer than this (in microseconds) cause visible hitches
+static const uint32 kGCPauseBudget = 5000;
+
+// Upper bound for stretching the collection interval after slow collections
+static const uint kGCMaxIntervalScale = 4;
+
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMicros();
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -213,6 +222,7 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					++freed;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -223,8 +233,19 @@ void run_gc(EngineState *s) {
 		}
 	}
 
+	GCStats &stats = s->_gcStats;
+	stats.lastReachable = activeRefs->size();
 	delete activeRefs;
 
+	const uint32 pause = g_system->getMicros() - startTime;
+	stats.runs++;
+	stats.lastMicros = pause;
+	stats.maxMicros = MAX(stats.maxMicros, pause);
+	stats.totalMicros += pause;
+	stats.lastFreed = freed;
+	stats.totalFreed += freed;
+	debugC(kDebugLevelGC, "[GC] Freed %u of %u objects in %u us", freed, freed + stats.lastReachable, pause);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -234,4 +255,21 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void scheduleNextGC(EngineState *s) {
+	GCStats &stats = s->_gcStats;
+
+	// A slow collection that found hardly any garbage will most likely be
+	// followed by another one just like it, so wait longer for the next
+	if (stats.lastMicros > kGCPauseBudget && stats.lastFreed < stats.lastReachable / 16) {
+		if (stats.intervalScale < kGCMaxIntervalScale) {
+			stats.intervalScale *= 2;
+			stats.deferred++;
+		}
+	} else {
+		stats.intervalScale = 1;
+	}
+
+	s->gcCountDown = s->scriptGCInterval * stats.intervalScale;
+}
+
 } // End of namespace Sci
@@ -54,6 +54,14 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Sets the number of kernel calls until the next garbage collection. The
+ * interval is stretched while collections are slow and free little, to
+ * make the resulting pauses less frequent.
+ * @param s The state in which we gc
+ */
+void scheduleNextGC(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
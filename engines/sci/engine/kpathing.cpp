@@ -116,21 +116,121 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* open set bookkeeping: position in the open heap (-1 if not in
+	// the open set), order of insertion into it and closed set membership
+	int heapIndex;
+	uint32 openOrder;
+	bool closed;
+
+	// Row/column in the cached visibility matrix, -1 if not cached
+	int cacheIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
+		costF = HUGE_DISTANCE;
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		heapIndex = -1;
+		openOrder = 0;
+		closed = false;
+		cacheIndex = -1;
 	}
 };
 
-class VertexList: public Common::List<Vertex *> {
+typedef Common::List<Vertex *> VertexList;
+
+/**
+ * Binary min-heap of vertices ordered by F cost, used as the A* open set.
+ * Vertices with equal F cost are returned most recently inserted first.
+ */
+class VertexHeap {
 public:
-	bool contains(Vertex *v) {
-		for (iterator it = begin(); it != end(); ++it) {
-			if (v == *it)
-				return true;
+	VertexHeap(uint capacity) : _inserted(0) {
+		_heap.reserve(capacity);
+	}
+
+	bool empty() const {
+		return _heap.empty();
+	}
+
+	Vertex *top() const {
+		return _heap[0];
+	}
+
+	bool contains(const Vertex *vertex) const {
+		return vertex->heapIndex >= 0;
+	}
+
+	void push(Vertex *vertex) {
+		vertex->openOrder = _inserted++;
+		vertex->heapIndex = _heap.size();
+		_heap.push_back(vertex);
+		siftUp(vertex->heapIndex);
+	}
+
+	void pop() {
+		Vertex *last = _heap.back();
+		_heap[0]->heapIndex = -1;
+		_heap.pop_back();
+
+		if (!_heap.empty()) {
+			_heap[0] = last;
+			last->heapIndex = 0;
+			siftDown(0);
 		}
-		return false;
+	}
+
+	/** Restores the heap order after the F cost of a vertex was lowered. */
+	void decreased(Vertex *vertex) {
+		siftUp(vertex->heapIndex);
+	}
+
+private:
+	Common::Array<Vertex *> _heap;
+	uint32 _inserted;
+
+	static bool before(const Vertex *a, const Vertex *b) {
+		if (a->costF != b->costF)
+			return a->costF < b->costF;
+		return a->openOrder > b->openOrder;
+	}
+
+	void place(uint index, Vertex *vertex) {
+		_heap[index] = vertex;
+		vertex->heapIndex = index;
+	}
+
+	void siftUp(uint index) {
+		Vertex *vertex = _heap[index];
+
+		while (index > 0) {
+			uint parent = (index - 1) / 2;
+			if (!before(vertex, _heap[parent]))
+				break;
+			place(index, _heap[parent]);
+			index = parent;
+		}
+
+		place(index, vertex);
+	}
+
+	void siftDown(uint index) {
+		Vertex *vertex = _heap[index];
+		const uint size = _heap.size();
+
+		for (;;) {
+			uint child = 2 * index + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && before(_heap[child + 1], _heap[child]))
+				++child;
+			if (!before(_heap[child], vertex))
+				break;
+			place(index, _heap[child]);
+			index = child;
+		}
+
+		place(index, vertex);
 	}
 };
 
@@ -262,12 +362,16 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility cache of the polygon set, NULL if it can't be used
+	AvoidPathCache *_visibilityCache;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
 		vertex_index = nullptr;
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
+		_visibilityCache = nullptr;
 		vertices = 0;
 	}
 
@@ -698,42 +802,68 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether a vertex is visible from another vertex.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if vertex is visible from vertex_cur
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
+ * Visibility between vertices of the polygon set is taken from the
+ * visibility cache when available, and stored there once computed.
  * @param s				the pathfinding state
  * @param vertex_cur	the vertex
  * @return list of vertices that are visible from vert
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	byte *cacheRow = nullptr;
+
+	if (s->_visibilityCache && vertex_cur->cacheIndex >= 0)
+		cacheRow = &s->_visibilityCache->visibility[vertex_cur->cacheIndex * s->_visibilityCache->vertices];
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
+		bool visible;
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
-
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+		if (cacheRow && vertex->cacheIndex >= 0) {
+			byte &entry = cacheRow[vertex->cacheIndex];
+			if (!entry)
+				entry = vertex_visible(s, vertex_cur, vertex) ? 1 : 2;
+			visible = (entry == 1);
+		} else {
+			visible = vertex_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1144,8 +1274,11 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				Vertex *next = CLIST_NEXT(vertex);
 
 				if (between(vertex->v, next->v, v)) {
-					// Split edge by adding vertex
+					// Split edge by adding vertex. This changes the
+					// edges of the polygon set, so cached visibility
+					// no longer applies.
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->_visibilityCache = nullptr;
 					return v_new;
 				}
 			}
@@ -1235,6 +1368,49 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Assigns each vertex of the polygon set its index in the visibility cache,
+ * and resets the cache if the polygon set differs from the one it was
+ * built for. Must be called before the start and end points are merged.
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) pf_s: The pathfinding state
+ */
+static void setup_visibility_cache(EngineState *s, PathfindingState *pf_s) {
+	// Larger polygon sets are not cached to bound the matrix size
+	const uint kMaxCachedVertices = 512;
+
+	AvoidPathCache &cache = s->_avoidPathCache;
+	Common::Array<int16> signature;
+	uint count = 0;
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		signature.push_back(polygon->type);
+		signature.push_back(polygon->vertices.size());
+
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			signature.push_back(vertex->v.x);
+			signature.push_back(vertex->v.y);
+			vertex->cacheIndex = count++;
+		}
+	}
+
+	if (count > kMaxCachedVertices)
+		return;
+
+	if (cache.vertices != count || !(cache.signature == signature)) {
+		cache.signature = signature;
+		cache.vertices = count;
+		cache.visibility.clear();
+		cache.visibility.resize(count * count);
+		debugC(kDebugLevelAvoidPath, "AvoidPath: New polygon set with %d vertices", count);
+	}
+
+	pf_s->_visibilityCache = &cache;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1326,6 +1502,8 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	setup_visibility_cache(s, pf_s);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1360,40 +1538,27 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
+	// The remaining vertices. Vertices of which the shortest path is known
+	// are flagged as closed.
+	VertexHeap openSet(s->vertices);
 
-	// The remaining vertices
-	VertexList openSet;
-
-	openSet.push_front(s->vertex_start);
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
+	openSet.push(s->vertex_start);
 
 	while (!openSet.empty()) {
 		// Find vertex in open set with lowest F cost
-		VertexList::iterator vertex_min_it = openSet.end();
-		Vertex *vertex_min = nullptr;
-		uint32 min = HUGE_DISTANCE;
-
-		for (VertexList::iterator it = openSet.begin(); it != openSet.end(); ++it) {
-			Vertex *vertex = *it;
-			if (vertex->costF < min) {
-				vertex_min_it = it;
-				vertex_min = *vertex_min_it;
-				min = vertex->costF;
-			}
-		}
+		Vertex *vertex_min = openSet.top();
 
-		assert(vertex_min != nullptr);	// the vertex cost should never be bigger than HUGE_DISTANCE
+		assert(vertex_min->costF != HUGE_DISTANCE);	// the vertex cost should never be bigger than HUGE_DISTANCE
 
 		// Check if we are done
 		if (vertex_min == s->vertex_end)
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
-		openSet.erase(vertex_min_it);
+		vertex_min->closed = true;
+		openSet.pop();
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1401,11 +1566,11 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->closed)
 				continue;
 
 			if (!openSet.contains(vertex))
-				openSet.push_front(vertex);
+				openSet.push(vertex);
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1443,6 +1608,7 @@ static void AStar(PathfindingState *s) {
 				vertex->costG = new_dist;
 				vertex->costF = vertex->costG + (uint32)sqrt((float)vertex->v.sqrDist(s->vertex_end->v));
 				vertex->path_prev = vertex_min;
+				openSet.decreased(vertex);
 			}
 		}
 
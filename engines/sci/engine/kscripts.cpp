@@ -45,6 +45,13 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// Scripts load the resources of a room before using them, which is a
+	// good hint to decompress them now instead of on the first frame that
+	// needs them. Digital audio is streamed and would only flush the cache.
+	if (restype != kResourceTypeAudio && restype != kResourceTypeSync &&
+		restype != kResourceTypeAudio36 && restype != kResourceTypeSync36)
+		g_sci->getResMan()->prefetchResource(ResourceId(restype, resnr));
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
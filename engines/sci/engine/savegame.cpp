@@ -183,6 +183,50 @@ void syncArray(Common::Serializer &s, Common::Array<T> &arr) {
 	sync(s, arr);
 }
 
+/**
+ * Sync a run of reg_t values. This produces the same data as syncing each of
+ * them with syncWithSerializer, but goes through the serializer in blocks,
+ * which matters for object variables and large arrays.
+ */
+void syncRegs(Common::Serializer &s, reg_t *regs, uint count) {
+	uint16 raw[512];
+	while (count) {
+		const uint numRegs = MIN<uint>(count, ARRAYSIZE(raw) / 2);
+		if (s.isSaving()) {
+			for (uint i = 0; i < numRegs; ++i) {
+				raw[i * 2] = regs[i]._segment;
+				raw[i * 2 + 1] = regs[i]._offset;
+			}
+		}
+
+		s.syncArrayAsUint16LE(raw, numRegs * 2);
+
+		if (s.isLoading()) {
+			for (uint i = 0; i < numRegs; ++i) {
+				regs[i]._segment = raw[i * 2];
+				regs[i]._offset = raw[i * 2 + 1];
+			}
+		}
+
+		regs += numRegs;
+		count -= numRegs;
+	}
+}
+
+/**
+ * Sync a Common::Array of reg_t values in the format used by syncArray.
+ */
+void syncRegArray(Common::Serializer &s, Common::Array<reg_t> &arr) {
+	uint len = arr.size();
+	s.syncAsUint32LE(len);
+
+	if (s.isLoading())
+		arr.resize(len);
+
+	if (len)
+		syncRegs(s, arr.data(), len);
+}
+
 void SegManager::saveLoadWithSerializer(Common::Serializer &s) {
 	if (s.isLoading()) {
 		resetSegMan();
@@ -336,6 +380,9 @@ void SegManager::saveLoadWithSerializer(Common::Serializer &s) {
 #endif
 			}
 		}
+
+		// Segments were restored without going through allocSegment()
+		_selectorLookupCache.invalidate();
 	}
 }
 
@@ -465,7 +512,7 @@ void Vocabulary::saveLoadWithSerializer(Common::Serializer &s) {
 
 void LocalVariables::saveLoadWithSerializer(Common::Serializer &s) {
 	s.syncAsSint32LE(script_id);
-	syncArray<reg_t>(s, _locals);
+	syncRegArray(s, _locals);
 }
 
 void Object::saveLoadWithSerializer(Common::Serializer &s) {
@@ -473,7 +520,7 @@ void Object::saveLoadWithSerializer(Common::Serializer &s) {
 	syncWithSerializer(s, _pos);
 	s.syncAsSint32LE(_methodCount);		// that's actually a uint16
 
-	syncArray<reg_t>(s, _variables);
+	syncRegArray(s, _variables);
 
 #ifdef ENABLE_SCI32
 	if (s.getVersion() >= 42 && getSciVersion() == SCI_VERSION_3) {
@@ -795,9 +842,7 @@ void SciArray::saveLoadWithSerializer(Common::Serializer &s) {
 	switch (_type) {
 	case kArrayTypeInt16:
 	case kArrayTypeID:
-		for (int i = 0; i < savedSize; ++i) {
-			syncWithSerializer(s, ((reg_t *)_data)[i]);
-		}
+		syncRegs(s, (reg_t *)_data, savedSize);
 		break;
 	case kArrayTypeByte:
 	case kArrayTypeString:
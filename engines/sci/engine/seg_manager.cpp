@@ -124,6 +124,7 @@ SegmentObj *SegManager::allocSegment(SegmentObj *mem, SegmentId *segid) {
 		_heap.push_back(0);
 	}
 	_heap[id] = mem;
+	_selectorLookupCache.invalidate();
 
 	return mem;
 }
@@ -181,6 +182,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = NULL;
+	_selectorLookupCache.invalidate();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -488,6 +490,8 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	// The entry may have belonged to a clone that has been freed
+	_selectorLookupCache.invalidate();
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -1099,6 +1103,8 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
+	// The script may have been reloaded into the segment it had before
+	_selectorLookupCache.invalidate();
 
 	return segmentId;
 }
@@ -342,34 +342,89 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
-
-	if (index >= 0) {
-		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	SelectorType type;
+	reg_t func;
+
+	if (!cache.find(obj_location, selectorId, type, index, func)) {
+		index = obj->locateVarSelector(segMan, selectorId);
+		func = NULL_REG;
+
+		if (index >= 0) {
+			// Found it as a variable
+			type = kSelectorVariable;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			type = kSelectorNone;
+			while (obj) {
+				int funcIndex = obj->funcSelectorPosition(selectorId);
+				if (funcIndex >= 0) {
+					func = obj->getFunction(funcIndex);
+					type = kSelectorMethod;
+					break;
+				} else {
+					obj = segMan->getObject(obj->getSuperClassSelector());
+				}
 			}
 		}
 
-		return kSelectorNone;
+		cache.store(obj_location, selectorId, type, index, func);
+	}
+
+	if (type == kSelectorVariable && varp) {
+		varp->obj = obj_location;
+		varp->varindex = index;
+	} else if (type == kSelectorMethod && fptr) {
+		*fptr = func;
+	}
+
+	return type;
+}
+
+SelectorLookupCache::SelectorLookupCache() {
+	memset(_entries, 0, sizeof(_entries));
+	_generation = 1;
+	resetStats();
+}
+
+void SelectorLookupCache::invalidate() {
+	// Entries from older generations never match. Only clear them when
+	// the generation counter wraps around.
+	if (++_generation == 0) {
+		memset(_entries, 0, sizeof(_entries));
+		_generation = 1;
+	}
+	_stats.invalidations++;
+}
+
+bool SelectorLookupCache::find(reg_t obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func) {
+	const Entry &entry = entryFor(obj, selectorId);
+	if (entry.generation != _generation || entry.obj != obj || entry.selectorId != selectorId) {
+		_stats.misses++;
+		return false;
 	}
 
+	type = entry.type;
+	varIndex = entry.varIndex;
+	func = entry.func;
+	_stats.hits++;
+	return true;
+}
+
+void SelectorLookupCache::store(reg_t obj, Selector selectorId, SelectorType type, int varIndex, reg_t func) {
+	Entry &entry = entryFor(obj, selectorId);
+	entry.generation = _generation;
+	entry.obj = obj;
+	entry.func = func;
+	entry.varIndex = varIndex;
+	entry.selectorId = selectorId;
+	entry.type = type;
+}
 
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+void SelectorLookupCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.invalidations = 0;
 }
 
 } // End of namespace Sci
@@ -116,6 +116,8 @@ void EngineState::reset(bool isRestoring) {
 
 	_cursorWorkaroundActive = false;
 
+	_avoidPathCache.clear();
+
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
 }
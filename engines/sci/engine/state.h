@@ -97,6 +97,51 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Pause durations and yield of the garbage collector, see gc.cpp.
+ */
+struct GCStats {
+	uint32 runs; ///< Number of collections
+	uint32 lastMicros; ///< Duration of the last collection
+	uint32 maxMicros; ///< Longest collection
+	uint64 totalMicros; ///< Time spent in all collections
+	uint32 lastReachable; ///< Reachable addresses found by the last collection
+	uint32 lastFreed; ///< Objects freed by the last collection
+	uint32 totalFreed; ///< Objects freed by all collections
+	uint32 deferred; ///< Number of times the next collection was postponed
+	uint intervalScale; ///< Multiplier applied to the collection interval
+
+	GCStats() { reset(); }
+
+	void reset() {
+		runs = 0;
+		lastMicros = maxMicros = 0;
+		totalMicros = 0;
+		lastReachable = lastFreed = totalFreed = 0;
+		deferred = 0;
+		intervalScale = 1;
+	}
+};
+
+/**
+ * Visibility between the polygon vertices of the last polygon set passed to
+ * kAvoidPath. Games pass the same set on every click in a room, so the
+ * visibility graph is kept until the set changes. See kpathing.cpp.
+ */
+struct AvoidPathCache {
+	Common::Array<int16> signature; ///< Type, size and points of each polygon
+	Common::Array<byte> visibility; ///< Vertex pair visibility, 0 if not computed yet
+	uint vertices; ///< Number of vertices in the polygon set
+
+	AvoidPathCache() : vertices(0) {}
+
+	void clear() {
+		signature.clear();
+		visibility.clear();
+		vertices = 0;
+	}
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -191,6 +236,7 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GCStats _gcStats;
 
 	MessageState *_msgState;
 
@@ -202,6 +248,8 @@ public:
 	uint16 _memorySegmentSize;
 	byte _memorySegment[kMemorySegmentMax];
 
+	AvoidPathCache _avoidPathCache;
+
 	/**
 	 * Resets the engine state.
 	 */
@@ -854,8 +854,8 @@ void run_vm(EngineState *s) {
 		case op_callk: { // 0x21 (33)
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
-				s->gcCountDown = s->scriptGCInterval;
 				run_gc(s);
+				scheduleNextGC(s);
 			}
 
 			// Call kernel function
@@ -380,6 +380,55 @@ void run_vm(EngineState *s);
  */
 void script_debug(EngineState *s);
 
+/**
+ * Direct mapped cache of lookupSelector() results, keyed by object address
+ * and selector. The variables and methods of an object never change while
+ * it exists, so entries only go stale when an address is reused for a
+ * different object. The segment manager invalidates the whole cache when
+ * scripts or clones are allocated, reloaded or freed.
+ */
+class SelectorLookupCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 invalidations;
+	};
+
+	SelectorLookupCache();
+
+	/** Drop all entries. Runs in constant time. */
+	void invalidate();
+
+	bool find(reg_t obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func);
+	void store(reg_t obj, Selector selectorId, SelectorType type, int varIndex, reg_t func);
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	enum {
+		kCacheSize = 1024
+	};
+
+	struct Entry {
+		uint32 generation;
+		reg_t obj;
+		reg_t func;
+		int varIndex;
+		Selector selectorId;
+		SelectorType type;
+	};
+
+	Entry &entryFor(reg_t obj, Selector selectorId) {
+		return _entries[(obj.getSegment() * 61 + obj.getOffset() * 13 + selectorId) & (kCacheSize - 1)];
+	}
+
+	Entry _entries[kCacheSize];
+	uint32 _generation;
+	Stats _stats;
+};
+
 /**
  * Looks up a selector and returns its type and value
  * varindex is written to iff it is non-NULL and the selector indicates a property of the object.
@@ -40,15 +40,26 @@ namespace Sci {
 CelScaler *CelObj::_scaler = nullptr;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
+	++_useCounter;
+
+	int oldest = 0;
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
 		if (_scaleTables[i].scaleX == scaleX && _scaleTables[i].scaleY == scaleY) {
 			_activeIndex = i;
+			_lastUsed[i] = _useCounter;
+			++_stats.hits;
 			return;
 		}
+
+		if (_lastUsed[i] < _lastUsed[oldest]) {
+			oldest = i;
+		}
 	}
 
-	const int i = 1 - _activeIndex;
+	++_stats.misses;
+	const int i = oldest;
 	_activeIndex = i;
+	_lastUsed[i] = _useCounter;
 	CelScalerTable &table = _scaleTables[i];
 
 	if (table.scaleX != scaleX) {
@@ -88,9 +99,8 @@ bool CelObj::_drawBlackLines = false;
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	_cache = new CelCache(1000);
 }
 
 void CelObj::deinit() {
@@ -234,14 +244,21 @@ struct SCALER_Scale {
 				scaledPosition.y,
 				scaledPosition.x + (celObj._width * scaleX).toInt(),
 				scaledPosition.y + (celObj._height * scaleY).toInt());
-			_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
-			_sourceBuffer->create(
-				scaledImageRect.width(), scaledImageRect.height(),
-				Graphics::PixelFormat::createFormatCLUT8());
-			Copier copier(_reader, *_sourceBuffer);
-			Graphics::larryScale(
-				celObj._width, celObj._height, celObj._skipColor, copier,
-				scaledImageRect.width(), scaledImageRect.height(), copier);
+			//
+			// Resource cels never change, so their scaled images are kept in
+			// the cel cache for as long as they keep being drawn at that size.
+			_sourceBuffer = CelObj::_cache->findScaled(celObj._info, scaledImageRect.width(), scaledImageRect.height());
+			if (!_sourceBuffer) {
+				_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_sourceBuffer->create(
+					scaledImageRect.width(), scaledImageRect.height(),
+					Graphics::PixelFormat::createFormatCLUT8());
+				Copier copier(_reader, *_sourceBuffer);
+				Graphics::larryScale(
+					celObj._width, celObj._height, celObj._skipColor, copier,
+					scaledImageRect.width(), scaledImageRect.height(), copier);
+				CelObj::_cache->insertScaled(celObj._info, _sourceBuffer);
+			}
 
 			// Set _valuesX and _valuesY to reference the scaled image without additional scaling
 			for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -686,45 +703,118 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+CelCache::CelCache(const uint maxSize) :
+	_maxSize(maxSize),
+	_scaledBytes(0) {
+	resetStats();
+}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+CelCache::~CelCache() {
+	for (CelList::iterator it = _lru.begin(); it != _lru.end(); ++it) {
+		delete *it;
+	}
+}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
-		}
+CelObj *CelCache::find(const CelInfo32 &celInfo) {
+	CelMap::iterator it = _map.find(celInfo);
+	if (it == _map.end()) {
+		++_stats.misses;
+		return nullptr;
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+	++_stats.hits;
+	CelObj *celObj = *it->_value;
+	if (it->_value != _lru.begin()) {
+		_lru.erase(it->_value);
+		_lru.push_front(celObj);
+		it->_value = _lru.begin();
 	}
+	return celObj;
+}
 
-	return -1;
+void CelCache::insert(CelObj *celObj) {
+	CelMap::iterator it = _map.find(celObj->_info);
+	if (it != _map.end()) {
+		delete *it->_value;
+		_lru.erase(it->_value);
+		_map.erase(it);
+	} else if (_map.size() >= _maxSize) {
+		CelObj *oldest = _lru.back();
+		_map.erase(oldest->_info);
+		_lru.pop_back();
+		delete oldest;
+		++_stats.evictions;
+	}
+
+	_lru.push_front(celObj);
+	_map[celObj->_info] = _lru.begin();
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+CelCache::ScaledCel CelCache::findScaled(const CelInfo32 &celInfo, const int16 width, const int16 height) {
+	const ScaledCelKey key = { celInfo, width, height };
+	ScaledCelMap::iterator it = _scaledMap.find(key);
+	if (it == _scaledMap.end()) {
+		++_stats.scaledMisses;
+		return ScaledCel();
+	}
+
+	++_stats.scaledHits;
+	if (it->_value != _scaledLru.begin()) {
+		const ScaledCelEntry entry = *it->_value;
+		_scaledLru.erase(it->_value);
+		_scaledLru.push_front(entry);
+		it->_value = _scaledLru.begin();
 	}
+	return _scaledLru.front().scaledCel;
+}
+
+void CelCache::insertScaled(const CelInfo32 &celInfo, const ScaledCel &scaledCel) {
+	if (celInfo.type != kCelTypeView && celInfo.type != kCelTypePic) {
+		return;
+	}
+
+	const uint32 bytes = scaledCel->pitch * scaledCel->h;
+	if (bytes > kMaxScaledBytes) {
+		return;
+	}
+
+	const ScaledCelKey key = { celInfo, (int16)scaledCel->w, (int16)scaledCel->h };
+	ScaledCelMap::iterator it = _scaledMap.find(key);
+	if (it != _scaledMap.end()) {
+		_scaledBytes -= it->_value->scaledCel->pitch * it->_value->scaledCel->h;
+		_scaledLru.erase(it->_value);
+		_scaledMap.erase(it);
+	}
+
+	while (!_scaledLru.empty() && _scaledBytes + bytes > kMaxScaledBytes) {
+		const ScaledCelEntry &oldest = _scaledLru.back();
+		_scaledBytes -= oldest.scaledCel->pitch * oldest.scaledCel->h;
+		_scaledMap.erase(oldest.key);
+		_scaledLru.pop_back();
+	}
+
+	const ScaledCelEntry entry = { key, scaledCel };
+	_scaledLru.push_front(entry);
+	_scaledMap[key] = _scaledLru.begin();
+	_scaledBytes += bytes;
+}
+
+void CelCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
+	_stats.scaledHits = 0;
+	_stats.scaledMisses = 0;
+}
+
+CelObj *CelObj::searchCache(const CelInfo32 &celInfo) const {
+	return _cache->find(celInfo);
+}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
-	entry.celObj.reset(duplicate());
-	entry.id = ++_nextCacheId;
+void CelObj::putCopyInCache() const {
+	_cache->insert(duplicate());
 }
 
 #pragma mark -
@@ -971,16 +1061,13 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
+	const CelObj *const cacheEntry = searchCache(_info);
+	if (cacheEntry != nullptr) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cacheEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1078,7 +1165,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1179,16 +1266,13 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
+	const CelObj *const cacheEntry = searchCache(_info);
+	if (cacheEntry != nullptr) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cacheEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1252,7 +1336,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
@@ -22,12 +22,19 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
 #include "sci/engine/vm_types.h"
 #include "sci/util.h"
 
+namespace Graphics {
+struct Surface;
+}
+
 namespace Sci {
 typedef Common::Rational Ratio;
 
@@ -105,7 +112,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +122,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -139,17 +146,120 @@ struct CelInfo32 {
 };
 
 class CelObj;
-struct CelCacheEntry {
+
+/**
+ * A cache of cel objects indexed by their CelInfo32, which replaces the least
+ * recently used cel when it is full. SSCI searched a fixed array of 100 cels
+ * linearly; scenes with many animated views easily use more than that.
+ */
+class CelCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		uint32 scaledHits;
+		uint32 scaledMisses;
+	};
+
+	typedef Common::SharedPtr<Graphics::Surface> ScaledCel;
+
+	CelCache(uint maxSize);
+	~CelCache();
+
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * Returns the cached cel object for the given CelInfo32 and marks it as
+	 * the most recently used one, or nullptr if it is not cached.
 	 */
-	int id;
-	Common::ScopedPtr<CelObj> celObj;
-	CelCacheEntry() : id(0) {}
-};
+	CelObj *find(const CelInfo32 &celInfo);
+
+	/**
+	 * Adds the given cel object to the cache, which takes ownership of it.
+	 */
+	void insert(CelObj *celObj);
+
+	/**
+	 * Returns the cached LarryScale output for the given cel at the given
+	 * size and marks it as the most recently used one, or a null pointer if
+	 * it is not cached.
+	 */
+	ScaledCel findScaled(const CelInfo32 &celInfo, int16 width, int16 height);
+
+	/**
+	 * Adds LarryScale output for the given cel to the cache, dropping the
+	 * least recently used scaled cels once they use more than
+	 * `kMaxScaledBytes`. Only view and pic cels are accepted, since the
+	 * contents of memory bitmaps can change.
+	 */
+	void insertScaled(const CelInfo32 &celInfo, const ScaledCel &scaledCel);
+
+	uint size() const { return _map.size(); }
+	uint getMaxSize() const { return _maxSize; }
+	uint scaledSize() const { return _scaledLru.size(); }
+	uint32 getScaledBytes() const { return _scaledBytes; }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	struct CelInfo32Hash {
+		uint operator()(const CelInfo32 &info) const {
+			return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 6) ^ info.celNo ^
+				(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+		}
+	};
+
+	struct CelInfo32EqualTo {
+		bool operator()(const CelInfo32 &a, const CelInfo32 &b) const { return a == b; }
+	};
+
+	/** Cel objects, from the most to the least recently used one. */
+	typedef Common::List<CelObj *> CelList;
+	typedef Common::HashMap<CelInfo32, CelList::iterator, CelInfo32Hash, CelInfo32EqualTo> CelMap;
 
-typedef Common::Array<CelCacheEntry> CelCache;
+	struct ScaledCelKey {
+		CelInfo32 celInfo;
+		int16 width;
+		int16 height;
+	};
+
+	struct ScaledCelKeyHash {
+		uint operator()(const ScaledCelKey &key) const {
+			return CelInfo32Hash()(key.celInfo) ^ (key.width << 20) ^ (key.height << 8);
+		}
+	};
+
+	struct ScaledCelKeyEqualTo {
+		bool operator()(const ScaledCelKey &a, const ScaledCelKey &b) const {
+			return a.celInfo == b.celInfo && a.width == b.width && a.height == b.height;
+		}
+	};
+
+	struct ScaledCelEntry {
+		ScaledCelKey key;
+		ScaledCel scaledCel;
+	};
+
+	/** Scaled cels, from the most to the least recently used one. */
+	typedef Common::List<ScaledCelEntry> ScaledCelList;
+	typedef Common::HashMap<ScaledCelKey, ScaledCelList::iterator, ScaledCelKeyHash, ScaledCelKeyEqualTo> ScaledCelMap;
+
+	enum {
+		/**
+		 * The memory that may be used by scaled cels. Enough for a dozen
+		 * full-screen high resolution cels.
+		 */
+		kMaxScaledBytes = 8 * 1024 * 1024
+	};
+
+	uint _maxSize;
+	CelList _lru;
+	CelMap _map;
+	ScaledCelList _scaledLru;
+	ScaledCelMap _scaledMap;
+	uint32 _scaledBytes;
+	Stats _stats;
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -188,16 +298,33 @@ struct CelScalerTable {
 };
 
 class CelScaler {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+	};
+
+private:
 	/**
-	 * Cached scale tables.
+	 * Cached scale tables. SSCI kept two, which is not enough for scenes with
+	 * several actors scaled by distance.
 	 */
-	CelScalerTable _scaleTables[2];
+	CelScalerTable _scaleTables[4];
+
+	/**
+	 * When each scale table was last used, to find the least recently used
+	 * one for replacement.
+	 */
+	uint32 _lastUsed[ARRAYSIZE(_scaleTables)];
+	uint32 _useCounter;
 
 	/**
 	 * The index of the most recently used scale table.
 	 */
 	int _activeIndex;
 
+	Stats _stats;
+
 	/**
 	 * Activates a scale table for the given X and Y ratios. If there is no
 	 * table that matches the given ratios, the least most recently used table
@@ -215,7 +342,10 @@ class CelScaler {
 public:
 	CelScaler() :
 		_scaleTables(),
-		_activeIndex(0) {
+		_lastUsed(),
+		_useCounter(0),
+		_activeIndex(0),
+		_stats() {
 		CelScalerTable &table = _scaleTables[0];
 		table.scaleX = Ratio();
 		table.scaleY = Ratio();
@@ -232,6 +362,9 @@ public:
 	 * Retrieves scaler tables for the given X and Y ratios.
 	 */
 	const CelScalerTable &getScalerTable(const Ratio &scaleX, const Ratio &scaleY);
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats.hits = _stats.misses = 0; }
 };
 
 #pragma mark -
@@ -452,31 +585,24 @@ private:
 
 #pragma mark -
 #pragma mark CelObj - Caching
-protected:
-	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
-	 */
-	static int _nextCacheId;
-
+public:
 	/**
 	 * A cache of cel objects used to avoid reinitialisation overhead for cels
 	 * with the same CelInfo32.
 	 */
 	static CelCache *_cache;
 
+protected:
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * not found, nullptr is returned.
 	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
+	CelObj *searchCache(const CelInfo32 &celInfo) const;
 
 	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
+	 * Puts a copy of this CelObj into the cache.
 	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache() const;
 };
 
 #pragma mark -
@@ -22,6 +22,8 @@
 #ifndef SCI_GRAPHICS_PAINT16_H
 #define SCI_GRAPHICS_PAINT16_H
 
+#include "sci/graphics/picture.h"
+
 namespace Sci {
 
 class GfxPorts;
@@ -98,6 +100,8 @@ private:
 
 	// true means make EGA picture drawing visible
 	bool _EGAdrawingVisualize;
+
+	GfxPictureCache _pictureCache;
 };
 
 } // End of namespace Sci
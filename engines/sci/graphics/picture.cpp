@@ -36,7 +36,7 @@ namespace Sci {
 //#define DEBUG_PICTURE_DRAW
 
 GfxPicture::GfxPicture(ResourceManager *resMan, GfxCoordAdjuster16 *coordAdjuster, GfxPorts *ports, GfxScreen *screen, GfxPalette *palette, GuiResourceId resourceId, bool EGAdrawingVisualize)
-	: _resMan(resMan), _coordAdjuster(coordAdjuster), _ports(ports), _screen(screen), _palette(palette), _resourceId(resourceId), _EGAdrawingVisualize(EGAdrawingVisualize) {
+	: _resMan(resMan), _coordAdjuster(coordAdjuster), _ports(ports), _screen(screen), _palette(palette), _resourceId(resourceId), _EGAdrawingVisualize(EGAdrawingVisualize), _sideEffects(nullptr) {
 	assert(resourceId != -1);
 	initData(resourceId);
 }
@@ -80,6 +80,64 @@ void GfxPicture::draw(bool mirroredFlag, bool addToFlag, int16 EGApaletteNo) {
 	}
 }
 
+static void copySpan(Common::Array<byte> &target, const SciSpan<const byte> &data) {
+	target.resize(data.size());
+	memcpy(target.begin(), data.getUnsafeDataAt(0, data.size()), data.size());
+}
+
+void GfxPicture::setPalette(Palette &palette) {
+	if (_sideEffects) {
+		PictureSideEffect effect;
+		effect.type = PictureSideEffect::kSetPalette;
+		effect.palette = palette;
+		_sideEffects->push_back(effect);
+	}
+	_palette->set(&palette, true);
+}
+
+void GfxPicture::modifyAmigaPalette(const SciSpan<const byte> &data) {
+	if (_sideEffects) {
+		PictureSideEffect effect;
+		effect.type = PictureSideEffect::kModifyAmigaPalette;
+		copySpan(effect.data, data);
+		_sideEffects->push_back(effect);
+	}
+	_palette->modifyAmigaPalette(data);
+}
+
+void GfxPicture::priorityBandsInit(int16 top, int16 bottom) {
+	if (_sideEffects) {
+		PictureSideEffect effect;
+		effect.type = PictureSideEffect::kPriorityBandsRange;
+		effect.top = top;
+		effect.bottom = bottom;
+		_sideEffects->push_back(effect);
+	}
+	_ports->priorityBandsInit(-1, top, bottom);
+}
+
+void GfxPicture::priorityBandsInit(const SciSpan<const byte> &data) {
+	if (_sideEffects) {
+		PictureSideEffect effect;
+		effect.type = PictureSideEffect::kPriorityBandsTable;
+		copySpan(effect.data, data);
+		_sideEffects->push_back(effect);
+	}
+	_ports->priorityBandsInit(data);
+}
+
+void GfxPicture::priorityBandsInitSci11(const SciSpan<const byte> &data) {
+	// 14 words of priority band data
+	const SciSpan<const byte> bands = data.subspan(0, 28);
+	if (_sideEffects) {
+		PictureSideEffect effect;
+		effect.type = PictureSideEffect::kPriorityBandsSci11;
+		copySpan(effect.data, bands);
+		_sideEffects->push_back(effect);
+	}
+	_ports->priorityBandsInitSci11(bands);
+}
+
 void GfxPicture::reset() {
 	int16 startY = _ports->getPort()->top;
 	int16 startX = 0;
@@ -125,7 +183,7 @@ void GfxPicture::drawSci11Vga() {
 	if (has_cel) {
 		// Create palette and set it
 		_palette->createFromData(inbuffer.subspan(palette_data_ptr), &palette);
-		_palette->set(&palette, true);
+		setPalette(palette);
 
 		drawCelData(inbuffer, cel_headerPos, cel_RlePos, cel_LiteralPos, 0, 0, 0, 0, false);
 	}
@@ -134,7 +192,7 @@ void GfxPicture::drawSci11Vga() {
 	drawVectorData(inbuffer.subspan(vector_dataPos, vector_size));
 
 	// Set priority band information
-	_ports->priorityBandsInitSci11(inbuffer.subspan(40));
+	priorityBandsInitSci11(inbuffer.subspan(40));
 }
 
 extern void unpackCelData(const SciSpan<const byte> &inBuffer, SciSpan<byte> &celBitmap, byte clearColor, int rlePos, int literalPos, ViewType viewType, uint16 width, bool isMacSci11ViewData);
@@ -649,7 +707,7 @@ void GfxPicture::drawVectorData(const SciSpan<const byte> &data) {
 					curPos += size;
 					break;
 				case PIC_OPX_EGA_SET_PRIORITY_TABLE:
-					_ports->priorityBandsInit(data.subspan(curPos, 14));
+					priorityBandsInit(data.subspan(curPos, 14));
 					curPos += 14;
 					break;
 				default:
@@ -672,7 +730,7 @@ void GfxPicture::drawVectorData(const SciSpan<const byte> &data) {
 							curPos += 256 + 4 + 1024;
 						} else {
 							// Setting half of the Amiga palette
-							_palette->modifyAmigaPalette(data.subspan(curPos));
+							modifyAmigaPalette(data.subspan(curPos, 32));
 							curPos += 32;
 						}
 					} else {
@@ -681,7 +739,7 @@ void GfxPicture::drawVectorData(const SciSpan<const byte> &data) {
 							palette.colors[i].used = data[curPos++];
 							palette.colors[i].r = data[curPos++]; palette.colors[i].g = data[curPos++]; palette.colors[i].b = data[curPos++];
 						}
-						_palette->set(&palette, true);
+						setPalette(palette);
 					}
 					break;
 				case PIC_OPX_VGA_EMBEDDED_VIEW: // draw cel
@@ -698,11 +756,11 @@ void GfxPicture::drawVectorData(const SciSpan<const byte> &data) {
 					curPos += size;
 					break;
 				case PIC_OPX_VGA_PRIORITY_TABLE_EQDIST:
-					_ports->priorityBandsInit(-1, data.getUint16LEAt(curPos), data.getUint16LEAt(curPos + 2));
+					priorityBandsInit(data.getUint16LEAt(curPos), data.getUint16LEAt(curPos + 2));
 					curPos += 4;
 					break;
 				case PIC_OPX_VGA_PRIORITY_TABLE_EXPLICIT:
-					_ports->priorityBandsInit(data.subspan(curPos, 14));
+					priorityBandsInit(data.subspan(curPos, 14));
 					curPos += 14;
 					break;
 				default:
@@ -1186,4 +1244,113 @@ void GfxPicture::vectorPattern(int16 x, int16 y, byte color, byte priority, byte
 	}
 }
 
+// Memory budget for the planes of cached pictures
+static const uint kPictureCacheBudget = 4 * 1024 * 1024;
+
+bool GfxPictureCache::Key::operator==(const Key &other) const {
+	return pictureId == other.pictureId && mirroredFlag == other.mirroredFlag &&
+		addToFlag == other.addToFlag && EGApaletteNo == other.EGApaletteNo &&
+		portTop == other.portTop && portLeft == other.portLeft && portRect == other.portRect &&
+		paletteMapValue == other.paletteMapValue && unditheringEnabled == other.unditheringEnabled &&
+		planesHash == other.planesHash;
+}
+
+GfxPictureCache::GfxPictureCache(ResourceManager *resMan, GfxCoordAdjuster16 *coordAdjuster, GfxPorts *ports, GfxScreen *screen, GfxPalette *palette)
+	: _resMan(resMan), _coordAdjuster(coordAdjuster), _ports(ports), _screen(screen), _palette(palette), _memoryUsed(0) {
+}
+
+GfxPictureCache::~GfxPictureCache() {
+	clear();
+}
+
+void GfxPictureCache::clear() {
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		delete *it;
+	_entries.clear();
+	_memoryUsed = 0;
+}
+
+void GfxPictureCache::applySideEffects(const PictureSideEffectList &sideEffects) {
+	for (PictureSideEffectList::const_iterator it = sideEffects.begin(); it != sideEffects.end(); ++it) {
+		const SciSpan<const byte> data(it->data.begin(), it->data.size());
+
+		switch (it->type) {
+		case PictureSideEffect::kSetPalette: {
+			Palette palette = it->palette;
+			_palette->set(&palette, true);
+			break;
+		}
+		case PictureSideEffect::kModifyAmigaPalette:
+			_palette->modifyAmigaPalette(data);
+			break;
+		case PictureSideEffect::kPriorityBandsRange:
+			_ports->priorityBandsInit(-1, it->top, it->bottom);
+			break;
+		case PictureSideEffect::kPriorityBandsTable:
+			_ports->priorityBandsInit(data);
+			break;
+		case PictureSideEffect::kPriorityBandsSci11:
+			_ports->priorityBandsInitSci11(data);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void GfxPictureCache::draw(GuiResourceId pictureId, bool mirroredFlag, bool addToFlag, int16 EGApaletteNo) {
+	const Port *port = _ports->getPort();
+
+	Key key;
+	key.pictureId = pictureId;
+	key.mirroredFlag = mirroredFlag;
+	key.addToFlag = addToFlag;
+	key.EGApaletteNo = EGApaletteNo;
+	key.portTop = port->top;
+	key.portLeft = port->left;
+	key.portRect = port->rect;
+	key.paletteMapValue = _screen->getCurPaletteMapValue();
+	key.unditheringEnabled = _screen->isUnditheringEnabled();
+	key.planesHash = _screen->hashDrawingPlanes();
+
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		Entry *entry = *it;
+		if (entry->key == key) {
+			debugC(kDebugLevelGraphics, "Drawing picture %d from cache", pictureId);
+			_screen->restoreDrawingPlanes(entry->planes);
+			applySideEffects(entry->sideEffects);
+			_entries.erase(it);
+			_entries.push_front(entry);
+			return;
+		}
+	}
+
+	const uint planesSize = _screen->getDrawingPlanesSize();
+
+	Entry *entry = new Entry();
+	entry->key = key;
+
+	GfxPicture *picture = new GfxPicture(_resMan, _coordAdjuster, _ports, _screen, _palette, pictureId);
+	picture->recordSideEffects(&entry->sideEffects);
+	picture->draw(mirroredFlag, addToFlag, EGApaletteNo);
+	delete picture;
+
+	if (planesSize > kPictureCacheBudget) {
+		delete entry;
+		return;
+	}
+
+	entry->planes = new byte[planesSize];
+	_screen->saveDrawingPlanes(entry->planes);
+
+	while (_memoryUsed + planesSize > kPictureCacheBudget) {
+		delete _entries.back();
+		_entries.pop_back();
+		_memoryUsed -= planesSize;
+	}
+
+	_entries.push_front(entry);
+	_memoryUsed += planesSize;
+}
+
 } // End of namespace Sci
@@ -22,7 +22,11 @@
 #ifndef SCI_GRAPHICS_PICTURE_H
 #define SCI_GRAPHICS_PICTURE_H
 
+#include "common/array.h"
+#include "common/list.h"
+#include "common/rect.h"
 #include "sci/util.h"
+#include "sci/graphics/helpers.h"
 
 namespace Sci {
 
@@ -43,6 +47,28 @@ class GfxCoordAdjuster16;
 class ResourceManager;
 class Resource;
 
+/**
+ * A change made by drawing a picture outside of the screen planes. These are
+ * recorded when a picture is cached, and repeated when it is drawn from the
+ * cache.
+ */
+struct PictureSideEffect {
+	enum Type {
+		kSetPalette,
+		kModifyAmigaPalette,
+		kPriorityBandsRange,
+		kPriorityBandsTable,
+		kPriorityBandsSci11
+	};
+
+	Type type;
+	Palette palette; // for kSetPalette
+	Common::Array<byte> data; // for kModifyAmigaPalette and the priority band tables
+	int16 top, bottom; // for kPriorityBandsRange
+};
+
+typedef Common::Array<PictureSideEffect> PictureSideEffectList;
+
 /**
  * Picture class, handles loading and displaying of picture resources
  *  every picture resource has its own instance of this class
@@ -55,7 +81,16 @@ public:
 	GuiResourceId getResourceId();
 	void draw(bool mirroredFlag, bool addToFlag, int16 EGApaletteNo);
 
+	// Records palette and priority band changes into the given list while drawing
+	void recordSideEffects(PictureSideEffectList *sideEffects) { _sideEffects = sideEffects; }
+
 private:
+	void setPalette(Palette &palette);
+	void modifyAmigaPalette(const SciSpan<const byte> &data);
+	void priorityBandsInit(int16 top, int16 bottom);
+	void priorityBandsInit(const SciSpan<const byte> &data);
+	void priorityBandsInitSci11(const SciSpan<const byte> &data);
+
 	void initData(GuiResourceId resourceId);
 	void reset();
 	void drawSci11Vga();
@@ -91,6 +126,63 @@ private:
 
 	// If true, we will show the whole EGA drawing process...
 	bool _EGAdrawingVisualize;
+
+	PictureSideEffectList *_sideEffects;
+};
+
+/**
+ * Keeps the screen planes resulting from drawing pictures, so that drawing
+ * the same picture again becomes a copy. The contents of the screen before
+ * drawing are part of the key, which covers pictures drawn on top of other
+ * pictures as well as anything drawn outside of the picture port.
+ */
+class GfxPictureCache {
+public:
+	GfxPictureCache(ResourceManager *resMan, GfxCoordAdjuster16 *coordAdjuster, GfxPorts *ports, GfxScreen *screen, GfxPalette *palette);
+	~GfxPictureCache();
+
+	// Same as GfxPicture::draw, using the cache when possible
+	void draw(GuiResourceId pictureId, bool mirroredFlag, bool addToFlag, int16 EGApaletteNo);
+
+	void clear();
+
+private:
+	struct Key {
+		GuiResourceId pictureId;
+		bool mirroredFlag;
+		bool addToFlag;
+		int16 EGApaletteNo;
+		int16 portTop, portLeft;
+		Common::Rect portRect;
+		byte paletteMapValue;
+		bool unditheringEnabled;
+		uint64 planesHash;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct Entry {
+		Key key;
+		byte *planes;
+		PictureSideEffectList sideEffects;
+
+		Entry() : planes(nullptr) {}
+		~Entry() { delete[] planes; }
+	};
+
+	typedef Common::List<Entry *> EntryList;
+
+	void applySideEffects(const PictureSideEffectList &sideEffects);
+
+	ResourceManager *_resMan;
+	GfxCoordAdjuster16 *_coordAdjuster;
+	GfxPorts *_ports;
+	GfxScreen *_screen;
+	GfxPalette *_palette;
+
+	// Most recently used entries first
+	EntryList _entries;
+	uint _memoryUsed;
 };
 
 } // End of namespace Sci
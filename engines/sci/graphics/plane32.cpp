@@ -430,6 +430,27 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	DrawList::size_type drawListSizePrimary = drawList.size();
 	const RectList::size_type eraseListCount = eraseList.size();
 
+	// Only unchanged items can be added to the draw list by the passes below,
+	// and in busy scenes most items are unchanged. Collect them once, in list
+	// order, along with their bounds, instead of rescanning the whole item
+	// list for every erase rect and draw item.
+	Common::Array<ScreenItemList::size_type> unchangedItems;
+	Common::Rect unchangedBounds;
+	for (ScreenItemList::size_type j = 0; j < screenItemCount && j < _screenItemList.size(); ++j) {
+		const ScreenItem *item = _screenItemList[j];
+		if (
+			item != nullptr &&
+			!item->_created && !item->_updated && !item->_deleted
+		) {
+			if (unchangedItems.empty()) {
+				unchangedBounds = item->_screenRect;
+			} else {
+				unchangedBounds.extend(item->_screenRect);
+			}
+			unchangedItems.push_back(j);
+		}
+	}
+
 	if (getSciVersion() == SCI_VERSION_3) {
 		_screenItemList.sort();
 		bool pictureDrawn = false;
@@ -477,13 +498,13 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		// Add all items overlapping the erase list to the draw list
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
-				ScreenItem *item = _screenItemList[j];
-				if (
-					item != nullptr &&
-					!item->_created && !item->_updated && !item->_deleted &&
-					rect.intersects(item->_screenRect)
-				) {
+			if (!rect.intersects(unchangedBounds)) {
+				continue;
+			}
+
+			for (uint k = 0; k < unchangedItems.size(); ++k) {
+				ScreenItem *item = _screenItemList[unchangedItems[k]];
+				if (rect.intersects(item->_screenRect)) {
 					drawList.add(item, rect.findIntersectingRect(item->_screenRect));
 				}
 			}
@@ -503,23 +524,19 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				drawListEntry = drawList[i];
 			}
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
-				ScreenItem *newItem = nullptr;
-				if (j < _screenItemList.size()) {
-					newItem = _screenItemList[j];
-				}
+			if (drawListEntry == nullptr || !drawListEntry->rect.intersects(unchangedBounds)) {
+				continue;
+			}
 
-				if (
-					drawListEntry != nullptr && newItem != nullptr &&
-					!newItem->_created && !newItem->_updated && !newItem->_deleted
-				) {
-					const ScreenItem *drawnItem = drawListEntry->screenItem;
+			const ScreenItem *drawnItem = drawListEntry->screenItem;
+			for (uint k = 0; k < unchangedItems.size(); ++k) {
+				const ScreenItemList::size_type j = unchangedItems[k];
+				const ScreenItem *newItem = _screenItemList[j];
 
-					if (newItem->hasPriorityAbove(*drawnItem) &&
-						drawListEntry->rect.intersects(newItem->_screenRect)
-					) {
-						mergeToDrawList(j, drawListEntry->rect.findIntersectingRect(newItem->_screenRect), drawList);
-					}
+				if (newItem->hasPriorityAbove(*drawnItem) &&
+					drawListEntry->rect.intersects(newItem->_screenRect)
+				) {
+					mergeToDrawList(j, drawListEntry->rect.findIntersectingRect(newItem->_screenRect), drawList);
 				}
 			}
 		}
@@ -1099,6 +1099,61 @@ void GfxScreen::bakDiscard() {
 	_backupScreen = nullptr;
 }
 
+uint GfxScreen::getDrawingPlanesSize() const {
+	uint size = _pixels * 3 + _displayPixels + sizeof(_ditheredPicColors);
+	if (_paletteMapScreen)
+		size += _displayPixels;
+	return size;
+}
+
+void GfxScreen::saveDrawingPlanes(byte *target) const {
+	memcpy(target, _visualScreen, _pixels); target += _pixels;
+	memcpy(target, _priorityScreen, _pixels); target += _pixels;
+	memcpy(target, _controlScreen, _pixels); target += _pixels;
+	memcpy(target, _displayScreen, _displayPixels); target += _displayPixels;
+	if (_paletteMapScreen) {
+		memcpy(target, _paletteMapScreen, _displayPixels); target += _displayPixels;
+	}
+	memcpy(target, _ditheredPicColors, sizeof(_ditheredPicColors));
+}
+
+void GfxScreen::restoreDrawingPlanes(const byte *source) {
+	memcpy(_visualScreen, source, _pixels); source += _pixels;
+	memcpy(_priorityScreen, source, _pixels); source += _pixels;
+	memcpy(_controlScreen, source, _pixels); source += _pixels;
+	memcpy(_displayScreen, source, _displayPixels); source += _displayPixels;
+	if (_paletteMapScreen) {
+		memcpy(_paletteMapScreen, source, _displayPixels); source += _displayPixels;
+	}
+	memcpy(_ditheredPicColors, source, sizeof(_ditheredPicColors));
+}
+
+// 64-bit FNV-1a over 32-bit words, with the remaining bytes hashed one by one
+static uint64 hashBuffer(uint64 hash, const byte *data, uint size) {
+	const uint64 prime = 0x100000001B3ULL;
+	uint i = 0;
+	for (; i + 4 <= size; i += 4) {
+		hash ^= READ_UINT32(data + i);
+		hash *= prime;
+	}
+	for (; i < size; ++i) {
+		hash ^= data[i];
+		hash *= prime;
+	}
+	return hash;
+}
+
+uint64 GfxScreen::hashDrawingPlanes() const {
+	uint64 hash = 0xCBF29CE484222325ULL;
+	hash = hashBuffer(hash, _visualScreen, _pixels);
+	hash = hashBuffer(hash, _priorityScreen, _pixels);
+	hash = hashBuffer(hash, _controlScreen, _pixels);
+	hash = hashBuffer(hash, _displayScreen, _displayPixels);
+	if (_paletteMapScreen)
+		hash = hashBuffer(hash, _paletteMapScreen, _displayPixels);
+	return hashBuffer(hash, (const byte *)_ditheredPicColors, sizeof(_ditheredPicColors));
+}
+
 void GfxScreen::bakCopyRectToScreen(const Common::Rect &rect, int16 x, int16 y) {
 	assert(_backupScreen);
 	const byte *ptr = _backupScreen;
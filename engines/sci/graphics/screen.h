@@ -91,6 +91,14 @@ public:
 	void bakCopyRectToScreen(const Common::Rect &rect, int16 x, int16 y);
 	void bakDiscard();
 
+	// functions to save and restore everything picture drawing modifies:
+	// the visual, priority, control and display screens, the palette map
+	// and the dithering statistics (for the picture cache)
+	uint getDrawingPlanesSize() const;
+	void saveDrawingPlanes(byte *target) const;
+	void restoreDrawingPlanes(const byte *source);
+	uint64 hashDrawingPlanes() const;
+
 	// video frame displaying
 	void copyVideoFrameToScreen(const byte *buffer, int pitch, const Common::Rect &rect, bool is8bit);
 
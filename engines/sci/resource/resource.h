@@ -309,6 +309,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	Common::List<Resource *>::iterator _lruPosition; /**< Position in the LRU list while enqueued */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -374,6 +375,13 @@ public:
 	 */
 	Resource *findResource(ResourceId id, bool lock);
 
+	/**
+	 * Loads a resource into the LRU cache ahead of its use, without locking
+	 * it. Does nothing if the resource doesn't exist or is already loaded.
+	 * @param id	The resource to load
+	 */
+	void prefetchResource(ResourceId id);
+
 	/**
 	 * Unlocks a previously locked resource.
 	 * @param res	The resource to free
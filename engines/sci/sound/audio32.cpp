@@ -188,6 +188,7 @@ Audio32::Audio32(ResourceManager *resMan) :
 	_mixer(g_system->getMixer()),
 	_handle(),
 	_mutex(),
+	_decodedCache(1024 * 1024, 256 * 1024),
 
 	_channels(getSciVersion() < SCI_VERSION_2_1_EARLY ? 10 : getSciVersion() < SCI_VERSION_3 ? 5 : 8),
 	_numActiveChannels(0),
@@ -232,9 +233,9 @@ Audio32::~Audio32() {
 #pragma mark -
 #pragma mark AudioStream implementation
 
-int Audio32::writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, Audio::st_sample_t *targetBuffer, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume) {
+int Audio32::writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, int32 *targetBuffer, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume) {
 	const int samplePairsToRead = numSamples >> 1;
-	const int samplePairsWritten = converter.convert(sourceStream, targetBuffer, samplePairsToRead, leftVolume, rightVolume);
+	const int samplePairsWritten = converter.mix(sourceStream, targetBuffer, samplePairsToRead, leftVolume, rightVolume);
 	return samplePairsWritten << 1;
 }
 
@@ -304,10 +305,15 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 
 	const bool playOnlyMonitoredChannel = getSciVersion() != SCI_VERSION_3 && _monitoredChannelIndex != -1;
 
+	// Channels are mixed into an unsaturated 32-bit buffer, which is clamped
+	// into the output buffer only once after all channels have been mixed.
 	// The caller of `readBuffer` is a rate converter, which reuses (without
-	// clearing) an intermediate buffer, so we need to zero the intermediate
-	// buffer to prevent mixing into audio data from the last callback.
-	memset(buffer, 0, numSamples * sizeof(Audio::st_sample_t));
+	// clearing) an intermediate buffer, so the whole output buffer is written
+	// to prevent leaving audio data from the last callback in it.
+	if (numSamples > (int)_mixBuffer.size()) {
+		_mixBuffer.resize(numSamples);
+	}
+	memset(_mixBuffer.data(), 0, numSamples * sizeof(int32));
 
 	// This emulates the attenuated mixing mode of SSCI engine, which reduces
 	// the volume of the target buffer when each new channel is mixed in.
@@ -413,14 +419,21 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			if (numSamples > (int)_monitoredBuffer.size()) {
 				_monitoredBuffer.resize(numSamples);
 			}
-			memset(_monitoredBuffer.data(), 0, _monitoredBuffer.size() * sizeof(Audio::st_sample_t));
-			_numMonitoredSamples = writeAudioInternal(*channel.stream, *channel.converter, _monitoredBuffer.data(), numSamples, leftVolume, rightVolume);
+			if (numSamples > (int)_monitoredMixBuffer.size()) {
+				_monitoredMixBuffer.resize(numSamples);
+			}
+			memset(_monitoredMixBuffer.data(), 0, numSamples * sizeof(int32));
+			_numMonitoredSamples = writeAudioInternal(*channel.stream, *channel.converter, _monitoredMixBuffer.data(), numSamples, leftVolume, rightVolume);
+
+			// The monitoring buffer holds the saturated samples of the
+			// channel, like the output of the channel would be on its own
+			Audio::clampSamples(_monitoredBuffer.data(), _monitoredMixBuffer.data(), _numMonitoredSamples);
 
-			Audio::st_sample_t *sourceBuffer = _monitoredBuffer.data();
-			Audio::st_sample_t *targetBuffer = buffer;
-			const Audio::st_sample_t *const end = _monitoredBuffer.data() + _numMonitoredSamples;
+			const int32 *sourceBuffer = _monitoredMixBuffer.data();
+			int32 *targetBuffer = _mixBuffer.data();
+			const int32 *const end = _monitoredMixBuffer.data() + _numMonitoredSamples;
 			while (sourceBuffer != end) {
-				Audio::clampedAdd(*targetBuffer++, *sourceBuffer++);
+				*targetBuffer++ += *sourceBuffer++;
 			}
 
 			if (_numMonitoredSamples > maxSamplesWritten) {
@@ -437,13 +450,15 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 				leftVolume = rightVolume = 0;
 			}
 
-			const int channelSamplesWritten = writeAudioInternal(*channel.stream, *channel.converter, buffer, numSamples, leftVolume, rightVolume);
+			const int channelSamplesWritten = writeAudioInternal(*channel.stream, *channel.converter, _mixBuffer.data(), numSamples, leftVolume, rightVolume);
 			if (channelSamplesWritten > maxSamplesWritten) {
 				maxSamplesWritten = channelSamplesWritten;
 			}
 		}
 	}
 
+	Audio::clampSamples(buffer, _mixBuffer.data(), numSamples);
+
 	_inAudioThread = false;
 
 	return maxSamplesWritten;
@@ -833,31 +848,36 @@ uint16 Audio32::play(int16 channelIndex, const ResourceId resourceId, const bool
 		_monitoredChannelIndex = channelIndex;
 	}
 
-	Common::SeekableReadStream *dataStream = resource->makeStream();
+	// Short SOL resources are kept decoded, since sound effects are often
+	// replayed many times in a row
+	const Common::String cacheName = resourceId.toString();
+	Audio::RewindableAudioStream *audioStream = _decodedCache.get(cacheName, 0);
 
-	Audio::RewindableAudioStream *audioStream;
+	if (audioStream == nullptr) {
+		Common::SeekableReadStream *dataStream = resource->makeStream();
 
-	if (detectSolAudio(*dataStream)) {
-		audioStream = makeSOLStream(dataStream, DisposeAfterUse::YES);
-	} else if (detectWaveAudio(*dataStream)) {
-		audioStream = Audio::makeWAVStream(dataStream, DisposeAfterUse::YES);
-	} else if (detectAIFFAudio(*dataStream)) {
-		audioStream = Audio::makeAIFFStream(dataStream, DisposeAfterUse::YES);
-	} else if (detectMacSndAudio(*dataStream)) {
-		audioStream = Audio::makeMacSndStream(dataStream, DisposeAfterUse::YES);
-	} else {
-		byte flags = Audio::FLAG_LITTLE_ENDIAN;
-		if (_globalBitDepth == 16) {
-			flags |= Audio::FLAG_16BITS;
+		if (detectSolAudio(*dataStream)) {
+			audioStream = _decodedCache.add(cacheName, 0, makeSOLStream(dataStream, DisposeAfterUse::YES));
+		} else if (detectWaveAudio(*dataStream)) {
+			audioStream = Audio::makeWAVStream(dataStream, DisposeAfterUse::YES);
+		} else if (detectAIFFAudio(*dataStream)) {
+			audioStream = Audio::makeAIFFStream(dataStream, DisposeAfterUse::YES);
+		} else if (detectMacSndAudio(*dataStream)) {
+			audioStream = Audio::makeMacSndStream(dataStream, DisposeAfterUse::YES);
 		} else {
-			flags |= Audio::FLAG_UNSIGNED;
-		}
+			byte flags = Audio::FLAG_LITTLE_ENDIAN;
+			if (_globalBitDepth == 16) {
+				flags |= Audio::FLAG_16BITS;
+			} else {
+				flags |= Audio::FLAG_UNSIGNED;
+			}
 
-		if (_globalNumOutputChannels == 2) {
-			flags |= Audio::FLAG_STEREO;
-		}
+			if (_globalNumOutputChannels == 2) {
+				flags |= Audio::FLAG_STEREO;
+			}
 
-		audioStream = Audio::makeRawStream(dataStream, _globalSampleRate, flags, DisposeAfterUse::YES);
+			audioStream = Audio::makeRawStream(dataStream, _globalSampleRate, flags, DisposeAfterUse::YES);
+		}
 	}
 
 	channel.stream.reset(new MutableLoopAudioStream(audioStream, loop));
@@ -22,6 +22,7 @@
 #ifndef SCI_AUDIO32_H
 #define SCI_AUDIO32_H
 #include "audio/audiostream.h"     // for AudioStream, SeekableAudioStream (...
+#include "audio/decoded_cache.h"   // for DecodedCache
 #include "audio/mixer.h"           // for Mixer, SoundHandle
 #include "audio/rate.h"            // for Audio::st_volume_t, RateConverter
 #include "common/array.h"          // for Array
@@ -192,6 +193,12 @@ private:
 	Audio::SoundHandle _handle;
 	Common::Mutex _mutex;
 
+	/**
+	 * Decoded PCM data of recently played short SOL resources, so sound
+	 * effects which are played over and over are only decompressed once.
+	 */
+	Audio::DecodedCache _decodedCache;
+
 #pragma mark -
 #pragma mark AudioStream implementation
 public:
@@ -215,10 +222,16 @@ private:
 	bool channelShouldMix(const AudioChannel &channel) const;
 
 	/**
-	 * Mixes audio from the given source stream into the target buffer using the
-	 * given rate converter.
+	 * Mixes audio from the given source stream into the unsaturated target
+	 * mixing buffer using the given rate converter.
 	 */
-	int writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, Audio::st_sample_t *targetBuffer, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume);
+	int writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, int32 *targetBuffer, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume);
+
+	/**
+	 * The unsaturated buffer all channels are mixed into before being written
+	 * to the output buffer.
+	 */
+	Common::Array<int32> _mixBuffer;
 
 #pragma mark -
 #pragma mark Channel management
@@ -628,6 +641,11 @@ private:
 	 */
 	Common::Array<Audio::st_sample_t> _monitoredBuffer;
 
+	/**
+	 * The unsaturated mixing buffer for the monitored channel.
+	 */
+	Common::Array<int32> _monitoredMixBuffer;
+
 	/**
 	 * The number of valid audio samples in the signal monitoring buffer.
 	 */
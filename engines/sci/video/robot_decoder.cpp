@@ -29,6 +29,7 @@
 #include "common/str.h"              // for String
 #include "common/stream.h"           // for SeekableReadStream, SeekableReadStreamEndianWrapper
 #include "common/textconsole.h"      // for error, warning
+#include "common/system.h"           // for OSystem::getThreadPool
 #include "common/types.h"            // for Flag::NO, Flag::YES
 #include "sci/engine/seg_manager.h"  // for SegManager
 #include "sci/graphics/celobj32.h"   // for Ratio, ::kLowResX, ::kLowResY
@@ -349,7 +350,8 @@ RobotDecoder::RobotDecoder(SegManager *segMan) :
 	_segMan(segMan),
 	_status(kRobotStatusUninitialized),
 	_audioBuffer(nullptr),
-	_rawPalette((uint8 *)malloc(kRawPaletteSize)) {}
+	_rawPalette((uint8 *)malloc(kRawPaletteSize)),
+	_prefetchGroup(g_system->getThreadPool()) {}
 
 RobotDecoder::~RobotDecoder() {
 	close();
@@ -585,6 +587,8 @@ void RobotDecoder::close() {
 
 	debugC(kDebugLevelVideo, "Closing robot");
 
+	flushPrefetchedCels();
+
 	for (CelHandleList::size_type i = 0; i < _celHandles.size(); ++i) {
 		if (_celHandles[i].status == CelHandleInfo::kFrameLifetime) {
 			_segMan->freeBitmap(_celHandles[i].bitmapId);
@@ -627,6 +631,8 @@ void RobotDecoder::pause() {
 		return;
 	}
 
+	flushPrefetchedCels();
+
 	if (_hasAudio) {
 		_audioList.stopAudioNow();
 	}
@@ -676,6 +682,7 @@ void RobotDecoder::showFrame(const uint16 frameNo, const uint16 newX, const uint
 	pause();
 
 	if (frameNo != _previousFrameNo) {
+		flushPrefetchedCels();
 		seekToFrame(frameNo);
 		doVersion5(false);
 	} else {
@@ -1247,6 +1254,8 @@ void RobotDecoder::doRobot() {
 	if (_hasAudio) {
 		_audioList.submitDriverMax();
 	}
+
+	prefetchCels(_currentFrameNo + 1);
 }
 
 void RobotDecoder::frameAlmostVisible() {
@@ -1330,10 +1339,14 @@ void RobotDecoder::frameNowVisible() {
 	}
 }
 
-void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight) const {
+/**
+ * Scales a cel squashed vertically by `verticalScaleFactor` back to its
+ * original dimensions.
+ */
+static void expandSquashedCel(byte *target, const byte *source, const int16 celWidth, const int16 celHeight, const uint8 verticalScaleFactor) {
 	assert(source != nullptr && target != nullptr);
 
-	const int sourceHeight = (celHeight * _verticalScaleFactor) / 100;
+	const int sourceHeight = (celHeight * verticalScaleFactor) / 100;
 	assert(sourceHeight > 0);
 
 	const int16 numerator = celHeight;
@@ -1353,6 +1366,10 @@ void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWi
 	}
 }
 
+void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight) const {
+	expandSquashedCel(target, source, celWidth, celHeight, _verticalScaleFactor);
+}
+
 int16 RobotDecoder::getPriority() const {
 	return _priority;
 }
@@ -1364,12 +1381,18 @@ void RobotDecoder::setPriority(const int16 newPriority) {
 void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	const RobotScreenItemList::size_type oldScreenItemCount = _screenItemList.size();
 	const int videoSize = _videoSizes[_currentFrameNo];
-	_doVersion5Scratch.resize(videoSize);
+	const byte *prefetchedPixels = takePrefetchedCels(_currentFrameNo);
 
-	byte *videoFrameData = _doVersion5Scratch.begin();
+	byte *videoFrameData;
+	if (prefetchedPixels) {
+		videoFrameData = _prefetchJob.rawVideoData.begin();
+	} else {
+		_doVersion5Scratch.resize(videoSize);
+		videoFrameData = _doVersion5Scratch.begin();
 
-	if (!_stream->read(videoFrameData, videoSize)) {
-		error("RobotDecoder::doVersion5: Read error");
+		if (!_stream->read(videoFrameData, videoSize)) {
+			error("RobotDecoder::doVersion5: Read error");
+		}
 	}
 
 	const RobotScreenItemList::size_type screenItemCount = READ_SCI11ENDIAN_UINT16(videoFrameData);
@@ -1394,7 +1417,7 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 		_originalScreenItemY.resize(screenItemCount);
 	}
 
-	createCels5(videoFrameData + 2, screenItemCount, true);
+	createCels5(videoFrameData + 2, screenItemCount, true, prefetchedPixels);
 	for (RobotScreenItemList::size_type i = 0; i < screenItemCount; ++i) {
 		Common::Point position(_screenItemX[i], _screenItemY[i]);
 
@@ -1447,14 +1470,39 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	}
 }
 
-void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette) {
+void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *prefetchedPixels) {
 	preallocateCelMemory(rawVideoData, numCels);
 	for (int16 i = 0; i < numCels; ++i) {
-		rawVideoData += createCel5(rawVideoData, i, usePalette);
+		rawVideoData += createCel5(rawVideoData, i, usePalette, prefetchedPixels);
+	}
+}
+
+void RobotDecoder::decompressCelChunks(DecompressorLZS &decompressor, const byte *rawVideoData, const int16 numDataChunks, byte *targetBuffer) {
+	for (int i = 0; i < numDataChunks; ++i) {
+		uint compressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData);
+		uint decompressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
+		uint16 compressionType = READ_SCI11ENDIAN_UINT16(rawVideoData + 8);
+		rawVideoData += 10;
+
+		switch (compressionType) {
+		case kCompressionLZS: {
+			Common::MemoryReadStream videoDataStream(rawVideoData, compressedSize, DisposeAfterUse::NO);
+			decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize);
+			break;
+		}
+		case kCompressionNone:
+			Common::copy(rawVideoData, rawVideoData + decompressedSize, targetBuffer);
+			break;
+		default:
+			error("Unknown compression type %d!", compressionType);
+		}
+
+		rawVideoData += compressedSize;
+		targetBuffer += decompressedSize;
 	}
 }
 
-uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette) {
+uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *&prefetchedPixels) {
 	_verticalScaleFactor = rawVideoData[1];
 	const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
 	const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
@@ -1513,41 +1561,26 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	assert(bitmap.getHunkPaletteOffset() == (uint32)bitmap.getWidth() * bitmap.getHeight() + SciBitmap::getBitmapHeaderSize());
 	bitmap.setOrigin(origin);
 
-	byte *targetBuffer;
-	if (_verticalScaleFactor == 100) {
-		// direct copy to bitmap
-		targetBuffer = bitmap.getPixels();
+	if (prefetchedPixels) {
+		const uint area = celWidth * celHeight;
+		Common::copy(prefetchedPixels, prefetchedPixels + area, bitmap.getPixels());
+		prefetchedPixels += area;
 	} else {
-		// go through squashed cel decompressor
-		_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
-		targetBuffer = _celDecompressionBuffer.begin();
-	}
-
-	for (int i = 0; i < numDataChunks; ++i) {
-		uint compressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData);
-		uint decompressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
-		uint16 compressionType = READ_SCI11ENDIAN_UINT16(rawVideoData + 8);
-		rawVideoData += 10;
-
-		switch (compressionType) {
-		case kCompressionLZS: {
-			Common::MemoryReadStream videoDataStream(rawVideoData, compressedSize, DisposeAfterUse::NO);
-			_decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize);
-			break;
-		}
-		case kCompressionNone:
-			Common::copy(rawVideoData, rawVideoData + decompressedSize, targetBuffer);
-			break;
-		default:
-			error("Unknown compression type %d!", compressionType);
+		byte *targetBuffer;
+		if (_verticalScaleFactor == 100) {
+			// direct copy to bitmap
+			targetBuffer = bitmap.getPixels();
+		} else {
+			// go through squashed cel decompressor
+			_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
+			targetBuffer = _celDecompressionBuffer.begin();
 		}
 
-		rawVideoData += compressedSize;
-		targetBuffer += decompressedSize;
-	}
+		decompressCelChunks(_decompressor, rawVideoData, numDataChunks, targetBuffer);
 
-	if (_verticalScaleFactor != 100) {
-		expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		if (_verticalScaleFactor != 100) {
+			expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		}
 	}
 
 	if (usePalette) {
@@ -1624,4 +1657,151 @@ void RobotDecoder::preallocateCelMemory(const byte *rawVideoData, const int16 nu
 	}
 }
 
+#pragma mark -
+#pragma mark RobotDecoder - Cel prefetching
+
+void RobotDecoder::CelPrefetchJob::run() {
+	failed = !decompressCels();
+}
+
+bool RobotDecoder::CelPrefetchJob::decompressCels() {
+	const byte *rawData = rawVideoData.begin();
+	const byte *const rawDataEnd = rawVideoData.end();
+
+	if (rawVideoData.size() < 2) {
+		return false;
+	}
+
+	const int16 numCels = READ_SCI11ENDIAN_UINT16(rawData);
+	if (numCels > kScreenItemListSize) {
+		return false;
+	}
+
+	// Verify the layout of the frame first, since errors can't be raised
+	// from a worker thread; the engine reports them when it decompresses
+	// the frame itself
+	uint totalArea = 0;
+	uint maxSquashedArea = 0;
+	const byte *celData = rawData + 2;
+	for (int16 i = 0; i < numCels; ++i) {
+		if (rawDataEnd - celData < kCelHeaderSize) {
+			return false;
+		}
+
+		const uint8 verticalScaleFactor = celData[1];
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(celData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(celData + 4);
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(celData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(celData + 16);
+
+		if (celWidth <= 0 || celHeight <= 0 || rawDataEnd - celData < kCelHeaderSize + dataSize) {
+			return false;
+		}
+
+		const uint area = celWidth * celHeight;
+		uint decodedArea = area;
+		if (verticalScaleFactor != 100) {
+			const int sourceHeight = (celHeight * verticalScaleFactor) / 100;
+			if (sourceHeight <= 0) {
+				return false;
+			}
+			decodedArea = celWidth * sourceHeight;
+			maxSquashedArea = MAX(maxSquashedArea, decodedArea);
+		}
+
+		const byte *chunk = celData + kCelHeaderSize;
+		uint decompressedTotal = 0;
+		for (int16 j = 0; j < numDataChunks; ++j) {
+			if (rawDataEnd - chunk < 10) {
+				return false;
+			}
+
+			const uint compressedSize = READ_SCI11ENDIAN_UINT32(chunk);
+			const uint decompressedSize = READ_SCI11ENDIAN_UINT32(chunk + 4);
+			const uint16 compressionType = READ_SCI11ENDIAN_UINT16(chunk + 8);
+			chunk += 10;
+
+			if ((compressionType != kCompressionLZS && compressionType != kCompressionNone) ||
+				(uint)(rawDataEnd - chunk) < compressedSize ||
+				decompressedSize > decodedArea - decompressedTotal) {
+				return false;
+			}
+
+			chunk += compressedSize;
+			decompressedTotal += decompressedSize;
+		}
+
+		totalArea += area;
+		celData += kCelHeaderSize + dataSize;
+	}
+
+	pixels.resize(totalArea);
+	_squashedCel.resize(maxSquashedArea);
+
+	byte *target = pixels.begin();
+	celData = rawData + 2;
+	for (int16 i = 0; i < numCels; ++i) {
+		const uint8 verticalScaleFactor = celData[1];
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(celData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(celData + 4);
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(celData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(celData + 16);
+
+		if (verticalScaleFactor == 100) {
+			decompressCelChunks(_decompressor, celData + kCelHeaderSize, numDataChunks, target);
+		} else {
+			decompressCelChunks(_decompressor, celData + kCelHeaderSize, numDataChunks, _squashedCel.begin());
+			expandSquashedCel(target, _squashedCel.begin(), celWidth, celHeight, verticalScaleFactor);
+		}
+
+		target += celWidth * celHeight;
+		celData += kCelHeaderSize + dataSize;
+	}
+
+	return true;
+}
+
+void RobotDecoder::prefetchCels(const int frameNo) {
+	if (frameNo >= _numFramesTotal || g_system->getThreadPool().getWorkerCount() == 0) {
+		return;
+	}
+
+	flushPrefetchedCels();
+
+	const int videoSize = _videoSizes[frameNo];
+	_prefetchJob.rawVideoData.resize(videoSize);
+
+	if (!_stream->seek(_recordPositions[frameNo], SEEK_SET) ||
+		_stream->read(_prefetchJob.rawVideoData.begin(), videoSize) != (uint32)videoSize) {
+		// Let doVersion5 report the error if the frame is actually shown
+		return;
+	}
+
+	_prefetchJob.frameNo = frameNo;
+	_prefetchJob.failed = false;
+	_prefetchGroup.run(&_prefetchJob);
+}
+
+const byte *RobotDecoder::takePrefetchedCels(const int frameNo) {
+	if (_prefetchJob.frameNo == -1) {
+		return nullptr;
+	}
+
+	_prefetchGroup.wait();
+
+	if (_prefetchJob.frameNo != frameNo || _prefetchJob.failed) {
+		debugC(kDebugLevelVideo, "Discarding prefetched frame %d for frame %d", _prefetchJob.frameNo, frameNo);
+		_prefetchJob.frameNo = -1;
+		return nullptr;
+	}
+
+	_prefetchJob.frameNo = -1;
+	return _prefetchJob.pixels.begin();
+}
+
+void RobotDecoder::flushPrefetchedCels() {
+	_prefetchGroup.wait();
+	_prefetchJob.frameNo = -1;
+}
+
 } // End of namespace Sci
@@ -28,6 +28,7 @@
 #include "common/mutex.h"                // for StackLock, Mutex
 #include "common/rect.h"                 // for Point, Rect (ptr only)
 #include "common/scummsys.h"             // for int16, int32, byte, uint16
+#include "common/threadpool.h"           // for Job, TaskGroup
 #include "sci/engine/vm_types.h"         // for NULL_REG, reg_t
 #include "sci/graphics/helpers.h"        // for GuiResourceId
 #include "sci/graphics/screen_item32.h"  // for ScaleInfo, ScreenItem (ptr o...
@@ -1217,20 +1218,87 @@ private:
 	/**
 	 * Creates screen items for a version 5/6 robot.
 	 */
-	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette);
+	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *prefetchedPixels = nullptr);
 
 	/**
-	 * Creates a single screen item for a cel in a version 5/6 robot.
+	 * Creates a single screen item for a cel in a version 5/6 robot. If
+	 * `prefetchedPixels` is not null, the pixels of the cel are copied from
+	 * there instead of being decompressed, and the pointer is advanced past
+	 * them.
 	 *
 	 * Returns the size, in bytes, of the raw cel data.
 	 */
-	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette);
+	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *&prefetchedPixels);
+
+	/**
+	 * Decompresses the data chunks of a cel, which follow its header.
+	 */
+	static void decompressCelChunks(DecompressorLZS &decompressor, const byte *rawVideoData, const int16 numDataChunks, byte *targetBuffer);
 
 	/**
 	 * Preallocates memory for the next `numCels` cels in the robot data stream.
 	 */
 	void preallocateCelMemory(const byte *rawVideoData, const int16 numCels);
 
+	/**
+	 * Decompresses all cels of a video frame into a private buffer on a
+	 * worker thread. The screen items keep showing the bitmaps of the
+	 * current frame until the engine copies the pixels over.
+	 */
+	class CelPrefetchJob : public Common::Job {
+	public:
+		/**
+		 * The frame being decompressed, or -1 if there is none.
+		 */
+		int frameNo;
+
+		/**
+		 * The raw video data of the frame.
+		 */
+		ScratchMemory rawVideoData;
+
+		/**
+		 * The decompressed and unsquashed pixels of every cel, in the order of
+		 * the cels in the frame.
+		 */
+		ScratchMemory pixels;
+
+		/**
+		 * Whether the frame data could not be decompressed, in which case the
+		 * frame must be decompressed by the engine.
+		 */
+		bool failed;
+
+		CelPrefetchJob() : frameNo(-1), failed(false) {}
+
+		void run() override;
+
+	private:
+		DecompressorLZS _decompressor;
+		ScratchMemory _squashedCel;
+
+		bool decompressCels();
+	};
+
+	/**
+	 * Reads the video data of the given frame and starts decompressing its
+	 * cels on a worker thread. Does nothing if there are no worker threads.
+	 */
+	void prefetchCels(const int frameNo);
+
+	/**
+	 * Waits for the prefetched frame and returns its decompressed pixels if it
+	 * is the given frame. Otherwise, or if a different frame was prefetched,
+	 * returns null and the prefetched frame is discarded.
+	 */
+	const byte *takePrefetchedCels(const int frameNo);
+
+	/**
+	 * Waits for and discards the prefetched frame. Used whenever playback
+	 * stops or jumps to a different frame.
+	 */
+	void flushPrefetchedCels();
+
 	/**
 	 * The decompressor for LZS-compressed cels.
 	 */
@@ -1366,6 +1434,17 @@ private:
 	 * dimensions.
 	 */
 	uint8 _verticalScaleFactor;
+
+	/**
+	 * The cels of the frame expected to be shown next, decompressed ahead of
+	 * time when there are worker threads.
+	 */
+	CelPrefetchJob _prefetchJob;
+
+	/**
+	 * The task group running `_prefetchJob`.
+	 */
+	Common::TaskGroup _prefetchGroup;
 };
 } // end of namespace Sci
 #endif
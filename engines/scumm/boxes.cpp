@@ -583,7 +583,46 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	return true;
 }
 
+void ScummEngine::invalidateBoxCache() {
+	_boxRoutes.clear();
+	_boxCorners.clear();
+}
+
+void ScummEngine::cacheBoxCorners(int numOfBoxes) {
+	_boxCorners.resize(numOfBoxes * 4);
+	for (int i = 0; i < numOfBoxes; i++) {
+		const BoxCoords box = decodeBoxCoordinates(i);
+		_boxCorners[i * 4 + 0] = box.ul;
+		_boxCorners[i * 4 + 1] = box.ur;
+		_boxCorners[i * 4 + 2] = box.ll;
+		_boxCorners[i * 4 + 3] = box.lr;
+	}
+}
+
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	// Actors look up the boxes they walk in at every step, so the corners
+	// are only decoded once per box set. Out of range requests take the
+	// slow path, which knows the workarounds for them.
+	if (_boxCorners.empty()) {
+		const int numOfBoxes = getNumBoxes();
+		if (numOfBoxes > 0)
+			cacheBoxCorners(numOfBoxes);
+	}
+
+	if (boxnum >= 0 && (uint)boxnum * 4 < _boxCorners.size()) {
+		const Common::Point *corners = &_boxCorners[boxnum * 4];
+		BoxCoords box;
+		box.ul = corners[0];
+		box.ur = corners[1];
+		box.ll = corners[2];
+		box.lr = corners[3];
+		return box;
+	}
+
+	return decodeBoxCoordinates(boxnum);
+}
+
+BoxCoords ScummEngine::decodeBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -728,9 +767,7 @@ byte *ScummEngine::getBoxConnectionBase(int box) {
  */
 int ScummEngine::getNextBox(byte from, byte to) {
 	const byte *boxm;
-	byte i;
 	const int numOfBoxes = getNumBoxes();
-	int dest = -1;
 
 	if (from == to)
 		return to;
@@ -766,6 +803,27 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		return (int8)boxm[to];
 	}
 
+	// WORKAROUND #2: In addition to the truncated matrix handled by
+	// cacheBoxRoutes(), we have to add this special case to fix the scene
+	// in Indy3 where Indy meets Hitler in Berlin.
+	// See bug #1017 and also bug #1052.
+	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+		return 0;
+
+	if (_boxRoutes.size() != (uint)(numOfBoxes * numOfBoxes))
+		cacheBoxRoutes(numOfBoxes);
+
+	return _boxRoutes[from * numOfBoxes + to];
+}
+
+/**
+ * Expand the compressed box matrix (see createBoxMatrix) into a table
+ * holding the next box for every pair of boxes, so that walking actors
+ * don't have to scan the matrix rows on every step.
+ */
+void ScummEngine::cacheBoxRoutes(int numOfBoxes) {
+	const byte *boxm = getBoxMatrixBaseAddr();
+
 	// WORKAROUND #1: It seems that in some cases, the box matrix is corrupt
 	// (more precisely, is too short) in the datafiles already. In
 	// particular this seems to be the case in room 46 of Indy3 EGA (see
@@ -776,33 +834,30 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	// since random data may follow after the resource in ScummVM.
 	//
 	// As a workaround, we add a check for the end of the box matrix
-	// resource, and abort the search once we reach the end.
+	// resource, and treat all entries past the end as missing.
 	const byte *end = boxm + getResourceSize(rtMatrix, 1);
+	bool truncated = false;
 
-	// WORKAROUND #2: In addition to the above, we have to add this special
-	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
-	// See bug #1017 and also bug #1052.
-	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
-		return 0;
+	_boxRoutes.resize(numOfBoxes * numOfBoxes);
+
+	for (int from = 0; from < numOfBoxes; from++) {
+		int8 *routes = &_boxRoutes[from * numOfBoxes];
+		memset(routes, -1, numOfBoxes);
 
-	// Skip up to the matrix data for box 'from'
-	for (i = 0; i < from && boxm < end; i++) {
-		while (boxm < end && *boxm != 0xFF)
+		// Later entries take precedence over earlier ones
+		while (boxm < end && boxm[0] != 0xFF) {
+			for (int to = boxm[0]; to <= boxm[1] && to < numOfBoxes; to++)
+				routes[to] = (int8)boxm[2];
 			boxm += 3;
-		boxm++;
-	}
+		}
 
-	// Now search for the entry for box 'to'
-	while (boxm < end && boxm[0] != 0xFF) {
-		if (boxm[0] <= to && to <= boxm[1])
-			dest = (int8)boxm[2];
-		boxm += 3;
+		if (boxm >= end)
+			truncated = true;
+		boxm++;
 	}
 
-	if (boxm >= end)
+	if (truncated)
 		debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
-
-	return dest;
 }
 
 /*
@@ -39,6 +39,8 @@
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -73,6 +75,8 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("actors",    WRAP_METHOD(ScummDebugger, Cmd_PrintActor));
 	registerCmd("box",       WRAP_METHOD(ScummDebugger, Cmd_PrintBox));
 	registerCmd("matrix",    WRAP_METHOD(ScummDebugger, Cmd_PrintBoxMatrix));
+	registerCmd("walkbench", WRAP_METHOD(ScummDebugger, Cmd_WalkBench));
+	registerCmd("roombench", WRAP_METHOD(ScummDebugger, Cmd_RoomBench));
 	registerCmd("camera",    WRAP_METHOD(ScummDebugger, Cmd_Camera));
 	registerCmd("room",      WRAP_METHOD(ScummDebugger, Cmd_Room));
 	registerCmd("objects",   WRAP_METHOD(ScummDebugger, Cmd_PrintObjects));
@@ -106,6 +110,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 #endif
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("resources",       WRAP_METHOD(ScummDebugger, Cmd_Resources));
 }
 
 void ScummDebugger::preEnter() {
@@ -1104,6 +1109,111 @@ bool ScummDebugger::Cmd_PrintBoxMatrix(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_WalkBench(int argc, const char **argv) {
+	const int num = _vm->getNumBoxes();
+	const int iterations = (argc > 1) ? atoi(argv[1]) : 100;
+
+	if (num == 0 || iterations <= 0) {
+		debugPrintf("Usage: %s [<iterations>] (needs a room with walkboxes)\n", argv[0]);
+		return true;
+	}
+
+	// Run the queries a walking actor makes at every step for all pairs of
+	// boxes, once with the decoded box data kept and once with it rebuilt
+	// for every round, as after each room change.
+	for (int pass = 0; pass < 2; pass++) {
+		const bool cold = (pass == 1);
+		uint checksum = 0;
+		const uint32 start = g_system->getMillis();
+
+		for (int i = 0; i < iterations; i++) {
+			if (cold)
+				_vm->invalidateBoxCache();
+			for (int from = 0; from < num; from++) {
+				const BoxCoords box = _vm->getBoxCoordinates(from);
+				int16 x, y;
+				checksum += getClosestPtOnBox(box, box.ul.x - 1, box.ul.y - 1, x, y);
+				for (int to = 0; to < num; to++) {
+					checksum += _vm->getNextBox(from, to);
+					checksum += _vm->checkXYInBoxBounds(to, box.ll.x, box.ll.y);
+				}
+			}
+		}
+
+		debugPrintf("%s: %d x %d box pairs in %d ms (checksum %u)\n", cold ? "Cold" : "Warm",
+			iterations, num * num, g_system->getMillis() - start, checksum);
+	}
+	return true;
+}
+
+bool ScummDebugger::Cmd_RoomBench(int argc, const char **argv) {
+	const int iterations = (argc > 1) ? atoi(argv[1]) : 10;
+	int first = (argc > 2) ? atoi(argv[2]) : _vm->_currentRoom;
+	int last = (argc > 3) ? atoi(argv[3]) : first;
+
+	if (iterations <= 0 || first <= 0 || last < first) {
+		debugPrintf("Usage: %s [<iterations> [<first room> [<last room>]]]\n", argv[0]);
+		debugPrintf("Enters each room and times full redraws of the background, the actors\n");
+		debugPrintf("and the screen update. Room entry scripts are run, so reload a savegame\n");
+		debugPrintf("afterwards.\n");
+		return true;
+	}
+
+	const int oldRoom = _vm->_currentRoom;
+	last = MIN<int>(last, _vm->_res->_types[rtRoom].size() - 1);
+
+	uint64 total[3] = { 0, 0, 0 };
+	int rooms = 0;
+
+	for (int room = first; room <= last; room++) {
+		if (_vm->_res->_types[rtRoom][room]._roomoffs == RES_INVALID_OFFSET)
+			continue;
+
+		_vm->_sound->stopAllSounds();
+		_vm->startScene(room, nullptr, 0);
+		if (_vm->_currentRoom != room)
+			continue;
+
+		// Background, actors and the copy to the backend, as in scummLoop()
+		uint64 stage[3] = { 0, 0, 0 };
+		for (int i = 0; i < iterations; i++) {
+			uint64 start = g_system->getMicros();
+			_vm->_fullRedraw = true;
+			_vm->scummLoop_handleDrawing();
+			uint64 now = g_system->getMicros();
+			stage[0] += now - start;
+
+			start = now;
+			_vm->scummLoop_handleActors();
+			_vm->_fullRedraw = false;
+			now = g_system->getMicros();
+			stage[1] += now - start;
+
+			start = now;
+			_vm->drawDirtyScreenParts();
+			stage[2] += g_system->getMicros() - start;
+		}
+
+		debugPrintf("Room %3d: background %7.3f ms, actors %7.3f ms, screen %7.3f ms\n", room,
+			stage[0] / (1000.0 * iterations), stage[1] / (1000.0 * iterations), stage[2] / (1000.0 * iterations));
+
+		for (int i = 0; i < 3; i++)
+			total[i] += stage[i];
+		rooms++;
+	}
+
+	if (rooms > 1) {
+		debugPrintf("%d rooms:  background %7.3f ms, actors %7.3f ms, screen %7.3f ms\n", rooms,
+			total[0] / (1000.0 * iterations * rooms), total[1] / (1000.0 * iterations * rooms), total[2] / (1000.0 * iterations * rooms));
+	}
+
+	if (oldRoom > 0 && _vm->_currentRoom != oldRoom) {
+		_vm->startScene(oldRoom, nullptr, 0);
+		_vm->_fullRedraw = true;
+	}
+	return true;
+}
+
 void ScummDebugger::printBox(int box) {
 	if (box < 0 || box >= _vm->getNumBoxes()) {
 		debugPrintf("%d is not a valid box!\n", box);
@@ -1384,4 +1494,42 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		_vm->_res->resetStats();
+		debugPrintf("Resource statistics reset\n");
+		return true;
+	}
+
+	ResourceManager *res = _vm->_res;
+	debugPrintf("+-------------+----+--------+--------+-------+-------+----+------+-------+\n");
+	debugPrintf("|type         |num |bytes   |locked  |hits   |misses |hit%%|freed |expired|\n");
+	debugPrintf("+-------------+----+--------+--------+-------+-------+----+------+-------+\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		const ResourceManager::ResTypeData &data = res->_types[type];
+		uint32 num = 0, bytes = 0, lockedBytes = 0;
+		for (uint idx = 0; idx < data.size(); idx++) {
+			if (data[idx]._address) {
+				num++;
+				bytes += data[idx]._size;
+				if (data[idx].isLocked())
+					lockedBytes += data[idx]._size;
+			}
+		}
+
+		const ResourceManager::ResTypeData::Stats &stats = data._stats;
+		const uint32 accesses = stats.hits + stats.misses;
+		if (!num && !accesses && !stats.nuked)
+			continue;
+
+		debugPrintf("|%-13s|%4d|%8d|%8d|%7d|%7d|%3d%%|%6d|%7d|\n",
+				nameOfResType(type), num, bytes, lockedBytes, stats.hits, stats.misses,
+				accesses ? stats.hits * 100 / accesses : 100, stats.nuked, stats.expired);
+	}
+	debugPrintf("+-------------+----+--------+--------+-------+-------+----+------+-------+\n");
+	debugPrintf("Heap: %d of %d bytes\n", res->getHeapSize(), res->getHeapThreshold());
+
+	return true;
+}
+
 } // End of namespace Scumm
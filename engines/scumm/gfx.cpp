@@ -20,6 +20,7 @@
  */
 
 #include "common/system.h"
+#include "graphics/blit-simd.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
 #ifdef ENABLE_HE
@@ -215,6 +216,9 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_vertStripNextInc = 0;
 	_zbufferDisabled = false;
 	_objectMode = false;
+	_stripCacheSize = 0;
+	_stripCacheEnabled = false;
+	_stripCacheable = false;
 	_distaff = false;
 }
 
@@ -285,6 +289,24 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
+}
+
+void Gdi::setStripCacheEnabled(bool enabled) {
+	_stripCacheEnabled = enabled;
+	clearStripCache();
+}
+
+void Gdi::clearStripCache() {
+	_stripCache.clear();
+	_stripCacheSize = 0;
+}
+
+uint32 Gdi::hashRoomPalette() const {
+	uint32 hash = 0;
+	for (int i = 0; i < 256; ++i)
+		hash = hash * 31 + _vm->_roomPalette[i];
+	return hash;
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -591,27 +613,55 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+	// Neighboring dirty strips are coalesced into one rectangle spanning
+	// all of them, as long as that redraws at most twice the dirty area.
+	// This keeps the number of copyRectToScreen() calls low. NES games only
+	// merge strips of the same height: a repaint of the whole screen has a
+	// special meaning in drawStripToScreen() there.
+	const bool mergeRanges = (_game.platform != Common::kPlatformNES);
+	int start = -1;
+	int top = 0, bottom = 0, area = 0;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		if (!vs->bdirty[i]) {
+			if (start >= 0)
+				drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
+			start = -1;
+			continue;
+		}
+
+		const int stripTop = vs->tdirty[i];
+		const int stripBottom = vs->bdirty[i];
+		const int stripArea = MAX(stripBottom - stripTop, 0);
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+
+		if (start >= 0) {
+			if (stripTop == top && stripBottom == bottom) {
+				area += stripArea;
 				continue;
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+			if (mergeRanges) {
+				const int mergedTop = MIN(top, stripTop);
+				const int mergedBottom = MAX(bottom, stripBottom);
+				if ((mergedBottom - mergedTop) * (i + 1 - start) <= 2 * (area + stripArea)) {
+					top = mergedTop;
+					bottom = mergedBottom;
+					area += stripArea;
+					continue;
+				}
+			}
+			drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
 		}
-		start = i + 1;
+
+		start = i;
+		top = stripTop;
+		bottom = stripBottom;
+		area = stripArea;
 	}
+
+	if (start >= 0)
+		drawStripToScreen(vs, start * 8, (_gdi->_numStrips - start) * 8, top, bottom);
 }
 
 /**
@@ -719,35 +769,53 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+			const Graphics::KeyBlitRowProc keyBlitRow = Graphics::getKeyBlitRowProc(1);
+			if (keyBlitRow) {
+				// Copy the game graphics and put the non-transparent text
+				// pixels over them, a vector register at a time
+				const byte *srcPtr = (const byte *)src;
+				const byte *textPtr = (const byte *)text;
+				byte *dstPtr = _compositeBuf;
+				const int rowWidth = width * m;
+
+				for (int h = height * m; h > 0; --h) {
+					memcpy(dstPtr, srcPtr, rowWidth);
+					keyBlitRow(dstPtr, textPtr, rowWidth, CHARSET_MASK_TRANSPARENCY);
+					srcPtr += rowWidth + vsPitch;
+					textPtr += _textSurface.pitch;
+					dstPtr += rowWidth;
+				}
+			} else {
+				// We blit four pixels at a time, for improved performance.
+				const uint32 *src32 = (const uint32 *)src;
+				uint32 *dst32 = (uint32 *)_compositeBuf;
+
+				vsPitch >>= 2;
+
+				const uint32 *text32 = (const uint32 *)text;
+				const int textPitch = (_textSurface.pitch - width * m) >> 2;
+				for (int h = height * m; h > 0; --h) {
+					for (int w = width * m; w > 0; w -= 4) {
+						uint32 temp = *text32++;
+
+						// Generate a byte mask for those text pixels (bytes) with
+						// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+						// in mask will be either equal to 0x00 or 0xFF.
+						// Doing it this way avoids branches and bytewise operations,
+						// at the cost of readability ;).
+						uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+						mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+						mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+						// The following line is equivalent to this code:
+						//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+						// However, some compilers can generate somewhat better
+						// machine code for this equivalent statement:
+						*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+					}
+					src32 += vsPitch;
+					text32 += textPitch;
 				}
-				src32 += vsPitch;
-				text32 += textPitch;
 			}
 #endif
 		}
@@ -2108,6 +2176,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		sx = 0;
 	}
 
+	// Plain background strips of the main screen are decoded once per room.
+	// The decoded pixels depend on the room palette mapping as well.
+	const bool useStripCache = _stripCacheEnabled && flag == 0 && !_objectMode && vs->number == kMainVirtScreen &&
+		vs->format.bytesPerPixel == 1 && _vm->_game.heversion == 0;
+	const uint32 palette = useStripCache ? hashRoomPalette() : 0;
+
 	// Compute the number of strips we have to iterate over.
 	// TODO/FIXME: The computation of its initial value looks very fishy.
 	// It was added as a kind of hack to fix some corner cases, but it compares
@@ -2132,7 +2206,23 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const uint32 cacheKey = stripnr | (y << 16);
+		DecodedStripMap::iterator cached = useStripCache ? _stripCache.find(cacheKey) : _stripCache.end();
+		if (cached != _stripCache.end() && (cached->_value.src != smap_ptr || cached->_value.height != height ||
+				cached->_value.numZBuffers != numzbuf || cached->_value.palette != palette))
+			cached = _stripCache.end();
+
+		if (cached != _stripCache.end()) {
+			const byte *data = cached->_value.data.begin();
+			for (int h = 0; h < height; ++h, data += 8)
+				memcpy(dstPtr + h * vs->pitch, data, 8);
+		} else {
+			_stripCacheable = false;
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
+
+		// A strip that was drawn opaquely can be cached
+		const bool storeStrip = useStripCache && cached == _stripCache.end() && _stripCacheable && !transpStrip;
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -2146,7 +2236,44 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (cached != _stripCache.end()) {
+			const byte *data = cached->_value.data.begin() + height * 8;
+			for (int i = 1; i < numzbuf; i++) {
+				if (!zplane_list[i])
+					continue;
+				byte *mask_ptr = getMaskBuffer(x, y, i);
+				for (int h = 0; h < height; h++)
+					mask_ptr[h * _numStrips] = *data++;
+			}
+		} else {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		}
+
+		// Some workarounds change the palette mapping while drawing
+		if (storeStrip && hashRoomPalette() == palette) {
+			const uint32 size = height * 8 + MAX(numzbuf - 1, 0) * height;
+			if (_stripCacheSize + size > kStripCacheBudget)
+				clearStripCache();
+
+			DecodedStrip &strip = _stripCache[cacheKey];
+			_stripCacheSize += size - strip.data.size();
+			strip.src = smap_ptr;
+			strip.height = height;
+			strip.numZBuffers = numzbuf;
+			strip.palette = palette;
+			strip.data.resize(size);
+
+			byte *data = strip.data.begin();
+			for (int h = 0; h < height; ++h, data += 8)
+				memcpy(data, dstPtr + h * vs->pitch, 8);
+			for (int i = 1; i < numzbuf; i++) {
+				if (!zplane_list[i])
+					continue;
+				const byte *mask_ptr = getMaskBuffer(x, y, i);
+				for (int h = 0; h < height; h++)
+					*data++ = mask_ptr[h * _numStrips];
+			}
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2274,6 +2401,7 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 		return result;
 	}
 
+	_stripCacheable = true;
 	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
 }
 
@@ -23,7 +23,9 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
+#include "common/hashmap.h"
 
 #include "graphics/surface.h"
 
@@ -219,6 +221,39 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A decoded background strip of the current room. The pixels are
+	 * followed by the masks of the z-planes, one byte per line each.
+	 */
+	struct DecodedStrip {
+		const byte *src;
+		int height;
+		int numZBuffers;
+		uint32 palette;
+		Common::Array<byte> data;
+
+		DecodedStrip() : src(nullptr), height(0), numZBuffers(0), palette(0) {}
+	};
+
+	typedef Common::HashMap<uint32, DecodedStrip> DecodedStripMap;
+
+	/** Maximum number of bytes kept in _stripCache. */
+	static const uint32 kStripCacheBudget = 1024 * 1024;
+
+	/**
+	 * Background strips decoded by drawBitmap() since the room was entered,
+	 * keyed by strip number and top line, so strips scrolling back into
+	 * view are copied instead of decoded again.
+	 */
+	DecodedStripMap _stripCache;
+	uint32 _stripCacheSize;
+	bool _stripCacheEnabled;
+
+	/** Set by drawStrip() when its result only depends on the strip data. */
+	bool _stripCacheable;
+
+	uint32 hashRoomPalette() const;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -275,6 +310,8 @@ public:
 
 	virtual void init();
 	virtual void roomChanged(byte *roomptr);
+	void setStripCacheEnabled(bool enabled);
+	void clearStripCache();
 	virtual void loadTiles(byte *roomptr);
 	void setTransparentColor(byte transparentColor) { _transparentColor = transparentColor; }
 
@@ -163,6 +163,7 @@ AI::AI(ScummEngine_v100he *vm) : _vm(vm) {
 
 void AI::resetAI() {
 	_aiState = STATE_CHOOSE_BEHAVIOR;
+	clearTerrainCaches();
 	debugC(DEBUG_MOONBASE_AI, "----------------------> Resetting AI");
 
 	for (int i = 1; i != 5; i++) {
@@ -314,6 +315,9 @@ int AI::masterControlProgram(const int paramCount, const int32 *params) {
 
 	switch (_aiState) {
 	case STATE_CHOOSE_BEHAVIOR:
+		// The map may have changed since the last decision
+		clearTerrainCaches();
+
 		_behavior = chooseBehavior();
 		debugC(DEBUG_MOONBASE_AI, "Behavior mode: %d", _behavior);
 
@@ -2426,7 +2430,13 @@ int AI::calcAngle(int originX, int originY, int endX, int endY, int noWrapFlag)
 }
 
 int AI::getTerrain(int x, int y) {
+	const uint32 key = coordsKey(x, y);
+	Common::HashMap<uint32, int>::const_iterator i = _terrainCache.find(key);
+	if (i != _terrainCache.end())
+		return i->_value;
+
 	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_TERRAIN_TYPE], 2, x, y);
+	_terrainCache[key] = retVal;
 	return retVal;
 }
 
@@ -2650,10 +2660,21 @@ int AI::getTurnCounter() {
 }
 
 int AI::getGroundAltitude(int x, int y) {
+	const uint32 key = coordsKey(x, y);
+	Common::HashMap<uint32, int>::const_iterator i = _groundAltitudeCache.find(key);
+	if (i != _groundAltitudeCache.end())
+		return i->_value;
+
 	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_GROUND_ALTITUDE], 2, x, y);
+	_groundAltitudeCache[key] = retVal;
 	return retVal;
 }
 
+void AI::clearTerrainCaches() {
+	_groundAltitudeCache.clear(true);
+	_terrainCache.clear(true);
+}
+
 int AI::checkForCordOverlap(int xStart, int yStart, int affectRadius, int simulateFlag) {
 	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_CHECK_FOR_CORD_OVERLAP], 4, xStart, yStart, affectRadius, simulateFlag);
 	return retVal;
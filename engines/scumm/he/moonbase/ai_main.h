@@ -23,6 +23,7 @@
 #define SCUMM_HE_MOONBASE_AI_MAIN_H
 
 #include "common/array.h"
+#include "common/hashmap.h"
 #include "scumm/he/moonbase/ai_tree.h"
 
 namespace Scumm {
@@ -188,6 +189,17 @@ private:
 	int energyPoolSize(int pool);
 	int getMaxCollectors(int pool);
 
+	static uint32 coordsKey(int x, int y) { return (uint16)x | ((uint32)(uint16)y << 16); }
+	void clearTerrainCaches();
+
+	/**
+	 * Terrain query results of the current decision. The map does not change
+	 * while the AI is thinking, and the searches ask for the same squares at
+	 * every step of every simulated launch, which each take a script call.
+	 */
+	Common::HashMap<uint32, int> _groundAltitudeCache;
+	Common::HashMap<uint32, int> _terrainCache;
+
 public:
 	Common::Array<int> _lastXCoord[5];
 	Common::Array<int> _lastYCoord[5];
@@ -23,6 +23,7 @@
 
 #include "common/archive.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "graphics/cursorman.h"
 #include "graphics/primitives.h"
 #include "scumm/he/intern_he.h"
@@ -688,6 +689,17 @@ void Wiz::copyRawWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstTyp
 	}
 }
 
+/**
+ * Images with at least this many pixels are decompressed and warped in
+ * slices of kWizSliceRows destination rows on the worker threads.
+ */
+static const int kWizParallelPixels = 64 * 1024;
+static const int kWizSliceRows = 16;
+
+static bool useWizThreads(int w, int h) {
+	return w * h >= kWizParallelPixels && h >= 2 * kWizSliceRows && g_system->getThreadPool().getWorkerCount() > 0;
+}
+
 #ifdef USE_RGB_COLOR
 template<int type>
 void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *xmapPtr) {
@@ -704,11 +716,108 @@ void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, cons
 }
 
 template<int type>
-void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
-	const uint8 *dataPtr, *dataPtrNext;
+void Wiz::write16BitSpan(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstType, int dstInc) {
+#ifdef SCUMM_LITTLE_ENDIAN
+	// Every destination type is little endian here, so spans are handled at once
+	if (dstInc == 2) {
+		if (type == kWizCopy) {
+			memcpy(dstPtr, dataPtr, count * 2);
+			return;
+		}
+		if (type == kWizXMap) {
+			// Four pixels at a time; the mask keeps the shifted pixels apart
+			for (; count >= 4; count -= 4, dataPtr += 8, dstPtr += 8) {
+				const uint64 srcColors = (READ_UINT64(dataPtr) >> 1) & 0x7DEF7DEF7DEF7DEFULL;
+				const uint64 dstColors = (READ_UINT64(dstPtr) >> 1) & 0x7DEF7DEF7DEF7DEFULL;
+				WRITE_UINT64(dstPtr, srcColors + dstColors);
+			}
+		}
+	}
+#endif
+	for (; count > 0; count--, dataPtr += 2, dstPtr += dstInc)
+		write16BitColor<type>(dstPtr, dataPtr, dstType, NULL);
+}
+
+template<int type>
+void Wiz::fill16BitSpan(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstType, int dstInc) {
+	uint16 col = READ_LE_UINT16(dataPtr);
+	if (type == kWizXMap) {
+		uint16 srcColor = (col >> 1) & 0x7DEF;
+		for (; count > 0; count--, dstPtr += dstInc)
+			writeColor(dstPtr, dstType, srcColor + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF));
+	}
+	if (type == kWizCopy) {
+		for (; count > 0; count--, dstPtr += dstInc)
+			writeColor(dstPtr, dstType, col);
+	}
+}
+
+template<int type>
+void Wiz::decompress16BitWizLine(uint8 *dstPtr, const uint8 *dataPtr, int xoff, int w, int dstType, int dstInc) {
 	uint8 code;
-	uint8 *dstPtr, *dstPtrNext;
-	int h, w, xoff, dstInc;
+
+	uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+	if (lineSize == 0)
+		return;
+
+	while (w > 0) {
+		code = *dataPtr++;
+		if (code & 1) {
+			code >>= 1;
+			if (xoff > 0) {
+				xoff -= code;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+			}
+			dstPtr += dstInc * code;
+			w -= code;
+		} else if (code & 2) {
+			code = (code >> 2) + 1;
+			if (xoff > 0) {
+				xoff -= code;
+				dataPtr += 2;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+				dataPtr -= 2;
+			}
+			w -= code;
+			if (w < 0) {
+				code += w;
+			}
+			fill16BitSpan<type>(dstPtr, dataPtr, code, dstType, dstInc);
+			dstPtr += dstInc * code;
+			dataPtr += 2;
+		} else {
+			code = (code >> 2) + 1;
+			if (xoff > 0) {
+				xoff -= code;
+				dataPtr += code * 2;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+				dataPtr += xoff * 2;
+			}
+			w -= code;
+			if (w < 0) {
+				code += w;
+			}
+			write16BitSpan<type>(dstPtr, dataPtr, code, dstType, dstInc);
+			dataPtr += code * 2;
+			dstPtr += dstInc * code;
+		}
+	}
+}
+
+template<int type>
+void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
+	const uint8 *dataPtr;
+	uint8 *dstPtr;
+	int h, w, dstInc;
 
 	if (type == kWizXMap) {
 		assert(xmapPtr != 0);
@@ -737,71 +846,24 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 		dstInc = -2;
 	}
 
-	while (h--) {
-		xoff = srcRect.left;
-		w = srcRect.width();
-		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		dstPtrNext = dstPtr + dstPitch;
-		dataPtrNext = dataPtr + lineSize;
-		if (lineSize != 0) {
-			while (w > 0) {
-				code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					if (xoff > 0) {
-						xoff -= code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-					}
-					dstPtr += dstInc * code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += 2;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr -= 2;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dstPtr += dstInc;
-					}
-					dataPtr += 2;
-				} else {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += code * 2;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr += xoff * 2;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
-					}
-				}
-			}
+	if (useWizThreads(w, h)) {
+		// The lines only depend on their own data, once it has been located
+		Common::Array<const uint8 *> lines(h);
+		for (int y = 0; y < h; ++y) {
+			lines[y] = dataPtr;
+			dataPtr += READ_LE_UINT16(dataPtr) + 2;
 		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
+		g_system->getThreadPool().parallelFor(0, h, kWizSliceRows, [&](uint first, uint last) {
+			for (uint y = first; y < last; ++y)
+				decompress16BitWizLine<type>(dstPtr + (int)y * dstPitch, lines[y], srcRect.left, w, dstType, dstInc);
+		});
+		return;
+	}
+
+	while (h--) {
+		decompress16BitWizLine<type>(dstPtr, dataPtr, srcRect.left, w, dstType, dstInc);
+		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+		dstPtr += dstPitch;
 	}
 }
 #endif
@@ -835,11 +897,127 @@ void Wiz::write8BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const
 	}
 }
 
+template<int type>
+void Wiz::write8BitSpan(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (bitDepth == 1) {
+		if (type == kWizCopy && dstInc == 1) {
+			memcpy(dstPtr, dataPtr, count);
+			return;
+		}
+		for (; count > 0; count--, dataPtr++, dstPtr += dstInc) {
+			if (type == kWizXMap) {
+				*dstPtr = xmapPtr[*dataPtr * 256 + *dstPtr];
+			}
+			if (type == kWizRMap) {
+				*dstPtr = palPtr[*dataPtr];
+			}
+			if (type == kWizCopy) {
+				*dstPtr = *dataPtr;
+			}
+		}
+		return;
+	}
+
+	for (; count > 0; count--, dataPtr++, dstPtr += dstInc)
+		write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, 2);
+}
+
+template<int type>
+void Wiz::fill8BitSpan(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (bitDepth == 1) {
+		if (type == kWizXMap) {
+			const uint8 *xmapRow = xmapPtr + *dataPtr * 256;
+			for (; count > 0; count--, dstPtr += dstInc)
+				*dstPtr = xmapRow[*dstPtr];
+			return;
+		}
+		const uint8 col = (type == kWizRMap) ? palPtr[*dataPtr] : *dataPtr;
+		if (dstInc == 1) {
+			memset(dstPtr, col, count);
+		} else {
+			for (; count > 0; count--, dstPtr += dstInc)
+				*dstPtr = col;
+		}
+		return;
+	}
+
+	if (type == kWizXMap) {
+		uint16 srcColor = (READ_LE_UINT16(palPtr + *dataPtr * 2) >> 1) & 0x7DEF;
+		for (; count > 0; count--, dstPtr += dstInc)
+			writeColor(dstPtr, dstType, srcColor + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF));
+		return;
+	}
+	const uint16 col = (type == kWizRMap) ? READ_LE_UINT16(palPtr + *dataPtr * 2) : *dataPtr;
+	for (; count > 0; count--, dstPtr += dstInc)
+		writeColor(dstPtr, dstType, col);
+}
+
+template<int type>
+void Wiz::decompressWizLine(uint8 *dstPtr, const uint8 *dataPtr, int xoff, int w, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	uint8 code;
+
+	uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+	if (lineSize == 0)
+		return;
+
+	while (w > 0) {
+		code = *dataPtr++;
+		if (code & 1) {
+			code >>= 1;
+			if (xoff > 0) {
+				xoff -= code;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+			}
+			dstPtr += dstInc * code;
+			w -= code;
+		} else if (code & 2) {
+			code = (code >> 2) + 1;
+			if (xoff > 0) {
+				xoff -= code;
+				++dataPtr;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+				--dataPtr;
+			}
+			w -= code;
+			if (w < 0) {
+				code += w;
+			}
+			fill8BitSpan<type>(dstPtr, dataPtr, code, dstType, dstInc, palPtr, xmapPtr, bitDepth);
+			dstPtr += dstInc * code;
+			dataPtr++;
+		} else {
+			code = (code >> 2) + 1;
+			if (xoff > 0) {
+				xoff -= code;
+				dataPtr += code;
+				if (xoff >= 0)
+					continue;
+
+				code = -xoff;
+				dataPtr += xoff;
+			}
+			w -= code;
+			if (w < 0) {
+				code += w;
+			}
+			write8BitSpan<type>(dstPtr, dataPtr, code, dstType, dstInc, palPtr, xmapPtr, bitDepth);
+			dataPtr += code;
+			dstPtr += dstInc * code;
+		}
+	}
+}
+
 template<int type>
 void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
-	const uint8 *dataPtr, *dataPtrNext;
-	uint8 code, *dstPtr, *dstPtrNext;
-	int h, w, xoff, dstInc;
+	const uint8 *dataPtr;
+	uint8 *dstPtr;
+	int h, w, dstInc;
 
 	if (type == kWizXMap) {
 		assert(xmapPtr != 0);
@@ -871,71 +1049,24 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 		dstInc = -bitDepth;
 	}
 
-	while (h--) {
-		xoff = srcRect.left;
-		w = srcRect.width();
-		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		dstPtrNext = dstPtr + dstPitch;
-		dataPtrNext = dataPtr + lineSize;
-		if (lineSize != 0) {
-			while (w > 0) {
-				code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					if (xoff > 0) {
-						xoff -= code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-					}
-					dstPtr += dstInc * code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						++dataPtr;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						--dataPtr;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dstPtr += dstInc;
-					}
-					dataPtr++;
-				} else {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr += xoff;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dataPtr++;
-						dstPtr += dstInc;
-					}
-				}
-			}
+	if (useWizThreads(w, h)) {
+		// The lines only depend on their own data, once it has been located
+		Common::Array<const uint8 *> lines(h);
+		for (int y = 0; y < h; ++y) {
+			lines[y] = dataPtr;
+			dataPtr += READ_LE_UINT16(dataPtr) + 2;
 		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
+		g_system->getThreadPool().parallelFor(0, h, kWizSliceRows, [&](uint first, uint last) {
+			for (uint y = first; y < last; ++y)
+				decompressWizLine<type>(dstPtr + (int)y * dstPitch, lines[y], srcRect.left, w, dstType, dstInc, palPtr, xmapPtr, bitDepth);
+		});
+		return;
+	}
+
+	while (h--) {
+		decompressWizLine<type>(dstPtr, dataPtr, srcRect.left, w, dstType, dstInc, palPtr, xmapPtr, bitDepth);
+		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+		dstPtr += dstPitch;
 	}
 }
 
@@ -2166,27 +2297,37 @@ void Wiz::drawWizPolygonImage(uint8 *dst, const uint8 *src, const uint8 *mask, i
 		++y_start;
 	}
 
-	pra = &pdd.ra[0];
-	for (i = 0; i < pdd.rAreasNum; ++i, ++pra) {
-		uint8 *dstPtr = dst + pra->dst_offs;
-		int32 w = pra->w;
-		int32 x_acc = pra->x_s;
-		int32 y_acc = pra->y_s;
-		while (--w) {
-			int32 src_offs = (y_acc / (1 << 16)) * wizW + (x_acc / (1 << 16));
-			assert(src_offs < wizW * wizH);
-			x_acc += pra->x_step;
-			y_acc += pra->y_step;
-			if (bitDepth == 2) {
-				if (transColor == -1 || transColor != READ_LE_UINT16(src + src_offs * 2)) {
-					writeColor(dstPtr, dstType, READ_LE_UINT16(src + src_offs * 2));
+	// Every result area is a separate destination row
+	const PolygonDrawData::ResultArea *areas = &pdd.ra[0];
+	auto drawAreas = [&](uint first, uint last) {
+		for (uint area = first; area < last; ++area) {
+			const PolygonDrawData::ResultArea *ra = &areas[area];
+			uint8 *dstPtr = dst + ra->dst_offs;
+			int32 w = ra->w;
+			int32 x_acc = ra->x_s;
+			int32 y_acc = ra->y_s;
+			while (--w) {
+				int32 src_offs = (y_acc / (1 << 16)) * wizW + (x_acc / (1 << 16));
+				assert(src_offs < wizW * wizH);
+				x_acc += ra->x_step;
+				y_acc += ra->y_step;
+				if (bitDepth == 2) {
+					if (transColor == -1 || transColor != READ_LE_UINT16(src + src_offs * 2)) {
+						writeColor(dstPtr, dstType, READ_LE_UINT16(src + src_offs * 2));
+					}
+				} else {
+					if (transColor == -1 || transColor != src[src_offs])
+						*dstPtr = src[src_offs];
 				}
-			} else {
-				if (transColor == -1 || transColor != src[src_offs])
-					*dstPtr = src[src_offs];
+				dstPtr += bitDepth;
 			}
-			dstPtr += bitDepth;
 		}
+	};
+
+	if (useWizThreads(xmax_p - xmin_p + 1, pdd.rAreasNum)) {
+		g_system->getThreadPool().parallelFor(0, pdd.rAreasNum, kWizSliceRows, drawAreas);
+	} else {
+		drawAreas(0, pdd.rAreasNum);
 	}
 
 	bound.left = xmin_p;
@@ -322,8 +322,14 @@ public:
 
 #ifdef USE_RGB_COLOR
 	template<int type> static void write16BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *xmapPtr);
+	template<int type> static void write16BitSpan(uint8 *dst, const uint8 *src, int count, int dstType, int dstInc);
+	template<int type> static void fill16BitSpan(uint8 *dst, const uint8 *src, int count, int dstType, int dstInc);
+	template<int type> static void decompress16BitWizLine(uint8 *dst, const uint8 *src, int xoff, int w, int dstType, int dstInc);
 #endif
 	template<int type> static void write8BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void write8BitSpan(uint8 *dst, const uint8 *src, int count, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void fill8BitSpan(uint8 *dst, const uint8 *src, int count, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void decompressWizLine(uint8 *dst, const uint8 *src, int xoff, int w, int dstType, int dstInc, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	static void writeColor(uint8 *dstPtr, int dstType, uint16 color);
 
 	uint16 getWizPixelColor(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth, uint16 color);
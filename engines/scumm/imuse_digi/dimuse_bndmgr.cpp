@@ -21,6 +21,7 @@
 
 
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "scumm/scumm.h"
 #include "scumm/util.h"
 #include "scumm/file.h"
@@ -137,8 +138,171 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache() : _useCounter(0), _waiting(false), _blockReady(nullptr), _group(g_system->getThreadPool()) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		_blocks[i].cache = this;
+		_blocks[i].state = kStateFree;
+		_blocks[i].lastUsed = 0;
+		_blocks[i].inputCapacity = 0;
+		_blocks[i].input = nullptr;
+	}
+
+	// Without workers nothing is decompressed ahead of time
+	if (g_system->getThreadPool().getWorkerCount() > 0)
+		_blockReady = g_system->createSemaphore(0);
+}
+
+BundleBlockCache::~BundleBlockCache() {
+	_group.wait();
+
+	for (int i = 0; i < kNumBlocks; i++)
+		free(_blocks[i].input);
+	delete _blockReady;
+}
+
+BundleBlockCache::Block *BundleBlockCache::findBlock(int bundleSlot, int32 sound, int32 block) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		Block &b = _blocks[i];
+		if (b.state != kStateFree && b.bundleSlot == bundleSlot && b.sound == sound && b.block == block)
+			return &b;
+	}
+	return nullptr;
+}
+
+BundleBlockCache::Block *BundleBlockCache::allocBlock(int bundleSlot, int32 sound, int32 block) {
+	// Reuse the least recently used block which is not being decompressed
+	Block *result = nullptr;
+	for (int i = 0; i < kNumBlocks; i++) {
+		Block &b = _blocks[i];
+		if (b.state == kStateFree) {
+			result = &b;
+			break;
+		}
+		if (b.state == kStateReady && (!result || b.lastUsed < result->lastUsed))
+			result = &b;
+	}
+
+	if (result) {
+		result->bundleSlot = bundleSlot;
+		result->sound = sound;
+		result->block = block;
+		result->lastUsed = ++_useCounter;
+	}
+	return result;
+}
+
+void BundleBlockCache::decompress(Block *block) {
+	block->outputSize = BundleCodecs::decompressCodec(block->codec, block->input, block->output, block->inputSize);
+}
+
+void BundleBlockCache::Block::run() {
+	{
+		Common::StackLock lock(cache->_mutex);
+		// The block may have been decompressed by the thread waiting for it
+		if (state != kStateQueued)
+			return;
+		state = kStateDecoding;
+	}
+
+	cache->decompress(this);
+
+	Common::StackLock lock(cache->_mutex);
+	state = kStateReady;
+	if (cache->_waiting) {
+		cache->_waiting = false;
+		cache->_blockReady->post();
+	}
+}
+
+bool BundleBlockCache::fetch(int bundleSlot, int32 sound, int32 block, byte *output, int &outputSize) {
+	_mutex.lock();
+	Block *b;
+	for (;;) {
+		b = findBlock(bundleSlot, sound, block);
+		if (!b || b->state == kStateReading) {
+			_mutex.unlock();
+			return false;
+		}
+		if (b->state != kStateDecoding)
+			break;
+
+		_waiting = true;
+		_mutex.unlock();
+		_blockReady->wait();
+		_mutex.lock();
+	}
+
+	if (b->state == kStateQueued) {
+		// No worker has picked it up yet, so there is no use in waiting
+		b->state = kStateDecoding;
+		_mutex.unlock();
+		decompress(b);
+		_mutex.lock();
+		b->state = kStateReady;
+	}
+
+	b->lastUsed = ++_useCounter;
+	outputSize = b->outputSize;
+	memcpy(output, b->output, MIN<int>(outputSize, DIMUSE_BUN_CHUNK_SIZE));
+	_mutex.unlock();
+	return true;
+}
+
+void BundleBlockCache::store(int bundleSlot, int32 sound, int32 block, const byte *output, int outputSize) {
+	if (outputSize > DIMUSE_BUN_CHUNK_SIZE)
+		return;
+
+	Common::StackLock lock(_mutex);
+	if (findBlock(bundleSlot, sound, block))
+		return;
+
+	Block *b = allocBlock(bundleSlot, sound, block);
+	if (!b)
+		return;
+	memcpy(b->output, output, outputSize);
+	b->outputSize = outputSize;
+	b->state = kStateReady;
+}
+
+void BundleBlockCache::prefetch(int bundleSlot, int32 sound, int32 block, int32 codec, Common::SeekableReadStream *file, int32 offset, int32 inputSize) {
+	if (!_blockReady)
+		return;
+
+	Block *b;
+	{
+		Common::StackLock lock(_mutex);
+		if (findBlock(bundleSlot, sound, block))
+			return;
+		b = allocBlock(bundleSlot, sound, block);
+		if (!b)
+			return;
+		// Not visible to fetch() until it has been queued
+		b->state = kStateReading;
+	}
+
+	// CMI hack: one more zero byte at the end of input buffer
+	if (b->inputCapacity < inputSize + 1) {
+		free(b->input);
+		b->input = (byte *)malloc(inputSize + 1);
+		assert(b->input);
+		b->inputCapacity = inputSize + 1;
+	}
+	file->seek(offset, SEEK_SET);
+	file->read(b->input, inputSize);
+	b->input[inputSize] = 0;
+	b->codec = codec;
+	b->inputSize = inputSize;
+
+	{
+		Common::StackLock lock(_mutex);
+		b->state = kStateQueued;
+	}
+	_group.run(b);
+}
+
+BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
 	_bundleTable = nullptr;
 	_compTable = nullptr;
 	_numFiles = 0;
@@ -146,6 +310,7 @@ BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
 	_lastBlockDecompressedSize = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_bundleSlot = -1;
 	_file = new ScummFile(vm);
 	_compInputBuff = nullptr;
 }
@@ -185,6 +350,7 @@ bool BundleMgr::open(const char *filename, bool &isCompressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_bundleSlot = slot;
 	isCompressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -349,13 +515,17 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		skip = (_curDecompressedFilePos + headerSize) % DIMUSE_BUN_CHUNK_SIZE; // Excess length after the last block
 
 		for (i = firstBlock; i <= lastBlock; i++) {
-			if (_lastBlock != i) {
+			if (_lastBlock != i && !(_blockCache && _blockCache->fetch(_bundleSlot, found->index, i, _compOutputBuff, _outputSize))) {
 				// CMI hack: one more zero byte at the end of input buffer
 				_compInputBuff[_compTable[i].size] = 0;
 				_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
 				_file->read(_compInputBuff, _compTable[i].size);
 				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				if (_blockCache)
+					_blockCache->store(_bundleSlot, found->index, i, _compOutputBuff, _outputSize);
+			}
 
+			if (_lastBlock != i) {
 				if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
 					error("_outputSize: %d", _outputSize);
 				}
@@ -391,6 +561,8 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		}
 		_curDecompressedFilePos += finalSize;
 
+		prefetchBlocks(found->index, lastBlock + 1);
+
 		return finalSize;
 	}
 
@@ -398,6 +570,18 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 	return final_size;
 }
 
+void BundleMgr::prefetchBlocks(int32 index, int32 firstBlock) {
+	// Decompress the blocks the stream is going to need next in the background
+	if (!_blockCache)
+		return;
+
+	const int32 lastBlock = MIN<int32>(firstBlock + DIMUSE_BUN_READ_AHEAD_BLOCKS, _numCompItems);
+	for (int32 i = firstBlock; i < lastBlock; i++) {
+		_blockCache->prefetch(_bundleSlot, index, i, _compTable[i].codec, _file,
+			_bundleTable[index].offset + _compTable[i].offset, _compTable[i].size);
+	}
+}
+
 bool BundleMgr::isExtCompBun(byte gameId) {
 	bool isExtComp = false;
 	if (gameId == GID_CMI) {
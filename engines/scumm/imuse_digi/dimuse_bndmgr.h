@@ -24,6 +24,8 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/threadpool.h"
 #include "scumm/imuse_digi/dimuse_defs.h"
 
 namespace Scumm {
@@ -65,6 +67,76 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * Bounded cache of decompressed bundle blocks, shared by all open bundles.
+ *
+ * The blocks following the ones being streamed are decompressed ahead of
+ * time on the worker threads, so that the iMUSE callback usually only has
+ * to copy a block which is ready.
+ */
+class BundleBlockCache {
+public:
+	BundleBlockCache();
+	~BundleBlockCache();
+
+	/**
+	 * Copy a cached block to @p output, waiting for it if it is still
+	 * being decompressed. Returns false if the block is not cached.
+	 */
+	bool fetch(int bundleSlot, int32 sound, int32 block, byte *output, int &outputSize);
+
+	/** Keep a copy of a block which has been decompressed by the caller. */
+	void store(int bundleSlot, int32 sound, int32 block, const byte *output, int outputSize);
+
+	/**
+	 * Read a compressed block at @p offset in @p file and queue its decompression on
+	 * a worker thread, unless it is already cached. Does nothing without
+	 * worker threads or when all the cache slots are in use.
+	 */
+	void prefetch(int bundleSlot, int32 sound, int32 block, int32 codec, Common::SeekableReadStream *file, int32 offset, int32 inputSize);
+
+private:
+	enum {
+		kNumBlocks = 32
+	};
+
+	enum BlockState {
+		kStateFree,
+		kStateReading,
+		kStateQueued,
+		kStateDecoding,
+		kStateReady
+	};
+
+	struct Block : public Common::Job {
+		BundleBlockCache *cache;
+		BlockState state;
+		int bundleSlot;
+		int32 sound;
+		int32 block;
+		uint32 lastUsed;
+		int32 codec;
+		int32 inputSize;
+		int32 inputCapacity;
+		byte *input;
+		int outputSize;
+		byte output[DIMUSE_BUN_CHUNK_SIZE];
+
+		void run() override;
+	};
+
+	Block _blocks[kNumBlocks];
+	uint32 _useCounter;
+	bool _waiting;
+	Common::Mutex _mutex;
+	Common::SemaphoreInternal *_blockReady;
+	Common::TaskGroup _group;
+
+	Block *findBlock(int bundleSlot, int32 sound, int32 block);
+	Block *allocBlock(int bundleSlot, int32 sound, int32 block);
+	void decompress(Block *block);
+};
+
 class BundleMgr {
 
 private:
@@ -77,6 +149,7 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache; // May be nullptr
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -90,15 +163,17 @@ private:
 	bool _compTableLoaded;
 	bool _isUncompressed;
 	int _fileBundleId;
+	int _bundleSlot;
 	byte _compOutputBuff[0x2000];
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
 	bool loadCompTable(int32 index);
+	void prefetchBlocks(int32 index, int32 firstBlock);
 
 public:
 
-	BundleMgr(const ScummEngine *vm, BundleDirCache *_cache);
+	BundleMgr(const ScummEngine *vm, BundleDirCache *cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &isCompressed, bool errorFlag = false);
@@ -38,6 +38,7 @@ namespace Scumm {
 class ScummEngine;
 class BundleMgr;
 class BundleDirCache;
+class BundleBlockCache;
 
 class ImuseDigiSndMgr {
 public:
@@ -74,6 +75,7 @@ private:
 	ScummEngine *_vm;
 	byte _disk;
 	BundleDirCache *_cacheBundleDir;
+	BundleBlockCache *_cacheBundleBlocks;
 
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
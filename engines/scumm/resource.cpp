@@ -769,7 +769,10 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 
 	// If the resource is missing, but loadable from the game data files, try to do so.
 	if (!_res->_types[type][idx]._address && _res->_types[type]._mode != kDynamicResTypeMode) {
+		_res->_types[type]._stats.misses++;
 		ensureResourceLoaded(type, idx);
+	} else if (_res->_types[type][idx]._address) {
+		_res->_types[type]._stats.hits++;
 	}
 
 	ptr = (byte *)_res->_types[type][idx]._address;
@@ -814,14 +817,19 @@ void ResourceManager::increaseResourceCounters() {
 		while (idx-- > 0) {
 			byte counter = _types[type][idx].getResourceCounter();
 			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
+				_types[type][idx].setResourceCounter(counter + 1);
 			}
 		}
 	}
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
+	Resource &res = _types[type][idx];
+	res.setResourceCounter(counter);
+	if (counter == 1)
+		res._lastUsed = ++_useCounter;
+	else if (counter >= RF_USAGE_MAX)
+		res._lastUsed = 0;
 }
 
 void ResourceManager::Resource::setResourceCounter(byte counter) {
@@ -875,6 +883,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_lastUsed = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -893,6 +902,7 @@ void ResourceManager::Resource::nuke() {
 ResourceManager::ResTypeData::ResTypeData() {
 	_mode = kDynamicResTypeMode;
 	_tag = 0;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 ResourceManager::ResTypeData::~ResTypeData() {
@@ -903,6 +913,7 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_useCounter = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -930,6 +941,10 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
 		_types[type][idx].nuke();
+		_types[type]._stats.nuked++;
+
+		if (type == rtMatrix)
+			_vm->invalidateBoxCache();
 	}
 }
 
@@ -1064,7 +1079,7 @@ void ResourceManager::Resource::setOnHeap() {
 }
 
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
+	uint32 best_used;
 	ResType best_type;
 	int best_res = 0;
 	uint32 oldAllocatedSize;
@@ -1081,7 +1096,7 @@ void ResourceManager::expireResources(uint32 size) {
 
 	do {
 		best_type = rtInvalid;
-		best_counter = 2;
+		best_used = 0;
 
 		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 			if (_types[type]._mode != kDynamicResTypeMode) {
@@ -1090,9 +1105,10 @@ void ResourceManager::expireResources(uint32 size) {
 				ResId idx = _types[type].size();
 				while (idx-- > 0) {
 					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
+					// Resources used since the counters were last increased are kept
+					if (!tmp.isLocked() && tmp.getResourceCounter() >= 2 && tmp._address && (!best_type || tmp._lastUsed < best_used) &&
+							!_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+						best_used = tmp._lastUsed;
 						best_type = type;
 						best_res = idx;
 					}
@@ -1103,6 +1119,7 @@ void ResourceManager::expireResources(uint32 size) {
 		if (!best_type)
 			break;
 		nukeResource(best_type, best_res);
+		_types[best_type]._stats.expired++;
 	} while (size + _allocatedSize > _minHeapThreshold);
 
 	increaseResourceCounters();
@@ -1189,6 +1206,11 @@ void ResourceManager::resourceStats() {
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
 }
 
+void ResourceManager::resetStats() {
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1))
+		memset(&_types[type]._stats, 0, sizeof(_types[type]._stats));
+}
+
 void ScummEngine_v5::readMAXS(int blockSize) {
 	_numVariables = _fileHandle->readUint16LE();      // 800
 	_fileHandle->readUint16LE();                      // 16
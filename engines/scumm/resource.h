@@ -125,6 +125,13 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * Value of the resource manager's use counter when the resource was
+		 * last accessed. When memory runs low, the least recently used
+		 * resources are removed first.
+		 */
+		uint32 _lastUsed;
+
 	public:
 		Resource();
 		~Resource();
@@ -164,6 +171,17 @@ public:
 		 */
 		uint32 _tag;
 
+		/**
+		 * Access statistics of this res type, shown by the "resources"
+		 * debugger command.
+		 */
+		struct Stats {
+			uint32 hits;
+			uint32 misses;
+			uint32 nuked;
+			uint32 expired;
+		} _stats;
+
 	public:
 		ResTypeData();
 		~ResTypeData();
@@ -174,6 +192,7 @@ protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _useCounter;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -181,6 +200,7 @@ public:
 
 	void setHeapThreshold(int min, int max);
 	uint32 getHeapSize() { return _allocatedSize; }
+	uint32 getHeapThreshold() const { return _maxHeapThreshold; }
 
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
@@ -211,7 +231,8 @@ public:
 	void increaseExpireCounter();
 
 	/**
-	 * Update the specified resource's counter.
+	 * Update the specified resource's counter. A counter of 1 marks the
+	 * resource as just used, RF_USAGE_MAX as the first one to expire.
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
@@ -224,6 +245,7 @@ public:
 	void increaseResourceCounters();
 
 	void resourceStats();
+	void resetStats();
 
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
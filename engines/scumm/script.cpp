@@ -441,18 +441,16 @@ void ScummEngine::resetScriptPointer() {
 }
 
 /**
- * This method checks whether the resource that contains the active script
- * moved, and if so, updates the script pointer accordingly.
+ * Slow path of refreshScriptPointer(): the resource that contains the
+ * active script moved, so rebase the script pointer onto its new address.
  *
  * The script resource may have moved because it might have been garbage
  * collected by ResourceManager::expireResources.
  */
-void ScummEngine::refreshScriptPointer() {
-	if (*_lastCodePtr != _scriptOrgPointer) {
-		long oldoffs = _scriptPointer - _scriptOrgPointer;
-		getScriptBaseAddress();
-		_scriptPointer = _scriptOrgPointer + oldoffs;
-	}
+void ScummEngine::rebaseScriptPointer() {
+	long oldoffs = _scriptPointer - _scriptOrgPointer;
+	getScriptBaseAddress();
+	_scriptPointer = _scriptOrgPointer + oldoffs;
 }
 
 /** Execute a script - Read opcode, and execute it from the table */
@@ -488,8 +486,11 @@ void ScummEngine::executeScript() {
 }
 
 void ScummEngine::executeOpcode(byte i) {
-	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
-		(*_opcodes[i].proc)();
+	// Handlers are only ever bound to member functions by setupOpcodes(),
+	// so a set entry is always valid and needs no further checks.
+	Opcode *proc = _opcodes[i].proc;
+	if (proc)
+		(*proc)();
 	else {
 		error("Invalid opcode '%x' at %lx", i, (long)(_scriptPointer - _scriptOrgPointer));
 	}
@@ -503,11 +504,6 @@ const char *ScummEngine::getOpcodeDesc(byte i) {
 #endif
 }
 
-byte ScummEngine::fetchScriptByte() {
-	refreshScriptPointer();
-	return *_scriptPointer++;
-}
-
 uint ScummEngine::fetchScriptWord() {
 	refreshScriptPointer();
 	uint a = READ_LE_UINT16(_scriptPointer);
@@ -519,17 +515,6 @@ int ScummEngine::fetchScriptWordSigned() {
 	return (int16)fetchScriptWord();
 }
 
-uint ScummEngine::fetchScriptDWord() {
-	refreshScriptPointer();
-	uint a = READ_LE_UINT32(_scriptPointer);
-	_scriptPointer += 4;
-	return a;
-}
-
-int ScummEngine::fetchScriptDWordSigned() {
-	return (int32)fetchScriptDWord();
-}
-
 int ScummEngine::readVar(uint var) {
 	int a;
 
@@ -148,6 +148,9 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	} else {
 		_gdi = new Gdi(this);
 	}
+	ConfMan.registerDefault("strip_cache", true);
+	_gdi->setStripCacheEnabled(ConfMan.getBool("strip_cache"));
+	ConfMan.registerDefault("resource_budget", 0);
 	_res = new ResourceManager(this);
 
 	// Convert MD5 checksum back into a digest
@@ -1486,6 +1489,11 @@ void ScummEngine::setupScumm(const Common::String &macResourceFile) {
 	_res->setHeapThreshold(16 * 1024 * 1024, 32 * 1024 * 1024);
 #endif
 
+	// A budget in KB overrides the default heap size
+	const int budget = ConfMan.getInt("resource_budget");
+	if (budget > 0)
+		_res->setHeapThreshold(budget / 4 * 3 * 1024, budget * 1024);
+
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
 }
@@ -1516,7 +1524,7 @@ void ScummEngine_v7::setupScumm(const Common::String &macResourceFile) {
 	// DIG demo uses raw VOC files for speech instead of a MONSTER.SOU file
 	if ((_game.id == GID_CMI || _game.id == GID_DIG) && !(_game.features & GF_DEMO)) {
 		BundleDirCache *ch = new BundleDirCache(this);
-		BundleMgr *bnd = new BundleMgr(this, ch);
+		BundleMgr *bnd = new BundleMgr(this, ch, nullptr);
 		filesAreCompressed |= bnd->isExtCompBun(_game.id);
 		delete bnd;
 		delete ch;
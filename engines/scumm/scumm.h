@@ -1007,12 +1007,29 @@ protected:
 	void resetScriptPointer();
 	int getVerbEntrypoint(int obj, int entry);
 
-	void refreshScriptPointer();
-	byte fetchScriptByte();
+	/**
+	 * Check whether the resource that contains the active script moved, and
+	 * if so, update the script pointer accordingly. This runs for every
+	 * operand fetched, so only the comparison is inlined.
+	 */
+	void refreshScriptPointer() {
+		if (*_lastCodePtr != _scriptOrgPointer)
+			rebaseScriptPointer();
+	}
+	void rebaseScriptPointer();
+	byte fetchScriptByte() {
+		refreshScriptPointer();
+		return *_scriptPointer++;
+	}
 	virtual uint fetchScriptWord();
 	virtual int fetchScriptWordSigned();
-	uint fetchScriptDWord();
-	int fetchScriptDWordSigned();
+	uint fetchScriptDWord() {
+		refreshScriptPointer();
+		uint a = READ_LE_UINT32(_scriptPointer);
+		_scriptPointer += 4;
+		return a;
+	}
+	int fetchScriptDWordSigned() { return (int32)fetchScriptDWord(); }
 	void ignoreScriptWord() { fetchScriptWord(); }
 	void ignoreScriptByte() { fetchScriptByte(); }
 	void push(int a);
@@ -1527,7 +1544,22 @@ public:
 	int getScale(int box, int x, int y);
 	int getScaleFromSlot(int slot, int x, int y);
 
+	/** Drop the decoded walkbox data after the box resources changed. */
+	void invalidateBoxCache();
+
 protected:
+	/**
+	 * Walkbox data of the current room, decoded on first use: the box
+	 * matrix expanded to a table of the next box between any two boxes,
+	 * and the corners of every box (ul, ur, ll, lr).
+	 */
+	Common::Array<int8> _boxRoutes;
+	Common::Array<Common::Point> _boxCorners;
+
+	void cacheBoxRoutes(int numOfBoxes);
+	void cacheBoxCorners(int numOfBoxes);
+	BoxCoords decodeBoxCoordinates(int boxnum);
+
 	// Scaling slots/items
 	struct ScaleSlot {
 		int x1, y1, scale1;
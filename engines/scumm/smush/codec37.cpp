@@ -324,6 +324,28 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 		dst += 4;                                             \
 	} while (0)
 
+/**
+ * Copy a run of @p length blocks from the previous frame. The run is copied
+ * line by line up to the end of each row of blocks, instead of block by
+ * block.
+ */
+byte *SmushDeltaBlocksDecoder::copyPrevBlocks(byte *dst, int32 nextOffs, int32 length, int32 &i, int &bh, int bw, int pitch) {
+	while (length > 0) {
+		const int32 count = MIN(length, i);
+		for (int x = 0; x < 4; x++)
+			memcpy(dst + pitch * x, dst + nextOffs + pitch * x, count * 4);
+		dst += count * 4;
+		length -= count;
+		i -= count;
+		if (i == 0) {
+			dst += pitch * 3;
+			bh--;
+			i = bw;
+		}
+	}
+	return dst;
+}
+
 void SmushDeltaBlocksDecoder::proc1(byte *dst, const byte *src, int32 nextOffs, int bw, int bh, int pitch, int16 *offsetTable) {
 	uint8 code;
 	bool filling, skipCode;
@@ -437,17 +459,7 @@ void SmushDeltaBlocksDecoder::proc4WithFDFE(byte *dst, const byte *src, int32 ne
 			} else if (code == 0xFF) {
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
-				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				dst = copyPrevBlocks(dst, nextOffs, *src++ + 1, i, bh, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
@@ -469,17 +481,7 @@ void SmushDeltaBlocksDecoder::proc4WithoutFDFE(byte *dst, const byte *src, int32
 			if (code == 0xFF) {
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
-				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				dst = copyPrevBlocks(dst, nextOffs, *src++ + 1, i, bh, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
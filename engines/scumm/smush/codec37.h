@@ -45,6 +45,7 @@ public:
 	~SmushDeltaBlocksDecoder();
 protected:
 	void makeTable(int, int);
+	static byte *copyPrevBlocks(byte *dst, int32 nextOffs, int32 length, int32 &i, int &bh, int bw, int pitch);
 	void proc1(byte *dst, const byte *src, int32, int, int, int, int16 *);
 	void proc3WithFDFE(byte *dst, const byte *src, int32, int, int, int, int16 *);
 	void proc3WithoutFDFE(byte *dst, const byte *src, int32, int, int, int, int16 *);
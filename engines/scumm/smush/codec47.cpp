@@ -55,6 +55,9 @@ namespace Scumm {
 
 #endif
 
+#define COPY_8X1_LINE(dst, src) \
+	memcpy(dst, src, 8)
+
 #define FILL_4X1_LINE(dst, val) \
 	do {                        \
 		(dst)[0] = val;         \
@@ -275,8 +278,11 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 			}
 
 			if (sideLength == 8) {
+				uint64 &bits = _glyphBitsBig[s / 388];
+				bits = 0;
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
+						bits |= (uint64)1 << i;
 						_tableBig[256 + s + _tableBig[384 + s]] = (byte)i;
 						_tableBig[384 + s]++;
 					} else {
@@ -287,8 +293,11 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 				s += 388;
 			}
 			if (sideLength == 4) {
+				uint16 &bits = _glyphBitsSmall[s / 128];
+				bits = 0;
 				for (i = 16 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
+						bits |= 1 << i;
 						_tableSmall[64 + s + _tableSmall[96 + s]] = (byte)i;
 						_tableSmall[96 + s]++;
 					} else {
@@ -425,20 +434,18 @@ void SmushDeltaGlyphsDecoder::level2(byte *d_dst) {
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		byte *tmpPtr = _tableSmall + *_dSrc++ * 128;
-		int32 l = tmpPtr[96];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[97];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		// The two colors of a glyph cover the whole block, so every row is a
+		// select between them instead of a scatter of single pixels
+		const uint bits = _glyphBitsSmall[*_dSrc++];
+		const uint32 fill0 = 0x01010101 * _dSrc[0];
+		const uint32 fill1 = 0x01010101 * _dSrc[1];
+		_dSrc += 2;
+		for (i = 0; i < 4; i++) {
+			uint32 mask;
+			memcpy(&mask, &_glyphRowMasks[(bits >> (i * 4)) & 0x0F], 4);
+			const uint32 row = (fill0 & mask) | (fill1 & ~mask);
+			memcpy(d_dst, &row, 4);
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
@@ -463,8 +470,7 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	if (code < MOTION_OFFSET_TABLE_SIZE) {
 		tmp = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else if (code == PROCESS_SUBBLOCKS) {
@@ -476,41 +482,33 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 		d_dst += 4;
 		level2(d_dst);
 	} else if (code == FILL_SINGLE_COLOR) {
-		byte t = *_dSrc++;
+		const uint64 t = 0x0101010101010101ULL * *_dSrc++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			memcpy(d_dst, &t, 8);
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		tmp = *_dSrc++;
-		byte *tmpPtr = _tableBig + tmp * 388;
-		byte l = tmpPtr[384];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[385];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		// See level2()
+		const uint64 bits = _glyphBitsBig[*_dSrc++];
+		const uint64 fill0 = 0x0101010101010101ULL * _dSrc[0];
+		const uint64 fill1 = 0x0101010101010101ULL * _dSrc[1];
+		_dSrc += 2;
+		for (i = 0; i < 8; i++) {
+			const uint64 mask = _glyphRowMasks[(bits >> (i * 8)) & 0xFF];
+			const uint64 row = (fill0 & mask) | (fill1 & ~mask);
+			memcpy(d_dst, &row, 8);
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else {
-		byte t = _paramPtr[code];
+		const uint64 t = 0x0101010101010101ULL * _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			memcpy(d_dst, &t, 8);
 			d_dst += _dPitch;
 		}
 	}
@@ -546,6 +544,13 @@ SmushDeltaGlyphsDecoder::SmushDeltaGlyphsDecoder(int width, int height) {
 		makeTablesInterpolation(8);
 	}
 
+	for (int i = 0; i < 256; i++) {
+		byte mask[8];
+		for (int x = 0; x < 8; x++)
+			mask[x] = (i & (1 << x)) ? 0xFF : 0x00;
+		memcpy(&_glyphRowMasks[i], mask, 8);
+	}
+
 	_frameSize = _width * _height;
 	_deltaSize = _frameSize * 3;
 	_deltaBuf = (byte *)malloc(_deltaSize);
@@ -40,6 +40,11 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	/** Pixels of each glyph drawn with its first color, one bit per pixel. */
+	uint64 _glyphBitsBig[256];
+	uint16 _glyphBitsSmall[256];
+	/** Byte masks for one row of glyph bits, 0xFF where a bit is set. */
+	uint64 _glyphRowMasks[256];
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
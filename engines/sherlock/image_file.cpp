@@ -200,6 +200,9 @@ void ImageFile::loadPalette(Common::SeekableReadStream &stream) {
 }
 
 void ImageFrame::decompressFrame(const byte *src, bool isRoseTattoo) {
+	// Any scaled copy is of the old pixels
+	_scaled.reset();
+
 	_frame.create(_width, _height, Graphics::PixelFormat::createFormatCLUT8());
 	byte *dest = (byte *)_frame.getPixels();
 	Common::fill(dest, dest + _width * _height, 0xff);
@@ -254,6 +257,53 @@ void ImageFrame::decompressFrame(const byte *src, bool isRoseTattoo) {
 
 /*----------------------------------------------------------------*/
 
+const Graphics::Surface *ImageFrame::getScaledFrame(int scaleVal, bool flipped) const {
+	if (_frame.format.bytesPerPixel != 1 || !_frame.getPixels())
+		return nullptr;
+
+	// Same size as the destination rectangle in BaseSurface::SHtransBlitFrom
+	const int destW = _frame.w * SCALE_THRESHOLD / scaleVal;
+	const int destH = _frame.h * SCALE_THRESHOLD / scaleVal;
+	if (destW <= 0 || destH <= 0)
+		return nullptr;
+
+	if (!_scaled)
+		_scaled.reset(new ScaledImageFrame());
+
+	ScaledImageFrame &scaled = *_scaled;
+	if (scaled._source == _frame.getPixels() && scaled._scaleVal == scaleVal && scaled._flipped == flipped)
+		return &scaled._surface;
+
+	if (scaled._requestedScaleVal != scaleVal || scaled._requestedFlipped != flipped) {
+		scaled._requestedScaleVal = scaleVal;
+		scaled._requestedFlipped = flipped;
+		return nullptr;
+	}
+
+	// Pick the source pixels the same way the scaled ManagedSurface::transBlitFrom does
+	const int scaleX = SCALE_THRESHOLD * _frame.w / destW;
+	const int scaleY = SCALE_THRESHOLD * _frame.h / destH;
+
+	scaled._surface.free();
+	scaled._surface.create(destW, destH, _frame.format);
+
+	for (int y = 0; y < destH; ++y) {
+		const byte *srcLine = (const byte *)_frame.getBasePtr(0, y * scaleY / SCALE_THRESHOLD);
+		byte *destLine = (byte *)scaled._surface.getBasePtr(0, y);
+
+		for (int x = 0; x < destW; ++x) {
+			const int srcX = x * scaleX / SCALE_THRESHOLD;
+			destLine[x] = srcLine[flipped ? _frame.w - srcX - 1 : srcX];
+		}
+	}
+
+	scaled._source = _frame.getPixels();
+	scaled._scaleVal = scaleVal;
+	scaled._flipped = flipped;
+
+	return &scaled._surface;
+}
+
 int ImageFrame::sDrawXSize(int scaleVal) const {
 	int width = _width;
 	int scale = scaleVal == 0 ? 1 : scaleVal;
@@ -26,6 +26,7 @@
 #include "common/file.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 #include "common/str.h"
 #include "common/stream.h"
@@ -35,6 +36,23 @@ namespace Sherlock {
 
 class SherlockEngine;
 
+/**
+ * A scaled copy of an image frame, see ImageFrame::getScaledFrame()
+ */
+struct ScaledImageFrame {
+	Graphics::Surface _surface;
+	const void *_source;
+	int _scaleVal;
+	bool _flipped;
+
+	// The last scale requested, which is only cached on its second use in a row
+	int _requestedScaleVal;
+	bool _requestedFlipped;
+
+	ScaledImageFrame() : _source(nullptr), _scaleVal(0), _flipped(false), _requestedScaleVal(0), _requestedFlipped(false) {}
+	~ScaledImageFrame() { _surface.free(); }
+};
+
 struct ImageFrame {
 	uint32 _pos;
 	byte _decoded;
@@ -45,6 +63,7 @@ struct ImageFrame {
 	Common::Point _offset;
 	byte _rleMarker;
 	Graphics::Surface _frame;
+	mutable Common::SharedPtr<ScaledImageFrame> _scaled;
 
 	/**
 	 * Converts an ImageFrame record to a surface for convenience in passing to drawing methods
@@ -75,6 +94,15 @@ struct ImageFrame {
 	 * Return the frame offset y adjusted by a specified scale amount
 	 */
 	int sDrawYOffset(int scaleVal) const;
+
+	/**
+	 * Return the 8-bit frame scaled (and flipped) the way a scaled transparent
+	 * blit would draw it, so it can be blitted unscaled instead. Frames are only
+	 * scaled once the same scale is asked for twice in a row, since characters
+	 * walking towards or away from the camera change scale on every frame.
+	 * Returns nullptr if the frame isn't cached for that scale.
+	 */
+	const Graphics::Surface *getScaledFrame(int scaleVal, bool flipped) const;
 };
 
 class ImageFile {
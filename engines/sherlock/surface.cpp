@@ -57,6 +57,17 @@ void BaseSurface::writeFancyString(const Common::String &str, const Common::Poin
 void BaseSurface::SHtransBlitFrom(const ImageFrame &src, const Common::Point &pt,
 		bool flipped, int overrideColor, int scaleVal) {
 	Common::Point drawPt(pt.x + src.sDrawXOffset(scaleVal), pt.y + src.sDrawYOffset(scaleVal));
+
+	// Scaled 8-bit frames of characters standing or walking sideways are drawn
+	// from a cached scaled copy, which gives the same pixels as scaling them here
+	if (scaleVal != SCALE_THRESHOLD && !IS_3DO && format.bytesPerPixel == 1) {
+		const Graphics::Surface *scaled = src.getScaledFrame(scaleVal, flipped);
+		if (scaled) {
+			Graphics::Screen::transBlitFrom(*scaled, drawPt, TRANSPARENCY, false, overrideColor);
+			return;
+		}
+	}
+
 	SHtransBlitFrom(src._frame, drawPt, flipped, overrideColor, scaleVal);
 }
 
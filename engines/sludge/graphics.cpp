@@ -118,6 +118,7 @@ void GraphicsManager::kill() {
 	// kill sprite banks
 	LoadedSpriteBanks::iterator it;
 	for (it = _allLoadedBanks.begin(); it != _allLoadedBanks.end(); ++it) {
+		forgetSpriteBank((*it)->bank);
 		delete (*it);
 		(*it) = nullptr;
 	}
@@ -22,6 +22,8 @@
 #ifndef SLUDGE_GRAPHICS_H
 #define SLUDGE_GRAPHICS_H
 
+#include "common/array.h"
+
 #include "sludge/sprbanks.h"
 
 namespace Common {
@@ -239,6 +241,13 @@ private:
 	Graphics::Surface *duplicateSurface(Graphics::Surface *surface);
 	void blendColor(Graphics::Surface * surface, uint32 color, Graphics::TSpriteBlendMode mode);
 	Graphics::Surface *applyLightmapToSprite(Graphics::Surface *&blitted, OnScreenPerson *thisPerson, bool mirror, int x, int y, int x1, int y1, int diffX, int diffY);
+	bool getSpriteLightColors(OnScreenPerson *thisPerson, int x, int y, uint32 &primaryColor, uint32 &secondaryColor);
+	void applySpriteLightColors(Graphics::Surface *&blitted, Graphics::Surface *&toDelete, uint32 primaryColor, uint32 secondaryColor);
+	Graphics::Surface *getScaledSprite(Sprite &single, int width, int height, uint32 primaryColor, uint32 secondaryColor);
+	void forgetScaledSprite(Sprite &single);
+
+	// Scaled sprite copies replaced while sprite layers may still point to them
+	Common::Array<Graphics::Surface *> _retiredScaledSprites;
 
 	// Sprite banks
 	LoadedSpriteBanks _allLoadedBanks;
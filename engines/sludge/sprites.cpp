@@ -48,6 +48,11 @@ void GraphicsManager::forgetSpriteBank(SpriteBank &forgetme) {
 		for (int i = 0; i < forgetme.total; ++i) {
 			forgetme.sprites[i].surface.free();
 			forgetme.sprites[i].burnSurface.free();
+			if (forgetme.sprites[i].scaled) {
+				forgetme.sprites[i].scaled->free();
+				delete forgetme.sprites[i].scaled;
+				forgetme.sprites[i].scaled = nullptr;
+			}
 		}
 
 		delete []forgetme.sprites;
@@ -333,8 +338,10 @@ void GraphicsManager::blendColor(Graphics::Surface *blitted, uint32 color, Graph
 	tmp.free();
 }
 
-Graphics::Surface *GraphicsManager::applyLightmapToSprite(Graphics::Surface *&blitted, OnScreenPerson *thisPerson, bool mirror, int x, int y, int x1, int y1, int diffX, int diffY) {
-	Graphics::Surface * toDetele = nullptr;
+// Work out the colors a person's sprite is multiplied with and added to.
+// Returns true if the light map also has to be applied pixel by pixel.
+bool GraphicsManager::getSpriteLightColors(OnScreenPerson *thisPerson, int x, int y, uint32 &primaryColor, uint32 &secondaryColor) {
+	bool pixelLight = false;
 
 	// if light map is used
 	bool light = !(thisPerson->extra & EXTRA_NOLITE);
@@ -355,18 +362,7 @@ Graphics::Surface *GraphicsManager::applyLightmapToSprite(Graphics::Surface *&bl
 			}
 		} else if (_lightMapMode == LIGHTMAPMODE_PIXEL) {
 			curLight[0] = curLight[1] = curLight[2] = 255;
-
-			toDetele = blitted = duplicateSurface(blitted);
-
-			// apply light map texture
-			Graphics::TransparentSurface tmp(_lightMap, false);
-			Common::Rect rect_none(x1, y1, x1 + diffX, y1 + diffY);
-			Common::Rect rect_h(_sceneWidth - x1 - diffX, y1, _sceneWidth - x1, y1 + diffY);
-			tmp.blit(*blitted, 0, 0,
-					(mirror ? Graphics::FLIP_H : Graphics::FLIP_NONE),
-					(mirror ? &rect_h : &rect_none),
-					TS_ARGB((uint)255, (uint)255, (uint)255, (uint)255),
-					(int)blitted->w, (int)blitted->h, Graphics::BLEND_MULTIPLY);
+			pixelLight = true;
 		} else {
 			curLight[0] = curLight[1] = curLight[2] = 255;
 		}
@@ -383,31 +379,107 @@ Graphics::Surface *GraphicsManager::applyLightmapToSprite(Graphics::Surface *&bl
 		fb = curLight[2]*thisPerson->b * thisPerson->colourmix / 65025 / 255.0F;
 	}
 
-	uint32 primaryColor = TS_ARGB(255,
+	primaryColor = TS_ARGB(255,
 			(uint8)(fr + curLight[0] * (255 - thisPerson->colourmix) / 255.f),
 			(uint8)(fg + curLight[1] * (255 - thisPerson->colourmix) / 255.f),
 			(uint8)(fb + curLight[2] * (255 - thisPerson->colourmix) / 255.f));
 
-	uint32 secondaryColor = TS_ARGB(0xff, (uint8)(fr * 255), (uint8)(fg * 255), (uint8)(fb * 255));
+	secondaryColor = TS_ARGB(0xff, (uint8)(fr * 255), (uint8)(fg * 255), (uint8)(fb * 255));
+
+	return pixelLight;
+}
 
+void GraphicsManager::applySpriteLightColors(Graphics::Surface *&blitted, Graphics::Surface *&toDelete, uint32 primaryColor, uint32 secondaryColor) {
 	// apply primary color
 	if (primaryColor != (uint32)TS_ARGB(255, 255, 255, 255)) {
-		if (!toDetele) {
-			toDetele = blitted = duplicateSurface(blitted);
+		if (!toDelete) {
+			toDelete = blitted = duplicateSurface(blitted);
 			blendColor(blitted, primaryColor, Graphics::BLEND_MULTIPLY);
 		}
 	}
 
 	// apply secondary light map color
 	if (secondaryColor != 0x0) {
-		if (!toDetele) {
-			toDetele = blitted = duplicateSurface(blitted);
+		if (!toDelete) {
+			toDelete = blitted = duplicateSurface(blitted);
 		}
 		blendColor(blitted, secondaryColor, Graphics::BLEND_ADDITIVE);
 	}
+}
+
+Graphics::Surface *GraphicsManager::applyLightmapToSprite(Graphics::Surface *&blitted, OnScreenPerson *thisPerson, bool mirror, int x, int y, int x1, int y1, int diffX, int diffY) {
+	Graphics::Surface * toDetele = nullptr;
+
+	uint32 primaryColor, secondaryColor;
+	if (getSpriteLightColors(thisPerson, x, y, primaryColor, secondaryColor)) {
+		toDetele = blitted = duplicateSurface(blitted);
+
+		// apply light map texture
+		Graphics::TransparentSurface tmp(_lightMap, false);
+		Common::Rect rect_none(x1, y1, x1 + diffX, y1 + diffY);
+		Common::Rect rect_h(_sceneWidth - x1 - diffX, y1, _sceneWidth - x1, y1 + diffY);
+		tmp.blit(*blitted, 0, 0,
+				(mirror ? Graphics::FLIP_H : Graphics::FLIP_NONE),
+				(mirror ? &rect_h : &rect_none),
+				TS_ARGB((uint)255, (uint)255, (uint)255, (uint)255),
+				(int)blitted->w, (int)blitted->h, Graphics::BLEND_MULTIPLY);
+	}
+
+	applySpriteLightColors(blitted, toDetele, primaryColor, secondaryColor);
 	return toDetele;
 }
 
+// Get the sprite coloured and scaled the way TransparentSurface::blit() would
+// do it on the fly. The copy is kept until the sprite is drawn differently.
+Graphics::Surface *GraphicsManager::getScaledSprite(Sprite &single, int width, int height, uint32 primaryColor, uint32 secondaryColor) {
+	const bool colored = primaryColor != (uint32)TS_ARGB(255, 255, 255, 255) || secondaryColor != 0x0;
+	if (!colored && width == single.surface.w && height == single.surface.h)
+		return &single.surface;
+
+	if (single.scaled && single.scaledWidth == width && single.scaledHeight == height
+			&& single.scaledPrimaryColor == primaryColor && single.scaledSecondaryColor == secondaryColor)
+		return single.scaled;
+
+	forgetScaledSprite(single);
+
+	Graphics::Surface *blitted = &single.surface;
+	Graphics::Surface *colorSurface = nullptr;
+	applySpriteLightColors(blitted, colorSurface, primaryColor, secondaryColor);
+
+	Graphics::Surface *scaled = blitted;
+	if (width != blitted->w || height != blitted->h) {
+		Graphics::TransparentSurface tmp(*blitted, false);
+		scaled = tmp.scale(width, height);
+
+		if (colorSurface) {
+			colorSurface->free();
+			delete colorSurface;
+		}
+	}
+
+	single.scaled = scaled;
+	single.scaledWidth = width;
+	single.scaledHeight = height;
+	single.scaledPrimaryColor = primaryColor;
+	single.scaledSecondaryColor = secondaryColor;
+
+	return scaled;
+}
+
+void GraphicsManager::forgetScaledSprite(Sprite &single) {
+	if (!single.scaled)
+		return;
+
+	// Sprite layers are drawn at the end of the frame
+	if (_spriteLayers->numLayers > 0) {
+		_retiredScaledSprites.push_back(single.scaled);
+	} else {
+		single.scaled->free();
+		delete single.scaled;
+	}
+	single.scaled = nullptr;
+}
+
 bool GraphicsManager::scaleSprite(Sprite &single, const SpritePalette &fontPal, OnScreenPerson *thisPerson, bool mirror) {
 	float x = thisPerson->x;
 	float y = thisPerson->y;
@@ -446,7 +518,15 @@ bool GraphicsManager::scaleSprite(Sprite &single, const SpritePalette &fontPal,
 	}
 
 	Graphics::Surface *blitted = &single.surface;
-	Graphics::Surface *ptr = applyLightmapToSprite(blitted, thisPerson, mirror, x, y, x1, y1, diffX, diffY);
+	Graphics::Surface *ptr = nullptr;
+
+	// Without a per pixel light map the coloured and scaled sprite only
+	// depends on its size and colors, so it is reused between frames
+	uint32 primaryColor, secondaryColor;
+	if (diffX > 0 && diffY > 0 && !getSpriteLightColors(thisPerson, x, y, primaryColor, secondaryColor))
+		blitted = getScaledSprite(single, diffX, diffY, primaryColor, secondaryColor);
+	else
+		ptr = applyLightmapToSprite(blitted, thisPerson, mirror, x, y, x1, y1, diffX, diffY);
 
 	// Use Transparent surface to scale and blit
 	if (!_zBuffer->numPanels) {
@@ -533,6 +613,12 @@ void GraphicsManager::killSpriteLayers() {
 		_spriteLayers->layer[i].clear();
 	}
 	_spriteLayers->numLayers = 0;
+
+	for (uint i = 0; i < _retiredScaledSprites.size(); ++i) {
+		_retiredScaledSprites[i]->free();
+		delete _retiredScaledSprites[i];
+	}
+	_retiredScaledSprites.clear();
 }
 
 // Paste a scaled sprite onto the backdrop
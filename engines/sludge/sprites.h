@@ -30,6 +30,13 @@ struct Sprite {
 	int xhot, yhot;
 	Graphics::Surface surface;
 	Graphics::Surface burnSurface;
+
+	// Scaled and coloured copy of surface last drawn by scaleSprite()
+	Graphics::Surface *scaled;
+	int scaledWidth, scaledHeight;
+	uint32 scaledPrimaryColor, scaledSecondaryColor;
+
+	Sprite() : xhot(0), yhot(0), scaled(nullptr), scaledWidth(0), scaledHeight(0), scaledPrimaryColor(0), scaledSecondaryColor(0) {}
 };
 
 class SpritePalette {
@@ -39,7 +39,9 @@ namespace Gfx {
 OpenGLSActorRenderer::OpenGLSActorRenderer(OpenGLSDriver *gfx) :
 		VisualActor(),
 		_gfx(gfx),
-		_faceVBO(0) {
+		_faceVBO(0),
+		_faceEBO(0),
+		_faceIndexCount(0) {
 	_shader = _gfx->createActorShaderInstance();
 	_shadowShader = _gfx->createShadowShaderInstance();
 }
@@ -94,12 +96,13 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	setBonePositionArrayUniform(_shader, "bonePosition");
 	setLightArrayUniform(lights);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		// For each face draw its vertices from the VBO, indexed by the EBO
-		const Material *material = mats[(*face)->materialId];
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+	for (uint i = 0; i < _faceBatches.size(); i++) {
+		// Draw all the faces using this material at once from the VBO, indexed by the EBO
+		const FaceBatch &batch = _faceBatches[i];
+		const Material *material = mats[batch.materialId];
 		const Gfx::Texture *tex = resolveTexture(material);
 		if (tex) {
 			tex->bind();
@@ -110,9 +113,7 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		_shader->setUniform("textured", tex != nullptr);
 		_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
 
-		GLuint ebo = _faceEBO[*face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_INT, (const void *)(batch.firstIndex * sizeof(uint32)));
 	}
 
 	_shader->unbind();
@@ -141,11 +142,9 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		modelInverse.inverse();
 		setShadowUniform(lights, position, modelInverse.getRotation());
 
-		for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-			GLuint ebo = _faceEBO[*face];
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
-		}
+		// The shadow does not depend on the materials, so the whole model is a single draw
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+		glDrawElements(GL_TRIANGLES, _faceIndexCount, GL_UNSIGNED_INT, 0);
 
 		glDisable(GL_BLEND);
 		glDisable(GL_STENCIL_TEST);
@@ -156,22 +155,17 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 
 void OpenGLSActorRenderer::clearVertices() {
 	OpenGL::Shader::freeBuffer(_faceVBO); // Zero names are silently ignored
+	OpenGL::Shader::freeBuffer(_faceEBO);
 	_faceVBO = 0;
+	_faceEBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::Shader::freeBuffer(it->_value);
-	}
-
-	_faceEBO.clear();
+	_faceBatches.clear();
+	_faceIndexCount = 0;
 }
 
 void OpenGLSActorRenderer::uploadVertices() {
 	_faceVBO = createModelVBO(_model);
-
-	Common::Array<Face *> faces = _model->getFaces();
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[*face] = createFaceEBO(*face);
-	}
+	_faceEBO = createFaceEBO(_model);
 }
 
 GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
@@ -209,8 +203,35 @@ GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
 	return vbo;
 }
 
-GLuint OpenGLSActorRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices[0]);
+GLuint OpenGLSActorRenderer::createFaceEBO(const Model *model) {
+	const Common::Array<Face *> &faces = model->getFaces();
+	const Common::Array<Material *> &materials = model->getMaterials();
+
+	// Merge the faces by material, so each material costs a single draw call
+	Common::Array<uint32> indices;
+	for (uint materialId = 0; materialId < materials.size(); materialId++) {
+		FaceBatch batch;
+		batch.materialId = materialId;
+		batch.firstIndex = indices.size();
+
+		for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
+			if ((*face)->materialId == materialId) {
+				indices.push_back((*face)->vertexIndices);
+			}
+		}
+
+		batch.indexCount = indices.size() - batch.firstIndex;
+		if (batch.indexCount > 0) {
+			_faceBatches.push_back(batch);
+		}
+	}
+
+	_faceIndexCount = indices.size();
+	if (indices.empty()) {
+		return 0;
+	}
+
+	return OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(), &indices[0]);
 }
 
 void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::Shader *shader, const char *uniform) {
@@ -49,18 +49,25 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<Face *, GLuint> FaceBufferMap;
+	/** A run of indices in the face EBO sharing the same material */
+	struct FaceBatch {
+		uint32 materialId;
+		uint32 firstIndex;
+		uint32 indexCount;
+	};
 
 	OpenGLSDriver *_gfx;
 	OpenGL::Shader *_shader, *_shadowShader;
 
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+	uint32 _faceIndexCount;
+	Common::Array<FaceBatch> _faceBatches;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createModelVBO(const Model *model);
-	GLuint createFaceEBO(const Face *face);
+	GLuint createFaceEBO(const Model *model);
 	void setBonePositionArrayUniform(OpenGL::Shader *shader, const char *uniform);
 	void setBoneRotationArrayUniform(OpenGL::Shader *shader, const char *uniform);
 	void setLightArrayUniform(const LightEntryArray &lights);
@@ -38,6 +38,7 @@ OpenGLSPropRenderer::OpenGLSPropRenderer(Driver *gfx) :
 		VisualProp(),
 		_gfx(gfx),
 		_faceVBO(0),
+		_faceEBO(0),
 		_modelIsDirty(true) {
 	static const char* attributes[] = { "position", "normal", "texcoord", nullptr };
 	_shader = OpenGL::Shader::fromFiles("stark_prop", attributes);
@@ -82,13 +83,14 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 	_shader->setUniform("normalMatrix", normalMatrix.getRotation());
 	setLightArrayUniform(lights);
 
-	const Common::Array<Face> &faces = _model->getFaces();
 	const Common::Array<Material> &materials = _model->getMaterials();
 
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		const Material &material = materials[face->materialId];
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+	for (uint i = 0; i < _faceBatches.size(); i++) {
+		const FaceBatch &batch = _faceBatches[i];
+		const Material &material = materials[batch.materialId];
 
-		// For each face draw its vertices from the VBO, indexed by the EBO
+		// Draw all the faces using this material at once from the VBO, indexed by the EBO
 		const Gfx::Texture *tex = _texture->getTexture(material.texture);
 		if (tex) {
 			tex->bind();
@@ -100,9 +102,7 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 		_shader->setUniform("color", Math::Vector3d(material.r, material.g, material.b));
 		_shader->setUniform("doubleSided", material.doubleSided ? 1 : 0);
 
-		GLuint ebo = _faceEBO[face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, face->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_INT, (const void *)(batch.firstIndex * sizeof(uint32)));
 	}
 
 	_shader->unbind();
@@ -110,21 +110,16 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 
 void OpenGLSPropRenderer::clearVertices() {
 	OpenGL::Shader::freeBuffer(_faceVBO);
+	OpenGL::Shader::freeBuffer(_faceEBO);
+	_faceVBO = 0;
+	_faceEBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::Shader::freeBuffer(it->_value);
-	}
-
-	_faceEBO.clear();
+	_faceBatches.clear();
 }
 
 void OpenGLSPropRenderer::uploadVertices() {
 	_faceVBO = createFaceVBO();
-
-	const Common::Array<Face> &faces = _model->getFaces();
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[face] = createFaceEBO(face);
-	}
+	_faceEBO = createFaceEBO();
 }
 
 GLuint OpenGLSPropRenderer::createFaceVBO() {
@@ -133,8 +128,34 @@ GLuint OpenGLSPropRenderer::createFaceVBO() {
 	return OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, sizeof(float) * 9 * vertices.size(), &vertices.front());
 }
 
-GLuint OpenGLSPropRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices.front());
+GLuint OpenGLSPropRenderer::createFaceEBO() {
+	const Common::Array<Face> &faces = _model->getFaces();
+	const Common::Array<Material> &materials = _model->getMaterials();
+
+	// Merge the faces by material, so each material costs a single draw call
+	Common::Array<uint32> indices;
+	for (uint materialId = 0; materialId < materials.size(); materialId++) {
+		FaceBatch batch;
+		batch.materialId = materialId;
+		batch.firstIndex = indices.size();
+
+		for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
+			if (face->materialId == materialId) {
+				indices.push_back(face->vertexIndices);
+			}
+		}
+
+		batch.indexCount = indices.size() - batch.firstIndex;
+		if (batch.indexCount > 0) {
+			_faceBatches.push_back(batch);
+		}
+	}
+
+	if (indices.empty()) {
+		return 0;
+	}
+
+	return OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(), &indices.front());
 }
 
 void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
@@ -50,19 +50,25 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<const Face *, GLuint> FaceBufferMap;
+	/** A run of indices in the face EBO sharing the same material */
+	struct FaceBatch {
+		uint32 materialId;
+		uint32 firstIndex;
+		uint32 indexCount;
+	};
 
 	Driver *_gfx;
 	OpenGL::Shader *_shader;
 
 	bool _modelIsDirty;
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+	Common::Array<FaceBatch> _faceBatches;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createFaceVBO();
-	GLuint createFaceEBO(const Face *face);
+	GLuint createFaceEBO();
 
 	void setLightArrayUniform(const LightEntryArray &lights);
 
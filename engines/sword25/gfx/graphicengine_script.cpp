@@ -44,6 +44,8 @@
 #include "sword25/gfx/animationtemplate.h"
 #include "sword25/gfx/animationtemplateregistry.h"
 
+#include "common/lua/lua_heap.h"
+
 namespace Sword25 {
 
 static bool animationDeleteCallback(uint Data);
@@ -77,6 +79,9 @@ static ActionCallback *actionCallbackPtr = 0;	// FIXME: should be turned into Gr
 #define ANIMATION_TEMPLATE_CLASS_NAME "Gfx.AnimationTemplate"
 static const char *GFX_LIBRARY_NAME = "Gfx";
 
+// Time the Lua garbage collector may spend at the end of each frame
+static const uint32 kGCBudgetMicros = 1000;
+
 static void newUintUserData(lua_State *L, uint value) {
 	void *userData = lua_newuserdata(L, sizeof(value));
 	memcpy(userData, &value, sizeof(value));
@@ -253,6 +258,10 @@ static int endFrame(lua_State *L) {
 
 	lua_pushbooleancpp(L, pGE->endFrame());
 
+	// Let the collector work between frames, so that it needn't catch up
+	// in long pauses during scene scripts
+	Lua::LuaHeap::collectWithTimeBudget(L, kGCBudgetMicros);
+
 	return 1;
 }
 
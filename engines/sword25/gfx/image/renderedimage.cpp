@@ -233,7 +233,33 @@ bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRe
 	int cg = (color >> BS_GSHIFT) & 0xff;
 	int cb = (color >> BS_BSHIFT) & 0xff;
 
-	_surface.blit(*_backSurface, posX, posY, newFlipping, pPartRect, _surface.format.ARGBToColor(ca, cr, cg, cb), width, height);
+	uint blitColor = _surface.format.ARGBToColor(ca, cr, cg, cb);
+
+	int srcWidth = pPartRect ? pPartRect->width() : _surface.w;
+	int srcHeight = pPartRect ? pPartRect->height() : _surface.h;
+	bool scaled = (width != -1 && width != srcWidth) || (height != -1 && height != srcHeight);
+
+	// Scaled images are blitted in one go, so that they are only scaled once
+	if (!updateRects || scaled) {
+		_surface.blit(*_backSurface, posX, posY, newFlipping, pPartRect, blitColor, width, height);
+		return true;
+	}
+
+	// Only touch the dirty rectangles. The back surface keeps the previous
+	// frame everywhere else, so blending the image there again would be both
+	// wasted work and wrong for translucent pixels.
+	Common::Rect screenRect(_backSurface->w, _backSurface->h);
+	Common::Rect imageRect(posX, posY, posX + srcWidth, posY + srcHeight);
+	imageRect.clip(screenRect);
+
+	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
+		Common::Rect clipRect = *rectIt;
+		clipRect.clip(imageRect);
+		if (clipRect.isEmpty())
+			continue;
+
+		_surface.blitClip(*_backSurface, clipRect, posX, posY, newFlipping, pPartRect, blitColor, width, height);
+	}
 
 	return true;
 }
@@ -198,14 +198,12 @@ void TeMesh::update(const Common::Array<TeMatrix4x4> *matricies1, const Common::
 }
 
 void TeMesh::update(TeIntrusivePtr<TeModelVertexAnimation> vertexanim) {
+	// Interpolate straight into the updated table so it keeps its storage
+	// from frame to frame.
+	vertexanim->getVertices(_updatedVerticies);
+	assert(_updatedVerticies.size() >= _verticies.size());
 	_updatedVerticies.resize(_verticies.size());
 	_updatedNormals.resize(_normals.size());
-
-	const Common::Array<TeVector3f32> animverts = vertexanim->getVertices();
-	assert(animverts.size() >= _verticies.size());
-	for (uint i = 0; i < _verticies.size(); i++) {
-		_updatedVerticies[i] = animverts[i];
-	}
 	for (uint i = 0; i < _normals.size(); i++) {
 		_updatedNormals[i] = _normals[i];
 	}
@@ -186,17 +186,6 @@ void TeModel::update() {
 	//if (name().contains("Kate"))
 	//	debug("TeModel::update model %s", name().c_str());
 	if (_bones.size()) {
-		Common::Array<TeMatrix4x4> matricies(_bones.size());
-		for (uint i = 0; i < _bones.size(); i++) {
-			const Bone &b = _bones[i];
-			const TeMatrix4x4 matrix = TeMatrix4x4::fromTRS(b._trs);
-			if (b._parentBone == -1 || _bones.size() < 2) {
-				matricies[0] = matrix;
-			} else {
-				matricies[i] = matricies[b._parentBone] * matrix;
-			}
-		}
-
 		_boneMatricies.resize(_bones.size());
 		_lerpedElements.resize(_weightElements.size());
 
@@ -262,9 +251,12 @@ void TeModel::update() {
 				mesh.update(&_boneMatricies, &_lerpedElements);
 			} else {
 				mesh.resizeUpdatedTables(mesh.numVerticies());
-				Common::Array<TeVector3f32> verticies;
+				// _animVerticies keeps its storage between frames.
+				Common::Array<TeVector3f32> &verticies = _animVerticies;
 				if (_modelVertexAnim && mesh.name() == _modelVertexAnim->head())
-					verticies = _modelVertexAnim->getVertices();
+					_modelVertexAnim->getVertices(verticies);
+				else
+					verticies.resize(0);
 
 				for (uint i = 0; i < mesh.numVerticies(); i++) {
 					TeVector3f32 vertex;
@@ -155,6 +155,7 @@ protected:
 	Common::Array<TeMatrix4x4> _skinOffsets;
 	Common::Array<TeMatrix4x4> _boneMatricies;
 	Common::Array<TeMatrix4x4> _lerpedElements;
+	Common::Array<TeVector3f32> _animVerticies;
 	Common::Array<Common::Array<weightElement>> _weightElements;
 	Common::Array<Common::SharedPtr<TeMesh>> _meshes;
 
@@ -51,9 +51,15 @@ TeVector3f32 TeModelVertexAnimation::getKeyVertex(uint keyno, uint vertexno) {
 
 Common::Array<TeVector3f32> TeModelVertexAnimation::getVertices() {
 	Common::Array<TeVector3f32> lerpVtx;
+	getVertices(lerpVtx);
+	return lerpVtx;
+}
 
-	if (_keydata.size() < 2)
-		return lerpVtx;
+void TeModelVertexAnimation::getVertices(Common::Array<TeVector3f32> &lerpVtx) {
+	if (_keydata.size() < 2) {
+		lerpVtx.resize(0);
+		return;
+	}
 
 	float frame = fmod((_lastMillis / 1000.0) * 30, _keydata[_keydata.size() - 1]._frame);
 	uint keyno = 0;
@@ -70,8 +76,6 @@ Common::Array<TeVector3f32> TeModelVertexAnimation::getVertices() {
 		const TeVector3f32 nextVector = getKeyVertex(keyno + 1, i);
 		lerpVtx[i] = prevVector * (1.0 - interp) + nextVector * interp;
 	}
-
-	return lerpVtx;
 }
 
 bool TeModelVertexAnimation::load(Common::ReadStream &stream) {
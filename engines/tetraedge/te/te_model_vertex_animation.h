@@ -58,6 +58,8 @@ public:
 	const Common::String &head() const { return _head; }
 	TeVector3f32 getKeyVertex(uint keyno, uint vertexno);
 	Common::Array<TeVector3f32> getVertices();
+	/** Same as getVertices(), but reuses the storage of @p lerpVtx. */
+	void getVertices(Common::Array<TeVector3f32> &lerpVtx);
 
 	bool load(Common::ReadStream &stream);
 	void save(Common::WriteStream &stream) const;
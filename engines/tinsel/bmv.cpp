@@ -41,6 +41,7 @@
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 
+#include "common/system.h"
 #include "common/textconsole.h"
 
 namespace Tinsel {
@@ -597,7 +598,7 @@ void BMVPlayer::PrepAudio(const byte *sourceData, int blobCount, byte *destPtr)
 
 //----------------- BMV FUNCTIONS ----------------------------
 
-BMVPlayer::BMVPlayer() {
+BMVPlayer::BMVPlayer() : _audioPrepGroup(g_system->getThreadPool()) {
 	bOldAudio = 0;
 	bMovieOn = 0;
 	bAbort = 0;
@@ -635,6 +636,8 @@ BMVPlayer::BMVPlayer() {
 	audioStarted = 0;
 	_audioStream = 0;
 	nextMaintain = 0;
+	_pendingAudioStart = false;
+	_audioPrepJob.player = this;
 }
 
 /**
@@ -667,6 +670,8 @@ void BMVPlayer::StartMovieSound() {
 }
 
 void BMVPlayer::FinishMovieSound() {
+	DiscardMovieAudio();
+
 	if (_audioStream) {
 		_vm->_mixer->stopHandle(_audioHandle);
 
@@ -677,27 +682,64 @@ void BMVPlayer::FinishMovieSound() {
 
 /**
  * Called when a packet contains an audio field.
+ * The samples are decoded by PrepMovieAudio() and handed to the
+ * mixer by QueueMovieAudio().
  */
 void BMVPlayer::MovieAudio(int audioOffset, int blobs) {
 	if (audioOffset == 0 && blobs == 0)
 		blobs = 57;
 
-	byte *data = (byte *)malloc(blobs * 128);
+	PendingAudio audio;
+	audio.offset = audioOffset;
+	audio.blobs = blobs;
+	audio.data = (byte *)malloc(blobs * 128);
 
-	if (audioOffset != 0)
-		PrepAudio(bigBuffer+audioOffset, blobs, data);
-	else
-		memset(data, 0, blobs * 128);
+	if (audioOffset == 0)
+		memset(audio.data, 0, blobs * 128);
 
-	_audioStream->queueBuffer(data, blobs * 128, DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_STEREO);
+	_pendingAudio.push_back(audio);
 
-	if (currentSoundFrame == ADVANCE_SOUND) {
-		if (!audioStarted) {
-			_vm->_mixer->playStream(Audio::Mixer::kSFXSoundType,
-					&_audioHandle, _audioStream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO);
-			audioStarted = true;
-		}
+	if (currentSoundFrame == ADVANCE_SOUND)
+		_pendingAudioStart = true;
+}
+
+/**
+ * Decode the pending audio packets. May run on a worker thread, as
+ * long as the engine thread does not touch the ADPCM state meanwhile.
+ */
+void BMVPlayer::PrepMovieAudio() {
+	for (uint i = 0; i < _pendingAudio.size(); i++) {
+		if (_pendingAudio[i].offset != 0)
+			PrepAudio(bigBuffer + _pendingAudio[i].offset, _pendingAudio[i].blobs, _pendingAudio[i].data);
+	}
+}
+
+/**
+ * Hand the decoded audio packets to the mixer, in packet order.
+ */
+void BMVPlayer::QueueMovieAudio() {
+	for (uint i = 0; i < _pendingAudio.size(); i++)
+		_audioStream->queueBuffer(_pendingAudio[i].data, _pendingAudio[i].blobs * 128, DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_STEREO);
+	_pendingAudio.clear();
+
+	if (_pendingAudioStart && !audioStarted) {
+		_vm->_mixer->playStream(Audio::Mixer::kSFXSoundType,
+				&_audioHandle, _audioStream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO);
+		audioStarted = true;
 	}
+	_pendingAudioStart = false;
+}
+
+/**
+ * Wait for any audio decoding in progress and drop its packets.
+ */
+void BMVPlayer::DiscardMovieAudio() {
+	_audioPrepGroup.wait();
+
+	for (uint i = 0; i < _pendingAudio.size(); i++)
+		free(_pendingAudio[i].data);
+	_pendingAudio.clear();
+	_pendingAudioStart = false;
 }
 
 /*-----------------------------------------------------*\
@@ -1383,6 +1425,8 @@ void BMVPlayer::FettleBMV() {
 					i++;
 				}
 			}
+			PrepMovieAudio();
+			QueueMovieAudio();
 			startTick = -ONE_SECOND / 4;	// 1/4 second
 		}
 		return;
@@ -1413,6 +1457,13 @@ void BMVPlayer::FettleBMV() {
 		}
 	}
 
+	// Decode the audio packets gathered above while the frames are
+	// decompressed. Packets between the sound and frame offsets are
+	// complete, so MaintainBuffer() never reads over them.
+	bool audioPrepRunning = !_pendingAudio.empty();
+	if (audioPrepRunning)
+		_audioPrepGroup.run(&_audioPrepJob);
+
 	// Time to process a frame (or maybe more)
 	if ((TinselVersion != 3) && (bigProblemCount < PT_A)) {
 		refFrame = currentFrame;
@@ -1439,6 +1490,14 @@ void BMVPlayer::FettleBMV() {
 		}
 	}
 
+	if (audioPrepRunning) {
+		_audioPrepGroup.wait();
+
+		// FinishBMV() drops the audio if the movie ended meanwhile
+		if (bMovieOn)
+			QueueMovieAudio();
+	}
+
 	if (tick >= nextMaintain || numAdvancePackets < SUBSEQUENT_SOUND) {
 		MaintainBuffer();
 		nextMaintain = tick + 2;
@@ -23,8 +23,10 @@
 #ifndef TINSEL_BMV_H
 #define TINSEL_BMV_H
 
+#include "common/array.h"
 #include "common/coroutines.h"
 #include "common/file.h"
+#include "common/threadpool.h"
 
 #include "audio/mixer.h"
 
@@ -137,6 +139,27 @@ class BMVPlayer {
 	Audio::QueuingAudioStream *_audioStream;
 	Audio::SoundHandle _audioHandle;
 
+	/// An audio packet whose samples have not been queued yet
+	struct PendingAudio {
+		int offset;
+		int blobs;
+		byte *data;
+	};
+
+	/// Decodes the pending audio packets while the frames are decompressed
+	class AudioPrepJob : public Common::Job {
+	public:
+		BMVPlayer *player;
+
+		AudioPrepJob() : player(nullptr) {}
+		void run() override { player->PrepMovieAudio(); }
+	};
+
+	Common::Array<PendingAudio> _pendingAudio;
+	bool _pendingAudioStart;
+	AudioPrepJob _audioPrepJob;
+	Common::TaskGroup _audioPrepGroup;
+
 	int nextMaintain;
 public:
 	BMVPlayer();
@@ -167,6 +190,9 @@ private:
 	void StartMovieSound();
 	void FinishMovieSound();
 	void MovieAudio(int audioOffset, int blobs);
+	void PrepMovieAudio();
+	void QueueMovieAudio();
+	void DiscardMovieAudio();
 	void FettleMovieText();
 	void BmvDrawText(bool bDraw);
 	void MovieText(CORO_PARAM, int stringId, int x, int y, int fontId, COLORREF *pTalkColor, int duration);
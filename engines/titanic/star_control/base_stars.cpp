@@ -27,6 +27,9 @@
 #include "titanic/support/simple_file.h"
 #include "titanic/titanic.h"
 
+#include "common/system.h"
+#include "common/threadpool.h"
+
 namespace Titanic {
 
 CBaseStarEntry::CBaseStarEntry() : _red(0), _value(0.0) {
@@ -160,47 +163,88 @@ void CBaseStars::draw(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *
 	}
 }
 
+void CBaseStars::projectStars(const FPose &pose, double threshold) {
+	const double MAX_VAL = 1.0e9 * 1.0e9;
+	const double minVal = threshold - 9216.0;
+
+	_projected.resize(_data.size());
+
+	// The transform of each star is independent of the others, so split
+	// it across the thread pool. Plotting stays sequential in star order.
+	g_system->getThreadPool().parallelFor(0, _data.size(), PROJECT_GRAIN, [&](uint first, uint last) {
+		for (uint idx = first; idx < last; ++idx) {
+			const FVector &vector = _data[idx]._position;
+			CProjectedStar &star = _projected[idx];
+
+			double tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
+				+ vector._z * pose._row3._z + pose._vector._z;
+			if (tempZ <= minVal) {
+				star._kind = PROJECTED_HIDDEN;
+				continue;
+			}
+
+			double tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
+			double tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+			double total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+
+			star._x = tempX;
+			star._y = tempY;
+			star._z = tempZ;
+			star._total2 = total2;
+
+			if (total2 < 1.0e12) {
+				star._kind = PROJECTED_CLOSEUP;
+				continue;
+			}
+
+			if (tempZ <= threshold || total2 >= MAX_VAL) {
+				star._kind = PROJECTED_HIDDEN;
+				continue;
+			}
+
+			double sVal = sqrt(total2);
+			star._brightness = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			star._kind = PROJECTED_POINT;
+		}
+	});
+}
+
 void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
-	double minVal = threshold - 9216.0;
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double tempX, tempY, tempZ, total2;
+	double tempX, tempY, tempZ;
+
+	projectStars(pose, threshold);
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
+		const CBaseStarEntry &entry = _data[idx];
+		const CProjectedStar &star = _projected[idx];
+		if (star._kind == PROJECTED_HIDDEN)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
-
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+		if (star._kind == PROJECTED_CLOSEUP) {
+			// We're in close proximity to the given star, so draw a closeup of it
+			closeup->draw(pose, entry._position, FVector(centroid._x, centroid._y, star._total2),
 				surfaceArea, camera);
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+		tempX = star._x;
+		tempY = star._y;
+		tempZ = star._z;
 
 		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
 		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		double sVal = star._brightness;
 		double red = MIN((double)entry._red * sVal, (double)255.0);
 		double green = MIN((double)entry._green * sVal, (double)255.0);
 		double blue = MIN((double)entry._green * sVal, (double)255.0);
@@ -249,43 +293,38 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
-	double minVal = threshold - 9216.0;
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double tempX, tempY, tempZ, total2;
+	double tempX, tempY, tempZ;
+
+	projectStars(pose, threshold);
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
+		const CBaseStarEntry &entry = _data[idx];
+		const CProjectedStar &star = _projected[idx];
+		if (star._kind == PROJECTED_HIDDEN)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
-
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+		if (star._kind == PROJECTED_CLOSEUP) {
+			// We're in close proximity to the given star, so draw a closeup of it
+			closeup->draw(pose, entry._position, FVector(centroid._x, centroid._y, star._total2),
 				surfaceArea, camera);
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+		tempX = star._x;
+		tempY = star._y;
+		tempZ = star._z;
 
 		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
 		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		double sVal = star._brightness;
 		double red = MIN((double)entry._red * sVal, (double)255.0);
 		double green = MIN((double)entry._green * sVal, (double)255.0);
 		double blue = MIN((double)entry._green * sVal, (double)255.0);
@@ -335,38 +374,34 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
-	double minVal = threshold - 9216.0;
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double *v3Ptr = &_value3, *v4Ptr = &_value4;
-	double tempX, tempY, tempZ, total2, sVal;
+	double tempX, tempY, tempZ, sVal;
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
+	projectStars(pose, threshold);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
+		const CBaseStarEntry &entry = _data[idx];
+		const CProjectedStar &star = _projected[idx];
+		if (star._kind == PROJECTED_HIDDEN)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
-
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+		if (star._kind == PROJECTED_CLOSEUP) {
+			// We're in close proximity to the given star, so draw a closeup of it
+			closeup->draw(pose, entry._position, FVector(centroid._x, centroid._y, star._total2),
 				surfaceArea, camera);
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+		tempX = star._x;
+		tempY = star._y;
+		tempZ = star._z;
 
 		// First pixel
 		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
@@ -374,9 +409,7 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+		sVal = star._brightness * 255.0;
 
 		if (sVal > 255.0)
 			sVal = 255.0;
@@ -408,9 +441,7 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+		sVal = star._brightness * 255.0;
 
 		if (sVal > 255.0)
 			sVal = 255.0;
@@ -442,39 +473,33 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
-	double minVal = threshold - 9216.0;
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2, *v3Ptr = &_value3, *v4Ptr = &_value4;
-	double tempX, tempY, tempZ, total2, sVal;
+	double tempX, tempY, tempZ, sVal;
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
+	projectStars(pose, threshold);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
 		const CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
+		const CProjectedStar &star = _projected[idx];
+		if (star._kind == PROJECTED_HIDDEN)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
-
-		if (total2 < 1.0e12) {
+		if (star._kind == PROJECTED_CLOSEUP) {
 			// We're in close proximity to the given star, so draw a closeup of it
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+			closeup->draw(pose, entry._position, FVector(centroid._x, centroid._y, star._total2),
 				surfaceArea, camera);
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+		tempX = star._x;
+		tempY = star._y;
+		tempZ = star._z;
 
 		// First pixel
 		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
@@ -482,9 +507,7 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+		sVal = star._brightness * 255.0;
 
 		if (sVal > 255.0)
 			sVal = 255.0;
@@ -516,9 +539,7 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+		sVal = star._brightness * 255.0;
 
 		if (sVal > 255.0)
 			sVal = 255.0;
@@ -58,6 +58,18 @@ struct CBaseStarEntry {
 	bool operator==(const CBaseStarEntry &s) const;
 };
 
+enum ProjectedStarKind { PROJECTED_HIDDEN = 0, PROJECTED_CLOSEUP = 1, PROJECTED_POINT = 2 };
+
+/**
+ * A star transformed into camera space for the current frame
+ */
+struct CProjectedStar {
+	double _x, _y, _z;
+	double _total2;
+	double _brightness;
+	ProjectedStarKind _kind;
+};
+
 struct CStarPosition : public Common::Point {
 	int _index1;
 	int _index2;
@@ -73,6 +85,16 @@ struct CStarPosition : public Common::Point {
  */
 class CBaseStars {
 private:
+	static const uint PROJECT_GRAIN = 2048;
+
+	Common::Array<CProjectedStar> _projected;
+
+	/**
+	 * Transform all the stars by the camera pose and classify them as
+	 * hidden, close enough for a closeup, or plain points
+	 */
+	void projectStars(const FPose &pose, double threshold);
+
 	void draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
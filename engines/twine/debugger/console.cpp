@@ -26,6 +26,7 @@
 #include "twine/debugger/debug_scene.h"
 #include "twine/holomap.h"
 #include "twine/renderer/redraw.h"
+#include "twine/renderer/renderer.h"
 #include "twine/resources/hqr.h"
 #include "twine/scene/gamestate.h"
 #include "twine/scene/scene.h"
@@ -74,6 +75,7 @@ TwinEConsole::TwinEConsole(TwinEEngine *engine) : _engine(engine), GUI::Debugger
 	registerCmd("set_holomap_trajectory", WRAP_METHOD(TwinEConsole, doSetHolomapTrajectory));
 	registerCmd("show_holomap_flag", WRAP_METHOD(TwinEConsole, doPrintGameFlag));
 	registerCmd("toggle_enhancements", WRAP_METHOD(TwinEConsole, doToggleEnhancements));
+	registerCmd("render_stats", WRAP_METHOD(TwinEConsole, doRenderStats));
 }
 
 TwinEConsole::~TwinEConsole() {
@@ -126,6 +128,12 @@ bool TwinEConsole::doToggleEnhancements(int argc, const char **argv) {
 	return true;
 }
 
+bool TwinEConsole::doRenderStats(int argc, const char **argv) {
+	const RenderStats &stats = _engine->_renderer->getLastFrameStats();
+	debugPrintf("Last frame: %u polygons, %u pixels filled\n", stats.polygons, stats.pixels);
+	return true;
+}
+
 bool TwinEConsole::doToggleClipRendering(int argc, const char **argv) {
 	TOGGLE_DEBUG(_engine->_debugScene->_showingClips, "clip rendering\n")
 	return true;
@@ -59,6 +59,7 @@ private:
 	bool doToggleTrackRendering(int argc, const char **argv);
 	bool doToggleGodMode(int argc, const char **argv);
 	bool doToggleEnhancements(int argc, const char **argv);
+	bool doRenderStats(int argc, const char **argv);
 	bool doToggleFreeCamera(int argc, const char **argv);
 	bool doToggleSceneChanges(int argc, const char **argv);
 	bool doToggleSceneRendering(int argc, const char **argv);
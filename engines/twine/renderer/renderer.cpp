@@ -838,8 +838,8 @@ void Renderer::svgaPolyCopper(int16 vtop, int16 Ymax, uint16 color) const {
 		xMax = *pVerticD++;
 		pDest = pDestLine + xMin;
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDest, (byte)color, xMax - xMin + 1);
 		}
 
 		color += sens;
@@ -870,8 +870,8 @@ void Renderer::svgaPolyBopper(int16 vtop, int16 Ymax, uint16 color) const {
 		xMax = *pVerticD++;
 		pDest = pDestLine + xMin;
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDest, (byte)color, xMax - xMin + 1);
 		}
 
 		line--;
@@ -904,8 +904,8 @@ void Renderer::svgaPolyTriste(int16 vtop, int16 Ymax, uint16 color) const {
 		xMax = *pVerticD++;
 		pDest = pDestLine + xMin;
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDest, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -1173,8 +1173,8 @@ void Renderer::svgaPolyTriche(int16 vtop, int16 Ymax, uint16 color) const {
 		pDest = pDestLine + xMin;
 
 		color = (*pCoulG++) >> 8;
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDest, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -1188,7 +1188,28 @@ void Renderer::renderPolygons(const CmdRenderPolygon &polygon, ComputedVertex *v
 	}
 }
 
+void Renderer::countFilledPixels(int16 vtop, int16 vbottom) {
+	if (_statsFrame != _engine->_frameCounter) {
+		_statsFrame = _engine->_frameCounter;
+		_lastFrameStats = _frameStats;
+		_frameStats = RenderStats();
+	}
+
+	uint32 pixels = 0;
+	for (int16 y = vtop; y <= vbottom; y++) {
+		const int32 width = _tabVerticD[y] - _tabVerticG[y] + 1;
+		if (width > 0) {
+			pixels += width;
+		}
+	}
+
+	_frameStats.polygons++;
+	_frameStats.pixels += pixels;
+}
+
 void Renderer::fillVertices(int16 vtop, int16 vbottom, uint8 renderType, uint16 color) {
+	countFilledPixels(vtop, vbottom);
+
 	switch (renderType) {
 	case POLYGONTYPE_FLAT:
 		svgaPolyTriste(vtop, vbottom, color);
@@ -72,6 +72,11 @@ struct CmdRenderPolygon {
 	// followed by Vertex array
 };
 
+struct RenderStats {
+	uint32 polygons = 0;
+	uint32 pixels = 0;
+};
+
 struct IMatrix3x3 {
 	IVec3 row1;
 	IVec3 row2;
@@ -196,6 +201,12 @@ private:
 
 	bool _isUsingIsoProjection = false;
 
+	int32 _statsFrame = 0;
+	RenderStats _frameStats;
+	RenderStats _lastFrameStats;
+
+	void countFilledPixels(int16 vtop, int16 vbottom);
+
 	void svgaPolyCopper(int16 vtop, int16 vbottom, uint16 color) const;
 	void svgaPolyBopper(int16 vtop, int16 vbottom, uint16 color) const;
 	void svgaPolyTriste(int16 vtop, int16 vbottom, uint16 color) const;
@@ -246,6 +257,10 @@ public:
 	IVec3 worldRotatePoint(const IVec3& vec);
 
 	void fillVertices(int16 vtop, int16 vbottom, uint8 renderType, uint16 color);
+
+	/** Polygons and pixels filled during the previous frame */
+	const RenderStats &getLastFrameStats() const { return _lastFrameStats; }
+
 	void renderPolygons(const CmdRenderPolygon &polygon, ComputedVertex *vertices);
 
 	inline IVec3 projectPoint(const IVec3& pos) { // ProjettePoint
@@ -953,15 +953,26 @@ void Screen::drawalphamap8globe(sint16 x, sint16 y, uint16 r) {
 	//Draw using "smooth" lighting
 	//The x and y are relative to (0,0) of the mapwindow itself, and are absolute coordinates, so are i and j
 	r--;
-	for (i = -globeradius_2[r]; i < globeradius_2[r]; i++)
-		for (j = -globeradius_2[r]; j < globeradius_2[r]; j++) {
-			if ((y + i) - 1 < 0 ||
-			        (x + j) - 1 < 0 ||
-			        (y + i) + 1 > shading_rect.height() ||
-			        (x + j) + 1 > shading_rect.width())
-				continue;
-			shading_data[(y + i)*shading_rect.width() + (x + j)] = MIN(shading_data[(y + i) * shading_rect.width() + (x + j)] + shading_globe[r][(i + globeradius_2[r]) * globeradius[r] + (j + globeradius_2[r])], 255);
-		}
+	// clip the globe to the shading buffer once rather than for each pixel
+	const sint16 i_start = MAX<sint16>(-globeradius_2[r], 1 - y);
+	const sint16 i_end = MIN<sint16>(globeradius_2[r], shading_rect.height() - y);
+	const sint16 j_start = MAX<sint16>(-globeradius_2[r], 1 - x);
+	const sint16 j_end = MIN<sint16>(globeradius_2[r], shading_rect.width() - x);
+	const uint16 pitch = shading_rect.width();
+
+	for (i = i_start; i < i_end; i++) {
+		uint8 *dst = shading_data + (y + i) * pitch + x;
+		const uint8 *globe = shading_globe[r] + (i + globeradius_2[r]) * globeradius[r] + globeradius_2[r];
+		for (j = j_start; j < j_end; j++)
+			dst[j] = MIN(dst[j] + globe[j], 255);
+	}
+}
+
+/* Scale a colour channel by an alpha value, truncating the same way as
+ * (uint8)((float)c * alpha / 255.0f) without the float conversions.
+ */
+static inline uint32 scale_channel(uint32 pixel, uint32 mask, uint8 shift, uint32 alpha) {
+	return ((((pixel & mask) >> shift) * alpha / 255) << shift) & mask;
 }
 
 
@@ -1064,6 +1075,13 @@ void Screen::blitalphamap8(sint16 x, sint16 y, Common::Rect *clip_rect) {
 	}
 
 
+	const uint32 Rmask = _renderSurface->Rmask, Gmask = _renderSurface->Gmask, Bmask = _renderSurface->Bmask;
+	const uint8 Rshift = _renderSurface->Rshift, Gshift = _renderSurface->Gshift, Bshift = _renderSurface->Bshift;
+	const uint32 rgbMask = Rmask | Gmask | Bmask;
+
+	// Fully lit pixels only lose their non-colour bits and unlit ones are
+	// cleared outright,
+	// so only the penumbra of each light pays for the per-channel scaling.
 	switch (_renderSurface->bits_per_pixel) {
 	case 16:
 		uint16 *pixels16;
@@ -1073,9 +1091,19 @@ void Screen::blitalphamap8(sint16 x, sint16 y, Common::Rect *clip_rect) {
 
 		for (i = 0; i < src_h; i++) {
 			for (j = 0; j < src_w; j++) {
-				pixels16[j] = (((unsigned char)(((float)((pixels16[j] & _renderSurface->Rmask) >> _renderSurface->Rshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Rshift) |      //R
-				              (((unsigned char)(((float)((pixels16[j] & _renderSurface->Gmask) >> _renderSurface->Gshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Gshift) |      //G
-				              (((unsigned char)(((float)((pixels16[j] & _renderSurface->Bmask) >> _renderSurface->Bshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Bshift);       //B
+				const uint8 alpha = src_buf[j];
+				if (alpha == 0xFF) {
+					pixels16[j] &= rgbMask;
+					continue;
+				}
+				if (alpha == 0) {
+					pixels16[j] = 0;
+					continue;
+				}
+				const uint32 p = pixels16[j];
+				pixels16[j] = scale_channel(p, Rmask, Rshift, alpha) |
+				              scale_channel(p, Gmask, Gshift, alpha) |
+				              scale_channel(p, Bmask, Bshift, alpha);
 			}
 			pixels16 += _renderSurface->w;
 			src_buf += shading_rect.width();
@@ -1091,9 +1119,19 @@ void Screen::blitalphamap8(sint16 x, sint16 y, Common::Rect *clip_rect) {
 
 		for (i = 0; i < src_h; i++) {
 			for (j = 0; j < src_w; j++) {
-				pixels[j] = (((unsigned char)(((float)((pixels[j] & _renderSurface->Rmask) >> _renderSurface->Rshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Rshift) |      //R
-				            (((unsigned char)(((float)((pixels[j] & _renderSurface->Gmask) >> _renderSurface->Gshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Gshift) |      //G
-				            (((unsigned char)(((float)((pixels[j] & _renderSurface->Bmask) >> _renderSurface->Bshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Bshift);       //B
+				const uint8 alpha = src_buf[j];
+				if (alpha == 0xFF) {
+					pixels[j] &= rgbMask;
+					continue;
+				}
+				if (alpha == 0) {
+					pixels[j] = 0;
+					continue;
+				}
+				const uint32 p = pixels[j];
+				pixels[j] = scale_channel(p, Rmask, Rshift, alpha) |
+				            scale_channel(p, Gmask, Gshift, alpha) |
+				            scale_channel(p, Bmask, Bshift, alpha);
 			}
 			pixels += _renderSurface->w;
 			src_buf += shading_rect.width();
@@ -47,14 +47,10 @@
 //
 // Macros defined by this file:
 //
-// NOT_CLIPPED_Y - Does Y Clipping check per line
-//
-// NOT_CLIPPED_X - Does X Clipping check per Pixel
-//
-// LINE_END_ASSIGN - Calcuates the line_end pointer required for X clipping
-//
 // XNEG - Negates X values if doing shape flipping
 //
+// FLIPPED - True if the shape is drawn flipped
+//
 // USE_XFORM_FUNC - Checks to see if we want to use XForm Blending for this pixel
 //
 // CUSTOM_BLEND - Final Blend for invisiblity
@@ -87,13 +83,16 @@
 #ifdef FLIP_CONDITIONAL
 const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 #define XNEG(x) (((x)+neg)^neg)
+#define FLIPPED (neg != 0)
 #else
 #define XNEG(x) (-(x))
+#define FLIPPED (true)
 #endif
 
 // Flipping = FALSE
 #else
 #define XNEG(x)(+(x))
+#define FLIPPED (false)
 #endif
 
 
@@ -102,9 +101,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 //
 #ifdef NO_CLIPPING
 
-#define LINE_END_ASSIGN //
-#define NOT_CLIPPED_X (1)
-#define NOT_CLIPPED_Y (1)
 #define OFFSET_PIXELS (_pixels)
 
 //
@@ -115,9 +111,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	const int		scrn_width = _clipWindow.width();
 	const int		scrn_height = _clipWindow.height();
 
-#define LINE_END_ASSIGN const uintX *dst_line_end = dst_line_start + scrn_width
-#define NOT_CLIPPED_X (dstpix >= dst_line_start && dstpix < dst_line_end)
-#define NOT_CLIPPED_Y (line >= 0 && line < scrn_height)
 #define OFFSET_PIXELS (off_pixels)
 
 	uint8			*off_pixels  = _pixels + _clipWindow.left * sizeof(uintX) + _clipWindow.top * _pitch;
@@ -195,31 +188,44 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 
 	assert(_pixels00 && _pixels && srcpixels);
 
-	for (int i = 0; i < height_; i++)  {
+	// Clip the frame against the window once, instead of testing each
+	// line and pixel
+	int32 ystart = 0, yend = height_;
+	int32 xstart = 0, xend = width_;
+
+#ifndef NO_CLIPPING
+	ystart = MAX<int32>(0, -y);
+	yend = MIN<int32>(height_, scrn_height - y);
+	if (FLIPPED) {
+		xstart = MAX<int32>(0, x - scrn_width + 1);
+		xend = MIN<int32>(width_, x + 1);
+	} else {
+		xstart = MAX<int32>(0, -x);
+		xend = MIN<int32>(width_, scrn_width - x);
+	}
+#endif
+
+	for (int32 i = ystart; i < yend; i++)  {
 		const int line = y + i;
+		const uint8	*srcline = srcpixels + i * width_;
+		uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
+
+		for (int32 xpos = xstart; xpos < xend; xpos++) {
+			if (srcline[xpos] == keycolor)
+				continue;
 
-		if (NOT_CLIPPED_Y) {
-			const uint8	*srcline = srcpixels + i * width_;
-			uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
-			LINE_END_ASSIGN;
-
-			for (int xpos = 0; xpos < width_; xpos++) {
-				if (srcline[xpos] == keycolor)
-					continue;
-
-				uintX *dstpix = dst_line_start + x + XNEG(xpos);
-
-				if (NOT_CLIPPED_X && NOT_DESTINATION_MASKED) {
-					const uint8 *srcpix = srcline + xpos;
-					#ifdef XFORM_SHAPES
-					if (USE_XFORM_FUNC) {
-						*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix, format));
-					}
-					else
-					#endif
-					{
-						*dstpix = CUSTOM_BLEND(pal[*srcpix]);
-					}
+			uintX *dstpix = dst_line_start + x + XNEG(xpos);
+
+			if (NOT_DESTINATION_MASKED) {
+				const uint8 *srcpix = srcline + xpos;
+				#ifdef XFORM_SHAPES
+				if (USE_XFORM_FUNC) {
+					*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix, format));
+				}
+				else
+				#endif
+				{
+					*dstpix = CUSTOM_BLEND(pal[*srcpix]);
 				}
 			}
 		}
@@ -228,8 +234,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 #undef NOT_DESTINATION_MASKED
 #undef OFFSET_PIXELS
 #undef CUSTOM_BLEND
-#undef LINE_END_ASSIGN
-#undef NOT_CLIPPED_X
-#undef NOT_CLIPPED_Y
+#undef FLIPPED
 #undef XNEG
 #undef USE_XFORM_FUNC
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/system.h"
 #include "ultima/ultima8/misc/debugger.h"
 #include "ultima/ultima8/kernel/kernel.h"
 #include "ultima/ultima8/kernel/process.h"
@@ -42,11 +43,12 @@ const uint16 Kernel::PROC_TYPE_ALL = 6;
 static const uint16 CRU_PROC_TYPE_ALL = 0xc;
 
 Kernel::Kernel() : _loading(false), _tickNum(0), _paused(0),
-		_runningProcess(nullptr), _frameByFrame(false) {
+		_runningProcess(nullptr), _frameByFrame(false), _profiling(false) {
 	debugN(MM_INFO, "Creating Kernel...\n");
 
 	_kernel = this;
 	_pIDs = new idMan(1, 32766, 128);
+	_pidTable.resize(32767, nullptr);
 	_currentProcess = _processes.end();
 }
 
@@ -62,17 +64,23 @@ Kernel::~Kernel() {
 void Kernel::reset() {
 	debugN(MM_INFO, "Resetting Kernel...\n");
 
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	for (Std::vector<Process *>::iterator it = procs.begin(); it != procs.end(); ++it) {
 		Process *p = *it;
 		if (p->_flags & Process::PROC_TERM_DISPOSE && p != _runningProcess) {
 			delete p;
 		} else {
 			p->_flags |= Process::PROC_TERMINATED;
+			p->_parked = false;
 		}
 	}
 	_processes.clear();
+	_waitingProcesses.clear();
 	_currentProcess = _processes.end();
 
+	for (Std::vector<Process *>::iterator it = _pidTable.begin(); it != _pidTable.end(); ++it)
+		*it = nullptr;
 	_pIDs->clearAll();
 
 	_paused = 0;
@@ -133,7 +141,9 @@ ProcId Kernel::addProcessExec(Process *proc, bool dispose) {
 		proc->_flags |= Process::PROC_TERM_DISPOSE;
 	}
 	_processes.push_back(proc);
+	proc->_kernelPos = --_processes.end();
 	proc->_flags |= Process::PROC_ACTIVE;
+	registerProcess(proc);
 
 	Process *oldrunning = _runningProcess;
 	_runningProcess = proc;
@@ -147,7 +157,7 @@ void Kernel::runProcesses() {
 	if (!_paused)
 		_tickNum++;
 
-	if (_processes.size() == 0) {
+	if (_processes.size() == 0 && _waitingProcesses.size() == 0) {
 		warning("Process queue is empty?! Aborting.");
 		return;
 	}
@@ -167,7 +177,16 @@ void Kernel::runProcesses() {
 		        (!_paused || (p->_flags & Process::PROC_RUNPAUSED)) &&
 				(_paused || _tickNum % p->getTicksPerRun() == 0)) {
 			_runningProcess = p;
-			p->run();
+			if (_profiling) {
+				// Look up the class first, the process may be deleted by run()
+				ProcessTime &time = _processTimes[p->GetClassType()._className];
+				uint64 start = g_system->getMicros();
+				p->run();
+				time._micros += g_system->getMicros() - start;
+				time._runs++;
+			} else {
+				p->run();
+			}
 			_runningProcess = nullptr;
 
 			num_run++;
@@ -206,6 +225,7 @@ void Kernel::runProcesses() {
 			_currentProcess = _processes.erase(_currentProcess);
 
 			// Clear pid
+			_pidTable[p->_pid] = nullptr;
 			_pIDs->clearID(p->_pid);
 
 			if (p->_flags & Process::PROC_TERM_DISPOSE) {
@@ -221,7 +241,14 @@ void Kernel::runProcesses() {
 			// *shouldn't* be used, and the process should be cleaned up next tick.
 			//
 			_processes.push_back(p);
+			p->_kernelPos = --_processes.end();
+			_currentProcess = _processes.erase(_currentProcess);
+		} else if (p->is_suspended() && !p->is_terminated()) {
+			// Park it until it is woken up, so it is not visited every tick
 			_currentProcess = _processes.erase(_currentProcess);
+			_waitingProcesses.push_back(p);
+			p->_kernelPos = --_waitingProcesses.end();
+			p->_parked = true;
 		} else {
 			++_currentProcess;
 		}
@@ -234,46 +261,75 @@ void Kernel::setNextProcess(Process *proc) {
 	if (_currentProcess != _processes.end() && *_currentProcess == proc) return;
 
 	if (proc->_flags & Process::PROC_ACTIVE) {
-		for (ProcessIterator it = _processes.begin();
-		        it != _processes.end(); ++it) {
-			if (*it == proc) {
-				_processes.erase(it);
-				break;
-			}
-		}
+		unlinkProcess(proc);
 	} else {
 		proc->_flags |= Process::PROC_ACTIVE;
+		registerProcess(proc);
 	}
 
 	if (_currentProcess == _processes.end()) {
 		// Not currently running processes, add to the start of the next run.
 		_processes.push_front(proc);
+		proc->_kernelPos = _processes.begin();
 	} else {
 		ProcessIterator t = _currentProcess;
 		++t;
 
 		_processes.insert(t, proc);
+		proc->_kernelPos = --t;
 	}
 }
 
-Process *Kernel::getProcess(ProcId pid) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
-		if (p->_pid == pid)
-			return p;
+void Kernel::registerProcess(Process *proc) {
+	if (proc->_pid < _pidTable.size())
+		_pidTable[proc->_pid] = proc;
+}
+
+void Kernel::unlinkProcess(Process *proc) {
+	if (proc->_parked) {
+		_waitingProcesses.erase(proc->_kernelPos);
+		proc->_parked = false;
+	} else {
+		_processes.erase(proc->_kernelPos);
 	}
+}
+
+void Kernel::unparkProcess(Process *proc) {
+	unlinkProcess(proc);
+	_processes.push_back(proc);
+	proc->_kernelPos = --_processes.end();
+}
+
+Process *Kernel::getProcess(ProcId pid) {
+	if (pid < _pidTable.size())
+		return _pidTable[pid];
 	return nullptr;
 }
 
+void Kernel::getProcesses(Std::vector<Process *> &procs, ObjId objid) const {
+	procs.clear();
+	for (ProcessIter it = _processes.begin(); it != _processes.end(); ++it) {
+		if (objid == 0 || (*it)->_itemNum == objid)
+			procs.push_back(*it);
+	}
+	for (ProcessIter it = _waitingProcesses.begin(); it != _waitingProcesses.end(); ++it) {
+		if (objid == 0 || (*it)->_itemNum == objid)
+			procs.push_back(*it);
+	}
+}
+
 void Kernel::kernelStats() {
 	g_debugger->debugPrintf("Kernel memory stats:\n");
-	g_debugger->debugPrintf("Processes  : %u/32765\n", _processes.size());
+	g_debugger->debugPrintf("Processes  : %u/32765\n", _processes.size() + _waitingProcesses.size());
+	g_debugger->debugPrintf("Waiting    : %u\n", _waitingProcesses.size());
 }
 
 void Kernel::processTypes() {
 	g_debugger->debugPrintf("Current process types:\n");
 	Common::HashMap<Common::String, unsigned int> processtypes;
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	for (Std::vector<Process *>::const_iterator it = procs.begin(); it != procs.end(); ++it) {
 		Process *p = *it;
 		processtypes[p->GetClassType()._className]++;
 	}
@@ -283,33 +339,54 @@ void Kernel::processTypes() {
 	}
 }
 
+void Kernel::processTimes() {
+	if (!_profiling && _processTimes.empty()) {
+		g_debugger->debugPrintf("Process profiling is off\n");
+		return;
+	}
+
+	g_debugger->debugPrintf("Process run times:\n");
+	Common::HashMap<Common::String, ProcessTime>::const_iterator iter;
+	for (iter = _processTimes.begin(); iter != _processTimes.end(); ++iter) {
+		const ProcessTime &time = iter->_value;
+		g_debugger->debugPrintf("%s: %u runs, %u us total, %u us per run\n", iter->_key.c_str(),
+			time._runs, (uint32)time._micros, (uint32)(time._runs ? time._micros / time._runs : 0));
+	}
+}
+
 uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 	uint32 count = 0;
 
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
+	const Std::list<Process *> *lists[] = { &_processes, &_waitingProcesses };
+	for (int l = 0; l < 2; l++) {
+		for (ProcessIter it = lists[l]->begin(); it != lists[l]->end(); ++it) {
+			Process *p = *it;
 
-		// Don't count us, we are not really here
-		if (p->is_terminated()) continue;
+			// Don't count us, we are not really here
+			if (p->is_terminated()) continue;
 
-		if ((objid == 0 || objid == p->_itemNum) &&
-		        (processtype == PROC_TYPE_ALL || processtype == p->_type))
-			count++;
+			if ((objid == 0 || objid == p->_itemNum) &&
+			        (processtype == PROC_TYPE_ALL || processtype == p->_type))
+				count++;
+		}
 	}
 
 	return count;
 }
 
 Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
+	const Std::list<Process *> *lists[] = { &_processes, &_waitingProcesses };
+	for (int l = 0; l < 2; l++) {
+		for (ProcessIter it = lists[l]->begin(); it != lists[l]->end(); ++it) {
+			Process *p = *it;
 
-		// Don't count us, we are not really here
-		if (p->is_terminated()) continue;
+			// Don't count us, we are not really here
+			if (p->is_terminated()) continue;
 
-		if ((objid == 0 || objid == p->_itemNum) &&
-		        (processtype == PROC_TYPE_ALL || processtype == p->_type)) {
-			return p;
+			if ((objid == 0 || objid == p->_itemNum) &&
+			        (processtype == PROC_TYPE_ALL || processtype == p->_type)) {
+				return p;
+			}
 		}
 	}
 
@@ -318,7 +395,10 @@ Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
 
 
 void Kernel::killProcesses(ObjId objid, uint16 processtype, bool fail) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	// Killing wakes up waiting processes, which moves them between lists
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	for (Std::vector<Process *>::const_iterator it = procs.begin(); it != procs.end(); ++it) {
 		Process *p = *it;
 
 		if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
@@ -334,7 +414,10 @@ void Kernel::killProcesses(ObjId objid, uint16 processtype, bool fail) {
 }
 
 void Kernel::killProcessesNotOfType(ObjId objid, uint16 processtype, bool fail) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	// Killing wakes up waiting processes, which moves them between lists
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	for (Std::vector<Process *>::const_iterator it = procs.begin(); it != procs.end(); ++it) {
 		Process *p = *it;
 
 		// * If objid is 0, terminate procs for all objects.
@@ -352,7 +435,10 @@ void Kernel::killProcessesNotOfType(ObjId objid, uint16 processtype, bool fail)
 }
 
 void Kernel::killAllProcessesNotOfTypeExcludeCurrent(uint16 processtype, bool fail) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	// Killing wakes up waiting processes, which moves them between lists
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	for (Std::vector<Process *>::const_iterator it = procs.begin(); it != procs.end(); ++it) {
 		Process *p = *it;
 
 		// Don't kill the running process
@@ -371,11 +457,14 @@ void Kernel::killAllProcessesNotOfTypeExcludeCurrent(uint16 processtype, bool fa
 }
 
 bool Kernel::canSave() {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
+	const Std::list<Process *> *lists[] = { &_processes, &_waitingProcesses };
+	for (int l = 0; l < 2; l++) {
+		for (ProcessIter it = lists[l]->begin(); it != lists[l]->end(); ++it) {
+			Process *p = *it;
 
-		if (!p->is_terminated() && p->_flags & Process::PROC_PREVENT_SAVE) {
-			return false;
+			if (!p->is_terminated() && p->_flags & Process::PROC_PREVENT_SAVE) {
+				return false;
+			}
 		}
 	}
 
@@ -385,8 +474,10 @@ bool Kernel::canSave() {
 void Kernel::save(Common::WriteStream *ws) {
 	ws->writeUint32LE(_tickNum);
 	_pIDs->save(ws);
-	ws->writeUint32LE(_processes.size());
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+	Std::vector<Process *> procs;
+	getProcesses(procs);
+	ws->writeUint32LE(procs.size());
+	for (Std::vector<Process *>::const_iterator it = procs.begin(); it != procs.end(); ++it) {
 		const Std::string & classname = (*it)->GetClassType()._className; // virtual
 		assert(classname.size());
 
@@ -414,6 +505,8 @@ bool Kernel::load(Common::ReadStream *rs, uint32 version) {
 		Process *p = loadProcess(rs, version);
 		if (!p) return false;
 		_processes.push_back(p);
+		p->_kernelPos = --_processes.end();
+		registerProcess(p);
 	}
 
 	// Integrity check for processes
@@ -91,17 +91,25 @@ public:
 	//! \param fail if true, fail the processes instead of terminating them
 	void killAllProcessesNotOfTypeExcludeCurrent(uint16 processtype, bool fail);
 
-	//! get an iterator of the process list.
-	ProcessIter getProcessBeginIterator() {
-		return _processes.begin();
-	}
-	ProcessIter getProcessEndIterator() {
-		return _processes.end();
-	}
+	//! get all processes, running or waiting, of the given object
+	//! \param objid the object, or 0 for any object
+	void getProcesses(Std::vector<Process *> &procs, ObjId objid = 0) const;
 
 	void kernelStats();
 	void processTypes();
 
+	//! print the time spent running each process class
+	void processTimes();
+	void setProfiling(bool profile) {
+		_profiling = profile;
+	}
+	bool isProfiling() const {
+		return _profiling;
+	}
+	void resetProcessTimes() {
+		_processTimes.clear();
+	}
+
 	bool canSave();
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
@@ -147,7 +155,20 @@ public:
 private:
 	Process *loadProcess(Common::ReadStream *rs, uint32 version);
 
+	//! called when a process starts being tracked by the kernel
+	void registerProcess(Process *proc);
+	//! take a process out of the list it is currently in
+	void unlinkProcess(Process *proc);
+	//! move a waiting process back to the end of the run list
+	void unparkProcess(Process *proc);
+	friend class Process;
+
+	//! processes that may run, in run order
 	Std::list<Process *> _processes;
+	//! suspended processes, moved back into _processes when woken
+	Std::list<Process *> _waitingProcesses;
+	//! processes in either list, indexed by pid
+	Std::vector<Process *> _pidTable;
 	idMan   *_pIDs;
 
 	Std::list<Process *>::iterator _currentProcess;
@@ -162,6 +183,16 @@ private:
 
 	Process *_runningProcess;
 
+	struct ProcessTime {
+		uint32 _runs;
+		uint64 _micros;
+
+		ProcessTime() : _runs(0), _micros(0) {}
+	};
+
+	bool _profiling;
+	Common::HashMap<Common::String, ProcessTime> _processTimes;
+
 	static Kernel *_kernel;
 };
 
@@ -29,7 +29,8 @@ namespace Ultima8 {
 DEFINE_RUNTIME_CLASSTYPE_CODE(Process)
 
 Process::Process(ObjId it, uint16 ty)
-	: _pid(0xFFFF), _flags(0), _itemNum(it), _type(ty), _result(0), _ticksPerRun(2) {
+	: _pid(0xFFFF), _flags(0), _itemNum(it), _type(ty), _result(0), _ticksPerRun(2),
+	  _parked(false) {
 	Kernel::get_instance()->assignPID(this);
 	if (GAME_IS_CRUSADER) {
 		// Default kernel ticks per run of processes in Crusader
@@ -58,6 +59,18 @@ void Process::terminate() {
 	_waiting.clear();
 
 	_flags |= PROC_TERMINATED;
+
+	// Terminated processes are removed from the run list
+	if (_parked)
+		kernel->unparkProcess(this);
+}
+
+void Process::terminateDeferred() {
+	_flags |= PROC_TERM_DEFERRED;
+
+	// The run list is where deferred termination happens
+	if (_parked)
+		Kernel::get_instance()->unparkProcess(this);
 }
 
 void Process::wakeUp(uint32 result) {
@@ -63,9 +63,7 @@ public:
 	virtual void terminate();
 
 	//! terminate next frame
-	void terminateDeferred() {
-		_flags |= PROC_TERM_DEFERRED;
-	}
+	void terminateDeferred();
 
 	//! run even when paused
 	void setRunPaused() {
@@ -145,6 +143,11 @@ protected:
 	//! When this process terminates, awaken them and pass them the result val.
 	Std::vector<ProcId> _waiting;
 
+	//! position in the kernel's run or wait list. Not saved.
+	Std::list<Process *>::iterator _kernelPos;
+	//! in the kernel's wait list rather than the run list. Not saved.
+	bool _parked;
+
 public:
 
 	enum processflags {
@@ -47,6 +47,7 @@
 #include "ultima/ultima8/world/camera_process.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/world/item_factory.h"
+#include "ultima/ultima8/world/item_sorter.h"
 #include "ultima/ultima8/world/actors/quick_avatar_mover_process.h"
 #include "ultima/ultima8/world/actors/avatar_mover_process.h"
 #include "ultima/ultima8/world/target_reticle_process.h"
@@ -136,8 +137,10 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::sortStats", WRAP_METHOD(Debugger, cmdSortStats));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
+	registerCmd("Kernel::processTimes", WRAP_METHOD(Debugger, cmdProcessTimes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
 	registerCmd("Kernel::listProcesses", WRAP_METHOD(Debugger, cmdListProcesses));
 	registerCmd("Kernel::toggleFrameByFrame", WRAP_METHOD(Debugger, cmdToggleFrameByFrame));
@@ -849,12 +852,46 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdSortStats(int argc, const char **argv) {
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No game map\n");
+		return true;
+	}
+
+	const ItemSorter::Stats &stats = gump->getDisplayList()->getStats();
+	debugPrintf("Items: %u\n", stats._items);
+	debugPrintf("Overlap tests: %u\n", stats._overlapTests);
+	debugPrintf("Order comparisons: %u\n", stats._orderComparisons);
+	debugPrintf("Items placed from last frame's order: %u\n", stats._reusedOrder);
+	debugPrintf("Full sorts: %u\n", stats._fullSorts);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
 	return true;
 }
 
+bool Debugger::cmdProcessTimes(int argc, const char **argv) {
+	Kernel *kern = Kernel::get_instance();
+	if (argc == 1) {
+		kern->processTimes();
+	} else if (!strcmp(argv[1], "on")) {
+		kern->setProfiling(true);
+		debugPrintf("Process profiling enabled\n");
+	} else if (!strcmp(argv[1], "off")) {
+		kern->setProfiling(false);
+		debugPrintf("Process profiling disabled\n");
+	} else if (!strcmp(argv[1], "reset")) {
+		kern->resetProcessTimes();
+	} else {
+		debugPrintf("usage: processTimes [on|off|reset]\n");
+	}
+	return true;
+}
+
 bool Debugger::cmdListProcesses(int argc, const char **argv) {
 	if (argc > 2) {
 		debugPrintf("usage: listProcesses [<itemnum>]\n");
@@ -867,8 +904,10 @@ bool Debugger::cmdListProcesses(int argc, const char **argv) {
 		} else {
 			debugPrintf("Processes:\n");
 		}
-		for (ProcessIterator it = kern->_processes.begin();
-			it != kern->_processes.end(); ++it) {
+		Std::vector<Process *> procs;
+		kern->getProcesses(procs);
+		for (Std::vector<Process *>::const_iterator it = procs.begin();
+			it != procs.end(); ++it) {
 			Process *p = *it;
 			if (argc == 1 || p->_itemNum == item) {
 				debugPrintf("%s\n", p->dumpInfo().c_str());
@@ -112,9 +112,11 @@ private:
 	bool cmdDumpAllMaps(int argc, const char **argv);
 	bool cmdIncrementSortOrder(int argc, const char **argv);
 	bool cmdDecrementSortOrder(int argc, const char **argv);
+	bool cmdSortStats(int argc, const char **argv);
 
 	// Kernel
 	bool cmdProcessTypes(int argc, const char **argv);
+	bool cmdProcessTimes(int argc, const char **argv);
 	bool cmdListProcesses(int argc, const char **argv);
 	bool cmdProcessInfo(int argc, const char **argv);
 	bool cmdToggleFrameByFrame(int argc, const char **argv);
@@ -1599,9 +1599,9 @@ ProcId Actor::dieCru(uint16 damageType, uint16 damagePts, Direction srcDir) {
 
 void Actor::killAllButCombatProcesses() {
 	// loop over all processes, keeping only the relevant ones
-	ProcessIter iter = Kernel::get_instance()->getProcessBeginIterator();
-	ProcessIter endproc = Kernel::get_instance()->getProcessEndIterator();
-	for (; iter != endproc; ++iter) {
+	Std::vector<Process *> procs;
+	Kernel::get_instance()->getProcesses(procs, _objId);
+	for (Std::vector<Process *>::const_iterator iter = procs.begin(); iter != procs.end(); ++iter) {
 		Process *p = *iter;
 		if (!p) continue;
 		if (p->getItemNum() != _objId) continue;
@@ -1630,9 +1630,9 @@ ProcId Actor::killAllButFallAnims(bool death) {
 	}
 
 	// loop over all animation processes, keeping only the relevant ones
-	ProcessIter iter = Kernel::get_instance()->getProcessBeginIterator();
-	ProcessIter endproc = Kernel::get_instance()->getProcessEndIterator();
-	for (; iter != endproc; ++iter) {
+	Std::vector<Process *> procs;
+	kernel->getProcesses(procs, _objId);
+	for (Std::vector<Process *>::const_iterator iter = procs.begin(); iter != procs.end(); ++iter) {
 		ActorAnimProcess *p = dynamic_cast<ActorAnimProcess *>(*iter);
 		if (!p) continue;
 		if (p->getItemNum() != _objId) continue;
@@ -38,27 +38,38 @@
 
 #include "ultima/ultima8/world/sort_item.h"
 
+#include "common/algorithm.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
+// Size in pixels of the screenspace grid cells used for overlap tests
+static const int32 GRID_CELL_SIZE = 64;
+
+// Give up on the previous frame's order when more than this many list
+// moves per item are needed to fix it up.
+static const uint32 MAX_REORDER_MOVES = 8;
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_itemsUnused(nullptr), _painted(nullptr), _sorted(true), _gridWidth(0),
+	_gridHeight(0), _camSx(0), _camSy(0), _sortLimit(0), _sortLimitChanged(false) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
 		_itemsUnused = new SortItem();
 		_itemsUnused->_next = next;
 	}
+	_added.reserve(capacity);
 }
 
 ItemSorter::~ItemSorter() {
 	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	for (uint i = 0; i < _added.size(); i++) {
+		_added[i]->_next = _itemsUnused;
+		_itemsUnused = _added[i];
 	}
+	_added.clear();
 	_items = nullptr;
 	_itemsTail = nullptr;
 
@@ -78,15 +89,32 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, int32 camx, int32 camy
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
 
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	for (uint i = 0; i < _added.size(); i++) {
+		_added[i]->_next = _itemsUnused;
+		_itemsUnused = _added[i];
 	}
 
+	_added.resize(0);
+	_sorted = true;
 	_items = nullptr;
 	_itemsTail = nullptr;
 	_painted = nullptr;
 
+	_stats = Stats();
+
+	// Reset the grid, keeping the memory of each cell
+	int32 gridWidth = MAX<int32>(1, (clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	int32 gridHeight = MAX<int32>(1, (clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	if (gridWidth != _gridWidth || gridHeight != _gridHeight) {
+		_gridWidth = gridWidth;
+		_gridHeight = gridHeight;
+		_grid.clear();
+		_grid.resize(_gridWidth * _gridHeight);
+	} else {
+		for (uint i = 0; i < _grid.size(); i++)
+			_grid[i].resize(0);
+	}
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (camx - camy) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -185,63 +213,64 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
-
-		// Doesn't overlap
-		if (si2->_occluded || !si->overlap(*si2))
-			continue;
-
-		// Attempt to find which is infront
-		if (si->below(*si2)) {
-			if (si2->_occl && si2->occludes(*si)) {
-				// No need to do any more checks, this isn't visible
-				si->_occluded = true;
-				break;
-			} else {
-				// si1 is behind si2, so add it to si2's dependency list
-				si2->_depends.insert_sorted(si);
-			}
-		} else {
-			if (si->_occl && si->occludes(*si2)) {
-				// Occluded, but we can't remove it from the list
-				si2->_occluded = true;
-			} else {
-				// si2 is behind si1, so add it to si1's dependency list
-				si->_depends.insert_sorted(si2);
+	si->_addIndex = _added.size();
+	si->_overlapCheck = 0;
+
+	// Compare against the items sharing a grid cell with us
+	int32 cellLeft = CLIP<int32>((si->_sr.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	int32 cellRight = CLIP<int32>((si->_sr.right - 1 - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	int32 cellTop = CLIP<int32>((si->_sr.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+	int32 cellBottom = CLIP<int32>((si->_sr.bottom - 1 - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+
+	for (int32 cy = cellTop; cy <= cellBottom && !si->_occluded; cy++) {
+		for (int32 cx = cellLeft; cx <= cellRight && !si->_occluded; cx++) {
+			const Common::Array<SortItem *> &cell = _grid[cy * _gridWidth + cx];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+
+				// Already tested from another cell
+				if (si2->_overlapCheck == si->_addIndex + 1)
+					continue;
+				si2->_overlapCheck = si->_addIndex + 1;
+
+				// Doesn't overlap
+				if (si2->_occluded)
+					continue;
+				_stats._overlapTests++;
+				if (!si->overlap(*si2))
+					continue;
+
+				// Attempt to find which is infront
+				if (si->below(*si2)) {
+					if (si2->_occl && si2->occludes(*si)) {
+						// No need to do any more checks, this isn't visible
+						si->_occluded = true;
+						break;
+					} else {
+						// si1 is behind si2, so add it to si2's dependency list
+						si2->_depends.insert_sorted(si);
+					}
+				} else {
+					if (si->_occl && si->occludes(*si2)) {
+						// Occluded, but we can't remove it from the list
+						si2->_occluded = true;
+					} else {
+						// si2 is behind si1, so add it to si1's dependency list
+						si->_depends.insert_sorted(si2);
+					}
+				}
 			}
 		}
 	}
 
-	// Add it to the list
+	// Add it to the list, it is put in the right place by SortDisplayList
 	_itemsUnused = _itemsUnused->_next;
+	_added.push_back(si);
+	_sorted = false;
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+	for (int32 cy = cellTop; cy <= cellBottom; cy++) {
+		for (int32 cx = cellLeft; cx <= cellRight; cx++)
+			_grid[cy * _gridWidth + cx].push_back(si);
 	}
 }
 
@@ -252,7 +281,93 @@ void ItemSorter::AddItem(const Item *add) {
 			add->getFlags(), add->getExtFlags(), add->getObjId());
 }
 
+void ItemSorter::SortDisplayList() {
+	_sorted = true;
+	_stats._items = _added.size();
+
+	// The list is ordered by listLessThan, keeping the order items were
+	// added in when they compare equal.
+	struct ListLess {
+		uint32 &_count;
+		ListLess(uint32 &count) : _count(count) {}
+		bool operator()(const SortItem *si1, const SortItem *si2) const {
+			_count++;
+			if (si1->listLessThan(*si2))
+				return true;
+			if (si2->listLessThan(*si1))
+				return false;
+			return si1->_addIndex < si2->_addIndex;
+		}
+	};
+	ListLess less(_stats._orderComparisons);
+
+	// Start from the order of the previous frame, which mostly still holds
+	// when only a few items moved.
+	Common::Array<SortItem *> sorted;
+	sorted.reserve(_added.size());
+
+	_orderSlots.resize(0);
+	_orderSlots.resize(_lastOrder.size() + _added.size());
+	for (uint i = 0; i < _orderSlots.size(); i++)
+		_orderSlots[i] = nullptr;
+
+	for (uint i = 0; i < _added.size(); i++) {
+		SortItem *si = _added[i];
+		Common::HashMap<uint16, uint32>::const_iterator last = si->_itemNum ? _lastOrder.find(si->_itemNum) : _lastOrder.end();
+		if (last != _lastOrder.end() && !_orderSlots[last->_value]) {
+			_orderSlots[last->_value] = si;
+			_stats._reusedOrder++;
+		} else {
+			_orderSlots[_lastOrder.size() + i] = si;
+		}
+	}
+	for (uint i = 0; i < _orderSlots.size(); i++) {
+		if (_orderSlots[i])
+			sorted.push_back(_orderSlots[i]);
+	}
+
+	// Insertion sort is linear when little has changed, fall back to a full
+	// sort when it stops being cheap.
+	uint32 moves = 0;
+	const uint32 maxMoves = MAX_REORDER_MOVES * sorted.size();
+	for (uint i = 1; i < sorted.size() && moves <= maxMoves; i++) {
+		SortItem *si = sorted[i];
+		uint j = i;
+		while (j > 0 && less(si, sorted[j - 1])) {
+			sorted[j] = sorted[j - 1];
+			j--;
+			moves++;
+		}
+		sorted[j] = si;
+	}
+	if (moves > maxMoves) {
+		_stats._fullSorts++;
+		Common::sort(sorted.begin(), sorted.end(), less);
+	}
+
+	// Link the list and remember the order for the next frame
+	_lastOrder.clear(true);
+	_items = nullptr;
+	_itemsTail = nullptr;
+	for (uint i = 0; i < sorted.size(); i++) {
+		SortItem *si = sorted[i];
+		si->_prev = _itemsTail;
+		si->_next = nullptr;
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		else
+			_items = si;
+		_itemsTail = si;
+
+		if (si->_itemNum)
+			_lastOrder[si->_itemNum] = i;
+	}
+}
+
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight) {
+	if (!_sorted)
+		SortDisplayList();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		surf->Fill32(0, _clipWindow);
@@ -375,6 +490,11 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	if (!_sorted) {
+		SortDisplayList();
+		_painted = nullptr;
+	}
+
 	if (!_painted) { // If no painted item found, we need to sort the items
 		it = _items;
 		_painted = nullptr;
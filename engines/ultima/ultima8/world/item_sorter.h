@@ -22,6 +22,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -33,6 +35,20 @@ class RenderSurface;
 struct SortItem;
 
 class ItemSorter {
+public:
+	// Work done by the sorter, for the debugger
+	struct Stats {
+		uint32 _items;            // Items in the display list
+		uint32 _overlapTests;     // Item pairs tested for overlap
+		uint32 _orderComparisons; // Comparisons made ordering the list
+		uint32 _reusedOrder;      // Items placed from the previous frame's order
+		uint32 _fullSorts;        // Frames the previous order was not usable
+
+		Stats() : _items(0), _overlapTests(0), _orderComparisons(0),
+			_reusedOrder(0), _fullSorts(0) {}
+	};
+
+private:
 	MainShapeArchive    *_shapes;
 	Rect        _clipWindow;
 
@@ -41,10 +57,25 @@ class ItemSorter {
 	SortItem    *_itemsUnused;
 	SortItem    *_painted;
 
+	// Items in the order they were added, linked into _items when sorted
+	Common::Array<SortItem *> _added;
+	bool        _sorted;
+
+	// Screenspace grid of the items covering each cell, so that only
+	// nearby items are tested for overlap
+	Common::Array<Common::Array<SortItem *> > _grid;
+	int32       _gridWidth, _gridHeight;
+
+	// List position of each item number in the previous frame
+	Common::HashMap<uint16, uint32> _lastOrder;
+	Common::Array<SortItem *> _orderSlots;
+
 	int32       _camSx, _camSy;
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	Stats       _stats;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -68,8 +99,16 @@ public:
 
 	void IncSortLimit(int count);
 
+	// Statistics of the last display list
+	const Stats &getStats() const {
+		return _stats;
+	}
+
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si);
+
+	// Order the added items and link them into the list
+	void SortDisplayList();
 };
 
 } // End of namespace Ultima8
@@ -48,7 +48,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _clipped(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _addIndex(0), _overlapCheck(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -215,6 +215,9 @@ struct SortItem {
 	// All this Items dependencies (i.e. all objects behind)
 	DependsList _depends;
 
+	uint32  _addIndex;      // Position in which the item was added to the sorter
+	uint32  _overlapCheck;  // _addIndex + 1 of the last item tested against this one
+
 	// Functions
 
 	// Set worldspace bounds and calculate screenspace at center point
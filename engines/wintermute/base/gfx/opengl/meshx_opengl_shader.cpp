@@ -52,11 +52,12 @@ XMeshOpenGLShader::~XMeshOpenGLShader() {
 }
 
 bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData *xobj, Common::Array<MaterialReference> &materialReferences) {
-	auto indexData = _skinMesh->_mesh->_indexData;
-	float *vertexData = _skinMesh->_mesh->_vertexData;
-	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-
 	if (XMesh::loadFromXData(filename, xobj, materialReferences)) {
+		// the mesh data only exists once loaded
+		auto &indexData = _skinMesh->_mesh->_indexData;
+		float *vertexData = _skinMesh->_mesh->_vertexData;
+		uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
+
 		glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
 		glBufferData(GL_ARRAY_BUFFER, 4 * XSkinMeshLoader::kVertexComponentCount * vertexCount, vertexData, GL_DYNAMIC_DRAW);
 
@@ -72,8 +73,8 @@ bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData
 //////////////////////////////////////////////////////////////////////////
 bool XMeshOpenGLShader::render(XModel *model) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
-	auto indexRanges = _skinMesh->_mesh->_indexRanges;
-	auto materialIndices = _skinMesh->_mesh->_materialIndices;
+	auto &indexRanges = _skinMesh->_mesh->_indexRanges;
+	auto &materialIndices = _skinMesh->_mesh->_materialIndices;
 	if (vertexData == nullptr) {
 		return false;
 	}
@@ -117,7 +118,7 @@ bool XMeshOpenGLShader::render(XModel *model) {
 
 bool XMeshOpenGLShader::renderFlatShadowModel() {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
-	auto indexRanges = _skinMesh->_mesh->_indexRanges;
+	auto &indexRanges = _skinMesh->_mesh->_indexRanges;
 	if (vertexData == nullptr) {
 		return false;
 	}
@@ -138,6 +139,11 @@ bool XMeshOpenGLShader::renderFlatShadowModel() {
 bool XMeshOpenGLShader::update(FrameNode *parentFrame) {
 	XMesh::update(parentFrame);
 
+	// the buffer still holds the last pose
+	if (!_vertexDataChanged) {
+		return true;
+	}
+
 	float *vertexData = _skinMesh->_mesh->_vertexData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
 
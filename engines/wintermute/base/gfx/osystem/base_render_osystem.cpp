@@ -171,6 +171,7 @@ bool BaseRenderOSystem::flip() {
 		}
 
 		addDirtyRect(_renderRect);
+		rebuildTicketIndex();
 		return true;
 	}
 	if (!_disableDirtyRects) {
@@ -204,6 +205,7 @@ bool BaseRenderOSystem::flip() {
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
+	rebuildTicketIndex();
 
 	g_system->updateScreen();
 
@@ -302,22 +304,20 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it;
+		if (findQueuedTicket(_ticketsByDraw, compare, false, it)) {
+			drawFromQueuedTicket(it);
+			return;
+		}
+		// The same image moved: reuse last frame's ticket instead of copying
+		// and transforming the surface again.
+		if (findQueuedTicket(_ticketsByShape, compare, true, it)) {
+			RenderTicket *ticket = *it;
+			addDirtyRect(ticket->_dstRect);
+			ticket->_dstRect = *dstRect;
+			_renderQueue.erase(it);
+			drawFromTicket(ticket);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
@@ -381,6 +381,75 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+void BaseRenderOSystem::TicketIndex::clear() {
+	_chains.clear();
+	// Keep the storage, the index is rebuilt every frame
+	_entries.resize(0);
+}
+
+void BaseRenderOSystem::TicketIndex::add(uint32 hash, const RenderQueueIterator &pos) {
+	Entry entry;
+	entry._ticket = *pos;
+	entry._pos = pos;
+	entry._next = -1;
+	int index = (int)_entries.size();
+	_entries.push_back(entry);
+
+	Common::HashMap<uint32, Chain>::iterator chain = _chains.find(hash);
+	if (chain == _chains.end()) {
+		Chain &newChain = _chains[hash];
+		newChain._first = newChain._last = index;
+	} else {
+		_entries[chain->_value._last]._next = index;
+		chain->_value._last = index;
+	}
+}
+
+bool BaseRenderOSystem::findQueuedTicket(TicketIndex &index, const RenderTicket &compare, bool sameShape, RenderQueueIterator &ticket) {
+	Common::HashMap<uint32, TicketIndex::Chain>::iterator chain = index._chains.find(sameShape ? compare.getShapeHash() : compare.getDrawHash());
+	if (chain == index._chains.end()) {
+		return false;
+	}
+
+	// Tickets that were drawn or invalidated this frame never become
+	// available again until the index is rebuilt, so skip them for good.
+	// Their queue position may be stale, only tickets still waiting are
+	// guaranteed not to have been moved.
+	int i = chain->_value._first;
+	while (i >= 0 && (index._entries[i]._ticket->_wantsDraw || !index._entries[i]._ticket->_isValid)) {
+		i = index._entries[i]._next;
+	}
+	chain->_value._first = i;
+
+	for (; i >= 0; i = index._entries[i]._next) {
+		const TicketIndex::Entry &entry = index._entries[i];
+		if (entry._ticket->_wantsDraw || !entry._ticket->_isValid) {
+			continue;
+		}
+		if (sameShape ? entry._ticket->hasSameShape(compare) : *entry._ticket == compare) {
+			ticket = entry._pos;
+			return true;
+		}
+	}
+	return false;
+}
+
+void BaseRenderOSystem::rebuildTicketIndex() {
+	_ticketsByDraw.clear();
+	_ticketsByShape.clear();
+	if (_disableDirtyRects) {
+		return;
+	}
+
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		RenderTicket *ticket = *it;
+		if (ticket->_owner && ticket->_isValid) {
+			_ticketsByDraw.add(ticket->getDrawHash(), it);
+			_ticketsByShape.add(ticket->getShapeHash(), it);
+		}
+	}
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
 	if (!_dirtyRect) {
 		_dirtyRect = new Common::Rect(rect);
@@ -592,6 +661,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	// so just skip this single frame.
 	_skipThisFrame = true;
 	_lastFrameIter = _renderQueue.end();
+	rebuildTicketIndex();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
@@ -32,6 +32,7 @@
 
 #include "common/rect.h"
 #include "common/list.h"
+#include "common/hashmap.h"
 
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
@@ -130,8 +131,39 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
+
+	/**
+	 * Hash index over the tickets queued last frame, so that incoming draw
+	 * calls find their ticket without walking the whole queue. Tickets with
+	 * the same hash are chained in queue order.
+	 */
+	struct TicketIndex {
+		struct Entry {
+			RenderTicket *_ticket;
+			RenderQueueIterator _pos;
+			int _next;
+		};
+		struct Chain {
+			int _first;
+			int _last;
+		};
+		Common::HashMap<uint32, Chain> _chains;
+		Common::Array<Entry> _entries;
+
+		void clear();
+		void add(uint32 hash, const RenderQueueIterator &pos);
+	};
+	/**
+	 * Find the first ticket of last frame that is still waiting to be drawn
+	 * and matches @p compare exactly, or only by shape.
+	 */
+	bool findQueuedTicket(TicketIndex &index, const RenderTicket &compare, bool sameShape, RenderQueueIterator &ticket);
+	void rebuildTicketIndex();
+
 	Common::Rect *_dirtyRect;
 	Common::List<RenderTicket *> _renderQueue;
+	TicketIndex _ticketsByDraw;
+	TicketIndex _ticketsByShape;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
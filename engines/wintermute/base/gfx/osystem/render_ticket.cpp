@@ -97,6 +97,40 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+bool RenderTicket::hasSameShape(const RenderTicket &t) const {
+	if ((t._owner != _owner) ||
+		(t._transform != _transform) ||
+		(t._dstRect.width() != _dstRect.width()) ||
+		(t._dstRect.height() != _dstRect.height()) ||
+		(t._srcRect != _srcRect)
+	) {
+		return false;
+	}
+	return true;
+}
+
+static inline uint32 hashCombine(uint32 hash, uint32 value) {
+	return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+}
+
+uint32 RenderTicket::getShapeHash() const {
+	uint32 hash = (uint32)(uintptr)_owner;
+	hash = hashCombine(hash, (uint16)_srcRect.left | ((uint32)(uint16)_srcRect.top << 16));
+	hash = hashCombine(hash, (uint16)_srcRect.right | ((uint32)(uint16)_srcRect.bottom << 16));
+	hash = hashCombine(hash, (uint16)_dstRect.width() | ((uint32)(uint16)_dstRect.height() << 16));
+	hash = hashCombine(hash, (uint32)_transform._angle);
+	hash = hashCombine(hash, (uint16)_transform._zoom.x | ((uint32)(uint16)_transform._zoom.y << 16));
+	hash = hashCombine(hash, (uint16)_transform._offset.x | ((uint32)(uint16)_transform._offset.y << 16));
+	hash = hashCombine(hash, _transform._rgbaMod);
+	hash = hashCombine(hash, _transform._flip | (_transform._alphaDisable << 8) | ((uint32)(_transform._blendMode + 1) << 16));
+	hash = hashCombine(hash, (uint16)_transform._numTimesX | ((uint32)(uint16)_transform._numTimesY << 16));
+	return hash;
+}
+
+uint32 RenderTicket::getDrawHash() const {
+	return hashCombine(getShapeHash(), (uint16)_dstRect.left | ((uint32)(uint16)_dstRect.top << 16));
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
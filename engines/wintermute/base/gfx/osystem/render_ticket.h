@@ -68,6 +68,15 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/**
+	 * Whether the ticket draws the same image as @p a, at any position.
+	 * Such a ticket's transformed surface can be reused for @p a.
+	 */
+	bool hasSameShape(const RenderTicket &a) const;
+	/** Hash of everything operator== compares. */
+	uint32 getDrawHash() const;
+	/** Hash of everything hasSameShape() compares. */
+	uint32 getShapeHash() const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
@@ -43,6 +43,8 @@ XMesh::XMesh(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame) {
 
 	_skinMesh = nullptr;
 	_skinnedMesh = false;
+	_poseValid = false;
+	_vertexDataChanged = false;
 
 	_BBoxStart = Math::Vector3d(0.0f, 0.0f, 0.0f);
 	_BBoxEnd = Math::Vector3d(0.0f, 0.0f, 0.0f);
@@ -80,7 +82,7 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 	if (!_skinnedMesh) {
 		return true;
 	}
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	_boneMatrices.resize(skinWeightsList.size());
 
@@ -90,13 +92,66 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 		if (frame) {
 			_boneMatrices[i] = frame->getCombinedMatrix();
 		} else {
+			_boneMatrices[i] = nullptr;
 			warning("XMeshOpenGL::findBones could not find bone %s", skinWeightsList[i]._boneName.c_str());
 		}
 	}
 
+	buildInfluences();
+
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void XMesh::buildInfluences() {
+	auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
+
+	_influenceStart.clear();
+	_influenceStart.resize(vertexCount + 1, 0);
+
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
+			uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
+			if (vertexIndex < vertexCount) {
+				_influenceStart[vertexIndex + 1]++;
+			}
+		}
+	}
+
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		_influenceStart[i + 1] += _influenceStart[i];
+	}
+
+	// keep the bone order for every vertex, so the weighted sums are
+	// accumulated in the same order as before
+	BaseArray<uint32> next;
+	next.resize(vertexCount);
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		next[i] = _influenceStart[i];
+	}
+
+	_influenceBones.resize(_influenceStart[vertexCount]);
+	_influenceWeights.resize(_influenceStart[vertexCount]);
+
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
+			uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
+			if (vertexIndex < vertexCount) {
+				uint32 influence = next[vertexIndex]++;
+				_influenceBones[influence] = boneIndex;
+				_influenceWeights[influence] = skinWeightsList[boneIndex]._vertexWeights[i];
+			}
+		}
+	}
+
+	_skinMatrices.clear();
+	_skinMatrices.resize(skinWeightsList.size());
+	_normalMatrices.clear();
+	_normalMatrices.resize(skinWeightsList.size());
+	_poseValid = false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
@@ -105,78 +160,52 @@ bool XMesh::update(FrameNode *parentFrame) {
 	}
 
 	float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
-	float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+
+	_vertexDataChanged = false;
 
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
-		finalBoneMatrices.resize(_boneMatrices.size());
-
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+		if (_influenceStart.size() != vertexCount + 1 || _skinMatrices.size() != skinWeightsList.size()) {
+			buildInfluences();
 		}
 
-		// the new vertex coordinates are the weighted sum of the product
-		// of the combined bone transformation matrices and the static pose coordinates
-		// to be able too add the weighted summands together, we reset everything to zero first
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
-			}
-		}
-
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			// to every vertex which is affected by the bone, we add the product
-			// of the bone transformation with the coordinates of the static pose,
-			// weighted by the weight for the particular vertex
-			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] += pos.getData()[j];
-				}
-			}
-		}
+		bool poseChanged = !_poseValid;
 
-		// now we have to update the vertex normals as well, so prepare the bone transformations
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
-		}
+			// bones which could not be found keep the identity matrix
+			if (i >= _boneMatrices.size() || !_boneMatrices[i]) {
+				continue;
+			}
 
-		// reset so we can form the weighted sums
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
+			Math::Matrix4 finalMatrix = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+			if (memcmp(finalMatrix.getData(), _skinMatrices[i].getData(), 16 * sizeof(float)) != 0) {
+				_skinMatrices[i] = finalMatrix;
+				// the vertex normals need the inverse transposed bone transformations
+				_normalMatrices[i] = finalMatrix;
+				_normalMatrices[i].transpose();
+				_normalMatrices[i].inverse();
+				poseChanged = true;
 			}
 		}
 
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] += pos.getData()[j];
-				}
-			}
+		// nothing moved since the last frame, the vertex data is still good
+		if (!poseChanged) {
+			return true;
 		}
 
-	//updateNormals();
+		skinVertices();
 	} else { // update static
+		const Math::Matrix4 *combinedMatrix = parentFrame->getCombinedMatrix();
+		if (_poseValid && memcmp(combinedMatrix->getData(), _lastCombinedMatrix.getData(), 16 * sizeof(float)) == 0) {
+			return true;
+		}
+		_lastCombinedMatrix = *combinedMatrix;
+
 		for (uint32 i = 0; i < vertexCount; ++i) {
 			Math::Vector3d pos(vertexPositionData + 3 * i);
-			parentFrame->getCombinedMatrix()->transform(&pos, true);
+			combinedMatrix->transform(&pos, true);
 
 			for (uint j = 0; j < 3; ++j) {
 				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = pos.getData()[j];
@@ -184,11 +213,58 @@ bool XMesh::update(FrameNode *parentFrame) {
 		}
 	}
 
+	_poseValid = true;
+	_vertexDataChanged = true;
+
 	updateBoundingBox();
 
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void XMesh::skinVertices() {
+	float *vertexData = _skinMesh->_mesh->_vertexData;
+	const float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
+	const float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
+	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
+
+	const uint32 *influenceStart = _influenceStart.data();
+	const uint32 *influenceBones = _influenceBones.data();
+	const float *influenceWeights = _influenceWeights.data();
+
+	// the new vertex coordinates are the weighted sum of the product
+	// of the combined bone transformation matrices and the static pose coordinates,
+	// the same goes for the normals with the inverse transposed matrices
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		const float *p = vertexPositionData + i * 3;
+		const float *n = vertexNormalData + i * 3;
+		float px = 0.0f, py = 0.0f, pz = 0.0f;
+		float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+
+		for (uint32 k = influenceStart[i]; k < influenceStart[i + 1]; ++k) {
+			const float *m = _skinMatrices[influenceBones[k]].getData();
+			const float *nm = _normalMatrices[influenceBones[k]].getData();
+			const float w = influenceWeights[k];
+
+			px += (m[0] * p[0] + m[1] * p[1] + m[2] * p[2] + m[3]) * w;
+			py += (m[4] * p[0] + m[5] * p[1] + m[6] * p[2] + m[7]) * w;
+			pz += (m[8] * p[0] + m[9] * p[1] + m[10] * p[2] + m[11]) * w;
+
+			nx += (nm[0] * n[0] + nm[1] * n[1] + nm[2] * n[2] + nm[3]) * w;
+			ny += (nm[4] * n[0] + nm[5] * n[1] + nm[6] * n[2] + nm[7]) * w;
+			nz += (nm[8] * n[0] + nm[9] * n[1] + nm[10] * n[2] + nm[11]) * w;
+		}
+
+		float *vertex = vertexData + i * XSkinMeshLoader::kVertexComponentCount;
+		vertex[XSkinMeshLoader::kPositionOffset + 0] = px;
+		vertex[XSkinMeshLoader::kPositionOffset + 1] = py;
+		vertex[XSkinMeshLoader::kPositionOffset + 2] = pz;
+		vertex[XSkinMeshLoader::kNormalOffset + 0] = nx;
+		vertex[XSkinMeshLoader::kNormalOffset + 1] = ny;
+		vertex[XSkinMeshLoader::kNormalOffset + 2] = nz;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const Math::Vector3d &light, float extrusionDepth) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
@@ -203,7 +279,7 @@ bool XMesh::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const
 
 	uint32 numEdges = 0;
 
-	auto indexData = _skinMesh->_mesh->_indexData;
+	auto &indexData = _skinMesh->_mesh->_indexData;
 	Common::Array<bool> isFront(indexData.size() / 3, false);
 
 	// First pass : for each face, record if it is front or back facing the light
@@ -288,7 +364,7 @@ bool XMesh::pickPoly(Math::Vector3d *pickRayOrig, Math::Vector3d *pickRayDir) {
 
 	bool res = false;
 
-	auto indexData = _skinMesh->_mesh->_indexData;
+	auto &indexData = _skinMesh->_mesh->_indexData;
 	for (uint16 i = 0; i < indexData.size(); i += 3) {
 		uint16 index1 = indexData[i + 0];
 		uint16 index2 = indexData[i + 1];
@@ -351,6 +427,8 @@ bool XMesh::restoreDeviceObjects() {
 		_materials[i]->restoreDeviceObjects();
 	}
 
+	_poseValid = false;
+
 	if (_skinnedMesh) {
 		return _skinMesh->_mesh->generateAdjacency(_adjacency);
 	} else {
@@ -72,6 +72,8 @@ public:
 protected:
 
 	void updateBoundingBox();
+	void buildInfluences();
+	void skinVertices();
 
 	uint32 _numAttrs;
 
@@ -84,6 +86,20 @@ protected:
 
 	BaseArray<Math::Matrix4 *> _boneMatrices;
 
+	// bone influences regrouped per vertex, so that each vertex is skinned
+	// in one go; influences of vertex i are [_influenceStart[i], _influenceStart[i + 1])
+	BaseArray<uint32> _influenceStart;
+	BaseArray<uint32> _influenceBones;
+	BaseArray<float> _influenceWeights;
+
+	// pose the vertex data was last computed for, to skip unchanged frames
+	BaseArray<Math::Matrix4> _skinMatrices;
+	BaseArray<Math::Matrix4> _normalMatrices;
+	Math::Matrix4 _lastCombinedMatrix;
+	bool _poseValid;
+	// whether the last update() changed the vertex data
+	bool _vertexDataChanged;
+
 	Common::Array<uint32> _adjacency;
 
 	BaseArray<Material *> _materials;
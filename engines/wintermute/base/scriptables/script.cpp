@@ -57,6 +57,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varCache = nullptr;
 
 	_engine = engine;
 
@@ -188,6 +189,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	delete[] _varCache;
+	_varCache = new VarCacheEntry[_numSymbols];
+	memset(_varCache, 0, _numSymbols * sizeof(VarCacheEntry));
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -397,6 +402,9 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varCache;
+	_varCache = nullptr;
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -742,7 +750,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		// Disabled in original code
 		/*if (false && var->_type==VAL_OBJECT || var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
@@ -754,15 +762,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -813,7 +820,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1215,6 +1222,47 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(uint32 symbolIndex) {
+	ScValue *scope = _scopeStack->_sP >= 0 ? _scopeStack->getTop() : nullptr;
+	ScValue *engineGlobals = _engine->_globals;
+
+	uint32 scopeVersion = scope ? scope->getPropsVersion() : 0;
+	uint32 globalsVersion = _globals->getPropsVersion();
+	uint32 engineGlobalsVersion = engineGlobals->getPropsVersion();
+
+	// Only plain objects can be trusted to resolve the same name the same
+	// way while their props stay the same, natives and references can't
+	bool cacheable =
+		(!scope || scope->_type == VAL_OBJECT || scope->_type == VAL_NULL) &&
+		(_globals->_type == VAL_OBJECT || _globals->_type == VAL_NULL) &&
+		(engineGlobals->_type == VAL_OBJECT || engineGlobals->_type == VAL_NULL);
+
+	VarCacheEntry &entry = _varCache[symbolIndex];
+	if (cacheable && entry._value && entry._scope == scope &&
+	        entry._scopeVersion == scopeVersion &&
+	        entry._globalsVersion == globalsVersion &&
+	        entry._engineGlobalsVersion == engineGlobalsVersion) {
+		return entry._value;
+	}
+
+	ScValue *ret = getVar(_symbols[symbolIndex]);
+
+	// Resolving may have created the variable, so take the versions again
+	if (cacheable) {
+		entry._value = ret;
+		entry._scope = scope;
+		entry._scopeVersion = scope ? scope->getPropsVersion() : 0;
+		entry._globalsVersion = _globals->getPropsVersion();
+		entry._engineGlobalsVersion = engineGlobals->getPropsVersion();
+	} else {
+		entry._value = nullptr;
+	}
+
+	return ret;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
@@ -79,6 +79,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getVar(uint32 symbolIndex);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -152,6 +153,17 @@ public:
 private:
 	char **_symbols;
 	uint32 _numSymbols;
+
+	// Where each symbol was last resolved to by getVar(), valid as long as
+	// the props of the scopes looked into have not changed since
+	struct VarCacheEntry {
+		ScValue *_value;
+		ScValue *_scope;
+		uint32 _scopeVersion;
+		uint32 _globalsVersion;
+		uint32 _engineGlobalsVersion;
+	};
+	VarCacheEntry *_varCache;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
 	TEventPos *_events;
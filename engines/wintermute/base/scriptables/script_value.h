@@ -105,6 +105,18 @@ public:
 	bool setProperty(const char *propName, double value);
 	bool setProperty(const char *propName, bool value);
 	bool setProperty(const char *propName);
+
+	/**
+	 * Changes whenever props are added to or removed from _valObject.
+	 * Versions are unique across all values, so a (value, version) pair
+	 * also tells a value apart from a new one allocated at the same address.
+	 */
+	uint32 getPropsVersion() const { return _propsVersion; }
+
+private:
+	uint32 _propsVersion;
+	static uint32 _lastPropsVersion;
+	void propsChanged() { _propsVersion = ++_lastPropsVersion; }
 };
 
 } // End of namespace Wintermute
@@ -24,6 +24,8 @@
 #include "common/math.h"
 #include "common/rect.h"
 #include "common/scummsys.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace ZVision {
 
@@ -34,6 +36,8 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceIndices = new uint32[numRows * numColumns];
+	generateSourceIndices();
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -41,6 +45,7 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceIndices;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -87,43 +92,34 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 	uint32 destOffset = 0;
 
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *sourceIndices = _sourceIndices + y * _numColumns + subRect.left;
+		uint16 *dest = destBuffer + destOffset;
 
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+		for (int16 x = 0; x < subRect.width(); ++x)
+			dest[x] = sourceBuffer[sourceIndices[x]];
 
 		destOffset += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+	const int16 width = srcBuf->w;
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+	// Every destination row only depends on the source image, so the rows
+	// can be warped in bands on the thread pool
+	const uint kMinBandRows = 32;
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+	g_system->getThreadPool().parallelFor(0, srcBuf->h, kMinBandRows, [&](uint first, uint last) {
+		for (uint y = first; y < last; ++y) {
+			const uint32 *sourceIndices = _sourceIndices + y * _numColumns;
+			uint16 *dest = destBuffer + y * width;
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+			for (int16 x = 0; x < width; ++x)
+				dest[x] = sourceBuffer[sourceIndices[x]];
 		}
-	}
+	});
 }
 
 void RenderTable::generateRenderTable() {
@@ -140,6 +136,22 @@ void RenderTable::generateRenderTable() {
 	default:
 		break;
 	}
+
+	generateSourceIndices();
+}
+
+void RenderTable::generateSourceIndices() {
+	for (uint y = 0; y < _numRows; ++y) {
+		for (uint x = 0; x < _numColumns; ++x) {
+			uint32 index = y * _numColumns + x;
+
+			// RenderTable only stores offsets from the original coordinates
+			uint32 sourceYIndex = y + _internalBuffer[index].y;
+			uint32 sourceXIndex = x + _internalBuffer[index].x;
+
+			_sourceIndices[index] = sourceYIndex * _numColumns + sourceXIndex;
+		}
+	}
 }
 
 void RenderTable::generatePanoramaLookupTable() {
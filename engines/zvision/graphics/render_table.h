@@ -42,6 +42,8 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	// Absolute source pixel index of each destination pixel, derived from _internalBuffer
+	uint32 *_sourceIndices;
 	RenderState _renderState;
 
 	struct {
@@ -89,6 +91,7 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void generateSourceIndices();
 };
 
 } // End of namespace ZVision
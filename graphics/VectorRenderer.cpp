@@ -59,6 +59,28 @@ void VectorRenderer::drawStep(const Common::Rect &area, const Common::Rect &clip
 	(this->*(step.drawingCall))(area, step);
 }
 
+void VectorRenderer::getState(State &state) const {
+	state.fillMode = _fillMode;
+	state.shadowOffset = _shadowOffset;
+	state.bevel = _bevel;
+	state.strokeWidth = _strokeWidth;
+	state.gradientFactor = _gradientFactor;
+	state.shadowIntensity = _shadowIntensity;
+	state.dynamicData = _dynamicData;
+	state.disableShadows = _disableShadows;
+}
+
+void VectorRenderer::setState(const State &state) {
+	_fillMode = state.fillMode;
+	_shadowOffset = state.shadowOffset;
+	_bevel = state.bevel;
+	_strokeWidth = state.strokeWidth;
+	_gradientFactor = state.gradientFactor;
+	_shadowIntensity = state.shadowIntensity;
+	_dynamicData = state.dynamicData;
+	_disableShadows = state.disableShadows;
+}
+
 Common::Rect VectorRenderer::applyStepClippingRect(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step) {
 	if (step.clip == Common::Rect()) {
 		return clip;
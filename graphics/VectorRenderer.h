@@ -311,6 +311,31 @@ public:
 		return _activeSurface;
 	}
 
+	/**
+	 * Drawing state set by the draw steps. Steps which do not set a color
+	 * keep drawing with the color of the previous step.
+	 */
+	struct State {
+		uint32 fgColor, bgColor, bevelColor;
+		uint32 gradientStart, gradientEnd;
+		int gradientBytes[3];
+		Common::Rect clippingArea;
+		FillMode fillMode;
+		int shadowOffset, bevel, strokeWidth, gradientFactor;
+		uint32 shadowIntensity, dynamicData;
+		bool disableShadows;
+	};
+
+	/**
+	 * Saves the current drawing state.
+	 */
+	virtual void getState(State &state) const;
+
+	/**
+	 * Restores a drawing state saved with getState().
+	 */
+	virtual void setState(const State &state);
+
 	/**
 	 * Fills the active surface with the specified fg/bg color or the active gradient.
 	 * Defaults to using the active Foreground color for filling.
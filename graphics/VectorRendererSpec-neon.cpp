@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/VectorRendererSpec-simd.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+namespace {
+
+/** Blend four zero-extended 16 bit pixels, one channel at a time. */
+inline uint16x4_t blendPixels16(uint32x4_t dst, const uint32x4_t *masks, const int32x4_t *targets, int32_t alpha) {
+	uint32x4_t result = vdupq_n_u32(0);
+	for (int i = 0; i < 4; ++i) {
+		const int32x4_t channel = vreinterpretq_s32_u32(vandq_u32(dst, masks[i]));
+		const int32x4_t delta = vshrq_n_s32(vmulq_n_s32(vsubq_s32(targets[i], channel), alpha), 8);
+		result = vorrq_u32(result, vandq_u32(vreinterpretq_u32_s32(vaddq_s32(channel, delta)), masks[i]));
+	}
+	return vmovn_u32(result);
+}
+
+/** Blend eight bytes, widened to 16 bit lanes, towards the target bytes. */
+inline uint8x8_t blendBytes(uint8x8_t dst, int16x8_t target, int16x8_t alpha) {
+	// 2 * (diff << 7) * alpha >> 16 is (diff * alpha) >> 8 without
+	// overflowing the 16 bit lanes.
+	const int16x8_t wide = vreinterpretq_s16_u16(vmovl_u8(dst));
+	const int16x8_t diff = vshlq_n_s16(vsubq_s16(target, wide), 7);
+	return vqmovun_s16(vaddq_s16(wide, vqdmulhq_s16(diff, alpha)));
+}
+
+} // End of anonymous namespace
+
+uint patternFillRow16NEON(void *dst, uint count, uint32 even, uint32 odd) {
+	const uint16x8_t pattern = vreinterpretq_u16_u32(vdupq_n_u32((even & 0xFFFF) | (odd << 16)));
+	const uint vectorCount = count & ~7;
+	uint16 *out = (uint16 *)dst;
+	for (uint i = 0; i < vectorCount; i += 8, out += 8)
+		vst1q_u16(out, pattern);
+	return vectorCount;
+}
+
+uint patternFillRow32NEON(void *dst, uint count, uint32 even, uint32 odd) {
+	const uint32_t values[4] = { even, odd, even, odd };
+	const uint32x4_t pattern = vld1q_u32(values);
+	const uint vectorCount = count & ~3;
+	uint32 *out = (uint32 *)dst;
+	for (uint i = 0; i < vectorCount; i += 4, out += 4)
+		vst1q_u32(out, pattern);
+	return vectorCount;
+}
+
+uint blendRow16NEON(void *dst, uint count, const SpanBlend &blend) {
+	uint32x4_t masks[4];
+	int32x4_t targets[4];
+	for (int i = 0; i < 4; ++i) {
+		masks[i] = vdupq_n_u32(blend.masks[i]);
+		targets[i] = vdupq_n_s32((int32_t)blend.targets[i]);
+	}
+	const int32_t alpha = (int32_t)blend.alpha;
+
+	const uint vectorCount = count & ~7;
+	uint16 *ptr = (uint16 *)dst;
+	for (uint i = 0; i < vectorCount; i += 8, ptr += 8) {
+		const uint16x8_t pixels = vld1q_u16(ptr);
+		const uint16x4_t lo = blendPixels16(vmovl_u16(vget_low_u16(pixels)), masks, targets, alpha);
+		const uint16x4_t hi = blendPixels16(vmovl_u16(vget_high_u16(pixels)), masks, targets, alpha);
+		vst1q_u16(ptr, vcombine_u16(lo, hi));
+	}
+	return vectorCount;
+}
+
+uint blendRow32NEON(void *dst, uint count, const SpanBlend &blend) {
+	const uint8x16_t target = vreinterpretq_u8_u32(vdupq_n_u32(blend.targets[0] | blend.targets[1] | blend.targets[2] | blend.targets[3]));
+	const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(blend.masks[0] | blend.masks[1] | blend.masks[2] | blend.masks[3]));
+	const int16x8_t targetLo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(target)));
+	const int16x8_t targetHi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(target)));
+	const int16x8_t alpha = vdupq_n_s16((int16_t)blend.alpha);
+
+	const uint vectorCount = count & ~3;
+	uint8 *ptr = (uint8 *)dst;
+	for (uint i = 0; i < vectorCount; i += 4, ptr += 16) {
+		const uint8x16_t pixels = vld1q_u8(ptr);
+		const uint8x8_t lo = blendBytes(vget_low_u8(pixels), targetLo, alpha);
+		const uint8x8_t hi = blendBytes(vget_high_u8(pixels), targetHi, alpha);
+		vst1q_u8(ptr, vandq_u8(vcombine_u8(lo, hi), mask));
+	}
+	return vectorCount;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/VectorRendererSpec-simd.h"
+
+#include "common/system.h"
+
+namespace Graphics {
+
+namespace {
+
+inline bool hasCpuFeature(OSystem::Feature f) {
+	return g_system && g_system->hasFeature(f);
+}
+
+} // End of anonymous namespace
+
+PatternFillRowProc getPatternFillRowProc(uint bytesPerPixel) {
+	if (bytesPerPixel != 2 && bytesPerPixel != 4)
+		return nullptr;
+
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	return bytesPerPixel == 2 ? patternFillRow16SSE2 : patternFillRow32SSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return bytesPerPixel == 2 ? patternFillRow16SSE2 : patternFillRow32SSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	return bytesPerPixel == 2 ? patternFillRow16NEON : patternFillRow32NEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return bytesPerPixel == 2 ? patternFillRow16NEON : patternFillRow32NEON;
+#endif
+#endif
+	return nullptr;
+}
+
+BlendRowProc getBlendRowProc(uint bytesPerPixel, bool byteChannels) {
+	if (bytesPerPixel != 2 && (bytesPerPixel != 4 || !byteChannels))
+		return nullptr;
+
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	return bytesPerPixel == 2 ? blendRow16SSE2 : blendRow32SSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return bytesPerPixel == 2 ? blendRow16SSE2 : blendRow32SSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	return bytesPerPixel == 2 ? blendRow16NEON : blendRow32NEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return bytesPerPixel == 2 ? blendRow16NEON : blendRow32NEON;
+#endif
+#endif
+	return nullptr;
+}
+
+} // End of namespace Graphics
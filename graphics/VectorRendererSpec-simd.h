@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_VECTORRENDERERSPEC_SIMD_H
+#define GRAPHICS_VECTORRENDERERSPEC_SIMD_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+/** Spans shorter than this are not worth handing to the vector kernels. */
+const int kMinVectorSpan = 16;
+
+/**
+ * A constant color and opacity blended over a span, in the form used by the
+ * vectorized blend kernels. The kernels produce the same pixels as
+ * VectorRendererSpec::blendPixelPtr().
+ */
+struct SpanBlend {
+	uint32 masks[4];   ///< Red, green, blue and alpha masks of the pixel format
+	uint32 targets[4]; ///< Channels of the blended color in place, and the alpha mask for alpha
+	uint32 alpha;      ///< Opacity of the color, from 0 to 254
+
+	void setup(const uint32 *channelMasks, uint32 color, uint8 opacity) {
+		for (uint i = 0; i < 3; ++i) {
+			masks[i] = channelMasks[i];
+			targets[i] = color & channelMasks[i];
+		}
+		masks[3] = targets[3] = channelMasks[3];
+		alpha = opacity;
+	}
+};
+
+/**
+ * Fill @p count pixels with @p even and @p odd alternately, starting with
+ * @p even. Returns how many pixels were filled, a multiple of the vector
+ * width; the caller fills the rest.
+ */
+typedef uint (*PatternFillRowProc)(void *dst, uint count, uint32 even, uint32 odd);
+
+/**
+ * Blend @p count pixels like VectorRendererSpec::blendPixelPtr(). Returns
+ * how many pixels were blended, a multiple of the vector width; the caller
+ * blends the rest.
+ */
+typedef uint (*BlendRowProc)(void *dst, uint count, const SpanBlend &blend);
+
+/**
+ * Return the fastest available pattern fill for the given pixel size, or
+ * nullptr if there is no vectorized one.
+ */
+PatternFillRowProc getPatternFillRowProc(uint bytesPerPixel);
+
+/**
+ * Return the fastest available blend for the given pixel size, or nullptr
+ * if there is no vectorized one. The 32 bit kernels require every channel
+ * to occupy a whole byte, which @p byteChannels tells.
+ */
+BlendRowProc getBlendRowProc(uint bytesPerPixel, bool byteChannels);
+
+#ifdef SCUMMVM_SSE2
+uint patternFillRow16SSE2(void *dst, uint count, uint32 even, uint32 odd);
+uint patternFillRow32SSE2(void *dst, uint count, uint32 even, uint32 odd);
+uint blendRow16SSE2(void *dst, uint count, const SpanBlend &blend);
+uint blendRow32SSE2(void *dst, uint count, const SpanBlend &blend);
+#endif
+
+#ifdef SCUMMVM_NEON
+uint patternFillRow16NEON(void *dst, uint count, uint32 even, uint32 odd);
+uint patternFillRow32NEON(void *dst, uint count, uint32 even, uint32 odd);
+uint blendRow16NEON(void *dst, uint count, const SpanBlend &blend);
+uint blendRow32NEON(void *dst, uint count, const SpanBlend &blend);
+#endif
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_VECTORRENDERERSPEC_SIMD_H
@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/VectorRendererSpec-simd.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+/** Multiply 32 bit lanes, keeping the low halves of the products. */
+inline __m128i mullo32(__m128i a, __m128i b) {
+	const __m128i even = _mm_mul_epu32(a, b);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/** Blend four zero-extended 16 bit pixels, one channel at a time. */
+inline __m128i blendPixels16(__m128i dst, const __m128i *masks, const __m128i *targets, __m128i alpha) {
+	__m128i result = _mm_setzero_si128();
+	for (int i = 0; i < 4; ++i) {
+		const __m128i channel = _mm_and_si128(dst, masks[i]);
+		const __m128i delta = _mm_srai_epi32(mullo32(_mm_sub_epi32(targets[i], channel), alpha), 8);
+		result = _mm_or_si128(result, _mm_and_si128(_mm_add_epi32(channel, delta), masks[i]));
+	}
+	// Sign extend so the saturating pack keeps the low halves.
+	return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+}
+
+/** Blend eight bytes, widened to 16 bit lanes, towards the target bytes. */
+inline __m128i blendBytes(__m128i dst, __m128i target, __m128i alpha) {
+	// (diff << 7) * (alpha << 1) >> 16 is (diff * alpha) >> 8 without
+	// overflowing the 16 bit lanes.
+	const __m128i diff = _mm_slli_epi16(_mm_sub_epi16(target, dst), 7);
+	return _mm_add_epi16(dst, _mm_mulhi_epi16(diff, alpha));
+}
+
+} // End of anonymous namespace
+
+uint patternFillRow16SSE2(void *dst, uint count, uint32 even, uint32 odd) {
+	const __m128i pattern = _mm_set1_epi32((int)((even & 0xFFFF) | (odd << 16)));
+	const uint vectorCount = count & ~7;
+	__m128i *out = (__m128i *)dst;
+	for (uint i = 0; i < vectorCount; i += 8)
+		_mm_storeu_si128(out++, pattern);
+	return vectorCount;
+}
+
+uint patternFillRow32SSE2(void *dst, uint count, uint32 even, uint32 odd) {
+	const __m128i pattern = _mm_setr_epi32((int)even, (int)odd, (int)even, (int)odd);
+	const uint vectorCount = count & ~3;
+	__m128i *out = (__m128i *)dst;
+	for (uint i = 0; i < vectorCount; i += 4)
+		_mm_storeu_si128(out++, pattern);
+	return vectorCount;
+}
+
+uint blendRow16SSE2(void *dst, uint count, const SpanBlend &blend) {
+	__m128i masks[4], targets[4];
+	for (int i = 0; i < 4; ++i) {
+		masks[i] = _mm_set1_epi32((int)blend.masks[i]);
+		targets[i] = _mm_set1_epi32((int)blend.targets[i]);
+	}
+	const __m128i alpha = _mm_set1_epi32((int)blend.alpha);
+	const __m128i zero = _mm_setzero_si128();
+
+	const uint vectorCount = count & ~7;
+	__m128i *ptr = (__m128i *)dst;
+	for (uint i = 0; i < vectorCount; i += 8, ++ptr) {
+		const __m128i pixels = _mm_loadu_si128(ptr);
+		const __m128i lo = blendPixels16(_mm_unpacklo_epi16(pixels, zero), masks, targets, alpha);
+		const __m128i hi = blendPixels16(_mm_unpackhi_epi16(pixels, zero), masks, targets, alpha);
+		_mm_storeu_si128(ptr, _mm_packs_epi32(lo, hi));
+	}
+	return vectorCount;
+}
+
+uint blendRow32SSE2(void *dst, uint count, const SpanBlend &blend) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i target = _mm_set1_epi32((int)(blend.targets[0] | blend.targets[1] | blend.targets[2] | blend.targets[3]));
+	const __m128i mask = _mm_set1_epi32((int)(blend.masks[0] | blend.masks[1] | blend.masks[2] | blend.masks[3]));
+	const __m128i targetLo = _mm_unpacklo_epi8(target, zero);
+	const __m128i targetHi = _mm_unpackhi_epi8(target, zero);
+	const __m128i alpha = _mm_set1_epi16((short)(blend.alpha << 1));
+
+	const uint vectorCount = count & ~3;
+	__m128i *ptr = (__m128i *)dst;
+	for (uint i = 0; i < vectorCount; i += 4, ++ptr) {
+		const __m128i pixels = _mm_loadu_si128(ptr);
+		const __m128i lo = blendBytes(_mm_unpacklo_epi8(pixels, zero), targetLo, alpha);
+		const __m128i hi = blendBytes(_mm_unpackhi_epi8(pixels, zero), targetHi, alpha);
+		_mm_storeu_si128(ptr, _mm_and_si128(_mm_packus_epi16(lo, hi), mask));
+	}
+	return vectorCount;
+}
+
+} // End of namespace Graphics
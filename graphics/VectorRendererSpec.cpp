@@ -29,6 +29,7 @@
 #include "gui/ThemeEngine.h"
 #include "graphics/VectorRenderer.h"
 #include "graphics/VectorRendererSpec.h"
+#include "graphics/VectorRendererSpec-simd.h"
 
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
@@ -438,8 +439,27 @@ namespace Graphics {
  * @param last Pointer to the last pixel to fill.
  * @param color Color of the pixel
  */
+/**
+ * Fills as much of a row as the vector kernels can handle with two colors
+ * alternating, starting with @p even.
+ *
+ * @return Pointer to the first pixel left for the caller to fill.
+ */
+template<typename PixelType>
+inline PixelType *patternFillVector(PixelType *first, int count, PixelType even, PixelType odd) {
+	if (count < kMinVectorSpan)
+		return first;
+
+	static const PatternFillRowProc fillRow = getPatternFillRowProc(sizeof(PixelType));
+	if (!fillRow)
+		return first;
+
+	return first + fillRow(first, count, even, odd);
+}
+
 template<typename PixelType>
 void colorFill(PixelType *first, PixelType *last, PixelType color) {
+	first = patternFillVector<PixelType>(first, last - first, color, color);
 	int count = (last - first);
 	if (!count)
 		return;
@@ -481,6 +501,9 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 		count -= diff;
 	}
 
+	const int done = patternFillVector<PixelType>(first, count, color, color) - first;
+	first += done;
+	count -= done;
 	if (!count)
 		return;
 
@@ -500,6 +523,25 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 	}
 }
 
+/**
+ * Fills several pixels in a row with two colors alternating, as used by
+ * the dithered gradients.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param last Pointer to the last pixel to fill.
+ * @param even Color of the first pixel and every other one after it
+ * @param odd Color of the remaining pixels
+ */
+template<typename PixelType>
+void colorFillPattern(PixelType *first, PixelType *last, PixelType even, PixelType odd) {
+	first = patternFillVector<PixelType>(first, last - first, even, odd);
+	while (first < last) {
+		*first++ = even;
+		if (first < last)
+			*first++ = odd;
+	}
+}
+
 /**
  * Fills several pixels in a column with a given color.
  *
@@ -593,8 +635,43 @@ VectorRendererSpec(PixelFormat format) :
 
 	_clippingArea = Common::Rect(0, 0, 32767, 32767);
 
+	// The 32 bit blend kernels work on whole bytes.
+	const bool byteChannels = !format.rLoss && !format.gLoss && !format.bLoss &&
+		!(format.rShift & 7) && !(format.gShift & 7) && !(format.bShift & 7) &&
+		(format.aLoss == 8 || (!format.aLoss && !(format.aShift & 7)));
+	_blendRowProc = getBlendRowProc(sizeof(PixelType), byteChannels);
+
 	_fgColor = _bgColor = _bevelColor = 0;
 	_gradientStart = _gradientEnd = 0;
+	_gradientBytes[0] = _gradientBytes[1] = _gradientBytes[2] = 0;
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+getState(State &state) const {
+	Base::getState(state);
+	state.fgColor = _fgColor;
+	state.bgColor = _bgColor;
+	state.bevelColor = _bevelColor;
+	state.gradientStart = _gradientStart;
+	state.gradientEnd = _gradientEnd;
+	for (int i = 0; i < 3; ++i)
+		state.gradientBytes[i] = _gradientBytes[i];
+	state.clippingArea = _clippingArea;
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+setState(const State &state) {
+	Base::setState(state);
+	_fgColor = state.fgColor;
+	_bgColor = state.bgColor;
+	_bevelColor = state.bevelColor;
+	_gradientStart = state.gradientStart;
+	_gradientEnd = state.gradientEnd;
+	for (int i = 0; i < 3; ++i)
+		_gradientBytes[i] = state.gradientBytes[i];
+	_clippingArea = state.clippingArea;
 }
 
 /****************************
@@ -684,16 +761,15 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
+		// Odd columns take the next color on odd rows and in the densest
+		// pattern, even columns only on odd rows of the two densest ones.
+		const PixelType colorOdd = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		const PixelType colorEven = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
 
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		if (x & 1)
+			colorFillPattern<PixelType>(ptr, ptr + width, colorOdd, colorEven);
+		else
+			colorFillPattern<PixelType>(ptr, ptr + width, colorEven, colorOdd);
 	}
 }
 
@@ -726,17 +802,18 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		const PixelType colorOdd = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		const PixelType colorEven = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+
+		const int begin = MAX(_clippingArea.left - realX, 0);
+		const int end = MIN(width, _clippingArea.right - realX);
+		if (begin >= end)
+			return;
+
+		if ((x + begin) & 1)
+			colorFillPattern<PixelType>(ptr + begin, ptr + end, colorOdd, colorEven);
+		else
+			colorFillPattern<PixelType>(ptr + begin, ptr + end, colorEven, colorOdd);
 	}
 }
 
@@ -3687,9 +3764,7 @@ drawSquareShadow(int x, int y, int w, int h, int offset) {
 	ptr = (PixelType *)_activeSurface->getBasePtr(x + offset, y + h - 1);
 
 	while (i++ < offset) {
-		j = w - offset;
-		while (j--)
-			blendPixelPtr(ptr + j, 0, ((offset - i) << 8) / offset);
+		blendFill(ptr, ptr + w - offset, 0, ((offset - i) << 8) / offset);
 		ptr += pitch;
 	}
 
@@ -3731,9 +3806,7 @@ drawSquareShadowClip(int x, int y, int w, int h, int offset) {
 	ptr_y = y + h - 1;
 
 	while (i++ < offset) {
-		j = w - offset;
-		while (j--)
-			blendPixelPtrClip(ptr + j, 0, ((offset - i) << 8) / offset, ptr_x + j, ptr_y);
+		blendFillClip(ptr, ptr + w - offset, 0, ((offset - i) << 8) / offset, ptr_x, ptr_y);
 		ptr += pitch;
 		++ptr_y;
 	}
@@ -23,6 +23,7 @@
 #define VECTOR_RENDERER_SPEC_H
 
 #include "graphics/VectorRenderer.h"
+#include "graphics/VectorRendererSpec-simd.h"
 
 namespace Graphics {
 
@@ -83,6 +84,9 @@ public:
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) override;
 	void setClippingRect(const Common::Rect &clippingArea) override { _clippingArea = clippingArea; }
 
+	void getState(State &state) const override;
+	void setState(const State &state) override;
+
 	void copyFrame(OSystem *sys, const Common::Rect &r) override;
 	void copyWholeFrame(OSystem *sys) override { copyFrame(sys, Common::Rect(0, 0, _activeSurface->w, _activeSurface->h)); }
 
@@ -287,20 +291,31 @@ protected:
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
 	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+		if (alpha == 0xff) {
+			while (first < last)
+				*first++ = color | _alphaMask;
+			return;
+		}
+
+		if (_blendRowProc && last - first >= kMinVectorSpan) {
+			const uint32 masks[4] = { _redMask, _greenMask, _blueMask, _alphaMask };
+			SpanBlend blend;
+			blend.setup(masks, color, alpha);
+			first += _blendRowProc(first, last - first, blend);
+		}
+
 		while (first < last)
 			blendPixelPtr(first++, color, alpha);
 	}
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
-		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first < last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
-		}
+		if (realY < _clippingArea.top || realY >= _clippingArea.bottom)
+			return;
+
+		const int begin = MAX(_clippingArea.left - realX, 0);
+		const int end = MIN<int>(last - first, _clippingArea.right - realX);
+		if (begin < end)
+			blendFill(first + begin, first + end, color, alpha);
 	}
 
 	void darkenFill(PixelType *first, PixelType *last);
@@ -321,6 +336,8 @@ protected:
 	Common::Array<int> _gradIndexes;
 
 	PixelType _bevelColor;
+
+	BlendRowProc _blendRowProc; /**< Vectorized span blend for this pixel format, if there is one */
 };
 
 
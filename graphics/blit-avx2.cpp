@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/blit-simd.h"
+
+#include <immintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint srcBpp, uint dstBpp>
+class ConvertBlockAVX2 {
+	__m128i _srcShift[4];
+	__m256i _srcMask[4];
+	__m128i _expandLeft[4];
+	__m128i _expandRight[4];
+	__m128i _dstLoss[4];
+	__m128i _dstShift[4];
+	__m256i _fill;
+	uint _numChannels;
+
+	inline __m256i convert(__m256i color) const {
+		__m256i result = _fill;
+		for (uint i = 0; i < _numChannels; ++i) {
+			__m256i v = _mm256_and_si256(_mm256_srl_epi32(color, _srcShift[i]), _srcMask[i]);
+			v = _mm256_or_si256(_mm256_sll_epi32(v, _expandLeft[i]), _mm256_srl_epi32(v, _expandRight[i]));
+			result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_srl_epi32(v, _dstLoss[i]), _dstShift[i]));
+		}
+		return result;
+	}
+
+	inline void store(byte *dst, __m256i colors) const {
+		if (dstBpp == 2) {
+			const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(colors), _mm256_extracti128_si256(colors, 1));
+			_mm_storeu_si128((__m128i *)dst, packed);
+		} else {
+			_mm256_storeu_si256((__m256i *)dst, colors);
+		}
+	}
+
+public:
+	static const uint kPixels = 16;
+
+	explicit ConvertBlockAVX2(const BlitConversion &conv) : _numChannels(conv.numChannels) {
+		for (uint i = 0; i < _numChannels; ++i) {
+			_srcShift[i] = _mm_cvtsi32_si128(conv.srcShift[i]);
+			_srcMask[i] = _mm256_set1_epi32(conv.srcMask[i]);
+			_expandLeft[i] = _mm_cvtsi32_si128(conv.expandLeft[i]);
+			_expandRight[i] = _mm_cvtsi32_si128(conv.expandRight[i]);
+			_dstLoss[i] = _mm_cvtsi32_si128(conv.dstLoss[i]);
+			_dstShift[i] = _mm_cvtsi32_si128(conv.dstShift[i]);
+		}
+		_fill = _mm256_set1_epi32(conv.fill);
+	}
+
+	inline void operator()(byte *dst, const byte *src) const {
+		__m256i lo, hi;
+		if (srcBpp == 2) {
+			lo = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+			hi = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + 16)));
+		} else {
+			lo = _mm256_loadu_si256((const __m256i *)src);
+			hi = _mm256_loadu_si256((const __m256i *)(src + 32));
+		}
+
+		lo = convert(lo);
+		hi = convert(hi);
+
+		store(dst, lo);
+		store(dst + 8 * dstBpp, hi);
+	}
+};
+
+template<uint srcBpp, uint dstBpp>
+void convertRowLogicAVX2(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	convertRowLogic(dst, src, w, conv, ConvertBlockAVX2<srcBpp, dstBpp>(conv));
+}
+
+} // End of anonymous namespace
+
+void convertRowAVX2(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	if (conv.srcBytesPerPixel == 2) {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicAVX2<2, 2>(dst, src, w, conv);
+		else
+			convertRowLogicAVX2<2, 4>(dst, src, w, conv);
+	} else {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicAVX2<4, 2>(dst, src, w, conv);
+		else
+			convertRowLogicAVX2<4, 4>(dst, src, w, conv);
+	}
+}
+
+void mapRow32AVX2(byte *dst, const byte *src, uint w, const uint32 *map) {
+	const uint vectorW = w & ~7;
+
+	// Work back to front, so that surfaces can be converted in place.
+	for (uint x = w; x-- > vectorW; )
+		*(uint32 *)(dst + x * 4) = map[src[x]];
+
+	for (uint x = vectorW; x > 0; ) {
+		x -= 8;
+		const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + x)));
+		const __m256i colors = _mm256_i32gather_epi32((const int *)map, indices, 4);
+		_mm256_storeu_si256((__m256i *)(dst + x * 4), colors);
+	}
+}
+
+void keyBlitRow8AVX2(byte *dst, const byte *src, uint w, uint32 key) {
+	const __m256i k = _mm256_set1_epi8((char)key);
+	uint x = 0;
+	for (; x + 32 <= w; x += 32) {
+		const __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+		const __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+		_mm256_storeu_si256((__m256i *)(dst + x), _mm256_blendv_epi8(s, d, _mm256_cmpeq_epi8(s, k)));
+	}
+
+	for (; x < w; ++x) {
+		if (src[x] != (byte)key)
+			dst[x] = src[x];
+	}
+}
+
+void keyBlitRow16AVX2(byte *dst, const byte *src, uint w, uint32 key) {
+	const __m256i k = _mm256_set1_epi16((short)key);
+	uint x = 0;
+	for (; x + 16 <= w; x += 16) {
+		const __m256i s = _mm256_loadu_si256((const __m256i *)(src + x * 2));
+		const __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x * 2));
+		_mm256_storeu_si256((__m256i *)(dst + x * 2), _mm256_blendv_epi8(s, d, _mm256_cmpeq_epi16(s, k)));
+	}
+
+	const uint16 *src16 = (const uint16 *)src;
+	uint16 *dst16 = (uint16 *)dst;
+	for (; x < w; ++x) {
+		if (src16[x] != (uint16)key)
+			dst16[x] = src16[x];
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/blit-simd.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint srcBpp, uint dstBpp>
+class ConvertBlockNEON {
+	// NEON only shifts by a vector of counts, negative ones shift right.
+	int32x4_t _srcShift[4];
+	uint32x4_t _srcMask[4];
+	int32x4_t _expandLeft[4];
+	int32x4_t _expandRight[4];
+	int32x4_t _dstLoss[4];
+	int32x4_t _dstShift[4];
+	uint32x4_t _fill;
+	uint _numChannels;
+
+	inline uint32x4_t convert(uint32x4_t color) const {
+		uint32x4_t result = _fill;
+		for (uint i = 0; i < _numChannels; ++i) {
+			uint32x4_t v = vandq_u32(vshlq_u32(color, _srcShift[i]), _srcMask[i]);
+			v = vorrq_u32(vshlq_u32(v, _expandLeft[i]), vshlq_u32(v, _expandRight[i]));
+			result = vorrq_u32(result, vshlq_u32(vshlq_u32(v, _dstLoss[i]), _dstShift[i]));
+		}
+		return result;
+	}
+
+public:
+	static const uint kPixels = 8;
+
+	explicit ConvertBlockNEON(const BlitConversion &conv) : _numChannels(conv.numChannels) {
+		for (uint i = 0; i < _numChannels; ++i) {
+			_srcShift[i] = vdupq_n_s32(-(int32)conv.srcShift[i]);
+			_srcMask[i] = vdupq_n_u32(conv.srcMask[i]);
+			_expandLeft[i] = vdupq_n_s32(conv.expandLeft[i]);
+			_expandRight[i] = vdupq_n_s32(-(int32)conv.expandRight[i]);
+			_dstLoss[i] = vdupq_n_s32(-(int32)conv.dstLoss[i]);
+			_dstShift[i] = vdupq_n_s32(conv.dstShift[i]);
+		}
+		_fill = vdupq_n_u32(conv.fill);
+	}
+
+	inline void operator()(byte *dst, const byte *src) const {
+		uint32x4_t lo, hi;
+		if (srcBpp == 2) {
+			const uint16x8_t in = vreinterpretq_u16_u8(vld1q_u8(src));
+			lo = vmovl_u16(vget_low_u16(in));
+			hi = vmovl_u16(vget_high_u16(in));
+		} else {
+			lo = vreinterpretq_u32_u8(vld1q_u8(src));
+			hi = vreinterpretq_u32_u8(vld1q_u8(src + 16));
+		}
+
+		lo = convert(lo);
+		hi = convert(hi);
+
+		if (dstBpp == 2) {
+			const uint16x8_t out = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+			vst1q_u8(dst, vreinterpretq_u8_u16(out));
+		} else {
+			vst1q_u8(dst, vreinterpretq_u8_u32(lo));
+			vst1q_u8(dst + 16, vreinterpretq_u8_u32(hi));
+		}
+	}
+};
+
+template<uint srcBpp, uint dstBpp>
+void convertRowLogicNEON(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	convertRowLogic(dst, src, w, conv, ConvertBlockNEON<srcBpp, dstBpp>(conv));
+}
+
+} // End of anonymous namespace
+
+void convertRowNEON(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	if (conv.srcBytesPerPixel == 2) {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicNEON<2, 2>(dst, src, w, conv);
+		else
+			convertRowLogicNEON<2, 4>(dst, src, w, conv);
+	} else {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicNEON<4, 2>(dst, src, w, conv);
+		else
+			convertRowLogicNEON<4, 4>(dst, src, w, conv);
+	}
+}
+
+void keyBlitRow8NEON(byte *dst, const byte *src, uint w, uint32 key) {
+	const uint8x16_t k = vdupq_n_u8((uint8)key);
+	uint x = 0;
+	for (; x + 16 <= w; x += 16) {
+		const uint8x16_t s = vld1q_u8(src + x);
+		const uint8x16_t d = vld1q_u8(dst + x);
+		vst1q_u8(dst + x, vbslq_u8(vceqq_u8(s, k), d, s));
+	}
+
+	for (; x < w; ++x) {
+		if (src[x] != (byte)key)
+			dst[x] = src[x];
+	}
+}
+
+void keyBlitRow16NEON(byte *dst, const byte *src, uint w, uint32 key) {
+	const uint16x8_t k = vdupq_n_u16((uint16)key);
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const uint16x8_t s = vreinterpretq_u16_u8(vld1q_u8(src + x * 2));
+		const uint16x8_t d = vreinterpretq_u16_u8(vld1q_u8(dst + x * 2));
+		vst1q_u8(dst + x * 2, vreinterpretq_u8_u16(vbslq_u16(vceqq_u16(s, k), d, s)));
+	}
+
+	const uint16 *src16 = (const uint16 *)src;
+	uint16 *dst16 = (uint16 *)dst;
+	for (; x < w; ++x) {
+		if (src16[x] != (uint16)key)
+			dst16[x] = src16[x];
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_BLIT_SIMD_H
+#define GRAPHICS_BLIT_SIMD_H
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * A pixel format conversion in the form used by the vectorized crossBlit()
+ * kernels. Every channel is converted as
+ *
+ *   v = (color >> srcShift) & srcMask
+ *   v = (v << expandLeft) | (v >> expandRight)
+ *   result |= (v >> dstLoss) << dstShift
+ *
+ * which yields the same result as PixelFormat::colorToARGB() followed by
+ * PixelFormat::ARGBToColor() for source channels of 4 to 8 bits. An alpha
+ * channel the source lacks is set in @p fill.
+ */
+struct BlitConversion {
+	uint srcBytesPerPixel;
+	uint dstBytesPerPixel;
+	uint numChannels;
+	uint32 srcShift[4];
+	uint32 srcMask[4];
+	uint32 expandLeft[4];
+	uint32 expandRight[4];
+	uint32 dstLoss[4];
+	uint32 dstShift[4];
+	uint32 fill;
+
+	/**
+	 * Set up the conversion from @p srcFmt to @p dstFmt.
+	 *
+	 * @return false if the formats can not be handled by the kernels.
+	 */
+	bool setup(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+
+	/**
+	 * Whether rows have to be processed from their end to their start, so
+	 * that surfaces can be converted in place.
+	 */
+	bool isBackward() const { return dstBytesPerPixel > srcBytesPerPixel; }
+
+	/**
+	 * Convert @p count pixels without vector instructions, in the direction
+	 * given by isBackward(). This handles the ends of rows.
+	 */
+	void convertPixels(byte *dst, const byte *src, uint count) const;
+};
+
+/**
+ * Convert one row of @p w pixels. Kernels process rows backwards when
+ * BlitConversion::isBackward() is set.
+ */
+typedef void (*BlitConvertRowProc)(byte *dst, const byte *src, uint w, const BlitConversion &conv);
+
+/**
+ * Shared row loop of the conversion kernels. @p block converts
+ * Block::kPixels pixels at once.
+ *
+ * Block types must have internal linkage and no inline functions shared with
+ * other files may be used here, since every kernel is built with different
+ * compiler flags.
+ */
+template<class Block>
+inline void convertRowLogic(byte *dst, const byte *src, uint w, const BlitConversion &conv, const Block &block) {
+	const uint srcBpp = conv.srcBytesPerPixel;
+	const uint dstBpp = conv.dstBytesPerPixel;
+	const uint vectorW = w - w % Block::kPixels;
+
+	if (dstBpp > srcBpp) {
+		conv.convertPixels(dst + vectorW * dstBpp, src + vectorW * srcBpp, w - vectorW);
+		for (uint x = vectorW; x > 0; ) {
+			x -= Block::kPixels;
+			block(dst + x * dstBpp, src + x * srcBpp);
+		}
+	} else {
+		for (uint x = 0; x < vectorW; x += Block::kPixels)
+			block(dst + x * dstBpp, src + x * srcBpp);
+		conv.convertPixels(dst + vectorW * dstBpp, src + vectorW * srcBpp, w - vectorW);
+	}
+}
+
+/**
+ * Copy one row of @p w pixels of one (8 bit) or two (16 bit) bytes each,
+ * leaving the destination pixels alone where the source pixel equals
+ * @p key.
+ */
+typedef void (*KeyBlitRowProc)(byte *dst, const byte *src, uint w, uint32 key);
+
+/**
+ * Return the fastest available color keyed row copy for the given pixel
+ * size, or nullptr if there is no vectorized one.
+ */
+KeyBlitRowProc getKeyBlitRowProc(uint bytesPerPixel);
+
+#ifdef SCUMMVM_SSE2
+void keyBlitRow8SSE2(byte *dst, const byte *src, uint w, uint32 key);
+void keyBlitRow16SSE2(byte *dst, const byte *src, uint w, uint32 key);
+void convertRowSSE2(byte *dst, const byte *src, uint w, const BlitConversion &conv);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void convertRowAVX2(byte *dst, const byte *src, uint w, const BlitConversion &conv);
+void keyBlitRow8AVX2(byte *dst, const byte *src, uint w, uint32 key);
+void keyBlitRow16AVX2(byte *dst, const byte *src, uint w, uint32 key);
+void mapRow32AVX2(byte *dst, const byte *src, uint w, const uint32 *map);
+#endif
+
+#ifdef SCUMMVM_NEON
+void convertRowNEON(byte *dst, const byte *src, uint w, const BlitConversion &conv);
+void keyBlitRow8NEON(byte *dst, const byte *src, uint w, uint32 key);
+void keyBlitRow16NEON(byte *dst, const byte *src, uint w, uint32 key);
+#endif
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_BLIT_SIMD_H
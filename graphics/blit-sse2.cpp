@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/blit-simd.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint srcBpp, uint dstBpp>
+class ConvertBlockSSE2 {
+	__m128i _srcShift[4];
+	__m128i _srcMask[4];
+	__m128i _expandLeft[4];
+	__m128i _expandRight[4];
+	__m128i _dstLoss[4];
+	__m128i _dstShift[4];
+	__m128i _fill;
+	uint _numChannels;
+
+	inline __m128i convert(__m128i color) const {
+		__m128i result = _fill;
+		for (uint i = 0; i < _numChannels; ++i) {
+			__m128i v = _mm_and_si128(_mm_srl_epi32(color, _srcShift[i]), _srcMask[i]);
+			v = _mm_or_si128(_mm_sll_epi32(v, _expandLeft[i]), _mm_srl_epi32(v, _expandRight[i]));
+			result = _mm_or_si128(result, _mm_sll_epi32(_mm_srl_epi32(v, _dstLoss[i]), _dstShift[i]));
+		}
+		return result;
+	}
+
+public:
+	static const uint kPixels = 8;
+
+	explicit ConvertBlockSSE2(const BlitConversion &conv) : _numChannels(conv.numChannels) {
+		for (uint i = 0; i < _numChannels; ++i) {
+			_srcShift[i] = _mm_cvtsi32_si128(conv.srcShift[i]);
+			_srcMask[i] = _mm_set1_epi32(conv.srcMask[i]);
+			_expandLeft[i] = _mm_cvtsi32_si128(conv.expandLeft[i]);
+			_expandRight[i] = _mm_cvtsi32_si128(conv.expandRight[i]);
+			_dstLoss[i] = _mm_cvtsi32_si128(conv.dstLoss[i]);
+			_dstShift[i] = _mm_cvtsi32_si128(conv.dstShift[i]);
+		}
+		_fill = _mm_set1_epi32(conv.fill);
+	}
+
+	inline void operator()(byte *dst, const byte *src) const {
+		__m128i lo, hi;
+		if (srcBpp == 2) {
+			const __m128i in = _mm_loadu_si128((const __m128i *)src);
+			lo = _mm_unpacklo_epi16(in, _mm_setzero_si128());
+			hi = _mm_unpackhi_epi16(in, _mm_setzero_si128());
+		} else {
+			lo = _mm_loadu_si128((const __m128i *)src);
+			hi = _mm_loadu_si128((const __m128i *)(src + 16));
+		}
+
+		lo = convert(lo);
+		hi = convert(hi);
+
+		if (dstBpp == 2) {
+			// SSE2 has no unsigned saturating pack from 32 to 16 bits, so
+			// sign extend the low halves and use the signed one.
+			lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+			hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+			_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+		} else {
+			_mm_storeu_si128((__m128i *)dst, lo);
+			_mm_storeu_si128((__m128i *)(dst + 16), hi);
+		}
+	}
+};
+
+template<uint srcBpp, uint dstBpp>
+void convertRowLogicSSE2(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	convertRowLogic(dst, src, w, conv, ConvertBlockSSE2<srcBpp, dstBpp>(conv));
+}
+
+} // End of anonymous namespace
+
+void convertRowSSE2(byte *dst, const byte *src, uint w, const BlitConversion &conv) {
+	if (conv.srcBytesPerPixel == 2) {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicSSE2<2, 2>(dst, src, w, conv);
+		else
+			convertRowLogicSSE2<2, 4>(dst, src, w, conv);
+	} else {
+		if (conv.dstBytesPerPixel == 2)
+			convertRowLogicSSE2<4, 2>(dst, src, w, conv);
+		else
+			convertRowLogicSSE2<4, 4>(dst, src, w, conv);
+	}
+}
+
+void keyBlitRow8SSE2(byte *dst, const byte *src, uint w, uint32 key) {
+	const __m128i k = _mm_set1_epi8((char)key);
+	uint x = 0;
+	for (; x + 16 <= w; x += 16) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+		const __m128i keyed = _mm_cmpeq_epi8(s, k);
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, s)));
+	}
+
+	for (; x < w; ++x) {
+		if (src[x] != (byte)key)
+			dst[x] = src[x];
+	}
+}
+
+void keyBlitRow16SSE2(byte *dst, const byte *src, uint w, uint32 key) {
+	const __m128i k = _mm_set1_epi16((short)key);
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + x * 2));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + x * 2));
+		const __m128i keyed = _mm_cmpeq_epi16(s, k);
+		_mm_storeu_si128((__m128i *)(dst + x * 2), _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, s)));
+	}
+
+	const uint16 *src16 = (const uint16 *)src;
+	uint16 *dst16 = (uint16 *)dst;
+	for (; x < w; ++x) {
+		if (src16[x] != (uint16)key)
+			dst16[x] = src16[x];
+	}
+}
+
+} // End of namespace Graphics
@@ -20,8 +20,11 @@
  */
 
 #include "graphics/blit.h"
+#include "graphics/blit-simd.h"
 #include "graphics/pixelformat.h"
 
+#include "common/system.h"
+
 namespace Graphics {
 
 // see graphics/blit-atari.cpp
@@ -195,6 +198,155 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 
 } // End of anonymous namespace
 
+bool BlitConversion::setup(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	if ((srcFmt.bytesPerPixel != 2 && srcFmt.bytesPerPixel != 4) ||
+	    (dstFmt.bytesPerPixel != 2 && dstFmt.bytesPerPixel != 4))
+		return false;
+
+	const uint srcBits[4] = { srcFmt.rBits(), srcFmt.gBits(), srcFmt.bBits(), srcFmt.aBits() };
+	const uint srcShifts[4] = { srcFmt.rShift, srcFmt.gShift, srcFmt.bShift, srcFmt.aShift };
+	const uint dstBits[4] = { dstFmt.rBits(), dstFmt.gBits(), dstFmt.bBits(), dstFmt.aBits() };
+	const uint dstShifts[4] = { dstFmt.rShift, dstFmt.gShift, dstFmt.bShift, dstFmt.aShift };
+
+	srcBytesPerPixel = srcFmt.bytesPerPixel;
+	dstBytesPerPixel = dstFmt.bytesPerPixel;
+	numChannels = 0;
+	fill = 0;
+
+	for (uint i = 0; i < 4; ++i) {
+		if (dstBits[i] == 0)
+			continue;
+
+		// Channels missing in the source are black, except for alpha
+		// which is opaque.
+		if (srcBits[i] == 0) {
+			if (i == 3)
+				fill |= (0xFF >> (8 - dstBits[i])) << dstShifts[i];
+			continue;
+		}
+
+		// Expanding fewer bits takes more than one shift.
+		if (srcBits[i] < 4)
+			return false;
+
+		srcShift[numChannels] = srcShifts[i];
+		srcMask[numChannels] = (1 << srcBits[i]) - 1;
+		expandLeft[numChannels] = 8 - srcBits[i];
+		expandRight[numChannels] = 2 * srcBits[i] - 8;
+		dstLoss[numChannels] = 8 - dstBits[i];
+		dstShift[numChannels] = dstShifts[i];
+		++numChannels;
+	}
+
+	return true;
+}
+
+void BlitConversion::convertPixels(byte *dst, const byte *src, uint count) const {
+	for (uint n = 0; n < count; ++n) {
+		const uint x = isBackward() ? count - 1 - n : n;
+		uint32 color = (srcBytesPerPixel == 2) ? *(const uint16 *)(src + x * 2) : *(const uint32 *)(src + x * 4);
+
+		uint32 result = fill;
+		for (uint i = 0; i < numChannels; ++i) {
+			uint32 v = (color >> srcShift[i]) & srcMask[i];
+			v = (v << expandLeft[i]) | (v >> expandRight[i]);
+			result |= (v >> dstLoss[i]) << dstShift[i];
+		}
+
+		if (dstBytesPerPixel == 2)
+			*(uint16 *)(dst + x * 2) = result;
+		else
+			*(uint32 *)(dst + x * 4) = result;
+	}
+}
+
+namespace {
+
+inline bool hasCpuFeature(OSystem::Feature f) {
+	return g_system && g_system->hasFeature(f);
+}
+
+BlitConvertRowProc getConvertRowProc() {
+#ifdef SCUMMVM_AVX2
+	if (hasCpuFeature(OSystem::kCpuFeatureAVX2))
+		return convertRowAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return convertRowSSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return convertRowSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return convertRowNEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return convertRowNEON;
+#endif
+#endif
+	return nullptr;
+}
+
+/**
+ * Convert a surface with the vectorized kernels if the CPU and the
+ * formats allow it. Returns false if the generic code has to be used.
+ */
+bool crossBlitSIMD(byte *dst, const byte *src,
+				   const uint dstPitch, const uint srcPitch,
+				   const uint w, const uint h,
+				   const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	const BlitConvertRowProc convertRow = getConvertRowProc();
+	if (!convertRow)
+		return false;
+
+	BlitConversion conv;
+	if (!conv.setup(dstFmt, srcFmt))
+		return false;
+
+	if (conv.isBackward()) {
+		for (uint y = h; y-- > 0; )
+			convertRow(dst + y * dstPitch, src + y * srcPitch, w, conv);
+	} else {
+		for (uint y = 0; y < h; ++y)
+			convertRow(dst + y * dstPitch, src + y * srcPitch, w, conv);
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+KeyBlitRowProc getKeyBlitRowProc(uint bytesPerPixel) {
+	if (bytesPerPixel != 1 && bytesPerPixel != 2)
+		return nullptr;
+
+#ifdef SCUMMVM_AVX2
+	if (hasCpuFeature(OSystem::kCpuFeatureAVX2))
+		return bytesPerPixel == 1 ? keyBlitRow8AVX2 : keyBlitRow16AVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	return bytesPerPixel == 1 ? keyBlitRow8SSE2 : keyBlitRow16SSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return bytesPerPixel == 1 ? keyBlitRow8SSE2 : keyBlitRow16SSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	return bytesPerPixel == 1 ? keyBlitRow8NEON : keyBlitRow16NEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return bytesPerPixel == 1 ? keyBlitRow8NEON : keyBlitRow16NEON;
+#endif
+#endif
+	return nullptr;
+}
+
 // Function to blit a rect from one color format to another
 bool crossBlit(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
@@ -212,6 +364,9 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	if (crossBlitSIMD(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -324,6 +479,15 @@ bool crossBlitMap(byte *dst, const byte *src,
 	const uint srcDelta = (srcPitch - w);
 	const uint dstDelta = (dstPitch - w * bytesPerPixel);
 
+#ifdef SCUMMVM_AVX2
+	if (bytesPerPixel == 4 && hasCpuFeature(OSystem::kCpuFeatureAVX2)) {
+		// Work bottom to top, so that surfaces can be converted in place.
+		for (uint y = h; y-- > 0; )
+			mapRow32AVX2(dst + y * dstPitch, src + y * srcPitch, w, map);
+		return true;
+	}
+#endif
+
 	if (bytesPerPixel == 1) {
 		crossBlitLogic1BppSource<uint8, false, false>(dst, src, w, h, srcDelta, dstDelta, map, 0);
 	} else if (bytesPerPixel == 2) {
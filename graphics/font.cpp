@@ -27,6 +27,200 @@
 
 namespace Graphics {
 
+namespace {
+
+/** Characters below this have their widths remembered by the text cache. */
+const uint kCachedWidthChars = 256;
+/** Pairs of characters below this have their kerning offsets remembered. */
+const uint kCachedKerningChars = 128;
+
+/** Markers of metrics which were not measured yet. */
+const int16 kUnknownWidth = -32768;
+const int8 kUnknownKerning = -128;
+
+/** Number of word wrapping results remembered per font and string type. */
+const uint kMaxWrapEntries = 32;
+/** Longer texts are wrapped without remembering the result. */
+const uint kMaxWrapLength = 4096;
+
+/**
+ * The most recent word wrapping results of a font, replacing the least
+ * recently used one when full.
+ */
+template<class StringType>
+class WordWrapMemo {
+public:
+	struct Result {
+		Common::Array<StringType> lines;
+		int maxLineWidth;
+	};
+
+	WordWrapMemo() : _count(0), _useCounter(0) {}
+
+	const Result *find(const StringType &str, uint hash, int maxWidth, int initWidth, uint32 mode) {
+		for (uint i = 0; i < _count; ++i) {
+			Entry &entry = _entries[i];
+			if (entry.hash == hash && entry.maxWidth == maxWidth && entry.initWidth == initWidth &&
+			    entry.mode == mode && entry.str == str) {
+				entry.lastUse = ++_useCounter;
+				return &entry.result;
+			}
+		}
+		return nullptr;
+	}
+
+	Result &insert(const StringType &str, uint hash, int maxWidth, int initWidth, uint32 mode) {
+		uint slot = _count;
+		if (_count < kMaxWrapEntries) {
+			_count++;
+		} else {
+			slot = 0;
+			for (uint i = 1; i < _count; ++i) {
+				if (_entries[i].lastUse < _entries[slot].lastUse)
+					slot = i;
+			}
+		}
+
+		Entry &entry = _entries[slot];
+		entry.str = str;
+		entry.hash = hash;
+		entry.maxWidth = maxWidth;
+		entry.initWidth = initWidth;
+		entry.mode = mode;
+		entry.lastUse = ++_useCounter;
+		entry.result.lines.clear();
+		entry.result.maxLineWidth = 0;
+		return entry.result;
+	}
+
+	void clear() {
+		for (uint i = 0; i < _count; ++i) {
+			_entries[i].str.clear();
+			_entries[i].result.lines.clear();
+		}
+		_count = 0;
+	}
+
+private:
+	struct Entry {
+		StringType str;
+		uint hash;
+		int maxWidth;
+		int initWidth;
+		uint32 mode;
+		uint32 lastUse;
+		Result result;
+	};
+
+	Entry _entries[kMaxWrapEntries];
+	uint _count;
+	uint32 _useCounter;
+};
+
+} // End of anonymous namespace
+
+struct Font::TextCache {
+	int16 charWidths[kCachedWidthChars];
+	int8 kerningOffsets[kCachedKerningChars * kCachedKerningChars];
+	WordWrapMemo<Common::String> wraps;
+	WordWrapMemo<Common::U32String> u32Wraps;
+
+	TextCache() {
+		clear();
+	}
+
+	void clear() {
+		for (uint i = 0; i < kCachedWidthChars; ++i)
+			charWidths[i] = kUnknownWidth;
+		memset(kerningOffsets, kUnknownKerning, sizeof(kerningOffsets));
+		wraps.clear();
+		u32Wraps.clear();
+	}
+
+	WordWrapMemo<Common::String> &getWraps(const Common::String &) { return wraps; }
+	WordWrapMemo<Common::U32String> &getWraps(const Common::U32String &) { return u32Wraps; }
+};
+
+/**
+ * Measures text with a font, going through its text cache if it has one
+ * enabled.
+ */
+class FontMeasure {
+public:
+	explicit FontMeasure(const Font &font) :
+		_font(font), _cache(font._textCacheEnabled ? font.getTextCache() : nullptr) {
+	}
+
+	int charWidth(uint32 chr) const {
+		if (!_cache || chr >= kCachedWidthChars)
+			return _font.getCharWidth(chr);
+
+		int16 &width = _cache->charWidths[chr];
+		if (width == kUnknownWidth)
+			width = _font.getCharWidth(chr);
+		return width;
+	}
+
+	int kerningOffset(uint32 left, uint32 right) const {
+		if (!_cache || left >= kCachedKerningChars || right >= kCachedKerningChars)
+			return _font.getKerningOffset(left, right);
+
+		int8 &offset = _cache->kerningOffsets[left * kCachedKerningChars + right];
+		if (offset != kUnknownKerning)
+			return offset;
+
+		const int measured = _font.getKerningOffset(left, right);
+		// Offsets which do not fit are measured each time.
+		if (measured > kUnknownKerning && measured <= 127)
+			offset = measured;
+		return measured;
+	}
+
+	template<class StringType>
+	int wordWrap(const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, uint32 mode) const;
+
+private:
+	const Font &_font;
+	Font::TextCache *_cache;
+};
+
+Font::Font() : _textCache(nullptr), _textCacheEnabled(false) {
+}
+
+Font::Font(const Font &other) : _textCache(nullptr), _textCacheEnabled(other._textCacheEnabled) {
+}
+
+Font &Font::operator=(const Font &other) {
+	if (this != &other) {
+		clearTextCache();
+		_textCacheEnabled = other._textCacheEnabled;
+	}
+	return *this;
+}
+
+Font::~Font() {
+	delete _textCache;
+}
+
+void Font::setTextCacheEnabled(bool enable) {
+	_textCacheEnabled = enable;
+	if (!enable) {
+		delete _textCache;
+		_textCache = nullptr;
+	}
+}
+
+void Font::clearTextCache() const {
+	if (_textCache)
+		_textCache->clear();
+}
+
+Font::TextCache *Font::getTextCache() const {
+	if (!_textCache)
+		_textCache = new TextCache();
+	return _textCache;
+}
+
 int Font::getFontAscent() const {
 	return -1;
 }
@@ -93,12 +287,13 @@ Common::Rect getBoundingBoxImpl(const Font &font, const StringType &str, int x,
 
 template<class StringType>
 int getStringWidthImpl(const Font &font, const StringType &str) {
+	const FontMeasure measure(font);
 	int space = 0;
 	typename StringType::unsigned_type last = 0;
 
 	for (uint i = 0; i < str.size(); ++i) {
 		const typename StringType::unsigned_type cur = str[i];
-		space += font.getCharWidth(cur) + font.getKerningOffset(last, cur);
+		space += measure.charWidth(cur) + measure.kerningOffset(last, cur);
 		last = cur;
 	}
 
@@ -120,10 +315,11 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	const FontMeasure measure(font);
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
-		x += font.getKerningOffset(last, cur);
+		x += measure.kerningOffset(last, cur);
 		last = cur;
 
 		Common::Rect charBox = font.getBoundingBox(cur);
@@ -132,7 +328,7 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		if (x + charBox.right >= leftX)
 			font.drawChar(dst, cur, x, y, color);
 
-		x += font.getCharWidth(cur);
+		x += measure.charWidth(cur);
 	}
 }
 
@@ -162,6 +358,7 @@ struct WordWrapper {
 
 template<class StringType>
 int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, uint32 mode) {
+	const FontMeasure measure(font);
 	WordWrapper<StringType> wrapper(lines);
 	StringType line;
 	StringType tmpStr;
@@ -215,7 +412,7 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 				}
 			}
 
-			const int w = font.getCharWidth(c) + font.getKerningOffset(last, c);
+			const int w = measure.charWidth(c) + measure.kerningOffset(last, c);
 			last = c;
 			fullTextWidthEWL += w;
 		}
@@ -230,7 +427,7 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 			// We add +2 to the fullTextWidthEWL to account for possible shadow pixels
 			// We add +10 * font.getCharWidth(' ') to the quotient since we want to allow some extra margin (about an extra wprd's length)
 			// since that yields better looking results
-			targetMaxLineWidth = ((fullTextWidthEWL + 2) / targetTotalLinesNumberEWL) + 10 * font.getCharWidth(' ');
+			targetMaxLineWidth = ((fullTextWidthEWL + 2) / targetTotalLinesNumberEWL) + 10 * measure.charWidth(' ');
 			if (targetMaxLineWidth > maxWidth) {
 				// repeat the loop with increased targetTotalLinesNumberEWL
 				continue;
@@ -257,8 +454,8 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 				c = ' ';
 			}
 
-			const int currentCharWidth = font.getCharWidth(c);
-			const int w = currentCharWidth + font.getKerningOffset(last, c);
+			const int currentCharWidth = measure.charWidth(c);
+			const int w = currentCharWidth + measure.kerningOffset(last, c);
 			last = c;
 			const bool wouldExceedWidth = (lineWidth + tmpWidth + w > targetMaxLineWidth);
 
@@ -301,7 +498,7 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 						// If tmpStr is empty, we might have removed the space before 'c'.
 						// That means we have to recompute the kerning.
 
-						tmpWidth += currentCharWidth + font.getKerningOffset(0, c);
+						tmpWidth += currentCharWidth + measure.kerningOffset(0, c);
 						tmpStr += c;
 						continue;
 					}
@@ -489,12 +686,45 @@ void Font::drawString(ManagedSurface *dst, const Common::U32String &str, int x,
 	}
 }
 
+template<class StringType>
+int FontMeasure::wordWrap(const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, uint32 mode) const {
+	if (!_cache || str.size() > kMaxWrapLength)
+		return wordWrapTextImpl(_font, str, maxWidth, lines, initWidth, mode);
+
+	WordWrapMemo<StringType> &memo = _cache->getWraps(str);
+	const uint hash = str.hash();
+	const typename WordWrapMemo<StringType>::Result *result = memo.find(str, hash, maxWidth, initWidth, mode);
+	if (!result) {
+		typename WordWrapMemo<StringType>::Result &entry = memo.insert(str, hash, maxWidth, initWidth, mode);
+		entry.maxLineWidth = wordWrapTextImpl(_font, str, maxWidth, entry.lines, initWidth, mode);
+		result = &entry;
+	}
+
+	// Even width wrapping starts over from an empty line array, unless
+	// explicit new lines in the text take precedence over it.
+	bool clearsLines = (mode & kWordWrapEvenWidthLines) != 0;
+	if (clearsLines && (mode & kWordWrapOnExplicitNewLines)) {
+		for (uint i = 0; i < str.size(); ++i) {
+			if (str[i] == '\n' || str[i] == '\r') {
+				clearsLines = false;
+				break;
+			}
+		}
+	}
+	if (clearsLines)
+		lines.clear();
+
+	for (uint i = 0; i < result->lines.size(); ++i)
+		lines.push_back(result->lines[i]);
+	return result->maxLineWidth;
+}
+
 int Font::wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth, uint32 mode) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
+	return FontMeasure(*this).wordWrap(str, maxWidth, lines, initWidth, mode);
 }
 
 int Font::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth, uint32 mode) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
+	return FontMeasure(*this).wordWrap(str, maxWidth, lines, initWidth, mode);
 }
 
 TextAlign convertTextAlignH(TextAlign alignH, bool rtl) {
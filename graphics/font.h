@@ -81,8 +81,10 @@ TextAlign convertTextAlignH(TextAlign alignH, bool rtl);
  */
 class Font {
 public:
-	Font() {}
-	virtual ~Font() {}
+	Font();
+	Font(const Font &other);
+	Font &operator=(const Font &other);
+	virtual ~Font();
 
 	/**
 	 * Return the height of the font.
@@ -290,6 +292,28 @@ public:
 	 */
 	void scaleSingleGlyph(Surface *scaleSurface, int *grayScaleMap, int grayScaleMapSize, int width, int height, int xOffset, int yOffset, int grayLevel, int chr, int srcheight, int srcwidth, float scale) const;
 
+	/**
+	 * Let the font remember the widths and kerning offsets of the most
+	 * common characters, as well as the results of recent wordWrapText()
+	 * calls, so that text which is laid out every frame is not measured
+	 * again each time.
+	 *
+	 * Only enable this for fonts whose metrics do not change once they are
+	 * loaded, or call clearTextCache() whenever they do.
+	 */
+	void setTextCacheEnabled(bool enable);
+
+	/** Forget all the metrics and word wrapping results remembered so far. */
+	void clearTextCache() const;
+
+private:
+	friend class FontMeasure;
+	struct TextCache;
+
+	TextCache *getTextCache() const;
+
+	mutable TextCache *_textCache;
+	bool _textCacheEnabled;
 };
 /** @} */
 } // End of namespace Graphics
@@ -33,6 +33,7 @@ namespace Graphics {
 
 BdfFont::BdfFont(const BdfFontData &data, DisposeAfterUse::Flag dispose)
 	: _data(data), _dispose(dispose) {
+	setTextCacheEnabled(true);
 }
 
 BdfFont::~BdfFont() {
@@ -0,0 +1,201 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/memtag.h"
+#include "graphics/fonts/glyph_atlas.h"
+
+namespace Graphics {
+
+static void createPageSurface(Surface &surface, int width, int height) {
+	surface.create(width, height, PixelFormat::createFormatCLUT8());
+	Common::memTagAllocated(Common::kMemTagFonts, surface.pitch * surface.h);
+}
+
+static void freePageSurface(Surface &surface) {
+	Common::memTagFreed(Common::kMemTagFonts, surface.pitch * surface.h);
+	surface.free();
+}
+
+GlyphAtlas::GlyphAtlas(int pageWidth, int pageHeight, uint maxPages)
+	: _pageWidth(pageWidth), _pageHeight(pageHeight), _maxPages(MAX<uint>(maxPages, 1)), _clock(0) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+	for (uint i = 0; i < _pages.size(); ++i) {
+		freePageSurface(_pages[i]->surface);
+		delete _pages[i];
+	}
+}
+
+uint32 GlyphAtlas::registerFace(const Common::String &descriptor) {
+	for (uint i = 0; i < _faces.size(); ++i) {
+		if (_faces[i] == descriptor)
+			return i;
+	}
+	_faces.push_back(descriptor);
+	return _faces.size() - 1;
+}
+
+const GlyphAtlas::Glyph *GlyphAtlas::find(uint32 face, uint32 chr) {
+	const Key key = { face, chr };
+	GlyphMap::iterator entry = _glyphs.find(key);
+	if (entry == _glyphs.end())
+		return nullptr;
+
+	if (entry->_value.page >= 0)
+		_pages[entry->_value.page]->lastUse = ++_clock;
+	return &entry->_value;
+}
+
+GlyphAtlas::Glyph *GlyphAtlas::insert(uint32 face, uint32 chr, int width, int height) {
+	const Key key = { face, chr };
+	GlyphMap::iterator existing = _glyphs.find(key);
+	if (existing != _glyphs.end()) {
+		if (existing->_value.page >= 0) {
+			Common::Array<Key> &keys = _pages[existing->_value.page]->glyphs;
+			for (uint i = 0; i < keys.size(); ++i) {
+				if (keys[i] == key) {
+					keys.remove_at(i);
+					break;
+				}
+			}
+		}
+		_glyphs.erase(existing);
+	}
+
+	Glyph glyph;
+	glyph.xOffset = glyph.yOffset = glyph.advance = 0;
+	glyph.slot = 0;
+	glyph.width = width;
+	glyph.height = height;
+	glyph.page = -1;
+	glyph.x = glyph.y = 0;
+
+	if (width > 0 && height > 0) {
+		int page = -1;
+		for (uint i = 0; i < _pages.size() && page < 0; ++i) {
+			if (allocate(*_pages[i], width, height, glyph.x, glyph.y))
+				page = i;
+		}
+
+		if (page < 0 && _pages.size() < _maxPages) {
+			// Glyphs larger than a page get a page of their own
+			Page *newPage = new Page();
+			createPageSurface(newPage->surface, MAX(_pageWidth, width), MAX(_pageHeight, height));
+			_pages.push_back(newPage);
+			page = _pages.size() - 1;
+			allocate(*newPage, width, height, glyph.x, glyph.y);
+		}
+
+		if (page < 0) {
+			uint oldest = 0;
+			for (uint i = 1; i < _pages.size(); ++i) {
+				if (_pages[i]->lastUse < _pages[oldest]->lastUse)
+					oldest = i;
+			}
+
+			Page &victim = *_pages[oldest];
+			evict(victim);
+			if (victim.surface.w < width || victim.surface.h < height) {
+				freePageSurface(victim.surface);
+				createPageSurface(victim.surface, MAX(_pageWidth, width), MAX(_pageHeight, height));
+			}
+			page = oldest;
+			allocate(victim, width, height, glyph.x, glyph.y);
+		}
+
+		Page &target = *_pages[page];
+		target.glyphs.push_back(key);
+		target.lastUse = ++_clock;
+		glyph.page = page;
+
+		byte *pixels = (byte *)target.surface.getBasePtr(glyph.x, glyph.y);
+		for (int y = 0; y < height; ++y)
+			memset(pixels + y * target.surface.pitch, 0, width);
+	}
+
+	_glyphs[key] = glyph;
+	return &_glyphs[key];
+}
+
+byte *GlyphAtlas::getPixels(const Glyph &glyph) {
+	if (glyph.page < 0)
+		return nullptr;
+	return (byte *)_pages[glyph.page]->surface.getBasePtr(glyph.x, glyph.y);
+}
+
+int GlyphAtlas::getPitch(const Glyph &glyph) const {
+	if (glyph.page < 0)
+		return 0;
+	return _pages[glyph.page]->surface.pitch;
+}
+
+void GlyphAtlas::clear() {
+	for (uint i = 0; i < _pages.size(); ++i) {
+		freePageSurface(_pages[i]->surface);
+		delete _pages[i];
+	}
+	_pages.clear();
+	_glyphs.clear();
+}
+
+bool GlyphAtlas::allocate(Page &page, int width, int height, int &x, int &y) {
+	if (width > page.surface.w)
+		return false;
+
+	// Use the shelf wasting the least height, shelves much taller than the
+	// glyph are left to taller glyphs
+	Shelf *best = nullptr;
+	for (uint i = 0; i < page.shelves.size(); ++i) {
+		Shelf &shelf = page.shelves[i];
+		if (shelf.height < height || shelf.height > height + height / 2 + 2 || shelf.x + width > page.surface.w)
+			continue;
+		if (!best || shelf.height < best->height)
+			best = &shelf;
+	}
+
+	if (!best) {
+		const int top = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+		if (top + height > page.surface.h)
+			return false;
+
+		Shelf shelf;
+		shelf.y = top;
+		shelf.height = height;
+		shelf.x = 0;
+		page.shelves.push_back(shelf);
+		best = &page.shelves.back();
+	}
+
+	x = best->x;
+	y = best->y;
+	best->x += width;
+	return true;
+}
+
+void GlyphAtlas::evict(Page &page) {
+	for (uint i = 0; i < page.glyphs.size(); ++i)
+		_glyphs.erase(page.glyphs[i]);
+	page.glyphs.clear();
+	page.shelves.clear();
+}
+
+} // End of namespace Graphics
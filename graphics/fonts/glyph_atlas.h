@@ -0,0 +1,139 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_FONTS_GLYPH_ATLAS_H
+#define GRAPHICS_FONTS_GLYPH_ATLAS_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * A size bounded cache of 8 bit glyph coverage bitmaps, shared by all
+ * fonts. Glyphs are packed into shelves on a fixed number of CLUT8 pages.
+ * When a glyph does not fit, the least recently used page is emptied and
+ * reused, which drops all glyphs stored on it.
+ *
+ * Glyphs are identified by a face id, which stands for everything that
+ * affects the rendering (font file, size, render mode, ...), and a code
+ * point.
+ */
+class GlyphAtlas {
+public:
+	struct Glyph {
+		int xOffset, yOffset;
+		int advance;
+		uint32 slot;
+		int width, height;
+
+		// Location in the atlas, page is -1 for glyphs without pixels
+		int page;
+		int x, y;
+	};
+
+	/**
+	 * @param pageWidth  Width of a page, in pixels.
+	 * @param pageHeight Height of a page, in pixels.
+	 * @param maxPages   Number of pages after which pages are reused.
+	 */
+	GlyphAtlas(int pageWidth, int pageHeight, uint maxPages);
+	~GlyphAtlas();
+
+	/**
+	 * Return the id of the face described by @p descriptor. Fonts with
+	 * equal descriptors share their glyphs.
+	 */
+	uint32 registerFace(const Common::String &descriptor);
+
+	/**
+	 * Look up a glyph and mark its page as recently used.
+	 *
+	 * @return The glyph, or nullptr if it is not cached. The pointer is
+	 *         valid until the next call to insert().
+	 */
+	const Glyph *find(uint32 face, uint32 chr);
+
+	/**
+	 * Add a glyph of @p width x @p height pixels, reusing the least recently
+	 * used page if needed. The caller fills in the metrics and the pixels,
+	 * see getPixels().
+	 *
+	 * @return The new glyph, valid until the next call to insert().
+	 */
+	Glyph *insert(uint32 face, uint32 chr, int width, int height);
+
+	/** Return the top left pixel of @p glyph, or nullptr if it has none. */
+	byte *getPixels(const Glyph &glyph);
+
+	/** Return the pitch of the page holding @p glyph. */
+	int getPitch(const Glyph &glyph) const;
+
+	/** Drop all glyphs. The registered faces are kept. */
+	void clear();
+
+	uint getGlyphCount() const { return _glyphs.size(); }
+	uint getPageCount() const { return _pages.size(); }
+
+private:
+	struct Key {
+		uint32 face;
+		uint32 chr;
+
+		bool operator==(const Key &other) const { return face == other.face && chr == other.chr; }
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const { return key.face * 0x9E3779B1 ^ key.chr; }
+	};
+
+	struct Shelf {
+		int y, height;
+		int x;
+	};
+
+	struct Page {
+		Surface surface;
+		Common::Array<Shelf> shelves;
+		Common::Array<Key> glyphs;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Glyph, KeyHash> GlyphMap;
+
+	bool allocate(Page &page, int width, int height, int &x, int &y);
+	void evict(Page &page);
+
+	const int _pageWidth, _pageHeight;
+	const uint _maxPages;
+	uint32 _clock;
+
+	Common::Array<Page *> _pages;
+	GlyphMap _glyphs;
+	Common::Array<Common::String> _faces;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -27,6 +27,7 @@
 #ifdef USE_FREETYPE2
 
 #include "graphics/fonts/ttf.h"
+#include "graphics/fonts/glyph_atlas.h"
 #include "graphics/font.h"
 #include "graphics/surface.h"
 #include "graphics/managed_surface.h"
@@ -34,6 +35,7 @@
 #include "common/ustr.h"
 #include "common/file.h"
 #include "common/config-manager.h"
+#include "common/crc.h"
 #include "common/singleton.h"
 #include "common/stream.h"
 #include "common/memstream.h"
@@ -106,11 +108,23 @@ private:
 	bool _initialized;
 };
 
+/**
+ * The glyph bitmaps of all TTF fonts. Fonts loaded from the same file with
+ * the same settings share their glyphs, also across font instances.
+ */
+class TTFGlyphAtlas : public GlyphAtlas, public Common::Singleton<TTFGlyphAtlas> {
+public:
+	// 32 pages of 256x256 pixels, 2 MB of glyph bitmaps in total
+	TTFGlyphAtlas() : GlyphAtlas(256, 256, 32) {}
+};
+
 void shutdownTTF() {
+	TTFGlyphAtlas::destroy();
 	TTFLibrary::destroy();
 }
 
 #define g_ttf ::Graphics::TTFLibrary::instance()
+#define g_ttfAtlas ::Graphics::TTFGlyphAtlas::instance()
 
 TTFLibrary::TTFLibrary() : _library(), _initialized(false) {
 	if (!FT_Init_FreeType(&_library))
@@ -161,6 +175,9 @@ public:
 	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	/** Render the glyphs of @p chars ahead of their first use. */
+	void prewarm(const Common::U32String &chars) const;
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -171,14 +188,19 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
+	// The bitmaps live in the shared glyph atlas, keyed by code point
 	struct Glyph {
-		Surface image;
+		uint32 chr;
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
+		int width, height;
 	};
 
+	uint32 _atlasFace;
+
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
+	const GlyphAtlas::Glyph *renderToAtlas(uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
@@ -202,7 +224,7 @@ private:
 
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+	  _descent(0), _atlasFace(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
 	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
 }
 
@@ -213,9 +235,6 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
 }
@@ -367,6 +386,14 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Everything that changes how the glyphs are rendered
+	Common::CRC32 crc;
+	const FT_Size_Metrics &metrics = _face->size->metrics;
+	_atlasFace = g_ttfAtlas.registerFace(Common::String::format("%08x:%u:%d:%d:%d:%ld:%ld:%d:%d:%d:%d:%d:%d",
+		crc.crcFast(_ttfFile, _size), _size, faceIndex, metrics.x_ppem, metrics.y_ppem,
+		(long)metrics.x_scale, (long)metrics.y_scale, (int)_loadFlags, (int)_renderMode,
+		_fakeBold, _fakeItalic, stemDarkening, _ascent));
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -409,6 +436,9 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		return false;
 	} else {
 		_initialized = true;
+		// The metrics are fixed from now on
+		clearTextCache();
+		setTextCacheEnabled(true);
 		// At this point we get ownership of _ttfFile
 		return true;
 	}
@@ -599,10 +629,8 @@ Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
 	if (glyphEntry == _glyphs.end()) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		const Glyph &glyph = glyphEntry->_value;
+		return Common::Rect(glyph.xOffset, glyph.yOffset, glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
 	}
 }
 
@@ -689,10 +717,20 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
+	if (w <= 0 || h <= 0)
+		return;
+
+	// The bitmap may have been dropped from the atlas since the glyph was cached
+	const GlyphAtlas::Glyph *image = g_ttfAtlas.find(_atlasFace, glyph.chr);
+	if (!image)
+		image = renderToAtlas(glyph.chr);
+	if (!image)
+		return;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = g_ttfAtlas.getPixels(*image);
+	const int srcPitch = g_ttfAtlas.getPitch(*image);
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -708,7 +746,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * srcPitch;
 		h += y;
 		y = 0;
 	}
@@ -737,40 +775,52 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += srcPitch;
 		}
 	} else if (dst->format.bytesPerPixel == 1) {
-		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	}
 }
 
 bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
-	FT_UInt slot = FT_Get_Char_Index(_face, chr);
-	if (!slot)
+	const GlyphAtlas::Glyph *image = g_ttfAtlas.find(_atlasFace, chr);
+	if (!image)
+		image = renderToAtlas(chr);
+	if (!image)
 		return false;
 
-	glyph.slot = slot;
+	glyph.chr = chr;
+	glyph.xOffset = image->xOffset;
+	glyph.yOffset = image->yOffset;
+	glyph.advance = image->advance;
+	glyph.slot = image->slot;
+	glyph.width = image->width;
+	glyph.height = image->height;
+	return true;
+}
+
+const GlyphAtlas::Glyph *TTFFont::renderToAtlas(uint32 chr) const {
+	FT_UInt slot = FT_Get_Char_Index(_face, chr);
+	if (!slot)
+		return nullptr;
 
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticeable in FreeSansBold.ttf, where otherwise the
 	// 't' glyph looks like it is cut off on the right side.
 	if (FT_Load_Glyph(_face, slot, _loadFlags))
-		return false;
+		return nullptr;
 
 	if (FT_Render_Glyph(_face->glyph, _renderMode))
-		return false;
+		return nullptr;
 
 	if (_face->glyph->format != FT_GLYPH_FORMAT_BITMAP)
-		return false;
-
-	glyph.xOffset = _face->glyph->bitmap_left;
-	glyph.yOffset = _ascent - _face->glyph->bitmap_top;
+		return nullptr;
 
-	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
+	int advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap *bitmap;
 #if FAKE_BOLD == 1
@@ -780,28 +830,28 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	if (_fakeBold) {
 #if FAKE_BOLD >= 2
 		// Embolden by 1 pixel in x and 0 in y
-		glyph.advance += 1;
+		advance += 1;
 
 		if (FT_GlyphSlot_Own_Bitmap(_face->glyph))
-			return false;
+			return nullptr;
 
 		// That's 26.6 fixed-point units
 		if (FT_Bitmap_Embolden(_face->glyph->library, &_face->glyph->bitmap, 1 << 6, 0))
-			return false;
+			return nullptr;
 
 		bitmap = &_face->glyph->bitmap;
 #elif FAKE_BOLD >= 1
 		FT_Bitmap_New(&ownBitmap);
 
 		if (FT_Bitmap_Copy(_face->glyph->library, &_face->glyph->bitmap, &ownBitmap))
-			return false;
+			return nullptr;
 
 		// Embolden by 1 pixel in x and 0 in y
-		glyph.advance += 1;
+		advance += 1;
 
 		// That's 26.6 fixed-point units
 		if (FT_Bitmap_Embolden(_face->glyph->library, &ownBitmap, 1 << 6, 0))
-			return false;
+			return nullptr;
 
 		bitmap = &ownBitmap;
 #else
@@ -812,8 +862,21 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		bitmap = &_face->glyph->bitmap;
 	}
 
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::renderToAtlas: Unsupported pixel mode %d", bitmap->pixel_mode);
+#if FAKE_BOLD == 1
+		if (_fakeBold) {
+			FT_Bitmap_Done(_face->glyph->library, &ownBitmap);
+		}
+#endif
+		return nullptr;
+	}
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	GlyphAtlas::Glyph *glyph = g_ttfAtlas.insert(_atlasFace, chr, bitmap->width, bitmap->rows);
+	glyph->xOffset = _face->glyph->bitmap_left;
+	glyph->yOffset = _ascent - _face->glyph->bitmap_top;
+	glyph->advance = advance;
+	glyph->slot = slot;
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -822,10 +885,10 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	uint8 *dst = g_ttfAtlas.getPixels(*glyph);
+	const int dstPitch = g_ttfAtlas.getPitch(*glyph);
 
-	switch (bitmap->pixel_mode) {
-	case FT_PIXEL_MODE_MONO:
+	if (dst && bitmap->pixel_mode == FT_PIXEL_MODE_MONO) {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			const uint8 *curSrc = src;
 			uint8 mask = 0;
@@ -835,28 +898,20 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += dstPitch;
 			src += srcPitch;
 		}
-		break;
-
-	case FT_PIXEL_MODE_GRAY:
+	} else if (dst) {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
+			dst += dstPitch;
 			src += srcPitch;
 		}
-		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 #if FAKE_BOLD == 1
@@ -865,7 +920,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 #endif
 
-	return true;
+	return glyph;
 }
 
 void TTFFont::assureCached(uint32 chr) const {
@@ -879,6 +934,44 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 }
 
+void TTFFont::prewarm(const Common::U32String &chars) const {
+	for (uint i = 0; i < chars.size(); ++i) {
+		assureCached(chars[i]);
+
+		GlyphCache::const_iterator glyphEntry = _glyphs.find(chars[i]);
+		if (glyphEntry != _glyphs.end() && !g_ttfAtlas.find(_atlasFace, glyphEntry->_value.chr))
+			renderToAtlas(glyphEntry->_value.chr);
+	}
+}
+
+void prewarmTTFFont(const Font *font, const Common::U32String &chars) {
+	const TTFFont *ttfFont = dynamic_cast<const TTFFont *>(font);
+	if (ttfFont)
+		ttfFont->prewarm(chars);
+}
+
+void prewarmTTFFont(const Font *font, TTFCharacterSet charset) {
+	static const struct {
+		uint32 first, last;
+	} ranges[][3] = {
+		// Printable ASCII and the Latin-1 supplement
+		{ { 0x20, 0x7E }, { 0xA0, 0xFF }, { 0, 0 } },
+		// Greek and Coptic
+		{ { 0x370, 0x3FF }, { 0, 0 }, { 0, 0 } },
+		// Cyrillic
+		{ { 0x400, 0x45F }, { 0, 0 }, { 0, 0 } },
+		// CJK punctuation, Hiragana, Katakana and full width forms
+		{ { 0x3000, 0x303F }, { 0x3040, 0x30FF }, { 0xFF01, 0xFF5E } }
+	};
+
+	Common::U32String chars;
+	for (int i = 0; i < 3 && ranges[charset][i].first; ++i) {
+		for (uint32 chr = ranges[charset][i].first; chr <= ranges[charset][i].last; ++chr)
+			chars += (Common::u32char_type_t)chr;
+	}
+	prewarmTTFFont(font, chars);
+}
+
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
 	TTFFont *font = new TTFFont();
 
@@ -1084,6 +1177,7 @@ Font *findTTFace(const Common::Array<Common::String> &files, const Common::U32St
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::TTFLibrary);
+DECLARE_SINGLETON(Graphics::TTFGlyphAtlas);
 } // End of namespace Common
 
 #endif
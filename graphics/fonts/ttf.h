@@ -138,6 +138,36 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::String> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint dpi = 0, TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Character sets for prewarmTTFFont().
+ */
+enum TTFCharacterSet {
+	kTTFCharsetLatin1,   ///< Printable ASCII and Latin-1 characters.
+	kTTFCharsetGreek,    ///< Greek and Coptic.
+	kTTFCharsetCyrillic, ///< Cyrillic.
+	kTTFCharsetKana      ///< CJK punctuation, Hiragana, Katakana and full width forms.
+};
+
+/**
+ * Renders the glyphs of the given characters into the shared glyph cache,
+ * so that drawing them later does not have to. The cache is bounded, so
+ * glyphs which have not been used for a while may be rendered again.
+ *
+ * Nothing happens for fonts not loaded from TTF files.
+ *
+ * @param font  The font to render the glyphs of.
+ * @param chars The characters to render.
+ */
+void prewarmTTFFont(const Font *font, const Common::U32String &chars);
+
+/**
+ * Renders the glyphs of a common character set into the shared glyph cache.
+ *
+ * @param font    The font to render the glyphs of.
+ * @param charset The characters to render. @see TTFCharacterSet
+ */
+void prewarmTTFFont(const Font *font, TTFCharacterSet charset);
+
 void shutdownTTF();
 
 } // End of namespace Graphics
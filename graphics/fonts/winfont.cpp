@@ -48,6 +48,7 @@ void WinFont::close() {
 	_glyphCount = 0;
 	delete[] _glyphs;
 	_glyphs = 0;
+	setTextCacheEnabled(false);
 }
 
 // Reads a null-terminated string
@@ -297,6 +298,7 @@ bool WinFont::loadFromFNT(Common::SeekableReadStream &stream) {
 #endif
 	}
 
+	setTextCacheEnabled(true);
 	return true;
 }
 
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/memtag.h"
+#include "graphics/frame_pool.h"
+
+namespace Common {
+DECLARE_SINGLETON(Graphics::FramePool);
+}
+
+namespace Graphics {
+
+FramePool::FramePool() {
+	resetStats();
+}
+
+FramePool::~FramePool() {
+	clear();
+}
+
+Surface *FramePool::acquire(int16 width, int16 height, const PixelFormat &format) {
+	{
+		Common::StackLock lock(_mutex);
+
+		// Prefer the most recently released surface, which is most likely in the cache
+		for (uint i = _free.size(); i > 0; --i) {
+			Surface *surface = _free[i - 1];
+			if (surface->w == width && surface->h == height && surface->format == format) {
+				_free.remove_at(i - 1);
+				++_stats.reuses;
+				return surface;
+			}
+		}
+
+		++_stats.allocations;
+	}
+
+	Surface *surface = new Surface();
+	surface->create(width, height, format);
+	Common::memTagAllocated(Common::kMemTagVideo, surface->pitch * surface->h);
+	return surface;
+}
+
+void FramePool::release(Surface *surface) {
+	if (!surface)
+		return;
+
+	Surface *evicted = 0;
+	{
+		Common::StackLock lock(_mutex);
+
+		if (_free.size() >= kMaxFreeSurfaces) {
+			evicted = _free.front();
+			_free.remove_at(0);
+			++_stats.evictions;
+		}
+		_free.push_back(surface);
+	}
+
+	if (evicted) {
+		Common::memTagFreed(Common::kMemTagVideo, evicted->pitch * evicted->h);
+		evicted->free();
+		delete evicted;
+	}
+}
+
+void FramePool::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _free.size(); ++i) {
+		Common::memTagFreed(Common::kMemTagVideo, _free[i]->pitch * _free[i]->h);
+		_free[i]->free();
+		delete _free[i];
+	}
+	_free.clear();
+}
+
+FramePool::Stats FramePool::getStats() const {
+	Common::StackLock lock(_mutex);
+	return _stats;
+}
+
+void FramePool::resetStats() {
+	Common::StackLock lock(_mutex);
+	_stats.allocations = 0;
+	_stats.reuses = 0;
+	_stats.evictions = 0;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @defgroup graphics_frame_pool Frame pool
+ * @ingroup graphics
+ *
+ * @brief Pool of the surfaces which video decoders and codecs decode into.
+ *
+ * Used in video:
+ * - FlicDecoder
+ * - Indeo3Decoder
+ * - MKVDecoder
+ * - PSXStreamDecoder
+ * - QuickTimeDecoder
+ * @{
+ */
+
+#ifndef GRAPHICS_FRAME_POOL_H
+#define GRAPHICS_FRAME_POOL_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * A pool of surfaces, which are reused by their size and pixel format.
+ *
+ * Decoders acquire the surfaces for their frames from the pool and release
+ * them when they do not need them anymore, for example when the size or
+ * the format of the video changes, or when the video is closed. Decoders
+ * which need a new surface for every frame therefore only allocate until
+ * the pool holds as many surfaces of their size as they keep in flight.
+ *
+ * The pool may be used from multiple threads, such as the thread pool
+ * workers decoding ahead.
+ *
+ * The surfaces allocated by the pool are accounted to Common::kMemTagVideo
+ * until the pool frees them.
+ */
+class FramePool : public Common::Singleton<FramePool> {
+public:
+	/** Counters since the pool was created or since resetStats() */
+	struct Stats {
+		uint32 allocations; ///< Surfaces which had to be allocated
+		uint32 reuses;      ///< Surfaces which were handed out again after they had been released
+		uint32 evictions;   ///< Released surfaces which were freed as the pool was full
+	};
+
+	/**
+	 * Return a surface of the given size and format, either a released
+	 * one or a newly allocated one. Its pixels are not initialized.
+	 */
+	Surface *acquire(int16 width, int16 height, const PixelFormat &format);
+
+	/**
+	 * Hand a surface returned by acquire() back to the pool. Does nothing
+	 * for a null pointer.
+	 */
+	void release(Surface *surface);
+
+	/** Free all surfaces which have been released. */
+	void clear();
+
+	Stats getStats() const;
+	void resetStats();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	FramePool();
+	~FramePool();
+
+	enum {
+		kMaxFreeSurfaces = 16
+	};
+
+	Common::Array<Surface *> _free; ///< The released surfaces, the least recently released first
+	Stats _stats;
+	mutable Common::Mutex _mutex;
+};
+ /** @} */
+} // End of namespace Graphics
+
+#define FramePoolMan (::Graphics::FramePool::instance())
+
+#endif
@@ -21,39 +21,79 @@
 
 #include "graphics/framelimiter.h"
 
+#include "common/algorithm.h"
 #include "common/util.h"
 
 namespace Graphics {
 
 FrameLimiter::FrameLimiter(OSystem *system, const uint framerate) :
 		_system(system),
-		_speedLimitMs(0),
+		_enabled(framerate != 0),
+		_framePeriod(0),
+		_vsyncInterval(0),
 		_startFrameTime(0),
-		_lastFrameDurationMs(_speedLimitMs) {
-	// The frame limiter is disabled when vsync is enabled.
-	_enabled = !_system->getFeatureState(OSystem::kFeatureVSync) && framerate != 0;
+		_nextFrameTime(0),
+		_lastFrameDuration(0),
+		_frameCount(0) {
+	if (!_enabled) {
+		return;
+	}
+
+	if (_system->getFeatureState(OSystem::kFeatureVSync)) {
+		// The swap already waits for the display, only framerates below
+		// the refresh rate need to be limited
+		const uint refreshRate = _system->getDisplayRefreshRate();
+		if (refreshRate == 0 || framerate >= refreshRate) {
+			_enabled = false;
+			return;
+		}
 
-	if (_enabled) {
-		_speedLimitMs = 1000 / CLIP<uint>(framerate, 0, 100);
+		_vsyncInterval = 1000000 / refreshRate;
+		_framePeriod = _vsyncInterval * ((refreshRate + framerate / 2) / framerate);
+	} else {
+		_framePeriod = 1000000 / MIN<uint>(framerate, 1000);
 	}
 }
 
 void FrameLimiter::startFrame() {
-	uint currentTime = _system->getMillis();
+	uint64 currentTime = _system->getMicros();
 
 	if (_startFrameTime != 0) {
-		_lastFrameDurationMs = currentTime - _startFrameTime;
+		_lastFrameDuration = (uint32)(currentTime - _startFrameTime);
+		_frameTimes[_frameCount % kStatsFrames] = _lastFrameDuration;
+		_frameCount++;
 	}
 
 	_startFrameTime = currentTime;
 }
 
 void FrameLimiter::delayBeforeSwap() {
-	uint endFrameTime = _system->getMillis();
-	uint frameDuration = endFrameTime - _startFrameTime;
+	if (!_enabled) {
+		return;
+	}
+
+	const uint64 currentTime = _system->getMicros();
 
-	if (_enabled && frameDuration < _speedLimitMs) {
-		_system->delayMillis(_speedLimitMs - frameDuration);
+	// Start over after a pause, or when more than a frame behind,
+	// instead of rushing through frames to catch up
+	if (_nextFrameTime == 0 || currentTime >= _nextFrameTime + _framePeriod) {
+		_nextFrameTime = _startFrameTime + _framePeriod;
+	}
+
+	// With vsync, wake up half a refresh early so that the swap
+	// happens on the intended refresh
+	waitUntil(_nextFrameTime - _vsyncInterval / 2);
+
+	_nextFrameTime += _framePeriod;
+}
+
+void FrameLimiter::waitUntil(uint64 time) {
+	const uint64 currentTime = _system->getMicros();
+
+	// The delay is rounded to the nearest millisecond. Since the frames
+	// are due on a fixed schedule, the rounding errors do not add up.
+	if (currentTime + 500 <= time) {
+		_system->delayMillis((uint)((time - currentTime + 500) / 1000));
 	}
 }
 
@@ -61,11 +101,30 @@ void FrameLimiter::pause(bool pause) {
 	if (!pause) {
 		// Make sure the frame duration value is consistent when resuming
 		_startFrameTime = 0;
+		_nextFrameTime = 0;
 	}
 }
 
 uint FrameLimiter::getLastFrameDuration() const {
-	return _lastFrameDurationMs;
+	return _lastFrameDuration / 1000;
+}
+
+FrameLimiter::Stats FrameLimiter::getStats() const {
+	Stats stats;
+	stats.frames = MIN<uint>(_frameCount, kStatsFrames);
+	stats.median = stats.p99 = stats.max = 0;
+	if (stats.frames == 0) {
+		return stats;
+	}
+
+	uint32 frameTimes[kStatsFrames];
+	memcpy(frameTimes, _frameTimes, stats.frames * sizeof(frameTimes[0]));
+	Common::sort(frameTimes, frameTimes + stats.frames);
+
+	stats.median = frameTimes[stats.frames / 2];
+	stats.p99 = frameTimes[(stats.frames * 99) / 100];
+	stats.max = frameTimes[stats.frames - 1];
+	return stats;
 }
 
 } // End of namespace Graphics
@@ -33,6 +33,15 @@ namespace Graphics {
  * by delaying until all of the timeslot allocated to the frame
  * is consumed.
  * Allows to curb CPU usage and have a stable framerate.
+ *
+ * Frames are due at fixed multiples of the frame period, which is
+ * measured in microseconds, so that the timing errors of single frames
+ * do not add up and the average framerate is exact.
+ *
+ * When vsync is enabled, the buffer swap waits for the display. If the
+ * refresh rate of the display is known and higher than the framerate,
+ * frames are paced to a whole number of refreshes, otherwise the
+ * limiter is disabled.
  */
 class FrameLimiter {
 public:
@@ -44,13 +53,35 @@ public:
 	void pause(bool pause);
 
 	uint getLastFrameDuration() const;
+
+	/** Frame time statistics over the most recent frames, in microseconds. */
+	struct Stats {
+		uint frames;     ///< Number of frames the statistics are based on.
+		uint32 median;   ///< Median frame time.
+		uint32 p99;      ///< 99th percentile of the frame times.
+		uint32 max;      ///< Longest frame time.
+	};
+
+	Stats getStats() const;
+
 private:
+	enum {
+		kStatsFrames = 256
+	};
+
 	OSystem *_system;
 
 	bool _enabled;
-	uint _speedLimitMs;
-	uint _startFrameTime;
-	uint _lastFrameDurationMs;
+	uint32 _framePeriod;
+	uint32 _vsyncInterval;
+	uint64 _startFrameTime;
+	uint64 _nextFrameTime;
+	uint32 _lastFrameDuration;
+
+	uint32 _frameTimes[kStatsFrames];
+	uint _frameCount;
+
+	void waitUntil(uint64 time);
 };
 
 } // End of namespace Graphics
@@ -21,6 +21,8 @@
 
 #include "larryScale.h"
 #include "common/array.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace Graphics {
 
@@ -147,45 +149,137 @@ public:
 	}
 };
 
-inline bool isLinePixel(const MarginedBitmap<Color> &src, int x, int y) {
-#define EQUALS(xOffset, yOffset) (src.get(x + xOffset, y + yOffset) == pixel)
+// An equality matrix is a combination of eight Boolean flags indicating whether
+// each of the surrounding pixels has the same color as the central pixel.
+//
+// +------+------+------+
+// | 0x02 | 0x04 | 0x08 |
+// +------+------+------+
+// | 0x01 | Ref. | 0x10 |
+// +------+------+------+
+// | 0x80 | 0x40 | 0x20 |
+// +------+------+------+
+typedef byte EqualityMatrix;
 
-	const Color pixel = src.get(x, y);
+enum {
+	kEqualW = 0x01,
+	kEqualNW = 0x02,
+	kEqualN = 0x04,
+	kEqualNE = 0x08,
+	kEqualE = 0x10,
+	kEqualSE = 0x20,
+	kEqualS = 0x40,
+	kEqualSW = 0x80
+};
+
+// Bitmaps with fewer pixels are not worth splitting across threads.
+const int kMinParallelPixels = 128 * 128;
+// Bands smaller than this are not worth handing to another thread.
+const uint kMinBandRows = 16;
+
+// Returns the number of rows per band when processing a bitmap of the given
+// size on the thread pool, or 0 if it should be processed on this thread.
+uint getBandGrain(int width, int height) {
+	if (width * height < kMinParallelPixels || (uint)height < 2 * kMinBandRows) {
+		return 0;
+	}
+	if (g_system->getThreadPool().getConcurrency() < 2) {
+		return 0;
+	}
+	return kMinBandRows;
+}
+
+// Calls `body(first, last)` for bands of the rows [0, height).
+template<typename F>
+void processRowBands(uint grain, int height, const F &body) {
+	if (grain) {
+		g_system->getThreadPool().parallelFor(0, height, grain, body);
+	} else {
+		body(0, height);
+	}
+}
+
+// Computes the equality matrixes for `count` consecutive pixels of a row.
+// The loop is free of branches so that the compiler can vectorize it.
+void getEqualityMatrixes(const Color *row, int stride, int count, EqualityMatrix *matrixes) {
+	const Color *above = row - stride;
+	const Color *below = row + stride;
+	for (int x = 0; x < count; ++x) {
+		const Color pixel = row[x];
+		matrixes[x] = (EqualityMatrix)(
+			(row[x - 1] == pixel ? kEqualW : 0x00)
+			| (above[x - 1] == pixel ? kEqualNW : 0x00)
+			| (above[x] == pixel ? kEqualN : 0x00)
+			| (above[x + 1] == pixel ? kEqualNE : 0x00)
+			| (row[x + 1] == pixel ? kEqualE : 0x00)
+			| (below[x + 1] == pixel ? kEqualSE : 0x00)
+			| (below[x] == pixel ? kEqualS : 0x00)
+			| (below[x - 1] == pixel ? kEqualSW : 0x00));
+	}
+}
+
+// Computes the equality matrixes of all pixels, including those of the
+// innermost margin ring, so that isLinePixel() may look at the matrixes of
+// all neighbors of a pixel.
+MarginedBitmap<EqualityMatrix> createMarginedEqualityMatrixBitmap(const MarginedBitmap<Color> &src, uint grain) {
+	const int width = src.getWidth();
+	const int height = src.getHeight();
+	MarginedBitmap<EqualityMatrix> result(width, height, 0);
+	processRowBands(grain, height + 2, [&](uint first, uint last) {
+		for (int y = (int)first - 1; y < (int)last - 1; ++y) {
+			getEqualityMatrixes(src.getPointerTo(-1, y), src.getStride(), width + 2, result.getPointerTo(-1, y));
+		}
+	});
+	return result;
+}
+
+inline bool hasEqualities(EqualityMatrix matrix, EqualityMatrix mask) {
+	return (matrix & mask) == mask;
+}
+
+inline bool isLinePixel(const MarginedBitmap<EqualityMatrix> &matrixes, int x, int y) {
+	const EqualityMatrix matrix = matrixes.get(x, y);
 
 	// Single pixels are fills
-	if (!EQUALS(-1, -1) && !EQUALS(0, -1) && !EQUALS(1, -1) && !EQUALS(1, 0) && !EQUALS(1, 1) && !EQUALS(0, 1) && !EQUALS(-1, 1) && !EQUALS(-1, 0)) {
+	if (matrix == 0) {
 		return false;
 	}
 
 	// 2x2 blocks are fills
-	if (EQUALS(0, -1) && EQUALS(1, -1) && EQUALS(1, 0)) return false;
-	if (EQUALS(1, 0) && EQUALS(1, 1) && EQUALS(0, 1)) return false;
-	if (EQUALS(0, 1) && EQUALS(-1, 1) && EQUALS(-1, 0)) return false;
-	if (EQUALS(-1, 0) && EQUALS(-1, -1) && EQUALS(0, -1)) return false;
+	if (hasEqualities(matrix, kEqualN | kEqualNE | kEqualE)) return false;
+	if (hasEqualities(matrix, kEqualE | kEqualSE | kEqualS)) return false;
+	if (hasEqualities(matrix, kEqualS | kEqualSW | kEqualW)) return false;
+	if (hasEqualities(matrix, kEqualW | kEqualNW | kEqualN)) return false;
 
 	// A pixel adjacent to a 2x2 block is a fill.
-	if (EQUALS(-1, -1) && EQUALS(0, -1) && EQUALS(-1, -2) && EQUALS(0, -2)) return false;
-	if (EQUALS(0, -1) && EQUALS(1, -1) && EQUALS(0, -2) && EQUALS(1, -2)) return false;
-	if (EQUALS(1, -1) && EQUALS(1, 0) && EQUALS(2, -1) && EQUALS(2, 0)) return false;
-	if (EQUALS(1, 0) && EQUALS(1, 1) && EQUALS(2, 0) && EQUALS(2, 1)) return false;
-	if (EQUALS(1, 1) && EQUALS(0, 1) && EQUALS(1, 2) && EQUALS(0, 2)) return false;
-	if (EQUALS(0, 1) && EQUALS(-1, 1) && EQUALS(0, 2) && EQUALS(-1, 2)) return false;
-	if (EQUALS(-1, 1) && EQUALS(-1, 0) && EQUALS(-2, 1) && EQUALS(-2, 0)) return false;
-	if (EQUALS(-1, 0) && EQUALS(-1, -1) && EQUALS(-2, 0) && EQUALS(-2, -1)) return false;
+	// If the pixel equals its neighbor, the pixels two steps away equal the
+	// pixel exactly if they equal that neighbor, so its matrix tells.
+	const EqualityMatrix n = matrixes.get(x, y - 1);
+	const EqualityMatrix e = matrixes.get(x + 1, y);
+	const EqualityMatrix s = matrixes.get(x, y + 1);
+	const EqualityMatrix w = matrixes.get(x - 1, y);
+	if (hasEqualities(matrix, kEqualNW | kEqualN) && hasEqualities(n, kEqualNW | kEqualN)) return false;
+	if (hasEqualities(matrix, kEqualN | kEqualNE) && hasEqualities(n, kEqualN | kEqualNE)) return false;
+	if (hasEqualities(matrix, kEqualNE | kEqualE) && hasEqualities(e, kEqualNE | kEqualE)) return false;
+	if (hasEqualities(matrix, kEqualE | kEqualSE) && hasEqualities(e, kEqualE | kEqualSE)) return false;
+	if (hasEqualities(matrix, kEqualSE | kEqualS) && hasEqualities(s, kEqualSE | kEqualS)) return false;
+	if (hasEqualities(matrix, kEqualS | kEqualSW) && hasEqualities(s, kEqualS | kEqualSW)) return false;
+	if (hasEqualities(matrix, kEqualSW | kEqualW) && hasEqualities(w, kEqualSW | kEqualW)) return false;
+	if (hasEqualities(matrix, kEqualW | kEqualNW) && hasEqualities(w, kEqualW | kEqualNW)) return false;
 
 	// Everything else is part of a line
 	return true;
-
-#undef EQUALS
 }
 
-MarginedBitmap<bool> createMarginedLinePixelsBitmap(const MarginedBitmap<Color> &src) {
-	MarginedBitmap<bool> result(src.getWidth(), src.getHeight(), false);
-	for (int y = 0; y < src.getHeight(); ++y) {
-		for (int x = 0; x < src.getWidth(); ++x) {
-			result.set(x, y, isLinePixel(src, x, y));
+MarginedBitmap<bool> createMarginedLinePixelsBitmap(const MarginedBitmap<EqualityMatrix> &matrixes, uint grain) {
+	MarginedBitmap<bool> result(matrixes.getWidth(), matrixes.getHeight(), false);
+	processRowBands(grain, matrixes.getHeight(), [&](uint first, uint last) {
+		for (int y = first; y < (int)last; ++y) {
+			for (int x = 0; x < matrixes.getWidth(); ++x) {
+				result.set(x, y, isLinePixel(matrixes, x, y));
+			}
 		}
-	}
+	});
 	return result;
 }
 
@@ -200,6 +294,8 @@ void scaleDown(
 	assert(dstWidth > 0 && dstWidth <= src.getWidth());
 	assert(dstHeight > 0 && dstHeight <= src.getHeight());
 
+	const MarginedBitmap<EqualityMatrix> matrixes =
+		createMarginedEqualityMatrixBitmap(src, getBandGrain(src.getWidth(), src.getHeight()));
 	Common::Array<Color> dstRow(dstWidth);
 	for (int dstY = 0; dstY < dstHeight; ++dstY) {
 		const int srcY1 = dstY * src.getHeight() / dstHeight;
@@ -216,7 +312,7 @@ void scaleDown(
 				int linePixelCount = 0;
 				for (int srcY = srcY1; srcY < srcY2; ++srcY) {
 					for (int srcX = srcX1; srcX < srcX2; ++srcX) {
-						const bool colorIsFromLine = isLinePixel(src, srcX, srcY);
+						const bool colorIsFromLine = isLinePixel(matrixes, srcX, srcY);
 						if (colorIsFromLine) {
 							bestLineColor = src.get(srcX, srcY);
 							++linePixelCount;
@@ -254,36 +350,52 @@ void scaleDown(
 	}
 }
 
-// An equality matrix is a combination of eight Boolean flags indicating whether
-// each of the surrounding pixels has the same color as the central pixel.
-//
-// +------+------+------+
-// | 0x02 | 0x04 | 0x08 |
-// +------+------+------+
-// | 0x01 | Ref. | 0x10 |
-// +------+------+------+
-// | 0x80 | 0x40 | 0x20 |
-// +------+------+------+
-typedef byte EqualityMatrix;
-
-EqualityMatrix getEqualityMatrix(const Color *pixel, int stride) {
-#define EQUALS(x, y) (pixel[y * stride + x] == *pixel)
-
-	return (EQUALS(-1, 0) ? 0x01 : 0x00)
-		| (EQUALS(-1, -1) ? 0x02 : 0x00)
-		| (EQUALS(0, -1) ? 0x04 : 0x00)
-		| (EQUALS(1, -1) ? 0x08 : 0x00)
-		| (EQUALS(1, 0) ? 0x10 : 0x00)
-		| (EQUALS(1, 1) ? 0x20 : 0x00)
-		| (EQUALS(0, 1) ? 0x40 : 0x00)
-		| (EQUALS(-1, 1) ? 0x80 : 0x00);
-
-#undef EQUALS
-}
-
 // scapeUp() requires generated functions
 #include "larryScale_generated.cpp"
 
+// Scales one row of source pixels to one or two rows of target pixels
+void scaleUpRow(
+	const MarginedBitmap<Color> &src,
+	const MarginedBitmap<EqualityMatrix> &matrixes,
+	const MarginedBitmap<bool> &linePixels,
+	int srcY,
+	int dstWidth, int dstBlockHeight,
+	Color *topDstRow, Color *bottomDstRow
+) {
+	for (int srcX = 0; srcX < src.getWidth(); ++srcX) {
+		const int dstX1 = srcX * dstWidth / src.getWidth();
+		const int dstX2 = (srcX + 1) * dstWidth / src.getWidth();
+		const int dstBlockWidth = dstX2 - dstX1;
+		const EqualityMatrix matrix = matrixes.get(srcX, srcY);
+
+		if (dstBlockWidth == 1) {
+			if (dstBlockHeight == 1) {
+				// 1x1
+				topDstRow[dstX1] = src.get(srcX, srcY);
+			} else {
+				// 1x2
+				Color &top = topDstRow[dstX1];
+				Color &bottom = bottomDstRow[dstX1];
+				scalePixelTo1x2(src, linePixels, srcX, srcY, matrix, top, bottom);
+			}
+		} else {
+			if (dstBlockHeight == 1) {
+				// 2x1
+				Color &left = topDstRow[dstX1];
+				Color &right = topDstRow[dstX1 + 1];
+				scalePixelTo2x1(src, linePixels, srcX, srcY, matrix, left, right);
+			} else {
+				// 2x2
+				Color &topLeft = topDstRow[dstX1];
+				Color &topRight = topDstRow[dstX1 + 1];
+				Color &bottomLeft = bottomDstRow[dstX1];
+				Color &bottomRight = bottomDstRow[dstX1 + 1];
+				scalePixelTo2x2(src, linePixels, srcX, srcY, matrix, topLeft, topRight, bottomLeft, bottomRight);
+			}
+		}
+	}
+}
+
 void scaleUp(
 	const MarginedBitmap<Color> &src,
 	int dstWidth, int dstHeight,
@@ -297,45 +409,37 @@ void scaleUp(
 	assert(dstWidth >= srcWidth && dstWidth <= 2 * src.getWidth());
 	assert(dstHeight >= srcHeight && dstHeight <= 2 * src.getHeight());
 
-	const MarginedBitmap<bool> linePixels = createMarginedLinePixelsBitmap(src);
+	const uint grain = getBandGrain(srcWidth, srcHeight);
+	const MarginedBitmap<EqualityMatrix> matrixes = createMarginedEqualityMatrixBitmap(src, grain);
+	const MarginedBitmap<bool> linePixels = createMarginedLinePixelsBitmap(matrixes, grain);
+
+	if (grain) {
+		// Scale bands of rows concurrently into a buffer, then hand the rows
+		// to the writer in order since it needn't be thread-safe
+		Common::Array<Color> dst(dstWidth * dstHeight);
+		processRowBands(grain, srcHeight, [&](uint first, uint last) {
+			for (int srcY = first; srcY < (int)last; ++srcY) {
+				const int dstY1 = srcY * dstHeight / srcHeight;
+				const int dstY2 = (srcY + 1) * dstHeight / srcHeight;
+				Color *topDstRow = dst.data() + dstY1 * dstWidth;
+				Color *bottomDstRow = (dstY2 - dstY1 == 2) ? topDstRow + dstWidth : topDstRow;
+				scaleUpRow(src, matrixes, linePixels, srcY, dstWidth, dstY2 - dstY1, topDstRow, bottomDstRow);
+			}
+		});
+		for (int dstY = 0; dstY < dstHeight; ++dstY) {
+			rowWriter.writeRow(dstY, dst.data() + dstY * dstWidth);
+		}
+		return;
+	}
+
 	Common::Array<Color> topDstRow(dstWidth);
 	Common::Array<Color> bottomDstRow(dstWidth);
-	for (int srcY = 0; srcY < src.getHeight(); ++srcY) {
-		const int dstY1 = srcY * dstHeight / src.getHeight();
-		const int dstY2 = (srcY + 1) * dstHeight / src.getHeight();
+	for (int srcY = 0; srcY < srcHeight; ++srcY) {
+		const int dstY1 = srcY * dstHeight / srcHeight;
+		const int dstY2 = (srcY + 1) * dstHeight / srcHeight;
 		const int dstBlockHeight = dstY2 - dstY1;
 
-		for (int srcX = 0; srcX < src.getWidth(); ++srcX) {
-			const int dstX1 = srcX * dstWidth / src.getWidth();
-			const int dstX2 = (srcX + 1) * dstWidth / src.getWidth();
-			const int dstBlockWidth = dstX2 - dstX1;
-
-			if (dstBlockWidth == 1) {
-				if (dstBlockHeight == 1) {
-					// 1x1
-					topDstRow[dstX1] = src.get(srcX, srcY);
-				} else {
-					// 1x2
-					Color &top = topDstRow[dstX1];
-					Color &bottom = bottomDstRow[dstX1];
-					scalePixelTo1x2(src, linePixels, srcX, srcY, top, bottom);
-				}
-			} else {
-				if (dstBlockHeight == 1) {
-					// 2x1
-					Color &left = topDstRow[dstX1];
-					Color &right = topDstRow[dstX1 + 1];
-					scalePixelTo2x1(src, linePixels, srcX, srcY, left, right);
-				} else {
-					// 2x2
-					Color &topLeft = topDstRow[dstX1];
-					Color &topRight = topDstRow[dstX1 + 1];
-					Color &bottomLeft = bottomDstRow[dstX1];
-					Color &bottomRight = bottomDstRow[dstX1 + 1];
-					scalePixelTo2x2(src, linePixels, srcX, srcY, topLeft, topRight, bottomLeft, bottomRight);
-				}
-			}
-		}
+		scaleUpRow(src, matrixes, linePixels, srcY, dstWidth, dstBlockHeight, topDstRow.data(), bottomDstRow.data());
 		rowWriter.writeRow(dstY1, topDstRow.data());
 		if (dstBlockHeight == 2) {
 			rowWriter.writeRow(dstY1 + 1, bottomDstRow.data());
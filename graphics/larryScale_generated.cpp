@@ -26,11 +26,11 @@ inline void scalePixelTo2x2(
 	const MarginedBitmap<Color> &src,
 	const MarginedBitmap<bool> &linePixels,
 	int x, int y,
+	EqualityMatrix matrix,
 	// Out parameters
 	Color &topLeft, Color &topRight, Color &bottomLeft, Color &bottomRight
 ) {
 	const Color pixel = src.get(x, y);
-	const EqualityMatrix matrix = getEqualityMatrix(src.getPointerTo(x, y), src.getStride());
 
 	// Note: There is a case label for every possible value, so we don't need a default label, but one is added to avoid any compiler warnings.
 	switch (matrix) {
@@ -393,11 +393,11 @@ inline void scalePixelTo2x1(
 	const MarginedBitmap<Color> &src,
 	const MarginedBitmap<bool> &linePixels,
 	int x, int y,
+	EqualityMatrix matrix,
 	// Out parameters
 	Color &left, Color &right
 ) {
 	const Color pixel = src.get(x, y);
-	const EqualityMatrix matrix = getEqualityMatrix(src.getPointerTo(x, y), src.getStride());
 
 	// Note: There is a case label for every possible value, so we don't need a default label, but one is added to avoid any compiler warnings.
 	switch (matrix) {
@@ -508,11 +508,11 @@ inline void scalePixelTo1x2(
 	const MarginedBitmap<Color> &src,
 	const MarginedBitmap<bool> &linePixels,
 	int x, int y,
+	EqualityMatrix matrix,
 	// Out parameters
 	Color &top, Color &bottom
 ) {
 	const Color pixel = src.get(x, y);
-	const EqualityMatrix matrix = getEqualityMatrix(src.getPointerTo(x, y), src.getStride());
 
 	// Note: There is a case label for every possible value, so we don't need a default label, but one is added to avoid any compiler warnings.
 	switch (matrix) {
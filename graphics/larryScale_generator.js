@@ -350,10 +350,9 @@ function generateScalePixelFunction(width, height, pixelRecords) {
 		.map((pixelRecord, index) => `Color &${pixelRecord.param}`)
 		.join(', ');
 	const header =
-		`inline void scalePixelTo${width}x${height}(\n\tconst MarginedBitmap<Color> &src,\n\tconst MarginedBitmap<bool> &linePixels,\n\tint x, int y,\n\t// Out parameters\n\t${params}\n)`;
+		`inline void scalePixelTo${width}x${height}(\n\tconst MarginedBitmap<Color> &src,\n\tconst MarginedBitmap<bool> &linePixels,\n\tint x, int y,\n\tEqualityMatrix matrix,\n\t// Out parameters\n\t${params}\n)`;
 	const prefix =
-		'const Color pixel = src.get(x, y);\n'
-		+ 'const EqualityMatrix matrix = getEqualityMatrix(src.getPointerTo(x, y), src.getStride());';
+		'const Color pixel = src.get(x, y);';
 	const switchBlock = generateSwitchBlock('matrix', matrix => {
 		const pixelType = getPixelType(matrix);
 		switch (pixelType) {
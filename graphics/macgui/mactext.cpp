@@ -251,7 +251,6 @@ void MacText::init() {
 	reallocSurface();
 	setAlignOffset(_textAlignment);
 	updateCursorPos();
-	render();
 }
 
 MacText::~MacText() {
@@ -296,6 +295,23 @@ void MacText::setMaxWidth(int maxWidth) {
 		return;
 	}
 
+	// Widening the text cannot add line breaks, so if no paragraph
+	// was wrapped, the lines stay as they are
+	bool wrapped = false;
+	for (uint i = 0; i + 1 < _textLines.size() && !wrapped; i++)
+		wrapped = !_textLines[i].paragraphEnd;
+
+	if (maxWidth > _maxWidth && !wrapped) {
+		_maxWidth = maxWidth;
+		_selectedText.endY = -1;
+
+		updateCursorPos();
+
+		_fullRefresh = true;
+		_contentIsDirty = true;
+		return;
+	}
+
 	Common::U32String str = getTextChunk(0, 0, -1, -1, true, true);
 
 	// keep the cursor pos
@@ -336,7 +352,6 @@ void MacText::setColors(uint32 fg, uint32 bg) {
 		setTextColor(fg, i);
 
 	_fullRefresh = true;
-	render();
 	_contentIsDirty = true;
 }
 
@@ -348,7 +363,6 @@ void MacText::enforceTextFont(uint16 fontId) {
 	}
 
 	_fullRefresh = true;
-	render();
 	_contentIsDirty = true;
 }
 
@@ -360,7 +374,6 @@ void MacText::setTextSize(int textSize) {
 	}
 
 	_fullRefresh = true;
-	render();
 	_contentIsDirty = true;
 }
 
@@ -374,6 +387,7 @@ void MacText::setTextColor(uint32 color, uint32 line) {
 	for (uint j = 0; j < _textLines[line].chunks.size(); j++) {
 		_textLines[line].chunks[j].fgcolor = fgcol;
 	}
+	_textLines[line].dirty = true;
 
 	// if we are calling this func separately, then here need a refresh
 }
@@ -464,10 +478,12 @@ void MacText::setTextChunks(int start, int end, int param, void (*callback)(MacF
 		for (uint j = from; j < to; j++) {
 			callback(_textLines[i].chunks[j], param);
 		}
+		_textLines[i].dirty = true;
 	}
 
-	_fullRefresh = true;
-	render();
+	// A color change keeps the layout, so redrawing the touched lines is enough
+	if (callback != setTextColorCallback)
+		_fullRefresh = true;
 	_contentIsDirty = true;
 }
 
@@ -499,7 +515,6 @@ void MacText::enforceTextSlant(int textSlant) {
 	}
 
 	_fullRefresh = true;
-	render();
 	_contentIsDirty = true;
 }
 
@@ -904,15 +919,40 @@ void MacText::reallocSurface() {
 }
 
 void MacText::render() {
+	renderDirty(0, _textMaxHeight);
+}
+
+void MacText::renderDirty(int top, int bottom) {
 	if (_fullRefresh) {
+		reallocSurface();
 		_surface->clear(_bgcolor);
 		if (_textShadow)
 			_shadowSurface->clear(_bgcolor);
 
-		render(0, _textLines.size());
+		for (uint i = 0; i < _textLines.size(); i++)
+			_textLines[i].dirty = true;
 
 		_fullRefresh = false;
 	}
+
+	// Render each run of consecutive dirty lines in one go
+	int first = -1;
+	for (int i = 0; i <= (int)_textLines.size(); i++) {
+		bool needed = false;
+		if (i < (int)_textLines.size() && _textLines[i].dirty) {
+			int y = _textLines[i].y;
+			needed = y < bottom && y + MAX(getLineHeight(i), _interLinear) > top;
+		}
+
+		if (needed) {
+			_textLines[i].dirty = false;
+			if (first == -1)
+				first = i;
+		} else if (first != -1) {
+			render(first, i - 1);
+			first = -1;
+		}
+	}
 }
 
 void MacText::render(int from, int to, int shadow) {
@@ -983,7 +1023,7 @@ void MacText::render(int from, int to) {
 	to = MIN<int>(to, _textLines.size() - 1);
 
 	// Clear the screen
-	_surface->fillRect(Common::Rect(0, _textLines[from].y, _surface->w, _textLines[to].y + getLineHeight(to)), _bgcolor);
+	_surface->fillRect(Common::Rect(0, _textLines[from].y, _surface->w, _textLines[to].y + MAX(getLineHeight(to), _interLinear)), _bgcolor);
 
 	// render the shadow surface;
 	if (_textShadow)
@@ -1087,11 +1127,10 @@ void MacText::setInterLinear(int interLinear) {
 
 	recalcDims();
 	_fullRefresh = true;
-	render();
 	_contentIsDirty = true;
 }
 
-void MacText::recalcDims() {
+void MacText::recalcDims(int from) {
 	if (_textLines.empty())
 		return;
 
@@ -1099,14 +1138,24 @@ void MacText::recalcDims() {
 	_textMaxWidth = 0;
 
 	for (uint i = 0; i < _textLines.size(); i++) {
-		_textLines[i].y = y;
+		if (_textLines[i].y != y) {
+			_textLines[i].y = y;
+			_textLines[i].dirty = true;
+		}
 
 		// We must calculate width first, because it enforces
 		// the computation. Calling Height() will return cached value!
-		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, true));
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, (int)i >= from));
 		y += MAX(getLineHeight(i), _interLinear);
 	}
 
+	// Clear whatever the removed lines left behind
+	if (y < _textMaxHeight && _surface) {
+		_surface->fillRect(Common::Rect(0, y, _surface->w, _textMaxHeight), _bgcolor);
+		if (_textShadow)
+			_shadowSurface->fillRect(Common::Rect(0, y, _shadowSurface->w, _textMaxHeight), _bgcolor);
+	}
+
 	_textMaxHeight = y;
 
 	if (!_fixedDims) {
@@ -1116,10 +1165,6 @@ void MacText::recalcDims() {
 			delete _composeSurface;
 			_composeSurface = new ManagedSurface(_dims.width(), _dims.height(), _wm->_pixelformat);
 			reallocSurface();
-			if (!_fullRefresh) {
-				_fullRefresh = true;
-				render();
-			}
 			_fullRefresh = true;
 			_contentIsDirty = true;
 		}
@@ -1258,10 +1303,10 @@ void MacText::appendText(const Common::U32String &str, const Font *font, uint16
 }
 
 void MacText::appendText_(const Common::U32String &strWithFont, uint oldLen) {
-	splitString(strWithFont);
-	recalcDims();
+	int from = MAX<int>(0, MIN<int>(oldLen, _textLines.size()) - 1);
 
-	render(oldLen - 1, _textLines.size());
+	splitString(strWithFont);
+	recalcDims(from);
 
 	_contentIsDirty = true;
 
@@ -1285,9 +1330,7 @@ void MacText::appendTextDefault(const Common::U32String &str, bool skipAdd) {
 		_str += strWithFont;
 	}
 	splitString(strWithFont);
-	recalcDims();
-
-	render(oldLen - 1, _textLines.size());
+	recalcDims(MAX<int>(0, oldLen - 1));
 }
 
 void MacText::appendTextDefault(const Common::String &str, bool skipAdd) {
@@ -1324,7 +1367,8 @@ void MacText::draw(ManagedSurface *g, int x, int y, int w, int h, int xoff, int
 	if (_textLines.empty())
 		return;
 
-	render();
+	// Only the part that ends up on the target needs to be up to date
+	renderDirty(y, y + MIN(h, g->h - yoff));
 
 	if (x + w < _surface->w || y + h < _surface->h)
 		g->fillRect(Common::Rect(x + xoff, y + yoff, x + w + xoff, y + h + yoff), _bgcolor);
@@ -1402,7 +1446,7 @@ void MacText::drawToPoint(ManagedSurface *g, Common::Rect srcRect, Common::Point
 	if (_textLines.empty())
 		return;
 
-	render();
+	renderDirty(srcRect.top, srcRect.bottom);
 
 	srcRect.clip(_surface->getBounds());
 
@@ -2254,10 +2298,12 @@ void MacText::insertTextFromClipboard() {
 	int ppos = 0;
 	Common::U32String str = _wm->getTextFromClipboard(Common::U32String(_defaultFormatting.toString()), &ppos);
 
+	int start = 0;
 	if (_textLines.empty()) {
 		splitString(str, 0);
 	} else {
-		int start = _cursorRow, end = _cursorRow;
+		int end = _cursorRow;
+		start = _cursorRow;
 
 		while (start && !_textLines[start - 1].paragraphEnd)
 			start--;
@@ -2286,10 +2332,8 @@ void MacText::insertTextFromClipboard() {
 		_cursorRow++;
 	}
 	_cursorCol = ppos;
-	recalcDims();
+	recalcDims(start);
 	updateCursorPos();
-	_fullRefresh = true;
-	render();
 }
 
 void MacText::setText(const Common::U32String &str) {
@@ -2301,7 +2345,6 @@ void MacText::setText(const Common::U32String &str) {
 	recalcDims();
 	updateCursorPos();
 	_fullRefresh = true;
-	render();
 
 	if (_selectable) {
 		setSelection(_selStart, true);
@@ -2340,13 +2383,10 @@ void MacText::insertChar(byte c, int *row, int *col) {
 	(*col)++;
 
 	if (getLineWidth(*row) - oldw + chunkw > _maxWidth) { // Needs reshuffle
-		reshuffleParagraph(row, col);
-		_fullRefresh = true;
-		recalcDims();
-		render();
+		recalcDims(reshuffleParagraph(row, col));
 	} else {
-		recalcDims();
-		render(*row, *row);
+		line->dirty = true;
+		recalcDims(*row);
 	}
 	for (int i = 0; i < (int)_textLines.size(); i++) {
 		D(9, "**insertChar line %d isEnd %d", i, _textLines[i].paragraphEnd);
@@ -2380,11 +2420,7 @@ void MacText::deleteSelection() {
 		deletePreviousCharInternal(&row, &col);
 	}
 
-	reshuffleParagraph(&row, &col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	recalcDims(reshuffleParagraph(&row, &col));
 
 	// update cursor position
 	_cursorRow = row;
@@ -2440,11 +2476,7 @@ void MacText::deletePreviousChar(int *row, int *col) {
 	}
 	D(9, "**deleteChar cursor row %d col %d", _cursorRow, _cursorCol);
 
-	reshuffleParagraph(row, col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	recalcDims(reshuffleParagraph(row, col));
 }
 
 void MacText::addNewLine(int *row, int *col) {
@@ -2476,8 +2508,10 @@ void MacText::addNewLine(int *row, int *col) {
 		line->chunks.pop_back();
 	}
 	line->width = -1; // Drop cache
+	line->dirty = true;
 
 	_textLines[*row].width = -1; // flush the cache
+	int splitRow = *row;
 
 	_textLines.insert_at(*row + 1, newline);
 
@@ -2494,12 +2528,10 @@ void MacText::addNewLine(int *row, int *col) {
 	}
 	D(9, "** addNewLine cursor row %d col %d", _cursorRow, _cursorCol);
 
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	recalcDims(splitRow);
 }
 
-void MacText::reshuffleParagraph(int *row, int *col) {
+int MacText::reshuffleParagraph(int *row, int *col) {
 	// First, we looking for the paragraph start and end
 	int start = *row, end = *row;
 
@@ -2537,6 +2569,8 @@ void MacText::reshuffleParagraph(int *row, int *col) {
 		(*row)++;
 	}
 	*col = ppos;
+
+	return start;
 }
 
 //////////////////
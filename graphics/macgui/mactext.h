@@ -114,6 +114,7 @@ struct MacTextLine {
 	int y;
 	int charwidth;
 	bool paragraphEnd;
+	bool dirty; ///< The line needs to be rendered again
 
 	Common::Array<MacFontRun> chunks;
 
@@ -121,6 +122,7 @@ struct MacTextLine {
 		width = height = charwidth = -1;
 		y = 0;
 		paragraphEnd = false;
+		dirty = true;
 	}
 
 	MacFontRun &firstChunk() { return chunks[0]; }
@@ -179,7 +181,7 @@ public:
 	void drawToPoint(ManagedSurface *g, Common::Rect srcRect, Common::Point dstPoint);
 	void drawToPoint(ManagedSurface *g, Common::Point dstPoint);
 
-	Graphics::ManagedSurface *getSurface() { return _surface; }
+	Graphics::ManagedSurface *getSurface() { render(); return _surface; }
 	int getInterLinear() { return _interLinear; }
 	void setInterLinear(int interLinear);
 	void setMaxWidth(int maxWidth);
@@ -309,14 +311,28 @@ private:
 	 * Rewraps paragraph containing given text row.
 	 * When text is modified, we redo whole thing again without touching
 	 * other paragraphs. Also, cursor position is returned in the arguments
+	 *
+	 * @return the first row of the paragraph
 	 */
-	void reshuffleParagraph(int *row, int *col);
+	int reshuffleParagraph(int *row, int *col);
 
 	void chopChunk(const Common::U32String &str, int *curLine);
 	void splitString(const Common::U32String &str, int curLine = -1);
 	void render(int from, int to, int shadow);
 	void render(int from, int to);
-	void recalcDims();
+
+	/**
+	 * Render the dirty lines which overlap the vertical range [top, bottom)
+	 * of the text surface. Other lines stay dirty until they are needed.
+	 */
+	void renderDirty(int top, int bottom);
+
+	/**
+	 * Recompute line positions and text dimensions. Only the lines starting
+	 * at @p from are measured again, the earlier ones must be unchanged.
+	 * Lines that move are marked dirty.
+	 */
+	void recalcDims(int from = 0);
 	void reallocSurface();
 
 	void drawSelection(int xoff, int yoff);
@@ -602,24 +602,61 @@ void MacWindow::markAllDirty() {
 	_dirtyRects.push_back(Common::Rect(_composeSurface->w, _composeSurface->h));
 }
 
-void MacWindow::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
+static uint findDirtyRectSet(Common::Array<uint> &parent, uint i) {
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
 
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+void MacWindow::mergeDirtyRects() {
+	// Group the overlapping rects into sets with a union-find, and replace
+	// each set with its bounding box. The bounding boxes of different sets
+	// may overlap again, so repeat until no rects overlap anymore.
+	Common::Array<Common::Rect> rects;
+	Common::Array<uint> parent;
+	bool merged = true;
+
+	while (merged && _dirtyRects.size() > 1) {
+		merged = false;
+
+		rects.clear();
+		for (Common::List<Common::Rect>::iterator r = _dirtyRects.begin(); r != _dirtyRects.end(); ++r)
+			rects.push_back(*r);
+
+		const uint numRects = rects.size();
+		parent.resize(numRects);
+		for (uint i = 0; i < numRects; i++)
+			parent[i] = i;
+
+		for (uint i = 0; i < numRects; i++) {
+			for (uint j = i + 1; j < numRects; j++) {
+				if (!rects[i].intersects(rects[j]))
+					continue;
+
+				uint a = findDirtyRectSet(parent, i);
+				uint b = findDirtyRectSet(parent, j);
+				if (a != b) {
+					parent[MAX(a, b)] = MIN(a, b);
+					merged = true;
+				}
+			}
+		}
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				rOuter->extend(*rInner);
+		if (!merged)
+			break;
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+		for (uint i = 0; i < numRects; i++) {
+			uint root = findDirtyRectSet(parent, i);
+			if (root != i)
+				rects[root].extend(rects[i]);
+		}
 
-				// move back to beginning of list
-				rInner = rOuter;
-			}
+		_dirtyRects.clear();
+		for (uint i = 0; i < numRects; i++) {
+			if (parent[i] == i)
+				_dirtyRects.push_back(rects[i]);
 		}
 	}
 }
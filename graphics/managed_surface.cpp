@@ -20,6 +20,7 @@
  */
 
 #include "graphics/managed_surface.h"
+#include "graphics/blit-simd.h"
 #include "common/algorithm.h"
 #include "common/textconsole.h"
 #include "common/endian.h"
@@ -608,60 +609,58 @@ void transBlitPixel<byte, byte>(byte srcVal, byte &destVal, const Graphics::Pixe
 		destVal = lookup[destVal];
 }
 
-template<typename TSRC, typename TDEST>
-void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
-		TSRC transColor, bool flipped, uint32 overrideColor, uint32 srcAlpha, const byte *srcPalette,
-		const byte *dstPalette, const Surface *mask, bool maskOnly) {
-	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
-	int scaleY = SCALE_THRESHOLD * srcRect.height() / destRect.height();
+/**
+ * The generic blitting loop. Scaling, flipping and masking are resolved at
+ * compile time, so that the per pixel work only contains what the call needs.
+ */
+template<typename TSRC, typename TDEST, bool SCALED, bool FLIPPED, bool MASKED>
+void transBlitGeneric(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
+		TSRC transColor, uint32 overrideColor, uint32 srcAlpha, const byte *srcPalette, const byte *lookup,
+		const Surface *mask, bool maskOnly) {
+	const int scaleX = SCALED ? SCALE_THRESHOLD * srcRect.width() / destRect.width() : SCALE_THRESHOLD;
+	const int scaleY = SCALED ? SCALE_THRESHOLD * srcRect.height() / destRect.height() : SCALE_THRESHOLD;
 	byte rst = 0, gst = 0, bst = 0, rdt = 0, gdt = 0, bdt = 0;
 	byte r = 0, g = 0, b = 0;
 
-	byte *lookup = nullptr;
-	if (srcPalette && dstPalette)
-		lookup = createPaletteLookup(srcPalette, dstPalette);
-
 	// If we're dealing with a 32-bit source surface, we need to split up the RGB,
 	// since we'll want to find matching RGB pixels irrespective of the alpha
-	bool isSrcTrans32 = src.format.aBits() != 0 && transColor != (uint32)-1 && transColor > 0;
+	const bool isSrcTrans32 = src.format.aBits() != 0 && transColor != (uint32)-1 && transColor > 0;
 	if (isSrcTrans32) {
 		src.format.colorToRGB(transColor, rst, gst, bst);
 	}
-	bool isDestTrans32 = dest.format.aBits() != 0 && dest.hasTransparentColor();
+	const bool isDestTrans32 = dest.format.aBits() != 0 && dest.hasTransparentColor();
 	if (isDestTrans32) {
 		dest.format.colorToRGB(dest.getTransparentColor(), rdt, gdt, bdt);
 	}
+	const bool hasDestTrans = dest.hasTransparentColor();
+	const uint32 destTransColor = dest.getTransparentColor();
 
-	// Loop through drawing output lines
-	for (int destY = destRect.top, scaleYCtr = 0; destY < destRect.bottom; ++destY, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= dest.h)
-			continue;
-		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
-		const TSRC *mskLine = nullptr;
-
-		if (mask)
-			mskLine = (const TSRC *)mask->getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
+	// Only visit the part of the destination rectangle inside the surface
+	const int top = MAX<int>(destRect.top, 0), bottom = MIN<int>(destRect.bottom, dest.h);
+	const int left = MAX<int>(destRect.left, 0), right = MIN<int>(destRect.right, dest.w);
 
+	// Loop through drawing output lines
+	for (int destY = top; destY < bottom; ++destY) {
+		const int srcY = (SCALED ? (destY - destRect.top) * scaleY / SCALE_THRESHOLD : destY - destRect.top) + srcRect.top;
+		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left, srcY);
+		const TSRC *mskLine = MASKED ? (const TSRC *)mask->getBasePtr(srcRect.left, srcY) : nullptr;
 		TDEST *destLine = (TDEST *)dest.getBasePtr(destRect.left, destY);
 
 		// Loop through drawing the pixels of the row
-		for (int destX = destRect.left, xCtr = 0, scaleXCtr = 0; destX < destRect.right; ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= dest.w)
-				continue;
-
-			TSRC srcVal = srcLine[flipped ? src.w - scaleXCtr / SCALE_THRESHOLD - 1 : scaleXCtr / SCALE_THRESHOLD];
+		for (int xCtr = left - destRect.left; xCtr < right - destRect.left; ++xCtr) {
+			const int srcX = SCALED ? xCtr * scaleX / SCALE_THRESHOLD : xCtr;
+			const int srcIdx = FLIPPED ? src.w - srcX - 1 : srcX;
+			const TSRC srcVal = srcLine[srcIdx];
 			TDEST &destVal = destLine[xCtr];
 
-			dest.format.colorToRGB(destVal, r, g, b);
-
 			// Check if dest pixel is transparent
 			bool isDestPixelTrans = false;
 			if (isDestTrans32) {
 				dest.format.colorToRGB(destVal, r, g, b);
 				if (rdt == r && gdt == g && bdt == b)
 					isDestPixelTrans = true;
-			} else if (dest.hasTransparentColor()) {
-				isDestPixelTrans = destVal == dest.getTransparentColor();
+			} else if (hasDestTrans) {
+				isDestPixelTrans = destVal == destTransColor;
 			}
 
 			if (isSrcTrans32 && !maskOnly) {
@@ -672,25 +671,132 @@ void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &
 			} else if (srcVal == transColor && !maskOnly)
 				continue;
 
-			if (mask) {
-				TSRC mskVal = mskLine[flipped ? src.w - scaleXCtr / SCALE_THRESHOLD - 1 : scaleXCtr / SCALE_THRESHOLD];
+			uint32 alpha = srcAlpha;
+			if (MASKED) {
+				const TSRC mskVal = mskLine[srcIdx];
 				if (!mskVal)
 					continue;
+				alpha = mskVal;
+			}
 
-				if (isDestPixelTrans)
-					// Remove transparent color on dest so it isn't alpha blended
-					destVal = 0;
+			if (isDestPixelTrans)
+				// Remove transparent color on dest so it isn't alpha blended
+				destVal = 0;
 
-				transBlitPixel<TSRC, TDEST>(srcVal, destVal, src.format, dest.format, overrideColor, mskVal, srcPalette, lookup);
-			} else {
-				if (isDestPixelTrans)
-					// Remove transparent color on dest so it isn't alpha blended
-					destVal = 0;
+			transBlitPixel<TSRC, TDEST>(srcVal, destVal, src.format, dest.format, overrideColor, alpha, srcPalette, lookup);
+		}
+	}
+}
+
+template<typename TSRC, typename TDEST, bool SCALED>
+void transBlitGeneric(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
+		TSRC transColor, bool flipped, uint32 overrideColor, uint32 srcAlpha, const byte *srcPalette, const byte *lookup,
+		const Surface *mask, bool maskOnly) {
+	if (flipped) {
+		if (mask)
+			transBlitGeneric<TSRC, TDEST, SCALED, true, true>(src, srcRect, dest, destRect, transColor, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
+		else
+			transBlitGeneric<TSRC, TDEST, SCALED, true, false>(src, srcRect, dest, destRect, transColor, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
+	} else {
+		if (mask)
+			transBlitGeneric<TSRC, TDEST, SCALED, false, true>(src, srcRect, dest, destRect, transColor, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
+		else
+			transBlitGeneric<TSRC, TDEST, SCALED, false, false>(src, srcRect, dest, destRect, transColor, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
+	}
+}
 
-				transBlitPixel<TSRC, TDEST>(srcVal, destVal, src.format, dest.format, overrideColor, srcAlpha, srcPalette, lookup);
+/**
+ * Unscaled, unflipped and unmasked color keyed blit, where every source
+ * pixel that is drawn is replaced by the same destination value. For
+ * paletted sources @p colorMap gives that value for each index, otherwise
+ * the source pixel is copied as it is.
+ */
+template<typename TSRC, typename TDEST>
+void transBlitKeyed(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
+		TSRC transColor, const TDEST *colorMap) {
+	Common::Rect drawRect(destRect);
+	drawRect.clip(Common::Rect(dest.w, dest.h));
+	if (drawRect.isEmpty())
+		return;
+
+	const int srcX = srcRect.left + drawRect.left - destRect.left;
+	const int srcY = srcRect.top + drawRect.top - destRect.top;
+	const uint width = drawRect.width();
+
+	const KeyBlitRowProc keyBlitRow = colorMap ? nullptr : getKeyBlitRowProc(sizeof(TSRC));
+
+	for (int y = 0; y < drawRect.height(); ++y) {
+		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcX, srcY + y);
+		TDEST *destLine = (TDEST *)dest.getBasePtr(drawRect.left, drawRect.top + y);
+
+		if (keyBlitRow) {
+			keyBlitRow((byte *)destLine, (const byte *)srcLine, width, transColor);
+		} else if (colorMap) {
+			for (uint x = 0; x < width; ++x) {
+				if (srcLine[x] != transColor)
+					destLine[x] = colorMap[srcLine[x]];
+			}
+		} else {
+			for (uint x = 0; x < width; ++x) {
+				if (srcLine[x] != transColor)
+					destLine[x] = srcLine[x];
 			}
 		}
 	}
+}
+
+template<typename TSRC, typename TDEST>
+void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
+		TSRC transColor, bool flipped, uint32 overrideColor, uint32 srcAlpha, const byte *srcPalette,
+		const byte *dstPalette, const Surface *mask, bool maskOnly) {
+	byte *lookup = nullptr;
+	if (srcPalette && dstPalette)
+		lookup = createPaletteLookup(srcPalette, dstPalette);
+
+	const bool scaled = srcRect.width() != destRect.width() || srcRect.height() != destRect.height();
+
+	// Most sprites are drawn unscaled with just a transparent color, which
+	// turns the pixel loop into a plain masked copy. The cases below leave
+	// the destination exactly as transBlitPixel() would.
+	if (!scaled && !flipped && !mask && !maskOnly) {
+		if (sizeof(TSRC) == 1 && sizeof(TDEST) == 1 && srcAlpha != 0) {
+			if (!lookup && !overrideColor) {
+				transBlitKeyed<TSRC, TDEST>(src, srcRect, dest, destRect, transColor, nullptr);
+			} else {
+				TDEST colorMap[256];
+				for (int i = 0; i < 256; ++i) {
+					const byte color = overrideColor ? overrideColor : i;
+					colorMap[i] = lookup ? lookup[color] : color;
+				}
+				transBlitKeyed<TSRC, TDEST>(src, srcRect, dest, destRect, transColor, colorMap);
+			}
+			delete[] lookup;
+			return;
+		}
+
+		if (sizeof(TSRC) == 1 && src.format.isCLUT8() && srcPalette && srcAlpha == 0xff) {
+			TDEST colorMap[256];
+			for (int i = 0; i < 256; ++i)
+				colorMap[i] = dest.format.ARGBToColor(0xff, srcPalette[i * 3 + 0], srcPalette[i * 3 + 1], srcPalette[i * 3 + 2]);
+			transBlitKeyed<TSRC, TDEST>(src, srcRect, dest, destRect, transColor, colorMap);
+			delete[] lookup;
+			return;
+		}
+
+		// Decoding and encoding an opaque pixel of a format that uses all its
+		// bits for color gives back the same pixel
+		if (sizeof(TSRC) == 2 && sizeof(TDEST) == 2 && src.format == dest.format && srcAlpha == 0xff &&
+				src.format.aBits() == 0 && src.format.RGBToColor(0xff, 0xff, 0xff) == 0xffff) {
+			transBlitKeyed<TSRC, TDEST>(src, srcRect, dest, destRect, transColor, nullptr);
+			delete[] lookup;
+			return;
+		}
+	}
+
+	if (scaled)
+		transBlitGeneric<TSRC, TDEST, true>(src, srcRect, dest, destRect, transColor, flipped, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
+	else
+		transBlitGeneric<TSRC, TDEST, false>(src, srcRect, dest, destRect, transColor, flipped, overrideColor, srcAlpha, srcPalette, lookup, mask, maskOnly);
 
 	delete[] lookup;
 }
@@ -13,11 +13,13 @@ MODULE_OBJS := \
 	fonts/consolefont.o \
 	fonts/dosfont.o \
 	fonts/freetype.o \
+	fonts/glyph_atlas.o \
 	fonts/macfont.o \
 	fonts/newfont_big.o \
 	fonts/newfont.o \
 	fonts/ttf.o \
 	fonts/winfont.o \
+	frame_pool.o \
 	framelimiter.o \
 	korfont.o \
 	larryScale.o \
@@ -43,6 +45,7 @@ MODULE_OBJS := \
 	pixelformat.o \
 	pm5544.o \
 	primitives.o \
+	region.o \
 	renderer.o \
 	scalerplugin.o \
 	scaler/downscaler.o \
@@ -56,8 +59,10 @@ MODULE_OBJS := \
 	transform_tools.o \
 	transparent_surface.o \
 	thumbnail.o \
+	tile-diff.o \
 	VectorRenderer.o \
 	VectorRendererSpec.o \
+	VectorRendererSpec-simd.o \
 	wincursor.o \
 	yuv_to_rgb.o
 
@@ -71,6 +76,31 @@ MODULE_OBJS += \
 	blit-atari.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	blit-sse2.o \
+	VectorRendererSpec-sse2.o \
+	yuv_to_rgb_sse2.o
+$(MODULE)/blit-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/VectorRendererSpec-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/yuv_to_rgb_sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	blit-avx2.o \
+	yuv_to_rgb_avx2.o
+$(MODULE)/blit-avx2.o: CXXFLAGS += -mavx2
+$(MODULE)/yuv_to_rgb_avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	blit-neon.o \
+	VectorRendererSpec-neon.o \
+	yuv_to_rgb_neon.o
+endif
+
 ifdef USE_TINYGL
 MODULE_OBJS += \
 	tinygl/api.o \
@@ -96,7 +126,25 @@ MODULE_OBJS += \
 	tinygl/zmath.o \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
-	tinygl/zdirtyrect.o
+	tinygl/zdirtyrect.o \
+	tinygl/zspan.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/zspan-sse2.o
+$(MODULE)/tinygl/zspan-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	tinygl/zspan-avx2.o
+$(MODULE)/tinygl/zspan-avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/zspan-neon.o
+endif
 endif
 
 ifdef USE_ASPECT
@@ -124,6 +172,23 @@ ifdef USE_HQ_SCALERS
 MODULE_OBJS += \
 	scaler/hq.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/hq-sse2.o
+$(MODULE)/scaler/hq-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/hq-avx2.o
+$(MODULE)/scaler/hq-avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/hq-neon.o
+endif
+
 ifdef USE_NASM
 MODULE_OBJS += \
 	scaler/hq2x_i386.o \
@@ -29,6 +29,7 @@
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
 
+#include "graphics/opengl/debug.h"
 #include "graphics/opengl/system_headers.h"
 
 #if defined(USE_OPENGL)
@@ -46,6 +47,9 @@ DECLARE_SINGLETON(OpenGL::Context);
 namespace OpenGL {
 
 Context::Context() {
+	_frameStats.calls = _frameStats.skipped = 0;
+	_frameStats.uploadBytes = 0;
+	_lastFrameStats = _frameStats;
 	reset();
 }
 
@@ -72,6 +76,11 @@ void Context::reset() {
 	textureBorderClampSupported = false;
 	textureMirrorRepeatSupported = false;
 	textureMaxLevelSupported = false;
+	pixelBufferObjectSupported = false;
+	mapBufferRangeSupported = false;
+	syncSupported = false;
+
+	invalidateState();
 }
 
 void Context::initialize(ContextType contextType) {
@@ -193,6 +202,12 @@ void Context::initialize(ContextType contextType) {
 			textureMirrorRepeatSupported = true;
 		} else if (token == "GL_SGIS_texture_lod" || token == "GL_APPLE_texture_max_level") {
 			textureMaxLevelSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object" || token == "GL_EXT_pixel_buffer_object") {
+			pixelBufferObjectSupported = true;
+		} else if (token == "GL_ARB_map_buffer_range") {
+			mapBufferRangeSupported = true;
+		} else if (token == "GL_ARB_sync") {
+			syncSupported = true;
 		}
 	}
 
@@ -227,6 +242,11 @@ void Context::initialize(ContextType contextType) {
 		// No border clamping in GLES2
 		textureMirrorRepeatSupported = true;
 		// TODO: textureMaxLevelSupported with GLES3
+		// TODO: Buffer objects for texture uploads with GLES3, whose
+		// functions are not loaded for GLES2 contexts
+		pixelBufferObjectSupported = false;
+		mapBufferRangeSupported = false;
+		syncSupported = false;
 		debug(5, "OpenGL: GLES2 context initialized");
 	} else if (type == kContextGLES) {
 		// GLES doesn't support shaders natively
@@ -246,6 +266,10 @@ void Context::initialize(ContextType contextType) {
 		textureEdgeClampSupported = true;
 		// No border clamping in GLES
 		// No mirror repeat in GLES
+		// No buffer objects for texture uploads in GLES
+		pixelBufferObjectSupported = false;
+		mapBufferRangeSupported = false;
+		syncSupported = false;
 		debug(5, "OpenGL: GLES context initialized");
 	} else if (type == kContextGL) {
 		shadersSupported = glslVersion >= 100;
@@ -286,6 +310,18 @@ void Context::initialize(ContextType contextType) {
 		if (isGLVersionOrHigher(1, 4)) {
 			textureMirrorRepeatSupported = true;
 		}
+		// OpenGL 2.1 adds pixel buffer objects
+		if (isGLVersionOrHigher(2, 1)) {
+			pixelBufferObjectSupported = true;
+		}
+		// OpenGL 3.0 adds mapping buffer ranges
+		if (isGLVersionOrHigher(3, 0)) {
+			mapBufferRangeSupported = true;
+		}
+		// OpenGL 3.2 adds sync objects
+		if (isGLVersionOrHigher(3, 2)) {
+			syncSupported = true;
+		}
 		debug(5, "OpenGL: GL context initialized");
 	} else {
 		warning("OpenGL: Unknown context initialized");
@@ -316,6 +352,122 @@ void Context::initialize(ContextType contextType) {
 	debug(5, "OpenGL: Texture border clamping support: %d", textureBorderClampSupported);
 	debug(5, "OpenGL: Texture mirror repeat support: %d", textureMirrorRepeatSupported);
 	debug(5, "OpenGL: Texture max level support: %d", textureMaxLevelSupported);
+	debug(5, "OpenGL: Pixel buffer object support: %d", pixelBufferObjectSupported);
+	debug(5, "OpenGL: Map buffer range support: %d", mapBufferRangeSupported);
+	debug(5, "OpenGL: Sync object support: %d", syncSupported);
+}
+
+void Context::setCapability(uint32 cap, bool enable) {
+	CapabilityState *state = nullptr;
+	for (uint i = 0; i < _numCapabilities; ++i) {
+		if (_capabilities[i].cap == cap) {
+			state = &_capabilities[i];
+			break;
+		}
+	}
+	if (!state && _numCapabilities < kMaxShadowedCapabilities) {
+		state = &_capabilities[_numCapabilities++];
+		state->cap = cap;
+		state->enabled = kUnknownState;
+	}
+
+	if (state && state->enabled == (uint32)enable) {
+		countStateCall(true);
+		return;
+	}
+	if (state)
+		state->enabled = enable;
+
+	countStateCall(false);
+	if (enable) {
+		GL_CALL(glEnable(cap));
+	} else {
+		GL_CALL(glDisable(cap));
+	}
+}
+
+void Context::activeTexture(uint32 unit) {
+	if (unit == _activeTextureUnit) {
+		countStateCall(true);
+		return;
+	}
+
+	_activeTextureUnit = unit;
+	countStateCall(false);
+	GL_CALL(glActiveTexture(unit));
+}
+
+void Context::bindTexture(uint32 target, uint32 texture) {
+	// Only 2D textures on the first few units are shadowed.
+	uint32 *binding = nullptr;
+	if (target == GL_TEXTURE_2D && _activeTextureUnit != kUnknownState &&
+	    _activeTextureUnit - GL_TEXTURE0 < kMaxShadowedTextureUnits) {
+		binding = &_boundTextures[_activeTextureUnit - GL_TEXTURE0];
+	}
+
+	if (binding && *binding == texture) {
+		countStateCall(true);
+		return;
+	}
+	if (binding)
+		*binding = texture;
+
+	countStateCall(false);
+	GL_CALL(glBindTexture(target, texture));
+}
+
+void Context::textureDeleted(uint32 texture) {
+	// GL reverts the units the texture was bound to to texture 0.
+	for (uint i = 0; i < kMaxShadowedTextureUnits; ++i) {
+		if (_boundTextures[i] == texture)
+			_boundTextures[i] = 0;
+	}
+}
+
+void Context::blendFunc(uint32 src, uint32 dst) {
+	if (src == _blendSrc && dst == _blendDst) {
+		countStateCall(true);
+		return;
+	}
+
+	_blendSrc = src;
+	_blendDst = dst;
+	countStateCall(false);
+	GL_CALL(glBlendFunc(src, dst));
+}
+
+void Context::useProgram(uint32 program, bool force) {
+	if (program == _program && !force) {
+		countStateCall(true);
+		return;
+	}
+
+	_program = program;
+	countStateCall(false);
+#if !USE_FORCED_GLES
+	GL_CALL(glUseProgram(program));
+#endif
+}
+
+void Context::programDeleted(uint32 program) {
+	// Be conservative: a later program may reuse the name.
+	if (_program == program)
+		_program = kUnknownState;
+}
+
+void Context::invalidateState() {
+	_numCapabilities = 0;
+	_activeTextureUnit = kUnknownState;
+	for (uint i = 0; i < kMaxShadowedTextureUnits; ++i)
+		_boundTextures[i] = kUnknownState;
+	_blendSrc = _blendDst = kUnknownState;
+	_program = kUnknownState;
+}
+
+void Context::endFrame() {
+	_lastFrameStats = _frameStats;
+	_frameStats.calls = _frameStats.skipped = 0;
+	_frameStats.uploadBytes = 0;
 }
 
 int Context::getGLSLVersion() const {
@@ -22,6 +22,7 @@
 #ifndef GRAPHICS_OPENGL_CONTEXT_H
 #define GRAPHICS_OPENGL_CONTEXT_H
 
+#include "common/scummsys.h"
 #include "common/singleton.h"
 
 namespace OpenGL {
@@ -120,7 +121,101 @@ public:
 	/** Whether texture max level is available or not. */
 	bool textureMaxLevelSupported;
 
+	/** Whether pixel buffer objects can be used as texture upload source or not. */
+	bool pixelBufferObjectSupported;
+
+	/** Whether mapping a range of a buffer object is available or not. */
+	bool mapBufferRangeSupported;
+
+	/** Whether fence sync objects are available or not. */
+	bool syncSupported;
+
+	/**
+	 * @name Shadowed GL state
+	 *
+	 * These functions mirror a few pieces of GL state and drop the GL call
+	 * when the requested state is already set. The shadow only stays right
+	 * as long as that state is changed through them: code changing it with
+	 * direct GL calls must call invalidateState() afterwards.
+	 *
+	 * The parameters are the usual GL enums and object names.
+	 * @{
+	 */
+
+	/** Enable or disable a capability, like glEnable() and glDisable(). */
+	void setCapability(uint32 cap, bool enable);
+
+	/** Select the active texture unit, like glActiveTexture(). */
+	void activeTexture(uint32 unit);
+
+	/** Bind a texture to the active texture unit, like glBindTexture(). */
+	void bindTexture(uint32 target, uint32 texture);
+
+	/** Forget the bindings of a texture which is being deleted. */
+	void textureDeleted(uint32 texture);
+
+	/** Set the blend factors, like glBlendFunc(). */
+	void blendFunc(uint32 src, uint32 dst);
+
+	/** Install a program, like glUseProgram(). Forcing it skips the shadow. */
+	void useProgram(uint32 program, bool force = false);
+
+	/** Forget a program which is being deleted. */
+	void programDeleted(uint32 program);
+
+	/** Mark all the shadowed state as unknown. */
+	void invalidateState();
+
+	/** GL call counters of one frame. */
+	struct StateStats {
+		uint calls;        ///< State changes and uniform updates passed on to GL
+		uint skipped;      ///< Redundant ones which were dropped
+		uint32 uploadBytes; ///< Texture data uploaded
+	};
+
+	/** Count a GL call for the statistics, for state shadowed elsewhere. */
+	void countStateCall(bool skipped) {
+		if (skipped)
+			_frameStats.skipped++;
+		else
+			_frameStats.calls++;
+	}
+
+	/** Count texture data uploaded for the statistics. */
+	void countUpload(uint32 bytes) { _frameStats.uploadBytes += bytes; }
+
+	/** Finish the counters of the current frame and start new ones. */
+	void endFrame();
+
+	/** Return the counters of the last finished frame. */
+	const StateStats &getFrameStats() const { return _lastFrameStats; }
+
+	/** @} */
+
 private:
+	enum {
+		kMaxShadowedCapabilities = 8,
+		kMaxShadowedTextureUnits = 8
+	};
+
+	/** Value of shadowed state which is not known. */
+	static const uint32 kUnknownState = 0xFFFFFFFF;
+
+	struct CapabilityState {
+		uint32 cap;
+		uint32 enabled;
+	};
+
+	CapabilityState _capabilities[kMaxShadowedCapabilities];
+	uint _numCapabilities;
+	uint32 _activeTextureUnit;
+	uint32 _boundTextures[kMaxShadowedTextureUnits];
+	uint32 _blendSrc, _blendDst;
+	uint32 _program;
+
+	StateStats _frameStats;
+	StateStats _lastFrameStats;
+
 	/**
 	 * Returns the native GLSL version supported by the driver.
 	 * This does NOT take shaders ARB extensions into account.
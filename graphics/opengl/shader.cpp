@@ -78,6 +78,40 @@ static const char *compatUniformBool =
 #endif
 
 
+static const char *yuvToRGBVertex =
+	"in vec2 position;\n"
+	"in vec2 texcoord;\n"
+	"uniform vec2 offsetXY;\n"
+	"uniform vec2 sizeWH;\n"
+	"uniform vec2 lumaCrop;\n"
+	"uniform vec2 chromaCrop;\n"
+	"uniform UBOOL flipY;\n"
+	"out vec2 LumaTexcoord;\n"
+	"out vec2 ChromaTexcoord;\n"
+	"void main() {\n"
+		"LumaTexcoord = texcoord * lumaCrop;\n"
+		"ChromaTexcoord = texcoord * chromaCrop;\n"
+		"vec2 pos = (offsetXY + position * sizeWH) * 2.0 - 1.0;\n"
+		"if (UBOOL_TEST(flipY))\n"
+			"pos.y = -pos.y;\n"
+		"gl_Position = vec4(pos, 0.0, 1.0);\n"
+	"}\n";
+
+// Full range BT.601, as used by JFIF
+static const char *yuvToRGBFragment =
+	"in vec2 LumaTexcoord;\n"
+	"in vec2 ChromaTexcoord;\n"
+	"uniform sampler2D texY;\n"
+	"uniform sampler2D texCb;\n"
+	"uniform sampler2D texCr;\n"
+	"OUTPUT\n"
+	"void main() {\n"
+		"float y = texture(texY, LumaTexcoord).r;\n"
+		"float cb = texture(texCb, ChromaTexcoord).r - 0.5;\n"
+		"float cr = texture(texCr, ChromaTexcoord).r - 0.5;\n"
+		"outColor = vec4(y + 1.402 * cr, y - 0.344136 * cb - 0.714136 * cr, y + 1.772 * cb, 1.0);\n"
+	"}\n";
+
 static const GLchar *readFile(const Common::String &filename) {
 	Common::File file;
 	Common::String shaderDir;
@@ -240,6 +274,7 @@ GLuint Shader::loadShaderFromFile(const char *base, const char *extension, GLenu
 struct SharedPtrProgramDeleter {
 	void operator()(GLuint *ptr) {
 		if (ptr) {
+			OpenGLContext.programDeleted(*ptr);
 			GL_CALL(glDeleteProgram(*ptr));
 		}
 		delete ptr;
@@ -288,7 +323,7 @@ bool Shader::loadShader(const Common::String &name, GLuint vertexShader, GLuint
 	GL_CALL(glDeleteShader(fragmentShader));
 
 	_shaderNo = Common::SharedPtr<GLuint>(new GLuint(shaderProgram), SharedPtrProgramDeleter());
-	_uniforms = Common::SharedPtr<UniformsMap>(new UniformsMap());
+	_uniforms = Common::SharedPtr<Uniforms>(new Uniforms());
 
 	return true;
 }
@@ -304,6 +339,21 @@ Shader *Shader::fromStrings(const Common::String &name, const char *vertex, cons
 	return shader;
 }
 
+Shader *Shader::createYUVToRGBShader() {
+	static const char *const attributes[] = { "position", "texcoord", nullptr };
+	Shader *shader = fromStrings("yuvtorgb", yuvToRGBVertex, yuvToRGBFragment, attributes, 110);
+
+	shader->setUniform("texY", 0);
+	shader->setUniform("texCb", 1);
+	shader->setUniform("texCr", 2);
+	shader->setUniform("lumaCrop", Math::Vector2d(1.0f, 1.0f));
+	shader->setUniform("chromaCrop", Math::Vector2d(1.0f, 1.0f));
+	shader->setUniform("offsetXY", Math::Vector2d(0.0f, 0.0f));
+	shader->setUniform("sizeWH", Math::Vector2d(1.0f, 1.0f));
+	shader->setUniform("flipY", false);
+	return shader;
+}
+
 bool Shader::loadFromStrings(const Common::String &name, const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion) {
 	GLuint vertexShader, fragmentShader;
 
@@ -389,7 +439,7 @@ void Shader::use(bool forceReload) {
 	_previousShader = this;
 	previousNumAttributes = _attributes.size();
 
-	GL_CALL(glUseProgram(*_shaderNo));
+	OpenGLContext.useProgram(*_shaderNo, forceReload);
 	for (uint32 i = 0; i < _attributes.size(); ++i) {
 		VertexAttrib &attrib = _attributes[i];
 		if (attrib._enabled) {
@@ -414,6 +464,111 @@ void Shader::use(bool forceReload) {
 	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
 }
 
+int Shader::getUniformId(const Common::String &uniform) const {
+	Common::HashMap<Common::String, int>::const_iterator kv = _uniforms->ids.find(uniform);
+	if (kv != _uniforms->ids.end())
+		return kv->_value;
+
+	GLint location;
+	GL_ASSIGN(location, glGetUniformLocation(*_shaderNo, uniform.c_str()));
+
+	int id = -1;
+	if (location != -1) {
+		UniformValue value;
+		value.location = location;
+		value.size = 0;
+		id = _uniforms->values.size();
+		_uniforms->values.push_back(value);
+	}
+	_uniforms->ids.setVal(uniform, id);
+	return id;
+}
+
+bool Shader::updateUniform(int id, const void *data, uint size) {
+	// Setting a uniform has always made its program current.
+	use();
+
+	UniformValue &value = _uniforms->values[id];
+	if (value.size == size && !memcmp(value.data, data, size)) {
+		OpenGLContext.countStateCall(true);
+		return false;
+	}
+
+	if (size <= sizeof(value.data)) {
+		memcpy(value.data, data, size);
+		value.size = size;
+	} else {
+		value.size = 0;
+	}
+
+	OpenGLContext.countStateCall(false);
+	return true;
+}
+
+bool Shader::setUniform(int id, const Math::Matrix4 &m) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, m.getData(), 16 * sizeof(float)))
+		GL_CALL(glUniformMatrix4fv(_uniforms->values[id].location, 1, GL_FALSE, m.getData()));
+	return true;
+}
+
+bool Shader::setUniform(int id, const Math::Matrix3 &m) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, m.getData(), 9 * sizeof(float)))
+		GL_CALL(glUniformMatrix3fv(_uniforms->values[id].location, 1, GL_FALSE, m.getData()));
+	return true;
+}
+
+bool Shader::setUniform(int id, const Math::Vector4d &v) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, v.getData(), 4 * sizeof(float)))
+		GL_CALL(glUniform4fv(_uniforms->values[id].location, 1, v.getData()));
+	return true;
+}
+
+bool Shader::setUniform(int id, const Math::Vector3d &v) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, v.getData(), 3 * sizeof(float)))
+		GL_CALL(glUniform3fv(_uniforms->values[id].location, 1, v.getData()));
+	return true;
+}
+
+bool Shader::setUniform(int id, const Math::Vector2d &v) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, v.getData(), 2 * sizeof(float)))
+		GL_CALL(glUniform2fv(_uniforms->values[id].location, 1, v.getData()));
+	return true;
+}
+
+bool Shader::setUniform(int id, unsigned int x) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, &x, sizeof(x)))
+		GL_CALL(glUniform1i(_uniforms->values[id].location, x));
+	return true;
+}
+
+bool Shader::setUniform(int id, const int size, const int *array) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, array, size * sizeof(int)))
+		GL_CALL(glUniform1iv(_uniforms->values[id].location, size, array));
+	return true;
+}
+
+bool Shader::setUniform1f(int id, float f) {
+	if (id < 0)
+		return false;
+	if (updateUniform(id, &f, sizeof(f)))
+		GL_CALL(glUniform1f(_uniforms->values[id].location, f));
+	return true;
+}
+
 GLuint Shader::createBuffer(GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage) {
 	GLuint vbo;
 	GL_CALL(glGenBuffers(1, &vbo));
@@ -499,7 +654,7 @@ void Shader::disableVertexAttribute(const char *attrib, int size, const float *d
 }
 
 void Shader::unbind() {
-	GL_CALL(glUseProgram(0));
+	OpenGLContext.useProgram(0);
 	_previousShader = nullptr;
 
 	// Disable all vertex attributes as well
@@ -54,7 +54,17 @@ struct VertexAttrib {
 };
 
 class Shader {
-	typedef Common::HashMap<Common::String, GLint> UniformsMap;
+	/** Last value set to a uniform, shadowed to skip redundant updates. */
+	struct UniformValue {
+		GLint location;
+		uint size; ///< Size of the value in bytes, 0 if it is not known
+		byte data[16 * sizeof(float)];
+	};
+
+	struct Uniforms {
+		Common::HashMap<Common::String, int> ids;
+		Common::Array<UniformValue> values;
+	};
 
 public:
 	Shader();
@@ -65,105 +75,65 @@ public:
 
 	void use(bool forceReload = false);
 
+	/**
+	 * Return an id to set a uniform with, without looking up its name
+	 * again. The location is resolved once per program, so clones of the
+	 * shader share the ids.
+	 *
+	 * @return the id, or -1 if the program has no such active uniform
+	 */
+	int getUniformId(const Common::String &uniform) const;
+
 	bool setUniform(const Common::String &uniform, const Math::Matrix4 &m) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniformMatrix4fv(pos, 1, GL_FALSE, m.getData()));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), m);
 	}
 
 	bool setUniform(const Common::String &uniform, const Math::Matrix3 &m) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniformMatrix3fv(pos, 1, GL_FALSE, m.getData()));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), m);
 	}
 
 	bool setUniform(const Common::String &uniform, const Math::Vector4d &v) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform4fv(pos, 1, v.getData()));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), v);
 	}
 
 	bool setUniform(const Common::String &uniform, const Math::Vector3d &v) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform3fv(pos, 1, v.getData()));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), v);
 	}
 
 	bool setUniform(const Common::String &uniform, const Math::Vector2d &v) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform2fv(pos, 1, v.getData()));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), v);
 	}
 
 	bool setUniform(const Common::String &uniform, unsigned int x) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform1i(pos, x));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), x);
 	}
 
 	bool setUniform(const Common::String &uniform, const int size, const int *array) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform1iv(pos, size, array));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform(getUniformId(uniform), size, array);
 	}
 
 	// Different name to avoid overload ambiguity
 	bool setUniform1f(const Common::String &uniform, float f) {
-		GLint pos = getUniformLocation(uniform);
-		if (pos != -1) {
-			use();
-			GL_CALL(glUniform1f(pos, f));
-			return true;
-		} else {
-			return false;
-		}
+		return setUniform1f(getUniformId(uniform), f);
 	}
 
+	/**
+	 * Set a uniform by the id returned by getUniformId(). The program keeps
+	 * uniform values, so setting a uniform to the value it already has is
+	 * skipped.
+	 */
+	bool setUniform(int id, const Math::Matrix4 &m);
+	bool setUniform(int id, const Math::Matrix3 &m);
+	bool setUniform(int id, const Math::Vector4d &v);
+	bool setUniform(int id, const Math::Vector3d &v);
+	bool setUniform(int id, const Math::Vector2d &v);
+	bool setUniform(int id, unsigned int x);
+	bool setUniform(int id, const int size, const int *array);
+	bool setUniform1f(int id, float f);
+
 	GLint getUniformLocation(const Common::String &uniform) const {
-		UniformsMap::iterator kv = _uniforms->find(uniform);
-		if (kv == _uniforms->end()) {
-			GLint ret;
-			GL_ASSIGN(ret, glGetUniformLocation(*_shaderNo, uniform.c_str()));
-			_uniforms->setVal(uniform, ret);
-			return ret;
-		} else {
-			return kv->_value;
-		}
+		const int id = getUniformId(uniform);
+		return id < 0 ? -1 : _uniforms->values[id].location;
 	}
 
 	void enableVertexAttribute(const char *attrib, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
@@ -215,6 +185,22 @@ public:
 	 */
 	static Shader *fromStrings(const Common::String &name, const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion = 0);
 
+	/**
+	 * Creates a shader drawing a quad from the Y, Cb and Cr planes of an
+	 * image, such as the ones of Image::JPEGDecoder::getYUVPlane(). The
+	 * planes are bound as single channel textures to units 0, 1 and 2 and
+	 * converted to RGB on the GPU with the full range BT.601 matrix of JPEG.
+	 *
+	 * The "position" and "texcoord" attributes range from 0 to 1. The quad
+	 * is placed with the "offsetXY" and "sizeWH" uniforms, in fractions of
+	 * the viewport, and mirrored vertically if "flipY" is set. The
+	 * "lumaCrop" and "chromaCrop" uniforms select the part of padded
+	 * textures that hold the planes.
+	 *
+	 * @return the shader object created
+	 */
+	static Shader *createYUVToRGBShader();
+
 	bool loadFromFiles(const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion = 120);
 	bool loadFromStrings(const Common::String &name, const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion = 0);
 
@@ -249,6 +235,12 @@ private:
 	GLuint createDirectShader(size_t shaderSourcesCount, const char *const *shaderSources, GLenum shaderType, const Common::String &name);
 	GLuint loadShaderFromFile(const char *base, const char *extension, GLenum shaderType, int compatGLSLVersion);
 
+	/**
+	 * Make the program current and remember the new value of a uniform.
+	 * Returns false if the uniform already has this value.
+	 */
+	bool updateUniform(int id, const void *data, uint size);
+
 	// Since this class is cloned using the implicit copy constructor,
 	// a reference counting pointer is used to ensure deletion of the OpenGL
 	// program upon destruction of the last clone.
@@ -257,7 +249,7 @@ private:
 	Common::String _name;
 
 	Common::Array<VertexAttrib> _attributes;
-	Common::SharedPtr<UniformsMap> _uniforms;
+	Common::SharedPtr<Uniforms> _uniforms;
 
 	static Shader *_previousShader;
 	static uint32 previousNumAttributes;
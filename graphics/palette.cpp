@@ -22,6 +22,39 @@
 
 namespace Graphics {
 
+namespace {
+
+enum {
+	kCellUnvisited = 0xFFFFFFFF
+};
+
+inline uint32 naiveDistance(const byte *entry, int cr, int cg, int cb) {
+	int r = cr - entry[0];
+	int g = cg - entry[1];
+	int b = cb - entry[2];
+	return 3 * r * r + 5 * g * g + 2 * b * b;
+}
+
+/**
+ * The square of the "redmean" distance. Comparing the squares gives the
+ * same order as comparing the distances themselves.
+ */
+inline uint32 redmeanDistance(const byte *entry, int cr, int cg, int cb) {
+	int rmean = (entry[0] + cr) / 2;
+	int r = entry[0] - cr;
+	int g = entry[1] - cg;
+	int b = entry[2] - cb;
+	return (((512 + rmean) * r * r) >> 8) + 4 * g * g + (((767 - rmean) * b * b) >> 8);
+}
+
+/** Smallest and largest distance between @p value and any of [lo, hi]. */
+inline void channelRange(int value, int lo, int hi, int &minDiff, int &maxDiff) {
+	minDiff = value < lo ? lo - value : (value > hi ? value - hi : 0);
+	maxDiff = MAX(ABS(value - lo), ABS(value - hi));
+}
+
+} // End of anonymous namespace
+
 PaletteLookup::PaletteLookup() {
 	_paletteSize = 0;
 }
@@ -39,58 +72,85 @@ bool PaletteLookup::setPalette(const byte *palette, uint len)  {
 
 	_paletteSize = len;
 	memcpy(_palette, palette, len * 3);
-	_colorHash.clear();
+	for (uint i = 0; i < ARRAYSIZE(_cellTables); ++i) {
+		_cellTables[i].cells.clear();
+		_cellTables[i].candidates.clear();
+	}
 
 	return true;
 }
 
+uint32 PaletteLookup::buildCell(CellTable &table, uint cell, bool useNaiveAlg) {
+	const int cellSize = 1 << (8 - kCellBits);
+	const int r0 = (cell >> (2 * kCellBits)) * cellSize;
+	const int g0 = ((cell >> kCellBits) & ((1 << kCellBits) - 1)) * cellSize;
+	const int b0 = (cell & ((1 << kCellBits) - 1)) * cellSize;
+
+	// Bound the distance between each entry and the colors of the cell.
+	// Since 0 <= rmean <= 255, the redmean distance of a difference
+	// (r, g, b) is at least 2r^2 + 4g^2 + 2b^2 and at most 3r^2 + 4g^2 + 3b^2.
+	const uint32 minWeight[3] = { useNaiveAlg ? 3u : 2u, useNaiveAlg ? 5u : 4u, 2u };
+	const uint32 maxWeight[3] = { 3u, useNaiveAlg ? 5u : 4u, useNaiveAlg ? 2u : 3u };
+
+	uint32 lower[256];
+	uint32 bestUpper = 0xFFFFFFFF;
+	for (uint i = 0; i < _paletteSize; ++i) {
+		const byte *entry = _palette + 3 * i;
+		int minR, maxR, minG, maxG, minB, maxB;
+		channelRange(entry[0], r0, r0 + cellSize - 1, minR, maxR);
+		channelRange(entry[1], g0, g0 + cellSize - 1, minG, maxG);
+		channelRange(entry[2], b0, b0 + cellSize - 1, minB, maxB);
+
+		lower[i] = minWeight[0] * minR * minR + minWeight[1] * minG * minG + minWeight[2] * minB * minB;
+		const uint32 upper = maxWeight[0] * maxR * maxR + maxWeight[1] * maxG * maxG + maxWeight[2] * maxB * maxB;
+		bestUpper = MIN(bestUpper, upper);
+	}
+
+	// Any entry that may come closer than the best guaranteed distance is
+	// a candidate. They are kept in index order to preserve tie breaking.
+	const uint32 offset = table.candidates.size();
+	for (uint i = 0; i < _paletteSize; ++i) {
+		if (lower[i] <= bestUpper)
+			table.candidates.push_back(i);
+	}
+
+	const uint32 entry = (offset << 9) | (table.candidates.size() - offset);
+	table.cells[cell] = entry;
+	return entry;
+}
+
 byte PaletteLookup::findBestColor(byte cr, byte cg, byte cb, bool useNaiveAlg) {
 	if (_paletteSize == 0) {
 		warning("PaletteLookup::findBestColor(): Palette was not set");
 		return 0;
 	}
 
-	uint bestColor = 0;
-	double min = 0xFFFFFFFF;
-
-	uint32 color = cr << 16 | cg << 8 | cb;
-
-	if (_colorHash.contains(color))
-		return _colorHash[color];
-
-	if (useNaiveAlg) {
-		byte *palettePtr = _palette;
-
-		for (uint i = 0; i < _paletteSize; i++) {
-			int redSquareDiff = (cr - palettePtr[0]) * (cr - palettePtr[0]);
-			int greenSquareDiff = (cg - palettePtr[1]) * (cg - palettePtr[1]);
-			int blueSquareDiff = (cb - palettePtr[2]) * (cb - palettePtr[2]);
-
-			int weightedColorError = 3 * redSquareDiff + 5 * greenSquareDiff + 2 * blueSquareDiff;
-			if (weightedColorError < min) {
-				bestColor = i;
-				min = weightedColorError;
-			}
-
-			palettePtr += 3;
-		}
-	} else {
-		for (uint i = 0; i < _paletteSize; ++i) {
-			int rmean = (*(_palette + 3 * i + 0) + cr) / 2;
-			int r = *(_palette + 3 * i + 0) - cr;
-			int g = *(_palette + 3 * i + 1) - cg;
-			int b = *(_palette + 3 * i + 2) - cb;
-
-			double dist = sqrt((((512 + rmean) * r * r) >> 8) + 4 * g * g + (((767 - rmean) * b * b) >> 8));
-			if (min > dist) {
-				bestColor = i;
-				min = dist;
-			}
+	CellTable &table = _cellTables[useNaiveAlg ? 1 : 0];
+	if (table.cells.empty())
+		table.cells.resize(kCellCount, kCellUnvisited);
+
+	const uint shift = 8 - kCellBits;
+	const uint cell = ((cr >> shift) << (2 * kCellBits)) | ((cg >> shift) << kCellBits) | (cb >> shift);
+	uint32 entry = table.cells[cell];
+	if (entry == kCellUnvisited)
+		entry = buildCell(table, cell, useNaiveAlg);
+
+	const byte *candidates = &table.candidates[entry >> 9];
+	const uint count = entry & 0x1FF;
+	if (count == 1)
+		return candidates[0];
+
+	byte bestColor = candidates[0];
+	uint32 min = 0xFFFFFFFF;
+	for (uint i = 0; i < count; ++i) {
+		const byte *palettePtr = _palette + 3 * candidates[i];
+		const uint32 dist = useNaiveAlg ? naiveDistance(palettePtr, cr, cg, cb) : redmeanDistance(palettePtr, cr, cg, cb);
+		if (dist < min) {
+			bestColor = candidates[i];
+			min = dist;
 		}
 	}
 
-	_colorHash[color] = bestColor;
-
 	return bestColor;
 }
 
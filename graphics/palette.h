@@ -23,6 +23,7 @@
 #define GRAPHICS_PALETTE_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/noncopyable.h"
 
@@ -137,6 +138,11 @@ public:
 	 * @brief This method returns closest color from the palette
 	 *        and it uses cache for faster lookups
 	 *
+	 * The RGB cube is split into cells of 8x8x8 colors. The first lookup
+	 * in a cell determines which palette entries can be the closest one
+	 * to any color in the cell, so that later lookups only compare those.
+	 * Ties are resolved in favour of the lowest palette index.
+	 *
 	 * @param useNaiveAlg            if true, use a simpler algorithm (non-floating point calculations)
 	 *
 	 * @return the palette index
@@ -144,9 +150,26 @@ public:
 	byte findBestColor(byte r, byte g, byte b, bool useNaiveAlg = false);
 
 private:
+	enum {
+		kCellBits = 5,
+		kCellCount = 1 << (3 * kCellBits)
+	};
+
+	/**
+	 * For each cell, the offset of its candidate list shifted left by 9,
+	 * ORed with the number of candidates, or 0xFFFFFFFF if the cell has
+	 * not been visited yet.
+	 */
+	struct CellTable {
+		Common::Array<uint32> cells;
+		Common::Array<byte> candidates;
+	};
+
 	byte _palette[256 * 3];
 	uint _paletteSize;
-	Common::HashMap<int, byte> _colorHash;
+	CellTable _cellTables[2]; ///< Indexed by useNaiveAlg
+
+	uint32 buildCell(CellTable &table, uint cell, bool useNaiveAlg);
 };
 
 } //  // end of namespace Graphics
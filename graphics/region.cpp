@@ -0,0 +1,333 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "graphics/region.h"
+
+namespace Graphics {
+
+namespace {
+
+struct Span {
+	int16 left, right;
+};
+
+typedef Common::Array<Common::Rect> RectArray;
+typedef Common::Array<Span> SpanArray;
+
+/** Return the index one past the last rectangle of the band at @p start. */
+uint bandEnd(const RectArray &rects, uint start) {
+	uint end = start + 1;
+	while (end < rects.size() && rects[end].top == rects[start].top)
+		end++;
+	return end;
+}
+
+/** Return the n-th horizontal edge of the rectangles, left edges at even n. */
+inline int edge(const RectArray &rects, uint n) {
+	return (n & 1) ? rects[n >> 1].right : rects[n >> 1].left;
+}
+
+void sortUnique(Common::Array<int16> &values) {
+	if (values.empty())
+		return;
+
+	Common::sort(values.begin(), values.end());
+	uint count = 1;
+	for (uint i = 1; i < values.size(); i++) {
+		if (values[i] != values[count - 1])
+			values[count++] = values[i];
+	}
+	values.resize(count);
+}
+
+/**
+ * Append a band covering [top, bottom), or extend the previous band if
+ * it ends at @p top and has the same spans.
+ */
+void appendBand(RectArray &rects, uint &lastBand, const SpanArray &spans, int16 top, int16 bottom) {
+	if (lastBand < rects.size() && rects[lastBand].bottom == top && rects.size() - lastBand == spans.size()) {
+		bool same = true;
+		for (uint i = 0; i < spans.size() && same; i++)
+			same = rects[lastBand + i].left == spans[i].left && rects[lastBand + i].right == spans[i].right;
+
+		if (same) {
+			for (uint i = lastBand; i < rects.size(); i++)
+				rects[i].bottom = bottom;
+			return;
+		}
+	}
+
+	lastBand = rects.size();
+	for (uint i = 0; i < spans.size(); i++)
+		rects.push_back(Common::Rect(spans[i].left, top, spans[i].right, bottom));
+}
+
+} // End of anonymous namespace
+
+Region::Region(const Common::Rect &r) {
+	if (!r.isEmpty())
+		_rects.push_back(r);
+}
+
+Common::Rect Region::getBounds() const {
+	if (_rects.empty())
+		return Common::Rect();
+
+	Common::Rect bounds(_rects.front().left, _rects.front().top, _rects.back().right, _rects.back().bottom);
+	for (uint i = 0; i < _rects.size(); i++) {
+		bounds.left = MIN(bounds.left, _rects[i].left);
+		bounds.right = MAX(bounds.right, _rects[i].right);
+	}
+	return bounds;
+}
+
+uint32 Region::getArea() const {
+	uint32 area = 0;
+	for (uint i = 0; i < _rects.size(); i++)
+		area += (uint32)_rects[i].width() * _rects[i].height();
+	return area;
+}
+
+bool Region::contains(int16 x, int16 y) const {
+	for (uint i = 0; i < _rects.size(); i++) {
+		if (_rects[i].contains(x, y))
+			return true;
+	}
+	return false;
+}
+
+void Region::unite(const Common::Rect &r) {
+	combine(Region(r), kOpUnion);
+}
+
+void Region::unite(const Region &other) {
+	combine(other, kOpUnion);
+}
+
+void Region::unite(const Common::Rect *rects, uint count) {
+	// Sweep over the rectangles top to bottom, keeping those that cover
+	// the current band, rather than combining them one at a time
+	RectArray sorted;
+	sorted.reserve(count);
+	Common::Array<int16> ys;
+	ys.reserve(2 * count);
+	for (uint i = 0; i < count; i++) {
+		if (rects[i].isEmpty())
+			continue;
+		sorted.push_back(rects[i]);
+		ys.push_back(rects[i].top);
+		ys.push_back(rects[i].bottom);
+	}
+	if (sorted.empty())
+		return;
+
+	Common::sort(sorted.begin(), sorted.end(), [](const Common::Rect &a, const Common::Rect &b) {
+		return a.top < b.top;
+	});
+	sortUnique(ys);
+
+	Region added;
+	RectArray active;
+	SpanArray spans;
+	uint lastBand = 0;
+	uint next = 0;
+
+	for (uint k = 0; k + 1 < ys.size(); k++) {
+		const int16 y0 = ys[k], y1 = ys[k + 1];
+
+		for (uint i = 0; i < active.size();) {
+			if (active[i].bottom <= y0) {
+				active[i] = active.back();
+				active.pop_back();
+			} else {
+				i++;
+			}
+		}
+		while (next < sorted.size() && sorted[next].top == y0)
+			active.push_back(sorted[next++]);
+
+		if (active.empty())
+			continue;
+
+		spans.clear();
+		for (uint i = 0; i < active.size(); i++) {
+			Span span = { active[i].left, active[i].right };
+			spans.push_back(span);
+		}
+		Common::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+			return a.left < b.left;
+		});
+
+		// Join overlapping and touching spans
+		uint numSpans = 1;
+		for (uint i = 1; i < spans.size(); i++) {
+			if (spans[i].left <= spans[numSpans - 1].right)
+				spans[numSpans - 1].right = MAX(spans[numSpans - 1].right, spans[i].right);
+			else
+				spans[numSpans++] = spans[i];
+		}
+		spans.resize(numSpans);
+
+		appendBand(added._rects, lastBand, spans, y0, y1);
+	}
+
+	combine(added, kOpUnion);
+}
+
+void Region::subtract(const Common::Rect &r) {
+	combine(Region(r), kOpSubtract);
+}
+
+void Region::subtract(const Region &other) {
+	combine(other, kOpSubtract);
+}
+
+void Region::intersect(const Common::Rect &r) {
+	combine(Region(r), kOpIntersect);
+}
+
+void Region::intersect(const Region &other) {
+	combine(other, kOpIntersect);
+}
+
+void Region::combine(const Region &other, Op op) {
+	const RectArray &a = _rects;
+	const RectArray &b = other._rects;
+
+	if (b.empty()) {
+		if (op == kOpIntersect)
+			_rects.clear();
+		return;
+	}
+	if (a.empty()) {
+		if (op == kOpUnion)
+			_rects = b;
+		return;
+	}
+
+	// Every band edge of either region starts a new output band
+	Common::Array<int16> ys;
+	ys.reserve(2 * (a.size() + b.size()));
+	for (uint i = 0; i < a.size(); i++) {
+		ys.push_back(a[i].top);
+		ys.push_back(a[i].bottom);
+	}
+	for (uint i = 0; i < b.size(); i++) {
+		ys.push_back(b[i].top);
+		ys.push_back(b[i].bottom);
+	}
+	sortUnique(ys);
+
+	RectArray result;
+	SpanArray spans;
+	uint lastBand = 0;
+	uint ia = 0, ib = 0;
+
+	for (uint k = 0; k + 1 < ys.size(); k++) {
+		const int16 y0 = ys[k], y1 = ys[k + 1];
+
+		while (ia < a.size() && a[ia].bottom <= y0)
+			ia = bandEnd(a, ia);
+		while (ib < b.size() && b[ib].bottom <= y0)
+			ib = bandEnd(b, ib);
+
+		const uint endA = (ia < a.size() && a[ia].top <= y0) ? bandEnd(a, ia) : ia;
+		const uint endB = (ib < b.size() && b[ib].top <= y0) ? bandEnd(b, ib) : ib;
+
+		// Sweep over the left and right edges of both bands
+		spans.clear();
+		uint i = 2 * ia, j = 2 * ib;
+		bool inA = false, inB = false, inside = false;
+		int16 start = 0;
+		while (i < 2 * endA || j < 2 * endB) {
+			const int x = MIN(i < 2 * endA ? edge(a, i) : 0x7FFFFFFF, j < 2 * endB ? edge(b, j) : 0x7FFFFFFF);
+			while (i < 2 * endA && edge(a, i) == x) {
+				inA = !inA;
+				i++;
+			}
+			while (j < 2 * endB && edge(b, j) == x) {
+				inB = !inB;
+				j++;
+			}
+
+			bool now;
+			if (op == kOpUnion)
+				now = inA || inB;
+			else if (op == kOpSubtract)
+				now = inA && !inB;
+			else
+				now = inA && inB;
+
+			if (now != inside) {
+				if (now) {
+					start = x;
+				} else {
+					Span span = { start, (int16)x };
+					spans.push_back(span);
+				}
+				inside = now;
+			}
+		}
+
+		if (!spans.empty())
+			appendBand(result, lastBand, spans, y0, y1);
+	}
+
+	_rects = result;
+}
+
+void Region::simplify(int maxGap, uint maxRects) {
+	if (_rects.empty())
+		return;
+
+	if (maxGap > 0) {
+		RectArray result;
+		SpanArray spans;
+		uint lastBand = 0;
+
+		for (uint start = 0, end; start < _rects.size(); start = end) {
+			end = bandEnd(_rects, start);
+
+			spans.clear();
+			for (uint i = start; i < end; i++) {
+				if (!spans.empty() && _rects[i].left - spans.back().right <= maxGap) {
+					spans.back().right = _rects[i].right;
+				} else {
+					Span span = { _rects[i].left, _rects[i].right };
+					spans.push_back(span);
+				}
+			}
+
+			appendBand(result, lastBand, spans, _rects[start].top, _rects[start].bottom);
+		}
+
+		_rects = result;
+	}
+
+	if (_rects.size() > maxRects) {
+		Common::Rect bounds = getBounds();
+		_rects.clear();
+		_rects.push_back(bounds);
+	}
+}
+
+} // End of namespace Graphics
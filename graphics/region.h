@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_REGION_H
+#define GRAPHICS_REGION_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_region Region
+ * @ingroup graphics
+ *
+ * @brief An area made up of rectangles, for dirty area tracking.
+ *
+ * @{
+ */
+
+/**
+ * A set of pixels, stored as non-overlapping rectangles.
+ *
+ * The rectangles are kept in bands: they are sorted by top and then
+ * left coordinate, and the rectangles of one band share the same top
+ * and bottom. Rectangles within a band never touch, and adjacent bands
+ * with identical horizontal extents are joined, so every region has
+ * exactly one representation.
+ */
+class Region {
+public:
+	Region() {}
+	explicit Region(const Common::Rect &r);
+
+	bool isEmpty() const { return _rects.empty(); }
+	void clear() { _rects.clear(); }
+
+	/** Return the rectangles covering the region, in band order. */
+	const Common::Array<Common::Rect> &getRects() const { return _rects; }
+
+	/** Return the smallest rectangle containing the whole region. */
+	Common::Rect getBounds() const;
+
+	/** Return the number of pixels in the region. */
+	uint32 getArea() const;
+
+	bool contains(int16 x, int16 y) const;
+
+	void unite(const Common::Rect &r);
+	void unite(const Region &other);
+
+	/** Add @p count rectangles at once, which is faster than one by one. */
+	void unite(const Common::Rect *rects, uint count);
+
+	void subtract(const Common::Rect &r);
+	void subtract(const Region &other);
+
+	void intersect(const Common::Rect &r);
+	void intersect(const Region &other);
+
+	/**
+	 * Trade exactness for fewer rectangles. Rectangles within a band that
+	 * are at most @p maxGap pixels apart are joined. If more than
+	 * @p maxRects rectangles remain, the region becomes its bounding box.
+	 */
+	void simplify(int maxGap, uint maxRects);
+
+	bool operator==(const Region &other) const { return _rects == other._rects; }
+	bool operator!=(const Region &other) const { return !(*this == other); }
+
+private:
+	enum Op {
+		kOpUnion,
+		kOpSubtract,
+		kOpIntersect
+	};
+
+	Common::Array<Common::Rect> _rects;
+
+	void combine(const Region &other, Op op);
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/scaler/hq-simd.h"
+
+#include <immintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+/**
+ * Return @p bit in the lanes where diffYUV() would report a difference:
+ * the absolute difference of any of the Y, U and V bytes exceeds its
+ * threshold.
+ */
+inline __m256i diffBit(__m256i a, __m256i b, __m256i threshold, int bit) {
+	const __m256i absDiff = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+	const __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(absDiff, threshold), _mm256_setzero_si256());
+	return _mm256_andnot_si256(same, _mm256_set1_epi32(bit));
+}
+
+inline __m256i load(const uint32 *p) {
+	return _mm256_loadu_si256((const __m256i *)p);
+}
+
+inline __m256i patterns8(const uint32 *above, const uint32 *center, const uint32 *below, __m256i threshold) {
+	const __m256i c = load(center);
+	__m256i pattern = diffBit(c, load(above - 1), threshold, 0x01);
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(above), threshold, 0x02));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(above + 1), threshold, 0x04));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(center - 1), threshold, 0x08));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(center + 1), threshold, 0x10));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(below - 1), threshold, 0x20));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(below), threshold, 0x40));
+	pattern = _mm256_or_si256(pattern, diffBit(c, load(below + 1), threshold, 0x80));
+	return pattern;
+}
+
+} // End of anonymous namespace
+
+void hqPatternRowAVX2(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w) {
+	// Y, U and V thresholds of diffYUV()
+	const __m256i threshold = _mm256_set1_epi32(0x00300706);
+
+	uint x = 0;
+	for (; x + 16 <= w; x += 16) {
+		const __m256i lo = patterns8(above + x, center + x, below + x, threshold);
+		const __m256i hi = patterns8(above + x + 8, center + x + 8, below + x + 8, threshold);
+		// The packs work within 128 bit lanes, restore the pixel order
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+		const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+		_mm_storeu_si128((__m128i *)(patterns + x), bytes);
+	}
+
+	hqPatternRow(patterns + x, above + x, center + x, below + x, w - x);
+}
+
+} // End of namespace Graphics
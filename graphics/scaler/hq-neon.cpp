@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/scaler/hq-simd.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+namespace {
+
+/**
+ * Return @p bit in the lanes where diffYUV() would report a difference:
+ * the absolute difference of any of the Y, U and V bytes exceeds its
+ * threshold.
+ */
+inline uint32x4_t diffBit(uint8x16_t a, uint8x16_t b, uint8x16_t threshold, uint32 bit) {
+	const uint32x4_t exceeds = vreinterpretq_u32_u8(vcgtq_u8(vabdq_u8(a, b), threshold));
+	return vandq_u32(vtstq_u32(exceeds, exceeds), vdupq_n_u32(bit));
+}
+
+inline uint8x16_t load(const uint32 *p) {
+	return vreinterpretq_u8_u32(vld1q_u32(p));
+}
+
+inline uint32x4_t patterns4(const uint32 *above, const uint32 *center, const uint32 *below, uint8x16_t threshold) {
+	const uint8x16_t c = load(center);
+	uint32x4_t pattern = diffBit(c, load(above - 1), threshold, 0x01);
+	pattern = vorrq_u32(pattern, diffBit(c, load(above), threshold, 0x02));
+	pattern = vorrq_u32(pattern, diffBit(c, load(above + 1), threshold, 0x04));
+	pattern = vorrq_u32(pattern, diffBit(c, load(center - 1), threshold, 0x08));
+	pattern = vorrq_u32(pattern, diffBit(c, load(center + 1), threshold, 0x10));
+	pattern = vorrq_u32(pattern, diffBit(c, load(below - 1), threshold, 0x20));
+	pattern = vorrq_u32(pattern, diffBit(c, load(below), threshold, 0x40));
+	pattern = vorrq_u32(pattern, diffBit(c, load(below + 1), threshold, 0x80));
+	return pattern;
+}
+
+} // End of anonymous namespace
+
+void hqPatternRowNEON(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w) {
+	// Y, U and V thresholds of diffYUV()
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(0x00300706));
+
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const uint32x4_t lo = patterns4(above + x, center + x, below + x, threshold);
+		const uint32x4_t hi = patterns4(above + x + 4, center + x + 4, below + x + 4, threshold);
+		const uint16x8_t packed = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+		vst1_u8(patterns + x, vmovn_u16(packed));
+	}
+
+	hqPatternRow(patterns + x, above + x, center + x, below + x, w - x);
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,59 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_HQ_SIMD_H
+#define GRAPHICS_SCALER_HQ_SIMD_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+/**
+ * Compute the HQ pattern of @p w pixels of a row: bit n of a pattern is set
+ * when the YUV value of the pixel differs from that of its n-th neighbour,
+ * counted row by row from the top left while skipping the pixel itself.
+ *
+ * @p above, @p center and @p below hold the YUV values of three source rows
+ * and must be readable from index -1 to @p w.
+ */
+typedef void (*HQPatternRowProc)(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w);
+
+/** The portable pattern detection, also used for the ends of rows. */
+void hqPatternRow(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w);
+
+/** Return the fastest pattern detection the CPU supports. */
+HQPatternRowProc getHQPatternRowProc();
+
+#ifdef SCUMMVM_SSE2
+void hqPatternRowSSE2(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void hqPatternRowAVX2(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w);
+#endif
+
+#ifdef SCUMMVM_NEON
+void hqPatternRowNEON(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w);
+#endif
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_SCALER_HQ_SIMD_H
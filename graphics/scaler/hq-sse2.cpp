@@ -0,0 +1,75 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/scaler/hq-simd.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+/**
+ * Return @p bit in the lanes where diffYUV() would report a difference:
+ * the absolute difference of any of the Y, U and V bytes exceeds its
+ * threshold.
+ */
+inline __m128i diffBit(__m128i a, __m128i b, __m128i threshold, int bit) {
+	const __m128i absDiff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+	const __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(absDiff, threshold), _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+
+inline __m128i load(const uint32 *p) {
+	return _mm_loadu_si128((const __m128i *)p);
+}
+
+inline __m128i patterns4(const uint32 *above, const uint32 *center, const uint32 *below, __m128i threshold) {
+	const __m128i c = load(center);
+	__m128i pattern = diffBit(c, load(above - 1), threshold, 0x01);
+	pattern = _mm_or_si128(pattern, diffBit(c, load(above), threshold, 0x02));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(above + 1), threshold, 0x04));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(center - 1), threshold, 0x08));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(center + 1), threshold, 0x10));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(below - 1), threshold, 0x20));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(below), threshold, 0x40));
+	pattern = _mm_or_si128(pattern, diffBit(c, load(below + 1), threshold, 0x80));
+	return pattern;
+}
+
+} // End of anonymous namespace
+
+void hqPatternRowSSE2(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w) {
+	// Y, U and V thresholds of diffYUV()
+	const __m128i threshold = _mm_set1_epi32(0x00300706);
+
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const __m128i lo = patterns4(above + x, center + x, below + x, threshold);
+		const __m128i hi = patterns4(above + x + 4, center + x + 4, below + x + 4, threshold);
+		const __m128i packed = _mm_packs_epi32(lo, hi);
+		_mm_storel_epi64((__m128i *)(patterns + x), _mm_packus_epi16(packed, packed));
+	}
+
+	hqPatternRow(patterns + x, above + x, center + x, below + x, w - x);
+}
+
+} // End of namespace Graphics
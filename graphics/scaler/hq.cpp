@@ -19,9 +19,13 @@
  */
 
 #include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq-simd.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 
+#include "common/array.h"
+#include "common/system.h"
+
 // RGB-to-YUV lookup table
 
 #ifdef USE_NASM
@@ -173,7 +177,63 @@ void HQScaler::initLUT(Graphics::PixelFormat format) {
 #define PIXEL11_90	*(q+1+nextlineDst) = interpolate_2_3_3(w5, w6, w8);
 #define PIXEL11_100	*(q+1+nextlineDst) = interpolate_14_1_1(w5, w6, w8);
 
-#define YUV(x)	(sizeof(Pixel) == 2 ? RGBtoYUV[w ## x] : ConvertYUV<ColorMask>(w ## x, RGBtoYUV))
+// YUV values of the 3x3 grid, taken from the rows converted by HQRows
+#define YUV(x)	YUV_ ## x
+#define YUV_1	yuvAbove[-1]
+#define YUV_2	yuvAbove[0]
+#define YUV_3	yuvAbove[1]
+#define YUV_4	yuvCenter[-1]
+#define YUV_5	yuvCenter[0]
+#define YUV_6	yuvCenter[1]
+#define YUV_7	yuvBelow[-1]
+#define YUV_8	yuvBelow[0]
+#define YUV_9	yuvBelow[1]
+
+namespace Graphics {
+
+void hqPatternRow(byte *patterns, const uint32 *above, const uint32 *center, const uint32 *below, uint w) {
+	for (; w > 0; --w, ++above, ++center, ++below) {
+		const int yuv5 = center[0];
+		int pattern = 0;
+		if (diffYUV(yuv5, above[-1])) pattern |= 0x0001;
+		if (diffYUV(yuv5, above[0])) pattern |= 0x0002;
+		if (diffYUV(yuv5, above[1])) pattern |= 0x0004;
+		if (diffYUV(yuv5, center[-1])) pattern |= 0x0008;
+		if (diffYUV(yuv5, center[1])) pattern |= 0x0010;
+		if (diffYUV(yuv5, below[-1])) pattern |= 0x0020;
+		if (diffYUV(yuv5, below[0])) pattern |= 0x0040;
+		if (diffYUV(yuv5, below[1])) pattern |= 0x0080;
+		*patterns++ = pattern;
+	}
+}
+
+HQPatternRowProc getHQPatternRowProc() {
+#ifdef SCUMMVM_AVX2
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureAVX2))
+		return hqPatternRowAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return hqPatternRowSSE2;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureSSE2))
+		return hqPatternRowSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return hqPatternRowNEON;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureNEON))
+		return hqPatternRowNEON;
+#endif
+#endif
+	return hqPatternRow;
+}
+
+} // End of namespace Graphics
 
 /**
  * Convert 32 bit RGB values to Yuv
@@ -193,6 +253,65 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+/**
+ * The YUV values and patterns of the source rows around the row being
+ * scaled. Every source row is converted once, and the patterns of a whole
+ * row are detected at once so that vector instructions can be used.
+ */
+template<typename ColorMask>
+class HQRows {
+	typedef typename ColorMask::PixelType Pixel;
+
+	Common::Array<uint32> _yuv;
+	Common::Array<byte> _patterns;
+	const uint32 *_RGBtoYUV;
+	Graphics::HQPatternRowProc _patternRow;
+	uint _width;
+	uint32 *_rows[3];
+
+	void convert(uint32 *yuv, const Pixel *p) const {
+		for (uint x = 0; x < _width + 2; ++x)
+			yuv[x] = sizeof(Pixel) == 2 ? _RGBtoYUV[p[x]] : ConvertYUV<ColorMask>(p[x], _RGBtoYUV);
+	}
+
+public:
+	/**
+	 * Convert the rows above and at @p p, which points at the first pixel
+	 * of the first row to be scaled.
+	 */
+	HQRows(const Pixel *p, uint32 nextlineSrc, uint width, const uint32 *RGBtoYUV) :
+			_RGBtoYUV(RGBtoYUV), _patternRow(Graphics::getHQPatternRowProc()), _width(width) {
+		_yuv.resize(3 * (width + 2));
+		_patterns.resize(width);
+		for (uint i = 0; i < 3; ++i)
+			_rows[i] = _yuv.data() + i * (width + 2) + 1;
+		convert(_rows[0] - 1, p - nextlineSrc - 1);
+		convert(_rows[1] - 1, p - 1);
+	}
+
+	/**
+	 * Convert the row below the row at @p p and detect its patterns. Has
+	 * to be called for every row in order.
+	 */
+	void next(const Pixel *p, uint32 nextlineSrc) {
+		convert(_rows[2] - 1, p + nextlineSrc - 1);
+		_patternRow(_patterns.data(), _rows[0], _rows[1], _rows[2], _width);
+	}
+
+	/** Move on to the next row after it has been scaled. */
+	void advance() {
+		uint32 *above = _rows[0];
+		_rows[0] = _rows[1];
+		_rows[1] = _rows[2];
+		_rows[2] = above;
+	}
+
+	const byte *patterns() const { return _patterns.data(); }
+	const uint32 *above() const { return _rows[0]; }
+	const uint32 *center() const { return _rows[1]; }
+	const uint32 *below() const { return _rows[2]; }
+};
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
@@ -221,7 +340,15 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQRows<ColorMask> rows(p, nextlineSrc, width, RGBtoYUV);
+
 	while (height--) {
+		rows.next(p, nextlineSrc);
+		const byte *patterns = rows.patterns();
+		const uint32 *yuvAbove = rows.above();
+		const uint32 *yuvCenter = rows.center();
+		const uint32 *yuvBelow = rows.below();
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -238,16 +365,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *patterns++;
 
 			switch (pattern) {
 			case 0:
@@ -2049,8 +2167,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w5 = w6;
 			w8 = w9;
 
+			yuvAbove++;
+			yuvCenter++;
+			yuvBelow++;
+
 			q += 2;
 		}
+		rows.advance();
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 2;
 	}
@@ -2139,7 +2262,15 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQRows<ColorMask> rows(p, nextlineSrc, width, RGBtoYUV);
+
 	while (height--) {
+		rows.next(p, nextlineSrc);
+		const byte *patterns = rows.patterns();
+		const uint32 *yuvAbove = rows.above();
+		const uint32 *yuvCenter = rows.center();
+		const uint32 *yuvBelow = rows.below();
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -2156,16 +2287,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *patterns++;
 
 			switch (pattern) {
 			case 0:
@@ -4940,8 +5062,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w5 = w6;
 			w8 = w9;
 
+			yuvAbove++;
+			yuvCenter++;
+			yuvBelow++;
+
 			q += 3;
 		}
+		rows.advance();
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 3;
 	}
@@ -47,6 +47,10 @@ public:
 	AdvMameScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	// Scale4x reads past the row ends of its intermediate buffer, so its
+	// border pixels depend on what earlier rows left there
+	bool isBandSafe() const override { return _factor != 4; }
+	uint getBandContextRows() const override { return 1; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
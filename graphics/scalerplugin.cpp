@@ -20,6 +20,9 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/system.h"
+#include "common/threadpool.h"
+
 namespace {
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
@@ -40,6 +43,9 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 		dstPtr += dstPitch;
 	}
 }
+
+/** Bands smaller than this are not worth handing to another thread. */
+const uint kMinBandRows = 16;
 } // End of anonymous namespace
 
 void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
@@ -52,11 +58,36 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 		} else {
 			Normal1x<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 		}
+	} else if (getBandGrain(height)) {
+		scaleInBands(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 	} else {
 		scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 	}
 }
 
+uint Scaler::getBandGrain(int height) const {
+	if (!isBandSafe())
+		return 0;
+
+	const uint grain = MAX<uint>(kMinBandRows, getBandContextRows() * 8);
+	if ((uint)height < grain * 2)
+		return 0;
+
+	if (g_system->getThreadPool().getConcurrency() < 2)
+		return 0;
+
+	return grain;
+}
+
+void Scaler::scaleInBands(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	                      uint32 dstPitch, int width, int height, int x, int y) {
+	g_system->getThreadPool().parallelFor(0, height, getBandGrain(height), [&](uint first, uint last) {
+		scaleIntern(srcPtr + first * srcPitch, srcPitch,
+		            dstPtr + first * _factor * dstPitch, dstPitch,
+		            width, last - first, x, y + first);
+	});
+}
+
 SourceScaler::SourceScaler(const Graphics::PixelFormat &format) : Scaler(format), _width(0), _height(0), _oldSrc(NULL), _enable(false) {
 }
 
@@ -112,6 +143,38 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	            width, height,
 	            (uint8 *)_bufferedOutput.getBasePtr(x * _factor, y * _factor), _bufferedOutput.pitch);
 
+	updateOldSource(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+}
+
+void SourceScaler::scaleInBands(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+						 uint32 dstPitch, int width, int height, int x, int y) {
+	const uint grain = getBandGrain(height);
+
+	if (!_enable) {
+		g_system->getThreadPool().parallelFor(0, height, grain, [&](uint first, uint last) {
+			internScale(srcPtr + first * srcPitch, srcPitch,
+			            dstPtr + first * _factor * dstPitch, dstPitch,
+			            NULL, 0,
+			            width, last - first,
+			            NULL, 0);
+		});
+		return;
+	}
+
+	int offset = (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
+	g_system->getThreadPool().parallelFor(0, height, grain, [&](uint first, uint last) {
+		internScale(srcPtr + first * srcPitch, srcPitch,
+		            dstPtr + first * _factor * dstPitch, dstPitch,
+		            _oldSrc + offset + first * srcPitch, srcPitch,
+		            width, last - first,
+		            (uint8 *)_bufferedOutput.getBasePtr(x * _factor, (y + first) * _factor), _bufferedOutput.pitch);
+	});
+
+	updateOldSource(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+}
+
+void SourceScaler::updateOldSource(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+						 uint32 dstPitch, int width, int height, int x, int y) {
 	// Update the destination buffer
 	byte *buffer = (byte *)_bufferedOutput.getBasePtr(x * _factor, y * _factor);
 	for (uint i = 0; i < height * _factor; ++i) {
@@ -121,11 +184,10 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	}
 
 	// Update old src
-	byte *oldSrc = _oldSrc + offset;
+	byte *oldSrc = _oldSrc + (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
 	while (height--) {
 		memcpy(oldSrc, srcPtr, width * _format.bytesPerPixel);
 		oldSrc += srcPitch;
 		srcPtr += srcPitch;
 	}
 }
-
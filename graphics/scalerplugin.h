@@ -94,6 +94,22 @@ public:
 		assert(0);
 	}
 
+	/**
+	 * Indicates whether the scaler can process disjoint horizontal bands of
+	 * a rect concurrently and still produce the same output as a single
+	 * call. This requires that scaling a row depends only on the source
+	 * rows within getBandContextRows() of it, the position passed in and
+	 * state that is not modified while scaling.
+	 */
+	virtual bool isBandSafe() const { return false; }
+
+	/**
+	 * The number of source rows above and below a band the scaler reads.
+	 * Used to keep bands large enough that the context stays small
+	 * relative to the work done per band.
+	 */
+	virtual uint getBandContextRows() const { return 0; }
+
 protected:
 	/**
 	 * @see scale
@@ -101,6 +117,21 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) = 0;
 
+	/**
+	 * Scale a rect by running scaleIntern on horizontal bands in parallel.
+	 * Only called for band-safe scalers.
+	 *
+	 * @see scale
+	 */
+	virtual void scaleInBands(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	                          uint32 dstPitch, int width, int height, int x, int y);
+
+	/**
+	 * Return the minimum number of source rows per band, or 0 if a rect
+	 * of the given height should not be split at all.
+	 */
+	uint getBandGrain(int height) const;
+
 	uint _factor;
 	Graphics::PixelFormat _format;
 };
@@ -127,6 +158,14 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) final;
 
+	/**
+	 * Runs internScale on the bands in parallel, then updates the old
+	 * source and the buffered output once all bands have been scaled,
+	 * since the bands read each other's old source context rows.
+	 */
+	virtual void scaleInBands(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	                          uint32 dstPitch, int width, int height, int x, int y) final;
+
 	/**
 	 * Scalers must implement this function. It will be called by oldSrcScale.
 	 * If by comparing the src and oldsrc images it is discovered that no change
@@ -141,6 +180,9 @@ protected:
 
 private:
 
+	void updateOldSource(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+	                     uint32 dstPitch, int width, int height, int x, int y);
+
 	int _width, _height, _padding;
 	bool _enable;
 	byte *_oldSrc;
@@ -23,18 +23,24 @@
 #include "common/algorithm.h"
 #include "graphics/screen.h"
 #include "graphics/palette.h"
+#include "graphics/region.h"
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+enum {
+	kDefaultDirtyMergeGap = 8,
+	kDefaultDirtyMaxRects = 64
+};
+
+Screen::Screen(): ManagedSurface(), _dirtyMergeGap(kDefaultDirtyMergeGap), _dirtyMaxRects(kDefaultDirtyMaxRects) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _dirtyMergeGap(kDefaultDirtyMergeGap), _dirtyMaxRects(kDefaultDirtyMaxRects) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _dirtyMergeGap(kDefaultDirtyMergeGap), _dirtyMaxRects(kDefaultDirtyMaxRects) {
 	create(width, height, pixelFormat);
 }
 
@@ -75,26 +81,27 @@ void Screen::makeAllDirty() {
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
-void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
+void Screen::setDirtyRectMerging(int maxGap, uint maxRects) {
+	_dirtyMergeGap = maxGap;
+	_dirtyMaxRects = MAX<uint>(maxRects, 1);
+}
 
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+void Screen::mergeDirtyRects() {
+	if (_dirtyRects.size() < 2)
+		return;
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
+	Common::Array<Common::Rect> rects;
+	rects.reserve(_dirtyRects.size());
+	for (Common::List<Common::Rect>::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+		rects.push_back(*i);
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+	Region region;
+	region.unite(rects.begin(), rects.size());
+	region.simplify(_dirtyMergeGap, _dirtyMaxRects);
 
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
-	}
+	_dirtyRects.clear();
+	for (uint i = 0; i < region.getRects().size(); i++)
+		_dirtyRects.push_back(region.getRects()[i]);
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
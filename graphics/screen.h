@@ -53,9 +53,20 @@ protected:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Dirty areas closer together than this many pixels are joined
+	 */
+	int _dirtyMergeGap;
+
+	/**
+	 * If there are more dirty areas than this, the whole bounding box is updated
+	 */
+	uint _dirtyMaxRects;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Replaces the dirty areas by non-overlapping rectangles covering them,
+	 * joining areas as set up by setDirtyRectMerging()
 	 */
 	void mergeDirtyRects();
 
@@ -79,6 +90,15 @@ public:
 	 */
 	void makeAllDirty();
 
+	/**
+	 * Set how aggressively dirty areas are combined before an update.
+	 * Joining areas means fewer, but larger, copies to the screen.
+	 *
+	 * @param maxGap	areas on the same rows at most this many pixels apart are joined
+	 * @param maxRects	if more areas remain, their bounding box is updated instead
+	 */
+	void setDirtyRectMerging(int maxGap, uint maxRects);
+
 	/**
 	 * Clear the current dirty rects list
 	 */
@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tile-diff.h"
+
+namespace Graphics {
+
+uint32 diffTiles(const byte *oldPixels, uint oldPitch, const byte *newPixels, uint newPitch,
+				 const Common::Rect &area, uint bytesPerPixel, Common::Array<Common::Rect> &changed) {
+	if (area.isEmpty())
+		return 0;
+
+	const int firstTile = area.left / kDiffTileSize;
+	const uint numTiles = (area.right - 1) / kDiffTileSize - firstTile + 1;
+
+	Common::Array<bool> dirty;
+	dirty.resize(numTiles);
+
+	// Indices of the rectangles ending at the bottom of the previous band,
+	// which can be extended down when the same tiles changed again.
+	Common::Array<uint> open, nowOpen;
+	uint32 changedArea = 0;
+
+	for (int top = area.top; top < area.bottom; ) {
+		const int bottom = MIN<int>((top / kDiffTileSize + 1) * kDiffTileSize, area.bottom);
+
+		for (uint i = 0; i < numTiles; ++i)
+			dirty[i] = false;
+
+		// Each tile is compared until its first differing line
+		uint numClean = numTiles;
+		for (int y = top; y < bottom && numClean; ++y) {
+			const byte *oldLine = oldPixels + y * oldPitch;
+			const byte *newLine = newPixels + (y - area.top) * newPitch;
+
+			for (uint i = 0; i < numTiles; ++i) {
+				if (dirty[i])
+					continue;
+
+				const int left = MAX<int>((firstTile + i) * kDiffTileSize, area.left);
+				const int right = MIN<int>((firstTile + i + 1) * kDiffTileSize, area.right);
+				if (memcmp(oldLine + left * bytesPerPixel, newLine + (left - area.left) * bytesPerPixel, (right - left) * bytesPerPixel)) {
+					dirty[i] = true;
+					--numClean;
+				}
+			}
+		}
+
+		// Turn runs of changed tiles into rectangles
+		nowOpen.clear();
+		for (uint i = 0; i < numTiles; ) {
+			if (!dirty[i]) {
+				++i;
+				continue;
+			}
+
+			uint end = i + 1;
+			while (end < numTiles && dirty[end])
+				++end;
+
+			const int left = MAX<int>((firstTile + i) * kDiffTileSize, area.left);
+			const int right = MIN<int>((firstTile + end) * kDiffTileSize, area.right);
+			changedArea += (right - left) * (bottom - top);
+
+			bool extended = false;
+			for (uint j = 0; j < open.size(); ++j) {
+				Common::Rect &r = changed[open[j]];
+				if (r.left == left && r.right == right) {
+					r.bottom = bottom;
+					nowOpen.push_back(open[j]);
+					extended = true;
+					break;
+				}
+			}
+
+			if (!extended) {
+				nowOpen.push_back(changed.size());
+				changed.push_back(Common::Rect(left, top, right, bottom));
+			}
+
+			i = end;
+		}
+
+		open.swap(nowOpen);
+		top = bottom;
+	}
+
+	return changedArea;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TILE_DIFF_H
+#define GRAPHICS_TILE_DIFF_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_tile_diff Tile diffing
+ * @ingroup graphics
+ *
+ * @brief Function for finding the changed parts of a frame.
+ *
+ * @{
+ */
+
+/** Width and height of the tiles compared by diffTiles(). */
+enum {
+	kDiffTileSize = 16
+};
+
+/**
+ * Compare new pixels for an area of a surface to the pixels currently in
+ * the surface. The comparison is done in tiles of kDiffTileSize pixels
+ * aligned to the surface origin. The changed tiles, clipped to @p area,
+ * are merged into few non-overlapping rectangles.
+ *
+ * @param oldPixels	 the pixel at the origin of the surface
+ * @param oldPitch	 width in bytes of one line of the surface
+ * @param newPixels	 the new pixel for the top left corner of @p area
+ * @param newPitch	 width in bytes of one line of the new pixels
+ * @param area		 the area of the surface the new pixels are for
+ * @param bytesPerPixel the size of a pixel in bytes
+ * @param changed	 receives the changed rectangles, after its current contents
+ *
+ * @return the number of pixels in the changed rectangles
+ */
+uint32 diffTiles(const byte *oldPixels, uint oldPitch, const byte *newPixels, uint newPitch,
+				 const Common::Rect &area, uint bytesPerPixel, Common::Array<Common::Rect> &changed);
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
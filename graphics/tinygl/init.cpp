@@ -348,11 +348,11 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	// color mask
 	color_mask_red = color_mask_green = color_mask_blue = color_mask_alpha = true;
 
-	_currentAllocatorIndex = 0;
-	_drawCallAllocator[0].initialize(drawCallMemorySize);
-	_drawCallAllocator[1].initialize(drawCallMemorySize);
+	_drawCallAllocator.setBlockSize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
+	_enableTiledRendering = false;
+	_tiledFrame = false;
 
 	TinyGL::Internal::tglBlitResetScissorRect();
 }
@@ -360,6 +360,7 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 void GLContext::deinit() {
 	disposeDrawCallLists();
 	disposeResources();
+	disposeTileContexts();
 
 	specbuf_cleanup();
 	for (int i = 0; i < 3; i++)
@@ -39,6 +39,11 @@ void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
+/**
+ * Rasterize the draw calls of the following frames in horizontal tiles on
+ * the thread pool. The output is identical to serial rendering.
+ */
+void enableTiledRendering(bool enable);
 void getSurfaceRef(Graphics::Surface &surface);
 Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat);
 
@@ -95,19 +95,59 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
+	_ownsBuffers = true;
 
 	_currentTexture = nullptr;
 
 	_enableScissor = false;
+
+	_spanProcs = getZBufferSpanProcs();
+}
+
+FrameBuffer *FrameBuffer::createView(const FrameBuffer &target) {
+	FrameBuffer *view = new FrameBuffer(target);
+	view->_ownsBuffers = false;
+	return view;
 }
 
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+ZBufferSpanProc FrameBuffer::selectSpanProc(ZBufferSpanState &state, bool depthTest, bool depthWrite, bool blending, bool texture) const {
+	if (!_spanProcs || _pbufBpp != 4)
+		return nullptr;
+	if (_pbufFormat.rLoss || _pbufFormat.gLoss || _pbufFormat.bLoss || (_pbufFormat.aLoss != 0 && _pbufFormat.aLoss != 8))
+		return nullptr;
+	if (depthTest && _depthFunc != TGL_LESS)
+		return nullptr;
+	if (blending && (_sourceBlendingFactor != TGL_SRC_ALPHA || _destinationBlendingFactor != TGL_ONE_MINUS_SRC_ALPHA))
+		return nullptr;
+
+	state.depthTest = depthTest;
+	state.depthWrite = depthWrite;
+	state.blending = blending;
+	state.texture = texture;
+	if (_enableScissor) {
+		state.clipLeft = _clipRectangle.left;
+		state.clipRight = _clipRectangle.right;
+	} else {
+		state.clipLeft = 0;
+		state.clipRight = _pbufWidth;
+	}
+	state.aLoss = _pbufFormat.aLoss;
+	state.aShift = _pbufFormat.aShift;
+	state.rShift = _pbufFormat.rShift;
+	state.gShift = _pbufFormat.gShift;
+	state.bShift = _pbufFormat.bShift;
+	return _spanProcs[depthTest | depthWrite << 1 | blending << 2 | texture << 3];
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
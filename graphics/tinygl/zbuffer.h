@@ -31,6 +31,7 @@
 #include "graphics/surface.h"
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
 
 #include "common/rect.h"
 
@@ -106,6 +107,13 @@ struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
 	~FrameBuffer();
 
+	/**
+	 * Create a frame buffer that renders into the pixel, depth and stencil
+	 * buffers currently selected in @p target, but has its own render state.
+	 * Views allow rasterizing disjoint tiles of a frame on several threads.
+	 */
+	static FrameBuffer *createView(const FrameBuffer &target);
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -372,6 +380,13 @@ private:
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kDepthTestEnabled>
 	void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
 
+	/**
+	 * Return the span kernel for the current state, or nullptr if the
+	 * kernels do not support the pixel format or the depth and blending
+	 * functions. Fills in @p state for the kernel.
+	 */
+	ZBufferSpanProc selectSpanProc(ZBufferSpanState &state, bool depthTest, bool depthWrite, bool blending, bool texture) const;
+
 
 	template <bool kEnableAlphaTest>
 	FORCEINLINE void writePixel(int pixel, int value) {
@@ -390,6 +405,10 @@ private:
 		return !_clipRectangle.contains(x, y);
 	}
 
+	FORCEINLINE bool scissorLine(int y) {
+		return y < _clipRectangle.top || y >= _clipRectangle.bottom;
+	}
+
 public:
 
 	FORCEINLINE void writePixel(int pixel, byte aSrc, byte rSrc, byte gSrc, byte bSrc) {
@@ -741,6 +760,7 @@ private:
 	void drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2);
 
 	Buffer _offscreenBuffer;
+	bool _ownsBuffers;
 	byte *_pbuf;
 	int _pbufWidth;
 	int _pbufHeight;
@@ -758,6 +778,8 @@ private:
 	Common::Rect _clipRectangle;
 	bool _enableScissor;
 
+	const ZBufferSpanProc *_spanProcs;
+
 	const TexelBuffer *_currentTexture;
 	uint _wrapS, _wrapT;
 	bool _blendingEnabled;
@@ -25,6 +25,8 @@
 
 #include "common/debug.h"
 #include "common/math.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace TinyGL {
 
@@ -193,12 +195,20 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		if (canRenderTiled()) {
+			Common::Array<Common::Rect> regions;
 			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
+				regions.push_back((*itRect).rectangle);
+			}
+			executeDrawCallsTiled(regions);
+		} else {
+			for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+				Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+				for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
+					Common::Rect dirtyRegion = (*itRect).rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						(*it)->execute(dirtyRegion, true);
+					}
 				}
 			}
 		}
@@ -231,8 +241,8 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 
 	disposeResources();
 
-	_currentAllocatorIndex = (_currentAllocatorIndex + 1) & 0x1;
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_drawCallAllocator.nextFrame();
+	_tiledFrame = _enableTiledRendering;
 }
 
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
@@ -240,16 +250,124 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
-	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-		(*it)->execute(true);
-		delete *it;
+	if (canRenderTiled()) {
+		executeDrawCallsTiled(Common::Array<Common::Rect>(1, renderRect));
+		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+			delete *it;
+		}
+	} else {
+		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+			(*it)->execute(true);
+			delete *it;
+		}
 	}
 
 	_drawCallsQueue.clear();
 
 	disposeResources();
 
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_drawCallAllocator.current().reset();
+	_tiledFrame = _enableTiledRendering;
+}
+
+bool GLContext::canRenderTiled() const {
+	// The draw calls of a frame only all have a dirty region if tiling was
+	// already enabled when the frame started. Selection and profiling
+	// update shared counters, so they are left to the serial path.
+	return _enableTiledRendering && _tiledFrame && render_mode == TGL_RENDER && !_profilingEnabled;
+}
+
+void GLContext::prepareTileContexts(uint count) {
+	while (_tileContexts.size() < count) {
+		GLContext *tile = new GLContext();
+		tile->vertex_max = POLYGON_MAX_VERTEX;
+		tile->vertex = (GLVertex *)gl_malloc(POLYGON_MAX_VERTEX * sizeof(GLVertex));
+		_tileContexts.push_back(tile);
+	}
+
+	// Draw calls apply their own state, only what they do not capture
+	// has to be copied. The views pick up the currently selected buffers.
+	for (uint i = 0; i < count; i++) {
+		GLContext *tile = _tileContexts[i];
+		delete tile->fb;
+		tile->fb = FrameBuffer::createView(*fb);
+		tile->renderRect = renderRect;
+		tile->render_mode = render_mode;
+		tile->current_cull_face = current_cull_face;
+		tile->vertex_n = vertex_n;
+	}
+}
+
+void GLContext::disposeTileContexts() {
+	for (uint i = 0; i < _tileContexts.size(); i++) {
+		delete _tileContexts[i]->fb;
+		gl_free(_tileContexts[i]->vertex);
+		delete _tileContexts[i];
+	}
+	_tileContexts.clear();
+}
+
+void GLContext::executeDrawCallsTiled(const Common::Array<Common::Rect> &regions) {
+	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+
+	// Two tiles per thread help balancing frames where most of the geometry
+	// is in one part of the screen
+	static const int kMinTileHeight = 16;
+	Common::ThreadPool &pool = g_system->getThreadPool();
+	const int height = renderRect.height();
+	const uint tileCount = CLIP<uint>(pool.getConcurrency() * 2, 1, MAX(1, height / kMinTileHeight));
+	prepareTileContexts(tileCount);
+
+	DrawCallIterator it = _drawCallsQueue.begin();
+	const DrawCallIterator end = _drawCallsQueue.end();
+	while (it != end) {
+		// Rasterizations and clears up to the next blit are executed tile by tile
+		const DrawCallIterator batchBegin = it;
+		while (it != end && (*it)->getType() != DrawCall::DrawCall_Blitting) {
+			++it;
+		}
+		const DrawCallIterator batchEnd = it;
+
+		if (batchBegin != batchEnd) {
+			pool.parallelFor(0, tileCount, 1, [&](uint first, uint last) {
+				for (uint i = first; i < last; i++) {
+					GLContext *tile = _tileContexts[i];
+					const Common::Rect tileRect(renderRect.left, renderRect.top + height * i / tileCount,
+					                            renderRect.right, renderRect.top + height * (i + 1) / tileCount);
+
+					for (DrawCallIterator call = batchBegin; call != batchEnd; ++call) {
+						const Common::Rect callRegion = (*call)->getDirtyRegion();
+						for (uint r = 0; r < regions.size(); r++) {
+							const Common::Rect clip = regions[r].findIntersectingRect(tileRect);
+							if (clip.isEmpty() || !clip.intersects(callRegion))
+								continue;
+							if ((*call)->getType() == DrawCall::DrawCall_Rasterization) {
+								((const RasterizationDrawCall *)*call)->executeTile(tile, clip);
+							} else {
+								((const ClearBufferDrawCall *)*call)->executeTile(tile, clip);
+							}
+						}
+					}
+				}
+			});
+		}
+
+		// Blits use the blitting state of this context, so they run here
+		// once all tiles have caught up
+		if (it != end) {
+			const Common::Rect callRegion = (*it)->getDirtyRegion();
+			for (uint r = 0; r < regions.size(); r++) {
+				if (regions[r].intersects(callRegion)) {
+					(*it)->execute(regions[r], true);
+				}
+			}
+			++it;
+		}
+	}
+}
+
+void enableTiledRendering(bool enable) {
+	gl_get_context()->_enableTiledRendering = enable;
 }
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
@@ -295,7 +413,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
 	_state = captureState();
-	if (c->_enableDirtyRectangles) {
+	if (c->_enableDirtyRectangles || c->_enableTiledRendering) {
 		computeDirtyRegion();
 	}
 }
@@ -340,13 +458,43 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	if (restoreState) {
 		backupState = captureState();
 	}
-	applyState(_state);
+	applyState(c, _state);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
 	c->vertex = _vertex;
 	c->vertex_cnt = _vertexCount;
+	rasterize(c);
+
+	c->vertex = prevVertex;
+	c->vertex_cnt = prevVertexCount;
+
+	if (restoreState) {
+		applyState(c, backupState);
+	}
+}
+
+void RasterizationDrawCall::executeTile(GLContext *c, const Common::Rect &clippingRectangle) const {
+	applyState(c, _state);
+
+	// Rasterization writes to the vertices, so every tile works on a copy
+	if (_vertexCount > c->vertex_max) {
+		c->vertex_max = _vertexCount;
+		c->vertex = (GLVertex *)gl_realloc(c->vertex, sizeof(GLVertex) * c->vertex_max);
+	}
+	GLVertex *vertex = c->vertex;
+	memcpy(vertex, _vertex, sizeof(GLVertex) * _vertexCount);
+	c->vertex_cnt = _vertexCount;
+
+	c->fb->setScissorRectangle(clippingRectangle);
+	rasterize(c);
+	c->fb->resetScissorRectangle();
+
+	c->vertex = vertex;
+}
+
+void RasterizationDrawCall::rasterize(GLContext *c) const {
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
 
@@ -424,13 +572,6 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	default:
 		error("glBegin: type %x not handled", c->begin_type);
 	}
-
-	c->vertex = prevVertex;
-	c->vertex_cnt = prevVertexCount;
-
-	if (restoreState) {
-		applyState(backupState);
-	}
 }
 
 RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
@@ -484,8 +625,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableAlphaTest(state.alphaTestEnabled);
@@ -573,7 +713,8 @@ BlittingDrawCall::BlittingDrawCall(BlitImage *image, const BlitTransform &transf
 	tglIncBlitImageRef(image);
 	_blitState = captureState();
 	_imageVersion = tglGetBlitImageVersion(image);
-	if (gl_get_context()->_enableDirtyRectangles) {
+	GLContext *c = gl_get_context();
+	if (c->_enableDirtyRectangles || c->_enableTiledRendering) {
 		computeDirtyRegion();
 	}
 }
@@ -690,7 +831,7 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue,
 	  _rValue(rValue), _gValue(gValue), _bValue(bValue), _clearStencilBuffer(clearStencilBuffer),
 	  _stencilValue(stencilValue), DrawCall(DrawCall_Clear) {
 	TinyGL::GLContext *c = gl_get_context();
-	if (c->_enableDirtyRectangles) {
+	if (c->_enableDirtyRectangles || c->_enableTiledRendering) {
 		_dirtyRegion = c->renderRect;
 	}
 }
@@ -701,7 +842,10 @@ void ClearBufferDrawCall::execute(bool restoreState) const {
 }
 
 void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool restoreState) const {
-	TinyGL::GLContext *c = gl_get_context();
+	executeTile(gl_get_context(), clippingRectangle);
+}
+
+void ClearBufferDrawCall::executeTile(GLContext *c, const Common::Rect &clippingRectangle) const {
 	Common::Rect clearRect = clippingRectangle.findIntersectingRect(getDirtyRegion());
 	c->fb->clearRegion(clearRect.left, clearRect.top, clearRect.width(), clearRect.height(),
 	                   _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue,
@@ -771,7 +915,7 @@ bool RasterizationDrawCall::RasterizationState::operator==(const RasterizationSt
 
 void *Internal::allocateFrame(int size) {
 	GLContext *c = gl_get_context();
-	return c->_drawCallAllocator[c->_currentAllocatorIndex].allocate(size);
+	return c->_drawCallAllocator.allocate(size);
 }
 
 } // end of namespace TinyGL
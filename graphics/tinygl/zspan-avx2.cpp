@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tinygl/zspan.h"
+
+#include <immintrin.h>
+
+namespace TinyGL {
+
+namespace {
+
+/** Return the start values of eight consecutive pixels. */
+inline __m256i ramp(uint start, int step) {
+	return _mm256_add_epi32(_mm256_set1_epi32(start), _mm256_mullo_epi32(_mm256_set1_epi32(step), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+}
+
+/** Byte of an interpolated color, (value >> 8) & 0xFF. */
+inline __m256i colorByte(__m256i value, __m256i byteMask) {
+	return _mm256_and_si256(_mm256_srli_epi32(value, 8), byteMask);
+}
+
+/** Modulate a texel channel by an interpolated light value. */
+inline __m256i modulate(__m256i texel, int channelShift, __m256i light, __m256i byteMask) {
+	const __m256i channel = _mm256_and_si256(_mm256_srli_epi32(texel, channelShift), byteMask);
+	return _mm256_and_si256(_mm256_srli_epi32(_mm256_mullo_epi32(channel, _mm256_srli_epi32(light, 8)), 8), byteMask);
+}
+
+/** src * alpha / 256 + dst * (255 - alpha) / 256, saturated to 255. */
+inline __m256i blendChannel(__m256i src, __m256i dst, __m256i alpha, __m256i invAlpha, __m256i byteMask) {
+	const __m256i sum = _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi16(src, alpha), 8),
+	                                     _mm256_srli_epi32(_mm256_mullo_epi16(dst, invAlpha), 8));
+	return _mm256_min_epu32(sum, byteMask);
+}
+
+template<bool kDepthTest, bool kDepthWrite, bool kBlending, bool kTexture>
+void fillSpan(const ZBufferSpanState &state, const ZBufferSpan &span) {
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i signBit = _mm256_set1_epi32((int)0x80000000);
+	const __m128i aLoss = _mm_cvtsi32_si128(state.aLoss);
+	const __m128i aShift = _mm_cvtsi32_si128(state.aShift);
+	const __m128i rShift = _mm_cvtsi32_si128(state.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(state.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(state.bShift);
+	const __m256i clipLeft = _mm256_set1_epi32(state.clipLeft - 1);
+	const __m256i clipRight = _mm256_set1_epi32(state.clipRight);
+
+	__m256i x = ramp(span.x, 1);
+	__m256i z = ramp(span.z, span.dzdx);
+	__m256i r = ramp(span.r, span.drdx);
+	__m256i g = ramp(span.g, span.dgdx);
+	__m256i b = ramp(span.b, span.dbdx);
+	__m256i a = ramp(span.a, span.dadx);
+	const __m256i dz = _mm256_set1_epi32(span.dzdx * 8);
+	const __m256i dr = _mm256_set1_epi32(span.drdx * 8);
+	const __m256i dg = _mm256_set1_epi32(span.dgdx * 8);
+	const __m256i db = _mm256_set1_epi32(span.dbdx * 8);
+	const __m256i da = _mm256_set1_epi32(span.dadx * 8);
+
+	int i = 0;
+	for (; i + 8 <= span.count; i += 8) {
+		__m256i mask = _mm256_and_si256(_mm256_cmpgt_epi32(x, clipLeft), _mm256_cmpgt_epi32(clipRight, x));
+		__m256i depth;
+		if (kDepthTest || kDepthWrite) {
+			depth = _mm256_loadu_si256((const __m256i *)(span.depth + i));
+		}
+		if (kDepthTest) {
+			// Unsigned depth[i] < z
+			mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(_mm256_xor_si256(z, signBit), _mm256_xor_si256(depth, signBit)));
+		}
+
+		if (!_mm256_testz_si256(mask, mask)) {
+			__m256i ca, cr, cg, cb;
+			if (kTexture) {
+				const __m256i texel = _mm256_loadu_si256((const __m256i *)(span.texels + i));
+				ca = modulate(texel, 24, a, byteMask);
+				cr = modulate(texel, 16, r, byteMask);
+				cg = modulate(texel, 8, g, byteMask);
+				cb = modulate(texel, 0, b, byteMask);
+			} else {
+				ca = colorByte(a, byteMask);
+				cr = colorByte(r, byteMask);
+				cg = colorByte(g, byteMask);
+				cb = colorByte(b, byteMask);
+			}
+
+			const __m256i dst = _mm256_loadu_si256((const __m256i *)(span.pixels + i));
+			if (kBlending) {
+				const __m256i invAlpha = _mm256_sub_epi32(byteMask, ca);
+				cr = blendChannel(cr, _mm256_and_si256(_mm256_srl_epi32(dst, rShift), byteMask), ca, invAlpha, byteMask);
+				cg = blendChannel(cg, _mm256_and_si256(_mm256_srl_epi32(dst, gShift), byteMask), ca, invAlpha, byteMask);
+				cb = blendChannel(cb, _mm256_and_si256(_mm256_srl_epi32(dst, bShift), byteMask), ca, invAlpha, byteMask);
+				ca = byteMask;
+			}
+			const __m256i color = _mm256_or_si256(
+				_mm256_or_si256(_mm256_sll_epi32(_mm256_srl_epi32(ca, aLoss), aShift), _mm256_sll_epi32(cr, rShift)),
+				_mm256_or_si256(_mm256_sll_epi32(cg, gShift), _mm256_sll_epi32(cb, bShift)));
+			_mm256_storeu_si256((__m256i *)(span.pixels + i), _mm256_blendv_epi8(dst, color, mask));
+
+			if (kDepthWrite) {
+				// The scalar code stores the depth through a float
+				const __m256i rounded = _mm256_cvttps_epi32(_mm256_cvtepi32_ps(z));
+				_mm256_storeu_si256((__m256i *)(span.depth + i), _mm256_blendv_epi8(depth, rounded, mask));
+			}
+		}
+
+		x = _mm256_add_epi32(x, _mm256_set1_epi32(8));
+		z = _mm256_add_epi32(z, dz);
+		r = _mm256_add_epi32(r, dr);
+		g = _mm256_add_epi32(g, dg);
+		b = _mm256_add_epi32(b, db);
+		a = _mm256_add_epi32(a, da);
+	}
+
+	fillSpanPixels(state, span, i);
+}
+
+} // End of anonymous namespace
+
+const ZBufferSpanProc zbufferSpanProcsAVX2[kZBufferSpanProcCount] = {
+	fillSpan<false, false, false, false>, fillSpan<true, false, false, false>,
+	fillSpan<false, true, false, false>, fillSpan<true, true, false, false>,
+	fillSpan<false, false, true, false>, fillSpan<true, false, true, false>,
+	fillSpan<false, true, true, false>, fillSpan<true, true, true, false>,
+	fillSpan<false, false, false, true>, fillSpan<true, false, false, true>,
+	fillSpan<false, true, false, true>, fillSpan<true, true, false, true>,
+	fillSpan<false, false, true, true>, fillSpan<true, false, true, true>,
+	fillSpan<false, true, true, true>, fillSpan<true, true, true, true>
+};
+
+} // end of namespace TinyGL
@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tinygl/zspan.h"
+
+#include <arm_neon.h>
+
+namespace TinyGL {
+
+namespace {
+
+/** Return the start values of four consecutive pixels. */
+inline uint32x4_t ramp(uint start, int step) {
+	static const uint32 kLanes[4] = { 0, 1, 2, 3 };
+	return vmlaq_n_u32(vdupq_n_u32(start), vld1q_u32(kLanes), (uint32)step);
+}
+
+/** Whether any lane of @p mask is set, also on 32 bit ARM. */
+inline bool anyLane(uint32x4_t mask) {
+	const uint32x2_t halves = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+	return vget_lane_u32(vpmax_u32(halves, halves), 0) != 0;
+}
+
+/** Byte of an interpolated color, (value >> 8) & 0xFF. */
+inline uint32x4_t colorByte(uint32x4_t value, uint32x4_t byteMask) {
+	return vandq_u32(vshrq_n_u32(value, 8), byteMask);
+}
+
+/** Modulate a texel channel by an interpolated light value. */
+template<int kChannelShift>
+inline uint32x4_t modulate(uint32x4_t texel, uint32x4_t light, uint32x4_t byteMask) {
+	const uint32x4_t channel = vandq_u32(vshrq_n_u32(texel, kChannelShift), byteMask);
+	return vandq_u32(vshrq_n_u32(vmulq_u32(channel, vshrq_n_u32(light, 8)), 8), byteMask);
+}
+
+/** Extract the channel at the (variable) @p shift, given negated. */
+inline uint32x4_t channelAt(uint32x4_t pixels, int32x4_t negShift, uint32x4_t byteMask) {
+	return vandq_u32(vshlq_u32(pixels, negShift), byteMask);
+}
+
+/** src * alpha / 256 + dst * (255 - alpha) / 256, saturated to 255. */
+inline uint32x4_t blendChannel(uint32x4_t src, uint32x4_t dst, uint32x4_t alpha, uint32x4_t invAlpha, uint32x4_t byteMask) {
+	const uint32x4_t sum = vaddq_u32(vshrq_n_u32(vmulq_u32(src, alpha), 8), vshrq_n_u32(vmulq_u32(dst, invAlpha), 8));
+	return vminq_u32(sum, byteMask);
+}
+
+template<bool kDepthTest, bool kDepthWrite, bool kBlending, bool kTexture>
+void fillSpan(const ZBufferSpanState &state, const ZBufferSpan &span) {
+	const uint32x4_t byteMask = vdupq_n_u32(0xFF);
+	const int32x4_t aLoss = vdupq_n_s32(-(int)state.aLoss);
+	const int32x4_t aShift = vdupq_n_s32(state.aShift);
+	const int32x4_t rShift = vdupq_n_s32(state.rShift);
+	const int32x4_t gShift = vdupq_n_s32(state.gShift);
+	const int32x4_t bShift = vdupq_n_s32(state.bShift);
+	const int32x4_t clipLeft = vdupq_n_s32(state.clipLeft);
+	const int32x4_t clipRight = vdupq_n_s32(state.clipRight);
+
+	int32x4_t x = vreinterpretq_s32_u32(ramp(span.x, 1));
+	uint32x4_t z = ramp(span.z, span.dzdx);
+	uint32x4_t r = ramp(span.r, span.drdx);
+	uint32x4_t g = ramp(span.g, span.dgdx);
+	uint32x4_t b = ramp(span.b, span.dbdx);
+	uint32x4_t a = ramp(span.a, span.dadx);
+	const uint32x4_t dz = vdupq_n_u32(span.dzdx * 4);
+	const uint32x4_t dr = vdupq_n_u32(span.drdx * 4);
+	const uint32x4_t dg = vdupq_n_u32(span.dgdx * 4);
+	const uint32x4_t db = vdupq_n_u32(span.dbdx * 4);
+	const uint32x4_t da = vdupq_n_u32(span.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= span.count; i += 4) {
+		uint32x4_t mask = vandq_u32(vcgeq_s32(x, clipLeft), vcltq_s32(x, clipRight));
+		uint32x4_t depth;
+		if (kDepthTest || kDepthWrite) {
+			depth = vld1q_u32(span.depth + i);
+		}
+		if (kDepthTest) {
+			mask = vandq_u32(mask, vcltq_u32(depth, z));
+		}
+
+		if (anyLane(mask)) {
+			uint32x4_t ca, cr, cg, cb;
+			if (kTexture) {
+				const uint32x4_t texel = vld1q_u32(span.texels + i);
+				ca = modulate<24>(texel, a, byteMask);
+				cr = modulate<16>(texel, r, byteMask);
+				cg = modulate<8>(texel, g, byteMask);
+				cb = modulate<0>(texel, b, byteMask);
+			} else {
+				ca = colorByte(a, byteMask);
+				cr = colorByte(r, byteMask);
+				cg = colorByte(g, byteMask);
+				cb = colorByte(b, byteMask);
+			}
+
+			const uint32x4_t dst = vld1q_u32(span.pixels + i);
+			if (kBlending) {
+				const uint32x4_t invAlpha = vsubq_u32(byteMask, ca);
+				cr = blendChannel(cr, channelAt(dst, vnegq_s32(rShift), byteMask), ca, invAlpha, byteMask);
+				cg = blendChannel(cg, channelAt(dst, vnegq_s32(gShift), byteMask), ca, invAlpha, byteMask);
+				cb = blendChannel(cb, channelAt(dst, vnegq_s32(bShift), byteMask), ca, invAlpha, byteMask);
+				ca = byteMask;
+			}
+			const uint32x4_t color = vorrq_u32(
+				vorrq_u32(vshlq_u32(vshlq_u32(ca, aLoss), aShift), vshlq_u32(cr, rShift)),
+				vorrq_u32(vshlq_u32(cg, gShift), vshlq_u32(cb, bShift)));
+			vst1q_u32(span.pixels + i, vbslq_u32(mask, color, dst));
+
+			if (kDepthWrite) {
+				// The scalar code stores the depth through a float
+				const uint32x4_t rounded = vreinterpretq_u32_s32(vcvtq_s32_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(z))));
+				vst1q_u32(span.depth + i, vbslq_u32(mask, rounded, depth));
+			}
+		}
+
+		x = vaddq_s32(x, vdupq_n_s32(4));
+		z = vaddq_u32(z, dz);
+		r = vaddq_u32(r, dr);
+		g = vaddq_u32(g, dg);
+		b = vaddq_u32(b, db);
+		a = vaddq_u32(a, da);
+	}
+
+	fillSpanPixels(state, span, i);
+}
+
+} // End of anonymous namespace
+
+const ZBufferSpanProc zbufferSpanProcsNEON[kZBufferSpanProcCount] = {
+	fillSpan<false, false, false, false>, fillSpan<true, false, false, false>,
+	fillSpan<false, true, false, false>, fillSpan<true, true, false, false>,
+	fillSpan<false, false, true, false>, fillSpan<true, false, true, false>,
+	fillSpan<false, true, true, false>, fillSpan<true, true, true, false>,
+	fillSpan<false, false, false, true>, fillSpan<true, false, false, true>,
+	fillSpan<false, true, false, true>, fillSpan<true, true, false, true>,
+	fillSpan<false, false, true, true>, fillSpan<true, false, true, true>,
+	fillSpan<false, true, true, true>, fillSpan<true, true, true, true>
+};
+
+} // end of namespace TinyGL
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tinygl/zspan.h"
+
+#include <emmintrin.h>
+
+namespace TinyGL {
+
+namespace {
+
+/** Multiply 32 bit lanes and keep the low halves of the products. */
+inline __m128i mullo32(__m128i a, __m128i b) {
+	const __m128i even = _mm_mul_epu32(a, b);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/** Return the start values of four consecutive pixels. */
+inline __m128i ramp(uint start, int step) {
+	return _mm_add_epi32(_mm_set1_epi32(start), _mm_setr_epi32(0, step, step * 2, step * 3));
+}
+
+/** Byte of an interpolated color, (value >> 8) & 0xFF. */
+inline __m128i colorByte(__m128i value, __m128i byteMask) {
+	return _mm_and_si128(_mm_srli_epi32(value, 8), byteMask);
+}
+
+/** Modulate a texel channel by an interpolated light value. */
+inline __m128i modulate(__m128i texel, int channelShift, __m128i light, __m128i byteMask) {
+	const __m128i channel = _mm_and_si128(_mm_srli_epi32(texel, channelShift), byteMask);
+	return _mm_and_si128(_mm_srli_epi32(mullo32(channel, _mm_srli_epi32(light, 8)), 8), byteMask);
+}
+
+/** Shift the channel of all lanes into place. */
+inline __m128i place(__m128i channel, __m128i shift) {
+	return _mm_sll_epi32(channel, shift);
+}
+
+/** src * alpha / 256 + dst * (255 - alpha) / 256, saturated to 255. */
+inline __m128i blendChannel(__m128i src, __m128i dst, __m128i alpha, __m128i invAlpha) {
+	// The products fit in 16 bits and the upper halves of the lanes are zero
+	const __m128i sum = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(src, alpha), 8),
+	                                  _mm_srli_epi32(_mm_mullo_epi16(dst, invAlpha), 8));
+	return _mm_min_epi16(sum, _mm_set1_epi32(255));
+}
+
+template<bool kDepthTest, bool kDepthWrite, bool kBlending, bool kTexture>
+void fillSpan(const ZBufferSpanState &state, const ZBufferSpan &span) {
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i signBit = _mm_set1_epi32((int)0x80000000);
+	const __m128i aLoss = _mm_cvtsi32_si128(state.aLoss);
+	const __m128i aShift = _mm_cvtsi32_si128(state.aShift);
+	const __m128i rShift = _mm_cvtsi32_si128(state.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(state.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(state.bShift);
+	const __m128i clipLeft = _mm_set1_epi32(state.clipLeft - 1);
+	const __m128i clipRight = _mm_set1_epi32(state.clipRight);
+
+	__m128i x = ramp(span.x, 1);
+	__m128i z = ramp(span.z, span.dzdx);
+	__m128i r = ramp(span.r, span.drdx);
+	__m128i g = ramp(span.g, span.dgdx);
+	__m128i b = ramp(span.b, span.dbdx);
+	__m128i a = ramp(span.a, span.dadx);
+	const __m128i dz = _mm_set1_epi32(span.dzdx * 4);
+	const __m128i dr = _mm_set1_epi32(span.drdx * 4);
+	const __m128i dg = _mm_set1_epi32(span.dgdx * 4);
+	const __m128i db = _mm_set1_epi32(span.dbdx * 4);
+	const __m128i da = _mm_set1_epi32(span.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= span.count; i += 4) {
+		__m128i mask = _mm_and_si128(_mm_cmpgt_epi32(x, clipLeft), _mm_cmplt_epi32(x, clipRight));
+		__m128i depth;
+		if (kDepthTest || kDepthWrite) {
+			depth = _mm_loadu_si128((const __m128i *)(span.depth + i));
+		}
+		if (kDepthTest) {
+			// Unsigned depth[i] < z
+			mask = _mm_and_si128(mask, _mm_cmpgt_epi32(_mm_xor_si128(z, signBit), _mm_xor_si128(depth, signBit)));
+		}
+
+		if (_mm_movemask_epi8(mask)) {
+			__m128i ca, cr, cg, cb;
+			if (kTexture) {
+				const __m128i texel = _mm_loadu_si128((const __m128i *)(span.texels + i));
+				ca = modulate(texel, 24, a, byteMask);
+				cr = modulate(texel, 16, r, byteMask);
+				cg = modulate(texel, 8, g, byteMask);
+				cb = modulate(texel, 0, b, byteMask);
+			} else {
+				ca = colorByte(a, byteMask);
+				cr = colorByte(r, byteMask);
+				cg = colorByte(g, byteMask);
+				cb = colorByte(b, byteMask);
+			}
+
+			const __m128i dst = _mm_loadu_si128((const __m128i *)(span.pixels + i));
+			__m128i color;
+			if (kBlending) {
+				const __m128i invAlpha = _mm_sub_epi32(byteMask, ca);
+				cr = blendChannel(cr, _mm_and_si128(_mm_srl_epi32(dst, rShift), byteMask), ca, invAlpha);
+				cg = blendChannel(cg, _mm_and_si128(_mm_srl_epi32(dst, gShift), byteMask), ca, invAlpha);
+				cb = blendChannel(cb, _mm_and_si128(_mm_srl_epi32(dst, bShift), byteMask), ca, invAlpha);
+				ca = byteMask;
+			}
+			color = _mm_or_si128(_mm_or_si128(place(_mm_srl_epi32(ca, aLoss), aShift), place(cr, rShift)),
+			                     _mm_or_si128(place(cg, gShift), place(cb, bShift)));
+			color = _mm_or_si128(_mm_and_si128(mask, color), _mm_andnot_si128(mask, dst));
+			_mm_storeu_si128((__m128i *)(span.pixels + i), color);
+
+			if (kDepthWrite) {
+				// The scalar code stores the depth through a float
+				const __m128i rounded = _mm_cvttps_epi32(_mm_cvtepi32_ps(z));
+				depth = _mm_or_si128(_mm_and_si128(mask, rounded), _mm_andnot_si128(mask, depth));
+				_mm_storeu_si128((__m128i *)(span.depth + i), depth);
+			}
+		}
+
+		x = _mm_add_epi32(x, _mm_set1_epi32(4));
+		z = _mm_add_epi32(z, dz);
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+		a = _mm_add_epi32(a, da);
+	}
+
+	fillSpanPixels(state, span, i);
+}
+
+} // End of anonymous namespace
+
+const ZBufferSpanProc zbufferSpanProcsSSE2[kZBufferSpanProcCount] = {
+	fillSpan<false, false, false, false>, fillSpan<true, false, false, false>,
+	fillSpan<false, true, false, false>, fillSpan<true, true, false, false>,
+	fillSpan<false, false, true, false>, fillSpan<true, false, true, false>,
+	fillSpan<false, true, true, false>, fillSpan<true, true, true, false>,
+	fillSpan<false, false, false, true>, fillSpan<true, false, false, true>,
+	fillSpan<false, true, false, true>, fillSpan<true, true, false, true>,
+	fillSpan<false, false, true, true>, fillSpan<true, false, true, true>,
+	fillSpan<false, true, true, true>, fillSpan<true, true, true, true>
+};
+
+} // end of namespace TinyGL
@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+
+#include "graphics/tinygl/zspan.h"
+
+namespace TinyGL {
+
+// Mirrors putPixelNoTexture() and putPixelTexture() for the supported states
+void fillSpanPixels(const ZBufferSpanState &state, const ZBufferSpan &span, int first) {
+	for (int i = first; i < span.count; i++) {
+		const int x = span.x + i;
+		if (x < state.clipLeft || x >= state.clipRight)
+			continue;
+
+		const uint z = span.z + i * (uint)span.dzdx;
+		if (state.depthTest && !(span.depth[i] < z))
+			continue;
+
+		uint a = ((span.a + i * (uint)span.dadx) >> 8) & 0xFF;
+		uint r = ((span.r + i * (uint)span.drdx) >> 8) & 0xFF;
+		uint g = ((span.g + i * (uint)span.dgdx) >> 8) & 0xFF;
+		uint b = ((span.b + i * (uint)span.dbdx) >> 8) & 0xFF;
+		if (state.texture) {
+			const uint32 texel = span.texels[i];
+			a = (((texel >> 24) & 0xFF) * ((span.a + i * (uint)span.dadx) >> 8) >> 8) & 0xFF;
+			r = (((texel >> 16) & 0xFF) * ((span.r + i * (uint)span.drdx) >> 8) >> 8) & 0xFF;
+			g = (((texel >> 8) & 0xFF) * ((span.g + i * (uint)span.dgdx) >> 8) >> 8) & 0xFF;
+			b = ((texel & 0xFF) * ((span.b + i * (uint)span.dbdx) >> 8) >> 8) & 0xFF;
+		}
+
+		if (state.depthWrite)
+			span.depth[i] = (uint)(float)z;
+
+		if (state.blending) {
+			const uint32 dst = span.pixels[i];
+			const uint rDst = ((dst >> state.rShift) & 0xFF) * (255 - a) >> 8;
+			const uint gDst = ((dst >> state.gShift) & 0xFF) * (255 - a) >> 8;
+			const uint bDst = ((dst >> state.bShift) & 0xFF) * (255 - a) >> 8;
+			r = MIN<uint>(((r * a) >> 8) + rDst, 255);
+			g = MIN<uint>(((g * a) >> 8) + gDst, 255);
+			b = MIN<uint>(((b * a) >> 8) + bDst, 255);
+			a = 255;
+		}
+		span.pixels[i] = ((a >> state.aLoss) << state.aShift) | (r << state.rShift) | (g << state.gShift) | (b << state.bShift);
+	}
+}
+
+const ZBufferSpanProc *getZBufferSpanProcs() {
+#ifdef SCUMMVM_AVX2
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureAVX2))
+		return zbufferSpanProcsAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return zbufferSpanProcsSSE2;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureSSE2))
+		return zbufferSpanProcsSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return zbufferSpanProcsNEON;
+#else
+	if (g_system && g_system->hasFeature(OSystem::kCpuFeatureNEON))
+		return zbufferSpanProcsNEON;
+#endif
+#endif
+	return nullptr;
+}
+
+} // end of namespace TinyGL
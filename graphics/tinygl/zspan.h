@@ -0,0 +1,93 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "common/scummsys.h"
+
+namespace TinyGL {
+
+/**
+ * Frame buffer state used by the span kernels. The kernels handle 32 bpp
+ * frame buffers with 8 bit color channels only, the depth test either
+ * disabled or TGL_LESS, and blending either disabled or
+ * TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA.
+ */
+struct ZBufferSpanState {
+	bool depthTest;
+	bool depthWrite;
+	bool blending;
+	bool texture;
+	// Pixels outside of [clipLeft, clipRight) are left untouched
+	int clipLeft, clipRight;
+	uint aLoss, aShift, rShift, gShift, bShift;
+};
+
+/**
+ * A run of @c count pixels of a scanline starting at column @c x. The
+ * interpolated values use the fixed point formats of ZBufferPoint. Light
+ * colors modulate @c texels, which hold one ARGB8888 texel per pixel.
+ */
+struct ZBufferSpan {
+	uint32 *pixels;
+	uint *depth;
+	const uint32 *texels;
+	int x, count;
+	uint z;
+	int dzdx;
+	uint r, g, b, a;
+	int drdx, dgdx, dbdx, dadx;
+};
+
+typedef void (*ZBufferSpanProc)(const ZBufferSpanState &state, const ZBufferSpan &span);
+
+/** Number of kernels per instruction set, see getZBufferSpanProcs(). */
+static const int kZBufferSpanProcCount = 16;
+
+/**
+ * Return the span kernels the CPU supports, indexed by
+ * depthTest | depthWrite << 1 | blending << 2 | texture << 3,
+ * or nullptr if there are none.
+ */
+const ZBufferSpanProc *getZBufferSpanProcs();
+
+/**
+ * The portable span fill, from pixel @p first on. The kernels use it for
+ * the pixels that do not fill a whole vector.
+ */
+void fillSpanPixels(const ZBufferSpanState &state, const ZBufferSpan &span, int first);
+
+#ifdef SCUMMVM_SSE2
+extern const ZBufferSpanProc zbufferSpanProcsSSE2[kZBufferSpanProcCount];
+#endif
+
+#ifdef SCUMMVM_AVX2
+extern const ZBufferSpanProc zbufferSpanProcsAVX2[kZBufferSpanProcCount];
+#endif
+
+#ifdef SCUMMVM_NEON
+extern const ZBufferSpanProc zbufferSpanProcsNEON[kZBufferSpanProcCount];
+#endif
+
+} // end of namespace TinyGL
+
+#endif
@@ -34,6 +34,16 @@ namespace TinyGL {
 
 static const int NB_INTERP = 8;
 
+// The span kernels store the depth through a signed float conversion, which
+// matches writePixel() as long as the interpolated depth stays below 2^31
+template <bool kDepthWrite>
+static inline bool spanDepthInRange(uint z, int dzdx, int count) {
+	if (!kDepthWrite)
+		return true;
+	const int64 last = (int64)z + (int64)dzdx * (count - 1);
+	return z < 0x80000000U && last >= 0 && last < 0x80000000LL;
+}
+
 template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
                                     int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
@@ -317,6 +327,12 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		a1 = p2->a;
 	}
 
+	// Spans without fog, alpha or stencil test go through the vector kernels
+	ZBufferSpanState spanState;
+	ZBufferSpanProc spanProc = nullptr;
+	if (kInterpRGB && kInterpZ && !kFogMode && !kAlphaTestEnabled && !kStencilEnabled)
+		spanProc = selectSpanProc(spanState, kDepthTestEnabled && _depthTestEnabled, kDepthWrite, kBlendingEnabled, kInterpST || kInterpSTZ);
+
 	if (kInterpRGB && (kInterpST || kInterpSTZ)) {
 		texture = _currentTexture;
 		fdzdx = (float)dzdx;
@@ -423,6 +439,9 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
+			// lines below the scissor rectangle can be skipped entirely
+			if (kEnableScissor && y >= _clipRectangle.bottom)
+				return;
 			int x = x1;
 			if (!kInterpRGB) {
 				int n;
@@ -430,6 +449,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				byte *ps = nullptr;
 				uint z;
 				n = (x2 >> 16) - x1;
+				if (kEnableScissor && scissorLine(y))
+					n = -1;
 				if (kInterpZ) {
 					pz = pz1 + x1;
 					z = z1;
@@ -468,6 +489,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				int pp;
 				uint z, r, g, b, a, fog;
 				int n = (x2 >> 16) - x1;
+				if (kEnableScissor && scissorLine(y))
+					n = -1;
 				pp = pp1 + x1;
 				r = r1;
 				g = g1;
@@ -483,6 +506,26 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (spanProc && n >= 0 && spanDepthInRange<kDepthWrite>(z, dzdx, n + 1)) {
+					ZBufferSpan span;
+					span.pixels = (uint32 *)_pbuf + pp;
+					span.depth = pz;
+					span.texels = nullptr;
+					span.x = x;
+					span.count = n + 1;
+					span.z = z;
+					span.dzdx = dzdx;
+					span.r = r;
+					span.g = g;
+					span.b = b;
+					span.a = a;
+					span.drdx = drdx;
+					span.dgdx = dgdx;
+					span.dbdx = dbdx;
+					span.dadx = dadx;
+					spanProc(spanState, span);
+					n = -1;
+				}
 				while (n >= 3) {
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
 					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
@@ -525,6 +568,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				int dsdx, dtdx;
 
 				n = (x2 >> 16) - x1;
+				if (kEnableScissor && scissorLine(y))
+					n = -1;
 				fz = (float)z1;
 				zinv = (float)(1.0 / fz);
 
@@ -545,6 +590,71 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				g = g1;
 				b = b1;
 				a = a1;
+				if (spanProc && n >= 0 && spanDepthInRange<kDepthWrite>(z, dzdx, n + 1)) {
+					// The texels are fetched one by one, the kernel lights and writes them
+					uint32 texels[NB_INTERP];
+					ZBufferSpan span;
+					span.texels = texels;
+					span.dzdx = dzdx;
+					span.drdx = drdx;
+					span.dgdx = dgdx;
+					span.dbdx = dbdx;
+					span.dadx = dadx;
+					while (n >= 0) {
+						const int count = MIN(n + 1, NB_INTERP);
+						{
+							float ss, tt;
+							ss = sz * zinv;
+							tt = tz * zinv;
+							s = (int)ss;
+							t = (int)tt;
+							dsdx = (int)((dszdx - ss * fdzdx) * zinv);
+							dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+							if (count == NB_INTERP) {
+								fz += fndzdx;
+								zinv = (float)(1.0 / fz);
+							}
+						}
+						uint zTexel = z;
+						for (int _a = 0; _a < count; _a++) {
+							if (!spanState.depthTest || pz[_a] < zTexel) {
+								uint8 c_a, c_r, c_g, c_b;
+								texture->getARGBAt(_wrapS, _wrapT, s, t, c_a, c_r, c_g, c_b);
+								texels[_a] = (uint32)c_a << 24 | c_r << 16 | c_g << 8 | c_b;
+							} else {
+								texels[_a] = 0;
+							}
+							zTexel += dzdx;
+							s += dsdx;
+							t += dtdx;
+						}
+
+						span.pixels = (uint32 *)_pbuf + pp;
+						span.depth = pz;
+						span.x = x;
+						span.count = count;
+						span.z = z;
+						span.r = r;
+						span.g = g;
+						span.b = b;
+						span.a = a;
+						spanProc(spanState, span);
+
+						pp += count;
+						pz += count;
+						z += count * dzdx;
+						if (kSmoothMode) {
+							r += count * drdx;
+							g += count * dgdx;
+							b += count * dbdx;
+							a += count * dadx;
+						}
+						sz += ndszdx;
+						tz += ndtzdx;
+						n -= count;
+						x += count;
+					}
+				}
 				while (n >= (NB_INTERP - 1)) {
 					{
 						float ss, tt;
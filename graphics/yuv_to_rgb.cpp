@@ -82,8 +82,12 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/array.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_simd.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -97,12 +101,14 @@ public:
 
 	Graphics::PixelFormat getFormat() const { return _format; }
 	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	bool getAlphaMode() const { return _alphaMode; }
 	const uint32 *getRGBToPix() const { return _rgbToPix; }
 	const uint32 *getAlphaToPix() const { return _alphaToPix; }
 
 private:
 	Graphics::PixelFormat _format;
 	YUVToRGBManager::LuminanceScale _scale;
+	bool _alphaMode;
 	uint32 _rgbToPix[3 * 768]; // 9216 bytes
 	uint32 _alphaToPix[256];   // 958 bytes
 };
@@ -110,6 +116,7 @@ private:
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale, bool alphaMode) {
 	_format = format;
 	_scale = scale;
+	_alphaMode = alphaMode;
 
 	int alphaValue = alphaMode ? 0 : 255;
 
@@ -166,8 +173,7 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 }
 
 YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
-	_alphaMode = false;
+	_useSIMD = true;
 
 	int16 *Cr_r_tab = &_colorTab[0 * 256];
 	int16 *Cr_g_tab = &_colorTab[1 * 256];
@@ -189,17 +195,176 @@ YUVToRGBManager::YUVToRGBManager() {
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (uint i = 0; i < _lookups.size(); ++i)
+		delete _lookups[i];
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale, bool alphaMode) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale && _alphaMode == alphaMode)
-		return _lookup;
+	// Video decoders may convert on worker threads, so the tables are
+	// kept until shutdown instead of being replaced on a format change.
+	Common::StackLock lock(_lookupMutex);
+
+	for (uint i = 0; i < _lookups.size(); ++i) {
+		const YUVToRGBLookup *lookup = _lookups[i];
+		if (lookup->getFormat() == format && lookup->getScale() == scale && lookup->getAlphaMode() == alphaMode)
+			return lookup;
+	}
 
-	_alphaMode = alphaMode;
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale, alphaMode);
-	return _lookup;
+	YUVToRGBLookup *lookup = new YUVToRGBLookup(format, scale, alphaMode);
+	_lookups.push_back(lookup);
+	return lookup;
+}
+
+bool YUVToRGBConversion::setup(const PixelFormat &format, bool ituRange, uint chromaShift, bool alphaMode) {
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	bytesPerPixel = format.bytesPerPixel;
+	itu = ituRange;
+	chromaShiftX = chromaShift;
+	loss[0] = format.rLoss;
+	loss[1] = format.gLoss;
+	loss[2] = format.bLoss;
+	loss[3] = format.aLoss;
+	shift[0] = format.rShift;
+	shift[1] = format.gShift;
+	shift[2] = format.bShift;
+	shift[3] = format.aShift;
+	fill = alphaMode ? 0 : format.ARGBToColor(255, 0, 0, 0);
+	return true;
+}
+
+void YUVToRGBConversion::convertPixels(byte *dst, const byte *ySrc, const byte *aSrc,
+                                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset, uint count) const {
+	const int16 *offsets[3] = { rOffset, gOffset, bOffset };
+
+	for (uint x = 0; x < count; ++x) {
+		uint32 color = fill;
+		for (uint i = 0; i < 3; ++i) {
+			int c = ySrc[x] + offsets[i][x >> chromaShiftX];
+			if (itu)
+				c = (CLIP(c, 16, 235) - 16) * 255 / 219;
+			else
+				c = CLIP(c, 0, 255);
+			color |= ((uint32)c >> loss[i]) << shift[i];
+		}
+		if (aSrc)
+			color |= ((uint32)aSrc[x] >> loss[3]) << shift[3];
+
+		if (bytesPerPixel == 2)
+			((uint16 *)dst)[x] = color;
+		else
+			((uint32 *)dst)[x] = color;
+	}
+}
+
+namespace {
+
+inline bool hasCpuFeature(OSystem::Feature f) {
+	return g_system && g_system->hasFeature(f);
+}
+
+/** Frames of at least this many pixels are converted in bands on the thread pool. */
+const int kMinParallelPixels = 640 * 480;
+
+/**
+ * Run @p body on the rows [0, rows), split into bands on the thread pool
+ * if the frame is large enough to be worth it.
+ */
+template<class F>
+void forEachBand(int rows, int yWidth, int yHeight, const F &body) {
+	if (rows <= 0)
+		return;
+
+	if (yWidth * yHeight >= kMinParallelPixels)
+		g_system->getThreadPool().parallelFor(0, rows, 8, body);
+	else
+		body(0, rows);
+}
+
+/**
+ * Convert a frame with the vectorized row kernels. Chroma is subsampled by
+ * 1 << chromaShiftX horizontally and 1 << chromaShiftY vertically.
+ */
+void convertYUVToRGBSIMD(YUVToRGBRowProc convertRow, const YUVToRGBConversion &conv, const int16 *colorTab,
+                         byte *dstPtr, int dstPitch, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc,
+                         int yWidth, int yHeight, int yPitch, int uvPitch, uint chromaShiftX, uint chromaShiftY) {
+	// The tables index the combined table of YUVToRGBLookup, remove the
+	// offsets of the channel tables and of their centers.
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	forEachBand(yHeight >> chromaShiftY, yWidth, yHeight, [&](uint first, uint last) {
+		const int chromaWidth = yWidth >> chromaShiftX;
+		Common::Array<int16> offsets;
+		offsets.resize(3 * chromaWidth);
+		int16 *rOffset = offsets.data();
+		int16 *gOffset = rOffset + chromaWidth;
+		int16 *bOffset = gOffset + chromaWidth;
+
+		for (uint row = first; row < last; ++row) {
+			const byte *u = uSrc + row * uvPitch;
+			const byte *v = vSrc + row * uvPitch;
+			for (int x = 0; x < chromaWidth; ++x) {
+				rOffset[x] = Cr_r_tab[v[x]] - (0 * 768 + 256);
+				gOffset[x] = Cr_g_tab[v[x]] + Cb_g_tab[u[x]] - (1 * 768 + 256);
+				bOffset[x] = Cb_b_tab[u[x]] - (2 * 768 + 256);
+			}
+
+			for (uint y = row << chromaShiftY; y < (row + 1) << chromaShiftY; ++y) {
+				convertRow(dstPtr + y * dstPitch, ySrc + y * yPitch, aSrc ? aSrc + y * yPitch : nullptr,
+				           rOffset, gOffset, bOffset, yWidth, conv);
+			}
+		}
+	});
+}
+
+} // End of anonymous namespace
+
+YUVToRGBRowProc getYUVToRGBRowProc() {
+#ifdef SCUMMVM_AVX2
+	if (hasCpuFeature(OSystem::kCpuFeatureAVX2))
+		return convertYUVRowAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return convertYUVRowSSE2;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureSSE2))
+		return convertYUVRowSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return convertYUVRowNEON;
+#else
+	if (hasCpuFeature(OSystem::kCpuFeatureNEON))
+		return convertYUVRowNEON;
+#endif
+#endif
+	return nullptr;
+}
+
+bool YUVToRGBManager::convertSIMD(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc,
+                                  int yWidth, int yHeight, int yPitch, int uvPitch, uint chromaShiftX, uint chromaShiftY) {
+	if (!_useSIMD)
+		return false;
+
+	const YUVToRGBRowProc convertRow = getYUVToRGBRowProc();
+	if (!convertRow)
+		return false;
+
+	YUVToRGBConversion conv;
+	if (!conv.setup(dst->format, scale == kScaleITU, chromaShiftX, aSrc != nullptr))
+		return false;
+
+	convertYUVToRGBSIMD(convertRow, conv, _colorTab, (byte *)dst->getPixels(), dst->pitch, ySrc, uSrc, vSrc, aSrc,
+	                    yWidth, yHeight, yPitch, uvPitch, chromaShiftX, chromaShiftY);
+	return true;
 }
 
 #define PUT_PIXEL(s, d) \
@@ -243,13 +408,21 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 
+	if (convertSIMD(dst, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 0, 0))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	forEachBand(yHeight, yWidth, yHeight, [&](uint first, uint last) {
+		byte *dstPtr = (byte *)dst->getBasePtr(0, first);
+		const int bandHeight = last - first;
+
+		// Use a templated function to avoid an if check on every pixel
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV444ToRGB<uint16>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + first * yPitch, uSrc + first * uvPitch, vSrc + first * uvPitch, yWidth, bandHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGB<uint32>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + first * yPitch, uSrc + first * uvPitch, vSrc + first * uvPitch, yWidth, bandHeight, yPitch, uvPitch);
+	});
 }
 
 template<typename PixelInt>
@@ -295,6 +468,9 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
 
+	if (convertSIMD(dst, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 0))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -351,13 +527,22 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	if (convertSIMD(dst, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 1))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	forEachBand(yHeight >> 1, yWidth, yHeight, [&](uint first, uint last) {
+		byte *dstPtr = (byte *)dst->getBasePtr(0, first * 2);
+		const byte *yBand = ySrc + first * 2 * yPitch;
+		const int bandHeight = (last - first) * 2;
+
+		// Use a templated function to avoid an if check on every pixel
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV420ToRGB<uint16>(dstPtr, dst->pitch, lookup, _colorTab, yBand, uSrc + first * uvPitch, vSrc + first * uvPitch, yWidth, bandHeight, yPitch, uvPitch);
+		else
+			convertYUV420ToRGB<uint32>(dstPtr, dst->pitch, lookup, _colorTab, yBand, uSrc + first * uvPitch, vSrc + first * uvPitch, yWidth, bandHeight, yPitch, uvPitch);
+	});
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -415,13 +600,23 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	if (convertSIMD(dst, scale, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale, true);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+	forEachBand(yHeight >> 1, yWidth, yHeight, [&](uint first, uint last) {
+		byte *dstPtr = (byte *)dst->getBasePtr(0, first * 2);
+		const byte *yBand = ySrc + first * 2 * yPitch;
+		const byte *aBand = aSrc + first * 2 * yPitch;
+		const int bandHeight = (last - first) * 2;
+
+		// Use a templated function to avoid an if check on every pixel
+		if (dst->format.bytesPerPixel == 2)
+			convertYUVA420ToRGBA<uint16>(dstPtr, dst->pitch, lookup, _colorTab, yBand, uSrc + first * uvPitch, vSrc + first * uvPitch, aBand, yWidth, bandHeight, yPitch, uvPitch);
+		else
+			convertYUVA420ToRGBA<uint32>(dstPtr, dst->pitch, lookup, _colorTab, yBand, uSrc + first * uvPitch, vSrc + first * uvPitch, aBand, yWidth, bandHeight, yPitch, uvPitch);
+	});
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -38,6 +38,8 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
@@ -135,6 +137,14 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Enable or disable the vectorized conversions of convert444(),
+	 * convert422(), convert420() and convert420Alpha(). They produce the
+	 * same pixels as the lookup tables, which are used when disabled or
+	 * when the CPU lacks the instructions. Enabled by default.
+	 */
+	void setUseSIMD(bool enable) { _useSIMD = enable; }
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -142,9 +152,19 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale, bool alphaMode = false);
 
-	YUVToRGBLookup *_lookup;
+	/**
+	 * Convert with the vectorized kernels. Chroma is subsampled by
+	 * 1 << chromaShiftX horizontally and 1 << chromaShiftY vertically.
+	 *
+	 * @return false if the lookup tables have to be used.
+	 */
+	bool convertSIMD(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc,
+	                 int yWidth, int yHeight, int yPitch, int uvPitch, uint chromaShiftX, uint chromaShiftY);
+
+	Common::Array<YUVToRGBLookup *> _lookups;
+	Common::Mutex _lookupMutex;
 	int16 _colorTab[4 * 256]; // 2048 bytes
-	bool _alphaMode;
+	bool _useSIMD;
 };
  /** @} */
 } // End of namespace Graphics
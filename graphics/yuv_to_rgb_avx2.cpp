@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/yuv_to_rgb_simd.h"
+
+#include <immintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+class YUVBlockAVX2 {
+	__m128i _loss[4];
+	__m128i _shift[4];
+	__m256i _fill;
+
+	static inline __m256i loadOffsets(const int16 *offset) {
+		if (shiftX) {
+			// Every offset applies to two pixels
+			const __m256i o = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)offset));
+			return _mm256_or_si256(o, _mm256_slli_epi32(o, 16));
+		}
+		return _mm256_loadu_si256((const __m256i *)offset);
+	}
+
+	static inline __m256i channel(__m256i y, const int16 *offset) {
+		__m256i c = _mm256_add_epi16(y, loadOffsets(offset));
+		if (itu) {
+			// n * 255 / 219 == n + ((n * 10774) >> 16) for n in [0, 219]
+			c = _mm256_min_epi16(_mm256_max_epi16(c, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+			c = _mm256_sub_epi16(c, _mm256_set1_epi16(16));
+			return _mm256_add_epi16(c, _mm256_mulhi_epu16(c, _mm256_set1_epi16(10774)));
+		}
+		return _mm256_min_epi16(_mm256_max_epi16(c, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+	}
+
+	inline __m256i place16(__m256i c, uint i) const {
+		return _mm256_sll_epi16(_mm256_srl_epi16(c, _loss[i]), _shift[i]);
+	}
+
+	inline __m256i place32(__m256i c, uint i) const {
+		return _mm256_sll_epi32(_mm256_srl_epi32(c, _loss[i]), _shift[i]);
+	}
+
+public:
+	enum { kPixels = 16 };
+
+	YUVBlockAVX2(const YUVToRGBConversion &conv) {
+		for (uint i = 0; i < 4; ++i) {
+			_loss[i] = _mm_cvtsi32_si128(conv.loss[i]);
+			_shift[i] = _mm_cvtsi32_si128(conv.shift[i]);
+		}
+		_fill = bpp == 2 ? _mm256_set1_epi16((int16)conv.fill) : _mm256_set1_epi32(conv.fill);
+	}
+
+	inline void operator()(byte *dst, const byte *ySrc, const byte *aSrc,
+	                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset) const {
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)ySrc));
+		const __m256i c[4] = {
+			channel(y, rOffset),
+			channel(y, gOffset),
+			channel(y, bOffset),
+			alpha ? _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)aSrc)) : zero
+		};
+		const uint numChannels = alpha ? 4 : 3;
+
+		if (bpp == 2) {
+			__m256i result = _fill;
+			for (uint i = 0; i < numChannels; ++i)
+				result = _mm256_or_si256(result, place16(c[i], i));
+			_mm256_storeu_si256((__m256i *)dst, result);
+		} else {
+			__m256i lo = _fill, hi = _fill;
+			for (uint i = 0; i < numChannels; ++i) {
+				lo = _mm256_or_si256(lo, place32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(c[i])), i));
+				hi = _mm256_or_si256(hi, place32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(c[i], 1)), i));
+			}
+			_mm256_storeu_si256((__m256i *)dst, lo);
+			_mm256_storeu_si256((__m256i *)(dst + 32), hi);
+		}
+	}
+};
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+void convertRow(byte *dst, const byte *ySrc, const byte *aSrc,
+                const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                uint w, const YUVToRGBConversion &conv) {
+	const YUVBlockAVX2<bpp, shiftX, itu, alpha> block(conv);
+	const uint vectorW = w - w % YUVBlockAVX2<bpp, shiftX, itu, alpha>::kPixels;
+	for (uint x = 0; x < vectorW; x += YUVBlockAVX2<bpp, shiftX, itu, alpha>::kPixels)
+		block(dst + x * bpp, ySrc + x, alpha ? aSrc + x : nullptr, rOffset + (x >> shiftX), gOffset + (x >> shiftX), bOffset + (x >> shiftX));
+	conv.convertPixels(dst + vectorW * bpp, ySrc + vectorW, aSrc ? aSrc + vectorW : nullptr,
+	                   rOffset + (vectorW >> shiftX), gOffset + (vectorW >> shiftX), bOffset + (vectorW >> shiftX), w - vectorW);
+}
+
+template<uint bpp, uint shiftX>
+void convertRowShift(byte *dst, const byte *ySrc, const byte *aSrc,
+                     const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                     uint w, const YUVToRGBConversion &conv) {
+	if (conv.itu) {
+		if (aSrc)
+			convertRow<bpp, shiftX, true, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, true, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	} else {
+		if (aSrc)
+			convertRow<bpp, shiftX, false, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, false, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	}
+}
+
+template<uint bpp>
+void convertRowBpp(byte *dst, const byte *ySrc, const byte *aSrc,
+                   const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                   uint w, const YUVToRGBConversion &conv) {
+	if (conv.chromaShiftX)
+		convertRowShift<bpp, 1>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowShift<bpp, 0>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of anonymous namespace
+
+void convertYUVRowAVX2(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv) {
+	if (conv.bytesPerPixel == 2)
+		convertRowBpp<2>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowBpp<4>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of namespace Graphics
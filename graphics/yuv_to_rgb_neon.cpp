@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/yuv_to_rgb_simd.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+class YUVBlockNEON {
+	// NEON only shifts by a vector of counts, negative ones shift right.
+	int16x8_t _loss16[4];
+	int16x8_t _shift16[4];
+	int32x4_t _loss32[4];
+	int32x4_t _shift32[4];
+	uint32 _fill;
+
+	static inline int16x8_t loadOffsets(const int16 *offset) {
+		if (shiftX) {
+			// Every offset applies to two pixels
+			const int16x4_t o = vld1_s16(offset);
+			const int16x4x2_t pairs = vzip_s16(o, o);
+			return vcombine_s16(pairs.val[0], pairs.val[1]);
+		}
+		return vld1q_s16(offset);
+	}
+
+	static inline uint16x8_t channel(int16x8_t y, const int16 *offset) {
+		int16x8_t c = vaddq_s16(y, loadOffsets(offset));
+		if (itu) {
+			// n * 255 / 219 == n + ((n * 10774) >> 16) for n in [0, 219]
+			c = vminq_s16(vmaxq_s16(c, vdupq_n_s16(16)), vdupq_n_s16(235));
+			const uint16x8_t n = vreinterpretq_u16_s16(vsubq_s16(c, vdupq_n_s16(16)));
+			const uint16x4_t lo = vshrn_n_u32(vmull_n_u16(vget_low_u16(n), 10774), 16);
+			const uint16x4_t hi = vshrn_n_u32(vmull_n_u16(vget_high_u16(n), 10774), 16);
+			return vaddq_u16(n, vcombine_u16(lo, hi));
+		}
+		return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(c, vdupq_n_s16(0)), vdupq_n_s16(255)));
+	}
+
+	inline uint16x8_t place16(uint16x8_t c, uint i) const {
+		return vshlq_u16(vshlq_u16(c, _loss16[i]), _shift16[i]);
+	}
+
+	inline uint32x4_t place32(uint32x4_t c, uint i) const {
+		return vshlq_u32(vshlq_u32(c, _loss32[i]), _shift32[i]);
+	}
+
+public:
+	enum { kPixels = 8 };
+
+	YUVBlockNEON(const YUVToRGBConversion &conv) : _fill(conv.fill) {
+		for (uint i = 0; i < 4; ++i) {
+			_loss16[i] = vdupq_n_s16(-(int16)conv.loss[i]);
+			_shift16[i] = vdupq_n_s16((int16)conv.shift[i]);
+			_loss32[i] = vdupq_n_s32(-(int32)conv.loss[i]);
+			_shift32[i] = vdupq_n_s32((int32)conv.shift[i]);
+		}
+	}
+
+	inline void operator()(byte *dst, const byte *ySrc, const byte *aSrc,
+	                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset) const {
+		const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc)));
+		const uint16x8_t c[4] = {
+			channel(y, rOffset),
+			channel(y, gOffset),
+			channel(y, bOffset),
+			alpha ? vmovl_u8(vld1_u8(aSrc)) : vdupq_n_u16(0)
+		};
+		const uint numChannels = alpha ? 4 : 3;
+
+		if (bpp == 2) {
+			uint16x8_t result = vdupq_n_u16((uint16)_fill);
+			for (uint i = 0; i < numChannels; ++i)
+				result = vorrq_u16(result, place16(c[i], i));
+			vst1q_u16((uint16 *)dst, result);
+		} else {
+			uint32x4_t lo = vdupq_n_u32(_fill), hi = vdupq_n_u32(_fill);
+			for (uint i = 0; i < numChannels; ++i) {
+				lo = vorrq_u32(lo, place32(vmovl_u16(vget_low_u16(c[i])), i));
+				hi = vorrq_u32(hi, place32(vmovl_u16(vget_high_u16(c[i])), i));
+			}
+			vst1q_u32((uint32 *)dst, lo);
+			vst1q_u32((uint32 *)(dst + 16), hi);
+		}
+	}
+};
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+void convertRow(byte *dst, const byte *ySrc, const byte *aSrc,
+                const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                uint w, const YUVToRGBConversion &conv) {
+	const YUVBlockNEON<bpp, shiftX, itu, alpha> block(conv);
+	const uint vectorW = w - w % YUVBlockNEON<bpp, shiftX, itu, alpha>::kPixels;
+	for (uint x = 0; x < vectorW; x += YUVBlockNEON<bpp, shiftX, itu, alpha>::kPixels)
+		block(dst + x * bpp, ySrc + x, alpha ? aSrc + x : nullptr, rOffset + (x >> shiftX), gOffset + (x >> shiftX), bOffset + (x >> shiftX));
+	conv.convertPixels(dst + vectorW * bpp, ySrc + vectorW, aSrc ? aSrc + vectorW : nullptr,
+	                   rOffset + (vectorW >> shiftX), gOffset + (vectorW >> shiftX), bOffset + (vectorW >> shiftX), w - vectorW);
+}
+
+template<uint bpp, uint shiftX>
+void convertRowShift(byte *dst, const byte *ySrc, const byte *aSrc,
+                     const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                     uint w, const YUVToRGBConversion &conv) {
+	if (conv.itu) {
+		if (aSrc)
+			convertRow<bpp, shiftX, true, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, true, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	} else {
+		if (aSrc)
+			convertRow<bpp, shiftX, false, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, false, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	}
+}
+
+template<uint bpp>
+void convertRowBpp(byte *dst, const byte *ySrc, const byte *aSrc,
+                   const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                   uint w, const YUVToRGBConversion &conv) {
+	if (conv.chromaShiftX)
+		convertRowShift<bpp, 1>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowShift<bpp, 0>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of anonymous namespace
+
+void convertYUVRowNEON(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv) {
+	if (conv.bytesPerPixel == 2)
+		convertRowBpp<2>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowBpp<4>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of namespace Graphics
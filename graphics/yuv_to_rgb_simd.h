@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_SIMD_H
+#define GRAPHICS_YUV_TO_RGB_SIMD_H
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * A YUV to RGB conversion in the form used by the vectorized kernels.
+ *
+ * The kernels get the luminance of every pixel and three chroma offsets,
+ * one for each color channel, for every pixel or, with horizontally
+ * subsampled chroma, for every pair of pixels. A channel is computed as
+ *
+ *   c = clamp(y + offset, 0, 255)                      for full range
+ *   c = (clamp(y + offset, 16, 235) - 16) * 255 / 219  for ITU range
+ *
+ * and stored as (c >> loss) << shift, which is exactly what the lookup
+ * tables of YUVToRGBManager contain.
+ */
+struct YUVToRGBConversion {
+	uint bytesPerPixel;
+	bool itu;
+	/** Red, green, blue and alpha loss and shift of the destination format. */
+	uint32 loss[4];
+	uint32 shift[4];
+	/** Bits set in every pixel, the opaque alpha value when there is no alpha source. */
+	uint32 fill;
+	/** 1 if the chroma offsets are shared by pairs of pixels, 0 otherwise. */
+	uint chromaShiftX;
+
+	/**
+	 * Set up the conversion to @p format.
+	 *
+	 * @param chromaShiftX 1 if chroma is subsampled horizontally, 0 otherwise.
+	 * @param alphaMode Whether the alpha channel is taken from an alpha source.
+	 * @return false if the format can not be handled by the kernels.
+	 */
+	bool setup(const PixelFormat &format, bool ituRange, uint chromaShiftX, bool alphaMode);
+
+	/**
+	 * Convert @p count pixels without vector instructions. This handles the
+	 * ends of rows, which have to start at an even pixel.
+	 */
+	void convertPixels(byte *dst, const byte *ySrc, const byte *aSrc,
+	                   const int16 *rOffset, const int16 *gOffset, const int16 *bOffset, uint count) const;
+};
+
+/**
+ * Convert one row of @p w pixels. @p aSrc is nullptr if the alpha channel
+ * is not taken from a source.
+ */
+typedef void (*YUVToRGBRowProc)(byte *dst, const byte *ySrc, const byte *aSrc,
+                                const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                                uint w, const YUVToRGBConversion &conv);
+
+/**
+ * Return the fastest available row conversion, or nullptr if there is no
+ * vectorized one.
+ */
+YUVToRGBRowProc getYUVToRGBRowProc();
+
+#ifdef SCUMMVM_SSE2
+void convertYUVRowSSE2(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void convertYUVRowAVX2(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv);
+#endif
+
+#ifdef SCUMMVM_NEON
+void convertYUVRowNEON(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv);
+#endif
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_YUV_TO_RGB_SIMD_H
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/yuv_to_rgb_simd.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+namespace {
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+class YUVBlockSSE2 {
+	__m128i _loss[4];
+	__m128i _shift[4];
+	__m128i _fill;
+
+	static inline __m128i loadOffsets(const int16 *offset) {
+		if (shiftX) {
+			// Every offset applies to two pixels
+			const __m128i o = _mm_loadl_epi64((const __m128i *)offset);
+			return _mm_unpacklo_epi16(o, o);
+		}
+		return _mm_loadu_si128((const __m128i *)offset);
+	}
+
+	static inline __m128i channel(__m128i y, const int16 *offset) {
+		__m128i c = _mm_add_epi16(y, loadOffsets(offset));
+		if (itu) {
+			// n * 255 / 219 == n + ((n * 10774) >> 16) for n in [0, 219]
+			c = _mm_min_epi16(_mm_max_epi16(c, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+			c = _mm_sub_epi16(c, _mm_set1_epi16(16));
+			return _mm_add_epi16(c, _mm_mulhi_epu16(c, _mm_set1_epi16(10774)));
+		}
+		return _mm_min_epi16(_mm_max_epi16(c, _mm_setzero_si128()), _mm_set1_epi16(255));
+	}
+
+	inline __m128i place16(__m128i c, uint i) const {
+		return _mm_sll_epi16(_mm_srl_epi16(c, _loss[i]), _shift[i]);
+	}
+
+	inline __m128i place32(__m128i c, uint i) const {
+		return _mm_sll_epi32(_mm_srl_epi32(c, _loss[i]), _shift[i]);
+	}
+
+public:
+	enum { kPixels = 8 };
+
+	YUVBlockSSE2(const YUVToRGBConversion &conv) {
+		for (uint i = 0; i < 4; ++i) {
+			_loss[i] = _mm_cvtsi32_si128(conv.loss[i]);
+			_shift[i] = _mm_cvtsi32_si128(conv.shift[i]);
+		}
+		_fill = bpp == 2 ? _mm_set1_epi16((int16)conv.fill) : _mm_set1_epi32(conv.fill);
+	}
+
+	inline void operator()(byte *dst, const byte *ySrc, const byte *aSrc,
+	                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), zero);
+		const __m128i c[4] = {
+			channel(y, rOffset),
+			channel(y, gOffset),
+			channel(y, bOffset),
+			alpha ? _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)aSrc), zero) : zero
+		};
+		const uint numChannels = alpha ? 4 : 3;
+
+		if (bpp == 2) {
+			__m128i result = _fill;
+			for (uint i = 0; i < numChannels; ++i)
+				result = _mm_or_si128(result, place16(c[i], i));
+			_mm_storeu_si128((__m128i *)dst, result);
+		} else {
+			__m128i lo = _fill, hi = _fill;
+			for (uint i = 0; i < numChannels; ++i) {
+				lo = _mm_or_si128(lo, place32(_mm_unpacklo_epi16(c[i], zero), i));
+				hi = _mm_or_si128(hi, place32(_mm_unpackhi_epi16(c[i], zero), i));
+			}
+			_mm_storeu_si128((__m128i *)dst, lo);
+			_mm_storeu_si128((__m128i *)(dst + 16), hi);
+		}
+	}
+};
+
+template<uint bpp, uint shiftX, bool itu, bool alpha>
+void convertRow(byte *dst, const byte *ySrc, const byte *aSrc,
+                const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                uint w, const YUVToRGBConversion &conv) {
+	const YUVBlockSSE2<bpp, shiftX, itu, alpha> block(conv);
+	const uint vectorW = w - w % YUVBlockSSE2<bpp, shiftX, itu, alpha>::kPixels;
+	for (uint x = 0; x < vectorW; x += YUVBlockSSE2<bpp, shiftX, itu, alpha>::kPixels)
+		block(dst + x * bpp, ySrc + x, alpha ? aSrc + x : nullptr, rOffset + (x >> shiftX), gOffset + (x >> shiftX), bOffset + (x >> shiftX));
+	conv.convertPixels(dst + vectorW * bpp, ySrc + vectorW, aSrc ? aSrc + vectorW : nullptr,
+	                   rOffset + (vectorW >> shiftX), gOffset + (vectorW >> shiftX), bOffset + (vectorW >> shiftX), w - vectorW);
+}
+
+template<uint bpp, uint shiftX>
+void convertRowShift(byte *dst, const byte *ySrc, const byte *aSrc,
+                     const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                     uint w, const YUVToRGBConversion &conv) {
+	if (conv.itu) {
+		if (aSrc)
+			convertRow<bpp, shiftX, true, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, true, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	} else {
+		if (aSrc)
+			convertRow<bpp, shiftX, false, true>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+		else
+			convertRow<bpp, shiftX, false, false>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	}
+}
+
+template<uint bpp>
+void convertRowBpp(byte *dst, const byte *ySrc, const byte *aSrc,
+                   const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                   uint w, const YUVToRGBConversion &conv) {
+	if (conv.chromaShiftX)
+		convertRowShift<bpp, 1>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowShift<bpp, 0>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of anonymous namespace
+
+void convertYUVRowSSE2(byte *dst, const byte *ySrc, const byte *aSrc,
+                       const int16 *rOffset, const int16 *gOffset, const int16 *bOffset,
+                       uint w, const YUVToRGBConversion &conv) {
+	if (conv.bytesPerPixel == 2)
+		convertRowBpp<2>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+	else
+		convertRowBpp<4>(dst, ySrc, aSrc, rOffset, gOffset, bOffset, w, conv);
+}
+
+} // End of namespace Graphics
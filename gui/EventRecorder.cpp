@@ -19,11 +19,17 @@
  *
  */
 
+// <sys/resource.h> pulls in <sys/time.h>
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
 
 #include "gui/EventRecorder.h"
 
 #ifdef ENABLE_EVENTRECORDER
 
+#ifdef POSIX
+#include <sys/resource.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
@@ -36,6 +42,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/onscreendialog.h"
+#include "common/algorithm.h"
 #include "common/random.h"
 #include "common/savefile.h"
 #include "common/textconsole.h"
@@ -57,6 +64,10 @@ EventRecorder::EventRecorder() {
 	_needRedraw = false;
 	_processingMillis = false;
 	_fastPlayback = false;
+	_screenshotHashOnly = false;
+	_playbackStartTime = 0;
+	_benchmark = false;
+	_benchmarkLastFrame = 0;
 	_lastTimeDate.tm_sec = 0;
 	_lastTimeDate.tm_min = 0;
 	_lastTimeDate.tm_hour = 0;
@@ -89,6 +100,7 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	const bool playback = (_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate);
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -96,7 +108,15 @@ void EventRecorder::deinit() {
 	_fakeMixerManager = nullptr;
 	_controlPanel->close();
 	delete _controlPanel;
-	debugC(1, kDebugLevelEventRec, "playback:action=stopplayback");
+	if (playback) {
+		// With fast playback this measures the throughput of the recording
+		debugC(1, kDebugLevelEventRec, "playback:action=stopplayback realtime=%u replayedtime=%u",
+		       g_system->getMillis(true) - _playbackStartTime, (uint32)_fakeTimer);
+		if (_benchmark)
+			reportBenchmark();
+	} else {
+		debugC(1, kDebugLevelEventRec, "playback:action=stopplayback");
+	}
 	Common::EventDispatcher *eventDispatcher = g_system->getEventManager()->getEventDispatcher();
 	eventDispatcher->unregisterSource(this);
 	eventDispatcher->ignoreSources(false);
@@ -256,6 +276,8 @@ void EventRecorder::processScreenUpdate() {
 		break;
 	case kRecorderUpdate: // fallthrough
 	case kRecorderPlayback:
+		if (_benchmark)
+			addBenchmarkFrame();
 		// if the next event isn't a screen update, fast forward until we find one.
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
@@ -404,6 +426,8 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	if (_screenshotPeriod == 0) {
 		_screenshotPeriod = kDefaultScreenshotPeriod;
 	}
+	_screenshotHashOnly = ConfMan.getBool("screenshot_hash_only");
+	_fastPlayback = ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) && ConfMan.getBool("fast_playback");
 	if (!openRecordFile(recordFileName)) {
 		deinit();
 		error("playback:action=error reason=\"Record file loading error\"");
@@ -425,6 +449,49 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	switchTimerManagers();
 	_needRedraw = true;
 	_initialized = true;
+	_playbackStartTime = g_system->getMillis(true);
+
+	_benchmark = (_recordMode == kRecorderPlayback) && ConfMan.getBool("benchmark");
+	_benchmarkFrameTimes.clear();
+	_benchmarkLastFrame = g_system->getMicros();
+}
+
+void EventRecorder::addBenchmarkFrame() {
+	uint64 now = g_system->getMicros();
+	_benchmarkFrameTimes.push_back((uint32)MIN<uint64>(now - _benchmarkLastFrame, 0xFFFFFFFF));
+	_benchmarkLastFrame = now;
+}
+
+void EventRecorder::reportBenchmark() {
+	uint32 frames = _benchmarkFrameTimes.size();
+	uint64 total = 0;
+	for (uint i = 0; i < frames; ++i)
+		total += _benchmarkFrameTimes[i];
+
+	// Percentiles are taken from the sorted frame times
+	Common::Array<uint32> sorted = _benchmarkFrameTimes;
+	Common::sort(sorted.begin(), sorted.end());
+	uint32 median = frames ? sorted[frames / 2] : 0;
+	uint32 p95 = frames ? sorted[MIN<uint32>(frames * 95 / 100, frames - 1)] : 0;
+	uint32 maximum = frames ? sorted[frames - 1] : 0;
+
+	long peakRss = -1;
+#ifdef POSIX
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef MACOSX
+		// Reported in bytes rather than kilobytes
+		peakRss = usage.ru_maxrss / 1024;
+#else
+		peakRss = usage.ru_maxrss;
+#endif
+	}
+#endif
+
+	// All times are in microseconds, except for the replayed game time
+	debug("benchmark:frames=%u totalus=%llu avgframeus=%llu medianframeus=%u p95frameus=%u maxframeus=%u replayedms=%u peakrsskb=%ld",
+	      frames, (unsigned long long)total, (unsigned long long)(frames ? total / frames : 0),
+	      median, p95, maximum, (uint32)_fakeTimer, peakRss);
 }
 
 
@@ -652,11 +719,13 @@ void EventRecorder::deleteRecord(const Common::String& fileName) {
 void EventRecorder::takeScreenshot() {
 	if ((_fakeTimer - _lastScreenshotTime) > _screenshotPeriod) {
 		Graphics::Surface screen;
-		uint8 md5[16];
-		if (grabScreenAndComputeMD5(screen, md5)) {
+		if (createScreenShot(screen)) {
+			// The checksum is computed and the screenshot written in the
+			// background, the record file takes over the pixels
 			_lastScreenshotTime = _fakeTimer;
-			_recordFile->saveScreenShot(screen, md5);
-			screen.free();
+			_recordFile->saveScreenShot(screen, _screenshotHashOnly);
+		} else {
+			warning("Can't save screenshot");
 		}
 	}
 }
@@ -247,6 +247,16 @@ private:
 	volatile RecordMode _recordMode;
 	Common::String _recordFileName;
 	bool _fastPlayback;
+	bool _screenshotHashOnly;
+	uint32 _playbackStartTime;
+
+	/** Record the time taken since the previous screen update when benchmarking. */
+	void addBenchmarkFrame();
+	/** Print frame time statistics and peak memory use of a benchmark run. */
+	void reportBenchmark();
+	bool _benchmark;
+	uint64 _benchmarkLastFrame;
+	Common::Array<uint32> _benchmarkFrameTimes;
 	bool _needRedraw;
 	bool _processingMillis;
 };
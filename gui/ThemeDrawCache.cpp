@@ -0,0 +1,169 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/managed_surface.h"
+
+#include "gui/ThemeDrawCache.h"
+
+namespace GUI {
+
+static bool statesEqual(const Graphics::VectorRenderer::State &a, const Graphics::VectorRenderer::State &b) {
+	return a.fgColor == b.fgColor && a.bgColor == b.bgColor && a.bevelColor == b.bevelColor
+		&& a.gradientStart == b.gradientStart && a.gradientEnd == b.gradientEnd
+		&& a.gradientBytes[0] == b.gradientBytes[0] && a.gradientBytes[1] == b.gradientBytes[1]
+		&& a.gradientBytes[2] == b.gradientBytes[2] && a.clippingArea == b.clippingArea
+		&& a.fillMode == b.fillMode && a.shadowOffset == b.shadowOffset && a.bevel == b.bevel
+		&& a.strokeWidth == b.strokeWidth && a.gradientFactor == b.gradientFactor
+		&& a.shadowIntensity == b.shadowIntensity && a.dynamicData == b.dynamicData
+		&& a.disableShadows == b.disableShadows;
+}
+
+static uint hashRect(uint hash, const Common::Rect &rect) {
+	hash = hash * 31 + (uint16)rect.left;
+	hash = hash * 31 + (uint16)rect.top;
+	hash = hash * 31 + (uint16)rect.right;
+	return hash * 31 + (uint16)rect.bottom;
+}
+
+bool ThemeDrawCache::Key::operator==(const Key &other) const {
+	return type == other.type && area == other.area && clip == other.clip
+		&& dynamic == other.dynamic && statesEqual(state, other.state);
+}
+
+uint ThemeDrawCache::KeyHash::operator()(const Key &key) const {
+	uint hash = hashRect(hashRect(key.type, key.area), key.clip);
+	hash = hash * 31 + key.dynamic;
+	hash = hash * 31 + key.state.fgColor;
+	hash = hash * 31 + key.state.bgColor;
+	return hash * 31 + key.state.gradientStart;
+}
+
+ThemeDrawCache::ThemeDrawCache(uint maxBytes) :
+	_pending(nullptr), _maxBytes(maxBytes), _bytes(0), _useCounter(0) {
+}
+
+ThemeDrawCache::~ThemeDrawCache() {
+	clear();
+}
+
+void ThemeDrawCache::makeKey(Key &key, int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+                             Graphics::VectorRenderer &renderer) const {
+	key.type = type;
+	key.area = area;
+	key.clip = clip;
+	key.dynamic = dynamic;
+	renderer.getState(key.state);
+}
+
+bool ThemeDrawCache::restore(int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+                             const Common::Rect &rect, Graphics::VectorRenderer &renderer) {
+	Key key;
+	makeKey(key, type, area, clip, dynamic, renderer);
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end() || i->_value->rect != rect)
+		return false;
+
+	Entry *entry = i->_value;
+	Graphics::Surface target = renderer.getActiveSurface()->getSubArea(rect);
+	const uint rowSize = rect.width() * target.format.bytesPerPixel;
+
+	for (int y = 0; y < rect.height(); ++y) {
+		if (memcmp(target.getBasePtr(0, y), entry->before.getBasePtr(0, y), rowSize))
+			return false;
+	}
+
+	target.copyRectToSurface(entry->after, 0, 0, Common::Rect(rect.width(), rect.height()));
+	renderer.setState(entry->state);
+	entry->lastUse = ++_useCounter;
+	return true;
+}
+
+void ThemeDrawCache::begin(int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+                           const Common::Rect &rect, Graphics::VectorRenderer &renderer) {
+	delete _pending;
+	_pending = nullptr;
+
+	const Graphics::Surface source = renderer.getActiveSurface()->getSubArea(rect);
+	// Results which would take a large part of the cache are not worth it
+	if ((uint)source.pitch * source.h * 2 > _maxBytes / 4)
+		return;
+
+	_pending = new Entry();
+	makeKey(_pending->key, type, area, clip, dynamic, renderer);
+	_pending->rect = rect;
+	_pending->before.copyFrom(source);
+}
+
+void ThemeDrawCache::end(Graphics::VectorRenderer &renderer) {
+	Entry *entry = _pending;
+	_pending = nullptr;
+	if (!entry)
+		return;
+
+	entry->after.copyFrom(renderer.getActiveSurface()->getSubArea(entry->rect));
+	renderer.getState(entry->state);
+	entry->lastUse = ++_useCounter;
+
+	EntryMap::iterator i = _entries.find(entry->key);
+	if (i != _entries.end())
+		removeEntry(i);
+
+	const uint size = entrySize(*entry);
+	evict(size);
+	_entries[entry->key] = entry;
+	_bytes += size;
+}
+
+void ThemeDrawCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete i->_value;
+	_entries.clear();
+	_bytes = 0;
+
+	delete _pending;
+	_pending = nullptr;
+}
+
+uint ThemeDrawCache::entrySize(const Entry &entry) {
+	return entry.before.pitch * entry.before.h + entry.after.pitch * entry.after.h;
+}
+
+void ThemeDrawCache::removeEntry(EntryMap::iterator i) {
+	Entry *entry = i->_value;
+	_bytes -= entrySize(*entry);
+	_entries.erase(i);
+	delete entry;
+}
+
+void ThemeDrawCache::evict(uint size) {
+	// Drop the least recently used results until the new one fits
+	while (!_entries.empty() && _bytes + size > _maxBytes) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value->lastUse < oldest->_value->lastUse)
+				oldest = i;
+		}
+		removeEntry(oldest);
+	}
+}
+
+} // End of namespace GUI
@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_THEME_DRAW_CACHE_H
+#define GUI_THEME_DRAW_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/rect.h"
+
+#include "graphics/surface.h"
+#include "graphics/VectorRenderer.h"
+
+namespace GUI {
+
+/**
+ * Keeps the pixels produced by drawing a DrawData set, so when the same
+ * widget is drawn again at the same place it can be copied to the screen
+ * instead of running all of its draw steps again.
+ *
+ * Widgets may be blended with what is below them and draw steps may use
+ * the colors left by previous steps, so an entry also keeps the pixels it
+ * was drawn over and the renderer state before and after drawing. It is
+ * only reused when both match, which gives exactly the pixels and the
+ * renderer state that drawing would have given.
+ */
+class ThemeDrawCache {
+public:
+	explicit ThemeDrawCache(uint maxBytes);
+	~ThemeDrawCache();
+
+	/**
+	 * Copies the result of drawing @p type in @p area to @p rect of the
+	 * renderer surface if it has been cached for the current pixels there.
+	 *
+	 * @return true if the result was copied, false if the DrawData set
+	 *         has to be drawn.
+	 */
+	bool restore(int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+	             const Common::Rect &rect, Graphics::VectorRenderer &renderer);
+
+	/**
+	 * Saves the pixels in @p rect before drawing @p type in @p area.
+	 * The result is added to the cache by calling end() after drawing.
+	 */
+	void begin(int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+	           const Common::Rect &rect, Graphics::VectorRenderer &renderer);
+
+	/**
+	 * Adds the result of the drawing started with begin() to the cache.
+	 */
+	void end(Graphics::VectorRenderer &renderer);
+
+	/**
+	 * Removes all the cached results. This needs to be called when the
+	 * theme or the renderer surface change.
+	 */
+	void clear();
+
+private:
+	struct Key {
+		int type;
+		Common::Rect area;
+		Common::Rect clip;
+		uint32 dynamic;
+		Graphics::VectorRenderer::State state;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Key key;
+		Common::Rect rect;
+		Graphics::Surface before;
+		Graphics::Surface after;
+		Graphics::VectorRenderer::State state;
+		uint32 lastUse;
+
+		~Entry() {
+			before.free();
+			after.free();
+		}
+	};
+
+	typedef Common::HashMap<Key, Entry *, KeyHash> EntryMap;
+
+	void makeKey(Key &key, int type, const Common::Rect &area, const Common::Rect &clip, uint32 dynamic,
+	             Graphics::VectorRenderer &renderer) const;
+	static uint entrySize(const Entry &entry);
+	void removeEntry(EntryMap::iterator i);
+	void evict(uint size);
+
+	EntryMap _entries;
+	Entry *_pending;
+	uint _maxBytes;
+	uint _bytes;
+	uint32 _useCounter;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -41,6 +41,7 @@
 #include "image/png.h"
 
 #include "gui/widget.h"
+#include "gui/ThemeDrawCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -202,6 +203,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 	_themeEval->setScaleFactor(_scaleFactor);
+	_drawCache = new GUI::ThemeDrawCache(kDrawCacheSize);
 
 	_useCursor = false;
 
@@ -251,6 +253,7 @@ ThemeEngine::~ThemeEngine() {
 
 	unloadTheme();
 	unloadExtraFont();
+	delete _drawCache;
 
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
@@ -282,6 +285,15 @@ const ThemeEngine::Renderer ThemeEngine::_rendererModes[] = {
 
 const uint ThemeEngine::_rendererModesSize = ARRAYSIZE(ThemeEngine::_rendererModes);
 
+struct ThemeEngine::ParsedTheme {
+	Common::String themeId;
+	Common::String themeFile;
+	Common::StringArray fileNames;
+	Common::Array<Common::XMLParser::ParseEventList> files;
+};
+
+ThemeEngine::ParsedTheme *ThemeEngine::_parsedTheme = nullptr;
+
 const ThemeEngine::GraphicsMode ThemeEngine::_defaultRendererMode =
 #ifndef DISABLE_FANCY_THEMES
 	ThemeEngine::kGfxAntialias;
@@ -464,6 +476,7 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+	_drawCache->clear();
 
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
@@ -679,18 +692,16 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				if (!decoder.loadStream(*stream))
+				// Decode straight into the overlay format
+				Graphics::Surface *decoded = new Graphics::Surface();
+				if (!decoder.loadStreamInto(*stream, *decoded, _overlayFormat))
 					error("Error decoding PNG");
 
-				srcSurface = decoder.getSurface();
+				surf = new Graphics::ManagedSurface(decoded);
 				delete stream;
-				if (srcSurface)
-					break;
+				break;
 			}
 		}
-
-		if (srcSurface && srcSurface->format.bytesPerPixel != 1)
-			surf = new Graphics::ManagedSurface(srcSurface->convertTo(_overlayFormat));
 #else
 		error("No PNG support compiled in");
 #endif
@@ -807,6 +818,7 @@ void ThemeEngine::unloadTheme() {
 	}
 
 	_themeEval->reset();
+	_drawCache->clear();
 	_themeOk = false;
 }
 
@@ -844,7 +856,24 @@ bool ThemeEngine::loadDefaultXML() {
 	_themeId = "builtin";
 	_themeFile.clear();
 
-	bool result = _parser->parse();
+	bool result;
+	if (_parsedTheme && _parsedTheme->themeId == "builtin") {
+		result = _parser->replay(_parsedTheme->files[0], "builtin");
+	} else {
+		clearParsedTheme();
+		ParsedTheme *parsed = new ParsedTheme();
+		parsed->themeId = "builtin";
+		parsed->files.resize(1);
+
+		_parser->setRecording(&parsed->files[0]);
+		result = _parser->parse();
+		_parser->setRecording(nullptr);
+
+		if (result)
+			_parsedTheme = parsed;
+		else
+			delete parsed;
+	}
 	_parser->close();
 
 	free(tmpXML);
@@ -885,31 +914,73 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	Common::StringArray fileNames;
+	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i)
+		fileNames.push_back((*i)->getName());
+
+	const bool replay = _parsedTheme && _parsedTheme->themeId == themeId &&
+		_parsedTheme->themeFile == _themeFile && _parsedTheme->fileNames == fileNames;
+
+	if (replay) {
+		for (uint i = 0; i < fileNames.size(); ++i) {
+			if (!_parser->replay(_parsedTheme->files[i], fileNames[i])) {
+				warning("Failed to parse STX file '%s'", fileNames[i].c_str());
+				return false;
+			}
+		}
+
+		assert(!_themeName.empty());
+		return true;
+	}
+
+	clearParsedTheme();
+	ParsedTheme *parsed = new ParsedTheme();
+	parsed->themeId = themeId;
+	parsed->themeFile = _themeFile;
+	parsed->fileNames = fileNames;
+	parsed->files.resize(fileNames.size());
+
+	_themeArchive->prefetchMembers(members);
+
 	//
 	// Loop over all STX files, load and parse them
 	//
-	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
+	uint fileIndex = 0;
+	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i, ++fileIndex) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
 		if (_parser->loadStream((*i)->createReadStream()) == false) {
 			warning("Failed to load STX file '%s'", (*i)->getName().c_str());
 			_parser->close();
+			delete parsed;
 			return false;
 		}
 
-		if (_parser->parse() == false) {
+		_parser->setRecording(&parsed->files[fileIndex]);
+		const bool result = _parser->parse();
+		_parser->setRecording(nullptr);
+
+		if (result == false) {
 			warning("Failed to parse STX file '%s'", (*i)->getName().c_str());
 			_parser->close();
+			delete parsed;
 			return false;
 		}
 
 		_parser->close();
 	}
 
+	_parsedTheme = parsed;
+
 	assert(!_themeName.empty());
 	return true;
 }
 
+void ThemeEngine::clearParsedTheme() {
+	delete _parsedTheme;
+	_parsedTheme = nullptr;
+}
+
 
 
 /**********************************************************
@@ -934,6 +1005,11 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
 
+	// Only results which are not cut by the screen or the clip rect are
+	// cached, so they can be reused whatever the clip rect is
+	const bool cacheable = area == r && Common::Rect(_screen.w, _screen.h).contains(extendedRect)
+		&& (_clip.isEmpty() || _clip.contains(extendedRect));
+
 	if (!_clip.isEmpty()) {
 		extendedRect.clip(_clip);
 	}
@@ -947,9 +1023,17 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (!cacheable || !_drawCache->restore(type, area, _clip, dynamic, extendedRect, *_vectorRenderer)) {
+			if (cacheable)
+				_drawCache->begin(type, area, _clip, dynamic, extendedRect, *_vectorRenderer);
+
+			Common::List<Graphics::DrawStep>::const_iterator step;
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
+
+			if (cacheable)
+				_drawCache->end(*_vectorRenderer);
 		}
 
 		addDirtyRect(extendedRect);
@@ -52,6 +52,7 @@ struct TextDrawData;
 struct TextColorData;
 class Dialog;
 class GuiObject;
+class ThemeDrawCache;
 class ThemeEval;
 class ThemeParser;
 
@@ -337,6 +338,9 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Maximum size in bytes of the drawn DrawData sets kept for reuse */
+	static const uint kDrawCacheSize = 16 * 1024 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -352,6 +356,9 @@ public:
 	static GraphicsMode findMode(const Common::String &cfg);
 	static const char *findModeConfigName(GraphicsMode mode);
 
+	/** Free the parsed theme files remembered for reloading the last theme. */
+	static void clearParsedTheme();
+
 	/** Default constructor */
 	ThemeEngine(Common::String id, GraphicsMode mode);
 
@@ -677,6 +684,15 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	struct ParsedTheme;
+
+	/**
+	 * The STX files of the last theme loaded, as recorded by the parser.
+	 * Reloading that theme, e.g. on a resolution or scale change, replays
+	 * them instead of reading and tokenizing the files again.
+	 */
+	static ParsedTheme *_parsedTheme;
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
@@ -751,6 +767,9 @@ protected:
 	/** Theme getEvaluator (changed from GUI::Eval to add functionality) */
 	GUI::ThemeEval *_themeEval;
 
+	/** Results of drawing DrawData sets, copied back when they are drawn again */
+	GUI::ThemeDrawCache *_drawCache;
+
 	/** Main screen surface. This is blitted straight into the overlay. */
 	Graphics::ManagedSurface _screen;
 
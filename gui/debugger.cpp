@@ -25,7 +25,10 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/memtag.h"
+#include "common/profiler.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -34,6 +37,8 @@
 #include "common/stream.h"
 #endif
 
+#include "audio/mixer.h"
+
 #include "engines/engine.h"
 
 #include "gui/debugger.h"
@@ -79,6 +84,12 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+#ifdef USE_PROFILER
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+#endif
+	registerCmd("audiostats",		WRAP_METHOD(Debugger, cmdAudioStats));
+	registerCmd("timerstats",		WRAP_METHOD(Debugger, cmdTimerStats));
+	registerCmd("mem",				WRAP_METHOD(Debugger, cmdMem));
 }
 
 Debugger::~Debugger() {
@@ -846,6 +857,100 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef USE_PROFILER
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc >= 2 && !scumm_stricmp(argv[1], "start")) {
+		profiler.setEnabled(true);
+		debugPrintf("Profiling started\n");
+	} else if (argc >= 2 && !scumm_stricmp(argv[1], "stop")) {
+		profiler.setEnabled(false);
+		debugPrintf("Profiling stopped\n");
+	} else if (argc >= 2 && !scumm_stricmp(argv[1], "clear")) {
+		profiler.clear();
+		debugPrintf("Cleared all profiling events\n");
+	} else if (argc >= 2 && !scumm_stricmp(argv[1], "show")) {
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getStatistics(stats);
+
+		debugPrintf("%-32s %8s %10s %10s %10s\n", "Zone", "Count", "Total ms", "Avg us", "Max us");
+		for (uint i = 0; i < stats.size(); ++i) {
+			debugPrintf("%-32s %8u %10u %10u %10u\n", stats[i].name, stats[i].count,
+				(uint)(stats[i].total / 1000), (uint)(stats[i].total / stats[i].count), stats[i].max);
+		}
+	} else if (argc >= 3 && !scumm_stricmp(argv[1], "dump")) {
+		Common::DumpFile out;
+		if (out.open(argv[2]) && profiler.writeChromeTrace(out))
+			debugPrintf("Wrote %u events to '%s'\n", profiler.getEventCount(), argv[2]);
+		else
+			debugPrintf("Failed to write '%s'\n", argv[2]);
+	} else {
+		debugPrintf("Profiling is %s, %u of %u events recorded\n", profiler.isEnabled() ? "enabled" : "disabled",
+			profiler.getEventCount(), profiler.getCapacity());
+		debugPrintf("Usage: %s [start | stop | clear | show | dump <file>]\n", argv[0]);
+	}
+	return true;
+}
+#endif
+
+bool Debugger::cmdAudioStats(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::Mixer::OutputStats stats;
+	if (!mixer || !mixer->getOutputStats(stats)) {
+		debugPrintf("The audio output is not measured\n");
+		return true;
+	}
+
+	const uint rate = mixer->getOutputRate();
+	debugPrintf("Output: %u Hz, %u samples per callback (%u ms)\n", rate, stats.bufferSize,
+		rate ? stats.bufferSize * 1000 / rate : 0);
+	debugPrintf("Callbacks: %u, underruns: %u\n", stats.callbacks, stats.underruns);
+	debugPrintf("Callback time: last %u us, average %u us, max %u us\n", stats.lastCallbackTime,
+		stats.callbacks ? (uint)(stats.totalCallbackTime / stats.callbacks) : 0, stats.maxCallbackTime);
+	return true;
+}
+
+bool Debugger::cmdTimerStats(int argc, const char **argv) {
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+	Common::Array<Common::TimerManager::TimerStats> stats;
+	if (!timerManager || !timerManager->getTimerStats(stats)) {
+		debugPrintf("The timers are not measured\n");
+		return true;
+	}
+
+	if (stats.empty()) {
+		debugPrintf("No timers are installed\n");
+		return true;
+	}
+
+	for (uint i = 0; i < stats.size(); ++i) {
+		debugPrintf("%s: every %d us, %u calls, %u overruns, max lateness %u ms\n", stats[i].id.c_str(),
+			stats[i].interval, stats[i].calls, stats[i].overruns, stats[i].maxLateness);
+	}
+	return true;
+}
+
+bool Debugger::cmdMem(int argc, const char **argv) {
+	if (argc >= 2 && !scumm_stricmp(argv[1], "resetpeak")) {
+		Common::resetMemTagPeaks();
+		debugPrintf("Reset the peak counters\n");
+		return true;
+	}
+
+	debugPrintf("%-10s %10s %10s %8s %10s\n", "Tag", "Current KB", "Peak KB", "Allocs", "Total");
+	uint64 currentBytes = 0;
+	for (int i = 0; i < Common::kMemTagCount; ++i) {
+		const Common::MemTagId tag = (Common::MemTagId)i;
+		const Common::MemTagStats stats = Common::getMemTagStats(tag);
+		debugPrintf("%-10s %10u %10u %8u %10u\n", Common::getMemTagName(tag), (uint)(stats.currentBytes / 1024),
+			(uint)(stats.peakBytes / 1024), stats.currentAllocations, stats.totalAllocations);
+		currentBytes += stats.currentBytes;
+	}
+	debugPrintf("Accounted: %u KB. Usage: %s [resetpeak]\n", (uint)(currentBytes / 1024), argv[0]);
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -276,6 +276,12 @@ protected:
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+#ifdef USE_PROFILER
+	bool cmdProfile(int argc, const char **argv);
+#endif
+	bool cmdAudioStats(int argc, const char **argv);
+	bool cmdTimerStats(int argc, const char **argv);
+	bool cmdMem(int argc, const char **argv);
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
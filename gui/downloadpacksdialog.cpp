@@ -22,6 +22,8 @@
 #include "backends/networking/curl/request.h"
 #include "gui/downloadpacksdialog.h"
 #include "gui/downloaddialog.h"
+#include "backends/networking/curl/chunkeddownloadrequest.h"
+#include "backends/networking/curl/connectionmanager.h"
 #include "backends/networking/curl/session.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
@@ -49,6 +51,7 @@ enum {
 struct DialogState {
 	DownloadPacksDialog *dialog;
 	Networking::Session session;
+	Networking::ChunkedDownloadRequest *fileRequest;
 	Common::HashMap<Common::String, uint32> fileHash;
 	IconProcessState state;
 	uint32 downloadedSize;
@@ -63,8 +66,11 @@ struct DialogState {
 		state = kDownloadStateNone;
 		downloadedSize = totalSize = totalFiles = startTime = lastUpdate = 0;
 		dialog = nullptr;
+		fileRequest = nullptr;
 	}
 
+	void abortRequests();
+
 	void downloadList();
 	void proceedDownload();
 
@@ -102,14 +108,23 @@ bool DialogState::takeOneFile() {
 	Common::String url = Common::String::format("https://downloads.scummvm.org/frs/icons/%s", fname.c_str());
 	Common::String localFile = normalizePath(ConfMan.get("iconspath") + "/" + fname, '/');
 
-	Networking::SessionRequest *rq = session.get(url, localFile,
+	// Packs are big: fetch them in parallel chunks when the server allows it
+	fileRequest = new Networking::ChunkedDownloadRequest(url, localFile,
 		new Common::Callback<DialogState, Networking::DataResponse>(this, &DialogState::downloadFileCallback),
 		new Common::Callback<DialogState, Networking::ErrorResponse>(this, &DialogState::errorCallback));
 
-	rq->start();
+	ConnMan.addRequest(fileRequest);
 	return true;
 }
 
+void DialogState::abortRequests() {
+	session.abortRequest();
+	if (fileRequest) {
+		fileRequest->abortRequest();
+		fileRequest = nullptr;
+	}
+}
+
 void DialogState::downloadListCallback(Networking::DataResponse r) {
 	Networking::SessionFileResponse *response = static_cast<Networking::SessionFileResponse *>(r.value);
 	Common::MemoryReadStream stream(response->buffer, response->len);
@@ -140,6 +155,9 @@ void DialogState::downloadFileCallback(Networking::DataResponse r) {
 
 	downloadedSize += response->len;
 	if (response->eos) {
+		// The request gets deleted once it returns
+		fileRequest = nullptr;
+
 		if (!takeOneFile()) {
 			state = kDownloadComplete;
 			if (dialog)
@@ -155,6 +173,9 @@ void DialogState::downloadFileCallback(Networking::DataResponse r) {
 }
 
 void DialogState::errorCallback(Networking::ErrorResponse error) {
+	if (error.request == fileRequest)
+		fileRequest = nullptr;
+
 	Common::U32String message = Common::U32String::format(_("ERROR %d: %s"), error.httpResponseCode, error.response.c_str());
 
 	if (dialog)
@@ -303,7 +324,7 @@ void DownloadPacksDialog::handleCommand(CommandSender *sender, uint32 cmd, uint3
 	switch (cmd) {
 	case kCleanupCmd:
 		{
-			g_state->session.abortRequest();
+			g_state->abortRequests();
 			delete g_state;
 			g_state = nullptr;
 
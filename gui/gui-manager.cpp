@@ -104,6 +104,7 @@ GuiManager::GuiManager() : CommandSender(nullptr), _redrawStatus(kRedrawDisabled
 
 GuiManager::~GuiManager() {
 	delete _theme;
+	ThemeEngine::clearParsedTheme();
 }
 
 void GuiManager::initIconsSet() {
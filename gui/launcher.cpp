@@ -128,6 +128,14 @@ bool LauncherFilterMatcher(void *boss, int idx, const Common::U32String &item, c
 	}
 
 	bool result = false;
+
+	// Plain words are matched against the description, which does not
+	// need the token converted.
+	if (!token.contains(':') && !token.contains('=') && !token.contains('~')) {
+		result = item.contains(token);
+		return invert ? !result : result;
+	}
+
 	Common::String token8 = token;
 	size_t pos = token8.findFirstOf(":=~");
 	if (pos != token8.npos) {
@@ -25,6 +25,7 @@
 #include "common/debug.h"
 #include "common/system.h"
 #include "common/taskbar.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
 
 #include "engines/advancedDetector.h"
@@ -58,6 +59,9 @@ enum {
 
 MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	: Dialog("MassAdd"),
+	_taskGroup(nullptr),
+	_jobsRunning(0),
+	_cancelled(false),
 	_dirsScanned(0),
 	_oldGamesCount(0),
 	_dirTotal(0),
@@ -153,6 +157,7 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 		close();
 	} else if (cmd == kCancelCmd) {
 		// User cancelled, so we don't do anything and just leave.
+		stopScan();
 		_games.clear();
 		close();
 	} else {
@@ -160,101 +165,202 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 	}
 }
 
-void MassAddDialog::handleTickle() {
-	if (_scanStack.empty())
-		return;	// We have finished scanning
+class MassAddDialog::ScanJob : public Common::Job {
+public:
+	ScanJob(MassAddDialog &dialog, const Common::FSNode &directory) : dir(directory), listed(false), _dialog(dialog) {}
+
+	void run() override {
+		if (!isCancelled()) {
+			Common::FSList files;
+			listed = dir.getChildren(files, Common::FSNode::kListAll);
+			if (listed) {
+				for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
+					if (file->isDirectory())
+						subdirs.push_back(*file);
+				}
 
-	uint32 t = g_system->getMillis();
+				Common::StackLock lock(_dialog._detectMutex);
+				if (!isCancelled())
+					detected = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED), true).listDetectedGames();
+			}
+		}
+
+		Common::StackLock lock(_dialog._jobMutex);
+		_dialog._finishedJobs.push(this);
+	}
+
+	Common::FSNode dir;
+	bool listed;
+	Common::FSList subdirs;
+	DetectedGames detected;
+
+private:
+	bool isCancelled() {
+		Common::StackLock lock(_dialog._jobMutex);
+		return _dialog._cancelled;
+	}
+
+	MassAddDialog &_dialog;
+};
+
+MassAddDialog::~MassAddDialog() {
+	stopScan();
+}
 
-	// Perform a breadth-first scan of the filesystem.
-	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
+void MassAddDialog::startJob(const Common::FSNode &dir) {
+	if (!_taskGroup)
+		_taskGroup = new Common::TaskGroup(g_system->getThreadPool());
 
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+	ScanJob *job = new ScanJob(*this, dir);
+	_jobs.push_back(job);
+	_jobsRunning++;
+	_taskGroup->run(job);
+}
+
+void MassAddDialog::stopScan() {
+	{
+		Common::StackLock lock(_jobMutex);
+		_cancelled = true;
+	}
+
+	// Jobs that did not start yet return right away
+	delete _taskGroup;
+	_taskGroup = nullptr;
+
+	for (uint i = 0; i < _jobs.size(); i++)
+		delete _jobs[i];
+	_jobs.clear();
+	_finishedJobs.clear();
+	_jobsRunning = 0;
+}
+
+void MassAddDialog::processFinishedJobs() {
+	Common::Array<ScanJob *> finished;
+	{
+		Common::StackLock lock(_jobMutex);
+		while (!_finishedJobs.empty())
+			finished.push_back(_finishedJobs.pop());
+	}
+
+	for (uint i = 0; i < finished.size(); i++) {
+		ScanJob *job = finished[i];
+		_jobsRunning--;
+
+		if (!job->listed)
 			continue;
-		}
 
-		// Run the detector on the dir
-		DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED), true);
+		DetectionResults detectionResults(job->detected);
 
 		if (detectionResults.foundUnknownGames()) {
 			Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
 			g_system->logMessage(LogMessageType::kInfo, report.encode().c_str());
 		}
 
-		// Just add all detected games / game variants. If we get more than one,
-		// that either means the directory contains multiple games, or the detector
-		// could not fully determine which game variant it was seeing. In either
-		// case, let the user choose which entries he wants to keep.
-		//
-		// However, we only add games which are not already in the config file.
-		DetectedGames candidates = detectionResults.listRecognizedGames();
-		for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
-			const DetectedGame &result = *cand;
-
-			Common::String path = dir.getPath();
-
-			// Remove trailing slashes
-			while (path != "/" && path.lastChar() == '/')
-				path.deleteLastChar();
-
-			// Check for existing config entries for this path/engineid/gameid/lang/platform combination
-			if (_pathToTargets.contains(path)) {
-				Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
-				Common::String resultLanguageCode = Common::getLanguageCode(result.language);
-
-				bool duplicate = false;
-				const Common::StringArray &targets = _pathToTargets[path];
-				for (Common::StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
-					// If the engineid, gameid, platform and language match -> skip it
-					Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
-					assert(dom);
-
-					if ((!dom->contains("engineid") || (*dom)["engineid"] == result.engineId) &&
-						(*dom)["gameid"] == result.gameId &&
-					    dom->getValOrDefault("platform") == resultPlatformCode &&
-						parseLanguage(dom->getValOrDefault("language")) == parseLanguage(resultLanguageCode)) {
-						duplicate = true;
-						break;
-					}
-				}
-				if (duplicate) {
-					_oldGamesCount++;
-					continue;	// Skip duplicates
-				}
-			}
-			_games.push_back(result);
-
-			_list->append(result.description);
-		}
-
+		addCandidates(job->dir, detectionResults.listRecognizedGames());
 
 		// Recurse into all subdirs
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			if (file->isDirectory()) {
-				_scanStack.push(*file);
+		for (Common::FSList::const_iterator file = job->subdirs.begin(); file != job->subdirs.end(); ++file) {
+			_scanStack.push(*file);
 
-				_dirTotal++;
-			}
+			_dirTotal++;
 		}
 
 		_dirsScanned++;
 
+		// Only the job object itself stays around until the scan ends
+		job->subdirs.clear();
+		job->detected.clear();
+	}
+
 #if defined(USE_TASKBAR)
+	if (!finished.empty()) {
 		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
 		g_system->getTaskbarManager()->setCount(_games.size());
+	}
 #endif
+}
+
+void MassAddDialog::addCandidates(const Common::FSNode &dir, const DetectedGames &candidates) {
+	// Just add all detected games / game variants. If we get more than one,
+	// that either means the directory contains multiple games, or the detector
+	// could not fully determine which game variant it was seeing. In either
+	// case, let the user choose which entries he wants to keep.
+	//
+	// However, we only add games which are not already in the config file.
+	for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
+		const DetectedGame &result = *cand;
+
+		Common::String path = dir.getPath();
+
+		// Remove trailing slashes
+		while (path != "/" && path.lastChar() == '/')
+			path.deleteLastChar();
+
+		// Check for existing config entries for this path/engineid/gameid/lang/platform combination
+		if (_pathToTargets.contains(path)) {
+			Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
+			Common::String resultLanguageCode = Common::getLanguageCode(result.language);
+
+			bool duplicate = false;
+			const Common::StringArray &targets = _pathToTargets[path];
+			for (Common::StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
+				// If the engineid, gameid, platform and language match -> skip it
+				Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
+				assert(dom);
+
+				if ((!dom->contains("engineid") || (*dom)["engineid"] == result.engineId) &&
+					(*dom)["gameid"] == result.gameId &&
+				    dom->getValOrDefault("platform") == resultPlatformCode &&
+					parseLanguage(dom->getValOrDefault("language")) == parseLanguage(resultLanguageCode)) {
+					duplicate = true;
+					break;
+				}
+			}
+			if (duplicate) {
+				_oldGamesCount++;
+				continue;	// Skip duplicates
+			}
+		}
+		_games.push_back(result);
+
+		_list->append(result.description);
 	}
+}
+
+void MassAddDialog::handleTickle() {
+	if (_scanStack.empty() && !_jobsRunning)
+		return;	// We have finished scanning
+
+	uint32 t = g_system->getMillis();
 
+	// Perform a breadth-first scan of the filesystem. With worker threads
+	// every known directory is handed out at once and the jobs finished
+	// since the last tickle are collected. Without them each job runs
+	// right away, so stop once the time budget is used up.
+	const bool threaded = g_system->getThreadPool().getWorkerCount() > 0;
+	do {
+		while (!_scanStack.empty()) {
+			startJob(_scanStack.pop());
+			if (!threaded)
+				break;
+		}
+
+		processFinishedJobs();
+	} while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime);
+
+	const bool complete = _scanStack.empty() && !_jobsRunning;
+	if (complete)
+		stopScan();
 
 	// Update the dialog
 	Common::U32String buf;
 
-	if (_scanStack.empty()) {
+	if (complete) {
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
+		PersistentMD5Man.flush(true);
+
 		buf = _("Scan complete!");
 		_dirProgressText->setLabel(buf);
 
@@ -26,9 +26,15 @@
 #include "gui/widgets/list.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/queue.h"
 #include "common/stack.h"
 #include "common/str.h"
 
+namespace Common {
+class TaskGroup;
+}
+
 namespace GUI {
 
 class StaticTextWidget;
@@ -36,6 +42,7 @@ class StaticTextWidget;
 class MassAddDialog : public Dialog {
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -48,9 +55,41 @@ public:
 	}
 
 private:
+	class ScanJob;
+
+	/**
+	 * Scan the directory on a worker thread. Without worker threads the
+	 * job runs right away.
+	 */
+	void startJob(const Common::FSNode &dir);
+
+	/** Add the results of the jobs that finished since the last call. */
+	void processFinishedJobs();
+
+	/** Stop all scanning and wait until the jobs have returned. */
+	void stopScan();
+
+	void addCandidates(const Common::FSNode &dir, const DetectedGames &candidates);
+
+	/** Directories that have not been handed to a job yet. */
 	Common::Stack<Common::FSNode>  _scanStack;
 	DetectedGames _games;
 
+	Common::TaskGroup *_taskGroup;
+	Common::Array<ScanJob *> _jobs;
+	uint _jobsRunning;
+
+	/** Guards _finishedJobs and _cancelled, which the jobs access. */
+	Common::Mutex _jobMutex;
+	Common::Queue<ScanJob *> _finishedJobs;
+	bool _cancelled;
+
+	/**
+	 * Detection code keeps global state, such as the MD5 caches, so jobs
+	 * only enumerate directories concurrently and take turns detecting.
+	 */
+	Common::Mutex _detectMutex;
+
 	/**
 	 * Map each path occuring in the config file to the target(s) using that path.
 	 * Used to detect whether a potential new target is already present in the
@@ -21,6 +21,12 @@
 
 #include "gui/saveload-dialog.h"
 
+#ifndef DISABLE_SAVELOADCHOOSER_GRID
+namespace Common {
+DECLARE_SINGLETON(GUI::SaveMetaInfoCache);
+}
+#endif // !DISABLE_SAVELOADCHOOSER_GRID
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 #include "backends/cloud/cloudmanager.h"
 #include "backends/cloud/savessyncrequest.h"
@@ -899,6 +905,7 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
+	SaveMetaInfoCache::instance().clear();
 	updateSaves();
 	g_gui.scheduleTopDialogRedraw();
 }
@@ -907,6 +914,7 @@ void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
 	listSaves();
+	SaveMetaInfoCache::instance().validate(_target);
 	_resultString.clear();
 
 	// Load information to restore the last page the user had open.
@@ -1083,6 +1091,7 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_pendingMetaInfos.clear();
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -1133,6 +1142,7 @@ void SaveLoadChooserGrid::destroyButtons() {
 	}
 
 	_buttons.clear();
+	_pendingMetaInfos.clear();
 }
 
 void SaveLoadChooserGrid::hideButtons() {
@@ -1142,63 +1152,106 @@ void SaveLoadChooserGrid::hideButtons() {
 	}
 }
 
-void SaveLoadChooserGrid::updateSaves() {
-	hideButtons();
+void SaveLoadChooserGrid::loadPendingMetaInfos(uint32 timeLimit) {
+	const uint32 start = g_system->getMillis();
+	bool updated = false;
 
-	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
+	while (!_pendingMetaInfos.empty() && g_system->getMillis() - start < timeLimit) {
+		const uint i = _pendingMetaInfos.remove_at(0);
 		const uint saveSlot = _saveList[i].getSaveSlot();
 
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		if (!_saveList[i].getLocked() && desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
+		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		if (desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
 			_saveList[i] = desc;
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + desc.getDescription());
+		else
+			desc = _saveList[i];
+		SaveMetaInfoCache::instance().add(desc);
 
-		Common::U32String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
+		updateSlotButton(_buttons[i - _curPage * _entriesPerPage], desc);
+		updated = true;
+	}
 
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
+	if (updated)
+		g_gui.scheduleTopDialogRedraw();
+}
 
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
+void SaveLoadChooserGrid::handleTickle() {
+	if (!_pendingMetaInfos.empty())
+		loadPendingMetaInfos(kMetaInfoLoadTime);
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", desc.getSaveSlot())) + desc.getDescription());
+
+	Common::U32String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
 		}
 
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
 		}
+	}
 
-		curButton.button->setTooltip(tooltip);
+	curButton.button->setTooltip(tooltip);
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::updateSaves() {
+	hideButtons();
+	_pendingMetaInfos.clear();
+
+	// Meta infos, which include the thumbnail, are loaded from the tickle
+	// handler when they are not cached, so that the page shows right away
+	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
+		SaveStateDescriptor desc;
+		if (_saveList[i].getLocked()) {
+			desc = _saveList[i];
+		} else if (!SaveMetaInfoCache::instance().get(_saveList[i].getSaveSlot(), desc)) {
+			desc = _saveList[i];
+			_pendingMetaInfos.push_back(i);
 		}
-		curButton.description->setEnabled(!desc.getLocked());
+
+		SlotButton &curButton = _buttons[curNum];
+		curButton.setVisible(true);
+		updateSlotButton(curButton, desc);
 	}
 
+	// Fill in whatever can be loaded without delaying the page noticeably
+	loadPendingMetaInfos(kMetaInfoLoadTime);
+
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
 	_pageDisplay->setLabel(Common::String::format("%u/%u", _curPage + 1, numPages));
 
@@ -1213,6 +1266,48 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveMetaInfoCache::validate(const Common::String &target) {
+	uint32 changeCounter;
+	if (!g_system->getSavefileManager()->getChangeCounter(changeCounter) ||
+			changeCounter != _changeCounter || target != _target)
+		clear();
+
+	_target = target;
+	_changeCounter = changeCounter;
+}
+
+void SaveMetaInfoCache::clear() {
+	_entries.clear();
+	// Nothing is valid anymore until validate() is called again
+	_target.clear();
+}
+
+bool SaveMetaInfoCache::get(int saveSlot, SaveStateDescriptor &desc) {
+	EntryMap::iterator entry = _entries.find(saveSlot);
+	if (entry == _entries.end())
+		return false;
+
+	entry->_value.lastUse = ++_useCounter;
+	desc = entry->_value.desc;
+	return true;
+}
+
+void SaveMetaInfoCache::add(const SaveStateDescriptor &desc) {
+	if (_entries.size() >= kMaxEntries && !_entries.contains(desc.getSaveSlot())) {
+		// Drop the least recently used entry
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+		_entries.erase(oldest);
+	}
+
+	Entry &entry = _entries[desc.getSaveSlot()];
+	entry.desc = desc;
+	entry.lastUse = ++_useCounter;
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
@@ -25,6 +25,9 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/hashmap.h"
+#include "common/singleton.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
@@ -202,6 +205,43 @@ private:
 	EditTextWidget *_description;
 };
 
+/**
+ * Meta infos, including the thumbnails, of the save slots shown in the grid
+ * chooser. They are kept across openings of the chooser, as long as the
+ * target stays the same and the save file manager reports no changes.
+ */
+class SaveMetaInfoCache : public Common::Singleton<SaveMetaInfoCache> {
+public:
+	/** Drop all entries, unless they are still valid for @p target. */
+	void validate(const Common::String &target);
+
+	void clear();
+
+	/** Return the cached meta infos of @p saveSlot, if any. */
+	bool get(int saveSlot, SaveStateDescriptor &desc);
+	void add(const SaveStateDescriptor &desc);
+
+private:
+	friend class Common::Singleton<SaveMetaInfoCache>;
+	SaveMetaInfoCache() : _useCounter(0), _changeCounter(0) {}
+
+	enum {
+		/** Number of save slots whose meta infos are kept. */
+		kMaxEntries = 64
+	};
+
+	struct Entry {
+		SaveStateDescriptor desc;
+		uint32 lastUse;
+	};
+	typedef Common::HashMap<int, Entry> EntryMap;
+	EntryMap _entries;
+	uint32 _useCounter;
+
+	Common::String _target;
+	uint32 _changeCounter;
+};
+
 class SaveLoadChooserGrid : public SaveLoadChooserDialog {
 public:
 	SaveLoadChooserGrid(const Common::U32String &title, bool saveMode);
@@ -216,6 +256,8 @@ public:
 	SaveLoadChooserType getType() const override { return kSaveLoadDialogGrid; }
 
 	void close() override;
+
+	void handleTickle() override;
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
@@ -223,6 +265,16 @@ protected:
 private:
 	int runIntern() override;
 
+	enum {
+		/** Time (in milliseconds) spent loading meta infos per tickle. */
+		kMetaInfoLoadTime = 20
+	};
+
+	/** Indices into _saveList of the visible slots still waiting for their meta infos. */
+	Common::Array<uint> _pendingMetaInfos;
+
+	void loadPendingMetaInfos(uint32 timeLimit);
+
 	uint _columns, _lines;
 	uint _entriesPerPage;
 	uint _curPage;
@@ -256,6 +308,7 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &curButton, const SaveStateDescriptor &desc);
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -28,6 +28,7 @@
 
 #include "gui/gui-manager.h"
 #include "gui/widgets/grid.h"
+#include "gui/widgets/list.h"
 
 #include "gui/ThemeEval.h"
 
@@ -491,8 +492,15 @@ void GridWidget::setEntryList(Common::Array<GridItemInfo> *list) {
 	_isGridInvalid = true;
 	_selectedEntry = nullptr;
 
+	_filterTitles.clear();
+	_sortedFilter.clear();
+
 	for (Common::Array<GridItemInfo>::iterator entryIter = list->begin(); entryIter != list->end(); ++entryIter) {
 		_dataEntryList.push_back(*entryIter);
+
+		Common::U32String title(entryIter->title);
+		title.toLowercase();
+		_filterTitles.push_back(title);
 	}
 	// TODO: Remove this below, add drawWidget(), that should do the drawing
 	if (!_gridItems.empty()) {
@@ -535,6 +543,14 @@ void GridWidget::groupEntries() {
 
 void GridWidget::sortGroups() {
 	uint oldHeight = _innerHeight;
+
+	// While a search string is typed, every filter narrows down the
+	// previous one, and only its matches have to be tested again.
+	Common::Array<GridItemInfo *> candidates;
+	const bool narrowing = !_filter.empty() && !_sortedFilter.empty() && isFilterNarrowing(_sortedFilter, _filter);
+	if (narrowing)
+		candidates.swap(_sortedEntryList);
+
 	_sortedEntryList.clear();
 	_headerEntryList.clear();
 
@@ -570,29 +586,26 @@ void GridWidget::sortGroups() {
 		// Restrict the list to everything which contains all words in _filter
 		// as substrings, ignoring case.
 
-		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
-
-		_sortedEntryList.clear();
+		Common::U32StringArray tokens = Common::U32StringTokenizer(_filter).split();
 
-		for (GridItemInfo *i = _dataEntryList.begin(); i != _dataEntryList.end(); ++i, ++n) {
-			tmp = i->title;
-			tmp.toLowercase();
+		const uint count = narrowing ? candidates.size() : _dataEntryList.size();
+		for (uint n = 0; n < count; ++n) {
+			GridItemInfo *entry = narrowing ? candidates[n] : &_dataEntryList[n];
+			const Common::U32String &title = _filterTitles[entry - _dataEntryList.begin()];
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+			for (uint t = 0; t < tokens.size(); ++t) {
+				if (!title.contains(tokens[t])) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_sortedEntryList.push_back(i);
+				_sortedEntryList.push_back(entry);
 			}
 		}
 	}
+	_sortedFilter = _filter;
 
 	calcEntrySizes();
 	calcInnerHeight();
@@ -109,6 +109,10 @@ protected:
 	Common::Array<GridItemInfo>			_headerEntryList;
 	Common::Array<GridItemInfo *>		_sortedEntryList;
 	Common::Array<GridItemInfo *>		_visibleEntryList;
+	/// Titles of _dataEntryList in lower case, matched against the filter.
+	Common::Array<Common::U32String>	_filterTitles;
+	/// The filter _sortedEntryList was last built with.
+	Common::U32String					_sortedFilter;
 
 	Common::String							_groupingAttribute;
 	Common::HashMap<Common::U32String, int>	_groupValueIndex;
@@ -36,6 +36,30 @@ bool ListWidgetDefaultMatcher(void *, int, const Common::U32String &item, const
 	return item.contains(token);
 }
 
+static bool isPlainFilterToken(const Common::U32String &token) {
+	for (uint i = 0; i < token.size(); ++i) {
+		if (token[i] == '!' || token[i] == ':' || token[i] == '=' || token[i] == '~')
+			return false;
+	}
+	return true;
+}
+
+bool isFilterNarrowing(const Common::U32String &oldFilter, const Common::U32String &newFilter) {
+	Common::U32StringArray oldTokens = Common::U32StringTokenizer(oldFilter).split();
+	Common::U32StringArray newTokens = Common::U32StringTokenizer(newFilter).split();
+
+	if (oldTokens.empty() || newTokens.size() < oldTokens.size())
+		return false;
+
+	for (uint i = 0; i < newTokens.size(); ++i) {
+		if (!isPlainFilterToken(newTokens[i]))
+			return false;
+		if (i < oldTokens.size() && !newTokens[i].contains(oldTokens[i]))
+			return false;
+	}
+	return true;
+}
+
 ListWidget::ListWidget(Dialog *boss, const Common::String &name, const Common::U32String &tooltip, uint32 cmd)
 	: EditableWidget(boss, name, tooltip), _cmd(cmd) {
 
@@ -750,6 +774,7 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	Common::U32String oldFilter = _filter;
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -762,32 +787,7 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 
 		_listIndex.clear();
 	} else {
-		// Restrict the list to everything which matches all tokens in _filter, ignoring case.
-
-		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
-
-		_list.clear();
-		_listIndex.clear();
-
-		for (auto i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = i->clean;
-			tmp.toLowercase();
-			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!_filterMatcher(_filterMatcherArg, n, tmp, tok.nextToken())) {
-					matches = false;
-					break;
-				}
-			}
-
-			if (matches) {
-				_list.push_back(i->orig);
-				_listIndex.push_back(n);
-			}
-		}
+		filterItems(oldFilter);
 	}
 
 	_currentPos = 0;
@@ -810,6 +810,44 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	}
 }
 
+void ListWidget::filterItems(const Common::U32String &oldFilter) {
+	// Restrict the list to everything which matches all tokens in _filter, ignoring case.
+	Common::U32StringArray tokens = Common::U32StringTokenizer(_filter).split();
+
+	// While a search string is typed, every filter narrows down the
+	// previous one, and only its matches have to be tested again.
+	Common::Array<int> candidates;
+	const bool narrowing = !oldFilter.empty() && isFilterNarrowing(oldFilter, _filter);
+	if (narrowing)
+		candidates.swap(_listIndex);
+
+	_list.clear();
+	_listIndex.clear();
+
+	const uint count = narrowing ? candidates.size() : _dataList.size();
+	for (uint i = 0; i < count; ++i) {
+		const int n = narrowing ? candidates[i] : (int)i;
+		// Skip the group headers of a GroupedListWidget, which it might
+		// have put back in after the filter was set.
+		if (n < 0)
+			continue;
+		const ListData &data = _dataList[n];
+
+		bool matches = true;
+		for (uint t = 0; t < tokens.size(); ++t) {
+			if (!_filterMatcher(_filterMatcherArg, n, data.lower, tokens[t])) {
+				matches = false;
+				break;
+			}
+		}
+
+		if (matches) {
+			_list.push_back(data.orig);
+			_listIndex.push_back(n);
+		}
+	}
+}
+
 Common::U32String ListWidget::getThemeColor(byte r, byte g, byte b) {
 	return Common::U32String::format("\001c%02x%02x%02x", r, g, b);
 }
@@ -45,6 +45,15 @@ enum {
 	kListSelectionChangedCmd	= 'Lsch'	///< selection changed - 'data' will be item index
 };
 
+/**
+ * Check whether every item matching @p newFilter also matches @p oldFilter,
+ * so that only the matches of the old filter have to be tested again. This
+ * is the case while a search string is typed: each token of the old filter
+ * is contained in the token at the same position in the new one. Tokens using
+ * the '!', ':', '=' or '~' operators of the launcher search are not compared.
+ */
+bool isFilterNarrowing(const Common::U32String &oldFilter, const Common::U32String &newFilter);
+
 /* ListWidget */
 class ListWidget : public EditableWidget {
 public:
@@ -53,8 +62,9 @@ public:
 	struct ListData {
 		Common::U32String orig;
 		Common::U32String clean;
+		Common::U32String lower; ///< clean in lower case, matched against the filter
 
-		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; }
+		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; lower = c; lower.toLowercase(); }
 	};
 
 	typedef Common::Array<ListData> ListDataArray;
@@ -129,6 +139,11 @@ public:
 	bool isEditable() const						{ return _editable; }
 	void setEditable(bool editable)				{ _editable = editable; }
 	void setEditColor(ThemeEngine::FontColor color) { _editColor = color; }
+	/**
+	 * Set the function used to match the items against the filter tokens.
+	 * Tokens without any of the '!', ':', '=' and '~' characters have to be
+	 * matched as substrings of the item, see isFilterNarrowing().
+	 */
 	void setFilterMatcher(FilterMatcher matcher, void *arg) { _filterMatcher = matcher; _filterMatcherArg = arg; }
 
 	// Made startEditMode/endEditMode for SaveLoadChooser
@@ -171,6 +186,13 @@ protected:
 
 	void copyListData(const Common::U32StringArray &list);
 
+	/**
+	 * Fill _list and _listIndex with the items matching the non-empty
+	 * _filter. If it narrows down @p oldFilter, which _listIndex still
+	 * holds the matches of, only those are tested.
+	 */
+	void filterItems(const Common::U32String &oldFilter);
+
 	void receivedFocusWidget() override;
 	void lostFocusWidget() override;
 	void checkBounds();
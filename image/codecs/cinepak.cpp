@@ -57,74 +57,65 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 }
 
 /**
- * Put a raw pixel to the destination surface
+ * Convert a codebook luma to a pixel of the output format
  */
 template<typename PixelInt>
-inline void putPixelRaw(PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = convertYUVToColor(clipTable, format, y, u, v);
+inline PixelInt convertCodebookPixel(const byte *clipTable, const Graphics::PixelFormat &format, byte y, int8 u, int8 v) {
+	return convertYUVToColor(clipTable, format, y, u, v);
 }
 
 /**
- * Specialized putPixelRaw for palettized 8bpp output
+ * Specialized convertCodebookPixel for palettized 8bpp output
  */
 template<>
-inline void putPixelRaw(byte *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = y;
+inline byte convertCodebookPixel(const byte *clipTable, const Graphics::PixelFormat &format, byte y, int8 u, int8 v) {
+	return y;
 }
 
 /**
- * The default codebook converter: raw output.
+ * Expand a codebook entry to the pixels of its block rows.
+ */
+template<typename PixelInt>
+void expandCodebookTmpl(const CinepakCodebook &codebook, byte codebookType, PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format) {
+	PixelInt pixels[4];
+	for (int i = 0; i < 4; i++)
+		pixels[i] = convertCodebookPixel<PixelInt>(clipTable, format, codebook.y[i], codebook.u, codebook.v);
+
+	if (codebookType == 1) {
+		// Every luma covers 2x2 pixels of the 4x4 block
+		dst[0] = dst[1] = pixels[0];
+		dst[2] = dst[3] = pixels[1];
+		dst[4] = dst[5] = pixels[2];
+		dst[6] = dst[7] = pixels[3];
+	} else {
+		for (int i = 0; i < 4; i++)
+			dst[i] = pixels[i];
+	}
+}
+
+/**
+ * The default codebook converter: copies the expanded codebooks, a block
+ * row at a time.
  */
 struct CodebookConverterRaw {
 	template<typename PixelInt>
 	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
+		const PixelInt *pixels = (const PixelInt *)strip.v1_pixels + (codebookIndex << 3);
+		memcpy(rows[0], pixels, 4 * sizeof(PixelInt));
+		memcpy(rows[1], pixels, 4 * sizeof(PixelInt));
+		memcpy(rows[2], pixels + 4, 4 * sizeof(PixelInt));
+		memcpy(rows[3], pixels + 4, 4 * sizeof(PixelInt));
 	}
 
 	template<typename PixelInt>
 	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-
-		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
-
-		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-
-		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+		for (int i = 0; i < 4; i++) {
+			const PixelInt *pixels = (const PixelInt *)strip.v4_pixels + (codebookIndex[i] << 2);
+			const int row = (i >> 1) << 1;
+			const int column = (i & 1) << 1;
+			memcpy(rows[row] + column, pixels, 2 * sizeof(PixelInt));
+			memcpy(rows[row + 1] + column, pixels + 2, 2 * sizeof(PixelInt));
+		}
 	}
 };
 
@@ -404,6 +395,12 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 	_curFrame.height = stream.readUint16BE();
 	_curFrame.stripCount = stream.readUint16BE();
 
+	// The codebooks are expanded to the format of the surface
+	if (!_curFrame.surface) {
+		_curFrame.surface = new Graphics::Surface();
+		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
+	}
+
 	if (!_curFrame.strips) {
 		_curFrame.strips = new CinepakStrip[_curFrame.stripCount];
 		for (uint16 i = 0; i < _curFrame.stripCount; i++) {
@@ -423,11 +420,6 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 			stream.seek(-2, SEEK_CUR);
 	}
 
-	if (!_curFrame.surface) {
-		_curFrame.surface = new Graphics::Surface();
-		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
-	}
-
 	_y = 0;
 
 	for (uint16 i = 0; i < _curFrame.stripCount; i++) {
@@ -441,6 +433,10 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 			// Copy the QuickTime dither tables
 			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
 			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
+
+			// And the expanded codebooks
+			memcpy(_curFrame.strips[i].v1_pixels, _curFrame.strips[i - 1].v1_pixels, sizeof(_curFrame.strips[i].v1_pixels));
+			memcpy(_curFrame.strips[i].v4_pixels, _curFrame.strips[i - 1].v4_pixels, sizeof(_curFrame.strips[i].v4_pixels));
 		}
 
 		_curFrame.strips[i].id = stream.readUint16BE();
@@ -513,9 +509,30 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 
 		if (_ditherType == kDitherTypeQT)
 			ditherCodebookQT(strip, codebookType, i);
+		else
+			expandCodebook(strip, codebookType, i);
 	}
 }
 
+void CinepakDecoder::expandCodebook(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	// The dithering converters work from the codebooks
+	if (_ditherPalette)
+		return;
+
+	CinepakStrip &cinepakStrip = _curFrame.strips[strip];
+	const Graphics::PixelFormat &format = _curFrame.surface->format;
+	const CinepakCodebook &codebook = (codebookType == 1) ? cinepakStrip.v1_codebook[codebookIndex] : cinepakStrip.v4_codebook[codebookIndex];
+	uint32 *pixels = (codebookType == 1) ? cinepakStrip.v1_pixels : cinepakStrip.v4_pixels;
+	const uint entrySize = (codebookType == 1) ? 8 : 4;
+
+	if (format.bytesPerPixel == 1)
+		expandCodebookTmpl<byte>(codebook, codebookType, (byte *)pixels + codebookIndex * entrySize, _clipTable, format);
+	else if (format.bytesPerPixel == 2)
+		expandCodebookTmpl<uint16>(codebook, codebookType, (uint16 *)pixels + codebookIndex * entrySize, _clipTable, format);
+	else if (format.bytesPerPixel == 4)
+		expandCodebookTmpl<uint32>(codebook, codebookType, pixels + codebookIndex * entrySize, _clipTable, format);
+}
+
 void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize) {
 	CinepakCodebook *codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook : _curFrame.strips[strip].v4_codebook;
 
@@ -549,9 +566,12 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Dither the codebook if we're dithering for QuickTime,
+			// otherwise convert it to the output format
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else
+				expandCodebook(strip, codebookType, i);
 		}
 	}
 }
@@ -46,6 +46,11 @@ struct CinepakStrip {
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
+
+	// The codebooks expanded to pixels of the output format, packed at its
+	// pixel size. A v1 entry holds the two distinct rows of its 4x4 block,
+	// a v4 entry the two rows of its 2x2 block.
+	uint32 v1_pixels[256 * 8], v4_pixels[256 * 4];
 };
 
 struct CinepakFrame {
@@ -95,6 +100,7 @@ private:
 	DitherType _ditherType;
 
 	void initializeCodebook(uint16 strip, byte codebookType);
+	void expandCodebook(uint16 strip, byte codebookType, uint16 codebookIndex);
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 
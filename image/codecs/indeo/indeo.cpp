@@ -1000,8 +1000,8 @@ int IndeoDecoderBase::processEmptyTile(IVIBandDesc *band,
 
 	if (band->_inheritMv && needMc) { // apply motion compensation if there is at least one non-zero motion vector
 		int numBlocks = (band->_mbSize != band->_blkSize) ? 4 : 1; // number of blocks per mb
-		IviMCFunc mcNoDeltaFunc = (band->_blkSize == 8) ? IndeoDSP::ffIviMc8x8NoDelta
-			: IndeoDSP::ffIviMc4x4NoDelta;
+		IviMCFunc mcNoDeltaFunc = IndeoDSP::getFastMC((band->_blkSize == 8) ? IndeoDSP::ffIviMc8x8NoDelta
+			: IndeoDSP::ffIviMc4x4NoDelta);
 
 		int mbn;
 		for (mbn = 0, mb = tile->_mbs; mbn < tile->_numMBs; mb++, mbn++) {
@@ -1079,6 +1079,11 @@ int IndeoDecoderBase::decodeBlocks(GetBits *_gb, IVIBandDesc *band, IVITile *til
 		mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg4x4NoDelta;
 	}
 
+	mcWithDeltaFunc    = IndeoDSP::getFastMC(mcWithDeltaFunc);
+	mcNoDeltaFunc      = IndeoDSP::getFastMC(mcNoDeltaFunc);
+	mcAvgWithDeltaFunc = IndeoDSP::getFastMCAvg(mcAvgWithDeltaFunc);
+	mcAvgNoDeltaFunc   = IndeoDSP::getFastMCAvg(mcAvgNoDeltaFunc);
+
 	int mbn;
 	IVIMbInfo *mb;
 
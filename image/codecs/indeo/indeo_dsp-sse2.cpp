@@ -0,0 +1,361 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <emmintrin.h>
+
+namespace Image {
+namespace Indeo {
+
+namespace {
+
+/**
+ * The 8-point transforms work on four columns (or rows, once transposed)
+ * at a time, with all intermediate values in 32-bit lanes exactly like
+ * the scalar code.
+ */
+inline void transpose4x4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/** Transpose an 8x8 matrix stored as the left and right halves of its rows. */
+inline void transpose8x8(__m128i *left, __m128i *right) {
+	transpose4x4(left[0], left[1], left[2], left[3]);
+	transpose4x4(right[0], right[1], right[2], right[3]);
+	transpose4x4(left[4], left[5], left[6], left[7]);
+	transpose4x4(right[4], right[5], right[6], right[7]);
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = right[i];
+		right[i] = left[i + 4];
+		left[i + 4] = t;
+	}
+}
+
+inline __m128i add(__m128i a, __m128i b) {
+	return _mm_add_epi32(a, b);
+}
+
+inline __m128i sub(__m128i a, __m128i b) {
+	return _mm_sub_epi32(a, b);
+}
+
+/** Convert eight 32-bit values to 16 bits, truncating like a scalar store. */
+inline __m128i packTruncate(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/** Return a mask of the columns whose flag is clear. */
+inline void emptyColumns(const uint8 *flags, __m128i &left, __m128i &right) {
+	const __m128i empty = _mm_cmpeq_epi8(_mm_loadl_epi64((const __m128i *)flags), _mm_setzero_si128());
+	const __m128i empty16 = _mm_unpacklo_epi8(empty, empty);
+	left = _mm_unpacklo_epi16(empty16, empty16);
+	right = _mm_unpackhi_epi16(empty16, empty16);
+}
+
+/** Same as INV_HAAR8, with the arguments in the order of the coefficients. */
+inline void invHaar8(const __m128i *s, __m128i *d) {
+	__m128i t1 = _mm_slli_epi32(s[0], 1);
+	__m128i t5 = _mm_slli_epi32(s[1], 1);
+	__m128i t0 = _mm_srai_epi32(sub(t1, t5), 1);
+	t1 = _mm_srai_epi32(add(t1, t5), 1);
+	t5 = t0;
+
+	const __m128i t3 = _mm_srai_epi32(sub(t1, s[2]), 1);
+	t1 = _mm_srai_epi32(add(t1, s[2]), 1);
+	const __m128i t7 = _mm_srai_epi32(sub(t5, s[3]), 1);
+	t5 = _mm_srai_epi32(add(t5, s[3]), 1);
+
+	d[0] = _mm_srai_epi32(add(t1, s[4]), 1);
+	d[1] = _mm_srai_epi32(sub(t1, s[4]), 1);
+	d[2] = _mm_srai_epi32(add(t3, s[5]), 1);
+	d[3] = _mm_srai_epi32(sub(t3, s[5]), 1);
+	d[4] = _mm_srai_epi32(add(t5, s[6]), 1);
+	d[5] = _mm_srai_epi32(sub(t5, s[6]), 1);
+	d[6] = _mm_srai_epi32(add(t7, s[7]), 1);
+	d[7] = _mm_srai_epi32(sub(t7, s[7]), 1);
+}
+
+/** Same as IVI_IREFLECT. */
+inline void reflect(__m128i &s1, __m128i &s2) {
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128i t = add(_mm_srai_epi32(add(add(s1, _mm_slli_epi32(s2, 1)), two), 2), s1);
+	s2 = sub(_mm_srai_epi32(add(sub(_mm_slli_epi32(s1, 1), s2), two), 2), s2);
+	s1 = t;
+}
+
+inline void bfly(__m128i &s1, __m128i &s2) {
+	const __m128i t = sub(s1, s2);
+	s1 = add(s1, s2);
+	s2 = t;
+}
+
+/**
+ * Same as IVI_INV_SLANT8, with the arguments in the order of the
+ * coefficients. @p compensate selects the rounding of the second pass.
+ */
+inline void invSlant8(const __m128i *s, __m128i *d, bool compensate) {
+	const __m128i four = _mm_set1_epi32(4);
+	// IVI_SLANT_PART4 on s4 and s5
+	__m128i t4 = add(s[3], _mm_srai_epi32(add(sub(_mm_slli_epi32(s[1], 2), s[3]), four), 3));
+	__m128i t5 = add(s[1], _mm_srai_epi32(add(sub(_mm_setzero_si128(), add(s[1], _mm_slli_epi32(s[3], 2))), four), 3));
+
+	__m128i t1 = add(s[0], t5);
+	t5 = sub(s[0], t5);
+	__m128i t2 = add(s[4], s[5]);
+	__m128i t6 = sub(s[4], s[5]);
+	__m128i t7 = add(s[7], s[6]);
+	__m128i t3 = sub(s[7], s[6]);
+	__m128i t8 = sub(t4, s[2]);
+	t4 = add(t4, s[2]);
+
+	bfly(t1, t2);
+	reflect(t4, t3);
+	bfly(t5, t6);
+	reflect(t8, t7);
+	bfly(t1, t4);
+	bfly(t2, t3);
+	bfly(t5, t8);
+	bfly(t6, t7);
+
+	d[0] = t1;
+	d[1] = t2;
+	d[2] = t3;
+	d[3] = t4;
+	d[4] = t5;
+	d[5] = t6;
+	d[6] = t7;
+	d[7] = t8;
+	if (compensate) {
+		const __m128i one = _mm_set1_epi32(1);
+		for (int i = 0; i < 8; i++)
+			d[i] = _mm_srai_epi32(add(d[i], one), 1);
+	}
+}
+
+inline void loadRows(const int32 *in, __m128i *left, __m128i *right) {
+	for (int i = 0; i < 8; i++, in += 8) {
+		left[i] = _mm_loadu_si128((const __m128i *)in);
+		right[i] = _mm_loadu_si128((const __m128i *)(in + 4));
+	}
+}
+
+inline void storeRows(int16 *out, uint32 pitch, const __m128i *left, const __m128i *right) {
+	for (int i = 0; i < 8; i++, out += pitch)
+		_mm_storeu_si128((__m128i *)out, packTruncate(left[i], right[i]));
+}
+
+/** Apply @p transform to the rows of the transposed matrix and transpose it back. */
+template<class Transform>
+inline void transformRows(__m128i *left, __m128i *right, Transform transform) {
+	transpose8x8(left, right);
+	__m128i resultLeft[8], resultRight[8];
+	transform(left, resultLeft);
+	transform(right, resultRight);
+	for (int i = 0; i < 8; i++) {
+		left[i] = resultLeft[i];
+		right[i] = resultRight[i];
+	}
+	transpose8x8(left, right);
+}
+
+struct Haar {
+	void operator()(const __m128i *s, __m128i *d) const { invHaar8(s, d); }
+};
+
+struct Slant {
+	bool compensate;
+	explicit Slant(bool c) : compensate(c) {}
+	void operator()(const __m128i *s, __m128i *d) const { invSlant8(s, d, compensate); }
+};
+
+/** Transform the columns and clear the ones that are flagged as empty. */
+template<class Transform>
+inline void transformColumns(__m128i *left, __m128i *right, const uint8 *flags, Transform transform) {
+	__m128i resultLeft[8], resultRight[8];
+	transform(left, resultLeft);
+	transform(right, resultRight);
+
+	__m128i emptyLeft, emptyRight;
+	emptyColumns(flags, emptyLeft, emptyRight);
+	for (int i = 0; i < 8; i++) {
+		left[i] = _mm_andnot_si128(emptyLeft, resultLeft[i]);
+		right[i] = _mm_andnot_si128(emptyRight, resultRight[i]);
+	}
+}
+
+template<int kSize>
+inline __m128i loadPixels(const int16 *src) {
+	return kSize == 8 ? _mm_loadu_si128((const __m128i *)src) : _mm_loadl_epi64((const __m128i *)src);
+}
+
+template<int kSize>
+inline void storePixels(int16 *dst, __m128i value) {
+	if (kSize == 8)
+		_mm_storeu_si128((__m128i *)dst, value);
+	else
+		_mm_storel_epi64((__m128i *)dst, value);
+}
+
+/** (a + b) >> 1 without overflowing 16 bits. */
+inline __m128i average2(__m128i a, __m128i b) {
+	return _mm_add_epi16(_mm_and_si128(a, b), _mm_srai_epi16(_mm_xor_si128(a, b), 1));
+}
+
+inline __m128i widenLo(__m128i a) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+
+inline __m128i widenHi(__m128i a) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+}
+
+/** (a + b + c + d) >> 2, computed in 32 bits like the scalar code. */
+inline __m128i average4(__m128i a, __m128i b, __m128i c, __m128i d) {
+	const __m128i lo = add(add(widenLo(a), widenLo(b)), add(widenLo(c), widenLo(d)));
+	const __m128i hi = add(add(widenHi(a), widenHi(b)), add(widenHi(c), widenHi(d)));
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+
+template<int kSize, bool kAdd>
+inline void storePrediction(int16 *buf, __m128i value) {
+	if (kAdd)
+		value = _mm_add_epi16(loadPixels<kSize>(buf), value);
+	storePixels<kSize>(buf, value);
+}
+
+/** Same as the iviMc*() functions of the scalar code. */
+template<int kSize, bool kAdd>
+void motionCompensate(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		for (int i = 0; i < kSize; i++, buf += dpitch, refBuf += pitch)
+			storePrediction<kSize, kAdd>(buf, loadPixels<kSize>(refBuf));
+		break;
+	case 1: // horizontal halfpel interpolation
+		for (int i = 0; i < kSize; i++, buf += dpitch, refBuf += pitch)
+			storePrediction<kSize, kAdd>(buf, average2(loadPixels<kSize>(refBuf), loadPixels<kSize>(refBuf + 1)));
+		break;
+	case 2: // vertical halfpel interpolation
+		for (int i = 0; i < kSize; i++, buf += dpitch, refBuf += pitch)
+			storePrediction<kSize, kAdd>(buf, average2(loadPixels<kSize>(refBuf), loadPixels<kSize>(refBuf + pitch)));
+		break;
+	case 3: // vertical and horizontal halfpel interpolation
+		for (int i = 0; i < kSize; i++, buf += dpitch, refBuf += pitch) {
+			storePrediction<kSize, kAdd>(buf, average4(loadPixels<kSize>(refBuf), loadPixels<kSize>(refBuf + 1),
+			                                           loadPixels<kSize>(refBuf + pitch), loadPixels<kSize>(refBuf + pitch + 1)));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+template<int kSize, bool kAdd>
+void motionCompensateAvg(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	int16 tmp[kSize * kSize];
+
+	motionCompensate<kSize, false>(tmp, kSize, refBuf, pitch, mcType);
+	motionCompensate<kSize, true>(tmp, kSize, refBuf2, pitch, mcType2);
+	for (int i = 0; i < kSize; i++, buf += pitch)
+		storePrediction<kSize, kAdd>(buf, _mm_srai_epi16(loadPixels<kSize>(tmp + i * kSize), 1));
+}
+
+} // End of anonymous namespace
+
+void IndeoDSP::ffIviInverseHaar8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i left[8], right[8];
+	loadRows(in, left, right);
+
+	// pre-scaling of the first four columns
+	for (int i = 0; i < 4; i++)
+		left[i] = _mm_slli_epi32(left[i], 1);
+
+	transformColumns(left, right, flags, Haar());
+	transformRows(left, right, Haar());
+	storeRows(out, pitch, left, right);
+}
+
+void IndeoDSP::ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i left[8], right[8];
+	loadRows(in, left, right);
+	transformColumns(left, right, flags, Slant(false));
+	transformRows(left, right, Slant(true));
+	storeRows(out, pitch, left, right);
+}
+
+void IndeoDSP::ffIviRowSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i left[8], right[8];
+	loadRows(in, left, right);
+	transformRows(left, right, Slant(true));
+	storeRows(out, pitch, left, right);
+}
+
+void IndeoDSP::ffIviColSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i left[8], right[8];
+	loadRows(in, left, right);
+	transformColumns(left, right, flags, Slant(true));
+	storeRows(out, pitch, left, right);
+}
+
+void IndeoDSP::ffIviMc8x8DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	motionCompensate<8, true>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc4x4DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	motionCompensate<4, true>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	motionCompensate<8, false>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	motionCompensate<4, false>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMcAvg8x8DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	motionCompensateAvg<8, true>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg4x4DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	motionCompensateAvg<4, true>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	motionCompensateAvg<8, false>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	motionCompensateAvg<4, false>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
@@ -25,6 +25,7 @@
  * written, produced, and directed by Alan Smithee
  */
 
+#include "common/system.h"
 #include "image/codecs/indeo/indeo_dsp.h"
 
 namespace Image {
@@ -603,5 +604,66 @@ IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+static bool hasSSE2() {
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return true;
+#else
+	return g_system && g_system->hasFeature(OSystem::kCpuFeatureSSE2);
+#endif
+#else
+	return false;
+#endif
+}
+
+InvTransformPtr *IndeoDSP::getFastTransform(InvTransformPtr *transform) {
+#ifdef SCUMMVM_SSE2
+	if (hasSSE2()) {
+		if (transform == ffIviInverseHaar8x8)
+			return ffIviInverseHaar8x8SSE2;
+		if (transform == ffIviInverseSlant8x8)
+			return ffIviInverseSlant8x8SSE2;
+		if (transform == ffIviRowSlant8)
+			return ffIviRowSlant8SSE2;
+		if (transform == ffIviColSlant8)
+			return ffIviColSlant8SSE2;
+	}
+#endif
+	return transform;
+}
+
+IviMCFunc IndeoDSP::getFastMC(IviMCFunc mc) {
+#ifdef SCUMMVM_SSE2
+	if (hasSSE2()) {
+		if (mc == ffIviMc8x8Delta)
+			return ffIviMc8x8DeltaSSE2;
+		if (mc == ffIviMc4x4Delta)
+			return ffIviMc4x4DeltaSSE2;
+		if (mc == ffIviMc8x8NoDelta)
+			return ffIviMc8x8NoDeltaSSE2;
+		if (mc == ffIviMc4x4NoDelta)
+			return ffIviMc4x4NoDeltaSSE2;
+	}
+#endif
+	return mc;
+}
+
+IviMCAvgFunc IndeoDSP::getFastMCAvg(IviMCAvgFunc mcAvg) {
+#ifdef SCUMMVM_SSE2
+	if (hasSSE2()) {
+		if (mcAvg == ffIviMcAvg8x8Delta)
+			return ffIviMcAvg8x8DeltaSSE2;
+		if (mcAvg == ffIviMcAvg4x4Delta)
+			return ffIviMcAvg4x4DeltaSSE2;
+		if (mcAvg == ffIviMcAvg8x8NoDelta)
+			return ffIviMcAvg8x8NoDeltaSSE2;
+		if (mcAvg == ffIviMcAvg4x4NoDelta)
+			return ffIviMcAvg4x4NoDeltaSSE2;
+	}
+#endif
+	return mcAvg;
+}
+
 } // End of namespace Indeo
 } // End of namespace Image
@@ -327,6 +327,32 @@ public:
 	 *  @param[in]      mcType2		Interpolation type for forward reference
 	 */
 	static void ffIviMcAvg4x4NoDelta(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+#ifdef SCUMMVM_SSE2
+	/**
+	 *  SSE2 versions of the functions above, producing the same output
+	 */
+	static void ffIviInverseHaar8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviRowSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviColSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviMc8x8DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMcAvg8x8DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+#endif
+
+	/**
+	 *  Return the fastest version of a transform or motion compensation
+	 *  function available on this CPU, which may be the function itself.
+	 */
+	static InvTransformPtr *getFastTransform(InvTransformPtr *transform);
+	static IviMCFunc getFastMC(IviMCFunc mc);
+	static IviMCAvgFunc getFastMCAvg(IviMCAvgFunc mcAvg);
 };
 
 } // End of namespace Indeo
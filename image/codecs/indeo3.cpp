@@ -33,6 +33,7 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#include "graphics/frame_pool.h"
 #include "graphics/yuv_to_rgb.h"
 
 #include "image/codecs/indeo3.h"
@@ -301,8 +302,7 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 				fWidth, fHeight, fWidth, chromaWidth + 1);
 	} else {
 		// Need to upscale, so decode to a temp surface first
-		Graphics::Surface tempSurface;
-		tempSurface.create(fWidth, fHeight, _surface->format);
+		Graphics::Surface &tempSurface = *FramePoolMan.acquire(fWidth, fHeight, _surface->format);
 
 		YUVToRGBMan.convert410(&tempSurface, Graphics::YUVToRGBManager::kScaleITU, srcY, tempU, tempV,
 				fWidth, fHeight, fWidth, chromaWidth + 1);
@@ -319,7 +319,7 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
  			}
 		}
 
-		tempSurface.free();
+		FramePoolMan.release(&tempSurface);
 	}
 
 	delete[] tempU;
@@ -491,12 +491,12 @@ void Indeo3Decoder::decodeChunk(byte *cur, byte *ref, int width, int height,
 			cmd = (bit_buf >> bit_pos) & 0x03;
 
 			if (cmd == 0 || ref_vectors != NULL) {
-				for (lp1 = 0; lp1 < blks_width; lp1++) {
-					for (i = 0, j = 0; i < blks_height; i++, j += width_tbl[1])
-						((uint32 *)cur_frm_pos)[j] = READ_UINT32(((uint32 *)ref_frm_pos)+j);
-					cur_frm_pos += 4;
-					ref_frm_pos += 4;
-				}
+				// Copy the cell row by row, the source is either another
+				// frame or the row above, which has already been copied
+				for (i = 0, j = 0; i < blks_height; i++, j += width_tbl[1] << 2)
+					memcpy(cur_frm_pos + j, ref_frm_pos + j, blks_width << 2);
+				cur_frm_pos += blks_width << 2;
+				ref_frm_pos += blks_width << 2;
 			} else if (cmd != 1)
 				return;
 		} else {
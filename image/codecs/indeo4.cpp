@@ -343,7 +343,7 @@ int Indeo4Decoder::decodeBandHeader(IVIBandDesc *band) {
 			if ((transformId >= 0 && transformId <= 2) || transformId == 10)
 				_ctx._usesHaar = true;
 
-			band->_invTransform = _transforms[transformId]._invTrans;
+			band->_invTransform = IndeoDSP::getFastTransform(_transforms[transformId]._invTrans);
 			band->_dcTransform = _transforms[transformId]._dcTrans;
 			band->_is2dTrans = _transforms[transformId]._is2dTrans;
 
@@ -66,8 +66,15 @@ const Graphics::Surface *JPEGDecoder::getSurface() const {
 	return &_surface;
 }
 
+const Graphics::Surface *JPEGDecoder::getYUVPlane(uint index) const {
+	assert(index < ARRAYSIZE(_planes));
+	return _planes[index].getPixels() ? &_planes[index] : nullptr;
+}
+
 void JPEGDecoder::destroy() {
 	_surface.free();
+	for (uint i = 0; i < ARRAYSIZE(_planes); ++i)
+		_planes[i].free();
 }
 
 const Graphics::Surface *JPEGDecoder::decodeFrame(Common::SeekableReadStream &stream) {
@@ -227,6 +234,56 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 } // End of anonymous namespace
 #endif
 
+bool JPEGDecoder::loadPlanes(jpeg_decompress_struct &cinfo) {
+#ifdef USE_JPEG
+	// Skip the upsampling and color conversion
+	cinfo.out_color_space = JCS_YCbCr;
+	cinfo.raw_data_out = TRUE;
+	jpeg_start_decompress(&cinfo);
+
+	// Every call returns one row of MCUs, which may extend past the bottom
+	// and right edges of the image. The planes are allocated at their
+	// padded size and then cropped to the image.
+	const uint mcuWidth = cinfo.max_h_samp_factor * DCTSIZE;
+	const uint mcusPerRow = (cinfo.image_width + mcuWidth - 1) / mcuWidth;
+	JSAMPROW rows[3][4 * DCTSIZE];
+	JSAMPARRAY planeRows[3];
+	for (int i = 0; i < 3; ++i) {
+		const jpeg_component_info &component = cinfo.comp_info[i];
+		if (component.v_samp_factor > 4) {
+			jpeg_abort_decompress(&cinfo);
+			return false;
+		}
+
+		_planes[i].create(mcusPerRow * component.h_samp_factor * DCTSIZE, cinfo.total_iMCU_rows * component.v_samp_factor * DCTSIZE,
+		                  Graphics::PixelFormat::createFormatCLUT8());
+		planeRows[i] = rows[i];
+	}
+
+	const int linesPerCall = cinfo.max_v_samp_factor * DCTSIZE;
+	for (uint mcuRow = 0; cinfo.output_scanline < cinfo.output_height; ++mcuRow) {
+		for (int i = 0; i < 3; ++i) {
+			const int componentLines = cinfo.comp_info[i].v_samp_factor * DCTSIZE;
+			for (int line = 0; line < componentLines; ++line)
+				rows[i][line] = (JSAMPROW)_planes[i].getBasePtr(0, mcuRow * componentLines + line);
+		}
+
+		if (jpeg_read_raw_data(&cinfo, planeRows, linesPerCall) == 0)
+			break;
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		_planes[i].w = cinfo.comp_info[i].downsampled_width;
+		_planes[i].h = cinfo.comp_info[i].downsampled_height;
+	}
+
+	jpeg_finish_decompress(&cinfo);
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #ifdef USE_JPEG
 	// Reset member variables from previous decodings
@@ -249,8 +306,19 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Read the file header
 	jpeg_read_header(&cinfo, TRUE);
 
+	// Only YCbCr images can be output as planes
+	ColorSpace outSpace = _colorSpace;
+	if (outSpace == kColorSpaceYUVPlanar && (cinfo.jpeg_color_space != JCS_YCbCr || cinfo.num_components != 3))
+		outSpace = kColorSpaceRGB;
+
+	if (outSpace == kColorSpaceYUVPlanar) {
+		bool result = loadPlanes(cinfo);
+		jpeg_destroy_decompress(&cinfo);
+		return result;
+	}
+
 	// We can request YUV output because Groovie requires it
-	switch (_colorSpace) {
+	switch (outSpace) {
 	case kColorSpaceRGB: {
 		J_COLOR_SPACE colorSpace = fromScummvmPixelFormat(_requestedPixelFormat);
 
@@ -283,7 +351,7 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
-	switch (_colorSpace) {
+	switch (outSpace) {
 	case kColorSpaceRGB: {
 		Graphics::PixelFormat outputPixelFormat;
 		if (cinfo.out_color_space == JCS_RGB) {
@@ -325,7 +393,7 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
+	if (outSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
 		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
 	}
 
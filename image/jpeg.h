@@ -26,6 +26,8 @@
 #include "image/image_decoder.h"
 #include "image/codecs/codec.h"
 
+struct jpeg_decompress_struct;
+
 namespace Common {
 class SeekableReadStream;
 }
@@ -83,7 +85,20 @@ public:
 		 * You should only use this when you are really aware of what you are
 		 * doing!
 		 */
-		kColorSpaceYUV
+		kColorSpaceYUV,
+
+		/**
+		 * Output the Y, Cb and Cr planes as they are stored in the file,
+		 * without upsampling the chroma or converting to RGB. The planes
+		 * are returned by getYUVPlane() and can be uploaded as single
+		 * channel textures for a shader to convert, such as the one of
+		 * OpenGL::Shader::createYUVToRGBShader().
+		 *
+		 * Images that are not in YCbCr color space are decoded to RGB
+		 * with the format specified using `setOutputPixelFormat`, then
+		 * getYUVPlane() returns nullptr and getSurface() the image.
+		 */
+		kColorSpaceYUVPlanar
 	};
 
 	/**
@@ -96,12 +111,25 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Return a plane decoded with kColorSpaceYUVPlanar: 0 for Y, 1 for Cb
+	 * and 2 for Cr. The planes have one byte per pixel, and the chroma
+	 * planes are smaller than the luma plane for subsampled images.
+	 *
+	 * @return nullptr if the last image was not decoded into planes.
+	 */
+	const Graphics::Surface *getYUVPlane(uint index) const;
+
 private:
 	Graphics::Surface _surface;
+	Graphics::Surface _planes[3];
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
+
+	/** Decode the planes of an image whose header has been read. */
+	bool loadPlanes(jpeg_decompress_struct &cinfo);
 };
 /** @} */
 } // End of namespace Image
@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -303,6 +304,179 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #endif
 }
 
+#ifdef USE_PNG
+namespace {
+
+/**
+ * Sums the RGBA bytes of the rows that are merged into one row of a
+ * downscaled image.
+ */
+class RowAverager {
+public:
+	RowAverager(uint width, uint scaleShift) :
+			_width(width), _outWidth((width + (1 << scaleShift) - 1) >> scaleShift), _scaleShift(scaleShift), _rows(0),
+			_sums(new uint32[_outWidth * 4]), _output(new byte[_outWidth * 4]) {
+		memset(_sums, 0, _outWidth * 4 * sizeof(uint32));
+	}
+
+	~RowAverager() {
+		delete[] _sums;
+		delete[] _output;
+	}
+
+	void add(const byte *row) {
+		for (uint x = 0; x < _width; ++x) {
+			uint32 *sum = _sums + (x >> _scaleShift) * 4;
+			sum[0] += row[0];
+			sum[1] += row[1];
+			sum[2] += row[2];
+			sum[3] += row[3];
+			row += 4;
+		}
+		++_rows;
+	}
+
+	/** Return the average of the added rows and start the next row. */
+	const byte *flush() {
+		const uint blockWidth = 1 << _scaleShift;
+		for (uint x = 0; x < _outWidth; ++x) {
+			const uint count = MIN(blockWidth, _width - x * blockWidth) * _rows;
+			for (uint c = 0; c < 4; ++c)
+				_output[x * 4 + c] = (_sums[x * 4 + c] + count / 2) / count;
+		}
+
+		memset(_sums, 0, _outWidth * 4 * sizeof(uint32));
+		_rows = 0;
+		return _output;
+	}
+
+private:
+	uint _width;
+	uint _outWidth;
+	uint _scaleShift;
+	uint _rows;
+	uint32 *_sums;
+	byte *_output;
+};
+
+} // End of anonymous namespace
+#endif
+
+bool PNGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, const Graphics::PixelFormat &format,
+                                uint scaleShift, ProgressProc progress, void *progressParam) {
+#ifdef USE_PNG
+	destroy();
+
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	if (!_skipSignature) {
+		if (stream.readUint32BE() != MKTAG(0x89, 'P', 'N', 'G')) {
+			return false;
+		}
+		if (stream.readUint32BE() != MKTAG(0x0d, 0x0a, 0x1a, 0x0a)) {
+			return false;
+		}
+	}
+
+	png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+	if (!pngPtr) {
+		return false;
+	}
+	png_infop infoPtr = png_create_info_struct(pngPtr);
+	if (!infoPtr) {
+		png_destroy_read_struct(&pngPtr, NULL, NULL);
+		return false;
+	}
+
+	png_set_error_fn(pngPtr, NULL, pngError, pngWarning);
+	png_set_read_fn(pngPtr, &stream, pngReadFromStream);
+	png_set_crc_action(pngPtr, PNG_CRC_DEFAULT, PNG_CRC_WARN_USE);
+	png_set_sig_bytes(pngPtr, 8);
+	png_read_info(pngPtr, infoPtr);
+
+	int bitDepth, colorType, interlaceType;
+	png_uint_32 w, h;
+	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, &interlaceType, NULL, NULL);
+	const uint width = w;
+	const uint height = h;
+	const uint outWidth = (width + (1 << scaleShift) - 1) >> scaleShift;
+	const uint outHeight = (height + (1 << scaleShift) - 1) >> scaleShift;
+
+	if (dst.getPixels()) {
+		if (dst.format != format || (uint)dst.w < outWidth || (uint)dst.h < outHeight) {
+			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			return false;
+		}
+	} else {
+		dst.create(outWidth, outHeight, format);
+	}
+
+	// Let libpng turn every image into 8-bit RGBA, which is then
+	// converted to the output format one row at a time
+	const bool hasTransparency = png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS);
+	png_set_expand(pngPtr);
+	if (bitDepth == 16)
+		png_set_strip_16(pngPtr);
+	if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+		png_set_gray_to_rgb(pngPtr);
+	if (!(colorType & PNG_COLOR_MASK_ALPHA) && !hasTransparency)
+		png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+
+	const int passes = png_set_interlace_handling(pngPtr);
+	png_read_update_info(pngPtr, infoPtr);
+
+	const Graphics::PixelFormat rgbaFormat = getByteOrderRgbaPixelFormat(true);
+	const uint rowSize = width * 4;
+
+	// Interlaced images need all of their rows until the last pass
+	byte *image = nullptr;
+	byte *row = nullptr;
+	if (passes > 1) {
+		image = new byte[rowSize * height];
+		png_bytep *rowPtrs = new png_bytep[height];
+		for (uint y = 0; y < height; ++y)
+			rowPtrs[y] = image + y * rowSize;
+		png_read_image(pngPtr, rowPtrs);
+		delete[] rowPtrs;
+	} else {
+		row = new byte[rowSize];
+	}
+
+	RowAverager *averager = scaleShift ? new RowAverager(width, scaleShift) : nullptr;
+	const uint blockMask = (1 << scaleShift) - 1;
+
+	for (uint y = 0; y < height; ++y) {
+		const byte *src = image ? image + y * rowSize : row;
+		if (!image)
+			png_read_row(pngPtr, row, nullptr);
+
+		if (!averager) {
+			Graphics::crossBlit((byte *)dst.getBasePtr(0, y), src, dst.pitch, rowSize, width, 1, format, rgbaFormat);
+		} else {
+			averager->add(src);
+			if ((y & blockMask) == blockMask || y + 1 == height)
+				Graphics::crossBlit((byte *)dst.getBasePtr(0, y >> scaleShift), averager->flush(), dst.pitch, outWidth * 4,
+				                    outWidth, 1, format, rgbaFormat);
+		}
+
+		if (progress)
+			progress(progressParam, y + 1, height);
+	}
+
+	delete averager;
+	delete[] row;
+	delete[] image;
+
+	png_read_end(pngPtr, NULL);
+	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool writePNG(Common::WriteStream &out, const Graphics::Surface &input, const byte *palette) {
 #ifdef USE_PNG
 #ifdef SCUMM_LITTLE_ENDIAN
@@ -58,7 +58,40 @@ public:
 	PNGDecoder();
 	~PNGDecoder();
 
+	/**
+	 * Receives the progress of loadStreamInto(), once for every row of
+	 * the image that has been decoded.
+	 */
+	typedef void (*ProgressProc)(void *param, uint rowsDone, uint rowsTotal);
+
 	bool loadStream(Common::SeekableReadStream &stream) override;
+
+	/**
+	 * Decode an image row by row straight into @p dst, converting every
+	 * row to @p format as it is read. Unlike loadStream() followed by
+	 * convertTo(), no full-size copy of the image is kept in the PNG's
+	 * own format. Palettes and transparency are expanded to alpha, so
+	 * getSurface() and getPalette() are not set by this call.
+	 *
+	 * If @p dst has no pixels it is created with the size of the decoded
+	 * image. Otherwise it must have @p format and be at least that large,
+	 * and the image is written to its top left corner.
+	 *
+	 * Interlaced images are decoded in full before they are converted,
+	 * as their rows are only complete after the last pass.
+	 *
+	 * @param stream         The stream to load the image from.
+	 * @param dst            The surface to decode into.
+	 * @param format         The pixel format of @p dst, with 2 or 4 bytes per pixel.
+	 * @param scaleShift     Shrink the image by 1 << scaleShift in both directions,
+	 *                       averaging the pixels that are merged.
+	 * @param progress       Called for every decoded row, if not null.
+	 * @param progressParam  Passed to @p progress.
+	 * @return false if the stream is not a PNG image or @p dst does not fit.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, const Graphics::PixelFormat &format,
+	                    uint scaleShift = 0, ProgressProc progress = nullptr, void *progressParam = nullptr);
+
 	void destroy() override;
 	const Graphics::Surface *getSurface() const override { return _outputSurface; }
 	const byte *getPalette() const override { return _palette; }
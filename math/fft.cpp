@@ -27,6 +27,7 @@
 
 #include "math/fft.h"
 #include "math/cosinetables.h"
+#include "math/simd.h"
 #include "math/utils.h"
 #include "common/util.h"
 
@@ -125,19 +126,6 @@ int FFT::splitRadixPermutation(int i, int n, int inverse) {
 	BF(a2.im, a0.im, a0.im, t6); \
 }
 
-// force loading all the inputs before storing any.
-// this is slightly slower for small data, but avoids store->load aliasing
-// for addresses separated by large powers of 2.
-#define BUTTERFLIES_BIG(a0, a1, a2, a3) { \
-	float r0 = a0.re, i0 = a0.im, r1 = a1.re, i1 = a1.im; \
-	BF(t3, t5, t5, t1); \
-	BF(a2.re, a0.re, r0, t5); \
-	BF(a3.im, a1.im, i1, t3); \
-	BF(t4, t6, t2, t6); \
-	BF(a3.re, a1.re, r1, t4); \
-	BF(a2.im, a0.im, i0, t6); \
-}
-
 #define TRANSFORM(a0, a1, a2, a3, wre, wim) { \
 	t1 = a2.re * wre + a2.im * wim; \
 	t2 = a2.im * wre - a2.re * wim; \
@@ -154,32 +142,6 @@ int FFT::splitRadixPermutation(int i, int n, int inverse) {
 	BUTTERFLIES(a0, a1, a2, a3) \
 }
 
-/* z[0...8n-1], w[1...2n-1] */
-#define PASS(name) \
-static void name(Complex *z, const float *wre, unsigned int n) { \
-	float t1, t2, t3, t4, t5, t6; \
-	int o1 = 2 * n; \
-	int o2 = 4 * n; \
-	int o3 = 6 * n; \
-	const float *wim = wre + o1; \
-	n--; \
-	\
-	TRANSFORM_ZERO(z[0], z[o1], z[o2], z[o3]); \
-	TRANSFORM(z[1], z[o1 + 1], z[o2 + 1], z[o3 + 1], wre[1], wim[-1]); \
-	do { \
-		z += 2; \
-		wre += 2; \
-		wim -= 2; \
-		TRANSFORM(z[0], z[o1], z[o2], z[o3], wre[0], wim[0]);\
-		TRANSFORM(z[1], z[o1 + 1], z[o2 + 1], z[o3 + 1], wre[1], wim[-1]);\
-	} while(--n);\
-}
-
-PASS(pass)
-#undef BUTTERFLIES
-#define BUTTERFLIES BUTTERFLIES_BIG
-PASS(pass_big)
-
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -244,10 +206,7 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
-		if (n > 1024)
-			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
-		else
-			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+		getMathKernels().fftPass((float *)z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 	}
 }
 
@@ -24,6 +24,8 @@
 namespace Math {
 
 Frustum::Frustum() {
+	for (int i = 0; i < 24; ++i)
+		_planeData[i] = 0.0f;
 }
 
 void Frustum::setup(const Math::Matrix4 &matrix) {
@@ -63,6 +65,11 @@ void Frustum::setup(const Math::Matrix4 &matrix) {
 
 	for (int i = 0; i < 6; ++i) {
 		_planes[i].normalize();
+
+		_planeData[i] = _planes[i]._normal.x();
+		_planeData[6 + i] = _planes[i]._normal.y();
+		_planeData[12 + i] = _planes[i]._normal.z();
+		_planeData[18 + i] = _planes[i]._d;
 	}
 }
 
@@ -89,6 +96,31 @@ bool Frustum::isInside(const Math::AABB &aabb) const {
 	return true;
 }
 
+void Frustum::isInside(const Math::AABB *aabbs, uint count, bool *inside) const {
+	const MathKernels &kernels = getMathKernels();
+
+	// Gather the bounds in batches for the kernel
+	const uint kBatchSize = 64;
+	float boxes[kBatchSize * 6];
+
+	for (uint first = 0; first < count; first += kBatchSize) {
+		const uint batch = MIN(count - first, kBatchSize);
+
+		for (uint i = 0; i < batch; ++i) {
+			const Math::AABB &aabb = aabbs[first + i];
+			float *box = &boxes[i * 6];
+			box[0] = aabb.getMin().x();
+			box[1] = aabb.getMin().y();
+			box[2] = aabb.getMin().z();
+			box[3] = aabb.getMax().x();
+			box[4] = aabb.getMax().y();
+			box[5] = aabb.getMax().z();
+		}
+
+		kernels.cullBoxes(_planeData, boxes, inside + first, batch);
+	}
+}
+
 bool Frustum::isTriangleInside(const Math::Vector3d &v0, const Math::Vector3d &v1, const Math::Vector3d &v2) const {
 	for (int i = 0; i < 6; ++i) {
 		const Plane &plane = _planes[i];
@@ -35,10 +35,19 @@ public:
 
 	void setup(const Math::Matrix4 &matrix);
 	bool isInside(const Math::AABB &aabb) const;
+
+	/**
+	 * Test @p count boxes at once, setting @p inside for the boxes which are
+	 * at least partially inside the frustum, like isInside() does.
+	 */
+	void isInside(const Math::AABB *aabbs, uint count, bool *inside) const;
 	bool isTriangleInside(const Math::Vector3d &v0, const Math::Vector3d &v1, const Math::Vector3d &v2) const;
 
 private:
 	Math::Plane _planes[6];
+
+	/** The plane normals and distances in the layout of MathKernels::cullBoxes. */
+	float _planeData[24];
 };
 
 } // end of namespace Math
@@ -33,16 +33,25 @@ Matrix<4, 4>::Matrix(const MatrixBase<4, 4> &m) :
 	MatrixType<4, 4>(m), Rotation3D<Matrix4>() {
 }
 
+// The batched transforms treat arrays of vectors as packed floats
+STATIC_ASSERT(sizeof(Vector3d) == 3 * sizeof(float), Vector3d_is_not_packed);
+
 void Matrix<4, 4>::transform(Vector3d *v, bool trans) const {
-	Vector4d m;
-	m(0, 0) = v->x();
-	m(1, 0) = v->y();
-	m(2, 0) = v->z();
-	m(3, 0) = (trans ? 1.f : 0.f);
+	const float *m = getData();
+	const float x = v->x(), y = v->y(), z = v->z();
+	const float w = (trans ? 1.f : 0.f);
+
+	v->set(m[0] * x + m[1] * y + m[2] * z + m[3] * w,
+	       m[4] * x + m[5] * y + m[6] * z + m[7] * w,
+	       m[8] * x + m[9] * y + m[10] * z + m[11] * w);
+}
 
-	m = *this * m;
+void Matrix<4, 4>::transformPoints(const Vector3d *in, Vector3d *out, uint count) const {
+	getMathKernels().transformPoints(getData(), in->getData(), out->getData(), count, 1.f);
+}
 
-	v->set(m(0, 0), m(1, 0), m(2, 0));
+void Matrix<4, 4>::transformVectors(const Vector3d *in, Vector3d *out, uint count) const {
+	getMathKernels().transformPoints(getData(), in->getData(), out->getData(), count, 0.f);
 }
 
 Vector3d Matrix<4, 4>::getPosition() const {
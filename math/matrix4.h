@@ -27,6 +27,7 @@
 #include "math/vector3d.h"
 #include "math/vector4d.h"
 #include "math/matrix3.h"
+#include "math/simd.h"
 
 namespace Math {
 
@@ -40,6 +41,18 @@ public:
 
 	void transform(Vector3d *v, bool translate) const;
 
+	/**
+	 * Transform @p count points like transform() with translation, and store
+	 * them at @p out, which may be the same array as @p in.
+	 */
+	void transformPoints(const Vector3d *in, Vector3d *out, uint count) const;
+
+	/**
+	 * Transform @p count direction vectors like transform() without translation,
+	 * and store them at @p out, which may be the same array as @p in.
+	 */
+	void transformVectors(const Vector3d *in, Vector3d *out, uint count) const;
+
 	Vector3d getPosition() const;
 	void setPosition(const Vector3d &v);
 
@@ -76,19 +89,7 @@ public:
 
 	inline Matrix<4, 4> operator*(const Matrix<4, 4> &m2) const {
 		Matrix<4, 4> result;
-		const float *d1 = getData();
-		const float *d2 = m2.getData();
-		float *r = result.getData();
-
-		for (int i = 0; i < 16; i += 4) {
-			for (int j = 0; j < 4; ++j) {
-				r[i + j] = (d1[i + 0] * d2[j + 0]) +
-				           (d1[i + 1] * d2[j + 4]) +
-				           (d1[i + 2] * d2[j + 8]) +
-				           (d1[i + 3] * d2[j + 12]);
-			}
-		}
-
+		getMathKernels().multiplyMatrix4(result.getData(), getData(), m2.getData());
 		return result;
 	}
 
@@ -29,6 +29,7 @@
 
 #include "math/mdct.h"
 #include "math/fft.h"
+#include "math/simd.h"
 #include "math/utils.h"
 #include "common/util.h"
 
@@ -143,17 +144,7 @@ void MDCT::calcHalfIMDCT(float *output, const float *input) {
 	_fft->calc(z);
 
 	// Post rotation + reordering
-	for (int k = 0; k < size8; k++) {
-		float r0, i0, r1, i1;
-
-		CMUL(r0, i1, z[size8-k-1].im, z[size8-k-1].re, _tSin[size8-k-1], _tCos[size8-k-1]);
-		CMUL(r1, i0, z[size8+k  ].im, z[size8+k  ].re, _tSin[size8+k  ], _tCos[size8+k  ]);
-
-		z[size8 - k - 1].re = r0;
-		z[size8 - k - 1].im = i0;
-		z[size8 + k    ].re = r1;
-		z[size8 + k    ].im = i1;
-	}
+	getMathKernels().imdctPostRotation(output, _tCos, _tSin, size8);
 }
 
 } // End of namespace Math
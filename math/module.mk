@@ -18,11 +18,23 @@ MODULE_OBJS := \
 	ray.o \
 	rdft.o \
 	rect2d.o \
+	simd.o \
 	sinetables.o \
 	sinewindows.o \
 	vector2d.o \
 	vector3d.o \
 	vector4d.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	simd-sse2.o
+$(MODULE)/simd-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	simd-neon.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -25,6 +25,7 @@
 
 #include "math/rdft.h"
 #include "math/fft.h"
+#include "math/simd.h"
 #include "math/utils.h"
 
 namespace Math {
@@ -58,7 +59,7 @@ void RDFT::calc(float *data) {
 		_fft->calc   ((Complex *)data);
 	}
 
-	Complex ev, od;
+	Complex ev;
 
 	/* i=0 is a special case because of packing, the DC term is real, so we
 	   are going to throw the N/2 term (also real) in with it. */
@@ -68,23 +69,8 @@ void RDFT::calc(float *data) {
 	data[0] = ev.re + data[1];
 	data[1] = ev.re - data[1];
 
-	int i;
-	for (i = 1; i < (n >> 2); i++) {
-		int i1 = 2 * i;
-		int i2 = n - i1;
-
-		/* Separate even and odd FFTs */
-		ev.re =  k1 * (data[i1    ] + data[i2   ]);
-		od.im = -k2 * (data[i1    ] - data[i2   ]);
-		ev.im =  k1 * (data[i1 + 1] - data[i2 + 1]);
-		od.re =  k2 * (data[i1 + 1] + data[i2 + 1]);
-
-		/* Apply twiddle factors to the odd FFT and add to the even FFT */
-		data[i1    ] =  ev.re + od.re * _tCos[i] - od.im * _tSin[i];
-		data[i1 + 1] =  ev.im + od.im * _tCos[i] + od.re * _tSin[i];
-		data[i2    ] =  ev.re - od.re * _tCos[i] + od.im * _tSin[i];
-		data[i2 + 1] = -ev.im + od.im * _tCos[i] + od.re * _tSin[i];
-	}
+	const int i = n >> 2;
+	getMathKernels().rdftTwiddle(data, _tCos, _tSin, n, 1, i, k1, k2);
 
 	data[2 * i + 1] = _signConvention * data[2 * i + 1];
 
@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "math/simd.h"
+
+#include <arm_neon.h>
+
+namespace Math {
+
+namespace {
+
+// Multiplications and additions are kept separate, as in the scalar code,
+// so that the results do not depend on fused multiply-adds.
+
+void multiplyMatrix4NEON(float *r, const float *a, const float *b) {
+	const float32x4_t b0 = vld1q_f32(b + 0);
+	const float32x4_t b1 = vld1q_f32(b + 4);
+	const float32x4_t b2 = vld1q_f32(b + 8);
+	const float32x4_t b3 = vld1q_f32(b + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		float32x4_t row = vmulq_n_f32(b0, a[i + 0]);
+		row = vaddq_f32(row, vmulq_n_f32(b1, a[i + 1]));
+		row = vaddq_f32(row, vmulq_n_f32(b2, a[i + 2]));
+		row = vaddq_f32(row, vmulq_n_f32(b3, a[i + 3]));
+		vst1q_f32(r + i, row);
+	}
+}
+
+/** Compute one coordinate of four points, given as separate x, y and z vectors. */
+inline float32x4_t transformRow(const float *row, const float32x4x3_t &p, float w) {
+	float32x4_t r = vmulq_n_f32(p.val[0], row[0]);
+	r = vaddq_f32(r, vmulq_n_f32(p.val[1], row[1]));
+	r = vaddq_f32(r, vmulq_n_f32(p.val[2], row[2]));
+	return vaddq_f32(r, vdupq_n_f32(row[3] * w));
+}
+
+void transformPointsNEON(const float *m, const float *in, float *out, uint count, float w) {
+	uint i = 0;
+
+	for (; i + 4 <= count; i += 4, in += 12, out += 12) {
+		const float32x4x3_t p = vld3q_f32(in);
+
+		float32x4x3_t r;
+		r.val[0] = transformRow(m + 0, p, w);
+		r.val[1] = transformRow(m + 4, p, w);
+		r.val[2] = transformRow(m + 8, p, w);
+		vst3q_f32(out, r);
+	}
+
+	mathKernelsScalar.transformPoints(m, in, out, count - i, w);
+}
+
+/** The signed distances of the box corners furthest along the normals of four planes. */
+inline float32x4_t positiveDistances(const float *planes, int first, const float *box) {
+	const float32x4_t nx = vld1q_f32(planes + first);
+	const float32x4_t ny = vld1q_f32(planes + 8 + first);
+	const float32x4_t nz = vld1q_f32(planes + 16 + first);
+	const float32x4_t d = vld1q_f32(planes + 24 + first);
+
+	float32x4_t dist = vmaxq_f32(vmulq_n_f32(nx, box[0]), vmulq_n_f32(nx, box[3]));
+	dist = vaddq_f32(dist, vmaxq_f32(vmulq_n_f32(ny, box[1]), vmulq_n_f32(ny, box[4])));
+	dist = vaddq_f32(dist, vmaxq_f32(vmulq_n_f32(nz, box[2]), vmulq_n_f32(nz, box[5])));
+	return vaddq_f32(dist, d);
+}
+
+void cullBoxesNEON(const float *planes, const float *boxes, bool *inside, uint count) {
+	// Pad the six planes to eight by repeating the last two
+	float padded[32];
+	for (int c = 0; c < 4; ++c) {
+		for (int p = 0; p < 8; ++p)
+			padded[c * 8 + p] = planes[c * 6 + (p < 6 ? p : p - 2)];
+	}
+
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+
+	for (uint i = 0; i < count; ++i, boxes += 6) {
+		const uint32x4_t outside = vorrq_u32(vcltq_f32(positiveDistances(padded, 0, boxes), zero),
+		                                     vcltq_f32(positiveDistances(padded, 4, boxes), zero));
+		const uint32x2_t any = vorr_u32(vget_low_u32(outside), vget_high_u32(outside));
+		inside[i] = vget_lane_u32(vpmax_u32(any, any), 0) == 0;
+	}
+}
+
+inline float32x4_t reverse(float32x4_t v) {
+	const float32x4_t r = vrev64q_f32(v);
+	return vcombine_f32(vget_high_f32(r), vget_low_f32(r));
+}
+
+void fftPassNEON(float *z, const float *cosTable, uint n) {
+	const uint quarter = 4 * n;
+
+	// The pass always runs on at least 32 values, i.e. 2 * n is a multiple of 4
+	for (uint k = 0; k < 2 * n; k += 4) {
+		float32x4_t wre = vld1q_f32(cosTable + k);
+		float32x4_t wim = reverse(vld1q_f32(cosTable + 2 * n - k - 3));
+		if (k == 0) {
+			wre = vsetq_lane_f32(1.0f, wre, 0);
+			wim = vsetq_lane_f32(0.0f, wim, 0);
+		}
+
+		float *a0 = z + 2 * k;
+		float *a1 = a0 + quarter;
+		float *a2 = a1 + quarter;
+		float *a3 = a2 + quarter;
+
+		// val[0] holds the real parts, val[1] the imaginary ones
+		const float32x4x2_t v0 = vld2q_f32(a0);
+		const float32x4x2_t v1 = vld2q_f32(a1);
+		const float32x4x2_t v2 = vld2q_f32(a2);
+		const float32x4x2_t v3 = vld2q_f32(a3);
+
+		const float32x4_t t1 = vaddq_f32(vmulq_f32(v2.val[0], wre), vmulq_f32(v2.val[1], wim));
+		const float32x4_t t2 = vsubq_f32(vmulq_f32(v2.val[1], wre), vmulq_f32(v2.val[0], wim));
+		const float32x4_t t5 = vsubq_f32(vmulq_f32(v3.val[0], wre), vmulq_f32(v3.val[1], wim));
+		const float32x4_t t6 = vaddq_f32(vmulq_f32(v3.val[1], wre), vmulq_f32(v3.val[0], wim));
+
+		const float32x4_t d51 = vsubq_f32(t5, t1), s51 = vaddq_f32(t5, t1);
+		const float32x4_t d26 = vsubq_f32(t2, t6), s26 = vaddq_f32(t2, t6);
+
+		float32x4x2_t r;
+		r.val[0] = vaddq_f32(v0.val[0], s51);
+		r.val[1] = vaddq_f32(v0.val[1], s26);
+		vst2q_f32(a0, r);
+		r.val[0] = vaddq_f32(v1.val[0], d26);
+		r.val[1] = vaddq_f32(v1.val[1], d51);
+		vst2q_f32(a1, r);
+		r.val[0] = vsubq_f32(v0.val[0], s51);
+		r.val[1] = vsubq_f32(v0.val[1], s26);
+		vst2q_f32(a2, r);
+		r.val[0] = vsubq_f32(v1.val[0], d26);
+		r.val[1] = vsubq_f32(v1.val[1], d51);
+		vst2q_f32(a3, r);
+	}
+}
+
+void imdctPostRotationNEON(float *z, const float *tCos, const float *tSin, uint size8) {
+	if (size8 % 4) {
+		mathKernelsScalar.imdctPostRotation(z, tCos, tSin, size8);
+		return;
+	}
+
+	for (uint k = 0; k < size8; k += 4) {
+		// The values below the middle are walked backwards, those above forwards
+		float *a = z + 2 * (size8 - k - 4);
+		float *b = z + 2 * (size8 + k);
+
+		const float32x4x2_t va = vld2q_f32(a);
+		const float32x4x2_t vb = vld2q_f32(b);
+		const float32x4_t aRe = reverse(va.val[0]);
+		const float32x4_t aIm = reverse(va.val[1]);
+
+		const float32x4_t sa = reverse(vld1q_f32(tSin + size8 - k - 4));
+		const float32x4_t ca = reverse(vld1q_f32(tCos + size8 - k - 4));
+		const float32x4_t sb = vld1q_f32(tSin + size8 + k);
+		const float32x4_t cb = vld1q_f32(tCos + size8 + k);
+
+		const float32x4_t r0 = vsubq_f32(vmulq_f32(aIm, sa), vmulq_f32(aRe, ca));
+		const float32x4_t i1 = vaddq_f32(vmulq_f32(aIm, ca), vmulq_f32(aRe, sa));
+		const float32x4_t r1 = vsubq_f32(vmulq_f32(vb.val[1], sb), vmulq_f32(vb.val[0], cb));
+		const float32x4_t i0 = vaddq_f32(vmulq_f32(vb.val[1], cb), vmulq_f32(vb.val[0], sb));
+
+		float32x4x2_t r;
+		r.val[0] = reverse(r0);
+		r.val[1] = reverse(i0);
+		vst2q_f32(a, r);
+		r.val[0] = r1;
+		r.val[1] = i1;
+		vst2q_f32(b, r);
+	}
+}
+
+void rdftTwiddleNEON(float *data, const float *tCos, const float *tSin, uint n, uint first, uint last, float k1, float k2) {
+	uint i = first;
+	for (; i + 4 <= last; i += 4) {
+		// The values from the end are walked backwards
+		float *x1 = data + 2 * i;
+		float *x2 = data + n - 2 * (i + 3);
+
+		const float32x4x2_t v1 = vld2q_f32(x1);
+		const float32x4x2_t v2 = vld2q_f32(x2);
+		const float32x4_t re2 = reverse(v2.val[0]);
+		const float32x4_t im2 = reverse(v2.val[1]);
+
+		const float32x4_t c = vld1q_f32(tCos + i);
+		const float32x4_t s = vld1q_f32(tSin + i);
+
+		const float32x4_t evRe = vmulq_n_f32(vaddq_f32(v1.val[0], re2), k1);
+		const float32x4_t odIm = vmulq_n_f32(vsubq_f32(v1.val[0], re2), -k2);
+		const float32x4_t evIm = vmulq_n_f32(vsubq_f32(v1.val[1], im2), k1);
+		const float32x4_t odRe = vmulq_n_f32(vaddq_f32(v1.val[1], im2), k2);
+
+		const float32x4_t odReC = vmulq_f32(odRe, c), odReS = vmulq_f32(odRe, s);
+		const float32x4_t odImC = vmulq_f32(odIm, c), odImS = vmulq_f32(odIm, s);
+
+		float32x4x2_t r;
+		r.val[0] = vsubq_f32(vaddq_f32(evRe, odReC), odImS);
+		r.val[1] = vaddq_f32(vaddq_f32(evIm, odImC), odReS);
+		vst2q_f32(x1, r);
+		r.val[0] = reverse(vaddq_f32(vsubq_f32(evRe, odReC), odImS));
+		r.val[1] = reverse(vaddq_f32(vaddq_f32(vnegq_f32(evIm), odImC), odReS));
+		vst2q_f32(x2, r);
+	}
+
+	mathKernelsScalar.rdftTwiddle(data, tCos, tSin, n, i, last, k1, k2);
+}
+
+} // End of anonymous namespace
+
+const MathKernels mathKernelsNEON = {
+	multiplyMatrix4NEON,
+	transformPointsNEON,
+	cullBoxesNEON,
+	fftPassNEON,
+	imdctPostRotationNEON,
+	rdftTwiddleNEON
+};
+
+} // End of namespace Math
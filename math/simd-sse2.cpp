@@ -0,0 +1,250 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "math/simd.h"
+
+#include <emmintrin.h>
+
+namespace Math {
+
+namespace {
+
+void multiplyMatrix4SSE2(float *r, const float *a, const float *b) {
+	const __m128 b0 = _mm_loadu_ps(b + 0);
+	const __m128 b1 = _mm_loadu_ps(b + 4);
+	const __m128 b2 = _mm_loadu_ps(b + 8);
+	const __m128 b3 = _mm_loadu_ps(b + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		__m128 row = _mm_mul_ps(_mm_set1_ps(a[i + 0]), b0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+		_mm_storeu_ps(r + i, row);
+	}
+}
+
+/** Compute one coordinate of four points, given as separate x, y and z vectors. */
+inline __m128 transformRow(const float *row, __m128 x, __m128 y, __m128 z, float w) {
+	__m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), x);
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[1]), y));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), z));
+	return _mm_add_ps(r, _mm_set1_ps(row[3] * w));
+}
+
+void transformPointsSSE2(const float *m, const float *in, float *out, uint count, float w) {
+	uint i = 0;
+
+	for (; i + 4 <= count; i += 4, in += 12, out += 12) {
+		// Four packed points: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+		const __m128 a = _mm_loadu_ps(in + 0);
+		const __m128 b = _mm_loadu_ps(in + 4);
+		const __m128 c = _mm_loadu_ps(in + 8);
+
+		const __m128 x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 3, 0)),
+		                                _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+		const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+		                                _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+		                                _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 3, 0)), _MM_SHUFFLE(1, 0, 2, 0));
+
+		const __m128 rx = transformRow(m + 0, x, y, z, w);
+		const __m128 ry = transformRow(m + 4, x, y, z, w);
+		const __m128 rz = transformRow(m + 8, x, y, z, w);
+
+		_mm_storeu_ps(out + 0, _mm_shuffle_ps(_mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0)),
+		                                      _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(out + 4, _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)),
+		                                      _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(out + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)),
+		                                      _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	mathKernelsScalar.transformPoints(m, in, out, count - i, w);
+}
+
+/** The signed distances of the box corners furthest along the normals of four planes. */
+inline __m128 positiveDistances(const float *planes, int first, const float *box) {
+	const __m128 nx = _mm_loadu_ps(planes + first);
+	const __m128 ny = _mm_loadu_ps(planes + 8 + first);
+	const __m128 nz = _mm_loadu_ps(planes + 16 + first);
+	const __m128 d = _mm_loadu_ps(planes + 24 + first);
+
+	__m128 dist = _mm_max_ps(_mm_mul_ps(nx, _mm_set1_ps(box[0])), _mm_mul_ps(nx, _mm_set1_ps(box[3])));
+	dist = _mm_add_ps(dist, _mm_max_ps(_mm_mul_ps(ny, _mm_set1_ps(box[1])), _mm_mul_ps(ny, _mm_set1_ps(box[4]))));
+	dist = _mm_add_ps(dist, _mm_max_ps(_mm_mul_ps(nz, _mm_set1_ps(box[2])), _mm_mul_ps(nz, _mm_set1_ps(box[5]))));
+	return _mm_add_ps(dist, d);
+}
+
+void cullBoxesSSE2(const float *planes, const float *boxes, bool *inside, uint count) {
+	// Pad the six planes to eight by repeating the last two
+	float padded[32];
+	for (int c = 0; c < 4; ++c) {
+		for (int p = 0; p < 8; ++p)
+			padded[c * 8 + p] = planes[c * 6 + (p < 6 ? p : p - 2)];
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+
+	for (uint i = 0; i < count; ++i, boxes += 6) {
+		const __m128 outside = _mm_or_ps(_mm_cmplt_ps(positiveDistances(padded, 0, boxes), zero),
+		                                 _mm_cmplt_ps(positiveDistances(padded, 4, boxes), zero));
+		inside[i] = _mm_movemask_ps(outside) == 0;
+	}
+}
+
+/** Load four complex values, split into their real and imaginary parts. */
+inline void loadComplex(const float *p, __m128 &re, __m128 &im) {
+	const __m128 lo = _mm_loadu_ps(p);
+	const __m128 hi = _mm_loadu_ps(p + 4);
+	re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+	im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline void storeComplex(float *p, __m128 re, __m128 im) {
+	_mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+	_mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+}
+
+inline __m128 reverse(__m128 v) {
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+void fftPassSSE2(float *z, const float *cosTable, uint n) {
+	const uint quarter = 4 * n;
+
+	// The pass always runs on at least 32 values, i.e. 2 * n is a multiple of 4
+	for (uint k = 0; k < 2 * n; k += 4) {
+		__m128 wre = _mm_loadu_ps(cosTable + k);
+		__m128 wim = reverse(_mm_loadu_ps(cosTable + 2 * n - k - 3));
+		if (k == 0) {
+			wre = _mm_move_ss(wre, _mm_set_ss(1.0f));
+			wim = _mm_move_ss(wim, _mm_setzero_ps());
+		}
+
+		float *a0 = z + 2 * k;
+		float *a1 = a0 + quarter;
+		float *a2 = a1 + quarter;
+		float *a3 = a2 + quarter;
+
+		__m128 r0, i0, r1, i1, r2, i2, r3, i3;
+		loadComplex(a0, r0, i0);
+		loadComplex(a1, r1, i1);
+		loadComplex(a2, r2, i2);
+		loadComplex(a3, r3, i3);
+
+		const __m128 t1 = _mm_add_ps(_mm_mul_ps(r2, wre), _mm_mul_ps(i2, wim));
+		const __m128 t2 = _mm_sub_ps(_mm_mul_ps(i2, wre), _mm_mul_ps(r2, wim));
+		const __m128 t5 = _mm_sub_ps(_mm_mul_ps(r3, wre), _mm_mul_ps(i3, wim));
+		const __m128 t6 = _mm_add_ps(_mm_mul_ps(i3, wre), _mm_mul_ps(r3, wim));
+
+		const __m128 d51 = _mm_sub_ps(t5, t1), s51 = _mm_add_ps(t5, t1);
+		const __m128 d26 = _mm_sub_ps(t2, t6), s26 = _mm_add_ps(t2, t6);
+
+		storeComplex(a0, _mm_add_ps(r0, s51), _mm_add_ps(i0, s26));
+		storeComplex(a1, _mm_add_ps(r1, d26), _mm_add_ps(i1, d51));
+		storeComplex(a2, _mm_sub_ps(r0, s51), _mm_sub_ps(i0, s26));
+		storeComplex(a3, _mm_sub_ps(r1, d26), _mm_sub_ps(i1, d51));
+	}
+}
+
+void imdctPostRotationSSE2(float *z, const float *tCos, const float *tSin, uint size8) {
+	if (size8 % 4) {
+		mathKernelsScalar.imdctPostRotation(z, tCos, tSin, size8);
+		return;
+	}
+
+	for (uint k = 0; k < size8; k += 4) {
+		// The values below the middle are walked backwards, those above forwards
+		float *a = z + 2 * (size8 - k - 4);
+		float *b = z + 2 * (size8 + k);
+
+		__m128 aRe, aIm, bRe, bIm;
+		loadComplex(a, aRe, aIm);
+		loadComplex(b, bRe, bIm);
+		aRe = reverse(aRe);
+		aIm = reverse(aIm);
+
+		const __m128 sa = reverse(_mm_loadu_ps(tSin + size8 - k - 4));
+		const __m128 ca = reverse(_mm_loadu_ps(tCos + size8 - k - 4));
+		const __m128 sb = _mm_loadu_ps(tSin + size8 + k);
+		const __m128 cb = _mm_loadu_ps(tCos + size8 + k);
+
+		const __m128 r0 = _mm_sub_ps(_mm_mul_ps(aIm, sa), _mm_mul_ps(aRe, ca));
+		const __m128 i1 = _mm_add_ps(_mm_mul_ps(aIm, ca), _mm_mul_ps(aRe, sa));
+		const __m128 r1 = _mm_sub_ps(_mm_mul_ps(bIm, sb), _mm_mul_ps(bRe, cb));
+		const __m128 i0 = _mm_add_ps(_mm_mul_ps(bIm, cb), _mm_mul_ps(bRe, sb));
+
+		storeComplex(a, reverse(r0), reverse(i0));
+		storeComplex(b, r1, i1);
+	}
+}
+
+void rdftTwiddleSSE2(float *data, const float *tCos, const float *tSin, uint n, uint first, uint last, float k1, float k2) {
+	const __m128 vk1 = _mm_set1_ps(k1);
+	const __m128 vk2 = _mm_set1_ps(k2);
+	const __m128 vnk2 = _mm_set1_ps(-k2);
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	uint i = first;
+	for (; i + 4 <= last; i += 4) {
+		// The values from the end are walked backwards
+		float *x1 = data + 2 * i;
+		float *x2 = data + n - 2 * (i + 3);
+
+		__m128 re1, im1, re2, im2;
+		loadComplex(x1, re1, im1);
+		loadComplex(x2, re2, im2);
+		re2 = reverse(re2);
+		im2 = reverse(im2);
+
+		const __m128 c = _mm_loadu_ps(tCos + i);
+		const __m128 s = _mm_loadu_ps(tSin + i);
+
+		const __m128 evRe = _mm_mul_ps(vk1, _mm_add_ps(re1, re2));
+		const __m128 odIm = _mm_mul_ps(vnk2, _mm_sub_ps(re1, re2));
+		const __m128 evIm = _mm_mul_ps(vk1, _mm_sub_ps(im1, im2));
+		const __m128 odRe = _mm_mul_ps(vk2, _mm_add_ps(im1, im2));
+
+		const __m128 odReC = _mm_mul_ps(odRe, c), odReS = _mm_mul_ps(odRe, s);
+		const __m128 odImC = _mm_mul_ps(odIm, c), odImS = _mm_mul_ps(odIm, s);
+
+		storeComplex(x1, _mm_sub_ps(_mm_add_ps(evRe, odReC), odImS),
+		                 _mm_add_ps(_mm_add_ps(evIm, odImC), odReS));
+		storeComplex(x2, reverse(_mm_add_ps(_mm_sub_ps(evRe, odReC), odImS)),
+		                 reverse(_mm_add_ps(_mm_add_ps(_mm_xor_ps(evIm, signBit), odImC), odReS)));
+	}
+
+	mathKernelsScalar.rdftTwiddle(data, tCos, tSin, n, i, last, k1, k2);
+}
+
+} // End of anonymous namespace
+
+const MathKernels mathKernelsSSE2 = {
+	multiplyMatrix4SSE2,
+	transformPointsSSE2,
+	cullBoxesSSE2,
+	fftPassSSE2,
+	imdctPostRotationSSE2,
+	rdftTwiddleSSE2
+};
+
+} // End of namespace Math
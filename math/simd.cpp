@@ -0,0 +1,197 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "math/simd.h"
+
+#include "common/system.h"
+
+namespace Math {
+
+namespace {
+
+void multiplyMatrix4(float *r, const float *a, const float *b) {
+	for (int i = 0; i < 16; i += 4) {
+		for (int j = 0; j < 4; ++j) {
+			r[i + j] = (a[i + 0] * b[j + 0]) +
+			           (a[i + 1] * b[j + 4]) +
+			           (a[i + 2] * b[j + 8]) +
+			           (a[i + 3] * b[j + 12]);
+		}
+	}
+}
+
+void transformPoints(const float *m, const float *in, float *out, uint count, float w) {
+	for (uint i = 0; i < count; ++i, in += 3, out += 3) {
+		const float x = in[0], y = in[1], z = in[2];
+		out[0] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+		out[1] = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+		out[2] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+	}
+}
+
+inline float positiveProduct(float n, float min, float max) {
+	// The product with the box corner furthest along the normal
+	const float a = n * min;
+	const float b = n * max;
+	return a > b ? a : b;
+}
+
+void cullBoxes(const float *planes, const float *boxes, bool *inside, uint count) {
+	const float *nx = planes, *ny = planes + 6, *nz = planes + 12, *d = planes + 18;
+
+	for (uint i = 0; i < count; ++i, boxes += 6) {
+		inside[i] = true;
+		for (int p = 0; p < 6; ++p) {
+			const float dist = positiveProduct(nx[p], boxes[0], boxes[3]) +
+			                   positiveProduct(ny[p], boxes[1], boxes[4]) +
+			                   positiveProduct(nz[p], boxes[2], boxes[5]) + d[p];
+			if (dist < 0.0f) {
+				inside[i] = false;
+				break;
+			}
+		}
+	}
+}
+
+void fftPass(float *z, const float *cosTable, uint n) {
+	// The four quarters of the values are combined with the butterflies
+	// of the split-radix FFT.
+	const uint quarter = 4 * n;
+
+	for (uint k = 0; k < 2 * n; ++k) {
+		const float wre = k ? cosTable[k] : 1.0f;
+		const float wim = k ? cosTable[2 * n - k] : 0.0f;
+
+		float *a0 = z + 2 * k;
+		float *a1 = a0 + quarter;
+		float *a2 = a1 + quarter;
+		float *a3 = a2 + quarter;
+
+		const float r0 = a0[0], i0 = a0[1], r1 = a1[0], i1 = a1[1];
+
+		const float t1 = a2[0] * wre + a2[1] * wim;
+		const float t2 = a2[1] * wre - a2[0] * wim;
+		const float t5 = a3[0] * wre - a3[1] * wim;
+		const float t6 = a3[1] * wre + a3[0] * wim;
+
+		const float d51 = t5 - t1, s51 = t5 + t1;
+		const float d26 = t2 - t6, s26 = t2 + t6;
+
+		a0[0] = r0 + s51;
+		a0[1] = i0 + s26;
+		a1[0] = r1 + d26;
+		a1[1] = i1 + d51;
+		a2[0] = r0 - s51;
+		a2[1] = i0 - s26;
+		a3[0] = r1 - d26;
+		a3[1] = i1 - d51;
+	}
+}
+
+void imdctPostRotation(float *z, const float *tCos, const float *tSin, uint size8) {
+	for (uint k = 0; k < size8; ++k) {
+		float *a = z + 2 * (size8 - k - 1);
+		float *b = z + 2 * (size8 + k);
+		const float sa = tSin[size8 - k - 1], ca = tCos[size8 - k - 1];
+		const float sb = tSin[size8 + k], cb = tCos[size8 + k];
+
+		const float r0 = a[1] * sa - a[0] * ca;
+		const float i1 = a[1] * ca + a[0] * sa;
+		const float r1 = b[1] * sb - b[0] * cb;
+		const float i0 = b[1] * cb + b[0] * sb;
+
+		a[0] = r0;
+		a[1] = i0;
+		b[0] = r1;
+		b[1] = i1;
+	}
+}
+
+void rdftTwiddle(float *data, const float *tCos, const float *tSin, uint n, uint first, uint last, float k1, float k2) {
+	for (uint i = first; i < last; ++i) {
+		float *x1 = data + 2 * i;
+		float *x2 = data + n - 2 * i;
+
+		// Separate even and odd FFTs
+		const float evRe = k1 * (x1[0] + x2[0]);
+		const float odIm = -k2 * (x1[0] - x2[0]);
+		const float evIm = k1 * (x1[1] - x2[1]);
+		const float odRe = k2 * (x1[1] + x2[1]);
+
+		// Apply twiddle factors to the odd FFT and add to the even FFT
+		x1[0] = evRe + odRe * tCos[i] - odIm * tSin[i];
+		x1[1] = evIm + odIm * tCos[i] + odRe * tSin[i];
+		x2[0] = evRe - odRe * tCos[i] + odIm * tSin[i];
+		x2[1] = -evIm + odIm * tCos[i] + odRe * tSin[i];
+	}
+}
+
+} // End of anonymous namespace
+
+const MathKernels mathKernelsScalar = {
+	multiplyMatrix4,
+	transformPoints,
+	cullBoxes,
+	fftPass,
+	imdctPostRotation,
+	rdftTwiddle
+};
+
+namespace {
+
+const MathKernels *detectMathKernels() {
+#ifdef SCUMMVM_SSE2
+#if defined(__x86_64__) || defined(_M_X64)
+	// SSE2 is part of the x86-64 baseline
+	return &mathKernelsSSE2;
+#else
+	if (g_system->hasFeature(OSystem::kCpuFeatureSSE2))
+		return &mathKernelsSSE2;
+#endif
+#endif
+#ifdef SCUMMVM_NEON
+#if defined(__aarch64__)
+	// NEON is part of the AArch64 baseline
+	return &mathKernelsNEON;
+#else
+	if (g_system->hasFeature(OSystem::kCpuFeatureNEON))
+		return &mathKernelsNEON;
+#endif
+#endif
+	return &mathKernelsScalar;
+}
+
+} // End of anonymous namespace
+
+const MathKernels &getMathKernels() {
+	static const MathKernels *kernels = nullptr;
+
+	if (!kernels) {
+		// Matrices may already be used before the backend is set up
+		if (!g_system)
+			return mathKernelsScalar;
+		kernels = detectMathKernels();
+	}
+
+	return *kernels;
+}
+
+} // End of namespace Math
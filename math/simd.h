@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_SIMD_H
+#define MATH_SIMD_H
+
+#include "common/scummsys.h"
+
+namespace Math {
+
+/**
+ * Kernels of the matrix, transform, culling and Fourier transform code,
+ * in a scalar and in vectorized versions. All of them compute the same
+ * results, with the operations in the same order.
+ *
+ * Matrices are 4x4 row-major float arrays, as returned by
+ * Matrix4::getData(), points are packed x, y, z triplets and complex
+ * values packed re, im pairs.
+ */
+struct MathKernels {
+	/** Store the product of @p a and @p b at @p r, which must not overlap them. */
+	void (*multiplyMatrix4)(float *r, const float *a, const float *b);
+
+	/**
+	 * Transform @p count points at @p in by @p m and store them at @p out,
+	 * which may be the same as @p in. The points get @p w as their fourth
+	 * coordinate, 1 to apply the translation and 0 to ignore it.
+	 */
+	void (*transformPoints)(const float *m, const float *in, float *out, uint count, float w);
+
+	/**
+	 * Test @p count boxes against six planes. @p planes holds the x, y
+	 * and z components of the normals and the distances, each for all six
+	 * planes in turn, and @p boxes the minimum and maximum x, y and z of
+	 * each box. @p inside is set for the boxes which are on the positive
+	 * side of all the planes, at least partially.
+	 */
+	void (*cullBoxes)(const float *planes, const float *boxes, bool *inside, uint count);
+
+	/**
+	 * Run one combining pass of the split-radix FFT on the 8 * @p n complex
+	 * values at @p z, with the twiddle factors taken from @p cosTable, the
+	 * table of CosineTable::getTable() for 8 * @p n points.
+	 */
+	void (*fftPass)(float *z, const float *cosTable, uint n);
+
+	/**
+	 * Run the post-rotation of MDCT::calcHalfIMDCT() on the 2 * @p size8
+	 * complex values at @p z.
+	 */
+	void (*imdctPostRotation)(float *z, const float *tCos, const float *tSin, uint size8);
+
+	/**
+	 * Separate the even and odd FFTs of the @p n real values at @p data and
+	 * recombine them with the twiddle factors, as RDFT::calc() does, for the
+	 * complex values in [@p first, @p last).
+	 */
+	void (*rdftTwiddle)(float *data, const float *tCos, const float *tSin, uint n, uint first, uint last, float k1, float k2);
+};
+
+extern const MathKernels mathKernelsScalar;
+
+#ifdef SCUMMVM_SSE2
+extern const MathKernels mathKernelsSSE2;
+#endif
+
+#ifdef SCUMMVM_NEON
+extern const MathKernels mathKernelsNEON;
+#endif
+
+/** Return the fastest kernels available on this CPU. */
+const MathKernels &getMathKernels();
+
+} // End of namespace Math
+
+#endif // MATH_SIMD_H
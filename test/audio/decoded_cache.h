@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoded_cache.h"
+#include "audio/audiostream.h"
+
+#include "helper.h"
+
+class DecodedCacheTestSuite : public CxxTest::TestSuite {
+	static bool playsSine(Audio::SeekableAudioStream *stream, const int16 *sine, int numSamples) {
+		int16 *buffer = new int16[numSamples];
+		const bool result = stream->readBuffer(buffer, numSamples) == numSamples &&
+		                    memcmp(sine, buffer, sizeof(int16) * numSamples) == 0 && stream->endOfData();
+		delete[] buffer;
+		return result;
+	}
+
+public:
+	void test_cached_sound() {
+		Audio::DecodedCache cache(1024 * 1024, 256 * 1024);
+		TS_ASSERT(!cache.get("click.ogg"));
+
+		int16 *sine;
+		Audio::SeekableAudioStream *stream = cache.add("click.ogg", 0, createSineStream<int16>(11025, 1, &sine, false, true));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(cache.getSize(), 11025u * 2 * sizeof(int16));
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), 11025);
+		TS_ASSERT(playsSine(stream, sine, 11025 * 2));
+		delete stream;
+
+		// Names are compared ignoring case, offsets are not
+		TS_ASSERT(!cache.get("click.ogg", 4));
+		stream = cache.get("CLICK.OGG");
+		TS_ASSERT(stream);
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		// The stream still plays after the sound was removed
+		TS_ASSERT(playsSine(stream, sine, 11025 * 2));
+		delete stream;
+		delete[] sine;
+	}
+
+	void test_long_sound() {
+		Audio::DecodedCache cache(1024 * 1024, 16 * 1024);
+		int16 *sine;
+		Audio::SeekableAudioStream *original = createSineStream<int16>(11025, 1, &sine, false, false);
+		Audio::SeekableAudioStream *stream = cache.add("music.ogg", 0, original);
+		TS_ASSERT_EQUALS(stream, original);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(playsSine(stream, sine, 11025));
+		delete stream;
+		delete[] sine;
+	}
+
+	void test_eviction() {
+		const uint32 soundSize = 11025 * sizeof(int16);
+		Audio::DecodedCache cache(soundSize * 2, soundSize);
+		int16 *sine;
+
+		delete cache.add("a.ogg", 0, createSineStream<int16>(11025, 1, &sine, false, false));
+		delete[] sine;
+		delete cache.add("b.ogg", 0, createSineStream<int16>(11025, 1, &sine, false, false));
+		delete[] sine;
+		// Using a makes b the least recently used sound
+		delete cache.get("a.ogg");
+		delete cache.add("c.ogg", 0, createSineStream<int16>(11025, 1, &sine, false, false));
+		delete[] sine;
+
+		TS_ASSERT_EQUALS(cache.getSize(), soundSize * 2);
+		Audio::SeekableAudioStream *stream = cache.get("b.ogg");
+		TS_ASSERT(!stream);
+		delete stream;
+		stream = cache.get("a.ogg");
+		TS_ASSERT(stream);
+		delete stream;
+		stream = cache.get("c.ogg");
+		TS_ASSERT(stream);
+		delete stream;
+	}
+};
@@ -0,0 +1,69 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mods/paula-simd.h"
+
+class PaulaTestSuite : public CxxTest::TestSuite {
+	static const uint kCount = 300;
+
+	static void initState(Audio::Paula::FilterState &state, Audio::Paula::FilterMode mode, bool ledFilter) {
+		state.mode = mode;
+		state.ledFilter = ledFilter;
+		state.a0[0] = 0.5f;
+		state.a0[1] = 0.95f;
+		state.a0[2] = 0.55f;
+		for (int voice = 0; voice < Audio::Paula::NUM_VOICES; ++voice) {
+			for (int i = 0; i < 5; ++i)
+				state.rc[voice][i] = (float)(voice * 100 - i * 37);
+		}
+	}
+
+	/**
+	 * Filter random samples with @p proc and with the scalar filter and
+	 * check that both agree within one bit.
+	 */
+	static bool filterMatches(Audio::FilterVoicesProc proc) {
+		static const uint counts[Audio::Paula::NUM_VOICES] = { kCount, 0, kCount - 17, 5 };
+		int32 expected[Audio::Paula::NUM_VOICES][kCount], actual[Audio::Paula::NUM_VOICES][kCount];
+		uint32 seed = 0x7f4a7c15;
+		bool result = true;
+
+		for (int run = 0; run < 4; ++run) {
+			const Audio::Paula::FilterMode mode = run & 1 ? Audio::Paula::kFilterModeA1200 : Audio::Paula::kFilterModeA500;
+			Audio::Paula::FilterState expectedState, actualState;
+			initState(expectedState, mode, (run & 2) != 0);
+			initState(actualState, mode, (run & 2) != 0);
+
+			int32 *expectedPtrs[Audio::Paula::NUM_VOICES], *actualPtrs[Audio::Paula::NUM_VOICES];
+			for (int voice = 0; voice < Audio::Paula::NUM_VOICES; ++voice) {
+				for (uint i = 0; i < kCount; ++i) {
+					seed = seed * 1103515245 + 12345;
+					// Full scale square waves make the filters overshoot
+					expected[voice][i] = actual[voice][i] = (seed >> 16) & 0x100 ? 127 * 64 : -128 * 64;
+				}
+				expectedPtrs[voice] = expected[voice];
+				actualPtrs[voice] = actual[voice];
+			}
+
+			Audio::filterVoices(expectedState, expectedPtrs, counts);
+			proc(actualState, actualPtrs, counts);
+
+			for (int voice = 0; voice < Audio::Paula::NUM_VOICES; ++voice) {
+				for (uint i = 0; i < kCount; ++i)
+					result &= ABS(expected[voice][i] - actual[voice][i]) <= 1;
+				for (int i = 0; i < 5; ++i)
+					result &= ABS(expectedState.rc[voice][i] - actualState.rc[voice][i]) <= 1.0f;
+			}
+		}
+		return result;
+	}
+
+public:
+	void test_filter_kernels() {
+		Audio::FilterVoicesProc proc = Audio::getFilterVoicesProc();
+		if (proc)
+			TS_ASSERT(filterMatches(proc));
+#ifdef SCUMMVM_SSE2
+		TS_ASSERT(filterMatches(Audio::filterVoicesSSE2));
+#endif
+	}
+};
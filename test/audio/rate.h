@@ -0,0 +1,156 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/rate.h"
+#include "audio/rate-simd.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Convert a sine with convert() and with mix() followed by
+	 * clampSamples() and check that both produce the same samples.
+	 */
+	void checkMix(int inRate, int outRate, bool inStereo, bool outStereo, bool reverseStereo,
+	              Audio::RateConverterQuality quality = Audio::kRateConverterLinear) {
+		const int numSamples = 3000;
+		const int outChannels = outStereo ? 2 : 1;
+		int16 *expected = new int16[numSamples * outChannels];
+		int16 *actual = new int16[numSamples * outChannels];
+		int32 *mixed = new int32[numSamples * outChannels];
+		memset(expected, 0, numSamples * outChannels * sizeof(int16));
+		memset(actual, 0, numSamples * outChannels * sizeof(int16));
+		memset(mixed, 0, numSamples * outChannels * sizeof(int32));
+
+		Audio::SeekableAudioStream *s1 = createSineStream<int16>(inRate, 1, nullptr, false, inStereo);
+		Audio::SeekableAudioStream *s2 = createSineStream<int16>(inRate, 1, nullptr, false, inStereo);
+		Audio::RateConverter *c1 = Audio::makeRateConverter(inRate, outRate, inStereo, outStereo, reverseStereo, quality);
+		Audio::RateConverter *c2 = Audio::makeRateConverter(inRate, outRate, inStereo, outStereo, reverseStereo, quality);
+
+		// Convert in uneven pieces, so the kernels also handle partial buffers
+		int done1 = 0, done2 = 0;
+		for (int pos = 0; pos < numSamples; pos += 700) {
+			const int count = MIN(700, numSamples - pos);
+			done1 += c1->convert(*s1, expected + pos * outChannels, count, 200, 97);
+			done2 += c2->mix(*s2, mixed + pos * outChannels, count, 200, 97);
+		}
+		Audio::clampSamples(actual, mixed, numSamples * outChannels);
+
+		TS_ASSERT_EQUALS(done1, done2);
+		TS_ASSERT_EQUALS(memcmp(expected, actual, numSamples * outChannels * sizeof(int16)), 0);
+
+		delete c1;
+		delete c2;
+		delete s1;
+		delete s2;
+		delete[] expected;
+		delete[] actual;
+		delete[] mixed;
+	}
+
+	/**
+	 * Check the vectorized kernels against the scalar computation, with
+	 * samples and sums at the limits.
+	 */
+	static bool kernelsMatch(const Audio::MixProcs &procs) {
+		const int kFrames = 45;
+		int16 in[kFrames * 2];
+		int32 expected[kFrames * 2], actual[kFrames * 2];
+		int16 expectedOut[kFrames * 2], actualOut[kFrames * 2];
+		uint32 seed = 0x6a09e667;
+		bool result = true;
+
+		for (int i = 0; i < kFrames * 2; ++i) {
+			seed = seed * 1103515245 + 12345;
+			in[i] = (int16)(seed >> 16);
+		}
+		in[0] = -32768;
+		in[1] = 32767;
+
+		for (int stereo = 0; stereo < 2; ++stereo) {
+			for (int i = 0; i < kFrames * 2; ++i) {
+				seed = seed * 1103515245 + 12345;
+				expected[i] = actual[i] = (int32)(seed % 80000) - 40000;
+			}
+
+			const Audio::st_volume_t volL = 256, volR = 131;
+			for (int i = 0; i < kFrames; ++i) {
+				const int16 inL = stereo ? in[i * 2] : in[i];
+				const int16 inR = stereo ? in[i * 2 + 1] : in[i];
+				expected[i * 2] += (inL * volL) / 256;
+				expected[i * 2 + 1] += (inR * volR) / 256;
+			}
+			(stereo ? procs.mixStereo : procs.mixMono)(actual, in, kFrames, volL, volR);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+
+			for (int i = 0; i < kFrames * 2; ++i)
+				expectedOut[i] = (int16)CLIP<int32>(expected[i], -32768, 32767);
+			procs.clamp(actualOut, expected, kFrames * 2);
+			result &= memcmp(expectedOut, actualOut, sizeof(actualOut)) == 0;
+		}
+
+		int16 coefs[32];
+		for (int i = 0; i < 32; ++i) {
+			seed = seed * 1103515245 + 12345;
+			coefs[i] = (int16)((seed >> 16) % 32768) - 16384;
+		}
+		for (uint count = 16; count <= 32; count += 16) {
+			int32 sum = 0;
+			for (uint i = 0; i < count; ++i)
+				sum += in[i] * coefs[i];
+			result &= procs.dotProduct(in, coefs, count) == sum;
+		}
+		return result;
+	}
+
+public:
+	void test_mix_copy() {
+		checkMix(22050, 22050, false, false, false);
+		checkMix(22050, 22050, false, true, false);
+		checkMix(22050, 22050, true, false, false);
+		checkMix(22050, 22050, true, true, false);
+		checkMix(22050, 22050, true, true, true);
+	}
+
+	void test_mix_resample() {
+		checkMix(44100, 22050, false, true, false);
+		checkMix(44100, 22050, true, true, true);
+		checkMix(11025, 44100, false, true, false);
+		checkMix(11025, 44100, true, false, false);
+		checkMix(11025, 44100, true, true, false);
+	}
+
+	void test_sinc_level() {
+		// A constant signal keeps its level once the filter is filled
+		const int kSamples = 2000;
+		byte *data = (byte *)malloc(kSamples * 2);
+		for (int i = 0; i < kSamples; ++i)
+			WRITE_LE_UINT16(data + i * 2, 10000);
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream(data, kSamples * 2, 11025,
+		                                                          Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+
+		int16 out[2000];
+		memset(out, 0, sizeof(out));
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 48000, false, false, false, Audio::kRateConverterSincHigh);
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, ARRAYSIZE(out), 256, 256), ARRAYSIZE(out));
+		for (int i = 200; i < ARRAYSIZE(out); ++i)
+			TS_ASSERT_EQUALS(out[i], 10000);
+
+		delete converter;
+		delete stream;
+	}
+
+	void test_mix_sinc() {
+		checkMix(22050, 48000, false, true, false, Audio::kRateConverterSincLow);
+		checkMix(22050, 48000, true, true, true, Audio::kRateConverterSincHigh);
+		checkMix(48000, 22050, true, false, false, Audio::kRateConverterSincHigh);
+	}
+
+	void test_mix_kernels() {
+		const Audio::MixProcs *procs = Audio::getMixProcs();
+		if (procs)
+			TS_ASSERT(kernelsMatch(*procs));
+#ifdef SCUMMVM_SSE2
+		TS_ASSERT(kernelsMatch(Audio::mixProcsSSE2));
+#endif
+	}
+};
@@ -0,0 +1,161 @@
+#include "test/bench/bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/rate.h"
+
+#include "common/str.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kOutputRate = 44100,
+	kBufferSamples = 2048
+};
+
+/** Never ending stream producing a square wave. */
+class SquareWaveStream : public Audio::AudioStream {
+public:
+	SquareWaveStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _pos(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		for (int i = 0; i < numSamples; ++i, ++_pos)
+			buffer[i] = (_pos & 0x40) ? 8192 : -8192;
+		return numSamples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return false; }
+
+private:
+	const int _rate;
+	const bool _stereo;
+	uint _pos;
+};
+
+void benchRateConverter(State &state, int inRate, bool inStereo, Audio::RateConverterQuality quality = Audio::kRateConverterLinear) {
+	SquareWaveStream stream(inRate, inStereo);
+	Audio::RateConverter *converter = Audio::makeRateConverter(inRate, kOutputRate, inStereo, true, false, quality);
+	Audio::st_sample_t *buffer = new Audio::st_sample_t[kBufferSamples * 2];
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		memset(buffer, 0, kBufferSamples * 2 * sizeof(Audio::st_sample_t));
+		converter->convert(stream, buffer, kBufferSamples, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		doNotOptimize(buffer[0]);
+	}
+
+	delete[] buffer;
+	delete converter;
+	state.itemsProcessed = state.iterations * kBufferSamples;
+	state.realTimeItemsPerSecond = kOutputRate;
+}
+
+void benchCopyRate(State &state) {
+	benchRateConverter(state, kOutputRate, true);
+}
+
+void benchSimpleRate(State &state) {
+	benchRateConverter(state, kOutputRate * 2, false);
+}
+
+void benchInterpolateRate(State &state) {
+	benchRateConverter(state, 22050, true);
+}
+
+struct RateBenchmark {
+	int inRate;
+	bool inStereo;
+	Audio::RateConverterQuality quality;
+	Common::String name;
+};
+
+void benchRate(State &state) {
+	const RateBenchmark &benchmark = *(const RateBenchmark *)state.arg;
+	benchRateConverter(state, benchmark.inRate, benchmark.inStereo, benchmark.quality);
+}
+
+struct MixerBenchmark {
+	int channels;
+	Common::String name;
+};
+
+/**
+ * Mix a number of square waves, a quarter of them at each combination of
+ * the output rate or half of it and mono or stereo.
+ */
+void benchMixer(State &state) {
+	const MixerBenchmark &benchmark = *(const MixerBenchmark *)state.arg;
+	Audio::MixerImpl mixer(kOutputRate, true, kBufferSamples);
+	mixer.setReady(true);
+	for (int i = 0; i < benchmark.channels; ++i) {
+		Audio::AudioStream *stream = new SquareWaveStream((i & 1) ? kOutputRate / 2 : kOutputRate, (i & 2) != 0);
+		mixer.playStream(Audio::Mixer::kPlainSoundType, nullptr, stream, -1, Audio::Mixer::kMaxChannelVolume / 2, 0,
+		                 DisposeAfterUse::YES, false, false);
+	}
+
+	int16 *buffer = new int16[kBufferSamples * 2];
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		mixer.mixCallback((byte *)buffer, kBufferSamples * 2 * sizeof(int16));
+		doNotOptimize(buffer[0]);
+	}
+
+	delete[] buffer;
+	state.itemsProcessed = state.iterations * kBufferSamples;
+	state.realTimeItemsPerSecond = kOutputRate;
+}
+
+} // End of anonymous namespace
+
+void addAudioBenchmarks(BenchmarkList &list) {
+	static const Benchmark benchmarks[] = {
+		{ "RateConverter copy 44100 stereo", benchCopyRate, nullptr },
+		{ "RateConverter simple 88200 mono", benchSimpleRate, nullptr },
+		{ "RateConverter interpolate 22050 stereo", benchInterpolateRate, nullptr }
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); ++i)
+		list.push_back(benchmarks[i]);
+
+	// Every quality at the common input rates, converted to kOutputRate
+	static const int inRates[] = { 8000, 11025, 16000, 22050, 32000, 48000, 88200, 96000 };
+	static const char *const qualityNames[] = { "linear", "sinc_low", "sinc_high" };
+	static Common::Array<RateBenchmark> rates;
+	rates.clear();
+	for (uint q = 0; q < ARRAYSIZE(qualityNames); ++q) {
+		for (uint r = 0; r < ARRAYSIZE(inRates); ++r) {
+			for (int stereo = 0; stereo < 2; ++stereo) {
+				RateBenchmark benchmark;
+				benchmark.inRate = inRates[r];
+				benchmark.inStereo = stereo != 0;
+				benchmark.quality = (Audio::RateConverterQuality)q;
+				benchmark.name = Common::String::format("RateConverter %s %d %s", qualityNames[q], inRates[r], stereo ? "stereo" : "mono");
+				rates.push_back(benchmark);
+			}
+		}
+	}
+
+	static const int channelCounts[] = { 1, 8, 32 };
+	static Common::Array<MixerBenchmark> mixers;
+	mixers.clear();
+	for (uint i = 0; i < ARRAYSIZE(channelCounts); ++i) {
+		MixerBenchmark benchmark;
+		benchmark.channels = channelCounts[i];
+		benchmark.name = Common::String::format("MixerImpl %d channel%s", channelCounts[i], channelCounts[i] > 1 ? "s" : "");
+		mixers.push_back(benchmark);
+	}
+
+	// The arrays are complete, so the pointers into them stay valid
+	for (uint i = 0; i < rates.size(); ++i) {
+		const Benchmark benchmark = { rates[i].name.c_str(), benchRate, &rates[i] };
+		list.push_back(benchmark);
+	}
+	for (uint i = 0; i < mixers.size(); ++i) {
+		const Benchmark benchmark = { mixers[i].name.c_str(), benchMixer, &mixers[i] };
+		list.push_back(benchmark);
+	}
+}
+
+} // End of namespace Bench
@@ -0,0 +1,355 @@
+#include "test/bench/bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/decoders/3do.h"
+#include "audio/decoders/aac.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/asf.h"
+#include "audio/decoders/flac.h"
+#include "audio/decoders/g711.h"
+#include "audio/decoders/mp3.h"
+#include "audio/decoders/quicktime.h"
+#include "audio/decoders/raw.h"
+#include "audio/decoders/vorbis.h"
+#include "audio/decoders/xa.h"
+#include "audio/decoders/xan_dpcm.h"
+
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/str.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kClipRate = 22050,
+	kBufferSamples = 2048
+};
+
+Common::String clipDirectory;
+
+/** Deterministic pseudo random bytes, so that every run decodes the same data. */
+class Random {
+public:
+	Random() : _seed(0x13579bdf) {}
+
+	uint32 next() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void fill(Common::Array<byte> &data, uint size) {
+		data.resize(size);
+		for (uint i = 0; i < size; ++i)
+			data[i] = (byte)next();
+	}
+
+private:
+	uint32 _seed;
+};
+
+/**
+ * Generators of one second of valid input data. The decoders do not
+ * depend on the actual signal, so most of the data is random and only
+ * the block headers are made valid.
+ */
+typedef void (*GenerateProc)(Common::Array<byte> &data, Random &random);
+
+void generateRaw8(Common::Array<byte> &data, Random &random) {
+	random.fill(data, kClipRate);
+}
+
+void generateRaw16Stereo(Common::Array<byte> &data, Random &random) {
+	random.fill(data, kClipRate * 4);
+}
+
+void generateNibblesMono(Common::Array<byte> &data, Random &random) {
+	random.fill(data, kClipRate / 2);
+}
+
+void generateNibblesStereo(Common::Array<byte> &data, Random &random) {
+	random.fill(data, kClipRate);
+}
+
+void generateBytesStereo(Common::Array<byte> &data, Random &random) {
+	random.fill(data, kClipRate * 2);
+}
+
+// Every block of 1024 bytes starts with the predictor and step index of both channels
+void generateMSIma(Common::Array<byte> &data, Random &random) {
+	random.fill(data, 22 * 1024);
+	for (uint block = 0; block < data.size(); block += 1024) {
+		for (int ch = 0; ch < 2; ++ch) {
+			data[block + ch * 4 + 2] = random.next() % 89;
+			data[block + ch * 4 + 3] = 0;
+		}
+	}
+}
+
+// Every block of 1024 bytes starts with the predictors, deltas and first samples of both channels
+void generateMS(Common::Array<byte> &data, Random &random) {
+	random.fill(data, 22 * 1024);
+	for (uint block = 0; block < data.size(); block += 1024) {
+		for (int ch = 0; ch < 2; ++ch) {
+			const uint16 delta = 16 + random.next() % 1024;
+			data[block + ch] = random.next() % 7;
+			data[block + 2 + ch * 2] = delta & 0xFF;
+			data[block + 3 + ch * 2] = delta >> 8;
+		}
+	}
+}
+
+// Blocks of 34 bytes per channel, the decoder clips the header values itself
+void generateApple(Common::Array<byte> &data, Random &random) {
+	random.fill(data, (kClipRate / 64) * 34 * 2);
+}
+
+// Every block of 1024 bytes starts with the rate and the sum and difference channel states
+void generateDK3(Common::Array<byte> &data, Random &random) {
+	random.fill(data, 22 * 1024);
+	for (uint block = 0; block < data.size(); block += 1024) {
+		data[block + 2] = kClipRate & 0xFF;
+		data[block + 3] = kClipRate >> 8;
+		data[block + 14] = random.next() % 89;
+		data[block + 15] = random.next() % 89;
+	}
+}
+
+// Sound groups of 128 bytes, of which the first 16 hold the filters and shifts
+void generateXAADPCM(Common::Array<byte> &data, Random &random) {
+	random.fill(data, (kClipRate * 2 / 224 + 1) * 128);
+	for (uint group = 0; group < data.size(); group += 128) {
+		for (int i = 0; i < 16; ++i)
+			data[group + i] = (random.next() % 5) << 4 | random.next() % 13;
+	}
+}
+
+// Blocks of 16 bytes with a filter and shift, flags and 28 samples
+void generateXA(Common::Array<byte> &data, Random &random) {
+	random.fill(data, (kClipRate / 28 + 1) * 16);
+	for (uint block = 0; block < data.size(); block += 16) {
+		data[block] = (random.next() % 5) << 4 | random.next() % 13;
+		data[block + 1] = block + 16 < data.size() ? 0 : 7;
+	}
+}
+
+typedef Audio::AudioStream *(*MakeStreamProc)(Common::SeekableReadStream *stream);
+
+Audio::AudioStream *makeRaw8(Common::SeekableReadStream *stream) {
+	return Audio::makeRawStream(stream, kClipRate, Audio::FLAG_UNSIGNED);
+}
+
+Audio::AudioStream *makeRaw16Stereo(Common::SeekableReadStream *stream) {
+	return Audio::makeRawStream(stream, kClipRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | Audio::FLAG_STEREO);
+}
+
+Audio::AudioStream *makeALaw(Common::SeekableReadStream *stream) {
+	return Audio::makeALawStream(stream, DisposeAfterUse::YES, kClipRate, 1);
+}
+
+Audio::AudioStream *makeMuLaw(Common::SeekableReadStream *stream) {
+	return Audio::makeMuLawStream(stream, DisposeAfterUse::YES, kClipRate, 1);
+}
+
+Audio::AudioStream *makeOki(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMOki, kClipRate, 1);
+}
+
+Audio::AudioStream *makeDVI(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMDVI, kClipRate, 2);
+}
+
+Audio::AudioStream *makeMSIma(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMMSIma, kClipRate, 2, 1024);
+}
+
+Audio::AudioStream *makeMS(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMMS, kClipRate, 2, 1024);
+}
+
+Audio::AudioStream *makeApple(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMApple, kClipRate, 2, 34);
+}
+
+Audio::AudioStream *makeDK3(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMDK3, kClipRate, 2, 1024);
+}
+
+Audio::AudioStream *makeXAADPCM(Common::SeekableReadStream *stream) {
+	return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, 0, Audio::kADPCMXA, kClipRate, 2);
+}
+
+Audio::AudioStream *makeXA(Common::SeekableReadStream *stream) {
+	return Audio::makeXAStream(stream, kClipRate);
+}
+
+Audio::AudioStream *make3DOADP4(Common::SeekableReadStream *stream) {
+	return Audio::make3DO_ADP4AudioStream(stream, kClipRate, false);
+}
+
+Audio::AudioStream *make3DOSDX2(Common::SeekableReadStream *stream) {
+	return Audio::make3DO_SDX2AudioStream(stream, kClipRate, true);
+}
+
+Audio::AudioStream *makeXanDPCM(Common::SeekableReadStream *stream) {
+	Audio::XanDPCMStream *xan = new Audio::XanDPCMStream(kClipRate, 2);
+	xan->queuePacket(stream);
+	xan->finish();
+	return xan;
+}
+
+#ifdef USE_MAD
+Audio::AudioStream *makeMP3(Common::SeekableReadStream *stream) {
+	return Audio::makeMP3Stream(stream, DisposeAfterUse::YES);
+}
+#endif
+
+#ifdef USE_VORBIS
+Audio::AudioStream *makeVorbis(Common::SeekableReadStream *stream) {
+	return Audio::makeVorbisStream(stream, DisposeAfterUse::YES);
+}
+#endif
+
+#ifdef USE_FLAC
+Audio::AudioStream *makeFLAC(Common::SeekableReadStream *stream) {
+	return Audio::makeFLACStream(stream, DisposeAfterUse::YES);
+}
+#endif
+
+Audio::AudioStream *makeASF(Common::SeekableReadStream *stream) {
+	return Audio::makeASFStream(stream, DisposeAfterUse::YES);
+}
+
+Audio::AudioStream *makeQuickTime(Common::SeekableReadStream *stream) {
+	return Audio::makeQuickTimeStream(stream, DisposeAfterUse::YES);
+}
+
+/**
+ * A decoder fed either with generated data or with a reference clip
+ * from the clip directory.
+ */
+struct DecoderInfo {
+	const char *name;
+	GenerateProc generate;
+	const char *clipFile;
+	MakeStreamProc makeStream;
+};
+
+const DecoderInfo decoderInfos[] = {
+	{ "Decode raw 8-bit mono", generateRaw8, nullptr, makeRaw8 },
+	{ "Decode raw 16-bit stereo", generateRaw16Stereo, nullptr, makeRaw16Stereo },
+	{ "Decode G.711 A-law mono", generateRaw8, nullptr, makeALaw },
+	{ "Decode G.711 mu-law mono", generateRaw8, nullptr, makeMuLaw },
+	{ "Decode ADPCM Oki mono", generateNibblesMono, nullptr, makeOki },
+	{ "Decode ADPCM DVI stereo", generateNibblesStereo, nullptr, makeDVI },
+	{ "Decode ADPCM MS IMA stereo", generateMSIma, nullptr, makeMSIma },
+	{ "Decode ADPCM MS stereo", generateMS, nullptr, makeMS },
+	{ "Decode ADPCM Apple IMA stereo", generateApple, nullptr, makeApple },
+	{ "Decode ADPCM DK3 stereo", generateDK3, nullptr, makeDK3 },
+	{ "Decode ADPCM XA stereo", generateXAADPCM, nullptr, makeXAADPCM },
+	{ "Decode PlayStation XA mono", generateXA, nullptr, makeXA },
+	{ "Decode 3DO ADP4 mono", generateNibblesMono, nullptr, make3DOADP4 },
+	{ "Decode 3DO SDX2 stereo", generateBytesStereo, nullptr, make3DOSDX2 },
+	{ "Decode Xan DPCM stereo", generateBytesStereo, nullptr, makeXanDPCM },
+#ifdef USE_MAD
+	{ "Decode MP3 clip", nullptr, "clip.mp3", makeMP3 },
+#endif
+#ifdef USE_VORBIS
+	{ "Decode Vorbis clip", nullptr, "clip.ogg", makeVorbis },
+#endif
+#ifdef USE_FLAC
+	{ "Decode FLAC clip", nullptr, "clip.flac", makeFLAC },
+#endif
+	{ "Decode WMA clip", nullptr, "clip.wma", makeASF },
+	{ "Decode QDM2 clip", nullptr, "clip_qdm2.mov", makeQuickTime },
+#ifdef USE_FAAD
+	{ "Decode AAC clip", nullptr, "clip_aac.m4a", makeQuickTime },
+#endif
+};
+
+struct Decoder {
+	const DecoderInfo *info;
+	Common::Array<byte> data;
+};
+
+Audio::AudioStream *openStream(const Decoder &decoder) {
+	return decoder.info->makeStream(new Common::MemoryReadStream(decoder.data.data(), decoder.data.size()));
+}
+
+bool loadClip(const char *name, Common::Array<byte> &data) {
+	if (clipDirectory.empty())
+		return false;
+
+	Common::FSNode node = Common::FSNode(Common::Path(clipDirectory)).getChild(name);
+	Common::SeekableReadStream *stream = node.exists() ? node.createReadStream() : nullptr;
+	if (!stream)
+		return false;
+
+	data.resize(stream->size());
+	const bool result = stream->read(data.data(), data.size()) == data.size();
+	delete stream;
+	return result;
+}
+
+/** Decode the whole input again in every iteration, including the setup of the stream. */
+void benchDecoder(State &state) {
+	const Decoder &decoder = *(const Decoder *)state.arg;
+	int16 *buffer = new int16[kBufferSamples];
+	uint64 samples = 0;
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Audio::AudioStream *stream = openStream(decoder);
+		state.realTimeItemsPerSecond = stream->getRate() * (stream->isStereo() ? 2 : 1);
+		while (!stream->endOfData()) {
+			const int decoded = stream->readBuffer(buffer, kBufferSamples);
+			if (decoded <= 0)
+				break;
+			samples += decoded;
+		}
+		doNotOptimize(buffer[0]);
+		delete stream;
+	}
+
+	delete[] buffer;
+	state.itemsProcessed = samples;
+	state.bytesProcessed = state.iterations * decoder.data.size();
+}
+
+} // End of anonymous namespace
+
+void setAudioClipDirectory(const char *path) {
+	clipDirectory = path;
+}
+
+void addAudioDecoderBenchmarks(BenchmarkList &list) {
+	static Common::Array<Decoder> decoders;
+	decoders.clear();
+	decoders.reserve(ARRAYSIZE(decoderInfos));
+
+	Random random;
+	for (uint i = 0; i < ARRAYSIZE(decoderInfos); ++i) {
+		Decoder decoder;
+		decoder.info = &decoderInfos[i];
+		if (decoder.info->generate)
+			decoder.info->generate(decoder.data, random);
+		else if (!loadClip(decoder.info->clipFile, decoder.data))
+			continue;
+
+		// Skip the clips which this build cannot decode
+		Audio::AudioStream *stream = openStream(decoder);
+		if (!stream)
+			continue;
+		delete stream;
+
+		decoders.push_back(decoder);
+	}
+
+	// The array is complete, so the pointers into it stay valid
+	for (uint i = 0; i < decoders.size(); ++i) {
+		const Benchmark benchmark = { decoders[i].info->name, benchDecoder, &decoders[i] };
+		list.push_back(benchmark);
+	}
+}
+
+} // End of namespace Bench
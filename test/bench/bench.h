@@ -0,0 +1,67 @@
+#ifndef TEST_BENCH_BENCH_H
+#define TEST_BENCH_BENCH_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+
+namespace Bench {
+
+/**
+ * Passed to every benchmark. The benchmark has to run its workload
+ * 'iterations' times and may report how much work that was, which is
+ * used to compute throughput. Benchmarks processing audio samples also
+ * report how many items play per second, so that the throughput can be
+ * compared to real time.
+ */
+struct State {
+	const void *arg;
+	uint64 iterations;
+	uint64 bytesProcessed;
+	uint64 itemsProcessed;
+	uint64 realTimeItemsPerSecond;
+
+	State() : arg(nullptr), iterations(0), bytesProcessed(0), itemsProcessed(0), realTimeItemsPerSecond(0) {}
+};
+
+typedef void (*BenchProc)(State &state);
+
+/**
+ * A named benchmark. The same procedure can be used for several
+ * benchmarks, which it tells apart through 'arg', passed in State.
+ */
+struct Benchmark {
+	const char *name;
+	BenchProc proc;
+	const void *arg;
+};
+
+typedef Common::Array<Benchmark> BenchmarkList;
+
+/** Keep the compiler from optimizing away computations whose results are unused. */
+template<class T>
+inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	volatile const T *sink = &value;
+	(void)sink;
+#endif
+}
+
+void addCommonBenchmarks(BenchmarkList &list);
+void addGraphicsBenchmarks(BenchmarkList &list);
+void addAudioBenchmarks(BenchmarkList &list);
+void addAudioDecoderBenchmarks(BenchmarkList &list);
+void addImageBenchmarks(BenchmarkList &list);
+void addMathBenchmarks(BenchmarkList &list);
+
+/**
+ * Set the directory with the reference clips for the decoders which
+ * cannot be fed generated data. The decoder benchmarks of missing clips
+ * are skipped.
+ */
+void setAudioClipDirectory(const char *path);
+
+} // End of namespace Bench
+
+#endif
@@ -0,0 +1,315 @@
+#include "test/bench/bench.h"
+
+#include "common/bitstream.h"
+#include "common/concurrent-memorypool.h"
+#include "common/flat-hashmap.h"
+#include "common/hashmap.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+#include "common/path.h"
+#include "common/str.h"
+#include "common/substream.h"
+#include "common/ustr.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kNumKeys = 4096,
+	kStreamSize = 64 * 1024
+};
+
+void benchStringAppend(State &state) {
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::String str;
+		for (uint c = 0; c < 256; ++c)
+			str += (char)('a' + c % 26);
+		doNotOptimize(str.c_str()[0]);
+	}
+	state.itemsProcessed = state.iterations * 256;
+}
+
+void benchStringFormat(State &state) {
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::String str = Common::String::format("%s-%d-%08x", "resource", (int)i, (uint)i);
+		doNotOptimize(str.c_str()[0]);
+	}
+	state.itemsProcessed = state.iterations;
+}
+
+void benchStringCompare(State &state) {
+	const Common::String a("The quick brown fox jumps over the lazy dog");
+	const Common::String b("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG");
+	uint equal = 0;
+	for (uint64 i = 0; i < state.iterations; ++i)
+		equal += a.equalsIgnoreCase(b);
+	doNotOptimize(equal);
+	state.itemsProcessed = state.iterations;
+}
+
+void benchStringCopy(State &state) {
+	// Long enough for external storage, so every copy takes a ref count
+	const Common::String text("The quick brown fox jumps over the lazy dog, twice over.");
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::String a(text);
+		Common::String b(a);
+		doNotOptimize(b.c_str()[0]);
+	}
+	state.itemsProcessed = state.iterations * 2;
+}
+
+void benchConcurrentMemoryPool(State &state) {
+	Common::ConcurrentMemoryPool pool(sizeof(int));
+	void *chunks[64];
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint c = 0; c < 64; ++c)
+			chunks[c] = pool.allocChunk();
+		for (uint c = 0; c < 64; ++c)
+			pool.freeChunk(chunks[c]);
+	}
+	state.itemsProcessed = state.iterations * 64;
+}
+
+void benchU32StringConvert(State &state) {
+	const Common::String utf8("Fl\xc3\xbcgel \xe2\x80\x94 \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e text for decoding");
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::U32String str(utf8, Common::kUtf8);
+		Common::String back = str.encode(Common::kUtf8);
+		doNotOptimize(back.c_str()[0]);
+	}
+	state.bytesProcessed = state.iterations * utf8.size();
+}
+
+void benchU32StringDecodeASCII(State &state) {
+	Common::String text;
+	while (text.size() < 4096)
+		text += "The quick brown fox jumps over the lazy dog. ";
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::U32String str(text, Common::kUtf8);
+		doNotOptimize(str.c_str()[0]);
+	}
+	state.bytesProcessed = state.iterations * text.size();
+}
+
+void benchU32StringEncodeASCII(State &state) {
+	Common::String text;
+	while (text.size() < 4096)
+		text += "The quick brown fox jumps over the lazy dog. ";
+	const Common::U32String str(text, Common::kUtf8);
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::String back = str.encode(Common::kUtf8);
+		doNotOptimize(back.c_str()[0]);
+	}
+	state.itemsProcessed = state.iterations * str.size();
+}
+
+void benchU32StringCodePage(State &state) {
+	const Common::String latin1("Sch\xf6ne Gr\xfc\xdf" "e aus K\xf6ln, la fen\xea" "tre est ouverte. ");
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::U32String str(latin1, Common::kISO8859_1);
+		Common::String back = str.encode(Common::kWindows1252);
+		doNotOptimize(back.c_str()[0]);
+	}
+	state.bytesProcessed = state.iterations * latin1.size();
+}
+
+template<class Map>
+void benchMapInsert(State &state) {
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Map map;
+		for (uint k = 0; k < kNumKeys; ++k)
+			map[k * 2654435761u] = k;
+		doNotOptimize(map.size());
+	}
+	state.itemsProcessed = state.iterations * kNumKeys;
+}
+
+template<class Map>
+void benchMapLookup(State &state) {
+	Map map;
+	for (uint k = 0; k < kNumKeys; ++k)
+		map[k * 2654435761u] = k;
+
+	uint found = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		// Half of the lookups miss.
+		for (uint k = 0; k < kNumKeys; ++k)
+			found += map.contains((k * 2) * 2654435761u);
+	}
+	doNotOptimize(found);
+	state.itemsProcessed = state.iterations * kNumKeys;
+}
+
+void benchStringHashMapLookup(State &state) {
+	typedef Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringMap;
+	StringMap map;
+	Common::Array<Common::String> keys;
+	for (uint k = 0; k < kNumKeys; ++k) {
+		keys.push_back(Common::String::format("data/resource%04u.bin", k));
+		map[keys.back()] = k;
+	}
+
+	uint found = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint k = 0; k < kNumKeys; ++k)
+			found += map.contains(keys[k]);
+	}
+	doNotOptimize(found);
+	state.itemsProcessed = state.iterations * kNumKeys;
+}
+
+void benchPathHashMapLookup(State &state) {
+	typedef Common::HashMap<Common::Path, uint, Common::Path::IgnoreCaseAndMac_Hash, Common::Path::IgnoreCaseAndMac_EqualsTo> PathMap;
+	PathMap map;
+	Common::Array<Common::Path> keys;
+	for (uint k = 0; k < kNumKeys; ++k) {
+		keys.push_back(Common::Path(Common::String::format("Data/Movies/Resource%04u.bin", k)));
+		map[keys.back()] = k;
+	}
+
+	uint found = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint k = 0; k < kNumKeys; ++k)
+			found += map.contains(keys[k]);
+	}
+	doNotOptimize(found);
+	state.itemsProcessed = state.iterations * kNumKeys;
+}
+
+void benchArrayPushBack(State &state) {
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::Array<uint32> array;
+		for (uint k = 0; k < kNumKeys; ++k)
+			array.push_back(k);
+		doNotOptimize(array[kNumKeys - 1]);
+	}
+	state.itemsProcessed = state.iterations * kNumKeys;
+}
+
+void benchMemoryReadStream(State &state) {
+	byte *data = new byte[kStreamSize]();
+	uint32 sum = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::MemoryReadStream stream(data, kStreamSize);
+		for (uint k = 0; k < kStreamSize / 4; ++k)
+			sum += stream.readUint32LE();
+	}
+	doNotOptimize(sum);
+	delete[] data;
+	state.bytesProcessed = state.iterations * kStreamSize;
+}
+
+void benchSubReadStream(State &state) {
+	byte *data = new byte[kStreamSize + 16]();
+	Common::MemoryReadStream parent(data, kStreamSize + 16);
+	uint32 sum = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::SeekableSubReadStream stream(&parent, 16, kStreamSize + 16);
+		for (uint k = 0; k < kStreamSize / 4; ++k)
+			sum += stream.readUint32LE();
+	}
+	doNotOptimize(sum);
+	delete[] data;
+	state.bytesProcessed = state.iterations * kStreamSize;
+}
+
+template<class BITSTREAM, class STREAM>
+void benchBitStreamGetBits(State &state) {
+	byte *data = new byte[kStreamSize];
+	for (uint k = 0; k < kStreamSize; ++k)
+		data[k] = (byte)(k * 167 + 13);
+
+	uint32 sum = 0;
+	uint64 bitsRead = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		STREAM stream(data, kStreamSize);
+		BITSTREAM bits(stream);
+		// Mixed widths, as read by the audio and video decoders
+		for (uint n = 1; bits.pos() + 32 <= bits.size(); n = (n * 7 + 3) % 23 + 1) {
+			sum += bits.getBits(n);
+			bitsRead += n;
+		}
+	}
+	doNotOptimize(sum);
+	delete[] data;
+	state.bytesProcessed = bitsRead / 8;
+}
+
+void benchHuffmanLongCodes(State &state) {
+	// A canonical code with two codes of each length from 2 to 16 (and
+	// two more of length 16), similar to the coefficient tables of audio codecs
+	const uint32 codeCount = 32;
+	uint8 lengths[codeCount];
+	uint32 codes[codeCount];
+	for (uint32 i = 0; i < codeCount; ++i)
+		lengths[i] = MIN<uint32>(2 + i / 2, 16);
+
+	uint32 code = 0;
+	for (uint32 i = 0; i < codeCount; ++i) {
+		if (i > 0)
+			code = (code + 1) << (lengths[i] - lengths[i - 1]);
+		codes[i] = code;
+	}
+
+	Common::Huffman<Common::BitStream8MSB> huffman(0, codeCount, codes, lengths);
+
+	// Encode symbols picked so that about a third of them need more than 8 bits
+	byte *data = new byte[kStreamSize + 8]();
+	uint32 numSymbols = 0;
+	uint32 pos = 0;
+	for (uint32 seed = 1; pos + 16 <= kStreamSize * 8; ++numSymbols) {
+		seed = seed * 1103515245 + 12345;
+		const uint32 symbol = ((seed >> 16) % 3 == 0) ? 14 + (seed >> 8) % 18 : (seed >> 8) % 14;
+		for (int b = lengths[symbol] - 1; b >= 0; --b, ++pos)
+			data[pos / 8] |= ((codes[symbol] >> b) & 1) << (7 - pos % 8);
+	}
+
+	uint32 sum = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::MemoryReadStream stream(data, kStreamSize + 8);
+		Common::BitStream8MSB bits(stream);
+		for (uint32 k = 0; k < numSymbols; ++k)
+			sum += huffman.getSymbol(bits);
+	}
+	doNotOptimize(sum);
+	delete[] data;
+	state.itemsProcessed = state.iterations * numSymbols;
+}
+
+} // End of anonymous namespace
+
+void addCommonBenchmarks(BenchmarkList &list) {
+	typedef Common::HashMap<uint32, uint32> IntMap;
+	typedef Common::FlatHashMap<uint32, uint32> FlatIntMap;
+
+	static const Benchmark benchmarks[] = {
+		{ "String::operator+=", benchStringAppend, nullptr },
+		{ "String::format", benchStringFormat, nullptr },
+		{ "String::equalsIgnoreCase", benchStringCompare, nullptr },
+		{ "String copy (shared storage)", benchStringCopy, nullptr },
+		{ "U32String UTF-8 round trip", benchU32StringConvert, nullptr },
+		{ "U32String UTF-8 decode (ASCII)", benchU32StringDecodeASCII, nullptr },
+		{ "U32String UTF-8 encode (ASCII)", benchU32StringEncodeASCII, nullptr },
+		{ "U32String Latin-1 to CP1252", benchU32StringCodePage, nullptr },
+		{ "HashMap insert", benchMapInsert<IntMap>, nullptr },
+		{ "HashMap lookup", benchMapLookup<IntMap>, nullptr },
+		{ "HashMap<String> lookup", benchStringHashMapLookup, nullptr },
+		{ "HashMap<Path> case-insensitive lookup", benchPathHashMapLookup, nullptr },
+		{ "FlatHashMap insert", benchMapInsert<FlatIntMap>, nullptr },
+		{ "FlatHashMap lookup", benchMapLookup<FlatIntMap>, nullptr },
+		{ "Array::push_back", benchArrayPushBack, nullptr },
+		{ "ConcurrentMemoryPool alloc/free", benchConcurrentMemoryPool, nullptr },
+		{ "MemoryReadStream::readUint32LE", benchMemoryReadStream, nullptr },
+		{ "SeekableSubReadStream::readUint32LE", benchSubReadStream, nullptr },
+		{ "BitStream8MSB::getBits", benchBitStreamGetBits<Common::BitStream8MSB, Common::MemoryReadStream>, nullptr },
+		{ "BitStreamMemory8MSB::getBits", benchBitStreamGetBits<Common::BitStreamMemory8MSB, Common::BitStreamMemoryStream>, nullptr },
+		{ "BitStreamMemory32LELSB::getBits", benchBitStreamGetBits<Common::BitStreamMemory32LELSB, Common::BitStreamMemoryStream>, nullptr },
+		{ "Huffman::getSymbol (long codes)", benchHuffmanLongCodes, nullptr }
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); ++i)
+		list.push_back(benchmarks[i]);
+}
+
+} // End of namespace Bench
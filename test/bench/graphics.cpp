@@ -0,0 +1,307 @@
+#include "test/bench/bench.h"
+
+#include "graphics/blit.h"
+#include "graphics/managed_surface.h"
+#include "graphics/palette.h"
+#include "graphics/pixelformat.h"
+#include "graphics/region.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/scaler/normal.h"
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq-simd.h"
+#endif
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kWidth = 320,
+	kHeight = 200
+};
+
+const Graphics::PixelFormat kFormatRGB565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+const Graphics::PixelFormat kFormatRGBA8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+const Graphics::PixelFormat kFormatABGR8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+
+void fillPattern(byte *dst, uint size) {
+	uint32 seed = 0x12345678;
+	for (uint i = 0; i < size; ++i) {
+		seed = seed * 1103515245 + 12345;
+		dst[i] = (byte)(seed >> 16);
+	}
+}
+
+void benchCrossBlit(State &state, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+	const uint srcPitch = kWidth * srcFmt.bytesPerPixel;
+	const uint dstPitch = kWidth * dstFmt.bytesPerPixel;
+	byte *src = new byte[srcPitch * kHeight];
+	byte *dst = new byte[dstPitch * kHeight];
+	fillPattern(src, srcPitch * kHeight);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Graphics::crossBlit(dst, src, dstPitch, srcPitch, kWidth, kHeight, dstFmt, srcFmt);
+		doNotOptimize(dst[0]);
+	}
+
+	delete[] src;
+	delete[] dst;
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+	state.bytesProcessed = state.iterations * srcPitch * kHeight;
+}
+
+void benchCrossBlit565To8888(State &state) {
+	benchCrossBlit(state, kFormatRGBA8888, kFormatRGB565);
+}
+
+void benchCrossBlit8888To565(State &state) {
+	benchCrossBlit(state, kFormatRGB565, kFormatRGBA8888);
+}
+
+void benchCrossBlitSwap32(State &state) {
+	benchCrossBlit(state, kFormatABGR8888, kFormatRGBA8888);
+}
+
+void benchCrossBlitMap(State &state) {
+	uint32 map[256];
+	for (uint i = 0; i < 256; ++i)
+		map[i] = i * 0x010101u | 0xFF000000u;
+
+	byte *src = new byte[kWidth * kHeight];
+	uint32 *dst = new uint32[kWidth * kHeight];
+	fillPattern(src, kWidth * kHeight);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Graphics::crossBlitMap((byte *)dst, src, kWidth * 4, kWidth, kWidth, kHeight, 4, map);
+		doNotOptimize(dst[0]);
+	}
+
+	delete[] src;
+	delete[] dst;
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+}
+
+void benchTransBlit(State &state, const Graphics::PixelFormat &dstFmt, const byte *palette) {
+	Graphics::Surface sprite;
+	sprite.create(64, 64, Graphics::PixelFormat::createFormatCLUT8());
+	fillPattern((byte *)sprite.getPixels(), sprite.pitch * sprite.h);
+	Graphics::ManagedSurface screen(kWidth, kHeight, dstFmt);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		// A screen full of sprites, some of them clipped at the edges
+		for (int y = -32; y < kHeight; y += 64) {
+			for (int x = -32; x < kWidth; x += 64)
+				screen.transBlitFrom(sprite, Common::Point(x, y), 0, false, 0, 0xff, palette);
+		}
+		doNotOptimize(*(const byte *)screen.getPixels());
+	}
+
+	sprite.free();
+	state.itemsProcessed = state.iterations * 6 * 4;
+}
+
+void benchTransBlitCLUT8(State &state) {
+	benchTransBlit(state, Graphics::PixelFormat::createFormatCLUT8(), nullptr);
+}
+
+void benchTransBlitCLUT8ToRGB565(State &state) {
+	byte palette[256 * 3];
+	fillPattern(palette, sizeof(palette));
+	benchTransBlit(state, kFormatRGB565, palette);
+}
+
+void benchScaler(State &state, Scaler &scaler, uint factor, const Graphics::PixelFormat &format = kFormatRGB565) {
+	// Scalers read one pixel row and column around the source rectangle.
+	const uint srcPitch = (kWidth + 2) * format.bytesPerPixel;
+	const uint dstPitch = kWidth * factor * format.bytesPerPixel;
+	byte *src = new byte[srcPitch * (kHeight + 2)];
+	byte *dst = new byte[dstPitch * kHeight * factor];
+	fillPattern(src, srcPitch * (kHeight + 2));
+
+	scaler.setFactor(factor);
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		scaler.scale(src + srcPitch + format.bytesPerPixel, srcPitch, dst, dstPitch, kWidth, kHeight, 0, 0);
+		doNotOptimize(dst[0]);
+	}
+
+	delete[] src;
+	delete[] dst;
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+}
+
+void benchYUV420(State &state, const Graphics::PixelFormat &format, bool useSIMD) {
+	const int width = kWidth;
+	const int height = kHeight;
+	byte *y = new byte[width * height];
+	byte *uv = new byte[width * height / 2];
+	fillPattern(y, width * height);
+	fillPattern(uv, width * height / 2);
+
+	Graphics::Surface dst;
+	dst.create(width, height, format);
+	YUVToRGBMan.setUseSIMD(useSIMD);
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		YUVToRGBMan.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, y, uv, uv + width * height / 4, width, height, width, width / 2);
+		doNotOptimize(*(byte *)dst.getPixels());
+	}
+	YUVToRGBMan.setUseSIMD(true);
+
+	dst.free();
+	delete[] y;
+	delete[] uv;
+	state.itemsProcessed = state.iterations * width * height;
+}
+
+void benchPaletteLookup(State &state) {
+	byte palette[256 * 3];
+	uint32 seed = 0x12345678;
+	for (uint i = 0; i < sizeof(palette); ++i) {
+		seed = seed * 1103515245 + 12345;
+		palette[i] = seed >> 16;
+	}
+
+	// A fresh lookup for every frame of smooth gradients, as after a palette change
+	uint sum = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Graphics::PaletteLookup lookup(palette, 256);
+		for (uint y = 0; y < kHeight; ++y) {
+			for (uint x = 0; x < kWidth; ++x)
+				sum += lookup.findBestColor(x * 255 / kWidth, y * 255 / kHeight, (x + y) & 0xFF);
+		}
+	}
+	doNotOptimize(sum);
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+}
+
+void benchRegionUnite(State &state) {
+	// Sprite sized dirty areas scattered over the screen, many overlapping
+	Common::Rect rects[256];
+	uint32 seed = 0x12345678;
+	for (uint i = 0; i < ARRAYSIZE(rects); ++i) {
+		seed = seed * 1103515245 + 12345;
+		int16 x = (seed >> 8) % (kWidth - 32);
+		int16 y = (seed >> 20) % (kHeight - 32);
+		rects[i] = Common::Rect(x, y, x + 8 + (seed & 15), y + 8 + ((seed >> 4) & 15));
+	}
+
+	uint count = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Graphics::Region region;
+		region.unite(rects, ARRAYSIZE(rects));
+		region.simplify(8, 64);
+		count += region.getRects().size();
+	}
+	doNotOptimize(count);
+	state.itemsProcessed = state.iterations * ARRAYSIZE(rects);
+}
+
+void benchYUV420ToRGB565LUT(State &state) {
+	benchYUV420(state, kFormatRGB565, false);
+}
+
+void benchYUV420ToRGB565SIMD(State &state) {
+	benchYUV420(state, kFormatRGB565, true);
+}
+
+void benchYUV420ToRGBA8888LUT(State &state) {
+	benchYUV420(state, kFormatRGBA8888, false);
+}
+
+void benchYUV420ToRGBA8888SIMD(State &state) {
+	benchYUV420(state, kFormatRGBA8888, true);
+}
+
+void benchNormal1x(State &state) {
+	NormalScaler scaler(kFormatRGB565);
+	benchScaler(state, scaler, 1);
+}
+
+#ifdef USE_SCALERS
+void benchNormal2x(State &state) {
+	NormalScaler scaler(kFormatRGB565);
+	benchScaler(state, scaler, 2);
+}
+#endif
+
+#ifdef USE_HQ_SCALERS
+void benchHQ2x(State &state) {
+	HQScaler scaler(kFormatRGB565);
+	benchScaler(state, scaler, 2);
+}
+
+void benchHQ3x(State &state) {
+	HQScaler scaler(kFormatRGB565);
+	benchScaler(state, scaler, 3);
+}
+
+void benchHQ2x32(State &state) {
+	HQScaler scaler(kFormatRGBA8888);
+	benchScaler(state, scaler, 2, kFormatRGBA8888);
+}
+
+void benchHQPatterns(State &state, Graphics::HQPatternRowProc patternRow) {
+	// YUV values of random RGB565 pixels, with the border rows and columns
+	const uint pitch = kWidth + 2;
+	uint32 *yuv = new uint32[pitch * (kHeight + 2)];
+	byte *patterns = new byte[kWidth];
+	fillPattern((byte *)yuv, pitch * (kHeight + 2) * sizeof(uint32));
+	for (uint i = 0; i < pitch * (kHeight + 2); ++i)
+		yuv[i] &= 0x007f7f7f;
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint y = 0; y < kHeight; ++y) {
+			const uint32 *center = yuv + (y + 1) * pitch + 1;
+			patternRow(patterns, center - pitch, center, center + pitch, kWidth);
+		}
+		doNotOptimize(patterns[0]);
+	}
+
+	delete[] yuv;
+	delete[] patterns;
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+}
+
+void benchHQPatternsC(State &state) {
+	benchHQPatterns(state, Graphics::hqPatternRow);
+}
+
+void benchHQPatternsSIMD(State &state) {
+	benchHQPatterns(state, Graphics::getHQPatternRowProc());
+}
+#endif
+
+} // End of anonymous namespace
+
+void addGraphicsBenchmarks(BenchmarkList &list) {
+	static const Benchmark benchmarks[] = {
+		{ "crossBlit RGB565 -> RGBA8888", benchCrossBlit565To8888, nullptr },
+		{ "crossBlit RGBA8888 -> RGB565", benchCrossBlit8888To565, nullptr },
+		{ "crossBlit RGBA8888 -> ABGR8888", benchCrossBlitSwap32, nullptr },
+		{ "crossBlitMap CLUT8 -> 32bpp", benchCrossBlitMap, nullptr },
+		{ "transBlitFrom CLUT8 keyed", benchTransBlitCLUT8, nullptr },
+		{ "transBlitFrom CLUT8 -> RGB565 keyed", benchTransBlitCLUT8ToRGB565, nullptr },
+		{ "PaletteLookup::findBestColor", benchPaletteLookup, nullptr },
+		{ "Region::unite (256 rects)", benchRegionUnite, nullptr },
+		{ "YUV420 -> RGB565 LUT", benchYUV420ToRGB565LUT, nullptr },
+		{ "YUV420 -> RGB565 SIMD", benchYUV420ToRGB565SIMD, nullptr },
+		{ "YUV420 -> RGBA8888 LUT", benchYUV420ToRGBA8888LUT, nullptr },
+		{ "YUV420 -> RGBA8888 SIMD", benchYUV420ToRGBA8888SIMD, nullptr },
+		{ "NormalScaler 1x", benchNormal1x, nullptr },
+#ifdef USE_SCALERS
+		{ "NormalScaler 2x", benchNormal2x, nullptr },
+#endif
+#ifdef USE_HQ_SCALERS
+		{ "HQScaler 2x", benchHQ2x, nullptr },
+		{ "HQScaler 3x", benchHQ3x, nullptr },
+		{ "HQScaler 2x RGBA8888", benchHQ2x32, nullptr },
+		{ "HQ patterns C", benchHQPatternsC, nullptr },
+		{ "HQ patterns SIMD", benchHQPatternsSIMD, nullptr },
+#endif
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); ++i)
+		list.push_back(benchmarks[i]);
+}
+
+} // End of namespace Bench
@@ -0,0 +1,183 @@
+#include "test/bench/bench.h"
+
+#include "common/memstream.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "image/codecs/cinepak.h"
+#include "image/codecs/indeo/indeo_dsp.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kWidth = 320,
+	kHeight = 240
+};
+
+void writeChunkHeader(Common::WriteStream &stream, byte id, uint32 size) {
+	stream.writeByte(id);
+	stream.writeByte((size + 4) >> 16);
+	stream.writeUint16BE((size + 4) & 0xFFFF);
+}
+
+/**
+ * Encode a Cinepak key frame with one strip, full v1 and v4 codebooks and
+ * random blocks using either of them.
+ */
+void createCinepakFrame(Common::MemoryWriteStreamDynamic &frame) {
+	uint32 seed = 0x6b8b4567;
+	byte codebooks[2][256 * 6];
+	for (uint i = 0; i < sizeof(codebooks); ++i) {
+		seed = seed * 1103515245 + 12345;
+		codebooks[i / sizeof(codebooks[0])][i % sizeof(codebooks[0])] = (byte)(seed >> 16);
+	}
+
+	Common::MemoryWriteStreamDynamic vectors(DisposeAfterUse::YES);
+	const uint blocks = (kWidth / 4) * (kHeight / 4);
+	for (uint block = 0; block < blocks; block += 32) {
+		seed = seed * 1103515245 + 12345;
+		const uint32 flags = seed;
+		vectors.writeUint32BE(flags);
+		for (uint i = 0; i < 32 && block + i < blocks; ++i) {
+			for (uint j = 0; j < ((flags & (0x80000000u >> i)) ? 4u : 1u); ++j) {
+				seed = seed * 1103515245 + 12345;
+				vectors.writeByte((byte)(seed >> 16));
+			}
+		}
+	}
+
+	const uint32 stripSize = 12 + 2 * (4 + 256 * 6) + 4 + vectors.size();
+	frame.writeByte(1);
+	frame.writeByte((10 + stripSize) >> 16);
+	frame.writeUint16BE((10 + stripSize) & 0xFFFF);
+	frame.writeUint16BE(kWidth);
+	frame.writeUint16BE(kHeight);
+	frame.writeUint16BE(1);
+
+	frame.writeUint16BE(0x1000);
+	frame.writeUint16BE(stripSize);
+	frame.writeUint16BE(0);
+	frame.writeUint16BE(0);
+	frame.writeUint16BE(kHeight);
+	frame.writeUint16BE(kWidth);
+
+	writeChunkHeader(frame, 0x20, 256 * 6);
+	frame.write(codebooks[0], sizeof(codebooks[0]));
+	writeChunkHeader(frame, 0x22, 256 * 6);
+	frame.write(codebooks[1], sizeof(codebooks[1]));
+	writeChunkHeader(frame, 0x30, vectors.size());
+	frame.write(vectors.getData(), vectors.size());
+}
+
+void benchCinepak(State &state, int bitsPerPixel, const Graphics::PixelFormat *format) {
+	Common::MemoryWriteStreamDynamic frame(DisposeAfterUse::YES);
+	createCinepakFrame(frame);
+
+	Image::CinepakDecoder decoder(bitsPerPixel);
+	if (format)
+		decoder.setOutputPixelFormat(*format);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		Common::MemoryReadStream stream(frame.getData(), frame.size());
+		const Graphics::Surface *surface = decoder.decodeFrame(stream);
+		doNotOptimize(surface);
+	}
+
+	state.itemsProcessed = state.iterations * kWidth * kHeight;
+	state.bytesProcessed = state.iterations * frame.size();
+}
+
+void benchCinepakCLUT8(State &state) {
+	benchCinepak(state, 8, nullptr);
+}
+
+void benchCinepakRGB565(State &state) {
+	const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	benchCinepak(state, 24, &format);
+}
+
+void benchCinepakRGBA8888(State &state) {
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	benchCinepak(state, 24, &format);
+}
+
+enum {
+	kIndeoBlocks = 256,
+	kIndeoPitch = 8 * 16
+};
+
+void benchIndeoTransform(State &state, Image::Indeo::InvTransformPtr *transform) {
+	int32 *coeffs = new int32[kIndeoBlocks * 64];
+	int16 *out = new int16[8 * kIndeoPitch];
+	uint32 seed = 0x1b873593;
+	for (uint i = 0; i < kIndeoBlocks * 64; ++i) {
+		seed = seed * 1103515245 + 12345;
+		coeffs[i] = (int)((seed >> 8) % 512) - 256;
+	}
+	static const uint8 flags[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint block = 0; block < kIndeoBlocks; ++block)
+			transform(coeffs + block * 64, out + (block % 16) * 8, kIndeoPitch, flags);
+		doNotOptimize(out[0]);
+	}
+
+	delete[] coeffs;
+	delete[] out;
+	state.itemsProcessed = state.iterations * kIndeoBlocks;
+}
+
+void benchIndeoSlantC(State &state) {
+	benchIndeoTransform(state, Image::Indeo::IndeoDSP::ffIviInverseSlant8x8);
+}
+
+void benchIndeoSlantFast(State &state) {
+	benchIndeoTransform(state, Image::Indeo::IndeoDSP::getFastTransform(Image::Indeo::IndeoDSP::ffIviInverseSlant8x8));
+}
+
+void benchIndeoMC(State &state, Image::Indeo::IviMCFunc mc) {
+	int16 *ref = new int16[9 * kIndeoPitch];
+	int16 *buf = new int16[8 * kIndeoPitch];
+	for (uint i = 0; i < 9 * kIndeoPitch; ++i)
+		ref[i] = (int16)(i * 37 % 509);
+	memset(buf, 0, 8 * kIndeoPitch * sizeof(buf[0]));
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		// Cycle through all interpolation types
+		for (uint block = 0; block < kIndeoBlocks; ++block)
+			mc(buf + (block % 16) * 8, ref + (block % 15) * 8, kIndeoPitch, block & 3);
+		doNotOptimize(buf[0]);
+	}
+
+	delete[] ref;
+	delete[] buf;
+	state.itemsProcessed = state.iterations * kIndeoBlocks;
+}
+
+void benchIndeoMCC(State &state) {
+	benchIndeoMC(state, Image::Indeo::IndeoDSP::ffIviMc8x8Delta);
+}
+
+void benchIndeoMCFast(State &state) {
+	benchIndeoMC(state, Image::Indeo::IndeoDSP::getFastMC(Image::Indeo::IndeoDSP::ffIviMc8x8Delta));
+}
+
+} // End of anonymous namespace
+
+void addImageBenchmarks(BenchmarkList &list) {
+	static const Benchmark benchmarks[] = {
+		{ "Cinepak key frame -> CLUT8", benchCinepakCLUT8, nullptr },
+		{ "Cinepak key frame -> RGB565", benchCinepakRGB565, nullptr },
+		{ "Cinepak key frame -> RGBA8888", benchCinepakRGBA8888, nullptr },
+		{ "Indeo inverse slant 8x8 C", benchIndeoSlantC, nullptr },
+		{ "Indeo inverse slant 8x8 fast", benchIndeoSlantFast, nullptr },
+		{ "Indeo MC 8x8 delta C", benchIndeoMCC, nullptr },
+		{ "Indeo MC 8x8 delta fast", benchIndeoMCFast, nullptr },
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); ++i)
+		list.push_back(benchmarks[i]);
+}
+
+} // End of namespace Bench
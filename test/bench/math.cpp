@@ -0,0 +1,212 @@
+#include "test/bench/bench.h"
+
+#include "math/fft.h"
+#include "math/frustum.h"
+#include "math/matrix4.h"
+#include "math/mdct.h"
+#include "math/rdft.h"
+#include "math/utils.h"
+
+namespace Bench {
+
+namespace {
+
+enum {
+	kNumPoints = 4096,
+	kNumBoxes = 1024
+};
+
+Math::Matrix4 makeMatrix() {
+	Math::Matrix4 m(Math::Angle(30), Math::Angle(-45), Math::Angle(10), Math::EO_XYZ);
+	m.setPosition(Math::Vector3d(1, -2, 3));
+	return m;
+}
+
+void fillPoints(Math::Vector3d *points, uint count) {
+	uint32 seed = 0x12345678;
+	for (uint i = 0; i < count; ++i) {
+		float c[3];
+		for (int j = 0; j < 3; ++j) {
+			seed = seed * 1103515245 + 12345;
+			c[j] = ((int)((seed >> 8) & 0xFFFF) - 0x8000) / 256.0f;
+		}
+		points[i].set(c[0], c[1], c[2]);
+	}
+}
+
+void benchMatrix4Multiply(State &state) {
+	const Math::Matrix4 m = makeMatrix();
+	Math::Matrix4 r;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint k = 0; k < 1024; ++k)
+			r = m * r;
+		doNotOptimize(r.getData()[0]);
+	}
+	state.itemsProcessed = state.iterations * 1024;
+}
+
+void benchMatrix4Transform(State &state) {
+	const Math::Matrix4 m = makeMatrix();
+	Math::Vector3d *points = new Math::Vector3d[kNumPoints];
+	Math::Vector3d *out = new Math::Vector3d[kNumPoints];
+	fillPoints(points, kNumPoints);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint k = 0; k < kNumPoints; ++k) {
+			out[k] = points[k];
+			m.transform(&out[k], true);
+		}
+		doNotOptimize(out[kNumPoints - 1].x());
+	}
+
+	delete[] points;
+	delete[] out;
+	state.itemsProcessed = state.iterations * kNumPoints;
+}
+
+void benchMatrix4TransformPoints(State &state) {
+	const Math::Matrix4 m = makeMatrix();
+	Math::Vector3d *points = new Math::Vector3d[kNumPoints];
+	Math::Vector3d *out = new Math::Vector3d[kNumPoints];
+	fillPoints(points, kNumPoints);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		m.transformPoints(points, out, kNumPoints);
+		doNotOptimize(out[kNumPoints - 1].x());
+	}
+
+	delete[] points;
+	delete[] out;
+	state.itemsProcessed = state.iterations * kNumPoints;
+}
+
+void setupFrustum(Math::Frustum &frustum, Math::AABB *boxes) {
+	Math::Matrix4 proj;
+	proj.setValue(2, 2, -1.0f);
+	proj.setValue(2, 3, -0.2f);
+	proj.setValue(3, 2, -1.0f);
+	proj.setValue(3, 3, 0.0f);
+	frustum.setup(proj);
+
+	Math::Vector3d *centers = new Math::Vector3d[kNumBoxes];
+	fillPoints(centers, kNumBoxes);
+	for (uint i = 0; i < kNumBoxes; ++i)
+		boxes[i] = Math::AABB(centers[i] - Math::Vector3d(1, 1, 1), centers[i] + Math::Vector3d(1, 1, 1));
+	delete[] centers;
+}
+
+void benchFrustumIsInside(State &state) {
+	Math::Frustum frustum;
+	Math::AABB *boxes = new Math::AABB[kNumBoxes];
+	setupFrustum(frustum, boxes);
+
+	uint visible = 0;
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		for (uint k = 0; k < kNumBoxes; ++k)
+			visible += frustum.isInside(boxes[k]);
+	}
+	doNotOptimize(visible);
+
+	delete[] boxes;
+	state.itemsProcessed = state.iterations * kNumBoxes;
+}
+
+void benchFrustumIsInsideBatch(State &state) {
+	Math::Frustum frustum;
+	Math::AABB *boxes = new Math::AABB[kNumBoxes];
+	bool *inside = new bool[kNumBoxes];
+	setupFrustum(frustum, boxes);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		frustum.isInside(boxes, kNumBoxes, inside);
+		doNotOptimize(inside[kNumBoxes - 1]);
+	}
+
+	delete[] boxes;
+	delete[] inside;
+	state.itemsProcessed = state.iterations * kNumBoxes;
+}
+
+void fillSamples(float *samples, uint count) {
+	uint32 seed = 0x12345678;
+	for (uint i = 0; i < count; ++i) {
+		seed = seed * 1103515245 + 12345;
+		samples[i] = ((int)((seed >> 8) & 0xFFFF) - 0x8000) / 32768.0f;
+	}
+}
+
+void benchFFT(State &state) {
+	const int bits = 10;
+	Math::FFT fft(bits, 0);
+	Math::Complex *z = new Math::Complex[1 << bits];
+	fillSamples((float *)z, 2 << bits);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		fft.calc(z);
+		doNotOptimize(z[0].re);
+		// Keep the values from growing without bounds
+		for (int k = 0; k < (1 << bits); ++k) {
+			z[k].re *= 1.0f / 32;
+			z[k].im *= 1.0f / 32;
+		}
+	}
+
+	delete[] z;
+	state.itemsProcessed = state.iterations << bits;
+}
+
+void benchRDFT(State &state) {
+	const int bits = 10;
+	Math::RDFT rdft(bits, Math::RDFT::DFT_R2C);
+	float *input = new float[1 << bits];
+	float *data = new float[1 << bits];
+	fillSamples(input, 1 << bits);
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		memcpy(data, input, sizeof(float) << bits);
+		rdft.calc(data);
+		doNotOptimize(data[0]);
+	}
+
+	delete[] input;
+	delete[] data;
+	state.itemsProcessed = state.iterations << bits;
+}
+
+void benchIMDCT(State &state) {
+	// The transform size of WMA at 44.1 kHz
+	const int bits = 12;
+	Math::MDCT mdct(bits, true, 1.0);
+	float *input = new float[1 << (bits - 1)];
+	float *output = new float[1 << bits];
+	fillSamples(input, 1 << (bits - 1));
+
+	for (uint64 i = 0; i < state.iterations; ++i) {
+		mdct.calcIMDCT(output, input);
+		doNotOptimize(output[0]);
+	}
+
+	delete[] input;
+	delete[] output;
+	state.itemsProcessed = state.iterations << (bits - 1);
+}
+
+} // End of anonymous namespace
+
+void addMathBenchmarks(BenchmarkList &list) {
+	static const Benchmark benchmarks[] = {
+		{ "Matrix4::operator*", benchMatrix4Multiply, nullptr },
+		{ "Matrix4::transform", benchMatrix4Transform, nullptr },
+		{ "Matrix4::transformPoints", benchMatrix4TransformPoints, nullptr },
+		{ "Frustum::isInside", benchFrustumIsInside, nullptr },
+		{ "Frustum::isInside (batch)", benchFrustumIsInsideBatch, nullptr },
+		{ "FFT::calc (1024)", benchFFT, nullptr },
+		{ "RDFT::calc (1024)", benchRDFT, nullptr },
+		{ "MDCT::calcIMDCT (4096)", benchIMDCT, nullptr }
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); ++i)
+		list.push_back(benchmarks[i]);
+}
+
+} // End of namespace Bench
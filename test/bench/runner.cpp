@@ -0,0 +1,225 @@
+/*
+ * Microbenchmark runner for core primitives. Use the 'bench' target to
+ * build and run it. Every benchmark is calibrated until one measurement
+ * takes at least kMinRunTime; the results are printed as a table and,
+ * with --json=FILE, written in a machine readable form. --clips=DIR points
+ * to the reference clips of the audio decoder benchmarks.
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+#include "test/null_osystem.h"
+
+#include "common/str.h"
+#include "common/system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GLIBC__)
+#define BENCH_COUNT_ALLOCATIONS 1
+#else
+#include <new>
+#endif
+
+namespace {
+
+const uint64 kMinRunTime = 200 * 1000;
+const uint64 kMaxIterations = 1ULL << 40;
+
+volatile uint64 allocationCount = 0;
+
+} // End of anonymous namespace
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+// glibc lets the executable interpose the allocator entry points and
+// exports the real implementations, so every allocation is counted,
+// including the ones made through operator new.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t nmemb, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+	allocationCount = allocationCount + 1;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+	allocationCount = allocationCount + 1;
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+	allocationCount = allocationCount + 1;
+	return __libc_realloc(ptr, size);
+}
+}
+#else
+// Only allocations made through operator new are counted here.
+void *operator new(size_t size) {
+	allocationCount = allocationCount + 1;
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	free(ptr);
+}
+#endif
+
+namespace {
+
+struct Result {
+	const char *name;
+	uint64 iterations;
+	double nsPerIteration;
+	double itemsPerSecond;
+	double bytesPerSecond;
+	double allocationsPerIteration;
+	double realTimeFactor;
+};
+
+Result runBenchmark(const Bench::Benchmark &benchmark) {
+	Bench::State state;
+	uint64 elapsed = 0;
+	uint64 allocations = 0;
+	uint64 iterations = 1;
+
+	for (;;) {
+		state = Bench::State();
+		state.arg = benchmark.arg;
+		state.iterations = iterations;
+
+		const uint64 allocationsBefore = allocationCount;
+		const uint64 start = g_system->getMicros();
+		benchmark.proc(state);
+		elapsed = g_system->getMicros() - start;
+		allocations = allocationCount - allocationsBefore;
+
+		if (elapsed >= kMinRunTime || iterations >= kMaxIterations)
+			break;
+
+		// Aim a bit over the minimum run time, but never grow more than
+		// tenfold per round in case the first rounds were too short to
+		// tell anything.
+		uint64 next = elapsed ? iterations * kMinRunTime * 14 / (elapsed * 10) : iterations * 10;
+		next = MIN<uint64>(next, iterations * 10);
+		iterations = MAX<uint64>(next, iterations + 1);
+	}
+
+	Result result;
+	result.name = benchmark.name;
+	result.iterations = iterations;
+	result.nsPerIteration = elapsed * 1000.0 / iterations;
+	result.itemsPerSecond = elapsed ? state.itemsProcessed * 1000000.0 / elapsed : 0.0;
+	result.bytesPerSecond = elapsed ? state.bytesProcessed * 1000000.0 / elapsed : 0.0;
+	result.allocationsPerIteration = (double)allocations / iterations;
+	result.realTimeFactor = state.realTimeItemsPerSecond ? result.itemsPerSecond / state.realTimeItemsPerSecond : 0.0;
+	return result;
+}
+
+void writeJsonString(FILE *file, const char *str) {
+	fputc('"', file);
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\')
+			fputc('\\', file);
+		fputc(*str, file);
+	}
+	fputc('"', file);
+}
+
+bool writeJson(const char *filename, const Common::Array<Result> &results) {
+	FILE *file = fopen(filename, "w");
+	if (!file)
+		return false;
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+	fprintf(file, "{\n\t\"allocation_counter\": \"malloc\",\n\t\"benchmarks\": [");
+#else
+	fprintf(file, "{\n\t\"allocation_counter\": \"operator new\",\n\t\"benchmarks\": [");
+#endif
+	for (uint i = 0; i < results.size(); ++i) {
+		const Result &r = results[i];
+		fprintf(file, "%s\n\t\t{\"name\": ", i ? "," : "");
+		writeJsonString(file, r.name);
+		fprintf(file, ", \"iterations\": %llu, \"ns_per_iteration\": %.3f, \"items_per_second\": %.1f, \"bytes_per_second\": %.1f, \"allocations_per_iteration\": %.3f",
+		        (unsigned long long)r.iterations, r.nsPerIteration, r.itemsPerSecond, r.bytesPerSecond, r.allocationsPerIteration);
+		if (r.realTimeFactor)
+			fprintf(file, ", \"realtime_factor\": %.2f", r.realTimeFactor);
+		fputc('}', file);
+	}
+	fprintf(file, "\n\t]\n}\n");
+
+	return fclose(file) == 0;
+}
+
+} // End of anonymous namespace
+
+int main(int argc, char *argv[]) {
+	const char *jsonFile = nullptr;
+	const char *filter = nullptr;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strncmp(argv[i], "--json=", 7)) {
+			jsonFile = argv[i] + 7;
+		} else if (!strncmp(argv[i], "--clips=", 8)) {
+			Bench::setAudioClipDirectory(argv[i] + 8);
+		} else if (!strcmp(argv[i], "--help")) {
+			printf("Usage: %s [--json=FILE] [--clips=DIR] [FILTER]\n", argv[0]);
+			return 0;
+		} else {
+			filter = argv[i];
+		}
+	}
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+	Common::install_null_g_system();
+#else
+	fprintf(stderr, "The benchmarks need the null OSystem for timing\n");
+	return 1;
+#endif
+
+	Bench::BenchmarkList benchmarks;
+	Bench::addCommonBenchmarks(benchmarks);
+	Bench::addGraphicsBenchmarks(benchmarks);
+	Bench::addAudioBenchmarks(benchmarks);
+	Bench::addAudioDecoderBenchmarks(benchmarks);
+	Bench::addImageBenchmarks(benchmarks);
+	Bench::addMathBenchmarks(benchmarks);
+
+	Common::Array<Result> results;
+	printf("%-40s %12s %14s %12s %12s %10s\n", "Benchmark", "ns/iter", "items/s", "MB/s", "allocs/iter", "x realtime");
+	for (uint i = 0; i < benchmarks.size(); ++i) {
+		if (filter && !Common::String(benchmarks[i].name).contains(filter))
+			continue;
+
+		Result r = runBenchmark(benchmarks[i]);
+		results.push_back(r);
+		printf("%-40s %12.1f %14.0f %12.2f %12.2f", r.name, r.nsPerIteration, r.itemsPerSecond,
+		       r.bytesPerSecond / (1024.0 * 1024.0), r.allocationsPerIteration);
+		if (r.realTimeFactor)
+			printf(" %10.1f", r.realTimeFactor);
+		printf("\n");
+		fflush(stdout);
+	}
+
+	if (jsonFile && !writeJson(jsonFile, results)) {
+		fprintf(stderr, "Could not write '%s'\n", jsonFile);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_alignment_and_growth() {
+		Common::Arena arena(64);
+
+		byte *a = (byte *)arena.allocate(3, 1);
+		uint32 *b = arena.allocateArray<uint32>(4);
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS((size_t)b % alignof(uint32), 0u);
+
+		// Larger than the block size, needs a new block
+		byte *big = (byte *)arena.allocate(1000);
+		TS_ASSERT(big);
+		memset(big, 0xAA, 1000);
+
+		b[3] = 0x12345678;
+		TS_ASSERT_EQUALS(b[3], 0x12345678u);
+		TS_ASSERT(arena.getUsedSize() >= 1000 + 16 + 3);
+	}
+
+	void test_marker_rewind() {
+		Common::Arena arena(64);
+		arena.allocate(16);
+		Common::Arena::Marker marker = arena.getMarker();
+		const size_t used = arena.getUsedSize();
+
+		for (int i = 0; i < 100; ++i)
+			arena.allocate(32);
+		TS_ASSERT(arena.getUsedSize() > used);
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), used);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0u);
+
+		// After a reset the merged block fits everything in one go
+		for (int i = 0; i < 100; ++i)
+			arena.allocate(32);
+		arena.reset();
+		void *first = arena.allocate(16);
+		for (int i = 0; i < 100; ++i)
+			arena.allocate(32);
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.allocate(16), first);
+	}
+
+	void test_frame_arena() {
+		Common::FrameArena frames(256);
+
+		int *previous = frames.allocateArray<int>(4);
+		previous[0] = 42;
+		frames.nextFrame();
+
+		int *current = frames.allocateArray<int>(4);
+		current[0] = 7;
+		TS_ASSERT_DIFFERS(previous, current);
+		// Data of the previous frame is still valid
+		TS_ASSERT_EQUALS(previous[0], 42);
+
+		frames.nextFrame();
+		// The arena of the previous frame is reused
+		TS_ASSERT_EQUALS(frames.allocateArray<int>(4), previous);
+	}
+
+	void test_allocator_adapter() {
+		Common::Arena arena;
+		Common::ArenaAllocator<int> alloc(arena);
+		Common::ArenaAllocator<char> other(alloc);
+		TS_ASSERT(alloc == other);
+
+		int *p = alloc.allocate(10);
+		p[9] = 3;
+		alloc.deallocate(p, 10);
+		TS_ASSERT(arena.getUsedSize() >= 10 * sizeof(int));
+	}
+};
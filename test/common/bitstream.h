@@ -255,4 +255,53 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+
+private:
+	/*
+	 * The memory bit streams fill their container with 64-bit loads.
+	 * Check that they hand out the same bits as the generic streams,
+	 * for reads of all widths and across the end of the data.
+	 */
+	template<class GBS, class MBS>
+	void tmpl_memory_matches_stream() {
+		byte contents[61];
+		for (uint i = 0; i < sizeof(contents); i++)
+			contents[i] = (byte)(i * 167 + 13);
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::BitStreamMemoryStream bms(contents, sizeof(contents));
+
+		GBS gbs(ms);
+		MBS mbs(bms);
+		TS_ASSERT_EQUALS(gbs.size(), mbs.size());
+
+		uint n = 0;
+		while (mbs.pos() + 32 <= mbs.size() + 32) {
+			n = (n * 7 + 3) % 33;
+			TS_ASSERT_EQUALS(gbs.peekBits(32), mbs.peekBits(32));
+			TS_ASSERT_EQUALS(gbs.getBits(n), mbs.getBits(n));
+			TS_ASSERT_EQUALS(gbs.pos(), mbs.pos());
+			if (n == 0)
+				TS_ASSERT_EQUALS(gbs.getBit(), mbs.getBit());
+		}
+
+		gbs.rewind();
+		mbs.rewind();
+		mbs.skip(100);
+		gbs.skip(100);
+		TS_ASSERT_EQUALS(gbs.getBits(17), mbs.getBits(17));
+	}
+public:
+	void test_memory_matches_stream() {
+		tmpl_memory_matches_stream<Common::BitStream8MSB, Common::BitStreamMemory8MSB>();
+		tmpl_memory_matches_stream<Common::BitStream8LSB, Common::BitStreamMemory8LSB>();
+		tmpl_memory_matches_stream<Common::BitStream16LEMSB, Common::BitStreamMemory16LEMSB>();
+		tmpl_memory_matches_stream<Common::BitStream16LELSB, Common::BitStreamMemory16LELSB>();
+		tmpl_memory_matches_stream<Common::BitStream16BEMSB, Common::BitStreamMemory16BEMSB>();
+		tmpl_memory_matches_stream<Common::BitStream16BELSB, Common::BitStreamMemory16BELSB>();
+		tmpl_memory_matches_stream<Common::BitStream32LEMSB, Common::BitStreamMemory32LEMSB>();
+		tmpl_memory_matches_stream<Common::BitStream32LELSB, Common::BitStreamMemory32LELSB>();
+		tmpl_memory_matches_stream<Common::BitStream32BEMSB, Common::BitStreamMemory32BEMSB>();
+		tmpl_memory_matches_stream<Common::BitStream32BELSB, Common::BitStreamMemory32BELSB>();
+	}
 };
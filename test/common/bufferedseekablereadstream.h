@@ -3,6 +3,8 @@
 #include "common/memstream.h"
 #include "common/bufferedstream.h"
 
+#include "../null_osystem.h"
+
 class BufferedSeekableReadStreamTestSuite : public CxxTest::TestSuite {
 	public:
 	void test_traverse() {
@@ -91,4 +93,44 @@ class BufferedSeekableReadStreamTestSuite : public CxxTest::TestSuite {
 
 		delete &ssrs;
 	}
+
+	void test_prefetching_traverse() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		byte contents[100];
+		for (int i = 0; i < 100; ++i)
+			contents[i] = i;
+		Common::MemoryReadStream ms(contents, 100);
+
+		Common::PrefetchingSeekableReadStream *ssrs
+			= Common::wrapPrefetchingSeekableReadStream(&ms, 8, 3, DisposeAfterUse::NO);
+		TS_ASSERT_EQUALS(ssrs->size(), 100);
+
+		byte b[7];
+		for (int i = 0; i < 98; i += 7) {
+			TS_ASSERT_EQUALS(ssrs->pos(), i);
+			TS_ASSERT_EQUALS(ssrs->read(b, 7), 7u);
+			for (int j = 0; j < 7; ++j)
+				TS_ASSERT_EQUALS(b[j], i + j);
+		}
+		TS_ASSERT(!ssrs->eos());
+
+		TS_ASSERT_EQUALS(ssrs->read(b, 7), 2u);
+		TS_ASSERT_EQUALS(b[1], 99);
+		TS_ASSERT(ssrs->eos());
+		TS_ASSERT(ssrs->getHits() > 0);
+
+		ssrs->hintSeek(50);
+		ssrs->seek(-50, SEEK_END);
+		TS_ASSERT(!ssrs->eos());
+		TS_ASSERT_EQUALS(ssrs->readByte(), 50);
+		ssrs->seek(-11, SEEK_CUR);
+		TS_ASSERT_EQUALS(ssrs->readByte(), 40);
+		ssrs->seek(3, SEEK_SET);
+		TS_ASSERT_EQUALS(ssrs->readByte(), 3);
+
+		delete ssrs;
+#endif
+	}
 };
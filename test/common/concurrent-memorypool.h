@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/concurrent-memorypool.h"
+#include "common/str.h"
+
+class ConcurrentMemoryPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void test_chunks_are_distinct() {
+		Common::ConcurrentMemoryPool pool(sizeof(int), 8);
+		TS_ASSERT_EQUALS(pool.getChunkSize(), sizeof(void *));
+
+		int *chunks[100];
+		for (int i = 0; i < 100; ++i) {
+			chunks[i] = (int *)pool.allocChunk();
+			*chunks[i] = i;
+		}
+		for (int i = 0; i < 100; ++i)
+			TS_ASSERT_EQUALS(*chunks[i], i);
+
+		for (int i = 0; i < 100; ++i)
+			pool.freeChunk(chunks[i]);
+	}
+
+	void test_batches() {
+		Common::ConcurrentMemoryPool pool(16, 32);
+
+		void *chunks[100];
+		for (int i = 0; i < 100; ++i)
+			chunks[i] = pool.allocChunk();
+		Common::ConcurrentMemoryPool::Stats stats = pool.getStats();
+		TS_ASSERT_EQUALS(stats.refills, 4u);
+		TS_ASSERT_EQUALS(stats.returns, 0u);
+
+		// The cache holds 28 chunks, and hands back a batch each time it
+		// reaches 64 chunks
+		for (int i = 0; i < 100; ++i)
+			pool.freeChunk(chunks[i]);
+		stats = pool.getStats();
+		TS_ASSERT_EQUALS(stats.refills, 4u);
+		TS_ASSERT_EQUALS(stats.returns, 3u);
+		TS_ASSERT_EQUALS(stats.crossThreadFrees, 0u);
+
+		// Reuses the cached chunks
+		for (int i = 0; i < 32; ++i)
+			chunks[i] = pool.allocChunk();
+		TS_ASSERT_EQUALS(pool.getStats().refills, 4u);
+		for (int i = 0; i < 32; ++i)
+			pool.freeChunk(chunks[i]);
+	}
+
+	void test_more_pools_than_cache_slots() {
+		enum { kNumPools = 20, kNumChunks = 10 };
+		Common::ConcurrentMemoryPool *pools[kNumPools];
+		uint32 *chunks[kNumPools][kNumChunks];
+		for (int p = 0; p < kNumPools; ++p)
+			pools[p] = new Common::ConcurrentMemoryPool(sizeof(uint32), 4);
+
+		// Interleave the pools, so the thread keeps evicting its caches
+		for (int round = 0; round < 3; ++round) {
+			for (int c = 0; c < kNumChunks; ++c) {
+				for (int p = 0; p < kNumPools; ++p) {
+					chunks[p][c] = (uint32 *)pools[p]->allocChunk();
+					*chunks[p][c] = p * 1000 + c;
+				}
+			}
+			for (int c = 0; c < kNumChunks; ++c) {
+				for (int p = 0; p < kNumPools; ++p) {
+					TS_ASSERT_EQUALS(*chunks[p][c], (uint32)(p * 1000 + c));
+					pools[p]->freeChunk(chunks[p][c]);
+				}
+			}
+		}
+
+		for (int p = 0; p < kNumPools; ++p)
+			delete pools[p];
+
+		// A new pool must not pick up a cache left behind by a deleted one
+		Common::ConcurrentMemoryPool pool(sizeof(uint32), 4);
+		void *chunk = pool.allocChunk();
+		TS_ASSERT_EQUALS(pool.getStats().refills, 1u);
+		pool.freeChunk(chunk);
+	}
+
+	void test_string_ref_counts() {
+		Common::String a("This string is long enough to need external storage");
+		Common::String b(a);
+		Common::String c(b);
+		TS_ASSERT_EQUALS(a, c);
+		b = "short";
+		TS_ASSERT_EQUALS(a, c);
+		TS_ASSERT_EQUALS(b, "short");
+	}
+};
@@ -271,4 +271,28 @@ public:
 		result = Common::U32String((const char *) utf8_2, sizeof(utf8_2)-1, Common::kUtf8).encode(Common::kISO8859_2);
 		TS_ASSERT_EQUALS(memcmp(result.c_str(), iso_8859_2, sizeof(iso_8859_2)), 0);
 	}
+
+	void test_long_ascii_runs() {
+		// Long enough for the block tests, with non-ASCII characters
+		// inside the blocks and at the end.
+		const char *utf8 = "The quick brown fox jumps over the lazy \xC3\xB6 dog, then the qui\xC4\x8Dk brown fox jumps \xE2\x80\x94 again\xF0\x9F\x98\x80";
+		const char *latin2 = "The quick brown fox jumps over the lazy \xF6 dog, then the qui\xE8k brown fox jumps ? again";
+
+		Common::U32String str(utf8, Common::kUtf8);
+		TS_ASSERT_EQUALS(str.size(), 86u);
+		TS_ASSERT_EQUALS(str[40], (Common::u32char_type_t)0xF6);
+		TS_ASSERT_EQUALS(str[85], (Common::u32char_type_t)0x1F600);
+
+		TS_ASSERT_EQUALS(str.encode(Common::kUtf8), Common::String(utf8));
+		TS_ASSERT_EQUALS(Common::U32String(str.c_str(), 85).encode(Common::kISO8859_2), Common::String(latin2));
+
+		Common::U32String back(latin2, Common::kISO8859_2);
+		TS_ASSERT_EQUALS(back.size(), 85u);
+		TS_ASSERT_EQUALS(back[40], (Common::u32char_type_t)0xF6);
+		TS_ASSERT_EQUALS(back[59], (Common::u32char_type_t)0x10D);
+
+		// A truncated sequence ends the string.
+		Common::U32String truncated("0123456789abcdefghij\xE2\x80", Common::kUtf8);
+		TS_ASSERT_EQUALS(truncated, Common::U32String("0123456789abcdefghij"));
+	}
 };
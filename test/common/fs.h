@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "../null_osystem.h"
+
+class FSNodeTestSuite : public CxxTest::TestSuite {
+public:
+	void test_mapped_read_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Copied there by the copy-dat target
+		Common::FSNode node("test/engine-data/encoding.dat");
+		TS_ASSERT(node.exists());
+
+		Common::SeekableReadStream *file = node.createReadStream();
+		Common::MemoryReadStream *mapped = node.createMappedReadStream();
+		TS_ASSERT(file);
+		TS_ASSERT(mapped);
+		TS_ASSERT_EQUALS(file->size(), mapped->size());
+
+		byte buffer[256];
+		const uint32 len = file->read(buffer, sizeof(buffer));
+		TS_ASSERT(len > 0);
+		TS_ASSERT_EQUALS(memcmp(buffer, mapped->getData(), len), 0);
+
+		// The stream interface reads the same data
+		mapped->seek(4);
+		TS_ASSERT_EQUALS(mapped->readByte(), buffer[4]);
+
+		delete mapped;
+		delete file;
+
+		Common::FSNode missing("test/engine-data/does-not-exist");
+		TS_ASSERT(!missing.createMappedReadStream());
+#endif
+	}
+
+	void test_file_stats() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode node("test/engine-data/encoding.dat");
+		Common::SeekableReadStream *file = node.createReadStream();
+		TS_ASSERT(file);
+
+		int64 size = -1, modificationTime = -1;
+		TS_ASSERT(node.getFileStats(size, modificationTime));
+		TS_ASSERT_EQUALS(size, file->size());
+		TS_ASSERT(modificationTime > 0);
+		delete file;
+
+		// Only regular files have stats
+		TS_ASSERT(!Common::FSNode("test/engine-data").getFileStats(size, modificationTime));
+		TS_ASSERT(!Common::FSNode("test/engine-data/does-not-exist").getFileStats(size, modificationTime));
+#endif
+	}
+};
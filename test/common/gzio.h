@@ -0,0 +1,54 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/compression/gzio.h"
+#include "common/compression/zlib.h"
+
+class GzioTestSuite : public CxxTest::TestSuite {
+public:
+	void test_random_access() {
+#ifdef USE_ZLIB
+		// Big enough to get seek points, compressible enough for back references
+		const uint32 size = 3 * 1024 * 1024 + 1234;
+		byte *original = new byte[size];
+		uint32 seed = 1;
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			original[i] = (i % 1000 < 300) ? (byte)(seed >> 24) : (byte)('a' + (i % 17));
+		}
+
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(compressed);
+		gzip->write(original, size);
+		gzip->finalize();
+		byte *data = compressed->getData();
+		uint32 dataSize = compressed->size();
+		delete gzip;
+
+		// Skip the gzip header to get at the raw deflate data
+		Common::ScopedPtr<Common::GzioReadStream> gzio(Common::GzioReadStream::openDeflate(
+			new Common::MemoryReadStream(data + 10, dataSize - 10), size, DisposeAfterUse::YES));
+
+		byte *buffer = new byte[size];
+		TS_ASSERT_EQUALS(gzio->read(buffer, size), size);
+		TS_ASSERT_EQUALS(memcmp(buffer, original, size), 0);
+
+		// Backwards and forwards, across and into windows and blocks
+		static const uint32 offsets[] = {
+			2 * 1024 * 1024 + 77, 12, 1024 * 1024 + 5000, 3 * 1024 * 1024,
+			1024 * 1024 - 1, 2 * 1024 * 1024 + 100000, 40000, 3 * 1024 * 1024 + 1000
+		};
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			const uint32 len = MIN<uint32>(70000, size - offsets[i]);
+			TS_ASSERT(gzio->seek(offsets[i]));
+			TS_ASSERT_EQUALS(gzio->read(buffer, len), len);
+			TS_ASSERT_EQUALS(memcmp(buffer, original + offsets[i], len), 0);
+		}
+
+		delete[] buffer;
+		free(data);
+		delete[] original;
+#endif
+	}
+};
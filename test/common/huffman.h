@@ -94,4 +94,69 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	/*
+	 * Codes longer than the first-level lookup table are resolved
+	 * through the second-level tables. Use a skewed tree with code
+	 * lengths 1..15 (k-1 one bits followed by a zero bit, plus the
+	 * all-ones code of length 15) and check both bit orders.
+	 */
+	template<class BITSTREAM>
+	void check_long_codes() {
+		const uint32 codeCount = 16;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+		uint32 symbols[codeCount];
+
+		for (uint32 i = 0; i < codeCount; i++) {
+			lengths[i] = MIN<uint32>(i + 1, 15);
+			symbols[i] = 0x100 + i;
+
+			// The code as read from the stream, bit by bit
+			uint32 ones = (i < 15) ? i : 15;
+			codes[i] = 0;
+			for (uint32 b = 0; b < lengths[i]; b++) {
+				uint32 bit = (b < ones) ? 1 : 0;
+				if (BITSTREAM::isMSB2LSB())
+					codes[i] = (codes[i] << 1) | bit;
+				else
+					codes[i] |= bit << b;
+			}
+		}
+
+		Common::Huffman<BITSTREAM> h(0, codeCount, codes, lengths, symbols);
+
+		const uint32 sequence[] = {15, 0, 14, 7, 1, 9, 13, 2, 8, 12, 3, 15, 10, 11, 6, 5, 4};
+
+		byte input[32];
+		memset(input, 0, sizeof(input));
+
+		uint32 pos = 0;
+		for (uint32 i = 0; i < ARRAYSIZE(sequence); i++) {
+			uint32 code = sequence[i];
+			for (uint32 b = 0; b < lengths[code]; b++, pos++) {
+				uint32 bit = BITSTREAM::isMSB2LSB() ? (codes[code] >> (lengths[code] - 1 - b)) & 1 : (codes[code] >> b) & 1;
+				if (BITSTREAM::isMSB2LSB())
+					input[pos / 8] |= bit << (7 - (pos % 8));
+				else
+					input[pos / 8] |= bit << (pos % 8);
+			}
+		}
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		BITSTREAM bs(ms);
+
+		for (uint32 i = 0; i < ARRAYSIZE(sequence); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), symbols[sequence[i]]);
+
+		TS_ASSERT_EQUALS(bs.pos(), pos);
+	}
+
+	void test_get_long_codes_msb() {
+		check_long_codes<Common::BitStream8MSB>();
+	}
+
+	void test_get_long_codes_lsb() {
+		check_long_codes<Common::BitStream8LSB>();
+	}
 };
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/macresman.h"
+#include "common/memstream.h"
+
+namespace {
+
+// A raw resource fork with one TEXT type holding two resources
+static const byte kRawFork[] = {
+	// Header: data offset, map offset, data length, map length
+	0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x1F,
+	0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x44,
+	// Data
+	0x00, 0x00, 0x00, 0x03, 'a', 'b', 'c',
+	0x00, 0x00, 0x00, 0x04, 'x', 'y', 'z', '!',
+	// Map header copy, handle and file reference
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0,
+	// Attributes, type list offset, name list offset, number of types - 1
+	0x00, 0x00, 0x00, 0x1C, 0x00, 0x3E, 0x00, 0x00,
+	// Type list
+	'T', 'E', 'X', 'T', 0x00, 0x01, 0x00, 0x0A,
+	// Reference list
+	0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x81, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00,
+	// Name list
+	0x05, 'H', 'e', 'l', 'l', 'o'
+};
+
+class ForkArchive : public Common::Archive {
+public:
+	bool hasFile(const Common::Path &path) const override {
+		return path.toString() == "test.rsrc";
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember("test.rsrc", this)));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path.toString(), this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream(kRawFork, sizeof(kRawFork));
+	}
+};
+
+} // End of anonymous namespace
+
+class MacResManagerTestSuite : public CxxTest::TestSuite {
+public:
+	void checkFork(Common::MacResManager &resMan) {
+		TS_ASSERT(resMan.hasResFork());
+		TS_ASSERT_EQUALS(resMan.getResIDArray(MKTAG('T', 'E', 'X', 'T')).size(), 2u);
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'X', 'T'), 128), "Hello");
+
+		Common::SeekableReadStream *res = resMan.getResource(MKTAG('T', 'E', 'X', 'T'), 129);
+		TS_ASSERT(res);
+		if (res) {
+			TS_ASSERT_EQUALS(res->size(), 4);
+			TS_ASSERT_EQUALS(res->readUint32BE(), MKTAG('x', 'y', 'z', '!'));
+			delete res;
+		}
+
+		res = resMan.getResource("hello");
+		TS_ASSERT(res);
+		if (res) {
+			TS_ASSERT_EQUALS(res->size(), 3);
+			delete res;
+		}
+	}
+
+	void test_shared_map() {
+		ForkArchive archive;
+
+		Common::MacResManager first;
+		TS_ASSERT(first.open("test", archive));
+		checkFork(first);
+
+		// The second instance shares the parsed map of the first one
+		Common::MacResManager second;
+		TS_ASSERT(second.open("test", archive));
+		first.close();
+		checkFork(second);
+
+		// Maps in use are kept
+		Common::MacResManager::clearMapCache();
+		checkFork(second);
+		second.close();
+
+		Common::MacResManager::clearMapCache();
+		TS_ASSERT(first.open("test", archive));
+		checkFork(first);
+		first.close();
+		Common::MacResManager::clearMapCache();
+	}
+};
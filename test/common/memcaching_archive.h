@@ -0,0 +1,76 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/stream.h"
+
+namespace {
+
+class CountingMemcachingArchive : public Common::MemcachingCaseInsensitiveArchive {
+public:
+	mutable int _reads;
+
+	CountingMemcachingArchive(uint32 maxRecentlyUsedSize) : Common::MemcachingCaseInsensitiveArchive(16, maxRecentlyUsedSize), _reads(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		return path.toString().hasPrefix("file");
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		return 0;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path.toString(), this));
+	}
+
+	Common::SharedArchiveContents readContentsForPath(const Common::String &name) const override {
+		if (!name.hasPrefix("file"))
+			return Common::SharedArchiveContents();
+
+		_reads++;
+		const uint32 size = 100;
+		byte *data = new byte[size];
+		memset(data, name.lastChar(), size);
+		return Common::SharedArchiveContents(data, size);
+	}
+
+	void open(const char *name) const {
+		Common::SeekableReadStream *stream = createReadStreamForMember(name);
+		TS_ASSERT(stream);
+		if (stream) {
+			TS_ASSERT_EQUALS(stream->size(), 100);
+			TS_ASSERT_EQUALS(stream->readByte(), (byte)name[strlen(name) - 1]);
+		}
+		delete stream;
+	}
+};
+
+} // End of anonymous namespace
+
+class MemcachingArchiveTestSuite : public CxxTest::TestSuite {
+public:
+	void test_weak_cache() {
+		CountingMemcachingArchive archive(0);
+		archive.open("file1");
+		archive.open("file1");
+		TS_ASSERT_EQUALS(archive._reads, 2);
+		TS_ASSERT(!archive.createReadStreamForMember("missing"));
+	}
+
+	void test_recently_used() {
+		CountingMemcachingArchive archive(250);
+		archive.open("file1");
+		archive.open("file2");
+		archive.open("file1");
+		archive.open("file2");
+		TS_ASSERT_EQUALS(archive._reads, 2);
+
+		// file3 pushes out file1, which was used least recently
+		archive.open("file3");
+		TS_ASSERT_EQUALS(archive._reads, 3);
+		archive.open("file2");
+		TS_ASSERT_EQUALS(archive._reads, 3);
+		archive.open("file1");
+		TS_ASSERT_EQUALS(archive._reads, 4);
+	}
+};
@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+#include "common/memorypool.h"
+#include "common/memtag.h"
+
+class MemTagTestSuite : public CxxTest::TestSuite {
+public:
+	void test_counters() {
+		const Common::MemTagStats before = Common::getMemTagStats(Common::kMemTagEngine);
+
+		Common::memTagAllocated(Common::kMemTagEngine, 1000);
+		Common::memTagAllocated(Common::kMemTagEngine, 24);
+		Common::memTagFreed(Common::kMemTagEngine, 1000);
+
+		const Common::MemTagStats after = Common::getMemTagStats(Common::kMemTagEngine);
+		TS_ASSERT_EQUALS(after.currentBytes, before.currentBytes + 24);
+		TS_ASSERT_EQUALS(after.currentAllocations, before.currentAllocations + 1);
+		TS_ASSERT_EQUALS(after.totalAllocations, before.totalAllocations + 2);
+		TS_ASSERT(after.peakBytes >= before.currentBytes + 1024);
+
+		Common::memTagFreed(Common::kMemTagEngine, 24);
+		Common::resetMemTagPeaks();
+		TS_ASSERT_EQUALS(Common::getMemTagStats(Common::kMemTagEngine).peakBytes, before.currentBytes);
+	}
+
+	void test_scopes() {
+		const uint64 before = Common::getMemTagStats(Common::kMemTagScripts).currentBytes;
+
+		TS_ASSERT_EQUALS(Common::MemTag::current(Common::kMemTagPools), Common::kMemTagPools);
+		{
+			Common::MemTag scope(Common::kMemTagScripts);
+			TS_ASSERT_EQUALS(Common::MemTag::current(Common::kMemTagPools), Common::kMemTagScripts);
+			{
+				Common::MemTag inner(Common::kMemTagAudio);
+				TS_ASSERT_EQUALS(Common::MemTag::current(Common::kMemTagPools), Common::kMemTagAudio);
+			}
+
+			Common::Arena arena(256);
+			arena.allocate(16);
+			TS_ASSERT(Common::getMemTagStats(Common::kMemTagScripts).currentBytes >= before + 256);
+
+			Common::MemoryPool pool(32);
+			pool.freeChunk(pool.allocChunk());
+			TS_ASSERT(Common::getMemTagStats(Common::kMemTagScripts).currentBytes >= before + 256 + 32);
+		}
+		TS_ASSERT_EQUALS(Common::MemTag::current(Common::kMemTagPools), Common::kMemTagPools);
+
+		// The arena and the pool have been destroyed
+		TS_ASSERT_EQUALS(Common::getMemTagStats(Common::kMemTagScripts).currentBytes, before);
+	}
+};
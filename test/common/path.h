@@ -66,4 +66,35 @@ class PathTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(p2.getParent().toString('#'), "par#nt/dir/fil#");
 		TS_ASSERT_EQUALS(p2.getParent().getParent().toString('#'), "par#");
 	}
+
+	void test_hashes() {
+		Common::Path::IgnoreCaseAndMac_Hash hash;
+		Common::Path::IgnoreCaseAndMac_EqualsTo equals;
+
+		Common::Path p("Parent/Dir/File.TXT");
+		Common::Path p2(TEST_PATH);
+		TS_ASSERT(equals(p, p2));
+		TS_ASSERT_EQUALS(hash(p), hash(p2));
+		TS_ASSERT(p != p2);
+
+		// The cached keys must follow modifications of the path
+		p.joinInPlace("other.txt");
+		TS_ASSERT(!equals(p, p2));
+		p2.joinInPlace("OTHER.txt");
+		TS_ASSERT(equals(p, p2));
+		TS_ASSERT_EQUALS(hash(p), hash(p2));
+
+		Common::Path p3(p2);
+		TS_ASSERT_EQUALS(hash(p3), hash(p2));
+		TS_ASSERT(p3 == p2);
+		p3 = "parent/dir";
+		TS_ASSERT(!equals(p3, p2));
+		TS_ASSERT_EQUALS(Common::Path::Hash()(p3), Common::Path::Hash()(Common::Path("parent/dir")));
+
+		// Slashes inside components go through the identifier string
+		Common::Path mac1("Sound Manager 3.1 / SoundLib|Sound", '|');
+		Common::Path mac2("Sound Manager 3.1 : SoundLib/sound");
+		TS_ASSERT(equals(mac1, mac2));
+		TS_ASSERT_EQUALS(hash(mac1), hash(mac2));
+	}
 };
@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+
+#include "../null_osystem.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_ring_buffer() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.setCapacity(4);
+		TS_ASSERT_EQUALS(profiler.getCapacity(), 4u);
+		TS_ASSERT_EQUALS(profiler.getEventCount(), 0u);
+
+		for (uint i = 0; i < 6; ++i)
+			profiler.record("zone", i * 10, i * 10 + i);
+
+		// Only the four most recent events are kept, oldest first.
+		TS_ASSERT_EQUALS(profiler.getEventCount(), 4u);
+		TS_ASSERT_EQUALS(profiler.getEvent(0).start, 20u);
+		TS_ASSERT_EQUALS(profiler.getEvent(0).duration, 2u);
+		TS_ASSERT_EQUALS(profiler.getEvent(3).start, 50u);
+
+		profiler.clear();
+		TS_ASSERT_EQUALS(profiler.getEventCount(), 0u);
+#endif
+	}
+
+	void test_statistics() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.setCapacity(16);
+		profiler.record("short", 0, 5);
+		profiler.record("long", 10, 110);
+		profiler.record("short", 200, 203);
+
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getStatistics(stats);
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		TS_ASSERT_EQUALS(Common::String(stats[0].name), "long");
+		TS_ASSERT_EQUALS(stats[0].count, 1u);
+		TS_ASSERT_EQUALS(stats[0].total, 100u);
+		TS_ASSERT_EQUALS(Common::String(stats[1].name), "short");
+		TS_ASSERT_EQUALS(stats[1].count, 2u);
+		TS_ASSERT_EQUALS(stats[1].total, 8u);
+		TS_ASSERT_EQUALS(stats[1].max, 5u);
+#endif
+	}
+
+	void test_chrome_trace() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.setCapacity(16);
+		profiler.record("a\"b", 7, 10, Common::Profiler::kLaneAudio);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(profiler.writeChromeTrace(out));
+		Common::String json((const char *)out.getData(), out.size());
+		TS_ASSERT_EQUALS(json, "{\"traceEvents\":[\n"
+			"{\"name\":\"a\\\"b\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":7,\"dur\":3}\n"
+			"]}\n");
+#endif
+	}
+
+	void test_zone() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.setCapacity(16);
+
+		profiler.setEnabled(false);
+		{
+			Common::ProfileZone zone("disabled");
+		}
+		TS_ASSERT_EQUALS(profiler.getEventCount(), 0u);
+
+		profiler.setEnabled(true);
+		{
+			Common::ProfileZone zone("enabled");
+		}
+		profiler.setEnabled(false);
+		TS_ASSERT_EQUALS(profiler.getEventCount(), 1u);
+		TS_ASSERT_EQUALS(Common::String(profiler.getEvent(0).name), "enabled");
+#endif
+	}
+};
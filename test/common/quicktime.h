@@ -0,0 +1,124 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/formats/quicktime.h"
+
+class QuickTimeSampleIndexTestSuite : public CxxTest::TestSuite {
+	class TestParser : public Common::QuickTimeParser {
+	public:
+		/**
+		 * Fill a track with random sample tables, build its index and check
+		 * it against the tables themselves.
+		 */
+		bool checkIndex(uint32 seed, bool constantSize) {
+			Track track;
+			track.codecType = CODEC_TYPE_VIDEO;
+
+			track.chunkCount = 40;
+			track.chunkOffsets = new uint32[track.chunkCount];
+			for (uint32 i = 0; i < track.chunkCount; i++)
+				track.chunkOffsets[i] = 1000 + i * 5000;
+
+			track.sampleToChunkCount = 4;
+			track.sampleToChunk = new SampleToChunkEntry[track.sampleToChunkCount];
+			for (uint32 i = 0; i < track.sampleToChunkCount; i++) {
+				track.sampleToChunk[i].first = i * 9;
+				track.sampleToChunk[i].count = 1 + nextRandom(seed) % 4;
+				track.sampleToChunk[i].id = 1 + i % 2;
+			}
+
+			uint32 totalSamples = 0;
+			for (uint32 i = 0, entry = 0; i < track.chunkCount; i++) {
+				if (entry + 1 < track.sampleToChunkCount && i >= track.sampleToChunk[entry + 1].first)
+					entry++;
+				totalSamples += track.sampleToChunk[entry].count;
+			}
+
+			track.sampleCount = totalSamples;
+			if (constantSize) {
+				track.sampleSize = 37;
+			} else {
+				track.sampleSizes = new uint32[track.sampleCount];
+				for (uint32 i = 0; i < track.sampleCount; i++)
+					track.sampleSizes[i] = 1 + nextRandom(seed) % 800;
+			}
+
+			track.timeToSampleCount = 5;
+			track.timeToSample = new TimeToSampleEntry[track.timeToSampleCount];
+			track.frameCount = 0;
+			for (int i = 0; i < track.timeToSampleCount; i++) {
+				track.timeToSample[i].count = 1 + nextRandom(seed) % 30;
+				track.timeToSample[i].duration = 1 + nextRandom(seed) % 20;
+				track.frameCount += track.timeToSample[i].count;
+			}
+
+			track.keyframeCount = 6;
+			track.keyframes = new uint32[track.keyframeCount];
+			for (uint32 i = 0; i < track.keyframeCount; i++)
+				track.keyframes[i] = 3 + i * 11;
+
+			track.buildSampleIndex();
+
+			bool result = track.sampleOffsets.size() == track.sampleCount && track.sampleTimes.size() == track.frameCount + 1;
+
+			// Samples follow each other within their chunk
+			uint32 sample = 0;
+			for (uint32 i = 0, entry = 0; i < track.chunkCount && result; i++) {
+				if (entry + 1 < track.sampleToChunkCount && i >= track.sampleToChunk[entry + 1].first)
+					entry++;
+
+				uint32 offset = track.chunkOffsets[i];
+				for (uint32 j = 0; j < track.sampleToChunk[entry].count; j++, sample++) {
+					result &= track.sampleOffsets[sample] == offset;
+					result &= track.sampleDescIds[sample] == track.sampleToChunk[entry].id;
+					offset += constantSize ? track.sampleSize : track.sampleSizes[sample];
+				}
+			}
+
+			uint32 time = 0;
+			sample = 0;
+			for (int i = 0; i < track.timeToSampleCount; i++) {
+				for (int j = 0; j < track.timeToSample[i].count; j++, sample++) {
+					result &= track.sampleTimes[sample] == time;
+
+					// Every time within the sample finds the sample after it
+					result &= track.findSampleTime(time) == sample;
+					for (int k = 1; k < track.timeToSample[i].duration; k++)
+						result &= track.findSampleTime(time + k) == sample + 1;
+
+					time += track.timeToSample[i].duration;
+				}
+			}
+			result &= track.sampleTimes[sample] == time;
+			result &= track.findSampleTime(time + 1) == track.sampleTimes.size();
+
+			for (uint32 i = 0; i < track.sampleCount; i++) {
+				uint32 keyframe = i;
+				for (uint32 j = 0; j < track.keyframeCount; j++) {
+					if (track.keyframes[j] <= i)
+						keyframe = track.keyframes[j];
+				}
+				result &= track.findKeyframe(i) == keyframe;
+			}
+
+			return result;
+		}
+
+	protected:
+		SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) override {
+			return nullptr;
+		}
+	};
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+public:
+	void test_sample_index() {
+		TestParser parser;
+		TS_ASSERT(parser.checkIndex(1, false));
+		TS_ASSERT(parser.checkIndex(2, false));
+		TS_ASSERT(parser.checkIndex(3, true));
+	}
+};
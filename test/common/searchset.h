@@ -0,0 +1,82 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+namespace {
+
+class CountingArchive : public Common::Archive {
+public:
+	Common::String _file;
+	mutable int _queries;
+
+	CountingArchive(const Common::String &file) : _file(file), _queries(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		_queries++;
+		return path.toString() == _file;
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_file, this)));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path.toString(), this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream((const byte *)_file.c_str(), _file.size());
+	}
+};
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_priority_order() {
+		Common::SearchSet set;
+		CountingArchive *low = new CountingArchive("a");
+		CountingArchive *high = new CountingArchive("a");
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(high->_queries, 1);
+		TS_ASSERT_EQUALS(low->_queries, 0);
+	}
+
+	void test_lookup_cache() {
+		Common::SearchSet set;
+		set.setCacheLookups(true);
+		CountingArchive *first = new CountingArchive("a");
+		CountingArchive *second = new CountingArchive("b");
+		set.add("first", first, 10);
+		set.add("second", second, 0);
+
+		TS_ASSERT(set.hasFile("b"));
+		TS_ASSERT(set.hasFile("b"));
+		TS_ASSERT(!set.hasFile("c"));
+		TS_ASSERT(!set.hasFile("c"));
+		// One query per archive for the first lookup of each path only
+		TS_ASSERT_EQUALS(first->_queries, 2);
+		TS_ASSERT_EQUALS(second->_queries, 2);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(first->_queries, 2);
+
+		// Adding an archive must invalidate the cache
+		set.add("third", new CountingArchive("c"), 20);
+		TS_ASSERT(set.hasFile("c"));
+
+		set.remove("third");
+		TS_ASSERT(!set.hasFile("c"));
+	}
+};
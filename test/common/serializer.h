@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/memstream.h"
 #include "common/serializer.h"
 #include "common/stream.h"
 
@@ -108,4 +109,46 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	void test_sync_array() {
+		// More entries than fit into the staging buffer at once
+		const uint count = Common::Serializer::kBulkBufferSize;
+		int16 values[count];
+		for (uint i = 0; i < count; ++i)
+			values[i] = (int16)(i * 37 - 5000);
+
+		Common::MemoryWriteStreamDynamic bulk(DisposeAfterUse::YES);
+		Common::MemoryWriteStreamDynamic single(DisposeAfterUse::YES);
+		Common::Serializer bulkSaver(0, &bulk);
+		Common::Serializer singleSaver(0, &single);
+		bulkSaver.syncArrayAsSint16LE(values, count);
+		for (uint i = 0; i < count; ++i)
+			singleSaver.syncAsSint16LE(values[i]);
+
+		TS_ASSERT_EQUALS(bulkSaver.bytesSynced(), count * 2);
+		TS_ASSERT_EQUALS(bulk.size(), single.size());
+		TS_ASSERT_EQUALS(memcmp(bulk.getData(), single.getData(), bulk.size()), 0);
+
+		Common::MemoryReadStream in(bulk.getData(), bulk.size());
+		Common::Serializer loader(&in, 0);
+		int16 loaded[count];
+		loader.syncArrayAsSint16LE(loaded, count);
+		TS_ASSERT_EQUALS(memcmp(loaded, values, sizeof(values)), 0);
+	}
+
+	void test_sync_array_versioned() {
+		static const byte contents[] = { 0x01, 0x00, 0x00, 0x00, 0x02, 0x03, 0x04, 0x05 };
+		Common::MemoryReadStream in(contents, sizeof(contents));
+		Common::Serializer loader(&in, 0);
+		loader.setVersion(1);
+
+		uint32 values[2] = { 0x12345678, 0x12345678 };
+		loader.syncArrayAsUint32BE(values, 2, Common::Serializer::Version(2));
+		TS_ASSERT_EQUALS(values[0], 0x12345678U);
+		TS_ASSERT_EQUALS(loader.bytesSynced(), 0U);
+
+		loader.syncArrayAsUint32BE(values, 2);
+		TS_ASSERT_EQUALS(values[0], 0x01000000U);
+		TS_ASSERT_EQUALS(values[1], 0x02030405U);
+	}
 };
@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+
+#include "../null_osystem.h"
+
+namespace {
+
+struct CountingJob : public Common::Job {
+	int *counter;
+	int amount;
+
+	void run() override {
+		*counter += amount;
+	}
+};
+
+} // End of anonymous namespace
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void test_task_group() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		Common::ThreadPool pool(4);
+		int counter = 0;
+		CountingJob jobs[10];
+		{
+			Common::TaskGroup group(pool);
+			for (int i = 0; i < 10; ++i) {
+				jobs[i].counter = &counter;
+				jobs[i].amount = i + 1;
+				group.run(&jobs[i]);
+			}
+			group.wait();
+			TS_ASSERT_EQUALS(counter, 55);
+		}
+		TS_ASSERT_EQUALS(counter, 55);
+	}
+
+	void test_parallel_for_covers_range() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		Common::ThreadPool pool(3);
+		byte visited[1000];
+		memset(visited, 0, sizeof(visited));
+
+		pool.parallelFor(0, 1000, 7, [&visited](uint first, uint last) {
+			for (uint i = first; i < last; ++i)
+				visited[i]++;
+		});
+
+		for (uint i = 0; i < 1000; ++i)
+			TS_ASSERT_EQUALS(visited[i], 1);
+	}
+
+	void test_parallel_for_empty_and_offset_ranges() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		Common::ThreadPool pool(2);
+		uint calls = 0;
+		pool.parallelFor(5, 5, 1, [&calls](uint first, uint last) {
+			calls++;
+		});
+		TS_ASSERT_EQUALS(calls, 0u);
+
+		uint sum = 0;
+		pool.parallelFor(10, 20, 100, [&sum](uint first, uint last) {
+			for (uint i = first; i < last; ++i)
+				sum += i;
+		});
+		TS_ASSERT_EQUALS(sum, 145u);
+	}
+};
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/compression/unzip.h"
+
+#include "../null_osystem.h"
+
+namespace {
+
+// A ZIP file holding "stored.txt" without compression and
+// "dir/deflated.txt" compressed with deflate.
+static const byte zipData[] = {
+		0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xcd, 0xba,
+		0xb6, 0xb7, 0x15, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x73, 0x74,
+		0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x73,
+		0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x0a, 0x50, 0x4b, 0x03,
+		0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0x14, 0x77, 0xad, 0xa3, 0x0d,
+		0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x64, 0x69, 0x72, 0x2f, 0x64,
+		0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x0b, 0x4e, 0x2e, 0xcd, 0xcd,
+		0x0d, 0xf3, 0x55, 0x08, 0x1e, 0x20, 0x1a, 0x00, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xcd, 0xba, 0xb6, 0xb7, 0x15, 0x00, 0x00, 0x00,
+		0x15, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74,
+		0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00,
+		0x14, 0x77, 0xad, 0xa3, 0x0d, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x3d, 0x00, 0x00, 0x00, 0x64, 0x69,
+		0x72, 0x2f, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b,
+		0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x76, 0x00, 0x00, 0x00, 0x78, 0x00,
+		0x00, 0x00, 0x00, 0x00
+};
+
+Common::Archive *openZip() {
+	return Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+}
+
+Common::String readMember(const Common::Archive &archive, const Common::Path &path) {
+	Common::SeekableReadStream *stream = archive.createReadStreamForMember(path);
+	if (!stream)
+		return "<missing>";
+	Common::String result = stream->readString(0, stream->size());
+	delete stream;
+	return result;
+}
+
+} // End of anonymous namespace
+
+class UnzipTestSuite : public CxxTest::TestSuite {
+public:
+	void test_read_members() {
+		Common::Archive *archive = openZip();
+		TS_ASSERT(archive);
+
+		TS_ASSERT(archive->hasFile("stored.txt"));
+		TS_ASSERT(archive->hasFile("dir/deflated.txt"));
+		TS_ASSERT(!archive->hasFile("missing.txt"));
+
+		TS_ASSERT_EQUALS(readMember(*archive, "stored.txt"), "Hello, stored world!\n");
+
+		Common::String expected;
+		for (int i = 0; i < 16; i++)
+			expected += "ScummVM ";
+		TS_ASSERT_EQUALS(readMember(*archive, "dir/deflated.txt"), expected);
+		// Served from the contents cache the second time.
+		TS_ASSERT_EQUALS(readMember(*archive, "dir/deflated.txt"), expected);
+		TS_ASSERT_EQUALS(readMember(*archive, "missing.txt"), "<missing>");
+
+		delete archive;
+	}
+
+	void test_prefetch_members() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Archive *archive = openZip();
+		TS_ASSERT(archive);
+
+		Common::ArchiveMemberList members;
+		TS_ASSERT_EQUALS(archive->listMembers(members), 2);
+		archive->prefetchMembers(members);
+
+		TS_ASSERT_EQUALS(readMember(*archive, "stored.txt"), "Hello, stored world!\n");
+		TS_ASSERT(readMember(*archive, "dir/deflated.txt").hasPrefix("ScummVM ScummVM "));
+
+		delete archive;
+#endif
+	}
+};
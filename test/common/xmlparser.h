@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/formats/xmlparser.h"
+
+class TestXMLParser : public Common::XMLParser {
+public:
+	Common::String _log;
+
+protected:
+	CUSTOM_XML_PARSER(TestXMLParser) {
+		XML_KEY(layout)
+			XML_PROP(name, true)
+			XML_KEY(widget)
+				XML_PROP(id, true)
+				XML_PROP(size, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_layout(ParserNode *node) {
+		_log += "layout:" + node->values["name"] + ";";
+		return true;
+	}
+
+	bool parserCallback_widget(ParserNode *node) {
+		_log += "widget:" + node->values["id"];
+		if (node->values.contains("size"))
+			_log += "," + node->values["size"];
+		_log += ";";
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_log += "/" + node->name + ";";
+		return true;
+	}
+
+	void cleanup() override {
+		_log.clear();
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void test_replay() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>\n"
+			"<!-- comment -->\n"
+			"<layout name = 'main'>\n"
+			"\t<widget id = 'ok' size = '10, 20'/>\n"
+			"\t<widget id = \"cancel\"></widget>\n"
+			"</layout>\n"
+			"<layout name = 'empty'/>\n";
+
+		TestXMLParser parser;
+		Common::XMLParser::ParseEventList events;
+
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		parser.setRecording(&events);
+		TS_ASSERT(parser.parse());
+		parser.setRecording(nullptr);
+		parser.close();
+
+		const Common::String parsed = parser._log;
+		TS_ASSERT_EQUALS(parsed, "/xml;layout:main;widget:ok,10, 20;/widget;widget:cancel;/widget;/layout;layout:empty;/layout;");
+
+		// Replaying the recording calls the same callbacks without a file
+		TS_ASSERT(parser.replay(events, "test"));
+		TS_ASSERT_EQUALS(parser._log, parsed);
+
+		// And it can be done any number of times
+		TS_ASSERT(parser.replay(events, "test"));
+		TS_ASSERT_EQUALS(parser._log, parsed);
+	}
+
+	void test_replay_unbalanced() {
+		TestXMLParser parser;
+		Common::XMLParser::ParseEventList events;
+
+		Common::XMLParser::ParseEvent event;
+		event.type = Common::XMLParser::ParseEvent::kOpenKey;
+		event.name = "layout";
+		event.values["name"] = "main";
+		event.header = false;
+		event.closed = false;
+		events.push_back(event);
+
+		// The key is never closed
+		TS_ASSERT(!parser.replay(events, "test"));
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/blit.h"
+#include "graphics/pixelformat.h"
+
+#include "../null_osystem.h"
+
+class BlitTestSuite : public CxxTest::TestSuite {
+	static const uint kWidth = 37;
+	static const uint kHeight = 3;
+
+	static uint32 readPixel(const byte *buf, uint bpp) {
+		return (bpp == 2) ? *(const uint16 *)buf : *(const uint32 *)buf;
+	}
+
+	static void fillPattern(byte *buf, uint size) {
+		uint32 seed = 0x12345678;
+		for (uint i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 16;
+		}
+	}
+
+	// Compare crossBlit() against converting each pixel through ARGB.
+	void checkConversion(const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		const uint srcPitch = kWidth * srcFmt.bytesPerPixel + 4;
+		const uint dstPitch = kWidth * dstFmt.bytesPerPixel + 8;
+		byte src[kHeight * (kWidth * 4 + 4)];
+		byte dst[kHeight * (kWidth * 4 + 8)];
+		fillPattern(src, sizeof(src));
+
+		TS_ASSERT(Graphics::crossBlit(dst, src, dstPitch, srcPitch, kWidth, kHeight, dstFmt, srcFmt));
+
+		for (uint y = 0; y < kHeight; ++y) {
+			for (uint x = 0; x < kWidth; ++x) {
+				byte a, r, g, b;
+				srcFmt.colorToARGB(readPixel(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel), a, r, g, b);
+				const uint32 expected = dstFmt.ARGBToColor(a, r, g, b);
+				const uint32 actual = readPixel(dst + y * dstPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel);
+				TS_ASSERT_EQUALS(actual, expected);
+				if (actual != expected)
+					return;
+			}
+		}
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void test_cross_blit() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+		const Graphics::PixelFormat argb4444(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		const Graphics::PixelFormat argb1555(2, 5, 5, 5, 1, 10, 5, 0, 15);
+		const Graphics::PixelFormat rgba8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Graphics::PixelFormat abgr8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		const Graphics::PixelFormat xrgb8888(4, 8, 8, 8, 0, 16, 8, 0, 24);
+
+		checkConversion(rgba8888, rgb565);
+		checkConversion(xrgb8888, rgb565);
+		checkConversion(rgb565, rgba8888);
+		checkConversion(rgb565, xrgb8888);
+		checkConversion(abgr8888, rgba8888);
+		checkConversion(rgba8888, abgr8888);
+		checkConversion(rgba8888, xrgb8888);
+		checkConversion(xrgb8888, abgr8888);
+		checkConversion(rgb555, rgb565);
+		checkConversion(argb4444, rgba8888);
+		checkConversion(rgba8888, argb4444);
+		checkConversion(rgba8888, argb1555);
+		checkConversion(argb1555, rgba8888);
+	}
+
+	void test_cross_blit_in_place() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat rgba8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+
+		uint16 original[kWidth * kHeight];
+		uint32 buf[kWidth * kHeight];
+		fillPattern((byte *)original, sizeof(original));
+		memcpy(buf, original, sizeof(original));
+
+		TS_ASSERT(Graphics::crossBlit((byte *)buf, (const byte *)buf, kWidth * 4, kWidth * 2, kWidth, kHeight, rgba8888, rgb565));
+
+		for (uint i = 0; i < kWidth * kHeight; ++i) {
+			byte a, r, g, b;
+			rgb565.colorToARGB(original[i], a, r, g, b);
+			TS_ASSERT_EQUALS(buf[i], rgba8888.ARGBToColor(a, r, g, b));
+		}
+	}
+
+	void test_cross_blit_map() {
+		uint32 map[256];
+		for (uint i = 0; i < 256; ++i)
+			map[i] = 0xFF000000 | (i * 0x010203);
+
+		byte src[kWidth * kHeight];
+		uint32 dst[kWidth * kHeight];
+		fillPattern(src, sizeof(src));
+
+		TS_ASSERT(Graphics::crossBlitMap((byte *)dst, src, kWidth * 4, kWidth, kWidth, kHeight, 4, map));
+
+		for (uint i = 0; i < kWidth * kHeight; ++i)
+			TS_ASSERT_EQUALS(dst[i], map[src[i]]);
+	}
+};
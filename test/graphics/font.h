@@ -0,0 +1,97 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/font.h"
+
+class CountingFont : public Graphics::Font {
+public:
+	CountingFont() : widthCalls(0) {}
+
+	int getFontHeight() const override { return 8; }
+	int getMaxCharWidth() const override { return 9; }
+
+	int getCharWidth(uint32 chr) const override {
+		widthCalls++;
+		return 4 + chr % 6;
+	}
+
+	int getKerningOffset(uint32 left, uint32 right) const override {
+		return (left == 'A' && right == 'V') ? -2 : 0;
+	}
+
+	void drawChar(Graphics::Surface *dst, uint32 chr, int x, int y, uint32 color) const override {}
+
+	mutable int widthCalls;
+};
+
+class FontTestSuite : public CxxTest::TestSuite {
+	static void compareWrap(const char *text, int maxWidth, uint32 mode) {
+		CountingFont plain;
+		CountingFont cached;
+		cached.setTextCacheEnabled(true);
+
+		Common::Array<Common::String> plainLines, cachedLines;
+		plainLines.push_back("previous");
+		cachedLines.push_back("previous");
+
+		const int plainWidth = plain.wordWrapText(text, maxWidth, plainLines, 0, mode);
+		for (int pass = 0; pass < 2; ++pass) {
+			if (pass) {
+				cachedLines.clear();
+				cachedLines.push_back("previous");
+			}
+			TS_ASSERT_EQUALS(cached.wordWrapText(text, maxWidth, cachedLines, 0, mode), plainWidth);
+			TS_ASSERT_EQUALS(cachedLines.size(), plainLines.size());
+			for (uint i = 0; i < plainLines.size() && i < cachedLines.size(); ++i)
+				TS_ASSERT_EQUALS(cachedLines[i], plainLines[i]);
+		}
+	}
+
+public:
+	void test_wrap_matches_uncached() {
+		const char *text = "AVery long line of text which has to be wrapped\nover several lines of output";
+		const uint32 modes[] = {
+			Graphics::kWordWrapDefault,
+			Graphics::kWordWrapOnExplicitNewLines,
+			Graphics::kWordWrapEvenWidthLines,
+			Graphics::kWordWrapEvenWidthLines | Graphics::kWordWrapOnExplicitNewLines
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(modes); ++i) {
+			compareWrap(text, 80, modes[i]);
+			compareWrap(text, 200, modes[i]);
+			compareWrap("No new lines in this text at all, just words", 90, modes[i]);
+		}
+	}
+
+	void test_string_width() {
+		CountingFont plain;
+		CountingFont cached;
+		cached.setTextCacheEnabled(true);
+
+		const Common::String text("AVAVA Z\xe9");
+		TS_ASSERT_EQUALS(cached.getStringWidth(text), plain.getStringWidth(text));
+		TS_ASSERT_EQUALS(cached.getStringWidth(text), plain.getStringWidth(text));
+	}
+
+	void test_repeated_wrap_is_not_measured() {
+		CountingFont font;
+		font.setTextCacheEnabled(true);
+
+		Common::Array<Common::String> lines;
+		font.wordWrapText("Some text which is wrapped every frame", 60, lines);
+		const uint firstCount = lines.size();
+		TS_ASSERT_LESS_THAN(0, font.widthCalls);
+
+		font.widthCalls = 0;
+		lines.clear();
+		font.wordWrapText("Some text which is wrapped every frame", 60, lines);
+		TS_ASSERT_EQUALS(font.widthCalls, 0);
+		TS_ASSERT_EQUALS(lines.size(), firstCount);
+
+		font.clearTextCache();
+		lines.clear();
+		font.wordWrapText("Some text which is wrapped every frame", 60, lines);
+		TS_ASSERT_LESS_THAN(0, font.widthCalls);
+		TS_ASSERT_EQUALS(lines.size(), firstCount);
+	}
+};
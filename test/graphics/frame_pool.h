@@ -0,0 +1,81 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/frame_pool.h"
+
+#include "../null_osystem.h"
+
+class FramePoolTestSuite : public CxxTest::TestSuite {
+public:
+	void test_reuse() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		FramePoolMan.clear();
+		FramePoolMan.resetStats();
+
+		Graphics::Surface *first = FramePoolMan.acquire(32, 16, clut8);
+		Graphics::Surface *second = FramePoolMan.acquire(32, 16, clut8);
+		TS_ASSERT_DIFFERS(first, second);
+		TS_ASSERT_EQUALS(first->w, 32);
+		TS_ASSERT_EQUALS(first->h, 16);
+		TS_ASSERT_EQUALS(first->format, clut8);
+		FramePoolMan.release(first);
+		FramePoolMan.release(second);
+
+		// Only surfaces of the same size and format are handed out again
+		Graphics::Surface *other = FramePoolMan.acquire(32, 16, rgb565);
+		TS_ASSERT(other != first && other != second);
+		Graphics::Surface *reused = FramePoolMan.acquire(32, 16, clut8);
+		TS_ASSERT_EQUALS(reused, second);
+		FramePoolMan.release(other);
+		FramePoolMan.release(reused);
+		FramePoolMan.release(0);
+
+		Graphics::FramePool::Stats stats = FramePoolMan.getStats();
+		TS_ASSERT_EQUALS(stats.allocations, 3u);
+		TS_ASSERT_EQUALS(stats.reuses, 1u);
+		TS_ASSERT_EQUALS(stats.evictions, 0u);
+
+		// Decoding frame after frame only allocates the surfaces in flight
+		FramePoolMan.resetStats();
+		for (int i = 0; i < 100; ++i) {
+			Graphics::Surface *frame = FramePoolMan.acquire(32, 16, clut8);
+			Graphics::Surface *converted = FramePoolMan.acquire(32, 16, rgb565);
+			FramePoolMan.release(frame);
+			FramePoolMan.release(converted);
+		}
+		stats = FramePoolMan.getStats();
+		TS_ASSERT_EQUALS(stats.allocations, 0u);
+		TS_ASSERT_EQUALS(stats.reuses, 200u);
+
+		FramePoolMan.clear();
+	}
+
+	void test_eviction() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		FramePoolMan.clear();
+		FramePoolMan.resetStats();
+
+		Graphics::Surface *surfaces[20];
+		for (int i = 0; i < ARRAYSIZE(surfaces); ++i)
+			surfaces[i] = FramePoolMan.acquire(8 + i, 8, Graphics::PixelFormat::createFormatCLUT8());
+		for (int i = 0; i < ARRAYSIZE(surfaces); ++i)
+			FramePoolMan.release(surfaces[i]);
+
+		// The pool keeps the surfaces released last
+		TS_ASSERT_EQUALS(FramePoolMan.getStats().evictions, 4u);
+		TS_ASSERT_EQUALS(FramePoolMan.acquire(8 + 19, 8, Graphics::PixelFormat::createFormatCLUT8()), surfaces[19]);
+		Graphics::Surface *evicted = FramePoolMan.acquire(8, 8, Graphics::PixelFormat::createFormatCLUT8());
+		TS_ASSERT_EQUALS(FramePoolMan.getStats().allocations, 21u);
+		FramePoolMan.release(surfaces[19]);
+		FramePoolMan.release(evicted);
+
+		FramePoolMan.clear();
+	}
+};
@@ -0,0 +1,48 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/framelimiter.h"
+
+#include "../null_osystem.h"
+
+class FrameLimiterTestSuite : public CxxTest::TestSuite {
+public:
+	void test_pacing() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Graphics::FrameLimiter limiter(g_system, 200);
+		TS_ASSERT_EQUALS(limiter.getStats().frames, 0u);
+
+		const uint64 start = g_system->getMicros();
+		for (uint i = 0; i <= 20; ++i) {
+			limiter.startFrame();
+			limiter.delayBeforeSwap();
+		}
+		const uint64 elapsed = g_system->getMicros() - start;
+
+		// Frames are due every 5 ms, delays are rounded to milliseconds
+		TS_ASSERT_LESS_THAN_EQUALS(20 * 5000 - 500, (int64)elapsed);
+
+		const Graphics::FrameLimiter::Stats stats = limiter.getStats();
+		TS_ASSERT_EQUALS(stats.frames, 20u);
+		TS_ASSERT_LESS_THAN_EQUALS(4000u, stats.median);
+		TS_ASSERT_LESS_THAN_EQUALS(stats.median, stats.p99);
+		TS_ASSERT_LESS_THAN_EQUALS(stats.p99, stats.max);
+#endif
+	}
+
+	void test_disabled() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Without a framerate frames are only measured
+		Graphics::FrameLimiter limiter(g_system, 0);
+		for (uint i = 0; i < 300; ++i) {
+			limiter.startFrame();
+			limiter.delayBeforeSwap();
+		}
+		TS_ASSERT_EQUALS(limiter.getStats().frames, 256u);
+		TS_ASSERT_LESS_THAN(limiter.getStats().max, 5000u);
+#endif
+	}
+};
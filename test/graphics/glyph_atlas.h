@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/fonts/glyph_atlas.h"
+
+class GlyphAtlasTestSuite : public CxxTest::TestSuite {
+	static void fill(Graphics::GlyphAtlas &atlas, Graphics::GlyphAtlas::Glyph &glyph, byte value) {
+		byte *pixels = atlas.getPixels(glyph);
+		for (int y = 0; y < glyph.height; ++y)
+			memset(pixels + y * atlas.getPitch(glyph), value, glyph.width);
+	}
+
+	static bool holds(Graphics::GlyphAtlas &atlas, const Graphics::GlyphAtlas::Glyph &glyph, byte value) {
+		const byte *pixels = atlas.getPixels(glyph);
+		for (int y = 0; y < glyph.height; ++y) {
+			for (int x = 0; x < glyph.width; ++x) {
+				if (pixels[y * atlas.getPitch(glyph) + x] != value)
+					return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	void test_faces() {
+		Graphics::GlyphAtlas atlas(64, 64, 2);
+		const uint32 a = atlas.registerFace("a:12");
+		const uint32 b = atlas.registerFace("b:12");
+		TS_ASSERT_DIFFERS(a, b);
+		TS_ASSERT_EQUALS(atlas.registerFace("a:12"), a);
+
+		atlas.insert(a, 'x', 5, 7)->advance = 6;
+		TS_ASSERT(atlas.find(a, 'x'));
+		TS_ASSERT_EQUALS(atlas.find(a, 'x')->advance, 6);
+		TS_ASSERT(!atlas.find(b, 'x'));
+	}
+
+	void test_packing() {
+		// Sixteen 16x16 glyphs fill one 64x64 page exactly
+		Graphics::GlyphAtlas atlas(64, 64, 1);
+		for (uint32 chr = 0; chr < 16; ++chr)
+			fill(atlas, *atlas.insert(0, chr, 16, 16), chr + 1);
+
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 1U);
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 16U);
+		for (uint32 chr = 0; chr < 16; ++chr)
+			TS_ASSERT(holds(atlas, *atlas.find(0, chr), chr + 1));
+
+		// Glyphs without pixels take no space
+		Graphics::GlyphAtlas::Glyph *space = atlas.insert(0, ' ', 0, 0);
+		TS_ASSERT_EQUALS(space->page, -1);
+		TS_ASSERT(!atlas.getPixels(*space));
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 17U);
+	}
+
+	void test_lru_eviction() {
+		Graphics::GlyphAtlas atlas(32, 32, 2);
+		// One page each
+		fill(atlas, *atlas.insert(0, 'a', 32, 32), 1);
+		fill(atlas, *atlas.insert(0, 'b', 32, 32), 2);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 2U);
+
+		// 'a' is used more recently, so the page of 'b' is reused
+		TS_ASSERT(atlas.find(0, 'a'));
+		fill(atlas, *atlas.insert(0, 'c', 20, 20), 3);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 2U);
+		TS_ASSERT(!atlas.find(0, 'b'));
+		TS_ASSERT(holds(atlas, *atlas.find(0, 'a'), 1));
+		TS_ASSERT(holds(atlas, *atlas.find(0, 'c'), 3));
+
+		// Inserting again replaces the glyph
+		fill(atlas, *atlas.insert(0, 'c', 8, 8), 4);
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 2U);
+		TS_ASSERT(holds(atlas, *atlas.find(0, 'c'), 4));
+	}
+
+	void test_large_glyph() {
+		Graphics::GlyphAtlas atlas(16, 16, 2);
+		atlas.insert(0, 'a', 8, 8);
+		Graphics::GlyphAtlas::Glyph *large = atlas.insert(0, 'W', 40, 30);
+		fill(atlas, *large, 9);
+		TS_ASSERT(holds(atlas, *atlas.find(0, 'W'), 9));
+		TS_ASSERT(atlas.find(0, 'a'));
+
+		atlas.clear();
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 0U);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 0U);
+	}
+};
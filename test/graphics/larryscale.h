@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/larryScale.h"
+#include "common/array.h"
+#include "common/util.h"
+
+class LarryScaleTestSuite : public CxxTest::TestSuite {
+	class Bitmap : public Graphics::RowReader, public Graphics::RowWriter {
+	public:
+		int _width;
+		int _height;
+		Common::Array<byte> _pixels;
+
+		Bitmap(int width, int height) : _width(width), _height(height), _pixels(width * height) {}
+
+		const byte *readRow(int y) override {
+			return &_pixels[y * _width];
+		}
+
+		void writeRow(int y, const byte *row) override {
+			memcpy(&_pixels[y * _width], row, _width);
+		}
+
+		uint32 hash() const {
+			uint32 result = 2166136261u;
+			for (uint i = 0; i < _pixels.size(); ++i) {
+				result = (result ^ _pixels[i]) * 16777619u;
+			}
+			return result;
+		}
+	};
+
+	/**
+	 * Fill the bitmap with flat rectangles on a transparent background
+	 * and scribble one pixel wide lines across them.
+	 */
+	static void drawCartoon(Bitmap &bitmap, uint32 seed) {
+		const int width = bitmap._width;
+		const int height = bitmap._height;
+		for (int i = 0; i < 12; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const int x = (seed >> 8) % width, y = (seed >> 16) % height;
+			seed = seed * 1103515245 + 12345;
+			const int w = 1 + (seed >> 8) % (width / 2), h = 1 + (seed >> 16) % (height / 2);
+			const byte color = 1 + (seed >> 24) % 5;
+			for (int yy = y; yy < MIN(height, y + h); ++yy)
+				memset(&bitmap._pixels[yy * width + x], color, MIN(width, x + w) - x);
+		}
+		for (int i = 0; i < 20; ++i) {
+			seed = seed * 1103515245 + 12345;
+			int x = (seed >> 8) % width, y = (seed >> 16) % height;
+			const byte color = 6 + (seed >> 24) % 3;
+			for (int step = 0; step < 40; ++step) {
+				bitmap._pixels[y * width + x] = color;
+				seed = seed * 1103515245 + 12345;
+				x = CLIP<int>(x + (int)((seed >> 16) % 3) - 1, 0, width - 1);
+				y = CLIP<int>(y + (int)((seed >> 20) % 3) - 1, 0, height - 1);
+			}
+		}
+	}
+
+	static uint32 scale(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+		Bitmap src(srcWidth, srcHeight);
+		drawCartoon(src, 0x1234 + dstWidth);
+		Bitmap dst(dstWidth, dstHeight);
+		Graphics::larryScale(srcWidth, srcHeight, 0, src, dstWidth, dstHeight, dst);
+		return dst.hash();
+	}
+
+public:
+	// The expected hashes pin the output of the original per-pixel
+	// classification, which the precomputed equality matrixes must match
+	void test_upscale() {
+		TS_ASSERT_EQUALS(scale(37, 29, 74, 58), 0xd363d8fbu);
+		TS_ASSERT_EQUALS(scale(37, 29, 55, 40), 0x6f33f672u);
+		TS_ASSERT_EQUALS(scale(37, 29, 100, 70), 0xec93fbf6u);
+		TS_ASSERT_EQUALS(scale(160, 120, 300, 230), 0x2073fe00u);
+	}
+
+	void test_downscale() {
+		TS_ASSERT_EQUALS(scale(37, 29, 20, 15), 0x04beb0d0u);
+		TS_ASSERT_EQUALS(scale(160, 120, 100, 80), 0x6c9837d8u);
+	}
+
+	void test_mixed_scale() {
+		TS_ASSERT_EQUALS(scale(37, 29, 30, 40), 0x66b2cd80u);
+	}
+};
@@ -0,0 +1,170 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+#include "../null_osystem.h"
+
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite {
+	static const int kSrcWidth = 45;
+	static const int kSrcHeight = 4;
+	static const int kDestWidth = 50;
+	static const int kDestHeight = 6;
+	static const uint32 kKey = 5;
+
+	// The sprite sticks out of the left and bottom edges of the destination.
+	static const int kDestX = -3;
+	static const int kDestY = 3;
+
+	static uint32 patternValue(int x, int y) {
+		return ((x * 7 + y * 13) % 11 == 0) ? kKey : (uint32)(x * 31 + y * 17 + 1000 + x * y);
+	}
+
+	static uint32 readPixel(const Graphics::ManagedSurface &surf, int x, int y) {
+		const void *p = surf.getBasePtr(x, y);
+		switch (surf.format.bytesPerPixel) {
+		case 1:
+			return *(const byte *)p;
+		case 2:
+			return *(const uint16 *)p;
+		default:
+			return *(const uint32 *)p;
+		}
+	}
+
+	static void fillSource(Graphics::Surface &src, uint32 valueMask) {
+		for (int y = 0; y < src.h; ++y) {
+			for (int x = 0; x < src.w; ++x) {
+				const uint32 v = patternValue(x, y);
+				src.setPixel(x, y, v == kKey ? kKey : (v & valueMask));
+			}
+		}
+	}
+
+	static bool isDrawn(int destX, int destY, int &srcX, int &srcY) {
+		srcX = destX - kDestX;
+		srcY = destY - kDestY;
+		return srcX >= 0 && srcX < kSrcWidth && srcY >= 0 && srcY < kSrcHeight &&
+			patternValue(srcX, srcY) != kKey;
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void test_clut8_keyed() {
+		Graphics::Surface src;
+		src.create(kSrcWidth, kSrcHeight, Graphics::PixelFormat::createFormatCLUT8());
+		fillSource(src, 0xff);
+
+		Graphics::ManagedSurface dest(kDestWidth, kDestHeight, Graphics::PixelFormat::createFormatCLUT8());
+		dest.clear(0xaa);
+		dest.transBlitFrom(src, Common::Point(kDestX, kDestY), kKey);
+
+		for (int y = 0; y < kDestHeight; ++y) {
+			for (int x = 0; x < kDestWidth; ++x) {
+				int srcX, srcY;
+				const uint32 expected = isDrawn(x, y, srcX, srcY) ? src.getPixel(srcX, srcY) : 0xaa;
+				TS_ASSERT_EQUALS(readPixel(dest, x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+
+	void test_clut8_override() {
+		Graphics::Surface src;
+		src.create(kSrcWidth, kSrcHeight, Graphics::PixelFormat::createFormatCLUT8());
+		fillSource(src, 0xff);
+
+		Graphics::ManagedSurface dest(kDestWidth, kDestHeight, Graphics::PixelFormat::createFormatCLUT8());
+		dest.clear(0xaa);
+		dest.transBlitFrom(src, Common::Point(kDestX, kDestY), kKey, false, 9);
+
+		for (int y = 0; y < kDestHeight; ++y) {
+			for (int x = 0; x < kDestWidth; ++x) {
+				int srcX, srcY;
+				const uint32 expected = isDrawn(x, y, srcX, srcY) ? 9 : 0xaa;
+				TS_ASSERT_EQUALS(readPixel(dest, x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+
+	void test_clut8_to_rgb565() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		byte palette[256 * 3];
+		for (int i = 0; i < 256 * 3; ++i)
+			palette[i] = i * 37;
+
+		Graphics::Surface src;
+		src.create(kSrcWidth, kSrcHeight, Graphics::PixelFormat::createFormatCLUT8());
+		fillSource(src, 0xff);
+
+		Graphics::ManagedSurface dest(kDestWidth, kDestHeight, format);
+		dest.clear(0x1234);
+		dest.transBlitFrom(src, Common::Point(kDestX, kDestY), kKey, false, 0, 0xff, palette);
+
+		for (int y = 0; y < kDestHeight; ++y) {
+			for (int x = 0; x < kDestWidth; ++x) {
+				int srcX, srcY;
+				uint32 expected = 0x1234;
+				if (isDrawn(x, y, srcX, srcY)) {
+					const byte *color = palette + src.getPixel(srcX, srcY) * 3;
+					expected = format.RGBToColor(color[0], color[1], color[2]);
+				}
+				TS_ASSERT_EQUALS(readPixel(dest, x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+
+	void test_rgb565_keyed() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+		Graphics::Surface src;
+		src.create(kSrcWidth, kSrcHeight, format);
+		fillSource(src, 0xffff);
+
+		Graphics::ManagedSurface dest(kDestWidth, kDestHeight, format);
+		dest.clear(0x1234);
+		dest.transBlitFrom(src, Common::Point(kDestX, kDestY), kKey);
+
+		for (int y = 0; y < kDestHeight; ++y) {
+			for (int x = 0; x < kDestWidth; ++x) {
+				int srcX, srcY;
+				const uint32 expected = isDrawn(x, y, srcX, srcY) ? src.getPixel(srcX, srcY) : 0x1234;
+				TS_ASSERT_EQUALS(readPixel(dest, x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+
+	void test_clut8_flipped_scaled() {
+		Graphics::Surface src;
+		src.create(kSrcWidth, kSrcHeight, Graphics::PixelFormat::createFormatCLUT8());
+		fillSource(src, 0xff);
+
+		// Flipped and doubled in width
+		Graphics::ManagedSurface dest(kSrcWidth * 2, kSrcHeight, Graphics::PixelFormat::createFormatCLUT8());
+		dest.clear(0xaa);
+		dest.transBlitFrom(src, Common::Rect(0, 0, kSrcWidth, kSrcHeight), Common::Rect(0, 0, kSrcWidth * 2, kSrcHeight), kKey, true);
+
+		for (int y = 0; y < kSrcHeight; ++y) {
+			for (int x = 0; x < kSrcWidth * 2; ++x) {
+				const uint32 srcVal = src.getPixel(kSrcWidth - x / 2 - 1, y);
+				const uint32 expected = srcVal == kKey ? 0xaa : srcVal;
+				TS_ASSERT_EQUALS(readPixel(dest, x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+};
@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/palette.h"
+
+namespace {
+
+// The exhaustive search PaletteLookup used to do for every color
+byte referenceBestColor(const byte *palette, uint size, byte cr, byte cg, byte cb, bool useNaiveAlg) {
+	uint bestColor = 0;
+	double min = 0xFFFFFFFF;
+	for (uint i = 0; i < size; ++i) {
+		const byte *p = palette + 3 * i;
+		double dist;
+		if (useNaiveAlg) {
+			dist = 3 * (cr - p[0]) * (cr - p[0]) + 5 * (cg - p[1]) * (cg - p[1]) + 2 * (cb - p[2]) * (cb - p[2]);
+		} else {
+			int rmean = (p[0] + cr) / 2;
+			int r = p[0] - cr;
+			int g = p[1] - cg;
+			int b = p[2] - cb;
+			dist = sqrt((((512 + rmean) * r * r) >> 8) + 4 * g * g + (((767 - rmean) * b * b) >> 8));
+		}
+		if (min > dist) {
+			bestColor = i;
+			min = dist;
+		}
+	}
+	return bestColor;
+}
+
+uint32 nextRandom(uint32 &seed) {
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+} // End of anonymous namespace
+
+class PaletteLookupTestSuite : public CxxTest::TestSuite {
+public:
+	void checkPalette(const byte *palette, uint size) {
+		Graphics::PaletteLookup lookup(palette, size);
+		uint32 seed = 1;
+		for (int alg = 0; alg < 2; ++alg) {
+			for (int i = 0; i < 20000; ++i) {
+				const uint32 color = nextRandom(seed);
+				const byte r = color >> 16, g = color >> 8, b = color;
+				TS_ASSERT_EQUALS(lookup.findBestColor(r, g, b, alg != 0), referenceBestColor(palette, size, r, g, b, alg != 0));
+			}
+		}
+	}
+
+	void test_random_palette() {
+		byte palette[256 * 3];
+		uint32 seed = 42;
+		for (uint i = 0; i < sizeof(palette); ++i)
+			palette[i] = nextRandom(seed);
+		checkPalette(palette, 256);
+	}
+
+	void test_grey_ramp_with_duplicates() {
+		// Duplicates and equidistant entries check the tie breaking
+		byte palette[64 * 3];
+		for (uint i = 0; i < 64; ++i)
+			palette[3 * i] = palette[3 * i + 1] = palette[3 * i + 2] = (i / 2) * 8;
+		checkPalette(palette, 64);
+	}
+
+	void test_small_palette_and_change() {
+		const byte ega[4 * 3] = { 0, 0, 0, 0, 0, 170, 170, 85, 0, 255, 255, 255 };
+		checkPalette(ega, 4);
+
+		Graphics::PaletteLookup lookup(ega, 4);
+		TS_ASSERT_EQUALS(lookup.findBestColor(250, 250, 250), 3);
+		const byte inverted[2 * 3] = { 255, 255, 255, 0, 0, 0 };
+		TS_ASSERT(lookup.setPalette(inverted, 2));
+		TS_ASSERT(!lookup.setPalette(inverted, 2));
+		TS_ASSERT_EQUALS(lookup.findBestColor(250, 250, 250), 0);
+		TS_ASSERT_EQUALS(lookup.findBestColor(5, 5, 5), 1);
+	}
+};
@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/region.h"
+
+class RegionTestSuite : public CxxTest::TestSuite {
+	enum {
+		kSize = 64
+	};
+
+	typedef byte Bitmap[kSize][kSize];
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static Common::Rect randomRect(uint32 &seed) {
+		int16 x = nextRandom(seed) % (kSize - 1);
+		int16 y = nextRandom(seed) % (kSize - 1);
+		int16 w = 1 + nextRandom(seed) % (kSize - x);
+		int16 h = 1 + nextRandom(seed) % (kSize - y);
+		return Common::Rect(x, y, x + w, y + h);
+	}
+
+	static void fill(Bitmap &bitmap, const Common::Rect &r, byte value) {
+		for (int y = r.top; y < r.bottom; y++)
+			for (int x = r.left; x < r.right; x++)
+				bitmap[y][x] = value;
+	}
+
+	// Checks the invariants of the banded representation, and that the
+	// region covers exactly the set pixels of the bitmap
+	static void checkRegion(const Graphics::Region &region, const Bitmap &bitmap) {
+		Bitmap covered;
+		memset(covered, 0, sizeof(covered));
+
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		for (uint i = 0; i < rects.size(); i++) {
+			TS_ASSERT(!rects[i].isEmpty());
+			if (i > 0) {
+				const Common::Rect &prev = rects[i - 1];
+				if (prev.top == rects[i].top) {
+					TS_ASSERT_EQUALS(prev.bottom, rects[i].bottom);
+					TS_ASSERT_LESS_THAN(prev.right, rects[i].left);
+				} else {
+					TS_ASSERT_LESS_THAN_EQUALS(prev.bottom, rects[i].top);
+				}
+			}
+
+			for (int y = rects[i].top; y < rects[i].bottom; y++)
+				for (int x = rects[i].left; x < rects[i].right; x++)
+					covered[y][x]++;
+		}
+
+		for (int y = 0; y < kSize; y++)
+			for (int x = 0; x < kSize; x++)
+				TS_ASSERT_EQUALS(covered[y][x], bitmap[y][x]);
+	}
+
+public:
+	void test_union_subtract_intersect() {
+		uint32 seed = 1;
+		for (int round = 0; round < 20; round++) {
+			Graphics::Region region;
+			Bitmap bitmap;
+			memset(bitmap, 0, sizeof(bitmap));
+
+			for (int i = 0; i < 12; i++) {
+				Common::Rect r = randomRect(seed);
+				switch (nextRandom(seed) % 3) {
+				case 0:
+				case 1:
+					region.unite(r);
+					fill(bitmap, r, 1);
+					break;
+				default:
+					region.subtract(r);
+					fill(bitmap, r, 0);
+					break;
+				}
+				checkRegion(region, bitmap);
+			}
+
+			Common::Rect clip = randomRect(seed);
+			region.intersect(clip);
+			for (int y = 0; y < kSize; y++)
+				for (int x = 0; x < kSize; x++)
+					if (!clip.contains(x, y))
+						bitmap[y][x] = 0;
+			checkRegion(region, bitmap);
+		}
+	}
+
+	void test_batched_union() {
+		uint32 seed = 7;
+		Common::Rect rects[50];
+		Graphics::Region single;
+		for (int i = 0; i < 50; i++) {
+			rects[i] = randomRect(seed);
+			single.unite(rects[i]);
+		}
+
+		Graphics::Region batched;
+		batched.unite(rects, 50);
+		TS_ASSERT(batched == single);
+	}
+
+	void test_bands_are_joined() {
+		// Two stacked rects of the same width become one
+		Graphics::Region region(Common::Rect(10, 10, 20, 20));
+		region.unite(Common::Rect(10, 20, 20, 30));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1u);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(10, 10, 20, 30));
+		TS_ASSERT_EQUALS(region.getArea(), 200u);
+
+		// Overlapping rects only count once
+		region.unite(Common::Rect(15, 15, 25, 25));
+		TS_ASSERT_EQUALS(region.getArea(), 250u);
+		TS_ASSERT_EQUALS(region.getBounds(), Common::Rect(10, 10, 25, 30));
+
+		region.subtract(Common::Rect(0, 0, 64, 64));
+		TS_ASSERT(region.isEmpty());
+	}
+
+	void test_simplify() {
+		Graphics::Region region(Common::Rect(0, 0, 10, 10));
+		region.unite(Common::Rect(14, 0, 20, 10));
+		region.unite(Common::Rect(40, 0, 50, 10));
+
+		region.simplify(4, 10);
+		TS_ASSERT_EQUALS(region.getRects().size(), 2u);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(0, 0, 20, 10));
+		TS_ASSERT_EQUALS(region.getRects()[1], Common::Rect(40, 0, 50, 10));
+
+		region.simplify(0, 1);
+		TS_ASSERT_EQUALS(region.getRects().size(), 1u);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(0, 0, 50, 10));
+	}
+};
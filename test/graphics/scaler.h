@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scalerplugin.h"
+#include "graphics/scaler/dotmatrix.h"
+#include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq-simd.h"
+#include "graphics/scaler/sai.h"
+#include "graphics/scaler/scalebit.h"
+#include "graphics/scaler/tv.h"
+
+class ScalerTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 40;
+	static const int kHeight = 50;
+	static const int kPadding = 4;
+	static const int kMaxFactor = 4;
+	static const int kSrcPitch = (kWidth + kPadding * 2) * 2;
+	static const int kDstPitch = kWidth * kMaxFactor * 2;
+
+	uint16 _src[(kHeight + kPadding * 2) * (kWidth + kPadding * 2)];
+	uint16 _whole[kHeight * kMaxFactor * kWidth * kMaxFactor];
+	uint16 _banded[kHeight * kMaxFactor * kWidth * kMaxFactor];
+
+	const uint8 *srcRow(int y) const {
+		return (const uint8 *)_src + (y + kPadding) * kSrcPitch + kPadding * 2;
+	}
+
+	/**
+	 * Scale the whole rect in one call and again band by band, the way
+	 * the thread pool splits it, and check both results are identical.
+	 */
+	void checkBands(Scaler &scaler, uint factor) {
+		scaler.setFactor(factor);
+		TS_ASSERT(scaler.isBandSafe());
+
+		memset(_whole, 0, sizeof(_whole));
+		memset(_banded, 0, sizeof(_banded));
+
+		scaler.scale(srcRow(0), kSrcPitch, (uint8 *)_whole, kDstPitch, kWidth, kHeight, 0, 0);
+
+		static const int bands[] = { 0, 9, 17, 33, kHeight };
+		for (int i = 0; i + 1 < ARRAYSIZE(bands); ++i) {
+			const int first = bands[i];
+			scaler.scale(srcRow(first), kSrcPitch, (uint8 *)_banded + first * factor * kDstPitch, kDstPitch,
+			             kWidth, bands[i + 1] - first, 0, first);
+		}
+
+		TS_ASSERT_EQUALS(memcmp(_whole, _banded, sizeof(_whole)), 0);
+	}
+
+public:
+	void setUp() {
+		uint32 seed = 0x12345678;
+		for (int i = 0; i < ARRAYSIZE(_src); ++i) {
+			seed = seed * 1103515245 + 12345;
+			// Use few colors so the edge detecting scalers see edges
+			_src[i] = (seed >> 16) & 0x8421;
+		}
+	}
+
+	void test_advmame() {
+#ifdef USE_SCALERS
+		AdvMameScaler scaler(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		for (uint factor = 2; factor <= 3; ++factor)
+			checkBands(scaler, factor);
+		scaler.setFactor(4);
+		TS_ASSERT(!scaler.isBandSafe());
+#endif
+	}
+
+	void test_sai() {
+#ifdef USE_SCALERS
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		SAIScaler sai(format);
+		checkBands(sai, 2);
+		SuperSAIScaler superSai(format);
+		checkBands(superSai, 2);
+		SuperEagleScaler superEagle(format);
+		checkBands(superEagle, 2);
+#endif
+	}
+
+	void test_dotmatrix_tv() {
+#ifdef USE_SCALERS
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		DotMatrixScaler dotMatrix(format);
+		checkBands(dotMatrix, 2);
+		TVScaler tv(format);
+		checkBands(tv, 2);
+#endif
+	}
+
+	void test_hq() {
+#ifdef USE_HQ_SCALERS
+		HQScaler scaler(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		checkBands(scaler, 2);
+		checkBands(scaler, 3);
+#endif
+	}
+
+	void test_hq_patterns() {
+#ifdef USE_HQ_SCALERS
+		// Values around the thresholds of every channel
+		static const int kRowWidth = 37;
+		uint32 rows[3][kRowWidth + 2];
+		uint32 seed = 0x9e3779b9;
+		for (int y = 0; y < 3; ++y) {
+			for (int x = 0; x < kRowWidth + 2; ++x) {
+				seed = seed * 1103515245 + 12345;
+				const int luma = 100 + (int)((seed >> 8) % 101) - 50;
+				const int u = 128 + (int)((seed >> 16) % 17) - 8;
+				const int v = 128 + (int)((seed >> 24) % 15) - 7;
+				rows[y][x] = (luma << 16) | (u << 8) | v;
+			}
+		}
+
+		byte expected[kRowWidth];
+		byte patterns[kRowWidth];
+		Graphics::hqPatternRow(expected, rows[0] + 1, rows[1] + 1, rows[2] + 1, kRowWidth);
+		Graphics::getHQPatternRowProc()(patterns, rows[0] + 1, rows[1] + 1, rows[2] + 1, kRowWidth);
+		TS_ASSERT_EQUALS(memcmp(expected, patterns, kRowWidth), 0);
+#ifdef SCUMMVM_SSE2
+		memset(patterns, 0, sizeof(patterns));
+		Graphics::hqPatternRowSSE2(patterns, rows[0] + 1, rows[1] + 1, rows[2] + 1, kRowWidth);
+		TS_ASSERT_EQUALS(memcmp(expected, patterns, kRowWidth), 0);
+#endif
+
+		bool sawAll = true;
+		for (int bit = 0; bit < 8; ++bit) {
+			bool set = false, clear = false;
+			for (int x = 0; x < kRowWidth; ++x) {
+				set |= (expected[x] & (1 << bit)) != 0;
+				clear |= (expected[x] & (1 << bit)) == 0;
+			}
+			sawAll &= set && clear;
+		}
+		TS_ASSERT(sawAll);
+#endif
+	}
+};
@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/tile-diff.h"
+
+class TileDiffTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 70;
+	static const int kHeight = 40;
+
+	byte _screen[kWidth * kHeight];
+	byte _frame[kWidth * kHeight];
+
+public:
+	void setUp() {
+		for (int i = 0; i < kWidth * kHeight; ++i)
+			_screen[i] = _frame[i] = i * 7;
+	}
+
+	void test_unchanged() {
+		Common::Array<Common::Rect> changed;
+		TS_ASSERT_EQUALS(Graphics::diffTiles(_screen, kWidth, _frame, kWidth, Common::Rect(kWidth, kHeight), 1, changed), 0u);
+		TS_ASSERT(changed.empty());
+	}
+
+	void test_single_pixel() {
+		_frame[20 * kWidth + 33] ^= 0xff;
+
+		Common::Array<Common::Rect> changed;
+		TS_ASSERT_EQUALS(Graphics::diffTiles(_screen, kWidth, _frame, kWidth, Common::Rect(kWidth, kHeight), 1, changed), 256u);
+		TS_ASSERT_EQUALS(changed.size(), 1u);
+		TS_ASSERT_EQUALS(changed[0], Common::Rect(32, 16, 48, 32));
+	}
+
+	void test_merge() {
+		// Two horizontally adjacent tiles in two bands form one rectangle,
+		// a second change in the last band becomes a rectangle clipped to
+		// the screen.
+		_frame[5 * kWidth + 10] ^= 0xff;
+		_frame[6 * kWidth + 20] ^= 0xff;
+		_frame[17 * kWidth + 0] ^= 0xff;
+		_frame[31 * kWidth + 31] ^= 0xff;
+		_frame[39 * kWidth + 69] ^= 0xff;
+
+		Common::Array<Common::Rect> changed;
+		TS_ASSERT_EQUALS(Graphics::diffTiles(_screen, kWidth, _frame, kWidth, Common::Rect(kWidth, kHeight), 1, changed), 32u * 32u + 6u * 8u);
+		TS_ASSERT_EQUALS(changed.size(), 2u);
+		TS_ASSERT_EQUALS(changed[0], Common::Rect(0, 0, 32, 32));
+		TS_ASSERT_EQUALS(changed[1], Common::Rect(64, 32, 70, 40));
+	}
+
+	void test_sub_rect() {
+		// The new pixels only cover part of the screen, unaligned to the
+		// tiles. The screen is used as 35x40 pixels of 2 bytes here.
+		const Common::Rect area(10, 5, 30, 25);
+		byte update[20 * 20 * 2];
+		for (int y = 0; y < area.height(); ++y) {
+			for (int x = 0; x < area.width() * 2; ++x)
+				update[y * area.width() * 2 + x] = _screen[(area.top + y) * kWidth + area.left * 2 + x];
+		}
+		update[(18 - area.top) * area.width() * 2 + (12 - area.left) * 2 + 1] ^= 0xff;
+
+		Common::Array<Common::Rect> changed;
+		TS_ASSERT_EQUALS(Graphics::diffTiles(_screen, kWidth, update, area.width() * 2, area, 2, changed), 6u * 9u);
+		TS_ASSERT_EQUALS(changed.size(), 1u);
+		TS_ASSERT_EQUALS(changed[0], Common::Rect(10, 16, 16, 25));
+	}
+};
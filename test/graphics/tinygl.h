@@ -0,0 +1,186 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zspan.h"
+#endif
+
+class TinyGLTestSuite : public CxxTest::TestSuite {
+#ifdef USE_TINYGL
+	static const int kWidth = 160;
+	static const int kHeight = 120;
+
+	static void drawScene(TinyGL::BlitImage *image) {
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+		tglBegin(TGL_TRIANGLES);
+		tglColor3f(1.0f, 0.0f, 0.0f);
+		tglVertex3f(-0.9f, -0.9f, 0.5f);
+		tglColor3f(0.0f, 1.0f, 0.0f);
+		tglVertex3f(0.8f, -0.7f, -0.5f);
+		tglColor3f(0.0f, 0.0f, 1.0f);
+		tglVertex3f(0.1f, 0.95f, 0.0f);
+		tglEnd();
+
+		// Partially outside of the screen, so it is clipped
+		tglBegin(TGL_TRIANGLE_STRIP);
+		tglColor3f(1.0f, 1.0f, 0.0f);
+		tglVertex3f(-1.5f, 0.2f, 0.2f);
+		tglVertex3f(-0.2f, -0.1f, -0.2f);
+		tglColor3f(0.0f, 1.0f, 1.0f);
+		tglVertex3f(-0.8f, 1.4f, 0.1f);
+		tglVertex3f(0.6f, 0.6f, -0.9f);
+		tglEnd();
+
+		// A blit between rasterizations splits the frame in two batches
+		tglBlit(image, 30, 50);
+
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglBegin(TGL_QUADS);
+		tglColor4f(1.0f, 1.0f, 1.0f, 0.5f);
+		tglVertex3f(-0.5f, -0.5f, -0.95f);
+		tglVertex3f(0.5f, -0.5f, -0.95f);
+		tglVertex3f(0.5f, 0.5f, -0.95f);
+		tglVertex3f(-0.5f, 0.5f, -0.95f);
+		tglEnd();
+		tglDisable(TGL_BLEND);
+		tglDisable(TGL_DEPTH_TEST);
+	}
+
+	/**
+	 * Render the same frame serially and in tiles and return whether both
+	 * produced the same pixels.
+	 */
+	static bool renderMatches(bool dirtyRects) {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		Graphics::Surface expected;
+		bool result = true;
+
+		for (int tiled = 0; tiled < 2; ++tiled) {
+			TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 256, false, dirtyRects);
+			TinyGL::enableTiledRendering(tiled != 0);
+
+			Graphics::Surface sprite;
+			sprite.create(40, 20, format);
+			for (int y = 0; y < sprite.h; ++y) {
+				for (int x = 0; x < sprite.w; ++x) {
+					sprite.setPixel(x, y, format.ARGBToColor(255, x * 6, y * 12, 128));
+				}
+			}
+			TinyGL::BlitImage *image = tglGenBlitImage();
+			tglUploadBlitImage(image, sprite, 0, false);
+			sprite.free();
+
+			// Tiling takes effect from the frame after it has been enabled
+			tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+			TinyGL::presentBuffer();
+			drawScene(image);
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			if (!tiled) {
+				expected.copyFrom(surface);
+			} else {
+				result = memcmp(expected.getPixels(), surface.getPixels(), surface.pitch * surface.h) == 0;
+			}
+
+			tglDeleteBlitImage(image);
+			TinyGL::destroyContext(context);
+		}
+
+		expected.free();
+		return result;
+	}
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 8) ^ (seed << 16);
+	}
+
+	/**
+	 * Fill random spans with @p procs and with fillSpanPixels() and check
+	 * that both produce the same pixels and depth values.
+	 */
+	static bool spansMatch(const TinyGL::ZBufferSpanProc *procs) {
+		static const int kCount = 45;
+		uint32 texels[kCount], expectedPixels[kCount], pixels[kCount];
+		uint expectedDepth[kCount], depth[kCount];
+		uint32 seed = 0x2545f491;
+		bool result = true;
+
+		for (int index = 0; index < TinyGL::kZBufferSpanProcCount; ++index) {
+			for (int run = 0; run < 8; ++run) {
+				TinyGL::ZBufferSpanState state;
+				state.depthTest = (index & 1) != 0;
+				state.depthWrite = (index & 2) != 0;
+				state.blending = (index & 4) != 0;
+				state.texture = (index & 8) != 0;
+				state.clipLeft = 10 + run;
+				state.clipRight = 10 + kCount - run * 2;
+				state.aLoss = run & 1 ? 8 : 0;
+				state.aShift = 24;
+				state.rShift = 16;
+				state.gShift = 8;
+				state.bShift = 0;
+
+				TinyGL::ZBufferSpan span;
+				span.texels = texels;
+				span.x = 10;
+				span.count = kCount - run;
+				span.z = (nextRandom(seed) & 0x3FFFFFFF) + 0x10000000;
+				span.dzdx = (int)(nextRandom(seed) % 0x80000) - 0x40000;
+				span.r = nextRandom(seed) & 0xFFFF;
+				span.g = nextRandom(seed) & 0xFFFF;
+				span.b = nextRandom(seed) & 0xFFFF;
+				span.a = nextRandom(seed) & 0xFFFF;
+				span.drdx = (int)(nextRandom(seed) % 0x400) - 0x200;
+				span.dgdx = (int)(nextRandom(seed) % 0x400) - 0x200;
+				span.dbdx = (int)(nextRandom(seed) % 0x400) - 0x200;
+				span.dadx = (int)(nextRandom(seed) % 0x400) - 0x200;
+				for (int i = 0; i < kCount; ++i) {
+					texels[i] = nextRandom(seed);
+					expectedPixels[i] = pixels[i] = nextRandom(seed);
+					expectedDepth[i] = depth[i] = span.z + (nextRandom(seed) % 0x1000000) - 0x800000;
+				}
+
+				span.pixels = expectedPixels;
+				span.depth = expectedDepth;
+				TinyGL::fillSpanPixels(state, span, 0);
+				span.pixels = pixels;
+				span.depth = depth;
+				procs[index](state, span);
+
+				result &= memcmp(expectedPixels, pixels, sizeof(pixels)) == 0;
+				result &= memcmp(expectedDepth, depth, sizeof(depth)) == 0;
+			}
+		}
+		return result;
+	}
+#endif
+
+public:
+	void test_tiled_rendering() {
+#ifdef USE_TINYGL
+		TS_ASSERT(renderMatches(false));
+		TS_ASSERT(renderMatches(true));
+#endif
+	}
+
+	void test_span_kernels() {
+#ifdef USE_TINYGL
+		const TinyGL::ZBufferSpanProc *procs = TinyGL::getZBufferSpanProcs();
+		if (procs)
+			TS_ASSERT(spansMatch(procs));
+#ifdef SCUMMVM_SSE2
+		TS_ASSERT(spansMatch(TinyGL::zbufferSpanProcsSSE2));
+#endif
+#endif
+	}
+};
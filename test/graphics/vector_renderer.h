@@ -0,0 +1,123 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "graphics/VectorRendererSpec-simd.h"
+
+class VectorRendererTestSuite : public CxxTest::TestSuite {
+	static void fill(byte *dst, uint size, uint32 seed) {
+		for (uint i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			dst[i] = (byte)(seed >> 16);
+		}
+	}
+
+	static uint32 channelMask(uint8 loss, uint8 shift) {
+		return (0xFF >> loss) << shift;
+	}
+
+	/** Same math as VectorRendererSpec::blendPixelPtr(). */
+	template<typename PixelType>
+	static PixelType blendReference(const Graphics::PixelFormat &format, PixelType dst, PixelType color, uint8 alpha) {
+		const uint32 masks[4] = {
+			channelMask(format.rLoss, format.rShift), channelMask(format.gLoss, format.gShift),
+			channelMask(format.bLoss, format.bShift), channelMask(format.aLoss, format.aShift)
+		};
+		const uint8 shifts[4] = { format.rShift, format.gShift, format.bShift, format.aShift };
+
+		uint32 result = 0;
+		for (int i = 0; i < 4; ++i) {
+			if (sizeof(PixelType) == 4) {
+				const byte s = i == 3 ? 0xff : (byte)((color & masks[i]) >> shifts[i]);
+				byte d = (byte)((dst & masks[i]) >> shifts[i]);
+				d += ((s - d) * alpha) >> 8;
+				result |= ((uint32)d << shifts[i]) & masks[i];
+			} else {
+				const int s = i == 3 ? (int)masks[i] : (int)(color & masks[i]);
+				const int d = (int)(dst & masks[i]);
+				result |= masks[i] & (d + (((s - d) * alpha) >> 8));
+			}
+		}
+		return (PixelType)result;
+	}
+
+	template<typename PixelType>
+	void checkBlend(const Graphics::PixelFormat &format, bool byteChannels) {
+		Graphics::BlendRowProc blendRow = Graphics::getBlendRowProc(sizeof(PixelType), byteChannels);
+		if (!blendRow)
+			return;
+
+		const uint32 masks[4] = {
+			channelMask(format.rLoss, format.rShift), channelMask(format.gLoss, format.gShift),
+			channelMask(format.bLoss, format.bShift), channelMask(format.aLoss, format.aShift)
+		};
+
+		const uint count = 67;
+		PixelType pixels[count], expected[count];
+		for (uint32 seed = 1; seed < 64; ++seed) {
+			fill((byte *)pixels, sizeof(pixels), seed);
+			PixelType color;
+			fill((byte *)&color, sizeof(color), seed + 1000);
+			const uint8 alpha = (uint8)(seed * 37 % 255);
+
+			for (uint i = 0; i < count; ++i)
+				expected[i] = blendReference<PixelType>(format, pixels[i], color, alpha);
+
+			Graphics::SpanBlend blend;
+			blend.setup(masks, color, alpha);
+			const uint done = blendRow(pixels + 1, count - 1, blend);
+			TS_ASSERT(done <= count - 1);
+			TS_ASSERT(done + 8 > count - 1);
+
+			for (uint i = 1; i <= done; ++i)
+				TS_ASSERT_EQUALS(pixels[i], expected[i]);
+		}
+	}
+
+	template<typename PixelType>
+	void checkPatternFill() {
+		Graphics::PatternFillRowProc fillRow = Graphics::getPatternFillRowProc(sizeof(PixelType));
+		if (!fillRow)
+			return;
+
+		const uint count = 45;
+		PixelType pixels[count + 2];
+		for (uint i = 0; i < count + 2; ++i)
+			pixels[i] = 0x5a5a;
+
+		const uint done = fillRow(pixels + 1, count, 0x1234, 0xabcd);
+		TS_ASSERT(done <= count);
+		TS_ASSERT(done + 8 > count);
+
+		TS_ASSERT_EQUALS(pixels[0], 0x5a5a);
+		for (uint i = 0; i < done; ++i)
+			TS_ASSERT_EQUALS(pixels[i + 1], (i & 1) ? 0xabcd : 0x1234);
+		for (uint i = done; i <= count; ++i)
+			TS_ASSERT_EQUALS(pixels[i + 1], 0x5a5a);
+	}
+
+public:
+	void test_blend_rgb565() {
+		checkBlend<uint16>(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), false);
+	}
+
+	void test_blend_argb1555() {
+		checkBlend<uint16>(Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15), false);
+	}
+
+	void test_blend_argb8888() {
+		checkBlend<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), true);
+	}
+
+	void test_blend_xrgb8888() {
+		checkBlend<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), true);
+	}
+
+	void test_blend_rgba8888() {
+		checkBlend<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), true);
+	}
+
+	void test_pattern_fill() {
+		checkPatternFill<uint16>();
+		checkPatternFill<uint32>();
+	}
+};
@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		k444,
+		k422,
+		k420,
+		k420Alpha
+	};
+
+	static void fill(byte *dst, uint size, uint32 seed) {
+		for (uint i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			dst[i] = (byte)(seed >> 16);
+		}
+	}
+
+	static void convert(Graphics::Surface &dst, Subsampling subsampling, Graphics::YUVToRGBManager::LuminanceScale scale,
+	                    const byte *y, const byte *u, const byte *v, const byte *a, int width, int height, int uvPitch) {
+		switch (subsampling) {
+		case k444:
+			YUVToRGBMan.convert444(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k422:
+			YUVToRGBMan.convert422(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k420Alpha:
+			YUVToRGBMan.convert420Alpha(&dst, scale, y, u, v, a, width, height, width, uvPitch);
+			break;
+		}
+	}
+
+	/**
+	 * Convert random planes with the vector kernels and with the lookup
+	 * tables and check that both produce the same pixels.
+	 */
+	void check(const Graphics::PixelFormat &format, Subsampling subsampling, int width, int height) {
+		const int uvPitch = subsampling == k444 ? width : width / 2;
+		const int uvHeight = subsampling == k444 || subsampling == k422 ? height : height / 2;
+		byte *y = new byte[width * height];
+		byte *a = new byte[width * height];
+		byte *u = new byte[uvPitch * uvHeight];
+		byte *v = new byte[uvPitch * uvHeight];
+		fill(y, width * height, 1);
+		fill(a, width * height, 2);
+		fill(u, uvPitch * uvHeight, 3);
+		fill(v, uvPitch * uvHeight, 4);
+
+		Graphics::Surface expected, actual;
+		expected.create(width, height, format);
+		actual.create(width, height, format);
+
+		for (int s = 0; s < 2; ++s) {
+			const Graphics::YUVToRGBManager::LuminanceScale scale = s ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+
+			YUVToRGBMan.setUseSIMD(false);
+			convert(expected, subsampling, scale, y, u, v, a, width, height, uvPitch);
+			YUVToRGBMan.setUseSIMD(true);
+			convert(actual, subsampling, scale, y, u, v, a, width, height, uvPitch);
+
+			TS_ASSERT_EQUALS(memcmp(expected.getPixels(), actual.getPixels(), expected.pitch * height), 0);
+		}
+
+		expected.free();
+		actual.free();
+		delete[] y;
+		delete[] a;
+		delete[] u;
+		delete[] v;
+	}
+
+public:
+	void test_rgb565() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		check(format, k444, 38, 6);
+		check(format, k422, 38, 6);
+		check(format, k420, 38, 6);
+		check(format, k420Alpha, 38, 6);
+	}
+
+	void test_argb4444() {
+		const Graphics::PixelFormat format(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		check(format, k420, 38, 6);
+		check(format, k420Alpha, 38, 6);
+	}
+
+	void test_rgba8888() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		check(format, k444, 38, 6);
+		check(format, k422, 38, 6);
+		check(format, k420, 38, 6);
+		check(format, k420Alpha, 38, 6);
+	}
+
+	void test_large_frame() {
+		// Large frames are converted in bands
+		check(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), k420, 640, 480);
+	}
+};
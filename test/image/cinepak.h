@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/util.h"
+#include "image/codecs/cinepak.h"
+#include "graphics/surface.h"
+
+#include "../null_osystem.h"
+
+class CinepakDecoderTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 24;
+	static const int kHeight = 16;
+
+	Common::MemoryWriteStreamDynamic _frame;
+	byte _v1[256][6], _v4[256][6];
+	byte _blocks[kHeight / 4][kWidth / 4][5]; // 0 for v1, 1 for v4 followed by the indices
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static void writeChunkHeader(Common::WriteStream &stream, byte id, uint32 size) {
+		stream.writeByte(id);
+		stream.writeByte((size + 4) >> 16);
+		stream.writeUint16BE((size + 4) & 0xFFFF);
+	}
+
+	static byte clip(int value) {
+		return CLIP(value, 0, 255);
+	}
+
+	/** The color of luma @p y of a codebook entry, as Cinepak defines it. */
+	static uint32 expectedColor(const Graphics::PixelFormat &format, const byte *entry, int y) {
+		const int u = (int8)entry[4], v = (int8)entry[5];
+		return format.RGBToColor(clip(entry[y] + (v << 1)), clip(entry[y] - (u >> 1) - v), clip(entry[y] + (u << 1)));
+	}
+
+public:
+	CinepakDecoderTestSuite() : _frame(DisposeAfterUse::YES) {
+		uint32 seed = 0x6b8b4567;
+		for (int i = 0; i < 256; ++i) {
+			for (int j = 0; j < 6; ++j) {
+				_v1[i][j] = nextRandom(seed);
+				_v4[i][j] = nextRandom(seed);
+			}
+		}
+
+		// Encode the vectors of a key frame, one flag per block chooses v1 or v4
+		Common::MemoryWriteStreamDynamic vectors(DisposeAfterUse::YES);
+		int flagPos = -1, bits = 0;
+		uint32 flags = 0;
+		for (int by = 0; by < kHeight / 4; ++by) {
+			for (int bx = 0; bx < kWidth / 4; ++bx) {
+				byte *block = _blocks[by][bx];
+				block[0] = nextRandom(seed) & 1;
+				for (int i = 1; i < 5; ++i)
+					block[i] = nextRandom(seed);
+
+				if (bits == 0) {
+					if (flagPos >= 0) {
+						vectors.seek(flagPos);
+						vectors.writeUint32BE(flags);
+						vectors.seek(0, SEEK_END);
+					}
+					flagPos = vectors.pos();
+					vectors.writeUint32BE(0);
+					flags = 0;
+					bits = 32;
+				}
+				--bits;
+				if (block[0])
+					flags |= 1 << bits;
+
+				vectors.write(block + 1, block[0] ? 4 : 1);
+			}
+		}
+		vectors.seek(flagPos);
+		vectors.writeUint32BE(flags);
+
+		const uint32 stripSize = 12 + 2 * (4 + 256 * 6) + 4 + vectors.size();
+		_frame.writeByte(1);
+		_frame.writeByte(0);
+		_frame.writeUint16BE(10 + stripSize);
+		_frame.writeUint16BE(kWidth);
+		_frame.writeUint16BE(kHeight);
+		_frame.writeUint16BE(1);
+
+		_frame.writeUint16BE(0x1000);
+		_frame.writeUint16BE(stripSize);
+		_frame.writeUint16BE(0);
+		_frame.writeUint16BE(0);
+		_frame.writeUint16BE(kHeight);
+		_frame.writeUint16BE(kWidth);
+
+		writeChunkHeader(_frame, 0x20, 256 * 6);
+		_frame.write(_v4, sizeof(_v4));
+		writeChunkHeader(_frame, 0x22, 256 * 6);
+		_frame.write(_v1, sizeof(_v1));
+		writeChunkHeader(_frame, 0x30, vectors.size());
+		_frame.write(vectors.getData(), vectors.size());
+	}
+
+	void check(const Graphics::PixelFormat &format) {
+		// The decoder defaults to the screen format
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		Image::CinepakDecoder decoder;
+		TS_ASSERT(decoder.setOutputPixelFormat(format));
+
+		Common::MemoryReadStream stream(_frame.getData(), _frame.size());
+		const Graphics::Surface *surface = decoder.decodeFrame(stream);
+		TS_ASSERT(surface);
+		if (!surface)
+			return;
+		TS_ASSERT_EQUALS(surface->format, format);
+
+		bool matches = true;
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth; ++x) {
+				const byte *block = _blocks[y / 4][x / 4];
+				uint32 expected;
+				if (block[0]) {
+					const int quarter = ((y & 2) ? 2 : 0) + ((x & 2) ? 1 : 0);
+					expected = expectedColor(format, _v4[block[1 + quarter]], (y & 1) * 2 + (x & 1));
+				} else {
+					expected = expectedColor(format, _v1[block[1]], ((y & 2) ? 2 : 0) + ((x & 2) ? 1 : 0));
+				}
+				matches &= surface->getPixel(x, y) == expected;
+			}
+		}
+		TS_ASSERT(matches);
+	}
+
+	void test_rgb565() {
+		check(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_rgba8888() {
+		check(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+	typedef Image::Indeo::IndeoDSP IndeoDSP;
+	typedef Image::Indeo::InvTransformPtr InvTransformPtr;
+	typedef Image::Indeo::IviMCFunc IviMCFunc;
+	typedef Image::Indeo::IviMCAvgFunc IviMCAvgFunc;
+
+	static const int kPitch = 21;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	/**
+	 * Run @p transform and its fast version on the same random blocks,
+	 * with some empty columns and rows, and check that they produce the
+	 * same values.
+	 */
+	static bool transformsMatch(InvTransformPtr *transform) {
+		InvTransformPtr *fast = IndeoDSP::getFastTransform(transform);
+		uint32 seed = 0x1b873593;
+		bool result = true;
+
+		for (int run = 0; run < 64; ++run) {
+			int32 coeffs[64];
+			uint8 flags[8];
+			const int range = run & 1 ? 8192 : 256;
+			for (int i = 0; i < 8; ++i)
+				flags[i] = nextRandom(seed) % 4 != 0;
+			for (int i = 0; i < 64; ++i)
+				coeffs[i] = nextRandom(seed) % 8 != 0 ? (int)(nextRandom(seed) % (range * 2)) - range : 0;
+			// Clear a row, which lets the scalar code take its shortcut
+			memset(coeffs + (run % 8) * 8, 0, 8 * sizeof(coeffs[0]));
+
+			int16 expected[8 * kPitch], actual[8 * kPitch];
+			memset(expected, 0x55, sizeof(expected));
+			memset(actual, 0x55, sizeof(actual));
+			transform(coeffs, expected, kPitch, flags);
+			fast(coeffs, actual, kPitch, flags);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+		}
+		return result;
+	}
+
+	static void fillReference(int16 *ref, int size, uint32 &seed, int range) {
+		for (int i = 0; i < size; ++i)
+			ref[i] = (int)(nextRandom(seed) % (range * 2)) - range;
+	}
+
+	/** Check that @p mc and its fast version produce the same values for all interpolation types. */
+	static bool mcMatches(IviMCFunc mc) {
+		IviMCFunc fast = IndeoDSP::getFastMC(mc);
+		uint32 seed = 0xcc9e2d51;
+		bool result = true;
+
+		for (int run = 0; run < 32; ++run) {
+			int16 ref[9 * kPitch], pixels[8 * kPitch];
+			const int range = run & 1 ? 32768 : 512;
+			fillReference(ref, ARRAYSIZE(ref), seed, range);
+			fillReference(pixels, ARRAYSIZE(pixels), seed, range);
+
+			int16 expected[8 * kPitch], actual[8 * kPitch];
+			memcpy(expected, pixels, sizeof(pixels));
+			memcpy(actual, pixels, sizeof(pixels));
+			mc(expected, ref, kPitch, run % 4);
+			fast(actual, ref, kPitch, run % 4);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+		}
+		return result;
+	}
+
+	static bool mcAvgMatches(IviMCAvgFunc mcAvg) {
+		IviMCAvgFunc fast = IndeoDSP::getFastMCAvg(mcAvg);
+		uint32 seed = 0x85ebca6b;
+		bool result = true;
+
+		for (int run = 0; run < 32; ++run) {
+			int16 ref[9 * kPitch], ref2[9 * kPitch], pixels[8 * kPitch];
+			const int range = run & 1 ? 32768 : 512;
+			fillReference(ref, ARRAYSIZE(ref), seed, range);
+			fillReference(ref2, ARRAYSIZE(ref2), seed, range);
+			fillReference(pixels, ARRAYSIZE(pixels), seed, range);
+
+			int16 expected[8 * kPitch], actual[8 * kPitch];
+			memcpy(expected, pixels, sizeof(pixels));
+			memcpy(actual, pixels, sizeof(pixels));
+			mcAvg(expected, ref, ref2, kPitch, run % 4, (run / 4) % 4);
+			fast(actual, ref, ref2, kPitch, run % 4, (run / 4) % 4);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+		}
+		return result;
+	}
+
+public:
+	void test_transforms() {
+		TS_ASSERT(transformsMatch(IndeoDSP::ffIviInverseHaar8x8));
+		TS_ASSERT(transformsMatch(IndeoDSP::ffIviInverseSlant8x8));
+		TS_ASSERT(transformsMatch(IndeoDSP::ffIviRowSlant8));
+		TS_ASSERT(transformsMatch(IndeoDSP::ffIviColSlant8));
+	}
+
+	void test_motion_compensation() {
+		TS_ASSERT(mcMatches(IndeoDSP::ffIviMc8x8Delta));
+		TS_ASSERT(mcMatches(IndeoDSP::ffIviMc8x8NoDelta));
+		TS_ASSERT(mcMatches(IndeoDSP::ffIviMc4x4Delta));
+		TS_ASSERT(mcMatches(IndeoDSP::ffIviMc4x4NoDelta));
+		TS_ASSERT(mcAvgMatches(IndeoDSP::ffIviMcAvg8x8Delta));
+		TS_ASSERT(mcAvgMatches(IndeoDSP::ffIviMcAvg8x8NoDelta));
+		TS_ASSERT(mcAvgMatches(IndeoDSP::ffIviMcAvg4x4Delta));
+		TS_ASSERT(mcAvgMatches(IndeoDSP::ffIviMcAvg4x4NoDelta));
+	}
+};
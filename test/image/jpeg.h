@@ -0,0 +1,136 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/jpeg.h"
+#include "graphics/surface.h"
+
+class JPEGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_JPEG
+	/**
+	 * Decode @p data into planes and as interleaved YUV, and check that
+	 * the planes have the expected sizes and the luma plane matches.
+	 */
+	static void checkPlanes(const byte *data, uint size, int chromaWidth, int chromaHeight, bool compareChroma) {
+		Image::JPEGDecoder interleaved;
+		interleaved.setOutputColorSpace(Image::JPEGDecoder::kColorSpaceYUV);
+		Common::MemoryReadStream stream(data, size);
+		TS_ASSERT(interleaved.loadStream(stream));
+		const Graphics::Surface *yuv = interleaved.getSurface();
+		TS_ASSERT(!interleaved.getYUVPlane(0));
+
+		Image::JPEGDecoder planar;
+		planar.setOutputColorSpace(Image::JPEGDecoder::kColorSpaceYUVPlanar);
+		stream.seek(0);
+		TS_ASSERT(planar.loadStream(stream));
+
+		const Graphics::Surface *planes[3];
+		for (int i = 0; i < 3; ++i) {
+			planes[i] = planar.getYUVPlane(i);
+			TS_ASSERT(planes[i]);
+			if (!planes[i])
+				return;
+			TS_ASSERT_EQUALS(planes[i]->format.bytesPerPixel, 1);
+		}
+
+		TS_ASSERT_EQUALS(planes[0]->w, yuv->w);
+		TS_ASSERT_EQUALS(planes[0]->h, yuv->h);
+		for (int i = 1; i < 3; ++i) {
+			TS_ASSERT_EQUALS(planes[i]->w, chromaWidth);
+			TS_ASSERT_EQUALS(planes[i]->h, chromaHeight);
+		}
+
+		bool matches = true;
+		for (int y = 0; y < yuv->h; ++y) {
+			const byte *pixel = (const byte *)yuv->getBasePtr(0, y);
+			for (int x = 0; x < yuv->w; ++x, pixel += 3) {
+				matches &= *(const byte *)planes[0]->getBasePtr(x, y) == pixel[0];
+				if (compareChroma) {
+					matches &= *(const byte *)planes[1]->getBasePtr(x, y) == pixel[1];
+					matches &= *(const byte *)planes[2]->getBasePtr(x, y) == pixel[2];
+				}
+			}
+		}
+		TS_ASSERT(matches);
+	}
+#endif
+
+public:
+	void test_planes_420() {
+#ifdef USE_JPEG
+		static const byte jpeg420[352] = {
+			0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+			0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+			0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+			0x09, 0x08, 0x0a, 0x0c, 0x14, 0x0d, 0x0c, 0x0b, 0x0b, 0x0c, 0x19, 0x12,
+			0x13, 0x0f, 0x14, 0x1d, 0x1a, 0x1f, 0x1e, 0x1d, 0x1a, 0x1c, 0x1c, 0x20,
+			0x24, 0x2e, 0x27, 0x20, 0x22, 0x2c, 0x23, 0x1c, 0x1c, 0x28, 0x37, 0x29,
+			0x2c, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1f, 0x27, 0x39, 0x3d, 0x38, 0x32,
+			0x3c, 0x2e, 0x33, 0x34, 0x32, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x09, 0x09,
+			0x09, 0x0c, 0x0b, 0x0c, 0x18, 0x0d, 0x0d, 0x18, 0x32, 0x21, 0x1c, 0x21,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x0c, 0x00, 0x14, 0x03,
+			0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+			0x16, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0xff, 0xc4, 0x00,
+			0x1e, 0x10, 0x00, 0x02, 0x01, 0x04, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x22, 0x01, 0x03, 0x06,
+			0xa1, 0x13, 0x21, 0x31, 0x23, 0xff, 0xc4, 0x00, 0x16, 0x01, 0x01, 0x01,
+			0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x04, 0x05, 0x06, 0xff, 0xc4, 0x00, 0x1b, 0x11, 0x00, 0x01,
+			0x05, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x12, 0x21, 0xff, 0xda,
+			0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00,
+			0xce, 0x52, 0xc6, 0x7c, 0x86, 0x84, 0x69, 0x63, 0x3e, 0x43, 0x43, 0x14,
+			0x90, 0x5f, 0xa8, 0x08, 0x92, 0x41, 0x7e, 0xa0, 0x02, 0x3b, 0x8e, 0x27,
+			0xe4, 0xee, 0x4b, 0xe0, 0x22, 0xd6, 0x33, 0xf3, 0xa4, 0x34, 0x46, 0xa9,
+			0x69, 0x05, 0xf8, 0xe9, 0x02, 0x12, 0x97, 0x1c, 0x6d, 0x99, 0xb9, 0x2f,
+			0x28, 0x7f, 0xff, 0xd9,
+		};
+
+		checkPlanes(jpeg420, sizeof(jpeg420), 10, 6, false);
+#endif
+	}
+
+	void test_planes_444() {
+#ifdef USE_JPEG
+		static const byte jpeg444[318] = {
+			0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+			0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+			0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+			0x09, 0x08, 0x0a, 0x0c, 0x14, 0x0d, 0x0c, 0x0b, 0x0b, 0x0c, 0x19, 0x12,
+			0x13, 0x0f, 0x14, 0x1d, 0x1a, 0x1f, 0x1e, 0x1d, 0x1a, 0x1c, 0x1c, 0x20,
+			0x24, 0x2e, 0x27, 0x20, 0x22, 0x2c, 0x23, 0x1c, 0x1c, 0x28, 0x37, 0x29,
+			0x2c, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1f, 0x27, 0x39, 0x3d, 0x38, 0x32,
+			0x3c, 0x2e, 0x33, 0x34, 0x32, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x09, 0x09,
+			0x09, 0x0c, 0x0b, 0x0c, 0x18, 0x0d, 0x0d, 0x18, 0x32, 0x21, 0x1c, 0x21,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+			0x32, 0x32, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x07, 0x00, 0x09, 0x03,
+			0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+			0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x07, 0xff, 0xc4, 0x00, 0x1b,
+			0x10, 0x00, 0x01, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x21, 0x06, 0x16,
+			0x51, 0xff, 0xc4, 0x00, 0x16, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03,
+			0x05, 0xff, 0xc4, 0x00, 0x1b, 0x11, 0x00, 0x02, 0x01, 0x05, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+			0x02, 0x03, 0x04, 0x05, 0x13, 0x15, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01,
+			0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0x9c, 0x42, 0xc7, 0x1b,
+			0x54, 0x81, 0xe3, 0x5c, 0x35, 0xa6, 0x45, 0x89, 0xeb, 0x8d, 0xe2, 0x14,
+			0xde, 0x6b, 0x74, 0x19, 0xff, 0xd9,
+		};
+
+		checkPlanes(jpeg444, sizeof(jpeg444), 9, 7, true);
+#endif
+	}
+};
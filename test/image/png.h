@@ -0,0 +1,114 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_PNG
+	static const int kWidth = 13;
+	static const int kHeight = 7;
+
+	Graphics::PixelFormat _rgba;
+	Common::MemoryWriteStreamDynamic _png;
+
+	static void countRows(void *param, uint rowsDone, uint rowsTotal) {
+		uint *rows = (uint *)param;
+		if (rowsDone == rows[0] + 1 && rowsTotal == kHeight)
+			rows[0] = rowsDone;
+	}
+
+public:
+	PNGDecoderTestSuite() : _rgba(4, 8, 8, 8, 8, 24, 16, 8, 0), _png(DisposeAfterUse::YES) {
+		Graphics::Surface image;
+		image.create(kWidth, kHeight, _rgba);
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth; ++x)
+				image.setPixel(x, y, _rgba.ARGBToColor(x * 19, y * 36, x * y * 2, 255 - x * 7));
+		}
+		Image::writePNG(_png, image);
+		image.free();
+	}
+
+	void test_load_into_format() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			Image::PNGDecoder decoder;
+			Common::MemoryReadStream stream(_png.getData(), _png.size());
+			TS_ASSERT(decoder.loadStream(stream));
+			Graphics::Surface *expected = decoder.getSurface()->convertTo(formats[i]);
+
+			Graphics::Surface actual;
+			uint rows[1] = { 0 };
+			stream.seek(0);
+			TS_ASSERT(decoder.loadStreamInto(stream, actual, formats[i], 0, &countRows, rows));
+			TS_ASSERT_EQUALS(rows[0], (uint)kHeight);
+			TS_ASSERT_EQUALS(actual.w, kWidth);
+			TS_ASSERT_EQUALS(actual.h, kHeight);
+			TS_ASSERT_EQUALS(actual.format, formats[i]);
+			for (int y = 0; y < kHeight; ++y)
+				TS_ASSERT_EQUALS(memcmp(expected->getBasePtr(0, y), actual.getBasePtr(0, y), kWidth * formats[i].bytesPerPixel), 0);
+
+			// A surface that is too small is rejected
+			Graphics::Surface small;
+			small.create(kWidth - 1, kHeight, formats[i]);
+			stream.seek(0);
+			TS_ASSERT(!decoder.loadStreamInto(stream, small, formats[i]));
+
+			small.free();
+			actual.free();
+			expected->free();
+			delete expected;
+		}
+	}
+
+	void test_load_downscaled() {
+		Image::PNGDecoder decoder;
+		Common::MemoryReadStream stream(_png.getData(), _png.size());
+		TS_ASSERT(decoder.loadStream(stream));
+		const Graphics::Surface *image = decoder.getSurface();
+		Graphics::Surface *full = image->convertTo(_rgba);
+
+		// Decode into a larger surface, which must be left alone outside the image
+		Graphics::Surface scaled;
+		scaled.create(8, 8, _rgba);
+		memset(scaled.getPixels(), 0x5A, scaled.pitch * scaled.h);
+		stream.seek(0);
+		TS_ASSERT(decoder.loadStreamInto(stream, scaled, _rgba, 1));
+
+		for (int y = 0; y < 4; ++y) {
+			for (int x = 0; x < 7; ++x) {
+				uint sums[4] = { 0, 0, 0, 0 }, count = 0;
+				for (int sy = y * 2; sy < MIN(y * 2 + 2, kHeight); ++sy) {
+					for (int sx = x * 2; sx < MIN(x * 2 + 2, kWidth); ++sx) {
+						uint8 a, r, g, b;
+						_rgba.colorToARGB(full->getPixel(sx, sy), a, r, g, b);
+						sums[0] += a;
+						sums[1] += r;
+						sums[2] += g;
+						sums[3] += b;
+						++count;
+					}
+				}
+
+				const uint32 expected = _rgba.ARGBToColor((sums[0] + count / 2) / count, (sums[1] + count / 2) / count,
+				                                          (sums[2] + count / 2) / count, (sums[3] + count / 2) / count);
+				TS_ASSERT_EQUALS(scaled.getPixel(x, y), expected);
+			}
+			TS_ASSERT_EQUALS(scaled.getPixel(7, y), 0x5A5A5A5Au);
+		}
+
+		scaled.free();
+		full->free();
+		delete full;
+	}
+#endif
+};
@@ -0,0 +1,224 @@
+#include <cxxtest/TestSuite.h>
+
+#include "math/cosinetables.h"
+#include "math/fft.h"
+#include "math/frustum.h"
+#include "math/rdft.h"
+#include "math/simd.h"
+#include "math/utils.h"
+
+class MathSimdTestSuite : public CxxTest::TestSuite {
+	static float value(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return ((int)((seed >> 8) & 0xFFFF) - 0x8000) / 1024.0f;
+	}
+
+	// The compiler may fuse the multiplications and additions of the scalar code
+	static bool nearlyEqual(float a, float b) {
+		return fabs(a - b) <= 1e-5f * MAX(1.0f, MAX(fabs(a), fabs(b)));
+	}
+
+	static void checkKernels(const Math::MathKernels &kernels) {
+		const Math::MathKernels &scalar = Math::mathKernelsScalar;
+		uint32 seed = 1;
+
+		float a[16], b[16], r[16], expected[16];
+		for (int i = 0; i < 16; i++) {
+			a[i] = value(seed);
+			b[i] = value(seed);
+		}
+		kernels.multiplyMatrix4(r, a, b);
+		scalar.multiplyMatrix4(expected, a, b);
+		for (int i = 0; i < 16; i++)
+			TS_ASSERT(nearlyEqual(r[i], expected[i]));
+
+		// An odd number of points, to cover the tail of the vectorized loops
+		const uint count = 11;
+		float in[count * 3], out[count * 3], expectedOut[count * 3];
+		for (uint i = 0; i < count * 3; i++)
+			in[i] = value(seed);
+
+		for (int translate = 0; translate < 2; translate++) {
+			kernels.transformPoints(a, in, out, count, translate);
+			scalar.transformPoints(a, in, expectedOut, count, translate);
+			for (uint i = 0; i < count * 3; i++)
+				TS_ASSERT(nearlyEqual(out[i], expectedOut[i]));
+		}
+
+		// In place
+		kernels.transformPoints(a, in, in, count, 1.0f);
+		for (uint i = 0; i < count * 3; i++)
+			TS_ASSERT(nearlyEqual(in[i], expectedOut[i]));
+
+		float planes[24];
+		for (int i = 0; i < 24; i++)
+			planes[i] = value(seed);
+
+		const uint boxCount = 50;
+		float boxes[boxCount * 6];
+		for (uint i = 0; i < boxCount; i++) {
+			for (int c = 0; c < 3; c++) {
+				const float v1 = value(seed), v2 = value(seed);
+				boxes[i * 6 + c] = MIN(v1, v2);
+				boxes[i * 6 + 3 + c] = MAX(v1, v2);
+			}
+		}
+
+		bool inside[boxCount], expectedInside[boxCount];
+		kernels.cullBoxes(planes, boxes, inside, boxCount);
+		scalar.cullBoxes(planes, boxes, expectedInside, boxCount);
+		for (uint i = 0; i < boxCount; i++)
+			TS_ASSERT_EQUALS(inside[i], expectedInside[i]);
+
+		// 64 complex values, i.e. n = 8, with the cosine table for 64 points
+		Math::CosineTable cosTable(64);
+		float z[128], expectedZ[128];
+		for (int i = 0; i < 128; i++)
+			z[i] = expectedZ[i] = value(seed);
+		kernels.fftPass(z, cosTable.getTable(), 8);
+		scalar.fftPass(expectedZ, cosTable.getTable(), 8);
+		for (int i = 0; i < 128; i++)
+			TS_ASSERT(nearlyEqual(z[i], expectedZ[i]));
+
+		float tCos[64], tSin[64];
+		for (int i = 0; i < 64; i++) {
+			tCos[i] = value(seed) / 32.0f;
+			tSin[i] = value(seed) / 32.0f;
+		}
+		for (uint size8 = 2; size8 <= 32; size8 *= 2) {
+			for (int i = 0; i < 128; i++)
+				z[i] = expectedZ[i] = value(seed);
+			kernels.imdctPostRotation(z, tCos, tSin, size8);
+			scalar.imdctPostRotation(expectedZ, tCos, tSin, size8);
+			for (int i = 0; i < 128; i++)
+				TS_ASSERT(nearlyEqual(z[i], expectedZ[i]));
+		}
+
+		for (int i = 0; i < 128; i++)
+			z[i] = expectedZ[i] = value(seed);
+		kernels.rdftTwiddle(z, tCos, tSin, 128, 1, 32, 0.5f, -0.5f);
+		scalar.rdftTwiddle(expectedZ, tCos, tSin, 128, 1, 32, 0.5f, -0.5f);
+		for (int i = 0; i < 128; i++)
+			TS_ASSERT(nearlyEqual(z[i], expectedZ[i]));
+	}
+
+public:
+	void test_kernels() {
+		checkKernels(Math::mathKernelsScalar);
+#ifdef SCUMMVM_SSE2
+		checkKernels(Math::mathKernelsSSE2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkKernels(Math::mathKernelsNEON);
+#endif
+	}
+
+	void test_fft() {
+		for (int bits = 2; bits <= 10; bits++) {
+			for (int inverse = 0; inverse < 2; inverse++) {
+				const int n = 1 << bits;
+				Math::FFT fft(bits, inverse);
+
+				uint32 seed = bits;
+				Math::Complex *z = new Math::Complex[n];
+				Math::Complex *input = new Math::Complex[n];
+				for (int i = 0; i < n; i++) {
+					input[i].re = z[i].re = value(seed) / 32.0f;
+					input[i].im = z[i].im = value(seed) / 32.0f;
+				}
+
+				fft.permute(z);
+				fft.calc(z);
+
+				// Compare against a plain discrete Fourier transform
+				const double sign = inverse ? 1.0 : -1.0;
+				for (int k = 0; k < n; k++) {
+					double re = 0.0, im = 0.0;
+					for (int i = 0; i < n; i++) {
+						const double angle = sign * 2.0 * M_PI * ((i * k) % n) / n;
+						re += input[i].re * cos(angle) - input[i].im * sin(angle);
+						im += input[i].re * sin(angle) + input[i].im * cos(angle);
+					}
+					TS_ASSERT(fabs(z[k].re - re) < 1e-3 * n);
+					TS_ASSERT(fabs(z[k].im - im) < 1e-3 * n);
+				}
+
+				delete[] z;
+				delete[] input;
+			}
+		}
+	}
+
+	void test_rdft_round_trip() {
+		const int bits = 8;
+		const int n = 1 << bits;
+		Math::RDFT forward(bits, Math::RDFT::DFT_R2C);
+		Math::RDFT backward(bits, Math::RDFT::IDFT_C2R);
+
+		uint32 seed = 5;
+		float data[n], input[n];
+		for (int i = 0; i < n; i++)
+			data[i] = input[i] = value(seed);
+
+		forward.calc(data);
+		backward.calc(data);
+
+		// The inverse transform is scaled by n / 2
+		for (int i = 0; i < n; i++)
+			TS_ASSERT(fabs(data[i] * 2 / n - input[i]) < 1e-3f);
+	}
+
+	void test_transformPoints() {
+		Math::Matrix4 m(Math::Angle(30), Math::Angle(-45), Math::Angle(10), Math::EO_XYZ);
+		m.setPosition(Math::Vector3d(1, -2, 3));
+
+		Math::Vector3d points[7];
+		for (int i = 0; i < 7; i++)
+			points[i].set(i, 2 * i - 3, 0.5f * i);
+
+		Math::Vector3d transformed[7], rotated[7];
+		m.transformPoints(points, transformed, 7);
+		m.transformVectors(points, rotated, 7);
+
+		for (int i = 0; i < 7; i++) {
+			Math::Vector3d p = points[i];
+			m.transform(&p, true);
+			TS_ASSERT((p - transformed[i]).getMagnitude() < 1e-4f);
+
+			p = points[i];
+			m.transform(&p, false);
+			TS_ASSERT((p - rotated[i]).getMagnitude() < 1e-4f);
+		}
+	}
+
+	void test_frustum_batch() {
+		Math::Matrix4 proj;
+		proj.setValue(0, 0, 1.0f);
+		proj.setValue(1, 1, 1.0f);
+		proj.setValue(2, 2, -1.0f);
+		proj.setValue(2, 3, -0.2f);
+		proj.setValue(3, 2, -1.0f);
+		proj.setValue(3, 3, 0.0f);
+
+		Math::Frustum frustum;
+		frustum.setup(proj);
+
+		Math::AABB boxes[100];
+		for (int i = 0; i < 100; i++) {
+			const float x = (i % 10) - 5.0f, z = -(i / 10) - 0.5f;
+			boxes[i] = Math::AABB(Math::Vector3d(x, -0.5f, z - 0.5f), Math::Vector3d(x + 1, 0.5f, z + 0.5f));
+		}
+
+		bool inside[100];
+		frustum.isInside(boxes, 100, inside);
+
+		int insideCount = 0;
+		for (int i = 0; i < 100; i++) {
+			TS_ASSERT_EQUALS(inside[i], frustum.isInside(boxes[i]));
+			insideCount += inside[i];
+		}
+
+		// Some, but not all of the boxes are visible
+		TS_ASSERT(insideCount > 0 && insideCount < 100);
+	}
+};
@@ -5,7 +5,7 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/video/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -28,7 +28,12 @@ TEST_LIBS += test/null_osystem.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+ifdef USE_LUA
+TESTS += $(srcdir)/test/common/lua/*.h
+TEST_LIBS += common/lua/liblua.a
+endif
+
+TEST_LIBS +=	video/libvideo.a audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -74,9 +79,26 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+BENCH_OBJS := test/bench/runner.o \
+	test/bench/common.o \
+	test/bench/graphics.o \
+	test/bench/audio.o \
+	test/bench/audio_decoders.o \
+	test/bench/image.o \
+	test/bench/math.o
+
+# Microbenchmarks for core primitives. The results are also written to
+# bench.json; pass BENCH_FILTER to only run matching benchmarks and
+# BENCH_CLIPS to point to the reference clips of the audio decoders.
+bench: test/bench/runner
+	./test/bench/runner --json=bench.json $(if $(BENCH_CLIPS),--clips=$(BENCH_CLIPS)) $(BENCH_FILTER)
+test/bench/runner: $(BENCH_OBJS) $(TEST_LIBS)
+	+$(QUIET_LINK)$(LD) -o $@ $(BENCH_OBJS) $(TEST_LIBS) $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
 	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/null_osystem.o
+	-$(RM) $(BENCH_OBJS) test/bench/runner bench.json
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
@@ -85,4 +107,4 @@ test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 
 copy-dat: test/engine-data/encoding.dat
 
-.PHONY: test clean-test copy-dat
+.PHONY: test bench clean-test copy-dat
@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_BINK
+#include "video/bink_dsp.h"
+#endif
+
+class BinkTestSuite : public CxxTest::TestSuite {
+#ifdef USE_BINK
+	static const int kPitch = 13;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	/**
+	 * Run all kernels of @p dsp and of the scalar set on the same random
+	 * blocks and check that they produce the same values.
+	 */
+	static bool kernelsMatch(const Video::BinkDSP &dsp) {
+		uint32 seed = 0x3c6ef372;
+		bool result = true;
+
+		for (int run = 0; run < 64; ++run) {
+			int32 coeffs[64];
+			int16 residue[64];
+			byte pixels[8 * kPitch];
+
+			// Every fourth block only has a DC coefficient
+			const int range = run & 1 ? 4096 : 512;
+			for (int i = 0; i < 64; ++i) {
+				coeffs[i] = (i == 0 || run % 4 != 0) ? (int)(nextRandom(seed) % (range * 2)) - range : 0;
+				residue[i] = (int)(nextRandom(seed) % 512) - 256;
+			}
+			for (int i = 0; i < ARRAYSIZE(pixels); ++i)
+				pixels[i] = nextRandom(seed);
+
+			int32 expectedBlock[64], block[64];
+			memcpy(expectedBlock, coeffs, sizeof(coeffs));
+			memcpy(block, coeffs, sizeof(coeffs));
+			Video::binkDSPScalar.idct(expectedBlock);
+			dsp.idct(block);
+			result &= memcmp(expectedBlock, block, sizeof(block)) == 0;
+
+			byte expected[8 * kPitch], actual[8 * kPitch];
+			memcpy(expected, pixels, sizeof(pixels));
+			memcpy(actual, pixels, sizeof(pixels));
+			Video::binkDSPScalar.idctPut(expected, kPitch, coeffs);
+			dsp.idctPut(actual, kPitch, coeffs);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+
+			memcpy(expected, pixels, sizeof(pixels));
+			memcpy(actual, pixels, sizeof(pixels));
+			memcpy(expectedBlock, coeffs, sizeof(coeffs));
+			memcpy(block, coeffs, sizeof(coeffs));
+			Video::binkDSPScalar.idctAdd(expected, kPitch, expectedBlock);
+			dsp.idctAdd(actual, kPitch, block);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+
+			memcpy(expected, pixels, sizeof(pixels));
+			memcpy(actual, pixels, sizeof(pixels));
+			Video::binkDSPScalar.addResidue(expected, kPitch, residue);
+			dsp.addResidue(actual, kPitch, residue);
+			result &= memcmp(expected, actual, sizeof(actual)) == 0;
+		}
+		return result;
+	}
+#endif
+
+public:
+	void test_block_kernels() {
+#ifdef USE_BINK
+		TS_ASSERT(kernelsMatch(Video::getBinkDSP()));
+#ifdef SCUMMVM_SSE2
+		TS_ASSERT(kernelsMatch(Video::binkDSPSSE2));
+#endif
+#endif
+	}
+};
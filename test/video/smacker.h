@@ -0,0 +1,245 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "video/smk_decoder.h"
+
+#include "../null_osystem.h"
+
+class SmackerDecoderTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 64;
+	static const int kHeight = 48;
+	static const int kFrameCount = 4;
+
+	/** Writes bits in the order SmackerBitStream reads them. */
+	class BitWriter {
+		Common::Array<byte> _data;
+		uint _bits;
+
+	public:
+		BitWriter() : _bits(0) {}
+
+		void writeBit(uint bit) {
+			if ((_bits & 7) == 0)
+				_data.push_back(0);
+			_data.back() |= (bit & 1) << (_bits & 7);
+			++_bits;
+		}
+
+		void writeBits(uint32 value, uint count) {
+			for (uint i = 0; i < count; ++i)
+				writeBit(value >> i);
+		}
+
+		/** Pad to a multiple of four bytes, like a frame in the file. */
+		void align() {
+			while (_data.size() & 3)
+				_data.push_back(0);
+			_bits = _data.size() * 8;
+		}
+
+		const Common::Array<byte> &data() const { return _data; }
+	};
+
+	struct Code {
+		uint32 bits;
+		uint length;
+	};
+
+	/**
+	 * A Huffman tree which is deliberately unbalanced, so that it has short
+	 * codes as well as codes which are longer than any lookup table.
+	 */
+	struct Tree {
+		Common::Array<uint32> values;
+		Code codes[65536];
+		uint maxLength;
+
+		void write(BitWriter &writer, uint first, uint count, uint32 prefix, uint length, Tree *lo, Tree *hi) {
+			if (count == 1) {
+				writer.writeBit(0);
+				if (lo) {
+					lo->encode(writer, values[first] & 0xFF);
+					hi->encode(writer, values[first] >> 8);
+				} else {
+					writer.writeBits(values[first], 8);
+				}
+				codes[values[first]].bits = prefix;
+				codes[values[first]].length = length;
+				maxLength = MAX(maxLength, length);
+				return;
+			}
+
+			writer.writeBit(1);
+			const uint left = count > 8 ? (count + 3) / 4 : count / 2;
+			write(writer, first, left, prefix, length + 1, lo, hi);
+			write(writer, first + left, count - left, prefix | (1 << length), length + 1, lo, hi);
+		}
+
+		void encode(BitWriter &writer, uint32 value) const {
+			writer.writeBits(codes[value].bits, codes[value].length);
+		}
+	};
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static void writeSmallTree(BitWriter &writer, Tree &tree, uint32 &seed) {
+		// All byte values, in random order
+		tree.values.clear();
+		tree.maxLength = 0;
+		for (uint i = 0; i < 256; ++i)
+			tree.values.push_back(i);
+		for (uint i = 255; i > 0; --i)
+			SWAP(tree.values[i], tree.values[nextRandom(seed) % (i + 1)]);
+
+		writer.writeBit(1);
+		tree.write(writer, 0, 256, 0, 0, nullptr, nullptr);
+		writer.writeBit(0);
+	}
+
+	/**
+	 * Write a big tree of @p count random values limited to @p mask. With
+	 * @p cachedLeaves the first three values are the markers of the recently
+	 * decoded values, otherwise no value is.
+	 */
+	static void writeBigTree(BitWriter &writer, Tree &tree, uint count, uint32 mask, bool cachedLeaves, uint32 &seed) {
+		Tree *lo = new Tree, *hi = new Tree;
+		writer.writeBit(1);
+		writeSmallTree(writer, *lo, seed);
+		writeSmallTree(writer, *hi, seed);
+
+		tree.values.clear();
+		tree.maxLength = 0;
+		while (tree.values.size() < count) {
+			const uint32 value = nextRandom(seed) & mask;
+			bool known = value >= 0xFFF0;
+			for (uint i = 0; i < tree.values.size(); ++i)
+				known |= tree.values[i] == value;
+			if (!known)
+				tree.values.push_back(value);
+		}
+
+		for (uint i = 0; i < 3; ++i)
+			writer.writeBits(cachedLeaves ? tree.values[i] : 0xFFF0 + i, 16);
+		tree.write(writer, 0, count, 0, 0, lo, hi);
+		writer.writeBit(0);
+
+		delete lo;
+		delete hi;
+	}
+
+	static uint blockRun(uint index) {
+		return index <= 58 ? index + 1 : 128 << (index - 59);
+	}
+
+	static void writeFrame(BitWriter &writer, Tree *trees, uint32 &seed) {
+		Tree &mMap = trees[0], &mClr = trees[1], &full = trees[2], &type = trees[3];
+		const uint blocks = (kWidth / 4) * (kHeight / 4);
+		uint block = 0;
+		while (block < blocks) {
+			const uint32 value = type.values[nextRandom(seed) % type.values.size()];
+			type.encode(writer, value);
+			const uint run = MIN(blockRun((value >> 2) & 0x3F), blocks - block);
+
+			uint codes = 0;
+			switch (value & 3) {
+			case 0:
+				for (uint i = 0; i < run; ++i) {
+					mClr.encode(writer, mClr.values[nextRandom(seed) % mClr.values.size()]);
+					mMap.encode(writer, mMap.values[nextRandom(seed) % mMap.values.size()]);
+				}
+				break;
+			case 1: {
+				// Full blocks in one of the three modes of Smacker v4
+				const uint mode = nextRandom(seed) % 3;
+				writer.writeBit(mode == 1);
+				if (mode != 1)
+					writer.writeBit(mode == 2);
+				codes = mode == 0 ? 8 : mode == 1 ? 2 : 4;
+				break;
+			}
+			default:
+				break;
+			}
+
+			for (uint i = 0; i < run * codes; ++i)
+				full.encode(writer, full.values[nextRandom(seed) % full.values.size()]);
+			block += run;
+		}
+		writer.align();
+	}
+
+	static void writeUint32(Common::WriteStream &stream, uint32 value) {
+		stream.writeUint32LE(value);
+	}
+
+public:
+	void test_decode() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		uint32 seed = 0x2545f491;
+		static const uint treeSizes[4] = { 60, 40, 300, 50 };
+		Tree *trees = new Tree[4];
+		BitWriter treeWriter;
+		for (uint i = 0; i < 4; ++i) {
+			// Mostly short runs of blocks in the type tree
+			const uint32 mask = i == 3 ? 0xFF3F : 0xFFFF;
+			writeBigTree(treeWriter, trees[i], treeSizes[i], mask, i == 1 || i == 2, seed);
+		}
+		treeWriter.align();
+
+		TS_ASSERT_LESS_THAN(12u, trees[2].maxLength);
+
+		BitWriter frames[kFrameCount];
+		for (int i = 0; i < kFrameCount; ++i)
+			writeFrame(frames[i], trees, seed);
+		delete[] trees;
+
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::NO);
+		file.writeUint32BE(MKTAG('S', 'M', 'K', '4'));
+		writeUint32(file, kWidth);
+		writeUint32(file, kHeight);
+		writeUint32(file, kFrameCount);
+		writeUint32(file, 100);
+		writeUint32(file, 0);
+		for (int i = 0; i < 7; ++i)
+			writeUint32(file, 0);
+		writeUint32(file, treeWriter.data().size());
+		for (uint i = 0; i < 4; ++i)
+			writeUint32(file, (treeSizes[i] * 2 + 4) * 4);
+		for (int i = 0; i < 7; ++i)
+			writeUint32(file, 0);
+		writeUint32(file, 0);
+		for (int i = 0; i < kFrameCount; ++i)
+			writeUint32(file, frames[i].data().size());
+		for (int i = 0; i < kFrameCount; ++i)
+			file.writeByte(0);
+		file.write(treeWriter.data().begin(), treeWriter.data().size());
+		for (int i = 0; i < kFrameCount; ++i)
+			file.write(frames[i].data().begin(), frames[i].data().size());
+
+		Video::SmackerDecoder decoder;
+		TS_ASSERT(decoder.loadStream(new Common::MemoryReadStream(file.getData(), file.size(), DisposeAfterUse::YES)));
+
+		// The checksum of the frames as decoded by the bit-by-bit tree walk
+		uint32 checksum = 0;
+		for (int i = 0; i < kFrameCount; ++i) {
+			const Graphics::Surface *surface = decoder.decodeNextFrame();
+			TS_ASSERT(surface);
+			if (!surface)
+				return;
+			for (int y = 0; y < surface->h; ++y) {
+				const byte *row = (const byte *)surface->getBasePtr(0, y);
+				for (int x = 0; x < surface->w; ++x)
+					checksum = (checksum ^ row[x]) * 16777619;
+			}
+		}
+		TS_ASSERT_EQUALS(checksum, 0x8b636133u);
+	}
+};
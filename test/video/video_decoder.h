@@ -0,0 +1,167 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../null_osystem.h"
+
+namespace {
+
+/**
+ * A video of numbered frames, where every pixel of a frame holds its
+ * number and every third frame comes with a new palette.
+ */
+class NumberedVideoDecoder : public Video::VideoDecoder {
+	class NumberedVideoTrack : public FixedRateVideoTrack {
+		Graphics::Surface _surface;
+		byte _palette[256 * 3];
+		int _curFrame;
+		int _frameCount;
+		mutable bool _dirtyPalette;
+
+	public:
+		NumberedVideoTrack(int frameCount) : _curFrame(-1), _frameCount(frameCount), _dirtyPalette(false) {
+			_surface.create(4, 2, Graphics::PixelFormat::createFormatCLUT8());
+			memset(_palette, 0, sizeof(_palette));
+		}
+
+		~NumberedVideoTrack() override {
+			_surface.free();
+		}
+
+		uint16 getWidth() const override { return _surface.w; }
+		uint16 getHeight() const override { return _surface.h; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return _frameCount; }
+		const byte *getPalette() const override { _dirtyPalette = false; return _palette; }
+		bool hasDirtyPalette() const override { return _dirtyPalette; }
+		bool isSeekable() const override { return true; }
+
+		bool seek(const Audio::Timestamp &time) override {
+			_curFrame = getFrameAtTime(time) - 1;
+			return true;
+		}
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			memset(_surface.getPixels(), _curFrame, _surface.pitch * _surface.h);
+			if (_curFrame % 3 == 0) {
+				_palette[0] = _curFrame;
+				_dirtyPalette = true;
+			}
+			return &_surface;
+		}
+
+	protected:
+		Common::Rational getFrameRate() const override { return 10; }
+	};
+
+	bool _decodeAhead;
+
+public:
+	NumberedVideoDecoder(bool decodeAhead) : _decodeAhead(decodeAhead) {}
+	~NumberedVideoDecoder() override { close(); }
+
+	bool loadStream(Common::SeekableReadStream *stream) override {
+		close();
+		addTrack(new NumberedVideoTrack(20));
+		return true;
+	}
+
+protected:
+	bool supportsDecodeAhead() const override { return _decodeAhead; }
+};
+
+} // End of anonymous namespace
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Decode the next frame and check that it has the expected number,
+	 * along with the palette and the frame reported by the decoder.
+	 */
+	static bool decodesFrame(NumberedVideoDecoder &decoder, int frame) {
+		const Graphics::Surface *surface = decoder.decodeNextFrame();
+		if (!surface || *(const byte *)surface->getBasePtr(3, 1) != frame)
+			return false;
+		if (decoder.getCurFrame() != frame)
+			return false;
+		if (decoder.hasDirtyPalette() != (frame % 3 == 0))
+			return false;
+		return frame % 3 != 0 || decoder.getPalette()[0] == frame;
+	}
+
+public:
+	void test_decode_ahead() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		NumberedVideoDecoder decoder(true);
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setDecodeAhead(3));
+
+		for (int frame = 0; frame < 20; ++frame) {
+			TS_ASSERT(!decoder.endOfVideo());
+			TS_ASSERT(decodesFrame(decoder, frame));
+		}
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT(!decoder.decodeNextFrame());
+	}
+
+	void test_decode_ahead_seek() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		NumberedVideoDecoder decoder(true);
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setDecodeAhead(4));
+
+		TS_ASSERT(decodesFrame(decoder, 0));
+		TS_ASSERT(decodesFrame(decoder, 1));
+
+		// The frames decoded ahead are discarded
+		TS_ASSERT(decoder.seekToFrame(12));
+		TS_ASSERT(decodesFrame(decoder, 12));
+		TS_ASSERT(decodesFrame(decoder, 13));
+
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT(decodesFrame(decoder, 0));
+	}
+
+	void test_decode_ahead_disable() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		NumberedVideoDecoder decoder(true);
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setDecodeAhead(5));
+
+		TS_ASSERT(decodesFrame(decoder, 0));
+		TS_ASSERT(decodesFrame(decoder, 1));
+
+		// The frames decoded already are still returned first
+		TS_ASSERT(decoder.setDecodeAhead(0));
+		for (int frame = 2; frame < 10; ++frame)
+			TS_ASSERT(decodesFrame(decoder, frame));
+
+		TS_ASSERT(decoder.setDecodeAhead(2));
+		for (int frame = 10; frame < 20; ++frame)
+			TS_ASSERT(decodesFrame(decoder, frame));
+		TS_ASSERT(decoder.endOfVideo());
+	}
+
+	void test_decode_ahead_unsupported() {
+		if (!NULL_OSYSTEM_IS_AVAILABLE)
+			return;
+		Common::install_null_g_system();
+
+		NumberedVideoDecoder decoder(false);
+		TS_ASSERT(!decoder.setDecodeAhead(3));
+		decoder.loadStream(nullptr);
+		TS_ASSERT(!decoder.setDecodeAhead(3));
+		TS_ASSERT(decodesFrame(decoder, 0));
+	}
+};
@@ -102,6 +102,8 @@ protected:
 	void readNextPacket();
 	bool seekIntern(const Audio::Timestamp &time);
 	bool supportsAudioTrackSwitching() const { return true; }
+	// decodeNextTransparency() would read the transparency track during playback
+	bool supportsDecodeAhead() const { return !_transparencyTrack.track; }
 	AudioTrack *getAudioTrack(int index);
 
 	/**
@@ -0,0 +1,177 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "video/bink_dsp.h"
+
+#include <emmintrin.h>
+
+namespace Video {
+
+namespace {
+
+/** Multiply 32-bit lanes and keep the low 32 bits, like the scalar code. */
+inline __m128i mullo(__m128i a, int32 b) {
+	const __m128i factor = _mm_set1_epi32(b);
+	const __m128i even = _mm_mul_epu32(a, factor);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), factor);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i scale(__m128i a, int32 b) {
+	return _mm_srai_epi32(mullo(a, b), 11);
+}
+
+/** The one-dimensional transform of IDCT_TRANSFORM, on four columns or rows at once. */
+inline void transform(const __m128i s[8], __m128i d[8]) {
+	const __m128i a0 = _mm_add_epi32(s[0], s[4]);
+	const __m128i a1 = _mm_sub_epi32(s[0], s[4]);
+	const __m128i a2 = _mm_add_epi32(s[2], s[6]);
+	const __m128i a3 = scale(_mm_sub_epi32(s[2], s[6]), 2896);
+	const __m128i a4 = _mm_add_epi32(s[5], s[3]);
+	const __m128i a5 = _mm_sub_epi32(s[5], s[3]);
+	const __m128i a6 = _mm_add_epi32(s[1], s[7]);
+	const __m128i a7 = _mm_sub_epi32(s[1], s[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = scale(_mm_add_epi32(a5, a7), 3784);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(scale(a5, -5352), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(scale(_mm_sub_epi32(a6, a4), 2896), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(scale(a7, 2217), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	d[0] = _mm_add_epi32(c0, b0);
+	d[1] = _mm_add_epi32(c1, b2);
+	d[2] = _mm_add_epi32(c2, b3);
+	d[3] = _mm_sub_epi32(c3, b4);
+	d[4] = _mm_add_epi32(c3, b4);
+	d[5] = _mm_sub_epi32(c2, b3);
+	d[6] = _mm_sub_epi32(c1, b2);
+	d[7] = _mm_sub_epi32(c0, b0);
+}
+
+inline void transpose(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Run the inverse DCT and return row i of the result in rows[2 * i] and
+ * rows[2 * i + 1]. The column shortcut of the scalar code for blocks with
+ * just a DC coefficient produces the same values as the full transform.
+ */
+inline void transformBlock(const int32 *block, __m128i rows[16]) {
+	__m128i s[8], d[8], left[8], right[8];
+
+	for (int i = 0; i < 8; i++)
+		s[i] = _mm_loadu_si128((const __m128i *)(block + i * 8));
+	transform(s, left);
+	for (int i = 0; i < 8; i++)
+		s[i] = _mm_loadu_si128((const __m128i *)(block + i * 8 + 4));
+	transform(s, right);
+
+	const __m128i round = _mm_set1_epi32(0x7F);
+	for (int row = 0; row < 8; row += 4) {
+		for (int i = 0; i < 4; i++) {
+			s[i] = left[row + i];
+			s[i + 4] = right[row + i];
+		}
+		transpose(s[0], s[1], s[2], s[3]);
+		transpose(s[4], s[5], s[6], s[7]);
+
+		transform(s, d);
+		for (int i = 0; i < 8; i++)
+			d[i] = _mm_srai_epi32(_mm_add_epi32(d[i], round), 8);
+
+		transpose(d[0], d[1], d[2], d[3]);
+		transpose(d[4], d[5], d[6], d[7]);
+		for (int i = 0; i < 4; i++) {
+			rows[(row + i) * 2] = d[i];
+			rows[(row + i) * 2 + 1] = d[i + 4];
+		}
+	}
+}
+
+/** Store the low byte of each lane of @p lo and @p hi, the way a byte assignment truncates. */
+inline void storeBytes(byte *dest, __m128i lo, __m128i hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+	_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(words, words));
+}
+
+void idctSSE2(int32 *block) {
+	__m128i rows[16];
+	transformBlock(block, rows);
+
+	for (int i = 0; i < 16; i++)
+		_mm_storeu_si128((__m128i *)(block + i * 4), rows[i]);
+}
+
+void idctPutSSE2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i rows[16];
+	transformBlock(block, rows);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		storeBytes(dest, rows[i * 2], rows[i * 2 + 1]);
+}
+
+void idctAddSSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i rows[16];
+	transformBlock(block, rows);
+
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), zero);
+		const __m128i lo = _mm_add_epi32(_mm_unpacklo_epi16(pixels, zero), rows[i * 2]);
+		const __m128i hi = _mm_add_epi32(_mm_unpackhi_epi16(pixels, zero), rows[i * 2 + 1]);
+		storeBytes(dest, lo, hi);
+	}
+}
+
+void addResidueSSE2(byte *dest, uint32 pitch, const int16 *block) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16(0xFF);
+
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), zero);
+		const __m128i sum = _mm_and_si128(_mm_add_epi16(pixels, _mm_loadu_si128((const __m128i *)block)), mask);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+}
+
+} // End of anonymous namespace
+
+const BinkDSP binkDSPSSE2 = {
+	idctSSE2,
+	idctPutSSE2,
+	idctAddSSE2,
+	addResidueSSE2
+};
+
+} // End of namespace Video
@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * Kernels of the Bink video decoder which work on one 8x8 block of a
+ * plane, in a scalar and in vectorized versions. All of them produce the
+ * same pixels.
+ */
+struct BinkDSP {
+	/** Run the inverse DCT on @p block in place. */
+	void (*idct)(int32 *block);
+
+	/** Run the inverse DCT on @p block and store the result at @p dest. */
+	void (*idctPut)(byte *dest, uint32 pitch, const int32 *block);
+
+	/**
+	 * Run the inverse DCT on @p block and add the result to the pixels
+	 * at @p dest. The contents of @p block are undefined afterwards.
+	 */
+	void (*idctAdd)(byte *dest, uint32 pitch, int32 *block);
+
+	/** Add the residue in @p block to the pixels at @p dest. */
+	void (*addResidue)(byte *dest, uint32 pitch, const int16 *block);
+};
+
+extern const BinkDSP binkDSPScalar;
+
+#ifdef SCUMMVM_SSE2
+extern const BinkDSP binkDSPSSE2;
+#endif
+
+/** Return the fastest kernels available on this CPU. */
+const BinkDSP &getBinkDSP();
+
+} // End of namespace Video
+
+#endif
@@ -450,16 +450,17 @@ void CoktelDecoder::deRLE(byte *&destPtr, const byte *&srcPtr, int16 destLen, in
 			destPtr += copyCount;
 			destLen -= copyCount;
 		} else { // 2 bytes tmp times
-			for (int i = 0; (i < tmp) && (destLen > 0); i++) {
-				for (int j = 0; j < 2; j++) {
-					if (destLen <= 0)
-						break;
+			int16 fillCount = MAX<int16>(0, MIN<int16>(destLen, tmp * 2));
 
-					*destPtr++ = srcPtr[j];
-					destLen--;
-				}
-			}
-			srcPtr += 2;
+			const uint16 pair = READ_UINT16(srcPtr);
+			for (int16 i = 0; i + 1 < fillCount; i += 2)
+				WRITE_UINT16(destPtr + i, pair);
+			if (fillCount & 1)
+				destPtr[fillCount - 1] = srcPtr[0];
+
+			srcPtr  += 2;
+			destPtr += fillCount;
+			destLen -= fillCount;
 		}
 		srcLen -= tmp;
 	}
@@ -489,9 +490,20 @@ void CoktelDecoder::renderBlockWholeDouble(Graphics::Surface &dstSurf, const byt
 	byte bpp = dstSurf.format.bytesPerPixel;
 	for (int i = 0; i < rect.height(); i++) {
 		// Each pixel on the source row is written twice to the destination row
-		for (int j = 0; j < rect.width(); j++) {
-			memcpy(dst + 2 * j * bpp, src + j * bpp, bpp);
-			memcpy(dst + (2 * j + 1) * bpp, src + j * bpp, bpp);
+		if (bpp == 1) {
+			for (int j = 0; j < rect.width(); j++)
+				dst[2 * j] = dst[2 * j + 1] = src[j];
+		} else if (bpp == 2) {
+			for (int j = 0; j < rect.width(); j++) {
+				const uint16 pixel = READ_UINT16(src + 2 * j);
+				WRITE_UINT16(dst + 4 * j    , pixel);
+				WRITE_UINT16(dst + 4 * j + 2, pixel);
+			}
+		} else {
+			for (int j = 0; j < rect.width(); j++) {
+				memcpy(dst + 2 * j * bpp, src + j * bpp, bpp);
+				memcpy(dst + (2 * j + 1) * bpp, src + j * bpp, bpp);
+			}
 		}
 		dst += dstSurf.pitch;
 
@@ -2574,6 +2586,32 @@ bool VMDDecoder::getRenderRects(const Common::Rect &rect,
 	return true;
 }
 
+// Convert a row of pixels into the video surface, keeping black transparent
+template<typename PixelType, int srcBpp>
+static void convertVMDRow(byte *dstRow, const byte *srcRow, int width, const Graphics::PixelFormat &pixelFormat) {
+	PixelType *dst = (PixelType *)dstRow;
+
+	for (int j = 0; j < width; j++, srcRow += srcBpp) {
+		byte r, g, b;
+		if (srcBpp == 2) {
+			uint16 data = READ_LE_UINT16(srcRow);
+
+			r = ((data & 0x7C00) >> 10) << 3;
+			g = ((data & 0x03E0) >>  5) << 3;
+			b = ((data & 0x001F) >>  0) << 3;
+		} else {
+			r = srcRow[2];
+			g = srcRow[1];
+			b = srcRow[0];
+		}
+
+		if ((r == 0) && (g == 0) && (b == 0))
+			dst[j] = 0;
+		else
+			dst[j] = (PixelType)pixelFormat.RGBToColor(r, g, b);
+	}
+}
+
 void VMDDecoder::blit16(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	rect = Common::Rect(rect.left / 2, rect.top, rect.right / 2, rect.bottom);
 
@@ -2590,25 +2628,10 @@ void VMDDecoder::blit16(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	byte *dst = (byte *)_surface.getBasePtr(_x + rect.left, _y + rect.top);
 
 	for (int i = 0; i < rect.height(); i++) {
-		const byte *srcRow = src;
-		      byte *dstRow = dst;
-
-		for (int j = 0; j < rect.width(); j++, srcRow += 2, dstRow += _surface.format.bytesPerPixel) {
-			uint16 data = READ_LE_UINT16(srcRow);
-
-			byte r = ((data & 0x7C00) >> 10) << 3;
-			byte g = ((data & 0x03E0) >>  5) << 3;
-			byte b = ((data & 0x001F) >>  0) << 3;
-
-			uint32 c = pixelFormat.RGBToColor(r, g, b);
-			if ((r == 0) && (g == 0) && (b == 0))
-				c = 0;
-
-			if      (_surface.format.bytesPerPixel == 2)
-				*((uint16 *)dstRow) = (uint16) c;
-			else if (_surface.format.bytesPerPixel == 4)
-				*((uint32 *)dstRow) = (uint32) c;
-		}
+		if      (_surface.format.bytesPerPixel == 2)
+			convertVMDRow<uint16, 2>(dst, src, rect.width(), pixelFormat);
+		else if (_surface.format.bytesPerPixel == 4)
+			convertVMDRow<uint32, 2>(dst, src, rect.width(), pixelFormat);
 
 		src += srcSurf .pitch;
 		dst += _surface.pitch;
@@ -2631,23 +2654,10 @@ void VMDDecoder::blit24(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	byte *dst = (byte *)_surface.getBasePtr(_x + rect.left, _y + rect.top);
 
 	for (int i = 0; i < rect.height(); i++) {
-		const byte *srcRow = src;
-		      byte *dstRow = dst;
-
-		for (int j = 0; j < rect.width(); j++, srcRow += 3, dstRow += _surface.format.bytesPerPixel) {
-			byte r = srcRow[2];
-			byte g = srcRow[1];
-			byte b = srcRow[0];
-
-			uint32 c = pixelFormat.RGBToColor(r, g, b);
-			if ((r == 0) && (g == 0) && (b == 0))
-				c = 0;
-
-			if      (_surface.format.bytesPerPixel == 2)
-				*((uint16 *)dstRow) = (uint16) c;
-			else if (_surface.format.bytesPerPixel == 4)
-				*((uint32 *)dstRow) = (uint32) c;
-		}
+		if      (_surface.format.bytesPerPixel == 2)
+			convertVMDRow<uint16, 3>(dst, src, rect.width(), pixelFormat);
+		else if (_surface.format.bytesPerPixel == 4)
+			convertVMDRow<uint32, 3>(dst, src, rect.width(), pixelFormat);
 
 		src += srcSurf .pitch;
 		dst += _surface.pitch;
@@ -2969,6 +2979,11 @@ void AdvancedVMDDecoder::setSurfaceMemory(void *mem, uint16 width, uint16 height
 	_decoder->setSurfaceMemory(mem, width, height, bpp);
 }
 
+bool AdvancedVMDDecoder::supportsDecodeAhead() const {
+	// Frames decoded into memory of the caller would overwrite the one on screen
+	return _decoder->_ownSurface;
+}
+
 AdvancedVMDDecoder::VMDVideoTrack::VMDVideoTrack(VMDDecoder *decoder) : _decoder(decoder) {
 }
 
@@ -596,6 +596,9 @@ public:
 
 	void setSurfaceMemory(void *mem, uint16 width, uint16 height, uint8 bpp);
 
+protected:
+	bool supportsDecodeAhead() const;
+
 private:
 	class VMDVideoTrack : public FixedRateVideoTrack {
 	public:
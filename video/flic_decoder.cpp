@@ -25,6 +25,7 @@
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "graphics/frame_pool.h"
 #include "graphics/surface.h"
 
 namespace Video {
@@ -88,8 +89,8 @@ FlicDecoder::FlicVideoTrack::FlicVideoTrack(Common::SeekableReadStream *stream,
 	_fileStream = stream;
 	_frameCount = frameCount;
 
-	_surface = new Graphics::Surface();
-	_surface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+	_surface = 0;
+	allocateSurface(width, height);
 	_palette = new byte[3 * 256]();
 	_dirtyPalette = false;
 
@@ -105,8 +106,15 @@ FlicDecoder::FlicVideoTrack::~FlicVideoTrack() {
 	delete _fileStream;
 	delete[] _palette;
 
-	_surface->free();
-	delete _surface;
+	FramePoolMan.release(_surface);
+}
+
+void FlicDecoder::FlicVideoTrack::allocateSurface(uint16 width, uint16 height) {
+	FramePoolMan.release(_surface);
+	_surface = FramePoolMan.acquire(width, height, Graphics::PixelFormat::createFormatCLUT8());
+
+	// Frames after the first one only contain the changes
+	memset(_surface->getPixels(), 0, _surface->pitch * _surface->h);
 }
 
 void FlicDecoder::FlicVideoTrack::readHeader() {
@@ -212,10 +220,7 @@ void FlicDecoder::FlicVideoTrack::handleFrame() {
 		if (newHeight == 0)
 			newHeight = _surface->h;
 
-		_surface->free();
-		delete _surface;
-		_surface = new Graphics::Surface();
-		_surface->create(newWidth, newHeight, Graphics::PixelFormat::createFormatCLUT8());
+		allocateSurface(newWidth, newHeight);
 	}
 
 	// Read subchunks
@@ -102,6 +102,8 @@ protected:
 
 		Common::List<Common::Rect> _dirtyRects;
 
+		/** Replace the surface with a cleared one from the frame pool. */
+		void allocateSurface(uint16 width, uint16 height);
 		void copyFrame(uint8 *data);
 		void decodeByteRun(uint8 *data);
 		void decodeDeltaFLC(uint8 *data);
@@ -28,6 +28,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/frame_pool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -335,8 +336,10 @@ MKVDecoder::VPXVideoTrack::VPXVideoTrack(const mkvparser::Track *const pTrack) {
 }
 
 MKVDecoder::VPXVideoTrack::~VPXVideoTrack() {
-	// The last frame is not freed in decodeNextFrame(), clear it hear instead.
-	_surface.free();
+	// The last frame is not released in decodeNextFrame(), release it here instead.
+	FramePoolMan.release(_surface);
+	while (!_displayQueue.empty())
+		FramePoolMan.release(_displayQueue.pop());
 	delete _codec;
 }
 
@@ -348,11 +351,10 @@ bool MKVDecoder::VPXVideoTrack::endOfTrack() const {
 
 const Graphics::Surface *MKVDecoder::VPXVideoTrack::decodeNextFrame() {
 	if (_displayQueue.size()) {
-		if (_surface.getPixels())
-			_surface.free();
+		FramePoolMan.release(_surface);
 		_surface = _displayQueue.pop();
 	}
-	return &_surface;
+	return _surface;
 }
 
 bool MKVDecoder::VPXVideoTrack::decodeFrame(byte *frame, long size) {
@@ -366,16 +368,15 @@ bool MKVDecoder::VPXVideoTrack::decodeFrame(byte *frame, long size) {
 	// Let's decode an image frame!
 	vpx_codec_iter_t iter = NULL;
 	vpx_image_t *img;
-	Graphics::Surface tmp;
-	tmp.create(getWidth(), getHeight(), getPixelFormat());
 
 	/* Get frame data */
 	while ((img = vpx_codec_get_frame(_codec, &iter))) {
 		if (img->fmt != VPX_IMG_FMT_I420)
 			error("Movie error. The movie is not in I420 colour format, which is the only one I can hanlde at the moment.");
 
-		YUVToRGBMan.convert420(&tmp, Graphics::YUVToRGBManager::kScaleITU, img->planes[0], img->planes[1], img->planes[2], img->d_w, img->d_h, img->stride[0], img->stride[1]);
-		_displayQueue.push(tmp);
+		Graphics::Surface *frame = FramePoolMan.acquire(getWidth(), getHeight(), getPixelFormat());
+		YUVToRGBMan.convert420(frame, Graphics::YUVToRGBManager::kScaleITU, img->planes[0], img->planes[1], img->planes[2], img->d_w, img->d_h, img->stride[0], img->stride[1]);
+		_displayQueue.push(frame);
 	}
 	return false;
 }
@@ -111,8 +111,8 @@ private:
 		uint16 _height;
 		Graphics::PixelFormat _pixelFormat;
 
-		Graphics::Surface _surface;
-		Common::Queue<Graphics::Surface> _displayQueue;
+		Graphics::Surface *_surface = nullptr;
+		Common::Queue<Graphics::Surface *> _displayQueue;
 
 		vpx_codec_ctx_t *_codec = nullptr;
 	};
@@ -18,7 +18,14 @@ MODULE_OBJS := \
 
 ifdef USE_BINK
 MODULE_OBJS += \
-	bink_decoder.o
+	bink_decoder.o \
+	bink_dsp.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_dsp-sse2.o
+$(MODULE)/bink_dsp-sse2.o: CXXFLAGS += -msse2
+endif
 endif
 
 ifdef USE_THEORADEC
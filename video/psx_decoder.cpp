@@ -29,6 +29,7 @@
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "graphics/frame_pool.h"
 #include "graphics/yuv_to_rgb.h"
 
 #include "video/psx_decoder.h"
@@ -367,10 +368,7 @@ PSXStreamDecoder::PSXVideoTrack::PSXVideoTrack(Common::SeekableReadStream *first
 }
 
 PSXStreamDecoder::PSXVideoTrack::~PSXVideoTrack() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
+	FramePoolMan.release(_surface);
 
 	delete[] _yBuffer;
 	delete[] _cbBuffer;
@@ -389,10 +387,8 @@ const Graphics::Surface *PSXStreamDecoder::PSXVideoTrack::decodeNextFrame() {
 }
 
 void PSXStreamDecoder::PSXVideoTrack::decodeFrame(Common::BitStreamMemoryStream *frame, uint sectorCount) {
-	if (!_surface) {
-		_surface = new Graphics::Surface();
-		_surface->create(_width, _height, _pixelFormat);
-	}
+	if (!_surface)
+		_surface = FramePoolMan.acquire(_width, _height, _pixelFormat);
 
 	// A frame is essentially an MPEG-1 intra frame
 
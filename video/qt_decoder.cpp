@@ -38,6 +38,8 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#include "graphics/frame_pool.h"
+
 // Video codecs
 #include "image/codecs/codec.h"
 
@@ -77,11 +79,8 @@ void QuickTimeDecoder::close() {
 	VideoDecoder::close();
 	Common::QuickTimeParser::close();
 
-	if (_scaledSurface) {
-		_scaledSurface->free();
-		delete _scaledSurface;
-		_scaledSurface = 0;
-	}
+	FramePoolMan.release(_scaledSurface);
+	_scaledSurface = 0;
 }
 
 const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
@@ -93,10 +92,8 @@ const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
 
 	// We have to initialize the scaled surface
 	if (frame && (_scaleFactorX != 1 || _scaleFactorY != 1)) {
-		if (!_scaledSurface) {
-			_scaledSurface = new Graphics::Surface();
-			_scaledSurface->create(_width, _height, getPixelFormat());
-		}
+		if (!_scaledSurface)
+			_scaledSurface = FramePoolMan.acquire(_width, _height, getPixelFormat());
 
 		scaleSurface(frame, _scaledSurface, _scaleFactorX, _scaleFactorY);
 		return _scaledSurface;
@@ -350,10 +347,7 @@ void QuickTimeDecoder::VideoTrackHandler::checkEditListBounds() {
 }
 
 QuickTimeDecoder::VideoTrackHandler::~VideoTrackHandler() {
-	if (_scaledSurface) {
-		_scaledSurface->free();
-		delete _scaledSurface;
-	}
+	FramePoolMan.release(_scaledSurface);
 
 	delete[] _forcedDitherPalette;
 	delete[] _ditherTable;
@@ -407,16 +401,30 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		return true;
 	}
 
-	// Now we're in the edit and need to figure out what frame we need
+	// Now we're in the edit and need to figure out what frame we need.
+	// After stepping over k frames from the start of the edit, the next
+	// frame starts at the media time of the frame k after the first one
+	// (or the start of the edit if k is 0), so search for the first k at
+	// which the next frame does not start before the requested time.
 	Audio::Timestamp time = requestedTime.convertToFramerate(_parent->timeScale);
-	while (getRateAdjustedFrameTime() < (uint32)time.totalNumberOfFrames()) {
-		_curFrame++;
-		if (_durationOverride >= 0) {
-			_nextFrameStartTime += _durationOverride;
-			_durationOverride = -1;
-		} else {
-			_nextFrameStartTime += getCurFrameDuration();
-		}
+	const uint32 editStart = _nextFrameStartTime;
+	const uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
+	const uint32 firstFrame = _curFrame + 1;
+	uint32 first = 0, last = _parent->sampleTimes.size() - 1 - firstFrame;
+
+	while (first < last) {
+		const uint32 middle = first + (last - first) / 2;
+		const uint32 frameStart = middle ? editStart + _parent->sampleTimes[firstFrame + middle] - mediaTime : editStart;
+		if (getRateAdjustedFrameTime(frameStart) < (uint32)time.totalNumberOfFrames())
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	if (first) {
+		_curFrame += first;
+		_nextFrameStartTime = editStart + _parent->sampleTimes[firstFrame + first] - mediaTime;
+		_durationOverride = -1;
 	}
 
 	// Check if we went past, then adjust the frame times
@@ -575,10 +583,8 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame()
 		frame = forceDither(*frame);
 
 	if (frame && (_parent->scaleFactorX != 1 || _parent->scaleFactorY != 1)) {
-		if (!_scaledSurface) {
-			_scaledSurface = new Graphics::Surface();
-			_scaledSurface->create(getScaledWidth().toInt(), getScaledHeight().toInt(), getPixelFormat());
-		}
+		if (!_scaledSurface)
+			_scaledSurface = FramePoolMan.acquire(getScaledWidth().toInt(), getScaledHeight().toInt(), getPixelFormat());
 
 		_decoder->scaleSurface(frame, _scaledSurface, _parent->scaleFactorX, _parent->scaleFactorY);
 		return _scaledSurface;
@@ -589,16 +595,8 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame()
 
 Audio::Timestamp QuickTimeDecoder::VideoTrackHandler::getFrameTime(uint frame) const {
 	// TODO: This probably doesn't work right with edit lists
-	int cumulativeDuration = 0;
-	for (int ttsIndex = 0; ttsIndex < _parent->timeToSampleCount; ttsIndex++) {
-		const TimeToSampleEntry &tts = _parent->timeToSample[ttsIndex];
-		if ((int)frame < tts.count)
-			return Audio::Timestamp(0, _parent->timeScale).addFrames(cumulativeDuration + frame * tts.duration);
-		else {
-			frame -= tts.count;
-			cumulativeDuration += tts.duration * tts.count;
-		}
-	}
+	if (frame + 1 < _parent->sampleTimes.size())
+		return Audio::Timestamp(0, _parent->timeScale).addFrames(_parent->sampleTimes[frame]);
 
 	return Audio::Timestamp().addFrames(-1);
 }
@@ -680,42 +678,14 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
-
-	if (actualChunk < 0)
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->sampleOffsets.size())
 		error("Could not find data for frame %d", _curFrame);
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+	descId = _parent->sampleDescIds[_curFrame];
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
-
-	// Finally, read in the raw data for the frame
+	// Seek to the frame and read in its raw data
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(_parent->sampleOffsets[_curFrame]);
 	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
 
 	if (_parent->sampleSize != 0)
@@ -725,14 +695,8 @@ Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePac
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
-	uint32 curFrameIndex = 0;
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		curFrameIndex += _parent->timeToSample[i].count;
-		if ((uint32)_curFrame < curFrameIndex) {
-			// Ok, now we have what duration this frame has.
-			return _parent->timeToSample[i].duration;
-		}
-	}
+	if (_curFrame >= 0 && (uint32)_curFrame + 1 < _parent->sampleTimes.size())
+		return _parent->sampleTimes[_curFrame + 1] - _parent->sampleTimes[_curFrame];
 
 	// This should never occur
 	error("Cannot find duration for frame %d", _curFrame);
@@ -740,12 +704,7 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
-
-	// If none found, we'll assume the requested frame is a key frame
-	return frame;
+	return _parent->findKeyframe(frame);
 }
 
 bool QuickTimeDecoder::VideoTrackHandler::isEmptyEdit() const {
@@ -765,31 +724,21 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditListEntry(bool bufferFrame
 	}
 
 	uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
-	uint32 frameNum = 0;
-	uint32 totalDuration = 0;
 	_durationOverride = -1;
 
 	// Track down where the mediaTime is in the media
 	// This is basically time -> frame mapping
 	// Note that this code uses first frame = 0
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		uint32 duration = _parent->timeToSample[i].count * _parent->timeToSample[i].duration;
-
-		if (totalDuration + duration >= mediaTime) {
-			uint32 frameInc = (mediaTime - totalDuration) / _parent->timeToSample[i].duration;
-			frameNum += frameInc;
-			totalDuration += frameInc * _parent->timeToSample[i].duration;
+	uint32 frameNum = _parent->findSampleTime(mediaTime);
 
-			// If we didn't get to the exact media time, mark an override for
-			// the time.
-			if (totalDuration != mediaTime)
-				_durationOverride = totalDuration + _parent->timeToSample[i].duration - mediaTime;
-
-			break;
-		}
-
-		frameNum += _parent->timeToSample[i].count;
-		totalDuration += duration;
+	if (frameNum == _parent->sampleTimes.size()) {
+		// Past the end of the media
+		frameNum--;
+	} else if (_parent->sampleTimes[frameNum] != mediaTime) {
+		// If we didn't get to the exact media time, mark an override for
+		// the time.
+		_durationOverride = _parent->sampleTimes[frameNum] - mediaTime;
+		frameNum--;
 	}
 
 	if (bufferFrames) {
@@ -868,9 +817,13 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
+	return getRateAdjustedFrameTime(_nextFrameStartTime);
+}
+
+uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime(uint32 frameStartTime) const {
 	// Figure out what time the next frame is at taking the edit list rate into account,
 	// unless this is an empty edit, in which case the rate isn't applicable.
-	Common::Rational offsetFromEdit = Common::Rational(_nextFrameStartTime - getCurEditTimeOffset());
+	Common::Rational offsetFromEdit = Common::Rational(frameStartTime - getCurEditTimeOffset());
 	if (!isEmptyEdit()) {
 		offsetFromEdit /= _parent->editList[_curEdit].mediaRate;
 	}
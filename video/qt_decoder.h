@@ -177,6 +177,7 @@ private:
 		void enterNewEditListEntry(bool bufferFrames, bool intializingTrack = false);
 		const Graphics::Surface *bufferNextFrame();
 		uint32 getRateAdjustedFrameTime() const; // media time
+		uint32 getRateAdjustedFrameTime(uint32 frameStartTime) const;
 		uint32 getCurEditTimeOffset() const;     // media time
 		uint32 getCurEditTrackDuration() const;  // media time
 		bool atFirstEdit() const;
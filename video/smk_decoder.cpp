@@ -29,7 +29,6 @@
 #include "common/util.h"
 #include "common/stream.h"
 #include "common/bitarray.h"
-#include "common/bitstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -46,6 +45,33 @@ enum SmkBlockTypes {
 	SMK_BLOCK_FILL = 3
 };
 
+SmackerBitStream::SmackerBitStream(const byte *data, uint32 size, DisposeAfterUse::Flag disposeMemory)
+	: _data(data), _ptr(data), _end(data + size), _disposeMemory(disposeMemory), _cache(0), _bitsLeft(0) {
+}
+
+SmackerBitStream::~SmackerBitStream() {
+	if (_disposeMemory == DisposeAfterUse::YES)
+		free(const_cast<byte *>(_data));
+}
+
+void SmackerBitStream::refill() {
+	if (_end - _ptr >= 8) {
+		// Load 8 bytes, but only consume the whole bytes which fit into the
+		// cache. The rest is loaded again with the same bits by the next refill.
+		_cache |= READ_LE_UINT64(_ptr) << _bitsLeft;
+		const uint bytes = (63 - _bitsLeft) >> 3;
+		_ptr += bytes;
+		_bitsLeft += bytes * 8;
+		return;
+	}
+
+	while (_bitsLeft <= 56) {
+		if (_ptr < _end)
+			_cache |= (uint64)*_ptr++ << _bitsLeft;
+		_bitsLeft += 8;
+	}
+}
+
 /*
  * class SmallHuffmanTree
  * A Huffman-tree to hold 8-bit values.
@@ -58,7 +84,9 @@ public:
 	uint16 getCode(SmackerBitStream &bs);
 private:
 	enum {
-		SMK_NODE = 0x8000
+		SMK_NODE = 0x8000,
+		// Audio trees are built for every chunk, so their table is smaller
+		kLookupBits = 10
 	};
 
 	uint16 decodeTree(uint32 prefix, int length);
@@ -66,8 +94,8 @@ private:
 	uint16 _treeSize;
 	uint16 _tree[511];
 
-	uint16 _prefixtree[256];
-	byte _prefixlength[256];
+	uint16 _prefixtree[1 << kLookupBits];
+	byte _prefixlength[1 << kLookupBits];
 
 	SmackerBitStream &_bs;
 	bool _empty;
@@ -80,8 +108,8 @@ SmallHuffmanTree::SmallHuffmanTree(SmackerBitStream &bs)
 		return;
 	}
 
-	for (uint16 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
+	memset(_prefixtree, 0, sizeof(_prefixtree));
+	memset(_prefixlength, 0, sizeof(_prefixlength));
 
 	decodeTree(0, 0);
 
@@ -95,8 +123,8 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 	if (!_bs.getBit()) { // Leaf
 		_tree[_treeSize] = _bs.getBits<8>();
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= kLookupBits) {
+			for (int i = 0; i < (1 << kLookupBits); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -108,9 +136,9 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint16 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == kLookupBits) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = kLookupBits;
 	}
 
 	uint16 r1 = decodeTree(prefix, length + 1);
@@ -129,7 +157,7 @@ uint16 SmallHuffmanTree::getCode(SmackerBitStream &bs) {
 	// Peeking data out of bounds is well-defined and returns 0 bits.
 	// This is for convenience when using speed-up techniques reading
 	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
+	uint32 peek = bs.peekBits<kLookupBits>();
 	uint16 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -159,14 +187,20 @@ private:
 		SMK_NODE = 0x80000000
 	};
 
+	enum {
+		kLookupBits = 12
+	};
+
 	uint32 decodeTree(uint32 prefix, int length);
 
 	uint32  _treeSize;
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	// Indices into _tree rather than values, as the values of the
+	// recently decoded markers change while decoding
+	uint32 _prefixtree[1 << kLookupBits];
+	byte _prefixlength[1 << kLookupBits];
 
 	/* Used during construction */
 	SmackerBitStream &_bs;
@@ -182,11 +216,13 @@ BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 		_tree = new uint32[1];
 		_tree[0] = 0;
 		_last[0] = _last[1] = _last[2] = 0;
+		memset(_prefixtree, 0, sizeof(_prefixtree));
+		memset(_prefixlength, 0, sizeof(_prefixlength));
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
+	memset(_prefixtree, 0, sizeof(_prefixtree));
+	memset(_prefixlength, 0, sizeof(_prefixlength));
 
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
@@ -232,8 +268,8 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= kLookupBits) {
+			for (int i = 0; i < (1 << kLookupBits); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -252,9 +288,9 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == kLookupBits) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = kLookupBits;
 	}
 
 	uint32 r1 = decodeTree(prefix, length + 1);
@@ -269,7 +305,7 @@ uint32 BigHuffmanTree::getCode(SmackerBitStream &bs) {
 	// Peeking data out of bounds is well-defined and returns 0 bits.
 	// This is for convenience when using speed-up techniques reading
 	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
+	uint32 peek = bs.peekBits<kLookupBits>();
 	uint32 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -294,6 +330,8 @@ SmackerDecoder::SmackerDecoder() {
 	_firstFrameStart = 0;
 	_frameTypes = 0;
 	_frameSizes = 0;
+	_concurrentAudio = false;
+	_audioGroup = 0;
 }
 
 SmackerDecoder::~SmackerDecoder() {
@@ -413,7 +451,7 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	byte *huffmanTrees = (byte *) malloc(_header.treesSize);
 	_fileStream->read(huffmanTrees, _header.treesSize);
 
-	SmackerBitStream bs(new Common::BitStreamMemoryStream(huffmanTrees, _header.treesSize, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	SmackerBitStream bs(huffmanTrees, _header.treesSize, DisposeAfterUse::YES);
 	videoTrack->readTrees(bs, _header.mMapSize, _header.mClrSize, _header.fullSize, _header.typeSize);
 
 	_firstFrameStart = _fileStream->pos();
@@ -422,6 +460,10 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 }
 
 void SmackerDecoder::close() {
+	finishAudioDecoding();
+	delete _audioGroup;
+	_audioGroup = 0;
+
 	VideoDecoder::close();
 
 	delete _fileStream;
@@ -533,15 +575,14 @@ void SmackerDecoder::readNextPacket() {
 
 	uint32 frameDataSize = frameSize - (_fileStream->pos() - startPos);
 
-	byte *frameData = (byte *)malloc(frameDataSize + 1);
-	// Padding to keep the BigHuffmanTrees from reading past the data end
-	frameData[frameDataSize] = 0x00;
-
+	byte *frameData = (byte *)malloc(frameDataSize);
 	_fileStream->read(frameData, frameDataSize);
 
-	SmackerBitStream bs(new Common::BitStreamMemoryStream(frameData, frameDataSize + 1, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	SmackerBitStream bs(frameData, frameDataSize, DisposeAfterUse::YES);
 	videoTrack->decodeFrame(bs);
 
+	finishAudioDecoding();
+
 	_fileStream->seek(startPos + frameSize);
 }
 
@@ -554,10 +595,7 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 		SmackerAudioTrack *audioTrack = (SmackerAudioTrack *)getTrack(track + 1);
 
 		// If it's track 0, play the audio data
-		byte *soundBuffer = (byte *)malloc(chunkSize + 1);
-		// Padding to keep the SmallHuffmanTrees from reading past the data end
-		soundBuffer[chunkSize] = 0x00;
-
+		byte *soundBuffer = (byte *)malloc(chunkSize);
 		_fileStream->read(soundBuffer, chunkSize);
 
 		if (_header.audioInfo[track].compression == kCompressionRDFT || _header.audioInfo[track].compression == kCompressionDCT) {
@@ -566,8 +604,16 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 			return;
 		} else if (_header.audioInfo[track].compression == kCompressionDPCM) {
 			// Compressed audio (Huffman DPCM encoded)
-			audioTrack->queueCompressedBuffer(soundBuffer, chunkSize + 1, unpackedSize);
-			free(soundBuffer);
+			AudioDecodeJob *job = new AudioDecodeJob(audioTrack, soundBuffer, chunkSize, unpackedSize);
+			if (_concurrentAudio) {
+				if (!_audioGroup)
+					_audioGroup = new Common::TaskGroup(g_system->getThreadPool());
+				_audioJobs.push_back(job);
+				_audioGroup->run(job);
+			} else {
+				job->run();
+				delete job;
+			}
 		} else {
 			// Uncompressed audio (PCM)
 			audioTrack->queuePCM(soundBuffer, chunkSize);
@@ -578,6 +624,16 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 	}
 }
 
+void SmackerDecoder::finishAudioDecoding() {
+	if (_audioJobs.empty())
+		return;
+
+	_audioGroup->wait();
+	for (uint i = 0; i < _audioJobs.size(); ++i)
+		delete _audioJobs[i];
+	_audioJobs.clear();
+}
+
 VideoDecoder::AudioTrack *SmackerDecoder::getAudioTrack(int index) {
 	// Smacker audio track indexes are relative to the first audio track
 	Track *track = getTrack(index + 1);
@@ -853,7 +909,7 @@ Audio::AudioStream *SmackerDecoder::SmackerAudioTrack::getAudioStream() const {
 }
 
 void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize) {
-	SmackerBitStream audioBS(new Common::BitStreamMemoryStream(buffer, bufferSize), DisposeAfterUse::YES);
+	SmackerBitStream audioBS(buffer, bufferSize);
 	bool dataPresent = audioBS.getBit();
 
 	if (!dataPresent)
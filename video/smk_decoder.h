@@ -23,9 +23,9 @@
 #define VIDEO_SMK_PLAYER_H
 
 #include "common/bitarray.h"
-#include "common/bitstream.h"
 #include "common/rational.h"
 #include "common/rect.h"
+#include "common/threadpool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "video/video_decoder.h"
@@ -43,10 +43,65 @@ namespace Video {
 
 class BigHuffmanTree;
 
-// Because the maximum number of bits read from a bitstream is 16, and the data is 8-bit, the container only
-// needs to hold up to 23 bits at any given time. As such, we use a bitstream with a 32-bit container to
-// avoid the overhead of 64-bit maths on systems that don't support it natively.
-typedef Common::BitStreamImpl<Common::BitStreamMemoryStream, uint32, 8, false, false> SmackerBitStream;
+/**
+ * Bitstream over a memory buffer with the least significant bit of every
+ * byte first, as Smacker stores its Huffman codes.
+ *
+ * The reader keeps up to 64 bits in a cache, which is refilled with one
+ * unaligned load for as long as 8 bytes of data are left, so the Huffman
+ * lookups of up to 16 bits rarely have to refill at all. Reading past the
+ * end of the data is well-defined and returns 0 bits.
+ */
+class SmackerBitStream {
+public:
+	SmackerBitStream(const byte *data, uint32 size, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO);
+	~SmackerBitStream();
+
+	uint32 getBit() {
+		if (_bitsLeft == 0)
+			refill();
+
+		const uint32 bit = _cache & 1;
+		_cache >>= 1;
+		--_bitsLeft;
+		return bit;
+	}
+
+	template<uint n>
+	uint32 getBits() {
+		const uint32 bits = peekBits<n>();
+		_cache >>= n;
+		_bitsLeft -= n;
+		return bits;
+	}
+
+	template<uint n>
+	uint32 peekBits() {
+		if (_bitsLeft < n)
+			refill();
+
+		return (uint32)_cache & ((1 << n) - 1);
+	}
+
+	void skip(uint n) {
+		if (_bitsLeft < n)
+			refill();
+
+		_cache >>= n;
+		_bitsLeft -= n;
+	}
+
+private:
+	const byte *_data;
+	const byte *_ptr;
+	const byte *_end;
+	DisposeAfterUse::Flag _disposeMemory;
+
+	uint64 _cache; ///< The next bits, bits above _bitsLeft are either 0 or the data following them.
+	uint _bitsLeft;
+
+	void refill();
+};
 
 /**
  * Decoder for Smacker v2/v4 videos.
@@ -75,6 +130,14 @@ public:
 	void forceSeekToFrame(uint frame);
 	bool rewind();
 
+	/**
+	 * Decode the Huffman DPCM audio of every frame on the thread pool,
+	 * while the frame's video is decoded. Off by default, as subclasses
+	 * overriding handleAudioTrack() may not expect the audio tracks to be
+	 * written to from another thread.
+	 */
+	void setConcurrentAudioDecoding(bool concurrent) { _concurrentAudio = concurrent; }
+
 	Common::Rational getFrameRate() const;
 
 	virtual const Common::Rect *getNextDirtyRect();
@@ -82,6 +145,7 @@ public:
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
+	bool supportsDecodeAhead() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 
 	virtual void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize);
@@ -194,6 +258,24 @@ private:
 		AudioInfo _audioInfo;
 	};
 
+	/** Decodes one Huffman DPCM audio chunk and frees it afterwards. */
+	class AudioDecodeJob : public Common::Job {
+	public:
+		AudioDecodeJob(SmackerAudioTrack *track, byte *buffer, uint32 bufferSize, uint32 unpackedSize) :
+			_track(track), _buffer(buffer), _bufferSize(bufferSize), _unpackedSize(unpackedSize) {}
+
+		void run() override {
+			_track->queueCompressedBuffer(_buffer, _bufferSize, _unpackedSize);
+			free(_buffer);
+		}
+
+	private:
+		SmackerAudioTrack *_track;
+		byte *_buffer;
+		uint32 _bufferSize;
+		uint32 _unpackedSize;
+	};
+
 	class SmackerEmptyTrack : public Track {
 		VideoDecoder::Track::TrackType getTrackType() const { return VideoDecoder::Track::kTrackTypeNone; }
 
@@ -213,6 +295,12 @@ protected:
 
 private:
 	uint32 _firstFrameStart;
+
+	bool _concurrentAudio;
+	Common::TaskGroup *_audioGroup;           ///< Created on first use, as g_system may not exist yet in the constructor.
+	Common::Array<AudioDecodeJob *> _audioJobs; ///< The jobs of the frame being decoded.
+
+	void finishAudioDecoding();
 };
 
 } // End of namespace Video
@@ -37,6 +37,7 @@
 
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
+#include "common/profiler.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -254,7 +255,8 @@ Common::Rational TheoraDecoder::getFrameRate() const {
 	return Common::Rational();
 }
 
-TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_info *theoraSetup) {
+TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_info *theoraSetup) :
+		_convertJob(*this), _convertGroup(g_system->getThreadPool()), _converting(false) {
 	_theoraDecode = th_decode_alloc(&theoraInfo, theoraSetup);
 
 	if (theoraInfo.pixel_fmt != TH_PF_420 && theoraInfo.pixel_fmt != TH_PF_422 && theoraInfo.pixel_fmt != TH_PF_444) {
@@ -290,8 +292,44 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 }
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
+	finishConversion();
 	th_decode_free(_theoraDecode);
+	freeSurfaces();
+}
+
+bool TheoraDecoder::TheoraVideoTrack::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	if (format != _pixelFormat) {
+		finishConversion();
+		freeSurfaces();
+		_pixelFormat = format;
+	}
+
+	return true;
+}
+
+const Graphics::Surface *TheoraDecoder::TheoraVideoTrack::decodeNextFrame() {
+	finishConversion();
+	return _displaySurface;
+}
 
+void TheoraDecoder::TheoraVideoTrack::allocateSurfaces() {
+	if (!_surface) {
+		_surface = new Graphics::Surface();
+		_surface->create(_surfaceWidth, _surfaceHeight, _pixelFormat);
+	}
+
+	// Set up a display surface
+	if (!_displaySurface) {
+		_displaySurface = new Graphics::Surface();
+		_displaySurface->init(_width, _height, _surface->pitch,
+		                      _surface->getBasePtr(_x, _y), _surface->format);
+	}
+}
+
+void TheoraDecoder::TheoraVideoTrack::freeSurfaces() {
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -305,14 +343,28 @@ TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 	}
 }
 
+void TheoraDecoder::TheoraVideoTrack::finishConversion() {
+	if (!_converting)
+		return;
+
+	_convertGroup.wait();
+	_converting = false;
+}
+
 bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
+	// libtheora reuses the planes of the frame that is still being converted
+	finishConversion();
+
 	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
 		_curFrame++;
 
-		// Convert YUV data to RGB data
-		th_ycbcr_buffer yuv;
-		th_decode_ycbcr_out(_theoraDecode, yuv);
-		translateYUVtoRGBA(yuv);
+		// Convert YUV data to RGB data, directly into the output surface.
+		// The conversion runs on a worker until decodeNextFrame() or the
+		// next packet needs it.
+		th_decode_ycbcr_out(_theoraDecode, _yuvBuffer);
+		allocateSurfaces();
+		_converting = true;
+		_convertGroup.run(&_convertJob);
 
 		double time = th_granule_time(_theoraDecode, oggPacket.granulepos);
 
@@ -350,17 +402,7 @@ void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuf
 	assert((YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height >> 1) || (YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height));
 	assert((YUVBuffer[kBufferV].height == YUVBuffer[kBufferY].height >> 1) || (YUVBuffer[kBufferV].height == YUVBuffer[kBufferY].height));
 
-	if (!_surface) {
-		_surface = new Graphics::Surface();
-		_surface->create(_surfaceWidth, _surfaceHeight, _pixelFormat);
-	}
-
-	// Set up a display surface
-	if (!_displaySurface) {
-		_displaySurface = new Graphics::Surface();
-		_displaySurface->init(_width, _height, _surface->pitch,
-		                      _surface->getBasePtr(_x, _y), _surface->format);
-	}
+	PROFILE_ZONE_LANE("TheoraDecoder::convert", Common::Profiler::kLaneWorker);
 
 	switch (_theoraPixelFormat) {
 	case TH_PF_420:
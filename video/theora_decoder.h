@@ -27,6 +27,7 @@
 #define VIDEO_THEORA_DECODER_H
 
 #include "common/rational.h"
+#include "common/threadpool.h"
 #include "video/video_decoder.h"
 #include "audio/mixer.h"
 #include "graphics/surface.h"
@@ -86,16 +87,29 @@ private:
 		uint16 getWidth() const { return _width; }
 		uint16 getHeight() const { return _height; }
 		Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
-		bool setOutputPixelFormat(const Graphics::PixelFormat &format) { _pixelFormat = format; return true; }
+		bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 		int getCurFrame() const { return _curFrame; }
 		const Common::Rational &getFrameRate() const { return _frameRate; }
 		uint32 getNextFrameStartTime() const { return (uint32)(_nextFrameStartTime * 1000); }
-		const Graphics::Surface *decodeNextFrame() { return _displaySurface; }
+		const Graphics::Surface *decodeNextFrame();
 
 		bool decodePacket(ogg_packet &oggPacket);
 		void setEndOfVideo() { _endOfVideo = true; }
 
 	private:
+		/**
+		 * Converts the last decoded frame on the thread pool, while the
+		 * decoder goes on demuxing and decoding the audio.
+		 */
+		class ConvertJob : public Common::Job {
+		public:
+			ConvertJob(TheoraVideoTrack &track) : _track(track) {}
+			void run() override { _track.translateYUVtoRGBA(_track._yuvBuffer); }
+
+		private:
+			TheoraVideoTrack &_track;
+		};
+
 		int _curFrame;
 		bool _endOfVideo;
 		Common::Rational _frameRate;
@@ -114,6 +128,14 @@ private:
 		th_dec_ctx *_theoraDecode;
 		th_pixel_fmt _theoraPixelFormat;
 
+		th_ycbcr_buffer _yuvBuffer; ///< The planes of the frame being converted, owned by libtheora.
+		ConvertJob _convertJob;
+		Common::TaskGroup _convertGroup;
+		bool _converting;
+
+		void allocateSurfaces();
+		void freeSurfaces();
+		void finishConversion();
 		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
 	};
 
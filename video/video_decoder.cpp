@@ -26,12 +26,344 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
+#include "common/rect.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * Frames decoded ahead of playback.
+ *
+ * A job on the thread pool runs the same steps as a synchronous call to
+ * decodeNextFrame() and copies every frame into a ring, together with the
+ * state of the video tracks after decoding it. While the ring is active,
+ * the playback queries answer from the state stored with the frame which
+ * was returned last, since the tracks themselves are further ahead.
+ *
+ * The job owns the tracks and _nextVideoTrack while it is queued or
+ * running. Everything else is only accessed by the thread playing the
+ * video, which stops the job before changing the tracks.
+ */
+class VideoDecoder::DecodeAhead : public Common::Job {
+public:
+	struct TrackState {
+		const VideoTrack *track;
+		int curFrame;
+		uint32 nextFrameStartTime;
+		bool endOfTrack;
+	};
+
+	DecodeAhead(VideoDecoder *decoder, uint depth, Common::SemaphoreInternal *frameReady);
+	~DecodeAhead() override;
+
+	void run() override;
+
+	bool isActive() const { return _active; }
+
+	/** Return the depth requested last, where 0 means the ring is drained. */
+	uint getRequestedDepth() const { return _requestedDepth; }
+	void setRequestedDepth(uint depth);
+
+	/**
+	 * Start decoding ahead from the current state of the tracks, which
+	 * must not be reversed.
+	 */
+	void activate();
+
+	/**
+	 * Stop decoding and forget all frames. The tracks have to be seeked
+	 * afterwards, as they are not at the frame returned last any more.
+	 */
+	void flush();
+
+	/** Stop and restart the job around a change of the track list. */
+	void suspend() { stopJob(); }
+	void resume();
+
+	/**
+	 * Return the next frame, waiting for the job if it is still decoding
+	 * it. Returns false and deactivates the ring if there are no more
+	 * frames, in which case the tracks are at the frame returned last.
+	 */
+	bool present(const Graphics::Surface *&surface, const byte *&palette);
+
+	const TrackState *getState(const Track *track) const;
+	VideoTrack *getNextVideoTrack() const { return _nextVideoTrack; }
+
+private:
+	struct Frame {
+		Graphics::Surface surface;
+		bool hasSurface;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+		VideoTrack *nextVideoTrack;
+		Common::Array<TrackState> tracks;
+	};
+
+	VideoDecoder *_decoder;
+	Common::TaskGroup _group;
+	Common::SemaphoreInternal *_frameReady;
+
+	// Protected by _mutex
+	Common::Mutex _mutex;
+	Common::Array<Frame> _frames;
+	uint _depth;
+	uint32 _head;
+	uint32 _tail;
+	bool _busy;
+	bool _stop;
+	bool _finished;
+	bool _waiting;
+
+	// Only used by the thread playing the video
+	uint _requestedDepth;
+	bool _active;
+	Common::Array<TrackState> _tracks;
+	VideoTrack *_nextVideoTrack;
+	byte _palette[256 * 3];
+
+	void decode(Frame &frame);
+	void saveTrackStates(Common::Array<TrackState> &states) const;
+	void schedule();
+	void stopJob();
+	void wakeUp();
+};
+
+VideoDecoder::DecodeAhead::DecodeAhead(VideoDecoder *decoder, uint depth, Common::SemaphoreInternal *frameReady) :
+		_decoder(decoder), _group(g_system->getThreadPool()), _frameReady(frameReady),
+		_depth(depth), _head(0), _tail(0), _busy(false), _stop(false), _finished(false), _waiting(false),
+		_requestedDepth(depth), _active(false), _nextVideoTrack(0) {
+	memset(_palette, 0, sizeof(_palette));
+}
+
+VideoDecoder::DecodeAhead::~DecodeAhead() {
+	stopJob();
+
+	for (uint i = 0; i < _frames.size(); i++)
+		_frames[i].surface.free();
+
+	delete _frameReady;
+}
+
+void VideoDecoder::DecodeAhead::setRequestedDepth(uint depth) {
+	_requestedDepth = depth;
+
+	if (!depth) {
+		// Keep the frames which are decoded already
+		stopJob();
+		return;
+	}
+
+	// The ring is only reallocated on activation; until then, only
+	// the slots which exist already may be used.
+	Common::StackLock lock(_mutex);
+	_depth = _frames.empty() ? depth : MIN<uint>(depth, _frames.size() - 1);
+}
+
+void VideoDecoder::DecodeAhead::activate() {
+	assert(!_active && _requestedDepth);
+
+	// One more slot than frames to decode ahead keeps the frame
+	// returned last alive until the next one is requested.
+	if (_frames.size() != _requestedDepth + 1) {
+		for (uint i = 0; i < _frames.size(); i++)
+			_frames[i].surface.free();
+		_frames.clear();
+		_frames.resize(_requestedDepth + 1);
+	}
+
+	saveTrackStates(_tracks);
+	_nextVideoTrack = _decoder->_nextVideoTrack;
+	_active = true;
+
+	{
+		Common::StackLock lock(_mutex);
+		_depth = _requestedDepth;
+		_head = _tail = 0;
+		_finished = !_nextVideoTrack;
+	}
+
+	schedule();
+}
+
+void VideoDecoder::DecodeAhead::flush() {
+	stopJob();
+
+	Common::StackLock lock(_mutex);
+	_head = _tail = 0;
+	_finished = false;
+	_active = false;
+}
+
+void VideoDecoder::DecodeAhead::resume() {
+	if (!_active)
+		return;
+
+	// Tracks added since the activation have not been decoded yet
+	for (TrackList::const_iterator it = _decoder->_tracks.begin(); it != _decoder->_tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !getState(*it)) {
+			const VideoTrack *track = (const VideoTrack *)*it;
+			TrackState state = { track, track->getCurFrame(), track->getNextFrameStartTime(), track->endOfTrack() };
+			_tracks.push_back(state);
+		}
+	}
+
+	schedule();
+}
+
+bool VideoDecoder::DecodeAhead::present(const Graphics::Surface *&surface, const byte *&palette) {
+	assert(_active);
+
+	Frame *frame = 0;
+
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			if (_head != _tail) {
+				frame = &_frames[_tail % _frames.size()];
+				_tail++;
+				break;
+			}
+
+			if (!_busy) {
+				// The job has stopped, so the tracks may be used directly again
+				_head = _tail = 0;
+				_finished = false;
+				_active = false;
+				return false;
+			}
+
+			_waiting = true;
+		}
+
+		PROFILE_ZONE("VideoDecoder::DecodeAhead::wait");
+		_frameReady->wait();
+	}
+
+	_tracks = frame->tracks;
+	_nextVideoTrack = frame->nextVideoTrack;
+
+	surface = frame->hasSurface ? &frame->surface : 0;
+	palette = 0;
+	if (frame->dirtyPalette) {
+		memcpy(_palette, frame->palette, sizeof(_palette));
+		palette = _palette;
+	}
+
+	if (_requestedDepth)
+		schedule();
+	return true;
+}
+
+const VideoDecoder::DecodeAhead::TrackState *VideoDecoder::DecodeAhead::getState(const Track *track) const {
+	if (!_active)
+		return 0;
+
+	for (uint i = 0; i < _tracks.size(); i++)
+		if (_tracks[i].track == track)
+			return &_tracks[i];
+
+	return 0;
+}
+
+void VideoDecoder::DecodeAhead::run() {
+	PROFILE_ZONE_LANE("VideoDecoder::DecodeAhead::run", Common::Profiler::kLaneWorker);
+
+	for (;;) {
+		Frame *frame;
+		{
+			Common::StackLock lock(_mutex);
+			if (_stop || _finished || _head - _tail >= _depth) {
+				_busy = false;
+				wakeUp();
+				return;
+			}
+
+			frame = &_frames[_head % _frames.size()];
+		}
+
+		decode(*frame);
+
+		Common::StackLock lock(_mutex);
+		_finished = !frame->nextVideoTrack;
+		_head++;
+		wakeUp();
+	}
+}
+
+void VideoDecoder::DecodeAhead::decode(Frame &frame) {
+	const byte *palette = 0;
+	const Graphics::Surface *surface = _decoder->decodeFrame(palette);
+
+	frame.hasSurface = surface != 0;
+	if (surface) {
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format) {
+			frame.surface.free();
+			frame.surface.create(surface->w, surface->h, surface->format);
+		}
+
+		frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.dirtyPalette = palette != 0;
+	if (palette)
+		memcpy(frame.palette, palette, sizeof(frame.palette));
+
+	saveTrackStates(frame.tracks);
+	frame.nextVideoTrack = _decoder->_nextVideoTrack;
+}
+
+void VideoDecoder::DecodeAhead::saveTrackStates(Common::Array<TrackState> &states) const {
+	states.clear();
+
+	for (TrackList::const_iterator it = _decoder->_tracks.begin(); it != _decoder->_tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			const VideoTrack *track = (const VideoTrack *)*it;
+			TrackState state = { track, track->getCurFrame(), track->getNextFrameStartTime(), track->endOfTrack() };
+			states.push_back(state);
+		}
+	}
+}
+
+void VideoDecoder::DecodeAhead::schedule() {
+	{
+		Common::StackLock lock(_mutex);
+		if (_busy || _finished || _head - _tail >= _depth)
+			return;
+
+		_busy = true;
+	}
+
+	// Without worker threads, this decodes the frames right away
+	_group.run(this);
+}
+
+void VideoDecoder::DecodeAhead::stopJob() {
+	{
+		Common::StackLock lock(_mutex);
+		_stop = true;
+	}
+
+	_group.wait();
+
+	Common::StackLock lock(_mutex);
+	_stop = false;
+}
+
+void VideoDecoder::DecodeAhead::wakeUp() {
+	// Called with _mutex locked
+	if (_waiting) {
+		_waiting = false;
+		_frameReady->post();
+	}
+}
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,9 +381,17 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_decodeAhead = 0;
+}
+
+VideoDecoder::~VideoDecoder() {
+	delete _decodeAhead;
 }
 
 void VideoDecoder::close() {
+	delete _decodeAhead;
+	_decodeAhead = 0;
+
 	if (isPlaying())
 		stop();
 
@@ -202,10 +542,46 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	const byte *palette = 0;
+	const Graphics::Surface *frame = 0;
+	bool decoded = false;
+
+	if (_decodeAhead) {
+		if (!_decodeAhead->isActive() && _decodeAhead->getRequestedDepth() && _nextVideoTrack && !_nextVideoTrack->isReversed())
+			_decodeAhead->activate();
+
+		if (_decodeAhead->isActive())
+			decoded = _decodeAhead->present(frame, palette);
+
+		// All frames decoded ahead have been returned after disabling it
+		if (!decoded && !_decodeAhead->getRequestedDepth()) {
+			// The tracks are at the frame returned last, and so is their palette
+			if (_palette)
+				_palette = _nextVideoTrack ? _nextVideoTrack->getPalette() : 0;
+
+			delete _decodeAhead;
+			_decodeAhead = 0;
+		}
+	}
+
+	if (!decoded)
+		frame = decodeFrame(palette);
+
+	if (palette) {
+		_palette = palette;
+		_dirtyPalette = true;
+	}
+
+	return frame;
+}
+
+const Graphics::Surface *VideoDecoder::decodeFrame(const byte *&palette) {
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -215,10 +591,8 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 
 	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
 
-	if (_nextVideoTrack->hasDirtyPalette()) {
-		_palette = _nextVideoTrack->getPalette();
-		_dirtyPalette = true;
-	}
+	if (_nextVideoTrack->hasDirtyPalette())
+		palette = _nextVideoTrack->getPalette();
 
 	// Look for the next video track here for the next decode.
 	findNextVideoTrack();
@@ -226,11 +600,39 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	if (_decodeAhead) {
+		_decodeAhead->setRequestedDepth(frames);
+		return true;
+	}
+
+	if (!frames)
+		return true;
+
+	if (!isVideoLoaded() || !supportsDecodeAhead())
+		return false;
+
+	// Threads waiting for a frame need to be woken up by the workers
+	Common::SemaphoreInternal *frameReady = 0;
+	if (g_system->getThreadPool().getWorkerCount() > 0) {
+		frameReady = g_system->createSemaphore(0);
+		if (!frameReady)
+			return false;
+	}
+
+	_decodeAhead = new DecodeAhead(this, frames, frameReady);
+	return true;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The tracks are ahead of the frame returned last, and always forward
+	if (_decodeAhead && _decodeAhead->isActive())
+		return !reverse;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -255,7 +657,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getPlaybackCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -292,13 +694,15 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	const VideoTrack *nextVideoTrack = getPlaybackNextVideoTrack();
+
+	if (endOfVideo() || _needsUpdate || !nextVideoTrack)
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getPlaybackNextFrameStartTime(nextVideoTrack);
 
-	if (_nextVideoTrack->isReversed()) {
+	if (nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -317,8 +721,8 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getPlaybackNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = getPlaybackEndOfTrack(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -341,6 +745,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	if (_decodeAhead)
+		_decodeAhead->flush();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -375,6 +782,9 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	if (_decodeAhead)
+		_decodeAhead->flush();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -758,6 +1168,9 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::String &base
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	if (_decodeAhead)
+		_decodeAhead->suspend();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -793,6 +1206,9 @@ void VideoDecoder::addTrack(Track *track, bool isExternal) {
 	// Start the track if we're playing
 	if (isPlaying() && track->getTrackType() == Track::kTrackTypeAudio)
 		((AudioTrack *)track)->start();
+
+	if (_decodeAhead)
+		_decodeAhead->resume();
 }
 
 bool VideoDecoder::addStreamTrack(Audio::SeekableAudioStream *stream) {
@@ -939,6 +1355,28 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	return _nextVideoTrack;
 }
 
+int VideoDecoder::getPlaybackCurFrame(const VideoTrack *track) const {
+	const DecodeAhead::TrackState *state = _decodeAhead ? _decodeAhead->getState(track) : 0;
+	return state ? state->curFrame : track->getCurFrame();
+}
+
+uint32 VideoDecoder::getPlaybackNextFrameStartTime(const VideoTrack *track) const {
+	const DecodeAhead::TrackState *state = _decodeAhead ? _decodeAhead->getState(track) : 0;
+	return state ? state->nextFrameStartTime : track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::getPlaybackEndOfTrack(const Track *track) const {
+	const DecodeAhead::TrackState *state = _decodeAhead ? _decodeAhead->getState(track) : 0;
+	return state ? state->endOfTrack : track->endOfTrack();
+}
+
+VideoDecoder::VideoTrack *VideoDecoder::getPlaybackNextVideoTrack() const {
+	if (_decodeAhead && _decodeAhead->isActive())
+		return _decodeAhead->getNextVideoTrack();
+
+	return _nextVideoTrack;
+}
+
 void VideoDecoder::startAudio() {
 	if (_endTimeSet) {
 		// HACK: Timestamp's subtraction asserts out when subtracting two times
@@ -974,8 +1412,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getPlaybackNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = getPlaybackEndOfTrack(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -992,6 +1430,9 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	if (_decodeAhead)
+		_decodeAhead->suspend();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -1006,6 +1447,9 @@ void VideoDecoder::eraseTrack(Track *track) {
 		if (_tracks[idx] == track)
 			_tracks.remove_at(idx);
 	}
+
+	if (_decodeAhead)
+		_decodeAhead->resume();
 }
 
 } // End of namespace Video
@@ -52,7 +52,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -398,6 +398,23 @@ public:
 	 */
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
+	/**
+	 * Decode frames ahead of playback on a worker thread.
+	 *
+	 * Up to @p frames frames are decoded into a ring of surfaces, so that
+	 * decodeNextFrame() usually returns a frame which is ready already.
+	 * Seeking and rewinding discard the frames decoded so far, and changes
+	 * of the playback rate apply to them as usual. Passing 0 returns the
+	 * frames which are decoded already before decoding on demand again.
+	 *
+	 * This should be called after loadStream(), and is reset by close().
+	 * Videos cannot be played in reverse while frames are decoded ahead.
+	 *
+	 * @param frames The maximum number of frames to decode ahead
+	 * @return true on success, false if the video does not support it
+	 */
+	bool setDecodeAhead(uint frames);
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -944,6 +961,18 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Can frames be decoded ahead of playback on another thread?
+	 *
+	 * A subclass may return true if readNextPacket() and the video tracks'
+	 * decodeNextFrame() only use the state of this decoder and its tracks,
+	 * do not depend on the playback time, and if nothing else accesses the
+	 * tracks while a video plays.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -965,6 +994,19 @@ private:
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
 
+	// Frames decoded ahead of playback
+	class DecodeAhead;
+	DecodeAhead *_decodeAhead;
+
+	const Graphics::Surface *decodeFrame(const byte *&palette);
+
+	// The state of the tracks at the frame returned last, which lags
+	// behind the tracks themselves while frames are decoded ahead
+	int getPlaybackCurFrame(const VideoTrack *track) const;
+	uint32 getPlaybackNextFrameStartTime(const VideoTrack *track) const;
+	bool getPlaybackEndOfTrack(const Track *track) const;
+	VideoTrack *getPlaybackNextVideoTrack() const;
+
 protected:
 	// Internal helper functions
 	void stopAudio();